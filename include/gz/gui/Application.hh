@@ -55,7 +55,14 @@ namespace gz
 
       /// \brief One independent dialog per plugin. Also useful to open a
       /// startup dialog before the main window.
-      kDialog = 1
+      kDialog = 1,
+
+      /// \brief A main window which doesn't need a display, for automated
+      /// tests and batch rendering. Qt's offscreen platform is used unless
+      /// QT_QPA_PLATFORM is set, and the window is rendered on the GUI
+      /// thread unless QSG_RENDER_LOOP is set. Plugins are loaded as usual,
+      /// and frames are rendered with Application::StepFrame.
+      kHeadless = 2
     };
 
     /// \brief A Gazebo GUI application loads a QML engine and
@@ -76,10 +83,52 @@ namespace gz
       /// \brief Destructor
       public: virtual ~Application();
 
+      /// \brief Choose the lightweight mode, for clients which only show
+      /// status, such as WorldStats, WorldControl and TopicEcho. Qt Quick
+      /// draws with its software adaptation instead of the GPU, the main
+      /// window ignores the render engine, and plugins which need a 3D
+      /// scene, see IsRenderPlugin, are neither loaded nor listed.
+      ///
+      /// It's chosen with `gz gui --lite`, or the GZ_GUI_LITE environment
+      /// variable set to 1 if SetLite wasn't called. Must be called before
+      /// the application is created.
+      /// \param[in] _lite True for the lightweight mode
+      public: static void SetLite(bool _lite);
+
+      /// \brief Get whether the lightweight mode was chosen.
+      /// \return True in the lightweight mode
+      /// \sa SetLite
+      public: static bool Lite();
+
+      /// \brief Get whether a plugin needs a 3D scene or a render engine,
+      /// such as MinimalScene or GridConfig.
+      /// \param[in] _filename Plugin filename, with or without the "lib"
+      /// prefix and the extension
+      /// \return True if it isn't loaded in the lightweight mode
+      public: static bool IsRenderPlugin(const std::string &_filename);
+
       /// \brief Get the QML engine
       /// \return Pointer to QML engine
       public: QQmlApplicationEngine *Engine() const;
 
+      /// \brief Render one frame of the main window and wait until it's
+      /// presented, processing events meanwhile. This is how the window of a
+      /// WindowType::kHeadless application is advanced without running the
+      /// event loop, but it works with any main window. Screenshots can be
+      /// taken after it with QQuickWindow::grabWindow.
+      /// \param[in] _timeoutMs How long to wait for the frame
+      /// \return True if a frame was presented before the timeout
+      public: bool StepFrame(int _timeoutMs = 1000);
+
+      /// \brief Get the component of a QML file. It's compiled the first
+      /// time it's requested and reused after that, so for example all
+      /// plugin cards share one component.
+      /// \param[in] _qmlFile Path to the QML file, such as
+      /// ":qml/GzCard.qml"
+      /// \return Component belonging to the engine, which may have errors,
+      /// see QQmlComponent::isError.
+      public: QQmlComponent *Component(const std::string &_qmlFile);
+
       /// \brief Load a plugin from a file name. The plugin file must be in the
       /// path.
       /// If a window has been initialized, the plugin is added to the window.
@@ -142,6 +191,15 @@ namespace gz
       /// 3. Path ~/.gz/gui/plugins
       /// 4. The path where Gazebo GUI plugins are installed
       ///
+      /// The directories are listed once and the list is shared with
+      /// LoadPlugin. It's listed again after AddPluginPath or
+      /// SetPluginPathEnv are called, or when a file is added to or removed
+      /// from one of the directories returned by the last call, which is
+      /// notified with PluginListChanged.
+      ///
+      /// Plugins linked into the executable, see StaticPlugins, come first,
+      /// with "built-in" as their path.
+      ///
       /// \return A vector of pairs, where each pair contains:
       /// * A path
       /// * A vector of plugins in that path
@@ -149,13 +207,24 @@ namespace gz
           PluginList();
 
       /// \brief Remove plugin by name. The plugin is removed from the
-      /// application and its shared library unloaded if this was its last
-      /// instance.
+      /// application. Its shared library stays loaded, so the plugin can
+      /// be added again quickly.
       /// \param[in] _pluginName Plugn instance's unique name. This is the
       /// plugin card's object name.
       /// \return True if successful
       public: bool RemovePlugin(const std::string &_pluginName);
 
+      /// \brief Start changing several plugins of the main window, for
+      /// example removing all of them and loading others. Until the matching
+      /// EndLayoutChange, the split layout doesn't recalculate its sizes and
+      /// the plugin count isn't updated after each plugin. Calls can be
+      /// nested, LoadConfig uses them.
+      public: void BeginLayoutChange();
+
+      /// \brief Finish a BeginLayoutChange. If it's the outermost one, the
+      /// layout and the plugin count are updated once.
+      public: void EndLayoutChange();
+
       /// \brief Get a plugin by its unique name.
       /// \param[in] _pluginName Plugn instance's unique name. This is the
       /// plugin card's object name.
@@ -163,10 +232,21 @@ namespace gz
       public: std::shared_ptr<Plugin> PluginByName(
           const std::string &_pluginName) const;
 
+      /// \brief Get the main window. This is cached when the main window is
+      /// created and cleared when it's destroyed, so it's cheap enough to
+      /// call on every frame, unlike searching the object tree with
+      /// `findChild<MainWindow *>()`.
+      /// \return Pointer to the main window, null if there's none.
+      public: MainWindow *MainWin() const;
+
       /// \brief Notify that a plugin has been added.
       /// \param[in] _objectName Plugin's object name.
       signals: void PluginAdded(const QString &_objectName);
 
+      /// \brief Notify that PluginList may have changed, because the plugin
+      /// paths or the contents of a plugin directory changed.
+      signals: void PluginListChanged();
+
       /// \brief Callback when user requests to close a plugin
       public slots: void OnPluginClose();
 
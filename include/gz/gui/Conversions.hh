@@ -18,6 +18,9 @@
 #ifndef GZ_GUI_CONVERSIONS_HH_
 #define GZ_GUI_CONVERSIONS_HH_
 
+#include <cstddef>
+#include <vector>
+
 #include <gz/common/KeyEvent.hh>
 #include <gz/common/MouseEvent.hh>
 #include <gz/math/Color.hh>
@@ -72,6 +75,75 @@ namespace gz
     GZ_GUI_VISIBLE
     math::Vector3d convert(const QVector3D &_vec);
 
+    /// \brief Convert an array of Gazebo colors, the same as converting
+    /// each of them. The loop is simple enough for the compiler to
+    /// vectorize, so prefer it to converting each element.
+    /// \param[in] _colors First color to convert
+    /// \param[in] _count Number of colors
+    /// \param[out] _out Array of at least _count Qt colors
+    GZ_GUI_VISIBLE
+    void convert(const math::Color *_colors, std::size_t _count,
+        QColor *_out);
+
+    /// \brief Convert an array of Gazebo colors into packed ARGB colors,
+    /// such as those of a QImage::Format_ARGB32 image.
+    /// \param[in] _colors First color to convert
+    /// \param[in] _count Number of colors
+    /// \param[out] _out Array of at least _count packed colors
+    GZ_GUI_VISIBLE
+    void convert(const math::Color *_colors, std::size_t _count,
+        QRgb *_out);
+
+    /// \brief Convert an array of Qt colors.
+    /// \param[in] _colors First color to convert
+    /// \param[in] _count Number of colors
+    /// \param[out] _out Array of at least _count Gazebo colors
+    GZ_GUI_VISIBLE
+    void convert(const QColor *_colors, std::size_t _count,
+        math::Color *_out);
+
+    /// \brief Convert an array of Gazebo vectors 3d, the same as converting
+    /// each of them. The loop is simple enough for the compiler to
+    /// vectorize, so prefer it to converting each element.
+    /// \param[in] _vecs First vector to convert
+    /// \param[in] _count Number of vectors
+    /// \param[out] _out Array of at least _count Qt vectors
+    GZ_GUI_VISIBLE
+    void convert(const math::Vector3d *_vecs, std::size_t _count,
+        QVector3D *_out);
+
+    /// \brief Convert an array of Qt vectors 3d.
+    /// \param[in] _vecs First vector to convert
+    /// \param[in] _count Number of vectors
+    /// \param[out] _out Array of at least _count Gazebo vectors
+    GZ_GUI_VISIBLE
+    void convert(const QVector3D *_vecs, std::size_t _count,
+        math::Vector3d *_out);
+
+    /// \brief Return the equivalent Qt colors.
+    /// \param[in] _colors Gazebo colors to convert
+    /// \return Qt colors, in the same order
+    GZ_GUI_VISIBLE
+    std::vector<QColor> convert(const std::vector<math::Color> &_colors);
+
+    /// \brief Return the equivalent Gazebo colors.
+    /// \param[in] _colors Qt colors to convert
+    /// \return Gazebo colors, in the same order
+    GZ_GUI_VISIBLE
+    std::vector<math::Color> convert(const std::vector<QColor> &_colors);
+
+    /// \brief Return the equivalent Qt vectors 3d.
+    /// \param[in] _vecs Gazebo vectors 3d to convert
+    /// \return Qt vectors 3d, in the same order
+    GZ_GUI_VISIBLE
+    std::vector<QVector3D> convert(const std::vector<math::Vector3d> &_vecs);
+
+    /// \brief Return the equivalent Gazebo vectors 3d.
+    /// \param[in] _vecs Qt vectors 3d to convert
+    /// \return Gazebo vectors 3d, in the same order
+    GZ_GUI_VISIBLE
+    std::vector<math::Vector3d> convert(const std::vector<QVector3D> &_vecs);
+
     /// \brief Return the equivalent Gazebo mouse event.
     ///
     /// Note that there isn't a 1-1 mapping between these types, so fields such
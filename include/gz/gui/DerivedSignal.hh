@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_DERIVEDSIGNAL_HH_
+#define GZ_GUI_DERIVEDSIGNAL_HH_
+
+#include <QPointF>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gz/gui/Export.hh"
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace gz
+{
+  namespace gui
+  {
+    class DerivedSignalPrivate;
+
+    /// \brief Series computed from the samples of other series, such as
+    /// the difference of two topic fields, their rolling mean or their
+    /// spectrum. It's used by the PlottingInterface, which feeds it the
+    /// full rate samples recorded by the topics on a worker thread.
+    ///
+    /// The expression is made of the names of its inputs, numbers,
+    /// + - * / ^, parentheses and these functions:
+    /// * abs, sqrt, exp, log, sin, cos, tan: of one argument
+    /// * atan2(y, x)
+    /// * min, max, norm: of any number of arguments, norm(x, y, z) being
+    ///   the length of a vector
+    /// * movmean, movstd, movmin, movmax(x, window): statistics of the
+    ///   last window seconds of x, the window being a number
+    /// * deriv(x): rate of change of x per second
+    /// * fft(x, size): amplitude of each frequency of the last size
+    ///   samples of x, without their mean, size being a power of two. It
+    ///   must be the whole expression.
+    ///
+    /// Such as `a - b`, `norm(x, y, z)` or `fft(movmean(a, 0.1), 1024)`.
+    ///
+    /// The expression is evaluated at the time of each sample of any
+    /// input, with the latest value of the others, once all inputs have a
+    /// value. Samples are only evaluated up to the latest time all inputs
+    /// reached, so inputs of different topics are evaluated in time order.
+    /// Statistics are computed incrementally, in constant time per sample.
+    class GZ_GUI_VISIBLE DerivedSignal
+    {
+      /// \brief Constructor
+      public: DerivedSignal();
+
+      /// \brief Destructor
+      public: ~DerivedSignal();
+
+      /// \brief Parse an expression, clearing the samples.
+      /// \param[in] _expression Expression, see the class description
+      /// \param[in] _inputs Names of the inputs, in the order their
+      /// samples are given to Update
+      /// \return False if it isn't valid, see Error
+      public: bool Parse(const std::string &_expression,
+                         const std::vector<std::string> &_inputs);
+
+      /// \brief Get why the last expression couldn't be parsed.
+      /// \return Error message, empty if it was valid
+      public: const std::string &Error() const;
+
+      /// \brief Get whether the expression is a spectrum, whose points
+      /// replace the previous ones instead of being appended.
+      /// \return True if it's an fft
+      public: bool IsSpectrum() const;
+
+      /// \brief Add samples and evaluate the expression.
+      /// \param[in] _samples New samples of each input, as time and value
+      /// in time order. Missing inputs have no new samples.
+      /// \return New points as time and value, or the whole spectrum as
+      /// frequency in Hz and magnitude. The spectrum is only returned if
+      /// it changed and has as many samples as its size. Points whose
+      /// value isn't finite are skipped.
+      public: std::vector<QPointF> Update(
+          const std::vector<std::vector<QPointF>> &_samples);
+
+      /// \brief Clear the samples and the statistics, such as when the
+      /// simulation is reset
+      public: void Reset();
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<DerivedSignalPrivate> dataPtr;
+    };
+  }
+}
+
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+#endif
@@ -17,22 +17,96 @@
 #ifndef GZ_GUI_DRAGDROPMODEL_HH_
 #define GZ_GUI_DRAGDROPMODEL_HH_
 
+#include <memory>
+#include <vector>
+
 #include "gz/gui/Export.hh"
 #include "gz/gui/qt.h"
 
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
 namespace gz
 {
 namespace gui
 {
+  class DragDropMimeDataPrivate;
+
+  /// \brief Dragged row of a DragDropModel
+  struct GZ_GUI_VISIBLE DragDropItem
+  {
+    /// \brief DataRole::URI_QUERY of the row
+    QString uri;
+
+    /// \brief DataRole::TYPE of the row
+    QString type;
+
+    /// \brief DataRole::DISPLAY_NAME of the row
+    QString name;
+  };
+
+  /// \brief MIME data of a drag from a DragDropModel. Drop targets in the
+  /// same process can get the dragged rows with Items, through
+  /// `qobject_cast<const DragDropMimeData *>`, without parsing anything.
+  /// The text formats are only generated if they're requested, such as
+  /// when dropping into another application:
+  ///
+  /// * `application/x-item`: URI of the first row
+  /// * `text/plain`: URIs of all rows, one per line
+  class GZ_GUI_VISIBLE DragDropMimeData : public QMimeData
+  {
+    Q_OBJECT
+
+    /// \brief Constructor
+    /// \param[in] _items Dragged rows
+    public: explicit DragDropMimeData(std::vector<DragDropItem> _items);
+
+    /// \brief Destructor
+    public: ~DragDropMimeData() override;
+
+    /// \brief Get the dragged rows.
+    /// \return Rows, in the order they were selected
+    public: const std::vector<DragDropItem> &Items() const;
+
+    /// \brief Overloaded from Qt.
+    /// \return The text formats, which are generated on demand
+    public: QStringList formats() const override;
+
+    /// \brief Overloaded from Qt.
+    /// \param[in] _mimeType MIME type
+    /// \return True for the formats
+    public: bool hasFormat(const QString &_mimeType) const override;
+
+    /// \brief Overloaded from Qt. Generate a text format.
+    /// \param[in] _mimeType MIME type
+    /// \param[in] _type Type requested by Qt
+    /// \return The data, invalid for other formats
+    protected: QVariant retrieveData(const QString &_mimeType,
+        QVariant::Type _type) const override;
+
+    /// \internal
+    /// \brief Private data pointer
+    private: std::unique_ptr<DragDropMimeDataPrivate> dataPtr;
+  };
+
   /// \brief Customized item model so that we can pass along an URI query as
   /// MIME information during a drag-drop.
   class GZ_GUI_VISIBLE DragDropModel : public QStandardItemModel
   {
     /// \brief Overloaded from Qt. Custom MIME data function.
     /// \param[in] _indexes List of selected items.
-    /// \return Mime data for the selected items.
+    /// \return A DragDropMimeData with a row for each of the selected rows.
     public: QMimeData *mimeData(const QModelIndexList &_indexes) const;
   };
 }
 }
+
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
 #endif
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_GPUMEMORY_HH_
+#define GZ_GUI_GPUMEMORY_HH_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "gz/gui/Export.hh"
+
+namespace gz
+{
+  namespace gui
+  {
+    /// \brief Accounts the GPU memory used by the scene, per plugin and per
+    /// kind of resource, and keeps it within a budget.
+    ///
+    /// Render engines don't report their allocations, so plugins record an
+    /// estimate of each resource they create, under a key of their choice,
+    /// such as a mesh name. Plugins are named like their render hooks,
+    /// usually by their class name, so instances of a plugin share a name
+    /// and should use keys unique to each instance.
+    ///
+    /// Before creating a large resource, a plugin calls Reserve. When the
+    /// resource would exceed the budget, the reclaimers of the other plugins
+    /// are asked to free memory first, for example by dropping old data. If
+    /// the resource still doesn't fit, Reserve fails and the plugin should
+    /// create a cheaper version of the resource, or none, instead of risking
+    /// running out of GPU memory.
+    ///
+    /// Scene plugins record, reserve and reclaim on the render thread, so
+    /// reclaimers are called there. Usage may be read from any thread.
+    class GZ_GUI_VISIBLE GpuMemory
+    {
+      /// \brief Kind of resource
+      public: enum class Resource
+      {
+        /// \brief Vertex and index buffers of meshes
+        kMeshes = 0,
+
+        /// \brief Textures and render targets
+        kTextures = 1,
+
+        /// \brief Geometry of markers
+        kMarkers = 2,
+
+        /// \brief Buffers of point clouds
+        kPoints = 3
+      };
+
+      /// \brief Number of kinds of resources
+      public: static constexpr std::size_t kResourceCount = 4;
+
+      /// \brief Memory used by a plugin
+      public: struct Usage
+      {
+        /// \brief Name of the plugin
+        std::string name;
+
+        /// \brief Bytes, per kind of resource
+        std::array<uint64_t, kResourceCount> bytes{};
+
+        /// \brief Get the bytes used by all kinds of resources
+        /// \return Bytes
+        uint64_t TotalBytes() const;
+      };
+
+      /// \brief Frees memory for another plugin's resource. The resources
+      /// freed must be released, or recorded again with their new size,
+      /// before it returns.
+      /// \param[in] _bytes Bytes which would have to be freed for the
+      /// resource to fit in the budget
+      public: using Reclaimer = std::function<void(uint64_t _bytes)>;
+
+      /// \brief Record the size of a resource, replacing the previous
+      /// record with the same key, regardless of the budget.
+      /// \param[in] _name Name of the plugin owning the resource
+      /// \param[in] _resource Kind of resource
+      /// \param[in] _key Key of the resource, unique to the plugin and kind
+      /// \param[in] _bytes Estimated size in bytes; 0 releases it
+      public: static void Record(const std::string &_name,
+                                 Resource _resource, const std::string &_key,
+                                 uint64_t _bytes);
+
+      /// \brief Record the size of a resource about to be created if it
+      /// fits in the budget, reclaiming memory from other plugins if it
+      /// doesn't.
+      /// \param[in] _name Name of the plugin owning the resource
+      /// \param[in] _resource Kind of resource
+      /// \param[in] _key Key of the resource, unique to the plugin and kind.
+      /// Its previous size counts as available.
+      /// \param[in] _bytes Estimated size in bytes
+      /// \return True if it fits and was recorded. False if it doesn't fit,
+      /// the previous record is then kept.
+      public: static bool Reserve(const std::string &_name,
+                                  Resource _resource, const std::string &_key,
+                                  uint64_t _bytes);
+
+      /// \brief Release a resource.
+      /// \param[in] _name Name of the plugin owning the resource
+      /// \param[in] _resource Kind of resource
+      /// \param[in] _key Key of the resource
+      public: static void Release(const std::string &_name,
+                                  Resource _resource, const std::string &_key);
+
+      /// \brief Release all the resources recorded under a name.
+      /// \param[in] _name Name of the plugin
+      public: static void ReleaseAll(const std::string &_name);
+
+      /// \brief Add a function called to free memory of a plugin, when
+      /// another plugin reserves memory. Reclaimers of the plugin reserving
+      /// memory aren't called.
+      /// \param[in] _name Name of the plugin
+      /// \param[in] _reclaimer Function
+      /// \return Identifier to remove it, 0 if the function is null
+      public: static uint64_t AddReclaimer(const std::string &_name,
+                                           Reclaimer _reclaimer);
+
+      /// \brief Remove a reclaimer. Waits for reclaimers which are being
+      /// called, so the function can't be called once this returns.
+      /// \param[in] _id Identifier returned by AddReclaimer
+      public: static void RemoveReclaimer(uint64_t _id);
+
+      /// \brief Set the budget.
+      /// \param[in] _bytes Maximum bytes of all resources, 0 for no limit
+      public: static void SetBudget(uint64_t _bytes);
+
+      /// \brief Get the budget.
+      /// \return Maximum bytes of all resources, 0 for no limit
+      public: static uint64_t Budget();
+
+      /// \brief Get the bytes used by all resources.
+      /// \return Bytes
+      public: static uint64_t TotalBytes();
+
+      /// \brief Get the bytes which can still be reserved without
+      /// reclaiming memory.
+      /// \return Bytes, the maximum value if there's no budget
+      public: static uint64_t AvailableBytes();
+
+      /// \brief Get the memory used by each plugin.
+      /// \return Usage per plugin, the largest first
+      public: static std::vector<Usage> CurrentUsage();
+
+      /// \brief Get the name of a kind of resource.
+      /// \param[in] _resource Kind of resource
+      /// \return Name, such as "meshes"
+      public: static std::string ResourceName(Resource _resource);
+    };
+  }
+}
+
+#endif  // GZ_GUI_GPUMEMORY_HH_
@@ -18,8 +18,12 @@
 #define GZ_GUI_GUIEVENTS_HH_
 
 #include <QEvent>
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -486,6 +490,192 @@ namespace gz
         /// \brief Private data pointer
         GZ_UTILS_IMPL_PTR(dataPtr)
       };
+
+      /// \brief Event used to notify 3D scenes that something in the scene
+      /// changed and needs to be rendered. Scenes which skip rendering
+      /// unchanged frames rely on this event to know when to render again.
+      /// It can be sent from the render thread or posted from any thread.
+      class GZ_GUI_VISIBLE SceneChanged : public QEvent
+      {
+        /// \brief Constructor
+        public: SceneChanged();
+
+        /// \brief Unique type for this event.
+        static const QEvent::Type kType = QEvent::Type(QEvent::MaxUser - 21);
+
+        /// \internal
+        /// \brief Private data pointer
+        GZ_UTILS_IMPL_PTR(dataPtr)
+      };
+
+      /// \brief Event sent when a 3D scene stops rendering because it isn't
+      /// visible, such as when it's in a collapsed card, on another tab or
+      /// in a minimized window, and again when it's visible and rendering
+      /// resumes. Plugins can pause work which is only needed to render,
+      /// no PreRender events are sent while suspended.
+      class GZ_GUI_VISIBLE RenderSuspended : public QEvent
+      {
+        /// \brief Constructor
+        /// \param[in] _suspended True if rendering stopped, false if it
+        /// resumed
+        public: explicit RenderSuspended(bool _suspended);
+
+        /// \brief Unique type for this event.
+        static const QEvent::Type kType = QEvent::Type(QEvent::MaxUser - 22);
+
+        /// \brief Get whether rendering stopped or resumed.
+        /// \return True if rendering stopped, false if it resumed
+        public: bool Suspended() const;
+
+        /// \internal
+        /// \brief Private data pointer
+        GZ_UTILS_IMPL_PTR(dataPtr)
+      };
+
+      /// \brief Event sent while a scene manager loads a scene, so 3D
+      /// scenes can show the progress over the view. It's posted from the
+      /// render thread.
+      class GZ_GUI_VISIBLE SceneLoadProgress : public QEvent
+      {
+        /// \brief Constructor
+        /// \param[in] _progress Fraction of the models and lights loaded,
+        /// from 0 to 1
+        /// \param[in] _placeholders Number of visuals showing boxes until
+        /// their meshes are decoded
+        public: SceneLoadProgress(double _progress,
+            unsigned int _placeholders);
+
+        /// \brief Unique type for this event.
+        static const QEvent::Type kType = QEvent::Type(QEvent::MaxUser - 23);
+
+        /// \brief Get the fraction of the models and lights loaded.
+        /// \return From 0 to 1, 1 once they're all loaded
+        public: double Progress() const;
+
+        /// \brief Get the number of visuals waiting for their meshes.
+        /// \return Number of visuals showing boxes
+        public: unsigned int Placeholders() const;
+
+        /// \internal
+        /// \brief Private data pointer
+        GZ_UTILS_IMPL_PTR(dataPtr)
+      };
+
+      /// \brief Combines lambdas into a single handler for Dispatcher, with
+      /// one overload of operator() per lambda.
+      template <typename... Lambdas>
+      struct Handlers : Lambdas...
+      {
+        using Lambdas::operator()...;
+      };
+
+      /// \brief Deduction guide, so Handlers{[](A &){}, [](B &){}} works
+      template <typename... Lambdas>
+      Handlers(Lambdas...) -> Handlers<Lambdas...>;
+
+      /// \brief Calls the handler of an event out of a fixed list of event
+      /// types, with the event cast to its class. The handlers are looked up
+      /// in a table indexed by the event type, which is built at compile
+      /// time, so dispatching costs the same regardless of the number of
+      /// types, instead of one comparison per type.
+      ///
+      /// Example, in a plugin's eventFilter:
+      ///
+      ///     using Events = events::Dispatcher<events::PreRender,
+      ///                                       events::HoverOnScene>;
+      ///     Events::Dispatch(_event, events::Handlers{
+      ///         [&](events::PreRender &) { this->OnPreRender(); },
+      ///         [&](events::HoverOnScene &_e) { this->OnHover(_e); }});
+      ///
+      /// Events::kTypes lists the types, to subscribe to them.
+      ///
+      /// \tparam Events Event classes with a unique kType, such as the ones
+      /// in this file. Their types must be within 256 of each other.
+      template <typename... Events>
+      class Dispatcher
+      {
+        static_assert(sizeof...(Events) > 0, "No event types");
+
+        /// \brief Types of the events, in the order given
+        public: static constexpr std::array<QEvent::Type, sizeof...(Events)>
+            kTypes{{Events::kType...}};
+
+        /// \brief Smallest event type, which is the first entry in the table
+        private: static constexpr int kMin =
+            std::min({static_cast<int>(Events::kType)...});
+
+        /// \brief Number of entries in the table
+        private: static constexpr std::size_t kSize = static_cast<std::size_t>(
+            std::max({static_cast<int>(Events::kType)...}) - kMin + 1);
+
+        static_assert(kSize <= 256,
+            "Event types are too far apart for a dispatch table");
+
+        /// \brief Get whether all event types are different
+        /// \return True if no type is repeated
+        private: static constexpr bool Unique()
+        {
+          for (std::size_t i = 0; i < kTypes.size(); ++i)
+          {
+            for (std::size_t j = i + 1; j < kTypes.size(); ++j)
+            {
+              if (kTypes[i] == kTypes[j])
+                return false;
+            }
+          }
+          return true;
+        }
+
+        /// \brief Entry of the table, which calls the handler with the
+        /// event cast to one of the classes
+        private: template <typename Handler>
+        using Entry = void (*)(Handler &, QEvent *);
+
+        /// \brief Call the handler with the event cast to its class
+        /// \param[in] _handler Handler to call
+        /// \param[in] _event Event whose type is Event::kType
+        private: template <typename Handler, typename Event>
+        static void Call(Handler &_handler, QEvent *_event)
+        {
+          _handler(*static_cast<Event *>(_event));
+        }
+
+        /// \brief Build the table, entries between the types are null
+        /// \return Table indexed by event type minus kMin
+        private: template <typename Handler>
+        static constexpr std::array<Entry<Handler>, kSize> Table()
+        {
+          static_assert(Unique(), "Event types must be unique");
+
+          std::array<Entry<Handler>, kSize> table{};
+          ((table[static_cast<std::size_t>(
+              static_cast<int>(Events::kType) - kMin)] =
+              &Dispatcher::Call<Handler, Events>), ...);
+          return table;
+        }
+
+        /// \brief Call the handler of the event, if its type is one of
+        /// Events.
+        /// \param[in] _event Event received, such as by eventFilter
+        /// \param[in] _handler Callable with a reference to each of Events,
+        /// such as Handlers or a generic lambda
+        /// \return True if the event was one of Events and was handled
+        public: template <typename Handler>
+        static bool Dispatch(QEvent *_event, Handler &&_handler)
+        {
+          using HandlerType = std::remove_reference_t<Handler>;
+          static constexpr auto table = Table<HandlerType>();
+
+          // Unsigned, so types below kMin are out of range too
+          auto index = static_cast<std::size_t>(
+              static_cast<int>(_event->type()) - kMin);
+          if (index >= kSize || table[index] == nullptr)
+            return false;
+
+          table[index](_handler, _event);
+          return true;
+        }
+      };
     }
   }
 }
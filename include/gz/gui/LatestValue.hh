@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_LATESTVALUE_HH_
+#define GZ_GUI_LATESTVALUE_HH_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "gz/gui/PluginStats.hh"
+#include "gz/gui/qt.h"
+
+namespace gz
+{
+  namespace gui
+  {
+    /// \brief Passes the latest value of something updated from another
+    /// thread, such as a message received by a Gazebo Transport callback,
+    /// to the thread of a QObject, usually the GUI thread.
+    ///
+    /// Values set while the previous one wasn't delivered yet replace it,
+    /// so there's at most one call queued on the receiver's thread, however
+    /// fast values arrive, and the receiver handles only the newest value
+    /// once per iteration of its event loop. It's meant for plugins which
+    /// display the latest state of a topic. Plugins which need every
+    /// message, such as plots, shouldn't use it.
+    ///
+    /// Set may be called from any thread. The callback is called on the
+    /// receiver's thread, and not anymore once the LatestValue is destroyed
+    /// on that thread. Set mustn't be called during or after destruction,
+    /// so it should be declared before the transport node which calls Set,
+    /// and destroyed after it.
+    ///
+    /// The time spent in the callback is accounted to the receiver's plugin
+    /// by PluginStats.
+    template <typename T>
+    class LatestValue
+    {
+      /// \brief Function called on the receiver's thread
+      public: using Callback = std::function<void(const T &)>;
+
+      /// \brief Constructor
+      /// \param[in] _receiver Object on whose thread the callback is called.
+      /// It must outlive this.
+      /// \param[in] _callback Function called with the latest value
+      public: LatestValue(QObject *_receiver, Callback _callback)
+        : receiver(_receiver), state(std::make_shared<State>())
+      {
+        this->state->callback = std::move(_callback);
+      }
+
+      /// \brief Destructor, values which weren't delivered are dropped
+      public: ~LatestValue()
+      {
+        std::lock_guard<std::mutex> lock(this->state->mutex);
+        this->state->stopped = true;
+      }
+
+      /// \brief Deleted copy constructor
+      public: LatestValue(const LatestValue &) = delete;
+
+      /// \brief Deleted copy assignment
+      public: LatestValue &operator=(const LatestValue &) = delete;
+
+      /// \brief Set the latest value, to be delivered on the receiver's
+      /// thread. Safe to call from any thread.
+      /// \param[in] _value New value
+      public: void Set(T _value)
+      {
+        std::lock_guard<std::mutex> lock(this->state->mutex);
+        if (this->state->stopped)
+          return;
+
+        if (this->state->hasValue)
+          ++this->state->replaced;
+        this->state->value = std::move(_value);
+        this->state->hasValue = true;
+        if (this->state->queued)
+          return;
+        this->state->queued = true;
+
+        // The state is shared, so a call still queued when this is
+        // destroyed finds it stopped
+        auto state = this->state;
+        auto receiver = this->receiver;
+        QMetaObject::invokeMethod(this->receiver, [state, receiver]
+        {
+          T value;
+          {
+            std::lock_guard<std::mutex> stateLock(state->mutex);
+            state->queued = false;
+            if (state->stopped || !state->hasValue)
+              return;
+            value = std::move(state->value);
+            state->hasValue = false;
+          }
+          PluginStats::Scope stats(receiver, PluginStats::Source::kTransport);
+          state->callback(value);
+        }, Qt::QueuedConnection);
+      }
+
+      /// \brief Get the number of values replaced by a newer one before
+      /// being delivered.
+      /// \return Number of replaced values
+      public: uint64_t Replaced() const
+      {
+        std::lock_guard<std::mutex> lock(this->state->mutex);
+        return this->state->replaced;
+      }
+
+      /// \brief State shared with the queued call
+      private: struct State
+      {
+        /// \brief Protects everything
+        std::mutex mutex;
+
+        /// \brief Latest value, if hasValue
+        T value;
+
+        /// \brief True if value wasn't delivered yet
+        bool hasValue{false};
+
+        /// \brief True while a call is queued on the receiver's thread
+        bool queued{false};
+
+        /// \brief True once destroyed
+        bool stopped{false};
+
+        /// \brief Number of values replaced before being delivered
+        uint64_t replaced{0u};
+
+        /// \brief Function called with the latest value
+        Callback callback;
+      };
+
+      /// \brief Object on whose thread the callback is called
+      private: QObject *receiver{nullptr};
+
+      /// \brief State shared with the queued call
+      private: std::shared_ptr<State> state;
+    };
+  }
+}
+
+#endif  // GZ_GUI_LATESTVALUE_HH_
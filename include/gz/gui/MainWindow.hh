@@ -17,12 +17,15 @@
 #ifndef GZ_GUI_MAINWINDOW_HH_
 #define GZ_GUI_MAINWINDOW_HH_
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
+#include <tinyxml2.h>
+
 #include <gz/common/Console.hh>
 
 #include "gz/gui/qt.h"
@@ -258,10 +261,32 @@ namespace gz
 
       /// \brief Save current window and plugin configuration to a file on disk.
       /// Will open an error dialog in case it's not possible to write to the
-      /// path.
+      /// path. The file is replaced atomically, so it's never left partially
+      /// written.
       /// \param[in] _path The full destination path including filename.
+      /// \sa SaveConfigAsync
       public: void SaveConfig(const std::string &_path);
 
+      /// \brief Same as SaveConfig, but only the plugins' configurations are
+      /// collected on the calling thread. The XML is serialized and written
+      /// on a save thread, and configSaved is emitted once it's done. Saves
+      /// are written in the order they're requested, and the ones still
+      /// queued when the window is destroyed are written before.
+      /// \param[in] _path The full destination path including filename.
+      public: void SaveConfigAsync(const std::string &_path);
+
+      /// \brief Save the configuration to the default config path
+      /// periodically, on the save thread. The file is only rewritten when
+      /// its contents would change.
+      /// \param[in] _period Time between saves, zero to disable autosave,
+      /// which is the default
+      /// \sa Application::DefaultConfigPath
+      public: void SetAutosavePeriod(std::chrono::milliseconds _period);
+
+      /// \brief Get the time between autosaves.
+      /// \return Period, zero if autosave is disabled
+      public: std::chrono::milliseconds AutosavePeriod() const;
+
       /// \brief Apply a WindowConfig to this window and keep a copy of it.
       /// \param[in] _config The configuration to apply.
       /// \return True if successful.
@@ -279,7 +304,8 @@ namespace gz
       /// \param [in] _plugin Plugin filename
       public slots: void OnAddPlugin(QString _plugin);
 
-      /// \brief Return a list of all plugin names found
+      /// \brief Return a list of all plugin names found. It's computed once
+      /// and again after the config or Application::PluginList changes.
       /// \return List with plugin names
       public: Q_INVOKABLE QStringList PluginListModel() const;
 
@@ -488,6 +514,33 @@ namespace gz
       public: Q_INVOKABLE void SetServerControlService(
         const std::string &_service);
 
+      /// \brief Have an object's eventFilter called for the events of one
+      /// type which are sent to the main window, such as
+      /// events::Render::kType. Unlike installing an event filter, which is
+      /// called for every event, the object is only called for the types it
+      /// subscribed to, so the cost of an event depends on the plugins
+      /// interested in it. Subscribers are called in subscription order,
+      /// after the event filters, with the main window as the watched
+      /// object. Returning true from eventFilter stops the event. They're
+      /// unsubscribed when destroyed.
+      /// \param[in] _type Event type
+      /// \param[in] _subscriber Object to call
+      public: void SubscribeEvent(QEvent::Type _type, QObject *_subscriber);
+
+      /// \brief Stop calling an object for events of a type.
+      /// \param[in] _type Event type
+      /// \param[in] _subscriber Object passed to SubscribeEvent
+      public: void UnsubscribeEvent(QEvent::Type _type,
+          QObject *_subscriber);
+
+      /// \brief Get the number of objects subscribed to a type of event.
+      /// \param[in] _type Event type
+      /// \return Number of subscribers
+      public: std::size_t EventSubscriberCount(QEvent::Type _type) const;
+
+      // Documentation inherited
+      protected: bool event(QEvent *_event) override;
+
       /// \brief Callback when load configuration is selected
       public slots: void OnLoadConfig(const QString &_path);
 
@@ -583,6 +636,18 @@ namespace gz
       /// appear
       signals: void notifyWithDuration(const QString &_message, int _duration);
 
+      /// \brief Notifies that a config was saved.
+      /// \param[in] _path Path of the file
+      /// \param[in] _written False if it was an autosave which found the file
+      /// up to date
+      signals: void configSaved(const QString &_path, bool _written);
+
+      /// \brief Queue a config save, see SaveConfigAsync.
+      /// \param[in] _path The full destination path including filename.
+      /// \param[in] _onlyIfChanged Skip writing if the file wouldn't change
+      private: void SaveConfigAsync(const std::string &_path,
+          bool _onlyIfChanged);
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<MainWindowPrivate> dataPtr;
@@ -598,6 +663,13 @@ namespace gz
       /// can't be parsed into XML.
       bool MergeFromXML(const std::string &_xml);
 
+      /// \brief Update this config from a <window> element, in a single
+      /// pass over its children. Unknown and repeated children are reported
+      /// and ignored, except for those which may be repeated.
+      /// \param[in] _windowElem The <window> element
+      /// \return True if successful, false if the element is null.
+      bool MergeFromXML(const tinyxml2::XMLElement *_windowElem);
+
       /// \brief Return this configuration in XML format as a string.
       /// \return String containing a complete config file.
       std::string XMLString() const;
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_MESSAGEPOOL_HH_
+#define GZ_GUI_MESSAGEPOOL_HH_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/transport/MessageInfo.hh>
+#include <gz/transport/Node.hh>
+
+namespace gz
+{
+  namespace gui
+  {
+    /// \brief Recycles the protobuf messages of a high rate topic, so
+    /// receiving a message doesn't allocate it, nor its strings and
+    /// repeated fields, which keep their capacity when the message is
+    /// parsed again.
+    ///
+    /// Gazebo Transport creates a new message for every callback, which
+    /// plugins then copy to keep it. Subscribing through the pool instead
+    /// parses the raw bytes straight into a recycled message, which the
+    /// plugin keeps without copying. Messages go back to the pool once
+    /// the last shared pointer to them is released, on any thread, and
+    /// are deleted instead if the pool is full or destroyed.
+    ///
+    /// Acquire, Parse and the subscription callback may be called from
+    /// any thread.
+    template <typename T>
+    class MessagePool
+    {
+      /// \brief Function called with each message received
+      public: using Callback = std::function<void(std::shared_ptr<T>)>;
+
+      /// \brief Constructor
+      /// \param[in] _capacity Number of released messages kept for reuse.
+      /// It should be the number of messages a plugin holds at once, plus
+      /// one being received.
+      public: explicit MessagePool(std::size_t _capacity = 4u)
+        : state(std::make_shared<State>())
+      {
+        this->state->capacity = _capacity;
+      }
+
+      /// \brief Destructor, messages still in use are deleted once released
+      public: ~MessagePool() = default;
+
+      /// \brief Deleted copy constructor
+      public: MessagePool(const MessagePool &) = delete;
+
+      /// \brief Deleted copy assignment
+      public: MessagePool &operator=(const MessagePool &) = delete;
+
+      /// \brief Get a message, recycled if one is available.
+      /// \return Message, never null. A recycled message still holds its
+      /// previous content, so it should be cleared or parsed into.
+      public: std::shared_ptr<T> Acquire()
+      {
+        return Acquire(this->state);
+      }
+
+      /// \brief Parse a serialized message into a recycled message.
+      /// \param[in] _data Serialized message
+      /// \param[in] _size Size of _data in bytes
+      /// \return Message, or null if _data isn't a valid message
+      public: std::shared_ptr<T> Parse(const char *_data, std::size_t _size)
+      {
+        return Parse(this->state, _data, _size);
+      }
+
+      /// \brief Subscribe to a topic, parsing its messages into recycled
+      /// messages. The callback is called on the transport thread, like
+      /// the callback of transport::Node::Subscribe. Messages which fail
+      /// to parse are dropped with an error.
+      /// \param[in] _node Node to subscribe with
+      /// \param[in] _topic Topic name
+      /// \param[in] _callback Function called with each message
+      /// \return True if subscribed
+      public: bool Subscribe(transport::Node &_node,
+                             const std::string &_topic, Callback _callback,
+                             const transport::SubscribeOptions &_opts =
+                                 transport::SubscribeOptions())
+      {
+        // The state is shared, so messages still arriving while the pool is
+        // destroyed are parsed safely
+        auto pool = this->state;
+        auto cb = [pool, _topic, _callback](const char *_data,
+            const size_t _size, const transport::MessageInfo &)
+        {
+          auto msg = Parse(pool, _data, _size);
+          if (!msg)
+          {
+            gzerr << "Failed to parse message of type ["
+                  << T().GetTypeName() << "] on [" << _topic << "]"
+                  << std::endl;
+            return;
+          }
+          _callback(std::move(msg));
+        };
+        return _node.SubscribeRaw(_topic, cb, T().GetTypeName(), _opts);
+      }
+
+      /// \brief Get the number of messages created by the pool, which
+      /// stops growing once enough are recycled.
+      /// \return Number of messages created
+      public: std::size_t Allocated() const
+      {
+        std::lock_guard<std::mutex> lock(this->state->mutex);
+        return this->state->allocated;
+      }
+
+      /// \brief Get the number of released messages ready for reuse
+      /// \return Number of free messages
+      public: std::size_t Available() const
+      {
+        std::lock_guard<std::mutex> lock(this->state->mutex);
+        return this->state->free.size();
+      }
+
+      /// \brief State shared with the messages in use and the subscription
+      private: struct State
+      {
+        /// \brief Protects everything
+        std::mutex mutex;
+
+        /// \brief Released messages
+        std::vector<std::unique_ptr<T>> free;
+
+        /// \brief Maximum size of free
+        std::size_t capacity{0u};
+
+        /// \brief Number of messages created
+        std::size_t allocated{0u};
+      };
+
+      /// \brief Get a message from the state, see Acquire
+      /// \param[in] _state Pool state
+      /// \return Message, never null
+      private: static std::shared_ptr<T> Acquire(
+          const std::shared_ptr<State> &_state)
+      {
+        std::unique_ptr<T> msg;
+        {
+          std::lock_guard<std::mutex> lock(_state->mutex);
+          if (!_state->free.empty())
+          {
+            msg = std::move(_state->free.back());
+            _state->free.pop_back();
+          }
+          else
+          {
+            ++_state->allocated;
+          }
+        }
+        if (!msg)
+          msg = std::make_unique<T>();
+
+        // Only a weak reference, so the pool isn't kept alive by its
+        // messages
+        std::weak_ptr<State> weak = _state;
+        return std::shared_ptr<T>(msg.release(), [weak](T *_msg)
+        {
+          std::unique_ptr<T> released(_msg);
+          auto pool = weak.lock();
+          if (!pool)
+            return;
+
+          std::lock_guard<std::mutex> lock(pool->mutex);
+          if (pool->free.size() < pool->capacity)
+            pool->free.push_back(std::move(released));
+        });
+      }
+
+      /// \brief Parse into a message from the state, see Parse
+      /// \param[in] _state Pool state
+      /// \param[in] _data Serialized message
+      /// \param[in] _size Size of _data in bytes
+      /// \return Message, or null if _data isn't a valid message
+      private: static std::shared_ptr<T> Parse(
+          const std::shared_ptr<State> &_state, const char *_data,
+          std::size_t _size)
+      {
+        auto msg = Acquire(_state);
+        if (!msg->ParseFromArray(_data, static_cast<int>(_size)))
+          return nullptr;
+        return msg;
+      }
+
+      /// \brief State shared with the messages in use and the subscription
+      private: std::shared_ptr<State> state;
+    };
+  }
+}
+
+#endif  // GZ_GUI_MESSAGEPOOL_HH_
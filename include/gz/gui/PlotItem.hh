@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLOTITEM_HH_
+#define GZ_GUI_PLOTITEM_HH_
+
+#include <QColor>
+#include <QQuickItem>
+#include <QString>
+#include <QVariantList>
+
+#include <memory>
+
+#include "gz/gui/Export.hh"
+
+namespace gz
+{
+namespace gui
+{
+class PlotItemPrivate;
+
+/// \brief Item drawing line series in the scene graph, used by the charts
+/// of the plotting interface to draw topic fields.
+///
+/// Points are stored in chunks, each uploaded once to its own geometry,
+/// so appending points only updates the last chunk. The visible range is
+/// applied as a transform, so scrolling and zooming don't touch the
+/// points. When zoomed out so that a chunk has many points per pixel,
+/// it's drawn from the minimum and maximum of groups of points instead,
+/// which each chunk keeps in a min/max pyramid updated as points are
+/// appended. Chunks outside of the range aren't drawn, so the number of
+/// vertices depends on the width of the item rather than on the length of
+/// the history, and long histories can be kept with a large maxPoints.
+///
+/// The range is given in data coordinates by xMin, xMax, yMin and yMax,
+/// and is drawn across the whole item.
+class GZ_GUI_VISIBLE PlotItem : public QQuickItem
+{
+  Q_OBJECT
+
+  /// \brief Smallest x shown, at the left of the item
+  Q_PROPERTY(
+    double xMin
+    READ XMin
+    WRITE SetXMin
+    NOTIFY RangeChanged
+  )
+
+  /// \brief Largest x shown, at the right of the item
+  Q_PROPERTY(
+    double xMax
+    READ XMax
+    WRITE SetXMax
+    NOTIFY RangeChanged
+  )
+
+  /// \brief Smallest y shown, at the bottom of the item
+  Q_PROPERTY(
+    double yMin
+    READ YMin
+    WRITE SetYMin
+    NOTIFY RangeChanged
+  )
+
+  /// \brief Largest y shown, at the top of the item
+  Q_PROPERTY(
+    double yMax
+    READ YMax
+    WRITE SetYMax
+    NOTIFY RangeChanged
+  )
+
+  /// \brief Number of points kept per series, the oldest ones are removed
+  /// a chunk at a time beyond it
+  Q_PROPERTY(
+    int maxPoints
+    READ MaxPoints
+    WRITE SetMaxPoints
+    NOTIFY MaxPointsChanged
+  )
+
+  /// \brief Constructor
+  /// \param[in] _parent Parent item
+  public: explicit PlotItem(QQuickItem *_parent = nullptr);
+
+  /// \brief Destructor
+  public: ~PlotItem() override;
+
+  /// \brief Add a series, or change the color of an existing one.
+  /// \param[in] _id Series ID
+  /// \param[in] _color Line color
+  public: Q_INVOKABLE void addSeries(const QString &_id,
+                                     const QColor &_color);
+
+  /// \brief Remove a series and its points.
+  /// \param[in] _id Series ID
+  public: Q_INVOKABLE void removeSeries(const QString &_id);
+
+  /// \brief Append points to a series.
+  /// \param[in] _id Series ID
+  /// \param[in] _points Points as QPointF, in increasing x
+  public: Q_INVOKABLE void appendPoints(const QString &_id,
+                                        const QVariantList &_points);
+
+  /// \brief Get the number of points of a series.
+  /// \param[in] _id Series ID
+  /// \return Number of points, 0 if there's no such series
+  public: Q_INVOKABLE int pointCount(const QString &_id) const;
+
+  /// \brief Get the smallest x shown
+  /// \return Smallest x
+  public: double XMin() const;
+
+  /// \brief Set the smallest x shown
+  /// \param[in] _value Smallest x
+  public: void SetXMin(double _value);
+
+  /// \brief Get the largest x shown
+  /// \return Largest x
+  public: double XMax() const;
+
+  /// \brief Set the largest x shown
+  /// \param[in] _value Largest x
+  public: void SetXMax(double _value);
+
+  /// \brief Get the smallest y shown
+  /// \return Smallest y
+  public: double YMin() const;
+
+  /// \brief Set the smallest y shown
+  /// \param[in] _value Smallest y
+  public: void SetYMin(double _value);
+
+  /// \brief Get the largest y shown
+  /// \return Largest y
+  public: double YMax() const;
+
+  /// \brief Set the largest y shown
+  /// \param[in] _value Largest y
+  public: void SetYMax(double _value);
+
+  /// \brief Get the number of points kept per series
+  /// \return Maximum number of points
+  public: int MaxPoints() const;
+
+  /// \brief Set the number of points kept per series
+  /// \param[in] _maxPoints Maximum number of points
+  public: void SetMaxPoints(int _maxPoints);
+
+  /// \brief Notify that the range changed
+  signals: void RangeChanged();
+
+  /// \brief Notify that the maximum number of points changed
+  signals: void MaxPointsChanged();
+
+  // Documentation inherited
+  protected: QSGNode *updatePaintNode(QSGNode *_oldNode,
+      QQuickItem::UpdatePaintNodeData *_data) override;
+
+  /// \internal
+  /// \brief Pointer to private data.
+  private: std::unique_ptr<PlotItemPrivate> dataPtr;
+};
+}
+}
+
+#endif
@@ -18,7 +18,9 @@
 #define GZ_GUI_PLOTTINGINTERFACE_HH_
 
 #include <QObject>
+#include <QPointF>
 #include <QString>
+#include <QStringList>
 #include <QMap>
 #include <QVariant>
 #ifdef _MSC_VER
@@ -30,11 +32,15 @@
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <ostream>
 #include <set>
 #include <string>
 #include <memory>
 #include <limits>
+#include <vector>
 
 #include "gz/gui/Export.hh"
 
@@ -125,10 +131,43 @@ class GZ_GUI_VISIBLE Topic : public QObject
   /// \return Map of fields to their plots
   public: std::map<std::string, PlotData *> &Fields();
 
-  /// \brief Callback to receive messages
+  /// \brief Callback to receive messages. The values of the fields are
+  /// buffered until the next call to Flush.
   /// \param[in] _msg the published msg from the topic
   public: void Callback(const google::protobuf::Message &_msg);
 
+  /// \brief Send the values received since the last call to the charts
+  /// with plotPoints, reduced to their minimum and maximum over short
+  /// intervals. Must be called from the thread that registers fields.
+  /// Negative charts are inputs of derived series, which aren't sent.
+  public: void Flush();
+
+  /// \brief Set how many samples are recorded for each field. Every
+  /// sample received is recorded, the oldest being overwritten once there
+  /// are as many. Clears the recorded samples.
+  /// \param[in] _size Maximum number of samples per field
+  public: void SetHistorySize(std::size_t _size);
+
+  /// \brief Write the recorded samples of a field as CSV rows of time and
+  /// value, oldest first. The samples are copied a few at a time, so
+  /// messages keep being received while writing.
+  /// \param[in] _fieldPath field path ID
+  /// \param[in] _out stream to write to
+  /// \return False if the field isn't registered or writing failed
+  public: bool WriteHistory(const std::string &_fieldPath,
+                            std::ostream &_out) const;
+
+  /// \brief Copy the recorded samples of a field from a sample on.
+  /// \param[in] _fieldPath field path ID
+  /// \param[in] _from Index of the first sample, counting all the
+  /// samples ever recorded. Samples already overwritten are skipped.
+  /// \param[out] _samples Samples appended to, oldest first
+  /// \return Index of the sample after the last one copied, _from if the
+  /// field isn't registered
+  public: uint64_t CopyHistory(const std::string &_fieldPath,
+                               uint64_t _from,
+                               std::vector<QPointF> &_samples) const;
+
   /// \brief Check if msg has header field and get its time
   /// \param[in] _msg msg to check its header
   /// \param[out] _headerTime header sim time
@@ -146,10 +185,25 @@ class GZ_GUI_VISIBLE Topic : public QObject
   /// \param[in] _y y coordinates of the plot point
   signals: void plot(int _chart, QString _fieldID, double _x, double _y);
 
+  /// \brief plot the values of a field received since the last flush
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \param[in] _points points of the plot, as QPointF in time order
+  signals: void plotPoints(int _chart, QString _fieldID,
+                           QVariantList _points);
+
   /// \brief update the current time with the default time of the plotting timer
   /// \param[in] _time current time of the plotting timer
   public: void SetPlottingTimeRef(const std::shared_ptr<double> &_time);
 
+  /// \brief Set the clock giving the time of messages without a header.
+  /// It's called on the transport thread as each message arrives, instead
+  /// of reading the plotting time ref, which is only updated as often as
+  /// the GUI thread runs.
+  /// \param[in] _clock Thread safe function returning the current time,
+  /// null to use the plotting time ref again
+  public: void SetPlottingClock(const std::function<double()> &_clock);
+
   /// \brief Private data member.
   private: std::unique_ptr<TopicPrivate> dataPtr;
 };
@@ -187,10 +241,29 @@ class GZ_GUI_VISIBLE Transport : public QObject
   /// \brief Unsubscribe from non-exist topics in the transport
   public slots: void UnsubscribeOutdatedTopics();
 
+  /// \brief Send the values buffered by all topics to the charts
+  public slots: void Flush();
+
+  /// \brief Set how many samples are recorded for each field of all
+  /// topics, see Topic::SetHistorySize
+  /// \param[in] _size Maximum number of samples per field
+  public: void SetHistorySize(std::size_t _size);
+
   /// \brief Get the registered topics
   /// \return Topics list
   public: const std::map<std::string, Topic*> &Topics();
 
+  /// \brief Set the clock of all topics, see Topic::SetPlottingClock
+  /// \param[in] _clock Thread safe function returning the current time
+  public: void SetPlottingClock(const std::function<double()> &_clock);
+
+  /// \brief Get the number of topic handlers receiving a topic, across
+  /// all transports of the process. Each topic is subscribed to once for
+  /// the process and its messages are passed to every handler.
+  /// \param[in] _topic topic name
+  /// \return Number of handlers, 0 if the topic isn't subscribed to
+  public: static int SubscriberCount(const std::string &_topic);
+
   /// \brief Slot for receiving topics signal at each topic callback to plot
   /// \param[in] _chart chart ID
   /// \param[in] _fieldID field path ID
@@ -205,6 +278,13 @@ class GZ_GUI_VISIBLE Transport : public QObject
   /// \param[in] _y y coordinates of the plot point
   signals: void plot(int _chart, QString _fieldID, double _x, double _y);
 
+  /// \brief notify the Plotting Interface to plot several points
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \param[in] _points points of the plot, as QPointF in time order
+  signals: void plotPoints(int _chart, QString _fieldID,
+                           QVariantList _points);
+
   /// \brief Private data member.
   private: std::unique_ptr<TransportPrivate> dataPtr;
 };
@@ -259,6 +339,14 @@ class GZ_GUI_VISIBLE PlottingInterface : public QObject
   /// \param[in] _y y coordinates of the plot point
   signals: void plot(int _chart, QString _fieldID, double _x, double _y);
 
+  /// \brief plot several points of a topic field to a chart, sent once
+  /// per UI frame
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID field path ID
+  /// \param[in] _points points of the plot, as QPointF in time order
+  signals: void plotPoints(int _chart, QString _fieldID,
+                           QVariantList _points);
+
   /// \brief called by Qml to register a chart to a component attribute
   /// \param[in] _entity entity id which has the component
   /// \param[in] _typeId component type id
@@ -318,6 +406,50 @@ class GZ_GUI_VISIBLE PlottingInterface : public QObject
   public slots: bool exportCSV(QString _path, int _chart,
                                QMap< QString, QVariant> _serieses);
 
+  /// \brief export every recorded sample of the topic fields plotted on a
+  /// chart to csv files, streamed from their history instead of the chart
+  /// \param[in] _path path of folder to save the csv files
+  /// \param[in] _chart plot id
+  /// \return IDs of the exported fields, so the remaining serieses can be
+  /// exported with exportCSV
+  public slots: QStringList exportHistoryCSV(QString _path, int _chart);
+
+  /// \brief set how many samples are recorded for each topic field,
+  /// 100000 by default
+  /// \param[in] _size Maximum number of samples per field
+  public slots: void setHistorySize(int _size);
+
+  /// \brief plot a series computed from topic fields, such as their
+  /// difference, rolling statistics or spectrum, see DerivedSignal. It's
+  /// computed on a worker from the samples recorded at full rate, and
+  /// sent with plotPoints, or plotSeries for a spectrum. It starts from
+  /// the samples already recorded.
+  /// \param[in] _chart chart id
+  /// \param[in] _expression expression over the names of the inputs
+  /// \param[in] _inputs inputs by name, each a topic and a field path
+  /// separated by ',', as dropped on the charts
+  /// \return ID of the series, empty if the expression isn't valid
+  public slots: QString addDerivedSeries(int _chart, QString _expression,
+                                         QVariantMap _inputs);
+
+  /// \brief stop computing a derived series
+  /// \param[in] _chart chart id
+  /// \param[in] _id ID returned by addDerivedSeries
+  public slots: void removeDerivedSeries(int _chart, QString _id);
+
+  /// \brief send the points computed for the derived series since the
+  /// last call, and compute the next ones from the samples received
+  /// meanwhile. Called with each flush of the topics.
+  public slots: void UpdateDerived();
+
+  /// \brief replace the points of a series, such as the spectrum of a
+  /// derived series
+  /// \param[in] _chart chart ID
+  /// \param[in] _fieldID series ID
+  /// \param[in] _points points of the plot, as QPointF in increasing x
+  signals: void plotSeries(int _chart, QString _fieldID,
+                           QVariantList _points);
+
   /// \brief Get Component Name based on its type Id
   /// \param[in] _typeId type Id of the component
   /// \return Component name
@@ -329,6 +461,21 @@ class GZ_GUI_VISIBLE PlottingInterface : public QObject
   /// \brief update the plotting tool time
   public slots: void UpdateTime();
 
+  /// \brief Get the time of the samples without a header. It's the time
+  /// since the interface was created from a monotonic clock, or the sim
+  /// time once world statistics are received, see SetStatsTopic.
+  /// Thread safe and never decreasing, unless the simulation is reset.
+  /// \return Time in seconds
+  public: double Time() const;
+
+  /// \brief Follow the sim time of a world statistics topic. In between
+  /// statistics, the time advances with the real time factor, and it
+  /// stops while paused.
+  /// \param[in] _topic World statistics topic, such as
+  /// /world/default/stats. Empty to use the monotonic clock again.
+  /// \return True if subscribed
+  public: bool SetStatsTopic(const std::string &_topic);
+
   /// \brief Private data member.
   private: std::unique_ptr<PlottingIfacePrivate> dataPtr;
 };
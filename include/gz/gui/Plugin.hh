@@ -21,6 +21,8 @@
 #include <memory>
 #include <string>
 
+#include <gz/transport/SubscribeOptions.hh>
+
 #include "gz/gui/qt.h"
 #include "gz/gui/Export.hh"
 
@@ -96,7 +98,9 @@ namespace gz
       /// \brief Load the plugin with a configuration file. Override this
       /// on custom plugins to handle custom configurations.
       ///
-      /// Called when a plugin is first created.
+      /// Called when a plugin is first created, or, for plugins with
+      /// `<lazy>true</lazy>` in their `<gz-gui>` element, when their card is
+      /// first shown expanded and scrolled into view.
       /// This function should not be blocking.
       ///
       /// \sa Load
@@ -111,6 +115,23 @@ namespace gz
       /// \return Plugin title.
       public: virtual std::string Title() const {return this->title;}
 
+      /// \brief Get the rate cap of a topic, set with
+      /// `<max_rate topic="...">` in the `<gz-gui>` element. A `<max_rate>`
+      /// without a topic caps all the plugin's topics which don't have
+      /// their own.
+      /// \param[in] _topic Topic name
+      /// \return Maximum rate in messages per second, 0 for no cap
+      public: double MaxRate(const std::string &_topic) const;
+
+      /// \brief Get the options to subscribe to a topic with, so that
+      /// messages above its rate cap are dropped by the transport before
+      /// being parsed.
+      /// \sa MaxRate
+      /// \param[in] _topic Topic name
+      /// \return Subscription options
+      public: transport::SubscribeOptions SubscribeOptions(
+          const std::string &_topic) const;
+
       /// \brief Get the value of the the `delete_later` element from the
       /// configuration file, which defaults to false.
       /// \return The value of `delete_later`.
@@ -120,6 +141,21 @@ namespace gz
       /// parent.
       protected: void DeleteLater();
 
+      /// \brief Notify that a property changed, together with the other
+      /// properties notified until the next frame. Plugins which update
+      /// several properties at once, such as for each message, can call
+      /// this instead of emitting each NOTIFY signal, so QML
+      /// re-evaluates the bindings that depend on them once per frame.
+      /// A property notified many times before the frame is notified once.
+      /// \param[in] _property Name of a Q_PROPERTY whose NOTIFY signal has
+      /// no arguments
+      /// \sa FlushNotifications
+      protected: void NotifyChanged(const char *_property);
+
+      /// \brief Emit the notifications queued with NotifyChanged now,
+      /// instead of on the next frame.
+      protected slots: void FlushNotifications();
+
       /// \brief Title to be displayed on top of plugin.
       protected: std::string title = "";
 
@@ -139,6 +175,10 @@ namespace gz
       /// through the <anchor> tag and any state properties.
       private: void ApplyAnchors();
 
+      /// \brief Call LoadConfig for a lazy plugin if its card is visible,
+      /// expanded and on screen, and it hasn't been called yet.
+      private slots: void LoadLazyConfig();
+
       /// \internal
       /// \brief Pointer to private data
       private: std::unique_ptr<PluginPrivate> dataPtr;
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINSTATS_HH_
+#define GZ_GUI_PLUGINSTATS_HH_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gz/gui/Export.hh"
+
+class QObject;
+
+namespace gz
+{
+  namespace gui
+  {
+    /// \brief Accounts the time each plugin spends on the GUI and render
+    /// threads, so the plugin burning the CPU can be found among many.
+    ///
+    /// Time is recorded per plugin and per source: the events delivered to
+    /// it through MainWindow::SubscribeEvent, its render hooks, and the
+    /// transport callbacks delivered through LatestValue. Plugins may also
+    /// time their own work with a Scope.
+    ///
+    /// It's disabled by default, and recording is then close to free. It's
+    /// enabled while a PluginProfiler plugin is loaded.
+    class GZ_GUI_VISIBLE PluginStats
+    {
+      /// \brief Clock used for the durations
+      public: using Clock = std::chrono::steady_clock;
+
+      /// \brief What the time was spent on
+      public: enum class Source
+      {
+        /// \brief Events filtered by the plugin
+        kEvents = 0,
+
+        /// \brief Render hooks
+        kRenderHooks = 1,
+
+        /// \brief Transport callbacks
+        kTransport = 2
+      };
+
+      /// \brief Number of sources
+      public: static constexpr std::size_t kSourceCount = 3;
+
+      /// \brief Time spent by a plugin since the last TakeUsage
+      public: struct Usage
+      {
+        /// \brief Name of the plugin
+        std::string name;
+
+        /// \brief Time in milliseconds, per source
+        std::array<double, kSourceCount> ms{};
+
+        /// \brief Number of calls, per source
+        std::array<uint64_t, kSourceCount> calls{};
+
+        /// \brief Get the time spent on all sources
+        /// \return Time in milliseconds
+        double TotalMs() const;
+      };
+
+      /// \brief Records the time from its construction to its destruction.
+      public: class GZ_GUI_VISIBLE Scope
+      {
+        /// \brief Start timing, if accounting is enabled
+        /// \param[in] _object Plugin, or an object belonging to it
+        /// \param[in] _source What the time is spent on
+        public: Scope(const QObject *_object, Source _source);
+
+        /// \brief Start timing, if accounting is enabled
+        /// \param[in] _name Name the time is accounted to
+        /// \param[in] _source What the time is spent on
+        public: Scope(const std::string &_name, Source _source);
+
+        /// \brief Record the time
+        public: ~Scope();
+
+        /// \brief Name the time is accounted to
+        private: std::string name;
+
+        /// \brief What the time is spent on
+        private: Source source;
+
+        /// \brief When timing started
+        private: Clock::time_point start;
+
+        /// \brief False if accounting was disabled on construction
+        private: bool enabled{false};
+      };
+
+      /// \brief Start accounting. Calls are counted, so it stops after as
+      /// many calls to Disable.
+      public: static void Enable();
+
+      /// \brief Stop accounting, once each Enable is matched. The usage
+      /// recorded so far is discarded.
+      public: static void Disable();
+
+      /// \brief Get whether time is being accounted
+      /// \return True between Enable and Disable
+      public: static bool Enabled();
+
+      /// \brief Account time to a plugin. Safe to call from any thread.
+      /// \param[in] _name Name of the plugin
+      /// \param[in] _source What the time was spent on
+      /// \param[in] _ms Time in milliseconds
+      public: static void Record(const std::string &_name, Source _source,
+                                 double _ms);
+
+      /// \brief Get the name time spent by an object is accounted to: the
+      /// unique name of the plugin it belongs to, through its parents or
+      /// its items' parents, or else its class name.
+      /// \param[in] _object Object, may be null
+      /// \return Name, "unknown" for null
+      public: static std::string NameOf(const QObject *_object);
+
+      /// \brief Get the usage recorded since the last call, and reset it.
+      /// \return Usage per plugin, the most expensive first
+      public: static std::vector<Usage> TakeUsage();
+
+      /// \brief Get the memory used by the process. Allocations can't be
+      /// told apart per plugin without replacing the allocator, so this is
+      /// the whole process.
+      /// \return Resident set size in bytes, 0 where it's not known
+      public: static uint64_t ResidentMemory();
+    };
+  }
+}
+
+#endif  // GZ_GUI_PLUGINSTATS_HH_
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PROFILER_HH_
+#define GZ_GUI_PROFILER_HH_
+
+#include <gz/common/Profiler.hh>
+
+#include "gz/gui/Export.hh"
+#include "gz/gui/SamplingProfiler.hh"
+#include "gz/gui/StartupProfiler.hh"
+
+/// \def GZ_GUI_TRACE_ENABLE
+/// \brief Set by the GZ_GUI_ENABLE_TRACE build option, to also record the
+/// zones in the Chrome trace of StartupProfiler.
+#ifndef GZ_GUI_TRACE_ENABLE
+#define GZ_GUI_TRACE_ENABLE 0
+#endif
+
+namespace gz
+{
+  namespace gui
+  {
+    /// \brief Records a zone in the trace of StartupProfiler from its
+    /// construction to its destruction, if the profiler is enabled. Use
+    /// GZ_GUI_PROFILE rather than this directly.
+    class GZ_GUI_VISIBLE TraceZone
+    {
+      /// \brief Start a zone
+      /// \param[in] _name Name of the zone, must outlive the zone, such as
+      /// a string literal
+      public: explicit TraceZone(const char *_name);
+
+      /// \brief Record the zone
+      public: ~TraceZone();
+
+      /// \brief Name of the zone, null if the profiler was disabled
+      private: const char *name{nullptr};
+
+      /// \brief When the zone started
+      private: StartupProfiler::Clock::time_point start;
+    };
+
+    /// \brief Name the calling thread for the gz-common profiler, the
+    /// trace and the SamplingProfiler. Only the first call of each thread
+    /// has an effect, so it can be called from callbacks which run on
+    /// threads gz-gui doesn't own.
+    /// Use GZ_GUI_PROFILE_THREAD_NAME rather than this directly.
+    /// \param[in] _name Thread name
+    GZ_GUI_VISIBLE void SetProfiledThreadName(const char *_name);
+  }
+}
+
+#define GZ_GUI_PROFILE_CONCAT_(_a, _b) _a ## _b
+#define GZ_GUI_PROFILE_CONCAT(_a, _b) GZ_GUI_PROFILE_CONCAT_(_a, _b)
+
+/// \brief Profile the rest of the scope. The zone is sent to the
+/// gz-common profiler (Remotery) when it's enabled, sampled while the
+/// SamplingProfiler is running and, with GZ_GUI_ENABLE_TRACE, recorded in
+/// the trace while StartupProfiler is enabled, which can be opened with
+/// https://ui.perfetto.dev.
+/// \param[in] _name Zone name, a string literal
+#if GZ_GUI_TRACE_ENABLE
+#define GZ_GUI_PROFILE(_name) \
+  GZ_PROFILE(_name); \
+  ::gz::gui::SamplingProfiler::Zone \
+      GZ_GUI_PROFILE_CONCAT(gzGuiSampledZone, __LINE__)(_name); \
+  ::gz::gui::TraceZone GZ_GUI_PROFILE_CONCAT(gzGuiTraceZone, __LINE__)(_name)
+#else
+#define GZ_GUI_PROFILE(_name) \
+  GZ_PROFILE(_name); \
+  ::gz::gui::SamplingProfiler::Zone \
+      GZ_GUI_PROFILE_CONCAT(gzGuiSampledZone, __LINE__)(_name)
+#endif
+
+/// \brief Name the calling thread, see SetProfiledThreadName.
+/// \param[in] _name Thread name, a string literal
+#define GZ_GUI_PROFILE_THREAD_NAME(_name) \
+  ::gz::gui::SetProfiledThreadName(_name)
+
+/// \brief Mark the start of a frame in the trace, with GZ_GUI_ENABLE_TRACE.
+/// Remotery has no frame markers, its frames are the root zones.
+/// \param[in] _name Name of the marker, a string literal
+#if GZ_GUI_TRACE_ENABLE
+#define GZ_GUI_PROFILE_FRAME(_name) \
+  do \
+  { \
+    if (::gz::gui::StartupProfiler::Enabled()) \
+      ::gz::gui::StartupProfiler::Mark(_name); \
+  } while (false)
+#else
+#define GZ_GUI_PROFILE_FRAME(_name) ((void) _name)
+#endif
+
+#endif
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_GUI_QUEUESTATS_HH_
+#define GZ_GUI_QUEUESTATS_HH_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gz/gui/Export.hh"
+
+namespace gz
+{
+  namespace gui
+  {
+    /// \brief Accounts the messages waiting in the buffers and queues of
+    /// plugins, such as marker and scene messages, so a queue growing under
+    /// load can be found before it uses all the memory.
+    ///
+    /// Each queue owns a Queue, named like "MarkerManager/markers", and
+    /// reports its depth and estimated size whenever they change. The
+    /// largest depth and size reached are kept as high-water marks.
+    ///
+    /// A limit may be set on the depth or size of queues by name, even
+    /// before they exist. Queues which can drop messages without breaking
+    /// their plugin then drop the oldest or the newest messages beyond the
+    /// limit, and count them. The other queues only report it.
+    ///
+    /// Queues may report from any thread, which only costs a few atomic
+    /// operations.
+    class GZ_GUI_VISIBLE QueueStats
+    {
+      /// \brief Messages dropped when a queue reaches its limit
+      public: enum class DropPolicy
+      {
+        /// \brief The oldest messages are dropped to make room
+        kDropOldest = 0,
+
+        /// \brief The messages which don't fit are dropped
+        kDropNewest = 1
+      };
+
+      /// \brief Limit of a queue
+      public: struct Limit
+      {
+        /// \brief Maximum number of messages, 0 for no limit
+        uint64_t depth{0u};
+
+        /// \brief Maximum bytes, 0 for no limit
+        uint64_t bytes{0u};
+
+        /// \brief Messages dropped beyond the limit
+        DropPolicy policy{DropPolicy::kDropOldest};
+
+        /// \brief Get whether a depth and size are beyond the limit
+        /// \param[in] _depth Number of messages
+        /// \param[in] _bytes Bytes
+        /// \return True if either is beyond its maximum
+        bool Exceeded(uint64_t _depth, uint64_t _bytes) const;
+
+        /// \brief Get whether there's a limit
+        /// \return True if the depth or the size is limited
+        bool Enabled() const;
+      };
+
+      /// \brief State of the queues sharing a name
+      public: struct Usage
+      {
+        /// \brief Name of the queues
+        std::string name;
+
+        /// \brief Number of queues with this name, such as one per plugin
+        /// instance
+        uint64_t count{0u};
+
+        /// \brief Number of messages
+        uint64_t depth{0u};
+
+        /// \brief Estimated bytes of the messages
+        uint64_t bytes{0u};
+
+        /// \brief Largest depth reached by each queue, summed
+        uint64_t maxDepth{0u};
+
+        /// \brief Largest size reached by each queue, summed
+        uint64_t maxBytes{0u};
+
+        /// \brief Messages dropped because of the limit
+        uint64_t dropped{0u};
+
+        /// \brief Limit set for the name
+        Limit limit;
+
+        /// \brief True if the queues drop messages beyond the limit
+        bool droppable{false};
+      };
+
+      /// \brief Registers a queue from its construction to its
+      /// destruction, and holds what it reports.
+      public: class GZ_GUI_VISIBLE Queue
+      {
+        /// \brief Register a queue
+        /// \param[in] _name Name of the queue, "<plugin>/<queue>"
+        /// \param[in] _droppable True if the queue drops messages beyond
+        /// its limit, false if it only reports it
+        public: Queue(const std::string &_name, bool _droppable);
+
+        /// \brief Unregister the queue
+        public: ~Queue();
+
+        /// \brief Not copyable, the registry refers to it
+        public: Queue(const Queue &) = delete;
+
+        /// \brief Not copyable, the registry refers to it
+        public: Queue &operator=(const Queue &) = delete;
+
+        /// \brief Report the current state of the queue
+        /// \param[in] _depth Number of messages
+        /// \param[in] _bytes Estimated bytes of the messages
+        public: void Update(uint64_t _depth, uint64_t _bytes);
+
+        /// \brief Count messages dropped because of the limit
+        /// \param[in] _count Number of messages
+        public: void Drop(uint64_t _count = 1u);
+
+        /// \brief Get the limit the queue should apply
+        /// \return Limit, disabled if the queue isn't droppable
+        public: Limit CurrentLimit() const;
+
+        /// \brief Get the name of the queue
+        /// \return Name
+        public: const std::string &Name() const;
+
+        /// \brief Allows the registry to read the counters and set the
+        /// limit
+        private: friend class QueueStats;
+
+        /// \brief Name of the queue
+        private: std::string name;
+
+        /// \brief True if it drops messages beyond its limit
+        private: bool droppable{false};
+
+        /// \brief Number of messages
+        private: std::atomic<uint64_t> depth{0u};
+
+        /// \brief Estimated bytes
+        private: std::atomic<uint64_t> bytes{0u};
+
+        /// \brief Largest depth reached
+        private: std::atomic<uint64_t> maxDepth{0u};
+
+        /// \brief Largest size reached
+        private: std::atomic<uint64_t> maxBytes{0u};
+
+        /// \brief Messages dropped
+        private: std::atomic<uint64_t> dropped{0u};
+
+        /// \brief Maximum depth, 0 for no limit
+        private: std::atomic<uint64_t> limitDepth{0u};
+
+        /// \brief Maximum bytes, 0 for no limit
+        private: std::atomic<uint64_t> limitBytes{0u};
+
+        /// \brief Drop policy, as an integer
+        private: std::atomic<int> limitPolicy{0};
+      };
+
+      /// \brief Set the limit of the queues with a name, including those
+      /// registered later.
+      /// \param[in] _name Name of the queues
+      /// \param[in] _limit Limit, disabled to remove it
+      public: static void SetLimit(const std::string &_name,
+                                   const Limit &_limit);
+
+      /// \brief Get the limit set for a name.
+      /// \param[in] _name Name of the queues
+      /// \return Limit, disabled if none was set
+      public: static Limit LimitOf(const std::string &_name);
+
+      /// \brief Get the state of the registered queues.
+      /// \return Usage per name, the largest first
+      public: static std::vector<Usage> CurrentUsage();
+
+      /// \brief Reset the high-water marks of all queues to their current
+      /// depth and size, and their dropped counts to zero.
+      public: static void Reset();
+
+      /// \brief Get the name of a drop policy.
+      /// \param[in] _policy Policy
+      /// \return Name, "drop_oldest" or "drop_newest"
+      public: static std::string PolicyName(DropPolicy _policy);
+
+      /// \brief Get a drop policy from its name.
+      /// \param[in] _name Name, see PolicyName
+      /// \param[out] _policy Policy, unchanged if the name isn't known
+      /// \return True if the name is known
+      public: static bool PolicyFromName(const std::string &_name,
+                                         DropPolicy &_policy);
+    };
+  }
+}
+
+#endif  // GZ_GUI_QUEUESTATS_HH_
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_RENDERDEVICE_HH_
+#define GZ_GUI_RENDERDEVICE_HH_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gz/gui/Export.hh"
+
+namespace gz
+{
+  namespace gui
+  {
+    /// \brief Chooses the GPU 3D scenes render on, on machines with more
+    /// than one.
+    ///
+    /// Graphics drivers pick the device when they're loaded, which happens
+    /// while the application is created, so the device is chosen through
+    /// the drivers' environment variables before that. It's chosen with
+    /// `gz gui --render-device`, or the GZ_GUI_RENDER_DEVICE environment
+    /// variable, which lets each instance of a headless server be pinned to
+    /// its own GPU. Variables which are already set are kept.
+    ///
+    /// Devices are given as:
+    /// * `discrete` or `amd`: the discrete GPU of a Mesa driver, while the
+    ///   integrated one still composites the windows (PRIME offload).
+    /// * `nvidia`: an NVIDIA GPU through PRIME render offload, and
+    ///   `nvidia:<index>` for a given one of several.
+    /// * `integrated` or `intel`: the integrated GPU.
+    /// * `<index>`: the GPU with that index among those of the Mesa
+    ///   drivers, 0 being the default one.
+    /// * `pci-<bus id>` or `<vendor id>:<device id>`: a GPU of the Mesa
+    ///   drivers by PCI address or ids, such as `pci-0000_01_00_0` or
+    ///   `1002:73df`.
+    ///
+    /// Only the drivers of Linux are supported.
+    class GZ_GUI_VISIBLE RenderDevice
+    {
+      /// \brief Environment variables choosing a device.
+      /// \param[in] _device Device, see the class description
+      /// \param[out] _variables Names and values of the variables
+      /// \return False if the device isn't valid
+      public: static bool Environment(const std::string &_device,
+          std::vector<std::pair<std::string, std::string>> &_variables);
+
+      /// \brief Choose the device. Must be called before the application is
+      /// created.
+      /// \param[in] _device Device, see the class description. Empty to
+      /// keep the default one.
+      /// \return False if the device isn't valid
+      public: static bool Select(const std::string &_device);
+
+      /// \brief Choose the device given by the GZ_GUI_RENDER_DEVICE
+      /// environment variable, if it's set and Select wasn't called.
+      public: static void SelectFromEnvironment();
+
+      /// \brief Get the device chosen with Select.
+      /// \return Device, empty for the default one
+      public: static std::string Selected();
+
+      /// \brief Get whether the device a context was created on fits a
+      /// requested device, from the vendor and renderer strings reported
+      /// by OpenGL or Vulkan.
+      /// \param[in] _device Requested device
+      /// \param[in] _vendor Vendor string, such as "NVIDIA Corporation"
+      /// \param[in] _renderer Renderer string, such as "Mesa Intel(R) UHD"
+      /// \return False if it clearly doesn't fit. Devices given by index or
+      /// PCI address can't be told apart and always fit.
+      public: static bool Matches(const std::string &_device,
+                                  const std::string &_vendor,
+                                  const std::string &_renderer);
+    };
+  }
+}
+
+#endif  // GZ_GUI_RENDERDEVICE_HH_
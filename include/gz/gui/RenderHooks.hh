@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_GUI_RENDERHOOKS_HH_
+#define GZ_GUI_RENDERHOOKS_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gz/gui/Export.hh"
+
+namespace gz
+{
+  namespace gui
+  {
+    /// \brief Phases of a 3D scene's frame in which hooks are run.
+    enum class RenderPhase : int
+    {
+      /// \brief Before the user camera is rendered, same as
+      /// events::PreRender.
+      kPreRender = 0,
+
+      /// \brief After the user camera is rendered, same as events::Render.
+      kRender = 1
+    };
+
+    /// \brief Registry of callbacks run on the render thread of a 3D scene.
+    ///
+    /// This is a lighter alternative to filtering events::PreRender and
+    /// events::Render on the main window: hooks are called directly, in a
+    /// fixed order, without allocating events or going through every
+    /// plugin's event filter. The events are still sent for compatibility.
+    ///
+    /// It's safe to make rendering calls from a hook. Hooks may be
+    /// registered and unregistered from any thread, including from within a
+    /// hook. Hooks are called without holding the registry's lock, so
+    /// registering never waits for a frame. Once Unregister returns, the
+    /// hook won't be called again: it waits for a call of that hook in
+    /// progress on another thread, so a hook must not wait on a thread
+    /// which unregisters it.
+    ///
+    /// Each scene runs the hooks once per frame, even if it has several
+    /// viewports, unless they ask to be run for every viewport. The
+    /// registry is shared by all scenes, so with several scenes every hook
+    /// is run for each of them. Hooks working on a single scene skip the
+    /// frames of the others once they know their scene:
+    ///
+    ///     if (!RenderHooks::RunsFor(this->scene->Name()))
+    ///       return;
+    class GZ_GUI_VISIBLE RenderHooks
+    {
+      /// \brief Callback type
+      public: using Callback = std::function<void()>;
+
+      /// \brief Register a hook.
+      /// \param[in] _phase Phase in which to call the hook.
+      /// \param[in] _callback Function to call.
+      /// \param[in] _order Hooks with lower order are called first. Hooks
+      /// with the same order are called in registration order.
+      /// \param[in] _name Optional name used to report the hook's timing,
+      /// usually the plugin's class name.
+      /// \param[in] _everyViewport True to be called for each viewport of a
+      /// scene, false to only be called for its first viewport.
+      /// \return Unique identifier used to unregister the hook, never 0.
+      public: static uint64_t Register(RenderPhase _phase,
+                                       Callback _callback,
+                                       int _order = 0,
+                                       const std::string &_name = "",
+                                       bool _everyViewport = false);
+
+      /// \brief Unregister a hook.
+      /// \param[in] _id Identifier returned by Register.
+      /// \return True if the hook was registered.
+      public: static bool Unregister(uint64_t _id);
+
+      /// \brief Call all hooks registered for a phase. This is called by the
+      /// plugin which owns the render thread, once per frame, phase and
+      /// viewport.
+      /// \param[in] _phase Phase to run.
+      /// \param[in] _scene Name of the scene being rendered, see Scene.
+      /// \param[in] _firstViewport False for the other viewports of the
+      /// scene, which only run the hooks registered for every viewport.
+      public: static void Run(RenderPhase _phase,
+                              const std::string &_scene = "",
+                              bool _firstViewport = true);
+
+      /// \brief Get the scene whose phase is being run on this thread.
+      /// \return Scene name, empty outside of a hook or if Run wasn't
+      /// given one.
+      public: static std::string Scene();
+
+      /// \brief Check if the calling hook is run for a scene, so hooks
+      /// working on a single scene can skip the frames of the others.
+      /// \param[in] _scene Scene name.
+      /// \return False if a different scene is being run on this thread.
+      public: static bool RunsFor(const std::string &_scene);
+
+      /// \brief Get the number of hooks registered for a phase.
+      /// \param[in] _phase Phase to check.
+      /// \return Number of hooks.
+      public: static std::size_t Count(RenderPhase _phase);
+
+      /// \brief Set whether to measure how long each hook takes. Disabled
+      /// by default.
+      /// \param[in] _enabled True to measure hooks.
+      public: static void SetTimingEnabled(bool _enabled);
+
+      /// \brief Get the duration of each hook the last time its phase was
+      /// run with timing enabled.
+      /// \param[in] _phase Phase to check.
+      /// \return Pairs of hook name and duration in milliseconds, in call
+      /// order. Unnamed hooks are called "hook_<id>".
+      public: static std::vector<std::pair<std::string, double>> Timings(
+                  RenderPhase _phase);
+    };
+  }
+}
+
+#endif  // GZ_GUI_RENDERHOOKS_HH_
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_RENDERSTATS_HH_
+#define GZ_GUI_RENDERSTATS_HH_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gz/gui/Export.hh"
+
+namespace gz
+{
+  namespace gui
+  {
+    /// \brief Shares what 3D scenes submit to the GPU on a frame, and which
+    /// visuals plugins marked as static.
+    ///
+    /// Scenes measure a frame now and then, when enabled, and record its
+    /// counts under their camera's name. Render engines don't report their
+    /// draw calls, so they're estimated from the visuals in the camera's
+    /// frustum: a draw call per submesh and a batch per material.
+    ///
+    /// Visuals which never move can be marked as static by the plugins
+    /// creating them. Scenes then keep their bounds instead of computing
+    /// them for every measure, and plugins may skip their transform
+    /// updates. Marks can be made from any thread, and are dropped by the
+    /// scenes once their visuals are destroyed.
+    class GZ_GUI_VISIBLE RenderStats
+    {
+      /// \brief Counts of a frame
+      public: struct Frame
+      {
+        /// \brief Estimated draw calls, one per submesh of visible visuals
+        uint64_t drawCalls{0u};
+
+        /// \brief Triangles of visible meshes
+        uint64_t triangles{0u};
+
+        /// \brief Visuals with geometry in the camera's frustum
+        uint64_t visibleNodes{0u};
+
+        /// \brief Visuals with geometry outside of the camera's frustum
+        uint64_t culledNodes{0u};
+
+        /// \brief Distinct materials of the draw calls, which could be
+        /// batched together
+        uint64_t batches{0u};
+
+        /// \brief Visuals with geometry marked as static
+        uint64_t staticNodes{0u};
+      };
+
+      /// \brief Record the counts of a frame, replacing the previous ones.
+      /// \param[in] _camera Name of the camera which rendered it
+      /// \param[in] _frame Counts
+      public: static void Record(const std::string &_camera,
+                                 const Frame &_frame);
+
+      /// \brief Get the latest counts of a camera.
+      /// \param[in] _camera Name of the camera
+      /// \param[out] _frame Counts
+      /// \return False if nothing was recorded for the camera
+      public: static bool Latest(const std::string &_camera, Frame &_frame);
+
+      /// \brief Get the cameras which recorded counts.
+      /// \return Camera names, sorted
+      public: static std::vector<std::string> Cameras();
+
+      /// \brief Forget the counts of a camera, such as when it's destroyed.
+      /// \param[in] _camera Name of the camera
+      public: static void Remove(const std::string &_camera);
+
+      /// \brief Mark a visual as static, or not anymore.
+      /// \param[in] _id Id of the visual, see gz::rendering::Node::Id
+      /// \param[in] _static True if it never moves
+      public: static void SetStatic(unsigned int _id, bool _static);
+
+      /// \brief Get whether a visual was marked as static.
+      /// \param[in] _id Id of the visual
+      /// \return True if it was marked as static
+      public: static bool IsStatic(unsigned int _id);
+
+      /// \brief Get the visuals marked as static.
+      /// \return Ids of the visuals, sorted
+      public: static std::vector<unsigned int> StaticVisuals();
+    };
+  }
+}
+
+#endif  // GZ_GUI_RENDERSTATS_HH_
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_GUI_SAMPLINGPROFILER_HH_
+#define GZ_GUI_SAMPLINGPROFILER_HH_
+
+#include <string>
+
+#include "gz/gui/Export.hh"
+
+namespace gz
+{
+  namespace gui
+  {
+    /// \brief Periodically samples the stack of GZ_GUI_PROFILE zones of
+    /// every thread, and writes how often each stack was seen as folded
+    /// stacks, one `thread;zone;zone count` line per stack, which can be
+    /// opened with https://www.speedscope.app or flamegraph.pl.
+    ///
+    /// It's meant to be left available in production, where a profiler
+    /// can't be attached: while it's stopped, a zone only costs a load, and
+    /// while it's running, pushing one to its thread's stack. Sampling
+    /// happens on its own thread at a low rate, without interrupting the
+    /// sampled threads. The Application starts and stops it through the
+    /// `/gui/sampling_profiler` service.
+    ///
+    /// Threads are named with GZ_GUI_PROFILE_THREAD_NAME. Only zones are
+    /// sampled, so time spent outside of any zone is counted to the thread
+    /// itself.
+    class GZ_GUI_VISIBLE SamplingProfiler
+    {
+      /// \brief Maximum depth of the zones sampled, deeper ones are
+      /// ignored
+      public: static constexpr int kMaxDepth = 32;
+
+      /// \brief Pushes a zone to the calling thread's stack from its
+      /// construction to its destruction. Use GZ_GUI_PROFILE rather than
+      /// this directly.
+      public: class GZ_GUI_VISIBLE Zone
+      {
+        /// \brief Push a zone, if the profiler is running
+        /// \param[in] _name Name of the zone, must outlive the profiler,
+        /// such as a string literal
+        public: explicit Zone(const char *_name);
+
+        /// \brief Pop the zone
+        public: ~Zone();
+
+        /// \brief True if the zone was pushed
+        private: bool pushed{false};
+      };
+
+      /// \brief Start sampling. Samples of a previous run which wasn't
+      /// stopped are discarded.
+      /// \param[in] _path File the profile is written to on Stop
+      /// \param[in] _rateHz Samples per second, between 1 and 1000
+      /// \return False if the rate is invalid
+      public: static bool Start(const std::string &_path,
+                                double _rateHz = 20.0);
+
+      /// \brief Get whether it's sampling
+      /// \return True between Start and Stop
+      public: static bool Running();
+
+      /// \brief Stop sampling and write the profile to the file given to
+      /// Start. Does nothing if it's not running.
+      /// \return True if the profile was written
+      public: static bool Stop();
+
+      /// \brief Get the file the profile is written to.
+      /// \return Path given to the last Start
+      public: static std::string Path();
+
+      /// \brief Name the calling thread in the profile. Names are kept
+      /// while it's stopped, so threads can be named when they start.
+      /// \param[in] _name Thread name, such as "Render"
+      public: static void SetThreadName(const std::string &_name);
+    };
+  }
+}
+
+#endif  // GZ_GUI_SAMPLINGPROFILER_HH_
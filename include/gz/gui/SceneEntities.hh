@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_SCENEENTITIES_HH_
+#define GZ_GUI_SCENEENTITIES_HH_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gz/gui/qt.h"
+#include "gz/gui/Export.hh"
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace gz
+{
+  namespace gui
+  {
+    class SceneEntitiesPrivate;
+
+    /// \brief Hierarchy of the entities loaded in the 3D scene, such as
+    /// models, links, visuals and lights, for plugins which browse the
+    /// scene, so they don't each subscribe to the scene and keep their own
+    /// copy of it.
+    ///
+    /// The scene manager adds and removes entities from any thread, usually
+    /// the render thread. Changes are queued and applied on the GUI thread
+    /// in batches, and notified with signals shaped like those of
+    /// QAbstractItemModel, so models only update the rows which changed.
+    /// Children are kept in the order they were added.
+    ///
+    /// Everything but Add, Remove, Clear and Select must be called from
+    /// the GUI thread.
+    class GZ_GUI_VISIBLE SceneEntities : public QObject
+    {
+      Q_OBJECT
+
+      /// \brief Kind of entity
+      public: enum class Type
+      {
+        /// \brief Model, possibly nested
+        kModel,
+
+        /// \brief Link of a model
+        kLink,
+
+        /// \brief Visual of a link
+        kVisual,
+
+        /// \brief Light
+        kLight
+      };
+
+      /// \brief Description of an entity
+      public: struct Entity
+      {
+        /// \brief Entity Id, not 0
+        unsigned int id{0u};
+
+        /// \brief Id of the parent, 0 for the top level
+        unsigned int parent{0u};
+
+        /// \brief Name, may be empty
+        std::string name;
+
+        /// \brief Kind of entity
+        Type type{Type::kModel};
+
+        /// \brief Rendering Id of the node, as in PickResult::objectId,
+        /// 0 if unknown
+        unsigned int renderId{0u};
+      };
+
+      /// \brief Get the entities of the process, created the first time.
+      /// It belongs to the application, if there is one, and is created
+      /// again if the application is. Must be called from the GUI thread.
+      /// \return Entities, never null
+      public: static SceneEntities *Instance();
+
+      /// \brief Destructor
+      public: ~SceneEntities() override;
+
+      /// \brief Add entities, after their parents. An entity whose parent
+      /// isn't known is added at the top level, and one whose Id is known
+      /// replaces it. Can be called from any thread.
+      /// \param[in] _entities Entities to add
+      public: void Add(std::vector<Entity> _entities);
+
+      /// \brief Remove entities and their descendants. Unknown Ids are
+      /// ignored. Can be called from any thread.
+      /// \param[in] _ids Entity Ids
+      public: void Remove(std::vector<unsigned int> _ids);
+
+      /// \brief Remove all entities. Can be called from any thread.
+      public: void Clear();
+
+      /// \brief Select the entity of a rendered node, such as the one
+      /// picked in the 3D view, see SetSelected. The selection is cleared
+      /// if no entity has the node. Can be called from any thread.
+      /// \param[in] _renderId Rendering Id of the entity's node
+      public: void SelectRendered(unsigned int _renderId);
+
+      /// \brief Apply the queued changes now. They're otherwise applied
+      /// once control returns to the GUI thread's event loop.
+      public slots: void Flush();
+
+      /// \brief Get the number of entities
+      /// \return Number of entities
+      public: std::size_t Count() const;
+
+      /// \brief Get an entity
+      /// \param[in] _id Entity Id
+      /// \return Entity, null if it isn't known
+      public: const Entity *Find(unsigned int _id) const;
+
+      /// \brief Get the number of children of an entity
+      /// \param[in] _parent Entity Id, 0 for the top level
+      /// \return Number of children
+      public: std::size_t ChildCount(unsigned int _parent) const;
+
+      /// \brief Get a child of an entity
+      /// \param[in] _parent Entity Id, 0 for the top level
+      /// \param[in] _row Index of the child
+      /// \return Child's Id, 0 if there's no such child
+      public: unsigned int Child(unsigned int _parent,
+                                 std::size_t _row) const;
+
+      /// \brief Get the index of an entity among its parent's children
+      /// \param[in] _id Entity Id
+      /// \return Index, -1 if the entity isn't known
+      public: int Row(unsigned int _id) const;
+
+      /// \brief Find entities whose name starts with a prefix, ignoring
+      /// case. Names are indexed, so this doesn't go through all entities.
+      /// \param[in] _prefix Prefix of the name
+      /// \param[in] _max Maximum number of results
+      /// \return Entity Ids, sorted by name
+      public: std::vector<unsigned int> Search(const std::string &_prefix,
+                                               std::size_t _max) const;
+
+      /// \brief Get the entity with a rendering Id
+      /// \param[in] _renderId Rendering Id of the entity's node
+      /// \return Entity Id, 0 if none
+      public: unsigned int FindRendered(unsigned int _renderId) const;
+
+      /// \brief Get the selected entity
+      /// \return Entity Id, 0 if none
+      public: unsigned int Selected() const;
+
+      /// \brief Select an entity, such as the one clicked in the 3D view or
+      /// in a tree. The selection is cleared if the entity is removed.
+      /// \param[in] _id Entity Id, 0 to clear the selection
+      public: void SetSelected(unsigned int _id);
+
+      /// \brief Notify that children are about to be appended
+      /// \param[in] _parent Entity Id, 0 for the top level
+      /// \param[in] _first Index of the first new child
+      /// \param[in] _last Index of the last new child
+      signals: void ChildrenAboutToBeAdded(unsigned int _parent, int _first,
+                                           int _last);
+
+      /// \brief Notify that children were appended
+      /// \param[in] _parent Entity Id, 0 for the top level
+      /// \param[in] _first Index of the first new child
+      /// \param[in] _last Index of the last new child
+      signals: void ChildrenAdded(unsigned int _parent, int _first,
+                                  int _last);
+
+      /// \brief Notify that consecutive children and their descendants are
+      /// about to be removed. They can still be queried.
+      /// \param[in] _parent Entity Id, 0 for the top level
+      /// \param[in] _first Index of the first removed child
+      /// \param[in] _last Index of the last removed child
+      signals: void ChildrenAboutToBeRemoved(unsigned int _parent,
+                                             int _first, int _last);
+
+      /// \brief Notify that consecutive children were removed
+      /// \param[in] _parent Entity Id, 0 for the top level
+      /// \param[in] _first Index of the first removed child
+      /// \param[in] _last Index of the last removed child
+      signals: void ChildrenRemoved(unsigned int _parent, int _first,
+                                    int _last);
+
+      /// \brief Notify that all entities are about to be removed
+      signals: void AboutToBeCleared();
+
+      /// \brief Notify that all entities were removed
+      signals: void Cleared();
+
+      /// \brief Notify that the selection changed
+      /// \param[in] _id Selected entity Id, 0 if none
+      signals: void SelectionChanged(unsigned int _id);
+
+      /// \brief Constructor, see Instance.
+      /// \param[in] _parent Parent object
+      private: explicit SceneEntities(QObject *_parent);
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<SceneEntitiesPrivate> dataPtr;
+    };
+  }
+}
+
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_SCENEPICKER_HH_
+#define GZ_GUI_SCENEPICKER_HH_
+
+#include <functional>
+
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+
+#include "gz/gui/Export.hh"
+
+namespace gz
+{
+  namespace gui
+  {
+    /// \brief What's under a point of the 3D scene's render window
+    struct PickResult
+    {
+      /// \brief True if an object is under the point
+      bool hit{false};
+
+      /// \brief Closest point on the object, in world coordinates
+      math::Vector3d point;
+
+      /// \brief Rendering Id of the object, if there's a hit
+      unsigned int objectId{0u};
+
+      /// \brief Origin of the ray through the point, in world coordinates
+      math::Vector3d origin;
+
+      /// \brief Direction of the ray through the point
+      math::Vector3d direction;
+
+      /// \brief Get the point on the object, or the point at a distance
+      /// along the ray if there's no object, like rendering::screenToScene
+      /// \param[in] _maxDistance Distance used when there's no hit
+      /// \return Point in world coordinates
+      math::Vector3d Point(double _maxDistance) const
+      {
+        if (this->hit)
+          return this->point;
+        return this->origin + this->direction * _maxDistance;
+      }
+    };
+
+    /// \brief Shared picking of the 3D scene, so plugins don't each cast
+    /// rays into the scene for the same mouse position.
+    ///
+    /// The plugin which owns the render thread sets the picker, which is
+    /// usually backed by the render engine's selection buffer, and calls
+    /// NewFrame on each frame. Results are cached until the next frame, so
+    /// the hover, click and drop events and plugins such as the view
+    /// controls pay for a single query per position and frame.
+    ///
+    /// Pick must be called from the render thread, for example from a
+    /// render hook or a render event.
+    class GZ_GUI_VISIBLE ScenePicker
+    {
+      /// \brief Function picking the object under a position
+      /// \param[in] _pos Position in the render window's image, in pixels
+      /// \param[out] _result What's under the position
+      /// \return False if picking isn't possible, for example before the
+      /// camera is created
+      public: using Picker = std::function<bool(const math::Vector2i &_pos,
+          PickResult &_result)>;
+
+      /// \brief Set the function used to pick. Clears the cache.
+      /// \param[in] _picker Picker, or nullptr to disable picking
+      public: static void SetPicker(Picker _picker);
+
+      /// \brief Get whether a picker is set
+      /// \return True if Pick may succeed
+      public: static bool HasPicker();
+
+      /// \brief Pick the object under a position, reusing the result of an
+      /// earlier call for the same position in the same frame.
+      /// \param[in] _pos Position in the render window's image, in pixels
+      /// \param[out] _result What's under the position
+      /// \return False if there's no picker, or it failed
+      public: static bool Pick(const math::Vector2i &_pos,
+                               PickResult &_result);
+
+      /// \brief Forget the cached results, because the scene or the camera
+      /// may have changed. Called once per frame by the render thread.
+      public: static void NewFrame();
+    };
+  }
+}
+
+#endif  // GZ_GUI_SCENEPICKER_HH_
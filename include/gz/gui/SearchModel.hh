@@ -17,13 +17,24 @@
 #ifndef GZ_GUI_SEARCHMODEL_HH_
 #define GZ_GUI_SEARCHMODEL_HH_
 
+#include <memory>
+
 #include "gz/gui/Export.hh"
 #include "gz/gui/qt.h"
 
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
 namespace gz
 {
 namespace gui
 {
+  class SearchModelPrivate;
+
   /// \brief Customize the proxy model to display search results.
   ///
   /// Features:
@@ -33,8 +44,46 @@ namespace gui
   ///   applicable
   /// * Items with DataRole::TYPE == "title" are ignored
   ///
+  /// The whole tree is matched against the search in a single pass the
+  /// first time it's filtered, and the result is cached until the search
+  /// or the source model changes, so filtering is linear in the number of
+  /// rows. The source model isn't modified.
+  ///
+  /// Rows appended at the end of their parent are added to the cache and
+  /// matched on their own. Other changes are copied again once control
+  /// returns to the event loop, and rows filtered until then are matched
+  /// directly on the source model, so a burst of changes costs a single
+  /// copy.
+  ///
+  /// When a word of the search extends a word of the previous search, such
+  /// as while typing, only the rows which contained the previous word are
+  /// tested. Models with at least BackgroundRows rows are searched on a
+  /// worker thread once typing pauses, and keep showing the previous result
+  /// until the new one is applied all at once.
+  ///
   class GZ_GUI_VISIBLE SearchModel : public QSortFilterProxyModel
   {
+    /// \brief Constructor
+    /// \param[in] _parent Parent object
+    public: explicit SearchModel(QObject *_parent = nullptr);
+
+    /// \brief Destructor
+    public: ~SearchModel() override;
+
+    /// \brief Overloaded Qt method. Invalidate the cached matches whenever
+    /// the source model changes.
+    /// \param[in] _model Source model
+    public: void setSourceModel(QAbstractItemModel *_model) override;
+
+    /// \brief Overloaded Qt method. DataRole::TO_EXPAND is true for rows
+    /// which have a descendant containing one of the words. Other roles
+    /// come from the source model.
+    /// \param[in] _index Index on this model.
+    /// \param[in] _role Data role.
+    /// \return Data of the index.
+    public: QVariant data(const QModelIndex &_index,
+                          int _role = Qt::DisplayRole) const override;
+
     /// \brief Overloaded Qt method. Customize so we accept rows where:
     /// 1. Each of the words can be found in its ancestors or itself, but not
     /// necessarily all words on the same row, or
@@ -57,7 +106,8 @@ namespace gui
     /// \param[in] _srcParent Parent on the source model.
     /// \return True if row is accepted.
     public: bool filterAcceptsRow(const int _srcRow,
-                                  const QModelIndex &_srcParent) const;
+                                  const QModelIndex &_srcParent) const
+                                  override;
 
     /// \brief Check if row contains the word on itself.
     /// \param[in] _srcRow Row on the source model.
@@ -68,14 +118,16 @@ namespace gui
                                         const QModelIndex &_srcParent,
                                         const QString &_word) const;
 
-    /// \brief Check if any of the children is fully accepted.
+    /// \brief Check if any of the children is fully accepted. Not used by
+    /// the filter, which relies on its cache instead.
     /// \param[in] _srcRow Row on the source model.
     /// \param[in] _srcParent Parent on the source model.
     /// \return True if any of the children match.
     public: bool HasAcceptedChildren(const int _srcRow,
                                      const QModelIndex &_srcParent) const;
 
-    /// \brief Check if any of the children accepts a specific word.
+    /// \brief Check if any of the children accepts a specific word. Not
+    /// used by the filter, which relies on its cache instead.
     /// \param[in] _srcParent Parent on the source model.
     /// \param[in] _word Word to be checked.
     /// \return True if any of the children match.
@@ -86,9 +138,34 @@ namespace gui
     /// \param[in] _search Full search string.
     public: void SetSearch(const QString &_search);
 
+    /// \brief Get the number of rows from which models are searched in the
+    /// background.
+    /// \return Number of rows, 5000 by default
+    public: int BackgroundRows() const;
+
+    /// \brief Set the number of rows from which models are searched in the
+    /// background.
+    /// \param[in] _rows Number of rows, 0 to always search in the
+    /// background
+    public: void SetBackgroundRows(int _rows);
+
+    /// \brief Get whether the latest search is still being matched in the
+    /// background.
+    /// \return True until its result is applied
+    public: bool SearchPending() const;
+
     /// \brief Full search string.
     public: QString search;
+
+    /// \internal
+    /// \brief Private data pointer
+    private: std::unique_ptr<SearchModelPrivate> dataPtr;
   };
 }
 }
+
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
 #endif
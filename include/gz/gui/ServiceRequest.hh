@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_SERVICEREQUEST_HH_
+#define GZ_GUI_SERVICEREQUEST_HH_
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <gz/transport/Node.hh>
+
+#include "gz/gui/qt.h"
+#include "gz/gui/Export.hh"
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::shared_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace gz
+{
+  namespace gui
+  {
+    class ServiceRequestPrivate;
+
+    /// \brief Calls a Gazebo Transport service without blocking, and calls
+    /// back with the reply on the thread which needs it: the thread of a
+    /// QObject, usually the GUI thread, or the render thread.
+    ///
+    /// Unlike the asynchronous transport::Node::Request, a request times
+    /// out, so a missing server doesn't leave the caller waiting forever,
+    /// and it can be canceled. The callback is called exactly once, with
+    /// the reply, a failure or a timeout, unless the request is canceled
+    /// or its receiver destroyed first. Replies arriving after the timeout
+    /// are dropped. Any number of requests may be in flight at once, each
+    /// with its own handle.
+    ///
+    /// The request is sent to the service once it's discovered, so it may
+    /// be sent before the server is started, instead of polling for it.
+    ///
+    /// Dropping the handle doesn't cancel the request.
+    class GZ_GUI_VISIBLE ServiceRequest
+    {
+      /// \brief How a request finished
+      public: enum class Result
+      {
+        /// \brief The server replied with success
+        kReplied,
+
+        /// \brief The server replied with a failure, or the request
+        /// couldn't be sent
+        kFailed,
+
+        /// \brief No reply before the timeout
+        kTimedOut
+      };
+
+      /// \brief Thread the callback is called on
+      public: enum class Thread
+      {
+        /// \brief The receiver's thread
+        kReceiver,
+
+        /// \brief The render thread, before rendering the next frame
+        kRender,
+
+        /// \brief The transport thread which got the reply, or the timer
+        /// thread on timeout, for callers which do their own locking
+        kAny
+      };
+
+      /// \brief Constructor of a handle without request, which isn't
+      /// pending
+      public: ServiceRequest();
+
+      /// \brief Destructor, the request carries on
+      public: ~ServiceRequest();
+
+      /// \brief Send a request, with the reply delivered on the thread of
+      /// a QObject. The request is canceled if the receiver is destroyed.
+      /// \param[in] _node Node to send the request with
+      /// \param[in] _service Service name
+      /// \param[in] _request Request message
+      /// \param[in] _timeout Time to wait for the reply
+      /// \param[in] _receiver Object on whose thread the callback is called
+      /// \param[in] _callback Function called with the reply and how the
+      /// request finished. The reply is a default message unless it's
+      /// kReplied or kFailed.
+      /// \return Handle of the request
+      public: template <typename RequestT, typename ReplyT>
+      static ServiceRequest Send(transport::Node &_node,
+          const std::string &_service, const RequestT &_request,
+          std::chrono::milliseconds _timeout, QObject *_receiver,
+          std::function<void(const ReplyT &, Result)> _callback)
+      {
+        return Send(Thread::kReceiver, _receiver, _node, _service, _request,
+            _timeout, std::move(_callback));
+      }
+
+      /// \brief Send a request, with the reply delivered on the render
+      /// thread or on any thread.
+      /// \param[in] _thread Thread the callback is called on, kRender or
+      /// kAny
+      /// \param[in] _node Node to send the request with
+      /// \param[in] _service Service name
+      /// \param[in] _request Request message
+      /// \param[in] _timeout Time to wait for the reply
+      /// \param[in] _callback Function called with the reply and how the
+      /// request finished
+      /// \return Handle of the request
+      public: template <typename RequestT, typename ReplyT>
+      static ServiceRequest Send(Thread _thread, transport::Node &_node,
+          const std::string &_service, const RequestT &_request,
+          std::chrono::milliseconds _timeout,
+          std::function<void(const ReplyT &, Result)> _callback)
+      {
+        return Send(_thread, nullptr, _node, _service, _request, _timeout,
+            std::move(_callback));
+      }
+
+      /// \brief Cancel the request, if it's still pending. Waits for the
+      /// callback if it's running on another thread, so it isn't running
+      /// nor called anymore once this returns.
+      public: void Cancel();
+
+      /// \brief Get whether the request is waiting for its reply or for its
+      /// callback to be called.
+      /// \return True until the callback is called or the request canceled
+      public: bool Pending() const;
+
+      /// \brief Constructor of a handle
+      /// \param[in] _state Request state
+      private: explicit ServiceRequest(
+          std::shared_ptr<ServiceRequestPrivate> _state);
+
+      /// \brief Send a request, see the public Send functions
+      /// \param[in] _thread Thread the callback is called on
+      /// \param[in] _receiver Object on whose thread the callback is called,
+      /// for kReceiver
+      /// \param[in] _node Node to send the request with
+      /// \param[in] _service Service name
+      /// \param[in] _request Request message
+      /// \param[in] _timeout Time to wait for the reply
+      /// \param[in] _callback Function called with the reply
+      /// \return Handle of the request
+      private: template <typename RequestT, typename ReplyT>
+      static ServiceRequest Send(Thread _thread, QObject *_receiver,
+          transport::Node &_node, const std::string &_service,
+          const RequestT &_request, std::chrono::milliseconds _timeout,
+          std::function<void(const ReplyT &, Result)> _callback)
+      {
+        auto state = Create(_thread, _receiver, _timeout, [_callback]
+        {
+          _callback(ReplyT(), Result::kTimedOut);
+        });
+
+        std::function<void(const ReplyT &, const bool)> cb =
+            [state, _callback](const ReplyT &_rep, const bool _result)
+        {
+          if (!Finish(state))
+            return;
+          Deliver(state, [_callback, _rep, _result]
+          {
+            _callback(_rep, _result ? Result::kReplied : Result::kFailed);
+          });
+        };
+
+        if (!_node.Request(_service, _request, cb) && Finish(state))
+        {
+          Deliver(state, [_callback]
+          {
+            _callback(ReplyT(), Result::kFailed);
+          });
+        }
+        return ServiceRequest(state);
+      }
+
+      /// \brief Create the state of a request and start its timeout
+      /// \param[in] _thread Thread the callback is called on
+      /// \param[in] _receiver Object for kReceiver
+      /// \param[in] _timeout Time to wait for the reply
+      /// \param[in] _onTimeout Function delivered on timeout
+      /// \return Request state
+      private: static std::shared_ptr<ServiceRequestPrivate> Create(
+          Thread _thread, QObject *_receiver,
+          std::chrono::milliseconds _timeout,
+          std::function<void()> _onTimeout);
+
+      /// \brief Mark a request as finished
+      /// \param[in] _state Request state
+      /// \return True if it wasn't finished, timed out or canceled yet, so
+      /// the caller delivers the result
+      private: static bool Finish(
+          const std::shared_ptr<ServiceRequestPrivate> &_state);
+
+      /// \brief Call a function on the thread of a request, unless the
+      /// request is canceled before
+      /// \param[in] _state Request state
+      /// \param[in] _task Function calling the callback
+      private: static void Deliver(
+          const std::shared_ptr<ServiceRequestPrivate> &_state,
+          std::function<void()> _task);
+
+      /// \internal
+      /// \brief Request state, shared with the transport callback
+      private: std::shared_ptr<ServiceRequestPrivate> dataPtr;
+    };
+  }
+}
+
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+#endif  // GZ_GUI_SERVICEREQUEST_HH_
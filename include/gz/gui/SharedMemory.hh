@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_SHAREDMEMORY_HH_
+#define GZ_GUI_SHAREDMEMORY_HH_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "gz/gui/Export.hh"
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace google
+{
+  namespace protobuf
+  {
+    class Message;
+  }
+}
+
+namespace gz
+{
+  namespace gui
+  {
+    class SharedMemoryPublisherPrivate;
+    class SharedMemorySubscriberPrivate;
+
+    /// \brief A message in a shared memory slot. It points into the slot,
+    /// so it's only valid during the subscriber's callback, and the
+    /// publisher may overwrite it if the subscriber is slower than the ring
+    /// of slots. Check Valid after using the data.
+    class GZ_GUI_VISIBLE SharedMemoryView
+    {
+      /// \brief Constructor
+      /// \param[in] _data Serialized message
+      /// \param[in] _size Size of the message in bytes
+      /// \param[in] _msgType Message type name, such as gz.msgs.Image
+      /// \param[in] _sequence Sequence number of the message
+      /// \param[in] _slotSequence Sequence number of the slot, which the
+      /// publisher changes when it overwrites the slot
+      public: SharedMemoryView(const char *_data, std::size_t _size,
+                  const std::string &_msgType, uint64_t _sequence,
+                  const std::atomic<uint64_t> *_slotSequence);
+
+      /// \brief Get the serialized message
+      /// \return Pointer into the slot
+      public: const char *Data() const;
+
+      /// \brief Get the size of the serialized message
+      /// \return Size in bytes
+      public: std::size_t Size() const;
+
+      /// \brief Get the message type
+      /// \return Type name, such as gz.msgs.Image
+      public: const std::string &MsgType() const;
+
+      /// \brief Get the sequence number of the message, incremented by one
+      /// for each message the publisher writes
+      /// \return Sequence number
+      public: uint64_t Sequence() const;
+
+      /// \brief Check that the publisher hasn't started overwriting the
+      /// slot, so everything read from it until now is consistent.
+      /// \return True if the data is still the message
+      public: bool Valid() const;
+
+      /// \brief Parse the whole message, which copies it once.
+      /// \param[out] _msg Message of the view's type
+      /// \return True if it was parsed and is still valid
+      public: bool Parse(google::protobuf::Message &_msg) const;
+
+      /// \brief Parse the message except for a bytes field, such as the
+      /// pixels of an image, which is left in the slot instead of being
+      /// copied.
+      /// \param[in] _field Number of a top-level bytes field
+      /// \param[out] _msg Message of the view's type, without the field
+      /// \param[out] _bytes Contents of the field, in the slot. Null if the
+      /// message doesn't have it.
+      /// \param[out] _size Size of the field in bytes
+      /// \return True if it was parsed
+      public: bool ParseExcept(int _field, google::protobuf::Message &_msg,
+                  const char *&_bytes, std::size_t &_size) const;
+
+      /// \brief Serialized message
+      private: const char *data{nullptr};
+
+      /// \brief Size of the message
+      private: std::size_t size{0u};
+
+      /// \brief Message type
+      private: const std::string &msgType;
+
+      /// \brief Sequence number
+      private: uint64_t sequence{0u};
+
+      /// \brief Sequence of the slot, in shared memory
+      private: const std::atomic<uint64_t> *slotSequence{nullptr};
+    };
+
+    /// \brief Writes messages for same-host subscribers into a ring of
+    /// pre-allocated slots in shared memory, instead of sending them
+    /// through sockets.
+    ///
+    /// Each message is serialized straight into a slot, and only its
+    /// sequence number goes through Gazebo Transport, on `<topic>/shm`, to
+    /// wake the subscribers. Publishers on the regular topic are still
+    /// needed for other hosts and for subscribers which don't use shared
+    /// memory.
+    ///
+    /// Shared memory is available on Linux and macOS.
+    class GZ_GUI_VISIBLE SharedMemoryPublisher
+    {
+      /// \brief Constructor. Creates the segment, replacing one left by a
+      /// previous publisher of the topic.
+      /// \param[in] _topic Topic of the messages
+      /// \param[in] _msgType Message type name, such as gz.msgs.Image
+      /// \param[in] _slotSize Maximum size of a serialized message in bytes
+      /// \param[in] _slots Number of slots. Subscribers which are slower
+      /// than the publisher have this many messages of slack before one is
+      /// overwritten.
+      public: SharedMemoryPublisher(const std::string &_topic,
+                  const std::string &_msgType, std::size_t _slotSize,
+                  unsigned int _slots = 4u);
+
+      /// \brief Destructor, removes the segment
+      public: ~SharedMemoryPublisher();
+
+      /// \brief Get whether the segment was created
+      /// \return False if shared memory isn't available
+      public: bool Valid() const;
+
+      /// \brief Serialize a message into the next slot and notify the
+      /// subscribers.
+      /// \param[in] _msg Message, of the publisher's type
+      /// \return False if it's larger than a slot or invalid
+      public: bool Publish(const google::protobuf::Message &_msg);
+
+      /// \brief Copy a serialized message into the next slot and notify the
+      /// subscribers.
+      /// \param[in] _data Serialized message
+      /// \param[in] _size Size in bytes
+      /// \return False if it's larger than a slot or invalid
+      public: bool PublishRaw(const char *_data, std::size_t _size);
+
+      /// \brief Get the name of the segment of a topic
+      /// \param[in] _topic Topic name
+      /// \return Name for shm_open
+      public: static std::string SegmentName(const std::string &_topic);
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<SharedMemoryPublisherPrivate> dataPtr;
+    };
+
+    /// \brief Receives the messages of a SharedMemoryPublisher on the same
+    /// host, without copying or deserializing them.
+    class GZ_GUI_VISIBLE SharedMemorySubscriber
+    {
+      /// \brief Callback, called from a Gazebo Transport thread. Only the
+      /// latest message is passed if several were written meanwhile.
+      public: using Callback = std::function<void(const SharedMemoryView &)>;
+
+      /// \brief Constructor
+      public: SharedMemorySubscriber();
+
+      /// \brief Destructor, unsubscribes
+      public: ~SharedMemorySubscriber();
+
+      /// \brief Subscribe to a topic's segment, replacing any previous
+      /// subscription.
+      /// \param[in] _topic Topic name
+      /// \param[in] _callback Called with each message
+      /// \return False if there's no segment for the topic on this host, in
+      /// which case the regular topic should be used
+      public: bool Subscribe(const std::string &_topic, Callback _callback);
+
+      /// \brief Stop calling the callback. Once this returns, it isn't
+      /// running anymore.
+      public: void Unsubscribe();
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<SharedMemorySubscriberPrivate> dataPtr;
+    };
+  }
+}
+
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+#endif  // GZ_GUI_SHAREDMEMORY_HH_
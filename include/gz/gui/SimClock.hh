@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_SIMCLOCK_HH_
+#define GZ_GUI_SIMCLOCK_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gz/gui/qt.h"
+#include "gz/gui/Export.hh"
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace gz
+{
+  namespace gui
+  {
+    class SimClockPrivate;
+
+    /// \brief Keeps the latest world statistics of a stats topic, such as
+    /// "/world/<name>/stats", for all plugins, so they don't each subscribe
+    /// to the topic and parse every message.
+    ///
+    /// There's one clock per topic, shared by everyone who holds it, and
+    /// subscribed while it's held. The sim time, paused state and iteration
+    /// count can be read from any thread with no locking, such as from the
+    /// render thread, and Updated notifies changes on the GUI thread.
+    class GZ_GUI_VISIBLE SimClock : public QObject
+    {
+      Q_OBJECT
+
+      /// \brief Latest statistics
+      public: struct State
+      {
+        /// \brief Bumped on every message, 0 until the first one
+        uint64_t version{0u};
+
+        /// \brief True once a message had a sim time
+        bool hasSimTime{false};
+
+        /// \brief Latest sim time
+        std::chrono::steady_clock::duration simTime{0};
+
+        /// \brief True once a message had a real time
+        bool hasRealTime{false};
+
+        /// \brief Latest real time
+        std::chrono::steady_clock::duration realTime{0};
+
+        /// \brief True if the latest message had a real time
+        bool latestHasRealTime{false};
+
+        /// \brief Real time factor of the latest message
+        double realTimeFactor{0.0};
+
+        /// \brief True if the latest message says the world is paused
+        bool paused{false};
+
+        /// \brief True if the latest message was sent while stepping
+        bool stepping{false};
+
+        /// \brief Iterations of the latest message
+        uint64_t iterations{0u};
+      };
+
+      /// \brief Get the clock of a topic, created and subscribed the first
+      /// time. Must be called from the GUI thread.
+      /// \param[in] _topic World statistics topic
+      /// \return Clock, null if the topic isn't valid or can't be subscribed
+      public: static std::shared_ptr<SimClock> ForTopic(
+          const std::string &_topic);
+
+      /// \brief Destructor, unsubscribes
+      public: ~SimClock() override;
+
+      /// \brief Get the topic of the clock
+      /// \return Topic name
+      public: const std::string &Topic() const;
+
+      /// \brief Get all the latest statistics at once. Safe to call from
+      /// any thread.
+      /// \return Statistics of the latest message
+      public: State Latest() const;
+
+      /// \brief Get the latest sim time. Safe to call from any thread.
+      /// \return Sim time, 0 until a message with a sim time is received
+      public: std::chrono::steady_clock::duration SimTime() const;
+
+      /// \brief Get whether the world is paused. Safe to call from any
+      /// thread.
+      /// \return True if the latest message says it's paused
+      public: bool Paused() const;
+
+      /// \brief Get the latest iteration count. Safe to call from any
+      /// thread.
+      /// \return Iterations
+      public: uint64_t Iterations() const;
+
+      /// \brief Notify that new statistics were received. Emitted on the GUI
+      /// thread, at most once per iteration of its event loop however fast
+      /// the statistics come, so only Latest is meaningful.
+      signals: void Updated();
+
+      /// \brief Constructor, see ForTopic.
+      /// \param[in] _topic Valid topic name
+      private: explicit SimClock(const std::string &_topic);
+
+      /// \brief Subscribe to the topic
+      /// \return False if subscribing failed
+      private: bool Subscribe();
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<SimClockPrivate> dataPtr;
+    };
+  }
+}
+
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_STARTUPPROFILER_HH_
+#define GZ_GUI_STARTUPPROFILER_HH_
+
+#include <chrono>
+#include <string>
+
+#include "gz/gui/Export.hh"
+
+namespace gz
+{
+  namespace gui
+  {
+    /// \brief Records how long each step of the startup takes, such as
+    /// parsing the config, loading each plugin's library and creating its
+    /// card, and writes it as a Chrome trace, which can be opened with
+    /// chrome://tracing or https://ui.perfetto.dev.
+    ///
+    /// It's disabled by default, and recording is then close to free. It's
+    /// enabled with `gz gui --startup-profile`. Steps may be recorded from
+    /// any thread.
+    ///
+    /// When gz-gui is built with GZ_GUI_ENABLE_TRACE, the zones of
+    /// GZ_GUI_PROFILE are recorded too, see gz/gui/Profiler.hh.
+    class GZ_GUI_VISIBLE StartupProfiler
+    {
+      /// \brief Clock used for the timestamps
+      public: using Clock = std::chrono::steady_clock;
+
+      /// \brief Records a step from its construction to its destruction.
+      public: class GZ_GUI_VISIBLE Scope
+      {
+        /// \brief Start a step, if the profiler is enabled
+        /// \param[in] _name Name of the step, such as the plugin filename
+        /// \param[in] _category Kind of step, such as "Load library"
+        public: Scope(const std::string &_name, const std::string &_category);
+
+        /// \brief Record the step
+        public: ~Scope();
+
+        /// \brief Name of the step
+        private: std::string name;
+
+        /// \brief Kind of step
+        private: std::string category;
+
+        /// \brief When the step started
+        private: Clock::time_point start;
+
+        /// \brief False if the profiler was disabled on construction
+        private: bool enabled{false};
+      };
+
+      /// \brief Start recording, timestamps are relative to this call.
+      /// Steps recorded before are discarded.
+      /// \param[in] _path File the trace is written to
+      public: static void Enable(const std::string &_path);
+
+      /// \brief Get whether steps are being recorded
+      /// \return True after Enable and until the trace is written
+      public: static bool Enabled();
+
+      /// \brief Record a step.
+      /// \param[in] _name Name of the step
+      /// \param[in] _category Kind of step
+      /// \param[in] _start When it started
+      /// \param[in] _end When it finished
+      public: static void Record(const std::string &_name,
+                                 const std::string &_category,
+                                 Clock::time_point _start,
+                                 Clock::time_point _end);
+
+      /// \brief Record a point in time, such as the first frame.
+      /// \param[in] _name Name of the event
+      public: static void Mark(const std::string &_name);
+
+      /// \brief Name the calling thread in the trace. Names are kept while
+      /// the profiler is disabled, so threads can be named when they start.
+      /// \param[in] _name Thread name, such as "Render"
+      public: static void SetThreadName(const std::string &_name);
+
+      /// \brief Write the trace to the file given to Enable and stop
+      /// recording. Does nothing if it's disabled.
+      /// \return True if the trace was written
+      public: static bool Write();
+    };
+  }
+}
+
+#endif  // GZ_GUI_STARTUPPROFILER_HH_
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_STATICPLUGINS_HH_
+#define GZ_GUI_STATICPLUGINS_HH_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gz/gui/Export.hh"
+
+namespace gz
+{
+  namespace gui
+  {
+    class Plugin;
+
+    /// \brief Plugins linked into the executable, rather than loaded from
+    /// a library at runtime.
+    ///
+    /// When gz-gui is built with GZ_GUI_STATIC_PLUGINS, the standard
+    /// plugins are linked into a single gz-gui executable and registered
+    /// here as the program starts, so Application::LoadPlugin creates them
+    /// without searching the plugin paths and opening their libraries.
+    /// Other plugins are still loaded from their libraries.
+    ///
+    /// Plugins register with GZ_GUI_ADD_PLUGIN, which registers them with
+    /// gz-plugin instead when they're built as libraries.
+    class GZ_GUI_VISIBLE StaticPlugins
+    {
+      /// \brief Creates a plugin
+      public: using Factory = std::function<std::shared_ptr<Plugin>()>;
+
+      /// \brief Register a plugin, usually through GZ_GUI_ADD_PLUGIN.
+      /// \param[in] _filename Filename the plugin is loaded with, such as
+      /// "Publisher"
+      /// \param[in] _factory Creates the plugin
+      /// \return False if a plugin was already registered with the
+      /// filename, it's then kept
+      public: static bool Register(const std::string &_filename,
+                                   Factory _factory);
+
+      /// \brief Get whether a plugin is linked into the executable.
+      /// \param[in] _filename Plugin filename, which may have the "lib"
+      /// prefix and library extension, such as "libPublisher.so"
+      /// \return True if it's registered
+      public: static bool Has(const std::string &_filename);
+
+      /// \brief Create a plugin linked into the executable.
+      /// \param[in] _filename Plugin filename, see Has
+      /// \return New plugin, null if it isn't registered
+      public: static std::shared_ptr<Plugin> Instantiate(
+          const std::string &_filename);
+
+      /// \brief Get the plugins linked into the executable.
+      /// \return Their filenames, sorted
+      public: static std::vector<std::string> Filenames();
+    };
+  }
+}
+
+#ifdef GZ_GUI_STATIC_PLUGIN
+/// \brief Register a plugin class with the filename it's loaded with. Set
+/// by the build when the plugin is linked into the executable.
+#define GZ_GUI_ADD_PLUGIN(_class, _filename) \
+  namespace \
+  { \
+    [[maybe_unused]] const bool kGzGuiStaticPluginRegistered = \
+        ::gz::gui::StaticPlugins::Register(_filename, []() \
+        { \
+          return std::shared_ptr<::gz::gui::Plugin>( \
+              std::make_shared<_class>()); \
+        }); \
+  }
+#else
+/// \brief Register a plugin class with the filename it's loaded with, see
+/// StaticPlugins. In a plugin library, it's registered with gz-plugin, so
+/// gz/plugin/Register.hh must be included.
+#define GZ_GUI_ADD_PLUGIN(_class, _filename) \
+  GZ_ADD_PLUGIN(_class, ::gz::gui::Plugin)
+#endif
+
+#endif  // GZ_GUI_STATICPLUGINS_HH_
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_TOPICDISCOVERY_HH_
+#define GZ_GUI_TOPICDISCOVERY_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gz/gui/qt.h"
+#include "gz/gui/Export.hh"
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace gz
+{
+  namespace gui
+  {
+    class TopicDiscoveryPrivate;
+
+    /// \brief Keeps track of the Gazebo Transport topics of the network
+    /// for all plugins, so they don't each list the topics and query the
+    /// type of every one of them.
+    ///
+    /// The topics are listed once per second, and on Refresh. Only new
+    /// topics are queried for their types, and changes are notified with
+    /// TopicAdded and TopicRemoved.
+    class GZ_GUI_VISIBLE TopicDiscovery : public QObject
+    {
+      Q_OBJECT
+
+      /// \brief Get the discovery of the process, created the first time.
+      /// It belongs to the application, if there is one, and is created
+      /// again if the application is.
+      /// \return Discovery, never null
+      public: static TopicDiscovery *Instance();
+
+      /// \brief Destructor
+      public: ~TopicDiscovery() override;
+
+      /// \brief Get the known topics.
+      /// \return Topic names, sorted
+      public: std::vector<std::string> Topics() const;
+
+      /// \brief Get the known topics published with a message type.
+      /// \param[in] _msgType Message type name, such as gz.msgs.Image
+      /// \return Topic names, sorted
+      public: std::vector<std::string> Topics(
+          const std::string &_msgType) const;
+
+      /// \brief Get the message type of a topic.
+      /// \param[in] _topic Topic name
+      /// \return Type of its first publisher, empty if the topic isn't
+      /// known
+      public: std::string MsgType(const std::string &_topic) const;
+
+      /// \brief List the topics now and notify the changes
+      public slots: void Refresh();
+
+      /// \brief Notify that a topic appeared
+      /// \param[in] _topic Topic name
+      /// \param[in] _msgType Type of its first publisher
+      signals: void TopicAdded(const QString &_topic,
+                               const QString &_msgType);
+
+      /// \brief Notify that a topic disappeared
+      /// \param[in] _topic Topic name
+      signals: void TopicRemoved(const QString &_topic);
+
+      /// \brief Constructor, see Instance.
+      /// \param[in] _parent Parent object
+      private: explicit TopicDiscovery(QObject *_parent);
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<TopicDiscoveryPrivate> dataPtr;
+    };
+  }
+}
+
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_GUI_WORKERPOOL_HH_
+#define GZ_GUI_WORKERPOOL_HH_
+
+#include <cstddef>
+#include <functional>
+
+#include "gz/gui/Export.hh"
+
+namespace gz
+{
+  namespace gui
+  {
+    /// \brief Process-wide pool of worker threads shared by the plugins, so
+    /// work such as image conversion, point cloud processing or scene
+    /// parsing is moved off the GUI and render threads without each plugin
+    /// starting its own threads and oversubscribing the cores.
+    ///
+    /// Each worker has its own queue. Tasks posted from a worker go to its
+    /// queue and are run newest first, while their data is still in cache,
+    /// and idle workers steal the oldest tasks of the others. Higher
+    /// priority tasks are always taken first. Tasks are meant to be coarse,
+    /// so a single lock protects the queues.
+    ///
+    /// Tasks have an owner, usually the plugin or its private data. The
+    /// owner's tasks are canceled with Cancel, which plugins call on
+    /// destruction, and the Application cancels the tasks owned by a
+    /// plugin when it's removed. Long tasks should check Canceled now and
+    /// then.
+    ///
+    /// Work which has to touch the scene continues on the render thread
+    /// with RunOnRenderThread, in the kPreRender RenderHooks phase of the
+    /// next frame.
+    ///
+    /// The workers start with the first task, and are stopped when the
+    /// Application is destroyed. Everything may be called from any thread.
+    class GZ_GUI_VISIBLE WorkerPool
+    {
+      /// \brief Function run by the pool
+      public: using Task = std::function<void()>;
+
+      /// \brief Priority of a task
+      public: enum class Priority : int
+      {
+        /// \brief Work the user is waiting for, such as the visible image
+        kHigh = 0,
+
+        /// \brief Default
+        kNormal = 1,
+
+        /// \brief Background work, such as prefetching
+        kLow = 2
+      };
+
+      /// \brief Run a task on a worker.
+      /// \param[in] _task Function
+      /// \param[in] _owner Owner of the task, for Cancel. Null if it can't
+      /// be canceled.
+      /// \param[in] _priority Priority
+      public: static void Post(Task _task, const void *_owner = nullptr,
+                               Priority _priority = Priority::kNormal);
+
+      /// \brief Run a task on a worker, and then a continuation on the
+      /// render thread, unless the task was canceled meanwhile.
+      /// \param[in] _task Function run on a worker
+      /// \param[in] _onRender Function run on the render thread next frame
+      /// \param[in] _owner Owner of both, for Cancel
+      /// \param[in] _priority Priority of the task
+      public: static void Post(Task _task, Task _onRender,
+                               const void *_owner,
+                               Priority _priority = Priority::kNormal);
+
+      /// \brief Run a function on the render thread, in the kPreRender
+      /// phase of the next frame. Nothing runs without a 3D scene.
+      /// \param[in] _task Function
+      /// \param[in] _owner Owner of the function, for Cancel
+      public: static void RunOnRenderThread(Task _task,
+                                            const void *_owner = nullptr);
+
+      /// \brief Cancel the tasks of an owner: the queued ones are dropped,
+      /// and it waits for the running ones. Running tasks mustn't wait for
+      /// the thread calling this. It may be called from one of the owner's
+      /// tasks, which isn't waited for.
+      /// \param[in] _owner Owner, nothing happens if it's null
+      public: static void Cancel(const void *_owner);
+
+      /// \brief Get whether the task running on the calling thread is
+      /// being canceled, so it can return early.
+      /// \return True if its owner is being canceled
+      public: static bool Canceled();
+
+      /// \brief Set the number of workers. Takes effect the next time the
+      /// workers start.
+      /// \param[in] _count Number of threads, 0 for one less than the
+      /// number of cores
+      public: static void SetThreadCount(std::size_t _count);
+
+      /// \brief Get the number of workers.
+      /// \return Number of threads, 0 until the first task
+      public: static std::size_t ThreadCount();
+
+      /// \brief Get the number of tasks waiting for a worker.
+      /// \return Number of queued tasks
+      public: static std::size_t Pending();
+
+      /// \brief Drop the queued tasks and stop the workers, once their
+      /// running tasks are done. Posting a task starts them again.
+      public: static void Shutdown();
+    };
+  }
+}
+
+#endif  // GZ_GUI_WORKERPOOL_HH_
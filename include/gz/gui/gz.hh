@@ -39,6 +39,26 @@ extern "C" GZ_GUI_VISIBLE void cmdConfig(const char *_config);
 /// \brief External hook to execute 'gz gui' from the command line.
 extern "C" GZ_GUI_VISIBLE void cmdEmptyWindow();
 
+/// \brief External hook to set the verbosity with 'gz gui -v' from the
+/// command line.
+/// \param[in] _verbosity Level of console output, from 0 to 4.
+extern "C" GZ_GUI_VISIBLE void cmdVerbose(const char *_verbosity);
+
+/// \brief External hook to profile the startup with
+/// 'gz gui --startup-profile' from the command line.
+/// \param[in] _path File to write the Chrome trace to.
+extern "C" GZ_GUI_VISIBLE void cmdStartupProfile(const char *_path);
+
+/// \brief External hook to choose the GPU with
+/// 'gz gui --render-device' from the command line.
+/// \param[in] _device Device, see gz::gui::RenderDevice.
+extern "C" GZ_GUI_VISIBLE void cmdRenderDevice(const char *_device);
+
+/// \brief External hook to choose the lightweight mode with
+/// 'gz gui --lite' from the command line.
+/// \sa gz::gui::Application::SetLite
+extern "C" GZ_GUI_VISIBLE void cmdLite();
+
 /// \brief External hook when executing 'gz gui -t' from the command line.
 /// \param[in] _filename Path to a QSS file.
 extern "C" GZ_GUI_VISIBLE void cmdSetStyleFromFile(const char *_filename);
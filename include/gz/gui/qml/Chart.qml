@@ -20,6 +20,7 @@ import QtQuick.Controls 2.2
 import QtQuick.Controls.Styles 1.4
 import QtQuick.Controls.Material 2.1
 import QtQuick.Layouts 1.3
+import GzPlot 1.0
 
 Rectangle {
   id: main
@@ -52,6 +53,12 @@ Rectangle {
     When points exceed that limit, some points from begining are deleted
   */
   property int maxPoints: 10000
+  /**
+    Points kept for each field drawn by the plot item, which draws only
+    the minimum and maximum per pixel of long histories, so it can keep
+    about an hour of a 250 Hz topic
+  */
+  property int historyPoints: 1000000
   /**
     Chart ID
   */
@@ -71,6 +78,52 @@ Rectangle {
   {
     chart.appendPoint(_fieldID, _x, _y);
   }
+
+  /**
+    add points to a field graph
+    _fieldID field key or path
+    _points points in time order
+  */
+  function appendPoints(_fieldID, _points)
+  {
+    chart.appendPoints(_fieldID, _points);
+  }
+
+  /**
+    replace the points of a series
+    _fieldID series ID
+    _points points in increasing x
+  */
+  function setPoints(_fieldID, _points)
+  {
+    chart.setPoints(_fieldID, _points);
+  }
+
+  /**
+    plot a series computed from topic fields, see
+    PlottingIface.addDerivedSeries
+    expression expression over the names of the inputs
+    inputs map of input names to "topic,path"
+    return: ID of the series, empty if it isn't valid
+  */
+  function addDerivedSeries(expression, inputs)
+  {
+    var ID = PlottingIface.addDerivedSeries(chartID, expression, inputs);
+    if (ID && !(ID in chart.serieses))
+      chart.addSeries(ID, "");
+    return ID;
+  }
+
+  /**
+    stop plotting a derived series
+    ID ID returned by addDerivedSeries
+  */
+  function removeDerivedSeries(ID)
+  {
+    PlottingIface.removeDerivedSeries(chartID, ID);
+    if (ID in chart.serieses)
+      chart.deleteSeries(ID);
+  }
   /**
     set the chart opacity
     _opacity opacity value
@@ -492,6 +545,7 @@ Rectangle {
       newSeries.width = 2;
       newSeries.color = chart.colors[chart.indexColor % chart.colors.length]
       serieses[ID] = newSeries;
+      plot.addSeries(ID, newSeries.color);
 
       chart.indexColor = (chart.indexColor + 1)  % chart.colors.length;
     }
@@ -505,6 +559,7 @@ Rectangle {
       removeSeries(serieses[ID]);
       // remove the series key from the serieses map
       delete serieses[ID];
+      plot.removeSeries(ID);
     }
 
     /**
@@ -553,6 +608,90 @@ Rectangle {
       chart.updateHoverText();
     }
 
+    /**
+      add points to a specific TextField, updating the chart once
+      the points are drawn by the plot item, the series is kept for its
+      legend
+      _fieldID field ID or Path
+      _points points in time order
+    */
+    function appendPoints(_fieldID, _points)
+    {
+      var series = chart.serieses[_fieldID];
+      if (!series || _points.length === 0)
+        return;
+
+      // the first point of an empty chart sets its boundaries
+      var first = 0;
+      if (chart.count === 2 && series.count === 0 &&
+          plot.pointCount(_fieldID) === 0)
+      {
+        xAxis.min = _points[0].x;
+        xAxis.max = _points[0].x + 10;
+        first = 1;
+      }
+
+      var minX = xAxis.min;
+      var maxX = xAxis.max;
+      var minY = yAxis.min;
+      var maxY = yAxis.max;
+      for (var i = first; i < _points.length; ++i)
+      {
+        var point = _points[i];
+        minX = Math.min(minX, point.x);
+        maxX = Math.max(maxX, point.x);
+        minY = Math.min(minY, point.y);
+        maxY = Math.max(maxY, point.y);
+      }
+      plot.appendPoints(_fieldID, _points);
+
+      // expand the chart boundries if needed
+      if (xAxis.max < maxX)
+      {
+        xAxis.max = maxX;
+        chart.scrollRight(chart.width * 0.0012);
+      }
+      if (yAxis.max < maxY)
+        yAxis.max = maxY;
+      if (yAxis.min > minY)
+        yAxis.min = minY;
+      if (xAxis.min > minX)
+        xAxis.min = minX;
+
+      chart.updateHoverText();
+    }
+
+    /**
+      replace the points of a series and fit the chart to them, as for a
+      spectrum
+      _fieldID series ID
+      _points points in increasing x
+    */
+    function setPoints(_fieldID, _points)
+    {
+      var series = chart.serieses[_fieldID];
+      if (!series || _points.length === 0)
+        return;
+
+      plot.removeSeries(_fieldID);
+      plot.addSeries(_fieldID, series.color);
+      plot.appendPoints(_fieldID, _points);
+
+      var minY = _points[0].y;
+      var maxY = _points[0].y;
+      for (var i = 1; i < _points.length; ++i)
+      {
+        minY = Math.min(minY, _points[i].y);
+        maxY = Math.max(maxY, _points[i].y);
+      }
+      xAxis.min = _points[0].x;
+      xAxis.max = _points[_points.length - 1].x;
+      yAxis.min = Math.min(0, minY);
+      yAxis.max = maxY > yAxis.min ? maxY : yAxis.min + 1;
+
+      chart.updateHoverText();
+    }
+
     width: parent.width
     anchors.bottom: parent.bottom
     anchors.top: infoRect.bottom
@@ -698,6 +837,22 @@ Rectangle {
       tickCount: 9
     }
 
+    // draws the points of the topic fields over the plot area, the oldest
+    // points beyond historyPoints are removed by the item
+    PlotItem {
+      id: plot
+      x: chart.plotArea.x
+      y: chart.plotArea.y
+      width: chart.plotArea.width
+      height: chart.plotArea.height
+      clip: true
+      xMin: xAxis.min
+      xMax: xAxis.max
+      yMin: yAxis.min
+      yMax: yAxis.max
+      maxPoints: main.historyPoints
+    }
+
     // to just show the plot at begining
     LineSeries {
       id: lineSeries
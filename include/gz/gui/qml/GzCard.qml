@@ -104,6 +104,43 @@ Pane {
    */
   property int lastHeight: 50
 
+  /**
+   * True while the card is scrolled out of view. Set by the split holding
+   * it.
+   */
+  property bool offScreen: false
+
+  /**
+   * False to keep the content shown and laid out while the card is off
+   * screen or collapsed, for plugins which must keep updating, such as
+   * those rendering a scene.
+   */
+  property bool cullable: true
+
+  /**
+   * True while the content can't be seen. It's then hidden and stops
+   * following the card's size, so resizing the window doesn't lay it out.
+   */
+  readonly property bool contentHidden: cullable && (offScreen ||
+      state === "docked_collapsed" || state === "floating_collapsed")
+
+  /**
+   * True to render the content once into a texture, which is drawn as a
+   * single quad on the following frames until the content changes. Suits
+   * cards which rarely change, but are drawn on every frame because
+   * another item, such as the 3D scene, is updating. Cards which change
+   * on most frames get slower, since they're rendered twice.
+   */
+  property bool cacheLayer: false
+
+  onContentHiddenChanged: {
+    content.visible = !contentHidden;
+    if (contentHidden)
+      content.anchors.fill = undefined;
+    else
+      content.anchors.fill = cardPane;
+  }
+
   /**
    * True if there's at least one anchor set for the card.
    * There's no way to check the anchors themselves, so we need
@@ -414,6 +451,9 @@ Pane {
    */
   function enterFloatingState()
   {
+    // Floating cards are always on screen
+    offScreen = false;
+
     const collapsed = cardPane.parent.Layout.minimumHeight === 50;
     // Reparent to main window's background
     cardPane.parent = backgroundItem
@@ -675,6 +715,10 @@ Pane {
     clip: true
     color: cardBackground
 
+    layer.enabled: cacheLayer && content.visible
+    // Sampled 1:1, so the cached content looks the same as when it isn't
+    layer.smooth: false
+
     onChildrenChanged: {
       // Set the height and width of the cardPane when child plugin is attached
       if (children.length > 0) {
@@ -43,6 +43,12 @@ SplitView {
    */
   property variant childSplits: new Object()
 
+  /**
+   * Number of unfinished beginBatch calls. Minimum sizes aren't
+   * recalculated while it's positive.
+   */
+  property int batchDepth: 0
+
   /**
    * Callback when the height changed.
    */
@@ -71,12 +77,47 @@ SplitView {
    */
   function recalculateMinimumSizes()
   {
+    if (batchDepth > 0)
+      return;
+
     for (var name in childSplits)
     {
       childSplits[name].split.recalculateMinimumSize()
     }
   }
 
+  /**
+   * Start adding or removing several items, so sizes are only recalculated
+   * once, on the matching endBatch. Calls can be nested.
+   */
+  function beginBatch()
+  {
+    batchDepth++;
+  }
+
+  /**
+   * Finish a beginBatch, recalculating sizes if it was the outermost one.
+   */
+  function endBatch()
+  {
+    if (batchDepth === 0)
+      return;
+
+    batchDepth--;
+    recalculateMinimumSizes();
+  }
+
+  /**
+   * Recalculate the minimum size of a split, unless in a batch.
+   * Meant for internal use.
+   * @param _split Split wrapper
+   */
+  function _recalculateSplit(_split)
+  {
+    if (batchDepth === 0)
+      _split.split.recalculateMinimumSize();
+  }
+
   /**
    * This function will appropriately create new items and splits according to
    * the current main window state.
@@ -163,8 +204,13 @@ SplitView {
       // Make sure that changes to the item's minimum size get propagated to the
       // split.
       item.minimumSizeChanged.connect(function(){
-        _split.split.recalculateMinimumSize()
+        _recalculateSplit(_split)
       });
+
+      // Items moving in or out of view
+      item.yChanged.connect(_split.scheduleCulling);
+      item.heightChanged.connect(_split.scheduleCulling);
+      _split.scheduleCulling();
     }
 
     return itemName;
@@ -235,7 +281,7 @@ SplitView {
       }
       else
       {
-        split.split.recalculateMinimumSize();
+        _recalculateSplit(split);
       }
     }
   }
@@ -318,7 +364,51 @@ SplitView {
       Layout.minimumWidth: split.Layout.minimumWidth + scrollBarWidth
       Layout.minimumHeight: split.Layout.minimumHeight
 
+      /**
+       * Update which cards are off screen once the current changes are
+       * done, however many items moved.
+       */
+      function scheduleCulling()
+      {
+        cullingTimer.restart();
+      }
+
+      /**
+       * Mark the cards outside of the visible part of the scroll view as
+       * off screen, so they aren't drawn or laid out.
+       */
+      function updateCulling()
+      {
+        var bar = scrollView.ScrollBar.vertical;
+        var top = bar.position * split.height;
+        var bottom = top + bar.size * split.height;
+        for (var i = 0; i < split.__items.length; i++)
+        {
+          var item = split.__items[i];
+          for (var c = 0; c < item.children.length; c++)
+          {
+            var card = item.children[c];
+            if (card.offScreen === undefined)
+              continue;
+            card.offScreen = item.y + item.height < top || item.y > bottom;
+          }
+        }
+      }
+
+      Timer {
+        id: cullingTimer
+        interval: 0
+        onTriggered: splitWrapper.updateCulling()
+      }
+
+      Connections {
+        target: scrollView.ScrollBar.vertical
+        onPositionChanged: splitWrapper.scheduleCulling()
+        onSizeChanged: splitWrapper.scheduleCulling()
+      }
+
       ScrollView {
+        id: scrollView
         contentHeight: split.height
         contentWidth: split.width + scrollBarWidth
 
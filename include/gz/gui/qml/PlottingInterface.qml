@@ -184,9 +184,33 @@ Rectangle
     charts[_chart].appendPoint(_fieldID, _x, _y);
   }
 
+  /**
+  plot several points to a chart
+  _chart: chart id
+  _fieldID: field path or id
+  _points: points in time order
+  */
+  function handlePlotPoints(_chart, _fieldID, _points)
+  {
+    charts[_chart].appendPoints(_fieldID, _points);
+  }
+
+  /**
+  replace the points of a series of a chart, such as a spectrum
+  _chart: chart id
+  _fieldID: series id
+  _points: points in increasing x
+  */
+  function handlePlotSeries(_chart, _fieldID, _points)
+  {
+    charts[_chart].setPoints(_fieldID, _points);
+  }
+
   Connections {
     target: PlottingIface
     onPlot : handlePlot(_chart, _fieldID, _x, _y);
+    onPlotPoints : handlePlotPoints(_chart, _fieldID, _points);
+    onPlotSeries : handlePlotSeries(_chart, _fieldID, _points);
   }
 
 
@@ -430,6 +454,9 @@ Rectangle
         if (Object.keys(serieses).length === 0)
           continue;
 
+        // topic fields are streamed from their recorded history, which
+        // holds every sample instead of only the plotted ones
+        var exported = PlottingIface.exportHistoryCSV(path, chart_id);
 
         // convert Serieses to Map of {series_name : points list}
         // slots in cpp accepts QMap<QString, QVariant>
@@ -439,6 +466,9 @@ Rectangle
         var seriesArray = [];
         Object.keys(serieses).forEach(function(key) {
 
+          if (exported.indexOf(key) !== -1)
+            return;
+
           seriesArray = []
 
           // convert Series to QList<QPointF>
@@ -449,6 +479,9 @@ Rectangle
           chartSerieses[key] = seriesArray;
         });
 
+        if (Object.keys(chartSerieses).length === 0)
+          return true;
+
         return PlottingIface.exportCSV(path, chart_id, chartSerieses);
       }
       }
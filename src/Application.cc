@@ -16,7 +16,17 @@
  */
 
 #include <tinyxml2.h>
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <future>
+#include <map>
+#include <mutex>
 #include <queue>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
@@ -25,7 +35,11 @@
 #include <gz/common/SystemPaths.hh>
 #include <gz/common/Util.hh>
 
+#include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/stringmsg.pb.h>
+
 #include <gz/plugin/Loader.hh>
+#include <gz/transport/Node.hh>
 
 #include "gz/gui/Application.hh"
 #include "gz/gui/config.hh"
@@ -33,6 +47,12 @@
 #include "gz/gui/Helpers.hh"
 #include "gz/gui/MainWindow.hh"
 #include "gz/gui/Plugin.hh"
+#include "gz/gui/Profiler.hh"
+#include "gz/gui/RenderDevice.hh"
+#include "gz/gui/SamplingProfiler.hh"
+#include "gz/gui/StartupProfiler.hh"
+#include "gz/gui/StaticPlugins.hh"
+#include "gz/gui/WorkerPool.hh"
 
 #include "gz/transport/TopicUtils.hh"
 
@@ -40,11 +60,128 @@ namespace gz
 {
   namespace gui
   {
+    /// \brief Shared library of a plugin, found and loaded before the
+    /// plugin is instantiated
+    struct PluginLibrary
+    {
+      /// \brief Full path to the library, empty if it wasn't found
+      std::string path;
+
+      /// \brief True if it was found through the deprecated environment
+      /// variable
+      bool deprecatedPath{false};
+
+      /// \brief Loader holding the library
+      std::shared_ptr<plugin::Loader> loader;
+
+      /// \brief Names of the plugins in the library, empty if it couldn't
+      /// be loaded
+      std::unordered_set<std::string> pluginNames;
+    };
+
+    /// \brief Directory of the plugin paths and its files
+    struct PluginDir
+    {
+      /// \brief Path to the directory
+      std::string path;
+
+      /// \brief Names of the files in it
+      std::vector<std::string> files;
+
+      /// \brief True if it comes from the deprecated environment variable
+      bool deprecated{false};
+    };
+
     class ApplicationPrivate
     {
+      /// \brief List the plugin directories and index their libraries, if
+      /// it isn't up to date. Must be called with pluginIndexMutex locked.
+      public: void UpdatePluginIndex() const;
+
+      /// \brief Rebuild the index the next time it's needed
+      public: void InvalidatePluginIndex();
+
+      /// \brief Find a plugin's library on the plugin paths and load it.
+      /// It only reads the paths, so several libraries can be loaded from
+      /// different threads while the paths don't change.
+      /// \param[in] _filename Plugin filename
+      /// \return The library, see PluginLibrary for failures
+      public: PluginLibrary LoadPluginLibrary(
+          const std::string &_filename) const;
+
+      /// \brief Search the plugin paths for a library, without the index
+      /// \param[in] _filename Plugin filename
+      /// \param[out] _deprecated True if it was found through the
+      /// deprecated environment variable
+      /// \return Full path, empty if not found
+      public: std::string FindPluginLibrary(const std::string &_filename,
+          bool &_deprecated) const;
+
+      /// \brief Start loading the libraries of plugins on worker threads,
+      /// so LoadPlugin only has to instantiate them.
+      /// \param[in] _filenames Plugin filenames
+      public: void PreloadPluginLibraries(
+          const std::vector<std::string> &_filenames);
+
+      /// \brief Find and load a plugin's library, unless it was already
+      /// loaded or preloaded, and instantiate the plugin.
+      /// \param[in] _filename Plugin filename
+      /// \param[out] _path Full path to the library
+      /// \return The plugin, null on failure, which is logged
+      public: std::shared_ptr<Plugin> InstantiateFromLibrary(
+          const std::string &_filename, std::string &_path);
+
+      /// \brief Wait for the preloading threads
+      public: void JoinPreloading();
+
+      /// \brief Libraries being loaded by PreloadPluginLibraries, taken by
+      /// the first LoadPlugin of each filename
+      public: std::map<std::string, std::future<PluginLibrary>> preloaded;
+
+      /// \brief Threads loading the preloaded libraries
+      public: std::vector<std::thread> preloadThreads;
+
+      /// \brief Libraries which have been loaded, by plugin filename. They
+      /// stay loaded, so more instances of their plugins are instantiated
+      /// without searching and loading them again.
+      public: std::map<std::string, PluginLibrary> loadedLibraries;
+
+      /// \brief Protects the plugin index, which is used by the preloading
+      /// threads
+      public: mutable std::mutex pluginIndexMutex;
+
+      /// \brief Whether the plugin index is up to date
+      public: mutable bool pluginIndexValid{false};
+
+      /// \brief Plugin directories in the order of PluginList
+      public: mutable std::vector<PluginDir> pluginDirs;
+
+      /// \brief Path to each library of the plugin directories, and whether
+      /// it's on a deprecated path. The library is found by its file name,
+      /// with or without the extension and "lib" prefix.
+      public: mutable std::unordered_map<std::string,
+          std::pair<std::string, bool>> pluginLibraries;
+
+      /// \brief Watches the plugin directories which exist, so the index is
+      /// rebuilt when plugins are installed or removed
+      public: QFileSystemWatcher pluginWatcher;
+
+      /// \brief Get the main window's split layout.
+      /// \return The layout, null if there's no main window.
+      public: QQuickItem *Background() const;
+
+      /// \brief Number of unfinished BeginLayoutChange calls
+      public: int layoutChangeDepth{0};
+
+      /// \brief True if the whole session is traced, until destruction
+      public: bool sessionTrace{false};
+
       /// \brief QML engine
       public: QQmlApplicationEngine *engine{nullptr};
 
+      /// \brief Components of QML files, by file path
+      public: std::map<std::string, QPointer<QQmlComponent>> components;
+
       /// \brief Pointer to main window
       public: MainWindow *mainWin{nullptr};
 
@@ -78,6 +215,21 @@ namespace gz
 
       public: common::SignalHandler signalHandler;
 
+      /// \brief Start or stop the sampling profiler, see
+      /// Application::Application.
+      /// \param[in] _req True to start, false to stop and write the profile
+      /// \param[out] _rep Path of the profile
+      /// \return False if it couldn't be started or written
+      public: bool OnSamplingProfiler(const msgs::Boolean &_req,
+          msgs::StringMsg &_rep);
+
+      /// \brief True if the sampling profiler was started by the service,
+      /// so it's written on destruction if it wasn't stopped
+      public: std::atomic<bool> samplingStarted{false};
+
+      /// \brief Node of the sampling profiler's service
+      public: std::unique_ptr<transport::Node> profilerNode;
+
       /// \brief QT message handler that pipes qt messages into our console
       /// system.
       public: static void MessageHandler(QtMsgType _type,
@@ -86,13 +238,81 @@ namespace gz
   }
 }
 
+namespace
+{
+  /// \brief True if headlessArgc set QT_QPA_PLATFORM, so it's unset again
+  /// and later applications of the process aren't affected
+  bool g_headlessPlatformSet{false};
+
+  /// \brief True in the lightweight mode, see Application::SetLite
+  bool g_lite{false};
+
+  /// \brief True once Application::SetLite was called, so GZ_GUI_LITE
+  /// doesn't override it
+  bool g_liteSet{false};
+
+  /// \brief True if a lightweight application chose the software
+  /// adaptation, so it's reset for later applications of the process
+  bool g_softwareBackendSet{false};
+
+  /// \brief Plugins of this library which need a 3D scene or a render
+  /// engine
+  const std::unordered_set<std::string> kRenderPlugins{
+    "CameraFps",
+    "CameraTracking",
+    "GridConfig",
+    "InteractiveViewControl",
+    "MarkerManager",
+    "MinimalScene",
+    "PointCloud",
+    "Screenshot",
+    "TapeMeasure",
+    "TransportSceneManager",
+    "VideoRecorder"
+  };
+
+  /////////////////////////////////////////////////
+  /// \brief Choose the offscreen platform for headless applications, and
+  /// the render device, which must happen before QApplication is
+  /// constructed and loads the graphics drivers.
+  /// \param[in] _argc Argument count, passed through.
+  /// \param[in] _type Window type.
+  /// \return _argc
+  int &headlessArgc(int &_argc, gz::gui::WindowType _type)
+  {
+    std::string lite;
+    if (!g_liteSet && gz::common::env("GZ_GUI_LITE", lite))
+      g_lite = lite == "1" || gz::common::lowercase(lite) == "true";
+
+    // Nothing renders on the GPU
+    if (!g_lite)
+      gz::gui::RenderDevice::SelectFromEnvironment();
+
+    g_headlessPlatformSet = false;
+    if (_type == gz::gui::WindowType::kHeadless &&
+        !qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+    {
+      qputenv("QT_QPA_PLATFORM", "offscreen");
+      g_headlessPlatformSet = true;
+    }
+    return _argc;
+  }
+}
+
 using namespace gz;
 using namespace gui;
 
 /////////////////////////////////////////////////
 Application::Application(int &_argc, char **_argv, const WindowType _type)
-  : QApplication(_argc, _argv), dataPtr(new ApplicationPrivate)
+  : QApplication(headlessArgc(_argc, _type), _argv),
+    dataPtr(new ApplicationPrivate)
 {
+  if (g_headlessPlatformSet)
+  {
+    qunsetenv("QT_QPA_PLATFORM");
+    g_headlessPlatformSet = false;
+  }
+
   gzdbg << "Initializing application." << std::endl;
 
   this->setOrganizationName("Gazebo");
@@ -105,10 +325,32 @@ Application::Application(int &_argc, char **_argv, const WindowType _type)
   // TODO(azeey) Remove once Qt 5.12 is available in all supported platforms.
   QLoggingCategory::setFilterRules("qt.qml.connections=false");
 
+  this->connect(&this->dataPtr->pluginWatcher,
+      &QFileSystemWatcher::directoryChanged, this, [this]()
+      {
+        this->dataPtr->InvalidatePluginIndex();
+        this->PluginListChanged();
+      });
+
+  if (g_lite)
+  {
+    // Unless another backend was chosen through the environment
+    if (!qEnvironmentVariableIsSet("QT_QUICK_BACKEND"))
+    {
+      QQuickWindow::setSceneGraphBackend(QSGRendererInterface::Software);
+      g_softwareBackendSet = true;
+    }
+    gzdbg << "Lightweight mode, Qt Quick using the ["
+          << QQuickWindow::sceneGraphBackend().toStdString()
+          << "] adaptation" << std::endl;
+  }
 #if __APPLE__
   // Use the Metal graphics API on macOS.
-  gzdbg << "Qt using Metal graphics interface" << std::endl;
-  QQuickWindow::setSceneGraphBackend(QSGRendererInterface::MetalRhi);
+  else
+  {
+    gzdbg << "Qt using Metal graphics interface" << std::endl;
+    QQuickWindow::setSceneGraphBackend(QSGRendererInterface::MetalRhi);
+  }
 
   // TODO(srmainwaring): implement facility for overriding the default
   //    graphics API in macOS, in which case there are restrictions on
@@ -125,12 +367,33 @@ Application::Application(int &_argc, char **_argv, const WindowType _type)
   // QSurfaceFormat::setDefaultFormat(format);
 #else
   // Otherwise use OpenGL
-  gzdbg << "Qt using OpenGL graphics interface" << std::endl;
+  else
+  {
+    if (g_softwareBackendSet)
+    {
+      QQuickWindow::setSceneGraphBackend(QString());
+      g_softwareBackendSet = false;
+    }
+    gzdbg << "Qt using OpenGL graphics interface" << std::endl;
+  }
 #endif
 
   // Configure console
   common::Console::SetPrefix("[GUI] ");
 
+  GZ_GUI_PROFILE_THREAD_NAME("Qt GUI");
+
+#if GZ_GUI_TRACE_ENABLE
+  // Trace the whole session, rather than the startup only
+  std::string tracePath;
+  if (!StartupProfiler::Enabled() &&
+      common::env("GZ_GUI_TRACE_FILE", tracePath) && !tracePath.empty())
+  {
+    StartupProfiler::Enable(tracePath);
+    this->dataPtr->sessionTrace = true;
+  }
+#endif
+
   // QML engine
   this->dataPtr->engine = new QQmlApplicationEngine();
   this->dataPtr->engine->addImportPath(qmlQrcImportPath());
@@ -151,12 +414,38 @@ Application::Application(int &_argc, char **_argv, const WindowType _type)
   this->dataPtr->defaultConfigPath = common::joinPaths(
         home, ".gz", "gui", "default.config");
 
+  // Sampling profiler, which can be toggled on machines in the field
+  this->dataPtr->profilerNode = std::make_unique<transport::Node>();
+  if (!this->dataPtr->profilerNode->Advertise("/gui/sampling_profiler",
+      &ApplicationPrivate::OnSamplingProfiler, this->dataPtr.get()))
+  {
+    gzwarn << "Failed to advertise [/gui/sampling_profiler], the sampling "
+           << "profiler can't be toggled" << std::endl;
+  }
+
   // If it's a main window, initialize it
   if (_type == WindowType::kMainWindow)
   {
     if (!this->InitializeMainWindow())
       gzerr << "Failed to initialize main window." << std::endl;
   }
+  else if (_type == WindowType::kHeadless)
+  {
+    gzdbg << "Headless application on platform ["
+          << this->platformName().toStdString() << "]" << std::endl;
+
+    // The render loop is chosen when the first window is created. The
+    // basic loop renders as frames are stepped, on this thread.
+    bool setLoop = !qEnvironmentVariableIsSet("QSG_RENDER_LOOP");
+    if (setLoop)
+      qputenv("QSG_RENDER_LOOP", "basic");
+
+    if (!this->InitializeMainWindow())
+      gzerr << "Failed to initialize headless main window." << std::endl;
+
+    if (setLoop)
+      qunsetenv("QSG_RENDER_LOOP");
+  }
   else if (_type == WindowType::kDialog)
   {
     // Do nothing, dialogs are initialized as plugins are loaded
@@ -205,6 +494,38 @@ Application::~Application()
   this->dataPtr->pluginsAdded.clear();
   this->dataPtr->pluginPaths.clear();
   this->dataPtr->pluginPathEnv = "GZ_GUI_PLUGIN_PATH";
+
+  if (this->dataPtr->sessionTrace)
+    StartupProfiler::Write();
+
+  this->dataPtr->profilerNode.reset();
+  if (this->dataPtr->samplingStarted && SamplingProfiler::Running())
+    SamplingProfiler::Stop();
+
+  // The plugins are gone, so their tasks are too
+  WorkerPool::Shutdown();
+}
+
+/////////////////////////////////////////////////
+void Application::SetLite(bool _lite)
+{
+  g_lite = _lite;
+  g_liteSet = true;
+}
+
+/////////////////////////////////////////////////
+bool Application::Lite()
+{
+  return g_lite;
+}
+
+/////////////////////////////////////////////////
+bool Application::IsRenderPlugin(const std::string &_filename)
+{
+  auto name = common::basename(_filename);
+  if (name.find("lib") == 0)
+    name = name.substr(3);
+  return kRenderPlugins.count(name.substr(0, name.find('.'))) > 0;
 }
 
 /////////////////////////////////////////////////
@@ -213,6 +534,78 @@ QQmlApplicationEngine *Application::Engine() const
   return this->dataPtr->engine;
 }
 
+/////////////////////////////////////////////////
+void Application::BeginLayoutChange()
+{
+  if (++this->dataPtr->layoutChangeDepth > 1)
+    return;
+
+  if (auto bgItem = this->dataPtr->Background())
+    QMetaObject::invokeMethod(bgItem, "beginBatch");
+}
+
+/////////////////////////////////////////////////
+void Application::EndLayoutChange()
+{
+  if (this->dataPtr->layoutChangeDepth == 0)
+  {
+    gzwarn << "EndLayoutChange called without BeginLayoutChange"
+           << std::endl;
+    return;
+  }
+
+  if (--this->dataPtr->layoutChangeDepth > 0)
+    return;
+
+  if (auto bgItem = this->dataPtr->Background())
+    QMetaObject::invokeMethod(bgItem, "endBatch");
+
+  if (this->dataPtr->mainWin)
+  {
+    this->dataPtr->mainWin->SetPluginCount(
+        this->dataPtr->pluginsAdded.size());
+  }
+}
+
+/////////////////////////////////////////////////
+bool Application::StepFrame(int _timeoutMs)
+{
+  if (!this->dataPtr->mainWin || !this->dataPtr->mainWin->QuickWindow())
+    return false;
+
+  auto window = this->dataPtr->mainWin->QuickWindow();
+
+  // Swapped on the render thread, which may be this one
+  auto swapped = std::make_shared<std::atomic<bool>>(false);
+  auto connection = this->connect(window, &QQuickWindow::frameSwapped,
+      [swapped]()
+  {
+    *swapped = true;
+  });
+
+  window->update();
+
+  QElapsedTimer timer;
+  timer.start();
+  while (!*swapped && timer.elapsed() < _timeoutMs)
+    this->processEvents(QEventLoop::AllEvents, 10);
+
+  this->disconnect(connection);
+  return *swapped;
+}
+
+/////////////////////////////////////////////////
+QQmlComponent *Application::Component(const std::string &_qmlFile)
+{
+  auto &component = this->dataPtr->components[_qmlFile];
+  if (!component)
+  {
+    component = new QQmlComponent(this->dataPtr->engine,
+        QString::fromStdString(_qmlFile), this->dataPtr->engine);
+  }
+  return component;
+}
+
 /////////////////////////////////////////////////
 Application *gz::gui::App()
 {
@@ -234,15 +627,14 @@ bool Application::RemovePlugin(const std::string &_pluginName)
   cardItem->deleteLater();
 
   // Remove split on QML
-  auto bgItem = this->dataPtr->mainWin->QuickWindow()
-      ->findChild<QQuickItem *>("background");
+  auto bgItem = this->dataPtr->Background();
   if (bgItem && cardItem->parentItem())
   {
     QMetaObject::invokeMethod(bgItem, "removeSplitItem",
         Q_ARG(QVariant, cardItem->parentItem()->objectName()));
   }
 
-  // Unload shared library
+  // Release the plugin, its shared library stays loaded
   this->RemovePlugin(plugin);
 
   return true;
@@ -285,7 +677,10 @@ bool Application::LoadConfig(const std::string &_config)
 
   // Use tinyxml to read config
   tinyxml2::XMLDocument doc;
+  auto parseStart = StartupProfiler::Clock::now();
   auto success = !doc.LoadFile(configFull.c_str());
+  StartupProfiler::Record(configFull, "Parse config", parseStart,
+      StartupProfiler::Clock::now());
   if (!success)
   {
     // We do not show an error message if the default config path doesn't exist
@@ -302,6 +697,9 @@ bool Application::LoadConfig(const std::string &_config)
 
   gzmsg << "Loading config [" << configFull << "]" << std::endl;
 
+  // Replace all plugins, updating the layout once at the end
+  this->BeginLayoutChange();
+
   // Clear all previous plugins
   auto plugins = this->dataPtr->mainWin->findChildren<Plugin *>();
   for (auto plugin : plugins)
@@ -315,27 +713,45 @@ bool Application::LoadConfig(const std::string &_config)
   }
   this->dataPtr->pluginsAdded.clear();
 
+  // Split the document in a single pass. The elements are used in place,
+  // without printing and parsing them again.
+  std::vector<const tinyxml2::XMLElement *> pluginElems;
+  const tinyxml2::XMLElement *winElem{nullptr};
+  std::vector<std::string> filenames;
+  for (auto elem = doc.FirstChildElement(); elem != nullptr;
+      elem = elem->NextSiblingElement())
+  {
+    if (std::string(elem->Name()) == "plugin")
+    {
+      pluginElems.push_back(elem);
+      if (auto filename = elem->Attribute("filename"))
+        filenames.push_back(filename);
+    }
+    else if (std::string(elem->Name()) == "window" && nullptr == winElem)
+    {
+      winElem = elem;
+    }
+  }
+
+  // Find and load all libraries in parallel, while the plugins are
+  // instantiated in order on this thread
+  this->dataPtr->PreloadPluginLibraries(filenames);
+
   // Process each plugin
-  for (auto pluginElem = doc.FirstChildElement("plugin"); pluginElem != nullptr;
-      pluginElem = pluginElem->NextSiblingElement("plugin"))
+  for (auto pluginElem : pluginElems)
   {
     auto filename = pluginElem->Attribute("filename");
-    this->LoadPlugin(filename, pluginElem);
+    this->LoadPlugin(filename ? filename : "", pluginElem);
   }
+  this->dataPtr->JoinPreloading();
+  this->EndLayoutChange();
 
   // Process window properties
-  if (auto winElem = doc.FirstChildElement("window"))
+  if (winElem)
   {
     gzdbg << "Loading window config" << std::endl;
 
-    tinyxml2::XMLPrinter printer;
-    if (!winElem->Accept(&printer))
-    {
-      gzwarn << "There was an error parsing the <window> element"
-              << std::endl;
-      return false;
-    }
-    this->dataPtr->windowConfig.MergeFromXML(std::string(printer.CStr()));
+    this->dataPtr->windowConfig.MergeFromXML(winElem);
 
     // Closing behavior.
     if (auto defaultExitActionElem =
@@ -456,94 +872,36 @@ bool Application::LoadPlugin(const std::string &_filename,
     return false;
   }
 
-  gzdbg << "Loading plugin [" << _filename << "]" << std::endl;
-
-  common::SystemPaths systemPaths;
-  systemPaths.SetPluginPathEnv(this->dataPtr->pluginPathEnv);
-
-  for (const auto &path : this->dataPtr->pluginPaths)
-    systemPaths.AddPluginPaths(path);
-
-  // Add default folder and install folder
-  std::string home;
-  common::env(GZ_HOMEDIR, home);
-  systemPaths.AddPluginPaths(home + "/.gz/gui/plugins:" +
-                             GZ_GUI_PLUGIN_INSTALL_DIR);
-
-  // TODO(CH3): Deprecated. Remove on tock.
-  systemPaths.AddPluginPaths(home + "/.ignition/gui/plugins:" +
-                             GZ_GUI_PLUGIN_INSTALL_DIR);
-
-
-  auto pathToLib = systemPaths.FindSharedLibrary(_filename);
-  if (pathToLib.empty())
+  // Not even its library is loaded
+  if (g_lite && IsRenderPlugin(_filename))
   {
-    // Try deprecated environment variable
-    common::SystemPaths systemPathsDep;
-    systemPathsDep.SetPluginPathEnv(this->dataPtr->pluginPathEnvDeprecated);
-    pathToLib = systemPathsDep.FindSharedLibrary(_filename);
-    if (pathToLib.empty())
-    {
-      gzerr << "Failed to load plugin [" << _filename <<
-                "] : couldn't find shared library." << std::endl;
-      return false;
-    }
-    else
-    {
-      gzwarn << "Found plugin [" << _filename
-              << "] using deprecated environment variable ["
-              << this->dataPtr->pluginPathEnvDeprecated << "]. Please use ["
-              << this->dataPtr->pluginPathEnv << "] instead." << std::endl;
-    }
-  }
-
-  // Load plugin
-  plugin::Loader pluginLoader;
-
-  auto pluginNames = pluginLoader.LoadLib(pathToLib, true);
-  if (pluginNames.empty())
-  {
-    gzerr << "Failed to load plugin [" << _filename <<
-              "] : couldn't load library on path [" << pathToLib <<
-              "]." << std::endl;
+    gzmsg << "Skipping plugin [" << _filename << "], it needs a 3D scene "
+          << "and the application is in lightweight mode" << std::endl;
     return false;
   }
 
-  // Go over all plugin names and get the first one that implements the
-  // gz::gui::Plugin interface
-  plugin::PluginPtr commonPlugin;
+  gzdbg << "Loading plugin [" << _filename << "]" << std::endl;
+
+  // Plugins linked into the executable don't have a library
+  std::string pathToLib;
   std::shared_ptr<gui::Plugin> plugin{nullptr};
-  for (auto pluginName : pluginNames)
+  if (StaticPlugins::Has(_filename))
   {
-    commonPlugin = pluginLoader.Instantiate(pluginName);
-    if (!commonPlugin)
-      continue;
-
-    plugin = commonPlugin->QueryInterfaceSharedPtr<gz::gui::Plugin>();
-    if (plugin)
-      break;
+    StartupProfiler::Scope instantiateProfile(_filename, "Instantiate");
+    plugin = StaticPlugins::Instantiate(_filename);
+    pathToLib = "built-in";
   }
-
-  if (!commonPlugin)
+  else
   {
-    gzerr << "Failed to load plugin [" << _filename <<
-              "] : couldn't instantiate plugin on path [" << pathToLib <<
-              "]. Tried plugin names: " << std::endl;
-
-    for (auto pluginName : pluginNames)
-    {
-      gzerr << " * " << pluginName << std::endl;
-    }
-    return false;
+    plugin = this->dataPtr->InstantiateFromLibrary(_filename, pathToLib);
   }
 
   if (!plugin)
-  {
-    gzerr << "Failed to load plugin [" << _filename <<
-              "] : couldn't get [gz::gui::Plugin] interface."
-           << std::endl;
     return false;
-  }
+
+  // Already in the trace as a startup step
+  GZ_PROFILE("Application::LoadPlugin");
+  StartupProfiler::Scope loadProfile(_filename, "Load plugin");
 
   // Basic config in case there is none
   if (!_pluginElem)
@@ -606,15 +964,34 @@ bool Application::InitializeMainWindow()
 {
   gzdbg << "Create main window" << std::endl;
 
+  StartupProfiler::Scope profile("MainWindow", "Initialize main window");
   this->dataPtr->mainWin = new MainWindow();
   if (!this->dataPtr->mainWin->QuickWindow())
     return false;
 
   this->dataPtr->mainWin->setParent(this);
 
+  // Keep the cached pointer valid no matter how the window is destroyed
+  auto win = this->dataPtr->mainWin;
+  this->connect(win, &QObject::destroyed, this, [this, win]()
+  {
+    if (this->dataPtr->mainWin == win)
+      this->dataPtr->mainWin = nullptr;
+  });
+
   return true;
 }
 
+/////////////////////////////////////////////////
+MainWindow *Application::MainWin() const
+{
+  if (nullptr != this->dataPtr->mainWin)
+    return this->dataPtr->mainWin;
+
+  // Fallback for main windows which weren't created by the application
+  return this->findChild<MainWindow *>();
+}
+
 /////////////////////////////////////////////////
 bool Application::ApplyConfig()
 {
@@ -633,8 +1010,7 @@ bool Application::AddPluginsToWindow()
     return false;
 
   // Get main window background item
-  auto bgItem = this->dataPtr->mainWin->QuickWindow()
-      ->findChild<QQuickItem *>("background");
+  auto bgItem = this->dataPtr->Background();
   if (!this->dataPtr->pluginsToAdd.empty() && !bgItem)
   {
     gzerr << "Null background QQuickItem!" << std::endl;
@@ -689,7 +1065,11 @@ bool Application::AddPluginsToWindow()
         std::endl;
   }
 
-  this->dataPtr->mainWin->SetPluginCount(this->dataPtr->pluginsAdded.size());
+  if (this->dataPtr->layoutChangeDepth == 0)
+  {
+    this->dataPtr->mainWin->SetPluginCount(
+        this->dataPtr->pluginsAdded.size());
+  }
 
   return true;
 }
@@ -747,64 +1127,70 @@ bool Application::InitializeDialogs()
 void Application::SetPluginPathEnv(const std::string &_env)
 {
   this->dataPtr->pluginPathEnv = _env;
+  this->dataPtr->InvalidatePluginIndex();
+  this->PluginListChanged();
 }
 
 /////////////////////////////////////////////////
 void Application::AddPluginPath(const std::string &_path)
 {
   this->dataPtr->pluginPaths.push_back(_path);
+  this->dataPtr->InvalidatePluginIndex();
+  this->PluginListChanged();
 }
 
 /////////////////////////////////////////////////
 std::vector<std::pair<std::string, std::vector<std::string>>>
     Application::PluginList()
 {
-  // 1. Paths from env variable
-  auto paths = common::SystemPaths::PathsFromEnv(this->dataPtr->pluginPathEnv);
-
-  // 1.5 Paths from deprecated env variable
-  auto pathsDeprecated =
-      common::SystemPaths::PathsFromEnv(this->dataPtr->pluginPathEnvDeprecated);
+  std::lock_guard<std::mutex> lock(this->dataPtr->pluginIndexMutex);
+  this->dataPtr->UpdatePluginIndex();
 
-  for (auto const &path : pathsDeprecated)
-    paths.push_back(path);
-
-  // 2. Paths added by calling addPluginPath
-  for (auto const &path : this->dataPtr->pluginPaths)
-    paths.push_back(path);
-
-  // 3. ~/.gz/gui/plugins
-  std::string home;
-  common::env(GZ_HOMEDIR, home);
-  paths.push_back(home + "/.gz/gui/plugins");
-
-  // TODO(CH3): Deprecated. Remove on tock.
-  paths.push_back(home + "/.ignition/gui/plugins");
-
-  // 4. Install path
-  paths.push_back(GZ_GUI_PLUGIN_INSTALL_DIR);
-
-  // Populate map
   std::vector<std::pair<std::string, std::vector<std::string>>> plugins;
 
-  for (auto const &path : paths)
+  // Plugins linked into the executable are found first
+  auto builtIn = StaticPlugins::Filenames();
+  if (g_lite)
+  {
+    builtIn.erase(std::remove_if(builtIn.begin(), builtIn.end(),
+        &Application::IsRenderPlugin), builtIn.end());
+  }
+  if (!builtIn.empty())
+    plugins.push_back(std::make_pair(std::string("built-in"), builtIn));
+
+  for (const auto &dir : this->dataPtr->pluginDirs)
   {
     std::vector<std::string> ps;
 
-    common::DirIter endIter;
-    for (common::DirIter dirIter(path);
-        dirIter != endIter; ++dirIter)
+    // All we verify is that the file starts with "lib", any further
+    // checks would require loading the plugin.
+    for (const auto &file : dir.files)
     {
-      auto plugin = common::basename(*dirIter);
-
-      // All we verify is that the file starts with "lib", any further
-      // checks would require loading the plugin.
-
-      if (plugin.find("lib") == 0)
-        ps.push_back(plugin);
+      if (file.find("lib") == 0 && !(g_lite && IsRenderPlugin(file)))
+        ps.push_back(file);
     }
 
-    plugins.push_back(std::make_pair(path, ps));
+    plugins.push_back(std::make_pair(dir.path, ps));
+  }
+
+  // The watcher lives on this thread, unlike the index, which may be
+  // rebuilt by the preloading threads
+  QStringList watched;
+  for (const auto &dir : this->dataPtr->pluginDirs)
+  {
+    auto path = QString::fromStdString(dir.path);
+    if (common::isDirectory(dir.path) && !watched.contains(path))
+      watched.append(path);
+  }
+  watched.sort();
+  auto &watcher = this->dataPtr->pluginWatcher;
+  auto current = watcher.directories();
+  current.sort();
+  if (current != watched)
+  {
+    if (!current.isEmpty())
+      watcher.removePaths(current);
+    watcher.addPaths(watched);
   }
 
   return plugins;
@@ -820,6 +1206,8 @@ void Application::OnPluginClose()
 /////////////////////////////////////////////////
 void Application::RemovePlugin(std::shared_ptr<Plugin> _plugin)
 {
+  WorkerPool::Cancel(_plugin.get());
+
   this->dataPtr->pluginsAdded.erase(std::remove(
       this->dataPtr->pluginsAdded.begin(),
       this->dataPtr->pluginsAdded.end(), _plugin),
@@ -827,10 +1215,12 @@ void Application::RemovePlugin(std::shared_ptr<Plugin> _plugin)
 
   auto pluginCount = this->dataPtr->pluginsAdded.size();
 
-  // Update main window count
+  // Update main window count, unless it's updated at the end of a layout
+  // change
   if (this->dataPtr->mainWin)
   {
-    this->dataPtr->mainWin->SetPluginCount(pluginCount);
+    if (this->dataPtr->layoutChangeDepth == 0)
+      this->dataPtr->mainWin->SetPluginCount(pluginCount);
   }
   // Or close app if it's the last dialog
   else if (pluginCount == 0)
@@ -839,6 +1229,61 @@ void Application::RemovePlugin(std::shared_ptr<Plugin> _plugin)
   }
 }
 
+//////////////////////////////////////////////////
+QQuickItem *ApplicationPrivate::Background() const
+{
+  if (!this->mainWin || !this->mainWin->QuickWindow())
+    return nullptr;
+
+  return this->mainWin->QuickWindow()->findChild<QQuickItem *>("background");
+}
+
+//////////////////////////////////////////////////
+bool ApplicationPrivate::OnSamplingProfiler(const msgs::Boolean &_req,
+    msgs::StringMsg &_rep)
+{
+  if (!_req.data())
+  {
+    _rep.set_data(SamplingProfiler::Path());
+    this->samplingStarted = false;
+    return SamplingProfiler::Stop();
+  }
+
+  if (SamplingProfiler::Running())
+  {
+    _rep.set_data(SamplingProfiler::Path());
+    return true;
+  }
+
+  std::string dir;
+  if (!common::env("GZ_GUI_SAMPLING_PROFILE_DIR", dir) || dir.empty())
+  {
+    std::string home;
+    common::env(GZ_HOMEDIR, home);
+    dir = common::joinPaths(home, ".gz", "gui", "profiles");
+  }
+  if (!common::createDirectories(dir))
+  {
+    gzerr << "Failed to create [" << dir << "] for the sampling profile"
+          << std::endl;
+    return false;
+  }
+
+  char stamp[32];
+  auto now = std::time(nullptr);
+  std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S",
+      std::localtime(&now));
+  auto path = common::joinPaths(dir,
+      std::string("sampling_") + stamp + ".folded");
+
+  if (!SamplingProfiler::Start(path))
+    return false;
+
+  this->samplingStarted = true;
+  _rep.set_data(path);
+  return true;
+}
+
 //////////////////////////////////////////////////
 void ApplicationPrivate::MessageHandler(QtMsgType _type,
     const QMessageLogContext &_context, const QString &_msg)
@@ -868,3 +1313,308 @@ void ApplicationPrivate::MessageHandler(QtMsgType _type,
       break;
   }
 }
+
+//////////////////////////////////////////////////
+std::shared_ptr<Plugin> ApplicationPrivate::InstantiateFromLibrary(
+    const std::string &_filename, std::string &_path)
+{
+  // Use the library if it was already loaded or preloaded
+  PluginLibrary library;
+  auto loadedIt = this->loadedLibraries.find(_filename);
+  auto preloadedIt = this->preloaded.find(_filename);
+  if (loadedIt != this->loadedLibraries.end())
+  {
+    library = loadedIt->second;
+  }
+  else if (preloadedIt != this->preloaded.end())
+  {
+    library = preloadedIt->second.get();
+    this->preloaded.erase(preloadedIt);
+  }
+  else
+  {
+    library = this->LoadPluginLibrary(_filename);
+  }
+
+  _path = library.path;
+  const auto &pathToLib = _path;
+  if (pathToLib.empty())
+  {
+    gzerr << "Failed to load plugin [" << _filename <<
+              "] : couldn't find shared library." << std::endl;
+    return nullptr;
+  }
+
+  if (library.deprecatedPath)
+  {
+    gzwarn << "Found plugin [" << _filename
+            << "] using deprecated environment variable ["
+            << this->pluginPathEnvDeprecated << "]. Please use ["
+            << this->pluginPathEnv << "] instead." << std::endl;
+  }
+
+  auto &pluginLoader = *library.loader;
+  const auto &pluginNames = library.pluginNames;
+  if (pluginNames.empty())
+  {
+    gzerr << "Failed to load plugin [" << _filename <<
+              "] : couldn't load library on path [" << pathToLib <<
+              "]." << std::endl;
+    return nullptr;
+  }
+  this->loadedLibraries[_filename] = library;
+
+  // Go over all plugin names and get the first one that implements the
+  // gz::gui::Plugin interface
+  plugin::PluginPtr commonPlugin;
+  std::shared_ptr<gui::Plugin> plugin{nullptr};
+  auto instantiateStart = StartupProfiler::Clock::now();
+  for (auto pluginName : pluginNames)
+  {
+    commonPlugin = pluginLoader.Instantiate(pluginName);
+    if (!commonPlugin)
+      continue;
+
+    plugin = commonPlugin->QueryInterfaceSharedPtr<gz::gui::Plugin>();
+    if (plugin)
+      break;
+  }
+  StartupProfiler::Record(_filename, "Instantiate", instantiateStart,
+      StartupProfiler::Clock::now());
+
+  if (!commonPlugin)
+  {
+    gzerr << "Failed to load plugin [" << _filename <<
+              "] : couldn't instantiate plugin on path [" << pathToLib <<
+              "]. Tried plugin names: " << std::endl;
+
+    for (auto pluginName : pluginNames)
+    {
+      gzerr << " * " << pluginName << std::endl;
+    }
+    return nullptr;
+  }
+
+  if (!plugin)
+  {
+    gzerr << "Failed to load plugin [" << _filename <<
+              "] : couldn't get [gz::gui::Plugin] interface."
+           << std::endl;
+    return nullptr;
+  }
+
+  return plugin;
+}
+
+//////////////////////////////////////////////////
+PluginLibrary ApplicationPrivate::LoadPluginLibrary(
+    const std::string &_filename) const
+{
+  PluginLibrary library;
+
+  auto findStart = StartupProfiler::Clock::now();
+  {
+    std::lock_guard<std::mutex> lock(this->pluginIndexMutex);
+    this->UpdatePluginIndex();
+    auto it = this->pluginLibraries.find(_filename);
+    if (it != this->pluginLibraries.end())
+    {
+      library.path = it->second.first;
+      library.deprecatedPath = it->second.second;
+    }
+  }
+
+  // Search the paths for libraries which aren't in the index, such as
+  // absolute paths and libraries added after it was built
+  if (library.path.empty())
+    library.path = this->FindPluginLibrary(_filename, library.deprecatedPath);
+  StartupProfiler::Record(_filename, "Find library", findStart,
+      StartupProfiler::Clock::now());
+  if (library.path.empty())
+    return library;
+
+  StartupProfiler::Scope profile(_filename, "Load library");
+  library.loader = std::make_shared<plugin::Loader>();
+  library.pluginNames = library.loader->LoadLib(library.path, true);
+  return library;
+}
+
+//////////////////////////////////////////////////
+std::string ApplicationPrivate::FindPluginLibrary(
+    const std::string &_filename, bool &_deprecated) const
+{
+  common::SystemPaths systemPaths;
+  systemPaths.SetPluginPathEnv(this->pluginPathEnv);
+
+  for (const auto &path : this->pluginPaths)
+    systemPaths.AddPluginPaths(path);
+
+  // Add default folder and install folder
+  std::string home;
+  common::env(GZ_HOMEDIR, home);
+  systemPaths.AddPluginPaths(home + "/.gz/gui/plugins:" +
+                             GZ_GUI_PLUGIN_INSTALL_DIR);
+
+  // TODO(CH3): Deprecated. Remove on tock.
+  systemPaths.AddPluginPaths(home + "/.ignition/gui/plugins:" +
+                             GZ_GUI_PLUGIN_INSTALL_DIR);
+
+  auto path = systemPaths.FindSharedLibrary(_filename);
+  if (path.empty())
+  {
+    // Try deprecated environment variable
+    common::SystemPaths systemPathsDep;
+    systemPathsDep.SetPluginPathEnv(this->pluginPathEnvDeprecated);
+    path = systemPathsDep.FindSharedLibrary(_filename);
+    _deprecated = !path.empty();
+  }
+  return path;
+}
+
+//////////////////////////////////////////////////
+void ApplicationPrivate::UpdatePluginIndex() const
+{
+  if (this->pluginIndexValid)
+    return;
+
+  std::vector<std::pair<std::string, bool>> paths;
+
+  // 1. Paths from env variable
+  for (const auto &path : common::SystemPaths::PathsFromEnv(
+      this->pluginPathEnv))
+  {
+    paths.emplace_back(path, false);
+  }
+
+  // 1.5 Paths from deprecated env variable
+  for (const auto &path : common::SystemPaths::PathsFromEnv(
+      this->pluginPathEnvDeprecated))
+  {
+    paths.emplace_back(path, true);
+  }
+
+  // 2. Paths added by calling addPluginPath
+  for (auto const &path : this->pluginPaths)
+    paths.emplace_back(path, false);
+
+  // 3. ~/.gz/gui/plugins
+  std::string home;
+  common::env(GZ_HOMEDIR, home);
+  paths.emplace_back(home + "/.gz/gui/plugins", false);
+
+  // TODO(CH3): Deprecated. Remove on tock.
+  paths.emplace_back(home + "/.ignition/gui/plugins", false);
+
+  // 4. Install path
+  paths.emplace_back(GZ_GUI_PLUGIN_INSTALL_DIR, false);
+
+  this->pluginDirs.clear();
+  for (const auto &path : paths)
+  {
+    PluginDir dir;
+    dir.path = path.first;
+    dir.deprecated = path.second;
+
+    common::DirIter endIter;
+    for (common::DirIter dirIter(dir.path); dirIter != endIter; ++dirIter)
+      dir.files.push_back(common::basename(*dirIter));
+
+    this->pluginDirs.push_back(dir);
+  }
+
+  // The deprecated directories are searched last, and the first library
+  // with a name wins, like SystemPaths::FindSharedLibrary
+  this->pluginLibraries.clear();
+  for (auto deprecated : {false, true})
+  {
+    for (const auto &dir : this->pluginDirs)
+    {
+      if (dir.deprecated != deprecated)
+        continue;
+
+      for (const auto &file : dir.files)
+      {
+        auto dot = file.find('.');
+        if (dot == std::string::npos)
+          continue;
+
+        auto extension = file.substr(dot);
+        if (extension != ".so" && extension.find(".so.") != 0 &&
+            extension != ".dylib" && extension != ".dll")
+        {
+          continue;
+        }
+
+        auto value = std::make_pair(
+            common::joinPaths(dir.path, file), deprecated);
+        auto stem = file.substr(0, dot);
+        this->pluginLibraries.emplace(file, value);
+        this->pluginLibraries.emplace(stem, value);
+        if (stem.find("lib") == 0)
+          this->pluginLibraries.emplace(stem.substr(3), value);
+      }
+    }
+  }
+
+  this->pluginIndexValid = true;
+}
+
+//////////////////////////////////////////////////
+void ApplicationPrivate::InvalidatePluginIndex()
+{
+  std::lock_guard<std::mutex> lock(this->pluginIndexMutex);
+  this->pluginIndexValid = false;
+}
+
+//////////////////////////////////////////////////
+void ApplicationPrivate::PreloadPluginLibraries(
+    const std::vector<std::string> &_filenames)
+{
+  auto promises =
+      std::make_shared<std::vector<std::pair<std::string,
+      std::promise<PluginLibrary>>>>();
+  for (const auto &filename : _filenames)
+  {
+    if (filename.empty() || this->preloaded.count(filename) > 0 ||
+        this->loadedLibraries.count(filename) > 0 ||
+        StaticPlugins::Has(filename))
+    {
+      continue;
+    }
+
+    promises->emplace_back(filename, std::promise<PluginLibrary>());
+    this->preloaded[filename] = promises->back().second.get_future();
+  }
+
+  if (promises->empty())
+    return;
+
+  // Each thread takes the next library in order, so the first plugins are
+  // ready first
+  auto next = std::make_shared<std::atomic<size_t>>(0);
+  auto threadCount = std::min<size_t>(promises->size(),
+      std::max(1u, std::thread::hardware_concurrency()));
+  for (size_t i = 0; i < threadCount; ++i)
+  {
+    this->preloadThreads.emplace_back([this, promises, next]()
+    {
+      for (auto index = (*next)++; index < promises->size();
+          index = (*next)++)
+      {
+        auto &entry = (*promises)[index];
+        entry.second.set_value(this->LoadPluginLibrary(entry.first));
+      }
+    });
+  }
+}
+
+//////////////////////////////////////////////////
+void ApplicationPrivate::JoinPreloading()
+{
+  for (auto &thread : this->preloadThreads)
+    thread.join();
+  this->preloadThreads.clear();
+
+  // Libraries which weren't taken are released here
+  this->preloaded.clear();
+}
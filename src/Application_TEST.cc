@@ -18,6 +18,10 @@
 #include <stdlib.h>
 #include <gtest/gtest.h>
 #include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/stringmsg.pb.h>
+#include <gz/transport/Node.hh>
 #include <gz/utils/ExtraTestMacros.hh>
 
 #include "test_config.hh"  // NOLINT(build/include)
@@ -25,6 +29,7 @@
 #include "gz/gui/Dialog.hh"
 #include "gz/gui/MainWindow.hh"
 #include "gz/gui/Plugin.hh"
+#include "gz/gui/SamplingProfiler.hh"
 
 int g_argc = 1;
 char* g_argv[] =
@@ -62,6 +67,42 @@ TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Constructor))
   EXPECT_EQ(nullptr, App());
 }
 
+//////////////////////////////////////////////////
+TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Headless))
+{
+  common::Console::SetVerbosity(4);
+
+  bool platformSet = qEnvironmentVariableIsSet("QT_QPA_PLATFORM");
+
+  // Dialogs have no main window to step
+  {
+    Application app(g_argc, g_argv, WindowType::kDialog);
+    EXPECT_FALSE(app.StepFrame(100));
+  }
+
+  {
+    Application app(g_argc, g_argv, WindowType::kHeadless);
+    if (!platformSet)
+      EXPECT_EQ("offscreen", app.platformName().toStdString());
+
+    ASSERT_NE(nullptr, app.MainWin());
+    ASSERT_NE(nullptr, app.MainWin()->QuickWindow());
+
+    app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+    EXPECT_TRUE(app.LoadPlugin("TestPlugin"));
+    EXPECT_EQ(1, app.MainWin()->findChildren<Plugin *>().size());
+
+    EXPECT_TRUE(app.StepFrame());
+    EXPECT_TRUE(app.StepFrame());
+
+    auto image = app.MainWin()->QuickWindow()->grabWindow();
+    EXPECT_FALSE(image.isNull());
+  }
+
+  // The platform isn't kept for later applications
+  EXPECT_EQ(platformSet, qEnvironmentVariableIsSet("QT_QPA_PLATFORM"));
+}
+
 //////////////////////////////////////////////////
 TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LoadPlugin))
 {
@@ -110,6 +151,30 @@ TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LoadPlugin))
     EXPECT_TRUE(app.RemovePlugin(pluginName));
   }
 
+  // Second instance of a loaded plugin, and again after removing both
+  {
+    Application app(g_argc, g_argv);
+    app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+    std::vector<std::string> pluginNames;
+    app.connect(&app, &Application::PluginAdded, [&pluginNames](
+        const QString &_pluginName)
+    {
+      pluginNames.push_back(_pluginName.toStdString());
+    });
+
+    EXPECT_TRUE(app.LoadPlugin("TestPlugin"));
+    EXPECT_TRUE(app.LoadPlugin("TestPlugin"));
+    ASSERT_EQ(2u, pluginNames.size());
+    EXPECT_NE(pluginNames[0], pluginNames[1]);
+
+    for (const auto &name : pluginNames)
+      EXPECT_TRUE(app.RemovePlugin(name));
+
+    EXPECT_TRUE(app.LoadPlugin("TestPlugin"));
+    EXPECT_EQ(3u, pluginNames.size());
+  }
+
   // Plugin path added by env var
   {
     setenv("TEST_ENV_VAR",
@@ -146,6 +211,52 @@ TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LoadPlugin))
   }
 }
 
+//////////////////////////////////////////////////
+TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LayoutChange))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  auto win = app.MainWin();
+  ASSERT_NE(nullptr, win);
+
+  std::vector<std::string> pluginNames;
+  app.connect(&app, &Application::PluginAdded, [&pluginNames](
+      const QString &_pluginName)
+  {
+    pluginNames.push_back(_pluginName.toStdString());
+  });
+
+  // The count is only updated at the end of the outermost change
+  app.BeginLayoutChange();
+  app.BeginLayoutChange();
+  EXPECT_TRUE(app.LoadPlugin("TestPlugin"));
+  EXPECT_TRUE(app.LoadPlugin("TestPlugin"));
+  EXPECT_EQ(0, win->PluginCount());
+
+  app.EndLayoutChange();
+  EXPECT_EQ(0, win->PluginCount());
+
+  app.EndLayoutChange();
+  EXPECT_EQ(2, win->PluginCount());
+
+  // Same for removals
+  app.BeginLayoutChange();
+  ASSERT_EQ(2u, pluginNames.size());
+  EXPECT_TRUE(app.RemovePlugin(pluginNames[0]));
+  EXPECT_TRUE(app.RemovePlugin(pluginNames[1]));
+  EXPECT_EQ(2, win->PluginCount());
+
+  app.EndLayoutChange();
+  EXPECT_EQ(0, win->PluginCount());
+
+  // Unmatched end is ignored
+  app.EndLayoutChange();
+  EXPECT_EQ(0, win->PluginCount());
+}
+
 //////////////////////////////////////////////////
 TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LoadConfig))
 {
@@ -251,6 +362,7 @@ TEST(ApplicationTest,
 
     auto win = App()->findChild<MainWindow *>();
     ASSERT_NE(nullptr, win);
+    EXPECT_EQ(win, app.MainWin());
 
     // Check plugin count
     auto plugins = win->findChildren<Plugin *>();
@@ -303,6 +415,7 @@ TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Dialog))
   {
     Application app(g_argc, g_argv, WindowType::kDialog);
     EXPECT_EQ(app.allWindows().size(), 0);
+    EXPECT_EQ(nullptr, app.MainWin());
 
     // Add test plugin to path
     auto testBuildPath = std::string(PROJECT_BINARY_PATH) + "/lib/";
@@ -382,3 +495,89 @@ TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(messageHandler))
   qWarning("This came from qWarning");
   qCritical("This came from qCritical");
 }
+
+/////////////////////////////////////////////////
+TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(SamplingProfiler))
+{
+  common::Console::SetVerbosity(4);
+
+  auto dir = common::joinPaths(std::string(PROJECT_BINARY_PATH),
+      "sampling_profiles");
+  setenv("GZ_GUI_SAMPLING_PROFILE_DIR", dir.c_str(), 1);
+
+  Application app(g_argc, g_argv);
+  EXPECT_FALSE(SamplingProfiler::Running());
+
+  transport::Node node;
+  msgs::Boolean req;
+  msgs::StringMsg rep;
+  bool result{false};
+
+  req.set_data(true);
+  EXPECT_TRUE(node.Request("/gui/sampling_profiler", req, 5000, rep,
+      result));
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(SamplingProfiler::Running());
+  auto path = rep.data();
+  EXPECT_EQ(0u, path.find(dir));
+
+  // Started once
+  EXPECT_TRUE(node.Request("/gui/sampling_profiler", req, 5000, rep,
+      result));
+  EXPECT_TRUE(result);
+  EXPECT_EQ(path, rep.data());
+
+  req.set_data(false);
+  EXPECT_TRUE(node.Request("/gui/sampling_profiler", req, 5000, rep,
+      result));
+  EXPECT_TRUE(result);
+  EXPECT_FALSE(SamplingProfiler::Running());
+  EXPECT_TRUE(common::exists(path));
+
+  common::removeAll(dir);
+  unsetenv("GZ_GUI_SAMPLING_PROFILE_DIR");
+}
+
+//////////////////////////////////////////////////
+TEST(ApplicationTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Lite))
+{
+  common::Console::SetVerbosity(4);
+
+  EXPECT_TRUE(Application::IsRenderPlugin("MinimalScene"));
+  EXPECT_TRUE(Application::IsRenderPlugin("libGridConfig.so"));
+  EXPECT_FALSE(Application::IsRenderPlugin("Publisher"));
+  EXPECT_FALSE(Application::IsRenderPlugin("libTopicEcho.so"));
+
+  EXPECT_FALSE(Application::Lite());
+  Application::SetLite(true);
+  EXPECT_TRUE(Application::Lite());
+  {
+    Application app(g_argc, g_argv, WindowType::kHeadless);
+    app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+    EXPECT_EQ(QQuickWindow::sceneGraphBackend(), "software");
+
+    // Only plugins which don't need a 3D scene are loaded
+    EXPECT_TRUE(app.LoadPlugin("Publisher"));
+    EXPECT_FALSE(app.LoadPlugin("MinimalScene"));
+    EXPECT_FALSE(app.LoadPlugin("GridConfig"));
+
+    for (const auto &path : app.PluginList())
+    {
+      for (const auto &plugin : path.second)
+        EXPECT_FALSE(Application::IsRenderPlugin(plugin)) << plugin;
+    }
+
+    // No render engine is set
+    auto win = app.findChild<MainWindow *>();
+    ASSERT_NE(nullptr, win);
+    win->SetRenderEngine("ogre2");
+    EXPECT_FALSE(win->property("renderEngine").isValid());
+  }
+
+  // Later applications aren't affected
+  Application::SetLite(false);
+  {
+    Application app(g_argc, g_argv, WindowType::kHeadless);
+    EXPECT_NE(QQuickWindow::sceneGraphBackend(), "software");
+  }
+}
@@ -63,6 +63,99 @@ gz::math::Vector3d gz::gui::convert(const QVector3D &_vec)
   return gz::math::Vector3d(_vec.x(), _vec.y(), _vec.z());
 }
 
+//////////////////////////////////////////////////
+void gz::gui::convert(const gz::math::Color *_colors, std::size_t _count,
+    QColor *_out)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    _out[i].setRgb(static_cast<int>(_colors[i].R() * 255.0),
+        static_cast<int>(_colors[i].G() * 255.0),
+        static_cast<int>(_colors[i].B() * 255.0),
+        static_cast<int>(_colors[i].A() * 255.0));
+  }
+}
+
+//////////////////////////////////////////////////
+void gz::gui::convert(const gz::math::Color *_colors, std::size_t _count,
+    QRgb *_out)
+{
+  // Truncated like QColor's integer constructor
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    _out[i] = qRgba(static_cast<int>(_colors[i].R() * 255.0),
+        static_cast<int>(_colors[i].G() * 255.0),
+        static_cast<int>(_colors[i].B() * 255.0),
+        static_cast<int>(_colors[i].A() * 255.0));
+  }
+}
+
+//////////////////////////////////////////////////
+void gz::gui::convert(const QColor *_colors, std::size_t _count,
+    gz::math::Color *_out)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    _out[i].Set(_colors[i].red() / 255.0, _colors[i].green() / 255.0,
+        _colors[i].blue() / 255.0, _colors[i].alpha() / 255.0);
+  }
+}
+
+//////////////////////////////////////////////////
+void gz::gui::convert(const gz::math::Vector3d *_vecs, std::size_t _count,
+    QVector3D *_out)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    _out[i] = QVector3D(static_cast<float>(_vecs[i].X()),
+        static_cast<float>(_vecs[i].Y()), static_cast<float>(_vecs[i].Z()));
+  }
+}
+
+//////////////////////////////////////////////////
+void gz::gui::convert(const QVector3D *_vecs, std::size_t _count,
+    gz::math::Vector3d *_out)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+    _out[i].Set(_vecs[i].x(), _vecs[i].y(), _vecs[i].z());
+}
+
+//////////////////////////////////////////////////
+std::vector<QColor> gz::gui::convert(
+    const std::vector<gz::math::Color> &_colors)
+{
+  std::vector<QColor> result(_colors.size());
+  convert(_colors.data(), _colors.size(), result.data());
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::vector<gz::math::Color> gz::gui::convert(
+    const std::vector<QColor> &_colors)
+{
+  std::vector<gz::math::Color> result(_colors.size());
+  convert(_colors.data(), _colors.size(), result.data());
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::vector<QVector3D> gz::gui::convert(
+    const std::vector<gz::math::Vector3d> &_vecs)
+{
+  std::vector<QVector3D> result(_vecs.size());
+  convert(_vecs.data(), _vecs.size(), result.data());
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::vector<gz::math::Vector3d> gz::gui::convert(
+    const std::vector<QVector3D> &_vecs)
+{
+  std::vector<gz::math::Vector3d> result(_vecs.size());
+  convert(_vecs.data(), _vecs.size(), result.data());
+  return result;
+}
+
 //////////////////////////////////////////////////
 gz::common::MouseEvent gz::gui::convert(const QMouseEvent &_e)
 {
@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include <gz/common/Console.hh>
 #include <gz/common/MouseEvent.hh>
 #include <gz/math/Color.hh>
@@ -99,6 +101,46 @@ TEST(ConversionsTest, Vector3d)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(ConversionsTest, Arrays)
+{
+  // Same as converting one at a time
+  std::vector<math::Color> colors{
+      math::Color(0.1f, 0.3f, 0.5f, 0.7f), math::Color::White,
+      math::Color(0.0f, 0.0f, 0.0f, 0.0f)};
+  auto qColors = convert(colors);
+  ASSERT_EQ(colors.size(), qColors.size());
+
+  std::vector<QRgb> packed(colors.size());
+  convert(colors.data(), colors.size(), packed.data());
+
+  for (std::size_t i = 0; i < colors.size(); ++i)
+  {
+    EXPECT_EQ(convert(colors[i]), qColors[i]) << i;
+    EXPECT_EQ(convert(colors[i]).rgba(), packed[i]) << i;
+  }
+
+  auto backColors = convert(qColors);
+  ASSERT_EQ(qColors.size(), backColors.size());
+  for (std::size_t i = 0; i < qColors.size(); ++i)
+    EXPECT_EQ(convert(qColors[i]), backColors[i]) << i;
+
+  std::vector<math::Vector3d> vecs{
+      {-0.1, 0, 1234}, {1e6, -2.5, 0.125}, math::Vector3d::Zero};
+  auto qVecs = convert(vecs);
+  ASSERT_EQ(vecs.size(), qVecs.size());
+  for (std::size_t i = 0; i < vecs.size(); ++i)
+    EXPECT_EQ(convert(vecs[i]), qVecs[i]) << i;
+
+  auto backVecs = convert(qVecs);
+  ASSERT_EQ(qVecs.size(), backVecs.size());
+  for (std::size_t i = 0; i < qVecs.size(); ++i)
+    EXPECT_EQ(convert(qVecs[i]), backVecs[i]) << i;
+
+  // Nothing to convert
+  EXPECT_TRUE(convert(std::vector<QVector3D>()).empty());
+}
+
 /////////////////////////////////////////////////
 TEST(ConversionsTest, MouseEvent)
 {
@@ -0,0 +1,911 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <locale>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gz/math/Helpers.hh>
+
+#include "gz/gui/DerivedSignal.hh"
+
+namespace
+{
+/// \brief Samples of an input later than the latest time of the others
+/// are evaluated anyway once they're older than this, in seconds, so an
+/// input which stopped publishing doesn't stop the signal
+constexpr double kMaxHold{0.1};
+
+/// \brief Samples older than the last evaluation by more than this, in
+/// seconds, restart the statistics, as when the simulation is reset
+constexpr double kResetJump{1.0};
+
+/// \brief Largest fft size
+constexpr std::size_t kMaxSpectrumSize{1u << 20};
+
+/// \brief Operation of an instruction of a compiled expression
+enum class Op
+{
+  kConst, kInput,
+  kAdd, kSub, kMul, kDiv, kPow, kNeg,
+  kAbs, kSqrt, kExp, kLog, kSin, kCos, kTan, kAtan2,
+  kMin, kMax, kNorm,
+  kMovMean, kMovStd, kMovMin, kMovMax, kDeriv
+};
+
+/// \brief Instruction of an expression compiled to postfix order, run on
+/// a stack of values
+struct Instruction
+{
+  /// \brief Operation
+  Op op;
+
+  /// \brief Constant value, or window length in seconds
+  double value{0.0};
+
+  /// \brief Input index, number of arguments, or index of the state of
+  /// statistics
+  std::size_t index{0};
+};
+
+/// \brief Samples of the last seconds of a value, with their sums and
+/// their extremes
+struct Window
+{
+  /// \brief Add a sample and drop the samples out of the window
+  /// \param[in] _time Time of the sample
+  /// \param[in] _value Value
+  void Add(double _time, double _value)
+  {
+    // Summed relative to the first value, so large values with small
+    // variations don't lose their precision
+    if (this->samples.empty())
+    {
+      this->offset = _value;
+      this->sum = 0.0;
+      this->sumSq = 0.0;
+    }
+    double d = _value - this->offset;
+    this->samples.emplace_back(_time, _value);
+    this->sum += d;
+    this->sumSq += d * d;
+
+    // Values which can't be the extreme anymore are dropped, so the
+    // extreme is always at the front
+    while (!this->mins.empty() && this->mins.back().y() >= _value)
+      this->mins.pop_back();
+    this->mins.emplace_back(_time, _value);
+    while (!this->maxs.empty() && this->maxs.back().y() <= _value)
+      this->maxs.pop_back();
+    this->maxs.emplace_back(_time, _value);
+
+    double start = _time - this->length;
+    while (this->samples.front().x() < start)
+    {
+      d = this->samples.front().y() - this->offset;
+      this->sum -= d;
+      this->sumSq -= d * d;
+      this->samples.pop_front();
+    }
+    while (this->mins.front().x() < start)
+      this->mins.pop_front();
+    while (this->maxs.front().x() < start)
+      this->maxs.pop_front();
+  }
+
+  /// \brief Get the mean
+  /// \return Mean of the samples in the window
+  double Mean() const
+  {
+    return this->offset + this->sum / this->samples.size();
+  }
+
+  /// \brief Get the standard deviation
+  /// \return Population standard deviation of the samples in the window
+  double StdDev() const
+  {
+    double n = static_cast<double>(this->samples.size());
+    double mean = this->sum / n;
+    return std::sqrt(std::max(0.0, this->sumSq / n - mean * mean));
+  }
+
+  /// \brief Length in seconds
+  double length{1.0};
+
+  /// \brief Samples in the window, in time order
+  std::deque<QPointF> samples;
+
+  /// \brief Value the sums are relative to
+  double offset{0.0};
+
+  /// \brief Sum of the samples minus the offset
+  double sum{0.0};
+
+  /// \brief Sum of the squares of the samples minus the offset
+  double sumSq{0.0};
+
+  /// \brief Increasing values, the minimum first
+  std::deque<QPointF> mins;
+
+  /// \brief Decreasing values, the maximum first
+  std::deque<QPointF> maxs;
+};
+
+/// \brief State of a rate of change
+struct Rate
+{
+  /// \brief True once there's a previous sample
+  bool hasPrevious{false};
+
+  /// \brief Time of the previous sample
+  double time{0.0};
+
+  /// \brief Value of the previous sample
+  double value{0.0};
+
+  /// \brief Last rate, kept for samples at the same time
+  double rate{std::numeric_limits<double>::quiet_NaN()};
+};
+
+/// \brief Names of the functions and their operation
+const std::map<std::string, Op> &Functions()
+{
+  static const std::map<std::string, Op> functions{
+    {"abs", Op::kAbs}, {"sqrt", Op::kSqrt}, {"exp", Op::kExp},
+    {"log", Op::kLog}, {"sin", Op::kSin}, {"cos", Op::kCos},
+    {"tan", Op::kTan}, {"atan2", Op::kAtan2}, {"min", Op::kMin},
+    {"max", Op::kMax}, {"norm", Op::kNorm}, {"movmean", Op::kMovMean},
+    {"movstd", Op::kMovStd}, {"movmin", Op::kMovMin},
+    {"movmax", Op::kMovMax}, {"deriv", Op::kDeriv}};
+  return functions;
+}
+
+/// \brief Compiles an expression to instructions in postfix order
+class Parser
+{
+  /// \brief Constructor
+  /// \param[in] _text Expression
+  /// \param[in] _inputs Names of the inputs
+  public: Parser(const std::string &_text,
+                 const std::vector<std::string> &_inputs)
+    : text(_text), inputs(_inputs)
+  {
+  }
+
+  /// \brief Compile the whole expression
+  /// \return False on error
+  public: bool Parse()
+  {
+    if (!this->Expression())
+      return false;
+    this->SkipSpaces();
+    if (this->pos < this->text.size())
+      return this->Fail("unexpected [" + this->text.substr(this->pos) + "]");
+    if (this->spectrumSize > 0 && this->program.size() != this->spectrumEnd)
+      return this->Fail("fft must be the whole expression");
+    return true;
+  }
+
+  /// \brief Compiled instructions
+  public: std::vector<Instruction> program;
+
+  /// \brief Number of windows of statistics
+  public: std::size_t windowCount{0};
+
+  /// \brief Number of rates of change
+  public: std::size_t rateCount{0};
+
+  /// \brief Size of the fft, 0 if it isn't a spectrum
+  public: std::size_t spectrumSize{0};
+
+  /// \brief Error message
+  public: std::string error;
+
+  /// \brief expression := term (('+' | '-') term)*
+  private: bool Expression()
+  {
+    if (!this->Term())
+      return false;
+    while (this->Accept('+') || this->Accept('-'))
+    {
+      Op op = this->text[this->pos - 1] == '+' ? Op::kAdd : Op::kSub;
+      if (!this->Term())
+        return false;
+      this->program.push_back({op});
+    }
+    return true;
+  }
+
+  /// \brief term := unary (('*' | '/') unary)*
+  private: bool Term()
+  {
+    if (!this->Unary())
+      return false;
+    while (this->Accept('*') || this->Accept('/'))
+    {
+      Op op = this->text[this->pos - 1] == '*' ? Op::kMul : Op::kDiv;
+      if (!this->Unary())
+        return false;
+      this->program.push_back({op});
+    }
+    return true;
+  }
+
+  /// \brief unary := '-' unary | primary ('^' unary)?
+  private: bool Unary()
+  {
+    if (this->Accept('-'))
+    {
+      if (!this->Unary())
+        return false;
+      this->program.push_back({Op::kNeg});
+      return true;
+    }
+    if (!this->Primary())
+      return false;
+    if (this->Accept('^'))
+    {
+      if (!this->Unary())
+        return false;
+      this->program.push_back({Op::kPow});
+    }
+    return true;
+  }
+
+  /// \brief primary := number | name | name '(' arguments ')' |
+  /// '(' expression ')'
+  private: bool Primary()
+  {
+    this->SkipSpaces();
+    if (this->Accept('('))
+    {
+      if (!this->Expression())
+        return false;
+      return this->Accept(')') || this->Fail("missing )");
+    }
+
+    if (this->pos >= this->text.size())
+      return this->Fail("unexpected end");
+
+    char c = this->text[this->pos];
+    if (std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+      return this->Number();
+
+    if (!std::isalpha(static_cast<unsigned char>(c)) && c != '_')
+      return this->Fail(std::string("unexpected [") + c + "]");
+
+    std::size_t start = this->pos;
+    while (this->pos < this->text.size() &&
+        (std::isalnum(static_cast<unsigned char>(this->text[this->pos])) ||
+         this->text[this->pos] == '_'))
+    {
+      ++this->pos;
+    }
+    std::string name = this->text.substr(start, this->pos - start);
+
+    if (!this->Accept('('))
+    {
+      auto it = std::find(this->inputs.begin(), this->inputs.end(), name);
+      if (it == this->inputs.end())
+        return this->Fail("unknown input [" + name + "]");
+      Instruction input{Op::kInput};
+      input.index = static_cast<std::size_t>(it - this->inputs.begin());
+      this->program.push_back(input);
+      return true;
+    }
+
+    return this->Function(name);
+  }
+
+  /// \brief Compile the arguments of a function, after its '('
+  /// \param[in] _name Function name
+  private: bool Function(const std::string &_name)
+  {
+    std::size_t start = this->program.size();
+    std::size_t argc{0};
+    std::vector<std::size_t> argStarts;
+    if (!this->Accept(')'))
+    {
+      do
+      {
+        argStarts.push_back(this->program.size());
+        if (!this->Expression())
+          return false;
+        ++argc;
+      }
+      while (this->Accept(','));
+      if (!this->Accept(')'))
+        return this->Fail("missing ) after the arguments of " + _name);
+    }
+
+    // The last argument of these is a number, taken out of the program
+    auto constant = [&](double &_value)
+    {
+      const auto &last = this->program.back();
+      if (argc != 2 || this->program.size() != argStarts[1] + 1 ||
+          last.op != Op::kConst)
+      {
+        return false;
+      }
+      _value = last.value;
+      this->program.pop_back();
+      return true;
+    };
+
+    if (_name == "fft")
+    {
+      double size{0.0};
+      if (!constant(size))
+        return this->Fail("fft takes an expression and a size");
+      auto n = static_cast<std::size_t>(size);
+      if (size != static_cast<double>(n) || n < 4 ||
+          n > kMaxSpectrumSize || (n & (n - 1)) != 0)
+      {
+        return this->Fail("fft size must be a power of two from 4");
+      }
+      if (start != 0 || this->spectrumSize > 0)
+        return this->Fail("fft must be the whole expression");
+      this->spectrumSize = n;
+      this->spectrumEnd = this->program.size();
+      return true;
+    }
+
+    auto it = Functions().find(_name);
+    if (it == Functions().end())
+      return this->Fail("unknown function [" + _name + "]");
+
+    Instruction instruction{it->second};
+    switch (instruction.op)
+    {
+      case Op::kAtan2:
+        if (argc != 2)
+          return this->Fail("atan2 takes 2 arguments");
+        break;
+      case Op::kMin:
+      case Op::kMax:
+      case Op::kNorm:
+        if (argc == 0)
+          return this->Fail(_name + " takes at least one argument");
+        instruction.index = argc;
+        break;
+      case Op::kMovMean:
+      case Op::kMovStd:
+      case Op::kMovMin:
+      case Op::kMovMax:
+        if (!constant(instruction.value) || !(instruction.value > 0.0))
+          return this->Fail(_name + " takes a value and a window in seconds");
+        instruction.index = this->windowCount++;
+        break;
+      case Op::kDeriv:
+        if (argc != 1)
+          return this->Fail("deriv takes 1 argument");
+        instruction.index = this->rateCount++;
+        break;
+      default:
+        if (argc != 1)
+          return this->Fail(_name + " takes 1 argument");
+        break;
+    }
+    this->program.push_back(instruction);
+    return true;
+  }
+
+  /// \brief Compile a number
+  private: bool Number()
+  {
+    // The GUI's locale may use another decimal separator
+    std::istringstream stream(this->text.substr(this->pos));
+    stream.imbue(std::locale::classic());
+    double value;
+    if (!(stream >> value))
+      return this->Fail("bad number");
+    auto read = stream.eof() ? this->text.size() - this->pos :
+        static_cast<std::size_t>(stream.tellg());
+    this->pos += read;
+    Instruction constant{Op::kConst};
+    constant.value = value;
+    this->program.push_back(constant);
+    return true;
+  }
+
+  /// \brief Consume a character, after spaces
+  /// \param[in] _c Character
+  /// \return True if it was next
+  private: bool Accept(char _c)
+  {
+    this->SkipSpaces();
+    if (this->pos < this->text.size() && this->text[this->pos] == _c)
+    {
+      ++this->pos;
+      return true;
+    }
+    return false;
+  }
+
+  /// \brief Skip spaces
+  private: void SkipSpaces()
+  {
+    while (this->pos < this->text.size() &&
+        std::isspace(static_cast<unsigned char>(this->text[this->pos])))
+    {
+      ++this->pos;
+    }
+  }
+
+  /// \brief Set the error
+  /// \param[in] _error Message
+  /// \return False
+  private: bool Fail(const std::string &_error)
+  {
+    if (this->error.empty())
+    {
+      this->error = _error + ", at character " +
+          std::to_string(this->pos + 1);
+    }
+    return false;
+  }
+
+  /// \brief Expression
+  private: const std::string &text;
+
+  /// \brief Input names
+  private: const std::vector<std::string> &inputs;
+
+  /// \brief Position of the next character
+  private: std::size_t pos{0};
+
+  /// \brief Size of the program after the argument of the fft
+  private: std::size_t spectrumEnd{0};
+};
+
+/// \brief In place radix-2 fft
+/// \param[in, out] _data Samples, their number a power of two
+void Fft(std::vector<std::complex<double>> &_data)
+{
+  const std::size_t n = _data.size();
+  for (std::size_t i = 1, j = 0; i < n; ++i)
+  {
+    std::size_t bit = n >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+    if (i < j)
+      std::swap(_data[i], _data[j]);
+  }
+
+  for (std::size_t len = 2; len <= n; len <<= 1)
+  {
+    double angle = -2.0 * GZ_PI / static_cast<double>(len);
+    std::complex<double> step(std::cos(angle), std::sin(angle));
+    for (std::size_t i = 0; i < n; i += len)
+    {
+      std::complex<double> w(1.0, 0.0);
+      for (std::size_t k = 0; k < len / 2; ++k)
+      {
+        auto u = _data[i + k];
+        auto v = _data[i + k + len / 2] * w;
+        _data[i + k] = u + v;
+        _data[i + k + len / 2] = u - v;
+        w *= step;
+      }
+    }
+  }
+}
+}
+
+namespace gz
+{
+  namespace gui
+  {
+    class DerivedSignalPrivate
+    {
+      /// \brief Evaluate the program at a time, with the latest values
+      /// \param[in] _time Time of the evaluation
+      /// \return Value
+      public: double Evaluate(double _time);
+
+      /// \brief Compute the spectrum of the last samples
+      /// \return Frequencies and magnitudes, empty if the sample rate is
+      /// unknown
+      public: std::vector<QPointF> Spectrum() const;
+
+      /// \brief Compiled expression
+      public: std::vector<Instruction> program;
+
+      /// \brief Error of the last parse
+      public: std::string error;
+
+      /// \brief Size of the fft, 0 if it isn't a spectrum
+      public: std::size_t spectrumSize{0};
+
+      /// \brief Hann window of the fft
+      public: std::vector<double> hann;
+
+      /// \brief Last values of the expression for the fft, the oldest at
+      /// spectrumCount % spectrumSize once full
+      public: std::vector<QPointF> spectrumSamples;
+
+      /// \brief Number of samples ever added for the fft
+      public: std::size_t spectrumCount{0};
+
+      /// \brief Samples of each input not evaluated yet
+      public: std::vector<std::deque<QPointF>> pending;
+
+      /// \brief Latest value of each input
+      public: std::vector<double> values;
+
+      /// \brief True for the inputs which have a value
+      public: std::vector<bool> known;
+
+      /// \brief Time of the last sample of each input, lowest if none
+      public: std::vector<double> lastTimes;
+
+      /// \brief Time of the last evaluation
+      public: double lastEvaluation{std::numeric_limits<double>::lowest()};
+
+      /// \brief Windows of the statistics
+      public: std::vector<Window> windows;
+
+      /// \brief Rates of change
+      public: std::vector<Rate> rates;
+
+      /// \brief Stack of values while evaluating
+      public: std::vector<double> stack;
+    };
+  }
+}
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+DerivedSignal::DerivedSignal()
+  : dataPtr(std::make_unique<DerivedSignalPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+DerivedSignal::~DerivedSignal()
+{
+}
+
+/////////////////////////////////////////////////
+bool DerivedSignal::Parse(const std::string &_expression,
+    const std::vector<std::string> &_inputs)
+{
+  Parser parser(_expression, _inputs);
+  bool valid = parser.Parse();
+  this->dataPtr->error = parser.error;
+
+  this->dataPtr->program = valid ? parser.program :
+      std::vector<Instruction>();
+  this->dataPtr->spectrumSize = valid ? parser.spectrumSize : 0;
+  this->dataPtr->windows.assign(valid ? parser.windowCount : 0, Window());
+  this->dataPtr->rates.assign(valid ? parser.rateCount : 0, Rate());
+  for (const auto &instruction : this->dataPtr->program)
+  {
+    if (instruction.op == Op::kMovMean || instruction.op == Op::kMovStd ||
+        instruction.op == Op::kMovMin || instruction.op == Op::kMovMax)
+    {
+      this->dataPtr->windows[instruction.index].length = instruction.value;
+    }
+  }
+
+  auto n = this->dataPtr->spectrumSize;
+  this->dataPtr->hann.resize(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    this->dataPtr->hann[i] =
+        0.5 - 0.5 * std::cos(2.0 * GZ_PI * i / static_cast<double>(n - 1));
+  }
+
+  this->dataPtr->pending.assign(_inputs.size(), std::deque<QPointF>());
+  this->dataPtr->values.assign(_inputs.size(), 0.0);
+  this->dataPtr->known.assign(_inputs.size(), false);
+  this->dataPtr->lastTimes.assign(_inputs.size(),
+      std::numeric_limits<double>::lowest());
+  this->Reset();
+  return valid;
+}
+
+/////////////////////////////////////////////////
+const std::string &DerivedSignal::Error() const
+{
+  return this->dataPtr->error;
+}
+
+/////////////////////////////////////////////////
+bool DerivedSignal::IsSpectrum() const
+{
+  return this->dataPtr->spectrumSize > 0;
+}
+
+/////////////////////////////////////////////////
+void DerivedSignal::Reset()
+{
+  for (auto &window : this->dataPtr->windows)
+  {
+    window.samples.clear();
+    window.mins.clear();
+    window.maxs.clear();
+  }
+  for (auto &rate : this->dataPtr->rates)
+    rate = Rate();
+  this->dataPtr->spectrumSamples.clear();
+  this->dataPtr->spectrumCount = 0;
+  this->dataPtr->lastEvaluation = std::numeric_limits<double>::lowest();
+}
+
+/////////////////////////////////////////////////
+std::vector<QPointF> DerivedSignal::Update(
+    const std::vector<std::vector<QPointF>> &_samples)
+{
+  auto &d = *this->dataPtr;
+  std::vector<QPointF> points;
+  if (d.program.empty())
+    return points;
+
+  // Inputs are evaluated up to the latest time they all reached
+  double newest = std::numeric_limits<double>::lowest();
+  double watermark = std::numeric_limits<double>::max();
+  for (std::size_t i = 0; i < d.pending.size(); ++i)
+  {
+    if (i < _samples.size())
+    {
+      d.pending[i].insert(d.pending[i].end(), _samples[i].begin(),
+          _samples[i].end());
+    }
+    if (!d.pending[i].empty())
+      d.lastTimes[i] = std::max(d.lastTimes[i], d.pending[i].back().x());
+    if (d.lastTimes[i] > std::numeric_limits<double>::lowest())
+      watermark = std::min(watermark, d.lastTimes[i]);
+    newest = std::max(newest, d.lastTimes[i]);
+  }
+  watermark = std::max(watermark, newest - kMaxHold);
+
+  bool spectrumChanged{false};
+  while (true)
+  {
+    double time = std::numeric_limits<double>::max();
+    for (const auto &pending : d.pending)
+    {
+      if (!pending.empty())
+        time = std::min(time, pending.front().x());
+    }
+    if (time > watermark)
+      break;
+
+    // Inputs of the same message have the same time, and are evaluated
+    // once
+    for (std::size_t i = 0; i < d.pending.size(); ++i)
+    {
+      if (d.pending[i].empty() || d.pending[i].front().x() != time)
+        continue;
+      d.values[i] = d.pending[i].front().y();
+      d.known[i] = true;
+      d.pending[i].pop_front();
+    }
+
+    if (time < d.lastEvaluation - kResetJump)
+      this->Reset();
+    else if (time < d.lastEvaluation)
+      continue;
+
+    if (std::find(d.known.begin(), d.known.end(), false) != d.known.end())
+      continue;
+
+    d.lastEvaluation = time;
+    double value = d.Evaluate(time);
+    if (!std::isfinite(value))
+      continue;
+
+    if (d.spectrumSize == 0)
+    {
+      points.emplace_back(time, value);
+      continue;
+    }
+
+    if (d.spectrumSamples.size() < d.spectrumSize)
+      d.spectrumSamples.emplace_back(time, value);
+    else
+      d.spectrumSamples[d.spectrumCount % d.spectrumSize] = {time, value};
+    ++d.spectrumCount;
+    spectrumChanged = true;
+  }
+
+  if (spectrumChanged && d.spectrumSamples.size() == d.spectrumSize)
+    points = d.Spectrum();
+  return points;
+}
+
+/////////////////////////////////////////////////
+double DerivedSignalPrivate::Evaluate(double _time)
+{
+  auto &s = this->stack;
+  s.clear();
+  for (const auto &instruction : this->program)
+  {
+    switch (instruction.op)
+    {
+      case Op::kConst:
+        s.push_back(instruction.value);
+        break;
+      case Op::kInput:
+        s.push_back(this->values[instruction.index]);
+        break;
+      case Op::kAdd:
+        s[s.size() - 2] += s.back();
+        s.pop_back();
+        break;
+      case Op::kSub:
+        s[s.size() - 2] -= s.back();
+        s.pop_back();
+        break;
+      case Op::kMul:
+        s[s.size() - 2] *= s.back();
+        s.pop_back();
+        break;
+      case Op::kDiv:
+        s[s.size() - 2] /= s.back();
+        s.pop_back();
+        break;
+      case Op::kPow:
+        s[s.size() - 2] = std::pow(s[s.size() - 2], s.back());
+        s.pop_back();
+        break;
+      case Op::kAtan2:
+        s[s.size() - 2] = std::atan2(s[s.size() - 2], s.back());
+        s.pop_back();
+        break;
+      case Op::kNeg:
+        s.back() = -s.back();
+        break;
+      case Op::kAbs:
+        s.back() = std::abs(s.back());
+        break;
+      case Op::kSqrt:
+        s.back() = std::sqrt(s.back());
+        break;
+      case Op::kExp:
+        s.back() = std::exp(s.back());
+        break;
+      case Op::kLog:
+        s.back() = std::log(s.back());
+        break;
+      case Op::kSin:
+        s.back() = std::sin(s.back());
+        break;
+      case Op::kCos:
+        s.back() = std::cos(s.back());
+        break;
+      case Op::kTan:
+        s.back() = std::tan(s.back());
+        break;
+      case Op::kMin:
+      case Op::kMax:
+      case Op::kNorm:
+      {
+        auto first = s.end() - static_cast<std::ptrdiff_t>(instruction.index);
+        double result;
+        if (instruction.op == Op::kMin)
+        {
+          result = *std::min_element(first, s.end());
+        }
+        else if (instruction.op == Op::kMax)
+        {
+          result = *std::max_element(first, s.end());
+        }
+        else
+        {
+          double sumSq{0.0};
+          for (auto it = first; it != s.end(); ++it)
+            sumSq += *it * *it;
+          result = std::sqrt(sumSq);
+        }
+        s.erase(first, s.end());
+        s.push_back(result);
+        break;
+      }
+      case Op::kMovMean:
+      case Op::kMovStd:
+      case Op::kMovMin:
+      case Op::kMovMax:
+      {
+        auto &window = this->windows[instruction.index];
+        if (std::isfinite(s.back()))
+          window.Add(_time, s.back());
+        if (window.samples.empty())
+          break;
+
+        if (instruction.op == Op::kMovMean)
+          s.back() = window.Mean();
+        else if (instruction.op == Op::kMovStd)
+          s.back() = window.StdDev();
+        else if (instruction.op == Op::kMovMin)
+          s.back() = window.mins.front().y();
+        else
+          s.back() = window.maxs.front().y();
+        break;
+      }
+      case Op::kDeriv:
+      {
+        auto &rate = this->rates[instruction.index];
+        double value = s.back();
+        if (rate.hasPrevious && _time > rate.time)
+          rate.rate = (value - rate.value) / (_time - rate.time);
+        if (!rate.hasPrevious || _time > rate.time)
+        {
+          rate.hasPrevious = true;
+          rate.time = _time;
+          rate.value = value;
+        }
+        s.back() = rate.rate;
+        break;
+      }
+    }
+  }
+  return s.empty() ? std::numeric_limits<double>::quiet_NaN() : s.back();
+}
+
+/////////////////////////////////////////////////
+std::vector<QPointF> DerivedSignalPrivate::Spectrum() const
+{
+  std::vector<QPointF> points;
+  const std::size_t n = this->spectrumSize;
+  const std::size_t oldest = this->spectrumCount % n;
+
+  // The sample rate is estimated from the samples, topics don't give it
+  double first = this->spectrumSamples[oldest].x();
+  double last = this->spectrumSamples[(oldest + n - 1) % n].x();
+  if (!(last > first))
+    return points;
+  double rate = static_cast<double>(n - 1) / (last - first);
+
+  // The mean is removed, so it doesn't leak into the lowest frequencies
+  double mean{0.0};
+  for (const auto &sample : this->spectrumSamples)
+    mean += sample.y();
+  mean /= static_cast<double>(n);
+
+  std::vector<std::complex<double>> data(n);
+  double windowSum{0.0};
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    data[i] = (this->spectrumSamples[(oldest + i) % n].y() - mean) *
+        this->hann[i];
+    windowSum += this->hann[i];
+  }
+  Fft(data);
+
+  // Amplitudes of the sines
+  points.reserve(n / 2);
+  for (std::size_t k = 1; k <= n / 2; ++k)
+  {
+    points.emplace_back(rate * static_cast<double>(k) / n,
+        2.0 * std::abs(data[k]) / windowSum);
+  }
+  return points;
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <gz/math/Helpers.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/DerivedSignal.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(DerivedSignalTest, Parse)
+{
+  DerivedSignal signal;
+  EXPECT_TRUE(signal.Parse("a - b", {"a", "b"}));
+  EXPECT_TRUE(signal.Error().empty());
+  EXPECT_FALSE(signal.IsSpectrum());
+
+  EXPECT_TRUE(signal.Parse("norm(a, b, 2) * -1.5e1 ^ 2", {"a", "b"}));
+  EXPECT_TRUE(signal.Parse("fft(movmean(a, 0.1), 1024)", {"a"}));
+  EXPECT_TRUE(signal.IsSpectrum());
+
+  for (const auto &expression : {"a +", "(a", "c", "2a", "foo(a)",
+      "atan2(a)", "movmean(a, b)", "movstd(a, 0)", "fft(a, 1000)",
+      "fft(a, 8) + a", "a + fft(a, 8)"})
+  {
+    EXPECT_FALSE(signal.Parse(expression, {"a", "b"})) << expression;
+    EXPECT_FALSE(signal.Error().empty()) << expression;
+    EXPECT_FALSE(signal.IsSpectrum()) << expression;
+    EXPECT_TRUE(signal.Update({{QPointF(0, 1)}, {QPointF(0, 1)}}).empty());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(DerivedSignalTest, Expression)
+{
+  DerivedSignal signal;
+  ASSERT_TRUE(signal.Parse("norm(a, b) - -2^2 / 4 + max(a, b, 1)",
+      {"a", "b"}));
+
+  auto points = signal.Update({{QPointF(1, 3)}, {QPointF(1, 4)}});
+  ASSERT_EQ(points.size(), 1u);
+  EXPECT_DOUBLE_EQ(points[0].x(), 1.0);
+  EXPECT_DOUBLE_EQ(points[0].y(), 5.0 + 1.0 + 4.0);
+
+  // Non finite values are skipped
+  ASSERT_TRUE(signal.Parse("log(a)", {"a"}));
+  points = signal.Update({{QPointF(0, -1), QPointF(1, 1)}});
+  ASSERT_EQ(points.size(), 1u);
+  EXPECT_DOUBLE_EQ(points[0].y(), 0.0);
+}
+
+/////////////////////////////////////////////////
+TEST(DerivedSignalTest, TimeOrder)
+{
+  DerivedSignal signal;
+  ASSERT_TRUE(signal.Parse("a - b", {"a", "b"}));
+
+  // Nothing until both have a value, and a isn't evaluated past b
+  auto points = signal.Update({{QPointF(0.0, 1.0)}, {}});
+  EXPECT_TRUE(points.empty());
+  points = signal.Update({{QPointF(0.01, 2.0), QPointF(0.02, 3.0)},
+      {QPointF(0.0, 1.0)}});
+  ASSERT_EQ(points.size(), 1u);
+  EXPECT_DOUBLE_EQ(points[0].x(), 0.0);
+  EXPECT_DOUBLE_EQ(points[0].y(), 0.0);
+
+  // Evaluated with the latest value of the other input
+  points = signal.Update({{}, {QPointF(0.015, 0.0)}});
+  ASSERT_EQ(points.size(), 2u);
+  EXPECT_DOUBLE_EQ(points[0].x(), 0.01);
+  EXPECT_DOUBLE_EQ(points[0].y(), 1.0);
+  EXPECT_DOUBLE_EQ(points[1].x(), 0.015);
+  EXPECT_DOUBLE_EQ(points[1].y(), 2.0);
+
+  // Not waiting for inputs which stopped
+  std::vector<QPointF> samples;
+  for (int i = 0; i < 20; ++i)
+    samples.emplace_back(0.02 + i * 0.01, 5.0);
+  points = signal.Update({samples, {}});
+  EXPECT_FALSE(points.empty());
+  EXPECT_LT(points.size(), samples.size());
+  EXPECT_DOUBLE_EQ(points.back().y(), 5.0);
+}
+
+/////////////////////////////////////////////////
+TEST(DerivedSignalTest, Statistics)
+{
+  std::vector<QPointF> samples;
+  for (int i = 0; i < 300; ++i)
+    samples.emplace_back(i * 0.01, i % 2 ? 1001.0 : 1003.0);
+
+  DerivedSignal signal;
+  ASSERT_TRUE(signal.Parse("movmean(a, 1)", {"a"}));
+  auto points = signal.Update({samples});
+  ASSERT_EQ(points.size(), samples.size());
+  EXPECT_DOUBLE_EQ(points.front().y(), 1003.0);
+  EXPECT_NEAR(points.back().y(), 1002.0, 0.02);
+
+  ASSERT_TRUE(signal.Parse("movstd(a, 1)", {"a"}));
+  points = signal.Update({samples});
+  EXPECT_NEAR(points.back().y(), 1.0, 1e-3);
+
+  ASSERT_TRUE(signal.Parse("movmax(a, 0.5) - movmin(a, 0.5)", {"a"}));
+  points = signal.Update({samples});
+  EXPECT_DOUBLE_EQ(points.front().y(), 0.0);
+  EXPECT_DOUBLE_EQ(points.back().y(), 2.0);
+
+  // The rate isn't known at the first sample
+  samples.clear();
+  for (int i = 0; i < 10; ++i)
+    samples.emplace_back(5.0 + i * 0.1, 0.2 * i);
+  ASSERT_TRUE(signal.Parse("deriv(a)", {"a"}));
+  points = signal.Update({samples});
+  ASSERT_EQ(points.size(), samples.size() - 1);
+  EXPECT_NEAR(points.back().y(), 2.0, 1e-9);
+
+  // Restarted when the time goes back
+  signal.Update({{QPointF(0.0, 5.0)}});
+  points = signal.Update({{QPointF(0.1, 6.0)}});
+  ASSERT_EQ(points.size(), 1u);
+  EXPECT_NEAR(points[0].y(), 10.0, 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST(DerivedSignalTest, Spectrum)
+{
+  DerivedSignal signal;
+  ASSERT_TRUE(signal.Parse("fft(a, 256)", {"a"}));
+
+  // Not enough samples yet
+  std::vector<QPointF> samples;
+  for (int i = 0; i < 100; ++i)
+  {
+    double t = i * 0.001;
+    samples.emplace_back(t, 1.0 + 0.5 * std::sin(2.0 * GZ_PI * 125.0 * t));
+  }
+  EXPECT_TRUE(signal.Update({samples}).empty());
+
+  samples.clear();
+  for (int i = 100; i < 1000; ++i)
+  {
+    double t = i * 0.001;
+    samples.emplace_back(t, 1.0 + 0.5 * std::sin(2.0 * GZ_PI * 125.0 * t));
+  }
+  auto points = signal.Update({samples});
+  ASSERT_EQ(points.size(), 128u);
+  EXPECT_NEAR(points.back().x(), 500.0, 1e-6);
+
+  std::size_t peak{0};
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    if (points[i].y() > points[peak].y())
+      peak = i;
+  }
+  EXPECT_NEAR(points[peak].x(), 125.0, 1e-6);
+  EXPECT_NEAR(points[peak].y(), 0.5, 1e-3);
+
+  // Unchanged without new samples
+  EXPECT_TRUE(signal.Update({{}}).empty());
+}
@@ -15,28 +15,98 @@
  *
 */
 
+#include <set>
+#include <utility>
+#include <vector>
+
 #include "gz/gui/Enums.hh"
 #include "gz/gui/DragDropModel.hh"
 
+namespace gz
+{
+namespace gui
+{
+  class DragDropMimeDataPrivate
+  {
+    /// \brief Dragged rows
+    public: std::vector<DragDropItem> items;
+  };
+}
+}
+
 using namespace gz;
 using namespace gui;
 
 /////////////////////////////////////////////////
-QMimeData *DragDropModel::mimeData(const QModelIndexList &_indexes) const
+DragDropMimeData::DragDropMimeData(std::vector<DragDropItem> _items)
+  : dataPtr(std::make_unique<DragDropMimeDataPrivate>())
+{
+  this->dataPtr->items = std::move(_items);
+}
+
+/////////////////////////////////////////////////
+DragDropMimeData::~DragDropMimeData()
+{
+}
+
+/////////////////////////////////////////////////
+const std::vector<DragDropItem> &DragDropMimeData::Items() const
+{
+  return this->dataPtr->items;
+}
+
+/////////////////////////////////////////////////
+QStringList DragDropMimeData::formats() const
+{
+  if (this->dataPtr->items.empty())
+    return QMimeData::formats();
+  return {"application/x-item", "text/plain"};
+}
+
+/////////////////////////////////////////////////
+bool DragDropMimeData::hasFormat(const QString &_mimeType) const
 {
-  QMimeData *curMimeData = new QMimeData();
+  return this->formats().contains(_mimeType);
+}
+
+/////////////////////////////////////////////////
+QVariant DragDropMimeData::retrieveData(const QString &_mimeType,
+    QVariant::Type _type) const
+{
+  if (this->dataPtr->items.empty())
+    return QMimeData::retrieveData(_mimeType, _type);
+
+  if (_mimeType == "application/x-item")
+    return this->dataPtr->items.front().uri.toLatin1();
 
+  if (_mimeType == "text/plain")
+  {
+    QStringList uris;
+    for (const auto &item : this->dataPtr->items)
+      uris.append(item.uri);
+    return uris.join("\n");
+  }
+
+  return QMimeData::retrieveData(_mimeType, _type);
+}
+
+/////////////////////////////////////////////////
+QMimeData *DragDropModel::mimeData(const QModelIndexList &_indexes) const
+{
+  // Views give an index per column, only the rows matter
+  std::vector<DragDropItem> items;
+  std::set<std::pair<int, QModelIndex>> rows;
   for (auto const &idx : _indexes)
   {
-    if (idx.isValid())
-    {
-      QString text = this->data(idx, DataRole::URI_QUERY).toString();
-      curMimeData->setData("application/x-item", text.toLatin1().data());
+    if (!idx.isValid() || !rows.emplace(idx.row(), idx.parent()).second)
+      continue;
 
-      break;
-    }
+    DragDropItem item;
+    item.uri = this->data(idx, DataRole::URI_QUERY).toString();
+    item.type = this->data(idx, DataRole::TYPE).toString();
+    item.name = this->data(idx, DataRole::DISPLAY_NAME).toString();
+    items.push_back(std::move(item));
   }
 
-  return curMimeData;
+  return new DragDropMimeData(std::move(items));
 }
-
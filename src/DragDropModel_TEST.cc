@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+
 #include <gz/common/Console.hh>
 
 #include "test_config.hh"  // NOLINT(build/include)
@@ -49,3 +51,47 @@ TEST(DragDropModelTest, Mime)
   EXPECT_EQ(model->mimeData(ids)->data("application/x-item"), "/example/URI");
 }
 
+/////////////////////////////////////////////////
+TEST(DragDropModelTest, Items)
+{
+  DragDropModel model;
+
+  for (auto uri : {"/example/one", "/example/two"})
+  {
+    QList<QStandardItem *> row;
+    row.append(new QStandardItem());
+    row.append(new QStandardItem());
+    row[0]->setData(uri, DataRole::URI_QUERY);
+    row[0]->setData("model", DataRole::TYPE);
+    row[0]->setData(QString(uri).mid(9), DataRole::DISPLAY_NAME);
+    model.appendRow(row);
+  }
+
+  // A view gives an index per column, rows are only dragged once
+  QModelIndexList ids;
+  ids.push_back(model.index(1, 0));
+  ids.push_back(model.index(1, 1));
+  ids.push_back(model.index(0, 0));
+  ids.push_back(QModelIndex());
+
+  std::unique_ptr<QMimeData> mime(model.mimeData(ids));
+  auto dragged = qobject_cast<DragDropMimeData *>(mime.get());
+  ASSERT_NE(nullptr, dragged);
+
+  const auto &items = dragged->Items();
+  ASSERT_EQ(2u, items.size());
+  EXPECT_EQ("/example/two", items[0].uri);
+  EXPECT_EQ("model", items[0].type);
+  EXPECT_EQ("two", items[0].name);
+  EXPECT_EQ("/example/one", items[1].uri);
+
+  EXPECT_TRUE(mime->hasFormat("application/x-item"));
+  EXPECT_TRUE(mime->hasFormat("text/plain"));
+  EXPECT_FALSE(mime->hasFormat("text/html"));
+  EXPECT_EQ(mime->data("application/x-item"), "/example/two");
+  EXPECT_EQ(mime->text(), "/example/two\n/example/one");
+
+  // Nothing to drag
+  std::unique_ptr<QMimeData> empty(model.mimeData({QModelIndex()}));
+  EXPECT_FALSE(empty->hasFormat("application/x-item"));
+}
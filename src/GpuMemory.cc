@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gz/gui/GpuMemory.hh"
+
+namespace
+{
+  /// \brief Resources of a plugin
+  struct Owner
+  {
+    /// \brief Bytes of each resource by key, per kind of resource
+    std::array<std::map<std::string, uint64_t>,
+        gz::gui::GpuMemory::kResourceCount> resources;
+
+    /// \brief Sum of the bytes, per kind of resource
+    std::array<uint64_t, gz::gui::GpuMemory::kResourceCount> bytes{};
+
+    /// \brief Get the bytes of all kinds of resources
+    /// \return Bytes
+    uint64_t TotalBytes() const
+    {
+      uint64_t total{0u};
+      for (auto value : this->bytes)
+        total += value;
+      return total;
+    }
+  };
+
+  /// \brief Global accounting state
+  struct Memory
+  {
+    /// \brief Protects everything
+    std::mutex mutex;
+
+    /// \brief Resources per plugin name
+    std::map<std::string, Owner> owners;
+
+    /// \brief Plugin name and function of each reclaimer, by identifier
+    std::map<uint64_t, std::pair<std::string,
+        gz::gui::GpuMemory::Reclaimer>> reclaimers;
+
+    /// \brief Identifier of the next reclaimer
+    uint64_t nextReclaimer{1u};
+
+    /// \brief Held while reclaimers are called, without the mutex since
+    /// they release resources, so they aren't removed while running
+    std::recursive_mutex reclaimMutex;
+
+    /// \brief Bytes of all resources
+    uint64_t total{0u};
+
+    /// \brief Maximum bytes, 0 for no limit
+    uint64_t budget{0u};
+  };
+
+  /////////////////////////////////////////////////
+  Memory &memory()
+  {
+    static Memory instance;
+    return instance;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Must be called with the mutex locked
+  uint64_t recordedBytes(Memory &_memory, const std::string &_name,
+      gz::gui::GpuMemory::Resource _resource, const std::string &_key)
+  {
+    auto owner = _memory.owners.find(_name);
+    if (owner == _memory.owners.end())
+      return 0u;
+
+    const auto &resources =
+        owner->second.resources[static_cast<std::size_t>(_resource)];
+    auto it = resources.find(_key);
+    return it == resources.end() ? 0u : it->second;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Must be called with the mutex locked
+  bool fits(const Memory &_memory, uint64_t _previous, uint64_t _bytes)
+  {
+    return _memory.budget == 0u ||
+        _memory.total - _previous + _bytes <= _memory.budget;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Must be called with the mutex locked
+  void record(Memory &_memory, const std::string &_name,
+      gz::gui::GpuMemory::Resource _resource, const std::string &_key,
+      uint64_t _bytes)
+  {
+    auto it = _memory.owners.find(_name);
+    if (it == _memory.owners.end())
+    {
+      if (_bytes == 0u)
+        return;
+      it = _memory.owners.emplace(_name, Owner()).first;
+    }
+
+    auto index = static_cast<std::size_t>(_resource);
+    auto &owner = it->second;
+    auto &resources = owner.resources[index];
+    uint64_t previous{0u};
+    auto resource = resources.find(_key);
+    if (resource != resources.end())
+    {
+      previous = resource->second;
+      if (_bytes == 0u)
+        resources.erase(resource);
+      else
+        resource->second = _bytes;
+    }
+    else if (_bytes > 0u)
+    {
+      resources.emplace(_key, _bytes);
+    }
+
+    owner.bytes[index] = owner.bytes[index] - previous + _bytes;
+    _memory.total = _memory.total - previous + _bytes;
+  }
+}
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+uint64_t GpuMemory::Usage::TotalBytes() const
+{
+  uint64_t total{0u};
+  for (auto value : this->bytes)
+    total += value;
+  return total;
+}
+
+/////////////////////////////////////////////////
+void GpuMemory::Record(const std::string &_name, Resource _resource,
+    const std::string &_key, uint64_t _bytes)
+{
+  auto &m = memory();
+  std::lock_guard<std::mutex> lock(m.mutex);
+  record(m, _name, _resource, _key, _bytes);
+}
+
+/////////////////////////////////////////////////
+bool GpuMemory::Reserve(const std::string &_name, Resource _resource,
+    const std::string &_key, uint64_t _bytes)
+{
+  auto &m = memory();
+  {
+    std::lock_guard<std::mutex> lock(m.mutex);
+    if (fits(m, recordedBytes(m, _name, _resource, _key), _bytes))
+    {
+      record(m, _name, _resource, _key, _bytes);
+      return true;
+    }
+  }
+
+  std::lock_guard<std::recursive_mutex> reclaimLock(m.reclaimMutex);
+  std::vector<std::pair<uint64_t, Reclaimer>> reclaimers;
+  {
+    std::lock_guard<std::mutex> lock(m.mutex);
+    for (const auto &reclaimer : m.reclaimers)
+    {
+      const auto &name = reclaimer.second.first;
+      if (name == _name)
+        continue;
+
+      auto owner = m.owners.find(name);
+      if (owner != m.owners.end())
+      {
+        reclaimers.emplace_back(owner->second.TotalBytes(),
+            reclaimer.second.second);
+      }
+    }
+  }
+
+  // The largest users first, so fewer plugins lose their data
+  std::stable_sort(reclaimers.begin(), reclaimers.end(),
+      [](const auto &_a, const auto &_b)
+      {
+        return _a.first > _b.first;
+      });
+
+  for (const auto &reclaimer : reclaimers)
+  {
+    uint64_t needed;
+    {
+      std::lock_guard<std::mutex> lock(m.mutex);
+      auto previous = recordedBytes(m, _name, _resource, _key);
+      if (fits(m, previous, _bytes))
+        break;
+      needed = m.total - previous + _bytes - m.budget;
+    }
+    reclaimer.second(needed);
+  }
+
+  std::lock_guard<std::mutex> lock(m.mutex);
+  if (!fits(m, recordedBytes(m, _name, _resource, _key), _bytes))
+    return false;
+
+  record(m, _name, _resource, _key, _bytes);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void GpuMemory::Release(const std::string &_name, Resource _resource,
+    const std::string &_key)
+{
+  Record(_name, _resource, _key, 0u);
+}
+
+/////////////////////////////////////////////////
+void GpuMemory::ReleaseAll(const std::string &_name)
+{
+  auto &m = memory();
+  std::lock_guard<std::mutex> lock(m.mutex);
+  auto it = m.owners.find(_name);
+  if (it == m.owners.end())
+    return;
+
+  m.total -= it->second.TotalBytes();
+  m.owners.erase(it);
+}
+
+/////////////////////////////////////////////////
+uint64_t GpuMemory::AddReclaimer(const std::string &_name,
+    Reclaimer _reclaimer)
+{
+  if (!_reclaimer)
+    return 0u;
+
+  auto &m = memory();
+  std::lock_guard<std::mutex> lock(m.mutex);
+  auto id = m.nextReclaimer++;
+  m.reclaimers.emplace(id, std::make_pair(_name, std::move(_reclaimer)));
+  return id;
+}
+
+/////////////////////////////////////////////////
+void GpuMemory::RemoveReclaimer(uint64_t _id)
+{
+  auto &m = memory();
+  std::lock_guard<std::recursive_mutex> reclaimLock(m.reclaimMutex);
+  std::lock_guard<std::mutex> lock(m.mutex);
+  m.reclaimers.erase(_id);
+}
+
+/////////////////////////////////////////////////
+void GpuMemory::SetBudget(uint64_t _bytes)
+{
+  auto &m = memory();
+  std::lock_guard<std::mutex> lock(m.mutex);
+  m.budget = _bytes;
+}
+
+/////////////////////////////////////////////////
+uint64_t GpuMemory::Budget()
+{
+  auto &m = memory();
+  std::lock_guard<std::mutex> lock(m.mutex);
+  return m.budget;
+}
+
+/////////////////////////////////////////////////
+uint64_t GpuMemory::TotalBytes()
+{
+  auto &m = memory();
+  std::lock_guard<std::mutex> lock(m.mutex);
+  return m.total;
+}
+
+/////////////////////////////////////////////////
+uint64_t GpuMemory::AvailableBytes()
+{
+  auto &m = memory();
+  std::lock_guard<std::mutex> lock(m.mutex);
+  if (m.budget == 0u)
+    return std::numeric_limits<uint64_t>::max();
+  return m.total >= m.budget ? 0u : m.budget - m.total;
+}
+
+/////////////////////////////////////////////////
+std::vector<GpuMemory::Usage> GpuMemory::CurrentUsage()
+{
+  std::vector<Usage> result;
+  {
+    auto &m = memory();
+    std::lock_guard<std::mutex> lock(m.mutex);
+    for (const auto &owner : m.owners)
+    {
+      if (owner.second.TotalBytes() == 0u)
+        continue;
+
+      Usage usage;
+      usage.name = owner.first;
+      usage.bytes = owner.second.bytes;
+      result.push_back(usage);
+    }
+  }
+
+  std::stable_sort(result.begin(), result.end(),
+      [](const Usage &_a, const Usage &_b)
+      {
+        return _a.TotalBytes() > _b.TotalBytes();
+      });
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::string GpuMemory::ResourceName(Resource _resource)
+{
+  switch (_resource)
+  {
+    case Resource::kMeshes:
+      return "meshes";
+    case Resource::kTextures:
+      return "textures";
+    case Resource::kMarkers:
+      return "markers";
+    case Resource::kPoints:
+      return "points";
+  }
+  return "unknown";
+}
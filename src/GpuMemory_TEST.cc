@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <string>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/GpuMemory.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(GpuMemoryTest, Record)
+{
+  EXPECT_EQ(0u, GpuMemory::TotalBytes());
+  EXPECT_TRUE(GpuMemory::CurrentUsage().empty());
+
+  GpuMemory::Record("A", GpuMemory::Resource::kMeshes, "box.dae", 100u);
+  GpuMemory::Record("A", GpuMemory::Resource::kTextures, "camera", 50u);
+  GpuMemory::Record("B", GpuMemory::Resource::kPoints, "0", 500u);
+  EXPECT_EQ(650u, GpuMemory::TotalBytes());
+
+  // Recording the same key replaces it
+  GpuMemory::Record("A", GpuMemory::Resource::kMeshes, "box.dae", 200u);
+  EXPECT_EQ(750u, GpuMemory::TotalBytes());
+
+  // Largest first
+  auto usage = GpuMemory::CurrentUsage();
+  ASSERT_EQ(2u, usage.size());
+  EXPECT_EQ("B", usage[0].name);
+  EXPECT_EQ(500u, usage[0].TotalBytes());
+  EXPECT_EQ("A", usage[1].name);
+  EXPECT_EQ(200u, usage[1].bytes[
+      static_cast<std::size_t>(GpuMemory::Resource::kMeshes)]);
+  EXPECT_EQ(50u, usage[1].bytes[
+      static_cast<std::size_t>(GpuMemory::Resource::kTextures)]);
+  EXPECT_EQ(250u, usage[1].TotalBytes());
+
+  GpuMemory::Release("A", GpuMemory::Resource::kMeshes, "box.dae");
+  GpuMemory::Release("A", GpuMemory::Resource::kMeshes, "unknown");
+  EXPECT_EQ(550u, GpuMemory::TotalBytes());
+
+  GpuMemory::ReleaseAll("B");
+  GpuMemory::ReleaseAll("A");
+  EXPECT_EQ(0u, GpuMemory::TotalBytes());
+  EXPECT_TRUE(GpuMemory::CurrentUsage().empty());
+
+  EXPECT_EQ("meshes", GpuMemory::ResourceName(GpuMemory::Resource::kMeshes));
+  EXPECT_EQ("points", GpuMemory::ResourceName(GpuMemory::Resource::kPoints));
+}
+
+/////////////////////////////////////////////////
+TEST(GpuMemoryTest, Budget)
+{
+  // No limit by default
+  EXPECT_EQ(0u, GpuMemory::Budget());
+  EXPECT_EQ(std::numeric_limits<uint64_t>::max(),
+      GpuMemory::AvailableBytes());
+  EXPECT_TRUE(GpuMemory::Reserve("A", GpuMemory::Resource::kMeshes, "big",
+      1000000u));
+  GpuMemory::ReleaseAll("A");
+
+  GpuMemory::SetBudget(1000u);
+  EXPECT_EQ(1000u, GpuMemory::Budget());
+
+  // Reclaims from the others, the largest first, until it fits
+  int reclaimedB{0};
+  int reclaimedC{0};
+  GpuMemory::Record("B", GpuMemory::Resource::kPoints, "0", 300u);
+  GpuMemory::Record("B", GpuMemory::Resource::kPoints, "1", 300u);
+  auto reclaimerB = GpuMemory::AddReclaimer("B",
+      [&reclaimedB](uint64_t _bytes)
+      {
+        if (++reclaimedB == 1)
+        {
+          EXPECT_EQ(100u, _bytes);
+        }
+        GpuMemory::Release("B", GpuMemory::Resource::kPoints, "1");
+      });
+  GpuMemory::Record("C", GpuMemory::Resource::kMarkers, "0", 100u);
+  auto reclaimerC = GpuMemory::AddReclaimer("C", [&reclaimedC](uint64_t)
+  {
+    ++reclaimedC;
+  });
+  EXPECT_NE(0u, reclaimerB);
+  EXPECT_NE(reclaimerB, reclaimerC);
+  EXPECT_EQ(0u, GpuMemory::AddReclaimer("D", nullptr));
+  EXPECT_EQ(300u, GpuMemory::AvailableBytes());
+
+  EXPECT_TRUE(GpuMemory::Reserve("A", GpuMemory::Resource::kMeshes, "mesh",
+      200u));
+  EXPECT_EQ(0, reclaimedB);
+  EXPECT_TRUE(GpuMemory::Reserve("A", GpuMemory::Resource::kMeshes, "other",
+      200u));
+  EXPECT_EQ(1, reclaimedB);
+  EXPECT_EQ(0, reclaimedC);
+  EXPECT_EQ(800u, GpuMemory::TotalBytes());
+
+  // A plugin's own reclaimer isn't called, and resources which don't fit
+  // aren't recorded
+  auto reclaimerA = GpuMemory::AddReclaimer("A", [](uint64_t)
+  {
+    FAIL() << "A's own reclaimer was called";
+  });
+  EXPECT_FALSE(GpuMemory::Reserve("A", GpuMemory::Resource::kTextures, "huge",
+      5000u));
+  EXPECT_EQ(1, reclaimedC);
+  EXPECT_EQ(800u, GpuMemory::TotalBytes());
+
+  // The previous size of the key counts as available
+  EXPECT_TRUE(GpuMemory::Reserve("A", GpuMemory::Resource::kMeshes, "mesh",
+      400u));
+  EXPECT_EQ(1000u, GpuMemory::TotalBytes());
+  EXPECT_EQ(0u, GpuMemory::AvailableBytes());
+
+  // Removed reclaimers aren't called
+  GpuMemory::RemoveReclaimer(reclaimerC);
+  EXPECT_FALSE(GpuMemory::Reserve("A", GpuMemory::Resource::kTextures, "huge",
+      5000u));
+  EXPECT_EQ(1, reclaimedC);
+
+  GpuMemory::RemoveReclaimer(reclaimerA);
+  GpuMemory::RemoveReclaimer(reclaimerB);
+  GpuMemory::ReleaseAll("A");
+  GpuMemory::ReleaseAll("B");
+  GpuMemory::ReleaseAll("C");
+  GpuMemory::SetBudget(0u);
+  EXPECT_EQ(0u, GpuMemory::TotalBytes());
+}
@@ -146,6 +146,25 @@ class gz::gui::events::PreRender::Implementation
 {
 };
 
+class gz::gui::events::SceneChanged::Implementation
+{
+};
+
+class gz::gui::events::RenderSuspended::Implementation
+{
+  /// \brief True if rendering stopped, false if it resumed
+  public: bool suspended;
+};
+
+class gz::gui::events::SceneLoadProgress::Implementation
+{
+  /// \brief Fraction of the models and lights loaded
+  public: double progress;
+
+  /// \brief Number of visuals waiting for their meshes
+  public: unsigned int placeholders;
+};
+
 using namespace gz;
 using namespace gui;
 using namespace events;
@@ -430,3 +449,43 @@ PreRender::PreRender()
   : QEvent(kType), dataPtr(utils::MakeImpl<Implementation>())
 {
 }
+
+/////////////////////////////////////////////////
+SceneChanged::SceneChanged()
+  : QEvent(kType), dataPtr(utils::MakeImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+RenderSuspended::RenderSuspended(bool _suspended)
+  : QEvent(kType), dataPtr(utils::MakeImpl<Implementation>())
+{
+  this->dataPtr->suspended = _suspended;
+}
+
+/////////////////////////////////////////////////
+bool RenderSuspended::Suspended() const
+{
+  return this->dataPtr->suspended;
+}
+
+/////////////////////////////////////////////////
+SceneLoadProgress::SceneLoadProgress(double _progress,
+    unsigned int _placeholders)
+  : QEvent(kType), dataPtr(utils::MakeImpl<Implementation>())
+{
+  this->dataPtr->progress = _progress;
+  this->dataPtr->placeholders = _placeholders;
+}
+
+/////////////////////////////////////////////////
+double SceneLoadProgress::Progress() const
+{
+  return this->dataPtr->progress;
+}
+
+/////////////////////////////////////////////////
+unsigned int SceneLoadProgress::Placeholders() const
+{
+  return this->dataPtr->placeholders;
+}
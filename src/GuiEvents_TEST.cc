@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include <string>
 
 #include "test_config.hh"  // NOLINT(build/include)
 #include "gz/gui/GuiEvents.hh"
@@ -291,3 +292,89 @@ TEST(GuiEventsTest, PreRender)
 
   EXPECT_LT(QEvent::User, event.type());
 }
+
+/////////////////////////////////////////////////
+TEST(GuiEventsTest, SceneChanged)
+{
+  events::SceneChanged event;
+
+  EXPECT_LT(QEvent::User, event.type());
+  EXPECT_NE(events::PreRender::kType, event.type());
+}
+
+/////////////////////////////////////////////////
+TEST(GuiEventsTest, RenderSuspended)
+{
+  events::RenderSuspended suspended(true);
+
+  EXPECT_LT(QEvent::User, suspended.type());
+  EXPECT_NE(events::SceneChanged::kType, suspended.type());
+  EXPECT_TRUE(suspended.Suspended());
+
+  events::RenderSuspended resumed(false);
+  EXPECT_FALSE(resumed.Suspended());
+}
+
+/////////////////////////////////////////////////
+TEST(GuiEventsTest, Dispatcher)
+{
+  // Not contiguous, with SnapIntervals and others in between
+  using Events = events::Dispatcher<events::Render,
+      events::SpawnFromDescription, events::RenderSuspended>;
+  static_assert(Events::kTypes.size() == 3u, "Wrong number of types");
+  EXPECT_EQ(events::SpawnFromDescription::kType, Events::kTypes[1]);
+
+  int renders{0};
+  std::string description;
+  int suspended{0};
+  auto handlers = events::Handlers{
+      [&](events::Render &) { ++renders; },
+      [&](events::SpawnFromDescription &_event)
+      {
+        description = _event.Description();
+      },
+      [&](events::RenderSuspended &_event)
+      {
+        suspended += _event.Suspended() ? 1 : -1;
+      }};
+
+  events::Render render;
+  EXPECT_TRUE(Events::Dispatch(&render, handlers));
+  EXPECT_EQ(1, renders);
+
+  events::SpawnFromDescription spawn("<sdf/>");
+  EXPECT_TRUE(Events::Dispatch(&spawn, handlers));
+  EXPECT_EQ("<sdf/>", description);
+
+  events::RenderSuspended suspend(true);
+  EXPECT_TRUE(Events::Dispatch(&suspend, handlers));
+  EXPECT_EQ(1, suspended);
+
+  // Within the table but not one of the types
+  events::SnapIntervals snap({1, 2, 3}, {4, 5, 6}, {7, 8, 9});
+  EXPECT_FALSE(Events::Dispatch(&snap, handlers));
+  events::PreRender preRender;
+  EXPECT_FALSE(Events::Dispatch(&preRender, handlers));
+
+  // Outside the table
+  QEvent user(QEvent::User);
+  EXPECT_FALSE(Events::Dispatch(&user, handlers));
+  EXPECT_EQ(1, renders);
+  EXPECT_EQ(1, suspended);
+
+  // A generic lambda handles all types
+  int count{0};
+  EXPECT_TRUE(Events::Dispatch(&spawn, [&](auto &) { ++count; }));
+  EXPECT_EQ(1, count);
+}
+
+/////////////////////////////////////////////////
+TEST(GuiEventsTest, SceneLoadProgress)
+{
+  events::SceneLoadProgress event(0.25, 3u);
+
+  EXPECT_LT(QEvent::User, event.type());
+  EXPECT_NE(events::RenderSuspended::kType, event.type());
+  EXPECT_DOUBLE_EQ(0.25, event.Progress());
+  EXPECT_EQ(3u, event.Placeholders());
+}
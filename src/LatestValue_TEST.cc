@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/LatestValue.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./LatestValue_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(LatestValueTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Coalesce))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv, WindowType::kDialog);
+
+  std::vector<std::string> received;
+  LatestValue<std::string> latest(&app, [&](const std::string &_value)
+  {
+    received.push_back(_value);
+  });
+
+  // Values set from another thread before the GUI thread gets to them are
+  // delivered once, newest first
+  std::thread setter([&]
+  {
+    latest.Set("a");
+    latest.Set("b");
+    latest.Set("c");
+  });
+  setter.join();
+  EXPECT_TRUE(received.empty());
+
+  QCoreApplication::processEvents();
+  ASSERT_EQ(1u, received.size());
+  EXPECT_EQ("c", received[0]);
+  EXPECT_EQ(2u, latest.Replaced());
+
+  // Nothing is delivered without a new value
+  QCoreApplication::processEvents();
+  EXPECT_EQ(1u, received.size());
+
+  latest.Set("d");
+  QCoreApplication::processEvents();
+  ASSERT_EQ(2u, received.size());
+  EXPECT_EQ("d", received[1]);
+}
+
+/////////////////////////////////////////////////
+TEST(LatestValueTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Destroyed))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv, WindowType::kDialog);
+
+  int calls{0};
+  {
+    LatestValue<int> latest(&app, [&](const int &)
+    {
+      ++calls;
+    });
+    latest.Set(1);
+  }
+
+  // The queued call finds it destroyed
+  QCoreApplication::processEvents();
+  EXPECT_EQ(0, calls);
+}
@@ -16,14 +16,27 @@
  */
 
 #include <tinyxml2.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <sstream>
 #include <regex>
 #include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
 #include "gz/gui/Application.hh"
 #include "gz/gui/MainWindow.hh"
 #include "gz/gui/Plugin.hh"
+#include "gz/gui/PluginStats.hh"
 #include "gz/gui/qt.h"
 #include "gz/msgs/boolean.pb.h"
 #include "gz/msgs/server_control.pb.h"
@@ -33,8 +46,35 @@ namespace gz
 {
   namespace gui
   {
+    /// \brief Config waiting to be written by the save thread
+    struct SaveJob
+    {
+      /// \brief Destination file
+      std::string path;
+
+      /// \brief Snapshot of the window and plugins
+      WindowConfig config;
+
+      /// \brief Skip writing if the file already has the same contents
+      bool onlyIfChanged{false};
+    };
+
     class MainWindowPrivate
     {
+      /// \brief Serialize and write the queued configs until stopped. Run
+      /// by the save thread.
+      /// \param[in] _window Window notified when each save finishes
+      public: void SaveLoop(MainWindow *_window);
+
+      /// \brief Write a config file atomically: it's written next to the
+      /// destination and moved over it, so readers and crashes never see a
+      /// partial file.
+      /// \param[in] _path Destination file
+      /// \param[in] _xml File contents
+      /// \return True if successful
+      public: bool WriteConfig(const std::string &_path,
+          const std::string &_xml);
+
       /// \brief Number of plugins on the window
       public: int pluginCount{0};
 
@@ -44,6 +84,11 @@ namespace gz
       /// \brief Configuration for this window.
       public: WindowConfig windowConfig;
 
+      /// \brief Names of the plugins for the plugin menu, computed the
+      /// first time they're needed after the plugin list or the config
+      /// changes
+      public: std::optional<QStringList> pluginList;
+
       /// \brief Counts the times the window has been painted
       public: unsigned int paintCount{0};
 
@@ -77,6 +122,36 @@ namespace gz
 
       /// \brief Communication node
       public: gz::transport::Node node;
+
+      /// \brief Objects subscribed to each event type, see SubscribeEvent.
+      /// Destroyed objects are skipped and removed on the next dispatch.
+      public: std::map<int, std::vector<QPointer<QObject>>> eventSubscribers;
+
+      /// \brief Protects eventSubscribers, since events such as
+      /// events::Render are sent from the render thread
+      public: std::mutex eventMutex;
+
+      /// \brief Contents last written to each config file, used to skip
+      /// autosaves which wouldn't change anything. Protected by saveMutex.
+      public: std::map<std::string, std::string> savedConfigs;
+
+      /// \brief Configs waiting to be written, in order
+      public: std::deque<SaveJob> saveQueue;
+
+      /// \brief Protects saveQueue, savedConfigs and saveStop
+      public: std::mutex saveMutex;
+
+      /// \brief Notifies the save thread of a job or of saveStop
+      public: std::condition_variable saveCondition;
+
+      /// \brief Whether the save thread should stop once the queue is empty
+      public: bool saveStop{false};
+
+      /// \brief Save thread, started with the first asynchronous save
+      public: std::thread saveThread;
+
+      /// \brief Saves the config to the default path periodically
+      public: QTimer autosaveTimer;
     };
   }
 }
@@ -102,6 +177,17 @@ MainWindow::MainWindow()
   qmlRegisterUncreatableMetaObject(gui::staticMetaObject,
     "ExitAction", 1, 0, "ExitAction", "Error: namespace enum");
 
+  this->connect(App(), &Application::PluginListChanged, this, [this]()
+  {
+    this->dataPtr->pluginList.reset();
+  });
+
+  this->connect(&this->dataPtr->autosaveTimer, &QTimer::timeout, this,
+      [this]()
+      {
+        this->SaveConfigAsync(App()->DefaultConfigPath(), true);
+      });
+
   // Make MainWindow functions available from all QML files (using root)
   App()->Engine()->rootContext()->setContextProperty("MainWindow", this);
 
@@ -124,32 +210,46 @@ MainWindow::MainWindow()
 /////////////////////////////////////////////////
 MainWindow::~MainWindow()
 {
+  // Queued configs are still written
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->saveMutex);
+    this->dataPtr->saveStop = true;
+  }
+  this->dataPtr->saveCondition.notify_one();
+  if (this->dataPtr->saveThread.joinable())
+    this->dataPtr->saveThread.join();
 }
 
 /////////////////////////////////////////////////
 QStringList MainWindow::PluginListModel() const
 {
+  if (this->dataPtr->pluginList)
+    return *this->dataPtr->pluginList;
+
+  // Split WWWCamelCase3D -> WWW Camel Case 3D
+  static const std::regex reg("(\\B[A-Z][a-z])|(\\B[0-9])");
+
+  const auto &config = this->dataPtr->windowConfig;
+  std::unordered_set<std::string> show(config.showPlugins.begin(),
+      config.showPlugins.end());
+
   QStringList pluginNames;
   auto plugins = App()->PluginList();
   for (auto const &path : plugins)
   {
     for (auto const &plugin : path.second)
     {
-      // Remove lib and .so
-      auto pluginName = plugin.substr(3, plugin.find(".") - 3);
-
-      // Split WWWCamelCase3D -> WWW Camel Case 3D
-      std::regex reg("(\\B[A-Z][a-z])|(\\B[0-9])");
+      // Remove lib and .so, which built-in plugins don't have
+      auto pluginName = plugin.find("lib") == 0 ? plugin.substr(3) : plugin;
+      pluginName = pluginName.substr(0, pluginName.find("."));
       pluginName = std::regex_replace(pluginName, reg, " $&");
 
-      // Show?
-      if (this->dataPtr->windowConfig.pluginsFromPaths ||
-          std::find(this->dataPtr->windowConfig.showPlugins.begin(),
-                    this->dataPtr->windowConfig.showPlugins.end(),
-                    pluginName) !=
-                    this->dataPtr->windowConfig.showPlugins.end())
+      // Show? Built-in plugins may also be found on the paths
+      auto name = QString::fromStdString(pluginName);
+      if ((config.pluginsFromPaths || show.count(pluginName) > 0) &&
+          !pluginNames.contains(name))
       {
-        pluginNames.append(QString::fromStdString(pluginName));
+        pluginNames.append(name);
       }
     }
   }
@@ -165,6 +265,7 @@ QStringList MainWindow::PluginListModel() const
   }
 
   pluginNames.sort();
+  this->dataPtr->pluginList = pluginNames;
   return pluginNames;
 }
 
@@ -181,7 +282,7 @@ void MainWindow::OnLoadConfig(const QString &_path)
 /////////////////////////////////////////////////
 void MainWindow::OnSaveConfig()
 {
-  this->SaveConfig(App()->DefaultConfigPath());
+  this->SaveConfigAsync(App()->DefaultConfigPath());
 }
 
 /////////////////////////////////////////////////
@@ -190,7 +291,7 @@ void MainWindow::OnSaveConfigAs(const QString &_path)
   auto localPath = QUrl(_path).toLocalFile();
   if (localPath.isEmpty())
     localPath = _path;
-  this->SaveConfig(localPath.toStdString());
+  this->SaveConfigAsync(localPath.toStdString());
 }
 
 /////////////////////////////////////////////////
@@ -237,26 +338,186 @@ void MainWindow::SaveConfig(const std::string &_path)
 {
   this->dataPtr->windowConfig = this->CurrentWindowConfig();
 
-  // Create the intermediate directories if needed.
-  // We check for errors when we try to open the file.
-  auto dirname = dirName(_path);
-  common::createDirectories(dirname);
-
-  // Open the file
-  std::ofstream out(_path.c_str(), std::ios::out);
-  if (!out)
+  auto xml = this->dataPtr->windowConfig.XMLString();
+  if (!this->dataPtr->WriteConfig(_path, xml))
   {
     std::string str = "Unable to open file: " + _path;
     str += ".\nCheck file permissions.";
     this->notify(QString::fromStdString(str));
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->saveMutex);
+    this->dataPtr->savedConfigs[_path] = xml;
   }
-  else
-    out << this->dataPtr->windowConfig.XMLString();
 
   std::string msg("Saved configuration to <b>" + _path + "</b>");
 
   this->notify(QString::fromStdString(msg));
   gzmsg << msg << std::endl;
+  this->configSaved(QString::fromStdString(_path), true);
+}
+
+/////////////////////////////////////////////////
+void MainWindow::SaveConfigAsync(const std::string &_path)
+{
+  this->SaveConfigAsync(_path, false);
+}
+
+/////////////////////////////////////////////////
+void MainWindow::SaveConfigAsync(const std::string &_path,
+    bool _onlyIfChanged)
+{
+  // Plugins are queried on this thread, only the serialization and the
+  // writing are left to the save thread
+  this->dataPtr->windowConfig = this->CurrentWindowConfig();
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->saveMutex);
+    SaveJob job;
+    job.path = _path;
+    job.config = this->dataPtr->windowConfig;
+    job.onlyIfChanged = _onlyIfChanged;
+    this->dataPtr->saveQueue.push_back(std::move(job));
+  }
+  this->dataPtr->saveCondition.notify_one();
+
+  if (!this->dataPtr->saveThread.joinable())
+  {
+    this->dataPtr->saveThread = std::thread(&MainWindowPrivate::SaveLoop,
+        this->dataPtr.get(), this);
+  }
+}
+
+/////////////////////////////////////////////////
+void MainWindow::SetAutosavePeriod(std::chrono::milliseconds _period)
+{
+  if (_period.count() <= 0)
+    this->dataPtr->autosaveTimer.stop();
+  else
+    this->dataPtr->autosaveTimer.start(static_cast<int>(_period.count()));
+}
+
+/////////////////////////////////////////////////
+std::chrono::milliseconds MainWindow::AutosavePeriod() const
+{
+  if (!this->dataPtr->autosaveTimer.isActive())
+    return std::chrono::milliseconds(0);
+  return std::chrono::milliseconds(this->dataPtr->autosaveTimer.interval());
+}
+
+/////////////////////////////////////////////////
+void MainWindowPrivate::SaveLoop(MainWindow *_window)
+{
+  while (true)
+  {
+    SaveJob job;
+    std::string saved;
+    bool known{false};
+    {
+      std::unique_lock<std::mutex> lock(this->saveMutex);
+      this->saveCondition.wait(lock, [this]
+      {
+        return this->saveStop || !this->saveQueue.empty();
+      });
+      if (this->saveQueue.empty())
+        return;
+      job = std::move(this->saveQueue.front());
+      this->saveQueue.pop_front();
+
+      auto it = this->savedConfigs.find(job.path);
+      known = it != this->savedConfigs.end();
+      if (known)
+        saved = it->second;
+    }
+
+    auto xml = job.config.XMLString();
+
+    // Compare with the file itself the first time, it may have been saved
+    // by a previous session
+    if (job.onlyIfChanged && !known)
+    {
+      std::ifstream in(job.path);
+      if (in)
+      {
+        std::stringstream contents;
+        contents << in.rdbuf();
+        saved = contents.str();
+        known = true;
+      }
+    }
+
+    bool changed = !job.onlyIfChanged || !known || saved != xml;
+    bool success = !changed || this->WriteConfig(job.path, xml);
+    if (success)
+    {
+      std::lock_guard<std::mutex> lock(this->saveMutex);
+      this->savedConfigs[job.path] = xml;
+    }
+
+    auto path = job.path;
+    auto autosave = job.onlyIfChanged;
+    QMetaObject::invokeMethod(_window,
+        [_window, path, autosave, changed, success]
+    {
+      if (!success)
+      {
+        std::string str = "Unable to open file: " + path;
+        str += ".\nCheck file permissions.";
+        _window->notify(QString::fromStdString(str));
+        return;
+      }
+
+      if (!changed)
+      {
+        _window->configSaved(QString::fromStdString(path), false);
+        return;
+      }
+
+      std::string msg("Saved configuration to <b>" + path + "</b>");
+      if (autosave)
+      {
+        gzdbg << "Autosaved configuration to [" << path << "]" << std::endl;
+      }
+      else
+      {
+        _window->notify(QString::fromStdString(msg));
+        gzmsg << msg << std::endl;
+      }
+      _window->configSaved(QString::fromStdString(path), true);
+    }, Qt::QueuedConnection);
+  }
+}
+
+/////////////////////////////////////////////////
+bool MainWindowPrivate::WriteConfig(const std::string &_path,
+    const std::string &_xml)
+{
+  // Create the intermediate directories if needed.
+  // We check for errors when we try to open the file.
+  common::createDirectories(dirName(_path));
+
+  auto tmpPath = _path + ".tmp";
+  {
+    std::ofstream out(tmpPath, std::ios::out | std::ios::trunc);
+    if (!out)
+      return false;
+    out << _xml;
+    out.close();
+    if (!out)
+    {
+      std::remove(tmpPath.c_str());
+      return false;
+    }
+  }
+
+  if (!common::moveFile(tmpPath, _path))
+  {
+    std::remove(tmpPath.c_str());
+    return false;
+  }
+  return true;
 }
 
 /////////////////////////////////////////////////
@@ -335,6 +596,7 @@ bool MainWindow::ApplyConfig(const WindowConfig &_config)
 
   // Keep a copy
   this->dataPtr->windowConfig = _config;
+  this->dataPtr->pluginList.reset();
 
   // Notify view
   this->configChanged();
@@ -402,155 +664,186 @@ bool WindowConfig::MergeFromXML(const std::string &_windowXml)
   // TinyXml element from string
   tinyxml2::XMLDocument doc;
   doc.Parse(_windowXml.c_str());
-  auto winElem = doc.FirstChildElement("window");
+  return this->MergeFromXML(doc.FirstChildElement("window"));
+}
 
-  if (!winElem)
+/////////////////////////////////////////////////
+bool WindowConfig::MergeFromXML(const tinyxml2::XMLElement *_windowElem)
+{
+  if (!_windowElem)
     return false;
 
-  // Position
-  if (auto xElem = winElem->FirstChildElement("position_x"))
-    xElem->QueryIntText(&this->posX);
-
-  if (auto yElem = winElem->FirstChildElement("position_y"))
-    yElem->QueryIntText(&this->posY);
-
-  // Size
-  if (auto widthElem = winElem->FirstChildElement("width"))
-    widthElem->QueryIntText(&this->width);
-
-  if (auto heightElem = winElem->FirstChildElement("height"))
-    heightElem->QueryIntText(&this->height);
+  // Loaded by Application::LoadConfig
+  static const std::unordered_set<std::string> kAppElems{
+      "default_exit_action", "dialog_on_exit", "dialog_on_exit_options",
+      "server_control_service"};
 
-  // Docks state
-  if (auto stateElem = winElem->FirstChildElement("state"))
+  std::unordered_set<std::string> seen;
+  for (auto elem = _windowElem->FirstChildElement(); elem != nullptr;
+      elem = elem->NextSiblingElement())
   {
-    auto text = stateElem->GetText();
-    if (nullptr != text)
-      this->state = QByteArray::fromBase64(text);
-  }
+    std::string name = elem->Name();
 
-  // Style
-  if (auto styleElem = winElem->FirstChildElement("style"))
-  {
-    auto mTheme = styleElem->Attribute("material_theme");
-    if (mTheme)
-    {
-      this->materialTheme = mTheme;
-    }
-    auto mPrimary = styleElem->Attribute("material_primary");
-    if (mPrimary)
-    {
-      this->materialPrimary = mPrimary;
-    }
-    auto mAccent = styleElem->Attribute("material_accent");
-    if (mAccent)
-    {
-      this->materialAccent = mAccent;
-    }
-    auto tbColorLight = styleElem->Attribute("toolbar_color_light");
-    if (tbColorLight)
+    if (name == "ignore")
     {
-      this->toolBarColorLight = tbColorLight;
+      if (auto prop = elem->GetText())
+        this->ignoredProps.insert(prop);
+      continue;
     }
-    auto tbTextColorLight = styleElem->Attribute("toolbar_text_color_light");
-    if (tbTextColorLight)
-    {
-      this->toolBarTextColorLight = tbTextColorLight;
-    }
-    auto tbColorDark = styleElem->Attribute("toolbar_color_dark");
-    if (tbColorDark)
+
+    // The first one wins, like the lookups of the other config elements
+    if (!seen.insert(name).second)
     {
-      this->toolBarColorDark = tbColorDark;
+      gzwarn << "Ignoring repeated <" << name << "> of <window>"
+             << std::endl;
+      continue;
     }
-    auto tbTextColorDark = styleElem->Attribute("toolbar_text_color_dark");
-    if (tbTextColorDark)
+
+    // Position
+    if (name == "position_x")
     {
-      this->toolBarTextColorDark = tbTextColorDark;
+      elem->QueryIntText(&this->posX);
     }
-    auto pluginTBColorLight =
-        styleElem->Attribute("plugin_toolbar_color_light");
-    if (pluginTBColorLight)
+    else if (name == "position_y")
     {
-      this->pluginToolBarColorLight = pluginTBColorLight;
+      elem->QueryIntText(&this->posY);
     }
-    auto pluginTBTextColorLight =
-        styleElem->Attribute("plugin_toolbar_text_color_light");
-    if (pluginTBTextColorLight)
+    // Size
+    else if (name == "width")
     {
-      this->pluginToolBarTextColorLight = pluginTBTextColorLight;
+      elem->QueryIntText(&this->width);
     }
-    auto pluginTBColorDark = styleElem->Attribute("plugin_toolbar_color_dark");
-    if (pluginTBColorDark)
+    else if (name == "height")
     {
-      this->pluginToolBarColorDark = pluginTBColorDark;
+      elem->QueryIntText(&this->height);
     }
-    auto pluginTBTextColorDark =
-        styleElem->Attribute("plugin_toolbar_text_color_dark");
-    if (pluginTBTextColorDark)
+    // Docks state
+    else if (name == "state")
     {
-      this->pluginToolBarTextColorDark = pluginTBTextColorDark;
+      auto text = elem->GetText();
+      if (nullptr != text)
+        this->state = QByteArray::fromBase64(text);
     }
-  }
-
-  // Menus
-  if (auto menusElem = winElem->FirstChildElement("menus"))
-  {
-    // Drawer
-    if (auto drawerElem = menusElem->FirstChildElement("drawer"))
+    // Style
+    else if (name == "style")
     {
-      // Visible
-      if (drawerElem->Attribute("visible"))
+      auto styleElem = elem;
+      auto mTheme = styleElem->Attribute("material_theme");
+      if (mTheme)
       {
-        bool visible = true;
-        drawerElem->QueryBoolAttribute("visible", &visible);
-        this->showDrawer = visible;
+        this->materialTheme = mTheme;
       }
-      // Default
-      if (drawerElem->Attribute("default"))
+      auto mPrimary = styleElem->Attribute("material_primary");
+      if (mPrimary)
       {
-        bool def = true;
-        drawerElem->QueryBoolAttribute("default", &def);
-        this->showDefaultDrawerOpts = def;
+        this->materialPrimary = mPrimary;
       }
-    }
-
-    // Plugins
-    if (auto pluginsElem = menusElem->FirstChildElement("plugins"))
-    {
-      // Visible
-      if (pluginsElem->Attribute("visible"))
+      auto mAccent = styleElem->Attribute("material_accent");
+      if (mAccent)
       {
-        bool visible = true;
-        pluginsElem->QueryBoolAttribute("visible", &visible);
-        this->showPluginMenu = visible;
+        this->materialAccent = mAccent;
       }
-
-      // From paths
-      if (pluginsElem->Attribute("from_paths"))
+      auto tbColorLight = styleElem->Attribute("toolbar_color_light");
+      if (tbColorLight)
       {
-        bool fromPaths = false;
-        pluginsElem->QueryBoolAttribute("from_paths", &fromPaths);
-        this->pluginsFromPaths = fromPaths;
+        this->toolBarColorLight = tbColorLight;
       }
-
-      // Show individual plugins
-      for (auto showElem = pluginsElem->FirstChildElement("show");
-          showElem != nullptr;
-          showElem = showElem->NextSiblingElement("show"))
+      auto tbTextColorLight = styleElem->Attribute("toolbar_text_color_light");
+      if (tbTextColorLight)
+      {
+        this->toolBarTextColorLight = tbTextColorLight;
+      }
+      auto tbColorDark = styleElem->Attribute("toolbar_color_dark");
+      if (tbColorDark)
+      {
+        this->toolBarColorDark = tbColorDark;
+      }
+      auto tbTextColorDark = styleElem->Attribute("toolbar_text_color_dark");
+      if (tbTextColorDark)
+      {
+        this->toolBarTextColorDark = tbTextColorDark;
+      }
+      auto pluginTBColorLight =
+          styleElem->Attribute("plugin_toolbar_color_light");
+      if (pluginTBColorLight)
+      {
+        this->pluginToolBarColorLight = pluginTBColorLight;
+      }
+      auto pluginTBTextColorLight =
+          styleElem->Attribute("plugin_toolbar_text_color_light");
+      if (pluginTBTextColorLight)
+      {
+        this->pluginToolBarTextColorLight = pluginTBTextColorLight;
+      }
+      auto pluginTBColorDark =
+          styleElem->Attribute("plugin_toolbar_color_dark");
+      if (pluginTBColorDark)
+      {
+        this->pluginToolBarColorDark = pluginTBColorDark;
+      }
+      auto pluginTBTextColorDark =
+          styleElem->Attribute("plugin_toolbar_text_color_dark");
+      if (pluginTBTextColorDark)
       {
-        if (auto pluginName = showElem->GetText())
-          this->showPlugins.push_back(pluginName);
+        this->pluginToolBarTextColorDark = pluginTBTextColorDark;
       }
     }
-  }
+    // Menus
+    else if (name == "menus")
+    {
+      auto menusElem = elem;
+      // Drawer
+      if (auto drawerElem = menusElem->FirstChildElement("drawer"))
+      {
+        // Visible
+        if (drawerElem->Attribute("visible"))
+        {
+          bool visible = true;
+          drawerElem->QueryBoolAttribute("visible", &visible);
+          this->showDrawer = visible;
+        }
+        // Default
+        if (drawerElem->Attribute("default"))
+        {
+          bool def = true;
+          drawerElem->QueryBoolAttribute("default", &def);
+          this->showDefaultDrawerOpts = def;
+        }
+      }
 
-  // Ignore
-  for (auto ignoreElem = winElem->FirstChildElement("ignore");
-      ignoreElem != nullptr;
-      ignoreElem = ignoreElem->NextSiblingElement("ignore"))
-  {
-    if (auto prop = ignoreElem->GetText())
-      this->ignoredProps.insert(prop);
+      // Plugins
+      if (auto pluginsElem = menusElem->FirstChildElement("plugins"))
+      {
+        // Visible
+        if (pluginsElem->Attribute("visible"))
+        {
+          bool visible = true;
+          pluginsElem->QueryBoolAttribute("visible", &visible);
+          this->showPluginMenu = visible;
+        }
+
+        // From paths
+        if (pluginsElem->Attribute("from_paths"))
+        {
+          bool fromPaths = false;
+          pluginsElem->QueryBoolAttribute("from_paths", &fromPaths);
+          this->pluginsFromPaths = fromPaths;
+        }
+
+        // Show individual plugins
+        for (auto showElem = pluginsElem->FirstChildElement("show");
+            showElem != nullptr;
+            showElem = showElem->NextSiblingElement("show"))
+        {
+          if (auto pluginName = showElem->GetText())
+            this->showPlugins.push_back(pluginName);
+        }
+      }
+    }
+    else if (kAppElems.count(name) == 0)
+    {
+      gzwarn << "Ignoring unknown <" << name << "> of <window>" << std::endl;
+    }
   }
 
   return true;
@@ -947,6 +1240,14 @@ void MainWindow::SetShowDialogOnExit(bool _showDialogOnExit)
 /////////////////////////////////////////////////
 void MainWindow::SetRenderEngine(const std::string &_renderEngine)
 {
+  // Left empty, so nothing initializes the engine
+  if (Application::Lite())
+  {
+    gzmsg << "Ignoring render engine [" << _renderEngine << "] in "
+          << "lightweight mode" << std::endl;
+    return;
+  }
+
   // Deprecated: accept ignition-prefixed engines
   auto renderEngine = _renderEngine;
   auto pos = renderEngine.find("ignition");
@@ -1038,3 +1339,81 @@ void MainWindow::SetServerControlService(const std::string &_service)
 {
   this->dataPtr->controlService = _service;
 }
+
+/////////////////////////////////////////////////
+void MainWindow::SubscribeEvent(QEvent::Type _type, QObject *_subscriber)
+{
+  if (nullptr == _subscriber)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->eventMutex);
+  auto &subscribers = this->dataPtr->eventSubscribers[_type];
+  if (std::find(subscribers.begin(), subscribers.end(), _subscriber) ==
+      subscribers.end())
+  {
+    subscribers.emplace_back(_subscriber);
+  }
+}
+
+/////////////////////////////////////////////////
+void MainWindow::UnsubscribeEvent(QEvent::Type _type, QObject *_subscriber)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->eventMutex);
+  auto it = this->dataPtr->eventSubscribers.find(_type);
+  if (it == this->dataPtr->eventSubscribers.end())
+    return;
+
+  auto &subscribers = it->second;
+  subscribers.erase(std::remove(subscribers.begin(), subscribers.end(),
+      _subscriber), subscribers.end());
+  if (subscribers.empty())
+    this->dataPtr->eventSubscribers.erase(it);
+}
+
+/////////////////////////////////////////////////
+std::size_t MainWindow::EventSubscriberCount(QEvent::Type _type) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->eventMutex);
+  auto it = this->dataPtr->eventSubscribers.find(_type);
+  if (it == this->dataPtr->eventSubscribers.end())
+    return 0u;
+
+  return static_cast<std::size_t>(std::count_if(it->second.begin(),
+      it->second.end(), [](const QPointer<QObject> &_subscriber)
+      {
+        return !_subscriber.isNull();
+      }));
+}
+
+/////////////////////////////////////////////////
+bool MainWindow::event(QEvent *_event)
+{
+  // Copied, so subscribers may subscribe and unsubscribe while handling it
+  std::vector<QPointer<QObject>> subscribers;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->eventMutex);
+    auto it = this->dataPtr->eventSubscribers.find(_event->type());
+    if (it != this->dataPtr->eventSubscribers.end())
+      subscribers = it->second;
+  }
+  if (subscribers.empty())
+    return QObject::event(_event);
+
+  bool pruned{false};
+  for (const auto &subscriber : subscribers)
+  {
+    if (subscriber.isNull())
+    {
+      pruned = true;
+      continue;
+    }
+    PluginStats::Scope stats(subscriber.data(), PluginStats::Source::kEvents);
+    if (subscriber->eventFilter(this, _event))
+      return true;
+  }
+
+  if (pruned)
+    this->UnsubscribeEvent(_event->type(), nullptr);
+
+  return QObject::event(_event);
+}
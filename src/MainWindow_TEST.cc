@@ -17,11 +17,16 @@
 
 #include <gtest/gtest.h>
 #include <chrono>
+#include <fstream>
+#include <optional>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <QQmlProperty>
 
 #include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
 #include <gz/msgs/boolean.pb.h>
 #include <gz/msgs/server_control.pb.h>
 #include <gz/transport/Node.hh>
@@ -29,6 +34,7 @@
 
 #include "test_config.hh"  // NOLINT(build/include)
 #include "gz/gui/Application.hh"
+#include "gz/gui/GuiEvents.hh"
 #include "gz/gui/MainWindow.hh"
 #include "gz/gui/Plugin.hh"
 
@@ -43,6 +49,27 @@ using namespace gz;
 using namespace gui;
 using namespace std::chrono_literals;
 
+/////////////////////////////////////////////////
+/// \brief Process events until the window saves a config
+/// \param[in] _window Window
+/// \return Whether the file was written, empty if nothing was saved
+std::optional<bool> waitForSave(MainWindow *_window)
+{
+  std::optional<bool> written;
+  auto connection = QObject::connect(_window, &MainWindow::configSaved,
+      [&written](const QString &, bool _written)
+      {
+        written = _written;
+      });
+  for (int i = 0; i < 300 && !written; ++i)
+  {
+    QCoreApplication::processEvents();
+    std::this_thread::sleep_for(10ms);
+  }
+  QObject::disconnect(connection);
+  return written;
+}
+
 /////////////////////////////////////////////////
 // See https://github.com/gazebosim/gz-gui/issues/75
 TEST(MainWindowTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Constructor))
@@ -74,6 +101,7 @@ TEST(MainWindowTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(OnSaveConfig))
   {
     // Trigger save
     mainWindow->OnSaveConfig();
+    EXPECT_TRUE(waitForSave(mainWindow).value_or(false));
 
     // Check saved file
     QFile saved(QString::fromStdString(kTestConfigFile));
@@ -107,6 +135,7 @@ TEST(MainWindowTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(SaveConfigAs))
   {
     // Trigger save
     mainWindow->OnSaveConfigAs(QString::fromStdString(kTestConfigFile));
+    EXPECT_TRUE(waitForSave(mainWindow).value_or(false));
 
     // Check saved file
     QFile saved(QString::fromStdString(kTestConfigFile));
@@ -130,6 +159,37 @@ TEST(MainWindowTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(SaveConfigAs))
   delete mainWindow;
 }
 
+/////////////////////////////////////////////////
+TEST(MainWindowTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Autosave))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+  App()->SetDefaultConfigPath(kTestConfigFile);
+  std::remove(kTestConfigFile.c_str());
+
+  auto mainWindow = new MainWindow;
+  ASSERT_NE(nullptr, mainWindow);
+  EXPECT_EQ(0ms, mainWindow->AutosavePeriod());
+
+  mainWindow->SetAutosavePeriod(50ms);
+  EXPECT_EQ(50ms, mainWindow->AutosavePeriod());
+
+  // Written the first time
+  EXPECT_TRUE(waitForSave(mainWindow).value_or(false));
+  EXPECT_TRUE(common::exists(kTestConfigFile));
+  EXPECT_FALSE(common::exists(kTestConfigFile + ".tmp"));
+
+  // Skipped while nothing changes
+  EXPECT_FALSE(waitForSave(mainWindow).value_or(true));
+
+  mainWindow->SetAutosavePeriod(0ms);
+  EXPECT_EQ(0ms, mainWindow->AutosavePeriod());
+  EXPECT_FALSE(waitForSave(mainWindow).has_value());
+
+  delete mainWindow;
+  std::remove(kTestConfigFile.c_str());
+}
+
 /////////////////////////////////////////////////
 TEST(MainWindowTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(OnLoadConfig))
 {
@@ -204,6 +264,46 @@ TEST(MainWindowTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(OnAddPlugin))
   EXPECT_EQ(plugins.size(), 2);
 }
 
+/////////////////////////////////////////////////
+TEST(MainWindowTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(PluginListModel))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  auto mainWindow = App()->findChild<MainWindow *>();
+  ASSERT_NE(nullptr, mainWindow);
+
+  std::string dir = "/tmp/gz-gui-plugin-list-test";
+  common::removeAll(dir);
+  ASSERT_TRUE(common::createDirectories(dir));
+
+  int changes{0};
+  QObject::connect(&app, &Application::PluginListChanged, [&changes]()
+  {
+    ++changes;
+  });
+
+  App()->AddPluginPath(dir);
+  EXPECT_EQ(1, changes);
+  auto list = mainWindow->PluginListModel();
+  EXPECT_FALSE(list.contains("Fake Camel Plugin 3D"));
+
+  // Cached
+  EXPECT_EQ(list, mainWindow->PluginListModel());
+
+  // Installing a plugin refreshes the list
+  { std::ofstream file(dir + "/libFakeCamelPlugin3D.so"); }
+  for (int i = 0; i < 100 && changes < 2; ++i)
+  {
+    std::this_thread::sleep_for(10ms);
+    QCoreApplication::processEvents();
+  }
+  EXPECT_LE(2, changes);
+  EXPECT_TRUE(mainWindow->PluginListModel().contains("Fake Camel Plugin 3D"));
+
+  common::removeAll(dir);
+}
+
 /////////////////////////////////////////////////
 TEST(WindowConfigTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(defaultValues))
 {
@@ -277,6 +377,36 @@ TEST(WindowConfigTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(mergeFromXML))
   EXPECT_TRUE(c.IsIgnoring("size"));
 }
 
+/////////////////////////////////////////////////
+TEST(WindowConfigTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(mergeFromElement))
+{
+  WindowConfig c;
+  EXPECT_FALSE(c.MergeFromXML(
+      static_cast<const tinyxml2::XMLElement *>(nullptr)));
+
+  // Repeated elements keep the first value, unknown ones are ignored
+  tinyxml2::XMLDocument doc;
+  doc.Parse(
+      "<window>"
+      "  <width>100</width>"
+      "  <width>200</width>"
+      "  <not_an_option>1</not_an_option>"
+      "  <default_exit_action>shutdown_server</default_exit_action>"
+      "  <ignore>position</ignore>"
+      "  <ignore>state</ignore>"
+      "  <menus><plugins><show>A</show><show>B</show></plugins></menus>"
+      "</window>");
+  EXPECT_TRUE(c.MergeFromXML(doc.FirstChildElement("window")));
+
+  EXPECT_EQ(100, c.width);
+  EXPECT_EQ(2u, c.ignoredProps.size());
+  EXPECT_TRUE(c.IsIgnoring("position"));
+  EXPECT_TRUE(c.IsIgnoring("state"));
+  ASSERT_EQ(2u, c.showPlugins.size());
+  EXPECT_EQ("A", c.showPlugins[0]);
+  EXPECT_EQ("B", c.showPlugins[1]);
+}
+
 /////////////////////////////////////////////////
 TEST(WindowConfigTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(MenusToString))
 {
@@ -771,3 +901,78 @@ TEST(MainWindowTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(ApplyConfig))
 
   delete mainWindow;
 }
+
+/// \brief Counts the events it's called for
+class EventCounter : public QObject
+{
+  // Documentation inherited
+  public: bool eventFilter(QObject *, QEvent *_event) override
+  {
+    this->types.push_back(_event->type());
+    return this->consume;
+  }
+
+  /// \brief Types of the events received, in order
+  public: std::vector<QEvent::Type> types;
+
+  /// \brief True to stop the events
+  public: bool consume{false};
+};
+
+/////////////////////////////////////////////////
+TEST(MainWindowTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(SubscribeEvent))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  auto mainWindow = new MainWindow;
+  ASSERT_NE(nullptr, mainWindow);
+
+  EventCounter render;
+  EventCounter scene;
+  mainWindow->SubscribeEvent(events::Render::kType, &render);
+  mainWindow->SubscribeEvent(events::Render::kType, &render);
+  mainWindow->SubscribeEvent(events::SceneChanged::kType, &scene);
+  EXPECT_EQ(1u, mainWindow->EventSubscriberCount(events::Render::kType));
+  EXPECT_EQ(1u,
+      mainWindow->EventSubscriberCount(events::SceneChanged::kType));
+
+  // Each subscriber only gets its types
+  events::Render renderEvent;
+  app.sendEvent(mainWindow, &renderEvent);
+  events::SceneChanged sceneEvent;
+  app.sendEvent(mainWindow, &sceneEvent);
+  ASSERT_EQ(1u, render.types.size());
+  EXPECT_EQ(events::Render::kType, render.types[0]);
+  ASSERT_EQ(1u, scene.types.size());
+  EXPECT_EQ(events::SceneChanged::kType, scene.types[0]);
+
+  // A subscriber which consumes the event stops it
+  EventCounter second;
+  mainWindow->SubscribeEvent(events::Render::kType, &second);
+  render.consume = true;
+  app.sendEvent(mainWindow, &renderEvent);
+  EXPECT_EQ(2u, render.types.size());
+  EXPECT_TRUE(second.types.empty());
+
+  render.consume = false;
+  mainWindow->UnsubscribeEvent(events::Render::kType, &render);
+  app.sendEvent(mainWindow, &renderEvent);
+  EXPECT_EQ(2u, render.types.size());
+  EXPECT_EQ(1u, second.types.size());
+
+  // Destroyed subscribers are removed
+  {
+    EventCounter temporary;
+    mainWindow->SubscribeEvent(events::Render::kType, &temporary);
+    EXPECT_EQ(2u, mainWindow->EventSubscriberCount(events::Render::kType));
+  }
+  EXPECT_EQ(1u, mainWindow->EventSubscriberCount(events::Render::kType));
+  app.sendEvent(mainWindow, &renderEvent);
+  EXPECT_EQ(2u, second.types.size());
+
+  mainWindow->UnsubscribeEvent(events::Render::kType, &second);
+  EXPECT_EQ(0u, mainWindow->EventSubscriberCount(events::Render::kType));
+
+  delete mainWindow;
+}
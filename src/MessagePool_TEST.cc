@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/msgs/stringmsg.pb.h>
+
+#include "gz/gui/MessagePool.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(MessagePoolTest, Recycle)
+{
+  MessagePool<msgs::StringMsg> pool(2u);
+  EXPECT_EQ(0u, pool.Allocated());
+  EXPECT_EQ(0u, pool.Available());
+
+  const msgs::StringMsg *first{nullptr};
+  {
+    auto msg = pool.Acquire();
+    ASSERT_NE(nullptr, msg);
+    msg->set_data("first");
+    first = msg.get();
+    EXPECT_EQ(1u, pool.Allocated());
+    EXPECT_EQ(0u, pool.Available());
+  }
+  EXPECT_EQ(1u, pool.Available());
+
+  // The released message is reused, with its content
+  auto msg = pool.Acquire();
+  EXPECT_EQ(first, msg.get());
+  EXPECT_EQ("first", msg->data());
+  EXPECT_EQ(1u, pool.Allocated());
+  EXPECT_EQ(0u, pool.Available());
+
+  // Messages beyond the capacity are deleted on release
+  {
+    auto a = pool.Acquire();
+    auto b = pool.Acquire();
+    EXPECT_EQ(3u, pool.Allocated());
+  }
+  msg.reset();
+  EXPECT_EQ(2u, pool.Available());
+  EXPECT_EQ(3u, pool.Allocated());
+}
+
+/////////////////////////////////////////////////
+TEST(MessagePoolTest, Parse)
+{
+  MessagePool<msgs::StringMsg> pool;
+
+  msgs::StringMsg src;
+  src.set_data(std::string(1000, 'a'));
+  std::string data;
+  ASSERT_TRUE(src.SerializeToString(&data));
+
+  const msgs::StringMsg *parsed{nullptr};
+  {
+    auto msg = pool.Parse(data.data(), data.size());
+    ASSERT_NE(nullptr, msg);
+    EXPECT_EQ(src.data(), msg->data());
+    parsed = msg.get();
+  }
+
+  // Parsing replaces the previous content of a recycled message
+  src.set_data("b");
+  ASSERT_TRUE(src.SerializeToString(&data));
+  auto msg = pool.Parse(data.data(), data.size());
+  ASSERT_NE(nullptr, msg);
+  EXPECT_EQ(parsed, msg.get());
+  EXPECT_EQ("b", msg->data());
+  EXPECT_EQ(1u, pool.Allocated());
+
+  // Invalid data
+  const char invalid[] = {'\xff', '\xff', '\xff'};
+  EXPECT_EQ(nullptr, pool.Parse(invalid, sizeof(invalid)));
+}
+
+/////////////////////////////////////////////////
+TEST(MessagePoolTest, Threads)
+{
+  MessagePool<msgs::StringMsg> pool(8u);
+
+  // Messages are acquired and released from several threads at once
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&pool]
+    {
+      for (int i = 0; i < 1000; ++i)
+      {
+        auto msg = pool.Acquire();
+        msg->set_data(std::to_string(i));
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_LE(pool.Allocated(), 4u);
+  EXPECT_EQ(pool.Allocated(), pool.Available());
+}
+
+/////////////////////////////////////////////////
+TEST(MessagePoolTest, OutlivePool)
+{
+  std::shared_ptr<msgs::StringMsg> msg;
+  {
+    MessagePool<msgs::StringMsg> pool;
+    msg = pool.Acquire();
+    msg->set_data("kept");
+  }
+
+  // Messages in use stay valid after the pool is destroyed
+  EXPECT_EQ("kept", msg->data());
+  msg.reset();
+}
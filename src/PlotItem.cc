@@ -0,0 +1,547 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <QMatrix4x4>
+#include <QPointF>
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+#include <QSGTransformNode>
+
+#include "gz/gui/PlotItem.hh"
+
+namespace
+{
+/// \brief Number of points per chunk, including the last point of the
+/// previous chunk which connects them.
+constexpr std::size_t kChunkSize{4096};
+
+/// \brief Each level of detail draws the minimum and maximum of this many
+/// more points than the previous one.
+constexpr std::size_t kLevelFactor{8};
+
+/// \brief Number of levels of detail, the last one has a single group.
+constexpr int kLevels{5};
+
+/// \brief Level of detail is lowered until there are at most this many
+/// points per pixel.
+constexpr double kPointsPerPixel{2.0};
+
+/// \brief Level of a chunk outside of the range, which has no vertices.
+constexpr int kHidden{-1};
+
+/// \brief Indices of the lowest and highest points of a group.
+struct PlotExtremes
+{
+  /// \brief Index of the lowest point
+  uint32_t min{0};
+
+  /// \brief Index of the highest point
+  uint32_t max{0};
+};
+
+/// \brief Points of a series uploaded to the same geometry.
+struct PlotChunk
+{
+  /// \brief Points, the first one being the last of the previous chunk
+  std::vector<QPointF> points;
+
+  /// \brief Min/max pyramid, like mipmaps: the extremes of the groups of
+  /// each level of detail above 0, starting at the second point. It's
+  /// updated as points are appended, so changing the level of detail
+  /// doesn't scan the points.
+  std::vector<std::vector<PlotExtremes>> pyramid;
+
+  /// \brief True if points were added since the geometry was uploaded
+  bool dirty{true};
+
+  /// \brief Level of detail of the uploaded geometry
+  int level{0};
+
+  /// \brief Geometry of the points, owned by the scene graph
+  QSGGeometryNode *node{nullptr};
+};
+
+/// \brief Line series of the plot.
+struct PlotSeries
+{
+  /// \brief Line color
+  QColor color;
+
+  /// \brief True if the color changed since the material was updated
+  bool colorDirty{true};
+
+  /// \brief X of the first point, subtracted from the vertices to keep
+  /// float precision for large x like timestamps
+  double origin{0.0};
+
+  /// \brief Chunks, oldest first
+  std::deque<PlotChunk> chunks;
+
+  /// \brief Number of points, not counting the points repeated at the
+  /// start of chunks
+  std::size_t count{0};
+
+  /// \brief Transform from the series' vertices to the item, owned by the
+  /// scene graph
+  QSGTransformNode *node{nullptr};
+};
+
+/// \brief Append a point to a chunk and update its pyramid.
+/// \param[in] _chunk Chunk to append to
+/// \param[in] _point Point to append
+void AppendPoint(PlotChunk &_chunk, const QPointF &_point)
+{
+  _chunk.points.push_back(_point);
+  auto index = static_cast<uint32_t>(_chunk.points.size() - 1);
+
+  // The first point belongs to the previous chunk's groups
+  if (index == 0)
+    return;
+
+  if (_chunk.pyramid.empty())
+    _chunk.pyramid.resize(kLevels - 1);
+
+  std::size_t groupSize{1};
+  for (auto &level : _chunk.pyramid)
+  {
+    groupSize *= kLevelFactor;
+    std::size_t group = (index - 1) / groupSize;
+    if (group == level.size())
+    {
+      level.push_back({index, index});
+      continue;
+    }
+
+    auto &extremes = level.back();
+    if (_point.y() < _chunk.points[extremes.min].y())
+      extremes.min = index;
+    if (_point.y() > _chunk.points[extremes.max].y())
+      extremes.max = index;
+  }
+}
+
+/// \brief Get whether any of a chunk is within a range of x.
+/// \param[in] _chunk Chunk to check
+/// \param[in] _xMin Smallest x
+/// \param[in] _xMax Largest x
+/// \return True if it has points in the range, or lines crossing it
+bool ChunkVisible(const PlotChunk &_chunk, double _xMin, double _xMax)
+{
+  return !_chunk.points.empty() && _chunk.points.front().x() <= _xMax &&
+      _chunk.points.back().x() >= _xMin;
+}
+
+/// \brief Get the level of detail to draw a chunk with.
+/// \param[in] _chunk Chunk to draw
+/// \param[in] _pixelsPerX Pixels per unit of x
+/// \return Level of detail, 0 to draw all points
+int ChunkLevel(const PlotChunk &_chunk, double _pixelsPerX)
+{
+  if (_chunk.points.size() < 2)
+    return 0;
+
+  double pixels = (_chunk.points.back().x() - _chunk.points.front().x()) *
+      _pixelsPerX;
+  double pointsPerPixel = _chunk.points.size() / std::max(pixels, 1.0);
+
+  int level{0};
+  double groupSize{1.0};
+  while (level + 1 < kLevels &&
+      pointsPerPixel / (groupSize * kLevelFactor) * 2.0 >= kPointsPerPixel)
+  {
+    groupSize *= kLevelFactor;
+    ++level;
+  }
+  return level;
+}
+
+/// \brief Upload the points of a chunk to a geometry.
+/// \param[in] _chunk Chunk to upload
+/// \param[in] _origin X subtracted from every point
+/// \param[in] _level Level of detail
+/// \param[out] _geometry Geometry, resized to the vertices
+void UploadChunk(const PlotChunk &_chunk, double _origin, int _level,
+    QSGGeometry &_geometry)
+{
+  const auto &points = _chunk.points;
+
+  // The first and last points are always kept, so chunks stay connected.
+  // The vertices are read from the pyramid, so their number depends on the
+  // level, not on the number of points.
+  std::vector<std::size_t> kept;
+  if (_level <= 0 || points.size() <= 2 ||
+      static_cast<std::size_t>(_level) > _chunk.pyramid.size())
+  {
+    kept.resize(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i)
+      kept[i] = i;
+  }
+  else
+  {
+    const auto &level = _chunk.pyramid[_level - 1];
+    kept.reserve(level.size() * 2 + 2);
+    kept.push_back(0);
+    for (const auto &extremes : level)
+    {
+      kept.push_back(std::min(extremes.min, extremes.max));
+      if (extremes.min != extremes.max)
+        kept.push_back(std::max(extremes.min, extremes.max));
+    }
+    if (kept.back() != points.size() - 1)
+      kept.push_back(points.size() - 1);
+  }
+
+  _geometry.allocate(static_cast<int>(kept.size()));
+  auto vertices = _geometry.vertexDataAsPoint2D();
+  for (std::size_t i = 0; i < kept.size(); ++i)
+  {
+    const auto &point = points[kept[i]];
+    vertices[i].set(static_cast<float>(point.x() - _origin),
+        static_cast<float>(point.y()));
+  }
+}
+}
+
+namespace gz
+{
+namespace gui
+{
+class PlotItemPrivate
+{
+  /// \brief Series by ID
+  public: std::map<QString, PlotSeries> series;
+
+  /// \brief Nodes of removed series and chunks, to be deleted on the
+  /// render thread
+  public: std::vector<QSGNode *> removedNodes;
+
+  /// \brief Smallest x shown
+  public: double xMin{0.0};
+
+  /// \brief Largest x shown
+  public: double xMax{1.0};
+
+  /// \brief Smallest y shown
+  public: double yMin{0.0};
+
+  /// \brief Largest y shown
+  public: double yMax{1.0};
+
+  /// \brief Number of points kept per series
+  public: int maxPoints{10000};
+};
+}
+}
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+PlotItem::PlotItem(QQuickItem *_parent)
+  : QQuickItem(_parent), dataPtr(std::make_unique<PlotItemPrivate>())
+{
+  this->setFlag(ItemHasContents, true);
+}
+
+/////////////////////////////////////////////////
+PlotItem::~PlotItem()
+{
+}
+
+/////////////////////////////////////////////////
+void PlotItem::addSeries(const QString &_id, const QColor &_color)
+{
+  auto &series = this->dataPtr->series[_id];
+  series.color = _color;
+  series.colorDirty = true;
+  this->update();
+}
+
+/////////////////////////////////////////////////
+void PlotItem::removeSeries(const QString &_id)
+{
+  auto it = this->dataPtr->series.find(_id);
+  if (it == this->dataPtr->series.end())
+    return;
+
+  // The chunks' nodes are children of the series' node
+  if (it->second.node)
+    this->dataPtr->removedNodes.push_back(it->second.node);
+  this->dataPtr->series.erase(it);
+  this->update();
+}
+
+/////////////////////////////////////////////////
+void PlotItem::appendPoints(const QString &_id, const QVariantList &_points)
+{
+  auto it = this->dataPtr->series.find(_id);
+  if (it == this->dataPtr->series.end() || _points.empty())
+    return;
+
+  auto &series = it->second;
+  if (series.count == 0)
+    series.origin = _points.front().toPointF().x();
+
+  for (const auto &variant : _points)
+  {
+    if (series.chunks.empty())
+    {
+      series.chunks.emplace_back();
+      series.chunks.back().points.reserve(kChunkSize);
+    }
+    else if (series.chunks.back().points.size() >= kChunkSize)
+    {
+      // Start with the last point of the previous chunk, to connect them
+      QPointF last = series.chunks.back().points.back();
+      series.chunks.emplace_back();
+      series.chunks.back().points.reserve(kChunkSize);
+      AppendPoint(series.chunks.back(), last);
+    }
+    AppendPoint(series.chunks.back(), variant.toPointF());
+    series.chunks.back().dirty = true;
+    ++series.count;
+  }
+
+  // Remove the oldest chunks beyond the maximum number of points
+  auto maxPoints = static_cast<std::size_t>(
+      std::max(this->dataPtr->maxPoints, 0));
+  while (series.chunks.size() > 1 &&
+      series.count - series.chunks.front().points.size() >= maxPoints)
+  {
+    series.count -= series.chunks.front().points.size();
+    if (series.chunks.front().node)
+      this->dataPtr->removedNodes.push_back(series.chunks.front().node);
+    series.chunks.pop_front();
+
+    // Its first point is now only in this chunk
+    ++series.count;
+  }
+
+  this->update();
+}
+
+/////////////////////////////////////////////////
+int PlotItem::pointCount(const QString &_id) const
+{
+  auto it = this->dataPtr->series.find(_id);
+  if (it == this->dataPtr->series.end())
+    return 0;
+  return static_cast<int>(it->second.count);
+}
+
+/////////////////////////////////////////////////
+double PlotItem::XMin() const
+{
+  return this->dataPtr->xMin;
+}
+
+/////////////////////////////////////////////////
+void PlotItem::SetXMin(double _value)
+{
+  if (this->dataPtr->xMin == _value)
+    return;
+  this->dataPtr->xMin = _value;
+  this->RangeChanged();
+  this->update();
+}
+
+/////////////////////////////////////////////////
+double PlotItem::XMax() const
+{
+  return this->dataPtr->xMax;
+}
+
+/////////////////////////////////////////////////
+void PlotItem::SetXMax(double _value)
+{
+  if (this->dataPtr->xMax == _value)
+    return;
+  this->dataPtr->xMax = _value;
+  this->RangeChanged();
+  this->update();
+}
+
+/////////////////////////////////////////////////
+double PlotItem::YMin() const
+{
+  return this->dataPtr->yMin;
+}
+
+/////////////////////////////////////////////////
+void PlotItem::SetYMin(double _value)
+{
+  if (this->dataPtr->yMin == _value)
+    return;
+  this->dataPtr->yMin = _value;
+  this->RangeChanged();
+  this->update();
+}
+
+/////////////////////////////////////////////////
+double PlotItem::YMax() const
+{
+  return this->dataPtr->yMax;
+}
+
+/////////////////////////////////////////////////
+void PlotItem::SetYMax(double _value)
+{
+  if (this->dataPtr->yMax == _value)
+    return;
+  this->dataPtr->yMax = _value;
+  this->RangeChanged();
+  this->update();
+}
+
+/////////////////////////////////////////////////
+int PlotItem::MaxPoints() const
+{
+  return this->dataPtr->maxPoints;
+}
+
+/////////////////////////////////////////////////
+void PlotItem::SetMaxPoints(int _maxPoints)
+{
+  if (this->dataPtr->maxPoints == _maxPoints)
+    return;
+  this->dataPtr->maxPoints = _maxPoints;
+  this->MaxPointsChanged();
+}
+
+/////////////////////////////////////////////////
+QSGNode *PlotItem::updatePaintNode(QSGNode *_oldNode,
+    QQuickItem::UpdatePaintNodeData * /*_data*/)
+{
+  // The GUI thread is blocked while this runs, so the series can be read
+  // without locking
+  auto root = _oldNode;
+  if (!root)
+  {
+    // The previous nodes, if any, were deleted with the previous root
+    root = new QSGNode();
+    this->dataPtr->removedNodes.clear();
+    for (auto &seriesIt : this->dataPtr->series)
+    {
+      seriesIt.second.node = nullptr;
+      seriesIt.second.colorDirty = true;
+      for (auto &chunk : seriesIt.second.chunks)
+      {
+        chunk.node = nullptr;
+        chunk.dirty = true;
+      }
+    }
+  }
+
+  // Deleting a node also deletes its children
+  for (auto node : this->dataPtr->removedNodes)
+  {
+    if (node->parent())
+      node->parent()->removeChildNode(node);
+    delete node;
+  }
+  this->dataPtr->removedNodes.clear();
+
+  double rangeX = this->dataPtr->xMax - this->dataPtr->xMin;
+  double rangeY = this->dataPtr->yMax - this->dataPtr->yMin;
+  if (rangeX <= 0.0 || rangeY <= 0.0 || this->width() <= 0.0 ||
+      this->height() <= 0.0)
+  {
+    return root;
+  }
+  double pixelsPerX = this->width() / rangeX;
+  double pixelsPerY = this->height() / rangeY;
+
+  for (auto &seriesIt : this->dataPtr->series)
+  {
+    auto &series = seriesIt.second;
+    if (!series.node)
+    {
+      series.node = new QSGTransformNode();
+      root->appendChildNode(series.node);
+    }
+
+    // Scroll and zoom by transforming the vertices, never rewriting them
+    QMatrix4x4 matrix;
+    matrix.translate(0.0f, static_cast<float>(this->height()));
+    matrix.scale(static_cast<float>(pixelsPerX),
+        static_cast<float>(-pixelsPerY));
+    matrix.translate(
+        static_cast<float>(series.origin - this->dataPtr->xMin),
+        static_cast<float>(-this->dataPtr->yMin));
+    series.node->setMatrix(matrix);
+
+    for (auto &chunk : series.chunks)
+    {
+      // Chunks outside of the range have no vertices, so the vertices
+      // drawn depend on the range and the width, not on the history
+      int level = ChunkVisible(chunk, this->dataPtr->xMin,
+          this->dataPtr->xMax) ? ChunkLevel(chunk, pixelsPerX) : kHidden;
+      if (!chunk.node)
+      {
+        chunk.node = new QSGGeometryNode();
+        auto geometry = new QSGGeometry(
+            QSGGeometry::defaultAttributes_Point2D(), 0);
+        geometry->setDrawingMode(QSGGeometry::DrawLineStrip);
+        geometry->setLineWidth(2.0f);
+        chunk.node->setGeometry(geometry);
+        chunk.node->setFlag(QSGNode::OwnsGeometry);
+        chunk.node->setMaterial(new QSGFlatColorMaterial());
+        chunk.node->setFlag(QSGNode::OwnsMaterial);
+        series.node->appendChildNode(chunk.node);
+        chunk.dirty = true;
+        static_cast<QSGFlatColorMaterial *>(chunk.node->material())->
+            setColor(series.color);
+      }
+      else if (series.colorDirty)
+      {
+        static_cast<QSGFlatColorMaterial *>(chunk.node->material())->
+            setColor(series.color);
+        chunk.node->markDirty(QSGNode::DirtyMaterial);
+      }
+
+      // Only new points, or a new level of detail, are uploaded
+      if (level == kHidden)
+      {
+        if (chunk.level != kHidden)
+        {
+          chunk.node->geometry()->allocate(0);
+          chunk.node->markDirty(QSGNode::DirtyGeometry);
+          chunk.level = kHidden;
+        }
+      }
+      else if (chunk.dirty || chunk.level != level)
+      {
+        UploadChunk(chunk, series.origin, level, *chunk.node->geometry());
+        chunk.node->markDirty(QSGNode::DirtyGeometry);
+        chunk.dirty = false;
+        chunk.level = level;
+      }
+    }
+    series.colorDirty = false;
+  }
+
+  return root;
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <gz/common/Console.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/PlotItem.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./PlotItem_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+QVariantList Points(int _first, int _count)
+{
+  QVariantList points;
+  for (int i = _first; i < _first + _count; ++i)
+    points.push_back(QPointF(i, i % 7));
+  return points;
+}
+
+/////////////////////////////////////////////////
+TEST(PlotItemTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Range))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  PlotItem plot;
+  EXPECT_TRUE(plot.flags() & QQuickItem::ItemHasContents);
+
+  int rangeChanged{0};
+  QObject::connect(&plot, &PlotItem::RangeChanged,
+      [&rangeChanged](){++rangeChanged;});
+
+  plot.SetXMin(-2.0);
+  plot.SetXMax(3.0);
+  plot.SetYMin(-4.0);
+  plot.SetYMax(5.0);
+  EXPECT_DOUBLE_EQ(-2.0, plot.XMin());
+  EXPECT_DOUBLE_EQ(3.0, plot.XMax());
+  EXPECT_DOUBLE_EQ(-4.0, plot.YMin());
+  EXPECT_DOUBLE_EQ(5.0, plot.YMax());
+  EXPECT_EQ(4, rangeChanged);
+
+  // Same value
+  plot.SetXMin(-2.0);
+  EXPECT_EQ(4, rangeChanged);
+}
+
+/////////////////////////////////////////////////
+TEST(PlotItemTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Series))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  PlotItem plot;
+
+  // Points of unknown series are ignored
+  plot.appendPoints("a", Points(0, 10));
+  EXPECT_EQ(0, plot.pointCount("a"));
+
+  plot.addSeries("a", Qt::red);
+  plot.addSeries("b", Qt::blue);
+  plot.appendPoints("a", Points(0, 10));
+  plot.appendPoints("a", Points(10, 5));
+  plot.appendPoints("b", Points(0, 3));
+  EXPECT_EQ(15, plot.pointCount("a"));
+  EXPECT_EQ(3, plot.pointCount("b"));
+
+  // Changing the color keeps the points
+  plot.addSeries("a", Qt::green);
+  EXPECT_EQ(15, plot.pointCount("a"));
+
+  plot.removeSeries("a");
+  EXPECT_EQ(0, plot.pointCount("a"));
+  EXPECT_EQ(3, plot.pointCount("b"));
+
+  // Removing twice is fine
+  plot.removeSeries("a");
+}
+
+/////////////////////////////////////////////////
+TEST(PlotItemTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(MaxPoints))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  PlotItem plot;
+  plot.SetMaxPoints(5000);
+  EXPECT_EQ(5000, plot.MaxPoints());
+
+  plot.addSeries("a", Qt::red);
+  plot.appendPoints("a", Points(0, 4000));
+  EXPECT_EQ(4000, plot.pointCount("a"));
+
+  // Points are removed a chunk at a time, so there may be more than the
+  // maximum, but never fewer
+  for (int i = 0; i < 10; ++i)
+    plot.appendPoints("a", Points(4000 + i * 1000, 1000));
+  EXPECT_GE(plot.pointCount("a"), 5000);
+  EXPECT_LT(plot.pointCount("a"), 14000);
+}
+
+/////////////////////////////////////////////////
+TEST(PlotItemTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(LongHistory))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  PlotItem plot;
+  plot.SetMaxPoints(1000000);
+  plot.addSeries("a", Qt::red);
+
+  // Appended in batches like the plotting interface does
+  for (int i = 0; i < 100; ++i)
+    plot.appendPoints("a", Points(i * 5000, 5000));
+  EXPECT_EQ(500000, plot.pointCount("a"));
+
+  // Zooming in and out of the whole history keeps the points
+  plot.SetXMin(0.0);
+  plot.SetXMax(500000.0);
+  plot.SetXMin(250000.0);
+  plot.SetXMax(250010.0);
+  EXPECT_EQ(500000, plot.pointCount("a"));
+}
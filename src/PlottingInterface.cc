@@ -15,7 +15,27 @@
  *
 */
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
 #include <sstream>
+#include <utility>
+#include <vector>
+
+#include <QPointF>
+#include <google/protobuf/message.h>
+#include <gz/msgs/double.pb.h>
+#include <gz/msgs/float.pb.h>
+#include <gz/msgs/int32.pb.h>
+#include <gz/msgs/pose.pb.h>
+#include <gz/msgs/twist.pb.h>
+#include <gz/msgs/vector3d.pb.h>
+#include <gz/msgs/world_stats.pb.h>
 #include <gz/common/Console.hh>
 #include <gz/common/StringUtils.hh>
 #include <gz/transport/Node.hh>
@@ -24,10 +44,148 @@
 
 #include "gz/gui/PlottingInterface.hh"
 #include "gz/gui/Application.hh"
+#include "gz/gui/DerivedSignal.hh"
+#include "gz/gui/PlotItem.hh"
+#include "gz/gui/Profiler.hh"
+#include "gz/gui/WorkerPool.hh"
 
 #define DEFAULT_TIME (INT_MIN)
-// 1/60 Period like the GuiSystem frequency (60Hz)
-#define MAX_PERIOD_DIFF (0.0166666667)
+// Period of the plot updates in ms, like the GuiSystem frequency (60Hz)
+#define FLUSH_PERIOD (16)
+// Number of min/max pairs kept per series at each plot update. At 60Hz a
+// chart showing 10 s across 600 px draws one or two updates per pixel.
+#define FLUSH_BUCKETS (2)
+// Default number of samples recorded per field, 100 s at 1 kHz
+#define DEFAULT_HISTORY_SIZE (100000)
+// Number of samples copied out of a history at a time while exporting it
+#define EXPORT_CHUNK_SIZE (4096)
+// Number of min/max pairs a spectrum is reduced to, about a chart's width
+#define SPECTRUM_BUCKETS (512)
+
+namespace
+{
+/// \brief Reduce samples to the minimum and maximum of each of a number
+/// of buckets, keeping their order, so that peaks are still drawn.
+/// \param[in] _samples Samples in time order
+/// \param[in] _buckets Number of buckets
+/// \return Points to plot, as QPointF
+QVariantList Decimate(const std::vector<QPointF> &_samples,
+                      std::size_t _buckets)
+{
+  QVariantList points;
+  if (_samples.size() <= 2 * _buckets)
+  {
+    for (const auto &sample : _samples)
+      points.push_back(sample);
+    return points;
+  }
+
+  std::size_t bucketSize = (_samples.size() + _buckets - 1) / _buckets;
+  for (std::size_t start = 0; start < _samples.size(); start += bucketSize)
+  {
+    std::size_t end = std::min(start + bucketSize, _samples.size());
+    std::size_t minIdx = start;
+    std::size_t maxIdx = start;
+    for (std::size_t i = start + 1; i < end; ++i)
+    {
+      if (_samples[i].y() < _samples[minIdx].y())
+        minIdx = i;
+      if (_samples[i].y() > _samples[maxIdx].y())
+        maxIdx = i;
+    }
+    points.push_back(_samples[std::min(minIdx, maxIdx)]);
+    if (minIdx != maxIdx)
+      points.push_back(_samples[std::max(minIdx, maxIdx)]);
+  }
+  return points;
+}
+
+/// \brief Reads a field of a message of a known type without reflection
+using Extractor = double (*)(const google::protobuf::Message &);
+
+/// \brief Get the extractor of a field path for common plotted message
+/// types. Only valid for messages of the generated class, not for
+/// dynamic messages of the same type.
+/// \param[in] _descriptor Message type
+/// \param[in] _fieldPath Field names separated by '-'
+/// \return Extractor, null if the field isn't known
+Extractor TypedExtractor(const google::protobuf::Descriptor *_descriptor,
+                         const std::string &_fieldPath)
+{
+  using google::protobuf::Message;
+  using Key = std::pair<const google::protobuf::Descriptor *, std::string>;
+  static const std::map<Key, Extractor> extractors{
+    {{gz::msgs::Double::descriptor(), "data"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Double &>(_msg).data();}},
+    {{gz::msgs::Float::descriptor(), "data"}, [](const Message &_msg)
+      {return static_cast<double>(
+          static_cast<const gz::msgs::Float &>(_msg).data());}},
+    {{gz::msgs::Int32::descriptor(), "data"}, [](const Message &_msg)
+      {return static_cast<double>(
+          static_cast<const gz::msgs::Int32 &>(_msg).data());}},
+
+    {{gz::msgs::Vector3d::descriptor(), "x"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Vector3d &>(_msg).x();}},
+    {{gz::msgs::Vector3d::descriptor(), "y"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Vector3d &>(_msg).y();}},
+    {{gz::msgs::Vector3d::descriptor(), "z"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Vector3d &>(_msg).z();}},
+
+    {{gz::msgs::Pose::descriptor(), "position-x"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Pose &>(_msg).position().x();}},
+    {{gz::msgs::Pose::descriptor(), "position-y"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Pose &>(_msg).position().y();}},
+    {{gz::msgs::Pose::descriptor(), "position-z"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Pose &>(_msg).position().z();}},
+    {{gz::msgs::Pose::descriptor(), "orientation-x"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Pose &>(_msg).orientation().x();}},
+    {{gz::msgs::Pose::descriptor(), "orientation-y"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Pose &>(_msg).orientation().y();}},
+    {{gz::msgs::Pose::descriptor(), "orientation-z"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Pose &>(_msg).orientation().z();}},
+    {{gz::msgs::Pose::descriptor(), "orientation-w"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Pose &>(_msg).orientation().w();}},
+
+    {{gz::msgs::Twist::descriptor(), "linear-x"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Twist &>(_msg).linear().x();}},
+    {{gz::msgs::Twist::descriptor(), "linear-y"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Twist &>(_msg).linear().y();}},
+    {{gz::msgs::Twist::descriptor(), "linear-z"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Twist &>(_msg).linear().z();}},
+    {{gz::msgs::Twist::descriptor(), "angular-x"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Twist &>(_msg).angular().x();}},
+    {{gz::msgs::Twist::descriptor(), "angular-y"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Twist &>(_msg).angular().y();}},
+    {{gz::msgs::Twist::descriptor(), "angular-z"}, [](const Message &_msg)
+      {return static_cast<const gz::msgs::Twist &>(_msg).angular().z();}},
+  };
+
+  auto it = extractors.find({_descriptor, _fieldPath});
+  return it == extractors.end() ? nullptr : it->second;
+}
+
+/// \brief Check if a field has one of the types read by
+/// TopicPrivate::FieldData.
+/// \param[in] _field Field to check
+/// \return True if the field can be plotted
+bool IsPlottable(const google::protobuf::FieldDescriptor *_field)
+{
+  using FieldDescriptor = google::protobuf::FieldDescriptor;
+  switch (_field->type())
+  {
+    case FieldDescriptor::Type::TYPE_DOUBLE:
+    case FieldDescriptor::Type::TYPE_FLOAT:
+    case FieldDescriptor::Type::TYPE_INT32:
+    case FieldDescriptor::Type::TYPE_INT64:
+    case FieldDescriptor::Type::TYPE_BOOL:
+    case FieldDescriptor::Type::TYPE_UINT32:
+    case FieldDescriptor::Type::TYPE_UINT64:
+      return true;
+    default:
+      return false;
+  }
+}
+}
 
 namespace gz
 {
@@ -46,6 +204,36 @@ class PlotDataPrivate
 };
 
 
+/// \brief Field path resolved for a message type, so that messages can
+/// be read without looking up fields by name.
+struct FieldAccessor
+{
+  /// \brief Plot data of the field, owned by the topic's fields
+  PlotData *data{nullptr};
+
+  /// \brief Field path ID, prefixed by the topic name, as sent to the plot
+  QString id;
+
+  /// \brief Fields to go through from the message to the value, the last
+  /// one being the plotted field. Empty if the path isn't valid for the
+  /// message type.
+  std::vector<const google::protobuf::FieldDescriptor *> path;
+
+  /// \brief Reads the field without reflection, null to read it through
+  /// the path
+  Extractor extractor{nullptr};
+
+  /// \brief Samples received since the last flush
+  std::vector<QPointF> samples;
+
+  /// \brief Every sample received, up to the topic's history size. Once
+  /// full, the oldest sample is at historyCount % history size.
+  std::vector<QPointF> history;
+
+  /// \brief Number of samples ever added to the history
+  uint64_t historyCount{0};
+};
+
 class TopicPrivate
 {
   /// \brief Check the plotable types and get data from reflection
@@ -55,26 +243,164 @@ class TopicPrivate
   public: double FieldData(const google::protobuf::Message &_msg,
                            const google::protobuf::FieldDescriptor *_field);
 
+  /// \brief Resolve the header and all field paths for the type of a
+  /// message.
+  /// \param[in] _msg Message of the new type
+  public: void Resolve(const google::protobuf::Message &_msg);
+
+  /// \brief Resolve a field path for the current message type.
+  /// \param[in] _fieldPath Field names separated by '-'
+  /// \param[out] _accessor Accessor whose path is set
+  public: void ResolvePath(const std::string &_fieldPath,
+                           FieldAccessor &_accessor) const;
+
+  /// \brief Read the value at the end of a resolved path.
+  /// \param[in] _msg Message to read from
+  /// \param[in] _path Resolved path, not empty
+  /// \return Plottable value as double
+  public: double PathData(const google::protobuf::Message &_msg,
+      const std::vector<const google::protobuf::FieldDescriptor *> &_path);
+
+  /// \brief Message type the paths are resolved for
+  public: const google::protobuf::Descriptor *descriptor{nullptr};
+
+  /// \brief True if messages are of the generated class of their type,
+  /// so that typed extractors can be used
+  public: bool generated{false};
+
+  /// \brief Header field of the message type, null if it has none
+  public: const google::protobuf::FieldDescriptor *headerField{nullptr};
+
+  /// \brief Stamp field of the header
+  public: const google::protobuf::FieldDescriptor *stampField{nullptr};
+
+  /// \brief Seconds field of the stamp
+  public: const google::protobuf::FieldDescriptor *secField{nullptr};
+
+  /// \brief Nanoseconds field of the stamp
+  public: const google::protobuf::FieldDescriptor *nsecField{nullptr};
+
+  /// \brief Resolved paths of the registered fields, by field path ID
+  public: std::map<std::string, FieldAccessor> accessors;
+
+  /// \brief Maximum number of samples recorded per field
+  public: std::size_t historySize{DEFAULT_HISTORY_SIZE};
+
   /// \brief Topic name
   public: std::string name;
 
   /// \brief Default Plotting time
   public: std::shared_ptr<double> plottingTime;
 
-  /// \brief Previous header time to limit the frequency of publishing
-  public: double lastHeaderTime = 0;
+  /// \brief Time of messages without a header, read at arrival. Null to
+  /// use the plotting time instead.
+  public: std::function<double()> plottingClock;
+
+  /// \brief Protects the accessors and their samples, which are written
+  /// by the transport thread and flushed by the GUI thread
+  public: std::mutex mutex;
 
   /// \brief Plotting fields to update its values
   public: std::map<std::string, gz::gui::PlotData*> fields;
 };
 
+/// \brief Subscribes once to each plotted topic for the whole process and
+/// passes every message to all the topic handlers plotting it, so several
+/// plotting plugins on the same topic share one subscription and messages
+/// are deserialized once.
+class PlottingHub
+{
+  /// \brief Get the hub of the process
+  /// \return The hub
+  public: static PlottingHub &Instance();
+
+  /// \brief Pass the messages of a topic to a handler, subscribing to the
+  /// topic if it's the first handler.
+  /// \param[in] _topic Topic name
+  /// \param[in] _handler Topic handler, must be removed before deleting it
+  public: void Add(const std::string &_topic, Topic *_handler);
+
+  /// \brief Stop passing messages to a handler, unsubscribing from the
+  /// topic if it was the last one. The handler isn't called anymore once
+  /// this returns.
+  /// \param[in] _topic Topic name
+  /// \param[in] _handler Topic handler
+  public: void Remove(const std::string &_topic, Topic *_handler);
+
+  /// \brief Get the number of handlers of a topic
+  /// \param[in] _topic Topic name
+  /// \return Number of handlers
+  public: int HandlerCount(const std::string &_topic);
+
+  /// \brief Pass a message to the handlers of its topic
+  /// \param[in] _topic Topic name
+  /// \param[in] _msg Message received
+  private: void OnMessage(const std::string &_topic,
+                          const google::protobuf::Message &_msg);
+
+  /// \brief Node subscribed to the topics
+  private: gz::transport::Node node;
+
+  /// \brief Serializes adding and removing handlers with subscribing and
+  /// unsubscribing, which isn't done under the handlers mutex so that
+  /// messages being passed don't block it
+  private: std::mutex subscriptionMutex;
+
+  /// \brief Protects the handlers, held while passing a message
+  private: std::mutex handlersMutex;
+
+  /// \brief Handlers by topic name
+  private: std::map<std::string, std::vector<Topic *>> handlers;
+};
+
 class TransportPrivate
 {
-  /// \brief Node for Commincation
+  /// \brief Node to list the topics, they're subscribed to by the hub
   public: gz::transport::Node node;
 
   /// \brief subscribed topics
   public: std::map<std::string, gz::gui::Topic*> topics;
+
+  /// \brief Number of samples recorded per field of new topics
+  public: std::size_t historySize{DEFAULT_HISTORY_SIZE};
+
+  /// \brief Clock of new topics
+  public: std::function<double()> plottingClock;
+};
+
+/// \brief Series computed from topic fields on a worker
+struct DerivedSeries
+{
+  /// \brief Chart plotting it
+  int chart{0};
+
+  /// \brief Series ID
+  QString id;
+
+  /// \brief Chart the inputs are registered with, negative so the
+  /// fields aren't plotted
+  int inputChart{-1};
+
+  /// \brief Topic and field path of each input
+  std::vector<std::pair<std::string, std::string>> inputs;
+
+  /// \brief Index of the next sample to copy from the history of each
+  /// input
+  std::vector<uint64_t> next;
+
+  /// \brief Computes the series, only used by the task while busy
+  DerivedSignal signal;
+
+  /// \brief Protects the members below, shared with the task
+  std::mutex mutex;
+
+  /// \brief True while a task computes the series, so there's one at a
+  /// time
+  bool busy{false};
+
+  /// \brief Points computed and not sent yet, reduced to the resolution
+  /// of the chart
+  QVariantList points;
 };
 
 class PlottingIfacePrivate
@@ -82,6 +408,14 @@ class PlottingIfacePrivate
   /// \brief Responsible for transport messages and topics
   public: Transport transport;
 
+  /// \brief Derived series, by chart and ID
+  public: std::map<std::pair<int, QString>, std::shared_ptr<DerivedSeries>>
+      derived;
+
+  /// \brief Chart the inputs of the next derived series are registered
+  /// with
+  public: int nextInputChart{-1};
+
   /// \brief Plotting time pointer to give access to topics to read it
   public: std::shared_ptr<double> plottingTimeRef = std::make_shared<double>();
 
@@ -90,6 +424,46 @@ class PlottingIfacePrivate
 
   /// \brief timer to update the plotting each time step
   public: QTimer timer;
+
+  /// \brief timer to send the buffered samples to the charts
+  public: QTimer flushTimer;
+
+  /// \brief World statistics topic, empty if not following sim time
+  public: std::string statsTopic;
+
+  /// \brief When the interface was created
+  public: std::chrono::steady_clock::time_point start{
+      std::chrono::steady_clock::now()};
+
+  /// \brief Protects the clock state below, which is written on the
+  /// transport thread and read by every topic
+  public: mutable std::mutex clockMutex;
+
+  /// \brief True once world statistics were received
+  public: bool hasSimTime{false};
+
+  /// \brief Sim time of the last statistics, in seconds
+  public: double simTime{0.0};
+
+  /// \brief When the last statistics were received
+  public: std::chrono::steady_clock::time_point simTimeStamp;
+
+  /// \brief Real time factor of the last statistics
+  public: double realTimeFactor{1.0};
+
+  /// \brief True if the simulation is paused
+  public: bool paused{false};
+
+  /// \brief Last time returned, so that it never decreases
+  public: mutable double lastTime{0.0};
+
+  /// \brief Callback of the world statistics
+  /// \param[in] _msg World statistics
+  public: void OnStats(const msgs::WorldStatistics &_msg);
+
+  /// \brief Node subscribed to the world statistics, destroyed first so
+  /// OnStats isn't called on a clock being destroyed
+  public: gz::transport::Node node;
 };
 
 }
@@ -98,6 +472,89 @@ class PlottingIfacePrivate
 using namespace gz;
 using namespace gui;
 
+//////////////////////////////////////////////////////
+PlottingHub &PlottingHub::Instance()
+{
+  static PlottingHub hub;
+  return hub;
+}
+
+//////////////////////////////////////////////////////
+void PlottingHub::Add(const std::string &_topic, Topic *_handler)
+{
+  std::lock_guard<std::mutex> subscriptionLock(this->subscriptionMutex);
+  bool first{false};
+  {
+    std::lock_guard<std::mutex> lock(this->handlersMutex);
+    auto &topicHandlers = this->handlers[_topic];
+    if (std::find(topicHandlers.begin(), topicHandlers.end(), _handler) !=
+        topicHandlers.end())
+    {
+      return;
+    }
+    first = topicHandlers.empty();
+    topicHandlers.push_back(_handler);
+  }
+
+  if (!first)
+    return;
+
+  std::function<void(const google::protobuf::Message &)> cb =
+      [this, _topic](const google::protobuf::Message &_msg)
+  {
+    this->OnMessage(_topic, _msg);
+  };
+  if (!this->node.Subscribe(_topic, cb))
+    gzerr << "Failed to subscribe to topic [" << _topic << "]" << std::endl;
+}
+
+//////////////////////////////////////////////////////
+void PlottingHub::Remove(const std::string &_topic, Topic *_handler)
+{
+  std::lock_guard<std::mutex> subscriptionLock(this->subscriptionMutex);
+  {
+    // Waits for the message being passed, if any
+    std::lock_guard<std::mutex> lock(this->handlersMutex);
+    auto it = this->handlers.find(_topic);
+    if (it == this->handlers.end())
+      return;
+
+    auto &topicHandlers = it->second;
+    topicHandlers.erase(
+        std::remove(topicHandlers.begin(), topicHandlers.end(), _handler),
+        topicHandlers.end());
+    if (!topicHandlers.empty())
+      return;
+    this->handlers.erase(it);
+  }
+
+  // Messages still arriving find no handlers
+  this->node.Unsubscribe(_topic);
+}
+
+//////////////////////////////////////////////////////
+int PlottingHub::HandlerCount(const std::string &_topic)
+{
+  std::lock_guard<std::mutex> lock(this->handlersMutex);
+  auto it = this->handlers.find(_topic);
+  if (it == this->handlers.end())
+    return 0;
+  return static_cast<int>(it->second.size());
+}
+
+//////////////////////////////////////////////////////
+void PlottingHub::OnMessage(const std::string &_topic,
+                            const google::protobuf::Message &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->handlersMutex);
+  auto it = this->handlers.find(_topic);
+  if (it == this->handlers.end())
+    return;
+
+  for (auto handler : it->second)
+    handler->Callback(_msg);
+}
+
 //////////////////////////////////////////////////////
 PlotData::PlotData() :
     dataPtr(std::make_unique<PlotDataPrivate>())
@@ -184,8 +641,21 @@ std::string &Topic::Name() const
 void Topic::Register(const std::string &_fieldPath, int _chart)
 {
   // if a new field create a new field and register the chart
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   if (this->dataPtr->fields.count(_fieldPath) == 0)
-    this->dataPtr->fields[_fieldPath] = new PlotData();
+  {
+    auto data = new PlotData();
+    this->dataPtr->fields[_fieldPath] = data;
+
+    // Resolved now if the message type is known, otherwise when the first
+    // message arrives
+    auto &accessor = this->dataPtr->accessors[_fieldPath];
+    accessor.data = data;
+    accessor.id = QString::fromStdString(
+        this->dataPtr->name + "-" + _fieldPath);
+    if (this->dataPtr->descriptor)
+      this->dataPtr->ResolvePath(_fieldPath, accessor);
+  }
 
   this->dataPtr->fields[_fieldPath]->AddChart(_chart);
 }
@@ -193,11 +663,15 @@ void Topic::Register(const std::string &_fieldPath, int _chart)
 //////////////////////////////////////////////////////
 void Topic::UnRegister(const std::string &_fieldPath, int _chart)
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->fields[_fieldPath]->RemoveChart(_chart);
 
   // if no one registers to the field, remove it
   if (!this->dataPtr->fields[_fieldPath]->ChartCount())
+  {
     this->dataPtr->fields.erase(_fieldPath);
+    this->dataPtr->accessors.erase(_fieldPath);
+  }
 }
 
 //////////////////////////////////////////////////////
@@ -215,94 +689,178 @@ std::map<std::string, PlotData*> &Topic::Fields()
 //////////////////////////////////////////////////////
 void Topic::Callback(const google::protobuf::Message &_msg)
 {
-  // check for header time
+  GZ_GUI_PROFILE_THREAD_NAME("Transport");
+  GZ_GUI_PROFILE("PlottingInterface::Callback");
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // check for header time, otherwise use the plotting time
   double headerTime;
-  if (!this->HasHeader(_msg, headerTime))
+  double x;
+  if (this->HasHeader(_msg, headerTime))
   {
-    if (!this->dataPtr->plottingTime)
-        return;
-
+    x = headerTime;
+  }
+  else if (this->dataPtr->plottingClock)
+  {
+    // Timestamped at arrival, so samples keep their spacing even if the
+    // GUI thread is busy
     headerTime = DEFAULT_TIME;
-
-    if (*this->dataPtr->plottingTime - this->dataPtr->lastHeaderTime
-          < MAX_PERIOD_DIFF)
-      return;
-
-    this->dataPtr->lastHeaderTime = *this->dataPtr->plottingTime;
+    x = this->dataPtr->plottingClock();
   }
   else
   {
-    if (headerTime - this->dataPtr->lastHeaderTime < MAX_PERIOD_DIFF)
+    if (!this->dataPtr->plottingTime)
         return;
 
-    this->dataPtr->lastHeaderTime = headerTime;
+    headerTime = DEFAULT_TIME;
+    x = *this->dataPtr->plottingTime;
   }
 
-  // loop over the registered fields and update them
-  for (auto fieldIt : this->dataPtr->fields)
+  // loop over the registered fields and update them, the paths were
+  // resolved by HasHeader if the message type changed
+  for (auto &accessorIt : this->dataPtr->accessors)
   {
-    auto msgDescriptor = _msg.GetDescriptor();
-    auto ref = _msg.GetReflection();
+    auto &accessor = accessorIt.second;
+    if (accessor.path.empty() || !accessor.data)
+      continue;
 
-    google::protobuf::Message *valueMsg = nullptr;
+    // Field Arrival Time
+    accessor.data->SetTime(headerTime);
 
-    auto fieldFullPath = gz::common::Split(fieldIt.first, '-');
-    int pathSize = fieldFullPath.size();
+    // Field Value
+    accessor.data->SetValue(accessor.extractor ?
+        accessor.extractor(_msg) :
+        this->dataPtr->PathData(_msg, accessor.path));
+
+    // Buffered until the next flush to the charts
+    QPointF sample(x, accessor.data->Value());
+    accessor.samples.push_back(sample);
+
+    // Recorded at full rate, overwriting the oldest once full
+    auto &history = accessor.history;
+    if (history.size() < this->dataPtr->historySize)
+      history.push_back(sample);
+    else if (!history.empty())
+      history[accessor.historyCount % history.size()] = sample;
+    ++accessor.historyCount;
+  }
+}
 
-    // loop until you reach the last field in the path
-    for (int i = 0; i < pathSize-1 ; i++)
-    {
-      std::string fieldName = fieldFullPath[i];
+//////////////////////////////////////////////////////
+void Topic::SetHistorySize(std::size_t _size)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->historySize = _size;
+  for (auto &accessorIt : this->dataPtr->accessors)
+  {
+    auto &accessor = accessorIt.second;
+    accessor.history.clear();
+    accessor.history.shrink_to_fit();
+    accessor.historyCount = 0;
+  }
+}
 
-      auto field = msgDescriptor->FindFieldByName(fieldName);
+//////////////////////////////////////////////////////
+bool Topic::WriteHistory(const std::string &_fieldPath,
+                         std::ostream &_out) const
+{
+  uint64_t next{0};
+  uint64_t end{0};
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto it = this->dataPtr->accessors.find(_fieldPath);
+    if (it == this->dataPtr->accessors.end())
+      return false;
 
-      msgDescriptor = field->message_type();
+    end = it->second.historyCount;
+    next = end - static_cast<uint64_t>(it->second.history.size());
+  }
 
-      if (valueMsg)
-      {
-        valueMsg = ref->MutableMessage
-                (const_cast<google::protobuf::Message *>(valueMsg), field);
-      }
-      else
-      {
-        valueMsg = ref->MutableMessage
-                (const_cast<google::protobuf::Message *>(&_msg), field);
-      }
+  // Copy a chunk at a time, so the callback is only blocked briefly.
+  // Samples overwritten meanwhile are skipped, samples received after the
+  // export started aren't written.
+  std::vector<QPointF> chunk;
+  chunk.reserve(EXPORT_CHUNK_SIZE);
+  while (next < end)
+  {
+    chunk.clear();
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      auto it = this->dataPtr->accessors.find(_fieldPath);
+      if (it == this->dataPtr->accessors.end())
+        return false;
 
-      if (valueMsg)
-        ref = valueMsg->GetReflection();
-      else
+      // Stop if the history was cleared meanwhile
+      const auto &history = it->second.history;
+      end = std::min(end, it->second.historyCount);
+      if (history.empty())
+        break;
+
+      next = std::max(next, it->second.historyCount -
+          static_cast<uint64_t>(history.size()));
+      while (next < end && chunk.size() < EXPORT_CHUNK_SIZE)
       {
-        gzwarn << "Invalid topic msg" << std::endl;
-        return;
+        chunk.push_back(history[next % history.size()]);
+        ++next;
       }
     }
 
-    std::string fieldName = fieldFullPath[pathSize-1];
-    double data;
+    for (const auto &sample : chunk)
+      _out << sample.x() << ", " << sample.y() << "\n";
+  }
+  return static_cast<bool>(_out);
+}
 
-    if (valueMsg)
+//////////////////////////////////////////////////////
+uint64_t Topic::CopyHistory(const std::string &_fieldPath, uint64_t _from,
+                            std::vector<QPointF> &_samples) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto it = this->dataPtr->accessors.find(_fieldPath);
+  if (it == this->dataPtr->accessors.end())
+    return _from;
+
+  // Start from the oldest sample, it's overwritten or the history was
+  // cleared
+  const auto &history = it->second.history;
+  uint64_t end = it->second.historyCount;
+  uint64_t oldest = end - static_cast<uint64_t>(history.size());
+  if (_from < oldest || _from > end)
+    _from = oldest;
+
+  _samples.reserve(_samples.size() + static_cast<std::size_t>(end - _from));
+  for (uint64_t i = _from; i < end; ++i)
+    _samples.push_back(history[i % history.size()]);
+  return end;
+}
+
+//////////////////////////////////////////////////////
+void Topic::Flush()
+{
+  // Take the samples, so the callback isn't blocked while they're sent
+  std::vector<std::pair<FieldAccessor *, std::vector<QPointF>>> series;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    for (auto &accessorIt : this->dataPtr->accessors)
     {
-      auto field = valueMsg->GetDescriptor()->FindFieldByName(fieldName);
-      data = this->dataPtr->FieldData(*valueMsg, field);
+      auto &accessor = accessorIt.second;
+      if (accessor.samples.empty())
+        continue;
+      series.emplace_back(&accessor, std::vector<QPointF>());
+      series.back().second.swap(accessor.samples);
     }
-    else
+  }
+
+  // Registered fields are only removed on this thread, so the accessors
+  // are still valid
+  for (auto &serie : series)
+  {
+    auto points = Decimate(serie.second, FLUSH_BUCKETS);
+    for (auto const &chart : serie.first->data->Charts())
     {
-      auto field = msgDescriptor->FindFieldByName(fieldName);
-      data = this->dataPtr->FieldData(_msg, field);
+      if (chart >= 0)
+        emit plotPoints(chart, serie.first->id, points);
     }
-
-    if (!fieldIt.second)
-      continue;
-
-    // Field Arrival Time
-    fieldIt.second->SetTime(headerTime);
-
-    // Field Value
-    fieldIt.second->SetValue(data);
-
-    // Update Field Charts UI
-    this->UpdateGui(fieldIt.first);
   }
 }
 
@@ -310,37 +868,23 @@ void Topic::Callback(const google::protobuf::Message &_msg)
 bool Topic::HasHeader(const google::protobuf::Message &_msg,
                       double &_headerTime)
 {
-  auto ref = _msg.GetReflection();
-  auto header = _msg.GetDescriptor()->FindFieldByName("header");
-  auto found = ref->HasField(_msg, header);
-
-  if (!found)
-    return false;
-
-  auto stamp = header->message_type()->FindFieldByName("stamp");
-
-  if (!stamp)
-    return false;
-
-  auto headerMsg = ref->MutableMessage
-          (const_cast<google::protobuf::Message *>(&_msg), header);
+  if (_msg.GetDescriptor() != this->dataPtr->descriptor)
+    this->dataPtr->Resolve(_msg);
 
-  if (!headerMsg)
+  if (!this->dataPtr->nsecField)
     return false;
 
-  ref = headerMsg->GetReflection();
-
-  auto stampMsg = ref->MutableMessage
-          (const_cast<google::protobuf::Message *>(headerMsg), stamp);
-
-  if (!stampMsg)
+  auto ref = _msg.GetReflection();
+  if (!ref->HasField(_msg, this->dataPtr->headerField))
     return false;
 
-  auto secField = stamp->message_type()->FindFieldByName("sec");
-  auto nsecField = stamp->message_type()->FindFieldByName("nsec");
+  const auto &headerMsg =
+      ref->GetMessage(_msg, this->dataPtr->headerField);
+  const auto &stampMsg = headerMsg.GetReflection()->GetMessage(
+      headerMsg, this->dataPtr->stampField);
 
-  auto sec = this->dataPtr->FieldData(*stampMsg, secField);
-  auto nsec = this->dataPtr->FieldData(*stampMsg, nsecField);
+  auto sec = this->dataPtr->FieldData(stampMsg, this->dataPtr->secField);
+  auto nsec = this->dataPtr->FieldData(stampMsg, this->dataPtr->nsecField);
 
   _headerTime = sec + nsec * std::pow(10, -9);
 
@@ -371,6 +915,98 @@ void Topic::SetPlottingTimeRef(const std::shared_ptr<double> &_timeRef)
     this->dataPtr->plottingTime = _timeRef;
 }
 
+//////////////////////////////////////////////////////
+void Topic::SetPlottingClock(const std::function<double()> &_clock)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->plottingClock = _clock;
+}
+
+//////////////////////////////////////////////////////
+void TopicPrivate::Resolve(const google::protobuf::Message &_msg)
+{
+  auto msgDescriptor = _msg.GetDescriptor();
+  this->descriptor = msgDescriptor;
+
+  // Messages of types unknown at build time are dynamic messages, which
+  // can't be cast to a generated class even if the type has the same name
+  auto prototype = google::protobuf::MessageFactory::generated_factory()->
+      GetPrototype(msgDescriptor);
+  this->generated = prototype &&
+      prototype->GetReflection() == _msg.GetReflection();
+
+  this->headerField = msgDescriptor->FindFieldByName("header");
+  this->stampField = nullptr;
+  this->secField = nullptr;
+  this->nsecField = nullptr;
+  if (this->headerField && this->headerField->message_type() &&
+      !this->headerField->is_repeated())
+  {
+    this->stampField =
+        this->headerField->message_type()->FindFieldByName("stamp");
+  }
+  if (this->stampField && this->stampField->message_type() &&
+      !this->stampField->is_repeated())
+  {
+    this->secField =
+        this->stampField->message_type()->FindFieldByName("sec");
+    this->nsecField =
+        this->stampField->message_type()->FindFieldByName("nsec");
+  }
+  if (!this->secField)
+    this->nsecField = nullptr;
+
+  for (auto &accessor : this->accessors)
+    this->ResolvePath(accessor.first, accessor.second);
+}
+
+//////////////////////////////////////////////////////
+void TopicPrivate::ResolvePath(const std::string &_fieldPath,
+                               FieldAccessor &_accessor) const
+{
+  _accessor.path.clear();
+  _accessor.extractor = nullptr;
+  auto msgDescriptor = this->descriptor;
+  for (const auto &fieldName : gz::common::Split(_fieldPath, '-'))
+  {
+    auto field = msgDescriptor ?
+        msgDescriptor->FindFieldByName(fieldName) : nullptr;
+    if (!field || field->is_repeated())
+    {
+      gzwarn << "Can't plot field [" << _fieldPath << "] of message ["
+             << this->descriptor->full_name() << "]" << std::endl;
+      _accessor.path.clear();
+      return;
+    }
+    _accessor.path.push_back(field);
+    msgDescriptor = field->message_type();
+  }
+
+  if (!_accessor.path.empty() && !IsPlottable(_accessor.path.back()))
+  {
+    gzwarn << "Field [" << _fieldPath << "] of message ["
+           << this->descriptor->full_name() << "] isn't a plottable type"
+           << std::endl;
+    _accessor.path.clear();
+  }
+  else if (!_accessor.path.empty() && this->generated)
+  {
+    _accessor.extractor = TypedExtractor(this->descriptor, _fieldPath);
+  }
+}
+
+//////////////////////////////////////////////////////
+double TopicPrivate::PathData(const google::protobuf::Message &_msg,
+    const std::vector<const google::protobuf::FieldDescriptor *> &_path)
+{
+  // Unset messages read as their default instance, without being created
+  const google::protobuf::Message *valueMsg = &_msg;
+  for (std::size_t i = 0; i + 1 < _path.size(); ++i)
+    valueMsg = &valueMsg->GetReflection()->GetMessage(*valueMsg, _path[i]);
+
+  return this->FieldData(*valueMsg, _path.back());
+}
+
 //////////////////////////////////////////////////////
 double TopicPrivate::FieldData(const google::protobuf::Message &_msg,
                                const google::protobuf::FieldDescriptor *_field)
@@ -408,9 +1044,12 @@ Transport::Transport() : dataPtr(std::make_unique<TransportPrivate>())
 ////////////////////////////////////////////
 Transport::~Transport()
 {
-  // unsubscribe from all topics in the transport
+  // stop receiving the messages of all topics in the transport
   for (auto topic : this->dataPtr->topics)
-    this->dataPtr->node.Unsubscribe(topic.first);
+  {
+    PlottingHub::Instance().Remove(topic.first, topic.second);
+    delete topic.second;
+  }
 }
 
 ////////////////////////////////////////////
@@ -425,7 +1064,8 @@ void Transport::Unsubscribe(const std::string &_topic,
     // if there is no registered fields, unsubscribe from the topic
     if (this->dataPtr->topics[_topic]->FieldCount() == 0)
     {
-      this->dataPtr->node.Unsubscribe(_topic);
+      PlottingHub::Instance().Remove(_topic, this->dataPtr->topics[_topic]);
+      delete this->dataPtr->topics[_topic];
       this->dataPtr->topics.erase(_topic);
     }
   }
@@ -441,30 +1081,63 @@ void Transport::Subscribe(const std::string &_topic,
   {
     auto topicHandler = new Topic(_topic);
     this->dataPtr->topics[_topic] = topicHandler;
+    if (this->dataPtr->historySize != DEFAULT_HISTORY_SIZE)
+      topicHandler->SetHistorySize(this->dataPtr->historySize);
 
     topicHandler->Register(_fieldPath, _chart);
-    this->dataPtr->node.Subscribe(_topic, &Topic::Callback, topicHandler);
-
     topicHandler->SetPlottingTimeRef(_time);
+    if (this->dataPtr->plottingClock)
+      topicHandler->SetPlottingClock(this->dataPtr->plottingClock);
+    PlottingHub::Instance().Add(_topic, topicHandler);
 
     connect(topicHandler, SIGNAL(plot(int, QString, double, double)),
             this, SLOT(onPlot(int, QString, double, double)));
+    connect(topicHandler, SIGNAL(plotPoints(int, QString, QVariantList)),
+            this, SIGNAL(plotPoints(int, QString, QVariantList)));
   }
   // already exist topic
   else
   {
     this->dataPtr->topics[_topic]->Register(_fieldPath, _chart);
-    this->dataPtr->node.Subscribe(_topic, &Topic::Callback,
-                                  this->dataPtr->topics[_topic]);
   }
 }
 
+//////////////////////////////////////////////////////
+int Transport::SubscriberCount(const std::string &_topic)
+{
+  return PlottingHub::Instance().HandlerCount(_topic);
+}
+
 //////////////////////////////////////////////////////
 const std::map<std::string, Topic*> &Transport::Topics()
 {
   return this->dataPtr->topics;
 }
 
+//////////////////////////////////////////////////////
+void Transport::SetPlottingClock(const std::function<double()> &_clock)
+{
+  this->dataPtr->plottingClock = _clock;
+  for (auto &topic : this->dataPtr->topics)
+    topic.second->SetPlottingClock(_clock);
+}
+
+//////////////////////////////////////////////////////
+void Transport::Flush()
+{
+  GZ_GUI_PROFILE("PlottingInterface::Flush");
+  for (auto &topic : this->dataPtr->topics)
+    topic.second->Flush();
+}
+
+//////////////////////////////////////////////////////
+void Transport::SetHistorySize(std::size_t _size)
+{
+  this->dataPtr->historySize = _size;
+  for (auto &topic : this->dataPtr->topics)
+    topic.second->SetHistorySize(_size);
+}
+
 //////////////////////////////////////////////////////
 void Transport::onPlot(int _chart, QString _fieldID, double _x, double _y)
 {
@@ -483,7 +1156,7 @@ void Transport::UnsubscribeOutdatedTopics()
     // check if the topic exist
     if (std::find(topics.begin(), topics.end(), topic.first) == topics.end())
     {
-      this->dataPtr->node.Unsubscribe(topic.first);
+      PlottingHub::Instance().Remove(topic.first, topic.second);
       delete topic.second;
       this->dataPtr->topics.erase(topic.first);
     }
@@ -497,16 +1170,29 @@ PlottingInterface::PlottingInterface() : QObject(),
   connect(&this->dataPtr->transport,
           SIGNAL(plot(int, QString, double, double)), this,
           SLOT(onPlot(int, QString, double, double)));
+  connect(&this->dataPtr->transport,
+          SIGNAL(plotPoints(int, QString, QVariantList)), this,
+          SIGNAL(plotPoints(int, QString, QVariantList)));
+
+  this->dataPtr->transport.SetPlottingClock([this]()
+  {
+    return this->Time();
+  });
 
   this->dataPtr->timeout = 1;
   this->InitTimer();
 
+  qmlRegisterType<PlotItem>("GzPlot", 1, 0, "PlotItem");
   App()->Engine()->rootContext()->setContextProperty("PlottingIface", this);
 }
 
 //////////////////////////////////////////////////////
 PlottingInterface::~PlottingInterface()
 {
+  WorkerPool::Cancel(this->dataPtr.get());
+
+  // Messages still being received mustn't read the clock being destroyed
+  this->dataPtr->transport.SetPlottingClock(nullptr);
 }
 
 //////////////////////////////////////////////////////
@@ -572,6 +1258,13 @@ void PlottingInterface::InitTimer()
   this->dataPtr->timer.setInterval(this->dataPtr->timeout);
   connect(&this->dataPtr->timer, SIGNAL(timeout()), this, SLOT(UpdateTime()));
   this->dataPtr->timer.start();
+
+  this->dataPtr->flushTimer.setInterval(FLUSH_PERIOD);
+  connect(&this->dataPtr->flushTimer, SIGNAL(timeout()),
+          &this->dataPtr->transport, SLOT(Flush()));
+  connect(&this->dataPtr->flushTimer, SIGNAL(timeout()),
+          this, SLOT(UpdateDerived()));
+  this->dataPtr->flushTimer.start();
 }
 
 //////////////////////////////////////////////////////
@@ -579,9 +1272,9 @@ void PlottingInterface::onPlot(int _chart, QString _fieldID,
                                double _x, double _y)
 {
   // if _x == -1, then the msg has not header time
-  // so update x with the default plotting time that is handled by a timer
+  // so update x with the current plotting time
   if (static_cast<int>(_x) == DEFAULT_TIME)
-      _x = *this->dataPtr->plottingTimeRef;
+      _x = this->Time();
 
   emit this->plot(_chart, _fieldID, _x, _y);
 }
@@ -589,7 +1282,87 @@ void PlottingInterface::onPlot(int _chart, QString _fieldID,
 //////////////////////////////////////////////////////
 void PlottingInterface::UpdateTime()
 {
-  *this->dataPtr->plottingTimeRef += this->dataPtr->timeout * 0.001;
+  // Read from the clock rather than accumulated, so late timer ticks
+  // don't make it drift
+  *this->dataPtr->plottingTimeRef = this->Time();
+}
+
+//////////////////////////////////////////////////////
+double PlottingInterface::Time() const
+{
+  auto now = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> lock(this->dataPtr->clockMutex);
+
+  double time;
+  if (this->dataPtr->hasSimTime)
+  {
+    time = this->dataPtr->simTime;
+    if (!this->dataPtr->paused)
+    {
+      time += std::chrono::duration<double>(
+          now - this->dataPtr->simTimeStamp).count() *
+          this->dataPtr->realTimeFactor;
+    }
+  }
+  else
+  {
+    time = std::chrono::duration<double>(now - this->dataPtr->start).count();
+  }
+
+  // Extrapolating past the next statistics mustn't make time go back
+  time = std::max(time, this->dataPtr->lastTime);
+  this->dataPtr->lastTime = time;
+  return time;
+}
+
+//////////////////////////////////////////////////////
+bool PlottingInterface::SetStatsTopic(const std::string &_topic)
+{
+  if (!this->dataPtr->statsTopic.empty())
+    this->dataPtr->node.Unsubscribe(this->dataPtr->statsTopic);
+  this->dataPtr->statsTopic.clear();
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->clockMutex);
+    if (this->dataPtr->hasSimTime)
+    {
+      // Carry on from the current time with the monotonic clock
+      this->dataPtr->start = std::chrono::steady_clock::now() -
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(this->dataPtr->lastTime));
+    }
+    this->dataPtr->hasSimTime = false;
+  }
+
+  if (_topic.empty())
+    return true;
+
+  if (!this->dataPtr->node.Subscribe(_topic, &PlottingIfacePrivate::OnStats,
+      this->dataPtr.get()))
+  {
+    gzerr << "Failed to subscribe to [" << _topic << "]" << std::endl;
+    return false;
+  }
+  this->dataPtr->statsTopic = _topic;
+  return true;
+}
+
+//////////////////////////////////////////////////////
+void PlottingIfacePrivate::OnStats(const msgs::WorldStatistics &_msg)
+{
+  double simTime = _msg.sim_time().sec() + _msg.sim_time().nsec() * 1e-9;
+
+  std::lock_guard<std::mutex> lock(this->clockMutex);
+
+  // Start from the sim time, or the simulation was reset
+  if (!this->hasSimTime || simTime < this->simTime)
+    this->lastTime = simTime;
+
+  this->hasSimTime = true;
+  this->simTime = simTime;
+  this->simTimeStamp = std::chrono::steady_clock::now();
+  this->realTimeFactor = std::max(_msg.real_time_factor(), 0.0);
+  this->paused = _msg.paused();
 }
 
 //////////////////////////////////////////////////////
@@ -615,6 +1388,192 @@ std::string PlottingInterface::FilePath(QString _path, std::string _name,
   return _path.toStdString() + "/" + "\'" + _name + "." + _extention + "\'";
 }
 
+//////////////////////////////////////////////////////
+void PlottingInterface::setHistorySize(int _size)
+{
+  this->dataPtr->transport.SetHistorySize(
+      static_cast<std::size_t>(std::max(0, _size)));
+}
+
+//////////////////////////////////////////////////////
+QString PlottingInterface::addDerivedSeries(int _chart, QString _expression,
+                                            QVariantMap _inputs)
+{
+  auto series = std::make_shared<DerivedSeries>();
+  series->chart = _chart;
+  series->id = _expression.trimmed();
+
+  std::vector<std::string> names;
+  for (auto it = _inputs.constBegin(); it != _inputs.constEnd(); ++it)
+  {
+    auto topicPath = it.value().toString().split(",");
+    if (topicPath.size() != 2)
+    {
+      gzerr << "Input [" << it.key().toStdString() << "] of derived series ["
+            << series->id.toStdString() << "] isn't a topic and a field path"
+            << std::endl;
+      return QString();
+    }
+    names.push_back(it.key().toStdString());
+    series->inputs.emplace_back(topicPath[0].toStdString(),
+        topicPath[1].toStdString());
+  }
+
+  if (!series->signal.Parse(series->id.toStdString(), names))
+  {
+    gzerr << "Invalid derived series [" << series->id.toStdString() << "]: "
+          << series->signal.Error() << std::endl;
+    return QString();
+  }
+
+  this->removeDerivedSeries(_chart, series->id);
+
+  // The fields are recorded as long as they're registered
+  series->inputChart = this->dataPtr->nextInputChart--;
+  series->next.assign(series->inputs.size(), 0);
+  for (const auto &input : series->inputs)
+  {
+    this->dataPtr->transport.Subscribe(input.first, input.second,
+        series->inputChart, this->dataPtr->plottingTimeRef);
+  }
+  this->dataPtr->derived[{_chart, series->id}] = series;
+  return series->id;
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::removeDerivedSeries(int _chart, QString _id)
+{
+  // A running task only writes to the series it shares
+  auto it = this->dataPtr->derived.find({_chart, _id});
+  if (it == this->dataPtr->derived.end())
+    return;
+
+  for (const auto &input : it->second->inputs)
+  {
+    this->dataPtr->transport.Unsubscribe(input.first, input.second,
+        it->second->inputChart);
+  }
+  this->dataPtr->derived.erase(it);
+}
+
+//////////////////////////////////////////////////////
+void PlottingInterface::UpdateDerived()
+{
+  GZ_GUI_PROFILE("PlottingInterface::UpdateDerived");
+  const auto &topics = this->dataPtr->transport.Topics();
+  for (auto &derivedIt : this->dataPtr->derived)
+  {
+    auto series = derivedIt.second;
+    QVariantList points;
+    {
+      std::lock_guard<std::mutex> lock(series->mutex);
+      if (series->busy)
+        continue;
+      points.swap(series->points);
+    }
+
+    if (!points.empty())
+    {
+      if (series->signal.IsSpectrum())
+        emit this->plotSeries(series->chart, series->id, points);
+      else
+        emit this->plotPoints(series->chart, series->id, points);
+    }
+
+    // Only the samples are copied on this thread
+    std::vector<std::vector<QPointF>> samples(series->inputs.size());
+    bool received{false};
+    for (std::size_t i = 0; i < series->inputs.size(); ++i)
+    {
+      auto topic = topics.find(series->inputs[i].first);
+      if (topic == topics.end())
+        continue;
+      series->next[i] = topic->second->CopyHistory(
+          series->inputs[i].second, series->next[i], samples[i]);
+      received = received || !samples[i].empty();
+    }
+    if (!received)
+      continue;
+
+    {
+      std::lock_guard<std::mutex> lock(series->mutex);
+      series->busy = true;
+    }
+    WorkerPool::Post([series, samples = std::move(samples)]()
+    {
+      auto computed = series->signal.Update(samples);
+
+      // Reduced to what the chart can show, as often as the fields. The
+      // first points may span the whole history.
+      QVariantList reduced;
+      if (series->signal.IsSpectrum() && !computed.empty())
+      {
+        reduced = Decimate(computed, SPECTRUM_BUCKETS);
+      }
+      else if (!computed.empty())
+      {
+        double span = computed.back().x() - computed.front().x();
+        auto flushes = static_cast<std::size_t>(
+            std::max(1.0, std::ceil(span * 1000.0 / FLUSH_PERIOD)));
+        reduced = Decimate(computed, flushes * FLUSH_BUCKETS);
+      }
+
+      std::lock_guard<std::mutex> lock(series->mutex);
+      if (series->signal.IsSpectrum() && !reduced.empty())
+        series->points = reduced;
+      else
+        series->points.append(reduced);
+      series->busy = false;
+    }, this->dataPtr.get());
+  }
+}
+
+//////////////////////////////////////////////////////
+QStringList PlottingInterface::exportHistoryCSV(QString _path, int _chart)
+{
+  QStringList exported;
+  std::string plotName = "Plot" + std::to_string(_chart);
+
+  for (const auto &topic : this->dataPtr->transport.Topics())
+  {
+    for (const auto &field : topic.second->Fields())
+    {
+      if (!field.second || field.second->Charts().count(_chart) == 0)
+        continue;
+
+      // same file names as exportCSV
+      auto id = topic.first + "-" + field.first;
+      auto key = id;
+      std::replace(key.begin(), key.end(), '-', '/');
+
+      auto filePath = this->FilePath(_path, plotName + "_" + key, "csv");
+      if (filePath.empty())
+      {
+        gzwarn << "[Couldn't parse file: " << filePath << "]" << std::endl;
+        continue;
+      }
+
+      std::ofstream file(filePath);
+      if (!file.is_open())
+      {
+        gzwarn << "[Couldn't open file: " << filePath << "]" << std::endl;
+        continue;
+      }
+
+      // enough digits to tell apart samples of fast loops
+      file.precision(std::numeric_limits<double>::max_digits10);
+      file << "time, " << key << std::endl;
+      if (!topic.second->WriteHistory(field.first, file))
+      {
+        gzwarn << "[Couldn't write file: " << filePath << "]" << std::endl;
+        continue;
+      }
+      exported.push_back(QString::fromStdString(id));
+    }
+  }
+  return exported;
+}
+
 //////////////////////////////////////////////////////
 bool PlottingInterface::exportCSV(QString _path, int _chart,
                                   QMap< QString, QVariant> _serieses)
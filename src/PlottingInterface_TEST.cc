@@ -17,12 +17,21 @@
 #include <gtest/gtest.h>
 
 #include <gz/msgs/collision.pb.h>
+#include <gz/msgs/double.pb.h>
+#include <gz/msgs/float.pb.h>
 #include <gz/msgs/header.pb.h>
 #include <gz/msgs/int32.pb.h>
 #include <gz/msgs/pose.pb.h>
 #include <gz/msgs/time.pb.h>
+#include <gz/msgs/twist.pb.h>
 #include <gz/msgs/vector3d.pb.h>
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <vector>
+
 #include <gz/common/Console.hh>
 #include <gz/transport/Node.hh>
 #include <gz/utils/ExtraTestMacros.hh>
@@ -96,11 +105,10 @@ TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Topic))
   EXPECT_EQ(static_cast<int>(fields["pose-position-x"]->Value()), 10);
   EXPECT_EQ(static_cast<int>(fields["pose-position-z"]->Value()), 15);
 
-  // ========== Callback Test with too small time diff ==========
+  // ========== Callback Test with small time diff ==========
   vector3d->set_x(20);
   vector3d->set_z(15);
 
-  // time diff < max diff
   *time += 0.0001;
 
   // update the fields
@@ -108,8 +116,51 @@ TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Topic))
 
   fields = topic.Fields();
 
-  // will not be set to 20 because the too small time diff
-  EXPECT_NE(static_cast<int>(fields["pose-position-x"]->Value()), 20);
+  // samples aren't dropped, however close in time
+  EXPECT_EQ(static_cast<int>(fields["pose-position-x"]->Value()), 20);
+
+  // ========== Flush Test ==========
+  std::map<int, QVariantList> plotted;
+  QObject::connect(&topic, &Topic::plotPoints,
+      [&](int _chart, QString _fieldID, QVariantList _points)
+  {
+    if (_fieldID == "-pose-position-x")
+      plotted[_chart] = _points;
+  });
+  topic.Flush();
+
+  // both samples of x were buffered, for both of its charts
+  ASSERT_EQ(plotted.size(), 2u);
+  ASSERT_EQ(plotted[1].size(), 2);
+  EXPECT_DOUBLE_EQ(plotted[1][0].toPointF().x(), 10);
+  EXPECT_DOUBLE_EQ(plotted[1][0].toPointF().y(), 10);
+  EXPECT_DOUBLE_EQ(plotted[1][1].toPointF().y(), 20);
+  EXPECT_EQ(plotted[1], plotted[2]);
+
+  // nothing new to flush
+  plotted.clear();
+  topic.Flush();
+  EXPECT_TRUE(plotted.empty());
+
+  // many samples are reduced to the minimum and maximum of each bucket
+  for (int i = 0; i < 1000; ++i)
+  {
+    vector3d->set_x(i == 500 ? 1000 : (i == 700 ? -1000 : 0));
+    *time += 0.001;
+    topic.Callback(msg);
+  }
+  topic.Flush();
+  ASSERT_EQ(plotted.size(), 2u);
+  EXPECT_LT(plotted[1].size(), 10);
+  double minY{0};
+  double maxY{0};
+  for (const auto &point : plotted[1])
+  {
+    minY = std::min(minY, point.toPointF().y());
+    maxY = std::max(maxY, point.toPointF().y());
+  }
+  EXPECT_DOUBLE_EQ(minY, -1000);
+  EXPECT_DOUBLE_EQ(maxY, 1000);
 }
 
 //////////////////////////////////////////////////
@@ -142,11 +193,10 @@ TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(HeaderTime))
 
   EXPECT_EQ(static_cast<int>(fields["data"]->Value()), 10);
 
-  // ======== Header time with too small time diff ==========
+  // ======== Header time with small time diff ==========
 
   msg.set_data(20);
 
-  // time diff < max diff
   stamp->set_sec(currentTime);
   stamp->set_nsec(1);
 
@@ -155,8 +205,9 @@ TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(HeaderTime))
 
   fields = topic.Fields();
 
-  // will not be set to 20 because the too small time diff
-  EXPECT_NE(static_cast<int>(fields["data"]->Value()), 20);
+  // samples aren't dropped, however close in time
+  EXPECT_EQ(static_cast<int>(fields["data"]->Value()), 20);
+  EXPECT_DOUBLE_EQ(fields["data"]->Time(), currentTime + 1e-9);
 }
 
 //////////////////////////////////////////////////
@@ -242,3 +293,258 @@ TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Transport))
   topics = transport.Topics();
   EXPECT_EQ(static_cast<int>(topics.size()), 1);
 }
+
+//////////////////////////////////////////////////
+// Disable test on windows until we fix "LNK2001 unresolved external symbol"
+// error
+TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(FieldPaths))
+{
+  common::Console::SetVerbosity(4);
+
+  auto timeRef = std::make_shared<double>(10);
+  auto topic = Topic("");
+  topic.SetPlottingTimeRef(timeRef);
+
+  // Fields which don't exist or can't be plotted are skipped
+  topic.Register("pose-position-x", 1);
+  topic.Register("pose-position-w", 1);
+  topic.Register("pose-position", 1);
+  topic.Register("name", 1);
+
+  msgs::Collision msg;
+  msg.mutable_pose()->mutable_position()->set_x(10);
+  msg.set_name("collision");
+  topic.Callback(msg);
+
+  auto fields = topic.Fields();
+  EXPECT_EQ(static_cast<int>(fields["pose-position-x"]->Value()), 10);
+  EXPECT_EQ(static_cast<int>(fields["pose-position-w"]->Value()), 0);
+  EXPECT_EQ(static_cast<int>(fields["pose-position"]->Value()), 0);
+  EXPECT_EQ(static_cast<int>(fields["name"]->Value()), 0);
+
+  // Fields registered once the message type is known are resolved too
+  topic.Register("pose-position-z", 1);
+  msg.mutable_pose()->mutable_position()->set_z(15);
+  *timeRef += 1;
+  topic.Callback(msg);
+
+  fields = topic.Fields();
+  EXPECT_EQ(static_cast<int>(fields["pose-position-z"]->Value()), 15);
+
+  // Unset messages are read as zeroes
+  msg.clear_pose();
+  *timeRef += 1;
+  topic.Callback(msg);
+
+  fields = topic.Fields();
+  EXPECT_EQ(static_cast<int>(fields["pose-position-x"]->Value()), 0);
+  EXPECT_FALSE(msg.has_pose());
+
+  // Paths are resolved again when the message type changes
+  topic.Register("data", 1);
+  msgs::Int32 intMsg;
+  intMsg.set_data(20);
+  *timeRef += 1;
+  topic.Callback(intMsg);
+
+  fields = topic.Fields();
+  EXPECT_EQ(static_cast<int>(fields["data"]->Value()), 20);
+}
+
+//////////////////////////////////////////////////
+// Disable test on windows until we fix "LNK2001 unresolved external symbol"
+// error
+TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(History))
+{
+  auto timeRef = std::make_shared<double>(0);
+  auto topic = Topic("");
+  topic.SetPlottingTimeRef(timeRef);
+  topic.Register("data", 1);
+
+  std::ostringstream out;
+  EXPECT_FALSE(topic.WriteHistory("missing", out));
+
+  // empty history
+  EXPECT_TRUE(topic.WriteHistory("data", out));
+  EXPECT_TRUE(out.str().empty());
+
+  // every sample is recorded, however close in time
+  msgs::Int32 msg;
+  for (int i = 0; i < 5; ++i)
+  {
+    msg.set_data(i);
+    *timeRef = i * 0.001;
+    topic.Callback(msg);
+  }
+  EXPECT_TRUE(topic.WriteHistory("data", out));
+  EXPECT_EQ(out.str(), "0, 0\n0.001, 1\n0.002, 2\n0.003, 3\n0.004, 4\n");
+
+  // the oldest samples are overwritten once the history is full
+  topic.SetHistorySize(3);
+  for (int i = 0; i < 5; ++i)
+  {
+    msg.set_data(i);
+    *timeRef = i;
+    topic.Callback(msg);
+  }
+  out.str("");
+  EXPECT_TRUE(topic.WriteHistory("data", out));
+  EXPECT_EQ(out.str(), "2, 2\n3, 3\n4, 4\n");
+
+  // copied from a sample on, skipping the overwritten ones
+  std::vector<QPointF> samples;
+  EXPECT_EQ(topic.CopyHistory("missing", 2u, samples), 2u);
+  EXPECT_TRUE(samples.empty());
+  EXPECT_EQ(topic.CopyHistory("data", 0u, samples), 5u);
+  ASSERT_EQ(samples.size(), 3u);
+  EXPECT_DOUBLE_EQ(samples[0].y(), 2.0);
+  EXPECT_DOUBLE_EQ(samples[2].y(), 4.0);
+
+  samples.clear();
+  EXPECT_EQ(topic.CopyHistory("data", 4u, samples), 5u);
+  ASSERT_EQ(samples.size(), 1u);
+  EXPECT_DOUBLE_EQ(samples[0].y(), 4.0);
+}
+
+//////////////////////////////////////////////////
+// Disable test on windows until we fix "LNK2001 unresolved external symbol"
+// error
+TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(SharedTopic))
+{
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Int32>("/shared_topic");
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  auto timeRef = std::make_shared<double>(10);
+  EXPECT_EQ(0, Transport::SubscriberCount("/shared_topic"));
+
+  // Transports of different plugins share the subscription
+  auto transportA = std::make_unique<Transport>();
+  Transport transportB;
+  transportA->Subscribe("/shared_topic", "data", 1, timeRef);
+  transportA->Subscribe("/shared_topic", "data", 2, timeRef);
+  EXPECT_EQ(1, Transport::SubscriberCount("/shared_topic"));
+  transportB.Subscribe("/shared_topic", "data", 1, timeRef);
+  EXPECT_EQ(2, Transport::SubscriberCount("/shared_topic"));
+
+  // Both receive the messages
+  msgs::Int32 msg;
+  msg.set_data(7);
+  auto fieldsA = transportA->Topics().at("/shared_topic")->Fields();
+  auto fieldsB = transportB.Topics().at("/shared_topic")->Fields();
+  int sleep = 0;
+  int maxSleep = 30;
+  while ((fieldsA["data"]->Value() != 7 || fieldsB["data"]->Value() != 7) &&
+      sleep < maxSleep)
+  {
+    pub.Publish(msg);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    sleep++;
+  }
+  EXPECT_EQ(7, static_cast<int>(fieldsA["data"]->Value()));
+  EXPECT_EQ(7, static_cast<int>(fieldsB["data"]->Value()));
+
+  // The subscription stays until the last handler is gone
+  transportB.Unsubscribe("/shared_topic", "data", 1);
+  EXPECT_EQ(1, Transport::SubscriberCount("/shared_topic"));
+  transportA->Unsubscribe("/shared_topic", "data", 1);
+  EXPECT_EQ(1, Transport::SubscriberCount("/shared_topic"));
+
+  // Deleting a transport removes its handlers
+  transportA.reset();
+  EXPECT_EQ(0, Transport::SubscriberCount("/shared_topic"));
+}
+
+//////////////////////////////////////////////////
+// Disable test on windows until we fix "LNK2001 unresolved external symbol"
+// error
+TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(PlottingClock))
+{
+  auto timeRef = std::make_shared<double>(10);
+  auto topic = Topic("");
+  topic.SetPlottingTimeRef(timeRef);
+  topic.Register("data", 1);
+
+  // Messages without a header are timestamped by the clock at arrival
+  double clockTime{0};
+  topic.SetPlottingClock([&clockTime]()
+  {
+    clockTime += 1;
+    return clockTime;
+  });
+
+  msgs::Int32 msg;
+  msg.set_data(5);
+  for (int i = 0; i < 3; ++i)
+    topic.Callback(msg);
+
+  // Back to the plotting time ref
+  topic.SetPlottingClock(nullptr);
+  topic.Callback(msg);
+
+  std::ostringstream out;
+  EXPECT_TRUE(topic.WriteHistory("data", out));
+  EXPECT_EQ(out.str(), "1, 5\n2, 5\n3, 5\n10, 5\n");
+
+  // Messages with a header keep their time
+  topic.SetPlottingClock([]() {return 100.0;});
+  msg.mutable_header()->mutable_stamp()->set_sec(20);
+  topic.Callback(msg);
+  EXPECT_DOUBLE_EQ(topic.Fields()["data"]->Time(), 20.0);
+}
+
+//////////////////////////////////////////////////
+// Disable test on windows until we fix "LNK2001 unresolved external symbol"
+// error
+TEST(PlottingInterfaceTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(TypedFields))
+{
+  auto timeRef = std::make_shared<double>(10);
+
+  // Common types are read without reflection, others through it
+  auto poseTopic = Topic("");
+  poseTopic.SetPlottingTimeRef(timeRef);
+  poseTopic.Register("position-y", 1);
+  poseTopic.Register("orientation-w", 1);
+  poseTopic.Register("name", 1);
+  poseTopic.Register("id", 1);
+
+  msgs::Pose poseMsg;
+  poseMsg.mutable_position()->set_y(2.5);
+  poseMsg.mutable_orientation()->set_w(0.5);
+  poseMsg.set_id(3);
+  poseTopic.Callback(poseMsg);
+
+  auto fields = poseTopic.Fields();
+  EXPECT_DOUBLE_EQ(fields["position-y"]->Value(), 2.5);
+  EXPECT_DOUBLE_EQ(fields["orientation-w"]->Value(), 0.5);
+  EXPECT_DOUBLE_EQ(fields["name"]->Value(), 0.0);
+  EXPECT_DOUBLE_EQ(fields["id"]->Value(), 3.0);
+
+  auto twistTopic = Topic("");
+  twistTopic.SetPlottingTimeRef(timeRef);
+  twistTopic.Register("angular-z", 1);
+  twistTopic.Register("linear-x", 1);
+
+  msgs::Twist twistMsg;
+  twistMsg.mutable_angular()->set_z(-1.5);
+  twistTopic.Callback(twistMsg);
+
+  fields = twistTopic.Fields();
+  EXPECT_DOUBLE_EQ(fields["angular-z"]->Value(), -1.5);
+  EXPECT_DOUBLE_EQ(fields["linear-x"]->Value(), 0.0);
+
+  // The same topic may change type
+  auto dataTopic = Topic("");
+  dataTopic.SetPlottingTimeRef(timeRef);
+  dataTopic.Register("data", 1);
+
+  msgs::Double doubleMsg;
+  doubleMsg.set_data(4.25);
+  dataTopic.Callback(doubleMsg);
+  EXPECT_DOUBLE_EQ(dataTopic.Fields()["data"]->Value(), 4.25);
+
+  msgs::Float floatMsg;
+  floatMsg.set_data(1.5f);
+  dataTopic.Callback(floatMsg);
+  EXPECT_DOUBLE_EQ(dataTopic.Fields()["data"]->Value(), 1.5);
+}
@@ -15,13 +15,22 @@
  *
  */
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <string>
 #include <unordered_set>
+#include <vector>
 
 #include <gz/common/Console.hh>
+#include <gz/transport/TopicUtils.hh>
+
 #include "gz/gui/Application.hh"
 #include "gz/gui/Helpers.hh"
 #include "gz/gui/MainWindow.hh"
 #include "gz/gui/Plugin.hh"
+#include "gz/gui/StartupProfiler.hh"
 
 /// \brief Used to store information about anchors set by the user.
 struct Anchors
@@ -78,6 +87,38 @@ class gz::gui::PluginPrivate
 
   /// \brief Holds all anchor information
   public: Anchors anchors;
+
+  /// \brief True if LoadConfig waits until the card is shown, set with
+  /// the `lazy` element
+  public: bool lazy{false};
+
+  /// \brief Copy of the <plugin> element, which ConfigStr updates and
+  /// lazy plugins are loaded from, so it isn't parsed again
+  public: tinyxml2::XMLDocument configDoc;
+
+  /// \brief Value of configStr when it was last printed from configDoc.
+  /// If a subclass changes configStr, configDoc is parsed from it again.
+  public: std::string configDocStr;
+
+  /// \brief Connections to the card which wait to load a lazy plugin
+  public: std::vector<QMetaObject::Connection> lazyConnections;
+
+  /// \brief Indices of the notify signals queued with NotifyChanged, in
+  /// order
+  public: std::vector<int> pendingNotify;
+
+  /// \brief True while a flush of pendingNotify is scheduled
+  public: bool flushScheduled{false};
+
+  /// \brief Connection to the window's frame which flushes pendingNotify
+  public: QMetaObject::Connection flushConnection;
+
+  /// \brief Rate caps in messages per second, by topic, set with
+  /// `<max_rate>`
+  public: std::map<std::string, double> maxRates;
+
+  /// \brief Rate cap of topics without their own, 0 for none
+  public: double defaultMaxRate{0.0};
 };
 
 using namespace gz;
@@ -104,8 +145,11 @@ void Plugin::Load(const tinyxml2::XMLElement *_pluginElem)
     return;
   }
 
-  // TODO(anyone): Too complicated to deep clone elements with tinyxml2, storing
-  // string for now and consider moving away from tinyxml
+  // Keep a copy of the element, and the string for subclasses
+  this->dataPtr->configDoc.Clear();
+  this->dataPtr->configDoc.InsertEndChild(
+      _pluginElem->DeepClone(&this->dataPtr->configDoc));
+
   tinyxml2::XMLPrinter printer;
   if (!_pluginElem->Accept(&printer))
   {
@@ -116,6 +160,7 @@ void Plugin::Load(const tinyxml2::XMLElement *_pluginElem)
   {
     this->configStr = std::string(printer.CStr());
   }
+  this->dataPtr->configDocStr = this->configStr;
 
   // Qml file
   std::string filename = _pluginElem->Attribute("filename");
@@ -127,16 +172,20 @@ void Plugin::Load(const tinyxml2::XMLElement *_pluginElem)
 
   // Instantiate plugin QML file into a component
   std::string qmlFile(":/" + filename + "/" + filename + ".qml");
-  if (!QFile(QString::fromStdString(qmlFile)).exists())
-  {
-    gzerr << "Can't find [" << qmlFile
-           << "]. Are you sure it was added to the .qrc file?" << std::endl;
-    return;
-  }
-
-  QQmlComponent component(App()->Engine(), QString::fromStdString(qmlFile));
+  StartupProfiler::Scope qmlProfile(filename, "Create QML");
+  auto &component = *App()->Component(qmlFile);
   if (component.isError())
   {
+    // Files compiled ahead of time aren't in the resources, so this is
+    // only checked when there's an error
+    if (!QFile(QString::fromStdString(qmlFile)).exists())
+    {
+      gzerr << "Can't find [" << qmlFile
+             << "]. Are you sure it was added to the .qrc file?"
+             << std::endl;
+      return;
+    }
+
     std::stringstream errors;
     errors << "Failed to instantiate QML file [" << qmlFile << "]."
            << std::endl;
@@ -185,8 +234,59 @@ void Plugin::Load(const tinyxml2::XMLElement *_pluginElem)
     }
   }
 
-  // Load custom configuration
-  this->LoadConfig(_pluginElem);
+  // Load custom configuration, unless it waits for the card to be shown
+  if (!this->dataPtr->lazy)
+  {
+    StartupProfiler::Scope profile(filename, "LoadConfig");
+    this->LoadConfig(_pluginElem);
+    return;
+  }
+
+  auto cardItem = this->CardItem();
+  if (!cardItem)
+    return;
+
+  // Queued, so the state from the config is applied before checking it
+  auto check = [this](){this->LoadLazyConfig();};
+  this->dataPtr->lazyConnections.push_back(this->connect(cardItem,
+      &QQuickItem::windowChanged, this, check, Qt::QueuedConnection));
+  this->dataPtr->lazyConnections.push_back(this->connect(cardItem,
+      &QQuickItem::visibleChanged, this, check, Qt::QueuedConnection));
+  this->dataPtr->lazyConnections.push_back(this->connect(cardItem,
+      &QQuickItem::stateChanged, this, check, Qt::QueuedConnection));
+
+  // Set by the split while the card is scrolled out of view
+  if (cardItem->metaObject()->indexOfProperty("offScreen") >= 0)
+  {
+    this->dataPtr->lazyConnections.push_back(this->connect(cardItem,
+        SIGNAL(offScreenChanged()), this, SLOT(LoadLazyConfig()),
+        Qt::QueuedConnection));
+  }
+}
+
+/////////////////////////////////////////////////
+void Plugin::LoadLazyConfig()
+{
+  auto cardItem = this->dataPtr->cardItem;
+  if (this->dataPtr->lazyConnections.empty() || !cardItem ||
+      !cardItem->window() || !cardItem->isVisible() ||
+      cardItem->state().endsWith("_collapsed") ||
+      cardItem->property("offScreen").toBool())
+  {
+    return;
+  }
+
+  for (const auto &connection : this->dataPtr->lazyConnections)
+    this->disconnect(connection);
+  this->dataPtr->lazyConnections.clear();
+
+  gzdbg << "Loading configuration of lazy plugin [" << this->title << "]"
+        << std::endl;
+
+  this->LoadConfig(this->dataPtr->configDoc.FirstChildElement("plugin"));
+
+  // The title may have been set by LoadConfig
+  cardItem->setProperty("pluginName", QString::fromStdString(this->Title()));
 }
 
 /////////////////////////////////////////////////
@@ -213,6 +313,13 @@ void Plugin::LoadCommonConfig(const tinyxml2::XMLElement *_guiElem)
       this->DeleteLater();
   }
 
+  // Lazy
+  elem = _guiElem->FirstChildElement("lazy");
+  if (nullptr != elem)
+  {
+    elem->QueryBoolText(&this->dataPtr->lazy);
+  }
+
   // Properties
   for (auto propElem = _guiElem->FirstChildElement("property");
       propElem != nullptr;
@@ -259,6 +366,36 @@ void Plugin::LoadCommonConfig(const tinyxml2::XMLElement *_guiElem)
     this->dataPtr->cardProperties[key] = variant;
   }
 
+  // Rate caps
+  for (auto rateElem = _guiElem->FirstChildElement("max_rate");
+      rateElem != nullptr;
+      rateElem = rateElem->NextSiblingElement("max_rate"))
+  {
+    double rate{0.0};
+    if (rateElem->QueryDoubleText(&rate) != tinyxml2::XML_SUCCESS ||
+        rate < 0.0)
+    {
+      gzerr << "Invalid <max_rate>, expected a non-negative rate in Hz"
+            << std::endl;
+      continue;
+    }
+
+    auto topic = rateElem->Attribute("topic");
+    if (nullptr == topic)
+    {
+      this->dataPtr->defaultMaxRate = rate;
+      continue;
+    }
+
+    auto valid = transport::TopicUtils::AsValidTopic(topic);
+    if (valid.empty())
+    {
+      gzerr << "Invalid <max_rate> topic [" << topic << "]" << std::endl;
+      continue;
+    }
+    this->dataPtr->maxRates[valid] = rate;
+  }
+
   // Anchors
   if (auto anchorElem = _guiElem->FirstChildElement("anchors"))
   {
@@ -291,15 +428,44 @@ void Plugin::LoadCommonConfig(const tinyxml2::XMLElement *_guiElem)
   }
 }
 
+/////////////////////////////////////////////////
+double Plugin::MaxRate(const std::string &_topic) const
+{
+  if (!this->dataPtr->maxRates.empty())
+  {
+    auto it = this->dataPtr->maxRates.find(
+        transport::TopicUtils::AsValidTopic(_topic));
+    if (it != this->dataPtr->maxRates.end())
+      return it->second;
+  }
+  return this->dataPtr->defaultMaxRate;
+}
+
+/////////////////////////////////////////////////
+transport::SubscribeOptions Plugin::SubscribeOptions(
+    const std::string &_topic) const
+{
+  transport::SubscribeOptions opts;
+  auto rate = this->MaxRate(_topic);
+  if (rate > 0.0)
+  {
+    // The transport counts whole messages per second
+    opts.SetMsgsPerSec(std::max<uint64_t>(1u,
+        static_cast<uint64_t>(std::ceil(rate))));
+  }
+  return opts;
+}
+
 /////////////////////////////////////////////////
 std::string Plugin::ConfigStr()
 {
   // TODO(anyone): When plugins override this function they will lose the
   // card updates, must refactor config handling
 
-  // Convert string to XML
-  tinyxml2::XMLDocument doc;
-  doc.Parse(this->configStr.c_str());
+  // Parse the string only if it doesn't match the element anymore
+  auto &doc = this->dataPtr->configDoc;
+  if (this->configStr != this->dataPtr->configDocStr)
+    doc.Parse(this->configStr.c_str());
 
   // <plugin>
   auto pluginElem = doc.FirstChildElement("plugin");
@@ -386,6 +552,7 @@ std::string Plugin::ConfigStr()
   else
   {
     this->configStr = std::string(printer.CStr());
+    this->dataPtr->configDocStr = this->configStr;
   }
 
   return this->configStr;
@@ -429,9 +596,9 @@ QQuickItem *Plugin::CardItem() const
 
   // Instantiate a card
   std::string qmlFile(":qml/GzCard.qml");
-  QQmlComponent cardComp(App()->Engine(),
-      QString(QString::fromStdString(qmlFile)));
-  auto cardItem = qobject_cast<QQuickItem *>(cardComp.create());
+  StartupProfiler::Scope profile(this->title, "Create card");
+  auto cardItem = qobject_cast<QQuickItem *>(
+      App()->Component(qmlFile)->create());
   if (!cardItem)
   {
     gzerr << "Internal error: Failed to instantiate QML file [" << qmlFile
@@ -595,3 +762,62 @@ void Plugin::ApplyAnchors()
   }
   this->CardItem()->setProperty("anchored", true);
 }
+
+/////////////////////////////////////////////////
+void Plugin::NotifyChanged(const char *_property)
+{
+  auto meta = this->metaObject();
+  auto index = meta->indexOfProperty(_property);
+  auto signal = index < 0 ? QMetaMethod() :
+      meta->property(index).notifySignal();
+  if (!signal.isValid() || signal.parameterCount() != 0)
+  {
+    gzerr << "Property [" << _property << "] of [" << this->title
+          << "] doesn't have a NOTIFY signal without arguments."
+          << std::endl;
+    return;
+  }
+
+  auto &pending = this->dataPtr->pendingNotify;
+  if (std::find(pending.begin(), pending.end(), signal.methodIndex()) ==
+      pending.end())
+  {
+    pending.push_back(signal.methodIndex());
+  }
+
+  if (this->dataPtr->flushScheduled)
+    return;
+  this->dataPtr->flushScheduled = true;
+
+  // Flushed right before the next frame is synchronized, so QML updates
+  // its bindings once per frame. Hidden windows don't render, so it's
+  // flushed on the next pass of the event loop instead.
+  auto item = this->dataPtr->pluginItem;
+  auto window = item ? item->window() : nullptr;
+  if (window && window->isExposed())
+  {
+    this->dataPtr->flushConnection = this->connect(window,
+        &QQuickWindow::afterAnimating, this, &Plugin::FlushNotifications);
+    window->update();
+  }
+  else
+  {
+    QMetaObject::invokeMethod(this, [this]
+    {
+      this->FlushNotifications();
+    }, Qt::QueuedConnection);
+  }
+}
+
+/////////////////////////////////////////////////
+void Plugin::FlushNotifications()
+{
+  this->disconnect(this->dataPtr->flushConnection);
+  this->dataPtr->flushScheduled = false;
+
+  // Signals may queue more notifications, which wait for the next frame
+  auto pending = std::move(this->dataPtr->pendingNotify);
+  this->dataPtr->pendingNotify.clear();
+  for (auto index : pending)
+    this->metaObject()->method(index).invoke(this, Qt::DirectConnection);
+}
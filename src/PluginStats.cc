@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include "gz/gui/Plugin.hh"
+#include "gz/gui/PluginStats.hh"
+#include "gz/gui/qt.h"
+
+namespace
+{
+  /// \brief Global accounting state
+  struct Stats
+  {
+    /// \brief Protects usage
+    std::mutex mutex;
+
+    /// \brief Number of Enable calls not matched by Disable. Checked before
+    /// taking the mutex, so disabled accounting only costs a load.
+    std::atomic<int> enabled{0};
+
+    /// \brief Usage per name since the last TakeUsage
+    std::map<std::string, gz::gui::PluginStats::Usage> usage;
+  };
+
+  /////////////////////////////////////////////////
+  Stats &stats()
+  {
+    static Stats instance;
+    return instance;
+  }
+}
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+double PluginStats::Usage::TotalMs() const
+{
+  double total{0.0};
+  for (auto value : this->ms)
+    total += value;
+  return total;
+}
+
+/////////////////////////////////////////////////
+PluginStats::Scope::Scope(const QObject *_object, Source _source)
+  : source(_source), enabled(PluginStats::Enabled())
+{
+  if (!this->enabled)
+    return;
+
+  this->name = PluginStats::NameOf(_object);
+  this->start = Clock::now();
+}
+
+/////////////////////////////////////////////////
+PluginStats::Scope::Scope(const std::string &_name, Source _source)
+  : source(_source), enabled(PluginStats::Enabled())
+{
+  if (!this->enabled)
+    return;
+
+  this->name = _name;
+  this->start = Clock::now();
+}
+
+/////////////////////////////////////////////////
+PluginStats::Scope::~Scope()
+{
+  if (!this->enabled)
+    return;
+
+  PluginStats::Record(this->name, this->source,
+      std::chrono::duration<double, std::milli>(
+      Clock::now() - this->start).count());
+}
+
+/////////////////////////////////////////////////
+void PluginStats::Enable()
+{
+  ++stats().enabled;
+}
+
+/////////////////////////////////////////////////
+void PluginStats::Disable()
+{
+  auto &s = stats();
+  if (s.enabled <= 0 || --s.enabled > 0)
+    return;
+
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.usage.clear();
+}
+
+/////////////////////////////////////////////////
+bool PluginStats::Enabled()
+{
+  return stats().enabled > 0;
+}
+
+/////////////////////////////////////////////////
+void PluginStats::Record(const std::string &_name, Source _source,
+    double _ms)
+{
+  auto &s = stats();
+  if (s.enabled <= 0)
+    return;
+
+  auto index = static_cast<std::size_t>(_source);
+  if (index >= kSourceCount)
+    return;
+
+  std::lock_guard<std::mutex> lock(s.mutex);
+  auto &usage = s.usage[_name];
+  usage.ms[index] += _ms;
+  ++usage.calls[index];
+}
+
+/////////////////////////////////////////////////
+std::string PluginStats::NameOf(const QObject *_object)
+{
+  if (nullptr == _object)
+    return "unknown";
+
+  // Plugins' helpers are usually their children, and their items are in
+  // their card, whose name is the plugin's
+  for (auto object = _object; object != nullptr;)
+  {
+    if (auto plugin = qobject_cast<const Plugin *>(object))
+    {
+      auto card = plugin->CardItem();
+      if (card && !card->objectName().isEmpty())
+        return card->objectName().toStdString();
+      return plugin->metaObject()->className();
+    }
+
+    auto item = qobject_cast<const QQuickItem *>(object);
+    if (item && item->property("pluginName").isValid() &&
+        !item->objectName().isEmpty())
+    {
+      return item->objectName().toStdString();
+    }
+
+    if (item && item->parentItem())
+      object = item->parentItem();
+    else
+      object = object->parent();
+  }
+
+  return _object->metaObject()->className();
+}
+
+/////////////////////////////////////////////////
+std::vector<PluginStats::Usage> PluginStats::TakeUsage()
+{
+  std::vector<Usage> result;
+  auto &s = stats();
+  {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    result.reserve(s.usage.size());
+    for (auto &entry : s.usage)
+    {
+      entry.second.name = entry.first;
+      result.push_back(std::move(entry.second));
+    }
+    s.usage.clear();
+  }
+
+  std::sort(result.begin(), result.end(),
+      [](const Usage &_a, const Usage &_b)
+      {
+        return _a.TotalMs() > _b.TotalMs();
+      });
+  return result;
+}
+
+/////////////////////////////////////////////////
+uint64_t PluginStats::ResidentMemory()
+{
+#ifdef __linux__
+  // Sizes in pages: total, then resident
+  std::ifstream statm("/proc/self/statm");
+  uint64_t size{0};
+  uint64_t resident{0};
+  if (!(statm >> size >> resident))
+    return 0;
+
+  auto pageSize = sysconf(_SC_PAGESIZE);
+  if (pageSize <= 0)
+    return 0;
+  return resident * static_cast<uint64_t>(pageSize);
+#else
+  return 0;
+#endif
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Plugin.hh"
+#include "gz/gui/PluginStats.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/qt.h"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(PluginStatsTest, Record)
+{
+  // Disabled by default
+  EXPECT_FALSE(PluginStats::Enabled());
+  PluginStats::Record("ignored", PluginStats::Source::kEvents, 1.0);
+  {
+    PluginStats::Scope scope("ignored", PluginStats::Source::kEvents);
+  }
+  EXPECT_TRUE(PluginStats::TakeUsage().empty());
+
+  PluginStats::Enable();
+  PluginStats::Enable();
+  EXPECT_TRUE(PluginStats::Enabled());
+
+  PluginStats::Record("A", PluginStats::Source::kEvents, 1.0);
+  PluginStats::Record("A", PluginStats::Source::kEvents, 2.0);
+  PluginStats::Record("A", PluginStats::Source::kTransport, 0.5);
+  std::thread thread([]()
+  {
+    PluginStats::Record("B", PluginStats::Source::kRenderHooks, 10.0);
+  });
+  thread.join();
+
+  auto usage = PluginStats::TakeUsage();
+  ASSERT_EQ(2u, usage.size());
+
+  // Most expensive first
+  EXPECT_EQ("B", usage[0].name);
+  EXPECT_DOUBLE_EQ(10.0, usage[0].TotalMs());
+  EXPECT_EQ(1u, usage[0].calls[
+      static_cast<std::size_t>(PluginStats::Source::kRenderHooks)]);
+
+  EXPECT_EQ("A", usage[1].name);
+  EXPECT_DOUBLE_EQ(3.5, usage[1].TotalMs());
+  EXPECT_DOUBLE_EQ(3.0, usage[1].ms[
+      static_cast<std::size_t>(PluginStats::Source::kEvents)]);
+  EXPECT_EQ(2u, usage[1].calls[
+      static_cast<std::size_t>(PluginStats::Source::kEvents)]);
+  EXPECT_EQ(1u, usage[1].calls[
+      static_cast<std::size_t>(PluginStats::Source::kTransport)]);
+
+  // Reset once taken
+  EXPECT_TRUE(PluginStats::TakeUsage().empty());
+
+  {
+    PluginStats::Scope scope("C", PluginStats::Source::kEvents);
+  }
+  usage = PluginStats::TakeUsage();
+  ASSERT_EQ(1u, usage.size());
+  EXPECT_EQ("C", usage[0].name);
+  EXPECT_GE(usage[0].TotalMs(), 0.0);
+
+  // Stops once each Enable is matched
+  PluginStats::Disable();
+  EXPECT_TRUE(PluginStats::Enabled());
+  PluginStats::Disable();
+  EXPECT_FALSE(PluginStats::Enabled());
+  PluginStats::Disable();
+  EXPECT_FALSE(PluginStats::Enabled());
+}
+
+/////////////////////////////////////////////////
+TEST(PluginStatsTest, NameOf)
+{
+  EXPECT_EQ("unknown", PluginStats::NameOf(nullptr));
+
+  QObject object;
+  EXPECT_EQ("QObject", PluginStats::NameOf(&object));
+
+  // Plugins without a card are named after their class
+  Plugin plugin;
+  QObject child(&plugin);
+  EXPECT_EQ("gz::gui::Plugin", PluginStats::NameOf(&plugin));
+  EXPECT_EQ("gz::gui::Plugin", PluginStats::NameOf(&child));
+}
+
+/////////////////////////////////////////////////
+TEST(PluginStatsTest, RenderHooks)
+{
+  PluginStats::Enable();
+
+  auto id = RenderHooks::Register(RenderPhase::kRender, []{}, 0, "Hooked");
+  RenderHooks::Run(RenderPhase::kRender);
+  RenderHooks::Run(RenderPhase::kRender);
+  EXPECT_TRUE(RenderHooks::Unregister(id));
+
+  auto usage = PluginStats::TakeUsage();
+  ASSERT_EQ(1u, usage.size());
+  EXPECT_EQ("Hooked", usage[0].name);
+  EXPECT_EQ(2u, usage[0].calls[
+      static_cast<std::size_t>(PluginStats::Source::kRenderHooks)]);
+
+  PluginStats::Disable();
+}
+
+/////////////////////////////////////////////////
+TEST(PluginStatsTest, ResidentMemory)
+{
+#ifdef __linux__
+  EXPECT_GT(PluginStats::ResidentMemory(), 0u);
+#else
+  EXPECT_EQ(0u, PluginStats::ResidentMemory());
+#endif
+}
@@ -136,6 +136,91 @@ TEST(PluginTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Getters))
   ASSERT_NE(nullptr, plugin->Context());
 }
 
+/////////////////////////////////////////////////
+TEST(PluginTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Lazy))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(
+      common::joinPaths(std::string(PROJECT_BINARY_PATH), "lib"));
+
+  // Publisher sets its title on LoadConfig
+  const char *pluginStr =
+    "<plugin filename=\"Publisher\">"
+    "  <gz-gui>"
+    "    <lazy>true</lazy>"
+    "    <property type=\"string\" key=\"state\">docked_collapsed</property>"
+    "  </gz-gui>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("Publisher",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  auto plugins = win->findChildren<Plugin *>();
+  ASSERT_EQ(1, plugins.size());
+  auto plugin = plugins[0];
+  ASSERT_NE(nullptr, plugin->CardItem());
+
+  // Not loaded while collapsed
+  QCoreApplication::processEvents();
+  EXPECT_TRUE(plugin->Title().empty());
+
+  // Loaded once expanded
+  plugin->CardItem()->setProperty("state", "docked");
+  QCoreApplication::processEvents();
+  EXPECT_EQ("Publisher", plugin->Title());
+  EXPECT_EQ("Publisher",
+      plugin->CardItem()->property("pluginName").toString().toStdString());
+}
+
+/////////////////////////////////////////////////
+TEST(PluginTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(MaxRate))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  const char *pluginStr =
+    "<plugin filename=\"TestPlugin\">"
+    "  <gz-gui>"
+    "    <max_rate topic=\"/camera\">10</max_rate>"
+    "    <max_rate topic=\"/lidar\">2.5</max_rate>"
+    "    <max_rate topic=\"/bad\">-1</max_rate>"
+    "    <max_rate>30</max_rate>"
+    "  </gz-gui>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("TestPlugin",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  auto plugins = win->findChildren<Plugin *>();
+  ASSERT_EQ(1, plugins.size());
+  auto plugin = plugins[0];
+
+  EXPECT_DOUBLE_EQ(10.0, plugin->MaxRate("/camera"));
+  EXPECT_DOUBLE_EQ(10.0, plugin->MaxRate("camera"));
+  EXPECT_DOUBLE_EQ(2.5, plugin->MaxRate("/lidar"));
+
+  // Invalid and unlisted topics get the default
+  EXPECT_DOUBLE_EQ(30.0, plugin->MaxRate("/bad"));
+  EXPECT_DOUBLE_EQ(30.0, plugin->MaxRate("/other"));
+
+  EXPECT_TRUE(plugin->SubscribeOptions("/camera").Throttled());
+  EXPECT_EQ(10u, plugin->SubscribeOptions("/camera").MsgsPerSec());
+  EXPECT_EQ(3u, plugin->SubscribeOptions("/lidar").MsgsPerSec());
+}
+
 /////////////////////////////////////////////////
 TEST(PluginTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(ConfigStr))
 {
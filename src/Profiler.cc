@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+
+#include "gz/gui/Profiler.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TraceZone::TraceZone(const char *_name)
+{
+  if (!StartupProfiler::Enabled())
+    return;
+
+  this->name = _name;
+  this->start = StartupProfiler::Clock::now();
+}
+
+/////////////////////////////////////////////////
+TraceZone::~TraceZone()
+{
+  // An empty category tells zones apart from startup steps
+  if (nullptr != this->name)
+  {
+    StartupProfiler::Record(this->name, std::string(), this->start,
+        StartupProfiler::Clock::now());
+  }
+}
+
+/////////////////////////////////////////////////
+void gz::gui::SetProfiledThreadName(const char *_name)
+{
+  thread_local bool named{false};
+  if (named)
+    return;
+  named = true;
+
+  GZ_PROFILE_THREAD_NAME(_name);
+  StartupProfiler::SetThreadName(_name);
+  SamplingProfiler::SetThreadName(_name);
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gz/common/Filesystem.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Profiler.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(ProfilerTest, TraceZone)
+{
+  auto path = common::joinPaths(std::string(PROJECT_BINARY_PATH),
+      "profiler_TEST.json");
+
+  // Not recorded while disabled
+  {
+    TraceZone zone("Before enabling");
+  }
+
+  StartupProfiler::Enable(path);
+  std::thread thread([]()
+  {
+    // Only the first name is kept
+    SetProfiledThreadName("Worker");
+    SetProfiledThreadName("Renamed");
+    TraceZone zone("Work");
+  });
+  thread.join();
+  {
+    TraceZone zone("Main");
+    GZ_GUI_PROFILE("Macro");
+  }
+  EXPECT_TRUE(StartupProfiler::Write());
+
+  std::ifstream file(path);
+  ASSERT_TRUE(file.is_open());
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  auto trace = buffer.str();
+
+  EXPECT_NE(std::string::npos,
+      trace.find("\"name\":\"Work\",\"cat\":\"zone\",\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, trace.find("\"name\":\"Main\""));
+  EXPECT_NE(std::string::npos, trace.find(
+      "\"name\":\"thread_name\",\"ph\":\"M\",\"args\":{\"name\":\"Worker\"}"));
+  EXPECT_EQ(std::string::npos, trace.find("Renamed"));
+  EXPECT_EQ(std::string::npos, trace.find("Before enabling"));
+
+  // Only recorded with the build option
+  EXPECT_EQ(GZ_GUI_TRACE_ENABLE != 0,
+      trace.find("\"name\":\"Macro\"") != std::string::npos);
+
+  common::removeFile(path);
+}
@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gz/gui/QueueStats.hh"
+
+namespace
+{
+  /// \brief Global registry state
+  struct Registry
+  {
+    /// \brief Protects everything. Held while a queue is destroyed, so the
+    /// queues are valid while it's held.
+    std::mutex mutex;
+
+    /// \brief Registered queues
+    std::set<gz::gui::QueueStats::Queue *> queues;
+
+    /// \brief Limits, by queue name
+    std::map<std::string, gz::gui::QueueStats::Limit> limits;
+  };
+
+  /////////////////////////////////////////////////
+  Registry &registry()
+  {
+    static Registry instance;
+    return instance;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Raise a high-water mark
+  /// \param[in] _max High-water mark
+  /// \param[in] _value Current value
+  void raise(std::atomic<uint64_t> &_max, uint64_t _value)
+  {
+    auto current = _max.load(std::memory_order_relaxed);
+    while (_value > current &&
+        !_max.compare_exchange_weak(current, _value,
+        std::memory_order_relaxed))
+    {
+    }
+  }
+}
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+bool QueueStats::Limit::Exceeded(uint64_t _depth, uint64_t _bytes) const
+{
+  return (this->depth > 0u && _depth > this->depth) ||
+      (this->bytes > 0u && _bytes > this->bytes);
+}
+
+/////////////////////////////////////////////////
+bool QueueStats::Limit::Enabled() const
+{
+  return this->depth > 0u || this->bytes > 0u;
+}
+
+/////////////////////////////////////////////////
+QueueStats::Queue::Queue(const std::string &_name, bool _droppable)
+  : name(_name), droppable(_droppable)
+{
+  auto &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  auto limit = r.limits.find(this->name);
+  if (limit != r.limits.end())
+  {
+    this->limitDepth = limit->second.depth;
+    this->limitBytes = limit->second.bytes;
+    this->limitPolicy = static_cast<int>(limit->second.policy);
+  }
+  r.queues.insert(this);
+}
+
+/////////////////////////////////////////////////
+QueueStats::Queue::~Queue()
+{
+  auto &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  r.queues.erase(this);
+}
+
+/////////////////////////////////////////////////
+void QueueStats::Queue::Update(uint64_t _depth, uint64_t _bytes)
+{
+  this->depth.store(_depth, std::memory_order_relaxed);
+  this->bytes.store(_bytes, std::memory_order_relaxed);
+  raise(this->maxDepth, _depth);
+  raise(this->maxBytes, _bytes);
+}
+
+/////////////////////////////////////////////////
+void QueueStats::Queue::Drop(uint64_t _count)
+{
+  this->dropped.fetch_add(_count, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+QueueStats::Limit QueueStats::Queue::CurrentLimit() const
+{
+  Limit limit;
+  if (!this->droppable)
+    return limit;
+
+  limit.depth = this->limitDepth.load(std::memory_order_relaxed);
+  limit.bytes = this->limitBytes.load(std::memory_order_relaxed);
+  limit.policy = static_cast<DropPolicy>(
+      this->limitPolicy.load(std::memory_order_relaxed));
+  return limit;
+}
+
+/////////////////////////////////////////////////
+const std::string &QueueStats::Queue::Name() const
+{
+  return this->name;
+}
+
+/////////////////////////////////////////////////
+void QueueStats::SetLimit(const std::string &_name, const Limit &_limit)
+{
+  auto &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  if (_limit.Enabled())
+    r.limits[_name] = _limit;
+  else
+    r.limits.erase(_name);
+
+  for (auto queue : r.queues)
+  {
+    if (queue->name != _name)
+      continue;
+    queue->limitDepth = _limit.depth;
+    queue->limitBytes = _limit.bytes;
+    queue->limitPolicy = static_cast<int>(_limit.policy);
+  }
+}
+
+/////////////////////////////////////////////////
+QueueStats::Limit QueueStats::LimitOf(const std::string &_name)
+{
+  auto &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  auto it = r.limits.find(_name);
+  return it == r.limits.end() ? Limit() : it->second;
+}
+
+/////////////////////////////////////////////////
+std::vector<QueueStats::Usage> QueueStats::CurrentUsage()
+{
+  std::map<std::string, Usage> byName;
+  {
+    auto &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto queue : r.queues)
+    {
+      auto &usage = byName[queue->name];
+      usage.name = queue->name;
+      ++usage.count;
+      usage.depth += queue->depth.load(std::memory_order_relaxed);
+      usage.bytes += queue->bytes.load(std::memory_order_relaxed);
+      usage.maxDepth += queue->maxDepth.load(std::memory_order_relaxed);
+      usage.maxBytes += queue->maxBytes.load(std::memory_order_relaxed);
+      usage.dropped += queue->dropped.load(std::memory_order_relaxed);
+      usage.droppable = usage.droppable || queue->droppable;
+
+      auto limit = r.limits.find(queue->name);
+      if (limit != r.limits.end())
+        usage.limit = limit->second;
+    }
+  }
+
+  std::vector<Usage> result;
+  result.reserve(byName.size());
+  for (auto &usage : byName)
+    result.push_back(std::move(usage.second));
+
+  // The largest first, then the deepest, such as queues of ids
+  std::stable_sort(result.begin(), result.end(),
+      [](const Usage &_a, const Usage &_b)
+      {
+        if (_a.bytes != _b.bytes)
+          return _a.bytes > _b.bytes;
+        return _a.depth > _b.depth;
+      });
+  return result;
+}
+
+/////////////////////////////////////////////////
+void QueueStats::Reset()
+{
+  auto &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  for (auto queue : r.queues)
+  {
+    queue->maxDepth = queue->depth.load();
+    queue->maxBytes = queue->bytes.load();
+    queue->dropped = 0u;
+  }
+}
+
+/////////////////////////////////////////////////
+std::string QueueStats::PolicyName(DropPolicy _policy)
+{
+  switch (_policy)
+  {
+    case DropPolicy::kDropOldest:
+      return "drop_oldest";
+    case DropPolicy::kDropNewest:
+      return "drop_newest";
+  }
+  return "unknown";
+}
+
+/////////////////////////////////////////////////
+bool QueueStats::PolicyFromName(const std::string &_name,
+    DropPolicy &_policy)
+{
+  if (_name == "drop_oldest")
+    _policy = DropPolicy::kDropOldest;
+  else if (_name == "drop_newest")
+    _policy = DropPolicy::kDropNewest;
+  else
+    return false;
+  return true;
+}
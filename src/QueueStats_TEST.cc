@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/QueueStats.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(QueueStatsTest, Usage)
+{
+  EXPECT_TRUE(QueueStats::CurrentUsage().empty());
+
+  {
+    QueueStats::Queue a("A/msgs", true);
+    QueueStats::Queue b("B/ids", false);
+    EXPECT_EQ("A/msgs", a.Name());
+
+    a.Update(10u, 1000u);
+    a.Update(2u, 200u);
+    a.Drop();
+    a.Drop(2u);
+    b.Update(5u, 20u);
+
+    // Largest first, with the high-water marks
+    auto usage = QueueStats::CurrentUsage();
+    ASSERT_EQ(2u, usage.size());
+    EXPECT_EQ("A/msgs", usage[0].name);
+    EXPECT_EQ(1u, usage[0].count);
+    EXPECT_EQ(2u, usage[0].depth);
+    EXPECT_EQ(200u, usage[0].bytes);
+    EXPECT_EQ(10u, usage[0].maxDepth);
+    EXPECT_EQ(1000u, usage[0].maxBytes);
+    EXPECT_EQ(3u, usage[0].dropped);
+    EXPECT_TRUE(usage[0].droppable);
+    EXPECT_FALSE(usage[0].limit.Enabled());
+    EXPECT_EQ("B/ids", usage[1].name);
+    EXPECT_FALSE(usage[1].droppable);
+
+    // Queues sharing a name are summed
+    {
+      QueueStats::Queue a2("A/msgs", true);
+      a2.Update(3u, 300u);
+      usage = QueueStats::CurrentUsage();
+      ASSERT_EQ(2u, usage.size());
+      EXPECT_EQ(2u, usage[0].count);
+      EXPECT_EQ(5u, usage[0].depth);
+      EXPECT_EQ(500u, usage[0].bytes);
+      EXPECT_EQ(13u, usage[0].maxDepth);
+    }
+
+    // Reset lowers the high-water marks to the current state
+    QueueStats::Reset();
+    usage = QueueStats::CurrentUsage();
+    ASSERT_EQ(2u, usage.size());
+    EXPECT_EQ(1u, usage[0].count);
+    EXPECT_EQ(2u, usage[0].maxDepth);
+    EXPECT_EQ(200u, usage[0].maxBytes);
+    EXPECT_EQ(0u, usage[0].dropped);
+  }
+
+  // Unregistered when destroyed
+  EXPECT_TRUE(QueueStats::CurrentUsage().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(QueueStatsTest, Limit)
+{
+  QueueStats::Limit limit;
+  EXPECT_FALSE(limit.Enabled());
+  EXPECT_FALSE(limit.Exceeded(1000000u, 1000000u));
+
+  limit.depth = 10u;
+  EXPECT_TRUE(limit.Enabled());
+  EXPECT_FALSE(limit.Exceeded(10u, 1000000u));
+  EXPECT_TRUE(limit.Exceeded(11u, 0u));
+
+  limit.depth = 0u;
+  limit.bytes = 100u;
+  EXPECT_FALSE(limit.Exceeded(1000000u, 100u));
+  EXPECT_TRUE(limit.Exceeded(0u, 101u));
+
+  // Set before the queue exists
+  limit.depth = 5u;
+  limit.policy = QueueStats::DropPolicy::kDropNewest;
+  QueueStats::SetLimit("A/msgs", limit);
+  EXPECT_EQ(5u, QueueStats::LimitOf("A/msgs").depth);
+  EXPECT_FALSE(QueueStats::LimitOf("B/ids").Enabled());
+
+  QueueStats::Queue a("A/msgs", true);
+  auto current = a.CurrentLimit();
+  EXPECT_EQ(5u, current.depth);
+  EXPECT_EQ(100u, current.bytes);
+  EXPECT_EQ(QueueStats::DropPolicy::kDropNewest, current.policy);
+
+  // Queues which can't drop messages only report it
+  QueueStats::SetLimit("B/ids", limit);
+  QueueStats::Queue b("B/ids", false);
+  EXPECT_FALSE(b.CurrentLimit().Enabled());
+  auto usage = QueueStats::CurrentUsage();
+  ASSERT_EQ(2u, usage.size());
+  EXPECT_EQ(5u, usage[1].limit.depth);
+
+  // Changed on existing queues
+  limit.depth = 50u;
+  limit.policy = QueueStats::DropPolicy::kDropOldest;
+  QueueStats::SetLimit("A/msgs", limit);
+  EXPECT_EQ(50u, a.CurrentLimit().depth);
+  EXPECT_EQ(QueueStats::DropPolicy::kDropOldest, a.CurrentLimit().policy);
+
+  // Removed
+  QueueStats::SetLimit("A/msgs", QueueStats::Limit());
+  QueueStats::SetLimit("B/ids", QueueStats::Limit());
+  EXPECT_FALSE(a.CurrentLimit().Enabled());
+  EXPECT_FALSE(QueueStats::LimitOf("A/msgs").Enabled());
+}
+
+/////////////////////////////////////////////////
+TEST(QueueStatsTest, PolicyName)
+{
+  EXPECT_EQ("drop_oldest",
+      QueueStats::PolicyName(QueueStats::DropPolicy::kDropOldest));
+  EXPECT_EQ("drop_newest",
+      QueueStats::PolicyName(QueueStats::DropPolicy::kDropNewest));
+
+  auto policy = QueueStats::DropPolicy::kDropOldest;
+  EXPECT_TRUE(QueueStats::PolicyFromName("drop_newest", policy));
+  EXPECT_EQ(QueueStats::DropPolicy::kDropNewest, policy);
+  EXPECT_FALSE(QueueStats::PolicyFromName("block", policy));
+  EXPECT_EQ(QueueStats::DropPolicy::kDropNewest, policy);
+}
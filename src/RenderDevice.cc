@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Util.hh>
+
+#include "gz/gui/RenderDevice.hh"
+
+namespace
+{
+  /// \brief Protects g_selected
+  std::mutex g_mutex;
+
+  /// \brief Device chosen with Select
+  std::string g_selected;
+
+  /// \brief True once Select was called
+  bool g_selectCalled{false};
+
+  /////////////////////////////////////////////////
+  std::string lowercase(std::string _str)
+  {
+    std::transform(_str.begin(), _str.end(), _str.begin(),
+        [](unsigned char _c) {return std::tolower(_c);});
+    return _str;
+  }
+
+  /////////////////////////////////////////////////
+  bool contains(const std::string &_str, const std::string &_sub)
+  {
+    return _str.find(_sub) != std::string::npos;
+  }
+
+  /////////////////////////////////////////////////
+  bool isIndex(const std::string &_str)
+  {
+    return !_str.empty() && std::all_of(_str.begin(), _str.end(),
+        [](unsigned char _c) {return std::isdigit(_c);});
+  }
+}
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+bool RenderDevice::Environment(const std::string &_device,
+    std::vector<std::pair<std::string, std::string>> &_variables)
+{
+  _variables.clear();
+  const auto device = lowercase(_device);
+  const std::string nvidiaPrefix{"nvidia:"};
+
+  if (device.empty())
+    return true;
+
+  if (device == "discrete" || device == "amd")
+  {
+    _variables = {{"DRI_PRIME", "1"}};
+  }
+  else if (device == "nvidia" ||
+      (device.compare(0, nvidiaPrefix.size(), nvidiaPrefix) == 0 &&
+      isIndex(device.substr(nvidiaPrefix.size()))))
+  {
+    _variables = {
+        {"__NV_PRIME_RENDER_OFFLOAD", "1"},
+        {"__GLX_VENDOR_LIBRARY_NAME", "nvidia"},
+        {"__VK_LAYER_NV_optimus", "NVIDIA_only"}};
+    if (device != "nvidia")
+    {
+      _variables.push_back({"__NV_PRIME_RENDER_OFFLOAD_PROVIDER",
+          "NVIDIA-G" + device.substr(nvidiaPrefix.size())});
+    }
+  }
+  else if (device == "integrated" || device == "intel")
+  {
+    _variables = {
+        {"DRI_PRIME", "0"},
+        {"__VK_LAYER_NV_optimus", "non_NVIDIA_only"}};
+  }
+  else if (isIndex(device) || device.compare(0, 4, "pci-") == 0)
+  {
+    _variables = {{"DRI_PRIME", device}};
+  }
+  else if (std::regex_match(device, std::regex("[0-9a-f]{4}:[0-9a-f]{4}")))
+  {
+    _variables = {
+        {"DRI_PRIME", device},
+        {"MESA_VK_DEVICE_SELECT", device}};
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool RenderDevice::Select(const std::string &_device)
+{
+  std::vector<std::pair<std::string, std::string>> variables;
+  if (!Environment(_device, variables))
+  {
+    gzerr << "Invalid render device [" << _device << "], it must be "
+          << "discrete, integrated, nvidia, nvidia:<index>, amd, intel, an "
+          << "index, pci-<bus id> or <vendor id>:<device id>." << std::endl;
+    return false;
+  }
+
+  for (const auto &[name, value] : variables)
+  {
+    std::string current;
+    if (common::env(name, current, true))
+    {
+      gzmsg << "Keeping " << name << "=" << current << " for render device ["
+            << _device << "]" << std::endl;
+      continue;
+    }
+    common::setenv(name, value);
+    gzdbg << "Set " << name << "=" << value << " for render device ["
+          << _device << "]" << std::endl;
+  }
+
+  std::lock_guard<std::mutex> lock(g_mutex);
+  g_selected = _device;
+  g_selectCalled = true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void RenderDevice::SelectFromEnvironment()
+{
+  {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (g_selectCalled)
+      return;
+  }
+
+  std::string device;
+  if (common::env("GZ_GUI_RENDER_DEVICE", device, true))
+    Select(device);
+}
+
+/////////////////////////////////////////////////
+std::string RenderDevice::Selected()
+{
+  std::lock_guard<std::mutex> lock(g_mutex);
+  return g_selected;
+}
+
+/////////////////////////////////////////////////
+bool RenderDevice::Matches(const std::string &_device,
+    const std::string &_vendor, const std::string &_renderer)
+{
+  const auto device = lowercase(_device);
+  if (device.empty())
+    return true;
+
+  const auto reported = lowercase(_vendor + " " + _renderer);
+
+  // Software rasterizers mean the driver of the device couldn't be used
+  if (contains(reported, "llvmpipe") || contains(reported, "softpipe") ||
+      contains(reported, "swrast"))
+  {
+    return false;
+  }
+
+  if (device.compare(0, 6, "nvidia") == 0)
+    return contains(reported, "nvidia");
+  if (device == "amd")
+    return contains(reported, "amd") || contains(reported, "radeon");
+  if (device == "intel")
+    return contains(reported, "intel");
+  if (device == "integrated")
+    return !contains(reported, "nvidia");
+  if (device == "discrete")
+    return !contains(reported, "intel");
+  return true;
+}
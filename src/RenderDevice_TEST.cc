@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Util.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/RenderDevice.hh"
+
+using namespace gz;
+using namespace gui;
+
+using Variables = std::vector<std::pair<std::string, std::string>>;
+
+/////////////////////////////////////////////////
+TEST(RenderDeviceTest, Environment)
+{
+  Variables variables{{"stale", "value"}};
+  EXPECT_TRUE(RenderDevice::Environment("", variables));
+  EXPECT_TRUE(variables.empty());
+
+  EXPECT_TRUE(RenderDevice::Environment("Discrete", variables));
+  EXPECT_EQ((Variables{{"DRI_PRIME", "1"}}), variables);
+
+  EXPECT_TRUE(RenderDevice::Environment("integrated", variables));
+  EXPECT_EQ((Variables{{"DRI_PRIME", "0"},
+      {"__VK_LAYER_NV_optimus", "non_NVIDIA_only"}}), variables);
+
+  EXPECT_TRUE(RenderDevice::Environment("nvidia", variables));
+  EXPECT_EQ((Variables{{"__NV_PRIME_RENDER_OFFLOAD", "1"},
+      {"__GLX_VENDOR_LIBRARY_NAME", "nvidia"},
+      {"__VK_LAYER_NV_optimus", "NVIDIA_only"}}), variables);
+
+  EXPECT_TRUE(RenderDevice::Environment("nvidia:1", variables));
+  ASSERT_EQ(4u, variables.size());
+  EXPECT_EQ("__NV_PRIME_RENDER_OFFLOAD_PROVIDER", variables[3].first);
+  EXPECT_EQ("NVIDIA-G1", variables[3].second);
+
+  EXPECT_TRUE(RenderDevice::Environment("2", variables));
+  EXPECT_EQ((Variables{{"DRI_PRIME", "2"}}), variables);
+
+  EXPECT_TRUE(RenderDevice::Environment("pci-0000_01_00_0", variables));
+  EXPECT_EQ((Variables{{"DRI_PRIME", "pci-0000_01_00_0"}}), variables);
+
+  EXPECT_TRUE(RenderDevice::Environment("1002:73DF", variables));
+  EXPECT_EQ((Variables{{"DRI_PRIME", "1002:73df"},
+      {"MESA_VK_DEVICE_SELECT", "1002:73df"}}), variables);
+
+  EXPECT_FALSE(RenderDevice::Environment("quantum", variables));
+  EXPECT_FALSE(RenderDevice::Environment("nvidia:first", variables));
+  EXPECT_FALSE(RenderDevice::Environment("1002:73", variables));
+}
+
+/////////////////////////////////////////////////
+TEST(RenderDeviceTest, Select)
+{
+  common::unsetenv("DRI_PRIME");
+  common::unsetenv("GZ_GUI_RENDER_DEVICE");
+  EXPECT_TRUE(RenderDevice::Selected().empty());
+
+  EXPECT_FALSE(RenderDevice::Select("quantum"));
+  EXPECT_TRUE(RenderDevice::Selected().empty());
+
+  EXPECT_TRUE(RenderDevice::Select("discrete"));
+  EXPECT_EQ("discrete", RenderDevice::Selected());
+  std::string value;
+  EXPECT_TRUE(common::env("DRI_PRIME", value));
+  EXPECT_EQ("1", value);
+
+  // Variables set by the user are kept
+  EXPECT_TRUE(RenderDevice::Select("integrated"));
+  EXPECT_TRUE(common::env("DRI_PRIME", value));
+  EXPECT_EQ("1", value);
+
+  // The environment doesn't override an explicit choice
+  common::setenv("GZ_GUI_RENDER_DEVICE", "nvidia");
+  RenderDevice::SelectFromEnvironment();
+  EXPECT_EQ("integrated", RenderDevice::Selected());
+
+  common::unsetenv("DRI_PRIME");
+  common::unsetenv("__VK_LAYER_NV_optimus");
+  common::unsetenv("GZ_GUI_RENDER_DEVICE");
+}
+
+/////////////////////////////////////////////////
+TEST(RenderDeviceTest, Matches)
+{
+  const std::string nvidia{"NVIDIA Corporation"};
+  const std::string nvidiaRenderer{"NVIDIA GeForce RTX 3060/PCIe/SSE2"};
+  const std::string intel{"Intel"};
+  const std::string intelRenderer{"Mesa Intel(R) UHD Graphics 620 (KBL GT2)"};
+  const std::string amd{"AMD"};
+  const std::string amdRenderer{"AMD Radeon RX 6700 XT (radeonsi, navi22)"};
+
+  EXPECT_TRUE(RenderDevice::Matches("", intel, intelRenderer));
+
+  EXPECT_TRUE(RenderDevice::Matches("nvidia", nvidia, nvidiaRenderer));
+  EXPECT_TRUE(RenderDevice::Matches("nvidia:1", nvidia, nvidiaRenderer));
+  EXPECT_FALSE(RenderDevice::Matches("nvidia", intel, intelRenderer));
+
+  EXPECT_TRUE(RenderDevice::Matches("amd", amd, amdRenderer));
+  EXPECT_FALSE(RenderDevice::Matches("amd", intel, intelRenderer));
+
+  EXPECT_TRUE(RenderDevice::Matches("intel", intel, intelRenderer));
+  EXPECT_TRUE(RenderDevice::Matches("integrated", intel, intelRenderer));
+  EXPECT_FALSE(RenderDevice::Matches("integrated", nvidia,
+      nvidiaRenderer));
+
+  EXPECT_TRUE(RenderDevice::Matches("discrete", amd, amdRenderer));
+  EXPECT_FALSE(RenderDevice::Matches("discrete", intel, intelRenderer));
+
+  // Can't be told apart
+  EXPECT_TRUE(RenderDevice::Matches("1", intel, intelRenderer));
+
+  // Software rendering never fits a requested device
+  EXPECT_FALSE(RenderDevice::Matches("1", "Mesa",
+      "llvmpipe (LLVM 15.0.7, 256 bits)"));
+}
@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "gz/gui/PluginStats.hh"
+#include "gz/gui/RenderHooks.hh"
+
+namespace
+{
+  /// \brief A registered hook
+  struct Hook
+  {
+    /// \brief Unique identifier
+    uint64_t id{0};
+
+    /// \brief Call order
+    int order{0};
+
+    /// \brief Name used to report timings
+    std::string name;
+
+    /// \brief Function to call
+    gz::gui::RenderHooks::Callback callback;
+
+    /// \brief True to be called for every viewport of a scene
+    bool everyViewport{false};
+
+    /// \brief Duration of the last timed call in milliseconds
+    std::atomic<double> lastMs{0.0};
+
+    /// \brief Cleared on unregister, so a snapshot being iterated skips it
+    std::atomic<bool> active{true};
+
+    /// \brief Held while the hook is called, so unregistering waits for a
+    /// call in progress. Recursive so the hook can unregister itself.
+    std::recursive_mutex callMutex;
+  };
+
+  using HookList = std::vector<std::shared_ptr<Hook>>;
+
+  /// \brief Number of phases in RenderPhase
+  constexpr std::size_t kPhaseCount = 2;
+
+  /// \brief Global hook registry
+  struct Registry
+  {
+    /// \brief Held while modifying the lists and while taking a snapshot,
+    /// not while running hooks
+    std::mutex mutex;
+
+    /// \brief Sorted hooks per phase. Lists are replaced, never modified,
+    /// so they can be iterated while a hook changes the registry.
+    std::shared_ptr<const HookList> lists[kPhaseCount];
+
+    /// \brief Last identifier handed out
+    uint64_t lastId{0};
+
+    /// \brief True to measure each hook
+    std::atomic<bool> timingEnabled{false};
+  };
+
+  /////////////////////////////////////////////////
+  Registry &registry()
+  {
+    // Intentionally leaked, so plugins unloaded at exit can still
+    // unregister.
+    static Registry *reg = new Registry();
+    return *reg;
+  }
+
+  /////////////////////////////////////////////////
+  std::size_t phaseIndex(gz::gui::RenderPhase _phase)
+  {
+    return static_cast<std::size_t>(_phase);
+  }
+
+  /// \brief Scene whose phase is being run on this thread, owned by the
+  /// caller of Run, null outside of it
+  thread_local const std::string *currentScene{nullptr};
+
+  /////////////////////////////////////////////////
+  /// \brief Call a hook unless it was unregistered
+  /// \param[in] _hook Hook
+  /// \param[in] _timed True to measure it
+  /// \return True if it was called
+  bool call(Hook &_hook, bool _timed)
+  {
+    std::lock_guard<std::recursive_mutex> lock(_hook.callMutex);
+    if (!_hook.active)
+      return false;
+
+    if (!_timed)
+    {
+      _hook.callback();
+      return true;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    _hook.callback();
+    _hook.lastMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    return true;
+  }
+}
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+uint64_t RenderHooks::Register(RenderPhase _phase, Callback _callback,
+    int _order, const std::string &_name, bool _everyViewport)
+{
+  auto index = phaseIndex(_phase);
+  if (index >= kPhaseCount)
+  {
+    gzerr << "Invalid render phase [" << static_cast<int>(_phase) << "]"
+          << std::endl;
+    return 0;
+  }
+
+  if (!_callback)
+  {
+    gzerr << "Can't register empty render hook" << std::endl;
+    return 0;
+  }
+
+  auto hook = std::make_shared<Hook>();
+  hook->order = _order;
+  hook->name = _name;
+  hook->callback = std::move(_callback);
+  hook->everyViewport = _everyViewport;
+
+  auto &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+
+  hook->id = ++reg.lastId;
+
+  auto list = reg.lists[index] ? std::make_shared<HookList>(*reg.lists[index])
+      : std::make_shared<HookList>();
+
+  // Insert after every hook with the same or lower order
+  auto it = std::upper_bound(list->begin(), list->end(), _order,
+      [](int _o, const std::shared_ptr<Hook> &_h)
+      {
+        return _o < _h->order;
+      });
+  list->insert(it, hook);
+
+  reg.lists[index] = std::move(list);
+  return hook->id;
+}
+
+/////////////////////////////////////////////////
+bool RenderHooks::Unregister(uint64_t _id)
+{
+  if (_id == 0)
+    return false;
+
+  std::shared_ptr<Hook> hook;
+  {
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    for (auto &current : reg.lists)
+    {
+      if (!current)
+        continue;
+
+      auto it = std::find_if(current->begin(), current->end(),
+          [&](const std::shared_ptr<Hook> &_h)
+          {
+            return _h->id == _id;
+          });
+      if (it == current->end())
+        continue;
+
+      hook = *it;
+      hook->active = false;
+
+      auto list = std::make_shared<HookList>(*current);
+      list->erase(list->begin() + (it - current->begin()));
+      current = std::move(list);
+      break;
+    }
+  }
+  if (!hook)
+    return false;
+
+  // Wait for a call in progress on another thread, without holding the
+  // registry, so other hooks keep running and registering meanwhile
+  std::lock_guard<std::recursive_mutex> wait(hook->callMutex);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void RenderHooks::Run(RenderPhase _phase, const std::string &_scene,
+    bool _firstViewport)
+{
+  auto index = phaseIndex(_phase);
+  if (index >= kPhaseCount)
+    return;
+
+  // The snapshot stays valid while hooks change the registry, so the lock
+  // is only held to copy it
+  auto &reg = registry();
+  std::shared_ptr<const HookList> list;
+  {
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    list = reg.lists[index];
+  }
+  if (!list)
+    return;
+
+  // Restored after, in case a hook runs another scene's phase
+  auto previousScene = currentScene;
+  currentScene = &_scene;
+
+  // Hooks are also timed for the plugin accounting
+  bool stats = PluginStats::Enabled();
+  bool timed = reg.timingEnabled || stats;
+  for (const auto &hook : *list)
+  {
+    if (!_firstViewport && !hook->everyViewport)
+      continue;
+
+    if (call(*hook, timed) && stats)
+    {
+      PluginStats::Record(hook->name.empty() ?
+          "hook_" + std::to_string(hook->id) : hook->name,
+          PluginStats::Source::kRenderHooks, hook->lastMs);
+    }
+  }
+
+  currentScene = previousScene;
+}
+
+/////////////////////////////////////////////////
+std::string RenderHooks::Scene()
+{
+  return nullptr == currentScene ? std::string() : *currentScene;
+}
+
+/////////////////////////////////////////////////
+bool RenderHooks::RunsFor(const std::string &_scene)
+{
+  return nullptr == currentScene || currentScene->empty() ||
+      *currentScene == _scene;
+}
+
+/////////////////////////////////////////////////
+std::size_t RenderHooks::Count(RenderPhase _phase)
+{
+  auto index = phaseIndex(_phase);
+  if (index >= kPhaseCount)
+    return 0;
+
+  auto &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  return reg.lists[index] ? reg.lists[index]->size() : 0;
+}
+
+/////////////////////////////////////////////////
+void RenderHooks::SetTimingEnabled(bool _enabled)
+{
+  registry().timingEnabled = _enabled;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::pair<std::string, double>> RenderHooks::Timings(
+    RenderPhase _phase)
+{
+  std::vector<std::pair<std::string, double>> timings;
+
+  auto index = phaseIndex(_phase);
+  if (index >= kPhaseCount)
+    return timings;
+
+  auto &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  if (!reg.lists[index])
+    return timings;
+
+  for (const auto &hook : *reg.lists[index])
+  {
+    timings.emplace_back(hook->name.empty() ?
+        "hook_" + std::to_string(hook->id) : hook->name, hook->lastMs);
+  }
+  return timings;
+}
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/RenderHooks.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(RenderHooksTest, RegisterUnregister)
+{
+  EXPECT_EQ(0u, RenderHooks::Count(RenderPhase::kPreRender));
+  EXPECT_EQ(0u, RenderHooks::Count(RenderPhase::kRender));
+
+  int calls{0};
+  auto id = RenderHooks::Register(RenderPhase::kRender, [&]{++calls;});
+  EXPECT_NE(0u, id);
+  EXPECT_EQ(0u, RenderHooks::Count(RenderPhase::kPreRender));
+  EXPECT_EQ(1u, RenderHooks::Count(RenderPhase::kRender));
+
+  RenderHooks::Run(RenderPhase::kPreRender);
+  EXPECT_EQ(0, calls);
+
+  RenderHooks::Run(RenderPhase::kRender);
+  RenderHooks::Run(RenderPhase::kRender);
+  EXPECT_EQ(2, calls);
+
+  EXPECT_TRUE(RenderHooks::Unregister(id));
+  EXPECT_FALSE(RenderHooks::Unregister(id));
+  EXPECT_EQ(0u, RenderHooks::Count(RenderPhase::kRender));
+
+  RenderHooks::Run(RenderPhase::kRender);
+  EXPECT_EQ(2, calls);
+
+  // Invalid
+  EXPECT_EQ(0u, RenderHooks::Register(RenderPhase::kRender, nullptr));
+  EXPECT_FALSE(RenderHooks::Unregister(0));
+}
+
+/////////////////////////////////////////////////
+TEST(RenderHooksTest, Order)
+{
+  std::vector<int> calls;
+  auto a = RenderHooks::Register(RenderPhase::kPreRender,
+      [&]{calls.push_back(1);}, 10);
+  auto b = RenderHooks::Register(RenderPhase::kPreRender,
+      [&]{calls.push_back(2);}, -5);
+  auto c = RenderHooks::Register(RenderPhase::kPreRender,
+      [&]{calls.push_back(3);}, 10);
+  auto d = RenderHooks::Register(RenderPhase::kPreRender,
+      [&]{calls.push_back(4);});
+
+  RenderHooks::Run(RenderPhase::kPreRender);
+  EXPECT_EQ((std::vector<int>{2, 4, 1, 3}), calls);
+
+  EXPECT_TRUE(RenderHooks::Unregister(a));
+  EXPECT_TRUE(RenderHooks::Unregister(b));
+  EXPECT_TRUE(RenderHooks::Unregister(c));
+  EXPECT_TRUE(RenderHooks::Unregister(d));
+  EXPECT_EQ(0u, RenderHooks::Count(RenderPhase::kPreRender));
+}
+
+/////////////////////////////////////////////////
+TEST(RenderHooksTest, ModifyWhileRunning)
+{
+  int firstCalls{0};
+  int secondCalls{0};
+  int addedCalls{0};
+  uint64_t second{0};
+  uint64_t added{0};
+
+  // The first hook unregisters the second and registers a new one
+  auto first = RenderHooks::Register(RenderPhase::kRender, [&]
+      {
+        ++firstCalls;
+        RenderHooks::Unregister(second);
+        if (added == 0)
+        {
+          added = RenderHooks::Register(RenderPhase::kRender,
+              [&]{++addedCalls;});
+        }
+      });
+  second = RenderHooks::Register(RenderPhase::kRender, [&]{++secondCalls;});
+
+  // Unregistered hook isn't called, new hook waits for the next run
+  RenderHooks::Run(RenderPhase::kRender);
+  EXPECT_EQ(1, firstCalls);
+  EXPECT_EQ(0, secondCalls);
+  EXPECT_EQ(0, addedCalls);
+
+  RenderHooks::Run(RenderPhase::kRender);
+  EXPECT_EQ(2, firstCalls);
+  EXPECT_EQ(0, secondCalls);
+  EXPECT_EQ(1, addedCalls);
+
+  EXPECT_TRUE(RenderHooks::Unregister(first));
+  EXPECT_TRUE(RenderHooks::Unregister(added));
+}
+
+/////////////////////////////////////////////////
+TEST(RenderHooksTest, Timings)
+{
+  auto named = RenderHooks::Register(RenderPhase::kPreRender, []
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      }, 0, "Sleepy");
+  auto unnamed = RenderHooks::Register(RenderPhase::kPreRender, []{});
+
+  // Not measured while disabled
+  RenderHooks::Run(RenderPhase::kPreRender);
+  auto timings = RenderHooks::Timings(RenderPhase::kPreRender);
+  ASSERT_EQ(2u, timings.size());
+  EXPECT_EQ("Sleepy", timings[0].first);
+  EXPECT_DOUBLE_EQ(0.0, timings[0].second);
+  EXPECT_EQ("hook_" + std::to_string(unnamed), timings[1].first);
+
+  RenderHooks::SetTimingEnabled(true);
+  RenderHooks::Run(RenderPhase::kPreRender);
+  RenderHooks::SetTimingEnabled(false);
+
+  timings = RenderHooks::Timings(RenderPhase::kPreRender);
+  ASSERT_EQ(2u, timings.size());
+  EXPECT_LE(2.0, timings[0].second);
+  EXPECT_LE(0.0, timings[1].second);
+
+  EXPECT_TRUE(RenderHooks::Timings(RenderPhase::kRender).empty());
+
+  EXPECT_TRUE(RenderHooks::Unregister(named));
+  EXPECT_TRUE(RenderHooks::Unregister(unnamed));
+}
+
+/////////////////////////////////////////////////
+TEST(RenderHooksTest, RegisterWhileRunningOnAnotherThread)
+{
+  std::atomic<bool> started{false};
+  std::atomic<bool> release{false};
+  auto slow = RenderHooks::Register(RenderPhase::kRender, [&]
+      {
+        started = true;
+        while (!release)
+          std::this_thread::yield();
+      });
+
+  std::thread render([]{RenderHooks::Run(RenderPhase::kRender);});
+  while (!started)
+    std::this_thread::yield();
+
+  // Other hooks are registered and unregistered without waiting for the
+  // frame
+  auto other = RenderHooks::Register(RenderPhase::kPreRender, []{});
+  EXPECT_NE(0u, other);
+  EXPECT_TRUE(RenderHooks::Unregister(other));
+
+  // Unregistering the running hook waits for it
+  std::atomic<bool> unregistered{false};
+  std::thread gui([&]
+      {
+        RenderHooks::Unregister(slow);
+        unregistered = true;
+      });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_FALSE(unregistered);
+
+  release = true;
+  gui.join();
+  render.join();
+  EXPECT_TRUE(unregistered);
+  EXPECT_EQ(0u, RenderHooks::Count(RenderPhase::kRender));
+}
+
+/////////////////////////////////////////////////
+TEST(RenderHooksTest, Scenes)
+{
+  std::vector<std::string> scenes;
+  int everyViewportCalls{0};
+  auto once = RenderHooks::Register(RenderPhase::kRender, [&]
+      {
+        scenes.push_back(RenderHooks::Scene());
+        EXPECT_TRUE(RenderHooks::RunsFor(RenderHooks::Scene()));
+      });
+  auto every = RenderHooks::Register(RenderPhase::kRender,
+      [&]{++everyViewportCalls;}, 0, "Every", true);
+
+  EXPECT_TRUE(RenderHooks::Scene().empty());
+  EXPECT_TRUE(RenderHooks::RunsFor("a"));
+
+  // Scene "a" with two viewports, then scene "b"
+  RenderHooks::Run(RenderPhase::kRender, "a");
+  RenderHooks::Run(RenderPhase::kRender, "a", false);
+  RenderHooks::Run(RenderPhase::kRender, "b");
+
+  ASSERT_EQ(2u, scenes.size());
+  EXPECT_EQ("a", scenes[0]);
+  EXPECT_EQ("b", scenes[1]);
+  EXPECT_EQ(3, everyViewportCalls);
+  EXPECT_TRUE(RenderHooks::Scene().empty());
+
+  // Hooks for one scene skip the others
+  int aCalls{0};
+  auto onlyA = RenderHooks::Register(RenderPhase::kPreRender, [&]
+      {
+        if (RenderHooks::RunsFor("a"))
+          ++aCalls;
+      });
+  RenderHooks::Run(RenderPhase::kPreRender, "a");
+  RenderHooks::Run(RenderPhase::kPreRender, "b");
+  EXPECT_EQ(1, aCalls);
+
+  EXPECT_TRUE(RenderHooks::Unregister(once));
+  EXPECT_TRUE(RenderHooks::Unregister(every));
+  EXPECT_TRUE(RenderHooks::Unregister(onlyA));
+}
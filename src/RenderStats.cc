@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gz/gui/RenderStats.hh"
+
+namespace
+{
+  /// \brief Global state
+  struct Stats
+  {
+    /// \brief Protects everything
+    std::mutex mutex;
+
+    /// \brief Latest counts, by camera name
+    std::map<std::string, gz::gui::RenderStats::Frame> frames;
+
+    /// \brief Ids of static visuals
+    std::set<unsigned int> staticVisuals;
+  };
+
+  /////////////////////////////////////////////////
+  Stats &stats()
+  {
+    static Stats instance;
+    return instance;
+  }
+}
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+void RenderStats::Record(const std::string &_camera, const Frame &_frame)
+{
+  auto &s = stats();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.frames[_camera] = _frame;
+}
+
+/////////////////////////////////////////////////
+bool RenderStats::Latest(const std::string &_camera, Frame &_frame)
+{
+  auto &s = stats();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  auto it = s.frames.find(_camera);
+  if (it == s.frames.end())
+    return false;
+  _frame = it->second;
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> RenderStats::Cameras()
+{
+  auto &s = stats();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  std::vector<std::string> cameras;
+  cameras.reserve(s.frames.size());
+  for (const auto &frame : s.frames)
+    cameras.push_back(frame.first);
+  return cameras;
+}
+
+/////////////////////////////////////////////////
+void RenderStats::Remove(const std::string &_camera)
+{
+  auto &s = stats();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.frames.erase(_camera);
+}
+
+/////////////////////////////////////////////////
+void RenderStats::SetStatic(unsigned int _id, bool _static)
+{
+  auto &s = stats();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  if (_static)
+    s.staticVisuals.insert(_id);
+  else
+    s.staticVisuals.erase(_id);
+}
+
+/////////////////////////////////////////////////
+bool RenderStats::IsStatic(unsigned int _id)
+{
+  auto &s = stats();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  return s.staticVisuals.count(_id) > 0u;
+}
+
+/////////////////////////////////////////////////
+std::vector<unsigned int> RenderStats::StaticVisuals()
+{
+  auto &s = stats();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  return {s.staticVisuals.begin(), s.staticVisuals.end()};
+}
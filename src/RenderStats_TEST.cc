@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/RenderStats.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(RenderStatsTest, Frames)
+{
+  RenderStats::Frame frame;
+  EXPECT_FALSE(RenderStats::Latest("camera", frame));
+  EXPECT_TRUE(RenderStats::Cameras().empty());
+
+  frame.drawCalls = 10u;
+  frame.triangles = 1200u;
+  frame.visibleNodes = 8u;
+  frame.culledNodes = 4u;
+  frame.batches = 3u;
+  RenderStats::Record("camera", frame);
+
+  RenderStats::Frame latest;
+  ASSERT_TRUE(RenderStats::Latest("camera", latest));
+  EXPECT_EQ(10u, latest.drawCalls);
+  EXPECT_EQ(1200u, latest.triangles);
+  EXPECT_EQ(8u, latest.visibleNodes);
+  EXPECT_EQ(4u, latest.culledNodes);
+  EXPECT_EQ(3u, latest.batches);
+  EXPECT_EQ(0u, latest.staticNodes);
+
+  // Replaced by the next frame
+  frame.drawCalls = 2u;
+  RenderStats::Record("camera", frame);
+  RenderStats::Record("other", RenderStats::Frame());
+  ASSERT_TRUE(RenderStats::Latest("camera", latest));
+  EXPECT_EQ(2u, latest.drawCalls);
+  EXPECT_EQ((std::vector<std::string>{"camera", "other"}),
+      RenderStats::Cameras());
+
+  RenderStats::Remove("camera");
+  EXPECT_FALSE(RenderStats::Latest("camera", latest));
+  RenderStats::Remove("other");
+  EXPECT_TRUE(RenderStats::Cameras().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(RenderStatsTest, Static)
+{
+  EXPECT_FALSE(RenderStats::IsStatic(5u));
+
+  RenderStats::SetStatic(5u, true);
+  RenderStats::SetStatic(3u, true);
+  RenderStats::SetStatic(5u, true);
+  EXPECT_TRUE(RenderStats::IsStatic(5u));
+  EXPECT_TRUE(RenderStats::IsStatic(3u));
+  EXPECT_EQ((std::vector<unsigned int>{3u, 5u}),
+      RenderStats::StaticVisuals());
+
+  RenderStats::SetStatic(5u, false);
+  EXPECT_FALSE(RenderStats::IsStatic(5u));
+  EXPECT_EQ(std::vector<unsigned int>{3u}, RenderStats::StaticVisuals());
+
+  // Unmarking a visual which isn't marked does nothing
+  RenderStats::SetStatic(7u, false);
+  EXPECT_EQ(std::vector<unsigned int>{3u}, RenderStats::StaticVisuals());
+}
@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "gz/gui/SamplingProfiler.hh"
+
+namespace
+{
+  /// \brief Zone stack of a thread. It's written by its thread without
+  /// locking and read by the sampling thread, so a sample may miss a zone
+  /// which is being pushed or popped, which doesn't matter statistically.
+  struct ThreadStack
+  {
+    /// \brief Names of the zones, the outermost first
+    std::array<std::atomic<const char *>,
+        gz::gui::SamplingProfiler::kMaxDepth> names{};
+
+    /// \brief Number of zones, including those deeper than kMaxDepth
+    std::atomic<int> depth{0};
+
+    /// \brief True once the thread exited
+    std::atomic<bool> exited{false};
+
+    /// \brief Name of the thread, protected by the profile's mutex
+    std::string name;
+  };
+
+  /// \brief Global profiler state
+  struct Profile
+  {
+    /// \brief Stop the sampling thread, if it wasn't stopped
+    ~Profile()
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+      }
+      this->stopCondition.notify_all();
+      if (this->sampler.joinable())
+        this->sampler.join();
+    }
+
+    /// \brief Protects everything but running
+    std::mutex mutex;
+
+    /// \brief Checked by zones before touching their stack
+    std::atomic<bool> running{false};
+
+    /// \brief Stacks of the threads which pushed a zone or were named
+    std::vector<std::shared_ptr<ThreadStack>> threads;
+
+    /// \brief Number of samples per folded stack
+    std::map<std::string, uint64_t> counts;
+
+    /// \brief File the profile is written to
+    std::string path;
+
+    /// \brief Period of the samples
+    std::chrono::microseconds period{50000};
+
+    /// \brief Wakes the sampling thread up to stop
+    std::condition_variable stopCondition;
+
+    /// \brief True when the sampling thread should stop
+    bool stopping{false};
+
+    /// \brief Thread taking the samples
+    std::thread sampler;
+  };
+
+  /////////////////////////////////////////////////
+  Profile &profile()
+  {
+    static Profile instance;
+    return instance;
+  }
+
+  /// \brief Marks the stack of a thread as exited when the thread ends
+  struct ThreadHolder
+  {
+    /// \brief Destructor
+    ~ThreadHolder()
+    {
+      if (this->stack)
+        this->stack->exited = true;
+    }
+
+    /// \brief Stack of the thread, null until it's needed
+    std::shared_ptr<ThreadStack> stack;
+  };
+
+  /////////////////////////////////////////////////
+  /// \brief Get the stack of the calling thread, registering it the first
+  /// time
+  /// \return Stack, never null
+  ThreadStack *threadStack()
+  {
+    thread_local ThreadHolder holder;
+    if (!holder.stack)
+    {
+      holder.stack = std::make_shared<ThreadStack>();
+      auto &p = profile();
+      std::lock_guard<std::mutex> lock(p.mutex);
+      holder.stack->name = "Thread " + std::to_string(p.threads.size());
+      p.threads.push_back(holder.stack);
+    }
+    return holder.stack.get();
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Sample the stacks of all the threads. Must be called with the
+  /// mutex locked.
+  void sample(Profile &_profile)
+  {
+    std::string folded;
+    for (auto it = _profile.threads.begin(); it != _profile.threads.end();)
+    {
+      const auto &stack = **it;
+      folded = stack.name;
+      int depth = std::min(stack.depth.load(std::memory_order_acquire),
+          gz::gui::SamplingProfiler::kMaxDepth);
+      for (int i = 0; i < depth; ++i)
+      {
+        auto name = stack.names[i].load(std::memory_order_relaxed);
+        if (nullptr == name)
+          break;
+        folded += ';';
+        folded += name;
+      }
+
+      // Threads which exited have nothing more to sample
+      if (stack.exited)
+      {
+        it = _profile.threads.erase(it);
+        continue;
+      }
+      ++_profile.counts[folded];
+      ++it;
+    }
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Replace the separators of the folded format in a name
+  std::string sanitize(std::string _name)
+  {
+    for (auto &c : _name)
+    {
+      if (c == ';' || c == '\n')
+        c = '_';
+    }
+    return _name;
+  }
+}
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+SamplingProfiler::Zone::Zone(const char *_name)
+{
+  auto &p = profile();
+  if (!p.running.load(std::memory_order_relaxed))
+    return;
+
+  auto stack = threadStack();
+  int depth = stack->depth.load(std::memory_order_relaxed);
+  if (depth < kMaxDepth)
+    stack->names[depth].store(_name, std::memory_order_relaxed);
+  stack->depth.store(depth + 1, std::memory_order_release);
+  this->pushed = true;
+}
+
+/////////////////////////////////////////////////
+SamplingProfiler::Zone::~Zone()
+{
+  if (!this->pushed)
+    return;
+
+  auto stack = threadStack();
+  stack->depth.store(stack->depth.load(std::memory_order_relaxed) - 1,
+      std::memory_order_release);
+}
+
+/////////////////////////////////////////////////
+bool SamplingProfiler::Start(const std::string &_path, double _rateHz)
+{
+  if (_rateHz < 1.0 || _rateHz > 1000.0)
+  {
+    gzerr << "Invalid sampling rate [" << _rateHz << "] Hz, expected "
+          << "between 1 and 1000" << std::endl;
+    return false;
+  }
+
+  auto &p = profile();
+  std::unique_lock<std::mutex> lock(p.mutex);
+  if (p.sampler.joinable())
+  {
+    p.stopping = true;
+    lock.unlock();
+    p.stopCondition.notify_all();
+    p.sampler.join();
+    lock.lock();
+  }
+
+  p.path = _path;
+  p.counts.clear();
+  p.period = std::chrono::microseconds(
+      static_cast<int64_t>(1000000.0 / _rateHz));
+  p.stopping = false;
+  p.running = true;
+  p.sampler = std::thread([&p]()
+  {
+    std::unique_lock<std::mutex> samplerLock(p.mutex);
+    auto next = std::chrono::steady_clock::now() + p.period;
+    while (!p.stopCondition.wait_until(samplerLock, next,
+        [&p] { return p.stopping; }))
+    {
+      sample(p);
+      next += p.period;
+    }
+  });
+
+  gzmsg << "Sampling profiler started at [" << _rateHz << "] Hz"
+        << std::endl;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SamplingProfiler::Running()
+{
+  return profile().running;
+}
+
+/////////////////////////////////////////////////
+bool SamplingProfiler::Stop()
+{
+  auto &p = profile();
+  std::unique_lock<std::mutex> lock(p.mutex);
+  if (!p.running)
+    return false;
+
+  p.running = false;
+  p.stopping = true;
+  lock.unlock();
+  p.stopCondition.notify_all();
+  if (p.sampler.joinable())
+    p.sampler.join();
+  lock.lock();
+
+  std::ofstream file(p.path);
+  if (!file.is_open())
+  {
+    gzerr << "Failed to write sampling profile [" << p.path << "]"
+          << std::endl;
+    return false;
+  }
+
+  uint64_t samples{0u};
+  for (const auto &count : p.counts)
+  {
+    file << count.first << " " << count.second << "\n";
+    samples += count.second;
+  }
+
+  gzmsg << "Wrote sampling profile with " << samples << " samples of "
+        << p.counts.size() << " stacks to [" << p.path << "]" << std::endl;
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string SamplingProfiler::Path()
+{
+  auto &p = profile();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  return p.path;
+}
+
+/////////////////////////////////////////////////
+void SamplingProfiler::SetThreadName(const std::string &_name)
+{
+  auto stack = threadStack();
+  auto &p = profile();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  stack->name = sanitize(_name);
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+
+#include <gz/common/Filesystem.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/SamplingProfiler.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Read a folded profile
+/// \param[in] _path File
+/// \return Count of each stack
+static std::map<std::string, uint64_t> readProfile(const std::string &_path)
+{
+  std::map<std::string, uint64_t> counts;
+  std::ifstream file(_path);
+  std::string line;
+  while (std::getline(file, line))
+  {
+    auto space = line.rfind(' ');
+    if (space == std::string::npos)
+      continue;
+    counts[line.substr(0, space)] = std::stoull(line.substr(space + 1));
+  }
+  return counts;
+}
+
+/////////////////////////////////////////////////
+TEST(SamplingProfilerTest, Sample)
+{
+  auto path = common::joinPaths(std::string(PROJECT_BINARY_PATH),
+      "sampling_profiler_TEST.folded");
+
+  EXPECT_FALSE(SamplingProfiler::Running());
+  EXPECT_FALSE(SamplingProfiler::Stop());
+  EXPECT_FALSE(SamplingProfiler::Start(path, 0.0));
+  EXPECT_FALSE(SamplingProfiler::Running());
+
+  std::atomic<bool> started{false};
+  std::atomic<bool> done{false};
+  std::thread worker([&]()
+  {
+    // Named before the profiler starts
+    SamplingProfiler::SetThreadName("Worker;1");
+
+    while (!SamplingProfiler::Running())
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    SamplingProfiler::Zone outer("Outer");
+    SamplingProfiler::Zone inner("Inner");
+    started = true;
+    while (!done)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  });
+
+  // Not pushed, since it started before the profiler
+  SamplingProfiler::Zone before("Before");
+
+  EXPECT_TRUE(SamplingProfiler::Start(path, 200.0));
+  EXPECT_TRUE(SamplingProfiler::Running());
+  EXPECT_EQ(path, SamplingProfiler::Path());
+
+  while (!started)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  EXPECT_TRUE(SamplingProfiler::Stop());
+  EXPECT_FALSE(SamplingProfiler::Running());
+  done = true;
+  worker.join();
+
+  auto counts = readProfile(path);
+  ASSERT_NE(counts.end(), counts.find("Worker_1;Outer;Inner"));
+  EXPECT_GT(counts["Worker_1;Outer;Inner"], 10u);
+  for (const auto &count : counts)
+    EXPECT_EQ(std::string::npos, count.first.find("Before"));
+
+  common::removeFile(path);
+}
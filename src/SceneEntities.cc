@@ -0,0 +1,508 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/SceneEntities.hh"
+
+namespace gz
+{
+  namespace gui
+  {
+    /// \brief Queued change
+    struct SceneChange
+    {
+      /// \brief Kind of change
+      enum class Kind
+      {
+        kAdd,
+        kRemove,
+        kClear,
+        kSelect
+      };
+
+      /// \brief Kind of change
+      Kind kind{Kind::kAdd};
+
+      /// \brief Entities added, for kAdd
+      std::vector<SceneEntities::Entity> entities;
+
+      /// \brief Entities removed, for kRemove
+      std::vector<unsigned int> ids;
+
+      /// \brief Rendering Id of the selected entity, for kSelect
+      unsigned int renderId{0u};
+    };
+
+    /// \brief Entity in the hierarchy
+    struct SceneNode
+    {
+      /// \brief Description
+      SceneEntities::Entity entity;
+
+      /// \brief Children, in the order they were added
+      std::vector<unsigned int> children;
+
+      /// \brief Index among its parent's children
+      std::size_t row{0u};
+
+      /// \brief Entry in the name index, names.end() for empty names
+      std::multimap<std::string, unsigned int>::iterator name;
+    };
+
+    class SceneEntitiesPrivate
+    {
+      /// \brief Queue a change and make sure it's flushed
+      /// \param[in] _entities Object to flush
+      /// \param[in] _change Change to queue
+      public: void Queue(SceneEntities *_entities, SceneChange &&_change);
+
+      /// \brief Get the children of an entity, the top level ones for 0
+      /// \param[in] _id Entity Id
+      /// \return Children, null if the entity isn't known
+      public: std::vector<unsigned int> *Children(unsigned int _id);
+
+      /// \brief Add entities
+      /// \param[in] _entities Object emitting the signals
+      /// \param[in] _added Entities to add, after their parents
+      public: void Add(SceneEntities *_entities,
+                       const std::vector<SceneEntities::Entity> &_added);
+
+      /// \brief Remove entities and their descendants
+      /// \param[in] _entities Object emitting the signals
+      /// \param[in] _ids Entity Ids
+      public: void Remove(SceneEntities *_entities,
+                          const std::vector<unsigned int> &_ids);
+
+      /// \brief Forget an entity and its descendants, without touching
+      /// its parent's children
+      /// \param[in] _id Entity Id
+      public: void Erase(unsigned int _id);
+
+      /// \brief Protects changes and flushQueued
+      public: std::mutex mutex;
+
+      /// \brief Changes not applied yet, in order
+      public: std::vector<SceneChange> changes;
+
+      /// \brief True if a flush is queued on the GUI thread
+      public: bool flushQueued{false};
+
+      /// \brief Entities by Id
+      public: std::unordered_map<unsigned int, SceneNode> nodes;
+
+      /// \brief Top level entities
+      public: std::vector<unsigned int> top;
+
+      /// \brief Entity Ids by lower case name
+      public: std::multimap<std::string, unsigned int> names;
+
+      /// \brief Entity Ids by rendering Id
+      public: std::unordered_map<unsigned int, unsigned int> rendered;
+
+      /// \brief Selected entity, 0 if none
+      public: unsigned int selected{0u};
+    };
+  }
+}
+
+using namespace gz;
+using namespace gui;
+
+namespace
+{
+  /////////////////////////////////////////////////
+  std::string lowercase(const std::string &_str)
+  {
+    std::string result(_str);
+    std::transform(result.begin(), result.end(), result.begin(),
+        [](unsigned char _c) {return static_cast<char>(std::tolower(_c));});
+    return result;
+  }
+}
+
+/////////////////////////////////////////////////
+void SceneEntitiesPrivate::Queue(SceneEntities *_entities,
+    SceneChange &&_change)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->changes.push_back(std::move(_change));
+  if (this->flushQueued)
+    return;
+  this->flushQueued = true;
+  QMetaObject::invokeMethod(_entities, "Flush", Qt::QueuedConnection);
+}
+
+/////////////////////////////////////////////////
+std::vector<unsigned int> *SceneEntitiesPrivate::Children(unsigned int _id)
+{
+  if (_id == 0u)
+    return &this->top;
+  auto it = this->nodes.find(_id);
+  return it == this->nodes.end() ? nullptr : &it->second.children;
+}
+
+/////////////////////////////////////////////////
+void SceneEntitiesPrivate::Add(SceneEntities *_entities,
+    const std::vector<SceneEntities::Entity> &_added)
+{
+  // Consecutive siblings are added at once
+  std::size_t begin{0u};
+  while (begin < _added.size())
+  {
+    std::size_t end = begin + 1;
+    while (end < _added.size() &&
+        _added[end].parent == _added[begin].parent)
+    {
+      ++end;
+    }
+
+    // Known entities are replaced
+    std::vector<unsigned int> known;
+    for (auto i = begin; i < end; ++i)
+    {
+      if (this->nodes.count(_added[i].id) > 0u)
+        known.push_back(_added[i].id);
+    }
+    if (!known.empty())
+      this->Remove(_entities, known);
+
+    unsigned int parent = _added[begin].parent;
+    auto children = this->Children(parent);
+    if (nullptr == children)
+    {
+      parent = 0u;
+      children = &this->top;
+    }
+
+    // Ids are only added once
+    std::vector<const SceneEntities::Entity *> run;
+    std::unordered_set<unsigned int> ids;
+    for (auto i = begin; i < end; ++i)
+    {
+      if (_added[i].id != 0u && ids.insert(_added[i].id).second)
+        run.push_back(&_added[i]);
+    }
+    begin = end;
+    if (run.empty())
+      continue;
+
+    int first = static_cast<int>(children->size());
+    int last = first + static_cast<int>(run.size()) - 1;
+    _entities->ChildrenAboutToBeAdded(parent, first, last);
+    for (auto entityPtr : run)
+    {
+      const auto &entity = *entityPtr;
+      auto &node = this->nodes[entity.id];
+      node.entity = entity;
+      node.entity.parent = parent;
+      node.row = children->size();
+      node.name = entity.name.empty() ? this->names.end() :
+          this->names.emplace(lowercase(entity.name), entity.id);
+      if (entity.renderId != 0u)
+        this->rendered[entity.renderId] = entity.id;
+      children->push_back(entity.id);
+    }
+    _entities->ChildrenAdded(parent, first, last);
+  }
+}
+
+/////////////////////////////////////////////////
+void SceneEntitiesPrivate::Remove(SceneEntities *_entities,
+    const std::vector<unsigned int> &_ids)
+{
+  std::unordered_set<unsigned int> removed;
+  for (auto id : _ids)
+  {
+    if (this->nodes.count(id) > 0u)
+      removed.insert(id);
+  }
+
+  // Descendants of removed entities go with them, the others are grouped
+  // by parent
+  std::map<unsigned int, std::vector<std::size_t>> rows;
+  for (auto id : removed)
+  {
+    const auto &node = this->nodes[id];
+    bool ancestorRemoved{false};
+    for (auto parent = node.entity.parent; parent != 0u && !ancestorRemoved;)
+    {
+      ancestorRemoved = removed.count(parent) > 0u;
+      auto it = this->nodes.find(parent);
+      parent = it == this->nodes.end() ? 0u : it->second.entity.parent;
+    }
+    if (!ancestorRemoved)
+      rows[node.entity.parent].push_back(node.row);
+  }
+
+  bool selectionRemoved{false};
+  for (auto &parentRows : rows)
+  {
+    auto parent = parentRows.first;
+    auto &indices = parentRows.second;
+    std::sort(indices.begin(), indices.end(), std::greater<std::size_t>());
+
+    // From the end, so the rows of earlier runs don't change
+    std::size_t i{0u};
+    while (i < indices.size())
+    {
+      std::size_t last = indices[i];
+      std::size_t first = last;
+      while (i + 1 < indices.size() && indices[i + 1] + 1 == first)
+        first = indices[++i];
+      ++i;
+
+      _entities->ChildrenAboutToBeRemoved(parent, static_cast<int>(first),
+          static_cast<int>(last));
+      auto children = this->Children(parent);
+      for (auto row = first; row <= last; ++row)
+      {
+        auto id = (*children)[row];
+        selectionRemoved = selectionRemoved || id == this->selected;
+        this->Erase(id);
+      }
+      children->erase(children->begin() + first,
+          children->begin() + last + 1);
+      for (auto row = first; row < children->size(); ++row)
+        this->nodes[(*children)[row]].row = row;
+      _entities->ChildrenRemoved(parent, static_cast<int>(first),
+          static_cast<int>(last));
+    }
+  }
+
+  // The selection may also be a descendant of a removed entity
+  if (this->selected != 0u && this->nodes.count(this->selected) == 0u)
+    selectionRemoved = true;
+  if (selectionRemoved)
+  {
+    this->selected = 0u;
+    _entities->SelectionChanged(0u);
+  }
+}
+
+/////////////////////////////////////////////////
+void SceneEntitiesPrivate::Erase(unsigned int _id)
+{
+  std::vector<unsigned int> stack{_id};
+  while (!stack.empty())
+  {
+    auto id = stack.back();
+    stack.pop_back();
+    auto it = this->nodes.find(id);
+    if (it == this->nodes.end())
+      continue;
+
+    auto &node = it->second;
+    stack.insert(stack.end(), node.children.begin(), node.children.end());
+    if (node.name != this->names.end())
+      this->names.erase(node.name);
+    auto rendered = this->rendered.find(node.entity.renderId);
+    if (rendered != this->rendered.end() && rendered->second == id)
+      this->rendered.erase(rendered);
+    this->nodes.erase(it);
+  }
+}
+
+/////////////////////////////////////////////////
+SceneEntities *SceneEntities::Instance()
+{
+  // Deleted with the application
+  static QPointer<SceneEntities> instance;
+  if (!instance)
+    instance = new SceneEntities(App());
+  return instance;
+}
+
+/////////////////////////////////////////////////
+SceneEntities::SceneEntities(QObject *_parent)
+  : QObject(_parent), dataPtr(std::make_unique<SceneEntitiesPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+SceneEntities::~SceneEntities()
+{
+}
+
+/////////////////////////////////////////////////
+void SceneEntities::Add(std::vector<Entity> _entities)
+{
+  if (_entities.empty())
+    return;
+  SceneChange change;
+  change.kind = SceneChange::Kind::kAdd;
+  change.entities = std::move(_entities);
+  this->dataPtr->Queue(this, std::move(change));
+}
+
+/////////////////////////////////////////////////
+void SceneEntities::Remove(std::vector<unsigned int> _ids)
+{
+  if (_ids.empty())
+    return;
+  SceneChange change;
+  change.kind = SceneChange::Kind::kRemove;
+  change.ids = std::move(_ids);
+  this->dataPtr->Queue(this, std::move(change));
+}
+
+/////////////////////////////////////////////////
+void SceneEntities::Clear()
+{
+  SceneChange change;
+  change.kind = SceneChange::Kind::kClear;
+  this->dataPtr->Queue(this, std::move(change));
+}
+
+/////////////////////////////////////////////////
+void SceneEntities::SelectRendered(unsigned int _renderId)
+{
+  SceneChange change;
+  change.kind = SceneChange::Kind::kSelect;
+  change.renderId = _renderId;
+  this->dataPtr->Queue(this, std::move(change));
+}
+
+/////////////////////////////////////////////////
+void SceneEntities::Flush()
+{
+  std::vector<SceneChange> changes;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    changes.swap(this->dataPtr->changes);
+    this->dataPtr->flushQueued = false;
+  }
+
+  for (const auto &change : changes)
+  {
+    switch (change.kind)
+    {
+      case SceneChange::Kind::kAdd:
+        this->dataPtr->Add(this, change.entities);
+        break;
+      case SceneChange::Kind::kRemove:
+        this->dataPtr->Remove(this, change.ids);
+        break;
+      case SceneChange::Kind::kClear:
+      {
+        this->AboutToBeCleared();
+        this->dataPtr->nodes.clear();
+        this->dataPtr->top.clear();
+        this->dataPtr->names.clear();
+        this->dataPtr->rendered.clear();
+        this->Cleared();
+        if (this->dataPtr->selected != 0u)
+        {
+          this->dataPtr->selected = 0u;
+          this->SelectionChanged(0u);
+        }
+        break;
+      }
+      case SceneChange::Kind::kSelect:
+        this->SetSelected(this->FindRendered(change.renderId));
+        break;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+std::size_t SceneEntities::Count() const
+{
+  return this->dataPtr->nodes.size();
+}
+
+/////////////////////////////////////////////////
+const SceneEntities::Entity *SceneEntities::Find(unsigned int _id) const
+{
+  auto it = this->dataPtr->nodes.find(_id);
+  return it == this->dataPtr->nodes.end() ? nullptr : &it->second.entity;
+}
+
+/////////////////////////////////////////////////
+std::size_t SceneEntities::ChildCount(unsigned int _parent) const
+{
+  auto children = this->dataPtr->Children(_parent);
+  return nullptr == children ? 0u : children->size();
+}
+
+/////////////////////////////////////////////////
+unsigned int SceneEntities::Child(unsigned int _parent,
+    std::size_t _row) const
+{
+  auto children = this->dataPtr->Children(_parent);
+  if (nullptr == children || _row >= children->size())
+    return 0u;
+  return (*children)[_row];
+}
+
+/////////////////////////////////////////////////
+int SceneEntities::Row(unsigned int _id) const
+{
+  auto it = this->dataPtr->nodes.find(_id);
+  if (it == this->dataPtr->nodes.end())
+    return -1;
+  return static_cast<int>(it->second.row);
+}
+
+/////////////////////////////////////////////////
+std::vector<unsigned int> SceneEntities::Search(const std::string &_prefix,
+    std::size_t _max) const
+{
+  std::vector<unsigned int> result;
+  auto prefix = lowercase(_prefix);
+  for (auto it = this->dataPtr->names.lower_bound(prefix);
+      it != this->dataPtr->names.end() && result.size() < _max &&
+      it->first.compare(0, prefix.size(), prefix) == 0; ++it)
+  {
+    result.push_back(it->second);
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+unsigned int SceneEntities::FindRendered(unsigned int _renderId) const
+{
+  auto it = this->dataPtr->rendered.find(_renderId);
+  return it == this->dataPtr->rendered.end() ? 0u : it->second;
+}
+
+/////////////////////////////////////////////////
+unsigned int SceneEntities::Selected() const
+{
+  return this->dataPtr->selected;
+}
+
+/////////////////////////////////////////////////
+void SceneEntities::SetSelected(unsigned int _id)
+{
+  if (_id == this->dataPtr->selected)
+    return;
+  if (_id != 0u && nullptr == this->Find(_id))
+    return;
+  this->dataPtr->selected = _id;
+  this->SelectionChanged(_id);
+}
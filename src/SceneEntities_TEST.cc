@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/SceneEntities.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./SceneEntities_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+using Type = SceneEntities::Type;
+using Rows = std::tuple<unsigned int, int, int>;
+
+/////////////////////////////////////////////////
+SceneEntities::Entity Make(unsigned int _id, unsigned int _parent,
+    const std::string &_name, Type _type, unsigned int _renderId = 0u)
+{
+  SceneEntities::Entity entity;
+  entity.id = _id;
+  entity.parent = _parent;
+  entity.name = _name;
+  entity.type = _type;
+  entity.renderId = _renderId;
+  return entity;
+}
+
+/////////////////////////////////////////////////
+TEST(SceneEntitiesTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Hierarchy))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  auto entities = SceneEntities::Instance();
+  ASSERT_NE(nullptr, entities);
+  EXPECT_EQ(entities, SceneEntities::Instance());
+  EXPECT_EQ(app.findChild<SceneEntities *>(), entities);
+
+  std::vector<Rows> added;
+  std::vector<Rows> removed;
+  QObject::connect(entities, &SceneEntities::ChildrenAdded,
+      [&](unsigned int _parent, int _first, int _last)
+      {
+        // Already applied
+        EXPECT_EQ(_last + 1, static_cast<int>(entities->ChildCount(_parent)));
+        added.emplace_back(_parent, _first, _last);
+      });
+  QObject::connect(entities, &SceneEntities::ChildrenAboutToBeRemoved,
+      [&](unsigned int _parent, int _first, int _last)
+      {
+        // Not applied yet
+        EXPECT_NE(0u, entities->Child(_parent, _last));
+        removed.emplace_back(_parent, _first, _last);
+      });
+
+  // Changes are queued
+  entities->Add({
+      Make(1, 0, "box", Type::kModel),
+      Make(2, 1, "box_link", Type::kLink),
+      Make(3, 2, "box_visual", Type::kVisual, 100),
+      Make(4, 2, "box_visual_2", Type::kVisual, 101),
+      Make(5, 0, "sun", Type::kLight),
+      Make(6, 0, "Sphere", Type::kModel),
+      Make(7, 42, "orphan", Type::kModel)});
+  EXPECT_EQ(0u, entities->Count());
+  entities->Flush();
+  EXPECT_EQ(7u, entities->Count());
+
+  // Siblings are added at once, orphans at the top level
+  ASSERT_EQ(5u, added.size());
+  EXPECT_EQ(Rows(0, 0, 0), added[0]);
+  EXPECT_EQ(Rows(1, 0, 0), added[1]);
+  EXPECT_EQ(Rows(2, 0, 1), added[2]);
+  EXPECT_EQ(Rows(0, 1, 2), added[3]);
+  EXPECT_EQ(Rows(0, 3, 3), added[4]);
+
+  EXPECT_EQ(4u, entities->ChildCount(0));
+  EXPECT_EQ(1u, entities->Child(0, 0));
+  EXPECT_EQ(6u, entities->Child(0, 2));
+  EXPECT_EQ(0u, entities->Child(0, 4));
+  EXPECT_EQ(2u, entities->ChildCount(2));
+  EXPECT_EQ(1, entities->Row(4));
+  EXPECT_EQ(3, entities->Row(7));
+  EXPECT_EQ(-1, entities->Row(42));
+  ASSERT_NE(nullptr, entities->Find(7));
+  EXPECT_EQ(0u, entities->Find(7)->parent);
+  EXPECT_EQ(Type::kVisual, entities->Find(3)->type);
+  EXPECT_EQ(3u, entities->FindRendered(100));
+
+  // Consecutive siblings are removed at once, with their descendants
+  entities->Remove({5, 1, 6, 99});
+  entities->Flush();
+  ASSERT_EQ(1u, removed.size());
+  EXPECT_EQ(Rows(0, 0, 2), removed[0]);
+  EXPECT_EQ(1u, entities->Count());
+  EXPECT_EQ(7u, entities->Child(0, 0));
+  EXPECT_EQ(0, entities->Row(7));
+  EXPECT_EQ(nullptr, entities->Find(3));
+  EXPECT_EQ(0u, entities->FindRendered(100));
+
+  // Known entities are replaced
+  added.clear();
+  removed.clear();
+  entities->Add({Make(7, 0, "renamed", Type::kModel)});
+  entities->Flush();
+  EXPECT_EQ(1u, removed.size());
+  EXPECT_EQ(Rows(0, 0, 0), added.back());
+  EXPECT_EQ("renamed", entities->Find(7)->name);
+
+  int cleared{0};
+  QObject::connect(entities, &SceneEntities::Cleared,
+      [&cleared]()
+      {
+        ++cleared;
+      });
+  entities->Clear();
+  entities->Flush();
+  EXPECT_EQ(1, cleared);
+  EXPECT_EQ(0u, entities->Count());
+  EXPECT_EQ(0u, entities->ChildCount(0));
+}
+
+/////////////////////////////////////////////////
+TEST(SceneEntitiesTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Search))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  auto entities = SceneEntities::Instance();
+  entities->Add({
+      Make(1, 0, "Robot", Type::kModel),
+      Make(2, 1, "robot_arm", Type::kLink),
+      Make(3, 1, "base", Type::kLink),
+      Make(4, 0, "tree", Type::kModel),
+      Make(5, 0, "", Type::kLight)});
+  entities->Flush();
+
+  auto found = entities->Search("rob", 10);
+  ASSERT_EQ(2u, found.size());
+  EXPECT_EQ(1u, found[0]);
+  EXPECT_EQ(2u, found[1]);
+
+  EXPECT_EQ(1u, entities->Search("ROBOT", 1).size());
+  EXPECT_EQ(4u, entities->Search("", 10).size());
+  EXPECT_TRUE(entities->Search("robots", 10).empty());
+
+  // Removed entities aren't found
+  entities->Remove({1});
+  entities->Flush();
+  EXPECT_TRUE(entities->Search("rob", 10).empty());
+  EXPECT_EQ(1u, entities->Search("t", 10).size());
+}
+
+/////////////////////////////////////////////////
+TEST(SceneEntitiesTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Selection))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  auto entities = SceneEntities::Instance();
+  std::vector<unsigned int> selections;
+  QObject::connect(entities, &SceneEntities::SelectionChanged,
+      [&selections](unsigned int _id)
+      {
+        selections.push_back(_id);
+      });
+
+  entities->Add({
+      Make(1, 0, "box", Type::kModel),
+      Make(2, 1, "box_link", Type::kLink),
+      Make(3, 2, "box_visual", Type::kVisual, 100)});
+  entities->Flush();
+  EXPECT_EQ(0u, entities->Selected());
+
+  // Unknown entities can't be selected
+  entities->SetSelected(9);
+  EXPECT_EQ(0u, entities->Selected());
+
+  entities->SetSelected(2);
+  EXPECT_EQ(2u, entities->Selected());
+
+  // Selected from the render thread with the picked object
+  std::thread render([entities]
+      {
+        entities->SelectRendered(100);
+      });
+  render.join();
+  EXPECT_EQ(2u, entities->Selected());
+  QCoreApplication::processEvents();
+  EXPECT_EQ(3u, entities->Selected());
+
+  // Cleared with the entity
+  entities->Remove({1});
+  entities->Flush();
+  EXPECT_EQ(0u, entities->Selected());
+
+  ASSERT_EQ(3u, selections.size());
+  EXPECT_EQ(2u, selections[0]);
+  EXPECT_EQ(3u, selections[1]);
+  EXPECT_EQ(0u, selections[2]);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "gz/gui/ScenePicker.hh"
+
+namespace
+{
+  /// \brief Maximum number of positions cached per frame. Usually only the
+  /// hovered and clicked positions are picked.
+  constexpr std::size_t kMaxCached{8u};
+
+  /// \brief Global picking state
+  struct Picking
+  {
+    /// \brief Protects everything
+    std::mutex mutex;
+
+    /// \brief Function used to pick
+    gz::gui::ScenePicker::Picker picker;
+
+    /// \brief Results picked in the current frame
+    std::vector<std::pair<gz::math::Vector2i, gz::gui::PickResult>> cache;
+  };
+
+  /////////////////////////////////////////////////
+  Picking &picking()
+  {
+    static Picking instance;
+    return instance;
+  }
+}
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+void ScenePicker::SetPicker(Picker _picker)
+{
+  auto &p = picking();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  p.picker = std::move(_picker);
+  p.cache.clear();
+}
+
+/////////////////////////////////////////////////
+bool ScenePicker::HasPicker()
+{
+  auto &p = picking();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  return static_cast<bool>(p.picker);
+}
+
+/////////////////////////////////////////////////
+bool ScenePicker::Pick(const math::Vector2i &_pos, PickResult &_result)
+{
+  auto &p = picking();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  if (!p.picker)
+    return false;
+
+  for (const auto &cached : p.cache)
+  {
+    if (cached.first == _pos)
+    {
+      _result = cached.second;
+      return true;
+    }
+  }
+
+  PickResult result;
+  if (!p.picker(_pos, result))
+    return false;
+
+  if (p.cache.size() >= kMaxCached)
+    p.cache.erase(p.cache.begin());
+  p.cache.emplace_back(_pos, result);
+  _result = result;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void ScenePicker::NewFrame()
+{
+  auto &p = picking();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  p.cache.clear();
+}
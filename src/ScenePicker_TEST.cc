@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/ScenePicker.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(ScenePickerTest, Cache)
+{
+  PickResult result;
+  EXPECT_FALSE(ScenePicker::HasPicker());
+  EXPECT_FALSE(ScenePicker::Pick({1, 2}, result));
+
+  int calls{0};
+  ScenePicker::SetPicker([&](const math::Vector2i &_pos,
+      PickResult &_result)
+  {
+    ++calls;
+    _result.hit = _pos.X() > 0;
+    _result.point = math::Vector3d(_pos.X(), _pos.Y(), 0);
+    _result.objectId = 5u;
+    _result.origin = math::Vector3d(0, 0, 10);
+    _result.direction = math::Vector3d(0, 0, -1);
+    return true;
+  });
+  EXPECT_TRUE(ScenePicker::HasPicker());
+
+  // Picking the same position in a frame only calls the picker once
+  EXPECT_TRUE(ScenePicker::Pick({1, 2}, result));
+  EXPECT_TRUE(ScenePicker::Pick({1, 2}, result));
+  EXPECT_EQ(1, calls);
+  EXPECT_TRUE(result.hit);
+  EXPECT_EQ(5u, result.objectId);
+  EXPECT_EQ(math::Vector3d(1, 2, 0), result.Point(1000));
+
+  EXPECT_TRUE(ScenePicker::Pick({3, 4}, result));
+  EXPECT_EQ(2, calls);
+
+  ScenePicker::NewFrame();
+  EXPECT_TRUE(ScenePicker::Pick({1, 2}, result));
+  EXPECT_EQ(3, calls);
+
+  // Without a hit, the point is along the ray
+  EXPECT_TRUE(ScenePicker::Pick({0, 2}, result));
+  EXPECT_FALSE(result.hit);
+  EXPECT_EQ(math::Vector3d(0, 0, 7), result.Point(3));
+
+  ScenePicker::SetPicker(nullptr);
+  EXPECT_FALSE(ScenePicker::HasPicker());
+  EXPECT_FALSE(ScenePicker::Pick({1, 2}, result));
+}
+
+/////////////////////////////////////////////////
+TEST(ScenePickerTest, Failure)
+{
+  int calls{0};
+  ScenePicker::SetPicker([&](const math::Vector2i &, PickResult &)
+  {
+    ++calls;
+    return false;
+  });
+
+  // Failures aren't cached
+  PickResult result;
+  EXPECT_FALSE(ScenePicker::Pick({1, 2}, result));
+  EXPECT_FALSE(ScenePicker::Pick({1, 2}, result));
+  EXPECT_EQ(2, calls);
+
+  ScenePicker::SetPicker(nullptr);
+}
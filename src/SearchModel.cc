@@ -15,85 +15,757 @@
  *
 */
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <gz/common/Console.hh>
 
 #include "gz/gui/Enums.hh"
 #include "gz/gui/SearchModel.hh"
 
+/// \brief Time without typing before a background search starts, in ms
+static const int kDebounceMs{150};
+
+namespace gz
+{
+namespace gui
+{
+  /// \brief Row of the source model, copied so it can be matched on the
+  /// worker thread
+  struct SearchRow
+  {
+    /// \brief Column 0 index on the source model
+    QModelIndex index;
+
+    /// \brief Searched text, lowercase
+    QString text;
+
+    /// \brief Position of the parent, -1 for top level rows. Parents are
+    /// always before their children.
+    int parent{-1};
+
+    /// \brief Whether it's a title, which is never accepted
+    bool title{false};
+  };
+
+  /// \brief Result of a search over every row
+  struct SearchResult
+  {
+    /// \brief Result for a row
+    struct Match
+    {
+      /// \brief Whether the row is accepted
+      bool accepted{false};
+
+      /// \brief Whether a descendant contains one of the words
+      bool expand{false};
+    };
+
+    /// \brief Unique non-empty words of the search, lowercase
+    QStringList words;
+
+    /// \brief Words contained by each row itself
+    std::vector<QBitArray> self;
+
+    /// \brief Result of each row
+    std::vector<Match> matches;
+  };
+
+  /// \brief Search job for the worker thread
+  struct SearchJob
+  {
+    /// \brief Generation the job was created for
+    uint64_t generation{0};
+
+    /// \brief Rows to search
+    std::shared_ptr<const std::vector<SearchRow>> rows;
+
+    /// \brief Previous result over the same rows, used to narrow the search
+    std::shared_ptr<const SearchResult> base;
+
+    /// \brief Words to search
+    QStringList words;
+  };
+
+  class SearchModelPrivate
+  {
+    /// \brief Copy the rows of the source model, unless it's been done
+    /// since the last change, and match them synchronously the first time.
+    /// \param[in] _model Source model
+    /// \param[in] _role Role holding the searched text
+    public: void Update(const QAbstractItemModel *_model, int _role);
+
+    /// \brief Copy rows of the model along with their descendants.
+    /// \param[in] _stack Rows to copy with the position of their parent,
+    /// the first one last
+    /// \param[out] _rows Rows the copies are added to
+    public: void Copy(std::vector<std::pair<QModelIndex, int>> &_stack,
+        std::vector<SearchRow> &_rows);
+
+    /// \brief Add rows inserted at the end of their parent to the copy and
+    /// match them against the current result, without searching the rest.
+    /// \param[in] _parent Parent of the inserted rows
+    /// \param[in] _first First inserted row
+    /// \param[in] _last Last inserted row
+    /// \return False if the rows can't be added, in which case the copy
+    /// must be invalidated
+    public: bool Append(const QModelIndex &_parent, int _first, int _last);
+
+    /// \brief Check whether changed data leaves the copied rows as they
+    /// are.
+    /// \param[in] _topLeft First changed index
+    /// \param[in] _bottomRight Last changed index
+    /// \param[in] _roles Changed roles, empty if all may have changed
+    /// \return True if none of the searched text or types changed
+    public: bool Unchanged(const QModelIndex &_topLeft,
+        const QModelIndex &_bottomRight, const QVector<int> &_roles) const;
+
+    /// \brief Drop the copied rows, which are copied again once control
+    /// returns to the event loop, so a burst of changes is copied once.
+    public: void Invalidate();
+
+    /// \brief Whether the copied rows are outdated and waiting to be
+    /// copied again, in which case rows are matched on the source model.
+    /// \return True if outdated
+    public: bool Outdated() const;
+
+    /// \brief Match a row directly on the source model, which is slower
+    /// than the copy but doesn't depend on the other rows being up to date.
+    /// \param[in] _index Column 0 index on the source model
+    /// \param[in] _role Role holding the searched text
+    /// \return The result
+    public: SearchResult::Match Evaluate(const QModelIndex &_index,
+        int _role) const;
+
+    /// \brief Search the rows. Words which extend a word of the base
+    /// search are only tested on the rows which contained it.
+    /// \param[in] _rows Rows to search
+    /// \param[in] _base Previous result over the same rows, may be null
+    /// \param[in] _words Words to search
+    /// \return The result
+    public: static std::shared_ptr<SearchResult> Search(
+        const std::vector<SearchRow> &_rows, const SearchResult *_base,
+        const QStringList &_words);
+
+    /// \brief Get the result for a source index.
+    /// \param[in] _index Column 0 index on the source model
+    /// \return The result, null if the row isn't known
+    public: const SearchResult::Match *Find(const QModelIndex &_index) const;
+
+    /// \brief Search the pending job until stopped. Run by the worker
+    /// thread.
+    /// \param[in] _model Model the results are applied on
+    /// \param[in] _refilter Called on the GUI thread once a result is
+    /// applied
+    public: void Work(QObject *_model, std::function<void()> _refilter);
+
+    /// \brief Words of the latest search, which may not be applied yet
+    public: QStringList words;
+
+    /// \brief Copy of the source rows, null if it changed since. Only
+    /// modified in place while no background job shares it.
+    public: std::shared_ptr<std::vector<SearchRow>> rows;
+
+    /// \brief Position in rows of each index
+    public: QHash<QModelIndex, int> positions;
+
+    /// \brief Result used by the filter, over the current rows. Only
+    /// modified in place while no background job shares it.
+    public: std::shared_ptr<SearchResult> result;
+
+    /// \brief Model the rows were copied from
+    public: const QAbstractItemModel *model{nullptr};
+
+    /// \brief Role the rows were copied with, since setFilterRole can't
+    /// be intercepted
+    public: int role{-1};
+
+    /// \brief Incremented whenever the words or the rows change, so
+    /// outdated background results are dropped
+    public: std::atomic<uint64_t> generation{0};
+
+    /// \brief Models with at least this many rows are searched on the
+    /// worker thread
+    public: int backgroundRows{5000};
+
+    /// \brief Starts the background search once typing pauses
+    public: QTimer debounce;
+
+    /// \brief Copies the rows again once the source model stops changing
+    public: QTimer rebuild;
+
+    /// \brief Connections to the source model
+    public: std::vector<QMetaObject::Connection> connections;
+
+    /// \brief Protects job and stop
+    public: std::mutex mutex;
+
+    /// \brief Notifies the worker of a job or of stop
+    public: std::condition_variable condition;
+
+    /// \brief Job waiting for the worker
+    public: std::optional<SearchJob> job;
+
+    /// \brief Whether the worker should stop
+    public: bool stop{false};
+
+    /// \brief Worker thread, started with the first background search
+    public: std::thread worker;
+  };
+}
+}
+
 using namespace gz;
 using namespace gui;
 
 /////////////////////////////////////////////////
-bool SearchModel::filterAcceptsRow(const int _srcRow,
-      const QModelIndex &_srcParent) const
+void SearchModelPrivate::Update(const QAbstractItemModel *_model, int _role)
 {
-  // Item index in search model.
-  auto id = this->sourceModel()->index(_srcRow, 0, _srcParent);
+  if (this->rows && this->model == _model && this->role == _role)
+    return;
 
-  // Ignore titles.
-  if (this->sourceModel()->data(id, DataRole::TYPE).toString() ==
-      "title")
+  ++this->generation;
+  this->model = _model;
+  this->role = _role;
+  this->positions.clear();
+
+  auto rowsCopy = std::make_shared<std::vector<SearchRow>>();
+  if (nullptr != _model)
+  {
+    std::vector<std::pair<QModelIndex, int>> stack;
+    for (int i = _model->rowCount() - 1; i >= 0; --i)
+      stack.emplace_back(_model->index(i, 0), -1);
+    this->Copy(stack, *rowsCopy);
+  }
+  this->rows = rowsCopy;
+
+  // The previous result doesn't match the new rows, so the rows are
+  // searched again from scratch
+  this->result = Search(*this->rows, nullptr, this->words);
+}
+
+/////////////////////////////////////////////////
+void SearchModelPrivate::Copy(
+    std::vector<std::pair<QModelIndex, int>> &_stack,
+    std::vector<SearchRow> &_rows)
+{
+  // Depth first, so parents come before their children
+  while (!_stack.empty())
+  {
+    auto [index, parent] = _stack.back();
+    _stack.pop_back();
+
+    SearchRow row;
+    row.index = index;
+    row.text = this->model->data(index, this->role).toString().toLower();
+    row.parent = parent;
+    row.title =
+        this->model->data(index, DataRole::TYPE).toString() == "title";
+
+    int position = static_cast<int>(_rows.size());
+    this->positions.insert(index, position);
+    _rows.push_back(std::move(row));
+
+    for (int i = this->model->rowCount(index) - 1; i >= 0; --i)
+      _stack.emplace_back(this->model->index(i, 0, index), position);
+  }
+}
+
+/////////////////////////////////////////////////
+bool SearchModelPrivate::Append(const QModelIndex &_parent, int _first,
+    int _last)
+{
+  // Rows inserted before others would shift the indices of those, and
+  // copies shared with a background job can't be modified
+  if (!this->rows || !this->result || this->rows.use_count() != 1 ||
+      this->result.use_count() != 1 ||
+      _last != this->model->rowCount(_parent) - 1)
   {
     return false;
   }
 
-  // Collapsed by default.
-  this->sourceModel()->blockSignals(true);
-  this->sourceModel()->setData(id, false, DataRole::TO_EXPAND);
-  this->sourceModel()->blockSignals(false);
+  int parent{-1};
+  if (_parent.isValid())
+  {
+    auto it = this->positions.constFind(_parent);
+    if (it == this->positions.constEnd())
+      return false;
+    parent = *it;
+  }
 
-  // Empty search matches everything.
-  if (this->search.isEmpty())
-    return true;
+  auto &rowsRef = *this->rows;
+  auto begin = rowsRef.size();
+  std::vector<std::pair<QModelIndex, int>> stack;
+  for (int i = _last; i >= _first; --i)
+    stack.emplace_back(this->model->index(i, 0, _parent), parent);
+  this->Copy(stack, rowsRef);
+  auto end = rowsRef.size();
+
+  // Same as Search, only over the new rows
+  auto &found = *this->result;
+  const auto &words = found.words;
+  int wordCount = words.size();
+  found.self.resize(end, QBitArray(wordCount));
+  found.matches.resize(end);
+
+  QBitArray ancestors(wordCount);
+  for (int a = parent; a >= 0; a = rowsRef[a].parent)
+    ancestors |= found.self[a];
 
-  // Each word must match at least once, either self, parent or child.
-  auto words = this->search.split(" ");
-  for (auto word : words)
+  auto isNew = [begin](int _position)
   {
-    if (word.isEmpty())
-      continue;
+    return _position >= static_cast<int>(begin);
+  };
 
-    // Expand this if at least one child contains the word.
-    // Note that this is not enough for this to be accepted, we need to match
-    // all words.
-    if (this->HasChildAcceptsItself(id, word))
+  std::vector<QBitArray> path(end - begin);
+  for (auto r = begin; r < end; ++r)
+  {
+    for (int w = 0; w < wordCount; ++w)
     {
-      this->sourceModel()->blockSignals(true);
-      this->sourceModel()->setData(id, true, DataRole::TO_EXPAND);
-      this->sourceModel()->blockSignals(false);
+      if (rowsRef[r].text.contains(words[w]))
+        found.self[r].setBit(w);
     }
+    auto p = rowsRef[r].parent;
+    path[r - begin] = found.self[r];
+    path[r - begin] |= isNew(p) ? path[p - begin] : ancestors;
+  }
 
-    // At least one of the children fits rule 1.
-    if (this->HasAcceptedChildren(_srcRow, _srcParent))
-      continue;
+  std::vector<QBitArray> below(end - begin, QBitArray(wordCount));
+  std::vector<bool> acceptedChild(end - begin, false);
+  bool accepted{false};
+  bool expand{false};
+  for (auto i = end; i > begin; --i)
+  {
+    auto r = i - 1;
+    auto n = r - begin;
+    auto &match = found.matches[r];
+    if (!rowsRef[r].title)
+    {
+      match.accepted = acceptedChild[n] ||
+          path[n].count(true) == path[n].size();
+      match.expand = below[n].count(true) > 0;
+    }
 
-    // Row itself contains this word.
-    if (this->FilterAcceptsRowItself(_srcRow, _srcParent, word))
+    auto p = rowsRef[r].parent;
+    if (isNew(p))
+    {
+      below[p - begin] |= below[n];
+      below[p - begin] |= found.self[r];
+      if (match.accepted)
+        acceptedChild[p - begin] = true;
+    }
+    else
+    {
+      accepted = accepted || match.accepted;
+      expand = expand || below[n].count(true) > 0 ||
+          found.self[r].count(true) > 0;
+    }
+  }
+
+  // Existing ancestors may now have an accepted child or a descendant
+  // containing a word. Titles are never accepted, so they don't pass an
+  // accepted child on.
+  for (int a = parent; a >= 0; a = rowsRef[a].parent)
+  {
+    if (rowsRef[a].title)
+    {
+      accepted = false;
       continue;
+    }
+    auto &match = found.matches[a];
+    match.accepted = match.accepted || accepted;
+    match.expand = match.expand || expand;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SearchModelPrivate::Unchanged(const QModelIndex &_topLeft,
+    const QModelIndex &_bottomRight, const QVector<int> &_roles) const
+{
+  if (!_roles.isEmpty() && !_roles.contains(this->role) &&
+      !_roles.contains(DataRole::TYPE))
+  {
+    return true;
+  }
+
+  if (!this->rows || this->model != _topLeft.model())
+    return false;
+
+  // Only column 0 is searched
+  if (_topLeft.column() > 0)
+    return true;
+
+  for (int r = _topLeft.row(); r <= _bottomRight.row(); ++r)
+  {
+    auto index = _topLeft.sibling(r, 0);
+    auto it = this->positions.constFind(index);
+    if (it == this->positions.constEnd())
+      return false;
+
+    const auto &row = (*this->rows)[*it];
+    if (row.text != this->model->data(index, this->role).toString().toLower()
+        || row.title !=
+        (this->model->data(index, DataRole::TYPE).toString() == "title"))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SearchModelPrivate::Invalidate()
+{
+  this->rows.reset();
+
+  // Without an event loop, the rows are copied again when next filtered
+  if (nullptr != QCoreApplication::instance())
+    this->rebuild.start();
+}
+
+/////////////////////////////////////////////////
+bool SearchModelPrivate::Outdated() const
+{
+  return !this->rows && this->rebuild.isActive();
+}
+
+/////////////////////////////////////////////////
+SearchResult::Match SearchModelPrivate::Evaluate(const QModelIndex &_index,
+    int _role) const
+{
+  auto model = _index.model();
+  int wordCount = this->words.size();
+
+  auto self = [&](const QModelIndex &_row)
+  {
+    QBitArray bits(wordCount);
+    auto text = model->data(_row, _role).toString().toLower();
+    for (int w = 0; w < wordCount; ++w)
+    {
+      if (text.contains(this->words[w]))
+        bits.setBit(w);
+    }
+    return bits;
+  };
+
+  // Rule 2 over the descendants, also finding whether one of them
+  // contains a word
+  bool found{false};
+  std::function<bool(const QModelIndex &, const QBitArray &)> accepts =
+      [&](const QModelIndex &_row, const QBitArray &_path)
+  {
+    bool accepted = _path.count(true) == _path.size();
+    for (int c = 0; c < model->rowCount(_row); ++c)
+    {
+      auto child = model->index(c, 0, _row);
+      auto childSelf = self(child);
+      found = found || childSelf.count(true) > 0;
+      accepted = accepts(child, _path | childSelf) || accepted;
+    }
+    return accepted &&
+        model->data(_row, DataRole::TYPE).toString() != "title";
+  };
+
+  QBitArray path(wordCount);
+  for (auto row = _index; row.isValid(); row = row.parent())
+    path |= self(row);
 
-    // One of the ancestors contains this word.
-    QModelIndex parentIndex = _srcParent;
-    bool parentAccepted = false;
-    while (parentIndex.isValid())
+  SearchResult::Match match;
+  match.accepted = accepts(_index, path);
+  match.expand = found &&
+      model->data(_index, DataRole::TYPE).toString() != "title";
+  return match;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<SearchResult> SearchModelPrivate::Search(
+    const std::vector<SearchRow> &_rows, const SearchResult *_base,
+    const QStringList &_words)
+{
+  auto result = std::make_shared<SearchResult>();
+  result->words = _words;
+  int wordCount = _words.size();
+  result->self.assign(_rows.size(), QBitArray(wordCount));
+  result->matches.resize(_rows.size());
+
+  if (_base != nullptr && _base->self.size() != _rows.size())
+    _base = nullptr;
+
+  for (int w = 0; w < wordCount; ++w)
+  {
+    // The rows containing the longest base word found in this word are
+    // the only ones which may contain this word
+    int baseWord{-1};
+    for (int b = 0; _base != nullptr && b < _base->words.size(); ++b)
     {
-      if (this->FilterAcceptsRowItself(parentIndex.row(),
-          parentIndex.parent(), word))
+      if (_words[w].contains(_base->words[b]) &&
+          (baseWord < 0 ||
+           _base->words[b].size() > _base->words[baseWord].size()))
       {
-        parentAccepted = true;
-        break;
+        baseWord = b;
       }
-      parentIndex = parentIndex.parent();
     }
 
-    if (parentAccepted)
+    for (std::size_t r = 0; r < _rows.size(); ++r)
+    {
+      if (baseWord >= 0 && !_base->self[r].testBit(baseWord))
+        continue;
+      if (_rows[r].text.contains(_words[w]))
+        result->self[r].setBit(w);
+    }
+  }
+
+  // Rule 1: each word is on the row or an ancestor. Rule 3 follows, since
+  // the path of a row includes the path of its ancestors.
+  std::vector<QBitArray> path(_rows.size());
+  for (std::size_t r = 0; r < _rows.size(); ++r)
+  {
+    path[r] = result->self[r];
+    if (_rows[r].parent >= 0)
+      path[r] |= path[_rows[r].parent];
+  }
+
+  // Rule 2: an accepted child. Children are after their parents, so they're
+  // all done by the time their parent is reached backwards.
+  std::vector<QBitArray> below(_rows.size(), QBitArray(wordCount));
+  std::vector<bool> acceptedChild(_rows.size(), false);
+  for (std::size_t i = _rows.size(); i > 0; --i)
+  {
+    auto r = i - 1;
+    auto &match = result->matches[r];
+    if (!_rows[r].title)
+    {
+      match.accepted = acceptedChild[r] ||
+          path[r].count(true) == path[r].size();
+      match.expand = below[r].count(true) > 0;
+    }
+
+    auto parent = _rows[r].parent;
+    if (parent >= 0)
+    {
+      below[parent] |= below[r];
+      below[parent] |= result->self[r];
+      if (match.accepted)
+        acceptedChild[parent] = true;
+    }
+  }
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+const SearchResult::Match *SearchModelPrivate::Find(
+    const QModelIndex &_index) const
+{
+  if (!this->result)
+    return nullptr;
+
+  auto it = this->positions.constFind(_index);
+  if (it == this->positions.constEnd())
+    return nullptr;
+  return &this->result->matches[*it];
+}
+
+/////////////////////////////////////////////////
+void SearchModelPrivate::Work(QObject *_model,
+    std::function<void()> _refilter)
+{
+  while (true)
+  {
+    SearchJob current;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->condition.wait(lock, [this]
+      {
+        return this->stop || this->job.has_value();
+      });
+      if (this->stop)
+        return;
+      current = std::move(*this->job);
+      this->job.reset();
+    }
+
+    // Typing went on, a newer job is coming
+    if (current.generation != this->generation)
       continue;
 
-    // This word can't be found on the row or a parent, and no child is fully
-    // accepted.
+    auto found = Search(*current.rows, current.base.get(), current.words);
+
+    // Applied on the GUI thread if nothing changed in the meantime
+    auto generation = current.generation;
+    auto rows = current.rows;
+    QMetaObject::invokeMethod(_model,
+        [this, _refilter, generation, rows, found]
+    {
+      if (generation != this->generation || rows != this->rows)
+        return;
+      this->result = found;
+      _refilter();
+    }, Qt::QueuedConnection);
+  }
+}
+
+/////////////////////////////////////////////////
+SearchModel::SearchModel(QObject *_parent)
+  : QSortFilterProxyModel(_parent),
+    dataPtr(std::make_unique<SearchModelPrivate>())
+{
+  this->dataPtr->debounce.setSingleShot(true);
+  this->connect(&this->dataPtr->debounce, &QTimer::timeout, this, [this]
+  {
+    if (!this->dataPtr->rows || !this->dataPtr->result ||
+        this->dataPtr->result->words == this->dataPtr->words)
+    {
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      SearchJob job;
+      job.generation = this->dataPtr->generation;
+      job.rows = this->dataPtr->rows;
+      job.base = this->dataPtr->result;
+      job.words = this->dataPtr->words;
+      this->dataPtr->job = std::move(job);
+    }
+    this->dataPtr->condition.notify_one();
+
+    if (!this->dataPtr->worker.joinable())
+    {
+      this->dataPtr->worker = std::thread(&SearchModelPrivate::Work,
+          this->dataPtr.get(), this, [this]
+          {
+            this->invalidateFilter();
+            this->layoutChanged();
+          });
+    }
+  });
+
+  this->dataPtr->rebuild.setSingleShot(true);
+  this->dataPtr->rebuild.setInterval(0);
+  this->connect(&this->dataPtr->rebuild, &QTimer::timeout, this, [this]
+  {
+    this->dataPtr->Update(this->sourceModel(), this->filterRole());
+  });
+}
+
+/////////////////////////////////////////////////
+SearchModel::~SearchModel()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->condition.notify_one();
+  if (this->dataPtr->worker.joinable())
+    this->dataPtr->worker.join();
+}
+
+/////////////////////////////////////////////////
+void SearchModel::setSourceModel(QAbstractItemModel *_model)
+{
+  for (const auto &connection : this->dataPtr->connections)
+    this->disconnect(connection);
+  this->dataPtr->connections.clear();
+  this->dataPtr->rows.reset();
+  this->dataPtr->rebuild.stop();
+
+  // Connected before the base class, so the rows are up to date before
+  // the new ones are filtered
+  if (nullptr != _model)
+  {
+    auto invalidate = [this]()
+    {
+      this->dataPtr->Invalidate();
+    };
+    auto &c = this->dataPtr->connections;
+    c.push_back(this->connect(_model, &QAbstractItemModel::dataChanged,
+        this, [this](const QModelIndex &_topLeft,
+            const QModelIndex &_bottomRight, const QVector<int> &_roles)
+        {
+          if (!this->dataPtr->Unchanged(_topLeft, _bottomRight, _roles))
+            this->dataPtr->Invalidate();
+        }));
+    c.push_back(this->connect(_model, &QAbstractItemModel::rowsInserted,
+        this, [this](const QModelIndex &_parent, int _first, int _last)
+        {
+          if (!this->dataPtr->Append(_parent, _first, _last))
+            this->dataPtr->Invalidate();
+        }));
+    c.push_back(this->connect(_model, &QAbstractItemModel::rowsRemoved,
+        this, invalidate));
+    c.push_back(this->connect(_model, &QAbstractItemModel::rowsMoved,
+        this, invalidate));
+    c.push_back(this->connect(_model, &QAbstractItemModel::modelReset,
+        this, invalidate));
+    c.push_back(this->connect(_model, &QAbstractItemModel::layoutChanged,
+        this, invalidate));
+  }
+
+  QSortFilterProxyModel::setSourceModel(_model);
+}
+
+/////////////////////////////////////////////////
+QVariant SearchModel::data(const QModelIndex &_index, int _role) const
+{
+  if (_role != DataRole::TO_EXPAND)
+    return QSortFilterProxyModel::data(_index, _role);
+
+  if (!_index.isValid())
     return false;
+
+  if (this->dataPtr->Outdated())
+  {
+    return this->dataPtr->Evaluate(this->mapToSource(
+        _index.sibling(_index.row(), 0)), this->filterRole()).expand;
   }
 
-  return true;
+  this->dataPtr->Update(this->sourceModel(), this->filterRole());
+  auto match = this->dataPtr->Find(
+      this->mapToSource(_index.sibling(_index.row(), 0)));
+  return match != nullptr && match->expand;
+}
+
+/////////////////////////////////////////////////
+bool SearchModel::filterAcceptsRow(const int _srcRow,
+      const QModelIndex &_srcParent) const
+{
+  auto index = this->sourceModel()->index(_srcRow, 0, _srcParent);
+  if (this->dataPtr->Outdated())
+    return this->dataPtr->Evaluate(index, this->filterRole()).accepted;
+
+  this->dataPtr->Update(this->sourceModel(), this->filterRole());
+  auto match = this->dataPtr->Find(index);
+  return match != nullptr && match->accepted;
+}
+
+/////////////////////////////////////////////////
+int SearchModel::BackgroundRows() const
+{
+  return this->dataPtr->backgroundRows;
+}
+
+/////////////////////////////////////////////////
+void SearchModel::SetBackgroundRows(int _rows)
+{
+  this->dataPtr->backgroundRows = _rows;
+}
+
+/////////////////////////////////////////////////
+bool SearchModel::SearchPending() const
+{
+  return this->dataPtr->rows && this->dataPtr->result &&
+      this->dataPtr->result->words != this->dataPtr->words;
 }
 
 /////////////////////////////////////////////////
@@ -148,6 +820,32 @@ void SearchModel::SetSearch(const QString &_search)
 {
   this->search = _search;
 
+  QStringList words;
+  for (const auto &word : _search.toLower().split(" "))
+  {
+    if (!word.isEmpty() && !words.contains(word))
+      words.append(word);
+  }
+  this->dataPtr->words = words;
+  ++this->dataPtr->generation;
+  this->dataPtr->debounce.stop();
+
+  // Copying the rows searches them with the new words right away
+  this->dataPtr->Update(this->sourceModel(), this->filterRole());
+  const auto &rows = this->dataPtr->rows;
+  if (this->dataPtr->result->words != words)
+  {
+    // Large models are searched in the background once typing pauses,
+    // and keep showing the previous result in the meantime
+    if (static_cast<int>(rows->size()) >= this->dataPtr->backgroundRows)
+    {
+      this->dataPtr->debounce.start(kDebounceMs);
+      return;
+    }
+    this->dataPtr->result = SearchModelPrivate::Search(*rows,
+        this->dataPtr->result.get(), words);
+  }
+
   // Trigger repaint on whole model
   this->invalidateFilter();
 
@@ -17,13 +17,24 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <string>
+#include <thread>
+
 #include <gz/common/Console.hh>
 
 #include "test_config.hh"  // NOLINT(build/include)
 
+#include "gz/gui/Application.hh"
 #include "gz/gui/Enums.hh"
 #include "gz/gui/SearchModel.hh"
 
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./SearchModel_TEST")),
+};
+
 using namespace gz;
 using namespace gui;
 
@@ -173,3 +184,206 @@ TEST(SearchModelTest, NestedStructure)
   }
 }
 
+
+/////////////////////////////////////////////////
+TEST(SearchModelTest, Cache)
+{
+  common::Console::SetVerbosity(4);
+
+  // - a
+  // -- b
+  // --- title
+  auto sourceModel = new QStandardItemModel();
+  auto a = new QStandardItem();
+  a->setData("a", DataRole::DISPLAY_NAME);
+  sourceModel->insertRow(0, a);
+
+  auto b = new QStandardItem();
+  b->setData("b", DataRole::DISPLAY_NAME);
+  a->appendRow(b);
+
+  auto title = new QStandardItem();
+  title->setData("title b", DataRole::DISPLAY_NAME);
+  title->setData("title", DataRole::TYPE);
+  b->appendRow(title);
+
+  auto searchModel = new SearchModel();
+  searchModel->setFilterRole(DataRole::DISPLAY_NAME);
+  searchModel->setSourceModel(sourceModel);
+
+  // Words are case insensitive and repeated words don't matter
+  searchModel->SetSearch("B  b");
+  ASSERT_EQ(1, searchModel->rowCount());
+  auto id = searchModel->index(0, 0);
+  EXPECT_TRUE(searchModel->data(id, DataRole::TO_EXPAND).toBool());
+  EXPECT_EQ(2, countRowsOfIndex(id) + 1);
+
+  // Titles aren't accepted, but still expand their parent
+  auto bId = searchModel->index(0, 0, id);
+  EXPECT_TRUE(searchModel->data(bId, DataRole::TO_EXPAND).toBool());
+
+  // The source model isn't modified
+  EXPECT_FALSE(a->data(DataRole::TO_EXPAND).isValid());
+  EXPECT_FALSE(b->data(DataRole::TO_EXPAND).isValid());
+
+  // New rows are matched against the current search
+  auto c = new QStandardItem();
+  c->setData("c", DataRole::DISPLAY_NAME);
+  a->appendRow(c);
+  EXPECT_EQ(2, countRowsOfIndex(searchModel->index(0, 0)) + 1);
+
+  auto cb = new QStandardItem();
+  cb->setData("cb", DataRole::DISPLAY_NAME);
+  sourceModel->insertRow(1, cb);
+  EXPECT_EQ(2, searchModel->rowCount());
+
+  // Changed data is matched again
+  b->setData("d", DataRole::DISPLAY_NAME);
+  searchModel->SetSearch("d");
+  EXPECT_EQ(1, searchModel->rowCount());
+  EXPECT_EQ(2, countRowsOfIndex(searchModel->index(0, 0)) + 1);
+
+  searchModel->SetSearch("");
+  EXPECT_FALSE(searchModel->data(searchModel->index(0, 0),
+      DataRole::TO_EXPAND).toBool());
+}
+
+/////////////////////////////////////////////////
+TEST(SearchModelTest, Background)
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  auto sourceModel = new QStandardItemModel();
+  for (int i = 0; i < 100; ++i)
+  {
+    auto it = new QStandardItem();
+    it->setData(QString::fromStdString("item" + std::to_string(i)),
+        DataRole::DISPLAY_NAME);
+    sourceModel->appendRow(it);
+  }
+
+  auto searchModel = new SearchModel();
+  EXPECT_EQ(5000, searchModel->BackgroundRows());
+  searchModel->SetBackgroundRows(0);
+  EXPECT_EQ(0, searchModel->BackgroundRows());
+  searchModel->setFilterRole(DataRole::DISPLAY_NAME);
+  searchModel->setSourceModel(sourceModel);
+  EXPECT_EQ(100, searchModel->rowCount());
+
+  auto wait = [&]()
+  {
+    for (int i = 0; i < 300 && searchModel->SearchPending(); ++i)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      QCoreApplication::processEvents();
+    }
+  };
+
+  // The previous result is shown until the search is done
+  searchModel->SetSearch("item 1");
+  EXPECT_TRUE(searchModel->SearchPending());
+  EXPECT_EQ(100, searchModel->rowCount());
+  wait();
+  EXPECT_FALSE(searchModel->SearchPending());
+  EXPECT_EQ(19, searchModel->rowCount());
+
+  // Narrowed from the previous result
+  searchModel->SetSearch("item 12");
+  wait();
+  EXPECT_EQ(1, searchModel->rowCount());
+
+  // Only the latest of quick changes is applied
+  searchModel->SetSearch("item 2");
+  searchModel->SetSearch("item 3");
+  wait();
+  EXPECT_EQ(19, searchModel->rowCount());
+  EXPECT_EQ("item3", searchModel->data(searchModel->index(0, 0),
+      DataRole::DISPLAY_NAME).toString());
+
+  // Changes to the source model are searched right away
+  sourceModel->removeRow(3);
+  EXPECT_EQ(18, searchModel->rowCount());
+
+  delete searchModel;
+  delete sourceModel;
+}
+
+/////////////////////////////////////////////////
+/// Source model counting how many times the searched text is read
+class CountingModel : public QStandardItemModel
+{
+  public: QVariant data(const QModelIndex &_index, int _role) const override
+  {
+    if (_role == DataRole::DISPLAY_NAME)
+      ++this->reads;
+    return QStandardItemModel::data(_index, _role);
+  }
+
+  /// \brief Reads of the searched text
+  public: mutable int reads{0};
+};
+
+/////////////////////////////////////////////////
+TEST(SearchModelTest, Changes)
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  auto sourceModel = new CountingModel();
+  auto searchModel = new SearchModel();
+  searchModel->setFilterRole(DataRole::DISPLAY_NAME);
+  searchModel->setSourceModel(sourceModel);
+  searchModel->SetSearch("item 1");
+
+  auto newItem = [](int _i)
+  {
+    auto it = new QStandardItem();
+    it->setData(QString::fromStdString("item" + std::to_string(_i)),
+        DataRole::DISPLAY_NAME);
+    return it;
+  };
+
+  // Appended rows are matched on their own, instead of copying the whole
+  // model again for each of them
+  int count{1000};
+  for (int i = 0; i < count; ++i)
+    sourceModel->appendRow(newItem(i));
+  EXPECT_EQ(271, searchModel->rowCount());
+  EXPECT_LT(sourceModel->reads, 2 * count);
+
+  // Inserted rows are matched on the source model until the model is
+  // copied again, once for all of them
+  sourceModel->reads = 0;
+  for (int i = count; i < count + 100; ++i)
+    sourceModel->insertRow(0, newItem(i));
+  EXPECT_EQ(371, searchModel->rowCount());
+  EXPECT_LT(sourceModel->reads, 2 * count);
+
+  QCoreApplication::processEvents();
+  EXPECT_LT(sourceModel->reads, 4 * count);
+  EXPECT_EQ(371, searchModel->rowCount());
+
+  // Nested rows appended to a visible parent
+  auto parent = sourceModel->item(0);
+  ASSERT_EQ("item1099", parent->data(DataRole::DISPLAY_NAME).toString());
+  parent->appendRow(newItem(0));
+  auto parentId = searchModel->index(0, 0);
+  EXPECT_EQ(1, searchModel->rowCount(parentId));
+  EXPECT_TRUE(searchModel->data(parentId, DataRole::TO_EXPAND).toBool());
+
+  // Data which isn't searched doesn't invalidate the copy
+  sourceModel->reads = 0;
+  sourceModel->item(1)->setData("tip", Qt::ToolTipRole);
+  QCoreApplication::processEvents();
+  EXPECT_LT(sourceModel->reads, count);
+
+  // Changed text is matched again
+  sourceModel->item(1)->setData("other", DataRole::DISPLAY_NAME);
+  QCoreApplication::processEvents();
+  searchModel->SetSearch("other");
+  EXPECT_EQ(1, searchModel->rowCount());
+
+  delete searchModel;
+  delete sourceModel;
+}
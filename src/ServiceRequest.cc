@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "gz/gui/PluginStats.hh"
+#include "gz/gui/ServiceRequest.hh"
+#include "gz/gui/WorkerPool.hh"
+
+namespace gz
+{
+  namespace gui
+  {
+    class ServiceRequestPrivate
+    {
+      /// \brief Thread the callback is called on
+      public: ServiceRequest::Thread thread{ServiceRequest::Thread::kAny};
+
+      /// \brief Object on whose thread the callback is called, for
+      /// kReceiver
+      public: QPointer<QObject> receiver;
+
+      /// \brief Function delivered on timeout
+      public: std::function<void()> onTimeout;
+
+      /// \brief True once replied, timed out or canceled
+      public: std::atomic<bool> finished{false};
+
+      /// \brief True once the callback was called or the request canceled
+      public: std::atomic<bool> done{false};
+
+      /// \brief True once canceled
+      public: std::atomic<bool> canceled{false};
+
+      /// \brief Held while the callback runs, so Cancel waits for it.
+      /// Recursive, so the callback can cancel its own request.
+      public: std::recursive_mutex mutex;
+    };
+  }
+}
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  /// \brief Thread timing out the requests, shared by all of them
+  struct Timeouts
+  {
+    /// \brief Stop the thread
+    ~Timeouts()
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopped = true;
+      }
+      this->condition.notify_all();
+      if (this->thread.joinable())
+        this->thread.join();
+    }
+
+    /// \brief Time out a request
+    /// \param[in] _deadline When it times out
+    /// \param[in] _state Request state
+    void Add(Clock::time_point _deadline,
+             std::weak_ptr<gz::gui::ServiceRequestPrivate> _state)
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->stopped)
+          return;
+        this->deadlines.emplace(_deadline, std::move(_state));
+        if (!this->thread.joinable())
+          this->thread = std::thread([this] {this->Run();});
+      }
+      this->condition.notify_all();
+    }
+
+    /// \brief Loop of the thread
+    void Run()
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      while (!this->stopped)
+      {
+        if (this->deadlines.empty())
+        {
+          this->condition.wait(lock);
+          continue;
+        }
+
+        auto next = this->deadlines.begin();
+        if (Clock::now() < next->first)
+        {
+          this->condition.wait_until(lock, next->first);
+          continue;
+        }
+
+        // Requests which finished or were dropped are gone already
+        auto state = next->second.lock();
+        this->deadlines.erase(next);
+        if (!state)
+          continue;
+
+        lock.unlock();
+        this->expire(state);
+        lock.lock();
+      }
+    }
+
+    /// \brief Protects everything but expire
+    std::mutex mutex;
+
+    /// \brief Notified when a request is added or on stop
+    std::condition_variable condition;
+
+    /// \brief Pending requests by deadline
+    std::multimap<Clock::time_point,
+        std::weak_ptr<gz::gui::ServiceRequestPrivate>> deadlines;
+
+    /// \brief Function timing out a request
+    std::function<void(
+        const std::shared_ptr<gz::gui::ServiceRequestPrivate> &)> expire;
+
+    /// \brief True on destruction
+    bool stopped{false};
+
+    /// \brief Started with the first request
+    std::thread thread;
+  };
+}
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+ServiceRequest::ServiceRequest() = default;
+
+/////////////////////////////////////////////////
+ServiceRequest::ServiceRequest(std::shared_ptr<ServiceRequestPrivate> _state)
+  : dataPtr(std::move(_state))
+{
+}
+
+/////////////////////////////////////////////////
+ServiceRequest::~ServiceRequest() = default;
+
+/////////////////////////////////////////////////
+void ServiceRequest::Cancel()
+{
+  if (!this->dataPtr)
+    return;
+
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->canceled = true;
+  this->dataPtr->finished = true;
+  this->dataPtr->done = true;
+}
+
+/////////////////////////////////////////////////
+bool ServiceRequest::Pending() const
+{
+  if (!this->dataPtr || this->dataPtr->done)
+    return false;
+
+  // Replies to destroyed receivers are dropped
+  return this->dataPtr->thread != Thread::kReceiver ||
+      !this->dataPtr->receiver.isNull();
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<ServiceRequestPrivate> ServiceRequest::Create(
+    Thread _thread, QObject *_receiver, std::chrono::milliseconds _timeout,
+    std::function<void()> _onTimeout)
+{
+  static Timeouts timeouts;
+  static std::once_flag once;
+  std::call_once(once, []
+  {
+    timeouts.expire = [](const std::shared_ptr<ServiceRequestPrivate> &_state)
+    {
+      if (Finish(_state))
+        Deliver(_state, _state->onTimeout);
+    };
+  });
+
+  auto state = std::make_shared<ServiceRequestPrivate>();
+  state->thread = _thread;
+  state->receiver = _receiver;
+  state->onTimeout = std::move(_onTimeout);
+  timeouts.Add(Clock::now() + _timeout, state);
+  return state;
+}
+
+/////////////////////////////////////////////////
+bool ServiceRequest::Finish(
+    const std::shared_ptr<ServiceRequestPrivate> &_state)
+{
+  return !_state->finished.exchange(true);
+}
+
+/////////////////////////////////////////////////
+void ServiceRequest::Deliver(
+    const std::shared_ptr<ServiceRequestPrivate> &_state,
+    std::function<void()> _task)
+{
+  auto run = [_state, task = std::move(_task)]
+  {
+    std::lock_guard<std::recursive_mutex> lock(_state->mutex);
+    if (_state->canceled)
+      return;
+    _state->done = true;
+    task();
+  };
+
+  switch (_state->thread)
+  {
+    case Thread::kReceiver:
+    {
+      QPointer<QObject> receiver = _state->receiver;
+      if (!receiver)
+      {
+        _state->done = true;
+        return;
+      }
+      // Dropped by Qt if the receiver is destroyed before
+      QMetaObject::invokeMethod(receiver, [receiver, run]
+      {
+        PluginStats::Scope stats(receiver, PluginStats::Source::kTransport);
+        run();
+      }, Qt::QueuedConnection);
+      break;
+    }
+    case Thread::kRender:
+      WorkerPool::RunOnRenderThread(run, _state.get());
+      break;
+    case Thread::kAny:
+    default:
+      run();
+      break;
+  }
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/stringmsg.pb.h>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/ServiceRequest.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./ServiceRequest_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+using namespace std::chrono_literals;
+
+using Result = ServiceRequest::Result;
+
+namespace
+{
+  /// \brief Process events until a condition is met
+  bool waitFor(const std::function<bool()> &_done)
+  {
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (!_done())
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+        return false;
+      QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return true;
+  }
+
+  /// \brief Service echoing its request, failing on "fail"
+  bool echo(const msgs::StringMsg &_req, msgs::StringMsg &_rep)
+  {
+    _rep.set_data(_req.data());
+    return _req.data() != "fail";
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ServiceRequestTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Reply))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv, WindowType::kDialog);
+
+  transport::Node server;
+  ASSERT_TRUE(server.Advertise("/test/service_request/echo", echo));
+
+  // Several requests in flight at once, each replied on the GUI thread
+  std::vector<std::string> replies;
+  std::vector<Result> results;
+  std::function<void(const msgs::StringMsg &, Result)> cb =
+      [&](const msgs::StringMsg &_rep, Result _result)
+  {
+    EXPECT_EQ(app.thread(), QThread::currentThread());
+    replies.push_back(_rep.data());
+    results.push_back(_result);
+  };
+
+  transport::Node node;
+  msgs::StringMsg req;
+  req.set_data("a");
+  auto first = ServiceRequest::Send(node, "/test/service_request/echo", req,
+      5000ms, &app, cb);
+  req.set_data("fail");
+  auto second = ServiceRequest::Send(node, "/test/service_request/echo",
+      req, 5000ms, &app, cb);
+  EXPECT_TRUE(first.Pending());
+  EXPECT_TRUE(second.Pending());
+
+  ASSERT_TRUE(waitFor([&] {return results.size() == 2u;}));
+  EXPECT_FALSE(first.Pending());
+  EXPECT_FALSE(second.Pending());
+
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    if (replies[i] == "a")
+      EXPECT_EQ(Result::kReplied, results[i]);
+    else
+      EXPECT_EQ(Result::kFailed, results[i]);
+  }
+
+  // Called once only
+  QCoreApplication::processEvents();
+  EXPECT_EQ(2u, results.size());
+}
+
+/////////////////////////////////////////////////
+TEST(ServiceRequestTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Timeout))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv, WindowType::kDialog);
+
+  // Nobody serves it
+  std::optional<Result> result;
+  std::function<void(const msgs::Boolean &, Result)> cb =
+      [&](const msgs::Boolean &_rep, Result _result)
+  {
+    EXPECT_FALSE(_rep.data());
+    result = _result;
+  };
+
+  transport::Node node;
+  auto request = ServiceRequest::Send(node, "/test/service_request/none",
+      msgs::StringMsg(), 100ms, &app, cb);
+  EXPECT_TRUE(request.Pending());
+
+  ASSERT_TRUE(waitFor([&] {return result.has_value();}));
+  EXPECT_EQ(Result::kTimedOut, *result);
+  EXPECT_FALSE(request.Pending());
+}
+
+/////////////////////////////////////////////////
+TEST(ServiceRequestTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Cancel))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv, WindowType::kDialog);
+
+  transport::Node server;
+  ASSERT_TRUE(server.Advertise("/test/service_request/cancel", echo));
+
+  int called{0};
+  std::function<void(const msgs::StringMsg &, Result)> cb =
+      [&](const msgs::StringMsg &, Result)
+  {
+    ++called;
+  };
+
+  // Canceled right away
+  transport::Node node;
+  auto request = ServiceRequest::Send(node, "/test/service_request/cancel",
+      msgs::StringMsg(), 200ms, &app, cb);
+  request.Cancel();
+  EXPECT_FALSE(request.Pending());
+
+  // Destroyed receiver
+  auto receiver = new QObject();
+  auto orphan = ServiceRequest::Send(node, "/test/service_request/cancel",
+      msgs::StringMsg(), 200ms, receiver, cb);
+  delete receiver;
+  EXPECT_FALSE(orphan.Pending());
+
+  // Neither replies nor timeouts are delivered
+  auto deadline = std::chrono::steady_clock::now() + 500ms;
+  while (std::chrono::steady_clock::now() < deadline)
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+  EXPECT_EQ(0, called);
+
+  // Empty handles
+  ServiceRequest empty;
+  EXPECT_FALSE(empty.Pending());
+  empty.Cancel();
+}
+
+/////////////////////////////////////////////////
+TEST(ServiceRequestTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(RenderThread))
+{
+  common::Console::SetVerbosity(4);
+
+  transport::Node server;
+  ASSERT_TRUE(server.Advertise("/test/service_request/render", echo));
+
+  std::atomic<bool> replied{false};
+  std::function<void(const msgs::StringMsg &, Result)> cb =
+      [&](const msgs::StringMsg &_rep, Result _result)
+  {
+    EXPECT_EQ("render", _rep.data());
+    EXPECT_EQ(Result::kReplied, _result);
+    replied = true;
+  };
+
+  transport::Node node;
+  msgs::StringMsg req;
+  req.set_data("render");
+  auto request = ServiceRequest::Send(ServiceRequest::Thread::kRender, node,
+      "/test/service_request/render", req, 5000ms, cb);
+
+  // Delivered by the render hooks, the test thread standing for the render
+  // thread
+  auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (!replied && std::chrono::steady_clock::now() < deadline)
+  {
+    RenderHooks::Run(RenderPhase::kPreRender);
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT_TRUE(replied);
+  EXPECT_FALSE(request.Pending());
+}
@@ -0,0 +1,665 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include <gz/common/Console.hh>
+#include <gz/msgs/uint64.pb.h>
+#include <gz/transport/Node.hh>
+
+#include "gz/gui/SharedMemory.hh"
+
+namespace
+{
+  /// \brief Identifies a segment, "gzSH"
+  constexpr uint32_t kMagic{0x677a5348u};
+
+  /// \brief Layout version of the segments
+  constexpr uint32_t kVersion{2u};
+
+  /// \brief Maximum length of the message type, with its terminator
+  constexpr std::size_t kMaxTypeLength{128u};
+
+  /// \brief Slots are aligned to cache lines, so writing one doesn't slow
+  /// down readers of the others
+  constexpr std::size_t kAlignment{64u};
+
+  // Sequences are shared between processes, so they must not use a lock
+  static_assert(std::atomic<uint64_t>::is_always_lock_free,
+      "Shared memory needs lock-free 64 bit atomics");
+
+  /// \brief Start of a segment
+  struct SegmentHeader
+  {
+    /// \brief kMagic, written last
+    std::atomic<uint32_t> magic{0u};
+
+    /// \brief kVersion
+    uint32_t version{kVersion};
+
+    /// \brief Number of slots
+    uint32_t slotCount{0u};
+
+    /// \brief Unused, for alignment
+    uint32_t reserved{0u};
+
+    /// \brief Maximum size of a message
+    uint64_t slotSize{0u};
+
+    /// \brief Nanoseconds since the epoch when the segment was created,
+    /// also sent with the notifications, so subscribers can tell when a
+    /// new publisher replaced the segment
+    uint64_t created{0u};
+
+    /// \brief Sequence of the latest complete message, 0 before the first
+    std::atomic<uint64_t> latest{0u};
+
+    /// \brief Message type, null terminated
+    char msgType[kMaxTypeLength]{};
+  };
+
+  /// \brief Start of each slot, followed by the message
+  struct SlotHeader
+  {
+    /// \brief Sequence of the message in the slot, 0 while it's written
+    std::atomic<uint64_t> sequence{0u};
+
+    /// \brief Size of the message
+    uint64_t size{0u};
+  };
+
+  /////////////////////////////////////////////////
+  std::size_t align(std::size_t _size)
+  {
+    return (_size + kAlignment - 1u) / kAlignment * kAlignment;
+  }
+
+  /////////////////////////////////////////////////
+  std::size_t slotStride(uint64_t _slotSize)
+  {
+    return align(sizeof(SlotHeader) + static_cast<std::size_t>(_slotSize));
+  }
+
+  /////////////////////////////////////////////////
+  std::size_t segmentSize(uint32_t _slots, uint64_t _slotSize)
+  {
+    return align(sizeof(SegmentHeader)) + _slots * slotStride(_slotSize);
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Get the slot a message is written to
+  /// \param[in] _segment Mapped segment
+  /// \param[in] _sequence Sequence of the message
+  /// \return Slot
+  SlotHeader *slotAt(void *_segment, uint64_t _sequence)
+  {
+    auto header = static_cast<SegmentHeader *>(_segment);
+    auto slots = static_cast<char *>(_segment) + align(sizeof(SegmentHeader));
+    return reinterpret_cast<SlotHeader *>(slots +
+        (_sequence % header->slotCount) * slotStride(header->slotSize));
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Get the message of a slot
+  /// \param[in] _slot Slot
+  /// \return Start of the message
+  char *slotData(SlotHeader *_slot)
+  {
+    return reinterpret_cast<char *>(_slot) + sizeof(SlotHeader);
+  }
+}
+
+namespace gz
+{
+  namespace gui
+  {
+    class SharedMemoryPublisherPrivate
+    {
+      /// \brief Write a message into the next slot and notify the
+      /// subscribers.
+      /// \param[in] _size Size of the message
+      /// \param[in] _write Writes the message at a location
+      /// \return False if it couldn't be written
+      public: bool Write(std::size_t _size,
+          const std::function<bool(char *)> &_write);
+
+      /// \brief Topic
+      public: std::string topic;
+
+      /// \brief Name of the segment
+      public: std::string name;
+
+      /// \brief Mapped segment, null if it couldn't be created
+      public: void *segment{nullptr};
+
+      /// \brief Size of the mapping
+      public: std::size_t size{0u};
+
+      /// \brief Maximum size of a message
+      public: std::size_t slotSize{0u};
+
+      /// \brief Sequence of the last message
+      public: uint64_t sequence{0u};
+
+      /// \brief Creation stamp of the segment
+      public: uint64_t created{0u};
+
+      /// \brief True once a message too large for the slots was reported
+      public: bool warnedSize{false};
+
+      /// \brief True once a message which failed to be written was
+      /// reported
+      public: bool warnedWrite{false};
+
+      /// \brief Messages may be published from several threads
+      public: std::mutex mutex;
+
+      /// \brief Node for the notifications
+      public: transport::Node node;
+
+      /// \brief Publishes the sequence of each message
+      public: transport::Node::Publisher notifier;
+    };
+
+    class SharedMemorySubscriberPrivate
+    {
+      /// \brief Map the segment of the topic
+      /// \return True if it exists and is valid
+      public: bool Map();
+
+      /// \brief Unmap the segment, if it's mapped
+      public: void Unmap();
+
+      /// \brief Called when the publisher wrote a message
+      /// \param[in] _msg Sequence of the message
+      public: void OnNotify(const msgs::UInt64 &_msg);
+
+      /// \brief Held while the callback runs
+      public: std::mutex mutex;
+
+      /// \brief Callback, null once unsubscribed
+      public: SharedMemorySubscriber::Callback callback;
+
+      /// \brief Topic
+      public: std::string topic;
+
+      /// \brief Message type of the segment
+      public: std::string msgType;
+
+      /// \brief Mapped segment
+      public: void *segment{nullptr};
+
+      /// \brief Size of the mapping
+      public: std::size_t size{0u};
+
+      /// \brief Sequence of the last message passed to the callback
+      public: uint64_t delivered{0u};
+
+      /// \brief Node for the notifications
+      public: transport::Node node;
+    };
+  }
+}
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+SharedMemoryView::SharedMemoryView(const char *_data, std::size_t _size,
+    const std::string &_msgType, uint64_t _sequence,
+    const std::atomic<uint64_t> *_slotSequence)
+  : data(_data), size(_size), msgType(_msgType), sequence(_sequence),
+    slotSequence(_slotSequence)
+{
+}
+
+/////////////////////////////////////////////////
+const char *SharedMemoryView::Data() const
+{
+  return this->data;
+}
+
+/////////////////////////////////////////////////
+std::size_t SharedMemoryView::Size() const
+{
+  return this->size;
+}
+
+/////////////////////////////////////////////////
+const std::string &SharedMemoryView::MsgType() const
+{
+  return this->msgType;
+}
+
+/////////////////////////////////////////////////
+uint64_t SharedMemoryView::Sequence() const
+{
+  return this->sequence;
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryView::Valid() const
+{
+  // Reads of the data must not be moved after the check
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return nullptr != this->slotSequence &&
+      this->slotSequence->load(std::memory_order_relaxed) == this->sequence;
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryView::Parse(google::protobuf::Message &_msg) const
+{
+  return _msg.ParseFromArray(this->data, static_cast<int>(this->size)) &&
+      this->Valid();
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryView::ParseExcept(int _field,
+    google::protobuf::Message &_msg, const char *&_bytes,
+    std::size_t &_size) const
+{
+  using WireFormatLite = google::protobuf::internal::WireFormatLite;
+
+  _bytes = nullptr;
+  _size = 0u;
+
+  // The other fields are copied out and parsed, they're usually small
+  google::protobuf::io::CodedInputStream input(
+      reinterpret_cast<const uint8_t *>(this->data),
+      static_cast<int>(this->size));
+  std::string rest;
+  while (true)
+  {
+    int start = input.CurrentPosition();
+    uint32_t tag = input.ReadTag();
+    if (tag == 0u)
+      break;
+
+    if (WireFormatLite::GetTagFieldNumber(tag) == _field &&
+        WireFormatLite::GetTagWireType(tag) ==
+        WireFormatLite::WIRETYPE_LENGTH_DELIMITED)
+    {
+      uint32_t length{0u};
+      if (!input.ReadVarint32(&length))
+        return false;
+      int position = input.CurrentPosition();
+      if (!input.Skip(static_cast<int>(length)))
+        return false;
+      _bytes = this->data + position;
+      _size = length;
+      continue;
+    }
+
+    if (!WireFormatLite::SkipField(&input, tag))
+      return false;
+    rest.append(this->data + start,
+        static_cast<std::size_t>(input.CurrentPosition() - start));
+  }
+
+  return _msg.ParseFromString(rest) && this->Valid();
+}
+
+/////////////////////////////////////////////////
+SharedMemoryPublisher::SharedMemoryPublisher(const std::string &_topic,
+    const std::string &_msgType, std::size_t _slotSize, unsigned int _slots)
+  : dataPtr(std::make_unique<SharedMemoryPublisherPrivate>())
+{
+  this->dataPtr->topic = _topic;
+  this->dataPtr->name = SegmentName(_topic);
+  this->dataPtr->slotSize = _slotSize;
+
+#ifdef _WIN32
+  gzwarn << "Shared memory isn't available on Windows, topic [" << _topic
+         << "] won't be published through it" << std::endl;
+  (void)_msgType;
+  (void)_slots;
+#else
+  if (_slots == 0u || _slotSize == 0u || _msgType.empty() ||
+      _msgType.size() >= kMaxTypeLength)
+  {
+    gzerr << "Invalid shared memory slots for topic [" << _topic << "]"
+          << std::endl;
+    return;
+  }
+
+  // Left by a publisher which crashed, subscribers remap when notified
+  // with the new creation stamp
+  const auto &name = this->dataPtr->name;
+  shm_unlink(name.c_str());
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0)
+  {
+    gzerr << "Failed to create shared memory [" << name << "]: "
+          << std::strerror(errno) << std::endl;
+    return;
+  }
+
+  auto size = segmentSize(_slots, _slotSize);
+  void *segment{MAP_FAILED};
+  if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+  {
+    segment = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+        0);
+  }
+  close(fd);
+  if (segment == MAP_FAILED)
+  {
+    gzerr << "Failed to map shared memory [" << name << "]: "
+          << std::strerror(errno) << std::endl;
+    shm_unlink(name.c_str());
+    return;
+  }
+
+  auto header = new (segment) SegmentHeader;
+  header->slotCount = _slots;
+  header->slotSize = _slotSize;
+  header->created = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count());
+  std::snprintf(header->msgType, kMaxTypeLength, "%s", _msgType.c_str());
+  for (uint64_t i = 0u; i < _slots; ++i)
+    new (slotAt(segment, i)) SlotHeader;
+  header->magic.store(kMagic, std::memory_order_release);
+
+  this->dataPtr->segment = segment;
+  this->dataPtr->size = size;
+  this->dataPtr->created = header->created;
+  this->dataPtr->notifier = this->dataPtr->node.Advertise<msgs::UInt64>(
+      _topic + "/shm");
+#endif
+}
+
+/////////////////////////////////////////////////
+SharedMemoryPublisher::~SharedMemoryPublisher()
+{
+#ifndef _WIN32
+  if (nullptr == this->dataPtr->segment)
+    return;
+
+  munmap(this->dataPtr->segment, this->dataPtr->size);
+  shm_unlink(this->dataPtr->name.c_str());
+#endif
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryPublisher::Valid() const
+{
+  return nullptr != this->dataPtr->segment;
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryPublisher::Publish(const google::protobuf::Message &_msg)
+{
+  auto size = _msg.ByteSizeLong();
+  return this->dataPtr->Write(size, [&_msg, size](char *_data)
+  {
+    return _msg.SerializeToArray(_data, static_cast<int>(size));
+  });
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryPublisher::PublishRaw(const char *_data, std::size_t _size)
+{
+  return this->dataPtr->Write(_size, [_data, _size](char *_slot)
+  {
+    std::memcpy(_slot, _data, _size);
+    return true;
+  });
+}
+
+/////////////////////////////////////////////////
+bool SharedMemoryPublisherPrivate::Write(std::size_t _size,
+    const std::function<bool(char *)> &_write)
+{
+  if (nullptr == this->segment)
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (_size > this->slotSize)
+  {
+    if (!this->warnedSize)
+    {
+      gzerr << "Message of [" << _size << "] bytes doesn't fit in the ["
+            << this->slotSize << "] byte slots of topic [" << this->topic
+            << "]" << std::endl;
+      this->warnedSize = true;
+    }
+    return false;
+  }
+
+  // Readers of the slot see a 0 sequence before any of the new data
+  auto sequence = this->sequence + 1u;
+  auto slot = slotAt(this->segment, sequence);
+  slot->sequence.store(0u, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  if (!_write(slotData(slot)))
+  {
+    if (!this->warnedWrite)
+    {
+      gzerr << "Failed to write a message of [" << _size << "] bytes to "
+            << "topic [" << this->topic << "]" << std::endl;
+      this->warnedWrite = true;
+    }
+    return false;
+  }
+  slot->size = _size;
+  slot->sequence.store(sequence, std::memory_order_release);
+  this->sequence = sequence;
+
+  static_cast<SegmentHeader *>(this->segment)->latest.store(sequence,
+      std::memory_order_release);
+
+  msgs::UInt64 msg;
+  msg.set_data(sequence);
+  msg.mutable_header()->mutable_stamp()->set_sec(
+      static_cast<int64_t>(this->created / 1000000000u));
+  msg.mutable_header()->mutable_stamp()->set_nsec(
+      static_cast<int32_t>(this->created % 1000000000u));
+  this->notifier.Publish(msg);
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string SharedMemoryPublisher::SegmentName(const std::string &_topic)
+{
+  std::string name{"/gz_gui"};
+  for (auto c : _topic)
+  {
+    bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+        (c >= '0' && c <= '9');
+    name += valid ? c : '_';
+  }
+
+  // macOS limits names to 31 characters, so long ones are hashed
+  if (name.size() <= 30u)
+    return name;
+
+  uint64_t hash{14695981039346656037ull};
+  for (auto c : _topic)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  }
+  char hex[17];
+  std::snprintf(hex, sizeof(hex), "%016llx",
+      static_cast<unsigned long long>(hash));
+  return std::string("/gz_gui_") + hex;
+}
+
+/////////////////////////////////////////////////
+SharedMemorySubscriber::SharedMemorySubscriber()
+  : dataPtr(std::make_unique<SharedMemorySubscriberPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+SharedMemorySubscriber::~SharedMemorySubscriber()
+{
+  this->Unsubscribe();
+}
+
+/////////////////////////////////////////////////
+bool SharedMemorySubscriber::Subscribe(const std::string &_topic,
+    Callback _callback)
+{
+  this->Unsubscribe();
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->topic = _topic;
+    if (!this->dataPtr->Map())
+      return false;
+    this->dataPtr->callback = std::move(_callback);
+    this->dataPtr->delivered = 0u;
+  }
+
+  if (!this->dataPtr->node.Subscribe(_topic + "/shm",
+      &SharedMemorySubscriberPrivate::OnNotify, this->dataPtr.get()))
+  {
+    gzerr << "Unable to subscribe to topic [" << _topic << "/shm]"
+          << std::endl;
+    this->Unsubscribe();
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SharedMemorySubscriber::Unsubscribe()
+{
+  for (const auto &sub : this->dataPtr->node.SubscribedTopics())
+    this->dataPtr->node.Unsubscribe(sub);
+
+  // Waits for a running callback
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->callback = nullptr;
+  this->dataPtr->Unmap();
+}
+
+/////////////////////////////////////////////////
+bool SharedMemorySubscriberPrivate::Map()
+{
+#ifdef _WIN32
+  return false;
+#else
+  this->Unmap();
+
+  auto name = SharedMemoryPublisher::SegmentName(this->topic);
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+    return false;
+
+  struct stat info;
+  void *segment{MAP_FAILED};
+  std::size_t size{0u};
+  if (fstat(fd, &info) == 0 &&
+      static_cast<std::size_t>(info.st_size) >= sizeof(SegmentHeader))
+  {
+    size = static_cast<std::size_t>(info.st_size);
+    segment = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (segment == MAP_FAILED)
+    return false;
+
+  // Not a segment, or the publisher is still creating it
+  auto header = static_cast<SegmentHeader *>(segment);
+  if (header->magic.load(std::memory_order_acquire) != kMagic ||
+      header->version != kVersion || header->slotCount == 0u ||
+      segmentSize(header->slotCount, header->slotSize) > size)
+  {
+    munmap(segment, size);
+    return false;
+  }
+
+  this->segment = segment;
+  this->size = size;
+  this->msgType.assign(header->msgType,
+      strnlen(header->msgType, kMaxTypeLength));
+  return true;
+#endif
+}
+
+/////////////////////////////////////////////////
+void SharedMemorySubscriberPrivate::Unmap()
+{
+#ifndef _WIN32
+  if (nullptr != this->segment)
+    munmap(this->segment, this->size);
+#endif
+  this->segment = nullptr;
+  this->size = 0u;
+}
+
+/////////////////////////////////////////////////
+void SharedMemorySubscriberPrivate::OnNotify(const msgs::UInt64 &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (!this->callback)
+    return;
+
+  // A new publisher restarts the sequences in a new segment, which may
+  // have overtaken the old one by the time its notifications arrive
+  auto created = static_cast<uint64_t>(_msg.header().stamp().sec()) *
+      1000000000u + static_cast<uint64_t>(_msg.header().stamp().nsec());
+  if (nullptr == this->segment ||
+      static_cast<SegmentHeader *>(this->segment)->created != created)
+  {
+    if (!this->Map())
+      return;
+    this->delivered = 0u;
+  }
+
+  // Only the latest message matters, earlier ones were notified already
+  auto header = static_cast<SegmentHeader *>(this->segment);
+  auto latest = header->latest.load(std::memory_order_acquire);
+  if (latest <= this->delivered)
+    return;
+
+  auto slot = slotAt(this->segment, latest);
+  if (slot->sequence.load(std::memory_order_acquire) != latest)
+    return;
+
+  // The size is only trusted as far as the slot goes, it's checked with
+  // the rest by Valid
+  auto size = std::min(slot->size, header->slotSize);
+  SharedMemoryView view(slotData(slot), static_cast<std::size_t>(size),
+      this->msgType, latest, &slot->sequence);
+  this->delivered = latest;
+  this->callback(view);
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <gz/msgs/image.pb.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <gz/common/Console.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/SharedMemory.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(SharedMemoryTest, SegmentName)
+{
+  EXPECT_EQ("/gz_gui_camera", SharedMemoryPublisher::SegmentName("/camera"));
+
+  // Short enough for macOS
+  auto name = SharedMemoryPublisher::SegmentName(
+      "/world/default/model/robot/link/base/sensor/camera/image");
+  EXPECT_LE(name.size(), 30u);
+  EXPECT_EQ(0u, name.find("/gz_gui_"));
+  EXPECT_NE(name, SharedMemoryPublisher::SegmentName(
+      "/world/default/model/robot/link/base/sensor/depth/image"));
+}
+
+/////////////////////////////////////////////////
+TEST(SharedMemoryTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(PublishSubscribe))
+{
+  common::Console::SetVerbosity(4);
+
+  // No publisher
+  SharedMemorySubscriber sub;
+  EXPECT_FALSE(sub.Subscribe("/shm_test_image",
+      [](const SharedMemoryView &){}));
+
+  SharedMemoryPublisher pub("/shm_test_image", "gz.msgs.Image", 1024u);
+  ASSERT_TRUE(pub.Valid());
+
+  std::mutex mutex;
+  msgs::Image received;
+  std::string pixels;
+  std::string msgType;
+  bool valid{false};
+  std::atomic<int> count{0};
+  ASSERT_TRUE(sub.Subscribe("/shm_test_image",
+      [&](const SharedMemoryView &_view)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        const char *bytes{nullptr};
+        std::size_t size{0u};
+        valid = _view.ParseExcept(msgs::Image::kDataFieldNumber, received,
+            bytes, size);
+        if (nullptr != bytes)
+          pixels.assign(bytes, size);
+        msgType = _view.MsgType();
+        ++count;
+      }));
+
+  msgs::Image msg;
+  msg.set_width(4);
+  msg.set_height(2);
+  msg.set_step(12);
+  msg.set_pixel_format_type(msgs::PixelFormatType::RGB_INT8);
+  msg.set_data(std::string(24, 'x'));
+
+  // Subscriptions take a moment to be discovered
+  for (int i = 0; i < 50 && count == 0; ++i)
+  {
+    EXPECT_TRUE(pub.Publish(msg));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  ASSERT_GT(count, 0);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_TRUE(valid);
+    EXPECT_EQ("gz.msgs.Image", msgType);
+    EXPECT_EQ(4u, received.width());
+    EXPECT_EQ(2u, received.height());
+    EXPECT_EQ(12u, received.step());
+    EXPECT_TRUE(received.data().empty());
+    EXPECT_EQ(std::string(24, 'x'), pixels);
+  }
+
+  // Too large for the slots
+  msg.set_data(std::string(2048, 'y'));
+  EXPECT_FALSE(pub.Publish(msg));
+
+  // No more calls once unsubscribed
+  sub.Unsubscribe();
+  int before = count;
+  msg.set_data(std::string(24, 'z'));
+  EXPECT_TRUE(pub.Publish(msg));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(before, count);
+}
+
+/////////////////////////////////////////////////
+TEST(SharedMemoryTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Overwritten))
+{
+  SharedMemoryPublisher pub("/shm_test_raw", "gz.msgs.Image", 16u, 2u);
+  ASSERT_TRUE(pub.Valid());
+
+  // A view of a slot which the publisher laps is no longer valid
+  std::atomic<bool> entered{false};
+  std::atomic<bool> lapped{false};
+  std::atomic<bool> stillValid{true};
+  std::atomic<bool> done{false};
+  SharedMemorySubscriber sub;
+  ASSERT_TRUE(sub.Subscribe("/shm_test_raw",
+      [&](const SharedMemoryView &_view)
+      {
+        if (done)
+          return;
+        EXPECT_TRUE(_view.Valid());
+        entered = true;
+        while (!lapped)
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        stillValid = _view.Valid();
+        done = true;
+      }));
+
+  for (int i = 0; i < 50 && !entered; ++i)
+  {
+    EXPECT_TRUE(pub.PublishRaw("abc", 3u));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  ASSERT_TRUE(entered);
+
+  // Two more messages wrap around the ring of two slots
+  EXPECT_TRUE(pub.PublishRaw("def", 3u));
+  EXPECT_TRUE(pub.PublishRaw("ghi", 3u));
+  lapped = true;
+
+  for (int i = 0; i < 50 && !done; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_TRUE(done);
+  EXPECT_FALSE(stillValid);
+}
+
+/////////////////////////////////////////////////
+TEST(SharedMemoryTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Republished))
+{
+  std::mutex mutex;
+  std::string data;
+  std::atomic<int> count{0};
+  SharedMemorySubscriber sub;
+  auto pub = std::make_unique<SharedMemoryPublisher>("/shm_test_republish",
+      "gz.msgs.Image", 16u);
+  ASSERT_TRUE(pub->Valid());
+  ASSERT_TRUE(sub.Subscribe("/shm_test_republish",
+      [&](const SharedMemoryView &_view)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        data.assign(_view.Data(), _view.Size());
+        ++count;
+      }));
+
+  for (int i = 0; i < 50 && count == 0; ++i)
+  {
+    EXPECT_TRUE(pub->PublishRaw("old", 3u));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  ASSERT_GT(count, 0);
+
+  // The new publisher's sequences catch up with the delivered ones, the
+  // subscriber still moves to its segment
+  pub.reset();
+  pub = std::make_unique<SharedMemoryPublisher>("/shm_test_republish",
+      "gz.msgs.Image", 16u);
+  ASSERT_TRUE(pub->Valid());
+  bool republished{false};
+  for (int i = 0; i < 50 && !republished; ++i)
+  {
+    EXPECT_TRUE(pub->PublishRaw("new", 3u));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::lock_guard<std::mutex> lock(mutex);
+    republished = data == "new";
+  }
+  EXPECT_TRUE(republished);
+}
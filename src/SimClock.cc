@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <gz/msgs/world_stats.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/transport/Node.hh>
+
+#include "gz/gui/LatestValue.hh"
+#include "gz/gui/SimClock.hh"
+
+namespace gz
+{
+  namespace gui
+  {
+    class SimClockPrivate
+    {
+      /// \brief Fold a message into the latest statistics
+      /// \param[in] _msg World statistics
+      public: void OnMsg(const msgs::WorldStatistics &_msg);
+
+      /// \brief Topic name
+      public: std::string topic;
+
+      /// \brief Latest statistics
+      public: SimClock::State state;
+
+      /// \brief Protects state
+      public: mutable std::mutex mutex;
+
+      /// \brief Latest sim time in nanoseconds, for lock free reads
+      public: std::atomic<int64_t> simTimeNs{0};
+
+      /// \brief Latest paused state, for lock free reads
+      public: std::atomic<bool> paused{false};
+
+      /// \brief Latest iterations, for lock free reads
+      public: std::atomic<uint64_t> iterations{0u};
+
+      /// \brief Notifies the GUI thread. Declared before the node, so it's
+      /// destroyed after the node stops calling it.
+      public: std::unique_ptr<LatestValue<bool>> updated;
+
+      /// \brief Node subscribed to the topic
+      public: transport::Node node;
+    };
+  }
+}
+
+using namespace gz;
+using namespace gui;
+
+namespace
+{
+  /////////////////////////////////////////////////
+  /// \brief Clocks which are held by someone, per topic. Only used from the
+  /// GUI thread.
+  std::map<std::string, std::weak_ptr<SimClock>> &clocks()
+  {
+    static std::map<std::string, std::weak_ptr<SimClock>> instance;
+    return instance;
+  }
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<SimClock> SimClock::ForTopic(const std::string &_topic)
+{
+  auto topic = transport::TopicUtils::AsValidTopic(_topic);
+  if (topic.empty())
+  {
+    gzerr << "Invalid world statistics topic [" << _topic << "]"
+          << std::endl;
+    return nullptr;
+  }
+
+  auto &all = clocks();
+  auto it = all.find(topic);
+  if (it != all.end())
+  {
+    if (auto clock = it->second.lock())
+      return clock;
+    all.erase(it);
+  }
+
+  std::shared_ptr<SimClock> clock(new SimClock(topic));
+  if (!clock->Subscribe())
+    return nullptr;
+
+  all[topic] = clock;
+  return clock;
+}
+
+/////////////////////////////////////////////////
+SimClock::SimClock(const std::string &_topic)
+  : dataPtr(std::make_unique<SimClockPrivate>())
+{
+  this->dataPtr->topic = _topic;
+  this->dataPtr->updated = std::make_unique<LatestValue<bool>>(this,
+      [this](const bool &)
+      {
+        this->Updated();
+      });
+}
+
+/////////////////////////////////////////////////
+SimClock::~SimClock()
+{
+}
+
+/////////////////////////////////////////////////
+bool SimClock::Subscribe()
+{
+  if (!this->dataPtr->node.Subscribe(this->dataPtr->topic,
+      &SimClockPrivate::OnMsg, this->dataPtr.get()))
+  {
+    gzerr << "Failed to subscribe to [" << this->dataPtr->topic << "]"
+          << std::endl;
+    return false;
+  }
+
+  gzmsg << "Listening to stats on [" << this->dataPtr->topic << "]"
+        << std::endl;
+  return true;
+}
+
+/////////////////////////////////////////////////
+const std::string &SimClock::Topic() const
+{
+  return this->dataPtr->topic;
+}
+
+/////////////////////////////////////////////////
+SimClock::State SimClock::Latest() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->state;
+}
+
+/////////////////////////////////////////////////
+std::chrono::steady_clock::duration SimClock::SimTime() const
+{
+  return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::nanoseconds(this->dataPtr->simTimeNs.load()));
+}
+
+/////////////////////////////////////////////////
+bool SimClock::Paused() const
+{
+  return this->dataPtr->paused;
+}
+
+/////////////////////////////////////////////////
+uint64_t SimClock::Iterations() const
+{
+  return this->dataPtr->iterations;
+}
+
+/////////////////////////////////////////////////
+void SimClockPrivate::OnMsg(const msgs::WorldStatistics &_msg)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto &s = this->state;
+    ++s.version;
+    if (_msg.has_sim_time())
+    {
+      s.hasSimTime = true;
+      s.simTime = math::secNsecToDuration(_msg.sim_time().sec(),
+          _msg.sim_time().nsec());
+      this->simTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          s.simTime).count();
+    }
+    s.latestHasRealTime = _msg.has_real_time();
+    if (_msg.has_real_time())
+    {
+      s.hasRealTime = true;
+      s.realTime = math::secNsecToDuration(_msg.real_time().sec(),
+          _msg.real_time().nsec());
+    }
+    s.realTimeFactor = _msg.real_time_factor();
+    s.paused = _msg.paused();
+    // (deprecated) Remove the header check in Gazebo H
+    const auto &header = _msg.header();
+    s.stepping = _msg.stepping() ||
+        (header.data_size() > 0 && header.data(0).key() == "step");
+    s.iterations = _msg.iterations();
+
+    this->paused = s.paused;
+    this->iterations = s.iterations;
+  }
+  this->updated->Set(true);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <gz/msgs/world_stats.pb.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <gz/common/Console.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/SimClock.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./SimClock_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(SimClockTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Shared))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  EXPECT_EQ(nullptr, SimClock::ForTopic(""));
+
+  auto clock = SimClock::ForTopic("/sim_clock_shared");
+  ASSERT_NE(nullptr, clock);
+  EXPECT_EQ("/sim_clock_shared", clock->Topic());
+  EXPECT_EQ(clock, SimClock::ForTopic("/sim_clock_shared"));
+  EXPECT_NE(clock, SimClock::ForTopic("/sim_clock_other"));
+
+  // Nothing received yet
+  EXPECT_EQ(0u, clock->Latest().version);
+  EXPECT_EQ(std::chrono::steady_clock::duration::zero(), clock->SimTime());
+  EXPECT_EQ(0u, clock->Iterations());
+
+  // Created again once nobody holds it
+  std::weak_ptr<SimClock> weak = clock;
+  clock.reset();
+  EXPECT_TRUE(weak.expired());
+  EXPECT_NE(nullptr, SimClock::ForTopic("/sim_clock_shared"));
+}
+
+/////////////////////////////////////////////////
+TEST(SimClockTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Updated))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  auto clock = SimClock::ForTopic("/sim_clock_updated");
+  ASSERT_NE(nullptr, clock);
+
+  int updates{0};
+  QObject::connect(clock.get(), &SimClock::Updated,
+      [&updates]()
+      {
+        ++updates;
+      });
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::WorldStatistics>("/sim_clock_updated");
+
+  msgs::WorldStatistics msg;
+  msg.mutable_sim_time()->set_sec(12);
+  msg.mutable_sim_time()->set_nsec(500000000);
+  msg.set_paused(true);
+  msg.set_iterations(12500);
+  msg.set_real_time_factor(0.5);
+
+  for (int i = 0; i < 30 && clock->Latest().version == 0u; ++i)
+  {
+    pub.Publish(msg);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+  }
+  QCoreApplication::processEvents();
+
+  auto state = clock->Latest();
+  EXPECT_LT(0u, state.version);
+  EXPECT_LT(0, updates);
+  EXPECT_TRUE(state.hasSimTime);
+  EXPECT_EQ(std::chrono::milliseconds(12500), state.simTime);
+  EXPECT_FALSE(state.hasRealTime);
+  EXPECT_FALSE(state.latestHasRealTime);
+  EXPECT_DOUBLE_EQ(0.5, state.realTimeFactor);
+  EXPECT_TRUE(state.paused);
+  EXPECT_FALSE(state.stepping);
+  EXPECT_EQ(12500u, state.iterations);
+
+  EXPECT_EQ(std::chrono::milliseconds(12500), clock->SimTime());
+  EXPECT_TRUE(clock->Paused());
+  EXPECT_EQ(12500u, clock->Iterations());
+
+  // Fields missing from a message keep their latest value
+  msgs::WorldStatistics stepMsg;
+  stepMsg.mutable_real_time()->set_sec(3);
+  stepMsg.set_stepping(true);
+  stepMsg.set_iterations(12501);
+  pub.Publish(stepMsg);
+  for (int i = 0; i < 30 && clock->Iterations() != 12501u; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+  }
+
+  state = clock->Latest();
+  EXPECT_EQ(std::chrono::milliseconds(12500), state.simTime);
+  EXPECT_TRUE(state.hasRealTime);
+  EXPECT_TRUE(state.latestHasRealTime);
+  EXPECT_EQ(std::chrono::seconds(3), state.realTime);
+  EXPECT_FALSE(state.paused);
+  EXPECT_TRUE(state.stepping);
+  EXPECT_EQ(12501u, state.iterations);
+}
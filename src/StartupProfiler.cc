@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "gz/gui/StartupProfiler.hh"
+
+namespace
+{
+  /// \brief A recorded step
+  struct Event
+  {
+    /// \brief Name of the step
+    std::string name;
+
+    /// \brief Kind of step, empty for marks and zones
+    std::string category;
+
+    /// \brief Start, in microseconds since the profiler was enabled
+    int64_t start{0};
+
+    /// \brief Duration in microseconds, negative for marks
+    int64_t duration{-1};
+
+    /// \brief Index of the thread which recorded it
+    int thread{0};
+  };
+
+  /// \brief Global profiler state
+  struct Profile
+  {
+    /// \brief Protects everything but enabled
+    std::mutex mutex;
+
+    /// \brief Checked before taking the mutex, so disabled profiling only
+    /// costs a load
+    std::atomic<bool> enabled{false};
+
+    /// \brief File to write the trace to
+    std::string path;
+
+    /// \brief Time of Enable
+    gz::gui::StartupProfiler::Clock::time_point origin;
+
+    /// \brief Recorded steps
+    std::vector<Event> events;
+
+    /// \brief Small index for each thread, in order of first event, so the
+    /// GUI thread is usually 0
+    std::map<std::thread::id, int> threads;
+
+    /// \brief Names of the threads, kept across Enable
+    std::map<std::thread::id, std::string> names;
+  };
+
+  /////////////////////////////////////////////////
+  Profile &profile()
+  {
+    static Profile instance;
+    return instance;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Must be called with the mutex locked
+  int threadIndex(Profile &_profile)
+  {
+    auto id = std::this_thread::get_id();
+    auto it = _profile.threads.find(id);
+    if (it != _profile.threads.end())
+      return it->second;
+
+    int index = static_cast<int>(_profile.threads.size());
+    _profile.threads[id] = index;
+    return index;
+  }
+
+  /////////////////////////////////////////////////
+  std::string escape(const std::string &_str)
+  {
+    std::string result;
+    result.reserve(_str.size());
+    for (auto c : _str)
+    {
+      if (c == '"' || c == '\\')
+      {
+        result += '\\';
+        result += c;
+      }
+      else if (static_cast<unsigned char>(c) < 0x20)
+      {
+        char code[7];
+        std::snprintf(code, sizeof(code), "\\u%04x",
+            static_cast<unsigned int>(c));
+        result += code;
+      }
+      else
+      {
+        result += c;
+      }
+    }
+    return result;
+  }
+}
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+StartupProfiler::Scope::Scope(const std::string &_name,
+    const std::string &_category)
+  : enabled(StartupProfiler::Enabled())
+{
+  if (!this->enabled)
+    return;
+
+  this->name = _name;
+  this->category = _category;
+  this->start = Clock::now();
+}
+
+/////////////////////////////////////////////////
+StartupProfiler::Scope::~Scope()
+{
+  if (this->enabled)
+    StartupProfiler::Record(this->name, this->category, this->start,
+        Clock::now());
+}
+
+/////////////////////////////////////////////////
+void StartupProfiler::Enable(const std::string &_path)
+{
+  auto &p = profile();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  p.path = _path;
+  p.origin = Clock::now();
+  p.events.clear();
+  p.threads.clear();
+  threadIndex(p);
+  p.enabled = true;
+}
+
+/////////////////////////////////////////////////
+bool StartupProfiler::Enabled()
+{
+  return profile().enabled;
+}
+
+/////////////////////////////////////////////////
+void StartupProfiler::Record(const std::string &_name,
+    const std::string &_category, Clock::time_point _start,
+    Clock::time_point _end)
+{
+  auto &p = profile();
+  if (!p.enabled)
+    return;
+
+  std::lock_guard<std::mutex> lock(p.mutex);
+  Event event;
+  event.name = _name;
+  event.category = _category;
+  event.start = std::chrono::duration_cast<std::chrono::microseconds>(
+      _start - p.origin).count();
+  event.duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      _end - _start).count();
+  event.thread = threadIndex(p);
+  p.events.push_back(event);
+}
+
+/////////////////////////////////////////////////
+void StartupProfiler::Mark(const std::string &_name)
+{
+  auto &p = profile();
+  if (!p.enabled)
+    return;
+
+  std::lock_guard<std::mutex> lock(p.mutex);
+  Event event;
+  event.name = _name;
+  event.start = std::chrono::duration_cast<std::chrono::microseconds>(
+      Clock::now() - p.origin).count();
+  event.thread = threadIndex(p);
+  p.events.push_back(event);
+}
+
+/////////////////////////////////////////////////
+void StartupProfiler::SetThreadName(const std::string &_name)
+{
+  auto &p = profile();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  p.names[std::this_thread::get_id()] = _name;
+}
+
+/////////////////////////////////////////////////
+bool StartupProfiler::Write()
+{
+  auto &p = profile();
+  if (!p.enabled)
+    return false;
+
+  std::lock_guard<std::mutex> lock(p.mutex);
+  p.enabled = false;
+
+  std::ofstream file(p.path);
+  if (!file.is_open())
+  {
+    gzerr << "Failed to write startup profile [" << p.path << "]"
+          << std::endl;
+    return false;
+  }
+
+  file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first{true};
+  for (const auto &thread : p.threads)
+  {
+    auto name = p.names.find(thread.first);
+    if (name == p.names.end())
+      continue;
+    file << (first ? "" : ",") << "\n{\"pid\":0,\"tid\":" << thread.second
+         << ",\"name\":\"thread_name\",\"ph\":\"M\",\"args\":{\"name\":\""
+         << escape(name->second) << "\"}}";
+    first = false;
+  }
+  for (const auto &event : p.events)
+  {
+    file << (first ? "" : ",") << "\n{\"pid\":0,\"tid\":" << event.thread
+         << ",\"ts\":" << event.start;
+    first = false;
+    if (event.duration < 0)
+    {
+      file << ",\"name\":\"" << escape(event.name) << "\""
+           << ",\"ph\":\"i\",\"s\":\"g\"}";
+    }
+    else if (event.category.empty())
+    {
+      file << ",\"name\":\"" << escape(event.name) << "\""
+           << ",\"cat\":\"zone\",\"ph\":\"X\",\"dur\":" << event.duration
+           << ",\"args\":{\"name\":\"" << escape(event.name) << "\"}}";
+    }
+    else
+    {
+      // Labeled with both, so steps of different plugins can be told apart
+      file << ",\"name\":\"" << escape(event.category) << " ["
+           << escape(event.name) << "]\""
+           << ",\"cat\":\"" << escape(event.category) << "\""
+           << ",\"ph\":\"X\",\"dur\":" << event.duration
+           << ",\"args\":{\"name\":\"" << escape(event.name) << "\"}}";
+    }
+  }
+  file << "\n]}\n";
+
+  gzmsg << "Wrote startup profile with " << p.events.size()
+        << " steps to [" << p.path << "]" << std::endl;
+  return true;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gz/common/Filesystem.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/StartupProfiler.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(StartupProfilerTest, Write)
+{
+  auto path = common::joinPaths(std::string(PROJECT_BINARY_PATH),
+      "startup_profile_TEST.json");
+
+  // Disabled by default
+  EXPECT_FALSE(StartupProfiler::Enabled());
+  {
+    StartupProfiler::Scope scope("ignored", "Before enabling");
+  }
+  EXPECT_FALSE(StartupProfiler::Write());
+
+  StartupProfiler::Enable(path);
+  EXPECT_TRUE(StartupProfiler::Enabled());
+
+  {
+    StartupProfiler::Scope scope("Plugin \"A\"", "Load library");
+    std::thread thread([]()
+    {
+      StartupProfiler::Scope threadScope("B", "Find library");
+    });
+    thread.join();
+  }
+  StartupProfiler::Mark("First frame");
+
+  EXPECT_TRUE(StartupProfiler::Write());
+  EXPECT_FALSE(StartupProfiler::Enabled());
+
+  // Nothing is recorded or written after that
+  StartupProfiler::Mark("Too late");
+  EXPECT_FALSE(StartupProfiler::Write());
+
+  std::ifstream file(path);
+  ASSERT_TRUE(file.is_open());
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  auto trace = buffer.str();
+
+  EXPECT_EQ(0u, trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_NE(std::string::npos,
+      trace.find("\"name\":\"Load library [Plugin \\\"A\\\"]\""));
+  EXPECT_NE(std::string::npos, trace.find("\"cat\":\"Find library\""));
+  EXPECT_NE(std::string::npos, trace.find("\"tid\":1"));
+  EXPECT_NE(std::string::npos, trace.find("\"name\":\"First frame\""));
+  EXPECT_EQ(std::string::npos, trace.find("Before enabling"));
+  EXPECT_EQ(std::string::npos, trace.find("Too late"));
+
+  common::removeFile(path);
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "gz/gui/Plugin.hh"
+#include "gz/gui/StaticPlugins.hh"
+
+namespace
+{
+  /// \brief Registered plugins
+  struct Registry
+  {
+    /// \brief Protects factories, since plugins may be registered while
+    /// others are created
+    std::mutex mutex;
+
+    /// \brief Factories by plugin filename
+    std::map<std::string, gz::gui::StaticPlugins::Factory> factories;
+  };
+
+  /////////////////////////////////////////////////
+  /// \brief Created on first use, since plugins register during static
+  /// initialization
+  Registry &registry()
+  {
+    static Registry instance;
+    return instance;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Strip the directory, "lib" prefix and extension of a library
+  /// filename, so "libPublisher.so" finds "Publisher"
+  std::string pluginName(const std::string &_filename)
+  {
+    auto name = _filename;
+    auto slash = name.find_last_of("/\\");
+    if (slash != std::string::npos)
+      name = name.substr(slash + 1);
+    if (name.size() > 3 && name.compare(0, 3, "lib") == 0)
+      name = name.substr(3);
+    auto dot = name.find('.');
+    if (dot != std::string::npos)
+      name = name.substr(0, dot);
+    return name;
+  }
+}
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+bool StaticPlugins::Register(const std::string &_filename, Factory _factory)
+{
+  if (_filename.empty() || !_factory)
+    return false;
+
+  auto &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  if (!r.factories.emplace(_filename, std::move(_factory)).second)
+  {
+    gzerr << "Plugin [" << _filename << "] is linked into the executable "
+          << "more than once, keeping the first one" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool StaticPlugins::Has(const std::string &_filename)
+{
+  auto &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  return r.factories.count(_filename) > 0 ||
+      r.factories.count(pluginName(_filename)) > 0;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<Plugin> StaticPlugins::Instantiate(
+    const std::string &_filename)
+{
+  Factory factory;
+  {
+    auto &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    auto it = r.factories.find(_filename);
+    if (it == r.factories.end())
+      it = r.factories.find(pluginName(_filename));
+    if (it == r.factories.end())
+      return nullptr;
+    factory = it->second;
+  }
+
+  // Plugins may register others while they're created
+  return factory();
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> StaticPlugins::Filenames()
+{
+  auto &r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  std::vector<std::string> filenames;
+  filenames.reserve(r.factories.size());
+  for (const auto &factory : r.factories)
+    filenames.push_back(factory.first);
+  return filenames;
+}
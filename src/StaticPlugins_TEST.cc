@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Plugin.hh"
+#include "gz/gui/StaticPlugins.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(StaticPluginsTest, Register)
+{
+  EXPECT_FALSE(StaticPlugins::Has("StaticTestPlugin"));
+  EXPECT_EQ(nullptr, StaticPlugins::Instantiate("StaticTestPlugin"));
+
+  int created{0};
+  EXPECT_TRUE(StaticPlugins::Register("StaticTestPlugin", [&created]()
+  {
+    ++created;
+    return std::make_shared<Plugin>();
+  }));
+
+  // Registered once
+  EXPECT_FALSE(StaticPlugins::Register("StaticTestPlugin", []()
+  {
+    return std::make_shared<Plugin>();
+  }));
+  EXPECT_FALSE(StaticPlugins::Register("", []()
+  {
+    return std::make_shared<Plugin>();
+  }));
+  EXPECT_FALSE(StaticPlugins::Register("Null", nullptr));
+
+  // Found by library filename too
+  EXPECT_TRUE(StaticPlugins::Has("StaticTestPlugin"));
+  EXPECT_TRUE(StaticPlugins::Has("libStaticTestPlugin.so"));
+  EXPECT_TRUE(StaticPlugins::Has("/usr/lib/libStaticTestPlugin.dylib"));
+  EXPECT_FALSE(StaticPlugins::Has("StaticTest"));
+
+  // A new plugin each time
+  auto first = StaticPlugins::Instantiate("StaticTestPlugin");
+  auto second = StaticPlugins::Instantiate("libStaticTestPlugin.so");
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(2, created);
+
+  auto filenames = StaticPlugins::Filenames();
+  ASSERT_EQ(1u, filenames.size());
+  EXPECT_EQ("StaticTestPlugin", filenames[0]);
+}
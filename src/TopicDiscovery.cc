@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gz/transport/MessageInfo.hh>
+#include <gz/transport/Node.hh>
+#include <gz/transport/Publisher.hh>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/TopicDiscovery.hh"
+
+// Period of the topic listing in ms
+#define DISCOVERY_PERIOD (1000)
+
+namespace gz
+{
+  namespace gui
+  {
+    class TopicDiscoveryPrivate
+    {
+      /// \brief Node to list the topics
+      public: transport::Node node;
+
+      /// \brief Message types of the publishers of each known topic, the
+      /// first publisher's first
+      public: std::map<std::string, std::vector<std::string>> topics;
+
+      /// \brief Timer to list the topics
+      public: QTimer timer;
+    };
+  }
+}
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TopicDiscovery *TopicDiscovery::Instance()
+{
+  // Deleted with the application
+  static QPointer<TopicDiscovery> instance;
+  if (!instance)
+  {
+    instance = new TopicDiscovery(App());
+    instance->Refresh();
+  }
+  return instance;
+}
+
+/////////////////////////////////////////////////
+TopicDiscovery::TopicDiscovery(QObject *_parent)
+  : QObject(_parent), dataPtr(std::make_unique<TopicDiscoveryPrivate>())
+{
+  this->connect(&this->dataPtr->timer, &QTimer::timeout, this,
+      &TopicDiscovery::Refresh);
+  this->dataPtr->timer.start(DISCOVERY_PERIOD);
+}
+
+/////////////////////////////////////////////////
+TopicDiscovery::~TopicDiscovery()
+{
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> TopicDiscovery::Topics() const
+{
+  std::vector<std::string> topics;
+  topics.reserve(this->dataPtr->topics.size());
+  for (const auto &topic : this->dataPtr->topics)
+    topics.push_back(topic.first);
+  return topics;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> TopicDiscovery::Topics(
+    const std::string &_msgType) const
+{
+  std::vector<std::string> topics;
+  for (const auto &topic : this->dataPtr->topics)
+  {
+    if (std::find(topic.second.begin(), topic.second.end(), _msgType) !=
+        topic.second.end())
+    {
+      topics.push_back(topic.first);
+    }
+  }
+  return topics;
+}
+
+/////////////////////////////////////////////////
+std::string TopicDiscovery::MsgType(const std::string &_topic) const
+{
+  auto it = this->dataPtr->topics.find(_topic);
+  if (it == this->dataPtr->topics.end() || it->second.empty())
+    return std::string();
+  return it->second.front();
+}
+
+/////////////////////////////////////////////////
+void TopicDiscovery::Refresh()
+{
+  std::vector<std::string> list;
+  this->dataPtr->node.TopicList(list);
+  std::set<std::string> current(list.begin(), list.end());
+
+  // Both are sorted, so they're compared in a single pass
+  auto &known = this->dataPtr->topics;
+  std::vector<std::string> removed;
+  std::vector<std::string> added;
+  auto knownIt = known.begin();
+  auto currentIt = current.begin();
+  while (knownIt != known.end() || currentIt != current.end())
+  {
+    if (currentIt == current.end() ||
+        (knownIt != known.end() && knownIt->first < *currentIt))
+    {
+      removed.push_back(knownIt->first);
+      ++knownIt;
+    }
+    else if (knownIt == known.end() || *currentIt < knownIt->first)
+    {
+      added.push_back(*currentIt);
+      ++currentIt;
+    }
+    else
+    {
+      ++knownIt;
+      ++currentIt;
+    }
+  }
+
+  for (const auto &topic : removed)
+  {
+    known.erase(topic);
+    this->TopicRemoved(QString::fromStdString(topic));
+  }
+
+  // Only new topics are queried for their types
+  for (const auto &topic : added)
+  {
+    std::vector<transport::MessagePublisher> publishers;
+    this->dataPtr->node.TopicInfo(topic, publishers);
+    if (publishers.empty())
+      continue;
+
+    auto &types = known[topic];
+    for (const auto &pub : publishers)
+    {
+      if (std::find(types.begin(), types.end(), pub.MsgTypeName()) ==
+          types.end())
+      {
+        types.push_back(pub.MsgTypeName());
+      }
+    }
+    this->TopicAdded(QString::fromStdString(topic),
+        QString::fromStdString(types.front()));
+  }
+}
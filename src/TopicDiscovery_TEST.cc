@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <gz/msgs/int32.pb.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/TopicDiscovery.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./TopicDiscovery_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+bool Contains(const std::vector<std::string> &_topics,
+    const std::string &_topic)
+{
+  return std::find(_topics.begin(), _topics.end(), _topic) != _topics.end();
+}
+
+/////////////////////////////////////////////////
+TEST(TopicDiscoveryTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(AddRemove))
+{
+  common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  auto discovery = TopicDiscovery::Instance();
+  ASSERT_NE(nullptr, discovery);
+  EXPECT_EQ(discovery, TopicDiscovery::Instance());
+  EXPECT_EQ(app.findChild<TopicDiscovery *>(), discovery);
+
+  std::vector<std::string> added;
+  std::vector<std::string> removed;
+  QObject::connect(discovery, &TopicDiscovery::TopicAdded,
+      [&added](const QString &_topic, const QString &)
+      {
+        added.push_back(_topic.toStdString());
+      });
+  QObject::connect(discovery, &TopicDiscovery::TopicRemoved,
+      [&removed](const QString &_topic)
+      {
+        removed.push_back(_topic.toStdString());
+      });
+
+  // Advertise
+  auto node = std::make_unique<transport::Node>();
+  auto pub = node->Advertise<msgs::Int32>("/discovery_test");
+  for (int i = 0; i < 30 && !Contains(added, "/discovery_test"); ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    discovery->Refresh();
+  }
+  EXPECT_TRUE(Contains(added, "/discovery_test"));
+  EXPECT_TRUE(Contains(discovery->Topics(), "/discovery_test"));
+  EXPECT_TRUE(Contains(discovery->Topics("gz.msgs.Int32"), "/discovery_test"));
+  EXPECT_FALSE(Contains(discovery->Topics("gz.msgs.Image"),
+      "/discovery_test"));
+  EXPECT_EQ("gz.msgs.Int32", discovery->MsgType("/discovery_test"));
+  EXPECT_TRUE(discovery->MsgType("/not_a_topic").empty());
+
+  // Known topics aren't notified again
+  auto addedCount = added.size();
+  discovery->Refresh();
+  EXPECT_EQ(addedCount, added.size());
+
+  // Stop advertising
+  pub = transport::Node::Publisher();
+  node.reset();
+  for (int i = 0; i < 30 && !Contains(removed, "/discovery_test"); ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    discovery->Refresh();
+  }
+  EXPECT_TRUE(Contains(removed, "/discovery_test"));
+  EXPECT_FALSE(Contains(discovery->Topics(), "/discovery_test"));
+}
@@ -0,0 +1,482 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "gz/gui/Profiler.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/WorkerPool.hh"
+
+namespace
+{
+  /// \brief Number of priorities
+  constexpr std::size_t kPriorityCount = 3;
+
+  /// \brief Queued task
+  struct QueuedTask
+  {
+    /// \brief Function
+    gz::gui::WorkerPool::Task task;
+
+    /// \brief Owner, may be null
+    const void *owner{nullptr};
+  };
+
+  /// \brief Queues of a priority
+  using Queues = std::array<std::deque<QueuedTask>, kPriorityCount>;
+
+  /// \brief Global pool state
+  struct Pool
+  {
+    /// \brief Stop the workers, if they're running
+    ~Pool();
+
+    /// \brief Start the workers, if they're not running. Must be called
+    /// with the mutex locked.
+    void Start();
+
+    /// \brief Take the next task for a worker. Must be called with the
+    /// mutex locked.
+    /// \param[in] _worker Index of the worker
+    /// \param[out] _task Task taken
+    /// \return False if there's none
+    bool Take(std::size_t _worker, QueuedTask &_task);
+
+    /// \brief Run a worker
+    /// \param[in] _worker Index of the worker
+    void Work(std::size_t _worker);
+
+    /// \brief Run the functions queued for the render thread
+    void RunRenderTasks();
+
+    /// \brief Mark a task of an owner as done. Must be called with the
+    /// mutex locked.
+    /// \param[in] _owner Owner
+    void Done(const void *_owner);
+
+    /// \brief Protects everything
+    std::mutex mutex;
+
+    /// \brief Wakes the workers up when tasks are queued or they stop
+    std::condition_variable workCondition;
+
+    /// \brief Notified when a task is done, for Cancel
+    std::condition_variable doneCondition;
+
+    /// \brief Tasks posted from outside of the workers
+    Queues injected;
+
+    /// \brief Tasks posted by each worker
+    std::vector<Queues> local;
+
+    /// \brief Number of queued tasks
+    std::size_t pending{0u};
+
+    /// \brief Functions waiting for the render thread
+    std::vector<QueuedTask> renderTasks;
+
+    /// \brief Number of running tasks of each owner
+    std::map<const void *, int> running;
+
+    /// \brief Owners being canceled
+    std::multiset<const void *> canceling;
+
+    /// \brief Worker threads
+    std::vector<std::thread> threads;
+
+    /// \brief Number of workers to start, 0 for the default
+    std::size_t threadCount{0u};
+
+    /// \brief True while the workers are stopping
+    bool stopping{false};
+
+    /// \brief Render hook running renderTasks, registered once
+    uint64_t renderHookId{0u};
+  };
+
+  /// \brief Index of the worker of the calling thread, -1 if it's not one
+  thread_local int t_worker{-1};
+
+  /// \brief Owner of the task running on the calling thread
+  thread_local const void *t_owner{nullptr};
+
+  /////////////////////////////////////////////////
+  Pool &pool()
+  {
+    static Pool instance;
+    return instance;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Remove an owner's tasks from queues
+  /// \param[in, out] _queues Queues
+  /// \param[in] _owner Owner
+  /// \return Number of tasks removed
+  std::size_t removeOwner(Queues &_queues, const void *_owner)
+  {
+    std::size_t removed{0u};
+    for (auto &queue : _queues)
+    {
+      auto size = queue.size();
+      queue.erase(std::remove_if(queue.begin(), queue.end(),
+          [_owner](const QueuedTask &_task) {return _task.owner == _owner;}),
+          queue.end());
+      removed += size - queue.size();
+    }
+    return removed;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Run a task, reporting exceptions instead of terminating
+  /// \param[in] _task Task
+  void runTask(const QueuedTask &_task)
+  {
+    t_owner = _task.owner;
+    try
+    {
+      _task.task();
+    }
+    catch (const std::exception &_e)
+    {
+      gzerr << "Worker task threw: " << _e.what() << std::endl;
+    }
+    catch (...)
+    {
+      gzerr << "Worker task threw an unknown exception" << std::endl;
+    }
+    t_owner = nullptr;
+  }
+
+  /////////////////////////////////////////////////
+  Pool::~Pool()
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->stopping = true;
+    lock.unlock();
+    this->workCondition.notify_all();
+    for (auto &thread : this->threads)
+      thread.join();
+  }
+
+  /////////////////////////////////////////////////
+  void Pool::Start()
+  {
+    if (!this->threads.empty() || this->stopping)
+      return;
+
+    auto count = this->threadCount;
+    if (count == 0u)
+    {
+      count = std::max(2u, std::thread::hardware_concurrency()) - 1u;
+    }
+
+    this->local.assign(count, Queues());
+    for (std::size_t i = 0; i < count; ++i)
+      this->threads.emplace_back(&Pool::Work, this, i);
+  }
+
+  /////////////////////////////////////////////////
+  bool Pool::Take(std::size_t _worker, QueuedTask &_task)
+  {
+    for (std::size_t priority = 0; priority < kPriorityCount; ++priority)
+    {
+      // Own tasks newest first, they're the most likely to be in cache
+      auto &own = this->local[_worker][priority];
+      if (!own.empty())
+      {
+        _task = std::move(own.back());
+        own.pop_back();
+        return true;
+      }
+
+      auto &injected = this->injected[priority];
+      if (!injected.empty())
+      {
+        _task = std::move(injected.front());
+        injected.pop_front();
+        return true;
+      }
+
+      // Steal the oldest task of another worker
+      for (std::size_t i = 1; i < this->local.size(); ++i)
+      {
+        auto &other = this->local[(_worker + i) % this->local.size()]
+            [priority];
+        if (!other.empty())
+        {
+          _task = std::move(other.front());
+          other.pop_front();
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  /////////////////////////////////////////////////
+  void Pool::Work(std::size_t _worker)
+  {
+    GZ_GUI_PROFILE_THREAD_NAME("Worker");
+    t_worker = static_cast<int>(_worker);
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true)
+    {
+      this->workCondition.wait(lock, [this]
+          {return this->stopping || this->pending > 0u;});
+      if (this->stopping)
+        break;
+
+      QueuedTask task;
+      if (!this->Take(_worker, task))
+        continue;
+      --this->pending;
+      ++this->running[task.owner];
+
+      lock.unlock();
+      {
+        GZ_GUI_PROFILE("WorkerPool::Task");
+        runTask(task);
+      }
+      task.task = nullptr;
+      lock.lock();
+
+      this->Done(task.owner);
+    }
+    t_worker = -1;
+  }
+
+  /////////////////////////////////////////////////
+  void Pool::Done(const void *_owner)
+  {
+    auto it = this->running.find(_owner);
+    if (it != this->running.end() && --it->second == 0)
+      this->running.erase(it);
+    this->doneCondition.notify_all();
+  }
+
+  /////////////////////////////////////////////////
+  void Pool::RunRenderTasks()
+  {
+    std::vector<QueuedTask> tasks;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (this->renderTasks.empty())
+        return;
+      tasks.swap(this->renderTasks);
+      for (const auto &task : tasks)
+        ++this->running[task.owner];
+    }
+
+    GZ_GUI_PROFILE("WorkerPool::RunRenderTasks");
+    for (auto &task : tasks)
+    {
+      bool canceled{false};
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        canceled = this->canceling.count(task.owner) > 0u;
+      }
+      if (!canceled)
+        runTask(task);
+      task.task = nullptr;
+
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->Done(task.owner);
+    }
+  }
+}
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+void WorkerPool::Post(Task _task, const void *_owner, Priority _priority)
+{
+  if (!_task)
+    return;
+
+  auto &p = pool();
+  {
+    std::lock_guard<std::mutex> lock(p.mutex);
+
+    // Posted by a task of an owner being canceled
+    if (nullptr != _owner && p.canceling.count(_owner) > 0u)
+      return;
+    p.Start();
+
+    auto priority = static_cast<std::size_t>(_priority);
+    if (t_worker >= 0 && static_cast<std::size_t>(t_worker) < p.local.size())
+      p.local[t_worker][priority].push_back({std::move(_task), _owner});
+    else
+      p.injected[priority].push_back({std::move(_task), _owner});
+    ++p.pending;
+  }
+  p.workCondition.notify_one();
+}
+
+/////////////////////////////////////////////////
+void WorkerPool::Post(Task _task, Task _onRender, const void *_owner,
+    Priority _priority)
+{
+  Post([task = std::move(_task), onRender = std::move(_onRender), _owner]()
+      {
+        if (task)
+          task();
+        if (!Canceled())
+          RunOnRenderThread(onRender, _owner);
+      }, _owner, _priority);
+}
+
+/////////////////////////////////////////////////
+void WorkerPool::RunOnRenderThread(Task _task, const void *_owner)
+{
+  if (!_task)
+    return;
+
+  auto &p = pool();
+  bool registerHook{false};
+  {
+    std::lock_guard<std::mutex> lock(p.mutex);
+    if (nullptr != _owner && p.canceling.count(_owner) > 0u)
+      return;
+    p.renderTasks.push_back({std::move(_task), _owner});
+    if (p.renderHookId == 0u)
+    {
+      // Marked before registering, so it's registered once
+      p.renderHookId = UINT64_MAX;
+      registerHook = true;
+    }
+  }
+
+  // Before the other hooks, so continuations are seen by them
+  if (registerHook)
+  {
+    auto id = RenderHooks::Register(RenderPhase::kPreRender,
+        [] {pool().RunRenderTasks();}, -1000, "WorkerPool");
+    std::lock_guard<std::mutex> lock(p.mutex);
+    p.renderHookId = id;
+  }
+}
+
+/////////////////////////////////////////////////
+void WorkerPool::Cancel(const void *_owner)
+{
+  if (nullptr == _owner)
+    return;
+
+  auto &p = pool();
+  std::unique_lock<std::mutex> lock(p.mutex);
+  auto canceling = p.canceling.insert(_owner);
+
+  std::size_t removed = removeOwner(p.injected, _owner);
+  for (auto &queues : p.local)
+    removed += removeOwner(queues, _owner);
+  p.pending -= removed;
+
+  p.renderTasks.erase(std::remove_if(p.renderTasks.begin(),
+      p.renderTasks.end(),
+      [_owner](const QueuedTask &_task) {return _task.owner == _owner;}),
+      p.renderTasks.end());
+
+  // A task canceling its own owner doesn't wait for itself
+  int self = t_owner == _owner ? 1 : 0;
+  p.doneCondition.wait(lock, [&p, _owner, self]
+      {
+        auto it = p.running.find(_owner);
+        return it == p.running.end() || it->second <= self;
+      });
+  p.canceling.erase(canceling);
+}
+
+/////////////////////////////////////////////////
+bool WorkerPool::Canceled()
+{
+  if (nullptr == t_owner)
+    return false;
+
+  auto &p = pool();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  return p.stopping || p.canceling.count(t_owner) > 0u;
+}
+
+/////////////////////////////////////////////////
+void WorkerPool::SetThreadCount(std::size_t _count)
+{
+  auto &p = pool();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  p.threadCount = _count;
+}
+
+/////////////////////////////////////////////////
+std::size_t WorkerPool::ThreadCount()
+{
+  auto &p = pool();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  return p.threads.size();
+}
+
+/////////////////////////////////////////////////
+std::size_t WorkerPool::Pending()
+{
+  auto &p = pool();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  return p.pending;
+}
+
+/////////////////////////////////////////////////
+void WorkerPool::Shutdown()
+{
+  auto &p = pool();
+  std::vector<std::thread> threads;
+  {
+    std::lock_guard<std::mutex> lock(p.mutex);
+    if (p.threads.empty() || p.stopping)
+      return;
+
+    p.stopping = true;
+    for (auto &queue : p.injected)
+      queue.clear();
+    p.local.clear();
+    p.pending = 0u;
+    threads.swap(p.threads);
+  }
+  p.workCondition.notify_all();
+
+  for (auto &thread : threads)
+  {
+    if (thread.get_id() == std::this_thread::get_id())
+      thread.detach();
+    else
+      thread.join();
+  }
+
+  std::lock_guard<std::mutex> lock(p.mutex);
+  p.stopping = false;
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/WorkerPool.hh"
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Wait for a condition
+/// \param[in] _condition Condition
+/// \return True if it became true within 5 seconds
+template <typename F>
+static bool waitFor(F _condition)
+{
+  for (int i = 0; i < 500 && !_condition(); ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  return _condition();
+}
+
+/////////////////////////////////////////////////
+TEST(WorkerPoolTest, Post)
+{
+  std::atomic<int> done{0};
+  for (int i = 0; i < 100; ++i)
+    WorkerPool::Post([&done] {++done;});
+  EXPECT_TRUE(waitFor([&done] {return done == 100;}));
+  EXPECT_GT(WorkerPool::ThreadCount(), 0u);
+
+  // Tasks posted from tasks
+  WorkerPool::Post([&done]
+  {
+    for (int i = 0; i < 10; ++i)
+      WorkerPool::Post([&done] {++done;});
+  });
+  EXPECT_TRUE(waitFor([&done] {return done == 110;}));
+
+  // Restarted after a shutdown
+  WorkerPool::Shutdown();
+  EXPECT_EQ(0u, WorkerPool::ThreadCount());
+  WorkerPool::Post([&done] {++done;});
+  EXPECT_TRUE(waitFor([&done] {return done == 111;}));
+
+  // Nothing to do without a task
+  WorkerPool::Post(nullptr);
+  EXPECT_EQ(0u, WorkerPool::Pending());
+}
+
+/////////////////////////////////////////////////
+TEST(WorkerPoolTest, Priority)
+{
+  WorkerPool::Shutdown();
+  WorkerPool::SetThreadCount(1u);
+
+  // Blocks the only worker while the others are queued
+  std::atomic<bool> release{false};
+  std::atomic<bool> blocked{false};
+  WorkerPool::Post([&] {blocked = true; while (!release) {}});
+  ASSERT_TRUE(waitFor([&blocked] {return blocked.load();}));
+
+  std::mutex mutex;
+  std::vector<int> order;
+  auto record = [&](int _value)
+  {
+    return [&, _value]
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(_value);
+    };
+  };
+  WorkerPool::Post(record(2), nullptr, WorkerPool::Priority::kLow);
+  WorkerPool::Post(record(1), nullptr, WorkerPool::Priority::kNormal);
+  WorkerPool::Post(record(0), nullptr, WorkerPool::Priority::kHigh);
+  EXPECT_EQ(3u, WorkerPool::Pending());
+  release = true;
+
+  ASSERT_TRUE(waitFor([&]
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return order.size() == 3u;
+  }));
+  EXPECT_EQ((std::vector<int>{0, 1, 2}), order);
+
+  WorkerPool::Shutdown();
+  WorkerPool::SetThreadCount(0u);
+}
+
+/////////////////////////////////////////////////
+TEST(WorkerPoolTest, Cancel)
+{
+  WorkerPool::Shutdown();
+  WorkerPool::SetThreadCount(1u);
+
+  int owner{0};
+  std::atomic<bool> started{false};
+  std::atomic<bool> canceled{false};
+  std::atomic<int> done{0};
+  WorkerPool::Post([&]
+  {
+    started = true;
+    while (!WorkerPool::Canceled()) {}
+    canceled = true;
+  }, &owner);
+  ASSERT_TRUE(waitFor([&started] {return started.load();}));
+
+  // Queued behind the running task
+  WorkerPool::Post([&done] {++done;}, &owner);
+  WorkerPool::Post([&done] {++done;}, &owner);
+  WorkerPool::RunOnRenderThread([&done] {++done;}, &owner);
+  EXPECT_EQ(2u, WorkerPool::Pending());
+
+  // Waits for the running task, which sees it
+  EXPECT_FALSE(WorkerPool::Canceled());
+  WorkerPool::Cancel(&owner);
+  EXPECT_TRUE(canceled);
+  EXPECT_EQ(0u, WorkerPool::Pending());
+  RenderHooks::Run(RenderPhase::kPreRender);
+  EXPECT_EQ(0, done);
+
+  // The owner can post again
+  WorkerPool::Post([&done] {++done;}, &owner);
+  EXPECT_TRUE(waitFor([&done] {return done == 1;}));
+
+  // Nothing happens without an owner
+  WorkerPool::Cancel(nullptr);
+
+  WorkerPool::Shutdown();
+  WorkerPool::SetThreadCount(0u);
+}
+
+/////////////////////////////////////////////////
+TEST(WorkerPoolTest, RenderThread)
+{
+  int owner{0};
+  std::atomic<bool> worked{false};
+  std::atomic<bool> rendered{false};
+  std::thread::id renderThread;
+  WorkerPool::Post([&worked] {worked = true;},
+      [&] {rendered = true; renderThread = std::this_thread::get_id();},
+      &owner);
+  ASSERT_TRUE(waitFor([&worked] {return worked.load();}));
+
+  // Runs in the next frame's kPreRender hooks, on the render thread
+  ASSERT_TRUE(waitFor([&rendered]
+  {
+    RenderHooks::Run(RenderPhase::kPreRender);
+    return rendered.load();
+  }));
+  EXPECT_EQ(std::this_thread::get_id(), renderThread);
+  EXPECT_EQ(1u, RenderHooks::Count(RenderPhase::kPreRender));
+
+  // Only once
+  rendered = false;
+  RenderHooks::Run(RenderPhase::kPreRender);
+  EXPECT_FALSE(rendered);
+}
@@ -25,6 +25,9 @@ GZ_GUI_COMPLETION_LIST="
   -s --standalone
   -c --config
   -v --verbose
+  --startup-profile
+  --render-device
+  --lite
   -h --help
   --force-version
   --versions
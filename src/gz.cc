@@ -18,14 +18,18 @@
 #include <string.h>
 
 #include <iostream>
+#include <memory>
 
 #include <gz/common/Console.hh>
 
 #include "gz/gui/Application.hh"
 #include "gz/gui/config.hh"
+#include "gz/gui/Dialog.hh"
 #include "gz/gui/Export.hh"
 #include "gz/gui/gz.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/RenderDevice.hh"
+#include "gz/gui/StartupProfiler.hh"
 
 int g_argc = 1;
 char* g_argv[] =
@@ -33,6 +37,9 @@ char* g_argv[] =
   reinterpret_cast<char*>(const_cast<char*>("./ignition")),
 };
 
+/// \brief True if the startup is profiled, rather than the whole session
+bool g_startupProfile{false};
+
 //////////////////////////////////////////////////
 void startConsoleLog()
 {
@@ -45,6 +52,26 @@ void startConsoleLog()
   gzLogInit(logPathMod, "console.log");
 }
 
+//////////////////////////////////////////////////
+/// \brief Write the startup profile, if enabled, once a window shows its
+/// first frame.
+/// \param[in] _window Window to wait for
+void writeProfileOnFirstFrame(QQuickWindow *_window)
+{
+  if (!g_startupProfile || nullptr == _window)
+    return;
+
+  // Called on the render thread, the profiler can be written from any thread
+  auto connection = std::make_shared<QMetaObject::Connection>();
+  *connection = QObject::connect(_window, &QQuickWindow::frameSwapped,
+      [connection]()
+  {
+    QObject::disconnect(*connection);
+    gz::gui::StartupProfiler::Mark("First frame");
+    gz::gui::StartupProfiler::Write();
+  });
+}
+
 //////////////////////////////////////////////////
 extern "C" GZ_GUI_VISIBLE char *gzVersion()
 {
@@ -94,7 +121,14 @@ extern "C" GZ_GUI_VISIBLE void cmdStandalone(const char *_filename)
     return;
   }
 
+  if (auto dialog = app.findChild<gz::gui::Dialog *>())
+    writeProfileOnFirstFrame(dialog->QuickWindow());
+
   app.exec();
+
+  // In case no frame was shown
+  if (g_startupProfile)
+    gz::gui::StartupProfiler::Write();
 }
 
 //////////////////////////////////////////////////
@@ -114,7 +148,14 @@ extern "C" GZ_GUI_VISIBLE void cmdConfig(const char *_config)
     return;
   }
 
+  writeProfileOnFirstFrame(
+      app.findChild<gz::gui::MainWindow *>()->QuickWindow());
+
   app.exec();
+
+  // In case no frame was shown
+  if (g_startupProfile)
+    gz::gui::StartupProfiler::Write();
 }
 
 //////////////////////////////////////////////////
@@ -123,6 +164,25 @@ extern "C" GZ_GUI_VISIBLE void cmdVerbose(const char *_verbosity)
   gz::common::Console::SetVerbosity(std::atoi(_verbosity));
 }
 
+//////////////////////////////////////////////////
+extern "C" GZ_GUI_VISIBLE void cmdStartupProfile(const char *_path)
+{
+  gz::gui::StartupProfiler::Enable(_path);
+  g_startupProfile = true;
+}
+
+//////////////////////////////////////////////////
+extern "C" GZ_GUI_VISIBLE void cmdRenderDevice(const char *_device)
+{
+  gz::gui::RenderDevice::Select(_device);
+}
+
+//////////////////////////////////////////////////
+extern "C" GZ_GUI_VISIBLE void cmdLite()
+{
+  gz::gui::Application::SetLite(true);
+}
+
 //////////////////////////////////////////////////
 extern "C" GZ_GUI_VISIBLE void cmdEmptyWindow()
 {
@@ -137,7 +197,14 @@ extern "C" GZ_GUI_VISIBLE void cmdEmptyWindow()
 
   app.LoadDefaultConfig();
 
+  writeProfileOnFirstFrame(
+      app.findChild<gz::gui::MainWindow *>()->QuickWindow());
+
   app.exec();
+
+  // In case no frame was shown
+  if (g_startupProfile)
+    gz::gui::StartupProfiler::Write();
 }
 
 //////////////////////////////////////////////////
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <iostream>
+#include <string>
+
+#include "gz/gui/gz.hh"
+
+//////////////////////////////////////////////////
+/// \brief Print the options, which are those of `gz gui`
+void printUsage()
+{
+  std::cout
+    << "Gazebo GUI, with the plugins linked in.\n\n"
+    << "  gz-gui [options]\n\n"
+    << "Options:\n\n"
+    << "  -l [ --list ]              List all available plugins.\n"
+    << "  -s [ --standalone ] arg    Run a plugin as a standalone window.\n"
+    << "  -c [ --config ] arg        Open the main window with a "
+    << "configuration file.\n"
+    << "  -v [ --verbose ] [arg]     Adjust the level of console output "
+    << "(0~4).\n"
+    << "  --startup-profile [arg]    Write how long each startup step "
+    << "takes as a\n"
+    << "                             Chrome trace.\n"
+    << "  --render-device arg        Choose the GPU 3D scenes render on.\n"
+    << "  --lite                     Draw without the GPU and skip the "
+    << "plugins which\n"
+    << "                             need a 3D scene.\n"
+    << "  -h [ --help ]              Print this help message.\n";
+}
+
+//////////////////////////////////////////////////
+/// \brief Same as `gz gui`, without loading the library through Ruby
+int main(int _argc, char **_argv)
+{
+  std::string standalone;
+  std::string config;
+  std::string verbose{"1"};
+  bool list{false};
+
+  for (int i = 1; i < _argc; ++i)
+  {
+    std::string arg(_argv[i]);
+
+    // Optional values don't start with a dash
+    bool hasValue = i + 1 < _argc && _argv[i + 1][0] != '-';
+
+    if (arg == "-h" || arg == "--help")
+    {
+      printUsage();
+      return 0;
+    }
+    else if (arg == "-l" || arg == "--list")
+    {
+      list = true;
+    }
+    else if ((arg == "-s" || arg == "--standalone") && hasValue)
+    {
+      standalone = _argv[++i];
+    }
+    else if ((arg == "-c" || arg == "--config") && hasValue)
+    {
+      config = _argv[++i];
+    }
+    else if (arg == "-v" || arg == "--verbose")
+    {
+      verbose = hasValue ? _argv[++i] : "3";
+    }
+    else if (arg == "--startup-profile")
+    {
+      cmdStartupProfile(hasValue ? _argv[++i] : "startup_profile.json");
+    }
+    else if (arg == "--render-device" && hasValue)
+    {
+      cmdRenderDevice(_argv[++i]);
+    }
+    else if (arg == "--lite")
+    {
+      cmdLite();
+    }
+    else
+    {
+      printUsage();
+      return -1;
+    }
+  }
+
+  cmdVerbose(verbose.c_str());
+
+  if (list)
+    cmdPluginList();
+  else if (!standalone.empty())
+    cmdStandalone(standalone.c_str());
+  else if (!config.empty())
+    cmdConfig(config.c_str());
+  else
+    cmdEmptyWindow();
+
+  return 0;
+}
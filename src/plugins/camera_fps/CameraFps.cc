@@ -15,39 +15,105 @@
  *
 */
 
-#include <list>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
 #include <string>
 
+#include <gz/msgs/param.pb.h>
+
 #include <gz/common/Console.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/rendering/RenderingIface.hh>
 #include <gz/rendering/Scene.hh>
+#include <gz/transport/Node.hh>
 
-#include "gz/gui/Application.hh"
-#include "gz/gui/GuiEvents.hh"
-#include "gz/gui/MainWindow.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/StaticPlugins.hh"
 
 #include "CameraFps.hh"
 
 /// \brief Private data class for CameraFps
 class gz::gui::plugins::CameraFpsPrivate
 {
-  /// \brief Previous camera update time
+  /// \brief Number of frames the statistics are computed over
+  public: static constexpr std::size_t kFrameWindow{256u};
+
+  /// \brief A frame longer than this many times the median is a hitch
+  public: static constexpr double kHitchFactor{2.0};
+
+  /// \brief Period of the statistics update, in ms
+  public: static constexpr int kReportPeriodMs{250};
+
+  /// \brief Previous camera update time, only used on the render thread
   public: std::optional<std::chrono::steady_clock::time_point>
       prevCameraUpdateTime;
 
-  /// \brief A moving window of camera update times
-  public: std::list<std::chrono::duration<double>> cameraUpdateTimes;
+  /// \brief Scene whose frames are measured, the first one it's run for,
+  /// only used on the render thread
+  public: std::string scene;
+
+  /// \brief Protects the frame times, the hitch count and the median
+  public: std::mutex mutex;
+
+  /// \brief Ring buffer of the latest frame times, in ms
+  public: std::array<double, kFrameWindow> frameMs{};
+
+  /// \brief Index of the next frame time to write
+  public: std::size_t frameIndex{0u};
+
+  /// \brief Number of valid frame times, up to kFrameWindow
+  public: std::size_t frameCount{0u};
+
+  /// \brief Number of hitches since startup
+  public: uint64_t hitches{0u};
+
+  /// \brief Median of the last report, 0 until there's one
+  public: double p50Ms{0.0};
 
-  /// \brief Sum of all update times in the moving window
-  public: std::chrono::duration<double> cameraUpdateTimeSum;
+  /// \brief Copy of the frame times sorted by the GUI thread, kept so
+  /// reports don't allocate
+  public: std::array<double, kFrameWindow> sortedMs{};
 
-  /// \brief Size of camera update time window
-  /// \todo(anyone) make this configurable
-  public: unsigned int cameraFPSWindowSize = 20u;
+  /// \brief Updates the statistics on the GUI thread
+  public: QTimer reportTimer;
 
   /// \brief Camera FPS string value
   public: QString cameraFPSValue;
+
+  /// \brief Median frame time string
+  public: QString p50Value;
+
+  /// \brief 95th percentile frame time string
+  public: QString p95Value;
+
+  /// \brief 99th percentile frame time string
+  public: QString p99Value;
+
+  /// \brief Worst frame time string
+  public: QString worstValue;
+
+  /// \brief Hitch count reported to the GUI
+  public: int hitchesValue{0};
+
+  /// \brief Topic to publish the statistics on, empty not to publish
+  public: std::string topic;
+
+  /// \brief Node to publish the statistics
+  public: transport::Node node;
+
+  /// \brief Publisher of the statistics
+  public: transport::Node::Publisher pub;
+
+  /// \brief Reused statistics message
+  public: msgs::Param msg;
+
+  /// \brief Render hook identifier
+  public: uint64_t renderHookId{0};
 };
 
 using namespace gz;
@@ -57,6 +123,12 @@ using namespace plugins;
 /////////////////////////////////////////////////
 void CameraFps::OnRender()
 {
+  // The frame rate is the one of the first scene this is run for
+  if (this->dataPtr->scene.empty())
+    this->dataPtr->scene = RenderHooks::Scene();
+  if (!RenderHooks::RunsFor(this->dataPtr->scene))
+    return;
+
   auto now = std::chrono::steady_clock::now();
   if (!this->dataPtr->prevCameraUpdateTime.has_value())
   {
@@ -64,53 +136,159 @@ void CameraFps::OnRender()
     return;
   }
 
-  const std::chrono::duration<double> dt =
-    std::chrono::steady_clock::now() - *this->dataPtr->prevCameraUpdateTime;
+  const std::chrono::duration<double, std::milli> dt =
+      now - *this->dataPtr->prevCameraUpdateTime;
   this->dataPtr->prevCameraUpdateTime = now;
-  this->dataPtr->cameraUpdateTimeSum += dt;
-  if (this->dataPtr->cameraUpdateTimes.size() >=
-      this->dataPtr->cameraFPSWindowSize)
+
+  // Only recorded here, the statistics are computed and formatted on the
+  // GUI thread a few times per second
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &data = *this->dataPtr;
+  data.frameMs[data.frameIndex] = dt.count();
+  data.frameIndex = (data.frameIndex + 1) % CameraFpsPrivate::kFrameWindow;
+  data.frameCount = std::min(data.frameCount + 1,
+      CameraFpsPrivate::kFrameWindow);
+  if (data.p50Ms > 0.0 &&
+      dt.count() > CameraFpsPrivate::kHitchFactor * data.p50Ms)
+  {
+    ++data.hitches;
+  }
+}
+
+/////////////////////////////////////////////////
+void CameraFps::Report()
+{
+  auto &data = *this->dataPtr;
+  std::size_t count;
+  uint64_t hitches;
+  {
+    std::lock_guard<std::mutex> lock(data.mutex);
+    count = data.frameCount;
+    hitches = data.hitches;
+    std::copy(data.frameMs.begin(), data.frameMs.begin() + count,
+        data.sortedMs.begin());
+  }
+  if (count == 0u)
+    return;
+
+  auto begin = data.sortedMs.begin();
+  auto end = begin + count;
+  auto percentile = [&](double _fraction)
+  {
+    auto index = std::min(static_cast<std::size_t>(_fraction * count),
+        count - 1);
+    std::nth_element(begin, begin + index, end);
+    return *(begin + index);
+  };
+
+  double sumMs = 0.0;
+  for (auto it = begin; it != end; ++it)
+    sumMs += *it;
+  const double p50 = percentile(0.5);
+  const double p95 = percentile(0.95);
+  const double p99 = percentile(0.99);
+  const double worst = *std::max_element(begin, end);
+
+  {
+    std::lock_guard<std::mutex> lock(data.mutex);
+    data.p50Ms = p50;
+  }
+
+  if (sumMs > 0.0)
+  {
+    this->SetCameraFpsValue(QString::number(
+        1000.0 * static_cast<double>(count) / sumMs, 'f', 2));
+  }
+
+  auto format = [](double _ms)
   {
-    auto first = this->dataPtr->cameraUpdateTimes.front();
-    this->dataPtr->cameraUpdateTimes.pop_front();
-    this->dataPtr->cameraUpdateTimeSum -= first;
-    double sum = this->dataPtr->cameraUpdateTimeSum.count();
-    double avg = sum /
-        static_cast<double>(this->dataPtr->cameraFPSWindowSize);
-    this->SetCameraFpsValue(QString::fromStdString(std::to_string(1.0/avg)));
+    return QString::number(_ms, 'f', 1) + " ms";
+  };
+  auto p50Value = format(p50);
+  auto p95Value = format(p95);
+  auto p99Value = format(p99);
+  auto worstValue = format(worst);
+  auto hitchesValue = static_cast<int>(hitches);
+  if (p50Value != data.p50Value || p95Value != data.p95Value ||
+      p99Value != data.p99Value || worstValue != data.worstValue ||
+      hitchesValue != data.hitchesValue)
+  {
+    data.p50Value = p50Value;
+    data.p95Value = p95Value;
+    data.p99Value = p99Value;
+    data.worstValue = worstValue;
+    data.hitchesValue = hitchesValue;
+    this->FrameStatsChanged();
   }
-  this->dataPtr->cameraUpdateTimes.push_back(dt);
+
+  if (data.topic.empty())
+    return;
+
+  auto setDouble = [&data](const char *_name, double _value)
+  {
+    auto &param = (*data.msg.mutable_params())[_name];
+    param.set_type(msgs::Any::DOUBLE);
+    param.set_double_value(_value);
+  };
+  setDouble("mean", sumMs / static_cast<double>(count));
+  setDouble("p50", p50);
+  setDouble("p95", p95);
+  setDouble("p99", p99);
+  setDouble("max", worst);
+  auto &param = (*data.msg.mutable_params())["hitches"];
+  param.set_type(msgs::Any::INT32);
+  param.set_int_value(hitchesValue);
+  data.pub.Publish(data.msg);
 }
 
 /////////////////////////////////////////////////
 CameraFps::CameraFps()
   : Plugin(), dataPtr(new CameraFpsPrivate)
 {
+  this->connect(&this->dataPtr->reportTimer, &QTimer::timeout, this,
+      &CameraFps::Report);
 }
 
 /////////////////////////////////////////////////
 CameraFps::~CameraFps()
 {
+  RenderHooks::Unregister(this->dataPtr->renderHookId);
 }
 
 /////////////////////////////////////////////////
-void CameraFps::LoadConfig(const tinyxml2::XMLElement *)
+void CameraFps::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Camera FPS";
 
-  App()->findChild<MainWindow *>()->installEventFilter(this);
-}
+  if (_pluginElem)
+  {
+    auto topicElem = _pluginElem->FirstChildElement("topic");
+    if (nullptr != topicElem && nullptr != topicElem->GetText())
+    {
+      auto topic = transport::TopicUtils::AsValidTopic(topicElem->GetText());
+      if (topic.empty())
+      {
+        gzerr << "Invalid topic [" << topicElem->GetText() << "]"
+              << std::endl;
+      }
+      else
+      {
+        this->dataPtr->topic = topic;
+        this->dataPtr->pub =
+            this->dataPtr->node.Advertise<msgs::Param>(topic);
+      }
+    }
+  }
 
-/////////////////////////////////////////////////
-bool CameraFps::eventFilter(QObject *_obj, QEvent *_event)
-{
-  if (_event->type() == events::Render::kType)
+  if (!this->dataPtr->reportTimer.isActive())
+    this->dataPtr->reportTimer.start(CameraFpsPrivate::kReportPeriodMs);
+
+  if (this->dataPtr->renderHookId == 0)
   {
-    this->OnRender();
+    this->dataPtr->renderHookId = RenderHooks::Register(RenderPhase::kRender,
+        [this]{this->OnRender();}, 0, "CameraFps");
   }
-  // Standard event processing
-  return QObject::eventFilter(_obj, _event);
 }
 
 /////////////////////////////////////////////////
@@ -122,10 +300,41 @@ QString CameraFps::CameraFpsValue() const
 /////////////////////////////////////////////////
 void CameraFps::SetCameraFpsValue(const QString &_value)
 {
+  if (this->dataPtr->cameraFPSValue == _value)
+    return;
   this->dataPtr->cameraFPSValue = _value;
   this->CameraFpsValueChanged();
 }
 
+/////////////////////////////////////////////////
+QString CameraFps::P50Value() const
+{
+  return this->dataPtr->p50Value;
+}
+
+/////////////////////////////////////////////////
+QString CameraFps::P95Value() const
+{
+  return this->dataPtr->p95Value;
+}
+
+/////////////////////////////////////////////////
+QString CameraFps::P99Value() const
+{
+  return this->dataPtr->p99Value;
+}
+
+/////////////////////////////////////////////////
+QString CameraFps::WorstValue() const
+{
+  return this->dataPtr->worstValue;
+}
+
+/////////////////////////////////////////////////
+int CameraFps::HitchesValue() const
+{
+  return this->dataPtr->hitchesValue;
+}
+
 // Register this plugin
-GZ_ADD_PLUGIN(gz::gui::plugins::CameraFps,
-              gz::gui::Plugin)
+GZ_GUI_ADD_PLUGIN(gz::gui::plugins::CameraFps, "CameraFps")
@@ -31,6 +31,16 @@ namespace plugins
   class CameraFpsPrivate;
 
   /// \brief This plugin displays the GUI camera's Framerate Per Second (FPS)
+  /// and its frame times over the last 256 frames: the median, the 95th and
+  /// 99th percentiles, the worst frame, and the number of hitches, which
+  /// are frames longer than twice the median. They're updated 4 times per
+  /// second.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<topic\> : Topic to also publish the statistics on, as a
+  ///               gz.msgs.Param with mean, p50, p95, p99, and max in ms,
+  ///               and hitches. Optional, not published by default.
   class CameraFps : public Plugin
   {
     Q_OBJECT
@@ -43,6 +53,41 @@ namespace plugins
       NOTIFY CameraFpsValueChanged
     )
 
+    /// \brief Median frame time
+    Q_PROPERTY(
+      QString p50Value
+      READ P50Value
+      NOTIFY FrameStatsChanged
+    )
+
+    /// \brief 95th percentile frame time
+    Q_PROPERTY(
+      QString p95Value
+      READ P95Value
+      NOTIFY FrameStatsChanged
+    )
+
+    /// \brief 99th percentile frame time
+    Q_PROPERTY(
+      QString p99Value
+      READ P99Value
+      NOTIFY FrameStatsChanged
+    )
+
+    /// \brief Worst frame time in the window
+    Q_PROPERTY(
+      QString worstValue
+      READ WorstValue
+      NOTIFY FrameStatsChanged
+    )
+
+    /// \brief Number of hitches since startup
+    Q_PROPERTY(
+      int hitchesValue
+      READ HitchesValue
+      NOTIFY FrameStatsChanged
+    )
+
     /// \brief Constructor
     public: CameraFps();
 
@@ -61,14 +106,38 @@ namespace plugins
     /// \return Camera FPS value string
     public: Q_INVOKABLE QString CameraFpsValue() const;
 
+    /// \brief Get the median frame time string
+    /// \return Median frame time, such as "16.7 ms"
+    public: Q_INVOKABLE QString P50Value() const;
+
+    /// \brief Get the 95th percentile frame time string
+    /// \return 95th percentile frame time
+    public: Q_INVOKABLE QString P95Value() const;
+
+    /// \brief Get the 99th percentile frame time string
+    /// \return 99th percentile frame time
+    public: Q_INVOKABLE QString P99Value() const;
+
+    /// \brief Get the worst frame time string
+    /// \return Worst frame time in the window
+    public: Q_INVOKABLE QString WorstValue() const;
+
+    /// \brief Get the number of hitches
+    /// \return Number of hitches since startup
+    public: Q_INVOKABLE int HitchesValue() const;
+
     /// \brief Notify that camera FPS value has changed
     signals: void CameraFpsValueChanged();
 
+    /// \brief Notify that the frame time statistics have changed
+    signals: void FrameStatsChanged();
+
     /// \brief Perform rendering calls in the rendering thread.
     private: void OnRender();
 
-    // Documentation inherited
-    private: bool eventFilter(QObject *_obj, QEvent *_event) override;
+    /// \brief Compute the statistics of the recorded frames and update the
+    /// properties and the topic, on the GUI thread.
+    private: void Report();
 
     /// \internal
     /// \brief Pointer to private data.
@@ -23,12 +23,13 @@ Rectangle {
   id: cameraFps
   color: "transparent"
   Layout.minimumWidth: 150
-  Layout.minimumHeight: 80
+  Layout.minimumHeight: 180
 
-  RowLayout {
+  GridLayout {
     id: cameraFpsLayout
     anchors.fill: parent
     anchors.margins: 10
+    columns: 2
 
     Label {
       ToolTip.text: qsTr("Camera FPS")
@@ -41,5 +42,65 @@ Rectangle {
       text: CameraFps.cameraFPSValue
       Layout.alignment: Qt.AlignRight
     }
+
+    Label {
+      ToolTip.text: qsTr("Median frame time")
+      font.weight: Font.DemiBold
+      text: "p50"
+    }
+
+    Label {
+      objectName: "p50"
+      text: CameraFps.p50Value
+      Layout.alignment: Qt.AlignRight
+    }
+
+    Label {
+      ToolTip.text: qsTr("95th percentile frame time")
+      font.weight: Font.DemiBold
+      text: "p95"
+    }
+
+    Label {
+      objectName: "p95"
+      text: CameraFps.p95Value
+      Layout.alignment: Qt.AlignRight
+    }
+
+    Label {
+      ToolTip.text: qsTr("99th percentile frame time")
+      font.weight: Font.DemiBold
+      text: "p99"
+    }
+
+    Label {
+      objectName: "p99"
+      text: CameraFps.p99Value
+      Layout.alignment: Qt.AlignRight
+    }
+
+    Label {
+      ToolTip.text: qsTr("Longest frame of the last 256")
+      font.weight: Font.DemiBold
+      text: "Worst"
+    }
+
+    Label {
+      objectName: "worst"
+      text: CameraFps.worstValue
+      Layout.alignment: Qt.AlignRight
+    }
+
+    Label {
+      ToolTip.text: qsTr("Frames longer than twice the median")
+      font.weight: Font.DemiBold
+      text: "Hitches"
+    }
+
+    Label {
+      objectName: "hitches"
+      text: CameraFps.hitchesValue
+      Layout.alignment: Qt.AlignRight
+    }
   }
 }
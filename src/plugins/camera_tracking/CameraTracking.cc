@@ -15,9 +15,14 @@
  *
 */
 
+#include <chrono>
+#include <cmath>
 #include <mutex>
+#include <optional>
 #include <string>
 
+#include <gz/msgs/empty.pb.h>
+#include <gz/msgs/pose.pb.h>
 #include <gz/msgs/stringmsg.pb.h>
 
 #include <gz/common/Console.hh>
@@ -33,6 +38,8 @@
 #include "gz/gui/Conversions.hh"
 #include "gz/gui/GuiEvents.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/Profiler.hh"
+#include "gz/gui/StaticPlugins.hh"
 
 #include <gz/transport/Node.hh>
 
@@ -75,12 +82,30 @@ class gz::gui::plugins::CameraTrackingPrivate
   public: bool OnFollowOffset(const msgs::Vector3d &_msg,
                msgs::Boolean &_res);
 
+  /// \brief Callback for a last camera pose request
+  /// \param[in] _req Empty request
+  /// \param[out] _res Latest camera pose
+  /// \return False if the camera hasn't been rendered yet
+  public: bool OnLastPose(const msgs::Empty &_req, msgs::Pose &_res);
+
+  /// \brief Publish the camera pose if it changed enough since it was last
+  /// published, at most at maxPoseRate. Called on the render thread once
+  /// the camera was rendered.
+  public: void PublishPose();
+
   /// \brief Callback when a move to animation is complete
   private: void OnMoveToComplete();
 
   /// \brief Callback when a move to  pose animation is complete
   private: void OnMoveToPoseComplete();
 
+  /// \brief Get the node of the follow target. It's looked up by name
+  /// only when the target changes, when the node is removed from the scene,
+  /// and once in a while in case another node took its name, so following
+  /// doesn't search the scene on every frame.
+  /// \return Node, null if there's no target or it wasn't found
+  public: rendering::NodePtr FollowNode();
+
   /// \brief Process key releases
   /// \param[in] _e Key release event
   public: void HandleKeyRelease(events::KeyReleaseOnScene *_e);
@@ -97,6 +122,15 @@ class gz::gui::plugins::CameraTrackingPrivate
   /// \brief Wait for follow target
   public: bool followTargetWait = false;
 
+  /// \brief Node of the follow target, see FollowNode
+  public: rendering::NodePtr followNode{nullptr};
+
+  /// \brief Name followNode was looked up with
+  public: std::string followNodeName;
+
+  /// \brief When followNode was last looked up
+  public: std::chrono::steady_clock::time_point followNodeTime;
+
   /// \brief Offset of camera from target being followed
   public: math::Vector3d followOffset = math::Vector3d(-5, 0, 3);
 
@@ -149,8 +183,32 @@ class gz::gui::plugins::CameraTrackingPrivate
   /// \brief Camera pose publisher
   public: transport::Node::Publisher cameraPosePub;
 
-  /// \brief Timer to keep publishing camera poses.
-  public: QTimer *timer{nullptr};
+  /// \brief Latest camera pose service
+  public: std::string lastPoseService;
+
+  /// \brief Maximum rate of camera pose messages in Hz, 0 for no limit
+  public: double maxPoseRate{50.0};
+
+  /// \brief Distance in meters the camera must move by to publish its pose
+  public: double minPoseDistance{1e-4};
+
+  /// \brief Angle in radians the camera must turn by to publish its pose
+  public: double minPoseAngle{1e-4};
+
+  /// \brief Protects lastPose
+  public: std::mutex poseMutex;
+
+  /// \brief Latest camera pose, for the last pose service
+  public: std::optional<math::Pose3d> lastPose;
+
+  /// \brief Camera pose last published
+  public: std::optional<math::Pose3d> publishedPose;
+
+  /// \brief When the camera pose was last published
+  public: std::chrono::steady_clock::time_point publishedTime;
+
+  /// \brief Whether the pose topic had subscribers on the last frame
+  public: bool hadConnections{false};
 };
 
 using namespace gz;
@@ -208,6 +266,13 @@ void CameraTrackingPrivate::Initialize()
   gzmsg << "Camera pose topic advertised on ["
          << this->cameraPoseTopic << "]" << std::endl;
 
+  // latest camera pose, for late joiners
+  this->lastPoseService = "/gui/camera/pose/last";
+  this->node.Advertise(this->lastPoseService,
+      &CameraTrackingPrivate::OnLastPose, this);
+  gzmsg << "Last camera pose service on ["
+         << this->lastPoseService << "]" << std::endl;
+
    // follow offset
    this->followOffsetService = "/gui/follow/offset";
    this->node.Advertise(this->followOffsetService,
@@ -294,6 +359,59 @@ bool CameraTrackingPrivate::OnMoveToPose(const msgs::GUICamera &_msg,
   return true;
 }
 
+/////////////////////////////////////////////////
+bool CameraTrackingPrivate::OnLastPose(const msgs::Empty &,
+  msgs::Pose &_res)
+{
+  std::lock_guard<std::mutex> lock(this->poseMutex);
+  if (!this->lastPose)
+    return false;
+
+  _res = msgs::Convert(*this->lastPose);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void CameraTrackingPrivate::PublishPose()
+{
+  auto pose = this->camera->WorldPose();
+  {
+    std::lock_guard<std::mutex> lock(this->poseMutex);
+    this->lastPose = pose;
+  }
+
+  // Subscribers which just connected get the pose right away
+  bool connected = this->cameraPosePub.HasConnections();
+  bool joined = connected && !this->hadConnections;
+  this->hadConnections = connected;
+  if (!connected)
+    return;
+
+  if (!joined && this->publishedPose)
+  {
+    const auto &published = *this->publishedPose;
+    bool moved = pose.Pos().Distance(published.Pos()) >=
+        this->minPoseDistance;
+    bool turned = std::abs((published.Rot().Inverse() * pose.Rot()).W()) <
+        std::cos(this->minPoseAngle * 0.5);
+    if (!moved && !turned)
+      return;
+  }
+
+  // Changes within the interval are published on the first frame after it
+  auto now = std::chrono::steady_clock::now();
+  if (!joined && this->maxPoseRate > 0.0 &&
+      std::chrono::duration<double>(now - this->publishedTime).count() <
+      1.0 / this->maxPoseRate)
+  {
+    return;
+  }
+
+  this->cameraPosePub.Publish(msgs::Convert(pose));
+  this->publishedPose = pose;
+  this->publishedTime = now;
+}
+
 /////////////////////////////////////////////////
 void CameraTrackingPrivate::OnRender()
 {
@@ -309,9 +427,12 @@ void CameraTrackingPrivate::OnRender()
   if (!this->camera)
     return;
 
+  // The user camera was just rendered with this pose
+  this->PublishPose();
+
   // Move To
   {
-    GZ_PROFILE("CameraTrackingPrivate::OnRender MoveTo");
+    GZ_GUI_PROFILE("CameraTrackingPrivate::OnRender MoveTo");
     if (!this->moveToTarget.empty())
     {
       if (this->moveToHelper.Idle())
@@ -343,7 +464,7 @@ void CameraTrackingPrivate::OnRender()
 
   // Move to pose
   {
-    GZ_PROFILE("CameraTrackingPrivate::OnRender MoveToPose");
+    GZ_GUI_PROFILE("CameraTrackingPrivate::OnRender MoveToPose");
     if (this->moveToPoseValue)
     {
       if (this->moveToHelper.Idle())
@@ -365,17 +486,15 @@ void CameraTrackingPrivate::OnRender()
 
   // Follow
   {
-    GZ_PROFILE("CameraTrackingPrivate::OnRender Follow");
+    GZ_GUI_PROFILE("CameraTrackingPrivate::OnRender Follow");
+    rendering::NodePtr target = this->FollowNode();
+
     // reset follow mode if target node got removed
-    if (!this->followTarget.empty())
+    if (!this->followTarget.empty() && !target && !this->followTargetWait)
     {
-      rendering::NodePtr target = this->scene->NodeByName(this->followTarget);
-      if (!target && !this->followTargetWait)
-      {
-        this->camera->SetFollowTarget(nullptr);
-        this->camera->SetTrackTarget(nullptr);
-        this->followTarget.clear();
-      }
+      this->camera->SetFollowTarget(nullptr);
+      this->camera->SetTrackTarget(nullptr);
+      this->followTarget.clear();
     }
 
     if (!this->moveToTarget.empty())
@@ -383,8 +502,6 @@ void CameraTrackingPrivate::OnRender()
     rendering::NodePtr followTargetTmp = this->camera->FollowTarget();
     if (!this->followTarget.empty())
     {
-      rendering::NodePtr target = scene->NodeByName(
-          this->followTarget);
       if (target)
       {
         if (!followTargetTmp || target != followTargetTmp
@@ -427,23 +544,38 @@ void CameraTrackingPrivate::OnRender()
   }
 }
 
+/////////////////////////////////////////////////
+rendering::NodePtr CameraTrackingPrivate::FollowNode()
+{
+  if (this->followTarget.empty())
+  {
+    this->followNode.reset();
+    this->followNodeName.clear();
+    return nullptr;
+  }
+
+  // The camera follows the node itself, with its P gain smoothing, so the
+  // name is only needed to notice the node changed. Removed nodes are
+  // detached from their parent. A missing target is looked for more often,
+  // so following starts soon after it's spawned.
+  auto now = std::chrono::steady_clock::now();
+  auto interval = this->followNode ? std::chrono::milliseconds(1000) :
+      std::chrono::milliseconds(100);
+  if (this->followNodeName != this->followTarget ||
+      now - this->followNodeTime > interval ||
+      (this->followNode && !this->followNode->Parent()))
+  {
+    this->followNode = this->scene->NodeByName(this->followTarget);
+    this->followNodeName = this->followTarget;
+    this->followNodeTime = now;
+  }
+  return this->followNode;
+}
+
 /////////////////////////////////////////////////
 CameraTracking::CameraTracking()
   : Plugin(), dataPtr(new CameraTrackingPrivate)
 {
-  this->dataPtr->timer = new QTimer(this);
-  this->connect(this->dataPtr->timer, &QTimer::timeout, [=]()
-  {
-   if (!this->dataPtr->camera)
-    return;
-   if (this->dataPtr->cameraPosePub.HasConnections())
-   {
-     auto poseMsg = msgs::Convert(this->dataPtr->camera->WorldPose());
-     this->dataPtr->cameraPosePub.Publish(poseMsg);
-   }
-  });
-  this->dataPtr->timer->setInterval(1000.0 / 50.0);
-  this->dataPtr->timer->start();
 }
 
 /////////////////////////////////////////////////
@@ -452,12 +584,41 @@ CameraTracking::~CameraTracking()
 }
 
 /////////////////////////////////////////////////
-void CameraTracking::LoadConfig(const tinyxml2::XMLElement *)
+void CameraTracking::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Camera tracking";
 
-  App()->findChild<MainWindow *>()->installEventFilter(this);
+  if (_pluginElem)
+  {
+    auto elem = _pluginElem->FirstChildElement("camera_pose");
+    if (nullptr != elem)
+    {
+      auto parseNonNegative = [&elem](const char *_name, double &_value)
+      {
+        auto child = elem->FirstChildElement(_name);
+        if (nullptr == child)
+          return;
+
+        double value{0.0};
+        if (child->QueryDoubleText(&value) != tinyxml2::XML_SUCCESS ||
+            value < 0.0)
+        {
+          gzerr << "Invalid <" << _name << ">, expected a non-negative "
+                << "number" << std::endl;
+          return;
+        }
+        _value = value;
+      };
+      parseNonNegative("max_rate", this->dataPtr->maxPoseRate);
+      parseNonNegative("min_distance", this->dataPtr->minPoseDistance);
+      parseNonNegative("min_angle", this->dataPtr->minPoseAngle);
+    }
+  }
+
+  auto mainWindow = App()->findChild<MainWindow *>();
+  mainWindow->SubscribeEvent(events::Render::kType, this);
+  mainWindow->SubscribeEvent(events::KeyReleaseOnScene::kType, this);
 }
 
 /////////////////////////////////////////////////
@@ -495,5 +656,4 @@ bool CameraTracking::eventFilter(QObject *_obj, QEvent *_event)
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(gz::gui::plugins::CameraTracking,
-              gz::gui::Plugin)
+GZ_GUI_ADD_PLUGIN(gz::gui::plugins::CameraTracking, "CameraTracking")
@@ -40,9 +40,27 @@ namespace plugins
   /// * `/gui/follow`: Set the user camera to follow a given target,
   ///                   identified by name.
   /// * `/gui/follow/offset`: Set the offset for following.
+  /// * `/gui/camera/pose/last`: Get the latest user camera pose, as a
+  ///                            msgs::Pose, such as for subscribers which
+  ///                            joined while the camera was still.
   ///
   /// Topics:
-  /// * `/gui/camera/pose`: Publishes the current user camera pose.
+  /// * `/gui/camera/pose`: Publishes the user camera pose after it's
+  ///                       rendered, only when it changed, and right away
+  ///                       when the first subscriber connects.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<camera_pose\> : Optional publishing of the camera pose.
+  ///   * \<max_rate\> : Maximum rate in Hz, 0 for no limit. A change
+  ///                    within the interval is published on the first
+  ///                    frame after it. Defaults to 50.
+  ///   * \<min_distance\> : Distance in meters the camera must move by
+  ///                        since the last message to be published again.
+  ///                        Defaults to 1e-4.
+  ///   * \<min_angle\> : Angle in radians the camera must turn by since
+  ///                     the last message to be published again. Defaults
+  ///                     to 1e-4.
   class CameraTracking : public Plugin
   {
     Q_OBJECT
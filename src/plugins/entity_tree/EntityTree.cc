@@ -0,0 +1,553 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <QModelIndex>
+#include <QString>
+#include <QVariantMap>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/MouseEvent.hh>
+#include <gz/plugin/Register.hh>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/GuiEvents.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/SceneEntities.hh"
+#include "gz/gui/ScenePicker.hh"
+#include "gz/gui/StaticPlugins.hh"
+
+#include "EntityTree.hh"
+
+#define NAME_KEY "name"
+#define TYPE_KEY "type"
+#define ID_KEY "entity"
+
+#define NAME_ROLE 51
+#define TYPE_ROLE 52
+#define ID_ROLE 53
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Tree of the scene entities. Indices hold the entity Id, and
+  /// rows are only created as they're fetched, kFetchSize at a time.
+  class EntityTreeModel : public QAbstractItemModel
+  {
+    /// \brief Constructor
+    /// \param[in] _entities Entities shown
+    public: explicit EntityTreeModel(SceneEntities *_entities);
+
+    /// \brief Get the index of an entity, fetching the rows of it and its
+    /// ancestors if needed
+    /// \param[in] _id Entity Id
+    /// \return Index, invalid if the entity isn't known
+    public: QModelIndex Reveal(unsigned int _id);
+
+    /// \brief Get the entity of an index
+    /// \param[in] _index Index, invalid for the top level
+    /// \return Entity Id, 0 for the top level
+    public: static unsigned int Id(const QModelIndex &_index);
+
+    // Documentation inherited
+    public: QModelIndex index(int _row, int _column,
+        const QModelIndex &_parent = QModelIndex()) const override;
+
+    // Documentation inherited
+    public: QModelIndex parent(const QModelIndex &_index) const override;
+
+    // Documentation inherited
+    public: int rowCount(
+        const QModelIndex &_parent = QModelIndex()) const override;
+
+    // Documentation inherited
+    public: int columnCount(
+        const QModelIndex &_parent = QModelIndex()) const override;
+
+    // Documentation inherited
+    public: bool hasChildren(
+        const QModelIndex &_parent = QModelIndex()) const override;
+
+    // Documentation inherited
+    public: bool canFetchMore(const QModelIndex &_parent) const override;
+
+    // Documentation inherited
+    public: void fetchMore(const QModelIndex &_parent) override;
+
+    // Documentation inherited
+    public: QVariant data(const QModelIndex &_index,
+        int _role = Qt::DisplayRole) const override;
+
+    /// \brief roles and names of the model
+    public: QHash<int, QByteArray> roleNames() const override
+    {
+      QHash<int, QByteArray> roles;
+      roles[NAME_ROLE] = NAME_KEY;
+      roles[TYPE_ROLE] = TYPE_KEY;
+      roles[ID_ROLE] = ID_KEY;
+      return roles;
+    }
+
+    /// \brief Get the index of an entity whose row was fetched
+    /// \param[in] _id Entity Id, 0 for the top level
+    /// \return Index, invalid for the top level
+    private: QModelIndex IndexOf(unsigned int _id) const;
+
+    /// \brief Get whether the row of an entity was fetched
+    /// \param[in] _id Entity Id
+    /// \return True if it's in the model
+    private: bool Shown(unsigned int _id) const;
+
+    /// \brief Get the number of fetched children
+    /// \param[in] _id Entity Id, 0 for the top level
+    /// \return Number of rows
+    private: int Fetched(unsigned int _id) const;
+
+    /// \brief Fetch children until a row is included
+    /// \param[in] _id Entity Id, 0 for the top level
+    /// \param[in] _row Row which must be fetched
+    private: void FetchTo(unsigned int _id, int _row);
+
+    /// \brief Forget the fetched rows of entities and their descendants
+    /// \param[in] _parent Parent of the entities
+    /// \param[in] _first First row
+    /// \param[in] _last Last row
+    private: void Forget(unsigned int _parent, int _first, int _last);
+
+    /// \brief Number of rows created at once
+    private: static constexpr int kFetchSize{500};
+
+    /// \brief Entities shown
+    private: SceneEntities *entities;
+
+    /// \brief Number of fetched children of the entities which were
+    /// expanded, always has the top level
+    private: std::unordered_map<unsigned int, int> fetched;
+
+    /// \brief Rows being inserted, between the store's signals
+    private: int inserting{0};
+
+    /// \brief Rows being removed, between the store's signals
+    private: int removing{0};
+  };
+
+  class EntityTreePrivate
+  {
+    /// \brief Entities shown
+    public: SceneEntities *entities{nullptr};
+
+    /// \brief Tree of entities
+    public: EntityTreeModel *model{nullptr};
+
+    /// \brief Maximum number of search results
+    public: std::size_t maxResults{100u};
+  };
+}
+}
+}
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+namespace
+{
+/// \brief Name shown for a kind of entity
+/// \param[in] _type Kind of entity
+/// \return Name
+QString typeName(SceneEntities::Type _type)
+{
+  switch (_type)
+  {
+    case SceneEntities::Type::kModel:
+      return "model";
+    case SceneEntities::Type::kLink:
+      return "link";
+    case SceneEntities::Type::kVisual:
+      return "visual";
+    case SceneEntities::Type::kLight:
+      return "light";
+  }
+  return QString();
+}
+}
+
+/////////////////////////////////////////////////
+EntityTreeModel::EntityTreeModel(SceneEntities *_entities)
+  : entities(_entities)
+{
+  this->fetched[0u] = 0;
+
+  // Rows are inserted right away while their parent shows fewer than
+  // kFetchSize, otherwise they're fetched as the view needs them
+  QObject::connect(this->entities, &SceneEntities::ChildrenAboutToBeAdded,
+      this, [this](unsigned int _parent, int _first, int _last)
+      {
+        auto it = this->fetched.find(_parent);
+        if (it == this->fetched.end() || it->second != _first ||
+            _first >= kFetchSize)
+        {
+          return;
+        }
+        this->inserting = std::min(_last - _first + 1, kFetchSize - _first);
+        this->beginInsertRows(this->IndexOf(_parent), _first,
+            _first + this->inserting - 1);
+      });
+  QObject::connect(this->entities, &SceneEntities::ChildrenAdded,
+      this, [this](unsigned int _parent, int _first, int)
+      {
+        if (this->inserting > 0)
+        {
+          this->fetched[_parent] += this->inserting;
+          this->inserting = 0;
+          this->endInsertRows();
+        }
+        else if (_first == 0 && _parent != 0u && this->Shown(_parent))
+        {
+          // It can be expanded now
+          auto index = this->IndexOf(_parent);
+          this->dataChanged(index, index);
+        }
+      });
+  QObject::connect(this->entities, &SceneEntities::ChildrenAboutToBeRemoved,
+      this, [this](unsigned int _parent, int _first, int _last)
+      {
+        // Rows which weren't fetched aren't in the model
+        int count = this->Fetched(_parent);
+        if (_first >= count)
+          return;
+        _last = std::min(_last, count - 1);
+        this->Forget(_parent, _first, _last);
+        this->removing = _last - _first + 1;
+        this->beginRemoveRows(this->IndexOf(_parent), _first, _last);
+      });
+  QObject::connect(this->entities, &SceneEntities::ChildrenRemoved,
+      this, [this](unsigned int _parent, int, int)
+      {
+        if (this->removing == 0)
+          return;
+        this->fetched[_parent] -= this->removing;
+        this->removing = 0;
+        this->endRemoveRows();
+      });
+  QObject::connect(this->entities, &SceneEntities::AboutToBeCleared,
+      this, [this]()
+      {
+        this->beginResetModel();
+      });
+  QObject::connect(this->entities, &SceneEntities::Cleared,
+      this, [this]()
+      {
+        this->fetched.clear();
+        this->fetched[0u] = 0;
+        this->endResetModel();
+      });
+}
+
+/////////////////////////////////////////////////
+QModelIndex EntityTreeModel::Reveal(unsigned int _id)
+{
+  auto entity = this->entities->Find(_id);
+  if (nullptr == entity)
+    return QModelIndex();
+
+  // From the top level down
+  std::vector<unsigned int> path{_id};
+  while (entity->parent != 0u)
+  {
+    path.push_back(entity->parent);
+    entity = this->entities->Find(entity->parent);
+  }
+  unsigned int parent{0u};
+  for (auto it = path.rbegin(); it != path.rend(); ++it)
+  {
+    this->FetchTo(parent, this->entities->Row(*it));
+    parent = *it;
+  }
+  return this->IndexOf(_id);
+}
+
+/////////////////////////////////////////////////
+unsigned int EntityTreeModel::Id(const QModelIndex &_index)
+{
+  if (!_index.isValid())
+    return 0u;
+  return static_cast<unsigned int>(_index.internalId());
+}
+
+/////////////////////////////////////////////////
+QModelIndex EntityTreeModel::index(int _row, int _column,
+    const QModelIndex &_parent) const
+{
+  auto parent = Id(_parent);
+  if (_column != 0 || _row < 0 || _row >= this->Fetched(parent))
+    return QModelIndex();
+  auto id = this->entities->Child(parent, static_cast<std::size_t>(_row));
+  return this->createIndex(_row, 0, static_cast<quintptr>(id));
+}
+
+/////////////////////////////////////////////////
+QModelIndex EntityTreeModel::parent(const QModelIndex &_index) const
+{
+  auto entity = this->entities->Find(Id(_index));
+  if (nullptr == entity)
+    return QModelIndex();
+  return this->IndexOf(entity->parent);
+}
+
+/////////////////////////////////////////////////
+int EntityTreeModel::rowCount(const QModelIndex &_parent) const
+{
+  if (_parent.column() > 0)
+    return 0;
+  return this->Fetched(Id(_parent));
+}
+
+/////////////////////////////////////////////////
+int EntityTreeModel::columnCount(const QModelIndex &) const
+{
+  return 1;
+}
+
+/////////////////////////////////////////////////
+bool EntityTreeModel::hasChildren(const QModelIndex &_parent) const
+{
+  return this->entities->ChildCount(Id(_parent)) > 0u;
+}
+
+/////////////////////////////////////////////////
+bool EntityTreeModel::canFetchMore(const QModelIndex &_parent) const
+{
+  auto id = Id(_parent);
+  return static_cast<std::size_t>(this->Fetched(id)) <
+      this->entities->ChildCount(id);
+}
+
+/////////////////////////////////////////////////
+void EntityTreeModel::fetchMore(const QModelIndex &_parent)
+{
+  this->FetchTo(Id(_parent), this->Fetched(Id(_parent)) + kFetchSize - 1);
+}
+
+/////////////////////////////////////////////////
+QVariant EntityTreeModel::data(const QModelIndex &_index, int _role) const
+{
+  auto entity = this->entities->Find(Id(_index));
+  if (nullptr == entity)
+    return QVariant();
+
+  switch (_role)
+  {
+    case Qt::DisplayRole:
+    case NAME_ROLE:
+      return QString::fromStdString(entity->name);
+    case TYPE_ROLE:
+      return typeName(entity->type);
+    case ID_ROLE:
+      return entity->id;
+    default:
+      return QVariant();
+  }
+}
+
+/////////////////////////////////////////////////
+QModelIndex EntityTreeModel::IndexOf(unsigned int _id) const
+{
+  if (_id == 0u)
+    return QModelIndex();
+  return this->createIndex(this->entities->Row(_id), 0,
+      static_cast<quintptr>(_id));
+}
+
+/////////////////////////////////////////////////
+bool EntityTreeModel::Shown(unsigned int _id) const
+{
+  for (auto id = _id; id != 0u;)
+  {
+    auto entity = this->entities->Find(id);
+    if (nullptr == entity || this->entities->Row(id) >=
+        this->Fetched(entity->parent))
+    {
+      return false;
+    }
+    id = entity->parent;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+int EntityTreeModel::Fetched(unsigned int _id) const
+{
+  auto it = this->fetched.find(_id);
+  return it == this->fetched.end() ? 0 : it->second;
+}
+
+/////////////////////////////////////////////////
+void EntityTreeModel::FetchTo(unsigned int _id, int _row)
+{
+  int count = this->Fetched(_id);
+  int last = std::min(_row,
+      static_cast<int>(this->entities->ChildCount(_id)) - 1);
+  if (last < count)
+    return;
+
+  this->beginInsertRows(this->IndexOf(_id), count, last);
+  this->fetched[_id] = last + 1;
+  this->endInsertRows();
+}
+
+/////////////////////////////////////////////////
+void EntityTreeModel::Forget(unsigned int _parent, int _first, int _last)
+{
+  std::vector<unsigned int> stack;
+  for (int row = _first; row <= _last; ++row)
+    stack.push_back(this->entities->Child(_parent, row));
+
+  while (!stack.empty())
+  {
+    auto id = stack.back();
+    stack.pop_back();
+    auto it = this->fetched.find(id);
+    if (it == this->fetched.end())
+      continue;
+    for (int row = 0; row < it->second; ++row)
+      stack.push_back(this->entities->Child(id, row));
+    this->fetched.erase(it);
+  }
+}
+
+/////////////////////////////////////////////////
+EntityTree::EntityTree()
+  : Plugin(), dataPtr(std::make_unique<EntityTreePrivate>())
+{
+  this->dataPtr->entities = SceneEntities::Instance();
+  this->dataPtr->model = new EntityTreeModel(this->dataPtr->entities);
+  this->dataPtr->model->setParent(this);
+  this->dataPtr->model->fetchMore(QModelIndex());
+
+  App()->Engine()->rootContext()->setContextProperty(
+      "EntityTreeModel", this->dataPtr->model);
+
+  this->connect(this->dataPtr->entities, &SceneEntities::SelectionChanged,
+      this, &EntityTree::SelectedIndexChanged);
+}
+
+/////////////////////////////////////////////////
+EntityTree::~EntityTree()
+{
+}
+
+/////////////////////////////////////////////////
+void EntityTree::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Entity tree";
+
+  if (_pluginElem)
+  {
+    auto elem = _pluginElem->FirstChildElement("max_results");
+    if (nullptr != elem)
+    {
+      unsigned int max{0u};
+      if (elem->QueryUnsignedText(&max) == tinyxml2::XML_SUCCESS && max > 0u)
+        this->dataPtr->maxResults = max;
+      else
+        gzerr << "Invalid <max_results>, expected a positive number"
+              << std::endl;
+    }
+  }
+
+  // Clicks on the 3D scene select entities
+  App()->findChild<MainWindow *>()->SubscribeEvent(
+      events::LeftClickOnScene::kType, this);
+}
+
+/////////////////////////////////////////////////
+QAbstractItemModel *EntityTree::Model() const
+{
+  return this->dataPtr->model;
+}
+
+/////////////////////////////////////////////////
+QModelIndex EntityTree::SelectedIndex() const
+{
+  return this->dataPtr->model->Reveal(this->dataPtr->entities->Selected());
+}
+
+/////////////////////////////////////////////////
+void EntityTree::Select(const QModelIndex &_index)
+{
+  this->dataPtr->entities->SetSelected(EntityTreeModel::Id(_index));
+}
+
+/////////////////////////////////////////////////
+void EntityTree::SelectEntity(unsigned int _id)
+{
+  this->dataPtr->entities->SetSelected(_id);
+}
+
+/////////////////////////////////////////////////
+QVariantList EntityTree::Search(const QString &_prefix) const
+{
+  QVariantList result;
+  if (_prefix.isEmpty())
+    return result;
+
+  for (auto id : this->dataPtr->entities->Search(_prefix.toStdString(),
+      this->dataPtr->maxResults))
+  {
+    auto entity = this->dataPtr->entities->Find(id);
+    QVariantMap item;
+    item[ID_KEY] = id;
+    item[NAME_KEY] = QString::fromStdString(entity->name);
+    item[TYPE_KEY] = typeName(entity->type);
+    result.push_back(item);
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+bool EntityTree::eventFilter(QObject *_obj, QEvent *_event)
+{
+  if (_event->type() == events::LeftClickOnScene::kType)
+  {
+    // This event is sent from the render thread, where picking is allowed,
+    // and the selection is applied on the GUI thread
+    auto clickEvent = static_cast<events::LeftClickOnScene *>(_event);
+    PickResult result;
+    if (!clickEvent->Mouse().Dragging() &&
+        ScenePicker::Pick(clickEvent->Mouse().Pos(), result))
+    {
+      this->dataPtr->entities->SelectRendered(result.hit ?
+          result.objectId : 0u);
+    }
+  }
+
+  // Standard event processing
+  return QObject::eventFilter(_obj, _event);
+}
+
+// Register this plugin
+GZ_GUI_ADD_PLUGIN(EntityTree, "EntityTree")
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_ENTITYTREE_HH_
+#define GZ_GUI_PLUGINS_ENTITYTREE_HH_
+
+#include <memory>
+
+#include "gz/gui/Plugin.hh"
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  class EntityTreePrivate;
+
+  /// \brief Browse the models, links, visuals and lights of the 3D scene
+  /// as a tree, as loaded by the TransportSceneManager plugin, see
+  /// SceneEntities.
+  ///
+  /// The model only creates rows as they're expanded, a limited number at
+  /// a time, and updates the rows which changed as entities are added and
+  /// removed, so scenes with tens of thousands of entities stay
+  /// responsive. Searching looks up an index of the names, instead of
+  /// going through the tree.
+  ///
+  /// The selection is shared with the scene: selecting a row selects the
+  /// entity for other plugins, and clicking an entity in the 3D view
+  /// selects its row, if the scene has a ScenePicker.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<max_results\> : Maximum number of search results, defaults to 100.
+  class EntityTree : public Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Index of the selected entity, invalid if none
+    Q_PROPERTY(
+      QModelIndex selectedIndex
+      READ SelectedIndex
+      NOTIFY SelectedIndexChanged
+    )
+
+    /// \brief Constructor
+    public: EntityTree();
+
+    /// \brief Destructor
+    public: ~EntityTree() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+        override;
+
+    /// \brief Get the tree of entities
+    /// \return Model
+    public: QAbstractItemModel *Model() const;
+
+    /// \brief Get the index of the selected entity, creating the rows of
+    /// its ancestors if needed.
+    /// \return Index, invalid if nothing is selected
+    public: Q_INVOKABLE QModelIndex SelectedIndex() const;
+
+    /// \brief Select the entity of a row
+    /// \param[in] _index Index, invalid to clear the selection
+    public: Q_INVOKABLE void Select(const QModelIndex &_index);
+
+    /// \brief Select an entity, such as a search result
+    /// \param[in] _id Entity Id, 0 to clear the selection
+    public: Q_INVOKABLE void SelectEntity(unsigned int _id);
+
+    /// \brief Find entities whose name starts with a prefix, ignoring case
+    /// \param[in] _prefix Prefix of the names
+    /// \return List of maps with the id, name and type of the entities,
+    /// sorted by name
+    public: Q_INVOKABLE QVariantList Search(const QString &_prefix) const;
+
+    /// \brief Notify that the selected entity changed
+    signals: void SelectedIndexChanged();
+
+    // Documentation inherited
+    protected: bool eventFilter(QObject *_obj, QEvent *_event) override;
+
+    /// \internal
+    /// \brief Pointer to private data
+    private: std::unique_ptr<EntityTreePrivate> dataPtr;
+  };
+}
+}
+}
+
+#endif
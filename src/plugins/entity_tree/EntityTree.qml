@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+import QtQml.Models 2.2
+import QtQuick 2.9
+import QtQuick.Controls 1.4
+import QtQuick.Controls 2.2 as Controls2
+import QtQuick.Controls.Material 2.1
+import QtQuick.Layouts 1.3
+
+ColumnLayout {
+  id: entityTree
+  Layout.minimumWidth: 300
+  Layout.minimumHeight: 400
+  anchors.fill: parent
+  anchors.margins: 5
+
+  property int itemHeight: 26
+
+  // Search results, empty when not searching
+  property var results: []
+
+  property color highlightColor: Material.accentColor
+  property color textColor: (Material.theme == Material.Light) ?
+      Material.color(Material.Grey, Material.Shade800) :
+      Material.color(Material.Grey, Material.Shade400)
+
+  // Expand the ancestors of the selected entity and select its row
+  function showSelected() {
+    var index = EntityTree.SelectedIndex()
+    if (!index.valid) {
+      tree.selection.clear()
+      return
+    }
+    for (var parent = EntityTreeModel.parent(index); parent.valid;
+        parent = EntityTreeModel.parent(parent)) {
+      tree.expand(parent)
+    }
+    tree.selection.setCurrentIndex(index, ItemSelectionModel.ClearAndSelect)
+  }
+
+  Connections {
+    target: EntityTree
+    onSelectedIndexChanged: {
+      entityTree.showSelected()
+    }
+  }
+
+  Controls2.TextField {
+    id: searchField
+    Layout.fillWidth: true
+    placeholderText: "Search by name"
+    selectByMouse: true
+    onTextChanged: entityTree.results = EntityTree.Search(text)
+  }
+
+  ListView {
+    id: resultList
+    Layout.fillWidth: true
+    Layout.fillHeight: true
+    visible: searchField.text.length > 0
+    clip: true
+    model: entityTree.results
+    delegate: Controls2.ItemDelegate {
+      width: resultList.width
+      height: entityTree.itemHeight
+      text: modelData.name + " (" + modelData.type + ")"
+      onClicked: {
+        EntityTree.SelectEntity(modelData.entity)
+        searchField.text = ""
+      }
+    }
+  }
+
+  TreeView {
+    id: tree
+    objectName: "treeView"
+    Layout.fillWidth: true
+    Layout.fillHeight: true
+    visible: !resultList.visible
+    model: EntityTreeModel
+    headerVisible: false
+    backgroundVisible: false
+    verticalScrollBarPolicy: Qt.ScrollBarAsNeeded
+    horizontalScrollBarPolicy: Qt.ScrollBarAlwaysOff
+    selectionMode: SelectionMode.SingleSelection
+    selection: ItemSelectionModel {
+      model: EntityTreeModel
+    }
+
+    TableViewColumn {
+      role: "name"
+    }
+
+    rowDelegate: Rectangle {
+      height: entityTree.itemHeight
+      color: styleData.selected ? entityTree.highlightColor : "transparent"
+    }
+
+    itemDelegate: Text {
+      text: (model === null) ? "" :
+          (model.name.length > 0 ? model.name : "[" + model.type + "]")
+      color: entityTree.textColor
+      elide: Text.ElideMiddle
+      verticalAlignment: Text.AlignVCenter
+    }
+
+    onClicked: EntityTree.Select(index)
+  }
+}
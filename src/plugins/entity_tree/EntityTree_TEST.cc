@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/Plugin.hh"
+#include "gz/gui/SceneEntities.hh"
+#include "test_config.hh"  // NOLINT(build/include)
+
+#include "EntityTree.hh"
+
+#define NAME_ROLE 51
+#define TYPE_ROLE 52
+#define ID_ROLE 53
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./EntityTree_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+SceneEntities::Entity Make(unsigned int _id, unsigned int _parent,
+    const std::string &_name, SceneEntities::Type _type)
+{
+  SceneEntities::Entity entity;
+  entity.id = _id;
+  entity.parent = _parent;
+  entity.name = _name;
+  entity.type = _type;
+  return entity;
+}
+
+/////////////////////////////////////////////////
+TEST(EntityTreeTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Model))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  // Loaded before the plugin
+  auto entities = SceneEntities::Instance();
+  std::vector<SceneEntities::Entity> added;
+  for (unsigned int id = 1; id <= 1000; ++id)
+    added.push_back(Make(id, 0, "model_" + std::to_string(id),
+        SceneEntities::Type::kModel));
+  added.push_back(Make(1001, 1, "link", SceneEntities::Type::kLink));
+  added.push_back(Make(1002, 1001, "visual", SceneEntities::Type::kVisual));
+  entities->Add(added);
+  entities->Flush();
+
+  EXPECT_TRUE(app.LoadPlugin("EntityTree"));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  auto plugins = win->findChildren<plugins::EntityTree *>();
+  ASSERT_EQ(1, plugins.size());
+  auto plugin = plugins[0];
+  EXPECT_EQ("Entity tree", plugin->Title());
+
+  auto model = plugin->Model();
+  ASSERT_NE(nullptr, model);
+
+  // Only some of the rows are created
+  int shown = model->rowCount();
+  EXPECT_GT(shown, 0);
+  EXPECT_LT(shown, 1000);
+  EXPECT_TRUE(model->canFetchMore(QModelIndex()));
+  while (model->canFetchMore(QModelIndex()))
+    model->fetchMore(QModelIndex());
+  EXPECT_EQ(1000, model->rowCount());
+
+  auto first = model->index(0, 0);
+  EXPECT_EQ("model_1", first.data(NAME_ROLE));
+  EXPECT_EQ("model", first.data(TYPE_ROLE));
+  EXPECT_EQ(1u, first.data(ID_ROLE).toUInt());
+
+  // Children are created as they're expanded
+  EXPECT_TRUE(model->hasChildren(first));
+  EXPECT_EQ(0, model->rowCount(first));
+  ASSERT_TRUE(model->canFetchMore(first));
+  model->fetchMore(first);
+  ASSERT_EQ(1, model->rowCount(first));
+  auto link = model->index(0, 0, first);
+  EXPECT_EQ("link", link.data(NAME_ROLE));
+  EXPECT_EQ(first, model->parent(link));
+  EXPECT_FALSE(model->index(0, 0, model->index(1, 0)).isValid());
+
+  // Incremental changes
+  int inserted{0};
+  int removed{0};
+  QObject::connect(model, &QAbstractItemModel::rowsInserted,
+      [&inserted](const QModelIndex &, int _first, int _last)
+      {
+        inserted += _last - _first + 1;
+      });
+  QObject::connect(model, &QAbstractItemModel::rowsRemoved,
+      [&removed](const QModelIndex &, int _first, int _last)
+      {
+        removed += _last - _first + 1;
+      });
+
+  entities->Add({Make(2000, 1, "link_2", SceneEntities::Type::kLink)});
+  entities->Flush();
+  EXPECT_EQ(1, inserted);
+  EXPECT_EQ(2, model->rowCount(first));
+  EXPECT_EQ("link_2", model->index(1, 0, first).data(NAME_ROLE));
+
+  entities->Remove({2, 3, 1001});
+  entities->Flush();
+  EXPECT_EQ(3, removed);
+  EXPECT_EQ(998, model->rowCount());
+  EXPECT_EQ(1, model->rowCount(first));
+  EXPECT_EQ("model_4", model->index(1, 0).data(NAME_ROLE));
+
+  // Search
+  auto results = plugin->Search("MODEL_10");
+  ASSERT_EQ(12, results.size());
+  EXPECT_EQ("model_10", results[0].toMap()["name"]);
+  EXPECT_TRUE(plugin->Search("").isEmpty());
+
+  // Selection
+  int selectionChanges{0};
+  QObject::connect(plugin, &plugins::EntityTree::SelectedIndexChanged,
+      [&selectionChanges]()
+      {
+        ++selectionChanges;
+      });
+  EXPECT_FALSE(plugin->SelectedIndex().isValid());
+  plugin->Select(model->index(1, 0));
+  EXPECT_EQ(4u, entities->Selected());
+  EXPECT_EQ(model->index(1, 0), plugin->SelectedIndex());
+
+  // Selected by another plugin, its ancestors' rows are created
+  entities->Add({Make(3000, 500, "deep_link", SceneEntities::Type::kLink)});
+  entities->Flush();
+  entities->SetSelected(3000);
+  EXPECT_EQ(2, selectionChanges);
+  auto selected = plugin->SelectedIndex();
+  ASSERT_TRUE(selected.isValid());
+  EXPECT_EQ("deep_link", selected.data(NAME_ROLE));
+  EXPECT_EQ("model_500", model->parent(selected).data(NAME_ROLE));
+
+  entities->Clear();
+  entities->Flush();
+  EXPECT_EQ(0, model->rowCount());
+  EXPECT_FALSE(plugin->SelectedIndex().isValid());
+}
@@ -15,20 +15,33 @@
  *
 */
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
 #include <string>
+#include <utility>
+#include <variant>
 #include <vector>
 
 #include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Util.hh>
 #include <gz/gui/Application.hh>
 #include <gz/gui/Conversions.hh>
 #include <gz/gui/GuiEvents.hh>
 #include <gz/gui/MainWindow.hh>
+#include <gz/gui/StaticPlugins.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/math/Color.hh>
 #include <gz/math/Pose3.hh>
+#include <gz/rendering/Camera.hh>
 #include <gz/rendering/Grid.hh>
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/RenderEngine.hh>
 #include <gz/rendering/RenderingIface.hh>
 #include <gz/rendering/Scene.hh>
+#include <gz/rendering/ShaderParams.hh>
 
 #include "GridConfig.hh"
 
@@ -50,6 +63,29 @@ namespace gz::gui
 
     /// \brief Grid color
     math::Color color{math::Color(0.7f, 0.7f, 0.7f, 1.0f)};
+
+    /// \brief True to draw the grid with a shader instead of lines
+    bool infinite{false};
+
+    /// \brief Infinite grids fade out this far from the camera, at least
+    double fadeDistance{100.0};
+  };
+
+  /// \brief Plane drawing a grid with a shader, in place of its lines.
+  /// Its cost doesn't depend on the number of cells.
+  struct InfiniteGrid
+  {
+    /// \brief Plane, which follows the camera
+    rendering::VisualPtr visual;
+
+    /// \brief Material with the grid shaders
+    rendering::MaterialPtr material;
+
+    /// \brief Visual of the line grid, the plane follows its pose
+    rendering::VisualPtr gridVisual;
+
+    /// \brief Fade distance, see GridParam
+    double fadeDistance{100.0};
   };
 
   class GridConfigPrivate
@@ -80,12 +116,272 @@ namespace gz::gui
 
     /// \brief Visible state
     bool visible{true};
+
+    /// \brief Draw a grid with a shader and hide its lines.
+    /// \param[in] _grid Line grid
+    /// \param[in] _fadeDistance Fade distance, see GridParam
+    /// \return False if the render engine doesn't support it
+    public: bool CreateInfinite(const rendering::GridPtr &_grid,
+        double _fadeDistance);
+
+    /// \brief Draw a grid with its lines again.
+    /// \param[in] _name Name of the line grid
+    public: void DestroyInfinite(const std::string &_name);
+
+    /// \brief Move the infinite grids under the camera and update their
+    /// shader parameters. Called on the render thread on each frame.
+    public: void UpdateInfinite();
+
+    /// \brief Infinite grids, by name of their line grid
+    public: std::map<std::string, InfiniteGrid> infiniteGrids;
+
+    /// \brief User camera, which the infinite grids follow
+    public: rendering::CameraPtr camera{nullptr};
+
+    /// \brief Paths to the vertex and fragment shaders, empty until they're
+    /// written
+    public: std::pair<std::string, std::string> shaderPaths;
   };
 }
 
+namespace
+{
+  /// \brief Vertex shader of the infinite grids, for Ogre 2 and OpenGL
+  constexpr const char *kVertexShader = R"glsl(#version ogre_glsl_ver_330
+
+in vec4 vertex;
+uniform mat4 worldviewproj_matrix;
+
+// Size of the plane, and its center in the grid's frame
+uniform float u_scale;
+uniform vec2 u_offset;
+
+out block
+{
+  vec2 gridPos;
+} outVs;
+
+void main()
+{
+  gl_Position = worldviewproj_matrix * vertex;
+  outVs.gridPos = vertex.xy * u_scale + u_offset;
+}
+)glsl";
+
+  /// \brief Fragment shader of the infinite grids. Lines are spaced by
+  /// powers of ten of the cell length, picked from the screen-space size
+  /// of a pixel, and each level fades into the next one.
+  constexpr const char *kFragmentShader = R"glsl(#version ogre_glsl_ver_330
+
+in block
+{
+  vec2 gridPos;
+} inPs;
+
+uniform vec4 u_color;
+uniform float u_cellLength;
+uniform vec2 u_camera;
+uniform float u_fadeDistance;
+
+out vec4 fragColor;
+
+// Coverage of lines spaced by _spacing, about a pixel wide
+float lines(vec2 _pos, float _spacing)
+{
+  vec2 coord = _pos / _spacing;
+  vec2 dist = abs(fract(coord - 0.5) - 0.5) / fwidth(coord);
+  return 1.0 - min(min(dist.x, dist.y), 1.0);
+}
+
+void main()
+{
+  // Finest level whose lines are at least 8 pixels apart
+  vec2 pixel = fwidth(inPs.gridPos);
+  float level = max(0.0,
+      log(max(pixel.x, pixel.y) * 8.0 / u_cellLength) / log(10.0));
+  float spacing = u_cellLength * pow(10.0, floor(level));
+
+  float alpha = max(lines(inPs.gridPos, spacing) * (1.0 - fract(level)),
+      lines(inPs.gridPos, spacing * 10.0));
+  alpha *= 1.0 - smoothstep(0.5 * u_fadeDistance, u_fadeDistance,
+      length(inPs.gridPos - u_camera));
+  if (alpha <= 0.0)
+    discard;
+
+  fragColor = vec4(u_color.rgb, u_color.a * alpha);
+}
+)glsl";
+
+  /////////////////////////////////////////////////
+  /// \brief Write a shader, unless it's already up to date
+  /// \param[in] _path File
+  /// \param[in] _source Shader source
+  /// \return True if the file has the source
+  bool writeShader(const std::string &_path, const std::string &_source)
+  {
+    {
+      std::ifstream in(_path);
+      std::string current((std::istreambuf_iterator<char>(in)),
+          std::istreambuf_iterator<char>());
+      if (current == _source)
+        return true;
+    }
+    std::ofstream out(_path);
+    out << _source;
+    return out.good();
+  }
+}
+
 using namespace gz;
 using namespace gui;
 
+/////////////////////////////////////////////////
+bool GridConfigPrivate::CreateInfinite(const rendering::GridPtr &_grid,
+    double _fadeDistance)
+{
+  if (this->infiniteGrids.count(_grid->Name()) > 0u)
+    return true;
+
+  auto gridVisual = _grid->Parent();
+  if (nullptr == gridVisual)
+    return false;
+
+  // The shaders are written for Ogre 2 with OpenGL
+  if (nullptr == this->scene->Engine() ||
+      this->scene->Engine()->Name() != "ogre2")
+  {
+    gzerr << "Infinite grids need the ogre2 render engine, drawing ["
+          << _grid->Name() << "] with lines" << std::endl;
+    return false;
+  }
+
+  // The render engine loads shaders from files
+  if (this->shaderPaths.first.empty())
+  {
+    std::string home;
+    common::env(GZ_HOMEDIR, home);
+    auto dir = common::joinPaths(home, ".gz", "gui", "grid_config");
+    auto vertex = common::joinPaths(dir, "infinite_grid_vs.glsl");
+    auto fragment = common::joinPaths(dir, "infinite_grid_fs.glsl");
+    if (!common::createDirectories(dir) ||
+        !writeShader(vertex, kVertexShader) ||
+        !writeShader(fragment, kFragmentShader))
+    {
+      gzerr << "Failed to write the infinite grid shaders to [" << dir
+            << "]" << std::endl;
+      return false;
+    }
+    this->shaderPaths = {vertex, fragment};
+  }
+
+  InfiniteGrid infinite;
+  infinite.gridVisual = gridVisual;
+  infinite.fadeDistance = _fadeDistance;
+  infinite.material = this->scene->CreateMaterial();
+  infinite.material->SetVertexShader(this->shaderPaths.first);
+  infinite.material->SetFragmentShader(this->shaderPaths.second);
+  // Transparent so the lines are blended and fade out
+  infinite.material->SetTransparency(0.5);
+  infinite.material->SetDepthWriteEnabled(false);
+  infinite.material->SetCastShadows(false);
+  (*infinite.material->VertexShaderParams())["u_offset"].InitializeBuffer(2);
+  auto fsParams = infinite.material->FragmentShaderParams();
+  (*fsParams)["u_color"].InitializeBuffer(4);
+  (*fsParams)["u_camera"].InitializeBuffer(2);
+
+  infinite.visual = this->scene->CreateVisual();
+  infinite.visual->AddGeometry(this->scene->CreatePlane());
+  infinite.visual->SetMaterial(infinite.material, false);
+  infinite.visual->SetVisibilityFlags(
+      GZ_VISIBILITY_GUI & ~GZ_VISIBILITY_SELECTABLE);
+  this->scene->RootVisual()->AddChild(infinite.visual);
+
+  gridVisual->SetVisible(false);
+  this->infiniteGrids[_grid->Name()] = infinite;
+  gzdbg << "Drawing grid [" << _grid->Name() << "] with a shader"
+        << std::endl;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void GridConfigPrivate::DestroyInfinite(const std::string &_name)
+{
+  auto it = this->infiniteGrids.find(_name);
+  if (it == this->infiniteGrids.end())
+    return;
+
+  this->scene->DestroyVisual(it->second.visual);
+  this->scene->DestroyMaterial(it->second.material);
+  this->infiniteGrids.erase(it);
+}
+
+/////////////////////////////////////////////////
+void GridConfigPrivate::UpdateInfinite()
+{
+  if (this->infiniteGrids.empty())
+    return;
+
+  if (nullptr == this->camera)
+  {
+    for (unsigned int i = 0; i < this->scene->NodeCount(); ++i)
+    {
+      auto cam = std::dynamic_pointer_cast<rendering::Camera>(
+          this->scene->NodeByIndex(i));
+      if (!cam)
+        continue;
+      try
+      {
+        if (std::get<bool>(cam->UserData("user-camera")))
+        {
+          this->camera = cam;
+          break;
+        }
+      }
+      catch (std::bad_variant_access &)
+      {
+      }
+    }
+    if (nullptr == this->camera)
+      return;
+  }
+
+  for (auto &it : this->infiniteGrids)
+  {
+    auto &infinite = it.second;
+
+    // Centered under the camera in the grid's plane, and wide enough for it
+    // to fade out before the edges. The higher the camera, the farther it
+    // fades.
+    auto gridPose = infinite.gridVisual->WorldPose();
+    auto local = gridPose.Rot().RotateVectorReverse(
+        this->camera->WorldPosition() - gridPose.Pos());
+    double fade = std::max(infinite.fadeDistance, 20.0 * std::abs(local.Z()));
+    double size = 2.0 * fade;
+    infinite.visual->SetWorldPose(
+        gridPose * math::Pose3d(local.X(), local.Y(), 0, 0, 0, 0));
+    infinite.visual->SetLocalScale(size, size, 1.0);
+
+    auto color = infinite.gridVisual->Material() ?
+        infinite.gridVisual->Material()->Ambient() : math::Color::White;
+    float colorBuffer[4]{color.R(), color.G(), color.B(), color.A()};
+    float offset[2]{static_cast<float>(local.X()),
+        static_cast<float>(local.Y())};
+
+    auto grid = std::dynamic_pointer_cast<rendering::Grid>(
+        infinite.gridVisual->GeometryByIndex(0));
+    auto vsParams = infinite.material->VertexShaderParams();
+    (*vsParams)["u_scale"] = static_cast<float>(size);
+    (*vsParams)["u_offset"].UpdateBuffer(offset);
+
+    auto fsParams = infinite.material->FragmentShaderParams();
+    (*fsParams)["u_color"].UpdateBuffer(colorBuffer);
+    (*fsParams)["u_cellLength"] = static_cast<float>(
+        grid ? std::max(grid->CellLength(), 1e-6) : 1.0);
+    (*fsParams)["u_camera"].UpdateBuffer(offset);
+    (*fsParams)["u_fadeDistance"] = static_cast<float>(fade);
+  }
+}
+
 /////////////////////////////////////////////////
 GridConfig::GridConfig()
   : gz::gui::Plugin(), dataPtr(std::make_unique<GridConfigPrivate>())
@@ -144,12 +440,18 @@ void GridConfig::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
         colorStr >> gridParam.color;
       }
 
+      if (auto infiniteElem = insertElem->FirstChildElement("infinite"))
+        infiniteElem->QueryBoolText(&gridParam.infinite);
+
+      if (auto fadeElem = insertElem->FirstChildElement("fade_distance"))
+        fadeElem->QueryDoubleText(&gridParam.fadeDistance);
+
       this->dataPtr->startupGrids.push_back(gridParam);
     }
   }
 
   gui::App()->findChild<
-      MainWindow *>()->installEventFilter(this);
+      MainWindow *>()->SubscribeEvent(events::Render::kType, this);
 }
 
 /////////////////////////////////////////////////
@@ -170,6 +472,9 @@ bool GridConfig::eventFilter(QObject *_obj, QEvent *_event)
 
       // Update selected grid
       this->UpdateGrid();
+
+      // Follow the camera
+      this->dataPtr->UpdateInfinite();
     }
   }
 
@@ -201,6 +506,9 @@ void GridConfig::CreateGrids()
     mat->SetSpecular(gridParam.color);
     gridVis->SetMaterial(mat);
 
+    if (gridParam.infinite)
+      this->dataPtr->CreateInfinite(grid, gridParam.fadeDistance);
+
     this->dataPtr->dirty = true;
 
     gzdbg << "Created grid [" << grid->Name() << "]" << std::endl;
@@ -222,12 +530,27 @@ void GridConfig::UpdateGrid()
   if (!this->dataPtr->dirty)
     return;
 
-  this->dataPtr->grid->SetVerticalCellCount(
-    this->dataPtr->gridParam.vCellCount);
-  this->dataPtr->grid->SetCellCount(
-    this->dataPtr->gridParam.hCellCount);
-  this->dataPtr->grid->SetCellLength(
-    this->dataPtr->gridParam.cellLength);
+  auto &param = this->dataPtr->gridParam;
+  auto name = this->dataPtr->grid->Name();
+  if (param.infinite && !this->dataPtr->CreateInfinite(
+      this->dataPtr->grid, param.fadeDistance))
+  {
+    param.infinite = false;
+    this->newInfinite(false);
+  }
+  else if (!param.infinite)
+  {
+    this->dataPtr->DestroyInfinite(name);
+  }
+
+  // The lines aren't rebuilt while they're hidden. The shader only needs
+  // the cell length.
+  if (!param.infinite)
+  {
+    this->dataPtr->grid->SetVerticalCellCount(param.vCellCount);
+    this->dataPtr->grid->SetCellCount(param.hCellCount);
+  }
+  this->dataPtr->grid->SetCellLength(param.cellLength);
 
   auto visual = this->dataPtr->grid->Parent();
   if (visual)
@@ -246,7 +569,16 @@ void GridConfig::UpdateGrid()
       gzerr << "Grid visual missing material" << std::endl;
     }
 
-    visual->SetVisible(this->dataPtr->visible);
+    auto infinite = this->dataPtr->infiniteGrids.find(name);
+    if (infinite != this->dataPtr->infiniteGrids.end())
+    {
+      visual->SetVisible(false);
+      infinite->second.visual->SetVisible(this->dataPtr->visible);
+    }
+    else
+    {
+      visual->SetVisible(this->dataPtr->visible);
+    }
   }
   else
   {
@@ -283,7 +615,16 @@ void GridConfig::ConnectToGrid()
         // TODO(chapulina) Set to the grid's visible state when that's available
         // through gz-rendering's API
         this->dataPtr->visible = true;
-        grid->Parent()->SetVisible(true);
+        auto infinite = this->dataPtr->infiniteGrids.find(grid->Name());
+        this->dataPtr->gridParam.infinite =
+            infinite != this->dataPtr->infiniteGrids.end();
+        if (this->dataPtr->gridParam.infinite)
+        {
+          infinite->second.visual->SetVisible(true);
+          this->dataPtr->gridParam.fadeDistance =
+              infinite->second.fadeDistance;
+        }
+        grid->Parent()->SetVisible(!this->dataPtr->gridParam.infinite);
 
         this->dataPtr->gridParam.hCellCount = grid->CellCount();
         this->dataPtr->gridParam.vCellCount = grid->VerticalCellCount();
@@ -297,6 +638,7 @@ void GridConfig::ConnectToGrid()
             convert(grid->Parent()->LocalPose().Pos()),
             convert(grid->Parent()->LocalPose().Rot().Euler()),
             convert(grid->Parent()->Material()->Ambient()));
+        this->newInfinite(this->dataPtr->gridParam.infinite);
       }
     }
   }
@@ -371,6 +713,13 @@ void GridConfig::OnShow(bool _checked)
   this->dataPtr->dirty = true;
 }
 
+/////////////////////////////////////////////////
+void GridConfig::OnInfinite(bool _checked)
+{
+  this->dataPtr->gridParam.infinite = _checked;
+  this->dataPtr->dirty = true;
+}
+
 /////////////////////////////////////////////////
 void GridConfig::OnRefresh()
 {
@@ -411,5 +760,4 @@ void GridConfig::RefreshList()
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(GridConfig,
-              gui::Plugin)
+GZ_GUI_ADD_PLUGIN(GridConfig, "GridConfig")
@@ -44,6 +44,15 @@ namespace gui
   ///   * \<cell_length\> : Length of each cell, defaults to 1.
   ///   * \<pose\> : Grid pose, defaults to the origin.
   ///   * \<color\> : Grid color, defaults to (0.7, 0.7, 0.7, 1.0)
+  ///   * \<infinite\> : True to draw the grid with a shader on a plane
+  ///                    which follows the camera, instead of lines. It has
+  ///                    no edges, and lines are spaced by powers of ten of
+  ///                    the cell length depending on the distance, so the
+  ///                    cell counts don't matter. Needs ogre2 with OpenGL.
+  ///                    Defaults to false.
+  ///   * \<fade_distance\> : Infinite grids fade out at this distance from
+  ///                         the camera, or 20 times its height above the
+  ///                         grid if farther. Defaults to 100.
   class GridConfig : public gz::gui::Plugin
   {
     Q_OBJECT
@@ -124,6 +133,15 @@ namespace gui
     /// \param[in] _checked indicates show or hide grid
     public slots: void OnShow(bool _checked);
 
+    /// \brief Callback when the infinite checkbox is clicked.
+    /// \param[in] _checked True to draw the grid with a shader, false to
+    /// draw its lines
+    public slots: void OnInfinite(bool _checked);
+
+    /// \brief Notify QML of whether the grid is drawn with a shader.
+    /// \param[in] _infinite True if it's infinite
+    signals: void newInfinite(bool _infinite);
+
     /// \brief Notify QML that grid values have changed.
     /// \param[in] _hCellCount Horizontal cell count
     /// \param[in] _vCellCount Vertical cell count
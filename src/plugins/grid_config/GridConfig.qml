@@ -52,6 +52,9 @@ GridLayout {
       gzColorGrid.b = _color.b;
       gzColorGrid.a = _color.a;
     }
+    onNewInfinite: {
+      infinite.checked = _infinite;
+    }
   }
 
   ComboBox {
@@ -94,6 +97,19 @@ GridLayout {
     }
   }
 
+  CheckBox {
+    id: infinite
+    Layout.columnSpan: 4
+    text: qsTr("Infinite")
+    checked: false
+    onClicked: {
+      GridConfig.OnInfinite(checked)
+    }
+    ToolTip.visible: hovered
+    ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
+    ToolTip.text: qsTr("Draw with a shader, without edges, instead of lines")
+  }
+
   Text {
     Layout.columnSpan: 4
     text: "Cell Count"
@@ -115,6 +131,7 @@ GridLayout {
     maximumValue: Number.MAX_VALUE
     minimumValue: 0
     value: 0
+    enabled: !infinite.checked
     onEditingFinished: GridConfig.UpdateVCellCount(verticalCellCount.value)
   }
 
@@ -132,6 +149,7 @@ GridLayout {
     maximumValue: Number.MAX_VALUE
     minimumValue: 1
     value: 20
+    enabled: !infinite.checked
     onEditingFinished: GridConfig.UpdateHCellCount(horizontalCellCount.value)
   }
 
@@ -0,0 +1,418 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/msgs/param.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/plugin/Register.hh>
+#include <gz/transport/Node.hh>
+#include <gz/transport/TopicUtils.hh>
+
+#include "gz/gui/LatestValue.hh"
+#include "gz/gui/StaticPlugins.hh"
+
+#include "GuiDiagnostics.hh"
+
+/// \brief History of a counter
+struct CounterHistory
+{
+  /// \brief Ring buffer of samples, NaN before the counter appeared
+  std::vector<double> samples;
+
+  /// \brief Latest value received
+  double latest{std::numeric_limits<double>::quiet_NaN()};
+};
+
+/// \brief Private data class for GuiDiagnostics
+class gz::gui::plugins::GuiDiagnosticsPrivate
+{
+  /// \brief Update the latest values of the counters of a topic.
+  /// \param[in] _prefix Prefix of the topic's counters
+  /// \param[in] _msg Latest message of the topic
+  public: void OnParams(const std::string &_prefix, const msgs::Param &_msg);
+
+  /// \brief Update the counters shown from their samples
+  public: void UpdateShown();
+
+  /// \brief Period of the sampling, in ms
+  public: static constexpr int kSamplePeriodMs{500};
+
+  /// \brief Number of samples kept per counter
+  public: std::size_t history{120u};
+
+  /// \brief Maximum number of counters
+  public: std::size_t maxSeries{256u};
+
+  /// \brief True once the counters beyond maxSeries have been warned about
+  public: bool warnedMaxSeries{false};
+
+  /// \brief Counters by name
+  public: std::map<std::string, CounterHistory> series;
+
+  /// \brief Ring buffer of the times of the samples, in seconds since
+  /// start
+  public: std::vector<double> times;
+
+  /// \brief Index of the next sample in the ring buffers
+  public: std::size_t next{0u};
+
+  /// \brief Number of samples in the ring buffers
+  public: std::size_t count{0u};
+
+  /// \brief When the plugin was created
+  public: std::chrono::steady_clock::time_point start{
+      std::chrono::steady_clock::now()};
+
+  /// \brief Filter of the counters shown
+  public: QString filter;
+
+  /// \brief Counters shown, see GuiDiagnostics::Series
+  public: QVariantList shown;
+
+  /// \brief Timer to sample the counters
+  public: QTimer sampleTimer;
+
+  /// \brief Latest message of each topic, declared before the node so the
+  /// node is destroyed first
+  public: std::vector<std::unique_ptr<LatestValue<msgs::Param>>> latest;
+
+  /// \brief Node to subscribe to the topics
+  public: transport::Node node;
+};
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+/// \brief Format a counter compactly
+/// \param[in] _value Value
+/// \return Value with 4 significant digits, such as "16.67" or "312.5M"
+static QString formatValue(double _value)
+{
+  static const std::vector<std::pair<double, const char *>> kUnits{
+      {1e9, "G"}, {1e6, "M"}, {1e3, "k"}};
+  for (const auto &unit : kUnits)
+  {
+    if (std::abs(_value) >= unit.first)
+      return QString::number(_value / unit.first, 'g', 4) + unit.second;
+  }
+  return QString::number(_value, 'g', 4);
+}
+
+/////////////////////////////////////////////////
+/// \brief Quote a CSV field if needed
+/// \param[in] _field Field
+/// \return Field, quoted if it has commas or quotes
+static std::string csvField(const std::string &_field)
+{
+  if (_field.find_first_of(",\"") == std::string::npos)
+    return _field;
+
+  std::string quoted{"\""};
+  for (auto c : _field)
+  {
+    if (c == '"')
+      quoted += '"';
+    quoted += c;
+  }
+  return quoted + "\"";
+}
+
+/////////////////////////////////////////////////
+void GuiDiagnosticsPrivate::OnParams(const std::string &_prefix,
+    const msgs::Param &_msg)
+{
+  for (const auto &param : _msg.params())
+  {
+    double value{0.0};
+    switch (param.second.type())
+    {
+      case msgs::Any::DOUBLE:
+        value = param.second.double_value();
+        break;
+      case msgs::Any::INT32:
+        value = param.second.int_value();
+        break;
+      case msgs::Any::BOOLEAN:
+        value = param.second.bool_value() ? 1.0 : 0.0;
+        break;
+      default:
+        continue;
+    }
+
+    auto name = _prefix + param.first;
+    auto it = this->series.find(name);
+    if (it == this->series.end())
+    {
+      if (this->series.size() >= this->maxSeries)
+      {
+        if (!this->warnedMaxSeries)
+        {
+          gzwarn << "More than [" << this->maxSeries << "] counters, "
+                 << "ignoring [" << name << "] and further ones. Raise "
+                 << "<max_series> to see them." << std::endl;
+          this->warnedMaxSeries = true;
+        }
+        continue;
+      }
+      it = this->series.emplace(name, CounterHistory()).first;
+      it->second.samples.assign(this->history,
+          std::numeric_limits<double>::quiet_NaN());
+    }
+    it->second.latest = value;
+  }
+}
+
+/////////////////////////////////////////////////
+GuiDiagnostics::GuiDiagnostics()
+  : Plugin(), dataPtr(std::make_unique<GuiDiagnosticsPrivate>())
+{
+  this->connect(&this->dataPtr->sampleTimer, &QTimer::timeout, this,
+      &GuiDiagnostics::Sample);
+}
+
+/////////////////////////////////////////////////
+GuiDiagnostics::~GuiDiagnostics() = default;
+
+/////////////////////////////////////////////////
+void GuiDiagnostics::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "GUI diagnostics";
+
+  std::vector<std::pair<std::string, std::string>> topics;
+  if (_pluginElem)
+  {
+    for (auto topicElem = _pluginElem->FirstChildElement("topic");
+        nullptr != topicElem;
+        topicElem = topicElem->NextSiblingElement("topic"))
+    {
+      auto topic = nullptr == topicElem->GetText() ? std::string() :
+          transport::TopicUtils::AsValidTopic(topicElem->GetText());
+      if (topic.empty())
+      {
+        gzerr << "Invalid <topic>, ignoring it" << std::endl;
+        continue;
+      }
+      auto prefix = topicElem->Attribute("prefix");
+      topics.emplace_back(topic, nullptr == prefix ? "" : prefix);
+    }
+
+    auto elem = _pluginElem->FirstChildElement("history");
+    if (nullptr != elem)
+    {
+      unsigned int history{0u};
+      if (elem->QueryUnsignedText(&history) == tinyxml2::XML_SUCCESS &&
+          history > 1u)
+      {
+        this->dataPtr->history = history;
+      }
+      else
+      {
+        gzerr << "Invalid <history>, expected a number of samples greater "
+              << "than 1" << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("max_series");
+    if (nullptr != elem)
+    {
+      unsigned int maxSeries{0u};
+      if (elem->QueryUnsignedText(&maxSeries) == tinyxml2::XML_SUCCESS)
+        this->dataPtr->maxSeries = maxSeries;
+      else
+        gzerr << "Invalid <max_series>, expected a number" << std::endl;
+    }
+  }
+
+  if (topics.empty())
+  {
+    topics = {
+        {"/gui/frame_timing", "frame/"},
+        {"/gui/stats", ""},
+        {"/gui/diagnostics", ""},
+        {"/gui/topic_stats", "topic"}};
+  }
+
+  this->dataPtr->times.assign(this->dataPtr->history, 0.0);
+
+  for (const auto &topic : topics)
+  {
+    auto prefix = topic.second;
+    auto data = this->dataPtr.get();
+    this->dataPtr->latest.push_back(
+        std::make_unique<LatestValue<msgs::Param>>(this,
+        [data, prefix](const msgs::Param &_msg)
+        {
+          data->OnParams(prefix, _msg);
+        }));
+
+    auto latest = this->dataPtr->latest.back().get();
+    std::function<void(const msgs::Param &)> cb =
+        [latest](const msgs::Param &_msg)
+        {
+          latest->Set(_msg);
+        };
+    if (!this->dataPtr->node.Subscribe(topic.first, cb))
+    {
+      gzerr << "Failed to subscribe to [" << topic.first << "]"
+            << std::endl;
+    }
+  }
+
+  if (!this->dataPtr->sampleTimer.isActive())
+    this->dataPtr->sampleTimer.start(GuiDiagnosticsPrivate::kSamplePeriodMs);
+}
+
+/////////////////////////////////////////////////
+void GuiDiagnostics::Sample()
+{
+  auto &data = *this->dataPtr;
+  if (data.times.empty())
+    return;
+
+  data.times[data.next] = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - data.start).count();
+  for (auto &series : data.series)
+    series.second.samples[data.next] = series.second.latest;
+  data.next = (data.next + 1u) % data.history;
+  data.count = std::min(data.count + 1u, data.history);
+
+  data.UpdateShown();
+  this->SeriesChanged();
+}
+
+/////////////////////////////////////////////////
+void GuiDiagnosticsPrivate::UpdateShown()
+{
+  // Only the counters shown are converted for QML
+  auto first = (this->next + this->history - this->count) % this->history;
+  this->shown.clear();
+  for (const auto &series : this->series)
+  {
+    auto name = QString::fromStdString(series.first);
+    if (!this->filter.isEmpty() &&
+        !name.contains(this->filter, Qt::CaseInsensitive))
+    {
+      continue;
+    }
+
+    QVariantList samples;
+    samples.reserve(static_cast<int>(this->count));
+    double min{std::numeric_limits<double>::max()};
+    double max{std::numeric_limits<double>::lowest()};
+    for (std::size_t i = 0; i < this->count; ++i)
+    {
+      double value = series.second.samples[(first + i) % this->history];
+      if (std::isnan(value))
+      {
+        samples.append(QVariant());
+        continue;
+      }
+      samples.append(value);
+      min = std::min(min, value);
+      max = std::max(max, value);
+    }
+
+    QVariantMap entry;
+    entry["name"] = name;
+    entry["value"] = std::isnan(series.second.latest) ? QString("-") :
+        formatValue(series.second.latest);
+    entry["samples"] = samples;
+    entry["min"] = min <= max ? min : 0.0;
+    entry["max"] = min <= max ? max : 0.0;
+    this->shown.append(entry);
+  }
+}
+
+/////////////////////////////////////////////////
+QVariantList GuiDiagnostics::Series() const
+{
+  return this->dataPtr->shown;
+}
+
+/////////////////////////////////////////////////
+QString GuiDiagnostics::Filter() const
+{
+  return this->dataPtr->filter;
+}
+
+/////////////////////////////////////////////////
+void GuiDiagnostics::SetFilter(const QString &_filter)
+{
+  if (_filter == this->dataPtr->filter)
+    return;
+
+  this->dataPtr->filter = _filter;
+  this->dataPtr->UpdateShown();
+  this->SeriesChanged();
+}
+
+/////////////////////////////////////////////////
+bool GuiDiagnostics::ExportCsv(const QString &_path) const
+{
+  auto path = _path.startsWith("file:") ? QUrl(_path).toLocalFile() :
+      _path;
+  std::ofstream file(path.toStdString());
+  if (!file.is_open())
+  {
+    gzerr << "Failed to export diagnostics to [" << path.toStdString()
+          << "]" << std::endl;
+    return false;
+  }
+
+  const auto &data = *this->dataPtr;
+  file.precision(10);
+  file << "time";
+  for (const auto &series : data.series)
+    file << "," << csvField(series.first);
+  file << "\n";
+
+  auto first = (data.next + data.history - data.count) % data.history;
+  for (std::size_t i = 0; i < data.count; ++i)
+  {
+    auto index = (first + i) % data.history;
+    file << data.times[index];
+    for (const auto &series : data.series)
+    {
+      file << ",";
+      if (!std::isnan(series.second.samples[index]))
+        file << series.second.samples[index];
+    }
+    file << "\n";
+  }
+
+  gzmsg << "Exported [" << data.count << "] samples of ["
+        << data.series.size() << "] counters to [" << path.toStdString()
+        << "]" << std::endl;
+  return true;
+}
+
+// Register this plugin
+GZ_GUI_ADD_PLUGIN(gz::gui::plugins::GuiDiagnostics, "GuiDiagnostics")
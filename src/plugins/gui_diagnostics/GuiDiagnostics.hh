@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_GUI_PLUGINS_GUIDIAGNOSTICS_HH_
+#define GZ_GUI_PLUGINS_GUIDIAGNOSTICS_HH_
+
+#include <memory>
+
+#include "gz/gui/Plugin.hh"
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  class GuiDiagnosticsPrivate;
+
+  /// \brief Displays the recent history of the GUI's performance counters
+  /// as sparklines, so a slow GUI can be diagnosed without a profiler.
+  ///
+  /// The counters are the values of gz.msgs.Param messages published on
+  /// diagnostics topics, by default the render phases of MinimalScene's
+  /// `<frame_timing>`, the plugin costs, GPU memory and message queues of
+  /// PluginProfiler, and the topic rates of TopicStats. Only the latest
+  /// message of each topic is kept, and every counter is sampled twice per
+  /// second into a ring buffer of fixed size, so the plugin costs about the
+  /// same however fast the counters are published. The history can be
+  /// exported as CSV.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<topic\> : May be repeated. Diagnostics topic, with an optional
+  ///               `prefix` attribute prepended to the names of its
+  ///               counters. Defaults to `/gui/frame_timing` with the
+  ///               prefix `frame/`, `/gui/stats`, `/gui/diagnostics`, and
+  ///               `/gui/topic_stats` with the prefix `topic`.
+  /// * \<history\> : Number of samples kept per counter, defaults to 120,
+  ///                 which is one minute.
+  /// * \<max_series\> : Maximum number of counters, further ones are
+  ///                    ignored. Defaults to 256.
+  class GuiDiagnostics : public Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Counters shown, each a map with name, value, the formatted
+    /// latest value, samples, a list of numbers oldest first, and min and
+    /// max of the samples
+    Q_PROPERTY(
+      QVariantList series
+      READ Series
+      NOTIFY SeriesChanged
+    )
+
+    /// \brief Only counters whose name contains it are shown
+    Q_PROPERTY(
+      QString filter
+      READ Filter
+      WRITE SetFilter
+      NOTIFY SeriesChanged
+    )
+
+    /// \brief Constructor
+    public: GuiDiagnostics();
+
+    /// \brief Destructor
+    public: ~GuiDiagnostics() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+        override;
+
+    /// \brief Get the counters shown.
+    /// \return List of maps, sorted by name
+    public: Q_INVOKABLE QVariantList Series() const;
+
+    /// \brief Get the filter of the counters shown.
+    /// \return Filter, empty to show all of them
+    public: Q_INVOKABLE QString Filter() const;
+
+    /// \brief Set the filter of the counters shown.
+    /// \param[in] _filter Part of the names, empty to show all of them
+    public: Q_INVOKABLE void SetFilter(const QString &_filter);
+
+    /// \brief Write the history of all the counters as CSV, with the time
+    /// in seconds since the plugin was loaded and one column per counter.
+    /// Samples taken before a counter appeared are left empty.
+    /// \param[in] _path File path or URL
+    /// \return True if it was written
+    public: Q_INVOKABLE bool ExportCsv(const QString &_path) const;
+
+    /// \brief Notify that the counters have been sampled
+    signals: void SeriesChanged();
+
+    /// \brief Sample all the counters and update the series shown
+    private: void Sample();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<GuiDiagnosticsPrivate> dataPtr;
+  };
+}
+}
+}
+#endif
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+import QtQuick 2.9
+import QtQuick.Controls 2.1
+import QtQuick.Dialogs 1.0
+import QtQuick.Layouts 1.3
+
+Rectangle {
+  id: guiDiagnostics
+  color: "transparent"
+  Layout.minimumWidth: 360
+  Layout.minimumHeight: 240
+
+  ColumnLayout {
+    anchors.fill: parent
+    anchors.margins: 10
+
+    RowLayout {
+      Layout.fillWidth: true
+
+      TextField {
+        objectName: "filter"
+        placeholderText: qsTr("Filter counters")
+        selectByMouse: true
+        text: GuiDiagnostics.filter
+        Layout.fillWidth: true
+        onTextChanged: GuiDiagnostics.filter = text
+      }
+
+      Button {
+        text: qsTr("Export CSV")
+        onClicked: exportDialog.open()
+      }
+    }
+
+    ListView {
+      id: seriesList
+      objectName: "seriesList"
+      clip: true
+      model: GuiDiagnostics.series
+      Layout.fillWidth: true
+      Layout.fillHeight: true
+
+      delegate: RowLayout {
+        width: seriesList.width
+
+        Label {
+          text: modelData.name
+          elide: Text.ElideRight
+          Layout.fillWidth: true
+        }
+
+        Canvas {
+          id: sparkline
+          property var samples: modelData.samples
+          Layout.preferredWidth: 120
+          Layout.preferredHeight: 20
+
+          ToolTip.visible: sparklineArea.containsMouse
+          ToolTip.text: modelData.min.toPrecision(4) + " - " +
+              modelData.max.toPrecision(4)
+
+          onSamplesChanged: requestPaint()
+
+          onPaint: {
+            var ctx = getContext("2d")
+            ctx.clearRect(0, 0, width, height)
+            if (samples.length < 2)
+              return
+
+            var range = modelData.max - modelData.min
+            var step = width / (samples.length - 1)
+            ctx.strokeStyle = "#3e87cc"
+            ctx.lineWidth = 1
+            ctx.beginPath()
+            var drawing = false
+            for (var i = 0; i < samples.length; ++i)
+            {
+              if (samples[i] === null || samples[i] === undefined)
+              {
+                drawing = false
+                continue
+              }
+              var y = range > 0 ?
+                  (1 - (samples[i] - modelData.min) / range) * (height - 2) :
+                  height / 2
+              if (drawing)
+                ctx.lineTo(i * step, y + 1)
+              else
+                ctx.moveTo(i * step, y + 1)
+              drawing = true
+            }
+            ctx.stroke()
+          }
+
+          MouseArea {
+            id: sparklineArea
+            anchors.fill: parent
+            hoverEnabled: true
+          }
+        }
+
+        Label {
+          text: modelData.value
+          horizontalAlignment: Text.AlignRight
+          Layout.preferredWidth: 60
+        }
+      }
+    }
+  }
+
+  FileDialog {
+    id: exportDialog
+    title: qsTr("Export diagnostics")
+    folder: shortcuts.home
+    nameFilters: [ "CSV files (*.csv)" ]
+    selectMultiple: false
+    selectExisting: false
+    onAccepted: {
+      var selected = fileUrl.toString();
+      if (!selected.endsWith(".csv"))
+        selected += ".csv";
+      GuiDiagnostics.ExportCsv(selected);
+    }
+  }
+}
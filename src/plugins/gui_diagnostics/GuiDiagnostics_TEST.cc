@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <gz/msgs/param.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/Plugin.hh"
+#include "gz/gui/qt.h"
+#include "test_config.hh"  // NOLINT(build/include)
+
+#include "GuiDiagnostics.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./GuiDiagnostics_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(GuiDiagnosticsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Sample))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(common::joinPaths(PROJECT_BINARY_PATH, "lib"));
+
+  const char *pluginStr =
+    "<plugin filename=\"GuiDiagnostics\">"
+      "<topic prefix=\"test/\">/test/diagnostics</topic>"
+      "<history>4</history>"
+      "<max_series>2</max_series>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+  EXPECT_TRUE(app.LoadPlugin("GuiDiagnostics",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  auto plugins = win->findChildren<plugins::GuiDiagnostics *>();
+  ASSERT_EQ(1, plugins.size());
+  auto plugin = plugins[0];
+  EXPECT_EQ("GUI diagnostics", plugin->Title());
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Param>("/test/diagnostics");
+
+  msgs::Param msg;
+  auto &render = (*msg.mutable_params())["render"];
+  render.set_type(msgs::Any::DOUBLE);
+  render.set_double_value(2500.0);
+  auto &depth = (*msg.mutable_params())["depth"];
+  depth.set_type(msgs::Any::INT32);
+  depth.set_int_value(3);
+  auto &name = (*msg.mutable_params())["name"];
+  name.set_type(msgs::Any::STRING);
+  name.set_string_value("not a counter");
+
+  // Samples twice per second, until the ring buffer is full
+  int sleep = 0;
+  int maxSleep = 50;
+  while (sleep < maxSleep)
+  {
+    pub.Publish(msg);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    ++sleep;
+    if (plugin->Series().size() == 2 &&
+        plugin->Series()[0].toMap()["samples"].toList().size() == 4)
+    {
+      break;
+    }
+  }
+
+  // Strings aren't counters
+  auto series = plugin->Series();
+  ASSERT_EQ(2, series.size());
+  auto depthMap = series[0].toMap();
+  EXPECT_EQ("test/depth", depthMap["name"].toString());
+  EXPECT_EQ("3", depthMap["value"].toString());
+  EXPECT_DOUBLE_EQ(3.0, depthMap["max"].toDouble());
+  auto renderMap = series[1].toMap();
+  EXPECT_EQ("test/render", renderMap["name"].toString());
+  EXPECT_EQ("2.5k", renderMap["value"].toString());
+
+  // The history is bounded
+  auto samples = renderMap["samples"].toList();
+  ASSERT_EQ(4, samples.size());
+  EXPECT_DOUBLE_EQ(2500.0, samples.back().toDouble());
+
+  // Filtered right away
+  plugin->SetFilter("REND");
+  ASSERT_EQ(1, plugin->Series().size());
+  EXPECT_EQ("test/render",
+      plugin->Series()[0].toMap()["name"].toString());
+  plugin->SetFilter("");
+  EXPECT_EQ(2, plugin->Series().size());
+
+  // All the counters are exported, regardless of the filter
+  plugin->SetFilter("depth");
+  auto path = common::joinPaths(PROJECT_BINARY_PATH,
+      "gui_diagnostics.csv");
+  EXPECT_TRUE(plugin->ExportCsv(QString::fromStdString(path)));
+
+  std::ifstream file(path);
+  std::string header;
+  ASSERT_TRUE(std::getline(file, header));
+  EXPECT_EQ("time,test/depth,test/render", header);
+  int rows{0};
+  std::string row;
+  std::string last;
+  while (std::getline(file, row))
+  {
+    last = row;
+    ++rows;
+  }
+  EXPECT_EQ(4, rows);
+  EXPECT_NE(std::string::npos, last.find(",3,2500"));
+
+  EXPECT_FALSE(plugin->ExportCsv("/nonexistent/dir/file.csv"));
+  common::removeFile(path);
+}
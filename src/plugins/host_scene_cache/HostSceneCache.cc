@@ -0,0 +1,882 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/empty.pb.h>
+#include <gz/msgs/header.pb.h>
+#include <gz/msgs/light.pb.h>
+#include <gz/msgs/link.pb.h>
+#include <gz/msgs/marker.pb.h>
+#include <gz/msgs/marker_v.pb.h>
+#include <gz/msgs/model.pb.h>
+#include <gz/msgs/pose_v.pb.h>
+#include <gz/msgs/scene.pb.h>
+#include <gz/msgs/uint32_v.pb.h>
+#include <gz/msgs/visual.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/math/Rand.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/msgs/Utility.hh>
+#include <gz/plugin/Register.hh>
+#include <gz/transport/MessageInfo.hh>
+#include <gz/transport/Node.hh>
+#include <gz/transport/TopicUtils.hh>
+
+#include "gz/gui/ServiceRequest.hh"
+#include "gz/gui/SharedMemory.hh"
+#include "gz/gui/StaticPlugins.hh"
+
+#include "HostSceneCache.hh"
+
+namespace
+{
+/// \brief Suffix of the segment names, after the topic or service
+const char kSegmentSuffix[] = "/host_cache";
+
+/// \brief Time to wait for the scene service, including for a server which
+/// isn't started yet
+constexpr std::chrono::milliseconds kSceneRequestTimeout{30000};
+
+/// \brief Clock of the marker lifetimes
+using Clock = std::chrono::steady_clock;
+
+/// \brief Key of a marker, its namespace and id
+using MarkerKey = std::pair<std::string, uint64_t>;
+
+/// \brief A marker as it was last set
+struct CachedMarker
+{
+  /// \brief Marker message, with all the fields set so far
+  gz::msgs::Marker msg;
+
+  /// \brief True if it has a lifetime
+  bool expires{false};
+
+  /// \brief When it expires
+  Clock::time_point expiry;
+};
+
+/////////////////////////////////////////////////
+/// \brief Find a key in the header data of a scene message
+/// \param[in] _msg Scene message
+/// \param[in] _key Key
+/// \return Header data, null if not found
+const gz::msgs::Header_Map *HeaderData(const gz::msgs::Scene &_msg,
+    const std::string &_key)
+{
+  if (!_msg.has_header())
+    return nullptr;
+
+  for (const auto &data : _msg.header().data())
+  {
+    if (data.key() == _key)
+      return &data;
+  }
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the revision of a scene update
+/// \param[in] _msg Scene message
+/// \param[out] _revision Revision
+/// \return True if the message has a valid revision
+bool SceneRevision(const gz::msgs::Scene &_msg, uint64_t &_revision)
+{
+  auto data = HeaderData(_msg, "revision");
+  if (nullptr == data || data->value_size() == 0)
+    return false;
+
+  try
+  {
+    _revision = std::stoull(data->value(0));
+    return true;
+  }
+  catch (...)
+  {
+    gzerr << "Invalid scene revision [" << data->value(0) << "]"
+          << std::endl;
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+/// \brief Remove the elements of a repeated field for which a predicate is
+/// true, keeping the order of the others
+/// \param[in, out] _field Repeated field
+/// \param[in] _pred Predicate
+/// \return True if any element was removed
+template <typename T, typename Pred>
+bool EraseIf(google::protobuf::RepeatedPtrField<T> *_field, Pred _pred)
+{
+  int kept{0};
+  for (int i = 0; i < _field->size(); ++i)
+  {
+    if (_pred(_field->Get(i)))
+      continue;
+    if (kept != i)
+      _field->SwapElements(kept, i);
+    ++kept;
+  }
+
+  bool removed = kept < _field->size();
+  while (_field->size() > kept)
+    _field->RemoveLast();
+  return removed;
+}
+
+/////////////////////////////////////////////////
+/// \brief Remove entities from a model, at any depth
+/// \param[in, out] _model Model
+/// \param[in] _ids Ids of the entities to remove
+/// \return True if any was removed
+bool RemoveIds(gz::msgs::Model &_model, const std::set<unsigned int> &_ids)
+{
+  auto removed = [&_ids](const auto &_entity)
+  {
+    return _ids.count(_entity.id()) > 0u;
+  };
+
+  bool changed = EraseIf(_model.mutable_model(), removed);
+  changed = EraseIf(_model.mutable_link(), removed) || changed;
+  for (auto &nested : *_model.mutable_model())
+    changed = RemoveIds(nested, _ids) || changed;
+  for (auto &link : *_model.mutable_link())
+  {
+    changed = EraseIf(link.mutable_visual(), removed) || changed;
+    changed = EraseIf(link.mutable_light(), removed) || changed;
+  }
+  return changed;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the region of a marker request, from the "region_min" and
+/// "region_max" keys of its header data, each holding "x y z".
+/// \param[in] _msg Request
+/// \param[out] _region Region, if it's given
+/// \param[out] _given True if the request has a region
+/// \return False if the region is given but invalid
+bool MarkerRegion(const gz::msgs::Marker &_msg,
+    gz::math::AxisAlignedBox &_region, bool &_given)
+{
+  _given = false;
+  if (!_msg.has_header())
+    return true;
+
+  std::string minValue;
+  std::string maxValue;
+  for (const auto &data : _msg.header().data())
+  {
+    if (data.value_size() == 0)
+      continue;
+    if (data.key() == "region_min")
+      minValue = data.value(0);
+    else if (data.key() == "region_max")
+      maxValue = data.value(0);
+  }
+  _given = !minValue.empty() || !maxValue.empty();
+  if (!_given)
+    return true;
+
+  gz::math::Vector3d min;
+  gz::math::Vector3d max;
+  std::istringstream minStream(minValue);
+  std::istringstream maxStream(maxValue);
+  if (!(minStream >> min) || !(maxStream >> max))
+  {
+    gzerr << "Invalid marker region [" << minValue << "] to [" << maxValue
+          << "], expected [x y z] for both region_min and region_max"
+          << std::endl;
+    return false;
+  }
+  _region = gz::math::AxisAlignedBox(min, max);
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse a megabytes element
+/// \param[in] _elem Element, may be null
+/// \param[in, out] _bytes Size in bytes, unchanged if it's missing or
+/// invalid
+void ParseSize(const tinyxml2::XMLElement *_elem, std::size_t &_bytes)
+{
+  if (nullptr == _elem)
+    return;
+
+  double megabytes{0.0};
+  if (_elem->QueryDoubleText(&megabytes) != tinyxml2::XML_SUCCESS ||
+      megabytes <= 0.0)
+  {
+    gzerr << "Invalid <" << _elem->Name() << ">, expected a positive "
+          << "number of MB" << std::endl;
+    return;
+  }
+  _bytes = static_cast<std::size_t>(megabytes * 1024.0 * 1024.0);
+}
+}
+
+/// \brief Private data class for HostSceneCache
+class gz::gui::plugins::HostSceneCachePrivate
+{
+  /// \brief Request the whole scene from the scene service
+  public: void RequestScene();
+
+  /// \brief Callback with the whole scene
+  /// \param[in] _msg Scene
+  /// \param[in] _result True if the service replied
+  public: void OnSceneSrvMsg(const msgs::Scene &_msg, bool _result);
+
+  /// \brief Callback with a scene update
+  /// \param[in] _msg Scene update
+  public: void OnSceneMsg(const msgs::Scene &_msg);
+
+  /// \brief Callback with deleted entities
+  /// \param[in] _msg Entity ids
+  public: void OnDeletionMsg(const msgs::UInt32_V &_msg);
+
+  /// \brief Apply a scene update to the scene. Must be called with
+  /// sceneMutex locked.
+  /// \param[in] _msg Scene update
+  public: void ApplyUpdate(const msgs::Scene &_msg);
+
+  /// \brief Remove entities from the scene. Must be called with
+  /// sceneMutex locked.
+  /// \param[in] _ids Entity ids
+  public: void RemoveEntities(const std::set<unsigned int> &_ids);
+
+  /// \brief Callback of the marker service
+  /// \param[in] _req Marker message
+  public: void OnMarkerMsg(const msgs::Marker &_req);
+
+  /// \brief Callback of the marker array service
+  /// \param[in] _req Marker messages
+  /// \param[out] _res Always true once the markers are cached
+  /// \return True
+  public: bool OnMarkerMsgArray(const msgs::Marker_V &_req,
+      msgs::Boolean &_res);
+
+  /// \brief Apply a marker message to the markers. Must be called with
+  /// markerMutex locked.
+  /// \param[in] _msg Marker message
+  public: void SetMarker(const msgs::Marker &_msg);
+
+  /// \brief Scene service
+  public: std::string service{"/scene"};
+
+  /// \brief Pose topic
+  public: std::string poseTopic{"/pose"};
+
+  /// \brief Deletion topic
+  public: std::string deletionTopic{"/delete"};
+
+  /// \brief Scene update topic
+  public: std::string sceneTopic{"/scene"};
+
+  /// \brief Marker services, empty to not cache markers
+  public: std::string markerTopic{"/marker"};
+
+  /// \brief Minimum time between two writes of the scene and markers
+  public: std::chrono::milliseconds period{50};
+
+  /// \brief Maximum size of the serialized scene
+  public: std::size_t sceneSize{64u * 1024u * 1024u};
+
+  /// \brief Maximum size of a pose message
+  public: std::size_t poseSize{4u * 1024u * 1024u};
+
+  /// \brief Maximum size of the serialized markers
+  public: std::size_t markerSize{16u * 1024u * 1024u};
+
+  /// \brief Protects the scene state below
+  public: std::mutex sceneMutex;
+
+  /// \brief Whole scene, kept up to date with the updates
+  public: msgs::Scene scene;
+
+  /// \brief True while waiting for the whole scene, during which updates
+  /// are deferred
+  public: bool resyncing{true};
+
+  /// \brief True once a scene with a revision was received
+  public: bool hasRevision{false};
+
+  /// \brief Revision of the scene
+  public: uint64_t revision{0u};
+
+  /// \brief Updates received while waiting for the whole scene
+  public: std::vector<msgs::Scene> deferredUpdates;
+
+  /// \brief Entities deleted while waiting for the whole scene, which may
+  /// still be part of it
+  public: std::set<unsigned int> deferredDeletions;
+
+  /// \brief True if the scene changed since it was last written
+  public: bool sceneDirty{false};
+
+  /// \brief Scene service request in flight
+  public: ServiceRequest sceneRequest;
+
+  /// \brief Protects markers and markersDirty
+  public: std::mutex markerMutex;
+
+  /// \brief Markers, sorted by namespace and id
+  public: std::map<MarkerKey, CachedMarker> markers;
+
+  /// \brief True if markers changed since they were last written
+  public: bool markersDirty{false};
+
+  /// \brief Segment of the scene
+  public: std::unique_ptr<SharedMemoryPublisher> scenePub;
+
+  /// \brief Segment of the latest poses
+  public: std::unique_ptr<SharedMemoryPublisher> posePub;
+
+  /// \brief Segment of the markers
+  public: std::unique_ptr<SharedMemoryPublisher> markerPub;
+
+  /// \brief Number of top level entities, for the GUI thread
+  public: int entityCount{0};
+
+  /// \brief Number of markers, for the GUI thread
+  public: int markerCount{0};
+
+  /// \brief Timer to write the scene and markers
+  public: QTimer timer;
+
+  /// \brief Node to subscribe to the scene and serve the markers
+  public: transport::Node node;
+};
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+HostSceneCache::HostSceneCache()
+  : Plugin(), dataPtr(std::make_unique<HostSceneCachePrivate>())
+{
+  this->connect(&this->dataPtr->timer, &QTimer::timeout, this,
+      &HostSceneCache::Write);
+}
+
+/////////////////////////////////////////////////
+HostSceneCache::~HostSceneCache()
+{
+  this->dataPtr->timer.stop();
+  for (const auto &topic : this->dataPtr->node.SubscribedTopics())
+    this->dataPtr->node.Unsubscribe(topic);
+  for (const auto &service : this->dataPtr->node.AdvertisedServices())
+    this->dataPtr->node.UnadvertiseSrv(service);
+
+  ServiceRequest sceneRequest;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->sceneMutex);
+    sceneRequest = this->dataPtr->sceneRequest;
+  }
+  sceneRequest.Cancel();
+}
+
+/////////////////////////////////////////////////
+void HostSceneCache::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Host scene cache";
+
+  if (this->dataPtr->timer.isActive())
+    return;
+
+  auto &data = *this->dataPtr;
+  if (_pluginElem)
+  {
+    auto parseTopic = [&](const char *_name, std::string &_topic,
+        bool _allowEmpty)
+    {
+      auto elem = _pluginElem->FirstChildElement(_name);
+      if (nullptr == elem)
+        return;
+
+      std::string text = nullptr == elem->GetText() ? "" : elem->GetText();
+      auto topic = transport::TopicUtils::AsValidTopic(text);
+      if (!topic.empty() || (_allowEmpty && text.empty()))
+      {
+        _topic = topic;
+        return;
+      }
+      gzerr << "Invalid <" << _name << "> [" << text << "], using ["
+            << _topic << "]" << std::endl;
+    };
+    parseTopic("service", data.service, false);
+    parseTopic("pose_topic", data.poseTopic, false);
+    parseTopic("deletion_topic", data.deletionTopic, false);
+    parseTopic("scene_topic", data.sceneTopic, false);
+    parseTopic("marker_topic", data.markerTopic, true);
+
+    auto elem = _pluginElem->FirstChildElement("period");
+    if (nullptr != elem)
+    {
+      unsigned int period{0u};
+      if (elem->QueryUnsignedText(&period) == tinyxml2::XML_SUCCESS)
+        data.period = std::chrono::milliseconds(period);
+      else
+        gzerr << "Invalid <period>, expected milliseconds" << std::endl;
+    }
+
+    ParseSize(_pluginElem->FirstChildElement("scene_size"), data.sceneSize);
+    ParseSize(_pluginElem->FirstChildElement("pose_size"), data.poseSize);
+    ParseSize(_pluginElem->FirstChildElement("marker_size"),
+        data.markerSize);
+  }
+
+  // One slot is enough for the scene and markers, whose readers only need
+  // the latest, while poses get a ring so slow readers still get whole
+  // messages
+  data.scenePub = std::make_unique<SharedMemoryPublisher>(
+      data.service + kSegmentSuffix, msgs::Scene().GetTypeName(),
+      data.sceneSize, 2u);
+  data.posePub = std::make_unique<SharedMemoryPublisher>(
+      data.poseTopic + kSegmentSuffix, msgs::Pose_V().GetTypeName(),
+      data.poseSize);
+  if (!data.markerTopic.empty())
+  {
+    data.markerPub = std::make_unique<SharedMemoryPublisher>(
+        data.markerTopic + kSegmentSuffix, msgs::Marker_V().GetTypeName(),
+        data.markerSize, 2u);
+  }
+
+  if (!data.scenePub->Valid() || !data.posePub->Valid() ||
+      (data.markerPub && !data.markerPub->Valid()))
+  {
+    gzerr << "Failed to create the shared memory segments, the scene isn't "
+          << "cached" << std::endl;
+    return;
+  }
+
+  // Poses are copied as they are, without parsing them
+  auto posePub = data.posePub.get();
+  std::function<void(const char *, const size_t,
+      const transport::MessageInfo &)> onPoses =
+      [posePub](const char *_data, const size_t _size,
+          const transport::MessageInfo &)
+      {
+        posePub->PublishRaw(_data, _size);
+      };
+  if (!data.node.SubscribeRaw(data.poseTopic, onPoses,
+      msgs::Pose_V().GetTypeName()))
+  {
+    gzerr << "Failed to subscribe to [" << data.poseTopic << "]"
+          << std::endl;
+  }
+
+  if (!data.node.Subscribe(data.deletionTopic,
+      &HostSceneCachePrivate::OnDeletionMsg, this->dataPtr.get()))
+  {
+    gzerr << "Failed to subscribe to [" << data.deletionTopic << "]"
+          << std::endl;
+  }
+
+  if (!data.node.Subscribe(data.sceneTopic,
+      &HostSceneCachePrivate::OnSceneMsg, this->dataPtr.get()))
+  {
+    gzerr << "Failed to subscribe to [" << data.sceneTopic << "]"
+          << std::endl;
+  }
+
+  if (!data.markerTopic.empty())
+  {
+    if (!data.node.Advertise(data.markerTopic,
+        &HostSceneCachePrivate::OnMarkerMsg, this->dataPtr.get()))
+    {
+      gzerr << "Failed to advertise [" << data.markerTopic << "]"
+            << std::endl;
+    }
+    if (!data.node.Advertise(data.markerTopic + "_array",
+        &HostSceneCachePrivate::OnMarkerMsgArray, this->dataPtr.get()))
+    {
+      gzerr << "Failed to advertise [" << data.markerTopic << "_array]"
+            << std::endl;
+    }
+  }
+
+  this->dataPtr->RequestScene();
+
+  gzmsg << "Caching the scene of [" << data.service << "] for this host"
+        << std::endl;
+  data.timer.start(static_cast<int>(data.period.count()));
+}
+
+/////////////////////////////////////////////////
+int HostSceneCache::EntityCount() const
+{
+  return this->dataPtr->entityCount;
+}
+
+/////////////////////////////////////////////////
+int HostSceneCache::MarkerCount() const
+{
+  return this->dataPtr->markerCount;
+}
+
+/////////////////////////////////////////////////
+void HostSceneCache::Write()
+{
+  auto &data = *this->dataPtr;
+  bool changed{false};
+  bool markersChanged{false};
+  {
+    std::lock_guard<std::mutex> lock(data.sceneMutex);
+    if (data.sceneDirty)
+    {
+      data.sceneDirty = false;
+      data.scenePub->Publish(data.scene);
+      data.entityCount = data.scene.model_size() + data.scene.light_size();
+      changed = true;
+    }
+  }
+
+  if (data.markerPub)
+  {
+    msgs::Marker_V msg;
+    {
+      std::lock_guard<std::mutex> lock(data.markerMutex);
+      auto now = Clock::now();
+      for (auto it = data.markers.begin(); it != data.markers.end();)
+      {
+        if (it->second.expires && it->second.expiry <= now)
+        {
+          it = data.markers.erase(it);
+          data.markersDirty = true;
+        }
+        else
+        {
+          ++it;
+        }
+      }
+
+      if (data.markersDirty)
+      {
+        data.markersDirty = false;
+        for (const auto &marker : data.markers)
+          *msg.add_marker() = marker.second.msg;
+        data.markerCount = static_cast<int>(data.markers.size());
+        markersChanged = true;
+      }
+    }
+
+    // Serialized without holding the lock, markers may be large
+    if (markersChanged)
+      data.markerPub->Publish(msg);
+  }
+
+  if (changed || markersChanged)
+    this->CountsChanged();
+}
+
+/////////////////////////////////////////////////
+void HostSceneCachePrivate::RequestScene()
+{
+  std::function<void(const msgs::Scene &, ServiceRequest::Result)> cb =
+      [this](const msgs::Scene &_msg, ServiceRequest::Result _result)
+  {
+    if (_result == ServiceRequest::Result::kTimedOut)
+    {
+      gzerr << "Timed out waiting for service [" << this->service << "]"
+            << std::endl;
+    }
+    this->OnSceneSrvMsg(_msg, _result == ServiceRequest::Result::kReplied);
+  };
+  auto request = ServiceRequest::Send(ServiceRequest::Thread::kAny,
+      this->node, this->service, msgs::Empty(), kSceneRequestTimeout, cb);
+
+  // Not locked while sending, as failures are handled right away
+  std::lock_guard<std::mutex> lock(this->sceneMutex);
+  this->sceneRequest = request;
+}
+
+/////////////////////////////////////////////////
+void HostSceneCachePrivate::OnSceneSrvMsg(const msgs::Scene &_msg,
+    bool _result)
+{
+  std::lock_guard<std::mutex> lock(this->sceneMutex);
+  this->resyncing = false;
+
+  uint64_t rev{0u};
+  bool hasRev{false};
+  if (_result)
+  {
+    hasRev = SceneRevision(_msg, rev);
+    this->scene = _msg;
+    this->scene.clear_header();
+    if (hasRev)
+    {
+      this->hasRevision = true;
+      this->revision = rev;
+    }
+  }
+  else
+  {
+    gzerr << "Error making service request to [" << this->service << "]"
+          << std::endl;
+  }
+
+  // Updates received meanwhile which are newer than the scene. Without a
+  // revision on the scene, apply all of them.
+  for (const auto &msg : this->deferredUpdates)
+  {
+    uint64_t msgRev{0u};
+    bool hasMsgRev = SceneRevision(msg, msgRev);
+    if (hasRev && hasMsgRev && msgRev <= rev)
+      continue;
+    if (hasMsgRev)
+    {
+      this->hasRevision = true;
+      this->revision = msgRev;
+    }
+    this->ApplyUpdate(msg);
+  }
+  this->deferredUpdates.clear();
+
+  this->RemoveEntities(this->deferredDeletions);
+  this->deferredDeletions.clear();
+  this->sceneDirty = true;
+}
+
+/////////////////////////////////////////////////
+void HostSceneCachePrivate::OnSceneMsg(const msgs::Scene &_msg)
+{
+  bool resync{false};
+  {
+    std::lock_guard<std::mutex> lock(this->sceneMutex);
+    if (this->resyncing)
+    {
+      this->deferredUpdates.push_back(_msg);
+      return;
+    }
+
+    uint64_t rev{0u};
+    if (SceneRevision(_msg, rev))
+    {
+      if (this->hasRevision && rev <= this->revision)
+        return;
+
+      if (this->hasRevision && rev != this->revision + 1)
+      {
+        gzwarn << "Missed scene updates between revisions ["
+               << this->revision << "] and [" << rev
+               << "], requesting the whole scene" << std::endl;
+        this->deferredUpdates.push_back(_msg);
+        this->resyncing = true;
+        resync = true;
+      }
+      else
+      {
+        this->hasRevision = true;
+        this->revision = rev;
+      }
+    }
+
+    if (!resync)
+      this->ApplyUpdate(_msg);
+  }
+
+  if (resync)
+    this->RequestScene();
+}
+
+/////////////////////////////////////////////////
+void HostSceneCachePrivate::OnDeletionMsg(const msgs::UInt32_V &_msg)
+{
+  std::set<unsigned int> ids(_msg.data().begin(), _msg.data().end());
+
+  std::lock_guard<std::mutex> lock(this->sceneMutex);
+  this->RemoveEntities(ids);
+  if (this->resyncing)
+    this->deferredDeletions.insert(ids.begin(), ids.end());
+}
+
+/////////////////////////////////////////////////
+void HostSceneCachePrivate::ApplyUpdate(const msgs::Scene &_msg)
+{
+  // Entities in the update replace existing ones with the same id
+  auto replace = [](auto *_field, const auto &_entity)
+  {
+    for (auto &existing : *_field)
+    {
+      if (existing.id() == _entity.id())
+      {
+        existing = _entity;
+        return;
+      }
+    }
+    *_field->Add() = _entity;
+  };
+  for (const auto &model : _msg.model())
+    replace(this->scene.mutable_model(), model);
+  for (const auto &light : _msg.light())
+    replace(this->scene.mutable_light(), light);
+
+  if (auto removed = HeaderData(_msg, "removed"))
+  {
+    std::set<unsigned int> ids;
+    for (const auto &value : removed->value())
+    {
+      try
+      {
+        ids.insert(static_cast<unsigned int>(std::stoul(value)));
+      }
+      catch (...)
+      {
+        gzerr << "Invalid removed entity [" << value << "]" << std::endl;
+      }
+    }
+    this->RemoveEntities(ids);
+  }
+  this->sceneDirty = true;
+}
+
+/////////////////////////////////////////////////
+void HostSceneCachePrivate::RemoveEntities(
+    const std::set<unsigned int> &_ids)
+{
+  if (_ids.empty())
+    return;
+
+  auto removed = [&_ids](const auto &_entity)
+  {
+    return _ids.count(_entity.id()) > 0u;
+  };
+  bool changed = EraseIf(this->scene.mutable_model(), removed);
+  changed = EraseIf(this->scene.mutable_light(), removed) || changed;
+  for (auto &model : *this->scene.mutable_model())
+    changed = RemoveIds(model, _ids) || changed;
+
+  if (changed)
+    this->sceneDirty = true;
+}
+
+/////////////////////////////////////////////////
+void HostSceneCachePrivate::OnMarkerMsg(const msgs::Marker &_req)
+{
+  std::lock_guard<std::mutex> lock(this->markerMutex);
+  this->SetMarker(_req);
+}
+
+/////////////////////////////////////////////////
+bool HostSceneCachePrivate::OnMarkerMsgArray(const msgs::Marker_V &_req,
+    msgs::Boolean &_res)
+{
+  std::lock_guard<std::mutex> lock(this->markerMutex);
+  for (const auto &marker : _req.marker())
+    this->SetMarker(marker);
+  _res.set_data(true);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void HostSceneCachePrivate::SetMarker(const msgs::Marker &_msg)
+{
+  switch (_msg.action())
+  {
+    case msgs::Marker::ADD_MODIFY:
+    {
+      // Markers without id get one here, so it's the same in every client
+      uint64_t id = _msg.id();
+      while (id == 0u ||
+          (_msg.id() == 0u && this->markers.count({_msg.ns(), id}) > 0u))
+      {
+        id = math::Rand::IntUniform(0, math::MAX_I32);
+      }
+
+      auto inserted = this->markers.emplace(MarkerKey(_msg.ns(), id),
+          CachedMarker());
+      auto &cached = inserted.first->second;
+      if (inserted.second)
+      {
+        cached.msg = _msg;
+      }
+      else
+      {
+        // Fields which are set replace the previous ones, as they do on the
+        // marker
+        if (_msg.point_size() > 0)
+          cached.msg.clear_point();
+        cached.msg.MergeFrom(_msg);
+      }
+      cached.msg.set_id(id);
+
+      cached.expires = _msg.has_lifetime() &&
+          (_msg.lifetime().sec() != 0 || _msg.lifetime().nsec() != 0);
+      if (cached.expires)
+      {
+        cached.expiry = Clock::now() +
+            std::chrono::duration_cast<Clock::duration>(
+            std::chrono::seconds(_msg.lifetime().sec()) +
+            std::chrono::nanoseconds(_msg.lifetime().nsec()));
+      }
+      break;
+    }
+    case msgs::Marker::DELETE_MARKER:
+    {
+      this->markers.erase({_msg.ns(), _msg.id()});
+      break;
+    }
+    case msgs::Marker::DELETE_ALL:
+    {
+      // Markers are deleted from a region by their position
+      math::AxisAlignedBox region;
+      bool hasRegion{false};
+      if (!MarkerRegion(_msg, region, hasRegion))
+        return;
+      for (auto it = this->markers.begin(); it != this->markers.end();)
+      {
+        bool matches = _msg.ns().empty() || it->first.first == _msg.ns();
+        if (matches && hasRegion)
+        {
+          matches = region.Contains(
+              msgs::Convert(it->second.msg.pose()).Pos());
+        }
+        if (matches)
+          it = this->markers.erase(it);
+        else
+          ++it;
+      }
+      break;
+    }
+    default:
+      gzerr << "Unknown marker action [" << _msg.action() << "]"
+            << std::endl;
+      return;
+  }
+  this->markersDirty = true;
+}
+
+// Register this plugin
+GZ_GUI_ADD_PLUGIN(gz::gui::plugins::HostSceneCache, "HostSceneCache")
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_HOSTSCENECACHE_HH_
+#define GZ_GUI_PLUGINS_HOSTSCENECACHE_HH_
+
+#include <memory>
+
+#include "gz/gui/Plugin.hh"
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  class HostSceneCachePrivate;
+
+  /// \brief Holds the scene, latest poses and markers of a world in shared
+  /// memory, for the other GUI processes on the same host, so that they
+  /// don't each receive and parse them.
+  ///
+  /// The cache is the only process of the host subscribing to the scene
+  /// topics and serving the marker services. TransportSceneManager and
+  /// MarkerManager plugins with `<host_cache>` read from it instead, see
+  /// SharedMemoryPublisher. It may run in one of the GUIs, whose scene
+  /// plugins then use `<host_cache>` too, or in a process of its own,
+  /// such as `gz gui` with only this plugin.
+  ///
+  /// The whole scene is kept up to date with the scene updates and
+  /// deletions, and rewritten into its segment each time it changes, at
+  /// most once per period. Clients only reload the entities which
+  /// changed. Pose messages are copied into their segment as they arrive.
+  /// Markers are kept as they were last set by the `<marker_topic>` and
+  /// `<marker_topic>_array` services, and expire after their lifetime in
+  /// wall clock time. Markers deleted from a region are those whose
+  /// position is in it, and the listing services aren't served.
+  ///
+  /// Segments are named after the topic or service with a `/host_cache`
+  /// suffix, such as `/scene/host_cache`, so they don't replace segments
+  /// of the publishers themselves.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<service\> : Scene service, defaults to "/scene".
+  /// * \<pose_topic\> : Pose topic, defaults to "/pose".
+  /// * \<deletion_topic\> : Deletion topic, defaults to "/delete".
+  /// * \<scene_topic\> : Scene update topic, defaults to "/scene".
+  /// * \<marker_topic\> : Marker services, defaults to "/marker". Empty to
+  ///                      not cache markers.
+  /// * \<period\> : Minimum time between two writes of the scene and of
+  ///                the markers, in milliseconds. Defaults to 50.
+  /// * \<scene_size\> : Maximum size of the serialized scene, in MB.
+  ///                    Defaults to 64.
+  /// * \<pose_size\> : Maximum size of a pose message, in MB. Defaults
+  ///                   to 4.
+  /// * \<marker_size\> : Maximum size of the serialized markers, in MB.
+  ///                     Defaults to 16.
+  class HostSceneCache : public Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Number of top level models and lights in the scene
+    Q_PROPERTY(
+      int entityCount
+      READ EntityCount
+      NOTIFY CountsChanged
+    )
+
+    /// \brief Number of markers
+    Q_PROPERTY(
+      int markerCount
+      READ MarkerCount
+      NOTIFY CountsChanged
+    )
+
+    /// \brief Constructor
+    public: HostSceneCache();
+
+    /// \brief Destructor
+    public: ~HostSceneCache() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+        override;
+
+    /// \brief Get the number of top level models and lights in the scene
+    /// \return Number of entities
+    public: Q_INVOKABLE int EntityCount() const;
+
+    /// \brief Get the number of markers
+    /// \return Number of markers
+    public: Q_INVOKABLE int MarkerCount() const;
+
+    /// \brief Notify that the counts changed
+    signals: void CountsChanged();
+
+    /// \brief Write the scene and markers which changed into their
+    /// segments
+    private: void Write();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<HostSceneCachePrivate> dataPtr;
+  };
+}
+}
+}
+#endif
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+import QtQuick 2.9
+import QtQuick.Controls 2.1
+import QtQuick.Layouts 1.3
+
+Rectangle {
+  id: hostSceneCache
+  color: "transparent"
+  Layout.minimumWidth: 250
+  Layout.minimumHeight: 80
+
+  GridLayout {
+    anchors.fill: parent
+    anchors.margins: 10
+    columns: 2
+
+    Label {
+      font.weight: Font.DemiBold
+      text: "Entities"
+    }
+
+    Label {
+      objectName: "entityCount"
+      text: HostSceneCache.entityCount
+      Layout.fillWidth: true
+    }
+
+    Label {
+      font.weight: Font.DemiBold
+      text: "Markers"
+    }
+
+    Label {
+      objectName: "markerCount"
+      text: HostSceneCache.markerCount
+      Layout.fillWidth: true
+    }
+  }
+}
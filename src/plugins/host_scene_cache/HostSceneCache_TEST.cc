@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <gz/msgs/empty.pb.h>
+#include <gz/msgs/marker.pb.h>
+#include <gz/msgs/marker_v.pb.h>
+#include <gz/msgs/pose_v.pb.h>
+#include <gz/msgs/scene.pb.h>
+#include <gz/msgs/uint32_v.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/Plugin.hh"
+#include "gz/gui/SharedMemory.hh"
+#include "gz/gui/qt.h"
+#include "test_config.hh"  // NOLINT(build/include)
+
+#include "HostSceneCache.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./HostSceneCache_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(HostSceneCacheTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Cache))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(common::joinPaths(PROJECT_BINARY_PATH, "lib"));
+
+  // Scene with a single model
+  transport::Node node;
+  std::function<bool(const msgs::Empty &, msgs::Scene &)> onScene =
+      [](const msgs::Empty &, msgs::Scene &_rep)
+      {
+        auto model = _rep.add_model();
+        model->set_id(1);
+        model->set_name("box");
+        return true;
+      };
+  EXPECT_TRUE(node.Advertise("/test/host_cache/scene", onScene));
+
+  const char *pluginStr =
+    "<plugin filename=\"HostSceneCache\">"
+      "<service>/test/host_cache/scene</service>"
+      "<pose_topic>/test/host_cache/pose</pose_topic>"
+      "<deletion_topic>/test/host_cache/delete</deletion_topic>"
+      "<scene_topic>/test/host_cache/scene_update</scene_topic>"
+      "<marker_topic>/test/host_cache/marker</marker_topic>"
+      "<period>10</period>"
+      "<scene_size>1</scene_size>"
+      "<pose_size>1</pose_size>"
+      "<marker_size>1</marker_size>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+  EXPECT_TRUE(app.LoadPlugin("HostSceneCache",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  auto plugins = win->findChildren<plugins::HostSceneCache *>();
+  ASSERT_EQ(1, plugins.size());
+  auto plugin = plugins[0];
+  EXPECT_EQ("Host scene cache", plugin->Title());
+
+  std::mutex mutex;
+  msgs::Scene scene;
+  msgs::Pose_V poses;
+  msgs::Marker_V markers;
+  std::atomic<int> sceneCount{0};
+  std::atomic<int> poseCount{0};
+  std::atomic<int> markerCount{0};
+
+  SharedMemorySubscriber sceneSub;
+  ASSERT_TRUE(sceneSub.Subscribe("/test/host_cache/scene/host_cache",
+      [&](const SharedMemoryView &_view)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (_view.Parse(scene))
+          ++sceneCount;
+      }));
+
+  SharedMemorySubscriber poseSub;
+  ASSERT_TRUE(poseSub.Subscribe("/test/host_cache/pose/host_cache",
+      [&](const SharedMemoryView &_view)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (_view.Parse(poses))
+          ++poseCount;
+      }));
+
+  SharedMemorySubscriber markerSub;
+  ASSERT_TRUE(markerSub.Subscribe("/test/host_cache/marker/host_cache",
+      [&](const SharedMemoryView &_view)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (_view.Parse(markers))
+          ++markerCount;
+      }));
+
+  // Updates add to the scene, until both models are cached
+  auto scenePub = node.Advertise<msgs::Scene>(
+      "/test/host_cache/scene_update");
+  auto posePub = node.Advertise<msgs::Pose_V>("/test/host_cache/pose");
+  msgs::Scene update;
+  auto model = update.add_model();
+  model->set_id(2);
+  model->set_name("sphere");
+  msgs::Pose_V poseMsg;
+  auto pose = poseMsg.add_pose();
+  pose->set_id(2);
+  pose->mutable_position()->set_x(3.0);
+
+  auto modelCount = [&]()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return scene.model_size();
+  };
+  for (int i = 0; i < 100 && (modelCount() < 2 || poseCount == 0); ++i)
+  {
+    scenePub.Publish(update);
+    posePub.Publish(poseMsg);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    QCoreApplication::processEvents();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(2, scene.model_size());
+    EXPECT_EQ(1u, scene.model(0).id());
+    EXPECT_EQ(2u, scene.model(1).id());
+    ASSERT_EQ(1, poses.pose_size());
+    EXPECT_DOUBLE_EQ(3.0, poses.pose(0).position().x());
+  }
+  EXPECT_EQ(2, plugin->EntityCount());
+
+  // Deleted entities are removed from the scene
+  auto deletionPub = node.Advertise<msgs::UInt32_V>(
+      "/test/host_cache/delete");
+  msgs::UInt32_V deletion;
+  deletion.add_data(1);
+  for (int i = 0; i < 100 && modelCount() != 1; ++i)
+  {
+    deletionPub.Publish(deletion);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    QCoreApplication::processEvents();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(1, scene.model_size());
+    EXPECT_EQ(2u, scene.model(0).id());
+  }
+
+  // Markers are kept as they were last set
+  msgs::Marker marker;
+  marker.set_ns("test");
+  marker.set_id(5);
+  marker.set_action(msgs::Marker::ADD_MODIFY);
+  marker.set_type(msgs::Marker::SPHERE);
+  EXPECT_TRUE(node.Request("/test/host_cache/marker", marker));
+
+  msgs::Marker modify;
+  modify.set_ns("test");
+  modify.set_id(5);
+  modify.set_action(msgs::Marker::ADD_MODIFY);
+  modify.mutable_pose()->mutable_position()->set_z(1.0);
+  EXPECT_TRUE(node.Request("/test/host_cache/marker", modify));
+
+  auto markerSize = [&]()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return markers.marker_size() == 1 &&
+        markers.marker(0).pose().position().z() > 0.5;
+  };
+  for (int i = 0; i < 100 && !markerSize(); ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    QCoreApplication::processEvents();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(1, markers.marker_size());
+    EXPECT_EQ("test", markers.marker(0).ns());
+    EXPECT_EQ(5u, markers.marker(0).id());
+    EXPECT_EQ(msgs::Marker::SPHERE, markers.marker(0).type());
+    EXPECT_DOUBLE_EQ(1.0, markers.marker(0).pose().position().z());
+  }
+  EXPECT_EQ(1, plugin->MarkerCount());
+
+  // Deleting the namespace removes it
+  msgs::Marker deleteAll;
+  deleteAll.set_ns("test");
+  deleteAll.set_action(msgs::Marker::DELETE_ALL);
+  EXPECT_TRUE(node.Request("/test/host_cache/marker", deleteAll));
+  for (int i = 0; i < 100 && plugin->MarkerCount() != 0; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    QCoreApplication::processEvents();
+  }
+  EXPECT_EQ(0, plugin->MarkerCount());
+}
@@ -19,62 +19,1146 @@
 
 #include "ImageDisplay.hh"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <gz/common/Console.hh>
-#include <gz/common/Image.hh>
 #include <gz/msgs/Utility.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/transport/Node.hh>
 
+#include <QBuffer>
+#include <QImageReader>
+#include <QPainter>
+
 #include "gz/gui/Application.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/QueueStats.hh"
+#include "gz/gui/SharedMemory.hh"
+#include "gz/gui/StaticPlugins.hh"
+#include "gz/gui/TopicDiscovery.hh"
+#include "gz/gui/WorkerPool.hh"
+
+namespace
+{
+/// \brief Read a value which may not be aligned in the message buffer.
+/// \param[in] _data Pointer to the value
+/// \return The value
+template<typename T>
+T ReadValue(const char *_data)
+{
+  T value;
+  std::memcpy(&value, _data, sizeof(T));
+  return value;
+}
+
+/// \brief Write a single channel image into the scanlines of an RGB888
+/// image as grayscale, scaled so that _min is black and _max white.
+/// Matches common::Image::ConvertToRGBImage, without its intermediate
+/// buffers.
+/// \param[in] _data First row of the image
+/// \param[in] _step Bytes per row of _data
+/// \param[in] _min Value shown as black. If it's the maximum value of T,
+/// the minimum of the image is used.
+/// \param[in] _max Value shown as white. If it's the lowest value of T,
+/// the maximum of the image is used.
+/// \param[in] _flip True to show _min as white and _max as black
+/// \param[out] _image Image of the same size as the data
+template<typename T>
+void GrayToRGB(const char *_data, unsigned int _step, T _min, T _max,
+    bool _flip, QImage &_image)
+{
+  const int width = _image.width();
+  const int height = _image.height();
+
+  // Range of the image, ignoring infinite and NaN values
+  T min = std::numeric_limits<T>::max();
+  T max = std::numeric_limits<T>::lowest();
+  if (_min == std::numeric_limits<T>::max() ||
+      _max == std::numeric_limits<T>::lowest())
+  {
+    for (int j = 0; j < height; ++j)
+    {
+      const char *row = _data + j * _step;
+      for (int i = 0; i < width; ++i)
+      {
+        T v = ReadValue<T>(row + i * sizeof(T));
+        if (!std::isfinite(static_cast<float>(v)))
+          continue;
+        min = std::min(min, v);
+        max = std::max(max, v);
+      }
+    }
+  }
+  if (_min != std::numeric_limits<T>::max())
+    min = _min;
+  if (_max != std::numeric_limits<T>::lowest())
+    max = _max;
+
+  double range = static_cast<double>(max) - static_cast<double>(min);
+  if (std::abs(range) < 1e-6)
+    range = 1.0;
+  const double offset = static_cast<double>(min);
+
+  for (int j = 0; j < height; ++j)
+  {
+    const char *row = _data + j * _step;
+    uchar *line = _image.scanLine(j);
+    for (int i = 0; i < width; ++i)
+    {
+      double t = (static_cast<double>(ReadValue<T>(row + i * sizeof(T))) -
+          offset) / range;
+      // NaN is shown like _min
+      t = t > 0.0 ? std::min(t, 1.0) : 0.0;
+      if (_flip)
+        t = 1.0 - t;
+      auto gray = static_cast<uchar>(255 * t);
+      line[3 * i] = gray;
+      line[3 * i + 1] = gray;
+      line[3 * i + 2] = gray;
+    }
+  }
+}
+
+/// \brief Number of bins of the histogram of depth images
+constexpr int kDepthBins{256};
+
+/// \brief Pixels processed together by DepthRow, so each lane's minimum
+/// and maximum are independent and the loop is vectorized
+constexpr int kDepthLanes{8};
+
+/// \brief Range of depth shown from white to black, adapted to every image
+/// from the percentiles of the previous one
+struct DepthRange
+{
+  /// \brief Depth shown as white
+  float min{0.0f};
+
+  /// \brief Depth shown as black
+  float max{1.0f};
+
+  /// \brief True once the range was set from an image
+  bool valid{false};
+
+  /// \brief True to set min from the low percentile
+  bool autoMin{false};
+
+  /// \brief True to set max from the high percentile
+  bool autoMax{true};
+
+  /// \brief Fraction of the pixels shown brighter than white
+  double lowPercentile{0.01};
+
+  /// \brief Fraction of the pixels shown darker than black
+  double highPercentile{0.99};
+
+  /// \brief Fraction of the change of range applied per image, 1 to
+  /// follow each image
+  double smoothing{0.2};
+};
+
+/// \brief Convert a row of depth to gray and bin it, in a single pass.
+/// \param[in] _values Depth of the row, _count values
+/// \param[in] _count Number of values
+/// \param[in] _offset Depth shown as white
+/// \param[in] _scale 1 over the range shown
+/// \param[in] _binOffset Depth of the start of the first bin
+/// \param[in] _binScale Bins per unit of depth
+/// \param[out] _grays Gray of each value, NaN as white
+/// \param[out] _bins Bin of each value, kDepthBins if it isn't finite
+/// \param[in,out] _lo Smallest finite value of each lane
+/// \param[in,out] _hi Largest finite value of each lane
+void DepthRow(const float *_values, int _count, float _offset, float _scale,
+    float _binOffset, float _binScale, uchar *_grays, uint16_t *_bins,
+    float *_lo, float *_hi)
+{
+  const float lastBin = static_cast<float>(kDepthBins - 1);
+  auto pixel = [&](int _i, int _lane)
+  {
+    const float v = _values[_i];
+
+    // False for NaN and infinity, without a call to std::isfinite
+    const bool finite = v >= std::numeric_limits<float>::lowest() &&
+        v <= std::numeric_limits<float>::max();
+    _lo[_lane] = finite && v < _lo[_lane] ? v : _lo[_lane];
+    _hi[_lane] = finite && v > _hi[_lane] ? v : _hi[_lane];
+
+    // Near is white, NaN compares false and is shown like the minimum
+    float t = (v - _offset) * _scale;
+    t = t > 0.0f ? (t < 1.0f ? t : 1.0f) : 0.0f;
+    _grays[_i] = static_cast<uchar>(255.0f * (1.0f - t));
+
+    float b = finite ? (v - _binOffset) * _binScale : 0.0f;
+    b = b > 0.0f ? (b < lastBin ? b : lastBin) : 0.0f;
+    _bins[_i] = finite ? static_cast<uint16_t>(b) :
+        static_cast<uint16_t>(kDepthBins);
+  };
+
+  int i = 0;
+  for (; i + kDepthLanes <= _count; i += kDepthLanes)
+  {
+    for (int lane = 0; lane < kDepthLanes; ++lane)
+      pixel(i + lane, lane);
+  }
+  for (; i < _count; ++i)
+    pixel(i, 0);
+}
+
+/// \brief Write a depth image into the scanlines of an RGB888 image as
+/// grayscale, near as white. The range is taken from the depth's
+/// percentiles, found with a histogram filled in the same pass as the
+/// conversion, so it's used for the next image. A pass finds the range of
+/// the first image.
+/// \param[in] _data First row of the image
+/// \param[in] _step Bytes per row of _data
+/// \param[in,out] _range Range shown, updated for the next image
+/// \param[out] _image Image of the same size as the data
+void DepthToRGB(const char *_data, unsigned int _step, DepthRange &_range,
+    QImage &_image)
+{
+  const int width = _image.width();
+  const int height = _image.height();
+
+  // Rows are copied so they're aligned, the message's data may not be
+  std::vector<float> values(width);
+  std::vector<uchar> grays(width);
+  std::vector<uint16_t> bins(width);
+  float lo[kDepthLanes];
+  float hi[kDepthLanes];
+
+  auto scan = [&](float _offset, float _scale, float _binOffset,
+      float _binScale, std::vector<uint32_t> *_histogram)
+  {
+    std::fill(lo, lo + kDepthLanes, std::numeric_limits<float>::max());
+    std::fill(hi, hi + kDepthLanes, std::numeric_limits<float>::lowest());
+    for (int j = 0; j < height; ++j)
+    {
+      std::memcpy(values.data(), _data + j * _step, width * sizeof(float));
+      DepthRow(values.data(), width, _offset, _scale, _binOffset, _binScale,
+          grays.data(), bins.data(), lo, hi);
+      if (nullptr == _histogram)
+        continue;
+
+      for (auto bin : bins)
+        ++(*_histogram)[bin];
+      uchar *line = _image.scanLine(j);
+      for (int i = 0; i < width; ++i)
+      {
+        line[3 * i] = grays[i];
+        line[3 * i + 1] = grays[i];
+        line[3 * i + 2] = grays[i];
+      }
+    }
+    return std::make_pair(*std::min_element(lo, lo + kDepthLanes),
+        *std::max_element(hi, hi + kDepthLanes));
+  };
+
+  // The first image is shown with its own range
+  if (!_range.valid)
+  {
+    auto extremes = scan(0.0f, 0.0f, 0.0f, 0.0f, nullptr);
+    if (extremes.first <= extremes.second)
+    {
+      if (_range.autoMin)
+        _range.min = extremes.first;
+      if (_range.autoMax)
+        _range.max = extremes.second;
+      _range.valid = true;
+    }
+  }
+
+  double range = static_cast<double>(_range.max) - _range.min;
+  if (std::abs(range) < 1e-6)
+    range = 1.0;
+
+  // The bins extend past the range, so it can grow from one image to the
+  // next
+  const double binMin = _range.min - 0.5 * range;
+  const double binScale = kDepthBins / (2.0 * range);
+  std::vector<uint32_t> histogram(kDepthBins + 1, 0u);
+  auto extremes = scan(_range.min, static_cast<float>(1.0 / range),
+      static_cast<float>(binMin), static_cast<float>(binScale), &histogram);
+  if (!_range.valid || extremes.first > extremes.second)
+    return;
+
+  // Percentiles, the edge bins also hold the values beyond them
+  uint64_t total{0u};
+  for (int b = 0; b < kDepthBins; ++b)
+    total += histogram[b];
+  const auto lowCount = static_cast<uint64_t>(_range.lowPercentile * total);
+  const auto highCount =
+      static_cast<uint64_t>(std::ceil(_range.highPercentile * total));
+  int lowBin{0};
+  int highBin{kDepthBins - 1};
+  uint64_t cumulative{0u};
+  for (int b = 0; b < kDepthBins; ++b)
+  {
+    if (cumulative <= lowCount)
+      lowBin = b;
+    cumulative += histogram[b];
+    if (cumulative >= highCount)
+    {
+      highBin = b;
+      break;
+    }
+  }
+  double low = lowBin == 0 ? extremes.first :
+      std::max<double>(binMin + lowBin / binScale, extremes.first);
+  double high = highBin == kDepthBins - 1 ? extremes.second :
+      std::min<double>(binMin + (highBin + 1) / binScale, extremes.second);
+
+  const double s = std::clamp(_range.smoothing, 0.0, 1.0);
+  if (_range.autoMin)
+    _range.min = static_cast<float>(_range.min + s * (low - _range.min));
+  if (_range.autoMax)
+    _range.max = static_cast<float>(_range.max + s * (high - _range.max));
+}
+
+/// \brief Write a 3 channel image into the scanlines of an RGB888 image.
+/// \param[in] _data First row of the image
+/// \param[in] _step Bytes per row of _data
+/// \param[in] _bgr True if the data is in BGR order, false for RGB
+/// \param[out] _image Image of the same size as the data
+void ColorToRGB(const char *_data, unsigned int _step, bool _bgr,
+    QImage &_image)
+{
+  const int width = _image.width();
+  for (int j = 0; j < _image.height(); ++j)
+  {
+    const auto *row = reinterpret_cast<const uchar *>(_data + j * _step);
+    uchar *line = _image.scanLine(j);
+    if (!_bgr)
+    {
+      std::memcpy(line, row, 3 * width);
+      continue;
+    }
+    for (int i = 0; i < width; ++i)
+    {
+      line[3 * i] = row[3 * i + 2];
+      line[3 * i + 1] = row[3 * i + 1];
+      line[3 * i + 2] = row[3 * i];
+    }
+  }
+}
+
+/// \brief Demosaic an 8 bit Bayer image into the scanlines of an RGB888
+/// image. Each 2x2 cell of the pattern gives the color of its 4 pixels,
+/// with green averaged from the cell's 2 green pixels.
+/// \param[in] _data First row of the image
+/// \param[in] _step Bytes per row of _data
+/// \param[in] _pattern Bayer pattern of the data
+/// \param[out] _image Image of the same size as the data
+void BayerToRGB(const char *_data, unsigned int _step,
+    gz::msgs::PixelFormatType _pattern, QImage &_image)
+{
+  // Position of red and blue in the 2x2 cell, as row * 2 + column. Green
+  // is at the other two positions.
+  int red{0};
+  int blue{3};
+  switch (_pattern)
+  {
+    case gz::msgs::PixelFormatType::BAYER_BGGR8:
+      red = 3;
+      blue = 0;
+      break;
+    case gz::msgs::PixelFormatType::BAYER_GBRG8:
+      red = 2;
+      blue = 1;
+      break;
+    case gz::msgs::PixelFormatType::BAYER_GRBG8:
+      red = 1;
+      blue = 2;
+      break;
+    default:
+      break;
+  }
+
+  const int width = _image.width();
+  const int height = _image.height();
+  for (int j = 0; j < height; j += 2)
+  {
+    // An odd last row or column uses the cell's first row or column
+    const int j1 = std::min(j + 1, height - 1);
+    const uchar *rows[2] = {
+        reinterpret_cast<const uchar *>(_data + j * _step),
+        reinterpret_cast<const uchar *>(_data + j1 * _step)};
+    uchar *lines[2] = {_image.scanLine(j), _image.scanLine(j1)};
+    for (int i = 0; i < width; i += 2)
+    {
+      const int i1 = std::min(i + 1, width - 1);
+      const uchar cell[4] = {rows[0][i], rows[0][i1], rows[1][i],
+          rows[1][i1]};
+      const uchar r = cell[red];
+      const uchar b = cell[blue];
+      const uchar g = static_cast<uchar>(
+          (cell[0] + cell[1] + cell[2] + cell[3] - r - b) / 2);
+      for (uchar *line : lines)
+      {
+        for (int x : {i, i1})
+        {
+          line[3 * x] = r;
+          line[3 * x + 1] = g;
+          line[3 * x + 2] = b;
+        }
+      }
+    }
+  }
+}
+
+/// \brief Get the bytes per pixel of a raw pixel format.
+/// \param[in] _format Pixel format
+/// \return Bytes per pixel, 0 if the format isn't supported
+unsigned int BytesPerPixel(gz::msgs::PixelFormatType _format)
+{
+  switch (_format)
+  {
+    case gz::msgs::PixelFormatType::RGB_INT8:
+    case gz::msgs::PixelFormatType::BGR_INT8:
+      return 3;
+    case gz::msgs::PixelFormatType::R_FLOAT32:
+      return sizeof(float);
+    case gz::msgs::PixelFormatType::L_INT16:
+      return sizeof(uint16_t);
+    case gz::msgs::PixelFormatType::L_INT8:
+    case gz::msgs::PixelFormatType::BAYER_RGGB8:
+    case gz::msgs::PixelFormatType::BAYER_BGGR8:
+    case gz::msgs::PixelFormatType::BAYER_GBRG8:
+    case gz::msgs::PixelFormatType::BAYER_GRBG8:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+/// \brief Get whether a pixel format is a Bayer pattern, whose pixels
+/// are only meaningful in 2x2 cells.
+/// \param[in] _format Pixel format
+/// \return True for Bayer formats
+bool IsBayer(gz::msgs::PixelFormatType _format)
+{
+  return BytesPerPixel(_format) == 1 &&
+      _format != gz::msgs::PixelFormatType::L_INT8;
+}
+
+/// \brief Check that raw pixels hold a whole image, warning if not.
+/// \param[in] _format Pixel format, which must be supported
+/// \param[in] _width Width in pixels
+/// \param[in] _height Height in pixels
+/// \param[in] _step Bytes per row as given by the message
+/// \param[in] _size Size of the pixels in bytes
+/// \return Bytes per row, which may be padded, or 0 if the pixels don't
+/// fit the size
+unsigned int ValidStep(gz::msgs::PixelFormatType _format,
+    unsigned int _width, unsigned int _height, unsigned int _step,
+    std::size_t _size)
+{
+  const unsigned int bytesPerPixel = BytesPerPixel(_format);
+  unsigned int step = std::max(_step, _width * bytesPerPixel);
+  if (_height == 0 || _width == 0 ||
+      _size < static_cast<std::size_t>(step) * (_height - 1) +
+      _width * bytesPerPixel)
+  {
+    gzwarn << "Image data is smaller than its size [" << _width << " x "
+           << _height << "]" << std::endl;
+    return 0;
+  }
+  return step;
+}
+
+/// \brief Convert raw pixels to an image for display.
+/// \param[in] _format Pixel format, which must be supported
+/// \param[in] _data First row of the pixels
+/// \param[in] _step Bytes per row of _data
+/// \param[in] _width Width in pixels
+/// \param[in] _height Height in pixels
+/// \param[in,out] _depth Range of depth images of the stream
+/// \return The image
+QImage ConvertPixels(gz::msgs::PixelFormatType _format, const char *_data,
+    unsigned int _step, int _width, int _height, DepthRange &_depth)
+{
+  // Convert straight into the image's scanlines
+  QImage image(_width, _height, QImage::Format_RGB888);
+  const char *data = _data;
+  const unsigned int step = _step;
+  switch (_format)
+  {
+    case gz::msgs::PixelFormatType::RGB_INT8:
+      ColorToRGB(data, step, false, image);
+      break;
+    case gz::msgs::PixelFormatType::BGR_INT8:
+      ColorToRGB(data, step, true, image);
+      break;
+    case gz::msgs::PixelFormatType::R_FLOAT32:
+      // Darker pixels = higher values and brighter pixels = lower values
+      DepthToRGB(data, step, _depth, image);
+      break;
+    case gz::msgs::PixelFormatType::L_INT16:
+      GrayToRGB<uint16_t>(data, step, std::numeric_limits<uint16_t>::max(),
+          std::numeric_limits<uint16_t>::lowest(), false, image);
+      break;
+    case gz::msgs::PixelFormatType::L_INT8:
+      GrayToRGB<uint8_t>(data, step, std::numeric_limits<uint8_t>::max(),
+          std::numeric_limits<uint8_t>::lowest(), false, image);
+      break;
+    default:
+      BayerToRGB(data, step, _format, image);
+      break;
+  }
+
+  return image;
+}
+
+/// \brief Convert a raw image message to an image for display.
+/// \param[in] _msg Image message
+/// \param[in,out] _depth Range of depth images of the stream
+/// \return The image, null if the message can't be converted
+QImage ConvertImage(const gz::msgs::Image &_msg, DepthRange &_depth)
+{
+  if (BytesPerPixel(_msg.pixel_format_type()) == 0)
+  {
+    gzwarn << "Unsupported image type: "
+            << _msg.pixel_format_type() << std::endl;
+    return QImage();
+  }
+
+  // Rows may be padded, as given by the step
+  unsigned int step = ValidStep(_msg.pixel_format_type(), _msg.width(),
+      _msg.height(), _msg.step(), _msg.data().size());
+  if (step == 0)
+    return QImage();
+
+  return ConvertPixels(_msg.pixel_format_type(), _msg.data().data(), step,
+      static_cast<int>(_msg.width()), static_cast<int>(_msg.height()),
+      _depth);
+}
+
+/// \brief Region of interest shown at full resolution, next to an
+/// overview of the whole image
+struct RegionOfInterest
+{
+  /// \brief Maximum width of the overview
+  int overviewWidth{640};
+
+  /// \brief Size of the crop, in pixels of the image
+  QSize size{512, 512};
+
+  /// \brief Center of the crop, as a fraction of the image's size
+  QPointF center{0.5, 0.5};
+
+  /// \brief Crop of the latest image, in its pixels
+  QRect rect;
+
+  /// \brief Range of depth images, set from the overviews
+  DepthRange depth;
+
+  /// \brief Get the crop of an image.
+  /// \param[in] _size Size of the image
+  /// \param[in] _bayer True to keep the crop on whole Bayer cells
+  /// \return Crop, within the image
+  QRect Crop(const QSize &_size, bool _bayer) const
+  {
+    int w = std::min(this->size.width(), _size.width());
+    int h = std::min(this->size.height(), _size.height());
+    int x = std::clamp(static_cast<int>(std::lround(
+        this->center.x() * _size.width() - w * 0.5)), 0, _size.width() - w);
+    int y = std::clamp(static_cast<int>(std::lround(
+        this->center.y() * _size.height() - h * 0.5)), 0,
+        _size.height() - h);
+    if (_bayer)
+    {
+      x &= ~1;
+      y &= ~1;
+      w = std::max(w & ~1, std::min(_size.width(), 2));
+      h = std::max(h & ~1, std::min(_size.height(), 2));
+    }
+    return QRect(x, y, w, h);
+  }
+
+  /// \brief Get the factor the overview is reduced by.
+  /// \param[in] _width Width of the image
+  /// \return Pixels of the image per pixel of the overview, 1 for images
+  /// which fit
+  int Factor(int _width) const
+  {
+    return std::max(1, (_width + this->overviewWidth - 1) /
+        std::max(1, this->overviewWidth));
+  }
+
+  /// \brief Outline the crop on the overview.
+  /// \param[in] _factor Factor the overview is reduced by
+  /// \param[in,out] _overview Overview
+  void Outline(int _factor, QImage &_overview) const
+  {
+    QPainter painter(&_overview);
+    painter.setPen(QPen(Qt::yellow, 0));
+    painter.drawRect(QRectF(this->rect.x() / static_cast<double>(_factor),
+        this->rect.y() / static_cast<double>(_factor),
+        this->rect.width() / static_cast<double>(_factor) - 1.0,
+        this->rect.height() / static_cast<double>(_factor) - 1.0));
+  }
+};
+
+/// \brief Convert the region of interest of raw pixels at full resolution
+/// and an overview made of every few pixels. Only the pixels of the crop
+/// and of the overview are converted, however large the image is.
+/// \param[in] _msg Image message, its data is ignored
+/// \param[in] _data Pixels, from the message or from shared memory
+/// \param[in] _size Size of the pixels in bytes
+/// \param[in,out] _roi Region of interest, its rect is set
+/// \param[out] _overview Overview, with the crop outlined
+/// \param[out] _crop Crop
+/// \return False if the pixels can't be converted
+bool ConvertRoi(const gz::msgs::Image &_msg, const char *_data,
+    std::size_t _size, RegionOfInterest &_roi, QImage &_overview,
+    QImage &_crop)
+{
+  const auto format = _msg.pixel_format_type();
+  const unsigned int bytesPerPixel = BytesPerPixel(format);
+  if (bytesPerPixel == 0)
+  {
+    gzwarn << "Unsupported image type: " << format << std::endl;
+    return false;
+  }
+  const unsigned int step = ValidStep(format, _msg.width(), _msg.height(),
+      _msg.step(), _size);
+  if (step == 0 || nullptr == _data)
+    return false;
+
+  const int width = static_cast<int>(_msg.width());
+  const int height = static_cast<int>(_msg.height());
+  const bool bayer = IsBayer(format);
+
+  // The overview is converted first, so the crop uses its depth range
+  const int factor = _roi.Factor(width);
+  if (factor == 1)
+  {
+    _overview = ConvertPixels(format, _data, step, width, height, _roi.depth);
+  }
+  else
+  {
+    // Every factor-th pixel, or Bayer cell, is gathered into a buffer of
+    // the overview's size before being converted
+    const int block = bayer ? 2 : 1;
+    const int blocksX = std::max(1, width / (block * factor));
+    const int blocksY = std::max(1, height / (block * factor));
+    const int overviewWidth = blocksX * block;
+    const int overviewHeight = blocksY * block;
+    const unsigned int sampledStep = overviewWidth * bytesPerPixel;
+    std::vector<char> sampled(
+        static_cast<std::size_t>(sampledStep) * overviewHeight);
+    for (int j = 0; j < overviewHeight; ++j)
+    {
+      const int sourceY = std::min(height - 1,
+          (j / block) * block * factor + j % block);
+      const char *row = _data + static_cast<std::size_t>(sourceY) * step;
+      char *line = sampled.data() + static_cast<std::size_t>(j) * sampledStep;
+      for (int i = 0; i < overviewWidth; ++i)
+      {
+        const int sourceX = std::min(width - 1,
+            (i / block) * block * factor + i % block);
+        std::memcpy(line + i * bytesPerPixel, row + sourceX * bytesPerPixel,
+            bytesPerPixel);
+      }
+    }
+    _overview = ConvertPixels(format, sampled.data(), sampledStep,
+        overviewWidth, overviewHeight, _roi.depth);
+  }
+
+  // The crop's range isn't kept, it follows the overview's
+  _roi.rect = _roi.Crop(QSize(width, height), bayer);
+  DepthRange depth = _roi.depth;
+  _crop = ConvertPixels(format, _data +
+      static_cast<std::size_t>(_roi.rect.y()) * step +
+      static_cast<std::size_t>(_roi.rect.x()) * bytesPerPixel, step,
+      _roi.rect.width(), _roi.rect.height(), depth);
+
+  _roi.Outline(factor, _overview);
+  return true;
+}
+
+/// \brief Pixel buffers of a single size, reused by the images wrapping
+/// them once they're released
+struct PixelPool
+{
+  /// \brief Maximum number of free buffers kept
+  static constexpr std::size_t kMaxFree{4u};
+
+  /// \brief Protects everything
+  std::mutex mutex;
+
+  /// \brief Size of the buffers in the pool
+  std::size_t size{0u};
+
+  /// \brief Free buffers
+  std::vector<std::unique_ptr<uchar[]>> free;
+
+  /// \brief Take a buffer, allocating it if none is free
+  /// \param[in] _size Size of the buffer, which empties the pool if it
+  /// changed
+  /// \return Buffer
+  std::unique_ptr<uchar[]> Take(std::size_t _size)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (_size != this->size)
+    {
+      this->free.clear();
+      this->size = _size;
+    }
+    if (this->free.empty())
+      return std::make_unique<uchar[]>(_size);
+    auto buffer = std::move(this->free.back());
+    this->free.pop_back();
+    return buffer;
+  }
+
+  /// \brief Give a buffer back, it's deleted if the size changed meanwhile
+  /// or enough buffers are free
+  /// \param[in] _buffer Buffer
+  /// \param[in] _size Size of the buffer
+  void Give(std::unique_ptr<uchar[]> _buffer, std::size_t _size)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (_size == this->size && this->free.size() < kMaxFree)
+      this->free.push_back(std::move(_buffer));
+  }
+};
+
+/// \brief Buffer wrapped by an image, given back to its pool once the
+/// image's last copy is released
+struct PooledBuffer
+{
+  /// \brief Pool the buffer comes from, which may outlive the plugin
+  std::shared_ptr<PixelPool> pool;
+
+  /// \brief Buffer
+  std::unique_ptr<uchar[]> data;
+
+  /// \brief Size of the buffer
+  std::size_t size{0u};
+};
+
+/// \brief Cleanup function of images wrapping a pooled buffer
+/// \param[in] _info The PooledBuffer
+void ReleasePooledBuffer(void *_info)
+{
+  std::unique_ptr<PooledBuffer> buffer(static_cast<PooledBuffer *>(_info));
+  buffer->pool->Give(std::move(buffer->data), buffer->size);
+}
+
+/// \brief Copy an RGB8 image message into a pooled buffer, wrapped by an
+/// image which can be uploaded as is. This is the only copy the pixels go
+/// through before the GPU.
+/// \param[in] _msg Image message, its data is ignored
+/// \param[in] _data Pixels, from the message or from shared memory
+/// \param[in] _size Size of the pixels in bytes
+/// \param[in] _pool Pool of buffers
+/// \return The image, null if the data is smaller than its size
+QImage WrapRGB8(const gz::msgs::Image &_msg, const char *_data,
+    std::size_t _size, const std::shared_ptr<PixelPool> &_pool)
+{
+  const unsigned int width = _msg.width();
+  const unsigned int height = _msg.height();
+  const unsigned int rowBytes = 3 * width;
+  const unsigned int step = std::max(_msg.step(), rowBytes);
+  if (height == 0 || width == 0 || nullptr == _data ||
+      _size < static_cast<std::size_t>(step) * (height - 1) + rowBytes)
+  {
+    gzwarn << "Image data is smaller than its size [" << width << " x "
+           << height << "]" << std::endl;
+    return QImage();
+  }
+
+  // QImage needs rows aligned to 4 bytes
+  const unsigned int bytesPerLine = (rowBytes + 3u) & ~3u;
+  auto buffer = std::make_unique<PooledBuffer>();
+  buffer->pool = _pool;
+  buffer->size = static_cast<std::size_t>(bytesPerLine) * height;
+  buffer->data = _pool->Take(buffer->size);
+
+  const char *data = _data;
+  if (step == bytesPerLine)
+  {
+    std::memcpy(buffer->data.get(), data,
+        static_cast<std::size_t>(step) * (height - 1) + rowBytes);
+  }
+  else
+  {
+    for (unsigned int j = 0; j < height; ++j)
+    {
+      std::memcpy(buffer->data.get() + j * bytesPerLine, data + j * step,
+          rowBytes);
+    }
+  }
+
+  uchar *pixels = buffer->data.get();
+  return QImage(pixels, static_cast<int>(width), static_cast<int>(height),
+      static_cast<int>(bytesPerLine), QImage::Format_RGB888,
+      &ReleasePooledBuffer, buffer.release());
+}
+
+/// \brief Get the format of a compressed image message, from its header.
+/// \param[in] _msg Image message
+/// \return Format as known by QImageReader, e.g. "jpeg", or empty if the
+/// image isn't compressed
+QByteArray CompressedFormat(const gz::msgs::Image &_msg)
+{
+  if (!_msg.has_header())
+    return QByteArray();
+
+  for (const auto &data : _msg.header().data())
+  {
+    if (data.key() != "format" || data.value_size() == 0)
+      continue;
+
+    QByteArray format = QByteArray::fromStdString(data.value(0)).toLower();
+    if (format == "jpg")
+      format = "jpeg";
+    return format;
+  }
+  return QByteArray();
+}
+
+/// \brief Topic of a mosaic, drawn into its own tile
+struct MosaicStream
+{
+  /// \brief Topic name
+  std::string topic;
+
+  /// \brief Minimum time between converted images, zero for no limit
+  std::chrono::steady_clock::duration minPeriod{0};
+
+  /// \brief Time the last image was taken for conversion
+  std::chrono::steady_clock::time_point lastAccepted;
+
+  /// \brief Latest image, waiting to be drawn
+  gz::msgs::Image pending;
+
+  /// \brief True if pending holds an image
+  bool hasPending{false};
+
+  /// \brief True while a task is drawing the tile, so the tile's images
+  /// are drawn one at a time
+  bool drawing{false};
+
+  /// \brief Range of the tile's depth images, only used by the task
+  /// drawing it
+  DepthRange depth;
+};
+}
 
 namespace gz
 {
 namespace gui
 {
-namespace plugins
+namespace plugins
+{
+  class ImageDisplayPrivate
+  {
+    /// \brief List of topics publishing image messages.
+    public: QStringList topicList;
+
+    /// \brief Holds data to set as the next image
+    public: msgs::Image imageMsg;
+
+    /// \brief True if imageMsg or decodedImage holds an image which hasn't
+    /// been displayed yet
+    public: bool hasImage{false};
+
+    /// \brief True if the image to display next is decodedImage, false if
+    /// it's imageMsg
+    public: bool hasDecoded{false};
+
+    /// \brief Latest decoded compressed image, or RGB8 image wrapping a
+    /// pooled buffer. The overview, with a region of interest.
+    public: QImage decodedImage;
+
+    /// \brief Crop of decodedImage's image, with a region of interest
+    public: QImage decodedCrop;
+
+    /// \brief Buffers of the RGB8 images, shared with the images so they
+    /// can outlive the plugin
+    public: std::shared_ptr<PixelPool> pixelPool =
+        std::make_shared<PixelPool>();
+
+    /// \brief Sequence number of the latest decoded compressed image, to
+    /// drop images decoded after a newer one
+    public: uint64_t decodedSeq{0};
+
+    /// \brief Latest compressed image, waiting for a decoder
+    public: msgs::Image compressedMsg;
+
+    /// \brief True if compressedMsg hasn't been taken by a decoder yet
+    public: bool hasCompressed{false};
+
+    /// \brief Sequence number of compressedMsg
+    public: uint64_t compressedSeq{0};
+
+    /// \brief Notifies decoders of a new compressed image, or to stop
+    public: std::condition_variable_any decodeCv;
+
+    /// \brief True to stop the decoders
+    public: bool stopDecoders{false};
+
+    /// \brief Threads decoding compressed images
+    public: std::vector<std::thread> decoders;
+
+    /// \brief True while a call to ProcessImage is queued or scheduled, so
+    /// that at most one is waiting at any time
+    public: std::atomic<bool> processPending{false};
+
+    /// \brief Number of images replaced by a newer one before being
+    /// displayed
+    public: std::atomic<int> droppedFrames{0};
+
+    /// \brief Number of dropped frames last notified to QML
+    public: int droppedFramesShown{0};
+
+    /// \brief Minimum time between displayed images, zero for no limit
+    public: std::chrono::steady_clock::duration minPeriod{0};
+
+    /// \brief Time the last image was displayed
+    public: std::chrono::steady_clock::time_point lastDisplay;
+
+    /// \brief Node for communication.
+    public: transport::Node node;
+
+    /// \brief Mutex for accessing image data
+    public: std::recursive_mutex imageMutex;
+
+    /// \brief Provides the latest image to QML through an image URL.
+    public: ImageProvider *provider{nullptr};
+
+    /// \brief Item displaying the latest image.
+    public: ImageItem *item{nullptr};
+
+    /// \brief Whether to try shared memory before subscribing
+    public: bool sharedMemory{false};
+
+    /// \brief Whether shared memory with the wrong type was reported
+    public: std::atomic<bool> shmWrongType{false};
+
+    /// \brief Bytes of the image displayed
+    public: uint64_t displayedBytes{0u};
+
+    /// \brief Reports the frames held to QueueStats. The newest frame
+    /// always replaces the pending one, so it has no limit.
+    public: QueueStats::Queue frameQueue{"ImageDisplay/frames", false};
+
+    /// \brief Report the displayed and pending frames to frameQueue. Must
+    /// be called with imageMutex locked.
+    public: void ReportFrames()
+    {
+      uint64_t depth{0u};
+      uint64_t bytes{0u};
+      if (this->displayedBytes > 0u)
+      {
+        ++depth;
+        bytes += this->displayedBytes;
+      }
+      if (this->hasImage)
+      {
+        ++depth;
+        bytes += this->hasDecoded ?
+            static_cast<uint64_t>(this->decodedImage.bytesPerLine()) *
+            static_cast<uint64_t>(this->decodedImage.height()) +
+            static_cast<uint64_t>(this->decodedCrop.bytesPerLine()) *
+            static_cast<uint64_t>(this->decodedCrop.height()) :
+            this->imageMsg.data().size();
+      }
+      if (this->hasCompressed)
+      {
+        ++depth;
+        bytes += this->compressedMsg.data().size();
+      }
+      this->frameQueue.Update(depth, bytes);
+    }
+
+    /// \brief Range of depth images of the topic, only used by the GUI
+    /// thread
+    public: DepthRange depth;
+
+    /// \brief Topics of the mosaic, empty if it's not a mosaic. Fixed once
+    /// loaded.
+    public: std::vector<MosaicStream> mosaic;
+
+    /// \brief Size of each tile of the mosaic
+    public: QSize tileSize{320, 240};
+
+    /// \brief Number of tiles per row of the mosaic
+    public: int columns{1};
+
+    /// \brief Protects the mosaic's streams and image
+    public: std::mutex mosaicMutex;
+
+    /// \brief All the tiles. Shared with the GUI until a tile is drawn,
+    /// which copies it on the worker instead of the GUI thread.
+    public: QImage atlas;
+
+    /// \brief True if a tile was drawn since the mosaic was displayed
+    public: bool atlasDirty{false};
+
+    /// \brief True once the plugin is being destroyed
+    public: bool stopMosaic{false};
+
+    /// \brief True to show an overview and a full resolution crop
+    /// instead of the whole image. Fixed once loaded.
+    public: bool roiEnabled{false};
+
+    /// \brief Region of interest
+    public: RegionOfInterest roi;
+
+    /// \brief Protects roi, images are converted by the thread receiving
+    /// them
+    public: std::mutex roiMutex;
+
+    /// \brief Provides the latest crop, with a region of interest
+    public: ImageProvider *cropProvider{nullptr};
+
+    /// \brief Item displaying the latest crop
+    public: ImageItem *cropItem{nullptr};
+
+    /// \brief Receives the images through shared memory. Last, so its
+    /// callbacks stop before the rest is destroyed.
+    public: SharedMemorySubscriber shm;
+  };
+}
+}
+}
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+ImageItem::ImageItem(QQuickItem *_parent)
+  : QQuickItem(_parent)
+{
+  this->setFlag(ItemHasContents, true);
+}
+
+/////////////////////////////////////////////////
+void ImageItem::SetImage(const QImage &_image)
+{
+  this->img = _image;
+  this->imgDirty = true;
+  this->update();
+}
+
+/////////////////////////////////////////////////
+QSGNode *ImageItem::updatePaintNode(QSGNode *_oldNode,
+    QQuickItem::UpdatePaintNodeData * /*_data*/)
 {
-  class ImageDisplayPrivate
+  // The GUI thread is blocked while this runs, so the image can be read
+  // without locking
+  auto node = static_cast<QSGSimpleTextureNode *>(_oldNode);
+  if (this->img.isNull() || nullptr == this->window())
   {
-    /// \brief List of topics publishing image messages.
-    public: QStringList topicList;
+    delete node;
+    return nullptr;
+  }
 
-    /// \brief Holds data to set as the next image
-    public: msgs::Image imageMsg;
+  if (nullptr == node)
+  {
+    node = new QSGSimpleTextureNode();
+    node->setOwnsTexture(true);
+    this->imgDirty = true;
+  }
 
-    /// \brief Node for communication.
-    public: transport::Node node;
+  // Not smooth to see the image's pixels when zoomed in
+  node->setFiltering(this->smooth() ? QSGTexture::Linear :
+      QSGTexture::Nearest);
 
-    /// \brief Mutex for accessing image data
-    public: std::recursive_mutex imageMutex;
+  // Replacing the texture deletes the previous one
+  if (this->imgDirty)
+  {
+    node->setTexture(this->window()->createTextureFromImage(this->img));
+    this->imgDirty = false;
+  }
 
-    /// \brief To provide images for QML.
-    public: ImageProvider *provider{nullptr};
-  };
-}
+  QSizeF size = this->img.size();
+  size.scale(this->width(), this->height(), Qt::KeepAspectRatio);
+  node->setRect(QRectF((this->width() - size.width()) * 0.5, 0,
+      size.width(), size.height()));
+
+  return node;
 }
+
+/////////////////////////////////////////////////
+QPointF ImageItem::MapToImage(qreal _x, qreal _y) const
+{
+  if (this->img.isNull())
+    return QPointF(-1, -1);
+
+  QSizeF size = this->img.size();
+  size.scale(this->width(), this->height(), Qt::KeepAspectRatio);
+  if (size.isEmpty())
+    return QPointF(-1, -1);
+
+  QPointF point((_x - (this->width() - size.width()) * 0.5) / size.width(),
+      _y / size.height());
+  if (point.x() < 0.0 || point.x() > 1.0 || point.y() < 0.0 ||
+      point.y() > 1.0)
+  {
+    return QPointF(-1, -1);
+  }
+  return point;
 }
 
-using namespace gz;
-using namespace gui;
-using namespace plugins;
+/////////////////////////////////////////////////
+void ImageItem::geometryChanged(const QRectF &_newGeometry,
+    const QRectF &_oldGeometry)
+{
+  QQuickItem::geometryChanged(_newGeometry, _oldGeometry);
+  this->update();
+}
 
 /////////////////////////////////////////////////
 ImageDisplay::ImageDisplay()
   : Plugin(), dataPtr(new ImageDisplayPrivate)
 {
+  qmlRegisterType<ImageItem>("ImageItem", 1, 0, "ImageItem");
 }
 
 /////////////////////////////////////////////////
 ImageDisplay::~ImageDisplay()
 {
+  this->dataPtr->shm.Unsubscribe();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mosaicMutex);
+    this->dataPtr->stopMosaic = true;
+  }
+  for (const auto &stream : this->dataPtr->mosaic)
+    this->dataPtr->node.Unsubscribe(stream.topic);
+  WorkerPool::Cancel(this);
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->imageMutex);
+    this->dataPtr->stopDecoders = true;
+  }
+  this->dataPtr->decodeCv.notify_all();
+  for (auto &decoder : this->dataPtr->decoders)
+    decoder.join();
+
   App()->Engine()->removeImageProvider(
       this->CardItem()->objectName() + "imagedisplay");
+  if (nullptr != this->dataPtr->cropProvider)
+  {
+    App()->Engine()->removeImageProvider(
+        this->CardItem()->objectName() + "imagedisplayroi");
+  }
 }
 
 /////////////////////////////////////////////////
@@ -86,6 +1170,7 @@ void ImageDisplay::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 
   std::string topic;
   bool topicPicker = true;
+  unsigned int decodeThreads{2};
 
   // Read configuration
   if (_pluginElem)
@@ -95,112 +1180,609 @@ void ImageDisplay::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 
     if (auto pickerElem = _pluginElem->FirstChildElement("topic_picker"))
       pickerElem->QueryBoolText(&topicPicker);
+
+    if (auto rateElem = _pluginElem->FirstChildElement("max_rate"))
+    {
+      double rate{0.0};
+      rateElem->QueryDoubleText(&rate);
+      if (rate > 0.0)
+      {
+        this->dataPtr->minPeriod =
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / rate));
+      }
+    }
+
+    if (auto threadsElem = _pluginElem->FirstChildElement("decode_threads"))
+      threadsElem->QueryUnsignedText(&decodeThreads);
+
+    if (auto shmElem = _pluginElem->FirstChildElement("shared_memory"))
+      shmElem->QueryBoolText(&this->dataPtr->sharedMemory);
+
+    if (auto depthElem = _pluginElem->FirstChildElement("depth"))
+    {
+      auto &depth = this->dataPtr->depth;
+      auto bound = [](const tinyxml2::XMLElement *_elem, float &_value,
+          bool &_auto)
+      {
+        if (nullptr == _elem || nullptr == _elem->GetText())
+          return;
+        _auto = std::string(_elem->GetText()) == "auto";
+        if (!_auto && _elem->QueryFloatText(&_value) != tinyxml2::XML_SUCCESS)
+        {
+          gzerr << "Invalid depth <" << _elem->Name() << "> ["
+                << _elem->GetText() << "], expected a number or [auto]"
+                << std::endl;
+        }
+      };
+      bound(depthElem->FirstChildElement("min"), depth.min, depth.autoMin);
+      bound(depthElem->FirstChildElement("max"), depth.max, depth.autoMax);
+
+      double percentile{depth.lowPercentile * 100.0};
+      if (auto lowElem = depthElem->FirstChildElement("low_percentile"))
+        lowElem->QueryDoubleText(&percentile);
+      depth.lowPercentile = std::clamp(percentile, 0.0, 100.0) / 100.0;
+      percentile = depth.highPercentile * 100.0;
+      if (auto highElem = depthElem->FirstChildElement("high_percentile"))
+        highElem->QueryDoubleText(&percentile);
+      depth.highPercentile = std::clamp(percentile, 0.0, 100.0) / 100.0;
+      if (depth.highPercentile < depth.lowPercentile)
+        std::swap(depth.lowPercentile, depth.highPercentile);
+
+      if (auto smoothingElem = depthElem->FirstChildElement("smoothing"))
+        smoothingElem->QueryDoubleText(&depth.smoothing);
+      depth.smoothing = std::clamp(depth.smoothing, 0.0, 1.0);
+    }
+
+    if (auto mosaicElem = _pluginElem->FirstChildElement("mosaic"))
+    {
+      for (auto topicElem = mosaicElem->FirstChildElement("topic");
+           nullptr != topicElem;
+           topicElem = topicElem->NextSiblingElement("topic"))
+      {
+        if (nullptr == topicElem->GetText())
+          continue;
+
+        MosaicStream stream;
+        stream.topic = topicElem->GetText();
+        stream.depth = this->dataPtr->depth;
+        double rate{0.0};
+        topicElem->QueryDoubleAttribute("max_rate", &rate);
+        if (rate > 0.0)
+        {
+          stream.minPeriod =
+              std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<double>(1.0 / rate));
+        }
+        this->dataPtr->mosaic.push_back(std::move(stream));
+      }
+
+      auto count = static_cast<int>(this->dataPtr->mosaic.size());
+      int columns = static_cast<int>(std::ceil(std::sqrt(count)));
+      if (auto columnsElem = mosaicElem->FirstChildElement("columns"))
+        columnsElem->QueryIntText(&columns);
+      this->dataPtr->columns = std::clamp(columns, 1, std::max(1, count));
+
+      int width = this->dataPtr->tileSize.width();
+      int height = this->dataPtr->tileSize.height();
+      if (auto widthElem = mosaicElem->FirstChildElement("tile_width"))
+        widthElem->QueryIntText(&width);
+      if (auto heightElem = mosaicElem->FirstChildElement("tile_height"))
+        heightElem->QueryIntText(&height);
+      this->dataPtr->tileSize = QSize(std::max(1, width), std::max(1, height));
+    }
+
+    if (auto roiElem = _pluginElem->FirstChildElement("roi"))
+    {
+      auto &roi = this->dataPtr->roi;
+      int width = roi.size.width();
+      int height = roi.size.height();
+      if (auto widthElem = roiElem->FirstChildElement("width"))
+        widthElem->QueryIntText(&width);
+      if (auto heightElem = roiElem->FirstChildElement("height"))
+        heightElem->QueryIntText(&height);
+      roi.size = QSize(std::max(1, width), std::max(1, height));
+      if (auto overviewElem = roiElem->FirstChildElement("overview_width"))
+        overviewElem->QueryIntText(&roi.overviewWidth);
+      roi.overviewWidth = std::max(1, roi.overviewWidth);
+      roi.depth = this->dataPtr->depth;
+
+      if (this->dataPtr->mosaic.empty())
+        this->dataPtr->roiEnabled = true;
+      else
+        gzwarn << "A <roi> can't be shown in a <mosaic>" << std::endl;
+    }
   }
 
-  if (topic.empty() && !topicPicker)
+  if (!this->dataPtr->mosaic.empty())
   {
-    gzwarn << "Can't hide topic picker without a default topic." << std::endl;
-    topicPicker = true;
+    this->PluginItem()->setProperty("showPicker", false);
+
+    // Tiles start black, until their first image
+    const auto &tile = this->dataPtr->tileSize;
+    int count = static_cast<int>(this->dataPtr->mosaic.size());
+    int rows = (count + this->dataPtr->columns - 1) / this->dataPtr->columns;
+    this->dataPtr->atlas = QImage(tile.width() * this->dataPtr->columns,
+        tile.height() * rows, QImage::Format_RGB888);
+    this->dataPtr->atlas.fill(Qt::black);
+    this->dataPtr->atlasDirty = true;
+
+    for (std::size_t i = 0; i < this->dataPtr->mosaic.size(); ++i)
+    {
+      const auto &topic = this->dataPtr->mosaic[i].topic;
+      std::function<void(const msgs::Image &)> cb =
+          [this, i](const msgs::Image &_msg)
+          {
+            this->OnMosaicImage(i, _msg);
+          };
+      if (!this->dataPtr->node.Subscribe(topic, cb,
+          this->SubscribeOptions(topic)))
+      {
+        gzerr << "Unable to subscribe to topic [" << topic << "]" << std::endl;
+      }
+    }
   }
 
-  this->PluginItem()->setProperty("showPicker", topicPicker);
+  // Images of a mosaic are decoded on the WorkerPool instead
+  if (this->dataPtr->mosaic.empty())
+  {
+    for (unsigned int i = 0; i < std::max(1u, decodeThreads); ++i)
+      this->dataPtr->decoders.emplace_back(&ImageDisplay::DecodeImages, this);
+  }
 
-  if (!topic.empty())
-    this->OnTopic(QString::fromStdString(topic));
-  else
-    this->OnRefresh();
+  if (this->dataPtr->mosaic.empty())
+  {
+    if (topic.empty() && !topicPicker)
+    {
+      gzwarn << "Can't hide topic picker without a default topic."
+             << std::endl;
+      topicPicker = true;
+    }
+
+    this->PluginItem()->setProperty("showPicker", topicPicker);
+
+    if (!topic.empty())
+      this->OnTopic(QString::fromStdString(topic));
+    else
+      this->OnRefresh();
+  }
 
   this->dataPtr->provider = new ImageProvider();
   App()->Engine()->addImageProvider(
       this->CardItem()->objectName() + "imagedisplay", this->dataPtr->provider);
+
+  this->dataPtr->item = this->PluginItem()->findChild<ImageItem *>(
+      "imageItem");
+  if (nullptr == this->dataPtr->item)
+    gzerr << "Failed to find image item, images won't be shown." << std::endl;
+
+  if (this->dataPtr->roiEnabled)
+  {
+    this->dataPtr->cropProvider = new ImageProvider();
+    App()->Engine()->addImageProvider(
+        this->CardItem()->objectName() + "imagedisplayroi",
+        this->dataPtr->cropProvider);
+    this->dataPtr->cropItem = this->PluginItem()->findChild<ImageItem *>(
+        "roiItem");
+    this->PluginItem()->setProperty("showRoi", true);
+  }
 }
 
 /////////////////////////////////////////////////
 void ImageDisplay::ProcessImage()
 {
+  // Wait until the display rate allows another image. Images received
+  // meanwhile replace the pending one.
+  auto now = std::chrono::steady_clock::now();
+  auto next = this->dataPtr->lastDisplay + this->dataPtr->minPeriod;
+  if (now < next)
+  {
+    auto wait =
+        std::chrono::duration_cast<std::chrono::milliseconds>(next - now);
+    QTimer::singleShot(std::max(1, static_cast<int>(wait.count())), this,
+        &ImageDisplay::ProcessImage);
+    return;
+  }
+
+  // Take the latest image, so the callback can store the next one while
+  // this one is converted
+  msgs::Image msg;
+  QImage image;
+  QImage crop;
+  bool decoded{false};
+  if (!this->dataPtr->mosaic.empty())
+  {
+    // All the tiles are shown at once
+    std::lock_guard<std::mutex> lock(this->dataPtr->mosaicMutex);
+    this->dataPtr->processPending = false;
+    if (!this->dataPtr->atlasDirty)
+      return;
+    this->dataPtr->atlasDirty = false;
+    image = this->dataPtr->atlas;
+    decoded = true;
+  }
+  else
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->imageMutex);
+    this->dataPtr->processPending = false;
+    if (!this->dataPtr->hasImage)
+      return;
+    decoded = this->dataPtr->hasDecoded;
+    if (decoded)
+    {
+      image.swap(this->dataPtr->decodedImage);
+      crop.swap(this->dataPtr->decodedCrop);
+    }
+    else
+      msg.Swap(&this->dataPtr->imageMsg);
+    this->dataPtr->hasImage = false;
+  }
+  this->dataPtr->lastDisplay = now;
+
+  int dropped = this->dataPtr->droppedFrames;
+  if (dropped != this->dataPtr->droppedFramesShown)
+  {
+    this->dataPtr->droppedFramesShown = dropped;
+    this->DroppedFramesChanged();
+  }
+
+  if (!decoded)
+    image = ConvertImage(msg, this->dataPtr->depth);
+  if (image.isNull())
+    return;
+
+  // The image shares its data with the provider and item, it's only
+  // uploaded once by the item
+  this->dataPtr->provider->SetImage(image);
+  if (nullptr != this->dataPtr->item)
+    this->dataPtr->item->SetImage(image);
+  if (!crop.isNull() && nullptr != this->dataPtr->cropProvider)
+  {
+    this->dataPtr->cropProvider->SetImage(crop);
+    if (nullptr != this->dataPtr->cropItem)
+      this->dataPtr->cropItem->SetImage(crop);
+  }
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->imageMutex);
+    this->dataPtr->displayedBytes =
+        static_cast<uint64_t>(image.bytesPerLine()) *
+        static_cast<uint64_t>(image.height()) +
+        static_cast<uint64_t>(crop.bytesPerLine()) *
+        static_cast<uint64_t>(crop.height());
+    this->dataPtr->ReportFrames();
+  }
+  this->newImage();
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::OnImageMsg(const msgs::Image &_msg)
+{
+  // Only the region of interest and the overview are converted
+  if (this->dataPtr->roiEnabled && CompressedFormat(_msg).isEmpty())
+  {
+    QImage overview;
+    QImage crop;
+    bool converted{false};
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->roiMutex);
+      converted = ConvertRoi(_msg, _msg.data().data(), _msg.data().size(),
+          this->dataPtr->roi, overview, crop);
+    }
+    if (converted)
+      this->ShowRaw(overview, crop);
+    return;
+  }
+
+  // RGB8 images are copied straight into a buffer the GUI can upload,
+  // rather than into a message which would be converted again. That's done
+  // before locking, so the GUI isn't held up by the copy.
+  bool raw = _msg.pixel_format_type() == msgs::PixelFormatType::RGB_INT8 &&
+      CompressedFormat(_msg).isEmpty();
+  if (raw)
+  {
+    QImage image = WrapRGB8(_msg, _msg.data().data(), _msg.data().size(),
+        this->dataPtr->pixelPool);
+    if (!image.isNull())
+      this->ShowRaw(image);
+    return;
+  }
+
   std::lock_guard<std::recursive_mutex> lock(this->dataPtr->imageMutex);
 
-  unsigned int height = this->dataPtr->imageMsg.height();
-  unsigned int width = this->dataPtr->imageMsg.width();
-  QImage::Format qFormat = QImage::Format_RGB888;
+  // Compressed images are decoded by the decoder threads, which then
+  // show them like raw images
+  if (!CompressedFormat(_msg).isEmpty())
+  {
+    if (this->dataPtr->hasCompressed)
+      ++this->dataPtr->droppedFrames;
+    this->dataPtr->compressedMsg = _msg;
+    this->dataPtr->hasCompressed = true;
+    ++this->dataPtr->compressedSeq;
+    this->dataPtr->ReportFrames();
+    this->dataPtr->decodeCv.notify_one();
+    return;
+  }
+
+  // The newest image wins over one which wasn't displayed yet
+  if (this->dataPtr->hasImage)
+    ++this->dataPtr->droppedFrames;
+  this->dataPtr->imageMsg = _msg;
+  this->dataPtr->hasImage = true;
+  this->dataPtr->hasDecoded = false;
+  this->dataPtr->ReportFrames();
 
-  QImage image = QImage(width, height, qFormat);
+  // Signal to main thread that the image changed, unless it's already
+  // going to process the latest image
+  if (!this->dataPtr->processPending.exchange(true))
+    QMetaObject::invokeMethod(this, "ProcessImage", Qt::QueuedConnection);
+}
 
-  common::Image output;
-  switch (this->dataPtr->imageMsg.pixel_format_type())
+/////////////////////////////////////////////////
+void ImageDisplay::ShowRaw(QImage &_image, QImage _crop)
+{
   {
-    case msgs::PixelFormatType::RGB_INT8:
-      // copy image data buffer directly to QImage
-      image = QImage(reinterpret_cast<const uchar *>(
-          this->dataPtr->imageMsg.data().c_str()), width, height, qFormat);
-      break;
-    // for other cases, convert to RGB common::Image
-    case msgs::PixelFormatType::R_FLOAT32:
-      // specify custom min max and also flip the pixel values
-      // i.e. darker pixels = higher values and brighter pixels = lower values
-      common::Image::ConvertToRGBImage<float>(
-          this->dataPtr->imageMsg.data().c_str(), width, height, output,
-          0.0f, std::numeric_limits<float>::lowest(), true);
-      break;
-    case msgs::PixelFormatType::L_INT16:
-      common::Image::ConvertToRGBImage<uint16_t>(
-          this->dataPtr->imageMsg.data().c_str(), width, height, output);
-       break;
-    case msgs::PixelFormatType::L_INT8:
-      common::Image::ConvertToRGBImage<uint8_t>(
-          this->dataPtr->imageMsg.data().c_str(), width, height, output);
-      break;
-    case msgs::PixelFormatType::BAYER_RGGB8:
-    case msgs::PixelFormatType::BAYER_BGGR8:
-    case msgs::PixelFormatType::BAYER_GBRG8:
-    case msgs::PixelFormatType::BAYER_GRBG8:
-      common::Image::ConvertToRGBImage<uint8_t>(
-          this->dataPtr->imageMsg.data().c_str(), width, height, output);
-      break;
-    default:
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->imageMutex);
+    if (this->dataPtr->hasImage)
+      ++this->dataPtr->droppedFrames;
+    this->dataPtr->decodedImage.swap(_image);
+    this->dataPtr->decodedCrop.swap(_crop);
+    this->dataPtr->hasImage = true;
+    this->dataPtr->hasDecoded = true;
+    this->dataPtr->ReportFrames();
+  }
+
+  if (!this->dataPtr->processPending.exchange(true))
+    QMetaObject::invokeMethod(this, "ProcessImage", Qt::QueuedConnection);
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::OnMosaicImage(std::size_t _tile, const msgs::Image &_msg)
+{
+  auto now = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> lock(this->dataPtr->mosaicMutex);
+  if (this->dataPtr->stopMosaic)
+    return;
+
+  // Images beyond the topic's rate aren't converted at all
+  auto &stream = this->dataPtr->mosaic[_tile];
+  if (now < stream.lastAccepted + stream.minPeriod)
+    return;
+  stream.lastAccepted = now;
+
+  if (stream.hasPending)
+    ++this->dataPtr->droppedFrames;
+  stream.pending = _msg;
+  stream.hasPending = true;
+  if (!stream.drawing)
+  {
+    stream.drawing = true;
+    WorkerPool::Post([this, _tile]{this->DrawTile(_tile);}, this,
+        WorkerPool::Priority::kHigh);
+  }
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::DrawTile(std::size_t _tile)
+{
+  msgs::Image msg;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mosaicMutex);
+    auto &stream = this->dataPtr->mosaic[_tile];
+    msg.Swap(&stream.pending);
+    stream.hasPending = false;
+  }
+
+  QImage image;
+  QByteArray format = CompressedFormat(msg);
+  if (format.isEmpty())
+  {
+    // Only this task uses the tile's range, see MosaicStream::drawing
+    image = ConvertImage(msg, this->dataPtr->mosaic[_tile].depth);
+  }
+  else
+  {
+    QByteArray bytes = QByteArray::fromRawData(msg.data().data(),
+        static_cast<int>(msg.data().size()));
+    QBuffer buffer(&bytes);
+    QImageReader reader(&buffer, format);
+    if (!reader.read(&image))
     {
-      gzwarn << "Unsupported image type: "
-              << this->dataPtr->imageMsg.pixel_format_type() << std::endl;
-      return;
+      gzwarn << "Failed to decode [" << format.toStdString() << "] image: "
+             << reader.errorString().toStdString() << std::endl;
     }
   }
-  common::Image::PixelFormatType pixelFormat =
-      common::Image::ConvertPixelFormat(
-      msgs::ConvertPixelFormatType(
-      this->dataPtr->imageMsg.pixel_format_type()));
 
+  // Scaled into a tile of its own first, so the mosaic is only locked to
+  // copy it
+  const auto &size = this->dataPtr->tileSize;
+  QImage tile(size, QImage::Format_RGB888);
+  if (!image.isNull())
+  {
+    tile.fill(Qt::black);
+    QSize scaled = image.size().scaled(size, Qt::KeepAspectRatio);
+    QPainter painter(&tile);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    painter.drawImage(QRect(QPoint((size.width() - scaled.width()) / 2,
+        (size.height() - scaled.height()) / 2), scaled), image);
+  }
 
-  // if not rgb, copy values from common::Image to QImage
-  if (pixelFormat != common::Image::PixelFormatType::RGB_INT8)
+  bool drawn{false};
   {
-    auto data = output.Data();
+    std::lock_guard<std::mutex> lock(this->dataPtr->mosaicMutex);
+    if (this->dataPtr->stopMosaic)
+      return;
 
-    for (unsigned int j = 0; j < height; ++j)
+    if (!image.isNull())
     {
-      for (unsigned int i = 0; i < width; ++i)
+      const int x = static_cast<int>(_tile) % this->dataPtr->columns;
+      const int y = static_cast<int>(_tile) / this->dataPtr->columns;
+      for (int j = 0; j < size.height(); ++j)
       {
-        unsigned int idx = j*width*3 + i * 3;
-        int r = data[idx];
-        int g = data[idx + 1];
-        int b = data[idx + 2];
-        QRgb value = qRgb(r, g, b);
-        image.setPixel(i, j, value);
+        std::memcpy(this->dataPtr->atlas.scanLine(y * size.height() + j) +
+            3 * x * size.width(), tile.constScanLine(j), 3 * size.width());
       }
+      this->dataPtr->atlasDirty = true;
+      drawn = true;
+    }
+
+    // Images received meanwhile are drawn by another task
+    auto &stream = this->dataPtr->mosaic[_tile];
+    if (stream.hasPending)
+    {
+      WorkerPool::Post([this, _tile]{this->DrawTile(_tile);}, this,
+          WorkerPool::Priority::kHigh);
+    }
+    else
+    {
+      stream.drawing = false;
     }
   }
 
-  this->dataPtr->provider->SetImage(image);
-  this->newImage();
+  if (drawn && !this->dataPtr->processPending.exchange(true))
+    QMetaObject::invokeMethod(this, "ProcessImage", Qt::QueuedConnection);
 }
 
 /////////////////////////////////////////////////
-void ImageDisplay::OnImageMsg(const msgs::Image &_msg)
+void ImageDisplay::OnSharedImage(const SharedMemoryView &_view)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->imageMutex);
-  this->dataPtr->imageMsg = _msg;
+  // Can't unsubscribe from within the callback, so it's only reported once
+  if (_view.MsgType() != "gz.msgs.Image")
+  {
+    if (!this->dataPtr->shmWrongType.exchange(true))
+    {
+      gzerr << "Shared memory has [" << _view.MsgType() << "] messages, "
+            << "expected gz.msgs.Image" << std::endl;
+    }
+    return;
+  }
+
+  // RGB8 pixels are copied from the slot straight into the image buffer,
+  // without being parsed
+  msgs::Image msg;
+  const char *pixels{nullptr};
+  std::size_t size{0u};
+  if (!_view.ParseExcept(msgs::Image::kDataFieldNumber, msg, pixels, size))
+    return;
+
+  // Converted from the slot, like RGB8 pixels are copied
+  if (this->dataPtr->roiEnabled && CompressedFormat(msg).isEmpty())
+  {
+    QImage overview;
+    QImage crop;
+    bool converted{false};
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->roiMutex);
+      converted = ConvertRoi(msg, pixels, size, this->dataPtr->roi,
+          overview, crop);
+    }
+    if (!_view.Valid())
+    {
+      ++this->dataPtr->droppedFrames;
+      return;
+    }
+    if (converted)
+      this->ShowRaw(overview, crop);
+    return;
+  }
+
+  if (msg.pixel_format_type() == msgs::PixelFormatType::RGB_INT8 &&
+      CompressedFormat(msg).isEmpty())
+  {
+    QImage image = WrapRGB8(msg, pixels, size, this->dataPtr->pixelPool);
+
+    // The publisher overwrote the slot during the copy
+    if (!_view.Valid())
+    {
+      ++this->dataPtr->droppedFrames;
+      return;
+    }
+    if (!image.isNull())
+      this->ShowRaw(image);
+    return;
+  }
+
+  if (_view.Parse(msg))
+    this->OnImageMsg(msg);
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::DecodeImages()
+{
+  // Decoded into the same image each time, which reuses its buffer once
+  // the GUI has released the previous image
+  QImage image;
+  msgs::Image msg;
+
+  std::unique_lock<std::recursive_mutex> lock(this->dataPtr->imageMutex);
+  while (true)
+  {
+    this->dataPtr->decodeCv.wait(lock, [this]
+    {
+      return this->dataPtr->stopDecoders || this->dataPtr->hasCompressed;
+    });
+    if (this->dataPtr->stopDecoders)
+      return;
+
+    msg.Swap(&this->dataPtr->compressedMsg);
+    this->dataPtr->hasCompressed = false;
+    uint64_t seq = this->dataPtr->compressedSeq;
+    lock.unlock();
+
+    QByteArray format = CompressedFormat(msg);
+    QByteArray bytes = QByteArray::fromRawData(msg.data().data(),
+        static_cast<int>(msg.data().size()));
+    QBuffer buffer(&bytes);
+    QImageReader reader(&buffer, format);
+    bool ok = reader.read(&image);
+    if (!ok)
+    {
+      gzwarn << "Failed to decode [" << format.toStdString() << "] image: "
+             << reader.errorString().toStdString() << std::endl;
+    }
+
+    // The whole image is decoded, but only the crop and the overview are
+    // handed to the GUI
+    QImage overview;
+    QImage crop;
+    if (ok && this->dataPtr->roiEnabled)
+    {
+      std::lock_guard<std::mutex> roiLock(this->dataPtr->roiMutex);
+      auto &roi = this->dataPtr->roi;
+      roi.rect = roi.Crop(image.size(), false);
+      crop = image.copy(roi.rect);
+      const int factor = roi.Factor(image.width());
+      overview = factor == 1 ? image.copy() :
+          image.scaled(std::max(1, image.width() / factor),
+          std::max(1, image.height() / factor), Qt::IgnoreAspectRatio,
+          Qt::FastTransformation);
+      roi.Outline(factor, overview);
+    }
+
+    lock.lock();
+
+    // Another decoder may have finished a newer image first
+    if (!ok || seq <= this->dataPtr->decodedSeq)
+      continue;
+
+    if (this->dataPtr->hasImage)
+      ++this->dataPtr->droppedFrames;
+    if (this->dataPtr->roiEnabled)
+    {
+      this->dataPtr->decodedImage = overview;
+      this->dataPtr->decodedCrop = crop;
+    }
+    else
+    {
+      this->dataPtr->decodedImage = image;
+    }
+    this->dataPtr->decodedSeq = seq;
+    this->dataPtr->hasImage = true;
+    this->dataPtr->hasDecoded = true;
+    this->dataPtr->ReportFrames();
 
-  // Signal to main thread that the image changed
-  QMetaObject::invokeMethod(this, "ProcessImage");
+    if (!this->dataPtr->processPending.exchange(true))
+      QMetaObject::invokeMethod(this, "ProcessImage", Qt::QueuedConnection);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -218,10 +1800,39 @@ void ImageDisplay::OnTopic(const QString _topic)
   auto subs = this->dataPtr->node.SubscribedTopics();
   for (auto sub : subs)
     this->dataPtr->node.Unsubscribe(sub);
+  this->dataPtr->shm.Unsubscribe();
+  this->dataPtr->shmWrongType = false;
+
+  this->dataPtr->droppedFrames = 0;
+  if (this->dataPtr->droppedFramesShown != 0)
+  {
+    this->dataPtr->droppedFramesShown = 0;
+    this->DroppedFramesChanged();
+  }
+
+  // The new topic's depth may be in a different range
+  this->dataPtr->depth.valid = false;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->roiMutex);
+    this->dataPtr->roi.depth.valid = false;
+  }
+
+  // Publishers on this host may offer the images through shared memory
+  if (this->dataPtr->sharedMemory && this->dataPtr->shm.Subscribe(topic,
+      [this](const SharedMemoryView &_view)
+      {
+        this->OnSharedImage(_view);
+      }))
+  {
+    App()->findChild<MainWindow *>()->notifyWithDuration(
+      QString::fromStdString("Subscribed to: <b>" + topic +
+      "</b> through shared memory"), 4000);
+    return;
+  }
 
   // Subscribe to new topic
   if (!this->dataPtr->node.Subscribe(topic, &ImageDisplay::OnImageMsg,
-      this))
+      this, this->SubscribeOptions(topic)))
   {
     // LCOV_EXCL_START
     gzerr << "Unable to subscribe to topic [" << topic << "]" << std::endl;
@@ -239,21 +1850,10 @@ void ImageDisplay::OnRefresh()
   this->dataPtr->topicList.clear();
 
   // Get updated list
-  std::vector<std::string> allTopics;
-  this->dataPtr->node.TopicList(allTopics);
-  for (auto topic : allTopics)
-  {
-    std::vector<transport::MessagePublisher> publishers;
-    this->dataPtr->node.TopicInfo(topic, publishers);
-    for (auto pub : publishers)
-    {
-      if (pub.MsgTypeName() == "gz.msgs.Image")
-      {
-        this->dataPtr->topicList.push_back(QString::fromStdString(topic));
-        break;
-      }
-    }
-  }
+  auto discovery = TopicDiscovery::Instance();
+  discovery->Refresh();
+  for (const auto &topic : discovery->Topics("gz.msgs.Image"))
+    this->dataPtr->topicList.push_back(QString::fromStdString(topic));
 
   // Select first one
   if (this->dataPtr->topicList.count() > 0)
@@ -261,6 +1861,27 @@ void ImageDisplay::OnRefresh()
   this->TopicListChanged();
 }
 
+/////////////////////////////////////////////////
+QRect ImageDisplay::Roi() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->roiMutex);
+  return this->dataPtr->roi.rect;
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::SetRoiCenter(double _x, double _y)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->roiMutex);
+  this->dataPtr->roi.center = QPointF(std::clamp(_x, 0.0, 1.0),
+      std::clamp(_y, 0.0, 1.0));
+}
+
+/////////////////////////////////////////////////
+int ImageDisplay::DroppedFrames() const
+{
+  return this->dataPtr->droppedFramesShown;
+}
+
 /////////////////////////////////////////////////
 QStringList ImageDisplay::TopicList() const
 {
@@ -275,5 +1896,4 @@ void ImageDisplay::SetTopicList(const QStringList &_topicList)
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(ImageDisplay,
-              gui::Plugin)
+GZ_GUI_ADD_PLUGIN(ImageDisplay, "ImageDisplay")
@@ -19,6 +19,7 @@
 #define GZ_GUI_PLUGINS_IMAGEDISPLAY_HH_
 
 #include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <QQuickImageProvider>
 
@@ -40,6 +41,8 @@ namespace gz
 {
 namespace gui
 {
+class SharedMemoryView;
+
 namespace plugins
 {
   class ImageDisplayPrivate;
@@ -75,6 +78,45 @@ namespace plugins
     private: QImage img;
   };
 
+  /// \brief Item which draws an image as a scene graph texture. The image
+  /// is uploaded once when it changes, instead of being requested from an
+  /// image provider and decoded again by QML. It keeps its aspect ratio
+  /// and is aligned to the top of the item.
+  class ImageDisplay_EXPORTS_API ImageItem : public QQuickItem
+  {
+    Q_OBJECT
+
+    /// \brief Constructor
+    /// \param[in] _parent Parent item
+    public: explicit ImageItem(QQuickItem *_parent = nullptr);
+
+    /// \brief Set the image to display. Must be called from the GUI
+    /// thread.
+    /// \param[in] _image New image
+    public: void SetImage(const QImage &_image);
+
+    /// \brief Get the position of a point of the item in the image.
+    /// \param[in] _x X coordinate in the item
+    /// \param[in] _y Y coordinate in the item
+    /// \return Position as a fraction of the image's size, (-1, -1) if the
+    /// point is outside the image
+    public: Q_INVOKABLE QPointF MapToImage(qreal _x, qreal _y) const;
+
+    // Documentation inherited
+    protected: QSGNode *updatePaintNode(QSGNode *_oldNode,
+        QQuickItem::UpdatePaintNodeData *_data) override;
+
+    // Documentation inherited
+    protected: void geometryChanged(const QRectF &_newGeometry,
+        const QRectF &_oldGeometry) override;
+
+    /// \brief Image to display
+    private: QImage img;
+
+    /// \brief True if the image changed since it was last uploaded
+    private: bool imgDirty{false};
+  };
+
   /// \brief Display images coming through a Gazebo Transport topic.
   ///
   /// ## Configuration
@@ -82,6 +124,83 @@ namespace plugins
   /// \<topic\> : Set the topic to receive image messages.
   /// \<topic_picker\> : Whether to show the topic picker, true by default. If
   ///                    this is false, a \<topic\> must be specified.
+  /// \<max_rate\> : Maximum number of images displayed per second. Images
+  ///                received faster are dropped, always keeping the newest.
+  ///                No limit by default.
+  ///
+  /// \<decode_threads\> : Number of threads decoding compressed images,
+  ///                      2 by default.
+  ///
+  /// \<shared_memory\> : True to receive the images through shared memory
+  ///                     when their publisher is on the same host and
+  ///                     offers them with a SharedMemoryPublisher. The
+  ///                     topic's regular subscription is used otherwise.
+  ///                     False by default.
+  ///
+  /// \<depth\> : How 32 bit float images, such as depth, are shown, from
+  ///             white for near to black for far.
+  ///   * \<min\> : Depth shown as white, or `auto` for the low percentile.
+  ///               0 by default.
+  ///   * \<max\> : Depth shown as black, or `auto` for the high percentile.
+  ///               `auto` by default.
+  ///   * \<low_percentile\> : Percent of the pixels brighter than white
+  ///                          with an `auto` min, 1 by default.
+  ///   * \<high_percentile\> : Percent of the pixels darker than black with
+  ///                           an `auto` max, 99 by default.
+  ///   * \<smoothing\> : Fraction of the change of an `auto` range applied
+  ///                     per image, 1 to follow each image, 0.2 by default.
+  ///
+  /// The `auto` range is taken from a histogram filled while converting
+  /// each image, so it doesn't cost another pass over the image, and is
+  /// used for the next one. The first image is shown with its own minimum
+  /// and maximum.
+  ///
+  /// Compressed images are image messages whose header has a `format` key
+  /// with the encoding as value, e.g. `jpeg` or `png`, and whose data is
+  /// the encoded image. Any format supported by Qt's image plugins works.
+  /// They're decoded on the decoder threads and only the decoded image is
+  /// handed to the GUI thread.
+  ///
+  /// Images received while the previous one is still waiting to be
+  /// displayed replace it, so the latency stays bounded when the GUI is
+  /// slower than the camera. The replaced images are counted as dropped.
+  /// The displayed and pending images are reported to QueueStats as
+  /// `ImageDisplay/frames`.
+  ///
+  /// ## Mosaic
+  ///
+  /// \<mosaic\> : Show several topics at once, tiled into a single image
+  ///              which is uploaded and drawn once, instead of an
+  ///              ImageDisplay per topic. It holds:
+  ///   * \<topic\> : A topic to show, may be repeated. Tiles are in the
+  ///                 order of the topics, row by row. A `max_rate`
+  ///                 attribute limits the images of the topic converted
+  ///                 per second.
+  ///   * \<columns\> : Number of tiles per row. Defaults to about the
+  ///                   square root of the number of topics.
+  ///   * \<tile_width\>, \<tile_height\> : Size of each tile in pixels,
+  ///                   320 x 240 by default. Images are scaled to fit,
+  ///                   keeping their aspect ratio.
+  ///
+  /// The topic picker is hidden in a mosaic. Images are converted and
+  /// drawn into their tile on the WorkerPool, one at a time per topic,
+  /// and \<max_rate\> limits how often the whole mosaic is displayed.
+  ///
+  /// ## Region of interest
+  ///
+  /// \<roi\> : Show an overview of the image and a crop of it at full
+  ///            resolution, to inspect large images. Clicking or dragging
+  ///            on the overview moves the crop, which is outlined on it.
+  ///            It holds:
+  ///   * \<width\>, \<height\> : Size of the crop in pixels of the image,
+  ///                   512 x 512 by default.
+  ///   * \<overview_width\> : Maximum width of the overview, 640 by
+  ///                          default. It's made of every few pixels of the
+  ///                          image, or Bayer cells, without filtering.
+  ///
+  /// Raw images are converted by the thread receiving them, and only the
+  /// pixels of the crop and of the overview are converted and uploaded,
+  /// however large the image. Compressed images are still decoded whole.
   class ImageDisplay_EXPORTS_API ImageDisplay : public Plugin
   {
     Q_OBJECT
@@ -94,6 +213,13 @@ namespace plugins
       NOTIFY TopicListChanged
     )
 
+    /// \brief Number of dropped frames
+    Q_PROPERTY(
+      int droppedFrames
+      READ DroppedFrames
+      NOTIFY DroppedFramesChanged
+    )
+
     /// \brief Constructor
     public: ImageDisplay();
 
@@ -122,16 +248,59 @@ namespace plugins
     /// \brief Notify that topic list has changed
     signals: void TopicListChanged();
 
+    /// \brief Get the number of images which were replaced by a newer one
+    /// before being displayed, since the topic was chosen.
+    /// \return Number of dropped frames
+    public: Q_INVOKABLE int DroppedFrames() const;
+
+    /// \brief Notify that the number of dropped frames has changed
+    signals: void DroppedFramesChanged();
+
+    /// \brief Get the crop of the latest image, with a \<roi\>.
+    /// \return Crop in pixels of the image, empty if none was shown
+    public: Q_INVOKABLE QRect Roi() const;
+
+    /// \brief Set the center of the crop, with a \<roi\>. It's kept within
+    /// the image, and applies from the next image.
+    /// \param[in] _x Horizontal center, as a fraction of the image's width
+    /// \param[in] _y Vertical center, as a fraction of the image's height
+    public: Q_INVOKABLE void SetRoiCenter(double _x, double _y);
+
     /// \brief Notify that a new image has been received.
     signals: void newImage();
 
     /// \brief Callback in main thread when image changes
     private slots: void ProcessImage();
 
+    /// \brief Decode compressed images until the plugin is destroyed. Run
+    /// by each decoder thread.
+    private: void DecodeImages();
+
     /// \brief Subscriber callback when new image is received
     /// \param[in] _msg New image
     private: void OnImageMsg(const gz::msgs::Image &_msg);
 
+    /// \brief Shared memory callback when a new image is received
+    /// \param[in] _view Latest image, valid during the call
+    private: void OnSharedImage(const SharedMemoryView &_view);
+
+    /// \brief Hand an image which doesn't need decoding to the GUI thread
+    /// \param[in] _image Image, or overview with a region of interest,
+    /// swapped with the pending one
+    /// \param[in] _crop Crop of the image, with a region of interest
+    private: void ShowRaw(QImage &_image, QImage _crop = QImage());
+
+    /// \brief Subscriber callback of a mosaic topic
+    /// \param[in] _tile Index of the topic's tile
+    /// \param[in] _msg New image
+    private: void OnMosaicImage(std::size_t _tile,
+        const gz::msgs::Image &_msg);
+
+    /// \brief Convert the latest image of a mosaic topic and draw it into
+    /// its tile. Run on the WorkerPool.
+    /// \param[in] _tile Index of the topic's tile
+    private: void DrawTile(std::size_t _tile);
+
     /// \internal
     /// \brief Pointer to private data.
     private: std::unique_ptr<ImageDisplayPrivate> dataPtr;
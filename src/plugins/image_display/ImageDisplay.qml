@@ -18,6 +18,7 @@ import QtQuick 2.9
 import QtQuick.Controls 2.2
 import QtQuick.Controls.Material 2.1
 import QtQuick.Layouts 1.3
+import ImageItem 1.0
 
 Rectangle {
   id: "imageDisplay"
@@ -32,26 +33,13 @@ Rectangle {
   property bool showPicker: false
 
   /**
-   * Unique name for this plugin instance
+   * True to show the crop of a region of interest below the image
    */
-  property string uniqueName: ""
+  property bool showRoi: false
 
   property int tooltipDelay: 500
   property int tooltipTimeout: 1000
 
-  onParentChanged: {
-    if (undefined === parent)
-      return;
-
-    uniqueName = parent.card().objectName + "imagedisplay";
-    image.reload();
-  }
-
-  Connections {
-    target: ImageDisplay
-    onNewImage: image.reload();
-  }
-
   ColumnLayout {
     id: imageDisplayColumn
     anchors.fill: parent
@@ -88,16 +76,36 @@ Rectangle {
         ToolTip.text: qsTr("Gazebo Transport topics publishing Image messages")
       }
     }
-    Image {
+    ImageItem {
       id: image
-      fillMode: Image.PreserveAspectFit
+      objectName: "imageItem"
       Layout.fillHeight: true
       Layout.fillWidth: true
-      verticalAlignment: Image.AlignTop
-      function reload() {
-        // Force image request to C++
-        source = "image://" + uniqueName + "/" + Math.random().toString(36).substr(2, 5);
+
+      MouseArea {
+        anchors.fill: parent
+        enabled: showRoi
+        function moveRoi(x, y) {
+          var point = image.MapToImage(x, y);
+          if (point.x >= 0)
+            ImageDisplay.SetRoiCenter(point.x, point.y);
+        }
+        onPressed: moveRoi(mouse.x, mouse.y)
+        onPositionChanged: moveRoi(mouse.x, mouse.y)
       }
     }
+    ImageItem {
+      id: roiImage
+      objectName: "roiItem"
+      visible: showRoi
+      smooth: false
+      Layout.fillHeight: true
+      Layout.fillWidth: true
+    }
+    Label {
+      objectName: "droppedLabel"
+      visible: ImageDisplay.droppedFrames > 0
+      text: qsTr("Dropped frames: ") + ImageDisplay.droppedFrames
+    }
   }
 }
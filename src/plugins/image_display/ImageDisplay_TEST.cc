@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
+#include <vector>
+
 #include <gz/msgs/stringmsg.pb.h>
 
 #include <gz/common/Console.hh>
@@ -307,6 +310,50 @@ TEST(ImageDisplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(ReceiveImage))
     }
   }
 
+  // Rows which aren't 4 byte aligned, padded in the message
+  {
+    msgs::Image msg;
+    msg.set_height(10);
+    msg.set_width(101);
+    msg.set_pixel_format_type(msgs::PixelFormatType::RGB_INT8);
+    msg.set_step(msg.width() * 3 + 7);
+
+    // blue image, with red padding which mustn't show
+    std::string data(msg.step() * msg.height(), '\0');
+    for (unsigned int j = 0; j < msg.height(); ++j)
+    {
+      for (unsigned int i = 0; i < msg.step(); ++i)
+      {
+        bool padding = i >= msg.width() * 3;
+        data[j * msg.step() + i] = static_cast<char>(
+            padding ? (i % 3 == 0 ? 255 : 0) : (i % 3 == 2 ? 255 : 0));
+      }
+    }
+    msg.set_data(data);
+    pub.Publish(msg);
+  }
+
+  sleep = 0;
+  while (img.width() != 101 && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    img = imageProvider->requestImage(QString(), &dummySize, dummySize);
+    ++sleep;
+  }
+
+  EXPECT_EQ(img.height(), 10);
+  ASSERT_EQ(img.width(), 101);
+  for (int y = 0; y < img.height(); ++y)
+  {
+    for (int x = 0; x < img.width(); ++x)
+    {
+      EXPECT_EQ(img.pixelColor(x, y).red(), 0);
+      EXPECT_EQ(img.pixelColor(x, y).green(), 0);
+      EXPECT_EQ(img.pixelColor(x, y).blue(), 255);
+    }
+  }
+
   // Cleanup
   plugins.clear();
 }
@@ -425,6 +472,88 @@ TEST(ImageDisplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(ReceiveImageFloat32))
   plugins.clear();
 }
 
+/////////////////////////////////////////////////
+TEST(ImageDisplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(DepthAutoRange))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(
+    common::joinPaths(std::string(PROJECT_BINARY_PATH), "lib"));
+
+  // Both ends follow the depth
+  const char *pluginStr =
+    "<plugin filename=\"ImageDisplay\">"
+      "<topic>/image_test</topic>"
+      "<depth>"
+        "<min>auto</min>"
+        "<smoothing>1</smoothing>"
+      "</depth>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("ImageDisplay",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(win, nullptr);
+  auto plugins = win->findChildren<plugins::ImageDisplay *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+
+  auto imageProvider = static_cast<plugins::ImageProvider *>(
+      app.Engine()->imageProvider(
+      plugin->CardItem()->objectName() + "imagedisplay"));
+  ASSERT_NE(imageProvider, nullptr);
+  QSize dummySize;
+  QImage img = imageProvider->requestImage(QString(), &dummySize, dummySize);
+  int placeholderSize = 400;
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Image>("/image_test");
+
+  // Top half at 2, bottom half at 3, with a NaN
+  {
+    msgs::Image msg;
+    msg.set_height(32);
+    msg.set_width(32);
+    msg.set_pixel_format_type(msgs::PixelFormatType::R_FLOAT32);
+    msg.set_step(msg.width() * sizeof(float));
+
+    std::vector<float> buffer(msg.width() * msg.height());
+    for (unsigned int y = 0; y < msg.height(); ++y)
+    {
+      for (unsigned int x = 0; x < msg.width(); ++x)
+        buffer[y * msg.width() + x] = y < msg.height() / 2 ? 2.0f : 3.0f;
+    }
+    buffer[0] = std::numeric_limits<float>::quiet_NaN();
+    msg.set_data(buffer.data(), buffer.size() * sizeof(float));
+    pub.Publish(msg);
+  }
+
+  int sleep = 0;
+  int maxSleep = 30;
+  while (img.width() == placeholderSize && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    img = imageProvider->requestImage(QString(), &dummySize, dummySize);
+    ++sleep;
+  }
+  ASSERT_EQ(img.width(), 32);
+  ASSERT_EQ(img.height(), 32);
+
+  // Nearest is white and farthest black, NaN is shown as near
+  EXPECT_EQ(img.pixelColor(0, 0).red(), 255);
+  EXPECT_EQ(img.pixelColor(5, 5).red(), 255);
+  EXPECT_EQ(img.pixelColor(5, 5).blue(), 255);
+  EXPECT_EQ(img.pixelColor(5, 20).red(), 0);
+  EXPECT_EQ(img.pixelColor(5, 20).blue(), 0);
+
+  plugins.clear();
+}
+
 /////////////////////////////////////////////////
 TEST(ImageDisplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(ReceiveImageInt16))
 {
@@ -612,3 +741,196 @@ TEST(ImageDisplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(TopicPicker))
   // Cleanup
   plugins.clear();
 }
+
+/////////////////////////////////////////////////
+TEST(ImageDisplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Mosaic))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(
+    common::joinPaths(std::string(PROJECT_BINARY_PATH), "lib"));
+
+  // Load plugin
+  const char *pluginStr =
+    "<plugin filename=\"ImageDisplay\">"
+      "<mosaic>"
+        "<topic>/mosaic_left</topic>"
+        "<topic max_rate=\"30\">/mosaic_right</topic>"
+        "<columns>2</columns>"
+        "<tile_width>20</tile_width>"
+        "<tile_height>10</tile_height>"
+      "</mosaic>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("ImageDisplay",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(win, nullptr);
+  auto plugins = win->findChildren<plugins::ImageDisplay *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+
+  // The picker is hidden
+  EXPECT_FALSE(plugin->PluginItem()->property("showPicker").toBool());
+
+  auto providerBase = app.Engine()->imageProvider(
+      plugin->CardItem()->objectName() + "imagedisplay");
+  ASSERT_NE(providerBase, nullptr);
+  auto imageProvider = static_cast<plugins::ImageProvider *>(providerBase);
+  QSize dummySize;
+
+  // Publish a red image on the left and a blue one on the right, of
+  // another aspect ratio than the tiles
+  transport::Node node;
+  auto leftPub = node.Advertise<msgs::Image>("/mosaic_left");
+  auto rightPub = node.Advertise<msgs::Image>("/mosaic_right");
+
+  auto makeImage = [](unsigned char _r, unsigned char _b)
+  {
+    msgs::Image msg;
+    msg.set_height(40);
+    msg.set_width(40);
+    msg.set_pixel_format_type(msgs::PixelFormatType::RGB_INT8);
+    msg.set_step(msg.width() * 3);
+    std::string data(msg.width() * msg.height() * 3, '\0');
+    for (std::size_t i = 0; i < data.size(); i += 3)
+    {
+      data[i] = static_cast<char>(_r);
+      data[i + 2] = static_cast<char>(_b);
+    }
+    msg.set_data(data);
+    return msg;
+  };
+  leftPub.Publish(makeImage(255u, 0u));
+  rightPub.Publish(makeImage(0u, 255u));
+
+  // Give it time to be processed
+  QImage img;
+  int sleep = 0;
+  int maxSleep = 30;
+  while (sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    img = imageProvider->requestImage(QString(), &dummySize, dummySize);
+    if (img.width() == 40 && img.pixelColor(10, 5) == QColor(Qt::red) &&
+        img.pixelColor(30, 5) == QColor(Qt::blue))
+    {
+      break;
+    }
+    ++sleep;
+  }
+
+  // Both tiles in a single image
+  EXPECT_EQ(img.width(), 40);
+  EXPECT_EQ(img.height(), 10);
+  EXPECT_EQ(img.pixelColor(10, 5), QColor(Qt::red));
+  EXPECT_EQ(img.pixelColor(30, 5), QColor(Qt::blue));
+
+  // Square images are centered in the tiles, with black bars
+  EXPECT_EQ(img.pixelColor(1, 5), QColor(Qt::black));
+  EXPECT_EQ(img.pixelColor(38, 5), QColor(Qt::black));
+}
+
+/////////////////////////////////////////////////
+TEST(ImageDisplayTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(RegionOfInterest))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(
+    common::joinPaths(std::string(PROJECT_BINARY_PATH), "lib"));
+
+  // Load plugin
+  const char *pluginStr =
+    "<plugin filename=\"ImageDisplay\">"
+      "<topic>/roi_image</topic>"
+      "<roi>"
+        "<width>20</width>"
+        "<height>10</height>"
+        "<overview_width>50</overview_width>"
+      "</roi>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("ImageDisplay",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(win, nullptr);
+  auto plugins = win->findChildren<plugins::ImageDisplay *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+  EXPECT_TRUE(plugin->PluginItem()->property("showRoi").toBool());
+
+  auto providerBase = app.Engine()->imageProvider(
+      plugin->CardItem()->objectName() + "imagedisplay");
+  ASSERT_NE(providerBase, nullptr);
+  auto overviewProvider = static_cast<plugins::ImageProvider *>(providerBase);
+  providerBase = app.Engine()->imageProvider(
+      plugin->CardItem()->objectName() + "imagedisplayroi");
+  ASSERT_NE(providerBase, nullptr);
+  auto cropProvider = static_cast<plugins::ImageProvider *>(providerBase);
+  QSize dummySize;
+
+  // Red is the column and green the row
+  msgs::Image msg;
+  msg.set_width(200);
+  msg.set_height(100);
+  msg.set_pixel_format_type(msgs::PixelFormatType::RGB_INT8);
+  msg.set_step(msg.width() * 3);
+  std::string data(msg.width() * msg.height() * 3, '\0');
+  for (unsigned int j = 0; j < msg.height(); ++j)
+  {
+    for (unsigned int i = 0; i < msg.width(); ++i)
+    {
+      data[(j * msg.width() + i) * 3] = static_cast<char>(i);
+      data[(j * msg.width() + i) * 3 + 1] = static_cast<char>(j);
+    }
+  }
+  msg.set_data(data);
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Image>("/roi_image");
+
+  auto waitForRoi = [&](const QRect &_rect)
+  {
+    for (int sleep = 0; sleep < 30 && plugin->Roi() != _rect; ++sleep)
+    {
+      pub.Publish(msg);
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      QCoreApplication::processEvents();
+    }
+    // Wait for the last image to be displayed
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+  };
+
+  // Centered by default
+  waitForRoi(QRect(90, 45, 20, 10));
+  EXPECT_EQ(plugin->Roi(), QRect(90, 45, 20, 10));
+
+  // The overview has every 4th pixel
+  QImage overview = overviewProvider->requestImage(QString(), &dummySize,
+      dummySize);
+  EXPECT_EQ(overview.size(), QSize(50, 25));
+  EXPECT_EQ(overview.pixelColor(40, 20), QColor(160, 80, 0));
+
+  // The crop has all the pixels of the region
+  QImage crop = cropProvider->requestImage(QString(), &dummySize, dummySize);
+  EXPECT_EQ(crop.size(), QSize(20, 10));
+  EXPECT_EQ(crop.pixelColor(0, 0), QColor(90, 45, 0));
+  EXPECT_EQ(crop.pixelColor(19, 9), QColor(109, 54, 0));
+
+  // Moved to a corner, kept within the image
+  plugin->SetRoiCenter(0.0, 1.0);
+  waitForRoi(QRect(0, 90, 20, 10));
+  EXPECT_EQ(plugin->Roi(), QRect(0, 90, 20, 10));
+  crop = cropProvider->requestImage(QString(), &dummySize, dummySize);
+  EXPECT_EQ(crop.pixelColor(0, 0), QColor(0, 90, 0));
+}
@@ -19,6 +19,7 @@
 #include <gz/msgs/double.pb.h>
 #include <gz/msgs/stringmsg.pb.h>
 
+#include <chrono>
 #include <string>
 #include <mutex>
 
@@ -27,6 +28,8 @@
 #include <gz/gui/Application.hh>
 #include <gz/gui/GuiEvents.hh>
 #include <gz/gui/MainWindow.hh>
+#include <gz/gui/ScenePicker.hh>
+#include <gz/gui/StaticPlugins.hh>
 
 #include <gz/plugin/Register.hh>
 
@@ -46,8 +49,33 @@
 /// \brief Private data class for InteractiveViewControl
 class gz::gui::plugins::InteractiveViewControlPrivate
 {
-  /// \brief Perform rendering calls in the rendering thread.
-  public: void OnRender();
+  /// \brief How a drag moves the camera
+  public: enum class DragMode
+          {
+            kNone,
+            kPan,
+            kOrbit,
+            kZoom
+          };
+
+  /// \brief Perform rendering calls in the rendering thread, right before
+  /// the camera is updated, so the motion is shown on this frame.
+  public: void OnPreRender();
+
+  /// \brief Move the camera for a drag.
+  /// \param[in] _mode How the camera is moved
+  /// \param[in] _drag Drag distance in pixels, scaled by the sensitivity
+  public: void ApplyDrag(DragMode _mode, const math::Vector2d &_drag);
+
+  /// \brief Extrapolate the drag from the pointer velocity.
+  /// \param[in] _mode How the camera is moved
+  /// \return Drag to apply, which is the actual drag plus the change of the
+  /// predicted motion since the last frame
+  public: math::Vector2d Predict(DragMode _mode);
+
+  /// \brief Undo the predicted motion the pointer didn't follow, once it
+  /// stops or the drag ends.
+  public: void RetractPrediction();
 
   /// \brief Callback for camera view controller request
   /// \param[in] _msg Request message to set the camera view controller
@@ -77,6 +105,13 @@ class gz::gui::plugins::InteractiveViewControlPrivate
   /// camera to target point so it remains the same size on screen.
   public: void UpdateReferenceVisual();
 
+  /// \brief Get the point of the scene under a position, using the shared
+  /// picking if available, so the renderer and this plugin don't both cast
+  /// a ray for the same click
+  /// \param[in] _pos Position in the camera image
+  /// \return Point in world coordinates
+  public: math::Vector3d ScreenToScene(const math::Vector2i &_pos);
+
   /// \brief Flag to indicate if mouse event is dirty
   public: bool mouseDirty = false;
 
@@ -142,14 +177,49 @@ class gz::gui::plugins::InteractiveViewControlPrivate
 
   /// \brief View control sensitivity value. Must be greater than 0.
   public: double viewControlSensitivity = 1.0;
+
+  /// \brief How far ahead drags are extrapolated in milliseconds, 0 to
+  /// not extrapolate
+  public: double predictionMs{0.0};
+
+  /// \brief Predicted drag already applied to the camera, which the
+  /// pointer hasn't covered yet
+  public: math::Vector2d predictedDrag;
+
+  /// \brief Smoothed pointer velocity in pixels per second
+  public: math::Vector2d dragVelocity;
+
+  /// \brief When the last drag was applied
+  public: std::chrono::steady_clock::time_point lastDragTime;
+
+  /// \brief How the last drag moved the camera
+  public: DragMode lastDragMode{DragMode::kNone};
+
+  /// \brief Position of the last scroll, whose target is reused while
+  /// scrolling continues there
+  public: math::Vector2i scrollPos;
+
+  /// \brief When the last scroll zoomed, default constructed once the
+  /// scroll target is outdated
+  public: std::chrono::steady_clock::time_point lastScrollTime;
 };
 
 using namespace gz;
 using namespace gui;
 using namespace plugins;
 
+/// \brief Events handled by the plugin
+using ViewControlEvents = events::Dispatcher<
+    events::PreRender,
+    events::LeftClickOnScene,
+    events::MousePressOnScene,
+    events::DragOnScene,
+    events::ScrollOnScene,
+    events::BlockOrbit,
+    events::HoverOnScene>;
+
 /////////////////////////////////////////////////
-void InteractiveViewControlPrivate::OnRender()
+void InteractiveViewControlPrivate::OnPreRender()
 {
   if (!this->scene)
   {
@@ -193,6 +263,8 @@ void InteractiveViewControlPrivate::OnRender()
   if (this->blockOrbit)
   {
     this->drag = {0, 0};
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->RetractPrediction();
     return;
   }
 
@@ -207,10 +279,13 @@ void InteractiveViewControlPrivate::OnRender()
     this->hoverDirty = false;
   }
 
+  std::lock_guard<std::mutex> lock(this->mutex);
+
   if (!this->mouseDirty)
+  {
+    this->RetractPrediction();
     return;
-
-  std::lock_guard<std::mutex> lock(this->mutex);
+  }
 
   if (this->viewController == "ortho")
   {
@@ -259,8 +334,20 @@ void InteractiveViewControlPrivate::OnRender()
 
   if (this->mouseEvent.Type() == common::MouseEvent::SCROLL)
   {
-    this->target = rendering::screenToScene(
-      this->mouseEvent.Pos(), this->camera, this->rayQuery);
+    this->RetractPrediction();
+
+    // Zooming moves the camera towards the target, which stays under the
+    // cursor, so the scene is only picked again once the cursor moves or
+    // scrolling pauses
+    auto now = std::chrono::steady_clock::now();
+    if (this->lastScrollTime == std::chrono::steady_clock::time_point() ||
+        this->scrollPos != this->mouseEvent.Pos() ||
+        now - this->lastScrollTime > std::chrono::milliseconds(300))
+    {
+      this->target = this->ScreenToScene(this->mouseEvent.Pos());
+      this->scrollPos = this->mouseEvent.Pos();
+    }
+    this->lastScrollTime = now;
 
     this->viewControl->SetTarget(this->target);
     double distance = this->camera->WorldPosition().Distance(
@@ -273,8 +360,9 @@ void InteractiveViewControlPrivate::OnRender()
   }
   else if (this->mouseEvent.Type() == common::MouseEvent::PRESS)
   {
-    this->target = rendering::screenToScene(
-      this->mouseEvent.PressPos(), this->camera, this->rayQuery);
+    this->RetractPrediction();
+    this->lastScrollTime = std::chrono::steady_clock::time_point();
+    this->target = this->ScreenToScene(this->mouseEvent.PressPos());
 
     this->viewControl->SetTarget(this->target);
     this->UpdateReferenceVisual();
@@ -282,38 +370,129 @@ void InteractiveViewControlPrivate::OnRender()
   }
   else
   {
-    math::Vector2d newDrag = this->drag * this->viewControlSensitivity;
+    DragMode mode{DragMode::kNone};
     // Pan with left button
     if (this->mouseEvent.Buttons() & common::MouseEvent::LEFT)
     {
       if (Qt::ShiftModifier == QGuiApplication::queryKeyboardModifiers())
-        this->viewControl->Orbit(newDrag);
+        mode = DragMode::kOrbit;
       else
-        this->viewControl->Pan(newDrag);
-      this->UpdateReferenceVisual();
+        mode = DragMode::kPan;
     }
     // Orbit with middle button
     else if (this->mouseEvent.Buttons() & common::MouseEvent::MIDDLE)
     {
-      this->viewControl->Orbit(newDrag);
-      this->UpdateReferenceVisual();
+      mode = DragMode::kOrbit;
     }
     // Zoom with right button
     else if (this->mouseEvent.Buttons() & common::MouseEvent::RIGHT)
+    {
+      mode = DragMode::kZoom;
+    }
+
+    if (mode == DragMode::kNone)
+    {
+      this->RetractPrediction();
+    }
+    else
+    {
+      math::Vector2d drag = this->predictionMs > 0.0 ?
+          this->Predict(mode) : this->drag;
+      this->ApplyDrag(mode, drag * this->viewControlSensitivity);
+      this->lastScrollTime = std::chrono::steady_clock::time_point();
+    }
+  }
+
+  this->drag = 0;
+  this->mouseDirty = false;
+}
+
+/////////////////////////////////////////////////
+void InteractiveViewControlPrivate::ApplyDrag(DragMode _mode,
+    const math::Vector2d &_drag)
+{
+  switch (_mode)
+  {
+    case DragMode::kPan:
+      this->viewControl->Pan(_drag);
+      break;
+    case DragMode::kOrbit:
+      this->viewControl->Orbit(_drag);
+      break;
+    case DragMode::kZoom:
     {
       double hfov = this->camera->HFOV().Radian();
       double vfov = 2.0f * atan(tan(hfov / 2.0f) / this->camera->AspectRatio());
       double distance = this->camera->WorldPosition().Distance(this->target);
-      double amount = ((-newDrag.Y() /
+      double amount = ((-_drag.Y() /
           static_cast<double>(this->camera->ImageHeight()))
           * distance * tan(vfov/2.0) * 6.0);
       this->viewControl->Zoom(amount);
-      this->UpdateReferenceVisual();
+      break;
     }
+    case DragMode::kNone:
+      return;
   }
+  this->UpdateReferenceVisual();
+}
 
-  this->drag = 0;
-  this->mouseDirty = false;
+/////////////////////////////////////////////////
+math::Vector2d InteractiveViewControlPrivate::Predict(DragMode _mode)
+{
+  if (_mode != this->lastDragMode)
+    this->RetractPrediction();
+
+  // The drag is the motion since the last frame, so it gives the velocity.
+  // Frames further apart than that mean the pointer stopped in between.
+  auto now = std::chrono::steady_clock::now();
+  double dt = std::chrono::duration<double>(now - this->lastDragTime).count();
+  if (this->lastDragTime != std::chrono::steady_clock::time_point() &&
+      dt > 0.0 && dt < 0.1)
+  {
+    this->dragVelocity = this->dragVelocity * 0.5 + this->drag * (0.5 / dt);
+  }
+  else
+  {
+    this->dragVelocity = math::Vector2d::Zero;
+  }
+  this->lastDragTime = now;
+  this->lastDragMode = _mode;
+
+  // Only the change of the prediction is applied, so the camera still ends
+  // up where the pointer leads it
+  math::Vector2d prediction =
+      this->dragVelocity * (this->predictionMs / 1000.0);
+  math::Vector2d drag = this->drag + prediction - this->predictedDrag;
+  this->predictedDrag = prediction;
+  return drag;
+}
+
+/////////////////////////////////////////////////
+void InteractiveViewControlPrivate::RetractPrediction()
+{
+  this->dragVelocity = math::Vector2d::Zero;
+  this->lastDragTime = std::chrono::steady_clock::time_point();
+  if (this->predictedDrag == math::Vector2d::Zero || !this->viewControl ||
+      !this->camera)
+  {
+    this->predictedDrag = math::Vector2d::Zero;
+    return;
+  }
+
+  this->ApplyDrag(this->lastDragMode,
+      -this->predictedDrag * this->viewControlSensitivity);
+  this->predictedDrag = math::Vector2d::Zero;
+}
+
+/////////////////////////////////////////////////
+math::Vector3d InteractiveViewControlPrivate::ScreenToScene(
+    const math::Vector2i &_pos)
+{
+  // Same default distance as screenToScene
+  PickResult result;
+  if (ScenePicker::Pick(_pos, result))
+    return result.Point(10.0);
+  return rendering::screenToScene(_pos, this->camera, this->rayQuery);
 }
 
 /////////////////////////////////////////////////
@@ -398,11 +577,30 @@ InteractiveViewControl::~InteractiveViewControl() = default;
 
 /////////////////////////////////////////////////
 void InteractiveViewControl::LoadConfig(
-  const tinyxml2::XMLElement * /*_pluginElem*/)
+  const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Interactive view control";
 
+  if (_pluginElem)
+  {
+    auto elem = _pluginElem->FirstChildElement("prediction");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double predictionMs;
+      if (elem->QueryDoubleText(&predictionMs) != tinyxml2::XML_SUCCESS ||
+          predictionMs < 0.0)
+      {
+        gzerr << "Unable to set <prediction> to '" << elem->GetText()
+              << "', it must be a non-negative number." << std::endl;
+      }
+      else
+      {
+        this->dataPtr->predictionMs = predictionMs;
+      }
+    }
+  }
+
   // camera view control mode
   this->dataPtr->cameraViewControlService = "/gui/camera/view_control";
   this->dataPtr->node.Advertise(this->dataPtr->cameraViewControlService,
@@ -429,80 +627,74 @@ void InteractiveViewControl::LoadConfig(
         << this->dataPtr->cameraViewControlSensitivityService << "]"
         << std::endl;
 
-  gz::gui::App()->findChild<
-    gz::gui::MainWindow *>()->installEventFilter(this);
+  auto mainWindow = gz::gui::App()->findChild<gz::gui::MainWindow *>();
+  for (auto type : ViewControlEvents::kTypes)
+  {
+    mainWindow->SubscribeEvent(type, this);
+  }
 }
 
 /////////////////////////////////////////////////
 bool InteractiveViewControl::eventFilter(QObject *_obj, QEvent *_event)
 {
-  if (_event->type() == events::Render::kType)
-  {
-    this->dataPtr->OnRender();
-  }
-  else if (_event->type() == events::LeftClickOnScene::kType)
-  {
-    auto leftClickOnScene =
-      reinterpret_cast<gz::gui::events::LeftClickOnScene *>(_event);
-    this->dataPtr->mouseDirty = true;
+  ViewControlEvents::Dispatch(_event, events::Handlers{
+    [this](events::PreRender &)
+    {
+      this->dataPtr->OnPreRender();
+    },
+    [this](events::LeftClickOnScene &_leftClick)
+    {
+      this->dataPtr->mouseDirty = true;
 
-    this->dataPtr->drag = math::Vector2d::Zero;
-    this->dataPtr->mouseEvent = leftClickOnScene->Mouse();
-  }
-  else if (_event->type() == events::MousePressOnScene::kType)
-  {
-    auto pressOnScene =
-      reinterpret_cast<gz::gui::events::MousePressOnScene *>(_event);
-    this->dataPtr->mouseDirty = true;
-    this->dataPtr->mousePressDirty = true;
+      this->dataPtr->drag = math::Vector2d::Zero;
+      this->dataPtr->mouseEvent = _leftClick.Mouse();
+    },
+    [this](events::MousePressOnScene &_press)
+    {
+      this->dataPtr->mouseDirty = true;
+      this->dataPtr->mousePressDirty = true;
 
-    this->dataPtr->drag = math::Vector2d::Zero;
-    this->dataPtr->mouseEvent = pressOnScene->Mouse();
-  }
-  else if (_event->type() == events::DragOnScene::kType)
-  {
-    if (this->dataPtr->mousePressDirty)
-      return QObject::eventFilter(_obj, _event);
+      this->dataPtr->drag = math::Vector2d::Zero;
+      this->dataPtr->mouseEvent = _press.Mouse();
+    },
+    [this](events::DragOnScene &_dragOnScene)
+    {
+      if (this->dataPtr->mousePressDirty)
+        return;
 
-    auto dragOnScene =
-      reinterpret_cast<gz::gui::events::DragOnScene *>(_event);
-    this->dataPtr->mouseDirty = true;
+      this->dataPtr->mouseDirty = true;
 
-    auto dragStart = this->dataPtr->mouseEvent.Pos();
-    auto dragInt = dragOnScene->Mouse().Pos() - dragStart;
-    auto dragDistance = math::Vector2d(dragInt.X(), dragInt.Y());
+      auto dragStart = this->dataPtr->mouseEvent.Pos();
+      auto dragInt = _dragOnScene.Mouse().Pos() - dragStart;
+      auto dragDistance = math::Vector2d(dragInt.X(), dragInt.Y());
 
-    this->dataPtr->drag += dragDistance;
+      this->dataPtr->drag += dragDistance;
 
-    this->dataPtr->mouseEvent = dragOnScene->Mouse();
-  }
-  else if (_event->type() == events::ScrollOnScene::kType)
-  {
-    auto scrollOnScene =
-      reinterpret_cast<gz::gui::events::ScrollOnScene *>(_event);
-    this->dataPtr->mouseDirty = true;
+      this->dataPtr->mouseEvent = _dragOnScene.Mouse();
+    },
+    [this](events::ScrollOnScene &_scroll)
+    {
+      this->dataPtr->mouseDirty = true;
 
-    this->dataPtr->drag += math::Vector2d(
-      scrollOnScene->Mouse().Scroll().X(),
-      scrollOnScene->Mouse().Scroll().Y());
+      this->dataPtr->drag += math::Vector2d(
+        _scroll.Mouse().Scroll().X(),
+        _scroll.Mouse().Scroll().Y());
 
-    this->dataPtr->mouseEvent = scrollOnScene->Mouse();
-  }
-  else if (_event->type() == gz::gui::events::BlockOrbit::kType)
-  {
-    auto blockOrbit = reinterpret_cast<gz::gui::events::BlockOrbit *>(
-      _event);
-    this->dataPtr->blockOrbit = blockOrbit->Block();
-  }
-  else if (_event->type() == gui::events::HoverOnScene::kType)
-  {
-    this->dataPtr->hoverDirty = true;
-  }
+      this->dataPtr->mouseEvent = _scroll.Mouse();
+    },
+    [this](events::BlockOrbit &_blockOrbit)
+    {
+      this->dataPtr->blockOrbit = _blockOrbit.Block();
+    },
+    [this](events::HoverOnScene &)
+    {
+      this->dataPtr->hoverDirty = true;
+    }});
 
   // Standard event processing
   return QObject::eventFilter(_obj, _event);
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(gz::gui::plugins::InteractiveViewControl,
-              gz::gui::Plugin)
+GZ_GUI_ADD_PLUGIN(gz::gui::plugins::InteractiveViewControl,
+                  "InteractiveViewControl")
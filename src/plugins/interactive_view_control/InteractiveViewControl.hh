@@ -49,6 +49,17 @@ namespace plugins
   ///
   /// * `orbit`: perspective projection
   /// * `ortho`: orthographic projection
+  ///
+  /// The camera is moved right before it's updated, so the motion is shown
+  /// on the same frame as the mouse event.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<prediction\> : Optional time in milliseconds drags are
+  ///                    extrapolated ahead from the pointer velocity, to
+  ///                    hide the time until the frame is displayed. Motion
+  ///                    the pointer doesn't follow is undone when it stops.
+  ///                    Defaults to 0, which doesn't extrapolate.
   class InteractiveViewControl : public Plugin
   {
     Q_OBJECT
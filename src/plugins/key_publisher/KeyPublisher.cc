@@ -16,11 +16,19 @@
 */
 
 #include <gz/msgs/int32.pb.h>
+#include <gz/msgs/param_v.pb.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <optional>
 #include <string>
+#include <vector>
 
+#include <gz/common/Console.hh>
 #include <gz/gui/Application.hh>
 #include <gz/gui/MainWindow.hh>
+#include <gz/gui/StaticPlugins.hh>
 #include <gz/plugin/Register.hh>
 
 #include "KeyPublisher.hh"
@@ -29,6 +37,19 @@ namespace gz
 {
 namespace gui
 {
+  /// \brief A key pressed since the last key state was published
+  struct KeyState
+  {
+    /// \brief Qt key code
+    int key{0};
+
+    /// \brief When it was pressed
+    std::chrono::system_clock::time_point pressed;
+
+    /// \brief When it was released, if it was
+    std::optional<std::chrono::system_clock::time_point> released;
+  };
+
   class KeyPublisherPrivate
   {
     /// \brief Node for communication
@@ -48,6 +69,29 @@ namespace gui
       Msg.set_data(_keyPress->key());
       pub.Publish(Msg);
     }
+
+    /// \brief Record a press or release for the key state. Auto-repeated
+    /// events are ignored.
+    /// \param[in] _keyEvent Key event
+    /// \param[in] _press True if it's a press
+    public: void RecordKey(const QKeyEvent *_keyEvent, bool _press);
+
+    /// \brief Publish the keys held and those released since the last time,
+    /// then forget the released ones
+    public: void PublishState();
+
+    /// \brief Topic of the key state, empty if it's not published
+    public: std::string stateTopic;
+
+    /// \brief Publisher of the key state
+    public: gz::transport::Node::Publisher statePub;
+
+    /// \brief Timer publishing the key state
+    public: QTimer stateTimer;
+
+    /// \brief Keys held, and released since the last publication, in the
+    /// order they were pressed
+    public: std::vector<KeyState> keys;
   };
 }
 }
@@ -55,6 +99,78 @@ namespace gui
 using namespace gz;
 using namespace gui;
 
+/////////////////////////////////////////////////
+void KeyPublisherPrivate::RecordKey(const QKeyEvent *_keyEvent, bool _press)
+{
+  if (_keyEvent->isAutoRepeat())
+    return;
+
+  auto now = std::chrono::system_clock::now();
+  auto key = _keyEvent->key();
+
+  // The latest press of the key which wasn't released
+  auto held = this->keys.rend();
+  for (auto it = this->keys.rbegin(); it != this->keys.rend(); ++it)
+  {
+    if (it->key == key && !it->released)
+    {
+      held = it;
+      break;
+    }
+  }
+
+  if (_press && held == this->keys.rend())
+  {
+    KeyState state;
+    state.key = key;
+    state.pressed = now;
+    this->keys.push_back(state);
+  }
+  else if (!_press && held != this->keys.rend())
+  {
+    held->released = now;
+  }
+}
+
+/////////////////////////////////////////////////
+void KeyPublisherPrivate::PublishState()
+{
+  auto setTime = [](msgs::Any &_any,
+      std::chrono::system_clock::time_point _time)
+  {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        _time.time_since_epoch()).count();
+    _any.set_type(msgs::Any::TIME);
+    _any.mutable_time_value()->set_sec(ns / 1000000000);
+    _any.mutable_time_value()->set_nsec(ns % 1000000000);
+  };
+
+  msgs::Param_V msg;
+  auto now = std::chrono::system_clock::now();
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      now.time_since_epoch()).count();
+  msg.mutable_header()->mutable_stamp()->set_sec(ns / 1000000000);
+  msg.mutable_header()->mutable_stamp()->set_nsec(ns % 1000000000);
+
+  for (const auto &state : this->keys)
+  {
+    auto params = msg.add_param()->mutable_params();
+    auto &key = (*params)["key"];
+    key.set_type(msgs::Any::INT32);
+    key.set_int_value(state.key);
+    setTime((*params)["pressed"], state.pressed);
+    if (state.released)
+      setTime((*params)["released"], *state.released);
+  }
+  this->statePub.Publish(msg);
+
+  this->keys.erase(std::remove_if(this->keys.begin(), this->keys.end(),
+      [](const KeyState &_state)
+      {
+        return _state.released.has_value();
+      }), this->keys.end());
+}
+
 /////////////////////////////////////////////////
 KeyPublisher::KeyPublisher(): Plugin(), dataPtr(new KeyPublisherPrivate)
 {
@@ -69,11 +185,47 @@ KeyPublisher::~KeyPublisher()
 }
 
 /////////////////////////////////////////////////
-void KeyPublisher::LoadConfig(const tinyxml2::XMLElement *)
+void KeyPublisher::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Key publisher";
 
+  auto stateElem = _pluginElem ?
+      _pluginElem->FirstChildElement("state") : nullptr;
+  if (nullptr != stateElem && !this->dataPtr->stateTimer.isActive())
+  {
+    this->dataPtr->stateTopic = "keyboard/state";
+    auto topicElem = stateElem->FirstChildElement("topic");
+    if (nullptr != topicElem && nullptr != topicElem->GetText())
+      this->dataPtr->stateTopic = topicElem->GetText();
+
+    double rate{50.0};
+    if (auto rateElem = stateElem->FirstChildElement("rate"))
+      rateElem->QueryDoubleText(&rate);
+    if (rate <= 0.0)
+    {
+      gzerr << "Invalid key state <rate> [" << rate << "], using 50 Hz"
+            << std::endl;
+      rate = 50.0;
+    }
+
+    this->dataPtr->statePub = this->dataPtr->node.Advertise<msgs::Param_V>(
+        this->dataPtr->stateTopic);
+    if (!this->dataPtr->statePub)
+    {
+      gzerr << "Failed to advertise key state topic ["
+            << this->dataPtr->stateTopic << "]" << std::endl;
+    }
+    else
+    {
+      this->connect(&this->dataPtr->stateTimer, &QTimer::timeout, this,
+          [this]{this->dataPtr->PublishState();});
+      this->dataPtr->stateTimer.setTimerType(Qt::PreciseTimer);
+      this->dataPtr->stateTimer.start(std::max(1,
+          static_cast<int>(std::lround(1000.0 / rate))));
+    }
+  }
+
   gui::App()->findChild
     <MainWindow *>()->QuickWindow()->installEventFilter(this);
 }
@@ -86,9 +238,28 @@ bool KeyPublisher::eventFilter(QObject *_obj, QEvent *_event)
     QKeyEvent *keyEvent = static_cast<QKeyEvent*>(_event);
     this->dataPtr->KeyPub(keyEvent);
   }
+
+  if (this->dataPtr->stateTimer.isActive())
+  {
+    if (_event->type() == QEvent::KeyPress ||
+        _event->type() == QEvent::KeyRelease)
+    {
+      this->dataPtr->RecordKey(static_cast<QKeyEvent *>(_event),
+          _event->type() == QEvent::KeyPress);
+    }
+    else if (_event->type() == QEvent::FocusOut)
+    {
+      // Releases aren't received without focus, so keys would stay held
+      auto now = std::chrono::system_clock::now();
+      for (auto &state : this->dataPtr->keys)
+      {
+        if (!state.released)
+          state.released = now;
+      }
+    }
+  }
   return QObject::eventFilter(_obj, _event);
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(KeyPublisher,
-              gui::Plugin)
+GZ_GUI_ADD_PLUGIN(KeyPublisher, "KeyPublisher")
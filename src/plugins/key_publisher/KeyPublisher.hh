@@ -43,8 +43,17 @@ namespace gui
 
   /// \brief Publish keyboard stokes to "keyboard/keypress" topic.
   ///
+  /// It can also publish the state of the keyboard at a fixed rate, as a
+  /// gz.msgs.Param_V with a param per key held or released since the last
+  /// message, in the order they were pressed. Each has `key`, the Qt key
+  /// code, `pressed`, when it was pressed, and if it was released,
+  /// `released`. Auto-repeated events are ignored, and keys are released
+  /// when the window loses focus.
+  ///
   /// ## Configuration
-  /// This plugin doesn't accept any custom configuration.
+  /// * \<state\> : Publish the key state, with:
+  ///   * \<topic\> : Topic, defaults to "keyboard/state"
+  ///   * \<rate\> : Rate in Hz, defaults to 50
   class KeyPublisher_EXPORTS_API KeyPublisher : public gz::gui::Plugin
   {
     Q_OBJECT
@@ -16,7 +16,12 @@
 */
 #include <gtest/gtest.h>
 
+#include <functional>
+#include <mutex>
+#include <vector>
+
 #include <gz/msgs/int32.pb.h>
+#include <gz/msgs/param_v.pb.h>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
@@ -126,3 +131,116 @@ TEST_F(KeyPublisherTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(KeyPublisher))
   this->VerifyKeyEvent(Qt::Key_A);
   this->VerifyKeyEvent(Qt::Key_D);
 }
+
+/////////////////////////////////////////////////
+TEST(KeyPublisherStateTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(KeyState))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(
+    common::joinPaths(std::string(PROJECT_BINARY_PATH), "lib"));
+
+  std::mutex mutex;
+  std::vector<msgs::Param_V> received;
+  std::function<void(const msgs::Param_V &)> cb =
+      [&](const msgs::Param_V &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.push_back(_msg);
+      };
+  transport::Node node;
+  EXPECT_TRUE(node.Subscribe("/test/keyboard/state", cb));
+
+  const char *pluginStr =
+    "<plugin filename=\"KeyPublisher\">"
+      "<state>"
+        "<topic>/test/keyboard/state</topic>"
+        "<rate>20</rate>"
+      "</state>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+  EXPECT_TRUE(app.LoadPlugin("KeyPublisher",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  // Wait for a message matching the predicate, and return it
+  auto waitFor = [&](std::function<bool(const msgs::Param_V &)> _pred)
+  {
+    for (int sleep = 0; sleep < 30; ++sleep)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto &msg : received)
+        {
+          if (_pred(msg))
+            return msg;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      QCoreApplication::processEvents();
+    }
+    ADD_FAILURE() << "No matching key state";
+    return msgs::Param_V();
+  };
+
+  // Published even with no key held
+  auto idle = waitFor([](const msgs::Param_V &_msg)
+  {
+    return _msg.param_size() == 0;
+  });
+  EXPECT_GT(idle.header().stamp().sec(), 0);
+
+  // A press, repeated while held, is reported once
+  app.sendEvent(win->QuickWindow(),
+      new QKeyEvent(QEvent::KeyPress, Qt::Key_W, Qt::NoModifier));
+  app.sendEvent(win->QuickWindow(),
+      new QKeyEvent(QEvent::KeyRelease, Qt::Key_W, Qt::NoModifier,
+      QString(), true));
+  app.sendEvent(win->QuickWindow(),
+      new QKeyEvent(QEvent::KeyPress, Qt::Key_W, Qt::NoModifier,
+      QString(), true));
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    received.clear();
+  }
+  auto held = waitFor([](const msgs::Param_V &_msg)
+  {
+    return _msg.param_size() > 0;
+  });
+  ASSERT_EQ(1, held.param_size());
+  EXPECT_EQ(Qt::Key_W, held.param(0).params().at("key").int_value());
+  EXPECT_NE(held.param(0).params().end(),
+      held.param(0).params().find("pressed"));
+  EXPECT_EQ(held.param(0).params().end(),
+      held.param(0).params().find("released"));
+
+  // A tap of another key between two messages isn't lost, and its release
+  // is reported once
+  app.sendEvent(win->QuickWindow(),
+      new QKeyEvent(QEvent::KeyPress, Qt::Key_A, Qt::NoModifier));
+  app.sendEvent(win->QuickWindow(),
+      new QKeyEvent(QEvent::KeyRelease, Qt::Key_A, Qt::NoModifier));
+  auto tapped = waitFor([](const msgs::Param_V &_msg)
+  {
+    return _msg.param_size() == 2;
+  });
+  EXPECT_EQ(Qt::Key_W, tapped.param(0).params().at("key").int_value());
+  EXPECT_EQ(Qt::Key_A, tapped.param(1).params().at("key").int_value());
+  EXPECT_NE(tapped.param(1).params().end(),
+      tapped.param(1).params().find("released"));
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    received.clear();
+  }
+  auto after = waitFor([](const msgs::Param_V &)
+  {
+    return true;
+  });
+  EXPECT_EQ(1, after.param_size());
+}
@@ -0,0 +1,374 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <gz/math/Vector3.hh>
+
+#include "MarkerIndex.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+namespace
+{
+/// \brief Maximum number of cells a marker is kept in, larger markers are
+/// checked by every query
+constexpr double kMaxCells{64.0};
+
+/// \brief Bits of each cell coordinate in a packed cell
+constexpr int kCellBits{21};
+
+/// \brief Largest cell coordinate, larger ones are clamped to it
+constexpr int32_t kCellLimit{(1 << (kCellBits - 1)) - 1};
+
+/// \brief Pack the coordinates of a cell into a key
+/// \param[in] _x X coordinate
+/// \param[in] _y Y coordinate
+/// \param[in] _z Z coordinate
+/// \return Key
+uint64_t Pack(int32_t _x, int32_t _y, int32_t _z)
+{
+  constexpr uint64_t mask = (uint64_t{1} << kCellBits) - 1u;
+  auto offset = [](int32_t _c)
+  {
+    return static_cast<uint64_t>(_c + kCellLimit + 1) & mask;
+  };
+  return offset(_x) | (offset(_y) << kCellBits) |
+      (offset(_z) << (2 * kCellBits));
+}
+
+/// \brief Unpack the coordinates of a cell
+/// \param[in] _key Key made by Pack
+/// \return Coordinates
+std::array<int32_t, 3> Unpack(uint64_t _key)
+{
+  constexpr uint64_t mask = (uint64_t{1} << kCellBits) - 1u;
+  std::array<int32_t, 3> cell;
+  for (int i = 0; i < 3; ++i)
+  {
+    cell[i] = static_cast<int32_t>((_key >> (i * kCellBits)) & mask) -
+        kCellLimit - 1;
+  }
+  return cell;
+}
+
+/// \brief Get the bounds of a frustum
+/// \param[in] _frustum Frustum, looking along X
+/// \return Box containing its 8 corners
+math::AxisAlignedBox FrustumBounds(const math::Frustum &_frustum)
+{
+  math::AxisAlignedBox box;
+  const double tanHalf = std::tan(_frustum.FOV().Radian() * 0.5);
+  const double aspect = std::max(_frustum.AspectRatio(), 1e-6);
+  for (double dist : {_frustum.Near(), _frustum.Far()})
+  {
+    const double halfWidth = dist * tanHalf;
+    const double halfHeight = halfWidth / aspect;
+    for (double y : {-halfWidth, halfWidth})
+    {
+      for (double z : {-halfHeight, halfHeight})
+      {
+        auto corner = _frustum.Pose().CoordPositionAdd(
+            math::Vector3d(dist, y, z));
+        box.Merge(math::AxisAlignedBox(corner, corner));
+      }
+    }
+  }
+  return box;
+}
+}
+
+/////////////////////////////////////////////////
+MarkerIndex::MarkerIndex(double _cellSize)
+  : cellSize(_cellSize > 0.0 ? _cellSize : 1.0)
+{
+}
+
+/////////////////////////////////////////////////
+void MarkerIndex::Update(const Key &_key,
+    const math::AxisAlignedBox &_bounds)
+{
+  if (_bounds.Min().X() > _bounds.Max().X() ||
+      _bounds.Min().Y() > _bounds.Max().Y() ||
+      _bounds.Min().Z() > _bounds.Max().Z())
+  {
+    this->Erase(_key);
+    return;
+  }
+
+  auto minCell = this->Cell(_bounds.Min());
+  auto maxCell = this->Cell(_bounds.Max());
+
+  auto it = this->slots.find(_key);
+  if (it != this->slots.end())
+  {
+    // Moves within the same cells only update the bounds
+    auto &item = this->items[it->second];
+    item.bounds = _bounds;
+    if (item.minCell == minCell && item.maxCell == maxCell)
+      return;
+
+    this->Remove(it->second);
+    item.minCell = minCell;
+    item.maxCell = maxCell;
+    this->Insert(it->second);
+    return;
+  }
+
+  uint32_t slot;
+  if (!this->freeSlots.empty())
+  {
+    slot = this->freeSlots.back();
+    this->freeSlots.pop_back();
+  }
+  else
+  {
+    slot = static_cast<uint32_t>(this->items.size());
+    this->items.emplace_back();
+    this->visited.push_back(0u);
+  }
+
+  auto &item = this->items[slot];
+  item.key = _key;
+  item.bounds = _bounds;
+  item.minCell = minCell;
+  item.maxCell = maxCell;
+  this->slots[_key] = slot;
+  this->Insert(slot);
+}
+
+/////////////////////////////////////////////////
+bool MarkerIndex::Erase(const Key &_key)
+{
+  auto it = this->slots.find(_key);
+  if (it == this->slots.end())
+    return false;
+
+  this->Remove(it->second);
+  this->items[it->second] = Item();
+  this->freeSlots.push_back(it->second);
+  this->slots.erase(it);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void MarkerIndex::Clear(const std::string &_ns)
+{
+  if (_ns.empty())
+  {
+    *this = MarkerIndex(this->cellSize);
+    return;
+  }
+
+  auto it = this->slots.lower_bound({_ns, 0u});
+  while (it != this->slots.end() && it->first.first == _ns)
+  {
+    this->Remove(it->second);
+    this->items[it->second] = Item();
+    this->freeSlots.push_back(it->second);
+    it = this->slots.erase(it);
+  }
+}
+
+/////////////////////////////////////////////////
+const math::AxisAlignedBox *MarkerIndex::Bounds(const Key &_key) const
+{
+  auto it = this->slots.find(_key);
+  if (it == this->slots.end())
+    return nullptr;
+  return &this->items[it->second].bounds;
+}
+
+/////////////////////////////////////////////////
+template <typename F>
+void MarkerIndex::Candidates(const math::AxisAlignedBox &_region,
+    F _visit) const
+{
+  if (this->slots.empty())
+    return;
+
+  // Wrapped around, all slots are visited again
+  if (++this->query == 0u)
+  {
+    std::fill(this->visited.begin(), this->visited.end(), 0u);
+    this->query = 1u;
+  }
+
+  auto visit = [&](uint32_t _slot)
+  {
+    if (this->visited[_slot] == this->query)
+      return;
+    this->visited[_slot] = this->query;
+    _visit(this->items[_slot]);
+  };
+
+  for (auto slot : this->large)
+    visit(slot);
+
+  auto minCell = this->Cell(_region.Min());
+  auto maxCell = this->Cell(_region.Max());
+  double count{1.0};
+  for (int i = 0; i < 3; ++i)
+    count *= 1.0 + std::max(0, maxCell[i] - minCell[i]);
+
+  // Large regions go through the cells in use rather than all the cells
+  // they cover
+  if (count > static_cast<double>(this->cells.size()))
+  {
+    for (const auto &cell : this->cells)
+    {
+      auto c = Unpack(cell.first);
+      if (c[0] < minCell[0] || c[0] > maxCell[0] ||
+          c[1] < minCell[1] || c[1] > maxCell[1] ||
+          c[2] < minCell[2] || c[2] > maxCell[2])
+      {
+        continue;
+      }
+      for (auto slot : cell.second)
+        visit(slot);
+    }
+    return;
+  }
+
+  for (int32_t x = minCell[0]; x <= maxCell[0]; ++x)
+  {
+    for (int32_t y = minCell[1]; y <= maxCell[1]; ++y)
+    {
+      for (int32_t z = minCell[2]; z <= maxCell[2]; ++z)
+      {
+        auto cell = this->cells.find(Pack(x, y, z));
+        if (cell == this->cells.end())
+          continue;
+        for (auto slot : cell->second)
+          visit(slot);
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+std::vector<MarkerIndex::Key> MarkerIndex::Query(
+    const math::AxisAlignedBox &_region) const
+{
+  std::vector<Key> keys;
+  this->Candidates(_region, [&](const Item &_item)
+  {
+    if (_item.bounds.Intersects(_region))
+      keys.push_back(_item.key);
+  });
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+/////////////////////////////////////////////////
+std::vector<MarkerIndex::Key> MarkerIndex::Query(
+    const math::Frustum &_frustum) const
+{
+  std::vector<Key> keys;
+  this->Candidates(FrustumBounds(_frustum), [&](const Item &_item)
+  {
+    if (_frustum.Contains(_item.bounds))
+      keys.push_back(_item.key);
+  });
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+/////////////////////////////////////////////////
+std::size_t MarkerIndex::Size() const
+{
+  return this->slots.size();
+}
+
+/////////////////////////////////////////////////
+std::array<int32_t, 3> MarkerIndex::Cell(const math::Vector3d &_pos) const
+{
+  std::array<int32_t, 3> cell;
+  for (int i = 0; i < 3; ++i)
+  {
+    // Also clamps infinite bounds, NaN goes to the highest cell
+    double c = std::floor(_pos[i] / this->cellSize);
+    c = c < kCellLimit ? c : kCellLimit;
+    cell[i] = c > -kCellLimit ? static_cast<int32_t>(c) : -kCellLimit;
+  }
+  return cell;
+}
+
+/////////////////////////////////////////////////
+void MarkerIndex::Insert(uint32_t _slot)
+{
+  auto &item = this->items[_slot];
+  double count{1.0};
+  for (int i = 0; i < 3; ++i)
+    count *= 1.0 + item.maxCell[i] - item.minCell[i];
+
+  item.large = count > kMaxCells;
+  if (item.large)
+  {
+    this->large.push_back(_slot);
+    return;
+  }
+
+  for (int32_t x = item.minCell[0]; x <= item.maxCell[0]; ++x)
+  {
+    for (int32_t y = item.minCell[1]; y <= item.maxCell[1]; ++y)
+    {
+      for (int32_t z = item.minCell[2]; z <= item.maxCell[2]; ++z)
+        this->cells[Pack(x, y, z)].push_back(_slot);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void MarkerIndex::Remove(uint32_t _slot)
+{
+  auto erase = [_slot](std::vector<uint32_t> &_slots)
+  {
+    auto it = std::find(_slots.begin(), _slots.end(), _slot);
+    if (it == _slots.end())
+      return;
+    *it = _slots.back();
+    _slots.pop_back();
+  };
+
+  const auto &item = this->items[_slot];
+  if (item.large)
+  {
+    erase(this->large);
+    return;
+  }
+
+  for (int32_t x = item.minCell[0]; x <= item.maxCell[0]; ++x)
+  {
+    for (int32_t y = item.minCell[1]; y <= item.maxCell[1]; ++y)
+    {
+      for (int32_t z = item.minCell[2]; z <= item.maxCell[2]; ++z)
+      {
+        auto cell = this->cells.find(Pack(x, y, z));
+        if (cell == this->cells.end())
+          continue;
+        erase(cell->second);
+        if (cell->second.empty())
+          this->cells.erase(cell);
+      }
+    }
+  }
+}
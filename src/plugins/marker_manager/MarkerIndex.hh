@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MARKERMANAGER_MARKERINDEX_HH_
+#define GZ_GUI_PLUGINS_MARKERMANAGER_MARKERINDEX_HH_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Frustum.hh>
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Spatial hash of the world bounds of markers, so the markers in
+  /// a region or in view are found without going through all of them.
+  ///
+  /// Space is divided into cubic cells, and each marker is kept in the
+  /// cells its bounds overlap. Markers overlapping too many cells are kept
+  /// in a list checked by every query instead. Updates only touch the
+  /// cells of the marker, and moves within the same cells don't touch any.
+  ///
+  /// It isn't thread safe, queries included.
+  class MarkerIndex
+  {
+    /// \brief Namespace and id of a marker
+    public: using Key = std::pair<std::string, uint64_t>;
+
+    /// \brief Constructor
+    /// \param[in] _cellSize Edge of the cells, in meters
+    public: explicit MarkerIndex(double _cellSize = 10.0);
+
+    /// \brief Add a marker or update its bounds
+    /// \param[in] _key Marker
+    /// \param[in] _bounds World bounds, the marker is removed if they're
+    /// empty
+    public: void Update(const Key &_key,
+        const gz::math::AxisAlignedBox &_bounds);
+
+    /// \brief Remove a marker
+    /// \param[in] _key Marker
+    /// \return True if it was indexed
+    public: bool Erase(const Key &_key);
+
+    /// \brief Remove all markers of a namespace, or all markers if it's
+    /// empty
+    /// \param[in] _ns Namespace
+    public: void Clear(const std::string &_ns);
+
+    /// \brief Get the bounds of a marker
+    /// \param[in] _key Marker
+    /// \return Bounds, null if it isn't indexed
+    public: const gz::math::AxisAlignedBox *Bounds(const Key &_key) const;
+
+    /// \brief Get the markers which overlap a region
+    /// \param[in] _region Region
+    /// \return Markers, sorted
+    public: std::vector<Key> Query(
+        const gz::math::AxisAlignedBox &_region) const;
+
+    /// \brief Get the markers which are at least partly in a frustum
+    /// \param[in] _frustum Frustum, such as the camera's view
+    /// \return Markers, sorted
+    public: std::vector<Key> Query(const gz::math::Frustum &_frustum) const;
+
+    /// \brief Get the number of markers
+    /// \return Number of markers
+    public: std::size_t Size() const;
+
+    /// \brief An indexed marker
+    private: struct Item
+    {
+      /// \brief Marker
+      Key key;
+
+      /// \brief World bounds
+      gz::math::AxisAlignedBox bounds;
+
+      /// \brief First cell overlapped, on each axis
+      std::array<int32_t, 3> minCell{};
+
+      /// \brief Last cell overlapped, on each axis
+      std::array<int32_t, 3> maxCell{};
+
+      /// \brief True if it's in large instead of cells
+      bool large{false};
+    };
+
+    /// \brief Get the cell of a position
+    /// \param[in] _pos Position
+    /// \return Cell coordinates
+    private: std::array<int32_t, 3> Cell(const gz::math::Vector3d &_pos)
+        const;
+
+    /// \brief Add an item to its cells, or to large
+    /// \param[in] _slot Index of the item
+    private: void Insert(uint32_t _slot);
+
+    /// \brief Remove an item from its cells, or from large
+    /// \param[in] _slot Index of the item
+    private: void Remove(uint32_t _slot);
+
+    /// \brief Get the items whose cells overlap a region, each once
+    /// \param[in] _region Region
+    /// \param[in] _visit Called with each item
+    private: template <typename F>
+        void Candidates(const gz::math::AxisAlignedBox &_region,
+        F _visit) const;
+
+    /// \brief Edge of the cells
+    private: double cellSize;
+
+    /// \brief Items, by slot. Free slots have an empty key and bounds.
+    private: std::vector<Item> items;
+
+    /// \brief Slots of removed items, to reuse
+    private: std::vector<uint32_t> freeSlots;
+
+    /// \brief Slot of each marker
+    private: std::map<Key, uint32_t> slots;
+
+    /// \brief Slots of the items overlapping each cell, by packed cell
+    /// coordinates
+    private: std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+
+    /// \brief Slots of the items overlapping more than kMaxCells cells
+    private: std::vector<uint32_t> large;
+
+    /// \brief Query number which last visited each slot, so items in
+    /// several cells are only visited once per query
+    private: mutable std::vector<uint32_t> visited;
+
+    /// \brief Number of the current query
+    private: mutable uint32_t query{0u};
+  };
+}
+}
+}
+#endif
@@ -16,29 +16,56 @@
 */
 
 #include <algorithm>
-#include <list>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iterator>
 #include <map>
+#include <stdexcept>
+#include <memory>
+#include <queue>
+#include <set>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <QQmlProperty>
 
 #include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/header.pb.h>
 #include <gz/msgs/marker.pb.h>
 #include <gz/msgs/marker_v.pb.h>
-#include <gz/msgs/world_stats.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Profiler.hh>
 #include <gz/common/StringUtils.hh>
 
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Color.hh>
+#include <gz/math/Frustum.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
 #include <gz/math/Rand.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
 
 #include <gz/plugin/Register.hh>
 
+#include <gz/rendering/Camera.hh>
 #include "gz/rendering/Marker.hh"
 #include <gz/rendering/RenderingIface.hh>
 #include <gz/rendering/Scene.hh>
 
+#include <gz/msgs/PointCloudPackedUtils.hh>
 #include <gz/msgs/Utility.hh>
 #include <gz/transport/Node.hh>
 
@@ -46,32 +73,711 @@
 #include "gz/gui/GuiEvents.hh"
 #include "gz/gui/Helpers.hh"
 #include "gz/gui/MainWindow.hh"
-
+#include "gz/gui/Profiler.hh"
+#include "gz/gui/QueueStats.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/SharedMemory.hh"
+#include "gz/gui/SimClock.hh"
+#include "gz/gui/StaticPlugins.hh"
+
+#include "MarkerIndex.hh"
 #include "MarkerManager.hh"
 
+namespace
+{
+/// \brief Material shared by all markers with the same material properties
+struct SharedMaterial
+{
+  /// \brief Rendering material
+  gz::rendering::MaterialPtr material;
+
+  /// \brief Number of markers using the material
+  unsigned int refs{0};
+};
+
+/// \brief Sim time when a marker expires
+struct MarkerExpiry
+{
+  /// \brief Sim time when the marker expires
+  std::chrono::steady_clock::duration time;
+
+  /// \brief Namespace of the marker
+  std::string ns;
+
+  /// \brief Id of the marker
+  uint64_t id;
+
+  /// \brief Visual of the marker, to tell if the marker was replaced
+  gz::rendering::VisualPtr::weak_type visual;
+
+  /// \brief Order by expiry time, for a min-heap
+  /// \param[in] _other Other expiry
+  /// \return True if this expires after _other
+  bool operator>(const MarkerExpiry &_other) const
+  {
+    return this->time > _other.time;
+  }
+};
+
+/// \brief Points of a marker, as last set on the rendering marker
+struct MarkerPoints
+{
+  /// \brief Point positions
+  std::vector<gz::math::Vector3d> points;
+
+  /// \brief Point colors
+  std::vector<gz::math::Color> colors;
+
+  /// \brief False if the points on the rendering marker aren't known
+  bool valid{true};
+};
+
+/// \brief Marker drawn as part of its namespace's batch
+struct BatchedMarker
+{
+  /// \brief Marker type, BOX, LINE_LIST or TEXT
+  gz::msgs::Marker::Type type{gz::msgs::Marker::BOX};
+
+  /// \brief Pose relative to the world
+  gz::math::Pose3d pose;
+
+  /// \brief Scale
+  gz::math::Vector3d scale{1, 1, 1};
+
+  /// \brief Color of the marker
+  gz::math::Color color{gz::math::Color::White};
+
+  /// \brief Points of line markers
+  MarkerPoints points;
+
+  /// \brief Text of TEXT markers
+  std::string text;
+};
+
+/// \brief Markers of a namespace which are merged into a single visual
+struct MarkerBatch
+{
+  /// \brief Visual holding the merged geometry
+  gz::rendering::VisualPtr visual;
+
+  /// \brief Triangles of all BOX markers
+  gz::rendering::MarkerPtr triangles;
+
+  /// \brief Lines of all LINE_LIST markers
+  gz::rendering::MarkerPtr lines;
+
+  /// \brief Glyph strokes of all TEXT markers, kept apart from the lines
+  /// so they can be turned towards the camera on their own
+  gz::rendering::MarkerPtr text;
+
+  /// \brief Camera rotation the text was built for
+  gz::math::Quaterniond textRotation;
+
+  /// \brief True if any marker is a TEXT marker
+  bool hasText{false};
+
+  /// \brief Batched markers, by id
+  std::map<uint64_t, BatchedMarker> markers;
+
+  /// \brief True if the merged geometry must be rebuilt
+  bool dirty{false};
+};
+
+/// \brief Vertices of the 12 triangles of a unit box centered at the origin
+const std::array<gz::math::Vector3d, 36> &UnitBoxTriangles()
+{
+  static const std::array<gz::math::Vector3d, 36> triangles = []
+  {
+    // Each face as 4 corners in counter clockwise order seen from outside
+    const double h = 0.5;
+    const gz::math::Vector3d faces[6][4] = {
+      {{h, -h, -h}, {h, h, -h}, {h, h, h}, {h, -h, h}},
+      {{-h, h, -h}, {-h, -h, -h}, {-h, -h, h}, {-h, h, h}},
+      {{h, h, -h}, {-h, h, -h}, {-h, h, h}, {h, h, h}},
+      {{-h, -h, -h}, {h, -h, -h}, {h, -h, h}, {-h, -h, h}},
+      {{-h, -h, h}, {h, -h, h}, {h, h, h}, {-h, h, h}},
+      {{-h, h, -h}, {h, h, -h}, {h, -h, -h}, {-h, -h, -h}}};
+
+    std::array<gz::math::Vector3d, 36> result;
+    std::size_t i = 0;
+    for (const auto &face : faces)
+    {
+      for (int corner : {0, 1, 2, 0, 2, 3})
+        result[i++] = face[corner];
+    }
+    return result;
+  }();
+  return triangles;
+}
+
+/// \brief Strokes of the printable ASCII characters, from ' ' to '~', on
+/// a grid 4 wide and 8 tall with the baseline at 2. Each stroke is a
+/// polyline of digit pairs, and strokes are separated by spaces.
+const char *const kGlyphStrokes[] = {
+  "", "2825 2322", "1816 3836", "1713 3733 0646 0444",
+  "473818070615354443321203 2821", "0842 0717 3343",
+  "4215071828370403123244", "2826", "38272332", "18272312",
+  "2723 1634 1436", "2723 0545", "2311", "1535", "2223", "0248",
+  "183847433212030718", "172822 1232", "07183847460242",
+  "07183847463525 354443321203", "380444 3832", "480805354443321203",
+  "473818070312324344351504", "084822",
+  "18384746351504031232434435 15060718",
+  "0312324347381807061545", "2625 2322", "2625 2311", "470543",
+  "0646 0444", "074503", "07183847462524 2322",
+  "4332120307183847442436", "022842 1535", "02083847463505 3544433202",
+  "4738180703123243", "02082847432202", "48080242 0535", "480802 0535",
+  "47381807031232434525", "0208 4842 0545", "1838 2822 1232",
+  "4843321203", "0208 4804 1542", "080242", "0208254842", "02084248",
+  "183847433212030718", "02083847463505", "183847433212030718 2442",
+  "02083847463505 3542", "473818070615354443321203", "0848 2822",
+  "080312324348", "082248", "0802254248", "0842 4802",
+  "0825 4825 2522", "08480242", "38282232", "0842", "18282212",
+  "062846", "0040", "1827", "16364542 441403123243",
+  "0802 0516364543321203", "4536160503123243",
+  "4842 4536160503123243", "04444536160503123243", "4738281712 0636",
+  "4536160504133344 4641301001", "0802 0516364542", "2622 2728",
+  "26211000 2728", "0802 4603 1442", "182822 1232",
+  "0602 05162522 25364542", "0602 0516364542", "163645433212030516",
+  "0600 0516364543321203", "4640 4536160503123243", "0602 04163645",
+  "45361605143443321203", "28233242 0636", "0603123243 4642",
+  "062246", "0602244246", "0642 4602", "0603123243 4641301001",
+  "06464202", "38272615242332", "2822", "18272635242312", "06173546"};
+
+/// \brief Width of a glyph plus the space to the next one, relative to
+/// the cap height
+const double kGlyphAdvance = 5.0 / 6.0;
+
+/// \brief Distance between the baselines of two lines of text, relative
+/// to the cap height
+const double kLineAdvance = 10.0 / 6.0;
+
+/// \brief Line segments drawing each printable ASCII character, as pairs
+/// of points, with a cap height of 1 and the baseline at 0. They're
+/// shared by all batched TEXT markers, so labels only add vertices.
+const std::array<std::vector<gz::math::Vector2d>, 95> &StrokeGlyphs()
+{
+  static const std::array<std::vector<gz::math::Vector2d>, 95> glyphs = []
+  {
+    static_assert(sizeof(kGlyphStrokes) / sizeof(kGlyphStrokes[0]) == 95,
+        "One glyph per printable ASCII character");
+
+    std::array<std::vector<gz::math::Vector2d>, 95> result;
+    for (std::size_t c = 0; c < result.size(); ++c)
+    {
+      for (const auto &stroke :
+           gz::common::Split(kGlyphStrokes[c], ' '))
+      {
+        for (std::size_t i = 2; i + 1 < stroke.size(); i += 2)
+        {
+          for (std::size_t p : {i - 2, i})
+          {
+            result[c].emplace_back((stroke[p] - '0') / 6.0,
+                (stroke[p + 1] - '0' - 2) / 6.0);
+          }
+        }
+      }
+    }
+    return result;
+  }();
+  return glyphs;
+}
+
+/// \brief Marker message waiting to be processed
+struct QueuedMarker
+{
+  /// \brief Marker message
+  gz::msgs::Marker msg;
+
+  /// \brief False if it was superseded by a later message
+  bool valid{true};
+
+  /// \brief False to not warn if the action fails, because the marker it
+  /// applies to may only have existed in the queue
+  bool warn{true};
+
+  /// \brief Points decoded from a packed message, used instead of the
+  /// message's points if set
+  std::shared_ptr<const MarkerPoints> points;
+
+  /// \brief Sequence number of the synchronous marker array request which
+  /// has been applied once this entry is reached. Zero for markers.
+  uint64_t barrier{0};
+
+  /// \brief Estimated bytes, for QueueStats
+  std::size_t bytes{0};
+};
+
+/// \brief Estimate the memory used by a queued marker, without walking
+/// the message like ByteSizeLong would
+/// \param[in] _queued Queued marker
+/// \return Bytes
+std::size_t QueuedBytes(const QueuedMarker &_queued)
+{
+  std::size_t bytes = sizeof(QueuedMarker) + _queued.msg.text().size() +
+      _queued.msg.point_size() * sizeof(gz::msgs::Vector3d) +
+      _queued.msg.materials_size() * sizeof(gz::msgs::Material);
+  if (_queued.points)
+  {
+    bytes += _queued.points->points.size() * sizeof(gz::math::Vector3d) +
+        _queued.points->colors.size() * sizeof(gz::math::Color);
+  }
+  return bytes;
+}
+
+/// \brief Whether a marker array request waits until its markers have been
+/// applied before replying, which is requested with a "sync" key in the
+/// header data.
+/// \param[in] _msg Marker array message
+/// \return True to wait
+bool IsSync(const gz::msgs::Marker_V &_msg)
+{
+  if (!_msg.has_header())
+    return false;
+
+  for (const auto &data : _msg.header().data())
+  {
+    if (data.key() == "sync")
+      return data.value_size() == 0 || data.value(0) != "false";
+  }
+  return false;
+}
+
+/// \brief Whether a marker message appends its points to the marker's
+/// current points instead of replacing them, which is requested with an
+/// "append" key in the header data.
+/// \param[in] _msg Marker message
+/// \return True to append
+bool IsAppend(const gz::msgs::Marker &_msg)
+{
+  if (!_msg.has_header())
+    return false;
+
+  for (const auto &data : _msg.header().data())
+  {
+    if (data.key() == "append")
+      return data.value_size() == 0 || data.value(0) != "false";
+  }
+  return false;
+}
+
+/// \brief Remove the "append" key from the header data of a message
+/// \param[in,out] _msg Marker message
+void ClearAppend(gz::msgs::Marker &_msg)
+{
+  if (!_msg.has_header())
+    return;
+
+  auto data = _msg.mutable_header()->mutable_data();
+  for (int i = data->size() - 1; i >= 0; --i)
+  {
+    if (data->Get(i).key() == "append")
+      data->DeleteSubrange(i, 1);
+  }
+}
+
+/// \brief Get the points of a marker message
+/// \param[in] _msg Marker message
+/// \return Points and their colors
+MarkerPoints PointsFromMsg(const gz::msgs::Marker &_msg)
+{
+  MarkerPoints points;
+  points.points.reserve(_msg.point().size());
+  points.colors.reserve(_msg.point().size());
+  for (int i = 0; i < _msg.point().size(); ++i)
+  {
+    points.points.emplace_back(
+        _msg.point(i).x(),
+        _msg.point(i).y(),
+        _msg.point(i).z());
+
+    gz::math::Color color = gz::msgs::Convert(_msg.material().diffuse());
+    if (i < _msg.materials().size())
+    {
+      color = gz::msgs::Convert(_msg.materials(i).diffuse());
+    }
+    points.colors.push_back(color);
+  }
+  return points;
+}
+
+/// \brief Get a value from the header data of a message
+/// \param[in] _header Message header
+/// \param[in] _key Data key
+/// \return First value of the key, empty if not found
+std::string HeaderValue(const gz::msgs::Header &_header,
+    const std::string &_key)
+{
+  for (const auto &data : _header.data())
+  {
+    if (data.key() == _key && data.value_size() > 0)
+      return data.value(0);
+  }
+  return std::string();
+}
+
+/// \brief Whether a request is limited to a region, see RegionFromMsg
+/// \param[in] _msg Request
+/// \return True if it has a region, valid or not
+bool HasRegion(const gz::msgs::Marker &_msg)
+{
+  return _msg.has_header() &&
+      (!HeaderValue(_msg.header(), "region_min").empty() ||
+       !HeaderValue(_msg.header(), "region_max").empty());
+}
+
+/// \brief Get the region of a request, from the "region_min" and
+/// "region_max" keys of its header data, each holding "x y z".
+/// \param[in] _msg Request
+/// \param[out] _region Region, if it's given
+/// \param[out] _given True if the request has a region
+/// \return False if the region is given but invalid
+bool RegionFromMsg(const gz::msgs::Marker &_msg,
+    gz::math::AxisAlignedBox &_region, bool &_given)
+{
+  _given = HasRegion(_msg);
+  if (!_given)
+    return true;
+
+  std::string minValue = HeaderValue(_msg.header(), "region_min");
+  std::string maxValue = HeaderValue(_msg.header(), "region_max");
+  gz::math::Vector3d min;
+  gz::math::Vector3d max;
+  std::istringstream minStream(minValue);
+  std::istringstream maxStream(maxValue);
+  if (!(minStream >> min) || !(maxStream >> max))
+  {
+    gzerr << "Invalid marker region [" << minValue << "] to [" << maxValue
+           << "], expected [x y z] for both region_min and region_max"
+           << std::endl;
+    return false;
+  }
+  _region = gz::math::AxisAlignedBox(min, max);
+  return true;
+}
+
+/// \brief Get the bounds of the points of a marker message
+/// \param[in] _msg Marker message
+/// \param[in] _points Points to use instead of the message's points, if
+/// not null
+/// \return Bounds in the marker's frame, empty if there are no points
+gz::math::AxisAlignedBox PointBounds(const gz::msgs::Marker &_msg,
+    const MarkerPoints *_points)
+{
+  gz::math::AxisAlignedBox bounds;
+  if (nullptr != _points)
+  {
+    for (const auto &point : _points->points)
+      bounds.Merge(gz::math::AxisAlignedBox(point, point));
+    return bounds;
+  }
+
+  for (const auto &msgPoint : _msg.point())
+  {
+    gz::math::Vector3d point(msgPoint.x(), msgPoint.y(), msgPoint.z());
+    bounds.Merge(gz::math::AxisAlignedBox(point, point));
+  }
+  return bounds;
+}
+
+/// \brief Whether a box is empty, like a default constructed box
+/// \param[in] _box Box
+/// \return True if it's empty
+bool IsEmpty(const gz::math::AxisAlignedBox &_box)
+{
+  return _box.Min().X() > _box.Max().X() ||
+      _box.Min().Y() > _box.Max().Y() || _box.Min().Z() > _box.Max().Z();
+}
+
+/// \brief Get the world bounds of a marker
+/// \param[in] _entry Listing of the marker
+/// \param[in] _points Bounds of the marker's points, in its frame
+/// \return Bounds, empty if the marker has a parent, since its pose is
+/// relative to it, or if it has no points and needs some
+gz::math::AxisAlignedBox MarkerBounds(const gz::msgs::Marker &_entry,
+    const gz::math::AxisAlignedBox &_points)
+{
+  if (!_entry.parent().empty())
+    return gz::math::AxisAlignedBox();
+
+  gz::math::Vector3d scale = _entry.has_scale() ?
+      gz::msgs::Convert(_entry.scale()) : gz::math::Vector3d::One;
+
+  gz::math::AxisAlignedBox local;
+  switch (_entry.type())
+  {
+    case gz::msgs::Marker::LINE_LIST:
+    case gz::msgs::Marker::LINE_STRIP:
+    case gz::msgs::Marker::TRIANGLE_FAN:
+    case gz::msgs::Marker::TRIANGLE_LIST:
+    case gz::msgs::Marker::TRIANGLE_STRIP:
+      if (IsEmpty(_points))
+        return local;
+      // The box orders the corners, which negative scales swap
+      local = gz::math::AxisAlignedBox(_points.Min() * scale,
+          _points.Max() * scale);
+      break;
+    case gz::msgs::Marker::POINTS:
+      // The scale is the size of the points
+      if (IsEmpty(_points))
+        return local;
+      local = gz::math::AxisAlignedBox(_points.Min() - scale.Abs() * 0.5,
+          _points.Max() + scale.Abs() * 0.5);
+      break;
+    default:
+      // Shapes fit in a unit box, tweaked by the scale
+      local = gz::math::AxisAlignedBox(scale.Abs() * -0.5,
+          scale.Abs() * 0.5);
+      break;
+  }
+
+  gz::math::Pose3d pose;
+  if (_entry.has_pose())
+  {
+    pose = gz::msgs::Convert(_entry.pose());
+    pose.Correct();
+  }
+
+  gz::math::AxisAlignedBox bounds;
+  for (int i = 0; i < 8; ++i)
+  {
+    gz::math::Vector3d corner(
+        (i & 1) ? local.Max().X() : local.Min().X(),
+        (i & 2) ? local.Max().Y() : local.Min().Y(),
+        (i & 4) ? local.Max().Z() : local.Min().Z());
+    corner = pose.CoordPositionAdd(corner);
+    bounds.Merge(gz::math::AxisAlignedBox(corner, corner));
+  }
+  return bounds;
+}
+
+/// \brief Apply an ADD_MODIFY message to the listing of a marker
+/// \param[in,out] _entry Listing of the marker
+/// \param[in] _msg The message data
+void MergeListing(gz::msgs::Marker &_entry, const gz::msgs::Marker &_msg)
+{
+  if (_msg.type() != gz::msgs::Marker::NONE)
+    _entry.set_type(_msg.type());
+  if (_msg.has_lifetime())
+    *_entry.mutable_lifetime() = _msg.lifetime();
+  if (_msg.has_pose())
+    *_entry.mutable_pose() = _msg.pose();
+  if (_msg.has_scale())
+    *_entry.mutable_scale() = _msg.scale();
+  if (_msg.has_material())
+    *_entry.mutable_material() = _msg.material();
+  if (!_msg.parent().empty())
+    _entry.set_parent(_msg.parent());
+}
+
+/// \brief Whether a marker has a lifetime
+/// \param[in] _msg Marker message or listing
+/// \return True if it has a lifetime which isn't zero
+bool HasLifetime(const gz::msgs::Marker &_msg)
+{
+  return _msg.has_lifetime() &&
+      (_msg.lifetime().sec() != 0 || _msg.lifetime().nsec() != 0);
+}
+
+/// \brief Find a field of a packed point cloud
+/// \param[in] _msg Point cloud message
+/// \param[in] _name Field name
+/// \return Field, null if not found
+const gz::msgs::PointCloudPacked_Field *PackedField(
+    const gz::msgs::PointCloudPacked &_msg, const std::string &_name)
+{
+  for (const auto &field : _msg.field())
+  {
+    if (field.name() == _name)
+      return &field;
+  }
+  return nullptr;
+}
+
+/// \brief Fill the fields of a marker modification which keep the
+/// marker's current value when unset, from an earlier modification that
+/// it supersedes.
+/// \param[in] _older Earlier message
+/// \param[in,out] _newer Later message
+void MergeMarker(const gz::msgs::Marker &_older, gz::msgs::Marker &_newer)
+{
+  if (_newer.type() == gz::msgs::Marker::NONE)
+    _newer.set_type(_older.type());
+  if (!_newer.has_scale() && _older.has_scale())
+    *_newer.mutable_scale() = _older.scale();
+  if (!_newer.has_pose() && _older.has_pose())
+    *_newer.mutable_pose() = _older.pose();
+  if (_newer.parent().empty())
+    _newer.set_parent(_older.parent());
+  if (!_newer.has_material() && _older.has_material())
+    *_newer.mutable_material() = _older.material();
+
+  // Points and their colors are only replaced when points are given
+  if (_newer.point_size() == 0)
+  {
+    *_newer.mutable_point() = _older.point();
+    if (_newer.materials_size() == 0)
+      *_newer.mutable_materials() = _older.materials();
+    if (!IsAppend(_older))
+      ClearAppend(_newer);
+    else if (!IsAppend(_newer))
+      _newer.mutable_header()->add_data()->set_key("append");
+  }
+  // Appended points go after the older message's points, and the result
+  // only appends if the older message did
+  else if (IsAppend(_newer) && _older.point_size() > 0)
+  {
+    auto defaultColor = _newer.material().diffuse();
+    gz::msgs::Marker merged;
+    *merged.mutable_point() = _older.point();
+    for (int i = 0; i < _older.point_size(); ++i)
+    {
+      *merged.add_materials()->mutable_diffuse() =
+          i < _older.materials_size() ? _older.materials(i).diffuse() :
+          _older.material().diffuse();
+    }
+    for (int i = 0; i < _newer.point_size(); ++i)
+    {
+      *merged.add_point() = _newer.point(i);
+      *merged.add_materials()->mutable_diffuse() =
+          i < _newer.materials_size() ? _newer.materials(i).diffuse() :
+          defaultColor;
+    }
+    _newer.mutable_point()->Swap(merged.mutable_point());
+    _newer.mutable_materials()->Swap(merged.mutable_materials());
+    if (!IsAppend(_older))
+      ClearAppend(_newer);
+  }
+}
+}
+
 /// \brief Private data class for MarkerManager
 class gz::gui::plugins::MarkerManagerPrivate
 {
   /// \brief Update markers based on msgs received
   public: void OnRender();
 
+  /// \brief Let the 3D scenes know that marker messages are waiting, so
+  /// that they render a frame even when they've stopped rendering while
+  /// idle, which means OnRender isn't called. Only posts once until the
+  /// next OnRender.
+  public: void NotifyMarkersReady();
+
   /// \brief Initialize services and subcriptions
   public: void Initialize();
 
+  /// \brief Loop of the worker thread, which decodes queued marker
+  /// messages and hands them over to the render thread.
+  public: void ProcessWorker();
+
+  /// \brief Stop the worker thread and wait for it to finish.
+  public: void StopWorker();
+
   /// \brief Processes a marker message.
   /// \param[in] _msg The message data.
+  /// \param[in] _warn False to not warn if the action fails, regardless of
+  /// warnOnActionFailure.
   /// \return True if the marker was processed successfully.
-  public: bool ProcessMarkerMsg(const gz::msgs::Marker &_msg);
+  /// \param[in] _points Points to use instead of the message's points, if
+  /// not null.
+  public: bool ProcessMarkerMsg(const gz::msgs::Marker &_msg,
+      bool _warn = true, const MarkerPoints *_points = nullptr);
+
+  /// \brief Queue a marker message, replacing queued messages that it
+  /// supersedes. Must be called with mutex locked.
+  /// \param[in] _msg The message data.
+  /// \param[in] _points Points decoded from a packed message, if any.
+  public: void QueueMarkerMsg(const gz::msgs::Marker &_msg,
+      std::shared_ptr<const MarkerPoints> _points = nullptr);
+
+  /// \brief Append to markerMsgs, applying the limit of markerQueue.
+  /// Must be called with mutex locked.
+  /// \param[in] _queued Message to queue
+  /// \return False if it was dropped
+  public: bool PushMarkerMsg(QueuedMarker &&_queued);
+
+  /// \brief Get the queued ADD_MODIFY message of a namespace and id.
+  /// Must be called with mutex locked.
+  /// \param[in] _key Namespace and id
+  /// \return Queued message, null if there's none
+  public: QueuedMarker *QueuedModification(
+      const std::pair<std::string, uint64_t> &_key);
+
+  /// \brief Callback that receives markers as packed point clouds.
+  /// \param[in] _req Points, with the marker's namespace, id, type and
+  /// size in the header data
+  /// \param[in] _res Response data
+  /// \return True if the request is valid
+  public: bool OnPackedMarker(const gz::msgs::PointCloudPacked &_req,
+              gz::msgs::Boolean &_res);
 
   /// \brief Services callback that returns a list of markers.
   /// \param[out] _rep Service reply
   /// \return True on success.
   public: bool OnList(gz::msgs::Marker_V &_rep);
 
+  /// \brief Services callback that returns a page of markers.
+  /// \param[in] _req Namespace to list, if not empty, with the page token,
+  /// page size and whether to return full data in the header data
+  /// \param[out] _rep Service reply, with the token of the next page in the
+  /// header data if there are more markers
+  /// \return True on success.
+  public: bool OnListPage(const gz::msgs::Marker &_req,
+                          gz::msgs::Marker_V &_rep);
+
+  /// \brief Update the listing of a marker after an ADD_MODIFY message.
+  /// \param[in] _ns Namespace of the marker.
+  /// \param[in] _id Id of the marker.
+  /// \param[in] _msg The message data.
+  /// \param[in] _points Points to use instead of the message's points, if
+  /// not null.
+  public: void UpdateListing(const std::string &_ns, uint64_t _id,
+                             const gz::msgs::Marker &_msg,
+                             const MarkerPoints *_points);
+
+  /// \brief Remove a marker from the listing.
+  /// \param[in] _ns Namespace of the marker.
+  /// \param[in] _id Id of the marker.
+  public: void EraseListing(const std::string &_ns, uint64_t _id);
+
+  /// \brief Remove all markers of a namespace from the listing, or all
+  /// markers if the namespace is empty.
+  /// \param[in] _ns Namespace.
+  public: void ClearListing(const std::string &_ns);
+
+  /// \brief Delete the markers in the region of a DELETE_ALL message,
+  /// only from its namespace if it has one.
+  /// \param[in] _msg The message data.
+  /// \return False if the region is invalid.
+  public: bool DeleteRegion(const gz::msgs::Marker &_msg);
+
+  /// \brief Keep an ADD_MODIFY message of a marker which stays out of
+  /// view, instead of applying it, until the marker comes into view.
+  /// \param[in,out] _queued Message, moved from if it's kept
+  /// \return True if it's kept
+  public: bool DeferOffscreen(QueuedMarker &_queued);
+
+  /// \brief Apply or drop the deferred message of the markers a message
+  /// applies to, before it's applied.
+  /// \param[in] _msg The message data.
+  public: void ResolveCulled(const gz::msgs::Marker &_msg);
+
+  /// \brief Apply the deferred messages of markers which came into view.
+  /// \return True if any was applied.
+  public: bool ApplyCulled();
+
+  /// \brief Get the user camera, found the first time it's needed.
+  /// \return Camera, null if the scene has none yet
+  public: rendering::CameraPtr UserCamera();
+
   /// \brief Callback that receives marker messages.
   /// \param[in] _req The marker message.
   public: void OnMarkerMsg(const gz::msgs::Marker &_req);
 
+  /// \brief Callback with all the markers of the host cache, which are
+  /// compared to the previous ones
+  /// \param[in] _view Markers
+  public: void OnHostMarkers(const SharedMemoryView &_view);
+
   /// \brief Callback that receives multiple marker messages.
   /// \param[in] _req The vector of marker messages
   /// \param[in] _res Response data
@@ -79,9 +785,6 @@ class gz::gui::plugins::MarkerManagerPrivate
   public: bool OnMarkerMsgArray(const gz::msgs::Marker_V &_req,
               gz::msgs::Boolean &_res);
 
-  /// \brief Subscriber callback when new world statistics are received
-  public: void OnWorldStatsMsg(const gz::msgs::WorldStatistics &_msg);
-
   /// \brief Sets Visual from marker message.
   /// \param[in] _msg The message data.
   /// \param[out] _visualPtr The visual pointer to set.
@@ -91,8 +794,11 @@ class gz::gui::plugins::MarkerManagerPrivate
   /// \brief Sets Marker from marker message.
   /// \param[in] _msg The message data.
   /// \param[out] _markerPtr The message pointer to set.
+  /// \param[in] _points Points to use instead of the message's points, if
+  /// not null.
   public: void SetMarker(const gz::msgs::Marker &_msg,
-                         const rendering::MarkerPtr &_markerPtr);
+                         const rendering::MarkerPtr &_markerPtr,
+                         const MarkerPoints *_points = nullptr);
 
   /// \brief Converts a Gazebo msg material to Gazebo Rendering
   //         material.
@@ -101,6 +807,69 @@ class gz::gui::plugins::MarkerManagerPrivate
   public: rendering::MaterialPtr MsgToMaterial(
     const gz::msgs::Marker &_msg);
 
+  /// \brief Set the material of a marker, sharing it with the other
+  /// markers which have the same material properties.
+  /// \param[in] _msg The message data.
+  /// \param[in] _markerPtr The marker to update.
+  public: void SetMarkerMaterial(const gz::msgs::Marker &_msg,
+                                 const rendering::MarkerPtr &_markerPtr);
+
+  /// \brief Release the shared material of a marker, destroying it when
+  /// no other marker uses it.
+  /// \param[in] _marker The marker.
+  public: void ReleaseMaterial(const rendering::Marker *_marker);
+
+  /// \brief Set the points of a marker, only updating what changed when
+  /// the new points extend or modify the current ones in place.
+  /// \param[in] _points New points.
+  /// \param[in] _append True to append to the current points.
+  /// \param[in] _markerPtr The marker to update.
+  public: void SetPoints(const MarkerPoints &_points, bool _append,
+                         const rendering::MarkerPtr &_markerPtr);
+
+  /// \brief Process a marker message for a namespace which is batched.
+  /// \param[in] _msg The message data.
+  /// \param[in] _ns Namespace of the marker.
+  /// \param[in] _id Id of the marker.
+  /// \param[in] _points Points to use instead of the message's points, if
+  /// not null.
+  /// \return True if the message was handled by the batch, false if the
+  /// marker must be a visual of its own.
+  public: bool ProcessBatchedMsg(const gz::msgs::Marker &_msg,
+      const std::string &_ns, uint64_t _id, const MarkerPoints *_points);
+
+  /// \brief Remove a marker from its namespace's batch.
+  /// \param[in] _ns Namespace of the marker.
+  /// \param[in] _id Id of the marker.
+  /// \return True if the marker was batched.
+  public: bool EraseBatchedMarker(const std::string &_ns, uint64_t _id);
+
+  /// \brief Remove all markers from a namespace's batch, or from all
+  /// batches if the namespace is empty.
+  /// \param[in] _ns Namespace.
+  /// \return True if any batch was cleared.
+  public: bool ClearBatches(const std::string &_ns);
+
+  /// \brief Rebuild the merged geometry of the batches which changed,
+  /// and the text of the batches whose text faces the camera when the
+  /// camera turned.
+  public: void UpdateBatches();
+
+  /// \brief Rebuild the glyph strokes of a batch's TEXT markers.
+  /// \param[in] _batch Batch, with its visual created.
+  /// \param[in] _rotation Camera rotation the text faces.
+  public: void UpdateBatchText(MarkerBatch &_batch,
+      const gz::math::Quaterniond &_rotation);
+
+  /// \brief Destroy the visual of a marker.
+  /// \param[in] _visual Marker visual
+  public: void DestroyMarkerVisual(const rendering::VisualPtr &_visual);
+
+  /// \brief Remove a marker if it still expires at the given time.
+  /// \param[in] _expiry Expiry of the marker
+  /// \return True if the marker was removed
+  public: bool ExpireMarker(const MarkerExpiry &_expiry);
+
   /// \brief Converts a Gazebo msg render type to Gazebo Rendering
   /// \param[in] _msg The message data
   /// \return Converted rendering type, if any.
@@ -110,24 +879,170 @@ class gz::gui::plugins::MarkerManagerPrivate
   //// \brief Pointer to the rendering scene
   public: rendering::ScenePtr scene{nullptr};
 
-  /// \brief Mutex to protect message list.
+  /// \brief Camera which batched text faces, found on the first batch with
+  /// text
+  public: rendering::CameraPtr camera{nullptr};
+
+  /// \brief Mutex to protect message list, sim time and the worker state.
   public: std::mutex mutex;
 
-  /// \brief List of marker message to process.
-  public: std::list<gz::msgs::Marker> markerMsgs;
+  /// \brief Notified when marker messages are handed to the worker or the
+  /// worker should stop.
+  public: std::condition_variable workerCv;
+
+  /// \brief Marker messages handed to the worker by the render thread, to
+  /// be decoded.
+  public: std::deque<QueuedMarker> decodeMsgs;
+
+  /// \brief Thread decoding queued marker messages.
+  public: std::thread worker;
+
+  /// \brief True to stop the worker thread.
+  public: bool stopWorker{false};
+
+  /// \brief Sequence number of the last synchronous marker array request.
+  public: uint64_t syncSequence{0};
+
+  /// \brief Mutex to protect appliedSequence.
+  public: std::mutex appliedMutex;
+
+  /// \brief Notified when a synchronous marker array request was applied.
+  public: std::condition_variable appliedCv;
+
+  /// \brief Sequence number of the last synchronous marker array request
+  /// which was applied.
+  public: uint64_t appliedSequence{0};
+
+  /// \brief Time a synchronous marker array request waits for its markers
+  /// to be applied before failing.
+  public: std::chrono::milliseconds syncTimeout{1000};
+
+  /// \brief Mutex to protect readyMsgs.
+  public: std::mutex readyMutex;
+
+  /// \brief True once NotifyMarkersReady posted, until the next OnRender
+  public: std::atomic<bool> markersReady{false};
+
+  /// \brief Marker messages decoded by the worker, waiting to be picked up
+  /// by the render thread.
+  public: std::vector<QueuedMarker> readyMsgs;
+
+  /// \brief Decoded marker messages owned by the render thread, still to
+  /// be applied to the scene.
+  public: std::deque<QueuedMarker> applyMsgs;
+
+  /// \brief Time the render thread may spend applying marker messages
+  /// each frame. Zero or negative means no limit.
+  public: std::chrono::duration<double, std::milli> processBudget{5.0};
+
+  /// \brief Mutex to protect visuals, so the list service can read them
+  /// while the render thread updates them.
+  public: std::mutex visualsMutex;
+
+  /// \brief Marker messages to process, in the order they were received.
+  public: std::deque<QueuedMarker> markerMsgs;
+
+  /// \brief Number of messages taken from the front of markerMsgs so far,
+  /// so dropping the oldest doesn't invalidate queuedModifications.
+  public: std::size_t markerBase{0};
+
+  /// \brief Estimated bytes of markerMsgs
+  public: std::size_t markerBytes{0};
+
+  /// \brief Messages dropped from markerMsgs because of its limit
+  public: uint64_t markerDrops{0};
+
+  /// \brief Reports markerMsgs to QueueStats
+  public: QueueStats::Queue markerQueue{"MarkerManager/markers", true};
+
+  /// \brief Position of the queued ADD_MODIFY message of each namespace
+  /// and id, markerBase being the position of the front of markerMsgs.
+  public: std::map<std::pair<std::string, uint64_t>, std::size_t>
+      queuedModifications;
 
   /// \brief Map of visuals
   public: std::map<std::string,
       std::map<uint64_t, gz::rendering::VisualPtr>> visuals;
 
+  /// \brief Points currently set on each marker
+  public: std::unordered_map<const rendering::Marker *, MarkerPoints>
+      markerPoints;
+
+  /// \brief Namespaces whose BOX, LINE_LIST and TEXT markers are batched
+  public: std::set<std::string> batchNamespaces;
+
+  /// \brief Batched markers, by namespace
+  public: std::map<std::string, MarkerBatch> batches;
+
+  /// \brief Shared materials, by the serialized material message
+  public: std::unordered_map<std::string, SharedMaterial> materials;
+
+  /// \brief Key in materials of the material used by each marker
+  public: std::unordered_map<const rendering::Marker *, std::string>
+      markerMaterials;
+
+  /// \brief Expiry times of markers with a lifetime, soonest first.
+  /// Entries of markers which were modified or deleted since are skipped
+  /// when they reach the top.
+  public: std::priority_queue<MarkerExpiry, std::vector<MarkerExpiry>,
+      std::greater<MarkerExpiry>> expiries;
+
   /// \brief Gazebo node
   public: gz::transport::Node node;
 
+  /// \brief Node for the paged list service, which shares its name with
+  /// the list service but takes a request.
+  public: gz::transport::Node listNode;
+
+  /// \brief Mutex to protect listing.
+  public: std::mutex listMutex;
+
+  /// \brief Properties of all markers except their points, by namespace
+  /// and id. Kept by the render thread so the list services don't need
+  /// the scene.
+  public: std::map<std::pair<std::string, uint64_t>, gz::msgs::Marker>
+      listing;
+
+  /// \brief World bounds of the markers of the listing, for region
+  /// queries. Protected by listMutex.
+  public: MarkerIndex index;
+
+  /// \brief Bounds of the points of the markers of the listing, in their
+  /// frame. Protected by listMutex.
+  public: std::map<MarkerIndex::Key, gz::math::AxisAlignedBox> pointBounds;
+
+  /// \brief True to defer the updates of markers out of view
+  public: bool cullOffscreen{false};
+
+  /// \brief Camera view of the current frame, valid if hasFrustum is true
+  public: gz::math::Frustum frustum;
+
+  /// \brief True if offscreen markers are culled this frame
+  public: bool hasFrustum{false};
+
+  /// \brief Deferred ADD_MODIFY messages of markers out of view, see
+  /// DeferOffscreen
+  public: std::map<MarkerIndex::Key, QueuedMarker> culled;
+
+  /// \brief Bounds of the markers of culled, both where they're rendered
+  /// and where they're going
+  public: MarkerIndex culledIndex;
+
+  /// \brief Markers returned per page by the paged list service if the
+  /// request doesn't give a page size.
+  public: static constexpr std::size_t kListPageSize{1000};
+
   /// \brief Topic name for the marker service
   public: std::string topicName = "/marker";
 
-  /// \brief Sim time according to world stats message
-  public: std::chrono::steady_clock::duration simTime;
+  /// \brief World statistics shared with other plugins, to set lifetimes
+  /// and expire markers. Protected by mutex, since it's set after the
+  /// render hook may run.
+  public: std::shared_ptr<SimClock> clock;
+
+  /// \brief Sim time copied by the render thread at the start of the
+  /// frame, used to set lifetimes and expire markers.
+  public: std::chrono::steady_clock::duration frameSimTime;
 
   /// \brief Previous sim time received
   public: std::chrono::steady_clock::duration lastSimTime;
@@ -138,156 +1053,892 @@ class gz::gui::plugins::MarkerManagerPrivate
   /// \brief True to print console warnings if the user tries to perform an
   /// action with an inexistent marker.
   public: bool warnOnActionFailure{true};
+
+  /// \brief Render hook identifier
+  public: uint64_t renderHookId{0};
+
+  /// \brief True to read the markers from a HostSceneCache
+  public: bool hostCache{false};
+
+  /// \brief Markers written by the host cache
+  public: SharedMemorySubscriber hostMarkers;
+
+  /// \brief Serialized markers last read from the host cache, to only
+  /// apply those which changed. Only accessed by the host cache callback.
+  public: std::map<MarkerIndex::Key, std::string> hostState;
+
+  /// \brief Topic of this manager among the shared managers, empty if it
+  /// isn't shared, see sharedManagers
+  public: std::string sharedKey;
 };
 
 using namespace gz;
 using namespace gui;
 using namespace plugins;
 
+namespace
+{
+  /// \brief Marker managers loaded in the process
+  struct SharedManagers
+  {
+    /// \brief Protects managers
+    std::mutex mutex;
+
+    /// \brief Data of each manager, by marker topic
+    std::map<std::string, std::weak_ptr<MarkerManagerPrivate>> managers;
+  };
+
+  /////////////////////////////////////////////////
+  /// \brief Managers shared by the plugins of all windows, so that the
+  /// markers of each topic are only received and created once
+  SharedManagers &sharedManagers()
+  {
+    static SharedManagers instance;
+    return instance;
+  }
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::Initialize()
+{
+  if (!this->scene)
+  {
+    gzerr << "Scene pointer is invalid" << std::endl;
+    return;
+  }
+
+  if (!this->worker.joinable())
+    this->worker = std::thread(&MarkerManagerPrivate::ProcessWorker, this);
+
+  if (this->topicName.empty())
+  {
+    gzerr << "Unable to advertise marker service. Topic name empty."
+           << std::endl;
+    return;
+  }
+
+  // Read only, the cache serves the marker services
+  if (this->hostCache)
+  {
+    if (this->hostMarkers.Subscribe(this->topicName + "/host_cache",
+        [this](const SharedMemoryView &_view) {this->OnHostMarkers(_view);}))
+    {
+      gzmsg << "Reading the markers of [" << this->topicName << "] from the "
+            << "host scene cache" << std::endl;
+      return;
+    }
+    gzwarn << "No host scene cache for [" << this->topicName << "], "
+           << "advertising the marker services instead" << std::endl;
+  }
+
+  // Advertise the list service
+  if (!this->node.Advertise(this->topicName + "/list",
+      &MarkerManagerPrivate::OnList, this))
+  {
+    gzerr << "Unable to advertise to the " << this->topicName
+           << "/list service.\n";
+  }
+
+  if (!this->listNode.Advertise(this->topicName + "/list",
+      &MarkerManagerPrivate::OnListPage, this))
+  {
+    gzerr << "Unable to advertise to the " << this->topicName
+           << "/list service with a request.\n";
+  }
+
+  gzdbg << "Advertise " << this->topicName << "/list service.\n";
+
+  // Advertise to the marker service
+  if (!this->node.Advertise(this->topicName,
+        &MarkerManagerPrivate::OnMarkerMsg, this))
+  {
+    gzerr << "Unable to advertise to the " << this->topicName
+           << " service.\n";
+  }
+
+  gzdbg << "Advertise " << this->topicName << "/list.\n";
+
+  // Advertise to the marker_array service
+  if (!this->node.Advertise(this->topicName + "_array",
+        &MarkerManagerPrivate::OnMarkerMsgArray, this))
+  {
+    gzerr << "Unable to advertise to the " << this->topicName
+           << "_array service.\n";
+  }
+
+  gzdbg << "Advertise " << this->topicName << "_array.\n";
+
+  // Advertise to the marker_packed service
+  if (!this->node.Advertise(this->topicName + "_packed",
+        &MarkerManagerPrivate::OnPackedMarker, this))
+  {
+    gzerr << "Unable to advertise to the " << this->topicName
+           << "_packed service.\n";
+  }
+
+  gzdbg << "Advertise " << this->topicName << "_packed.\n";
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::OnRender()
+{
+  GZ_GUI_PROFILE("MarkerManager::OnRender");
+  if (!this->scene)
+  {
+    this->scene = rendering::sceneFromFirstRenderEngine();
+    if (nullptr == this->scene)
+      return;
+
+    this->Initialize();
+  }
+
+  if (!RenderHooks::RunsFor(this->scene->Name()))
+    return;
+
+  // Markers received or decoded from now on post again
+  this->markersReady = false;
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->clock)
+    {
+      // Real time is used by worlds which don't have a sim time
+      auto stats = this->clock->Latest();
+      if (stats.hasSimTime)
+        this->frameSimTime = stats.simTime;
+      else if (stats.hasRealTime)
+        this->frameSimTime = stats.realTime;
+    }
+
+    // The messages received until this frame are decoded all at once, so
+    // that the modifications of a marker within a frame are merged into
+    // one. They're applied on one of the next frames.
+    if (!this->markerMsgs.empty())
+    {
+      for (auto &queued : this->markerMsgs)
+        this->decodeMsgs.push_back(std::move(queued));
+      this->markerBase += this->markerMsgs.size();
+      this->markerMsgs.clear();
+      this->markerBytes = 0u;
+      this->markerQueue.Update(0u, 0u);
+      this->queuedModifications.clear();
+      this->workerCv.notify_one();
+    }
+  }
+
+  // Pick up the messages decoded by the worker
+  {
+    std::lock_guard<std::mutex> lock(this->readyMutex);
+    for (auto &queued : this->readyMsgs)
+      this->applyMsgs.push_back(std::move(queued));
+    this->readyMsgs.clear();
+  }
+
+  std::lock_guard<std::mutex> lock(this->visualsMutex);
+  bool changed = !this->applyMsgs.empty();
+
+  // Markers out of this frame's view are culled
+  this->hasFrustum = false;
+  if (this->cullOffscreen)
+  {
+    auto camera = this->UserCamera();
+    if (nullptr != camera)
+    {
+      this->frustum = gz::math::Frustum(camera->NearClipPlane(),
+          camera->FarClipPlane(), camera->HFOV(), camera->AspectRatio(),
+          camera->WorldPose());
+      this->hasFrustum = true;
+    }
+  }
+
+  // Apply the marker messages, leaving the rest for the next frames once
+  // the budget is used up. At least one message is applied each frame.
+  auto start = std::chrono::steady_clock::now();
+  while (!this->applyMsgs.empty())
+  {
+    const auto &queued = this->applyMsgs.front();
+    if (queued.barrier != 0u)
+    {
+      {
+        std::lock_guard<std::mutex> appliedLock(this->appliedMutex);
+        this->appliedSequence = queued.barrier;
+      }
+      this->appliedCv.notify_all();
+      this->applyMsgs.pop_front();
+      continue;
+    }
+
+    if (this->hasFrustum && this->DeferOffscreen(this->applyMsgs.front()))
+    {
+      this->applyMsgs.pop_front();
+      continue;
+    }
+
+    this->ProcessMarkerMsg(queued.msg, queued.warn, queued.points.get());
+    this->applyMsgs.pop_front();
+
+    if (this->processBudget.count() > 0 &&
+        std::chrono::steady_clock::now() - start >= this->processBudget)
+    {
+      break;
+    }
+  }
+
+  if (this->hasFrustum && !this->culled.empty())
+    changed = this->ApplyCulled() || changed;
+
+  this->UpdateBatches();
+
+  // Erase markers whose lifetime is over. All markers with a lifetime
+  // expire when sim time goes backwards, e.g. on reset.
+  bool reset = this->frameSimTime < this->lastSimTime;
+  while (!this->expiries.empty() &&
+      (reset || this->expiries.top().time <= this->frameSimTime))
+  {
+    changed = this->ExpireMarker(this->expiries.top()) || changed;
+    this->expiries.pop();
+  }
+  this->lastSimTime = this->frameSimTime;
+
+  // Let scenes which skip unchanged frames know they need to render
+  if (changed)
+  {
+    events::SceneChanged sceneChangedEvent;
+    App()->sendEvent(App()->MainWin(), &sceneChangedEvent);
+  }
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::ProcessWorker()
+{
+  GZ_GUI_PROFILE_THREAD_NAME("Marker worker");
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    this->workerCv.wait(lock, [this]
+    {
+      return this->stopWorker || !this->decodeMsgs.empty();
+    });
+    if (this->stopWorker)
+      return;
+
+    std::deque<QueuedMarker> msgs;
+    msgs.swap(this->decodeMsgs);
+    lock.unlock();
+
+    // Decode points here so the render thread only has to apply them
+    std::vector<QueuedMarker> ready;
+    ready.reserve(msgs.size());
+    for (auto &queued : msgs)
+    {
+      if (!queued.valid)
+        continue;
+
+      if (nullptr == queued.points && queued.msg.point_size() > 0)
+      {
+        queued.points = std::make_shared<const MarkerPoints>(
+            PointsFromMsg(queued.msg));
+        queued.msg.clear_point();
+      }
+      ready.push_back(std::move(queued));
+    }
+
+    {
+      std::lock_guard<std::mutex> readyLock(this->readyMutex);
+      for (auto &queued : ready)
+        this->readyMsgs.push_back(std::move(queued));
+    }
+    if (!ready.empty())
+      this->NotifyMarkersReady();
+
+    lock.lock();
+  }
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::NotifyMarkersReady()
+{
+  if (this->markersReady.exchange(true))
+    return;
+
+  // Delivered on the GUI thread, which wakes up idle scenes
+  if (App() && App()->MainWin())
+    QCoreApplication::postEvent(App()->MainWin(), new events::SceneChanged());
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::StopWorker()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stopWorker = true;
+  }
+  this->workerCv.notify_all();
+  if (this->worker.joinable())
+    this->worker.join();
+}
+
+/////////////////////////////////////////////////
+bool MarkerManagerPrivate::OnList(gz::msgs::Marker_V &_rep)
+{
+  _rep.clear_marker();
+
+  std::lock_guard<std::mutex> lock(this->listMutex);
+  _rep.mutable_marker()->Reserve(static_cast<int>(this->listing.size()));
+  for (const auto &entry : this->listing)
+  {
+    gz::msgs::Marker *markerMsg = _rep.add_marker();
+    markerMsg->set_ns(entry.second.ns());
+    markerMsg->set_id(entry.second.id());
+    markerMsg->set_type(entry.second.type());
+    if (entry.second.has_lifetime())
+      *markerMsg->mutable_lifetime() = entry.second.lifetime();
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool MarkerManagerPrivate::OnListPage(const gz::msgs::Marker &_req,
+    gz::msgs::Marker_V &_rep)
+{
+  _rep.clear_marker();
+
+  std::size_t pageSize{kListPageSize};
+  bool full{false};
+  std::pair<std::string, uint64_t> start{_req.ns(), 0u};
+  bool resume{false};
+  if (_req.has_header())
+  {
+    std::string value = HeaderValue(_req.header(), "page_size");
+    if (!value.empty())
+    {
+      try
+      {
+        pageSize = std::stoul(value);
+      }
+      catch (...)
+      {
+        gzerr << "Invalid marker list page size [" << value << "]"
+               << std::endl;
+        return false;
+      }
+    }
+
+    value = HeaderValue(_req.header(), "full");
+    full = !value.empty() && value != "false";
+
+    // The page token is the id and namespace of the last marker returned
+    std::string token = HeaderValue(_req.header(), "page_token");
+    if (!token.empty())
+    {
+      auto sep = token.find(':');
+      try
+      {
+        if (sep == std::string::npos)
+          throw std::invalid_argument(token);
+        start = {token.substr(sep + 1), std::stoull(token.substr(0, sep))};
+        resume = true;
+      }
+      catch (...)
+      {
+        gzerr << "Invalid marker list page token [" << token << "]"
+               << std::endl;
+        return false;
+      }
+    }
+  }
+
+  gz::math::AxisAlignedBox region;
+  bool hasRegion{false};
+  if (!RegionFromMsg(_req, region, hasRegion))
+    return false;
+
+  // Add a marker to the page, false once it's full
+  const MarkerIndex::Key *last{nullptr};
+  auto add = [&](const MarkerIndex::Key &_key,
+      const gz::msgs::Marker &_entry)
+  {
+    if (pageSize > 0u && static_cast<std::size_t>(_rep.marker_size()) ==
+        pageSize)
+    {
+      auto data = _rep.mutable_header()->add_data();
+      data->set_key("next_page_token");
+      data->add_value(std::to_string(last->second) + ":" + last->first);
+      return false;
+    }
+    last = &_key;
+
+    gz::msgs::Marker *markerMsg = _rep.add_marker();
+    if (full)
+    {
+      *markerMsg = _entry;
+      return true;
+    }
+    markerMsg->set_ns(_entry.ns());
+    markerMsg->set_id(_entry.id());
+    markerMsg->set_type(_entry.type());
+    if (_entry.has_lifetime())
+      *markerMsg->mutable_lifetime() = _entry.lifetime();
+    return true;
+  };
+
+  std::lock_guard<std::mutex> lock(this->listMutex);
+
+  // Only the markers in the region are visited, in the same order
+  if (hasRegion)
+  {
+    auto keys = this->index.Query(region);
+    auto it = resume ? std::upper_bound(keys.begin(), keys.end(), start) :
+        std::lower_bound(keys.begin(), keys.end(), start);
+    for (; it != keys.end(); ++it)
+    {
+      if (!_req.ns().empty() && it->first != _req.ns())
+        break;
+
+      auto entry = this->listing.find(*it);
+      if (entry != this->listing.end() && !add(entry->first, entry->second))
+        break;
+    }
+    return true;
+  }
+
+  auto it = resume ? this->listing.upper_bound(start) :
+      this->listing.lower_bound(start);
+  for (; it != this->listing.end(); ++it)
+  {
+    if (!_req.ns().empty() && it->first.first != _req.ns())
+      break;
+
+    if (!add(it->first, it->second))
+      break;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::UpdateListing(const std::string &_ns,
+    uint64_t _id, const gz::msgs::Marker &_msg, const MarkerPoints *_points)
+{
+  MarkerIndex::Key key{_ns, _id};
+  std::lock_guard<std::mutex> lock(this->listMutex);
+  auto &entry = this->listing[key];
+  entry.set_ns(_ns);
+  entry.set_id(_id);
+  MergeListing(entry, _msg);
+
+  // Points are only replaced when points are given
+  auto &points = this->pointBounds[key];
+  if (nullptr != _points || _msg.point_size() > 0)
+  {
+    auto bounds = PointBounds(_msg, _points);
+    if (IsAppend(_msg))
+      points.Merge(bounds);
+    else
+      points = bounds;
+  }
+  this->index.Update(key, MarkerBounds(entry, points));
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::EraseListing(const std::string &_ns,
+    uint64_t _id)
+{
+  std::lock_guard<std::mutex> lock(this->listMutex);
+  this->listing.erase({_ns, _id});
+  this->pointBounds.erase({_ns, _id});
+  this->index.Erase({_ns, _id});
+}
+
 /////////////////////////////////////////////////
-void MarkerManagerPrivate::Initialize()
+void MarkerManagerPrivate::ClearListing(const std::string &_ns)
 {
-  if (!this->scene)
+  std::lock_guard<std::mutex> lock(this->listMutex);
+  this->index.Clear(_ns);
+  if (_ns.empty())
   {
-    gzerr << "Scene pointer is invalid" << std::endl;
+    this->listing.clear();
+    this->pointBounds.clear();
     return;
   }
 
-  if (this->topicName.empty())
-  {
-    gzerr << "Unable to advertise marker service. Topic name empty."
-           << std::endl;
+  auto it = this->listing.lower_bound({_ns, 0u});
+  while (it != this->listing.end() && it->first.first == _ns)
+    it = this->listing.erase(it);
+  auto pointsIt = this->pointBounds.lower_bound({_ns, 0u});
+  while (pointsIt != this->pointBounds.end() && pointsIt->first.first == _ns)
+    pointsIt = this->pointBounds.erase(pointsIt);
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::OnHostMarkers(const SharedMemoryView &_view)
+{
+  GZ_GUI_PROFILE_THREAD_NAME("Transport");
+  GZ_GUI_PROFILE("MarkerManager::OnHostMarkers");
+  gz::msgs::Marker_V msg;
+  if (!_view.Parse(msg))
     return;
+
+  // Markers which were added or modified
+  std::map<MarkerIndex::Key, std::string> state;
+  std::vector<const gz::msgs::Marker *> changed;
+  for (const auto &marker : msg.marker())
+  {
+    MarkerIndex::Key key(marker.ns(), marker.id());
+    auto data = marker.SerializeAsString();
+    auto it = this->hostState.find(key);
+    if (it == this->hostState.end() || it->second != data)
+      changed.push_back(&marker);
+    state[key] = std::move(data);
   }
 
-  // Advertise the list service
-  if (!this->node.Advertise(this->topicName + "/list",
-      &MarkerManagerPrivate::OnList, this))
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (const auto &entry : this->hostState)
   {
-    gzerr << "Unable to advertise to the " << this->topicName
-           << "/list service.\n";
+    if (state.find(entry.first) != state.end())
+      continue;
+
+    gz::msgs::Marker deleteMsg;
+    deleteMsg.set_ns(entry.first.first);
+    deleteMsg.set_id(entry.first.second);
+    deleteMsg.set_action(gz::msgs::Marker::DELETE_MARKER);
+    this->QueueMarkerMsg(deleteMsg);
   }
+  for (auto marker : changed)
+    this->QueueMarkerMsg(*marker);
+  this->NotifyMarkersReady();
 
-  gzdbg << "Advertise " << this->topicName << "/list service.\n";
+  this->hostState.swap(state);
+}
 
-  // Advertise to the marker service
-  if (!this->node.Advertise(this->topicName,
-        &MarkerManagerPrivate::OnMarkerMsg, this))
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::OnMarkerMsg(const gz::msgs::Marker &_req)
+{
+  GZ_GUI_PROFILE_THREAD_NAME("Transport");
+  GZ_GUI_PROFILE("MarkerManager::OnMarkerMsg");
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->QueueMarkerMsg(_req);
+  this->NotifyMarkersReady();
+}
+
+/////////////////////////////////////////////////
+bool MarkerManagerPrivate::OnMarkerMsgArray(
+    const gz::msgs::Marker_V&_req, gz::msgs::Boolean &_res)
+{
+  GZ_GUI_PROFILE_THREAD_NAME("Transport");
+  GZ_GUI_PROFILE("MarkerManager::OnMarkerMsgArray");
+  bool sync = IsSync(_req);
+  uint64_t sequence{0};
+  uint64_t drops{0};
   {
-    gzerr << "Unable to advertise to the " << this->topicName
-           << " service.\n";
+    std::lock_guard<std::mutex> lock(this->mutex);
+    drops = this->markerDrops;
+    for (const auto &marker : _req.marker())
+      this->QueueMarkerMsg(marker);
+
+    // Mark the end of the request, so the render thread can tell when all
+    // its markers have been applied
+    if (sync)
+    {
+      sequence = ++this->syncSequence;
+      QueuedMarker barrier;
+      barrier.barrier = sequence;
+      this->PushMarkerMsg(std::move(barrier));
+    }
+    this->NotifyMarkersReady();
   }
 
-  gzdbg << "Advertise " << this->topicName << "/list.\n";
+  if (!sync)
+  {
+    _res.set_data(true);
+    return true;
+  }
 
-  // Advertise to the marker_array service
-  if (!this->node.Advertise(this->topicName + "_array",
-        &MarkerManagerPrivate::OnMarkerMsgArray, this))
+  std::unique_lock<std::mutex> lock(this->appliedMutex);
+  bool applied = this->appliedCv.wait_for(lock, this->syncTimeout,
+      [this, sequence]{return this->appliedSequence >= sequence;});
+  if (!applied)
   {
-    gzerr << "Unable to advertise to the " << this->topicName
-           << "_array service.\n";
+    gzwarn << "Timed out waiting for [" << _req.marker_size()
+           << "] markers to be applied" << std::endl;
   }
+  lock.unlock();
 
-  gzdbg << "Advertise " << this->topicName << "_array.\n";
+  // Markers may have been dropped because the queue is full
+  if (applied)
+  {
+    std::lock_guard<std::mutex> queueLock(this->mutex);
+    if (this->markerDrops != drops)
+    {
+      gzwarn << "Markers were dropped while [" << _req.marker_size()
+             << "] markers were being applied, see QueueStats" << std::endl;
+      applied = false;
+    }
+  }
+  _res.set_data(applied);
+  return true;
 }
 
 /////////////////////////////////////////////////
-void MarkerManagerPrivate::OnRender()
+bool MarkerManagerPrivate::OnPackedMarker(
+    const gz::msgs::PointCloudPacked &_req, gz::msgs::Boolean &_res)
 {
-  if (!this->scene)
+  _res.set_data(false);
+
+  gz::msgs::Marker marker;
+  marker.set_action(gz::msgs::Marker::ADD_MODIFY);
+  marker.set_type(gz::msgs::Marker::POINTS);
+  for (const auto &data : _req.header().data())
   {
-    this->scene = rendering::sceneFromFirstRenderEngine();
-    if (nullptr == this->scene)
-      return;
+    if (data.value_size() == 0)
+    {
+      if (data.key() == "append")
+        marker.mutable_header()->add_data()->set_key("append");
+      continue;
+    }
 
-    this->Initialize();
+    const auto &value = data.value(0);
+    try
+    {
+      if (data.key() == "ns")
+        marker.set_ns(value);
+      else if (data.key() == "id")
+        marker.set_id(std::stoull(value));
+      else if (data.key() == "parent")
+        marker.set_parent(value);
+      else if (data.key() == "size")
+        gz::msgs::Set(marker.mutable_scale(),
+            gz::math::Vector3d::One * std::stod(value));
+      else if (data.key() == "append" && value != "false")
+        marker.mutable_header()->add_data()->set_key("append");
+      else if (data.key() == "type")
+      {
+        gz::msgs::Marker::Type type;
+        std::string name = value;
+        std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+        if (!gz::msgs::Marker::Type_Parse(name, &type))
+        {
+          gzerr << "Unknown packed marker type [" << value << "]"
+                << std::endl;
+          return true;
+        }
+        marker.set_type(type);
+      }
+    }
+    catch (...)
+    {
+      gzerr << "Invalid packed marker [" << data.key() << "] value ["
+            << value << "]" << std::endl;
+      return true;
+    }
+  }
+
+  if (nullptr == PackedField(_req, "x") || nullptr == PackedField(_req, "y") ||
+      nullptr == PackedField(_req, "z"))
+  {
+    gzerr << "Packed marker is missing x, y or z fields" << std::endl;
+    return true;
+  }
+
+  std::size_t count = static_cast<std::size_t>(_req.width()) *
+      std::max(_req.height(), 1u);
+  if (_req.data().size() < count * _req.point_step())
+  {
+    gzerr << "Packed marker has less data than " << count << " points"
+          << std::endl;
+    return true;
+  }
+
+  // Decode straight from the packed data, without a message per point
+  auto points = std::make_shared<MarkerPoints>();
+  points->points.reserve(count);
+  points->colors.reserve(count);
+
+  gz::msgs::PointCloudPackedIterator<float> iterX(_req, "x");
+  gz::msgs::PointCloudPackedIterator<float> iterY(_req, "y");
+  gz::msgs::PointCloudPackedIterator<float> iterZ(_req, "z");
+  for (std::size_t i = 0; i < count; ++i, ++iterX, ++iterY, ++iterZ)
+    points->points.emplace_back(*iterX, *iterY, *iterZ);
+
+  // Colors packed as 4 bytes, blue first, as in PCL
+  std::string colorField = PackedField(_req, "rgba") ? "rgba" :
+      PackedField(_req, "rgb") ? "rgb" : "";
+  if (!colorField.empty())
+  {
+    bool alpha = colorField == "rgba";
+    gz::msgs::PointCloudPackedIterator<uint8_t> iterColor(_req, colorField);
+    for (std::size_t i = 0; i < count; ++i, ++iterColor)
+    {
+      points->colors.emplace_back(iterColor[2] / 255.0f,
+          iterColor[1] / 255.0f, iterColor[0] / 255.0f,
+          alpha ? iterColor[3] / 255.0f : 1.0f);
+    }
+  }
+  else
+  {
+    points->colors.assign(count, math::Color::White);
   }
 
   std::lock_guard<std::mutex> lock(this->mutex);
-  // Process the marker messages.
-  for (auto markerIter = this->markerMsgs.begin();
-       markerIter != this->markerMsgs.end();)
+  this->QueueMarkerMsg(marker, points);
+  this->NotifyMarkersReady();
+  _res.set_data(true);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::QueueMarkerMsg(const gz::msgs::Marker &_msg,
+    std::shared_ptr<const MarkerPoints> _points)
+{
+  // Markers without an id get a new random id, they're always new markers
+  if (_msg.id() == 0)
   {
-    this->ProcessMarkerMsg(*markerIter);
-    this->markerMsgs.erase(markerIter++);
+    this->PushMarkerMsg({_msg, true, true, _points});
+    return;
   }
 
-  // Erase any markers that have a lifetime.
-  for (auto mit = this->visuals.begin();
-       mit != this->visuals.end();)
+  auto key = std::make_pair(_msg.ns(), _msg.id());
+  auto modification = this->QueuedModification(key);
+
+  if (_msg.action() == gz::msgs::Marker::ADD_MODIFY)
   {
-    for (auto it = mit->second.cbegin();
-         it != mit->second.cend(); ++it)
+    // Only the newest modification is processed. Messages with packed
+    // points are kept as they are.
+    if (nullptr != modification && !_points && !modification->points)
     {
-      if (it->second->GeometryCount() == 0u)
-        continue;
+      gz::msgs::Marker merged = _msg;
+      MergeMarker(modification->msg, merged);
+      modification->msg = std::move(merged);
+
+      auto bytes = QueuedBytes(*modification);
+      this->markerBytes = this->markerBytes - modification->bytes + bytes;
+      modification->bytes = bytes;
+      this->markerQueue.Update(this->markerMsgs.size(), this->markerBytes);
+      return;
+    }
 
-      gz::rendering::MarkerPtr markerPtr =
-            std::dynamic_pointer_cast<gz::rendering::Marker>
-            (it->second->GeometryByIndex(0u));
-      if (markerPtr != nullptr)
+    if (this->PushMarkerMsg({_msg, true, true, _points}))
+    {
+      this->queuedModifications[key] =
+          this->markerBase + this->markerMsgs.size() - 1;
+    }
+  }
+  else if (_msg.action() == gz::msgs::Marker::DELETE_MARKER)
+  {
+    // Deleting cancels the queued modification
+    bool warn{true};
+    if (nullptr != modification)
+    {
+      modification->valid = false;
+      this->queuedModifications.erase(key);
+      warn = false;
+    }
+    this->PushMarkerMsg({_msg, true, warn});
+  }
+  else if (_msg.action() == gz::msgs::Marker::DELETE_ALL && HasRegion(_msg))
+  {
+    // Which queued markers end up in the region isn't known yet, so they
+    // all stay queued
+    this->PushMarkerMsg({_msg});
+  }
+  else if (_msg.action() == gz::msgs::Marker::DELETE_ALL)
+  {
+    // Deleting all markers of a namespace, or of all namespaces, cancels
+    // everything queued for them
+    bool warn{true};
+    for (auto &queued : this->markerMsgs)
+    {
+      if (queued.valid && queued.barrier == 0u &&
+          (_msg.ns().empty() || queued.msg.ns() == _msg.ns()))
       {
-        if (markerPtr->Lifetime().count() != 0 &&
-            (markerPtr->Lifetime() <= this->simTime ||
-            this->simTime < this->lastSimTime))
-        {
-          this->scene->DestroyVisual(it->second);
-          it = mit->second.erase(it);
-          break;
-        }
+        queued.valid = false;
+        warn = false;
       }
     }
-
-    // Erase a namespace if it's empty
-    if (mit->second.empty())
-      mit = this->visuals.erase(mit);
-    else
-      ++mit;
+    for (auto it = this->queuedModifications.begin();
+        it != this->queuedModifications.end();)
+    {
+      if (_msg.ns().empty() || it->first.first == _msg.ns())
+        it = this->queuedModifications.erase(it);
+      else
+        ++it;
+    }
+    this->PushMarkerMsg({_msg, true, warn});
+  }
+  else
+  {
+    this->PushMarkerMsg({_msg});
   }
-  this->lastSimTime = this->simTime;
 }
 
 /////////////////////////////////////////////////
-bool MarkerManagerPrivate::OnList(gz::msgs::Marker_V &_rep)
+bool MarkerManagerPrivate::PushMarkerMsg(QueuedMarker &&_queued)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-  _rep.clear_marker();
+  _queued.bytes = QueuedBytes(_queued);
 
-  // Create the list of visuals
-  for (auto mIter : this->visuals)
+  // Barriers are always queued, so synchronous requests get their reply
+  auto limit = this->markerQueue.CurrentLimit();
+  if (_queued.barrier == 0u && limit.Exceeded(this->markerMsgs.size() + 1,
+      this->markerBytes + _queued.bytes))
   {
-    for (auto iter : mIter.second)
+    if (limit.policy == QueueStats::DropPolicy::kDropNewest)
+    {
+      ++this->markerDrops;
+      this->markerQueue.Drop();
+      return false;
+    }
+
+    while (!this->markerMsgs.empty() &&
+        limit.Exceeded(this->markerMsgs.size() + 1,
+        this->markerBytes + _queued.bytes))
     {
-      gz::msgs::Marker *markerMsg = _rep.add_marker();
-      markerMsg->set_ns(mIter.first);
-      markerMsg->set_id(iter.first);
+      this->markerBytes -= this->markerMsgs.front().bytes;
+      this->markerMsgs.pop_front();
+      ++this->markerBase;
+      ++this->markerDrops;
+      this->markerQueue.Drop();
+    }
+
+    // Too large on its own
+    if (limit.Exceeded(1, _queued.bytes))
+    {
+      ++this->markerDrops;
+      this->markerQueue.Drop();
+      return false;
     }
   }
 
+  this->markerBytes += _queued.bytes;
+  this->markerMsgs.push_back(std::move(_queued));
+  this->markerQueue.Update(this->markerMsgs.size(), this->markerBytes);
   return true;
 }
 
 /////////////////////////////////////////////////
-void MarkerManagerPrivate::OnMarkerMsg(const gz::msgs::Marker &_req)
+QueuedMarker *MarkerManagerPrivate::QueuedModification(
+    const std::pair<std::string, uint64_t> &_key)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-  this->markerMsgs.push_back(_req);
-}
+  auto it = this->queuedModifications.find(_key);
+  if (it == this->queuedModifications.end())
+    return nullptr;
 
-/////////////////////////////////////////////////
-bool MarkerManagerPrivate::OnMarkerMsgArray(
-    const gz::msgs::Marker_V&_req, gz::msgs::Boolean &_res)
-{
-  std::lock_guard<std::mutex> lock(this->mutex);
-  std::copy(_req.marker().begin(), _req.marker().end(),
-            std::back_inserter(this->markerMsgs));
-  _res.set_data(true);
-  return true;
+  // The message was dropped because of the queue's limit
+  if (it->second < this->markerBase)
+  {
+    this->queuedModifications.erase(it);
+    return nullptr;
+  }
+  return &this->markerMsgs[it->second - this->markerBase];
 }
 
 //////////////////////////////////////////////////
-bool MarkerManagerPrivate::ProcessMarkerMsg(const gz::msgs::Marker &_msg)
+bool MarkerManagerPrivate::ProcessMarkerMsg(const gz::msgs::Marker &_msg,
+    bool _warn, const MarkerPoints *_points)
 {
+  if (!this->culled.empty())
+    this->ResolveCulled(_msg);
+
   // Get the namespace, if it exists. Otherwise, use the global namespace
   std::string ns;
   if (!_msg.ns().empty())
@@ -323,9 +1974,28 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const gz::msgs::Marker &_msg)
   if (nsIter != this->visuals.end())
     visualIter = nsIter->second.find(id);
 
+  // Markers of batched namespaces which don't need a visual of their own
+  if (_msg.action() == gz::msgs::Marker::ADD_MODIFY &&
+      this->batchNamespaces.count(ns) > 0 &&
+      this->ProcessBatchedMsg(_msg, ns, id, _points))
+  {
+    if (nsIter != this->visuals.end() &&
+        visualIter != nsIter->second.end())
+    {
+      this->DestroyMarkerVisual(visualIter->second);
+      nsIter->second.erase(visualIter);
+      if (nsIter->second.empty())
+        this->visuals.erase(nsIter);
+    }
+    this->UpdateListing(ns, id, _msg, _points);
+    return true;
+  }
+
   // Add/modify a marker
   if (_msg.action() == gz::msgs::Marker::ADD_MODIFY)
   {
+    this->EraseBatchedMarker(ns, id);
+
     // Modify an existing marker, identified by namespace and id
     if (nsIter != this->visuals.end() &&
         visualIter != nsIter->second.end())
@@ -344,9 +2014,15 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const gz::msgs::Marker &_msg)
         this->SetVisual(_msg, visualIter->second);
 
         // Set the marker values from the Marker Message
-        this->SetMarker(_msg, markerPtr);
+        this->SetMarker(_msg, markerPtr, _points);
 
         visualIter->second->AddGeometry(markerPtr);
+
+        if (markerPtr->Lifetime().count() != 0)
+        {
+          this->expiries.push(
+              {markerPtr->Lifetime(), ns, id, visualIter->second});
+        }
       }
     }
     // Otherwise create a new marker
@@ -366,7 +2042,7 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const gz::msgs::Marker &_msg)
       this->SetVisual(_msg, visualPtr);
 
       // Set the marker values from the Marker Message
-      this->SetMarker(_msg, markerPtr);
+      this->SetMarker(_msg, markerPtr, _points);
 
       // Add populated marker to the visual
       visualPtr->AddGeometry(markerPtr);
@@ -379,7 +2055,11 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const gz::msgs::Marker &_msg)
 
       // Store the visual
       this->visuals[ns][id] = visualPtr;
+
+      if (markerPtr->Lifetime().count() != 0)
+        this->expiries.push({markerPtr->Lifetime(), ns, id, visualPtr});
     }
+    this->UpdateListing(ns, id, _msg, _points);
   }
   // Remove a single marker
   else if (_msg.action() == gz::msgs::Marker::DELETE_MARKER)
@@ -388,66 +2068,527 @@ bool MarkerManagerPrivate::ProcessMarkerMsg(const gz::msgs::Marker &_msg)
     if (nsIter != this->visuals.end() &&
         visualIter != nsIter->second.end())
     {
-      this->scene->DestroyVisual(visualIter->second);
+      this->DestroyMarkerVisual(visualIter->second);
       this->visuals[ns].erase(visualIter);
+      this->EraseListing(ns, id);
 
       // Remove namespace if empty
       if (this->visuals[ns].empty())
         this->visuals.erase(nsIter);
     }
+    else if (this->EraseBatchedMarker(ns, id))
+    {
+      this->EraseListing(ns, id);
+    }
+    else
+    {
+      if (this->warnOnActionFailure && _warn)
+      {
+        gzwarn << "Unable to delete marker with id[" << id << "] "
+                << "in namespace[" << ns << "]" << std::endl;
+      }
+      return false;
+    }
+  }
+  // Remove all markers, or all markers in a namespace
+  else if (_msg.action() == gz::msgs::Marker::DELETE_ALL && HasRegion(_msg))
+  {
+    return this->DeleteRegion(_msg);
+  }
+  else if (_msg.action() == gz::msgs::Marker::DELETE_ALL)
+  {
+    bool batched = this->ClearBatches(ns);
+    this->ClearListing(ns);
+
+    // If given namespace doesn't exist
+    if (!ns.empty() && nsIter == this->visuals.end())
+    {
+      if (batched)
+        return true;
+
+      if (this->warnOnActionFailure && _warn)
+      {
+        gzwarn << "Unable to delete all markers in namespace[" << ns
+                << "], namespace can't be found." << std::endl;
+      }
+      return false;
+    }
+    // Remove all markers in the specified namespace
+    else if (nsIter != this->visuals.end())
+    {
+      for (auto it : nsIter->second)
+      {
+        this->DestroyMarkerVisual(it.second);
+      }
+      nsIter->second.clear();
+      this->visuals.erase(nsIter);
+    }
+    // Remove all markers in all namespaces.
+    else
+    {
+      for (nsIter = this->visuals.begin();
+           nsIter != this->visuals.end(); ++nsIter)
+      {
+        for (auto it : nsIter->second)
+        {
+          this->DestroyMarkerVisual(it.second);
+        }
+      }
+      this->visuals.clear();
+    }
+  }
+  else
+  {
+    gzerr << "Unknown marker action[" << _msg.action() << "]\n";
+    return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool MarkerManagerPrivate::ProcessBatchedMsg(const gz::msgs::Marker &_msg,
+    const std::string &_ns, uint64_t _id, const MarkerPoints *_points)
+{
+  // Markers with a lifetime or a parent need a visual of their own
+  if (!_msg.parent().empty() ||
+      (_msg.has_lifetime() &&
+       (_msg.lifetime().sec() != 0 || _msg.lifetime().nsec() != 0)))
+  {
+    return false;
+  }
+
+  auto batchIt = this->batches.find(_ns);
+  BatchedMarker *current{nullptr};
+  if (batchIt != this->batches.end())
+  {
+    auto it = batchIt->second.markers.find(_id);
+    if (it != batchIt->second.markers.end())
+      current = &it->second;
+  }
+
+  // Messages without a type keep the type of the batched marker
+  gz::msgs::Marker::Type type = _msg.type();
+  if (type == gz::msgs::Marker::NONE && nullptr != current)
+    type = current->type;
+  if (type != gz::msgs::Marker::BOX && type != gz::msgs::Marker::LINE_LIST &&
+      type != gz::msgs::Marker::TEXT)
+  {
+    return false;
+  }
+
+  auto &batch = this->batches[_ns];
+  auto &marker = batch.markers[_id];
+  marker.type = type;
+
+  if (_msg.has_pose())
+  {
+    marker.pose = gz::msgs::Convert(_msg.pose());
+    marker.pose.Correct();
+  }
+  if (_msg.has_scale())
+    marker.scale = gz::msgs::Convert(_msg.scale());
+  if (_msg.has_material())
+    marker.color = gz::msgs::Convert(_msg.material().diffuse());
+  if (type == gz::msgs::Marker::TEXT &&
+      (_msg.type() == gz::msgs::Marker::TEXT || !_msg.text().empty()))
+  {
+    marker.text = _msg.text();
+  }
+
+  if (nullptr != _points || _msg.point_size() > 0)
+  {
+    MarkerPoints points = nullptr != _points ? *_points : PointsFromMsg(_msg);
+    if (IsAppend(_msg))
+    {
+      marker.points.points.insert(marker.points.points.end(),
+          points.points.begin(), points.points.end());
+      marker.points.colors.insert(marker.points.colors.end(),
+          points.colors.begin(), points.colors.end());
+    }
     else
     {
-      if (this->warnOnActionFailure)
-      {
-        gzwarn << "Unable to delete marker with id[" << id << "] "
-                << "in namespace[" << ns << "]" << std::endl;
-      }
-      return false;
+      marker.points = std::move(points);
+    }
+  }
+
+  batch.dirty = true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool MarkerManagerPrivate::EraseBatchedMarker(const std::string &_ns,
+    uint64_t _id)
+{
+  auto batchIt = this->batches.find(_ns);
+  if (batchIt == this->batches.end() ||
+      batchIt->second.markers.erase(_id) == 0u)
+  {
+    return false;
+  }
+
+  batchIt->second.dirty = true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool MarkerManagerPrivate::ClearBatches(const std::string &_ns)
+{
+  bool cleared = false;
+  for (auto &batch : this->batches)
+  {
+    if ((_ns.empty() || batch.first == _ns) && !batch.second.markers.empty())
+    {
+      batch.second.markers.clear();
+      batch.second.dirty = true;
+      cleared = true;
     }
   }
-  // Remove all markers, or all markers in a namespace
-  else if (_msg.action() == gz::msgs::Marker::DELETE_ALL)
+  return cleared;
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::UpdateBatches()
+{
+  // Batched text faces the user camera
+  auto cameraRotation = [this]()
   {
-    // If given namespace doesn't exist
-    if (!ns.empty() && nsIter == this->visuals.end())
+    auto userCamera = this->UserCamera();
+    return nullptr != userCamera ? userCamera->WorldRotation() :
+        gz::math::Quaterniond::Identity;
+  };
+
+  for (auto batchIt = this->batches.begin(); batchIt != this->batches.end();)
+  {
+    auto &batch = batchIt->second;
+    if (!batch.dirty)
     {
-      if (this->warnOnActionFailure)
+      // Only the text is rebuilt when the camera turns, by more than about
+      // 0.2 degrees
+      if (batch.hasText)
       {
-        gzwarn << "Unable to delete all markers in namespace[" << ns
-                << "], namespace can't be found." << std::endl;
+        auto rotation = cameraRotation();
+        const auto &last = batch.textRotation;
+        double dot = rotation.W() * last.W() + rotation.X() * last.X() +
+            rotation.Y() * last.Y() + rotation.Z() * last.Z();
+        if (std::abs(dot) < 1.0 - 1e-6)
+          this->UpdateBatchText(batch, rotation);
       }
-      return false;
+      ++batchIt;
+      continue;
     }
-    // Remove all markers in the specified namespace
-    else if (nsIter != this->visuals.end())
+    batch.dirty = false;
+
+    if (batch.markers.empty())
     {
-      for (auto it : nsIter->second)
+      if (nullptr != batch.visual)
+        this->DestroyMarkerVisual(batch.visual);
+      batchIt = this->batches.erase(batchIt);
+      continue;
+    }
+
+    if (nullptr == batch.visual)
+    {
+      batch.visual = this->scene->CreateVisual(
+          "__IGN_MARKER_BATCH_" + batchIt->first);
+      this->scene->RootVisual()->AddChild(batch.visual);
+
+      // Colors come from the vertices, so the material is plain and unlit
+      gz::msgs::Marker materialMsg;
+      gz::msgs::Set(materialMsg.mutable_material()->mutable_ambient(),
+          gz::math::Color::White);
+      gz::msgs::Set(materialMsg.mutable_material()->mutable_diffuse(),
+          gz::math::Color::White);
+      materialMsg.mutable_material()->set_lighting(false);
+
+      batch.triangles = this->scene->CreateMarker();
+      batch.triangles->SetType(rendering::MarkerType::MT_TRIANGLE_LIST);
+      this->SetMarkerMaterial(materialMsg, batch.triangles);
+      batch.visual->AddGeometry(batch.triangles);
+
+      batch.lines = this->scene->CreateMarker();
+      batch.lines->SetType(rendering::MarkerType::MT_LINE_LIST);
+      this->SetMarkerMaterial(materialMsg, batch.lines);
+      batch.visual->AddGeometry(batch.lines);
+
+      batch.text = this->scene->CreateMarker();
+      batch.text->SetType(rendering::MarkerType::MT_LINE_LIST);
+      this->SetMarkerMaterial(materialMsg, batch.text);
+      batch.visual->AddGeometry(batch.text);
+    }
+
+    batch.triangles->ClearPoints();
+    batch.lines->ClearPoints();
+    batch.hasText = false;
+    const auto &box = UnitBoxTriangles();
+    for (const auto &it : batch.markers)
+    {
+      const auto &marker = it.second;
+      if (marker.type == gz::msgs::Marker::TEXT)
       {
-        this->scene->DestroyVisual(it.second);
+        batch.hasText = true;
+      }
+      else if (marker.type == gz::msgs::Marker::BOX)
+      {
+        for (const auto &vertex : box)
+        {
+          batch.triangles->AddPoint(
+              marker.pose.CoordPositionAdd(vertex * marker.scale),
+              marker.color);
+        }
+      }
+      else
+      {
+        for (std::size_t i = 0; i < marker.points.points.size(); ++i)
+        {
+          batch.lines->AddPoint(
+              marker.pose.CoordPositionAdd(
+                  marker.points.points[i] * marker.scale),
+              marker.points.colors[i]);
+        }
       }
-      nsIter->second.clear();
-      this->visuals.erase(nsIter);
     }
-    // Remove all markers in all namespaces.
-    else
+    this->UpdateBatchText(batch,
+        batch.hasText ? cameraRotation() : batch.textRotation);
+    ++batchIt;
+  }
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::UpdateBatchText(MarkerBatch &_batch,
+    const gz::math::Quaterniond &_rotation)
+{
+  _batch.text->ClearPoints();
+  _batch.textRotation = _rotation;
+
+  // Cameras look along X with Z up, so text runs along -Y
+  const auto right = _rotation.RotateVector(-gz::math::Vector3d::UnitY);
+  const auto up = _rotation.RotateVector(gz::math::Vector3d::UnitZ);
+  const auto &glyphs = StrokeGlyphs();
+  const double glyphWidth = 4.0 / 6.0;
+
+  for (const auto &it : _batch.markers)
+  {
+    const auto &marker = it.second;
+    if (marker.type != gz::msgs::Marker::TEXT)
+      continue;
+
+    // Each line is centered on the marker's position, the first line's
+    // baseline at it, and the scale's Z is the cap height
+    const double height = marker.scale.Z();
+    double baseline = 0.0;
+    std::size_t start = 0;
+    while (start <= marker.text.size())
     {
-      for (nsIter = this->visuals.begin();
-           nsIter != this->visuals.end(); ++nsIter)
+      auto end = marker.text.find('\n', start);
+      if (end == std::string::npos)
+        end = marker.text.size();
+
+      std::size_t count = end - start;
+      double x = count == 0u ? 0.0 :
+          -0.5 * ((count - 1) * kGlyphAdvance + glyphWidth);
+      for (std::size_t i = start; i < end; ++i)
       {
-        for (auto it : nsIter->second)
+        // Characters without a glyph are drawn as '?'
+        auto c = static_cast<unsigned char>(marker.text[i]);
+        std::size_t glyph = (c >= ' ' && c <= '~') ? c - ' ' : '?' - ' ';
+        for (const auto &point : glyphs[glyph])
         {
-          this->scene->DestroyVisual(it.second);
+          _batch.text->AddPoint(marker.pose.Pos() +
+              (right * (x + point.X()) + up * (baseline + point.Y())) *
+              height, marker.color);
         }
+        x += kGlyphAdvance;
       }
-      this->visuals.clear();
+
+      baseline -= kLineAdvance;
+      start = end + 1;
     }
   }
+}
+
+/////////////////////////////////////////////////
+rendering::CameraPtr MarkerManagerPrivate::UserCamera()
+{
+  for (unsigned int i = 0;
+       nullptr == this->camera && i < this->scene->NodeCount(); ++i)
+  {
+    this->camera = std::dynamic_pointer_cast<rendering::Camera>(
+        this->scene->NodeByIndex(i));
+  }
+  return this->camera;
+}
+
+/////////////////////////////////////////////////
+bool MarkerManagerPrivate::DeleteRegion(const gz::msgs::Marker &_msg)
+{
+  gz::math::AxisAlignedBox region;
+  bool hasRegion{false};
+  if (!RegionFromMsg(_msg, region, hasRegion))
+    return false;
+
+  std::vector<MarkerIndex::Key> keys;
+  {
+    std::lock_guard<std::mutex> lock(this->listMutex);
+    keys = this->index.Query(region);
+  }
+
+  gz::msgs::Marker deleteMsg;
+  deleteMsg.set_action(gz::msgs::Marker::DELETE_MARKER);
+  for (const auto &key : keys)
+  {
+    if (!_msg.ns().empty() && key.first != _msg.ns())
+      continue;
+
+    deleteMsg.set_ns(key.first);
+    deleteMsg.set_id(key.second);
+    this->ProcessMarkerMsg(deleteMsg, false);
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool MarkerManagerPrivate::DeferOffscreen(QueuedMarker &_queued)
+{
+  // Only changes of the pose, scale and material of markers with a visual
+  // of their own are deferred, which leave them where they're rendered
+  const auto &msg = _queued.msg;
+  if (msg.action() != gz::msgs::Marker::ADD_MODIFY || msg.id() == 0 ||
+      nullptr != _queued.points || msg.point_size() > 0 ||
+      !msg.parent().empty() || HasLifetime(msg) ||
+      this->batchNamespaces.count(msg.ns()) > 0)
+  {
+    return false;
+  }
+
+  auto nsIter = this->visuals.find(msg.ns());
+  if (nsIter == this->visuals.end() ||
+      nsIter->second.find(msg.id()) == nsIter->second.end())
+  {
+    return false;
+  }
+
+  MarkerIndex::Key key{msg.ns(), msg.id()};
+  std::lock_guard<std::mutex> lock(this->listMutex);
+  auto entry = this->listing.find(key);
+  if (entry == this->listing.end() || HasLifetime(entry->second))
+    return false;
+
+  // Where it's rendered, or deferred from
+  auto culledIter = this->culled.find(key);
+  const auto *current = culledIter != this->culled.end() ?
+      this->culledIndex.Bounds(key) : this->index.Bounds(key);
+  if (nullptr == current || this->frustum.Contains(*current))
+    return false;
+
+  auto updated = entry->second;
+  MergeListing(updated, msg);
+  auto points = this->pointBounds.find(key);
+  auto bounds = MarkerBounds(updated, points != this->pointBounds.end() ?
+      points->second : gz::math::AxisAlignedBox());
+  if (IsEmpty(bounds) || this->frustum.Contains(bounds))
+    return false;
+
+  // The listing is up to date, only rendering is deferred
+  auto culledBounds = *current;
+  culledBounds.Merge(bounds);
+  entry->second = std::move(updated);
+  this->index.Update(key, bounds);
+
+  if (culledIter != this->culled.end())
+  {
+    MergeMarker(culledIter->second.msg, _queued.msg);
+    culledIter->second = std::move(_queued);
+  }
   else
   {
-    gzerr << "Unknown marker action[" << _msg.action() << "]\n";
+    this->culled.emplace(key, std::move(_queued));
+  }
+  this->culledIndex.Update(key, culledBounds);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::ResolveCulled(const gz::msgs::Marker &_msg)
+{
+  if (_msg.action() == gz::msgs::Marker::DELETE_ALL)
+  {
+    // Markers in a region are deleted one by one
+    if (HasRegion(_msg))
+      return;
+
+    this->culledIndex.Clear(_msg.ns());
+    if (_msg.ns().empty())
+    {
+      this->culled.clear();
+      return;
+    }
+    auto it = this->culled.lower_bound({_msg.ns(), 0u});
+    while (it != this->culled.end() && it->first.first == _msg.ns())
+      it = this->culled.erase(it);
+    return;
+  }
+
+  auto it = this->culled.find({_msg.ns(), _msg.id()});
+  if (it == this->culled.end())
+    return;
+
+  auto deferred = std::move(it->second);
+  this->culled.erase(it);
+  this->culledIndex.Erase({_msg.ns(), _msg.id()});
+
+  // Deleted markers drop it, modified markers apply it first
+  if (_msg.action() == gz::msgs::Marker::ADD_MODIFY)
+    this->ProcessMarkerMsg(deferred.msg, deferred.warn);
+}
+
+/////////////////////////////////////////////////
+bool MarkerManagerPrivate::ApplyCulled()
+{
+  auto keys = this->culledIndex.Query(this->frustum);
+  for (const auto &key : keys)
+  {
+    auto it = this->culled.find(key);
+    if (it == this->culled.end())
+      continue;
+
+    auto deferred = std::move(it->second);
+    this->culled.erase(it);
+    this->culledIndex.Erase(key);
+    this->ProcessMarkerMsg(deferred.msg, deferred.warn);
+  }
+  return !keys.empty();
+}
+
+/////////////////////////////////////////////////
+bool MarkerManagerPrivate::ExpireMarker(const MarkerExpiry &_expiry)
+{
+  auto nsIter = this->visuals.find(_expiry.ns);
+  if (nsIter == this->visuals.end())
+    return false;
+
+  auto visualIter = nsIter->second.find(_expiry.id);
+  if (visualIter == nsIter->second.end() ||
+      visualIter->second != _expiry.visual.lock() ||
+      visualIter->second->GeometryCount() == 0u)
+  {
     return false;
   }
 
+  // The marker may have been modified with a new lifetime since
+  gz::rendering::MarkerPtr markerPtr =
+        std::dynamic_pointer_cast<gz::rendering::Marker>
+        (visualIter->second->GeometryByIndex(0u));
+  if (nullptr == markerPtr || markerPtr->Lifetime() != _expiry.time)
+    return false;
+
+  this->DestroyMarkerVisual(visualIter->second);
+  nsIter->second.erase(visualIter);
+  this->EraseListing(_expiry.ns, _expiry.id);
+
+  // Erase a namespace if it's empty
+  if (nsIter->second.empty())
+    this->visuals.erase(nsIter);
   return true;
 }
 
@@ -503,7 +2644,8 @@ void MarkerManagerPrivate::SetVisual(const gz::msgs::Marker &_msg,
 
 /////////////////////////////////////////////////
 void MarkerManagerPrivate::SetMarker(const gz::msgs::Marker &_msg,
-                           const rendering::MarkerPtr &_markerPtr)
+                           const rendering::MarkerPtr &_markerPtr,
+                           const MarkerPoints *_points)
 {
   _markerPtr->SetLayer(_msg.layer());
 
@@ -514,7 +2656,7 @@ void MarkerManagerPrivate::SetMarker(const gz::msgs::Marker &_msg,
 
   if (lifetime.count() != 0)
   {
-    _markerPtr->SetLifetime(lifetime + this->simTime);
+    _markerPtr->SetLifetime(lifetime + this->frameSimTime);
   }
   else
   {
@@ -522,42 +2664,132 @@ void MarkerManagerPrivate::SetMarker(const gz::msgs::Marker &_msg,
   }
   // Set Marker Render Type
   gz::rendering::MarkerType markerType = MsgToType(_msg);
-  _markerPtr->SetType(markerType);
+  if (_markerPtr->Type() != markerType)
+  {
+    _markerPtr->SetType(markerType);
+    this->markerPoints[_markerPtr.get()].valid = false;
+  }
 
   // Set Marker Material
   if (_msg.has_material())
   {
-    rendering::MaterialPtr materialPtr = MsgToMaterial(_msg);
-    _markerPtr->SetMaterial(materialPtr, true /* clone */);
+    this->SetMarkerMaterial(_msg, _markerPtr);
+  }
 
-    // clean up material after clone
-    this->scene->DestroyMaterial(materialPtr);
+  // Assume the presence of points means we replace old ones
+  if (nullptr != _points)
+  {
+    this->SetPoints(*_points, IsAppend(_msg), _markerPtr);
+  }
+  else if (_msg.point().size() > 0)
+  {
+    this->SetPoints(PointsFromMsg(_msg), IsAppend(_msg), _markerPtr);
   }
 
-  // Assume the presence of points means we clear old ones
-  if (_msg.point().size() > 0)
+  if (_msg.has_scale())
   {
-    _markerPtr->ClearPoints();
+    _markerPtr->SetSize(_msg.scale().x());
   }
+}
 
-  // Set Marker Points
-  for (int i = 0; i < _msg.point().size(); ++i)
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::SetPoints(const MarkerPoints &_points,
+    bool _append, const rendering::MarkerPtr &_markerPtr)
+{
+  auto &current = this->markerPoints[_markerPtr.get()];
+  const auto &points = _points;
+
+  // Append to the current points
+  if (_append)
   {
-    math::Vector3d vector(
-        _msg.point(i).x(),
-        _msg.point(i).y(),
-        _msg.point(i).z());
+    for (std::size_t i = 0; i < points.points.size(); ++i)
+      _markerPtr->AddPoint(points.points[i], points.colors[i]);
 
-    math::Color color = msgs::Convert(_msg.material().diffuse());
-    if (i < _msg.materials().size())
+    current.points.insert(current.points.end(), points.points.begin(),
+        points.points.end());
+    current.colors.insert(current.colors.end(), points.colors.begin(),
+        points.colors.end());
+    return;
+  }
+
+  // If the new points keep the colors of the current ones and don't remove
+  // any, e.g. a growing trajectory, move the points which changed and add
+  // the new ones
+  bool inPlace = current.valid &&
+      points.points.size() >= current.points.size() &&
+      std::equal(current.colors.begin(), current.colors.end(),
+          points.colors.begin());
+  if (inPlace)
+  {
+    for (std::size_t i = 0; i < current.points.size(); ++i)
     {
-      color = msgs::Convert(_msg.materials(i).diffuse());
+      if (points.points[i] != current.points[i])
+        _markerPtr->SetPoint(static_cast<unsigned int>(i), points.points[i]);
     }
-    _markerPtr->AddPoint(vector, color);
+    for (std::size_t i = current.points.size(); i < points.points.size(); ++i)
+      _markerPtr->AddPoint(points.points[i], points.colors[i]);
   }
-  if (_msg.has_scale())
+  else
   {
-    _markerPtr->SetSize(_msg.scale().x());
+    _markerPtr->ClearPoints();
+    for (std::size_t i = 0; i < points.points.size(); ++i)
+      _markerPtr->AddPoint(points.points[i], points.colors[i]);
+  }
+  current.points = points.points;
+  current.colors = points.colors;
+  current.valid = true;
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::DestroyMarkerVisual(
+    const rendering::VisualPtr &_visual)
+{
+  for (unsigned int i = 0; i < _visual->GeometryCount(); ++i)
+  {
+    auto marker = dynamic_cast<const rendering::Marker *>(
+        _visual->GeometryByIndex(i).get());
+    this->markerPoints.erase(marker);
+    this->ReleaseMaterial(marker);
+  }
+  this->scene->DestroyVisual(_visual);
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::SetMarkerMaterial(const gz::msgs::Marker &_msg,
+    const rendering::MarkerPtr &_markerPtr)
+{
+  std::string key = _msg.material().SerializeAsString();
+
+  auto current = this->markerMaterials.find(_markerPtr.get());
+  if (current != this->markerMaterials.end() && current->second == key)
+    return;
+
+  auto &shared = this->materials[key];
+  if (nullptr == shared.material)
+    shared.material = this->MsgToMaterial(_msg);
+  ++shared.refs;
+
+  this->ReleaseMaterial(_markerPtr.get());
+  _markerPtr->SetMaterial(shared.material, false);
+  this->markerMaterials[_markerPtr.get()] = key;
+}
+
+/////////////////////////////////////////////////
+void MarkerManagerPrivate::ReleaseMaterial(const rendering::Marker *_marker)
+{
+  auto markerIt = this->markerMaterials.find(_marker);
+  if (markerIt == this->markerMaterials.end())
+    return;
+
+  auto it = this->materials.find(markerIt->second);
+  this->markerMaterials.erase(markerIt);
+  if (it == this->materials.end())
+    return;
+
+  if (--it->second.refs == 0)
+  {
+    this->scene->DestroyMaterial(it->second.material);
+    this->materials.erase(it);
   }
 }
 
@@ -637,28 +2869,6 @@ gz::rendering::MarkerType MarkerManagerPrivate::MsgToType(
   return gz::rendering::MarkerType::MT_NONE;
 }
 
-/////////////////////////////////////////////////
-void MarkerManagerPrivate::OnWorldStatsMsg(
-  const gz::msgs::WorldStatistics &_msg)
-{
-  std::lock_guard<std::mutex> lock(this->mutex);
-  std::chrono::steady_clock::duration timePoint;
-  if (_msg.has_sim_time())
-  {
-    timePoint = math::secNsecToDuration(
-        _msg.sim_time().sec(),
-        _msg.sim_time().nsec());
-    this->simTime = timePoint;
-  }
-  else if (_msg.has_real_time())
-  {
-    timePoint = math::secNsecToDuration(
-        _msg.real_time().sec(),
-        _msg.real_time().nsec());
-    this->simTime = timePoint;
-  }
-}
-
 /////////////////////////////////////////////////
 MarkerManager::MarkerManager()
   : Plugin(), dataPtr(new MarkerManagerPrivate)
@@ -668,6 +2878,21 @@ MarkerManager::MarkerManager()
 /////////////////////////////////////////////////
 MarkerManager::~MarkerManager()
 {
+  {
+    auto &shared = sharedManagers();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    // Other windows still show the markers
+    if (this->dataPtr.use_count() > 1)
+      return;
+
+    if (!this->dataPtr->sharedKey.empty())
+      shared.managers.erase(this->dataPtr->sharedKey);
+  }
+
+  this->dataPtr->hostMarkers.Unsubscribe();
+  RenderHooks::Unregister(this->dataPtr->renderHookId);
+  this->dataPtr->StopWorker();
 }
 
 /////////////////////////////////////////////////
@@ -705,6 +2930,79 @@ void MarkerManager::LoadConfig(const tinyxml2::XMLElement * _pluginElem)
       }
     }
 
+    if ((elem = _pluginElem->FirstChildElement("host_cache")))
+    {
+      if (elem->QueryBoolText(&this->dataPtr->hostCache) !=
+          tinyxml2::XML_SUCCESS)
+      {
+        gzerr << "Failed to parse <host_cache> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
+    if ((elem = _pluginElem->FirstChildElement("sync_timeout")))
+    {
+      unsigned int timeout;
+      if (elem->QueryUnsignedText(&timeout) == tinyxml2::XML_SUCCESS)
+      {
+        this->dataPtr->syncTimeout = std::chrono::milliseconds(timeout);
+      }
+      else
+      {
+        gzerr << "Failed to parse <sync_timeout> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
+    if ((elem = _pluginElem->FirstChildElement("process_budget")))
+    {
+      double budget;
+      if (elem->QueryDoubleText(&budget) == tinyxml2::XML_SUCCESS)
+      {
+        this->dataPtr->processBudget =
+            std::chrono::duration<double, std::milli>(budget);
+      }
+      else
+      {
+        gzerr << "Failed to parse <process_budget> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
+    if ((elem = _pluginElem->FirstChildElement("cull_offscreen")))
+    {
+      if (elem->QueryBoolText(&this->dataPtr->cullOffscreen) !=
+          tinyxml2::XML_SUCCESS)
+      {
+        gzerr << "Failed to parse <cull_offscreen> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
+    if ((elem = _pluginElem->FirstChildElement("index_cell_size")))
+    {
+      double size;
+      if (elem->QueryDoubleText(&size) == tinyxml2::XML_SUCCESS && size > 0.0)
+      {
+        std::lock_guard<std::mutex> lock(this->dataPtr->listMutex);
+        this->dataPtr->index = MarkerIndex(size);
+        this->dataPtr->culledIndex = MarkerIndex(size);
+      }
+      else
+      {
+        gzerr << "Failed to parse <index_cell_size> value: "
+               << elem->GetText() << std::endl;
+      }
+    }
+
+    for (auto batchElem = _pluginElem->FirstChildElement("batch_namespace");
+         nullptr != batchElem;
+         batchElem = batchElem->NextSiblingElement("batch_namespace"))
+    {
+      if (nullptr != batchElem->GetText())
+        this->dataPtr->batchNamespaces.insert(batchElem->GetText());
+    }
+
     // Stats topic
     auto statsTopicElem = _pluginElem->FirstChildElement("stats_topic");
     if (nullptr != statsTopicElem && nullptr != statsTopicElem->GetText())
@@ -742,16 +3040,9 @@ void MarkerManager::LoadConfig(const tinyxml2::XMLElement * _pluginElem)
   statsTopic = transport::TopicUtils::AsValidTopic(statsTopic);
   if (!statsTopic.empty())
   {
-    // Subscribe to world_stats
-    if (!this->dataPtr->node.Subscribe(statsTopic,
-        &MarkerManagerPrivate::OnWorldStatsMsg, this->dataPtr.get()))
-    {
-      gzerr << "Failed to subscribe to [" << statsTopic << "]" << std::endl;
-    }
-    else
-    {
-      gzmsg << "Listening to stats on [" << statsTopic << "]" << std::endl;
-    }
+    auto clock = SimClock::ForTopic(statsTopic);
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->clock = clock;
   }
   else
   {
@@ -764,20 +3055,32 @@ void MarkerManager::LoadConfig(const tinyxml2::XMLElement * _pluginElem)
   QQmlProperty::write(this->PluginItem(), "statsTopic",
       QString::fromStdString(statsTopic));
 
-  App()->findChild<MainWindow *>()->installEventFilter(this);
-}
+  if (this->dataPtr->sharedKey.empty())
+  {
+    // Another window may already show these markers, in which case its
+    // manager is shared instead of creating the markers again
+    auto &shared = sharedManagers();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    auto existing = shared.managers[this->dataPtr->topicName].lock();
+    if (existing)
+    {
+      gzmsg << "Sharing the markers of topic [" << this->dataPtr->topicName
+            << "] with another MarkerManager, its other parameters are "
+            << "ignored" << std::endl;
+      this->dataPtr = existing;
+      return;
+    }
+    this->dataPtr->sharedKey = this->dataPtr->topicName;
+    shared.managers[this->dataPtr->sharedKey] = this->dataPtr;
+  }
 
-/////////////////////////////////////////////////
-bool MarkerManager::eventFilter(QObject *_obj, QEvent *_event)
-{
-  if (_event->type() == events::Render::kType)
+  if (this->dataPtr->renderHookId == 0)
   {
-    this->dataPtr->OnRender();
+    auto dataPtr = this->dataPtr.get();
+    this->dataPtr->renderHookId = RenderHooks::Register(RenderPhase::kRender,
+        [dataPtr]{dataPtr->OnRender();}, 0, "MarkerManager");
   }
-  // Standard event processing
-  return QObject::eventFilter(_obj, _event);
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(gz::gui::plugins::MarkerManager,
-              gz::gui::Plugin)
+GZ_GUI_ADD_PLUGIN(gz::gui::plugins::MarkerManager, "MarkerManager")
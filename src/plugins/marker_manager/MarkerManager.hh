@@ -33,14 +33,133 @@ namespace plugins
   /// \brief This plugin will be in charge of handling the markers in the
   /// scene. It will allow to add, modify or remove markers.
   ///
+  /// Windows of the same application share a single MarkerManager per
+  /// `<topic_name>`. The first one loaded advertises the services and
+  /// creates the markers, the others use its markers, whose other
+  /// parameters are ignored. The markers are removed when the last of
+  /// them is closed.
+  ///
   /// ## Parameters
   ///
   /// * `<topic_name>`: Optional. Name of topic for marker service. Defaults
   /// to `/marker`.
   /// * `<stats_topic>`: Optional. Name of topic to receive world stats.
   /// Defaults to `/world/[world name]/stats`.
+  /// * `<host_cache>`: Optional. True to read the markers from a
+  /// HostSceneCache on this host with the same `<topic_name>`, instead of
+  /// advertising the marker services. The services are advertised if
+  /// there's no cache when the scene is created. Defaults to false.
   /// * `<warn_on_action_failure>`: True to display warnings if the user
   /// attempts to perform an invalid action. Defaults to true.
+  /// * `<process_budget>`: Optional. Milliseconds the render thread may
+  /// spend applying marker messages each frame. Messages left over are
+  /// applied on the following frames. Zero or negative means no limit.
+  /// Defaults to 5.
+  /// * `<sync_timeout>`: Optional. Milliseconds a synchronous marker array
+  /// request waits for its markers to be applied. Defaults to 1000.
+  /// * `<batch_namespace>`: Optional, may be repeated. Namespace whose
+  /// markers are merged into a single visual, see below.
+  /// * `<cull_offscreen>`: Optional. True to defer the updates of markers
+  /// which stay out of the camera's view, see below. Defaults to false.
+  /// * `<index_cell_size>`: Optional. Edge in meters of the cells of the
+  /// spatial index of the markers. Defaults to 10.
+  ///
+  /// ## Synchronous marker arrays
+  ///
+  /// A request to the `<topic>_array` service normally replies as soon as
+  /// the markers are queued. Adding a `sync` key to the request header's
+  /// data makes it reply only once all its markers have been applied to
+  /// the scene, or with false after `<sync_timeout>`.
+  ///
+  /// ## Queue
+  ///
+  /// Messages wait in a queue reported to QueueStats as
+  /// `MarkerManager/markers`, which is handed to the decoding worker once
+  /// per frame. The modifications of a marker received within a frame are
+  /// merged into one update. When a limit is set on the queue,
+  /// messages beyond it are dropped, and synchronous requests whose
+  /// markers may have been dropped reply with false.
+  ///
+  /// ## Listing markers
+  ///
+  /// The `<topic>/list` service without a request returns the namespace,
+  /// id, type and lifetime of every marker. Calling it with a marker
+  /// message as request lists a single page of markers, optionally only
+  /// from the request's namespace. The request header's data may hold:
+  ///
+  /// * `page_size`: Maximum number of markers to return, 0 for all.
+  /// Defaults to 1000.
+  /// * `page_token`: The `next_page_token` of the previous reply, to get
+  /// the next page. The reply's header data only has a `next_page_token`
+  /// if there are more markers.
+  /// * `full`: Also return the pose, scale, parent and material of the
+  /// markers. Points are never returned.
+  /// * `region_min`, `region_max`: Only list the markers whose bounds
+  /// overlap the box between these corners, each given as `x y z` in the
+  /// world frame.
+  ///
+  /// Both read from a listing kept by the render thread, so they don't
+  /// block rendering.
+  ///
+  /// ## Regions
+  ///
+  /// The render thread keeps the world bounds of the markers in a spatial
+  /// hash, so the markers in a region are found without going through all
+  /// of them. A DELETE_ALL message with `region_min` and `region_max` in
+  /// its header data, as above, only deletes the markers in that region,
+  /// from its namespace if it has one. Markers with a parent aren't in the
+  /// index, since their pose is relative to it, so they're never in a
+  /// region.
+  ///
+  /// With `<cull_offscreen>`, ADD_MODIFY messages which only change the
+  /// pose, scale or material of a marker that is out of view before and
+  /// after them are kept instead of applied, the latest one per marker,
+  /// until the marker comes into view. Listing and regions see them right
+  /// away. Messages with points or a lifetime, and markers with a parent or
+  /// in a batched namespace, are always applied.
+  ///
+  /// ## Batched namespaces
+  ///
+  /// BOX, LINE_LIST and TEXT markers of a batched namespace aren't visuals
+  /// of their own. All the boxes of the namespace are drawn as one triangle
+  /// list and all the lines as one line list, which turns thousands of
+  /// draw calls into two. Their color is the diffuse color of the marker
+  /// or of each point, and they aren't lit. Any change rebuilds the
+  /// namespace's batch once per frame, so batching suits namespaces with
+  /// many markers which change together, like occupancy grids. Markers
+  /// with a lifetime or a parent, and markers of other types, are still
+  /// drawn individually.
+  ///
+  /// TEXT markers of a batched namespace are drawn with a built-in stroke
+  /// font into one more line list, instead of a text object and mesh per
+  /// label, so thousands of labels stay cheap. Only printable ASCII
+  /// characters are drawn, others are drawn as `?`. Each line of text is
+  /// centered on the marker's position, its height is the Z scale, and it
+  /// always faces the camera. Only the text is rebuilt when the camera
+  /// turns.
+  ///
+  /// ## Point updates
+  ///
+  /// An ADD_MODIFY message with points normally replaces the marker's
+  /// points. Adding an `append` key to the message header's data appends
+  /// them to the current points instead, which is cheaper for markers that
+  /// grow over time, like trajectories. Messages that resend the current
+  /// points with new ones at the end, or with some of them moved, also
+  /// only update what changed.
+  ///
+  /// ## Packed markers
+  ///
+  /// Markers with many points can be sent to the `<topic_name>_packed`
+  /// service as a `gz::msgs::PointCloudPacked`, which avoids a message per
+  /// point. The points are read from the `x`, `y` and `z` float fields, and
+  /// their colors from an optional `rgb` or `rgba` field packed as 4 bytes,
+  /// blue first. The marker is described by the header data:
+  ///
+  /// * `ns`, `id`, `parent`: Same as in `gz::msgs::Marker`.
+  /// * `type`: Marker type, e.g. `points` or `line_strip`. Defaults to
+  ///   `points`.
+  /// * `size`: Point size or line scale.
+  /// * `append`: Append the points to the current ones.
   class MarkerManager : public Plugin
   {
     Q_OBJECT
@@ -55,12 +174,10 @@ namespace plugins
     public: virtual void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
         override;
 
-    // Documentation inherited
-    private: bool eventFilter(QObject *_obj, QEvent *_event) override;
-
     /// \internal
-    /// \brief Pointer to private data.
-    private: std::unique_ptr<MarkerManagerPrivate> dataPtr;
+    /// \brief Pointer to private data, shared by the plugins showing the
+    /// same markers.
+    private: std::shared_ptr<MarkerManagerPrivate> dataPtr;
   };
 }
 }
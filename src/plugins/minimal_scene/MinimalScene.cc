@@ -16,42 +16,178 @@
 */
 
 #include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/param.pb.h>
 #include <gz/msgs/stringmsg.pb.h>
 
 #include "MinimalScene.hh"
 #include "MinimalSceneRhi.hh"
 #include "MinimalSceneRhiMetal.hh"
 #include "MinimalSceneRhiOpenGL.hh"
+#include "MinimalSceneRhiVulkan.hh"
+#include "MinimalSceneStream.hh"
 
 #include <algorithm>
-#include <list>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+#include <iomanip>
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <gz/common/Console.hh>
 #include <gz/common/KeyEvent.hh>
+#include <gz/common/Mesh.hh>
+#include <gz/common/MeshManager.hh>
 #include <gz/common/MouseEvent.hh>
+#include <gz/common/SubMesh.hh>
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Frustum.hh>
+#include <gz/math/Helpers.hh>
 #include <gz/math/Vector2.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/rendering/Camera.hh>
+#include <gz/rendering/DirectionalLight.hh>
+#include <gz/rendering/Light.hh>
+#include <gz/rendering/Marker.hh>
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/Mesh.hh>
+#include <gz/rendering/MeshDescriptor.hh>
 #include <gz/rendering/RayQuery.hh>
 #include <gz/rendering/RenderEngine.hh>
 #include <gz/rendering/RenderingIface.hh>
 #include <gz/rendering/Scene.hh>
+#include <gz/rendering/SubMesh.hh>
 #include <gz/rendering/Utils.hh>
+#include <gz/rendering/Visual.hh>
 #include <gz/transport/Node.hh>
+#include <gz/transport/TopicUtils.hh>
 
 #include "gz/gui/Application.hh"
 #include "gz/gui/Conversions.hh"
+#include "gz/gui/GpuMemory.hh"
 #include "gz/gui/GuiEvents.hh"
 #include "gz/gui/Helpers.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/Profiler.hh"
+#include "gz/gui/RenderDevice.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/RenderStats.hh"
+#include "gz/gui/ScenePicker.hh"
+#include "gz/gui/StartupProfiler.hh"
+#include "gz/gui/StaticPlugins.hh"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 Q_DECLARE_METATYPE(gz::gui::plugins::RenderSync*)
 
+namespace
+{
+/// \brief Input passed from the Qt thread to the render thread
+struct InputEvent
+{
+  /// \brief Kind of input
+  enum class Kind
+  {
+    /// \brief Mouse press, release, move or scroll
+    kMouse,
+
+    /// \brief Mouse hovering without buttons
+    kHover,
+
+    /// \brief Text dropped on the scene
+    kDrop,
+
+    /// \brief Key press or release
+    kKey
+  };
+
+  /// \brief Kind of input
+  Kind kind{Kind::kMouse};
+
+  /// \brief Mouse event, for kMouse
+  gz::common::MouseEvent mouse;
+
+  /// \brief Key event, for kKey
+  gz::common::KeyEvent key;
+
+  /// \brief Position in the camera image, for kHover and kDrop
+  gz::math::Vector2i pos;
+
+  /// \brief Dropped text, for kDrop
+  std::string text;
+
+  /// \brief When the Qt thread received a mouse or key event, only set
+  /// while measuring input latency
+  std::chrono::steady_clock::time_point time;
+};
+
+/// \brief Fixed size queue between a single producer thread and a single
+/// consumer thread, which never blocks either of them
+/// \tparam T Element type
+/// \tparam N Capacity, a power of two
+template <typename T, std::size_t N>
+class SpscQueue
+{
+  static_assert((N & (N - 1)) == 0, "The capacity must be a power of two");
+
+  /// \brief Add an element, from the producer thread
+  /// \param[in] _value Element
+  /// \return False if the queue is full, the element is then dropped
+  public: bool Push(T &&_value)
+  {
+    auto head = this->head.load(std::memory_order_relaxed);
+    if (head - this->tail.load(std::memory_order_acquire) == N)
+      return false;
+    this->slots[head & (N - 1)] = std::move(_value);
+    this->head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// \brief Take the oldest element, from the consumer thread
+  /// \param[out] _value Element
+  /// \return False if the queue is empty
+  public: bool Pop(T &_value)
+  {
+    auto tail = this->tail.load(std::memory_order_relaxed);
+    if (tail == this->head.load(std::memory_order_acquire))
+      return false;
+    _value = std::move(this->slots[tail & (N - 1)]);
+    this->tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// \brief Elements
+  private: std::array<T, N> slots;
+
+  /// \brief Number of elements pushed, only written by the producer
+  private: alignas(64) std::atomic<std::size_t> head{0u};
+
+  /// \brief Number of elements popped, only written by the consumer
+  private: alignas(64) std::atomic<std::size_t> tail{0u};
+};
+}
+
 /// \brief Private data class for GzRenderer
 class gz::gui::plugins::GzRenderer::Implementation
 {
@@ -61,28 +197,47 @@ class gz::gui::plugins::GzRenderer::Implementation
   /// \brief Flag to indicate if hover event is dirty
   public: bool hoverDirty{false};
 
+  /// \brief True if the hovered point of the scene must be computed again.
+  /// Only accessed from the render thread.
+  public: bool hoverToSceneDirty{false};
+
+  /// \brief Hovered position to compute the point of the scene of
+  public: math::Vector2i hoverToScenePos{math::Vector2i::Zero};
+
+  /// \brief When the hovered point of the scene was last computed
+  public: std::chrono::steady_clock::time_point lastHoverToScene;
+
   /// \brief Flag to indicate if drop event is dirty
   public: bool dropDirty{false};
 
   /// \brief Current mouse event
   public: common::MouseEvent mouseEvent;
 
-  /// \brief A list of mouse events
-  public: std::list<common::MouseEvent> mouseEvents;
-
   /// \brief Key event
   public: common::KeyEvent keyEvent;
 
-  /// \brief Max number of mouse events to store in the queue.
-  /// These events are then propagated to other gui plugins. A queue is used
-  /// instead of just keeping the latest mouse event so that we can capture
-  /// important events like mouse presses. However we keep the queue size
-  /// small on purpose so that we do not flood other gui plugins with events
-  /// that may be outdated.
-  public: const unsigned int kMaxMouseEventSize = 5u;
+  /// \brief Input from the Qt thread, in order, drained by the render
+  /// thread at the start of each frame. A queue is used instead of just
+  /// keeping the latest mouse event so that we can capture important events
+  /// like mouse presses. It never blocks the Qt thread, however long the
+  /// plugins handling the events take.
+  public: SpscQueue<InputEvent, 256> inputQueue;
 
-  /// \brief Mutex to protect mouse events
-  public: std::mutex mutex;
+  /// \brief True once input was dropped because the queue was full
+  public: std::atomic<bool> inputDropped{false};
+
+  /// \brief Queue input for the render thread, from the Qt thread
+  /// \param[in] _input Input event
+  public: void PushInput(InputEvent &&_input)
+  {
+    // Only happens if the render thread is stuck for hundreds of events
+    if (!this->inputQueue.Push(std::move(_input)) &&
+        !this->inputDropped.exchange(true))
+    {
+      gzwarn << "Render thread isn't keeping up with input, dropping events"
+             << std::endl;
+    }
+  }
 
   /// \brief User camera
   public: rendering::CameraPtr camera{nullptr};
@@ -99,6 +254,86 @@ class gz::gui::plugins::GzRenderer::Implementation
   /// \brief Ray query for mouse clicks
   public: rendering::RayQueryPtr rayQuery{nullptr};
 
+  /// \brief Pick what's under a position of the camera image with the ray
+  /// query, for ScenePicker
+  /// \param[in] _pos Position in pixels
+  /// \param[out] _result What's under it
+  /// \return False if the camera isn't ready
+  public: bool Pick(const math::Vector2i &_pos, PickResult &_result);
+
+  /// \brief Record the estimated size of the camera's render target
+  /// \param[in] _size Size of the render target in pixels
+  /// \param[in] _msaa Anti-aliasing samples
+  public: void RecordTextureMemory(const QSize &_size, unsigned int _msaa);
+
+  /// \brief Count what the camera submits on this frame, every
+  /// kRenderStatsPeriod frames, and record it, see RenderStats
+  /// \param[in] _topic Topic to publish the counts on, empty to not
+  /// publish them
+  public: void RecordRenderStats(const std::string &_topic);
+
+  /// \brief Keep the lights most important to the camera on, and switch
+  /// the others off, every kLightBudgetPeriod frames
+  /// \param[in] _quality Light budget
+  /// \param[in] _force True to update now, such as when the budget changed
+  public: void UpdateLightBudget(const RenderQuality &_quality, bool _force);
+
+  /// \brief Get the triangles of a mesh
+  /// \param[in] _mesh Mesh
+  /// \return Triangles, 0 if its source mesh isn't known
+  public: uint64_t MeshTriangles(const rendering::Mesh &_mesh);
+
+  /// \brief Number of frames between two render stats
+  public: const unsigned int kRenderStatsPeriod{30u};
+
+  /// \brief Frames since the last render stats
+  public: unsigned int renderStatsFrames{0u};
+
+  /// \brief World bounds of the static visuals, by Id
+  public: std::unordered_map<unsigned int, math::AxisAlignedBox>
+      staticBounds;
+
+  /// \brief Triangles of each source mesh, by mesh and submesh name
+  public: std::unordered_map<std::string, uint64_t> meshTriangles;
+
+  /// \brief True once the render stats topic was advertised
+  public: bool statsAdvertised{false};
+
+  /// \brief Settings of a light changed by the light budget, restored
+  /// when it's back within the budget
+  public: struct BudgetedLight
+  {
+    /// \brief Intensity before it was switched off
+    double intensity{1.0};
+
+    /// \brief Whether it cast shadows before the budget
+    bool castShadows{false};
+
+    /// \brief True while it's switched off
+    bool off{false};
+
+    /// \brief True while its shadows are disabled
+    bool noShadows{false};
+  };
+
+  /// \brief Lights changed by the light budget, by Id
+  public: std::unordered_map<unsigned int, BudgetedLight> budgetedLights;
+
+  /// \brief Number of frames between two light budget updates
+  public: const unsigned int kLightBudgetPeriod{15u};
+
+  /// \brief Frames since the last light budget update
+  public: unsigned int lightBudgetFrames{0u};
+
+  /// \brief Publisher of render stats
+  public: transport::Node::Publisher statsPub;
+
+  /// \brief Get the point of the scene under a position, through the
+  /// shared picking
+  /// \param[in] _pos Position in pixels
+  /// \return Point in world coordinates
+  public: math::Vector3d ScreenToScene(const math::Vector2i &_pos);
+
   /// \brief View control focus target
   public: math::Vector3d target;
 
@@ -107,8 +342,234 @@ class gz::gui::plugins::GzRenderer::Implementation
 
   /// \brief Render hardware interface for the texture
   public: std::unique_ptr<GzCameraTextureRhi> rhi;
+
+  /// \brief Camera pose on the previous frame
+  public: math::Pose3d lastCameraPose;
+
+  /// \brief Copy of lastCameraPose which can be read from other threads
+  public: math::Pose3d sharedCameraPose;
+
+  /// \brief True once sharedCameraPose was set on a frame
+  public: bool hasSharedCameraPose{false};
+
+  /// \brief Protects sharedCameraPose and hasSharedCameraPose
+  public: mutable std::mutex cameraPoseMutex;
+
+  /// \brief True if the camera moved since the last ConsumeCameraMoved
+  public: std::atomic<bool> cameraMoved{false};
+
+  /// \brief Scene revision, bumped by MarkDirty
+  public: std::atomic<uint64_t> sceneRevision{0u};
+
+  /// \brief Scene revision when the camera was last updated
+  public: uint64_t renderedRevision{0u};
+
+  /// \brief True until the first frame has been rendered
+  public: bool firstFrame{true};
+
+  /// \brief Transport node used for all of the renderer's requests. It's
+  /// created together with the renderer, outside of the render loop.
+  public: transport::Node node;
+
+  /// \brief Transport commands waiting to be run on the next frame
+  public: std::vector<std::function<void(transport::Node &)>>
+      transportCommands;
+
+  /// \brief Protects transportCommands
+  public: std::mutex transportMutex;
+
+  /// \brief Quality set with SetQuality, applied on the next frame
+  public: std::optional<RenderQuality> pendingQuality;
+
+  /// \brief True while there's a pendingQuality, so frames don't lock
+  /// qualityMutex
+  public: std::atomic<bool> qualityPending{false};
+
+  /// \brief Protects pendingQuality
+  public: std::mutex qualityMutex;
+
+  /// \brief Phases of a frame measured by frame timing
+  public: enum FramePhase
+          {
+            kWaitQt,
+            kRhiUpdate,
+            kMouse,
+            kPreRender,
+            kPreRenderEvents,
+            kCameraUpdate,
+            kTransport,
+            kRender,
+            kRenderEvents,
+            kFramePhaseCount
+          };
+
+  /// \brief Names of each FramePhase, as published
+  public: static constexpr std::array<const char *, kFramePhaseCount>
+      kFramePhaseNames{{"wait_qt", "rhi_update", "mouse", "pre_render",
+      "pre_render_events", "camera_update", "transport", "render",
+      "render_events"}};
+
+  /// \brief Number of frames averaged before timings are reported
+  public: const unsigned int kFrameTimingWindow{30u};
+
+  /// \brief Duration of each phase on the current frame, in milliseconds
+  public: std::array<double, kFramePhaseCount> phaseMs{};
+
+  /// \brief Sum of each phase's duration over the current window
+  public: std::array<double, kFramePhaseCount> phaseSumMs{};
+
+  /// \brief Sum of each render hook's duration over the current window
+  public: std::map<std::string, double> hookSumMs;
+
+  /// \brief Sum of GPU times over the current window
+  public: double gpuSumMs{0.0};
+
+  /// \brief Number of frames with a GPU time in the current window
+  public: unsigned int gpuFrames{0u};
+
+  /// \brief Number of frames in the current window
+  public: unsigned int timingFrames{0u};
+
+  /// \brief True once the frame timing topic was advertised
+  public: bool timingAdvertised{false};
+
+  /// \brief Publisher of frame timings
+  public: transport::Node::Publisher timingPub;
+
+  /// \brief Latest frame timing summary
+  public: std::string timingSummary;
+
+  /// \brief Protects timingSummary
+  public: std::mutex timingMutex;
+
+  /// \brief Number of presented frames with input summarized in each
+  /// input latency report
+  public: const unsigned int kInputLatencyWindow{30u};
+
+  /// \brief Time of the oldest input handled but not rendered yet, default
+  /// constructed if there's none
+  public: std::chrono::steady_clock::time_point pendingInputTime;
+
+  /// \brief Time of the oldest input rendered by the current frame,
+  /// default constructed if there's none
+  public: std::chrono::steady_clock::time_point frameInputTime;
+
+  /// \brief Input to handling latencies in the current window, in
+  /// milliseconds
+  public: std::vector<double> handledMs;
+
+  /// \brief Input to camera update latencies in the current window, in
+  /// milliseconds
+  public: std::vector<double> updatedMs;
+
+  /// \brief Input to presentation latencies in the current window, in
+  /// milliseconds
+  public: std::vector<double> presentedMs;
+
+  /// \brief True once the input latency topic was advertised
+  public: bool latencyAdvertised{false};
+
+  /// \brief Publisher of input latencies
+  public: transport::Node::Publisher latencyPub;
+
+  /// \brief Render scale currently used, between minRenderScale and
+  /// renderScale. Read by the Qt thread to map mouse positions to the
+  /// texture.
+  public: std::atomic<double> currentScale{1.0};
+
+  /// \brief Number of frames averaged before adapting the render scale
+  public: const unsigned int kScaleWindow{30u};
+
+  /// \brief Sum of frame times over the current scale window
+  public: double scaleFrameSumMs{0.0};
+
+  /// \brief Number of frames in the current scale window
+  public: unsigned int scaleFrames{0u};
+
+  /// \brief Streams the frames to remote viewers, null if not streaming
+  public: std::unique_ptr<SceneStreamer> streamer;
 };
 
+/////////////////////////////////////////////////
+/// \brief Map a position in the render window to the render texture
+/// \param[in] _pos Position in the render window
+/// \param[in] _scale Render scale
+/// \return Position in the render texture
+static math::Vector2i scalePos(const math::Vector2i &_pos, double _scale)
+{
+  return math::Vector2i(
+      static_cast<int>(std::lround(_pos.X() * _scale)),
+      static_cast<int>(std::lround(_pos.Y() * _scale)));
+}
+
+/// \brief Check whether a mouse event can be merged into the previous one,
+/// which is the case for consecutive moves with the same buttons and
+/// modifiers, and for consecutive scrolls at the same position, so only
+/// presses and releases are kept apart
+/// \param[in] _prev Previous event
+/// \param[in] _next Following event
+/// \return True if they can be merged
+static bool canCoalesce(const common::MouseEvent &_prev,
+    const common::MouseEvent &_next)
+{
+  if (_prev.Type() != _next.Type())
+    return false;
+
+  if (_prev.Type() == common::MouseEvent::SCROLL)
+  {
+    return _prev.Pos() == _next.Pos() &&
+        _prev.Control() == _next.Control() &&
+        _prev.Shift() == _next.Shift() &&
+        _prev.Alt() == _next.Alt();
+  }
+
+  return _prev.Type() == common::MouseEvent::MOVE &&
+      _prev.Dragging() == _next.Dragging() &&
+      _prev.Buttons() == _next.Buttons() &&
+      _prev.PressPos() == _next.PressPos() &&
+      _prev.Control() == _next.Control() &&
+      _prev.Shift() == _next.Shift() &&
+      _prev.Alt() == _next.Alt();
+}
+
+/// \brief Kinds of materials which can be warmed up
+static const std::vector<std::string> &warmupMaterialKinds()
+{
+  static const std::vector<std::string> kinds{
+      "lit", "unlit", "transparent", "pbr"};
+  return kinds;
+}
+
+/// \brief Marker types which can be warmed up, by name
+static const std::map<std::string, gz::rendering::MarkerType> &
+    warmupMarkerTypes()
+{
+  static const std::map<std::string, gz::rendering::MarkerType> types{
+      {"box", gz::rendering::MarkerType::MT_BOX},
+      {"capsule", gz::rendering::MarkerType::MT_CAPSULE},
+      {"cylinder", gz::rendering::MarkerType::MT_CYLINDER},
+      {"sphere", gz::rendering::MarkerType::MT_SPHERE},
+      {"line_list", gz::rendering::MarkerType::MT_LINE_LIST},
+      {"line_strip", gz::rendering::MarkerType::MT_LINE_STRIP},
+      {"points", gz::rendering::MarkerType::MT_POINTS},
+      {"triangle_fan", gz::rendering::MarkerType::MT_TRIANGLE_FAN},
+      {"triangle_list", gz::rendering::MarkerType::MT_TRIANGLE_LIST},
+      {"triangle_strip", gz::rendering::MarkerType::MT_TRIANGLE_STRIP}};
+  return types;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get whether an item can't be seen, because it or one of its
+/// parents is hidden, such as a collapsed card or another tab, it has no
+/// area, or its window is hidden or minimized
+static bool isHidden(const QQuickItem *_item)
+{
+  auto window = _item->window();
+  return !_item->isVisible() || _item->width() <= 0.0 ||
+      _item->height() <= 0.0 || nullptr == window || !window->isVisible() ||
+      window->visibility() == QWindow::Minimized;
+}
+
 /// \brief Qt and Ogre rendering is happening in different threads
 /// The original sample 'textureinthread' from Qt used a double-buffer
 /// scheme so that the worker (Ogre) thread write to FBO A, while
@@ -190,6 +651,89 @@ class gz::gui::plugins::RenderSync
 
   /// \brief Must be called from GUI thread when shutting down
   public: void Shutdown();
+
+  /// \brief Must be called from worker thread to get a swap chain slot
+  /// which is neither displayed by Qt nor waiting to be displayed.
+  /// \return Index of the slot to render into
+  public: unsigned int AcquireWriteSlot();
+
+  /// \brief Must be called from worker thread once a slot has a complete
+  /// frame. The slot replaces any other frame still waiting to be displayed.
+  /// \param[in] _slot Slot returned by AcquireWriteSlot
+  /// \param[in] _textureId Texture Id of the slot
+  /// \param[in] _size Size of the slot texture
+  /// \param[in] _inputTime Time of the oldest input rendered by the frame,
+  /// default constructed if there's none
+  public: void PublishSlot(unsigned int _slot, int _textureId,
+              const QSize &_size,
+              std::chrono::steady_clock::time_point _inputTime);
+
+  /// \brief Must be called from Qt thread to display the newest complete
+  /// frame. The previously displayed slot is returned to the worker.
+  /// \param[out] _textureId Texture Id of the newest frame
+  /// \param[out] _size Size of the newest frame
+  /// \return True if there was a new frame since the last call
+  public: bool AcquireFrontSlot(int &_textureId, QSize &_size);
+
+  /// \brief Must be called from worker thread once a frame is complete,
+  /// when not triple buffering, to measure its input latency.
+  /// \param[in] _inputTime Time of the oldest input rendered by the frame,
+  /// default constructed if there's none
+  public: void PublishFrameInput(
+              std::chrono::steady_clock::time_point _inputTime);
+
+  /// \brief Must be called from Qt thread when it displays a new frame,
+  /// when not triple buffering, to measure its input latency.
+  public: void FramePresented();
+
+  /// \brief Must be called from worker thread to take the input latencies
+  /// measured since the last call.
+  /// \return Input to presentation latencies, in milliseconds
+  public: std::vector<double> TakeInputLatencies();
+
+  /// \brief Record the latency of the frame being displayed, must be
+  /// called with swapMutex locked.
+  private: void RecordPresentedLocked();
+
+  /// \brief True if the frame scheduler wants a new frame. Qt only asks
+  /// the worker thread for a frame when this is set, so window updates
+  /// caused by other items don't trigger extra renders.
+  public: std::atomic<bool> renderRequested{true};
+
+  /// \brief Number of textures in the swap chain
+  public: static constexpr unsigned int kSwapChainSize = 3u;
+
+  /// \brief True to let the worker thread render into a swap chain instead
+  /// of serializing with the Qt thread. Must not change once rendering
+  /// started.
+  public: bool tripleBuffering{false};
+
+  /// \brief True while a RenderNext request is pending on the worker thread,
+  /// used in triple buffering to keep a single frame in flight.
+  public: std::atomic<bool> frameRequested{false};
+
+  /// \brief Protects the swap chain slots
+  private: std::mutex swapMutex;
+
+  /// \brief Slot currently displayed by Qt, -1 if none
+  private: int frontSlot{-1};
+
+  /// \brief Newest complete slot not yet displayed, -1 if none
+  private: int readySlot{-1};
+
+  /// \brief Texture Id of each slot
+  private: std::array<int, kSwapChainSize> slotTextureIds{};
+
+  /// \brief Texture size of each slot
+  private: std::array<QSize, kSwapChainSize> slotSizes{};
+
+  /// \brief Time of the oldest input rendered by a frame not displayed yet.
+  /// A replaced frame's input is also shown by its replacement, so the
+  /// oldest one is kept.
+  private: std::chrono::steady_clock::time_point readyInputTime;
+
+  /// \brief Input to presentation latencies not taken by the worker yet
+  private: std::vector<double> presentedMs;
 };
 
 /// \brief Private data class for RenderWindowItem
@@ -218,23 +762,117 @@ class gz::gui::plugins::RenderWindowItem::Implementation
   /// \brief See RenderSync
   public: RenderSync renderSync;
 
-  /// \brief List of threads
-  public: static QList<QThread *> threads;
+  /// \brief Render thread of the viewport which created a scene
+  public: struct SceneThread
+  {
+    /// \brief Render thread, shared by every viewport of the scene
+    RenderThread *thread{nullptr};
+
+    /// \brief Synchronization of the viewport which created the scene
+    RenderSync *renderSync{nullptr};
+
+    /// \brief Number of extra viewports rendering on the thread
+    int extraViewports{0};
+  };
+
+  /// \brief Render threads of each scene, by scene name
+  public: static std::map<std::string, SceneThread> sceneThreads;
+
+  /// \brief Protects sceneThreads
+  public: static std::mutex sceneThreadsMutex;
+
+  /// \brief If this is an extra viewport, render thread of the viewport
+  /// which created the scene. Null otherwise.
+  public: RenderThread *sharedThread{nullptr};
+
+  /// \brief True once rendering was stopped
+  public: bool stopped{false};
 
   /// \brief List of our QT connections.
   public: QList<QMetaObject::Connection> connections;
+
+  /// \brief Maximum frame rate, 0 for unlimited (vsync)
+  public: double maxFps{0.0};
+
+  /// \brief Frame rate once idle. 0 stops rendering until there is new
+  /// activity, negative disables idle mode.
+  public: double idleFps{-1.0};
+
+  /// \brief Frame rate while the window isn't focused, 0 to disable
+  public: double unfocusedFps{0.0};
+
+  /// \brief Time without input or camera motion before going idle
+  public: const qint64 kIdleTimeoutMs{1000};
+
+  /// \brief Time since the last frame was requested
+  public: QElapsedTimer frameTimer;
+
+  /// \brief Time since the last input or camera motion
+  public: QElapsedTimer activityTimer;
+
+  /// \brief Timer used to request delayed frames
+  public: QTimer pacingTimer;
+
+  /// \brief True while a requested frame hasn't been delivered yet
+  public: bool framePending{false};
+
+  /// \brief True to stop rendering while the item can't be seen
+  public: bool suspendHidden{true};
+
+  /// \brief True while rendering is stopped because the item can't be
+  /// seen
+  public: bool suspended{false};
+
+  /// \brief True once the first frame was delivered. Rendering isn't
+  /// suspended before, so the scene is created even if it starts hidden.
+  public: bool frameDelivered{false};
+
+  /// \brief Connection to the visibility of the item's window
+  public: QMetaObject::Connection windowVisibility;
+
+  /// \brief Restarted on every size change, the render texture is
+  /// resized when it times out
+  public: QTimer resizeTimer;
+
+  /// \brief Latest mouse event from remote viewers, kept apart from the
+  /// local one so their presses and drags don't mix
+  public: common::MouseEvent remoteMouseEvent;
+
+  /// \brief Node receiving the input of remote viewers
+  public: transport::Node streamNode;
 };
 
 /// \brief Private data class for MinimalScene
 class gz::gui::plugins::MinimalScene::Implementation
 {
+  /// \brief Polls the render window for the frame timing overlay
+  public: QTimer frameTimingTimer;
+
+  /// \brief Frame timing summary shown on the overlay
+  public: QString frameTiming;
+
+  /// \brief Scene loading progress shown on the overlay
+  public: QString loadProgress;
+
+  /// \brief Quality preset
+  public: QString quality{"high"};
+
+  /// \brief True if the quality was changed at runtime, so it's saved
+  public: bool qualityChanged{false};
 };
 
 using namespace gz;
 using namespace gui;
 using namespace plugins;
 
-QList<QThread *> RenderWindowItem::Implementation::threads;
+/// \brief Events from other plugins handled by the scene
+using SceneEvents = events::Dispatcher<
+    events::SceneChanged,
+    events::SceneLoadProgress>;
+
+std::map<std::string, RenderWindowItem::Implementation::SceneThread>
+    RenderWindowItem::Implementation::sceneThreads;
+std::mutex RenderWindowItem::Implementation::sceneThreadsMutex;
 
 /////////////////////////////////////////////////
 void RenderSync::WaitForQtThreadAndBlock(std::unique_lock<std::mutex> &_lock)
@@ -294,6 +932,95 @@ void RenderSync::Shutdown()
   }
 }
 
+/////////////////////////////////////////////////
+unsigned int RenderSync::AcquireWriteSlot()
+{
+  std::lock_guard<std::mutex> lock(this->swapMutex);
+  for (unsigned int i = 0; i < kSwapChainSize; ++i)
+  {
+    if (static_cast<int>(i) != this->frontSlot &&
+        static_cast<int>(i) != this->readySlot)
+    {
+      return i;
+    }
+  }
+  // Unreachable with 3 or more slots
+  return 0u;
+}
+
+/////////////////////////////////////////////////
+void RenderSync::PublishSlot(unsigned int _slot, int _textureId,
+    const QSize &_size, std::chrono::steady_clock::time_point _inputTime)
+{
+  std::lock_guard<std::mutex> lock(this->swapMutex);
+  this->slotTextureIds[_slot] = _textureId;
+  this->slotSizes[_slot] = _size;
+  this->readySlot = static_cast<int>(_slot);
+  if (_inputTime != std::chrono::steady_clock::time_point() &&
+      (this->readyInputTime == std::chrono::steady_clock::time_point() ||
+      _inputTime < this->readyInputTime))
+  {
+    this->readyInputTime = _inputTime;
+  }
+}
+
+/////////////////////////////////////////////////
+bool RenderSync::AcquireFrontSlot(int &_textureId, QSize &_size)
+{
+  std::lock_guard<std::mutex> lock(this->swapMutex);
+  if (this->readySlot < 0)
+    return false;
+
+  this->frontSlot = this->readySlot;
+  this->readySlot = -1;
+  _textureId = this->slotTextureIds[this->frontSlot];
+  _size = this->slotSizes[this->frontSlot];
+  this->RecordPresentedLocked();
+  return true;
+}
+
+/////////////////////////////////////////////////
+void RenderSync::PublishFrameInput(
+    std::chrono::steady_clock::time_point _inputTime)
+{
+  if (_inputTime == std::chrono::steady_clock::time_point())
+    return;
+
+  std::lock_guard<std::mutex> lock(this->swapMutex);
+  if (this->readyInputTime == std::chrono::steady_clock::time_point() ||
+      _inputTime < this->readyInputTime)
+  {
+    this->readyInputTime = _inputTime;
+  }
+}
+
+/////////////////////////////////////////////////
+void RenderSync::FramePresented()
+{
+  std::lock_guard<std::mutex> lock(this->swapMutex);
+  this->RecordPresentedLocked();
+}
+
+/////////////////////////////////////////////////
+std::vector<double> RenderSync::TakeInputLatencies()
+{
+  std::vector<double> latencies;
+  std::lock_guard<std::mutex> lock(this->swapMutex);
+  latencies.swap(this->presentedMs);
+  return latencies;
+}
+
+/////////////////////////////////////////////////
+void RenderSync::RecordPresentedLocked()
+{
+  if (this->readyInputTime == std::chrono::steady_clock::time_point())
+    return;
+
+  this->presentedMs.push_back(std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - this->readyInputTime).count());
+  this->readyInputTime = std::chrono::steady_clock::time_point();
+}
+
 /////////////////////////////////////////////////
 GzRenderer::GzRenderer()
   : dataPtr(utils::MakeUniqueImpl<Implementation>())
@@ -305,94 +1032,310 @@ GzRenderer::GzRenderer()
 /////////////////////////////////////////////////
 void GzRenderer::Render(RenderSync *_renderSync)
 {
+  GZ_GUI_PROFILE_THREAD_NAME("Render");
+  GZ_GUI_PROFILE_FRAME("Frame");
+  GZ_GUI_PROFILE("GzRenderer::Render");
+  if (_renderSync->tripleBuffering)
+  {
+    // Qt only samples swap chain slots, never the camera texture, so the
+    // worker doesn't need to block Qt, not even to rebuild the camera
+    // texture on resize.
+    _renderSync->frameRequested = false;
+    if (this->inputLatency)
+      this->RecordInputLatency(_renderSync);
+    if (!this->RenderFrame())
+      return;
+
+    unsigned int slot = _renderSync->AcquireWriteSlot();
+    int textureId = 0;
+    if (this->dataPtr->rhi->CopyToSlot(slot, this->textureSize, &textureId))
+    {
+      _renderSync->PublishSlot(slot, textureId, this->textureSize,
+          this->dataPtr->frameInputTime);
+    }
+    return;
+  }
+
   std::unique_lock<std::mutex> lock(_renderSync->mutex);
+  auto waitStart = std::chrono::steady_clock::now();
   _renderSync->WaitForQtThreadAndBlock(lock);
+  this->dataPtr->phaseMs[Implementation::kWaitQt] =
+      std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - waitStart).count();
+  if (this->inputLatency)
+    this->RecordInputLatency(_renderSync);
+  this->RenderFrame();
+  _renderSync->PublishFrameInput(this->dataPtr->frameInputTime);
+  _renderSync->ReleaseQtThreadFromBlock(lock);
+}
 
+/////////////////////////////////////////////////
+bool GzRenderer::RenderFrame()
+{
+  GZ_GUI_PROFILE("GzRenderer::RenderFrame");
+  // Only read the clock when measuring
+  const bool timing = this->frameTiming;
+  std::chrono::steady_clock::time_point phaseStart;
+  if (timing)
+  {
+    RenderHooks::SetTimingEnabled(true);
+    phaseStart = std::chrono::steady_clock::now();
+  }
+  auto endPhase = [&](Implementation::FramePhase _phase)
+  {
+    if (!timing)
+      return;
+    auto now = std::chrono::steady_clock::now();
+    this->dataPtr->phaseMs[_phase] =
+        std::chrono::duration<double, std::milli>(now - phaseStart).count();
+    phaseStart = now;
+  };
+
+  const bool adaptiveScale = this->targetFrameTimeMs > 0.0;
+  std::chrono::steady_clock::time_point frameStart;
+  if (adaptiveScale)
+    frameStart = std::chrono::steady_clock::now();
+
+  bool qualityChanged = this->UpdateQuality();
+
+  bool textureRebuilt = this->textureDirty;
   if (this->textureDirty)
   {
-    // TODO(anyone) If SwapFromThread gets implemented,
-    // then we only need to lock when texture is dirty
-    // (but we still need to lock the whole routine if
-    // debugging from RenderDoc or if user is not willing
-    // to sacrifice VRAM)
-    //
-    // std::unique_lock<std::mutex> lock(renderSync->mutex);
-    // _renderSync->WaitForQtThreadAndBlock(lock);
+    double scale = adaptiveScale ? math::clamp(
+        this->dataPtr->currentScale.load(), this->minRenderScale,
+        this->renderScale) : this->renderScale;
+    this->dataPtr->currentScale = scale;
+    this->textureSize = QSize(
+        std::max(1, static_cast<int>(std::lround(
+        this->itemSize.width() * scale))),
+        std::max(1, static_cast<int>(std::lround(
+        this->itemSize.height() * scale))));
+
     this->dataPtr->camera->SetImageWidth(this->textureSize.width());
     this->dataPtr->camera->SetImageHeight(this->textureSize.height());
     this->dataPtr->camera->SetHFOV(this->cameraHFOV);
     // setting the size should cause the render texture to be rebuilt
     this->dataPtr->camera->PreRender();
     this->textureDirty = false;
-
-    // TODO(anyone) See SwapFromThread comments
-    // _renderSync->ReleaseQtThreadFromBlock(lock);
+    this->dataPtr->RecordTextureMemory(this->textureSize,
+        this->quality.msaa);
   }
 
   // Update the render interface (texture)
   this->dataPtr->rhi->Update(this->dataPtr->camera);
+  endPhase(Implementation::kRhiUpdate);
 
   // view control
+  ScenePicker::NewFrame();
   this->HandleMouseEvent();
+  endPhase(Implementation::kMouse);
 
+  // Hooks run once per frame of the scene, on its first viewport, unless
+  // they ask for every viewport
+  RenderHooks::Run(RenderPhase::kPreRender, this->sceneName,
+      !this->extraViewport);
+  endPhase(Implementation::kPreRender);
   if (gz::gui::App())
   {
+    gui::events::PreRender preRenderEvent;
     gz::gui::App()->sendEvent(
-        gz::gui::App()->findChild<gz::gui::MainWindow *>(),
-        new gui::events::PreRender());
+        gz::gui::App()->MainWin(), &preRenderEvent);
   }
+  endPhase(Implementation::kPreRenderEvents);
 
-  // update and render to texture
-  this->dataPtr->camera->Update();
+  auto cameraPose = this->dataPtr->camera->WorldPose();
+  bool cameraMoved = cameraPose != this->dataPtr->lastCameraPose;
+  if (cameraMoved)
+  {
+    this->dataPtr->lastCameraPose = cameraPose;
+    this->dataPtr->cameraMoved = true;
+    std::lock_guard<std::mutex> lock(this->dataPtr->cameraPoseMutex);
+    this->dataPtr->sharedCameraPose = cameraPose;
+    this->dataPtr->hasSharedCameraPose = true;
+  }
 
-  if (!this->cameraViewController.empty())
+  // Plugins apply their changes on the render event, so changes made on the
+  // previous frame are picked up here
+  bool rendered = true;
+  if (this->dirtyTracking)
+  {
+    uint64_t revision = this->dataPtr->sceneRevision;
+    rendered = this->dataPtr->firstFrame || textureRebuilt || cameraMoved ||
+        revision != this->dataPtr->renderedRevision;
+    this->dataPtr->renderedRevision = revision;
+    this->dataPtr->firstFrame = false;
+  }
+
+  // update and render to texture, otherwise the previous texture is
+  // presented again
+  this->dataPtr->frameInputTime = std::chrono::steady_clock::time_point();
+  if (rendered)
   {
-    std::string viewControlService = "/gui/camera/view_control";
-    transport::Node node;
-    std::function<void(const msgs::Boolean &, const bool)> cb =
-        [&](const msgs::Boolean &/*_rep*/, const bool _result)
+    this->dataPtr->UpdateLightBudget(this->quality, qualityChanged);
+    if (timing)
+      this->dataPtr->rhi->BeginGpuTimer();
+    this->dataPtr->camera->Update();
+    if (timing)
+      this->dataPtr->rhi->EndGpuTimer();
+
+    // Input is only shown once a frame is rendered
+    auto &inputTime = this->dataPtr->pendingInputTime;
+    if (inputTime != std::chrono::steady_clock::time_point())
     {
-      if (!_result)
-      {
-        // LCOV_EXCL_START
-        gzerr << "Error setting view controller. Check if the View Angle GUI "
-                 "plugin is loaded." << std::endl;
-        // LCOV_EXCL_STOP
-      }
-      this->cameraViewController = "";
-    };
+      this->dataPtr->updatedMs.push_back(
+          std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - inputTime).count());
+      this->dataPtr->frameInputTime = inputTime;
+      inputTime = std::chrono::steady_clock::time_point();
+    }
+  }
+  endPhase(Implementation::kCameraUpdate);
+
+  if (this->renderStats && rendered)
+    this->dataPtr->RecordRenderStats(this->renderStatsTopic);
 
+  if (this->dataPtr->streamer)
+    this->dataPtr->streamer->Capture(this->dataPtr->camera, rendered);
+
+  if (!this->cameraViewController.empty())
+  {
     msgs::StringMsg req;
     req.set_data(this->cameraViewController);
-    node.Request(viewControlService, req, cb);
+    this->cameraViewController.clear();
+
+    this->QueueTransportCommand([req](transport::Node &_node)
+    {
+      std::function<void(const msgs::Boolean &, const bool)> cb =
+          [](const msgs::Boolean &/*_rep*/, const bool _result)
+      {
+        if (!_result)
+        {
+          // LCOV_EXCL_START
+          gzerr << "Error setting view controller. Check if the View Angle "
+                   "GUI plugin is loaded." << std::endl;
+          // LCOV_EXCL_STOP
+        }
+      };
+
+      // The request is kept by the node until the service is advertised
+      _node.Request("/gui/camera/view_control", req, cb);
+    });
   }
 
+  this->ProcessTransportCommands();
+  endPhase(Implementation::kTransport);
+
+  RenderHooks::Run(RenderPhase::kRender, this->sceneName,
+      !this->extraViewport);
+  endPhase(Implementation::kRender);
   if (gz::gui::App())
   {
+    gui::events::Render renderEvent;
     gz::gui::App()->sendEvent(
-        gz::gui::App()->findChild<gz::gui::MainWindow *>(),
-        new gui::events::Render());
+        gz::gui::App()->MainWin(), &renderEvent);
   }
-  _renderSync->ReleaseQtThreadFromBlock(lock);
+  endPhase(Implementation::kRenderEvents);
+
+  this->BroadcastHoverToScene();
+
+  if (timing)
+    this->RecordFrameTiming();
+
+  if (adaptiveScale && rendered)
+  {
+    this->AdaptRenderScale(std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - frameStart).count());
+  }
+  return rendered;
 }
 
 /////////////////////////////////////////////////
 void GzRenderer::HandleMouseEvent()
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  for (const auto &e : this->dataPtr->mouseEvents)
+  // Hovers and drops only keep the latest one, mouse and key events are
+  // broadcast in order
+  std::vector<InputEvent> events;
+  InputEvent input;
+  while (this->dataPtr->inputQueue.Pop(input))
   {
-    this->dataPtr->mouseEvent = e;
+    switch (input.kind)
+    {
+      case InputEvent::Kind::kHover:
+        this->dataPtr->mouseHoverPos = input.pos;
+        this->dataPtr->hoverDirty = true;
+        break;
+      case InputEvent::Kind::kDrop:
+        this->dataPtr->dropText = std::move(input.text);
+        this->dataPtr->mouseDropPos = input.pos;
+        this->dataPtr->dropDirty = true;
+        break;
+      case InputEvent::Kind::kMouse:
+        // Replace the previous move, keeping where it started, so the
+        // handlers get the whole motion since the last frame in a single
+        // event. Bursts of scrolls, such as from a trackpad, become a
+        // single scroll of their sum.
+        if (!events.empty() && events.back().kind == InputEvent::Kind::kMouse
+            && canCoalesce(events.back().mouse, input.mouse))
+        {
+          if (input.mouse.Type() == common::MouseEvent::SCROLL)
+          {
+            input.mouse.SetScroll(
+                events.back().mouse.Scroll() + input.mouse.Scroll());
+          }
+          input.mouse.SetPrevPos(events.back().mouse.PrevPos());
+          input.time = events.back().time;
+          events.back() = std::move(input);
+          break;
+        }
+        events.push_back(std::move(input));
+        break;
+      case InputEvent::Kind::kKey:
+        events.push_back(std::move(input));
+        break;
+    }
+  }
+
+  // The latency of a frame is measured from the oldest input it shows
+  if (!events.empty() && this->inputLatency)
+  {
+    auto oldest = std::min_element(events.begin(), events.end(),
+        [](const InputEvent &_a, const InputEvent &_b)
+        {
+          return _a.time < _b.time;
+        })->time;
+    if (oldest != std::chrono::steady_clock::time_point())
+    {
+      this->dataPtr->handledMs.push_back(
+          std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - oldest).count());
+      auto &pending = this->dataPtr->pendingInputTime;
+      if (pending == std::chrono::steady_clock::time_point())
+        pending = oldest;
+    }
+  }
+
+  for (const auto &e : events)
+  {
+    if (e.kind == InputEvent::Kind::kKey)
+    {
+      this->dataPtr->keyEvent = e.key;
+      this->dataPtr->mouseEvent.SetControl(e.key.Control());
+      this->dataPtr->mouseEvent.SetShift(e.key.Shift());
+      this->dataPtr->mouseEvent.SetAlt(e.key.Alt());
+      this->BroadcastKeyPress();
+      this->BroadcastKeyRelease();
+      continue;
+    }
+
+    this->dataPtr->mouseEvent = e.mouse;
+    this->dataPtr->mouseDirty = true;
 
     this->BroadcastDrag();
     this->BroadcastMousePress();
     this->BroadcastLeftClick();
     this->BroadcastRightClick();
     this->BroadcastScroll();
-    this->BroadcastKeyPress();
-    this->BroadcastKeyRelease();
   }
-  this->dataPtr->mouseEvents.clear();
 
   this->BroadcastHoverPos();
   this->BroadcastDrop();
@@ -402,25 +1345,23 @@ void GzRenderer::HandleMouseEvent()
 ////////////////////////////////////////////////
 void GzRenderer::HandleKeyPress(const common::KeyEvent &_e)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  this->dataPtr->keyEvent = _e;
-
-  this->dataPtr->mouseEvent.SetControl(this->dataPtr->keyEvent.Control());
-  this->dataPtr->mouseEvent.SetShift(this->dataPtr->keyEvent.Shift());
-  this->dataPtr->mouseEvent.SetAlt(this->dataPtr->keyEvent.Alt());
+  InputEvent input;
+  input.kind = InputEvent::Kind::kKey;
+  input.key = _e;
+  if (this->inputLatency)
+    input.time = std::chrono::steady_clock::now();
+  this->dataPtr->PushInput(std::move(input));
 }
 
 ////////////////////////////////////////////////
 void GzRenderer::HandleKeyRelease(const common::KeyEvent &_e)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  this->dataPtr->keyEvent = _e;
-
-  this->dataPtr->mouseEvent.SetControl(this->dataPtr->keyEvent.Control());
-  this->dataPtr->mouseEvent.SetShift(this->dataPtr->keyEvent.Shift());
-  this->dataPtr->mouseEvent.SetAlt(this->dataPtr->keyEvent.Alt());
+  InputEvent input;
+  input.kind = InputEvent::Kind::kKey;
+  input.key = _e;
+  if (this->inputLatency)
+    input.time = std::chrono::steady_clock::now();
+  this->dataPtr->PushInput(std::move(input));
 }
 
 /////////////////////////////////////////////////
@@ -430,7 +1371,7 @@ void GzRenderer::BroadcastDrop()
     return;
   events::DropOnScene dropOnSceneEvent(
     this->dataPtr->dropText, this->dataPtr->mouseDropPos);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &dropOnSceneEvent);
+  App()->sendEvent(App()->MainWin(), &dropOnSceneEvent);
   this->dataPtr->dropDirty = false;
 }
 
@@ -440,38 +1381,58 @@ void GzRenderer::BroadcastHoverPos()
   if (!this->dataPtr->hoverDirty)
     return;
 
-  auto pos = rendering::screenToScene(this->dataPtr->mouseHoverPos,
-      this->dataPtr->camera, this->dataPtr->rayQuery, 1000);
-
-  events::HoverToScene hoverToSceneEvent(pos);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &hoverToSceneEvent);
+  this->dataPtr->hoverToSceneDirty = true;
+  this->dataPtr->hoverToScenePos = this->dataPtr->mouseHoverPos;
 
   common::MouseEvent hoverMouseEvent = this->dataPtr->mouseEvent;
   hoverMouseEvent.SetPos(this->dataPtr->mouseHoverPos);
   hoverMouseEvent.SetDragging(false);
   hoverMouseEvent.SetType(common::MouseEvent::MOVE);
   events::HoverOnScene hoverOnSceneEvent(hoverMouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &hoverOnSceneEvent);
+  App()->sendEvent(App()->MainWin(), &hoverOnSceneEvent);
 
   this->dataPtr->hoverDirty = false;
 }
 
 /////////////////////////////////////////////////
-void GzRenderer::BroadcastDrag()
+void GzRenderer::BroadcastHoverToScene()
 {
-  if (!this->dataPtr->mouseDirty)
+  if (!this->dataPtr->hoverToSceneDirty)
     return;
 
-  // Only broadcast drag if dragging
-  if (!this->dataPtr->mouseEvent.Dragging())
+  // Picking is the costly part of hovering, and readouts don't need it on
+  // every frame. The latest position is picked once the period is over.
+  auto now = std::chrono::steady_clock::now();
+  if (this->hoverRate > 0.0 &&
+      now - this->dataPtr->lastHoverToScene <
+      std::chrono::duration<double>(1.0 / this->hoverRate))
+  {
     return;
+  }
+  this->dataPtr->lastHoverToScene = now;
+  this->dataPtr->hoverToSceneDirty = false;
 
-  events::DragOnScene dragEvent(this->dataPtr->mouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &dragEvent);
+  auto pos = this->dataPtr->ScreenToScene(this->dataPtr->hoverToScenePos);
+  events::HoverToScene hoverToSceneEvent(pos);
+  App()->sendEvent(App()->MainWin(), &hoverToSceneEvent);
 }
 
 /////////////////////////////////////////////////
-void GzRenderer::BroadcastLeftClick()
+void GzRenderer::BroadcastDrag()
+{
+  if (!this->dataPtr->mouseDirty)
+    return;
+
+  // Only broadcast drag if dragging
+  if (!this->dataPtr->mouseEvent.Dragging())
+    return;
+
+  events::DragOnScene dragEvent(this->dataPtr->mouseEvent);
+  App()->sendEvent(App()->MainWin(), &dragEvent);
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::BroadcastLeftClick()
 {
   if (!this->dataPtr->mouseDirty)
     return;
@@ -480,14 +1441,13 @@ void GzRenderer::BroadcastLeftClick()
       this->dataPtr->mouseEvent.Type() != common::MouseEvent::RELEASE)
     return;
 
-  auto pos = rendering::screenToScene(this->dataPtr->mouseEvent.Pos(),
-      this->dataPtr->camera, this->dataPtr->rayQuery, 1000);
+  auto pos = this->dataPtr->ScreenToScene(this->dataPtr->mouseEvent.Pos());
 
   events::LeftClickToScene leftClickToSceneEvent(pos);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &leftClickToSceneEvent);
+  App()->sendEvent(App()->MainWin(), &leftClickToSceneEvent);
 
   events::LeftClickOnScene leftClickOnSceneEvent(this->dataPtr->mouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &leftClickOnSceneEvent);
+  App()->sendEvent(App()->MainWin(), &leftClickOnSceneEvent);
 }
 
 /////////////////////////////////////////////////
@@ -500,14 +1460,13 @@ void GzRenderer::BroadcastRightClick()
       this->dataPtr->mouseEvent.Type() != common::MouseEvent::RELEASE)
     return;
 
-  auto pos = rendering::screenToScene(this->dataPtr->mouseEvent.Pos(),
-      this->dataPtr->camera, this->dataPtr->rayQuery, 1000);
+  auto pos = this->dataPtr->ScreenToScene(this->dataPtr->mouseEvent.Pos());
 
   events::RightClickToScene rightClickToSceneEvent(pos);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &rightClickToSceneEvent);
+  App()->sendEvent(App()->MainWin(), &rightClickToSceneEvent);
 
   events::RightClickOnScene rightClickOnSceneEvent(this->dataPtr->mouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &rightClickOnSceneEvent);
+  App()->sendEvent(App()->MainWin(), &rightClickOnSceneEvent);
 }
 
 /////////////////////////////////////////////////
@@ -520,7 +1479,7 @@ void GzRenderer::BroadcastMousePress()
     return;
 
   events::MousePressOnScene event(this->dataPtr->mouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &event);
+  App()->sendEvent(App()->MainWin(), &event);
 }
 
 /////////////////////////////////////////////////
@@ -533,7 +1492,7 @@ void GzRenderer::BroadcastScroll()
     return;
 
   events::ScrollOnScene scrollOnSceneEvent(this->dataPtr->mouseEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &scrollOnSceneEvent);
+  App()->sendEvent(App()->MainWin(), &scrollOnSceneEvent);
 }
 
 /////////////////////////////////////////////////
@@ -543,7 +1502,7 @@ void GzRenderer::BroadcastKeyRelease()
     return;
 
   events::KeyReleaseOnScene keyRelease(this->dataPtr->keyEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &keyRelease);
+  App()->sendEvent(App()->MainWin(), &keyRelease);
 
   this->dataPtr->keyEvent.SetType(common::KeyEvent::NO_EVENT);
 }
@@ -555,7 +1514,7 @@ void GzRenderer::BroadcastKeyPress()
     return;
 
   events::KeyPressOnScene keyPress(this->dataPtr->keyEvent);
-  App()->sendEvent(App()->findChild<MainWindow *>(), &keyPress);
+  App()->sendEvent(App()->MainWin(), &keyPress);
 
   this->dataPtr->keyEvent.SetType(common::KeyEvent::NO_EVENT);
 }
@@ -566,6 +1525,8 @@ std::string GzRenderer::Initialize()
   if (this->initialized)
     return std::string();
 
+  StartupProfiler::Scope profile(this->engineName, "Initialize render engine");
+
   // Currently only support one engine at a time
   rendering::RenderEngine *engine{nullptr};
   auto loadedEngines = rendering::loadedEngines();
@@ -596,27 +1557,51 @@ std::string GzRenderer::Initialize()
     return "Engine [" + this->engineName + "] is not supported";
   }
 
+  // Quality set before initialization applies from the first frame
+  this->UpdateQuality();
+
   // Scene
-  if (engine->SceneCount() > 0)
+  rendering::ScenePtr scene;
+  if (this->extraViewport)
   {
-    return "Currently only one plugin providing a 3D scene is supported at a "
-            "time.";
+    scene = engine->SceneByName(this->sceneName);
+    if (nullptr == scene)
+    {
+      return "Failed to find scene [" + this->sceneName + "] to add a "
+          "viewport to";
+    }
+    gzdbg << "Add viewport to scene [" << this->sceneName << "]" << std::endl;
   }
-
-  gzdbg << "Create scene [" << this->sceneName << "]" << std::endl;
-  auto scene = engine->CreateScene(this->sceneName);
-  if (nullptr == scene)
+  else
   {
-    return "Failed to create scene [" + this->sceneName + "] for engine [" +
-        this->engineName + "]";
-  }
-  scene->SetAmbientLight(this->ambientLight);
-  scene->SetBackgroundColor(this->backgroundColor);
-  scene->SetCameraPassCountPerGpuFlush(6u);
+    if (engine->SceneCount() > 0)
+    {
+      return "Currently only one plugin providing a 3D scene is supported at "
+             "a time. Use the same <scene> name to add a viewport to the "
+             "existing scene.";
+    }
 
-  if (this->skyEnable)
-  {
-    scene->SetSkyEnabled(true);
+    gzdbg << "Create scene [" << this->sceneName << "]" << std::endl;
+    scene = engine->CreateScene(this->sceneName);
+    if (nullptr == scene)
+    {
+      return "Failed to create scene [" + this->sceneName + "] for engine [" +
+          this->engineName + "]";
+    }
+    scene->SetAmbientLight(this->ambientLight);
+    scene->SetBackgroundColor(this->backgroundColor);
+    scene->SetCameraPassCountPerGpuFlush(6u);
+
+    if (this->quality.shadowTextureSize > 0u)
+    {
+      scene->SetShadowTextureSize(rendering::LightType::DIRECTIONAL,
+          this->quality.shadowTextureSize);
+    }
+
+    if (this->quality.sky.value_or(this->skyEnable))
+    {
+      scene->SetSkyEnabled(true);
+    }
   }
 
   auto root = scene->RootVisual();
@@ -630,18 +1615,35 @@ std::string GzRenderer::Initialize()
   this->dataPtr->camera->SetFarClipPlane(this->cameraFarClip);
   this->dataPtr->camera->SetImageWidth(this->textureSize.width());
   this->dataPtr->camera->SetImageHeight(this->textureSize.height());
-  this->dataPtr->camera->SetAntiAliasing(8);
+  this->dataPtr->camera->SetAntiAliasing(this->quality.msaa);
   this->dataPtr->camera->SetHFOV(this->cameraHFOV);
   // setting the size and calling PreRender should cause the render texture to
   // be rebuilt
   this->dataPtr->camera->PreRender();
+  this->dataPtr->RecordTextureMemory(this->textureSize, this->quality.msaa);
 
   // Update the render interface (texture)
   this->dataPtr->rhi->Update(this->dataPtr->camera);
 
+  this->WarmUp();
+
   // Ray Query
   this->dataPtr->rayQuery = this->dataPtr->camera->Scene()->CreateRayQuery();
 
+  // Shared with other plugins, so each position is only picked once per
+  // frame
+  ScenePicker::SetPicker([this](const math::Vector2i &_pos,
+      PickResult &_result)
+  {
+    return this->dataPtr->Pick(_pos, _result);
+  });
+
+  if (!this->streamTopic.empty())
+  {
+    this->dataPtr->streamer = std::make_unique<SceneStreamer>(
+        this->streamTopic, this->streamFps, this->streamQuality);
+  }
+
   this->initialized = true;
   return std::string();
 }
@@ -666,17 +1668,32 @@ void GzRenderer::SetGraphicsAPI(const rendering::GraphicsAPI &_graphicsAPI)
     this->dataPtr->rhi = std::make_unique<GzCameraTextureRhiMetal>();
   }
 #endif
+  else if (_graphicsAPI == rendering::GraphicsAPI::VULKAN)
+  {
+    gzdbg << "Creating gz-rendering interface for Vulkan" << std::endl;
+    this->dataPtr->rhiParams["vulkan"] = "1";
+    this->dataPtr->rhi = std::make_unique<GzCameraTextureRhiVulkan>();
+  }
 }
 
 /////////////////////////////////////////////////
 void GzRenderer::Destroy()
 {
+  ScenePicker::SetPicker(nullptr);
+  this->dataPtr->streamer.reset();
+
   auto engine = rendering::engine(this->engineName);
   if (!engine)
     return;
   auto scene = engine->SceneByName(this->sceneName);
   if (!scene)
     return;
+  if (this->dataPtr->camera)
+  {
+    GpuMemory::Release("MinimalScene", GpuMemory::Resource::kTextures,
+        this->dataPtr->camera->Name());
+    RenderStats::Remove(this->dataPtr->camera->Name());
+  }
   scene->DestroySensor(this->dataPtr->camera);
 
   // If that was the last sensor, destroy scene
@@ -692,29 +1709,736 @@ void GzRenderer::Destroy()
 /////////////////////////////////////////////////
 void GzRenderer::NewHoverEvent(const math::Vector2i &_hoverPos)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  this->dataPtr->mouseHoverPos = _hoverPos;
-  this->dataPtr->hoverDirty = true;
+  InputEvent input;
+  input.kind = InputEvent::Kind::kHover;
+  input.pos = scalePos(_hoverPos, this->dataPtr->currentScale);
+  this->dataPtr->PushInput(std::move(input));
 }
 
 /////////////////////////////////////////////////
 void GzRenderer::NewDropEvent(const std::string &_dropText,
   const math::Vector2i &_dropPos)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  this->dataPtr->dropText = _dropText;
-  this->dataPtr->mouseDropPos = _dropPos;
-  this->dataPtr->dropDirty = true;
+  InputEvent input;
+  input.kind = InputEvent::Kind::kDrop;
+  input.text = _dropText;
+  input.pos = scalePos(_dropPos, this->dataPtr->currentScale);
+  this->dataPtr->PushInput(std::move(input));
 }
 
 /////////////////////////////////////////////////
 void GzRenderer::NewMouseEvent(const common::MouseEvent &_e)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  if (this->dataPtr->mouseEvents.size() >= this->dataPtr->kMaxMouseEventSize)
-    this->dataPtr->mouseEvents.pop_front();
-  this->dataPtr->mouseEvents.push_back(_e);
-  this->dataPtr->mouseDirty = true;
+  // Positions are relative to the camera image, which may be smaller than
+  // the render window
+  InputEvent input;
+  input.mouse = _e;
+  if (this->inputLatency)
+    input.time = std::chrono::steady_clock::now();
+  double scale = this->dataPtr->currentScale;
+  input.mouse.SetPos(scalePos(_e.Pos(), scale));
+  input.mouse.SetPrevPos(scalePos(_e.PrevPos(), scale));
+  input.mouse.SetPressPos(scalePos(_e.PressPos(), scale));
+  this->dataPtr->PushInput(std::move(input));
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::QueueTransportCommand(
+    std::function<void(transport::Node &)> _command)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->transportMutex);
+  this->dataPtr->transportCommands.push_back(std::move(_command));
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::ProcessTransportCommands()
+{
+  std::vector<std::function<void(transport::Node &)>> commands;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->transportMutex);
+    if (this->dataPtr->transportCommands.empty())
+      return;
+    commands.swap(this->dataPtr->transportCommands);
+  }
+
+  for (auto &command : commands)
+    command(this->dataPtr->node);
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::RecordFrameTiming()
+{
+  auto &impl = *this->dataPtr;
+  for (int i = 0; i < Implementation::kFramePhaseCount; ++i)
+    impl.phaseSumMs[i] += impl.phaseMs[i];
+  impl.phaseMs[Implementation::kWaitQt] = 0.0;
+
+  for (auto phase : {RenderPhase::kPreRender, RenderPhase::kRender})
+  {
+    for (const auto &[name, ms] : RenderHooks::Timings(phase))
+      impl.hookSumMs[name] += ms;
+  }
+
+  double gpuMs = impl.rhi->GpuTimeMs();
+  if (gpuMs >= 0.0)
+  {
+    impl.gpuSumMs += gpuMs;
+    ++impl.gpuFrames;
+  }
+
+  if (++impl.timingFrames < impl.kFrameTimingWindow)
+    return;
+
+  // Average over the window
+  const double frames = static_cast<double>(impl.timingFrames);
+  msgs::Param msg;
+  auto addParam = [&msg](const std::string &_name, double _ms)
+  {
+    auto &param = (*msg.mutable_params())[_name];
+    param.set_type(msgs::Any::DOUBLE);
+    param.set_double_value(_ms);
+  };
+
+  std::ostringstream summary;
+  summary << std::fixed << std::setprecision(2);
+
+  double totalMs = 0.0;
+  for (int i = 0; i < Implementation::kFramePhaseCount; ++i)
+    totalMs += impl.phaseSumMs[i] / frames;
+  addParam("total", totalMs);
+  summary << "total " << totalMs << " ms";
+
+  if (impl.gpuFrames > 0)
+  {
+    double avgGpuMs = impl.gpuSumMs / impl.gpuFrames;
+    addParam("gpu", avgGpuMs);
+    summary << ", gpu " << avgGpuMs << " ms";
+  }
+  summary << std::endl;
+
+  for (int i = 0; i < Implementation::kFramePhaseCount; ++i)
+  {
+    double avgMs = impl.phaseSumMs[i] / frames;
+    addParam(Implementation::kFramePhaseNames[i], avgMs);
+    summary << Implementation::kFramePhaseNames[i] << " " << avgMs
+            << std::endl;
+  }
+
+  for (const auto &[name, sumMs] : impl.hookSumMs)
+  {
+    double avgMs = sumMs / frames;
+    addParam("hook/" + name, avgMs);
+    summary << "  " << name << " " << avgMs << std::endl;
+  }
+
+  RenderStats::Frame stats;
+  if (this->renderStats && RenderStats::Latest(impl.camera->Name(), stats))
+  {
+    summary << "draw calls " << stats.drawCalls << ", triangles "
+            << stats.triangles << ", batches " << stats.batches << std::endl
+            << "visible " << stats.visibleNodes << ", culled "
+            << stats.culledNodes << ", static " << stats.staticNodes
+            << std::endl;
+  }
+
+  if (!this->frameTimingTopic.empty())
+  {
+    if (!impl.timingAdvertised)
+    {
+      impl.timingPub = impl.node.Advertise<msgs::Param>(
+          this->frameTimingTopic);
+      impl.timingAdvertised = true;
+    }
+    impl.timingPub.Publish(msg);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(impl.timingMutex);
+    impl.timingSummary = summary.str();
+  }
+
+  impl.phaseSumMs.fill(0.0);
+  impl.hookSumMs.clear();
+  impl.gpuSumMs = 0.0;
+  impl.gpuFrames = 0u;
+  impl.timingFrames = 0u;
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::RecordInputLatency(RenderSync *_renderSync)
+{
+  auto &impl = *this->dataPtr;
+  auto presented = _renderSync->TakeInputLatencies();
+  impl.presentedMs.insert(impl.presentedMs.end(), presented.begin(),
+      presented.end());
+  if (impl.presentedMs.size() < impl.kInputLatencyWindow)
+    return;
+
+  msgs::Param msg;
+  auto addStage = [&msg](const std::string &_stage,
+      std::vector<double> &_samples)
+  {
+    if (_samples.empty())
+      return;
+
+    std::sort(_samples.begin(), _samples.end());
+    auto addParam = [&](const std::string &_name, double _ms)
+    {
+      auto &param = (*msg.mutable_params())[_stage + "/" + _name];
+      param.set_type(msgs::Any::DOUBLE);
+      param.set_double_value(_ms);
+    };
+    auto percentile = [&_samples](double _fraction)
+    {
+      auto index = static_cast<std::size_t>(_fraction * _samples.size());
+      return _samples[std::min(index, _samples.size() - 1)];
+    };
+
+    double sum = 0.0;
+    for (auto ms : _samples)
+      sum += ms;
+    addParam("mean", sum / _samples.size());
+    addParam("p50", percentile(0.5));
+    addParam("p90", percentile(0.9));
+    addParam("p99", percentile(0.99));
+    addParam("max", _samples.back());
+  };
+  addStage("handled", impl.handledMs);
+  addStage("updated", impl.updatedMs);
+  addStage("presented", impl.presentedMs);
+
+  // Histogram of the whole latency, with bounds around common refresh
+  // periods
+  static const std::array<double, 6> kBoundsMs{{8, 16, 33, 50, 100, 200}};
+  std::array<int, kBoundsMs.size() + 1> counts{};
+  for (auto ms : impl.presentedMs)
+  {
+    auto bound = std::lower_bound(kBoundsMs.begin(), kBoundsMs.end(), ms);
+    ++counts[bound - kBoundsMs.begin()];
+  }
+  for (std::size_t i = 0; i < counts.size(); ++i)
+  {
+    std::string name = i < kBoundsMs.size() ?
+        "histogram/le_" + std::to_string(static_cast<int>(kBoundsMs[i])) :
+        std::string("histogram/inf");
+    auto &param = (*msg.mutable_params())[name];
+    param.set_type(msgs::Any::INT32);
+    param.set_int_value(counts[i]);
+  }
+
+  if (!impl.latencyAdvertised)
+  {
+    impl.latencyPub = impl.node.Advertise<msgs::Param>(
+        this->inputLatencyTopic);
+    impl.latencyAdvertised = true;
+  }
+  impl.latencyPub.Publish(msg);
+
+  impl.handledMs.clear();
+  impl.updatedMs.clear();
+  impl.presentedMs.clear();
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::AdaptRenderScale(double _frameTimeMs)
+{
+  auto &impl = *this->dataPtr;
+  impl.scaleFrameSumMs += _frameTimeMs;
+  if (++impl.scaleFrames < impl.kScaleWindow)
+    return;
+
+  double avgMs = impl.scaleFrameSumMs / impl.scaleFrames;
+  impl.scaleFrameSumMs = 0.0;
+  impl.scaleFrames = 0u;
+
+  // Every change reallocates the render texture, so only react to clear
+  // trends, in coarse steps
+  double scale = impl.currentScale;
+  double newScale = scale;
+  if (avgMs > this->targetFrameTimeMs * 1.1)
+    newScale = std::max(this->minRenderScale, scale - 0.1);
+  else if (avgMs < this->targetFrameTimeMs * 0.7)
+    newScale = std::min(this->renderScale, scale + 0.05);
+
+  if (math::equal(newScale, scale))
+    return;
+
+  impl.currentScale = newScale;
+  this->textureDirty = true;
+}
+
+/////////////////////////////////////////////////
+std::string GzRenderer::FrameTimingSummary()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->timingMutex);
+  return this->dataPtr->timingSummary;
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::MarkDirty()
+{
+  ++this->dataPtr->sceneRevision;
+}
+
+/////////////////////////////////////////////////
+bool RenderQuality::Preset(const std::string &_name, RenderQuality &_quality)
+{
+  _quality = RenderQuality();
+  if (_name == "low")
+  {
+    _quality.msaa = 0u;
+    _quality.shadowTextureSize = 512u;
+    _quality.sky = false;
+    _quality.maxLights = 8u;
+    _quality.maxShadowLights = 1u;
+  }
+  else if (_name == "medium")
+  {
+    _quality.msaa = 4u;
+    _quality.shadowTextureSize = 1024u;
+    _quality.maxLights = 32u;
+    _quality.maxShadowLights = 2u;
+  }
+  else if (_name != "high")
+  {
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::SetQuality(const RenderQuality &_quality)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->qualityMutex);
+    this->dataPtr->pendingQuality = _quality;
+  }
+  this->dataPtr->qualityPending = true;
+  this->MarkDirty();
+}
+
+/////////////////////////////////////////////////
+bool GzRenderer::UpdateQuality()
+{
+  if (!this->dataPtr->qualityPending.exchange(false))
+    return false;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->qualityMutex);
+    if (!this->dataPtr->pendingQuality)
+      return false;
+    this->quality = *this->dataPtr->pendingQuality;
+    this->dataPtr->pendingQuality.reset();
+  }
+
+  if (!this->dataPtr->camera)
+    return true;
+
+  // The scene is shared by all viewports, the last one to change wins
+  auto scene = this->dataPtr->camera->Scene();
+  if (this->quality.shadowTextureSize > 0u)
+  {
+    scene->SetShadowTextureSize(rendering::LightType::DIRECTIONAL,
+        this->quality.shadowTextureSize);
+  }
+  if (this->quality.sky)
+    scene->SetSkyEnabled(*this->quality.sky);
+
+  // Applied when the render texture is rebuilt
+  this->dataPtr->camera->SetAntiAliasing(this->quality.msaa);
+  this->textureDirty = true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::WarmUp()
+{
+  if (this->warmupMaterials.empty() && this->warmupMarkers.empty())
+    return;
+
+  StartupProfiler::Scope profile(this->sceneName, "Warm up shaders");
+  auto camera = this->dataPtr->camera;
+  auto scene = camera->Scene();
+
+  // Small and in front of the camera, so nothing is culled and a single
+  // render compiles everything. The camera's texture is overwritten by the
+  // first frame.
+  auto root = scene->CreateVisual();
+  scene->RootVisual()->AddChild(root);
+  root->SetWorldPosition(camera->WorldPosition() +
+      camera->WorldRotation() * math::Vector3d(this->cameraNearClip + 1.0,
+      0.0, 0.0));
+  root->SetLocalScale(0.01);
+
+  unsigned int count{0u};
+  for (const auto &kind : this->warmupMaterials)
+  {
+    auto material = scene->CreateMaterial();
+    material->SetDiffuse(math::Color::White);
+    if (kind == "unlit")
+    {
+      material->SetLightingEnabled(false);
+    }
+    else if (kind == "transparent")
+    {
+      material->SetTransparency(0.5);
+      material->SetDepthWriteEnabled(false);
+    }
+    else if (kind == "pbr")
+    {
+      material->SetMetalness(0.5);
+      material->SetRoughness(0.5);
+    }
+
+    auto visual = scene->CreateVisual();
+    visual->AddGeometry(scene->CreateBox());
+    visual->SetMaterial(material, true /* clone */);
+    scene->DestroyMaterial(material);
+    visual->SetLocalPosition(0.0, count++, 0.0);
+    root->AddChild(visual);
+  }
+
+  for (const auto &kind : this->warmupMarkers)
+  {
+    auto material = scene->CreateMaterial();
+    material->SetDiffuse(math::Color::White);
+    material->SetLightingEnabled(false);
+
+    // Enough points to make a shape of every type
+    auto marker = scene->CreateMarker();
+    marker->SetType(warmupMarkerTypes().at(kind));
+    marker->SetMaterial(material, true /* clone */);
+    scene->DestroyMaterial(material);
+    marker->AddPoint(math::Vector3d::Zero, math::Color::White);
+    marker->AddPoint(math::Vector3d::UnitY, math::Color::White);
+    marker->AddPoint(math::Vector3d::UnitZ, math::Color::White);
+
+    auto visual = scene->CreateVisual();
+    visual->AddGeometry(marker);
+    visual->SetLocalPosition(0.0, count++, 0.0);
+    root->AddChild(visual);
+  }
+
+  camera->Update();
+  scene->DestroyVisual(root, true);
+
+  gzdbg << "Warmed up " << count << " materials and markers" << std::endl;
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::Implementation::RecordTextureMemory(const QSize &_size,
+    unsigned int _msaa)
+{
+  // Color and depth per sample, and a resolved color target with MSAA
+  uint64_t pixels = static_cast<uint64_t>(_size.width()) *
+      static_cast<uint64_t>(_size.height());
+  uint64_t bytes = pixels * 8u * std::max(1u, _msaa);
+  if (_msaa > 1u)
+    bytes += pixels * 4u;
+  GpuMemory::Record("MinimalScene", GpuMemory::Resource::kTextures,
+      this->camera->Name(), bytes);
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::Implementation::RecordRenderStats(const std::string &_topic)
+{
+  if (++this->renderStatsFrames < this->kRenderStatsPeriod)
+    return;
+  this->renderStatsFrames = 0u;
+
+  auto scene = this->camera->Scene();
+  math::Frustum frustum(this->camera->NearClipPlane(),
+      this->camera->FarClipPlane(), this->camera->HFOV(),
+      this->camera->AspectRatio(), this->camera->WorldPose());
+  const auto mask = this->camera->VisibilityMask();
+
+  // Marks of destroyed visuals are dropped, and bounds of visuals which
+  // aren't static anymore are computed again
+  auto staticIds = RenderStats::StaticVisuals();
+  std::unordered_map<unsigned int, math::AxisAlignedBox> staticBounds;
+  for (auto id : staticIds)
+  {
+    if (!scene->HasVisualId(id))
+    {
+      RenderStats::SetStatic(id, false);
+      continue;
+    }
+    auto it = this->staticBounds.find(id);
+    if (it != this->staticBounds.end())
+      staticBounds.insert(*it);
+  }
+
+  RenderStats::Frame frame;
+  std::unordered_set<std::string> materials;
+  for (unsigned int i = 0; i < scene->VisualCount(); ++i)
+  {
+    auto visual = scene->VisualByIndex(i);
+    if (nullptr == visual || visual->GeometryCount() == 0u)
+      continue;
+
+    math::AxisAlignedBox box;
+    if (std::binary_search(staticIds.begin(), staticIds.end(),
+        visual->Id()))
+    {
+      ++frame.staticNodes;
+      auto it = staticBounds.find(visual->Id());
+      if (it == staticBounds.end())
+        it = staticBounds.emplace(visual->Id(), visual->BoundingBox()).first;
+      box = it->second;
+    }
+    else
+    {
+      box = visual->BoundingBox();
+    }
+
+    // Visuals without bounds, such as empty markers, count as visible
+    bool hasBounds = box.Min().X() <= box.Max().X();
+    if ((visual->VisibilityFlags() & mask) == 0u ||
+        (hasBounds && !frustum.Contains(box)))
+    {
+      ++frame.culledNodes;
+      continue;
+    }
+    ++frame.visibleNodes;
+
+    for (unsigned int g = 0; g < visual->GeometryCount(); ++g)
+    {
+      auto geometry = visual->GeometryByIndex(g);
+      auto mesh = std::dynamic_pointer_cast<rendering::Mesh>(geometry);
+      if (nullptr == mesh)
+      {
+        ++frame.drawCalls;
+        auto material = geometry->Material();
+        materials.insert(nullptr == material ? "" : material->Name());
+        continue;
+      }
+
+      for (unsigned int s = 0; s < mesh->SubMeshCount(); ++s)
+      {
+        ++frame.drawCalls;
+        auto material = mesh->SubMeshByIndex(s)->Material();
+        materials.insert(nullptr == material ? "" : material->Name());
+      }
+      frame.triangles += this->MeshTriangles(*mesh);
+    }
+  }
+  frame.batches = materials.size();
+  this->staticBounds = std::move(staticBounds);
+
+  RenderStats::Record(this->camera->Name(), frame);
+
+  if (_topic.empty())
+    return;
+
+  if (!this->statsAdvertised)
+  {
+    this->statsPub = this->node.Advertise<msgs::Param>(_topic);
+    this->statsAdvertised = true;
+  }
+
+  msgs::Param msg;
+  auto addParam = [&msg](const std::string &_name, uint64_t _value)
+  {
+    auto &param = (*msg.mutable_params())[_name];
+    param.set_type(msgs::Any::INT32);
+    param.set_int_value(static_cast<int>(std::min<uint64_t>(_value,
+        std::numeric_limits<int>::max())));
+  };
+  addParam("draw_calls", frame.drawCalls);
+  addParam("triangles", frame.triangles);
+  addParam("visible_nodes", frame.visibleNodes);
+  addParam("culled_nodes", frame.culledNodes);
+  addParam("batches", frame.batches);
+  addParam("static_nodes", frame.staticNodes);
+  this->statsPub.Publish(msg);
+}
+
+/////////////////////////////////////////////////
+void GzRenderer::Implementation::UpdateLightBudget(
+    const RenderQuality &_quality, bool _force)
+{
+  if (_quality.maxLights == 0u && _quality.maxShadowLights == 0u &&
+      this->budgetedLights.empty())
+  {
+    return;
+  }
+  if (++this->lightBudgetFrames < this->kLightBudgetPeriod && !_force)
+    return;
+  this->lightBudgetFrames = 0u;
+
+  GZ_GUI_PROFILE("GzRenderer::UpdateLightBudget");
+  auto scene = this->camera->Scene();
+  math::Frustum frustum(this->camera->NearClipPlane(),
+      this->camera->FarClipPlane(), this->camera->HFOV(),
+      this->camera->AspectRatio(), this->camera->WorldPose());
+  const auto cameraPos = this->camera->WorldPosition();
+
+  // Point and spot lights, by importance: how strong they are at the
+  // camera, ten times less if nothing they light is in view
+  std::vector<std::pair<double, rendering::LightPtr>> lights;
+  std::unordered_map<unsigned int, BudgetedLight> budgeted;
+  for (unsigned int i = 0; i < scene->LightCount(); ++i)
+  {
+    auto light = scene->LightByIndex(i);
+    if (nullptr == light ||
+        nullptr != std::dynamic_pointer_cast<rendering::DirectionalLight>(
+        light))
+    {
+      continue;
+    }
+
+    auto it = this->budgetedLights.find(light->Id());
+    BudgetedLight state;
+    if (it != this->budgetedLights.end())
+      state = it->second;
+    else
+      state = {light->Intensity(), light->CastShadows(), false, false};
+
+    double range = std::max(light->AttenuationRange(), 0.0);
+    auto pos = light->WorldPosition();
+    math::Vector3d extent(range, range, range);
+    double importance = state.intensity * std::max(range, 1.0) /
+        std::max(pos.Distance(cameraPos), 1.0);
+    if (!frustum.Contains(math::AxisAlignedBox(pos - extent, pos + extent)))
+      importance *= 0.1;
+
+    // Lights which are on stay on until they're clearly less important,
+    // so that they don't flicker as the camera moves
+    if (!state.off)
+      importance *= 1.25;
+
+    budgeted[light->Id()] = state;
+    lights.emplace_back(importance, light);
+  }
+  std::stable_sort(lights.begin(), lights.end(),
+      [](const auto &_a, const auto &_b)
+      {
+        return _a.first > _b.first;
+      });
+
+  unsigned int shadows{0u};
+  for (std::size_t i = 0; i < lights.size(); ++i)
+  {
+    const auto &light = lights[i].second;
+    auto &state = budgeted[light->Id()];
+
+    bool on = _quality.maxLights == 0u || i < _quality.maxLights;
+    if (on == state.off)
+    {
+      light->SetIntensity(on ? state.intensity : 0.0);
+      state.off = !on;
+    }
+
+    bool shadow = on && state.castShadows &&
+        (_quality.maxShadowLights == 0u ||
+        shadows < _quality.maxShadowLights);
+    if (shadow)
+      ++shadows;
+    bool noShadows = state.castShadows && !shadow;
+    if (noShadows != state.noShadows)
+    {
+      light->SetCastShadows(shadow);
+      state.noShadows = noShadows;
+    }
+  }
+
+  // Only lights the budget changed are tracked
+  this->budgetedLights.clear();
+  for (const auto &[id, state] : budgeted)
+  {
+    if (state.off || state.noShadows)
+      this->budgetedLights.emplace(id, state);
+  }
+}
+
+/////////////////////////////////////////////////
+uint64_t GzRenderer::Implementation::MeshTriangles(
+    const rendering::Mesh &_mesh)
+{
+  const auto &descriptor = _mesh.Descriptor();
+  const common::Mesh *source = descriptor.mesh;
+  if (nullptr == source && !descriptor.meshName.empty())
+  {
+    source = common::MeshManager::Instance()->MeshByName(
+        descriptor.meshName);
+  }
+  if (nullptr == source)
+    return 0u;
+
+  auto key = source->Name() + "/" + descriptor.subMeshName;
+  auto it = this->meshTriangles.find(key);
+  if (it != this->meshTriangles.end())
+    return it->second;
+
+  uint64_t triangles{0u};
+  for (unsigned int i = 0; i < source->SubMeshCount(); ++i)
+  {
+    auto subMesh = source->SubMeshByIndex(i).lock();
+    if (nullptr == subMesh ||
+        subMesh->SubMeshPrimitive() != common::SubMesh::TRIANGLES ||
+        (!descriptor.subMeshName.empty() &&
+        subMesh->Name() != descriptor.subMeshName))
+    {
+      continue;
+    }
+    auto count = subMesh->IndexCount() > 0u ? subMesh->IndexCount() :
+        subMesh->VertexCount();
+    triangles += count / 3u;
+  }
+  this->meshTriangles[key] = triangles;
+  return triangles;
+}
+
+/////////////////////////////////////////////////
+bool GzRenderer::Implementation::Pick(const math::Vector2i &_pos,
+    PickResult &_result)
+{
+  if (nullptr == this->camera || nullptr == this->rayQuery ||
+      this->camera->ImageWidth() == 0u || this->camera->ImageHeight() == 0u)
+  {
+    return false;
+  }
+
+  // Same as rendering::screenToScene, which doesn't return the object.
+  // With engines which support it, such as ogre2, the closest point comes
+  // from the selection buffer rendered on the GPU.
+  double width = this->camera->ImageWidth();
+  double height = this->camera->ImageHeight();
+  math::Vector2d screenPos(2.0 * _pos.X() / width - 1.0,
+      1.0 - 2.0 * _pos.Y() / height);
+  this->rayQuery->SetFromCamera(this->camera, screenPos);
+  auto result = this->rayQuery->ClosestPoint();
+
+  _result.hit = static_cast<bool>(result);
+  _result.point = result.point;
+  _result.objectId = result.objectId;
+  _result.origin = this->rayQuery->Origin();
+  _result.direction = this->rayQuery->Direction();
+  return true;
+}
+
+/////////////////////////////////////////////////
+math::Vector3d GzRenderer::Implementation::ScreenToScene(
+    const math::Vector2i &_pos)
+{
+  PickResult result;
+  if (ScenePicker::Pick(_pos, result))
+    return result.Point(1000);
+  return rendering::screenToScene(_pos, this->camera, this->rayQuery, 1000);
+}
+
+/////////////////////////////////////////////////
+bool GzRenderer::ConsumeCameraMoved()
+{
+  return this->dataPtr->cameraMoved.exchange(false);
+}
+
+/////////////////////////////////////////////////
+bool GzRenderer::CameraPose(math::Pose3d &_pose) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->cameraPoseMutex);
+  _pose = this->dataPtr->sharedCameraPose;
+  return this->dataPtr->hasSharedCameraPose;
 }
 
 /////////////////////////////////////////////////
@@ -723,14 +2447,81 @@ void GzRenderer::TextureId(void* _texturePtr)
   this->dataPtr->rhi->TextureId(_texturePtr);
 }
 
-/////////////////////////////////////////////////
-RenderThread::RenderThread()
-{
-  // Set default graphics API to OpenGL
-  this->SetGraphicsAPI(rendering::GraphicsAPI::OPENGL);
+/////////////////////////////////////////////////
+RenderThread::RenderThread()
+{
+  // Set default graphics API to OpenGL
+  this->SetGraphicsAPI(rendering::GraphicsAPI::OPENGL);
+
+  qRegisterMetaType<RenderSync*>("RenderSync*");
+
+  // Started is emitted from the new thread
+  this->connect(this, &QThread::started, this, &RenderThread::ApplyPolicy,
+      Qt::DirectConnection);
+}
+
+/////////////////////////////////////////////////
+void RenderThread::SetPolicy(const RenderThreadPolicy &_policy)
+{
+  this->policy = _policy;
+}
+
+/////////////////////////////////////////////////
+void RenderThread::ApplyPolicy()
+{
+  // Before the scheduler changes, since Qt maps its priorities to the range
+  // of the current one
+  if (this->policy.priority != QThread::InheritPriority)
+    this->setPriority(this->policy.priority);
+
+#ifdef __linux__
+  if (!this->policy.cpus.empty())
+  {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto cpu : this->policy.cpus)
+      CPU_SET(cpu, &set);
+    int error = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (error != 0)
+    {
+      gzwarn << "Failed to set the render thread's CPU affinity: "
+             << std::strerror(error) << std::endl;
+    }
+  }
+
+  if (this->policy.realtimePriority > 0)
+  {
+    sched_param param{};
+    param.sched_priority = this->policy.realtimePriority;
+    int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (error != 0)
+    {
+      gzwarn << "Failed to make the render thread SCHED_FIFO with priority ["
+             << this->policy.realtimePriority << "]: "
+             << std::strerror(error) << ". It needs CAP_SYS_NICE or an "
+             << "rtprio limit." << std::endl;
+    }
+  }
 
-  RenderWindowItem::Implementation::threads << this;
-  qRegisterMetaType<RenderSync*>("RenderSync*");
+  if (this->policy.nice)
+  {
+    // Linux sets the nice level of a single thread through its thread Id
+    auto tid = static_cast<id_t>(syscall(SYS_gettid));
+    if (setpriority(PRIO_PROCESS, tid, *this->policy.nice) != 0)
+    {
+      gzwarn << "Failed to set the render thread's nice level to ["
+             << *this->policy.nice << "]: " << std::strerror(errno)
+             << std::endl;
+    }
+  }
+#else
+  if (!this->policy.cpus.empty() || this->policy.realtimePriority > 0 ||
+      this->policy.nice)
+  {
+    gzwarn << "The render thread's CPU affinity, real-time priority and "
+           << "nice level are only supported on Linux." << std::endl;
+  }
+#endif
 }
 
 /////////////////////////////////////////////////
@@ -773,7 +2564,7 @@ void RenderThread::SizeChanged()
   if (item->width() <= 0 || item->height() <= 0)
     return;
 
-  this->gzRenderer.textureSize = QSize(item->width(), item->height());
+  this->gzRenderer.itemSize = QSize(item->width(), item->height());
   this->gzRenderer.textureDirty = true;
 }
 
@@ -801,6 +2592,12 @@ void RenderThread::SetContext(QOpenGLContext *_context)
   this->rhi->SetContext(_context);
 }
 
+/////////////////////////////////////////////////
+void RenderThread::SetSharedContext(QOpenGLContext *_context)
+{
+  this->rhi->SetSharedContext(_context);
+}
+
 /////////////////////////////////////////////////
 void RenderThread::SetGraphicsAPI(const rendering::GraphicsAPI &_graphicsAPI)
 {
@@ -820,6 +2617,11 @@ void RenderThread::SetGraphicsAPI(const rendering::GraphicsAPI &_graphicsAPI)
     this->rhi = std::make_unique<RenderThreadRhiMetal>(&this->gzRenderer);
   }
 #endif
+  else if (_graphicsAPI == rendering::GraphicsAPI::VULKAN)
+  {
+    gzdbg << "Creating render thread interface for Vulkan" << std::endl;
+    this->rhi = std::make_unique<RenderThreadRhiVulkan>(&this->gzRenderer);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -852,8 +2654,16 @@ TextureNode::TextureNode(
     this->rhi = std::make_unique<TextureNodeRhiMetal>(_window);
   }
 #endif
+  else if (_graphicsAPI == rendering::GraphicsAPI::VULKAN)
+  {
+    gzdbg << "Creating texture node render interface for Vulkan" << std::endl;
+    this->rhi = std::make_unique<TextureNodeRhiVulkan>(_window);
+  }
 
   this->setTexture(this->rhi->Texture());
+
+  // Smooth upscaling when rendering below the item size
+  this->setFiltering(QSGTexture::Linear);
 }
 
 /////////////////////////////////////////////////
@@ -862,7 +2672,10 @@ TextureNode::~TextureNode() = default;
 /////////////////////////////////////////////////
 void TextureNode::NewTexture(void* _texturePtr, const QSize &_size)
 {
-  this->rhi->NewTexture(_texturePtr, _size);
+  // With triple buffering the texture is picked from the swap chain in
+  // PrepareNode instead
+  if (!this->renderSync.tripleBuffering)
+    this->rhi->NewTexture(_texturePtr, _size);
 
   // We cannot call QQuickWindow::update directly here, as this is only allowed
   // from the rendering thread or GUI thread.
@@ -872,6 +2685,29 @@ void TextureNode::NewTexture(void* _texturePtr, const QSize &_size)
 /////////////////////////////////////////////////
 void TextureNode::PrepareNode()
 {
+  if (this->renderSync.tripleBuffering)
+  {
+    int textureId = 0;
+    QSize size;
+    if (this->renderSync.AcquireFrontSlot(textureId, size))
+      this->rhi->NewTexture(&textureId, size);
+
+    this->rhi->PrepareNode();
+    if (this->rhi->HasNewTexture())
+    {
+      this->setTexture(this->rhi->Texture());
+      this->markDirty(DirtyMaterial);
+    }
+
+    // Don't wait for the worker, just make sure it has a frame to work on
+    if (this->renderSync.renderRequested.exchange(false) &&
+        !this->renderSync.frameRequested.exchange(true))
+    {
+      emit TextureInUse(&this->renderSync);
+    }
+    return;
+  }
+
   this->rhi->PrepareNode();
 
   if (this->rhi->HasNewTexture())
@@ -879,6 +2715,7 @@ void TextureNode::PrepareNode()
     this->setTexture(this->rhi->Texture());
 
     this->markDirty(DirtyMaterial);
+    this->renderSync.FramePresented();
 
     // This will notify the rendering thread that the texture is now being
     // rendered and it can start rendering to the other one.
@@ -904,6 +2741,13 @@ void TextureNode::PrepareNode()
   // If we want these to run in worker thread and stay resolution-synchronized,
   // we probably should use a different method of signals and slots
   // to send work to the worker thread and get results back
+  //
+  // When the frame scheduler doesn't want a new frame yet, we skip both the
+  // emit and the wait. The worker thread stays blocked inside
+  // WaitForQtThreadAndBlock until a frame is due.
+  if (!this->renderSync.renderRequested.exchange(false))
+    return;
+
   emit TextureInUse(&this->renderSync);
 
   this->renderSync.WaitForWorkerThread();
@@ -916,6 +2760,16 @@ RenderWindowItem::RenderWindowItem(QQuickItem *_parent)
   this->setAcceptedMouseButtons(Qt::AllButtons);
   this->setFlag(ItemHasContents);
   this->dataPtr->renderThread = new RenderThread();
+  this->dataPtr->renderThread->gzRenderer.renderDevice =
+      RenderDevice::Selected();
+
+  this->dataPtr->pacingTimer.setSingleShot(true);
+  this->connect(&this->dataPtr->pacingTimer, &QTimer::timeout,
+      this, &RenderWindowItem::RequestFrame);
+  this->dataPtr->resizeTimer.setSingleShot(true);
+  this->dataPtr->resizeTimer.setInterval(100);
+  this->dataPtr->frameTimer.start();
+  this->dataPtr->activityTimer.start();
 }
 
 /////////////////////////////////////////////////
@@ -927,11 +2781,61 @@ RenderWindowItem::~RenderWindowItem()
 /////////////////////////////////////////////////
 void RenderWindowItem::StopRendering()
 {
+  if (this->dataPtr->stopped)
+    return;
+  this->dataPtr->stopped = true;
+
   // Disconnect our QT connections.
   for(auto conn : this->dataPtr->connections)
     QObject::disconnect(conn);
 
   this->dataPtr->renderSync.Shutdown();
+
+  const auto &sceneName = this->dataPtr->renderThread->gzRenderer.sceneName;
+  if (nullptr != this->dataPtr->sharedThread)
+  {
+    if (!this->dataPtr->initialized)
+      return;
+
+    bool running{false};
+    {
+      std::lock_guard<std::mutex> lock(Implementation::sceneThreadsMutex);
+      auto it = Implementation::sceneThreads.find(sceneName);
+      if (it != Implementation::sceneThreads.end() &&
+          it->second.thread == this->dataPtr->sharedThread)
+      {
+        --it->second.extraViewports;
+        running = true;
+      }
+    }
+
+    // The thread keeps rendering the other viewports, only wait for this
+    // viewport to be shut down. All viewports use triple buffering, so the
+    // thread never waits for Qt and this can't deadlock.
+    if (running)
+    {
+      QMetaObject::invokeMethod(this->dataPtr->renderThread,
+                                "ShutDown",
+                                Qt::BlockingQueuedConnection);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(Implementation::sceneThreadsMutex);
+    auto it = Implementation::sceneThreads.find(sceneName);
+    if (it != Implementation::sceneThreads.end() &&
+        it->second.thread == this->dataPtr->renderThread)
+    {
+      if (it->second.extraViewports > 0)
+      {
+        gzwarn << "Closing the first viewport of scene [" << sceneName
+               << "], its other " << it->second.extraViewports
+               << " viewport(s) will stop rendering." << std::endl;
+      }
+      Implementation::sceneThreads.erase(it);
+    }
+  }
   QMetaObject::invokeMethod(this->dataPtr->renderThread,
                             "ShutDown",
                             Qt::QueuedConnection);
@@ -951,30 +2855,112 @@ void RenderWindowItem::Ready()
     this->dataPtr->renderThread->Surface()->create();
   }
 
-  // Carry out initialization on main thread before moving to render thread
-  if (!this->dataPtr->renderThread->Initialize().empty())
+  if (this->dataPtr->renderSync.tripleBuffering &&
+      this->dataPtr->graphicsAPI != rendering::GraphicsAPI::OPENGL)
   {
-    return;
+    gzwarn << "Triple buffering is only supported with OpenGL, falling back "
+           << "to double buffering." << std::endl;
+    this->dataPtr->renderSync.tripleBuffering = false;
   }
 
-  if (this->dataPtr->graphicsAPI == rendering::GraphicsAPI::OPENGL)
+  // Extra viewports render on the thread of the scene's first viewport
+  if (nullptr != this->dataPtr->sharedThread)
   {
-    // Move context to the render thread
-    this->dataPtr->renderThread->Context()->moveToThread(
-        this->dataPtr->renderThread);
+    const auto &sceneName =
+        this->dataPtr->renderThread->gzRenderer.sceneName;
+    std::string error;
+    {
+      std::lock_guard<std::mutex> lock(Implementation::sceneThreadsMutex);
+      auto it = Implementation::sceneThreads.find(sceneName);
+      if (it == Implementation::sceneThreads.end() ||
+          it->second.thread != this->dataPtr->sharedThread)
+      {
+        error = "The first viewport of scene [" + sceneName +
+            "] was closed";
+      }
+      else if (!it->second.renderSync->tripleBuffering ||
+               !this->dataPtr->renderSync.tripleBuffering)
+      {
+        error = "Several viewports of scene [" + sceneName + "] require "
+            "<buffering>triple</buffering> on all of them";
+      }
+      else
+      {
+        ++it->second.extraViewports;
+      }
+    }
+    if (!error.empty())
+    {
+      this->dataPtr->renderThread->errorCb(QString::fromStdString(error));
+      return;
+    }
+
+    // The engine is initialized lazily on the shared thread, where the
+    // shared context is current
+    this->dataPtr->renderThread->gzRenderer.extraViewport = true;
+    this->dataPtr->renderThread->moveToThread(this->dataPtr->sharedThread);
   }
+  else
+  {
+    // Carry out initialization on main thread before moving to render thread
+    if (!this->dataPtr->renderThread->Initialize().empty())
+    {
+      return;
+    }
+
+    if (this->dataPtr->graphicsAPI == rendering::GraphicsAPI::OPENGL)
+    {
+      // Move context to the render thread
+      this->dataPtr->renderThread->Context()->moveToThread(
+          this->dataPtr->renderThread);
+    }
 
-  this->dataPtr->renderThread->moveToThread(this->dataPtr->renderThread);
+    this->dataPtr->renderThread->moveToThread(this->dataPtr->renderThread);
+  }
 
-  this->dataPtr->renderThread->gzRenderer.textureSize =
+  this->dataPtr->renderThread->gzRenderer.itemSize =
       QSize(std::max({this->width(), 1.0}), std::max({this->height(), 1.0}));
 
+  // Only rebuild the render texture once the size settles, meanwhile the
+  // previous texture is stretched over the item
   this->connect(this, &QQuickItem::widthChanged,
-      this->dataPtr->renderThread, &RenderThread::SizeChanged);
+      &this->dataPtr->resizeTimer, qOverload<>(&QTimer::start));
   this->connect(this, &QQuickItem::heightChanged,
+      &this->dataPtr->resizeTimer, qOverload<>(&QTimer::start));
+  this->connect(&this->dataPtr->resizeTimer, &QTimer::timeout,
+      this, &RenderWindowItem::SizeSettled);
+  this->connect(&this->dataPtr->resizeTimer, &QTimer::timeout,
+      this, &RenderWindowItem::Wake);
+  this->connect(this, &RenderWindowItem::SizeSettled,
       this->dataPtr->renderThread, &RenderThread::SizeChanged);
+  this->connect(this, &QQuickItem::widthChanged,
+      this, &RenderWindowItem::Wake);
+  this->connect(this, &QQuickItem::heightChanged,
+      this, &RenderWindowItem::Wake);
+
+  // Stop rendering while the item can't be seen
+  this->connect(this, &QQuickItem::visibleChanged,
+      this, &RenderWindowItem::UpdateSuspended);
+  this->connect(this, &QQuickItem::widthChanged,
+      this, &RenderWindowItem::UpdateSuspended);
+  this->connect(this, &QQuickItem::heightChanged,
+      this, &RenderWindowItem::UpdateSuspended);
+  auto watchWindow = [this](QQuickWindow *_window)
+  {
+    QObject::disconnect(this->dataPtr->windowVisibility);
+    if (nullptr != _window)
+    {
+      this->dataPtr->windowVisibility = this->connect(_window,
+          &QWindow::visibilityChanged, this,
+          &RenderWindowItem::UpdateSuspended);
+    }
+    this->UpdateSuspended();
+  };
+  this->connect(this, &QQuickItem::windowChanged, this, watchWindow);
+  watchWindow(this->window());
 
-  this->dataPtr->renderThread->start();
+  if (nullptr == this->dataPtr->sharedThread)
+    this->dataPtr->renderThread->start();
   this->dataPtr->initializing = false;
   this->dataPtr->initialized = true;
   this->update();
@@ -999,7 +2985,35 @@ QSGNode *RenderWindowItem::updatePaintNode(QSGNode *_node,
     this->dataPtr->renderThread->SetGraphicsAPI(
         this->dataPtr->graphicsAPI);
 
+    // The first viewport of a scene owns its render thread, other
+    // viewports of the same scene render on it
+    RenderThread *sceneThread{nullptr};
     if (this->dataPtr->graphicsAPI == rendering::GraphicsAPI::OPENGL)
+    {
+      const auto &sceneName =
+          this->dataPtr->renderThread->gzRenderer.sceneName;
+      std::lock_guard<std::mutex> lock(Implementation::sceneThreadsMutex);
+      auto it = Implementation::sceneThreads.find(sceneName);
+      if (it != Implementation::sceneThreads.end())
+      {
+        sceneThread = it->second.thread;
+      }
+      else
+      {
+        Implementation::sceneThreads[sceneName] = {
+            this->dataPtr->renderThread, &this->dataPtr->renderSync, 0};
+      }
+    }
+
+    if (nullptr != sceneThread)
+    {
+      this->dataPtr->sharedThread = sceneThread;
+      this->dataPtr->renderThread->SetSharedContext(sceneThread->Context());
+
+      // Initialize on main thread
+      QMetaObject::invokeMethod(this, "Ready", Qt::QueuedConnection);
+    }
+    else if (this->dataPtr->graphicsAPI == rendering::GraphicsAPI::OPENGL)
     {
       QOpenGLContext *current = this->window()->openglContext();
       // Some GL implementations require that the currently bound context is
@@ -1021,7 +3035,8 @@ QSGNode *RenderWindowItem::updatePaintNode(QSGNode *_node,
       // Initialize on main thread
       QMetaObject::invokeMethod(this, "Ready", Qt::QueuedConnection);
     }
-    else if (this->dataPtr->graphicsAPI == rendering::GraphicsAPI::METAL)
+    else if (this->dataPtr->graphicsAPI == rendering::GraphicsAPI::METAL ||
+        this->dataPtr->graphicsAPI == rendering::GraphicsAPI::VULKAN)
     {
       // Initialize on main thread
       QMetaObject::invokeMethod(this, "Ready", Qt::QueuedConnection);
@@ -1056,14 +3071,15 @@ QSGNode *RenderWindowItem::updatePaintNode(QSGNode *_node,
     // texture.
     //
     // This rendering pipeline is throttled by vsync on the scene graph
-    // rendering thread.
+    // rendering thread, and further by ScheduleFrame according to the frame
+    // pacing options.
 
     this->dataPtr->connections << this->connect(this->dataPtr->renderThread,
         &RenderThread::TextureReady, node, &TextureNode::NewTexture,
         Qt::DirectConnection);
     this->dataPtr->connections << this->connect(node,
-        &TextureNode::PendingNewTexture, this->window(),
-        &QQuickWindow::update, Qt::QueuedConnection);
+        &TextureNode::PendingNewTexture, this,
+        &RenderWindowItem::ScheduleFrame, Qt::QueuedConnection);
     this->dataPtr->connections << this->connect(this->window(),
         &QQuickWindow::beforeRendering, node, &TextureNode::PrepareNode,
         Qt::DirectConnection);
@@ -1072,6 +3088,7 @@ QSGNode *RenderWindowItem::updatePaintNode(QSGNode *_node,
         &RenderThread::RenderNext, Qt::QueuedConnection);
 
     // Get the production of FBO textures started..
+    node->renderSync.frameRequested = true;
     QMetaObject::invokeMethod(this->dataPtr->renderThread, "RenderNext",
       Qt::QueuedConnection,
       Q_ARG(RenderSync*, &node->renderSync));
@@ -1082,6 +3099,352 @@ QSGNode *RenderWindowItem::updatePaintNode(QSGNode *_node,
   return node;
 }
 
+/////////////////////////////////////////////////
+void RenderWindowItem::ScheduleFrame()
+{
+  this->dataPtr->framePending = false;
+  this->dataPtr->frameDelivered = true;
+
+  // Resumed with a single frame by UpdateSuspended
+  this->UpdateSuspended();
+  if (this->dataPtr->suspended)
+    return;
+
+  if (this->dataPtr->renderThread->gzRenderer.ConsumeCameraMoved())
+    this->dataPtr->activityTimer.restart();
+
+  double fps = this->dataPtr->maxFps;
+
+  auto window = this->window();
+  bool unfocused = nullptr != window &&
+      (!window->isActive() || window->visibility() == QWindow::Minimized);
+  if (unfocused && this->dataPtr->unfocusedFps > 0.0)
+  {
+    fps = fps > 0.0 ? std::min(fps, this->dataPtr->unfocusedFps) :
+        this->dataPtr->unfocusedFps;
+  }
+
+  if (this->dataPtr->idleFps >= 0.0 &&
+      this->dataPtr->activityTimer.elapsed() > this->dataPtr->kIdleTimeoutMs)
+  {
+    // Stop rendering until Wake is called
+    if (math::equal(this->dataPtr->idleFps, 0.0))
+      return;
+
+    fps = fps > 0.0 ? std::min(fps, this->dataPtr->idleFps) :
+        this->dataPtr->idleFps;
+  }
+
+  qint64 intervalMs = fps > 0.0 ? static_cast<qint64>(1000.0 / fps) : 0;
+  qint64 remainingMs = intervalMs - this->dataPtr->frameTimer.elapsed();
+  if (remainingMs <= 0)
+    this->RequestFrame();
+  else
+    this->dataPtr->pacingTimer.start(static_cast<int>(remainingMs));
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::RequestFrame()
+{
+  this->dataPtr->framePending = true;
+  this->dataPtr->frameTimer.restart();
+  this->dataPtr->renderSync.renderRequested = true;
+  if (nullptr != this->window())
+    this->window()->update();
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::Wake()
+{
+  this->dataPtr->activityTimer.restart();
+
+  // Re-evaluate the schedule right away instead of waiting for a slow idle
+  // or unfocused frame. A pending frame will reschedule once delivered.
+  if (!this->dataPtr->initialized || this->dataPtr->framePending)
+    return;
+
+  this->dataPtr->pacingTimer.stop();
+  this->ScheduleFrame();
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::UpdateSuspended()
+{
+  if (this->dataPtr->stopped)
+    return;
+
+  // Remote viewers still watch the scene while it's hidden here
+  bool suspend = this->dataPtr->suspendHidden &&
+      this->dataPtr->frameDelivered &&
+      this->dataPtr->renderThread->gzRenderer.streamTopic.empty() &&
+      isHidden(this);
+  if (suspend == this->dataPtr->suspended)
+    return;
+  this->dataPtr->suspended = suspend;
+
+  gzdbg << (suspend ? "Suspending" : "Resuming")
+        << " rendering of hidden scene" << std::endl;
+
+  if (nullptr != App())
+  {
+    events::RenderSuspended event(suspend);
+    App()->sendEvent(App()->MainWin(), &event);
+  }
+
+  if (suspend)
+  {
+    this->dataPtr->pacingTimer.stop();
+    return;
+  }
+
+  // Whatever changed while hidden is caught up by a single frame, even if
+  // the frame requested before suspending was never delivered because the
+  // window wasn't drawn
+  this->dataPtr->activityTimer.restart();
+  this->RequestFrame();
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetSuspendHidden(bool _suspend)
+{
+  this->dataPtr->suspendHidden = _suspend;
+  this->UpdateSuspended();
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::MarkDirty()
+{
+  this->dataPtr->renderThread->gzRenderer.MarkDirty();
+
+  // Leave idle mode, which may have stopped rendering altogether
+  QMetaObject::invokeMethod(this, "Wake", Qt::QueuedConnection);
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetDirtyTracking(bool _dirtyTracking)
+{
+  this->dataPtr->renderThread->gzRenderer.dirtyTracking = _dirtyTracking;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetHoverRate(double _rate)
+{
+  this->dataPtr->renderThread->gzRenderer.hoverRate = _rate;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetMaxFps(double _fps)
+{
+  this->dataPtr->maxFps = _fps;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetIdleFps(double _fps)
+{
+  this->dataPtr->idleFps = _fps;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetUnfocusedFps(double _fps)
+{
+  this->dataPtr->unfocusedFps = _fps;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetResizeDelay(int _delayMs)
+{
+  this->dataPtr->resizeTimer.setInterval(std::max(0, _delayMs));
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetQuality(const RenderQuality &_quality)
+{
+  this->dataPtr->renderThread->gzRenderer.SetQuality(_quality);
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetRenderThreadPolicy(
+    const RenderThreadPolicy &_policy)
+{
+  this->dataPtr->renderThread->SetPolicy(_policy);
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetRenderScale(double _scale, double _minScale,
+    double _targetFrameTimeMs)
+{
+  auto &renderer = this->dataPtr->renderThread->gzRenderer;
+  renderer.renderScale = _scale;
+  renderer.minRenderScale = std::min(_minScale, _scale);
+  renderer.targetFrameTimeMs = _targetFrameTimeMs;
+  renderer.textureDirty = true;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::EnableRenderStats(const std::string &_topic)
+{
+  this->dataPtr->renderThread->gzRenderer.renderStatsTopic = _topic;
+  this->dataPtr->renderThread->gzRenderer.renderStats = true;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::EnableFrameTiming(const std::string &_topic)
+{
+  this->dataPtr->renderThread->gzRenderer.frameTimingTopic = _topic;
+  this->dataPtr->renderThread->gzRenderer.frameTiming = true;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::EnableInputLatency(const std::string &_topic)
+{
+  this->dataPtr->renderThread->gzRenderer.inputLatencyTopic = _topic;
+  this->dataPtr->renderThread->gzRenderer.inputLatency = true;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::EnableStream(const std::string &_topic,
+    const std::string &_inputTopic, double _fps, int _quality)
+{
+  auto &renderer = this->dataPtr->renderThread->gzRenderer;
+  renderer.streamTopic = _topic;
+  renderer.streamFps = _fps;
+  renderer.streamQuality = _quality;
+
+  if (_inputTopic.empty())
+    return;
+
+  // Input is received on a transport thread, but goes through the same
+  // path as local input on the Qt thread
+  std::function<void(const msgs::Param &)> cb =
+      [this](const msgs::Param &_msg)
+  {
+    QMetaObject::invokeMethod(this, [this, _msg]
+    {
+      this->OnRemoteInput(_msg);
+    }, Qt::QueuedConnection);
+  };
+  if (!this->dataPtr->streamNode.Subscribe(_inputTopic, cb))
+  {
+    gzerr << "Failed to subscribe to remote input on [" << _inputTopic
+          << "]" << std::endl;
+    return;
+  }
+  gzmsg << "Receiving remote input on [" << _inputTopic << "]"
+        << std::endl;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetWarmUp(const std::vector<std::string> &_materials,
+    const std::vector<std::string> &_markers)
+{
+  auto &renderer = this->dataPtr->renderThread->gzRenderer;
+  renderer.warmupMaterials = _materials;
+  renderer.warmupMarkers = _markers;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::OnRemoteInput(const msgs::Param &_msg)
+{
+  const auto &params = _msg.params();
+  auto text = [&params](const std::string &_name)
+  {
+    auto it = params.find(_name);
+    return it == params.end() ? std::string() : it->second.string_value();
+  };
+  auto number = [&params](const std::string &_name)
+  {
+    auto it = params.find(_name);
+    if (it == params.end())
+      return 0.0;
+    return it->second.type() == msgs::Any::DOUBLE ?
+        it->second.double_value() :
+        static_cast<double>(it->second.int_value());
+  };
+  auto flag = [&params](const std::string &_name)
+  {
+    auto it = params.find(_name);
+    return it != params.end() && it->second.bool_value();
+  };
+
+  const auto type = text("type");
+  if (type == "key_press" || type == "key_release")
+  {
+    common::KeyEvent event;
+    event.SetType(type == "key_press" ? common::KeyEvent::PRESS :
+        common::KeyEvent::RELEASE);
+    event.SetKey(static_cast<int>(number("key")));
+    event.SetText(text("text"));
+    event.SetControl(flag("control"));
+    event.SetShift(flag("shift"));
+    event.SetAlt(flag("alt"));
+    if (event.Type() == common::KeyEvent::PRESS)
+      this->HandleKeyPress(event);
+    else
+      this->HandleKeyRelease(event);
+    return;
+  }
+
+  // Positions are normalized, so viewers don't need to know the window's
+  // size
+  auto &event = this->dataPtr->remoteMouseEvent;
+  event.SetPos(
+      static_cast<int>(std::lround(number("x") * this->width())),
+      static_cast<int>(std::lround(number("y") * this->height())));
+  event.SetControl(flag("control"));
+  event.SetShift(flag("shift"));
+  event.SetAlt(flag("alt"));
+
+  auto button = common::MouseEvent::LEFT;
+  const auto buttonName = text("button");
+  if (buttonName == "middle")
+    button = common::MouseEvent::MIDDLE;
+  else if (buttonName == "right")
+    button = common::MouseEvent::RIGHT;
+
+  if (type == "press")
+  {
+    event.SetType(common::MouseEvent::PRESS);
+    event.SetButton(button);
+    event.SetButtons(event.Buttons() | button);
+    event.SetPressPos(event.Pos());
+    event.SetDragging(false);
+  }
+  else if (type == "release")
+  {
+    event.SetType(common::MouseEvent::RELEASE);
+    event.SetButton(button);
+    event.SetButtons(event.Buttons() & ~button);
+  }
+  else if (type == "move")
+  {
+    event.SetType(common::MouseEvent::MOVE);
+    event.SetDragging(event.Buttons() != common::MouseEvent::NO_BUTTON);
+  }
+  else if (type == "scroll")
+  {
+    event.SetType(common::MouseEvent::SCROLL);
+    event.SetScroll(0, number("scroll") > 0.0 ? -1 : 1);
+  }
+  else
+  {
+    gzwarn << "Ignoring remote input of unknown type [" << type << "]"
+           << std::endl;
+    return;
+  }
+
+  this->dataPtr->renderThread->gzRenderer.NewMouseEvent(event);
+  if (type == "release")
+    event.SetDragging(false);
+  this->Wake();
+}
+
+/////////////////////////////////////////////////
+QString RenderWindowItem::FrameTimingSummary()
+{
+  return QString::fromStdString(
+      this->dataPtr->renderThread->gzRenderer.FrameTimingSummary());
+}
+
 /////////////////////////////////////////////////
 void RenderWindowItem::SetBackgroundColor(const math::Color &_color)
 {
@@ -1109,6 +3472,12 @@ void RenderWindowItem::SetEngineName(const std::string &_name)
   this->dataPtr->renderThread->gzRenderer.engineName = name;
 }
 
+/////////////////////////////////////////////////
+void RenderWindowItem::SetRenderDevice(const std::string &_device)
+{
+  this->dataPtr->renderThread->gzRenderer.renderDevice = _device;
+}
+
 /////////////////////////////////////////////////
 void RenderWindowItem::SetSceneName(const std::string &_name)
 {
@@ -1121,6 +3490,12 @@ void RenderWindowItem::SetCameraPose(const math::Pose3d &_pose)
   this->dataPtr->renderThread->gzRenderer.cameraPose = _pose;
 }
 
+/////////////////////////////////////////////////
+bool RenderWindowItem::CameraPose(math::Pose3d &_pose) const
+{
+  return this->dataPtr->renderThread->gzRenderer.CameraPose(_pose);
+}
+
 /////////////////////////////////////////////////
 void RenderWindowItem::SetCameraNearClip(double _near)
 {
@@ -1161,6 +3536,12 @@ void RenderWindowItem::SetCameraViewController(
     _view_controller;
 }
 
+/////////////////////////////////////////////////
+void RenderWindowItem::SetTripleBuffering(bool _tripleBuffering)
+{
+  this->dataPtr->renderSync.tripleBuffering = _tripleBuffering;
+}
+
 /////////////////////////////////////////////////
 MinimalScene::MinimalScene()
   : Plugin(), dataPtr(utils::MakeUniqueImpl<Implementation>())
@@ -1168,6 +3549,55 @@ MinimalScene::MinimalScene()
   qmlRegisterType<RenderWindowItem>("RenderWindow", 1, 0, "RenderWindow");
 }
 
+/////////////////////////////////////////////////
+std::string MinimalScene::ConfigStr()
+{
+  auto config = Plugin::ConfigStr();
+
+  // Save where the user left the camera, so it's restored with the layout
+  auto renderWindow = this->PluginItem() ?
+      this->PluginItem()->findChild<RenderWindowItem *>() : nullptr;
+  math::Pose3d pose;
+  bool hasPose = nullptr != renderWindow && renderWindow->CameraPose(pose);
+  if (!hasPose && !this->dataPtr->qualityChanged)
+    return config;
+
+  tinyxml2::XMLDocument doc;
+  doc.Parse(config.c_str());
+  auto pluginElem = doc.FirstChildElement("plugin");
+  if (nullptr == pluginElem)
+    return config;
+
+  if (hasPose)
+  {
+    auto elem = pluginElem->FirstChildElement("camera_pose");
+    if (nullptr == elem)
+    {
+      elem = doc.NewElement("camera_pose");
+      pluginElem->InsertEndChild(elem);
+    }
+    std::stringstream poseStr;
+    poseStr << pose;
+    elem->SetText(poseStr.str().c_str());
+  }
+
+  // A preset picked at runtime replaces the configured quality
+  if (this->dataPtr->qualityChanged)
+  {
+    auto elem = pluginElem->FirstChildElement("quality");
+    if (nullptr != elem)
+      pluginElem->DeleteChild(elem);
+    elem = doc.NewElement("quality");
+    elem->SetText(this->dataPtr->quality.toStdString().c_str());
+    pluginElem->InsertEndChild(elem);
+  }
+
+  tinyxml2::XMLPrinter printer;
+  if (!doc.Print(&printer))
+    return config;
+  return printer.CStr();
+}
+
 /////////////////////////////////////////////////
 void MinimalScene::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
@@ -1182,6 +3612,11 @@ void MinimalScene::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
   renderWindow->SetErrorCb(std::bind(&MinimalScene::SetLoadingError, this,
       std::placeholders::_1));
 
+  // Other plugins depend on the scene being rendered, even while the card
+  // is collapsed or scrolled away
+  if (this->CardItem())
+    this->CardItem()->setProperty("cullable", false);
+
   if (this->title.empty())
     this->title = "3D Scene";
 
@@ -1203,6 +3638,32 @@ void MinimalScene::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
     if (nullptr != elem && nullptr != elem->GetText())
       renderWindow->SetSceneName(elem->GetText());
 
+    elem = _pluginElem->FirstChildElement("render_device");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      std::string device = elem->GetText();
+      std::vector<std::pair<std::string, std::string>> variables;
+      if (!RenderDevice::Environment(device, variables))
+        gzerr << "Invalid <render_device> [" << device << "]" << std::endl;
+      else
+        renderWindow->SetRenderDevice(device);
+
+      auto selected = RenderDevice::Selected();
+      if (selected.empty())
+      {
+        gzwarn << "<render_device> can't change the GPU once the "
+               << "application started, choose it with `gz gui "
+               << "--render-device " << device << "` or "
+               << "GZ_GUI_RENDER_DEVICE=" << device << "." << std::endl;
+      }
+      else if (selected != device)
+      {
+        gzwarn << "<render_device> [" << device << "] differs from the "
+               << "render device chosen at startup [" << selected << "]."
+               << std::endl;
+      }
+    }
+
     elem = _pluginElem->FirstChildElement("ambient_light");
     if (nullptr != elem && nullptr != elem->GetText())
     {
@@ -1315,6 +3776,448 @@ void MinimalScene::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
     {
       renderWindow->SetCameraViewController(elem->GetText());
     }
+
+    elem = _pluginElem->FirstChildElement("frame_pacing");
+    if (nullptr != elem && !elem->NoChildren())
+    {
+      auto parseFps = [&elem](const char *_name, double &_fps) -> bool
+      {
+        auto child = elem->FirstChildElement(_name);
+        if (nullptr == child || nullptr == child->GetText())
+          return false;
+
+        if (child->QueryDoubleText(&_fps) != tinyxml2::XML_SUCCESS ||
+            _fps < 0.0)
+        {
+          gzerr << "Unable to set <" << _name << "> to '" << child->GetText()
+                << "', it must be a non-negative number." << std::endl;
+          return false;
+        }
+        return true;
+      };
+
+      double fps;
+      if (parseFps("max_fps", fps))
+        renderWindow->SetMaxFps(fps);
+      if (parseFps("idle_fps", fps))
+        renderWindow->SetIdleFps(fps);
+      if (parseFps("unfocused_fps", fps))
+        renderWindow->SetUnfocusedFps(fps);
+
+      auto suspendElem = elem->FirstChildElement("suspend_hidden");
+      bool suspend{true};
+      if (nullptr != suspendElem &&
+          suspendElem->QueryBoolText(&suspend) == tinyxml2::XML_SUCCESS)
+      {
+        renderWindow->SetSuspendHidden(suspend);
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("dirty_tracking");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      bool dirtyTracking = false;
+      elem->QueryBoolText(&dirtyTracking);
+      renderWindow->SetDirtyTracking(dirtyTracking);
+    }
+
+    elem = _pluginElem->FirstChildElement("hover_rate");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double rate;
+      if (elem->QueryDoubleText(&rate) != tinyxml2::XML_SUCCESS || rate < 0.0)
+      {
+        gzerr << "Unable to set <hover_rate> to '" << elem->GetText()
+              << "', it must be a non-negative number." << std::endl;
+      }
+      else
+      {
+        renderWindow->SetHoverRate(rate);
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("resize_delay");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      int delay;
+      if (elem->QueryIntText(&delay) != tinyxml2::XML_SUCCESS || delay < 0)
+      {
+        gzerr << "Unable to set <resize_delay> to '" << elem->GetText()
+              << "', it must be a non-negative integer." << std::endl;
+      }
+      else
+      {
+        renderWindow->SetResizeDelay(delay);
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("quality");
+    if (nullptr != elem)
+    {
+      RenderQuality quality;
+      std::string preset{"high"};
+      bool custom{false};
+      if (nullptr == elem->FirstChildElement())
+      {
+        if (nullptr != elem->GetText())
+          preset = elem->GetText();
+      }
+      else
+      {
+        auto presetElem = elem->FirstChildElement("preset");
+        if (nullptr != presetElem && nullptr != presetElem->GetText())
+          preset = presetElem->GetText();
+      }
+
+      if (!RenderQuality::Preset(preset, quality))
+      {
+        gzerr << "Unknown quality preset '" << preset
+              << "', it must be low, medium or high. Using high."
+              << std::endl;
+        preset = "high";
+        RenderQuality::Preset(preset, quality);
+      }
+
+      auto parseUnsigned = [&elem, &custom](const char *_name,
+          unsigned int &_value)
+      {
+        auto child = elem->FirstChildElement(_name);
+        if (nullptr == child || nullptr == child->GetText())
+          return;
+
+        if (child->QueryUnsignedText(&_value) != tinyxml2::XML_SUCCESS)
+        {
+          gzerr << "Unable to set <" << _name << "> to '" << child->GetText()
+                << "', it must be a non-negative integer." << std::endl;
+          return;
+        }
+        custom = true;
+      };
+      parseUnsigned("msaa", quality.msaa);
+      parseUnsigned("shadow_texture_size", quality.shadowTextureSize);
+      parseUnsigned("max_lights", quality.maxLights);
+      parseUnsigned("max_shadow_lights", quality.maxShadowLights);
+
+      auto skyElem = elem->FirstChildElement("sky");
+      if (nullptr != skyElem && nullptr != skyElem->GetText())
+      {
+        bool sky{false};
+        skyElem->QueryBoolText(&sky);
+        quality.sky = sky;
+        custom = true;
+      }
+
+      this->dataPtr->quality = QString::fromStdString(
+          custom ? "custom" : preset);
+      renderWindow->SetQuality(quality);
+    }
+
+    elem = _pluginElem->FirstChildElement("render_thread");
+    if (nullptr != elem)
+    {
+      RenderThreadPolicy policy;
+
+      auto child = elem->FirstChildElement("priority");
+      if (nullptr != child && nullptr != child->GetText())
+      {
+        static const std::map<std::string, QThread::Priority> kPriorities{
+            {"idle", QThread::IdlePriority},
+            {"lowest", QThread::LowestPriority},
+            {"low", QThread::LowPriority},
+            {"normal", QThread::NormalPriority},
+            {"high", QThread::HighPriority},
+            {"highest", QThread::HighestPriority},
+            {"time_critical", QThread::TimeCriticalPriority}};
+        auto it = kPriorities.find(child->GetText());
+        if (it == kPriorities.end())
+        {
+          gzerr << "Unknown <priority> '" << child->GetText()
+                << "', it must be one of idle, lowest, low, normal, high, "
+                << "highest and time_critical." << std::endl;
+        }
+        else
+        {
+          policy.priority = it->second;
+        }
+      }
+
+      child = elem->FirstChildElement("cpu_affinity");
+      if (nullptr != child && nullptr != child->GetText())
+      {
+        std::istringstream cpus(child->GetText());
+        int cpu;
+        while (cpus >> cpu)
+        {
+          if (cpu >= 0)
+            policy.cpus.push_back(cpu);
+        }
+        if (!cpus.eof() || policy.cpus.empty())
+        {
+          gzerr << "Unable to set <cpu_affinity> to '" << child->GetText()
+                << "', it must be space-separated CPU indices."
+                << std::endl;
+          policy.cpus.clear();
+        }
+      }
+
+      child = elem->FirstChildElement("realtime_priority");
+      if (nullptr != child && nullptr != child->GetText())
+      {
+        int priority;
+        if (child->QueryIntText(&priority) != tinyxml2::XML_SUCCESS ||
+            priority < 1 || priority > 99)
+        {
+          gzerr << "Unable to set <realtime_priority> to '"
+                << child->GetText() << "', it must be from 1 to 99."
+                << std::endl;
+        }
+        else
+        {
+          policy.realtimePriority = priority;
+        }
+      }
+
+      child = elem->FirstChildElement("nice");
+      if (nullptr != child && nullptr != child->GetText())
+      {
+        int nice;
+        if (child->QueryIntText(&nice) != tinyxml2::XML_SUCCESS ||
+            nice < -20 || nice > 19)
+        {
+          gzerr << "Unable to set <nice> to '" << child->GetText()
+                << "', it must be from -20 to 19." << std::endl;
+        }
+        else
+        {
+          policy.nice = nice;
+        }
+      }
+
+      renderWindow->SetRenderThreadPolicy(policy);
+    }
+
+    elem = _pluginElem->FirstChildElement("render_scale");
+    if (nullptr != elem)
+    {
+      auto parseScale = [&elem](const char *_name, double &_value,
+          double _min, double _max) -> bool
+      {
+        auto child = elem->FirstChildElement(_name);
+        if (nullptr == child || nullptr == child->GetText())
+          return false;
+
+        double value;
+        if (child->QueryDoubleText(&value) != tinyxml2::XML_SUCCESS ||
+            value <= _min || value > _max)
+        {
+          gzerr << "Unable to set <render_scale><" << _name << "> to '"
+                << child->GetText() << "', it must be in the range ("
+                << _min << ", " << _max << "]." << std::endl;
+          return false;
+        }
+        _value = value;
+        return true;
+      };
+
+      double scale{1.0};
+      double minScale{0.5};
+      double targetFrameTimeMs{0.0};
+      parseScale("scale", scale, 0.0, 1.0);
+      parseScale("min_scale", minScale, 0.0, 1.0);
+      parseScale("target_frame_time", targetFrameTimeMs, 0.0,
+          std::numeric_limits<double>::max());
+      renderWindow->SetRenderScale(scale, minScale, targetFrameTimeMs);
+    }
+
+    elem = _pluginElem->FirstChildElement("frame_timing");
+    if (nullptr != elem)
+    {
+      std::string topic{"/gui/frame_timing"};
+      auto topicElem = elem->FirstChildElement("topic");
+      if (nullptr != topicElem)
+      {
+        topic = nullptr == topicElem->GetText() ? "" :
+            transport::TopicUtils::AsValidTopic(topicElem->GetText());
+        if (topic.empty() && nullptr != topicElem->GetText())
+        {
+          gzerr << "Invalid <frame_timing><topic> [" << topicElem->GetText()
+                << "], frame timings won't be published." << std::endl;
+        }
+      }
+      renderWindow->EnableFrameTiming(topic);
+
+      bool overlay{false};
+      auto overlayElem = elem->FirstChildElement("overlay");
+      if (nullptr != overlayElem)
+        overlayElem->QueryBoolText(&overlay);
+      if (overlay)
+      {
+        this->connect(&this->dataPtr->frameTimingTimer, &QTimer::timeout,
+            this, &MinimalScene::UpdateFrameTiming);
+        this->dataPtr->frameTimingTimer.start(500);
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("render_stats");
+    if (nullptr != elem)
+    {
+      std::string topic{"/gui/render_stats"};
+      auto topicElem = elem->FirstChildElement("topic");
+      if (nullptr != topicElem)
+      {
+        topic = nullptr == topicElem->GetText() ? "" :
+            transport::TopicUtils::AsValidTopic(topicElem->GetText());
+        if (topic.empty() && nullptr != topicElem->GetText())
+        {
+          gzerr << "Invalid <render_stats><topic> ["
+                << topicElem->GetText()
+                << "], render stats won't be published." << std::endl;
+        }
+      }
+      renderWindow->EnableRenderStats(topic);
+    }
+
+    elem = _pluginElem->FirstChildElement("input_latency");
+    if (nullptr != elem)
+    {
+      std::string topic{"/gui/input_latency"};
+      auto topicElem = elem->FirstChildElement("topic");
+      if (nullptr != topicElem && nullptr != topicElem->GetText())
+      {
+        topic = transport::TopicUtils::AsValidTopic(topicElem->GetText());
+      }
+      if (topic.empty())
+      {
+        gzerr << "Invalid <input_latency><topic> [" << topicElem->GetText()
+              << "], input latencies won't be measured." << std::endl;
+      }
+      else
+      {
+        renderWindow->EnableInputLatency(topic);
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("stream");
+    if (nullptr != elem)
+    {
+      std::string topic{"/gui/stream"};
+      auto topicElem = elem->FirstChildElement("topic");
+      if (nullptr != topicElem && nullptr != topicElem->GetText())
+        topic = transport::TopicUtils::AsValidTopic(topicElem->GetText());
+
+      std::string inputTopic{"/gui/stream/input"};
+      auto inputElem = elem->FirstChildElement("input_topic");
+      if (nullptr != inputElem)
+      {
+        inputTopic = nullptr == inputElem->GetText() ? "" :
+            transport::TopicUtils::AsValidTopic(inputElem->GetText());
+      }
+
+      double fps{15.0};
+      auto fpsElem = elem->FirstChildElement("fps");
+      if (nullptr != fpsElem)
+        fpsElem->QueryDoubleText(&fps);
+
+      int quality{75};
+      auto qualityElem = elem->FirstChildElement("quality");
+      if (nullptr != qualityElem)
+        qualityElem->QueryIntText(&quality);
+
+      if (topic.empty())
+      {
+        gzerr << "Invalid <stream><topic>, the scene won't be streamed."
+              << std::endl;
+      }
+      else if (fps <= 0.0)
+      {
+        gzerr << "Invalid <stream><fps> [" << fps
+              << "], the scene won't be streamed." << std::endl;
+      }
+      else
+      {
+        renderWindow->EnableStream(topic, inputTopic, fps,
+            std::clamp(quality, 0, 100));
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("gpu_memory_budget");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double budget;
+      if (elem->QueryDoubleText(&budget) != tinyxml2::XML_SUCCESS ||
+          budget < 0.0)
+      {
+        gzerr << "Unable to set <gpu_memory_budget> to '" << elem->GetText()
+              << "', it must be a non-negative number." << std::endl;
+      }
+      else
+      {
+        GpuMemory::SetBudget(static_cast<uint64_t>(
+            budget * 1024.0 * 1024.0));
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("warmup");
+    if (nullptr != elem)
+    {
+      std::vector<std::string> materials;
+      for (auto child = elem->FirstChildElement("material");
+          nullptr != child; child = child->NextSiblingElement("material"))
+      {
+        std::string kind = nullptr == child->GetText() ? "" :
+            child->GetText();
+        const auto &kinds = warmupMaterialKinds();
+        if (std::find(kinds.begin(), kinds.end(), kind) == kinds.end())
+        {
+          gzerr << "Unknown <warmup><material> [" << kind
+                << "], valid choices are 'lit', 'unlit', 'transparent' "
+                << "and 'pbr'." << std::endl;
+          continue;
+        }
+        materials.push_back(kind);
+      }
+
+      std::vector<std::string> markers;
+      for (auto child = elem->FirstChildElement("marker");
+          nullptr != child; child = child->NextSiblingElement("marker"))
+      {
+        std::string kind = nullptr == child->GetText() ? "" :
+            child->GetText();
+        if (warmupMarkerTypes().find(kind) == warmupMarkerTypes().end())
+        {
+          gzerr << "Unknown <warmup><marker> [" << kind << "]."
+                << std::endl;
+          continue;
+        }
+        markers.push_back(kind);
+      }
+
+      // Everything, if nothing in particular was asked for
+      if (nullptr == elem->FirstChildElement())
+      {
+        materials = warmupMaterialKinds();
+        for (const auto &type : warmupMarkerTypes())
+          markers.push_back(type.first);
+      }
+
+      renderWindow->SetWarmUp(materials, markers);
+    }
+
+    elem = _pluginElem->FirstChildElement("buffering");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      std::string buffering = elem->GetText();
+      if (buffering == "triple")
+      {
+        renderWindow->SetTripleBuffering(true);
+      }
+      else if (buffering != "double")
+      {
+        gzerr << "Unknown <buffering> [" << buffering
+              << "], valid choices are 'double' and 'triple'. Using 'double'."
+              << std::endl;
+      }
+    }
   }
 
   renderWindow->SetEngineName(cmdRenderEngine);
@@ -1324,12 +4227,56 @@ void MinimalScene::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
   // There maybe a better way to solve the problem by making OpenGL calls.
   if (cmdRenderEngine == std::string("ogre2"))
     this->PluginItem()->setProperty("gammaCorrect", true);
+
+  // Listen to scene changes and loading progress from other plugins
+  if (App() && App()->MainWin())
+  {
+    for (auto type : SceneEvents::kTypes)
+      App()->MainWin()->SubscribeEvent(type, this);
+  }
+}
+
+/////////////////////////////////////////////////
+bool MinimalScene::eventFilter(QObject *_obj, QEvent *_event)
+{
+  SceneEvents::Dispatch(_event, events::Handlers{
+    [this](events::SceneChanged &)
+    {
+      auto renderWindow =
+          this->PluginItem()->findChild<RenderWindowItem *>();
+      if (nullptr != renderWindow)
+        renderWindow->MarkDirty();
+    },
+    [this](events::SceneLoadProgress &_progress)
+    {
+      QString text;
+      if (_progress.Progress() < 1.0)
+      {
+        text = QString("Loading scene: %1%").arg(
+            static_cast<int>(_progress.Progress() * 100));
+      }
+      if (_progress.Placeholders() > 0u)
+      {
+        if (!text.isEmpty())
+          text += "\n";
+        text += QString("Decoding meshes of %1 visuals").arg(
+            _progress.Placeholders());
+      }
+      if (text == this->dataPtr->loadProgress)
+        return;
+      this->dataPtr->loadProgress = text;
+      this->LoadProgressChanged();
+    }});
+
+  // Standard event processing
+  return QObject::eventFilter(_obj, _event);
 }
 
 /////////////////////////////////////////////////
 void RenderWindowItem::OnHovered(const gz::math::Vector2i &_hoverPos)
 {
   this->dataPtr->renderThread->gzRenderer.NewHoverEvent(_hoverPos);
+  this->Wake();
 }
 
 /////////////////////////////////////////////////
@@ -1338,6 +4285,7 @@ void RenderWindowItem::OnDropped(const QString &_drop,
 {
   this->dataPtr->renderThread->gzRenderer.NewDropEvent(
     _drop.toStdString(), _dropPos);
+  this->Wake();
 }
 
 /////////////////////////////////////////////////
@@ -1354,6 +4302,7 @@ void RenderWindowItem::mousePressEvent(QMouseEvent *_e)
 
   this->dataPtr->renderThread->gzRenderer.NewMouseEvent(
       this->dataPtr->mouseEvent);
+  this->Wake();
 }
 
 ////////////////////////////////////////////////
@@ -1389,6 +4338,7 @@ void RenderWindowItem::mouseReleaseEvent(QMouseEvent *_e)
 
   this->dataPtr->renderThread->gzRenderer.NewMouseEvent(
       this->dataPtr->mouseEvent);
+  this->Wake();
 }
 
 ////////////////////////////////////////////////
@@ -1404,6 +4354,7 @@ void RenderWindowItem::mouseMoveEvent(QMouseEvent *_e)
 
   this->dataPtr->renderThread->gzRenderer.NewMouseEvent(
       this->dataPtr->mouseEvent);
+  this->Wake();
 }
 
 ////////////////////////////////////////////////
@@ -1414,18 +4365,21 @@ void RenderWindowItem::wheelEvent(QWheelEvent *_e)
   this->dataPtr->mouseEvent = convert(*_e);
   this->dataPtr->renderThread->gzRenderer.NewMouseEvent(
     this->dataPtr->mouseEvent);
+  this->Wake();
 }
 
 ////////////////////////////////////////////////
 void RenderWindowItem::HandleKeyPress(const common::KeyEvent &_e)
 {
   this->dataPtr->renderThread->gzRenderer.HandleKeyPress(_e);
+  this->Wake();
 }
 
 ////////////////////////////////////////////////
 void RenderWindowItem::HandleKeyRelease(const common::KeyEvent &_e)
 {
   this->dataPtr->renderThread->gzRenderer.HandleKeyRelease(_e);
+  this->Wake();
 }
 
 /////////////////////////////////////////////////
@@ -1449,6 +4403,64 @@ void MinimalScene::OnFocusWindow()
   renderWindow->forceActiveFocus();
 }
 
+/////////////////////////////////////////////////
+QString MinimalScene::FrameTiming() const
+{
+  return this->dataPtr->frameTiming;
+}
+
+/////////////////////////////////////////////////
+QString MinimalScene::LoadProgress() const
+{
+  return this->dataPtr->loadProgress;
+}
+
+/////////////////////////////////////////////////
+void MinimalScene::UpdateFrameTiming()
+{
+  auto renderWindow = this->PluginItem()->findChild<RenderWindowItem *>();
+  if (nullptr == renderWindow)
+    return;
+
+  auto summary = renderWindow->FrameTimingSummary();
+  if (summary == this->dataPtr->frameTiming)
+    return;
+
+  this->dataPtr->frameTiming = summary;
+  this->FrameTimingChanged();
+}
+
+/////////////////////////////////////////////////
+QString MinimalScene::Quality() const
+{
+  return this->dataPtr->quality;
+}
+
+/////////////////////////////////////////////////
+void MinimalScene::SetQuality(const QString &_quality)
+{
+  RenderQuality quality;
+  if (!RenderQuality::Preset(_quality.toStdString(), quality))
+  {
+    gzerr << "Unknown quality preset '" << _quality.toStdString()
+          << "', it must be low, medium or high." << std::endl;
+    return;
+  }
+
+  auto renderWindow = this->PluginItem() ?
+      this->PluginItem()->findChild<RenderWindowItem *>() : nullptr;
+  if (nullptr == renderWindow)
+    return;
+
+  renderWindow->SetQuality(quality);
+  this->dataPtr->qualityChanged = true;
+  if (this->dataPtr->quality != _quality)
+  {
+    this->dataPtr->quality = _quality;
+    this->QualityChanged();
+  }
+}
+
 /////////////////////////////////////////////////
 QString MinimalScene::LoadingError() const
 {
@@ -1469,5 +4481,4 @@ void MinimalScene::SetLoadingError(const QString &_loadingError)
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(gz::gui::plugins::MinimalScene,
-              gz::gui::Plugin)
+GZ_GUI_ADD_PLUGIN(gz::gui::plugins::MinimalScene, "MinimalScene")
@@ -18,8 +18,13 @@
 #ifndef GZ_GUI_PLUGINS_MINIMALSCENE_HH_
 #define GZ_GUI_PLUGINS_MINIMALSCENE_HH_
 
+#include <gz/msgs/param.pb.h>
+
+#include <functional>
+#include <optional>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include <gz/common/KeyEvent.hh>
 #include <gz/common/MouseEvent.hh>
@@ -28,6 +33,7 @@
 #include <gz/math/Vector2.hh>
 #include <gz/utils/ImplPtr.hh>
 #include <gz/rendering/GraphicsAPI.hh>
+#include <gz/transport/Node.hh>
 
 #include "gz/gui/Plugin.hh"
 
@@ -43,14 +49,28 @@ namespace plugins
   /// It is possible to orbit the camera around the scene with
   /// the mouse. Use other plugins to manage objects in the scene.
   ///
-  /// Only one plugin displaying a Gazebo Rendering scene can be used at a
-  /// time.
+  /// Several plugins can display the same scene, each with its own camera,
+  /// by using the same \<scene\> name. The first one creates the scene and
+  /// its render thread, the others are extra viewports which render on that
+  /// thread with the same OpenGL context, so the render engine is only ever
+  /// used from one thread. Extra viewports are only supported with OpenGL
+  /// and require triple buffering on every viewport of the scene, so that
+  /// no viewport blocks the shared thread waiting for Qt. Plugins looking
+  /// for the user camera find the first viewport's camera. The
+  /// TransportSceneManager and MarkerManager plugins of each window are
+  /// shared too, so windows showing the same scene only add a camera.
   ///
   /// ## Configuration
   ///
   /// * \<engine\> : Optional render engine name, defaults to 'ogre'. If another
   ///                engine is already loaded, that will be used, because only
   ///                one engine is supported at a time currently.
+  /// * \<render_device\> : Optional GPU the scene is expected to render on,
+  ///                       see RenderDevice. The device is chosen when the
+  ///                       application starts, with `gz gui
+  ///                       --render-device` or GZ_GUI_RENDER_DEVICE, so
+  ///                       this only warns if the scene renders on another
+  ///                       device. Defaults to the device chosen at startup.
   /// * \<scene\> : Optional scene name, defaults to 'scene'. The plugin will
   ///               create a scene with this name if there isn't one yet. If
   ///               there is already one, a new camera is added to it.
@@ -67,9 +87,177 @@ namespace plugins
   /// * \<horizontal_fov\> : Horizontal FOV of the user camera in degrees,
   ///                        defaults to 90
   /// * \<graphics_api\> : Optional graphics API name. Valid choices are:
-  ///                      'opengl', 'metal'. Defaults to 'opengl'.
+  ///                      'opengl', 'metal', 'vulkan'. Defaults to
+  ///                      'opengl'. With 'vulkan', frames are copied through
+  ///                      the CPU into the window, which can use any graphics
+  ///                      API, such as Vulkan with QSG_RHI_BACKEND=vulkan.
   /// * \<view_controller> : Set the view controller (InteractiveViewControl
   ///                        currently supports types: ortho or orbit).
+  /// * \<frame_pacing\> : Optional frame rate limits, all in frames per
+  ///                      second. Without them, frames are rendered as fast
+  ///                      as vsync allows.
+  ///     * \<max_fps\> : Maximum frame rate, 0 for unlimited.
+  ///     * \<idle_fps\> : Frame rate after a second without input or camera
+  ///                      motion. 0 stops rendering until the next input
+  ///                      or events::SceneChanged. Plugins such as
+  ///                      TransportSceneManager and MarkerManager post that
+  ///                      event as soon as new poses, entities or markers
+  ///                      arrive, so they're shown right away.
+  ///     * \<unfocused_fps\> : Frame rate while the window isn't focused or
+  ///                           is minimized.
+  ///     * \<suspend_hidden\> : True to stop rendering while the scene
+  ///                            can't be seen, such as in a collapsed
+  ///                            card, on another tab or in a minimized
+  ///                            window, see events::RenderSuspended.
+  ///                            Defaults to true. Scenes streamed to
+  ///                            remote viewers are never suspended.
+  /// * \<dirty_tracking\> : Optional, defaults to false. If true, the
+  ///                        camera only renders when the camera moved, the
+  ///                        window was resized or a plugin sent an
+  ///                        events::SceneChanged, otherwise the previous
+  ///                        frame is presented again. Only enable it if all
+  ///                        plugins modifying the scene send that event.
+  /// * \<buffering\> : Optional buffering mode, 'double' or 'triple'.
+  ///                   Defaults to 'double', where the render thread and
+  ///                   Qt take turns. With 'triple', the render thread
+  ///                   renders into a swap chain while Qt displays the
+  ///                   newest complete frame. Only supported with OpenGL.
+  /// * \<resize_delay\> : Optional time in milliseconds the window size
+  ///                      must be stable before the render texture is
+  ///                      rebuilt, defaults to 100. Until then, the previous
+  ///                      frame is stretched over the window.
+  /// * \<render_scale\> : Optional, render at a fraction of the window size
+  ///                      and upscale the result, trading sharpness for
+  ///                      frame rate.
+  ///     * \<scale\> : Fraction of the window size, in (0, 1]. Defaults
+  ///                   to 1.
+  ///     * \<target_frame_time\> : Frame time in milliseconds to hold by
+  ///                               lowering the scale while frames take
+  ///                               longer. Defaults to 0, which disables
+  ///                               adaptive scaling.
+  ///     * \<min_scale\> : Lowest scale used by adaptive scaling, defaults
+  ///                       to 0.5.
+  /// * \<frame_timing\> : Optional, measure how long each phase of a frame
+  ///                      takes, including every plugin's render hooks and
+  ///                      the GPU time when timer queries are supported.
+  ///                      Averages over 30 frames are reported.
+  ///     * \<topic\> : Topic to publish gz::msgs::Param messages with the
+  ///                   timings in milliseconds on, defaults to
+  ///                   "/gui/frame_timing". Empty to not publish.
+  ///     * \<overlay\> : True to show the timings on top of the scene,
+  ///                     defaults to false.
+  /// * \<render_stats\> : Optional, count what the camera submits every 30
+  ///                      frames: estimated draw calls and batches,
+  ///                      triangles, and visuals inside and outside of its
+  ///                      frustum, see RenderStats. They're also shown on
+  ///                      the frame timing overlay.
+  ///     * \<topic\> : Topic to publish gz::msgs::Param messages with the
+  ///                   counts on, defaults to "/gui/render_stats". Empty to
+  ///                   not publish.
+  /// * \<input_latency\> : Optional, measure the time from mouse and key
+  ///                       events reaching the render window to the first
+  ///                       frame showing them being presented. Reported
+  ///                       every 30 frames with input.
+  ///     * \<topic\> : Topic to publish gz::msgs::Param messages on,
+  ///                   defaults to "/gui/input_latency". For each of the
+  ///                   "handled", "updated" and "presented" stages, from
+  ///                   input to the plugins handling it, to the camera
+  ///                   update and to presentation, it has the mean, p50,
+  ///                   p90, p99 and max in milliseconds. A histogram of
+  ///                   presentation latencies, "histogram/le_<ms>" and
+  ///                   "histogram/inf", counts frames per bucket.
+  /// * \<quality\> : Optional rendering quality, to scale the GPU cost
+  ///                 to the machine. Either the name of a preset, 'low',
+  ///                 'medium' or 'high', or these children, which override
+  ///                 the values of a preset. The 'quality' property can
+  ///                 switch the preset at runtime.
+  ///     * \<preset\> : Preset the other children override, defaults to
+  ///                    'high', which is what's used without \<quality\>.
+  ///     * \<msaa\> : Anti-aliasing samples, 0 to disable it. 0 for low,
+  ///                  4 for medium and 8 for high.
+  ///     * \<shadow_texture_size\> : Size of the shadow maps of
+  ///                                 directional lights, 0 for the
+  ///                                 engine's default. 512 for low, 1024
+  ///                                 for medium and 0 for high.
+  ///     * \<sky\> : Override \<sky\>. Low disables the sky, the others
+  ///                 keep \<sky\>.
+  ///     * \<max_lights\> : Light budget, the number of point and spot
+  ///                        lights kept on, see Light budget. 0 for no
+  ///                        limit. 8 for low, 32 for medium and 0 for high.
+  ///     * \<max_shadow_lights\> : Number of lights kept casting shadows
+  ///                               among those on. 0 for no limit. 1 for
+  ///                               low, 2 for medium and 0 for high.
+  /// * \<gpu_memory_budget\> : Optional budget in MB for the estimated
+  ///                            GPU memory of the scene's resources, shared
+  ///                            by all plugins, see GpuMemory. Plugins
+  ///                            loading large resources free memory or
+  ///                            load cheaper versions of them to stay
+  ///                            within it. Defaults to 0, no limit.
+  /// * \<warmup\> : Optional, compile the shaders of materials and
+  ///                 markers while the scene is created, instead of
+  ///                 stalling the first frame showing each of them. A
+  ///                 hidden object of each kind is rendered once on the
+  ///                 render thread, before the first frame. Without
+  ///                 children, every kind is warmed up.
+  ///     * \<material\> : Kind of material, repeated for each of them:
+  ///                      'lit', 'unlit', 'transparent' or 'pbr'.
+  ///     * \<marker\> : Kind of marker, repeated for each of them: 'box',
+  ///                    'capsule', 'cylinder', 'sphere', 'line_list',
+  ///                    'line_strip', 'points', 'triangle_fan',
+  ///                    'triangle_list' or 'triangle_strip'.
+  /// * \<render_thread\> : Optional scheduling of the render thread, so it
+  ///                       doesn't compete with other threads on loaded
+  ///                       machines. Extra viewports render on the thread of
+  ///                       the scene's first viewport, so its options apply.
+  ///     * \<priority\> : Qt thread priority, one of 'idle', 'lowest',
+  ///                      'low', 'normal', 'high', 'highest' and
+  ///                      'time_critical'.
+  ///     * \<cpu_affinity\> : Space-separated indices of the CPUs the
+  ///                          thread may run on. Linux only.
+  ///     * \<realtime_priority\> : SCHED_FIFO priority, from 1 to 99.
+  ///                               Requires CAP_SYS_NICE or an rtprio
+  ///                               limit. Linux only.
+  ///     * \<nice\> : Nice level of the thread, from -20 to 19. Negative
+  ///                  levels require CAP_SYS_NICE. Linux only.
+  /// * \<stream\> : Optional, stream the scene to remote viewers, such as
+  ///                a browser behind a websocket bridge. Frames are copied
+  ///                on the render thread, and encoded and published on a
+  ///                worker, only while someone subscribes.
+  ///     * \<topic\> : Topic to publish JPEG frames on as gz::msgs::Bytes,
+  ///                   defaults to "/gui/stream".
+  ///     * \<fps\> : Maximum frame rate, defaults to 15. Unchanged frames
+  ///                 are sent once per second.
+  ///     * \<quality\> : JPEG quality from 0 to 100, defaults to 75.
+  ///     * \<input_topic\> : Topic to receive the viewers' input on as
+  ///                         gz::msgs::Param, defaults to
+  ///                         "/gui/stream/input", empty to ignore input.
+  ///                         "type" is press, release, move, scroll,
+  ///                         key_press or key_release. Mouse input has "x"
+  ///                         and "y" normalized to the image, "button"
+  ///                         which is left, middle or right, and "scroll"
+  ///                         which is positive to zoom in. Key input has
+  ///                         the Qt "key" code and "text". All may have
+  ///                         "control", "shift" and "alt".
+  /// * \<hover_rate\> : Optional maximum rate in Hz at which the hovered
+  ///                    point of the scene is computed for
+  ///                    events::HoverToScene, defaults to 30. It's computed
+  ///                    after the frame is rendered, so plugins get it one
+  ///                    frame late. 0 computes it on every frame.
+  ///
+  /// ## Light budget
+  ///
+  /// Worlds with hundreds of point and spot lights cost far more to render
+  /// than the few which matter from where the camera is. With a light
+  /// budget, the lights are ranked every 15 frames by their intensity times
+  /// their range over their distance to the camera, ten times lower if
+  /// their range is out of view. Only the first \<max_lights\> are kept
+  /// on, the others have their intensity set to 0, and only the first
+  /// \<max_shadow_lights\> of those keep casting shadows. Lights on get a
+  /// margin, so they don't flicker as the camera moves. Settings are
+  /// restored when a light is back within the budget. Directional lights
+  /// are always kept. The renderer's own clustered culling still applies to
+  /// the lights which are on. With several viewports, the last one
+  /// rendered ranks the lights.
   class MinimalScene : public Plugin
   {
     Q_OBJECT
@@ -82,6 +270,28 @@ namespace plugins
       NOTIFY LoadingErrorChanged
     )
 
+    /// \brief Frame timing summary shown on the overlay
+    Q_PROPERTY(
+      QString frameTiming
+      READ FrameTiming
+      NOTIFY FrameTimingChanged
+    )
+
+    /// \brief Scene loading progress shown on the overlay
+    Q_PROPERTY(
+      QString loadProgress
+      READ LoadProgress
+      NOTIFY LoadProgressChanged
+    )
+
+    /// \brief Quality preset, "custom" if the config overrides its values
+    Q_PROPERTY(
+      QString quality
+      READ Quality
+      WRITE SetQuality
+      NOTIFY QualityChanged
+    )
+
     /// \brief Constructor
     public: MinimalScene();
 
@@ -105,6 +315,14 @@ namespace plugins
     public: virtual void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
         override;
 
+    /// \brief Get the configuration, with the camera's current pose as the
+    /// \<camera_pose\>, so saved layouts restore the view.
+    /// \return Config string
+    public: std::string ConfigStr() override;
+
+    // Documentation inherited
+    protected: bool eventFilter(QObject *_obj, QEvent *_event) override;
+
     /// \brief Get the loading error string.
     /// \return String explaining the loading error. If empty, there's no error.
     public: Q_INVOKABLE QString LoadingError() const;
@@ -116,6 +334,34 @@ namespace plugins
     /// \brief Notify that loading error has changed
     signals: void LoadingErrorChanged();
 
+    /// \brief Get the frame timing summary shown on the overlay.
+    /// \return Summary, empty if the overlay is disabled.
+    public: Q_INVOKABLE QString FrameTiming() const;
+
+    /// \brief Notify that the frame timing summary has changed
+    signals: void FrameTimingChanged();
+
+    /// \brief Update the frame timing overlay from the render window
+    private slots: void UpdateFrameTiming();
+
+    /// \brief Get the scene loading progress shown on the overlay.
+    /// \return Progress, empty once the scene is loaded.
+    public: Q_INVOKABLE QString LoadProgress() const;
+
+    /// \brief Notify that the scene loading progress has changed
+    signals: void LoadProgressChanged();
+
+    /// \brief Get the quality preset.
+    /// \return "low", "medium", "high" or "custom"
+    public: Q_INVOKABLE QString Quality() const;
+
+    /// \brief Switch to a quality preset, without restarting.
+    /// \param[in] _quality "low", "medium" or "high"
+    public: Q_INVOKABLE void SetQuality(const QString &_quality);
+
+    /// \brief Notify that the quality preset has changed
+    signals: void QualityChanged();
+
     /// \brief Loading error message
     public: QString loadingError;
 
@@ -126,6 +372,33 @@ namespace plugins
 
   class RenderSync;
 
+  /// \brief Rendering quality settings, see MinimalScene's \<quality\>
+  struct RenderQuality
+  {
+    /// \brief Anti-aliasing samples, 0 to disable it
+    unsigned int msaa{8u};
+
+    /// \brief Shadow map size of directional lights, 0 for the engine's
+    /// default
+    unsigned int shadowTextureSize{0u};
+
+    /// \brief Whether to show the sky, unset to keep \<sky\>
+    std::optional<bool> sky;
+
+    /// \brief Maximum number of lights on, the most important ones to the
+    /// camera, 0 for no limit
+    unsigned int maxLights{0u};
+
+    /// \brief Maximum number of lights casting shadows, 0 for no limit
+    unsigned int maxShadowLights{0u};
+
+    /// \brief Get the settings of a preset.
+    /// \param[in] _name "low", "medium" or "high"
+    /// \param[out] _quality Settings of the preset
+    /// \return False if there's no such preset
+    static bool Preset(const std::string &_name, RenderQuality &_quality);
+  };
+
   /// \brief gz-rendering renderer.
   /// All gz-rendering calls should be performed inside this class as it makes
   /// sure that opengl calls in the underlying render engine do not interfere
@@ -151,6 +424,40 @@ namespace plugins
     /// \param[in] _graphicsAPI The type of graphics API
     public: void SetGraphicsAPI(const rendering::GraphicsAPI &_graphicsAPI);
 
+    /// \brief Queue a command using the renderer's transport node. Commands
+    /// run on the render thread at the end of the next frame, so the node
+    /// is never constructed inside the render loop. Safe to call from any
+    /// thread.
+    /// \param[in] _command Command to run
+    public: void QueueTransportCommand(
+        std::function<void(transport::Node &)> _command);
+
+    /// \brief Bump the scene revision, so the next frame is rendered when
+    /// dirty tracking is enabled. Safe to call from any thread.
+    public: void MarkDirty();
+
+    /// \brief Change the rendering quality, on the next frame if the
+    /// renderer is already initialized. Safe to call from any thread.
+    /// \param[in] _quality Quality settings
+    public: void SetQuality(const RenderQuality &_quality);
+
+    /// \brief Check whether the user camera moved since the last call.
+    /// Safe to call from any thread.
+    /// \return True if the camera moved.
+    public: bool ConsumeCameraMoved();
+
+    /// \brief Get the user camera's pose on the latest frame.
+    /// Safe to call from any thread.
+    /// \param[out] _pose Camera pose
+    /// \return False if the camera hasn't been created yet
+    public: bool CameraPose(math::Pose3d &_pose) const;
+
+    /// \brief Get a human readable summary of the latest frame timings.
+    /// Safe to call from any thread.
+    /// \return One line per frame phase, empty if frame timing is disabled
+    /// or no frames were measured yet.
+    public: std::string FrameTimingSummary();
+
     /// \brief Destroy camera associated with this renderer
     public: void Destroy();
 
@@ -176,12 +483,47 @@ namespace plugins
     /// \param[in] _e The key event to process.
     public: void HandleKeyRelease(const common::KeyEvent &_e);
 
+    /// \brief Render a single frame of the user camera. Must be called from
+    /// Render, which takes care of synchronizing with the Qt thread.
+    /// \return False if dirty tracking skipped the camera update.
+    private: bool RenderFrame();
+
+    /// \brief Run all queued transport commands
+    private: void ProcessTransportCommands();
+
+    /// \brief Apply the quality set with SetQuality, if it changed
+    /// \return True if it changed
+    private: bool UpdateQuality();
+
+    /// \brief Render the materials and markers of warmupMaterials and
+    /// warmupMarkers once, so their shaders are compiled
+    private: void WarmUp();
+
+    /// \brief Accumulate the timings of the frame just rendered, and
+    /// publish their average once enough frames were measured.
+    private: void RecordFrameTiming();
+
+    /// \brief Accumulate the input latencies of the frames presented since
+    /// the last call, and publish a summary once enough were measured.
+    /// \param[in] _renderSync Where the Qt thread records when frames are
+    /// presented
+    private: void RecordInputLatency(RenderSync *_renderSync);
+
+    /// \brief Adapt the render scale to the time taken by the last frame.
+    /// \param[in] _frameTimeMs Time taken to render the frame.
+    private: void AdaptRenderScale(double _frameTimeMs);
+
     /// \brief Handle mouse event for view control
     private: void HandleMouseEvent();
 
-    /// \brief Broadcasts the currently hovered 3d scene location.
+    /// \brief Broadcasts the currently hovered screen position.
     private: void BroadcastHoverPos();
 
+    /// \brief Broadcasts the currently hovered 3d scene location, if the
+    /// mouse moved and the hover rate allows it. Called after rendering, so
+    /// picking doesn't delay the frame.
+    private: void BroadcastHoverToScene();
+
     /// \brief Broadcasts drag events.
     private: void BroadcastDrag();
 
@@ -218,6 +560,10 @@ namespace plugins
     /// \brief Unique scene name
     public: std::string sceneName = "scene";
 
+    /// \brief Device the scene is expected to render on, see RenderDevice.
+    /// Only used to check the device the context was created on.
+    public: std::string renderDevice;
+
     /// \brief Initial Camera pose
     public: math::Pose3d cameraPose = math::Pose3d(0, 0, 2, 0, 0.4, 0);
 
@@ -239,23 +585,105 @@ namespace plugins
     /// \brief Render texture size
     public: QSize textureSize = QSize(1024, 1024);
 
+    /// \brief Size of the item displaying the render texture. The texture
+    /// is rendered at this size times the render scale, and upscaled when
+    /// presented.
+    public: QSize itemSize = QSize(1024, 1024);
+
+    /// \brief Fraction of the item size to render at. With adaptive
+    /// scaling, this is the highest scale used.
+    public: double renderScale{1.0};
+
+    /// \brief Lowest scale used by adaptive scaling
+    public: double minRenderScale{0.5};
+
+    /// \brief Frame time in milliseconds held by adapting the render
+    /// scale, 0 to always render at renderScale
+    public: double targetFrameTimeMs{0.0};
+
     /// \brief Flag to indicate texture size has changed.
     public: bool textureDirty = true;
 
     /// \brief True if sky is enabled;
     public: bool skyEnable = false;
 
+    /// \brief Rendering quality, only accessed on the render thread once
+    /// it's running. Use SetQuality to change it.
+    public: RenderQuality quality;
+
     /// \brief Horizontal FOV of the camera;
     public: math::Angle cameraHFOV = math::Angle(M_PI * 0.5);
 
     /// \brief View controller type
     public: std::string cameraViewController{""};
 
+    /// \brief True to skip camera updates while the scene is unchanged
+    public: bool dirtyTracking{false};
+
+    /// \brief Maximum rate in Hz of events::HoverToScene, 0 for every frame
+    public: double hoverRate{30.0};
+
+    /// \brief True to add a camera to a scene created by another renderer
+    /// instead of creating the scene
+    public: bool extraViewport{false};
+
+    /// \brief True to measure how long each phase of a frame takes
+    public: bool frameTiming{false};
+
+    /// \brief Topic where frame timings are published, empty to not
+    /// publish them
+    public: std::string frameTimingTopic{""};
+
+    /// \brief True to count what the camera submits, see RenderStats
+    public: bool renderStats{false};
+
+    /// \brief Topic where render stats are published, empty to not
+    /// publish them
+    public: std::string renderStatsTopic{""};
+
+    /// \brief True to measure the time from input to its frame being
+    /// presented
+    public: bool inputLatency{false};
+
+    /// \brief Topic where input latencies are published
+    public: std::string inputLatencyTopic{""};
+
+    /// \brief Topic to stream the frames on, empty to not stream
+    public: std::string streamTopic{""};
+
+    /// \brief Maximum frame rate of the stream
+    public: double streamFps{15.0};
+
+    /// \brief JPEG quality of the stream
+    public: int streamQuality{75};
+
+    /// \brief Kinds of materials to warm up on initialization
+    public: std::vector<std::string> warmupMaterials;
+
+    /// \brief Kinds of markers to warm up on initialization
+    public: std::vector<std::string> warmupMarkers;
+
     /// \internal
     /// \brief Pointer to private data.
     GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
   };
 
+  /// \brief Scheduling options of a render thread
+  struct RenderThreadPolicy
+  {
+    /// \brief Qt priority, InheritPriority to keep the default
+    QThread::Priority priority{QThread::InheritPriority};
+
+    /// \brief CPUs the thread may run on, empty for all of them
+    std::vector<int> cpus;
+
+    /// \brief SCHED_FIFO priority, 0 to keep the regular scheduler
+    int realtimePriority{0};
+
+    /// \brief Nice level, if it's changed
+    std::optional<int> nice;
+  };
+
   /// \brief Rendering thread
   class RenderThread : public QThread
   {
@@ -264,6 +692,10 @@ namespace plugins
     /// \brief Constructor
     public: RenderThread();
 
+    /// \brief Set the scheduling options, applied when the thread starts.
+    /// \param[in] _policy Scheduling options
+    public: void SetPolicy(const RenderThreadPolicy &_policy);
+
     /// \brief Render when safe
     /// \param[in] _renderSync RenderSync to safely
     /// synchronize Qt and worker thread (this)
@@ -302,6 +734,11 @@ namespace plugins
     /// \param[in] _context OpenGL context
     public: void SetContext(QOpenGLContext *_context);
 
+    /// \brief Set an OpenGL context owned by another render thread, for
+    /// viewports rendering on that thread.
+    /// \param[in] _context OpenGL context
+    public: void SetSharedContext(QOpenGLContext *_context);
+
     /// \brief Set the graphics API
     /// \param[in] _graphicsAPI The type of graphics API
     public: void SetGraphicsAPI(const rendering::GraphicsAPI &_graphicsAPI);
@@ -313,8 +750,15 @@ namespace plugins
     /// \brief gz-rendering renderer
     public: GzRenderer gzRenderer;
 
+    /// \brief Apply the scheduling options, called on the thread once it
+    /// has started.
+    private slots: void ApplyPolicy();
+
     /// \brief Pointer to render interface to handle OpenGL/Metal compatibility
     private: std::unique_ptr<RenderThreadRhi> rhi;
+
+    /// \brief Scheduling options
+    private: RenderThreadPolicy policy;
   };
 
   /// \brief A QQUickItem that manages the render window
@@ -340,6 +784,10 @@ namespace plugins
     /// \param[in] _name Name of render engine
     public: void SetEngineName(const std::string &_name);
 
+    /// \brief Set the device the scene is expected to render on.
+    /// \param[in] _device Device, see RenderDevice
+    public: void SetRenderDevice(const std::string &_device);
+
     /// \brief Set name of scene created inside the render window
     /// \param[in] _name Name of scene
     public: void SetSceneName(const std::string &_name);
@@ -348,6 +796,11 @@ namespace plugins
     /// \param[in] _pose Initial camera pose
     public: void SetCameraPose(const math::Pose3d &_pose);
 
+    /// \brief Get the render window camera's current pose
+    /// \param[out] _pose Camera pose
+    /// \return False if the camera hasn't been created yet
+    public: bool CameraPose(math::Pose3d &_pose) const;
+
     /// \brief Set the render window camera's near clipping plane distance
     /// \param[in] _near Near clipping plane distance
     public: void SetCameraNearClip(double _near);
@@ -383,9 +836,127 @@ namespace plugins
     /// \param[in] _view_controller The camera view controller type to set
     public: void SetCameraViewController(const std::string &_view_controller);
 
+    /// \brief Set whether to render into a swap chain instead of serializing
+    /// the render thread with Qt. Must be called before rendering starts.
+    /// \param[in] _tripleBuffering True to enable triple buffering
+    public: void SetTripleBuffering(bool _tripleBuffering);
+
+    /// \brief Mark the scene as changed, so it's rendered on the next frame
+    /// even with dirty tracking, and leave idle mode. Safe to call from any
+    /// thread.
+    public: void MarkDirty();
+
+    /// \brief Set whether to skip camera updates while the scene is
+    /// unchanged.
+    /// \param[in] _dirtyTracking True to enable dirty tracking
+    public: void SetDirtyTracking(bool _dirtyTracking);
+
+    /// \brief Set the maximum rate of events::HoverToScene.
+    /// \param[in] _rate Rate in Hz, 0 for every frame.
+    public: void SetHoverRate(double _rate);
+
+    /// \brief Set the maximum frame rate.
+    /// \param[in] _fps Frames per second, 0 for unlimited.
+    public: void SetMaxFps(double _fps);
+
+    /// \brief Set the frame rate used when there's no input or camera
+    /// motion for a while.
+    /// \param[in] _fps Frames per second, 0 to stop rendering while idle.
+    public: void SetIdleFps(double _fps);
+
+    /// \brief Set the frame rate used while the window isn't focused.
+    /// \param[in] _fps Frames per second, 0 to keep the regular rate.
+    public: void SetUnfocusedFps(double _fps);
+
+    /// \brief Set whether rendering stops while the item can't be seen.
+    /// \param[in] _suspend True to suspend hidden rendering
+    public: void SetSuspendHidden(bool _suspend);
+
+    /// \brief Set how long the item size must be stable before the render
+    /// texture is resized.
+    /// \param[in] _delayMs Delay in milliseconds, 0 to resize on the next
+    /// frame.
+    public: void SetResizeDelay(int _delayMs);
+
+    /// \brief Set the rendering quality. Can be called while rendering.
+    /// \param[in] _quality Quality settings
+    public: void SetQuality(const RenderQuality &_quality);
+
+    /// \brief Set the scheduling options of the render thread. Must be
+    /// called before rendering starts.
+    /// \param[in] _policy Scheduling options
+    public: void SetRenderThreadPolicy(const RenderThreadPolicy &_policy);
+
+    /// \brief Render at a fraction of the item size.
+    /// \param[in] _scale Fraction of the item size, in (0, 1].
+    /// \param[in] _minScale Lowest scale used to hold the target frame time.
+    /// \param[in] _targetFrameTimeMs Frame time to hold by lowering the
+    /// scale down to _minScale, 0 to always use _scale.
+    public: void SetRenderScale(double _scale, double _minScale,
+        double _targetFrameTimeMs);
+
+    /// \brief Enable counting what the camera submits, see RenderStats.
+    /// \param[in] _topic Topic to publish the counts on, empty to only
+    /// record them
+    public: void EnableRenderStats(const std::string &_topic);
+
+    /// \brief Enable measuring how long each phase of a frame takes.
+    /// \param[in] _topic Topic to publish the timings on, empty to only
+    /// keep them for FrameTimingSummary.
+    public: void EnableFrameTiming(const std::string &_topic);
+
+    /// \brief Get a human readable summary of the latest frame timings.
+    /// \return Summary, empty if frame timing is disabled.
+    public: QString FrameTimingSummary();
+
+    /// \brief Enable measuring the time from input to its frame being
+    /// presented.
+    /// \param[in] _topic Topic to publish the latencies on
+    public: void EnableInputLatency(const std::string &_topic);
+
+    /// \brief Enable streaming the scene to remote viewers. Must be called
+    /// before rendering starts.
+    /// \param[in] _topic Topic to publish the frames on
+    /// \param[in] _inputTopic Topic to receive the viewers' input on,
+    /// empty to ignore input
+    /// \param[in] _fps Maximum frame rate
+    /// \param[in] _quality JPEG quality, from 0 to 100
+    public: void EnableStream(const std::string &_topic,
+        const std::string &_inputTopic, double _fps, int _quality);
+
+    /// \brief Set the materials and markers to warm up, see MinimalScene's
+    /// \<warmup\>. Must be called before rendering starts.
+    /// \param[in] _materials Kinds of materials
+    /// \param[in] _markers Kinds of markers
+    public: void SetWarmUp(const std::vector<std::string> &_materials,
+        const std::vector<std::string> &_markers);
+
+    /// \brief Handle input from a remote viewer like local input
+    /// \param[in] _msg Input, see MinimalScene's \<stream\>
+    private: void OnRemoteInput(const msgs::Param &_msg);
+
     /// \brief Slot called when thread is ready to be started
     public Q_SLOTS: void Ready();
 
+    /// \brief Slot called when a frame has been delivered, to schedule the
+    /// next one according to the frame pacing options.
+    private Q_SLOTS: void ScheduleFrame();
+
+    /// \brief Ask the render thread for a new frame.
+    private Q_SLOTS: void RequestFrame();
+
+    /// \brief Record activity, leaving idle mode if needed.
+    private Q_SLOTS: void Wake();
+
+    /// \brief Stop rendering if the item can't be seen, or resume with a
+    /// single frame once it can, and notify plugins with
+    /// events::RenderSuspended.
+    private Q_SLOTS: void UpdateSuspended();
+
+    /// \brief Signal emitted once the item size has been stable for the
+    /// resize delay
+    signals: void SizeSettled();
+
     /// \brief Handle key press event for snapping
     /// \param[in] _e The key event to process.
     public: void HandleKeyPress(const common::KeyEvent &_e);
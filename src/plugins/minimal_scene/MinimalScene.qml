@@ -54,6 +54,46 @@ Rectangle {
     visible: MinimalScene.loadingError.length == 0
   }
 
+  /*
+   * Frame timing overlay, enabled with <frame_timing><overlay>
+   */
+  Label {
+    id: frameTimingOverlay
+    anchors.top: parent.top
+    anchors.left: parent.left
+    anchors.margins: 5
+    padding: 4
+    z: 1
+    text: MinimalScene.frameTiming
+    visible: MinimalScene.frameTiming.length > 0
+    color: "white"
+    font.family: "Monospace"
+    font.pointSize: 8
+    background: Rectangle {
+      color: "#80000000"
+      radius: 2
+    }
+  }
+
+  /*
+   * Scene loading progress overlay, shown while a scene manager loads
+   */
+  Label {
+    id: loadProgressOverlay
+    anchors.bottom: parent.bottom
+    anchors.left: parent.left
+    anchors.margins: 5
+    padding: 4
+    z: 1
+    text: MinimalScene.loadProgress
+    visible: MinimalScene.loadProgress.length > 0
+    color: "white"
+    background: Rectangle {
+      color: "#80000000"
+      radius: 2
+    }
+  }
+
   /*
    * Gamma correction for sRGB output. Enabled when engine is set to ogre2
    */
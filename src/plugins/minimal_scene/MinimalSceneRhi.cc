@@ -24,6 +24,31 @@ using namespace plugins;
 /////////////////////////////////////////////////
 GzCameraTextureRhi::~GzCameraTextureRhi() = default;
 
+/////////////////////////////////////////////////
+bool GzCameraTextureRhi::CopyToSlot(unsigned int, const QSize &, //NOLINT
+    void *)
+{
+  return false;
+}
+
+/////////////////////////////////////////////////
+void GzCameraTextureRhi::BeginGpuTimer()
+{
+  /* no-op */
+}
+
+/////////////////////////////////////////////////
+void GzCameraTextureRhi::EndGpuTimer()
+{
+  /* no-op */
+}
+
+/////////////////////////////////////////////////
+double GzCameraTextureRhi::GpuTimeMs() const
+{
+  return -1.0;
+}
+
 /////////////////////////////////////////////////
 RenderThreadRhi::~RenderThreadRhi() = default;
 
@@ -51,5 +76,11 @@ void RenderThreadRhi::SetContext(QOpenGLContext *) //NOLINT
   /* no-op */
 }
 
+/////////////////////////////////////////////////
+void RenderThreadRhi::SetSharedContext(QOpenGLContext *) //NOLINT
+{
+  /* no-op */
+}
+
 /////////////////////////////////////////////////
 TextureNodeRhi::~TextureNodeRhi() = default;
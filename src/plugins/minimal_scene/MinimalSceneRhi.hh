@@ -49,6 +49,30 @@ namespace plugins
     /// \brief Get the graphics API texture Id
     /// \param[out] _texturePtr Pointer to a texture Id
     public: virtual void TextureId(void* _texturePtr) = 0;
+
+    /// \brief Copy the latest camera texture into a texture owned by a
+    /// swap chain slot, so it can be displayed while the camera renders the
+    /// next frame. Graphics APIs that don't support swap chains return false.
+    /// \param[in] _slot Index of the swap chain slot to write to
+    /// \param[in] _size Size of the camera texture
+    /// \param[out] _texturePtr Pointer to the slot's texture Id
+    /// \return True if the texture was copied
+    public: virtual bool CopyToSlot(unsigned int _slot, const QSize &_size,
+        void *_texturePtr);
+
+    /// \brief Start measuring GPU time. Must be followed by EndGpuTimer on
+    /// the same frame.
+    public: virtual void BeginGpuTimer();
+
+    /// \brief Stop measuring GPU time.
+    public: virtual void EndGpuTimer();
+
+    /// \brief Get the newest GPU time measured between BeginGpuTimer and
+    /// EndGpuTimer. Results lag a few frames behind so that reading them
+    /// doesn't stall the pipeline.
+    /// \return Time in milliseconds, negative if not supported or not
+    /// available yet.
+    public: virtual double GpuTimeMs() const;
   };
 
   /// \brief gz-rendering renderer.
@@ -78,6 +102,12 @@ namespace plugins
     /// \param[in] _context OpenGL context
     public: virtual void SetContext(QOpenGLContext *_context);
 
+    /// \brief Set an OpenGL context owned by another render thread, which
+    /// is used but not deleted on shutdown.
+    //
+    /// \param[in] _context OpenGL context
+    public: virtual void SetSharedContext(QOpenGLContext *_context);
+
     /// \brief Carry out initialization
     //
     /// On macOS this must be run on the main thread
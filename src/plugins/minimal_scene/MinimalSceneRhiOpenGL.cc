@@ -21,13 +21,22 @@
 #include <gz/common/Console.hh>
 #include <gz/rendering/Camera.hh>
 
+#include "gz/gui/RenderDevice.hh"
+
 #include <QMutex>
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLTimerQuery>
 #include <QQuickWindow>
 #include <QSGTexture>
 #include <QSize>
 
+#include <array>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 /////////////////////////////////////////////////
 namespace gz
@@ -38,7 +47,45 @@ namespace plugins
 {
   class GzCameraTextureRhiOpenGLPrivate
   {
+    /// \brief Texture Id of the camera, or of the latest swap chain slot
     public: int textureId = 0;
+
+    /// \brief Texture Id of the camera's own render texture
+    public: int cameraTextureId = 0;
+
+    /// \brief Textures owned by each swap chain slot
+    public: std::vector<GLuint> slotTextures;
+
+    /// \brief Size of each swap chain slot texture
+    public: std::vector<QSize> slotSizes;
+
+    /// \brief Framebuffer used to read from the camera texture
+    public: GLuint readFbo = 0;
+
+    /// \brief Framebuffer used to draw into a slot texture
+    public: GLuint drawFbo = 0;
+
+    /// \brief Number of GPU timer queries in flight
+    public: static constexpr std::size_t kTimerCount = 3u;
+
+#if !defined(QT_OPENGL_ES_2)
+    /// \brief Ring of GPU timer queries, so results are read a few frames
+    /// after being issued
+    public: std::array<std::unique_ptr<QOpenGLTimerQuery>, kTimerCount>
+        timers;
+#endif
+
+    /// \brief True if the timer of each ring slot has a pending result
+    public: std::array<bool, kTimerCount> timerPending{};
+
+    /// \brief Ring slot of the next timer to begin
+    public: std::size_t nextTimer = 0u;
+
+    /// \brief False if timer queries aren't supported by the context
+    public: bool timersSupported = true;
+
+    /// \brief Newest GPU time in milliseconds, negative if none yet
+    public: double gpuTimeMs = -1.0;
   };
 
   class RenderThreadRhiOpenGLPrivate
@@ -47,6 +94,9 @@ namespace plugins
     public: void *texturePtr = nullptr;
     public: QOffscreenSurface *surface = nullptr;
     public: QOpenGLContext *context = nullptr;
+
+    /// \brief False if the context belongs to another render thread
+    public: bool ownsContext = true;
   };
 
   class TextureNodeRhiOpenGLPrivate
@@ -67,8 +117,120 @@ using namespace gz;
 using namespace gui;
 using namespace plugins;
 
+namespace
+{
+  /// \brief Fences of the textures handed to Qt, which the render thread
+  /// signals once it's done writing to them. Sync objects are shared by
+  /// all the contexts of a share group.
+  struct TextureFences
+  {
+    /// \brief Protects fences
+    std::mutex mutex;
+
+    /// \brief Latest fence of each texture Id
+    std::map<GLuint, GLsync> fences;
+  };
+
+  /////////////////////////////////////////////////
+  TextureFences &textureFences()
+  {
+    static TextureFences instance;
+    return instance;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Fence the commands issued so far on the current context, which
+  /// write to a texture. Qt waits for it before sampling the texture.
+  /// \param[in] _f Functions of the current context
+  /// \param[in] _textureId Texture written to
+  void fenceTexture(QOpenGLExtraFunctions *_f, GLuint _textureId)
+  {
+    GLsync fence = _f->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    // Other contexts can only wait for fences which were flushed
+    _f->glFlush();
+
+    GLsync previous{nullptr};
+    {
+      auto &registry = textureFences();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      auto &slot = registry.fences[_textureId];
+      previous = slot;
+      slot = fence;
+    }
+    if (nullptr != previous)
+      _f->glDeleteSync(previous);
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Make the current context's next commands wait for the latest
+  /// fence of a texture. Only the GPU waits, the calling thread doesn't.
+  /// \param[in] _f Functions of the current context
+  /// \param[in] _textureId Texture about to be sampled
+  void waitTexture(QOpenGLExtraFunctions *_f, GLuint _textureId)
+  {
+    GLsync fence{nullptr};
+    {
+      auto &registry = textureFences();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      auto it = registry.fences.find(_textureId);
+      if (it == registry.fences.end())
+        return;
+      fence = it->second;
+      registry.fences.erase(it);
+    }
+
+    // Deleting it is deferred until the wait is done
+    _f->glWaitSync(fence, 0, GL_TIMEOUT_IGNORED);
+    _f->glDeleteSync(fence);
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Delete the fence of a texture which is being deleted
+  /// \param[in] _f Functions of the current context
+  /// \param[in] _textureId Texture being deleted
+  void forgetTexture(QOpenGLExtraFunctions *_f, GLuint _textureId)
+  {
+    GLsync fence{nullptr};
+    {
+      auto &registry = textureFences();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      auto it = registry.fences.find(_textureId);
+      if (it == registry.fences.end())
+        return;
+      fence = it->second;
+      registry.fences.erase(it);
+    }
+    _f->glDeleteSync(fence);
+  }
+}
+
 /////////////////////////////////////////////////
-GzCameraTextureRhiOpenGL::~GzCameraTextureRhiOpenGL() = default;
+GzCameraTextureRhiOpenGL::~GzCameraTextureRhiOpenGL()
+{
+  // Slot textures can only be released while a context of the share group
+  // is current, otherwise they're released together with the context.
+  auto context = QOpenGLContext::currentContext();
+#if !defined(QT_OPENGL_ES_2)
+  // Queries can't be destroyed without their context, they're released
+  // together with it
+  if (nullptr == context)
+  {
+    for (auto &timer : this->dataPtr->timers)
+      timer.release();
+  }
+#endif
+  if (nullptr == context || this->dataPtr->slotTextures.empty())
+    return;
+
+  auto f = context->extraFunctions();
+  for (auto texture : this->dataPtr->slotTextures)
+    forgetTexture(f, texture);
+  f->glDeleteTextures(static_cast<GLsizei>(this->dataPtr->slotTextures.size()),
+      this->dataPtr->slotTextures.data());
+  f->glDeleteFramebuffers(1, &this->dataPtr->readFbo);
+  f->glDeleteFramebuffers(1, &this->dataPtr->drawFbo);
+}
 
 /////////////////////////////////////////////////
 GzCameraTextureRhiOpenGL::GzCameraTextureRhiOpenGL()
@@ -79,15 +241,155 @@ GzCameraTextureRhiOpenGL::GzCameraTextureRhiOpenGL()
 /////////////////////////////////////////////////
 void GzCameraTextureRhiOpenGL::Update(rendering::CameraPtr _camera)
 {
-  this->dataPtr->textureId = _camera->RenderTextureGLId();
+  this->dataPtr->cameraTextureId = _camera->RenderTextureGLId();
+  this->dataPtr->textureId = this->dataPtr->cameraTextureId;
 }
 
 /////////////////////////////////////////////////
 void GzCameraTextureRhiOpenGL::TextureId(void* _texturePtr)
 {
+  // Called after rendering. Swap chain slots are fenced when they're
+  // copied to, before they're published.
+  auto context = QOpenGLContext::currentContext();
+  if (nullptr != context && 0 != this->dataPtr->cameraTextureId &&
+      this->dataPtr->textureId == this->dataPtr->cameraTextureId)
+  {
+    fenceTexture(context->extraFunctions(),
+        static_cast<GLuint>(this->dataPtr->cameraTextureId));
+  }
+
   *reinterpret_cast<void**>(_texturePtr) = (void*)&this->dataPtr->textureId; //NOLINT
 }
 
+/////////////////////////////////////////////////
+bool GzCameraTextureRhiOpenGL::CopyToSlot(unsigned int _slot,
+    const QSize &_size, void *_texturePtr)
+{
+  auto context = QOpenGLContext::currentContext();
+  if (nullptr == context || 0 == this->dataPtr->cameraTextureId)
+    return false;
+
+  auto f = context->extraFunctions();
+
+  if (_slot >= this->dataPtr->slotTextures.size())
+  {
+    size_t first = this->dataPtr->slotTextures.size();
+    this->dataPtr->slotTextures.resize(_slot + 1, 0);
+    this->dataPtr->slotSizes.resize(_slot + 1, QSize(0, 0));
+    f->glGenTextures(static_cast<GLsizei>(_slot + 1 - first),
+        &this->dataPtr->slotTextures[first]);
+  }
+  if (0 == this->dataPtr->readFbo)
+  {
+    f->glGenFramebuffers(1, &this->dataPtr->readFbo);
+    f->glGenFramebuffers(1, &this->dataPtr->drawFbo);
+  }
+
+  // The slot isn't in use by Qt, so it's safe to reallocate it on resize
+  GLuint slotTexture = this->dataPtr->slotTextures[_slot];
+  if (this->dataPtr->slotSizes[_slot] != _size)
+  {
+    f->glBindTexture(GL_TEXTURE_2D, slotTexture);
+    f->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, _size.width(),
+        _size.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    f->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    f->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    f->glBindTexture(GL_TEXTURE_2D, 0);
+    this->dataPtr->slotSizes[_slot] = _size;
+  }
+
+  // The render engine caches its own framebuffer bindings, restore them
+  GLint prevReadFbo = 0;
+  GLint prevDrawFbo = 0;
+  f->glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFbo);
+  f->glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevDrawFbo);
+
+  f->glBindFramebuffer(GL_READ_FRAMEBUFFER, this->dataPtr->readFbo);
+  f->glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+      GL_TEXTURE_2D, static_cast<GLuint>(this->dataPtr->cameraTextureId), 0);
+  f->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->dataPtr->drawFbo);
+  f->glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+      GL_TEXTURE_2D, slotTexture, 0);
+  f->glBlitFramebuffer(0, 0, _size.width(), _size.height(),
+                       0, 0, _size.width(), _size.height(),
+                       GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+  f->glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(prevReadFbo));
+  f->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(prevDrawFbo));
+
+  // Qt's context waits for the copy on the GPU before sampling the slot,
+  // so this thread can go on with the next frame
+  fenceTexture(f, slotTexture);
+
+  this->dataPtr->textureId = static_cast<int>(slotTexture);
+  *static_cast<int *>(_texturePtr) = this->dataPtr->textureId;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void GzCameraTextureRhiOpenGL::BeginGpuTimer()
+{
+#if !defined(QT_OPENGL_ES_2)
+  if (!this->dataPtr->timersSupported ||
+      nullptr == QOpenGLContext::currentContext())
+  {
+    return;
+  }
+
+  auto &timer = this->dataPtr->timers[this->dataPtr->nextTimer];
+  if (!timer)
+  {
+    timer = std::make_unique<QOpenGLTimerQuery>();
+    if (!timer->create())
+    {
+      gzwarn << "GPU timer queries aren't supported, GPU frame time won't "
+             << "be measured." << std::endl;
+      this->dataPtr->timersSupported = false;
+      timer.reset();
+      return;
+    }
+  }
+
+  // This slot's previous query was issued kTimerCount frames ago, so its
+  // result is usually available without stalling
+  if (this->dataPtr->timerPending[this->dataPtr->nextTimer])
+  {
+    if (timer->isResultAvailable())
+    {
+      this->dataPtr->gpuTimeMs =
+          static_cast<double>(timer->waitForResult()) * 1e-6;
+    }
+    this->dataPtr->timerPending[this->dataPtr->nextTimer] = false;
+  }
+
+  timer->begin();
+#endif
+}
+
+/////////////////////////////////////////////////
+void GzCameraTextureRhiOpenGL::EndGpuTimer()
+{
+#if !defined(QT_OPENGL_ES_2)
+  auto &timer = this->dataPtr->timers[this->dataPtr->nextTimer];
+  if (!this->dataPtr->timersSupported || !timer ||
+      nullptr == QOpenGLContext::currentContext())
+  {
+    return;
+  }
+
+  timer->end();
+  this->dataPtr->timerPending[this->dataPtr->nextTimer] = true;
+  this->dataPtr->nextTimer =
+      (this->dataPtr->nextTimer + 1) % this->dataPtr->kTimerCount;
+#endif
+}
+
+/////////////////////////////////////////////////
+double GzCameraTextureRhiOpenGL::GpuTimeMs() const
+{
+  return this->dataPtr->gpuTimeMs;
+}
+
 /////////////////////////////////////////////////
 /////////////////////////////////////////////////
 RenderThreadRhiOpenGL::~RenderThreadRhiOpenGL() = default;
@@ -121,6 +423,14 @@ QOpenGLContext *RenderThreadRhiOpenGL::Context() const
 void RenderThreadRhiOpenGL::SetContext(QOpenGLContext *_context)
 {
   this->dataPtr->context = _context;
+  this->dataPtr->ownsContext = true;
+}
+
+/////////////////////////////////////////////////
+void RenderThreadRhiOpenGL::SetSharedContext(QOpenGLContext *_context)
+{
+  this->dataPtr->context = _context;
+  this->dataPtr->ownsContext = false;
 }
 
 /////////////////////////////////////////////////
@@ -134,6 +444,26 @@ std::string RenderThreadRhiOpenGL::Initialize()
     return loadingError;
   }
 
+  // The driver picks the device, tell which one it is
+  auto functions = this->dataPtr->context->functions();
+  auto vendor = functions->glGetString(GL_VENDOR);
+  auto device = functions->glGetString(GL_RENDERER);
+  if (nullptr != vendor && nullptr != device)
+  {
+    std::string vendorStr(reinterpret_cast<const char *>(vendor));
+    std::string deviceStr(reinterpret_cast<const char *>(device));
+    gzmsg << "Rendering with OpenGL on [" << deviceStr << "] by ["
+          << vendorStr << "]" << std::endl;
+
+    const auto &requested = this->dataPtr->renderer->renderDevice;
+    if (!RenderDevice::Matches(requested, vendorStr, deviceStr))
+    {
+      gzwarn << "Rendering on [" << deviceStr << "], which doesn't look "
+             << "like the requested render device [" << requested
+             << "]. Check that its driver is installed." << std::endl;
+    }
+  }
+
   this->dataPtr->context->doneCurrent();
   return std::string();
 }
@@ -145,7 +475,9 @@ void RenderThreadRhiOpenGL::RenderNext(RenderSync *_renderSync)
 
   if (!this->dataPtr->renderer->initialized)
   {
+    // Initialize releases the context when done
     this->Initialize();
+    this->dataPtr->context->makeCurrent(this->dataPtr->surface);
   }
 
   if (!this->dataPtr->renderer->initialized)
@@ -186,7 +518,8 @@ void RenderThreadRhiOpenGL::ShutDown()
   if (this->dataPtr->context)
   {
     this->dataPtr->context->doneCurrent();
-    delete this->dataPtr->context;
+    if (this->dataPtr->ownsContext)
+      delete this->dataPtr->context;
     this->dataPtr->context = nullptr;
   }
 
@@ -266,6 +599,14 @@ void TextureNodeRhiOpenGL::PrepareNode()
 
   if (this->dataPtr->newTextureId)
   {
+    // Called while the scene graph's context is current
+    auto context = QOpenGLContext::currentContext();
+    if (nullptr != context)
+    {
+      waitTexture(context->extraFunctions(),
+          static_cast<GLuint>(this->dataPtr->newTextureId));
+    }
+
     delete this->dataPtr->texture;
     this->dataPtr->texture = nullptr;
 
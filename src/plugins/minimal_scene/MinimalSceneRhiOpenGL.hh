@@ -52,6 +52,19 @@ namespace plugins
     // Documentation inherited
     public: virtual void TextureId(void* _texturePtr) override;
 
+    // Documentation inherited
+    public: virtual bool CopyToSlot(unsigned int _slot, const QSize &_size,
+        void *_texturePtr) override;
+
+    // Documentation inherited
+    public: virtual void BeginGpuTimer() override;
+
+    // Documentation inherited
+    public: virtual void EndGpuTimer() override;
+
+    // Documentation inherited
+    public: virtual double GpuTimeMs() const override;
+
     /// \internal Pointer to private data
     private: std::unique_ptr<GzCameraTextureRhiOpenGLPrivate> dataPtr;
   };
@@ -81,6 +94,9 @@ namespace plugins
     // Documentation inherited
     public: virtual void SetContext(QOpenGLContext *_context) override;
 
+    // Documentation inherited
+    public: virtual void SetSharedContext(QOpenGLContext *_context) override;
+
     // Documentation inherited
     public: virtual std::string Initialize() override;
 
@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "MinimalSceneRhiVulkan.hh"
+#include "MinimalScene.hh"
+
+#include <gz/common/Console.hh>
+#include <gz/rendering/Camera.hh>
+#include <gz/rendering/Image.hh>
+
+#include <QImage>
+#include <QMutex>
+#include <QQuickWindow>
+#include <QSGTexture>
+#include <QSize>
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <string>
+
+/////////////////////////////////////////////////
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  class GzCameraTextureRhiVulkanPrivate
+  {
+    /// \brief Camera to read the frames from
+    public: rendering::CameraPtr camera;
+
+    /// \brief Frame read from the camera
+    public: rendering::Image capture;
+
+    /// \brief Frames handed to the texture node, alternated so the one
+    /// being uploaded is usually not written to. If it is, it's detached
+    /// first, since QImage is copied on write.
+    public: std::array<QImage, 2> frames;
+
+    /// \brief Index of the next frame to write
+    public: std::size_t nextFrame{0u};
+
+    /// \brief True once an unsupported pixel format was reported
+    public: bool formatReported{false};
+  };
+
+  class RenderThreadRhiVulkanPrivate
+  {
+    public: GzRenderer *renderer = nullptr;
+    public: void *texturePtr = nullptr;
+  };
+
+  class TextureNodeRhiVulkanPrivate
+  {
+    /// \brief Latest frame from the render thread, null once taken
+    public: QImage image;
+
+    /// \brief Frame taken on the last PrepareNode, null if there was none
+    public: QImage newImage;
+
+    public: QMutex mutex;
+    public: QSGTexture *texture = nullptr;
+    public: QQuickWindow *window = nullptr;
+  };
+}
+}
+}
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+GzCameraTextureRhiVulkan::~GzCameraTextureRhiVulkan() = default;
+
+/////////////////////////////////////////////////
+GzCameraTextureRhiVulkan::GzCameraTextureRhiVulkan()
+  : dataPtr(std::make_unique<GzCameraTextureRhiVulkanPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+void GzCameraTextureRhiVulkan::Update(rendering::CameraPtr _camera)
+{
+  this->dataPtr->camera = _camera;
+}
+
+/////////////////////////////////////////////////
+void GzCameraTextureRhiVulkan::TextureId(void* _texturePtr)
+{
+  *static_cast<void **>(_texturePtr) = nullptr;
+
+  auto &camera = this->dataPtr->camera;
+  if (!camera)
+    return;
+
+  QImage::Format format;
+  int pixelBytes{0};
+  switch (camera->ImageFormat())
+  {
+    case rendering::PF_R8G8B8:
+      format = QImage::Format_RGB888;
+      pixelBytes = 3;
+      break;
+    case rendering::PF_R8G8B8A8:
+      format = QImage::Format_RGBA8888;
+      pixelBytes = 4;
+      break;
+    default:
+      if (!this->dataPtr->formatReported)
+      {
+        gzerr << "Can't display camera [" << camera->Name()
+              << "] with Vulkan, its pixel format isn't supported."
+              << std::endl;
+        this->dataPtr->formatReported = true;
+      }
+      return;
+  }
+
+  auto &capture = this->dataPtr->capture;
+  if (capture.Width() != camera->ImageWidth() ||
+      capture.Height() != camera->ImageHeight() ||
+      capture.Format() != camera->ImageFormat())
+  {
+    capture = camera->CreateImage();
+  }
+  camera->Copy(capture);
+
+  const int width = static_cast<int>(capture.Width());
+  const int height = static_cast<int>(capture.Height());
+  auto &frame = this->dataPtr->frames[this->dataPtr->nextFrame];
+  this->dataPtr->nextFrame = (this->dataPtr->nextFrame + 1) %
+      this->dataPtr->frames.size();
+  if (frame.width() != width || frame.height() != height ||
+      frame.format() != format)
+  {
+    frame = QImage(width, height, format);
+  }
+
+  // QImage rows are 4-byte aligned, the capture's are packed
+  const auto rowBytes = static_cast<std::size_t>(width * pixelBytes);
+  const auto *data = capture.Data<unsigned char>();
+  for (int y = 0; y < height; ++y)
+    std::memcpy(frame.scanLine(y), data + y * rowBytes, rowBytes);
+
+  *static_cast<void **>(_texturePtr) = &frame;
+}
+
+/////////////////////////////////////////////////
+/////////////////////////////////////////////////
+RenderThreadRhiVulkan::~RenderThreadRhiVulkan() = default;
+
+/////////////////////////////////////////////////
+RenderThreadRhiVulkan::RenderThreadRhiVulkan(GzRenderer *_renderer)
+    : dataPtr(std::make_unique<RenderThreadRhiVulkanPrivate>())
+{
+  this->dataPtr->renderer = _renderer;
+}
+
+/////////////////////////////////////////////////
+std::string RenderThreadRhiVulkan::Initialize()
+{
+  return this->dataPtr->renderer->Initialize();
+}
+
+/////////////////////////////////////////////////
+void RenderThreadRhiVulkan::RenderNext(RenderSync *_renderSync)
+{
+  if (!this->dataPtr->renderer->initialized)
+  {
+    this->dataPtr->renderer->Initialize();
+  }
+
+  // Check if engine has been successfully initialized
+  if (!this->dataPtr->renderer->initialized)
+  {
+    gzerr << "Unable to initialize renderer" << std::endl;
+    return;
+  }
+
+  // Call the renderer
+  this->dataPtr->renderer->Render(_renderSync);
+
+  // Get the frame read back from the camera
+  this->dataPtr->texturePtr = nullptr;
+  this->dataPtr->renderer->TextureId(&this->dataPtr->texturePtr);
+}
+
+/////////////////////////////////////////////////
+void* RenderThreadRhiVulkan::TexturePtr() const
+{
+  return this->dataPtr->texturePtr;
+}
+
+/////////////////////////////////////////////////
+QSize RenderThreadRhiVulkan::TextureSize() const
+{
+  return this->dataPtr->renderer->textureSize;
+}
+
+/////////////////////////////////////////////////
+void RenderThreadRhiVulkan::ShutDown()
+{
+  this->dataPtr->renderer->Destroy();
+
+  this->dataPtr->texturePtr = nullptr;
+}
+
+/////////////////////////////////////////////////
+/////////////////////////////////////////////////
+TextureNodeRhiVulkan::~TextureNodeRhiVulkan()
+{
+  delete this->dataPtr->texture;
+  this->dataPtr->texture = nullptr;
+}
+
+/////////////////////////////////////////////////
+TextureNodeRhiVulkan::TextureNodeRhiVulkan(QQuickWindow *_window)
+    : dataPtr(std::make_unique<TextureNodeRhiVulkanPrivate>())
+{
+  this->dataPtr->window = _window;
+
+  // Our texture node must have a texture, so start with a black one
+  QImage empty(1, 1, QImage::Format_RGB888);
+  empty.fill(Qt::black);
+  this->dataPtr->texture =
+      this->dataPtr->window->createTextureFromImage(empty);
+}
+
+/////////////////////////////////////////////////
+QSGTexture *TextureNodeRhiVulkan::Texture() const
+{
+  return this->dataPtr->texture;
+}
+
+/////////////////////////////////////////////////
+bool TextureNodeRhiVulkan::HasNewTexture() const
+{
+  return !this->dataPtr->newImage.isNull();
+}
+
+/////////////////////////////////////////////////
+void TextureNodeRhiVulkan::NewTexture(
+    void* _texturePtr, const QSize &/*_size*/)
+{
+  // Null if the camera couldn't be read
+  if (nullptr == _texturePtr)
+    return;
+
+  // Called on the render thread, which owns the frame, so sharing it here
+  // is safe
+  this->dataPtr->mutex.lock();
+  this->dataPtr->image = *static_cast<QImage *>(_texturePtr);
+  this->dataPtr->mutex.unlock();
+}
+
+/////////////////////////////////////////////////
+void TextureNodeRhiVulkan::PrepareNode()
+{
+  this->dataPtr->mutex.lock();
+  this->dataPtr->newImage = this->dataPtr->image;
+  this->dataPtr->image = QImage();
+  this->dataPtr->mutex.unlock();
+
+  if (!this->dataPtr->newImage.isNull())
+  {
+    delete this->dataPtr->texture;
+    this->dataPtr->texture = nullptr;
+
+    // Uploaded with the scene graph's own graphics API
+    this->dataPtr->texture =
+        this->dataPtr->window->createTextureFromImage(
+            this->dataPtr->newImage);
+  }
+}
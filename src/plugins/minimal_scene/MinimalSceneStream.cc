@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gz/msgs/bytes.pb.h>
+
+#include "MinimalSceneStream.hh"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QImage>
+
+#include <gz/common/Console.hh>
+#include <gz/rendering/Camera.hh>
+#include <gz/rendering/Image.hh>
+#include <gz/transport/Node.hh>
+
+/// \brief Period at which unchanged frames are sent again
+static constexpr std::chrono::seconds kKeepAlivePeriod{1};
+
+/// \brief Private data class for SceneStreamer
+class gz::gui::plugins::SceneStreamerPrivate
+{
+  /// \brief Encode and publish frames until stopped
+  public: void Run();
+
+  /// \brief Minimum time between frames
+  public: std::chrono::steady_clock::duration period;
+
+  /// \brief JPEG quality
+  public: int quality{75};
+
+  /// \brief Node to publish the frames
+  public: transport::Node node;
+
+  /// \brief Publisher of the frames
+  public: transport::Node::Publisher pub;
+
+  /// \brief When the last frame was captured, only used on the render
+  /// thread
+  public: std::chrono::steady_clock::time_point lastCapture;
+
+  /// \brief Image the render thread copies into
+  public: rendering::Image capture;
+
+  /// \brief True once an unsupported pixel format was reported
+  public: bool formatReported{false};
+
+  /// \brief Protects pending, hasPending and stop
+  public: std::mutex mutex;
+
+  /// \brief Notified when a frame is pending or the worker should stop
+  public: std::condition_variable cv;
+
+  /// \brief Latest frame waiting for the worker
+  public: rendering::Image pending;
+
+  /// \brief Format of pending
+  public: QImage::Format pendingFormat{QImage::Format_RGB888};
+
+  /// \brief True if pending wasn't taken by the worker yet
+  public: bool hasPending{false};
+
+  /// \brief True to stop the worker
+  public: bool stop{false};
+
+  /// \brief Thread encoding and publishing the frames
+  public: std::thread worker;
+};
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+SceneStreamer::SceneStreamer(const std::string &_topic, double _fps,
+    int _quality)
+  : dataPtr(std::make_unique<SceneStreamerPrivate>())
+{
+  this->dataPtr->period =
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(1.0 / _fps));
+  this->dataPtr->quality = _quality;
+  this->dataPtr->pub = this->dataPtr->node.Advertise<msgs::Bytes>(_topic);
+  this->dataPtr->worker =
+      std::thread(&SceneStreamerPrivate::Run, this->dataPtr.get());
+
+  gzmsg << "Streaming the scene on [" << _topic << "] at up to " << _fps
+        << " FPS" << std::endl;
+}
+
+/////////////////////////////////////////////////
+SceneStreamer::~SceneStreamer()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->cv.notify_all();
+  if (this->dataPtr->worker.joinable())
+    this->dataPtr->worker.join();
+}
+
+/////////////////////////////////////////////////
+void SceneStreamer::Capture(const rendering::CameraPtr &_camera,
+    bool _rendered)
+{
+  auto &data = *this->dataPtr;
+  if (nullptr == _camera)
+    return;
+
+  // Nobody is watching
+  if (!data.pub.HasConnections())
+    return;
+
+  auto now = std::chrono::steady_clock::now();
+  auto elapsed = now - data.lastCapture;
+  if (elapsed < (_rendered ? data.period :
+      std::chrono::steady_clock::duration(kKeepAlivePeriod)))
+  {
+    return;
+  }
+
+  QImage::Format format;
+  switch (_camera->ImageFormat())
+  {
+    case rendering::PF_R8G8B8:
+      format = QImage::Format_RGB888;
+      break;
+    case rendering::PF_R8G8B8A8:
+      format = QImage::Format_RGBA8888;
+      break;
+    default:
+      if (!data.formatReported)
+      {
+        gzerr << "Can't stream camera [" << _camera->Name()
+              << "], its pixel format isn't supported." << std::endl;
+        data.formatReported = true;
+      }
+      return;
+  }
+  data.lastCapture = now;
+
+  if (data.capture.Width() != _camera->ImageWidth() ||
+      data.capture.Height() != _camera->ImageHeight() ||
+      data.capture.Format() != _camera->ImageFormat())
+  {
+    data.capture = _camera->CreateImage();
+  }
+  _camera->Copy(data.capture);
+
+  // The buffers are swapped, so none is allocated while the size doesn't
+  // change
+  {
+    std::lock_guard<std::mutex> lock(data.mutex);
+    std::swap(data.capture, data.pending);
+    data.pendingFormat = format;
+    data.hasPending = true;
+  }
+  data.cv.notify_one();
+}
+
+/////////////////////////////////////////////////
+void SceneStreamerPrivate::Run()
+{
+  rendering::Image encoding;
+  QByteArray bytes;
+  msgs::Bytes msg;
+  while (true)
+  {
+    QImage::Format format;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->cv.wait(lock, [this]
+      {
+        return this->stop || this->hasPending;
+      });
+      if (this->stop)
+        return;
+      std::swap(this->pending, encoding);
+      format = this->pendingFormat;
+      this->hasPending = false;
+    }
+
+    const int width = static_cast<int>(encoding.Width());
+    const int height = static_cast<int>(encoding.Height());
+    const int depth = format == QImage::Format_RGB888 ? 3 : 4;
+    QImage image(encoding.Data<unsigned char>(), width, height,
+        width * depth, format);
+
+    bytes.clear();
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::WriteOnly);
+    if (!image.save(&buffer, "JPG", this->quality))
+    {
+      gzerr << "Failed to encode a streamed frame" << std::endl;
+      continue;
+    }
+
+    msg.set_data(bytes.constData(), bytes.size());
+    this->pub.Publish(msg);
+  }
+}
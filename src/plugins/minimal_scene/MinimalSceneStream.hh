@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_MINIMALSCENE_MINIMALSCENESTREAM_HH_
+#define GZ_GUI_PLUGINS_MINIMALSCENE_MINIMALSCENESTREAM_HH_
+
+#include <memory>
+#include <string>
+
+#include "gz/rendering/RenderTypes.hh"
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  class SceneStreamerPrivate;
+
+  /// \brief Streams the frames of a camera as JPEG images on a topic, as
+  /// gz.msgs.Bytes, so remote viewers such as a browser behind a websocket
+  /// bridge can watch the scene without running the GUI.
+  ///
+  /// Frames are copied on the render thread, then encoded and published on
+  /// a worker thread. Only the latest frame waits for the worker, older
+  /// ones are dropped to keep the latency low.
+  class SceneStreamer
+  {
+    /// \brief Constructor
+    /// \param[in] _topic Topic to publish the frames on
+    /// \param[in] _fps Maximum frame rate of the stream
+    /// \param[in] _quality JPEG quality, from 0 to 100
+    public: SceneStreamer(const std::string &_topic, double _fps,
+        int _quality);
+
+    /// \brief Destructor, stops the worker
+    public: ~SceneStreamer();
+
+    /// \brief Capture the camera's image if a frame is due, on the render
+    /// thread after the camera is updated. Unchanged frames are only sent
+    /// once per second, so new viewers get an image.
+    /// \param[in] _camera Camera to capture
+    /// \param[in] _rendered True if the camera rendered a new frame
+    public: void Capture(const rendering::CameraPtr &_camera,
+        bool _rendered);
+
+    /// \internal
+    /// \brief Private data pointer
+    private: std::unique_ptr<SceneStreamerPrivate> dataPtr;
+  };
+}
+}
+}
+
+#endif
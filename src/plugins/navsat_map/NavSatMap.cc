@@ -18,16 +18,41 @@
 #include "NavSatMap.hh"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <set>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#ifdef HAVE_QT_SQL
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#endif
+
 #include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Util.hh>
+#include <gz/math/Helpers.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/transport/Node.hh>
 
 #include "gz/gui/Application.hh"
+#include "gz/gui/LatestValue.hh"
+#include "gz/gui/StaticPlugins.hh"
+#include "gz/gui/TopicDiscovery.hh"
 
 namespace gz
 {
@@ -35,19 +60,232 @@ namespace gui
 {
 namespace plugins
 {
+  /// \brief Position history of a vehicle
+  struct Track
+  {
+    /// \brief Latitude and longitude of each fix, in degrees, the oldest
+    /// first
+    std::deque<std::pair<double, double>> fixes;
+
+    /// \brief Incremented when a fix is added
+    uint64_t revision{0u};
+
+    /// \brief Revision of the cached path
+    uint64_t cachedRevision{0u};
+
+    /// \brief Zoom level of the cached path
+    int cachedZoom{-1};
+
+    /// \brief Decimated path for the cached revision and zoom level
+    QVariantList cachedPath;
+  };
+
+  /// \brief Latest position of each vehicle of the fleet. Rows are only
+  /// ever added, and positions are updated in place, so the map doesn't
+  /// create its items again.
+  class VehicleModel : public QAbstractListModel
+  {
+    /// \brief Roles of the rows
+    public: enum Role
+    {
+      /// \brief Topic of the vehicle, as a string
+      TopicRole = Qt::UserRole + 1,
+
+      /// \brief Latitude in degrees
+      LatitudeRole,
+
+      /// \brief Longitude in degrees
+      LongitudeRole
+    };
+
+    /// \brief Update the positions, adding rows for new vehicles.
+    /// \param[in] _positions Latitude and longitude per topic
+    public: void Update(
+        const std::map<std::string, std::pair<double, double>> &_positions)
+    {
+      int first = -1;
+      int last = -1;
+      std::vector<std::pair<std::string, std::pair<double, double>>> added;
+      for (const auto &position : _positions)
+      {
+        auto it = this->rows.find(position.first);
+        if (it == this->rows.end())
+        {
+          added.push_back(position);
+          continue;
+        }
+        auto &vehicle = this->vehicles[it->second];
+        if (vehicle.second == position.second)
+          continue;
+        vehicle.second = position.second;
+        first = first < 0 ? it->second : std::min(first, it->second);
+        last = std::max(last, it->second);
+      }
+
+      // A single notification for all the moved vehicles
+      if (first >= 0)
+      {
+        this->dataChanged(this->index(first), this->index(last),
+            {LatitudeRole, LongitudeRole});
+      }
+
+      if (added.empty())
+        return;
+      int row = static_cast<int>(this->vehicles.size());
+      this->beginInsertRows(QModelIndex(), row,
+          row + static_cast<int>(added.size()) - 1);
+      for (auto &vehicle : added)
+      {
+        this->rows[vehicle.first] = row++;
+        this->vehicles.push_back(std::move(vehicle));
+      }
+      this->endInsertRows();
+    }
+
+    // Documentation inherited
+    public: int rowCount(
+        const QModelIndex &_parent = QModelIndex()) const override
+    {
+      if (_parent.isValid())
+        return 0;
+      return static_cast<int>(this->vehicles.size());
+    }
+
+    // Documentation inherited
+    public: QVariant data(const QModelIndex &_index,
+        int _role = Qt::DisplayRole) const override
+    {
+      if (!_index.isValid() || _index.row() >= this->rowCount())
+        return QVariant();
+
+      const auto &vehicle = this->vehicles[_index.row()];
+      switch (_role)
+      {
+        case Qt::DisplayRole:
+        case TopicRole:
+          return QString::fromStdString(vehicle.first);
+        case LatitudeRole:
+          return vehicle.second.first;
+        case LongitudeRole:
+          return vehicle.second.second;
+        default:
+          return QVariant();
+      }
+    }
+
+    // Documentation inherited
+    public: QHash<int, QByteArray> roleNames() const override
+    {
+      return {{TopicRole, "topic"}, {LatitudeRole, "latitude"},
+          {LongitudeRole, "longitude"}};
+    }
+
+    /// \brief Topic and position of each row
+    private: std::vector<std::pair<std::string, std::pair<double, double>>>
+        vehicles;
+
+    /// \brief Row of each topic
+    private: std::map<std::string, int> rows;
+  };
+
   class NavSatMapPrivate
   {
+    /// \brief Add a fix to the track of a topic. Called from the transport
+    /// threads.
+    /// \param[in] _topic Topic the fix was received on
+    /// \param[in] _msg Fix
+    public: void AddFix(const std::string &_topic, const msgs::NavSat &_msg);
+
     /// \brief List of topics publishing navSat messages.
     public: QStringList topicList;
 
     /// \brief Holds data to set as the next navSat
     public: msgs::NavSat navSatMsg;
 
+    /// \brief Protects the tracks and the selected topic
+    public: std::mutex trackMutex;
+
+    /// \brief Tracks per topic
+    public: std::map<std::string, Track> tracks;
+
+    /// \brief Topics of the tracks, in the order they appeared
+    public: QStringList trackTopics;
+
+    /// \brief True if a track changed since the map was notified
+    public: bool tracksDirty{false};
+
+    /// \brief True if a track was added since the map was notified
+    public: bool tracksAdded{false};
+
+    /// \brief Topic whose position is shown
+    public: std::string selectedTopic;
+
+    /// \brief Maximum number of fixes per track, 0 disables the tracks
+    public: std::size_t maxTrackFixes{100000u};
+
+    /// \brief Topics of the fleet, subscribed with the fleet node
+    public: std::set<std::string> fleetTopics;
+
+    /// \brief Latest position of each vehicle of the fleet
+    public: std::map<std::string, std::pair<double, double>> positions;
+
+    /// \brief True if a position changed since the model was updated
+    public: bool positionsDirty{false};
+
+    /// \brief Topics of the fleet are discovered by matching this
+    public: std::optional<std::regex> fleetPattern;
+
+    /// \brief Positions of the fleet shown on the map
+    public: VehicleModel vehicles;
+
+    /// \brief Timer updating the vehicles on the map, so their rate doesn't
+    /// depend on the number of vehicles
+    public: QTimer vehicleTimer;
+
+    /// \brief Timer notifying the map of the track changes
+    public: QTimer trackTimer;
+
+    /// \brief Incremented when tracks are notified, so the paths are
+    /// fetched again
+    public: int trackRevision{0};
+
+    /// \brief Passes the latest message to the GUI thread. Declared before
+    /// the node, so it's destroyed after the node stops calling it.
+    public: std::unique_ptr<LatestValue<msgs::NavSat>> latestMsg;
+
     /// \brief Node for communication.
     public: transport::Node node;
 
-    /// \brief Mutex for accessing navSat data
-    public: std::recursive_mutex navSatMutex;
+    /// \brief Directory of the tile cache, empty for Qt's default
+    public: std::string cacheDirectory;
+
+    /// \brief Maximum size of the tile cache on disk, in MB
+    public: int cacheSizeMb{500};
+
+    /// \brief Tiles this many seconds ahead along the direction of travel
+    /// are fetched in advance. Zero disables it.
+    public: double prefetchSeconds{30.0};
+
+    /// \brief Directory of z/x/y tiles or MBTiles file to use instead of
+    /// the online tiles, empty to use the online tiles
+    public: std::string offline;
+
+    /// \brief Previous fix and its time, to estimate the velocity when the
+    /// messages don't have it
+    public: std::optional<std::pair<double, double>> prevFix;
+
+    /// \brief Time of the previous fix
+    public: std::chrono::steady_clock::time_point prevFixTime;
+
+    /// \brief Thread extracting an MBTiles file
+    public: std::thread extractThread;
+
+    /// \brief True to stop the extraction
+    public: std::atomic<bool> stopExtract{false};
+
+    /// \brief Node subscribed to the fleet. Declared after the tracks and
+    /// positions, so it's destroyed before them.
+    public: transport::Node fleetNode;
   };
 }
 }
@@ -57,15 +295,259 @@ using namespace gz;
 using namespace gui;
 using namespace plugins;
 
+namespace
+{
+  /// \brief Mean radius of the Earth in meters
+  constexpr double kEarthRadius{6371000.0};
+
+  /// \brief Meters per pixel at the equator at zoom level 0
+  constexpr double kMetersPerPixelZoom0{156543.03392};
+
+  /// \brief Tracks are simplified so they're at most this far from the
+  /// fixes, in pixels
+  constexpr double kTrackTolerancePx{1.5};
+
+  /////////////////////////////////////////////////
+  /// \brief Simplify a line with the Douglas-Peucker algorithm.
+  /// \param[in] _points Points, in meters
+  /// \param[in] _tolerance Maximum distance of the removed points from the
+  /// simplified line, in meters
+  /// \return Indices of the points kept, in order
+  std::vector<std::size_t> simplify(
+      const std::vector<std::pair<double, double>> &_points,
+      double _tolerance)
+  {
+    std::vector<std::size_t> kept;
+    if (_points.size() < 3u)
+    {
+      for (std::size_t i = 0; i < _points.size(); ++i)
+        kept.push_back(i);
+      return kept;
+    }
+
+    std::vector<bool> keep(_points.size(), false);
+    keep.front() = true;
+    keep.back() = true;
+    double tolerance2 = _tolerance * _tolerance;
+
+    // Iterative, so long tracks don't overflow the stack
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    ranges.emplace_back(0u, _points.size() - 1u);
+    while (!ranges.empty())
+    {
+      auto [first, last] = ranges.back();
+      ranges.pop_back();
+      if (last <= first + 1u)
+        continue;
+
+      const auto &a = _points[first];
+      const auto &b = _points[last];
+      double dx = b.first - a.first;
+      double dy = b.second - a.second;
+      double length2 = dx * dx + dy * dy;
+
+      double farthest2{-1.0};
+      std::size_t farthest{first};
+      for (std::size_t i = first + 1u; i < last; ++i)
+      {
+        // Distance to the segment
+        const auto &p = _points[i];
+        double t = length2 > 0.0 ? std::clamp(((p.first - a.first) * dx +
+            (p.second - a.second) * dy) / length2, 0.0, 1.0) : 0.0;
+        double ex = a.first + t * dx - p.first;
+        double ey = a.second + t * dy - p.second;
+        double distance2 = ex * ex + ey * ey;
+        if (distance2 > farthest2)
+        {
+          farthest2 = distance2;
+          farthest = i;
+        }
+      }
+
+      if (farthest2 > tolerance2)
+      {
+        keep[farthest] = true;
+        ranges.emplace_back(first, farthest);
+        ranges.emplace_back(farthest, last);
+      }
+    }
+
+    for (std::size_t i = 0; i < keep.size(); ++i)
+    {
+      if (keep[i])
+        kept.push_back(i);
+    }
+    return kept;
+  }
+
+#ifdef HAVE_QT_SQL
+  /////////////////////////////////////////////////
+  /// \brief Extract the tiles of an MBTiles file into a z/x/y directory,
+  /// unless they were already extracted from the same file.
+  /// \param[in] _file MBTiles file
+  /// \param[in] _dir Directory to extract into
+  /// \param[in] _stop Set to stop early
+  /// \return True if the directory has the file's tiles
+  bool extractMbtiles(const QString &_file, const QString &_dir,
+      const std::atomic<bool> &_stop)
+  {
+    QFileInfo info(_file);
+    auto stamp = QString::number(info.size()) + " " +
+        QString::number(info.lastModified().toSecsSinceEpoch());
+    QDir dir(_dir);
+    QFile marker(dir.filePath(".extracted"));
+    if (marker.open(QIODevice::ReadOnly) &&
+        QString::fromUtf8(marker.readAll()) == stamp)
+    {
+      return true;
+    }
+    marker.close();
+
+    gzmsg << "Extracting map tiles from [" << _file.toStdString()
+          << "] to [" << _dir.toStdString() << "]" << std::endl;
+
+    bool ok{false};
+    int count{0};
+    const QString connection{"NavSatMapMbtiles"};
+    {
+      auto db = QSqlDatabase::addDatabase("QSQLITE", connection);
+      db.setDatabaseName(_file);
+      db.setConnectOptions("QSQLITE_OPEN_READONLY");
+      if (!db.open())
+      {
+        gzerr << "Failed to open [" << _file.toStdString() << "]: "
+              << db.lastError().text().toStdString() << std::endl;
+      }
+      else
+      {
+        QSqlQuery query(db);
+        query.setForwardOnly(true);
+        ok = query.exec("SELECT zoom_level, tile_column, tile_row, "
+            "tile_data FROM tiles");
+        if (!ok)
+        {
+          gzerr << "Failed to read the tiles of [" << _file.toStdString()
+                << "]: " << query.lastError().text().toStdString()
+                << std::endl;
+        }
+        while (ok && !_stop && query.next())
+        {
+          int z = query.value(0).toInt();
+          int x = query.value(1).toInt();
+
+          // Rows are numbered from the south
+          int y = (1 << z) - 1 - query.value(2).toInt();
+
+          auto tileDir = QString("%1/%2").arg(z).arg(x);
+          dir.mkpath(tileDir);
+          QFile tile(dir.filePath(tileDir + QString("/%1.png").arg(y)));
+          if (!tile.open(QIODevice::WriteOnly) ||
+              tile.write(query.value(3).toByteArray()) < 0)
+          {
+            gzerr << "Failed to write [" << tile.fileName().toStdString()
+                  << "]" << std::endl;
+            ok = false;
+          }
+          ++count;
+        }
+        ok = ok && !_stop;
+      }
+    }
+    QSqlDatabase::removeDatabase(connection);
+
+    if (ok && marker.open(QIODevice::WriteOnly))
+    {
+      marker.write(stamp.toUtf8());
+      gzmsg << "Extracted " << count << " map tiles" << std::endl;
+    }
+    return ok;
+  }
+#endif
+}
+
+/////////////////////////////////////////////////
+void NavSatMapPrivate::AddFix(const std::string &_topic,
+    const msgs::NavSat &_msg)
+{
+  if (this->maxTrackFixes == 0u || !std::isfinite(_msg.latitude_deg()) ||
+      !std::isfinite(_msg.longitude_deg()))
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->trackMutex);
+  auto it = this->tracks.find(_topic);
+  if (it == this->tracks.end())
+  {
+    it = this->tracks.emplace(_topic, Track()).first;
+    this->trackTopics.push_back(QString::fromStdString(_topic));
+    this->tracksAdded = true;
+  }
+
+  // Standing still doesn't add to the track
+  auto &fixes = it->second.fixes;
+  std::pair<double, double> fix{_msg.latitude_deg(), _msg.longitude_deg()};
+  if (!fixes.empty() && fixes.back() == fix)
+    return;
+
+  fixes.push_back(fix);
+  while (fixes.size() > this->maxTrackFixes)
+    fixes.pop_front();
+  ++it->second.revision;
+  this->tracksDirty = true;
+}
+
 /////////////////////////////////////////////////
 NavSatMap::NavSatMap()
   : Plugin(), dataPtr(new NavSatMapPrivate)
 {
+  // Paths are simplified again on changes, so they're throttled
+  this->connect(&this->dataPtr->trackTimer, &QTimer::timeout, this, [this]
+  {
+    bool added{false};
+    bool dirty{false};
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->trackMutex);
+      std::swap(added, this->dataPtr->tracksAdded);
+      std::swap(dirty, this->dataPtr->tracksDirty);
+    }
+    if (added)
+      this->TrackTopicsChanged();
+    if (dirty)
+    {
+      ++this->dataPtr->trackRevision;
+      this->TrackRevisionChanged();
+    }
+  });
+
+  this->connect(&this->dataPtr->vehicleTimer, &QTimer::timeout, this,
+      [this]
+  {
+    std::map<std::string, std::pair<double, double>> positions;
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->trackMutex);
+      if (!this->dataPtr->positionsDirty)
+        return;
+      positions = this->dataPtr->positions;
+      this->dataPtr->positionsDirty = false;
+    }
+    this->dataPtr->vehicles.Update(positions);
+  });
+
+  this->dataPtr->latestMsg = std::make_unique<LatestValue<msgs::NavSat>>(
+      this, [this](const msgs::NavSat &_msg)
+      {
+        this->dataPtr->navSatMsg = _msg;
+        this->ProcessMessage();
+      });
 }
 
 /////////////////////////////////////////////////
 NavSatMap::~NavSatMap()
 {
+  this->dataPtr->stopExtract = true;
+  if (this->dataPtr->extractThread.joinable())
+    this->dataPtr->extractThread.join();
 }
 
 /////////////////////////////////////////////////
@@ -77,6 +559,8 @@ void NavSatMap::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 
   std::string topic;
   bool topicPicker = true;
+  std::vector<std::string> fleetTopics;
+  double fleetRate{10.0};
 
   // Read configuration
   if (_pluginElem)
@@ -86,8 +570,112 @@ void NavSatMap::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 
     if (auto pickerElem = _pluginElem->FirstChildElement("topic_picker"))
       pickerElem->QueryBoolText(&topicPicker);
+
+    if (auto cacheElem = _pluginElem->FirstChildElement("cache"))
+    {
+      auto dirElem = cacheElem->FirstChildElement("directory");
+      if (nullptr != dirElem && nullptr != dirElem->GetText())
+        this->dataPtr->cacheDirectory = dirElem->GetText();
+
+      if (auto sizeElem = cacheElem->FirstChildElement("size_mb"))
+        sizeElem->QueryIntText(&this->dataPtr->cacheSizeMb);
+    }
+
+    if (auto prefetchElem = _pluginElem->FirstChildElement("prefetch_seconds"))
+      prefetchElem->QueryDoubleText(&this->dataPtr->prefetchSeconds);
+
+    auto offlineElem = _pluginElem->FirstChildElement("offline");
+    if (nullptr != offlineElem && nullptr != offlineElem->GetText())
+      this->dataPtr->offline = offlineElem->GetText();
+
+    if (auto trackElem = _pluginElem->FirstChildElement("track"))
+    {
+      if (auto maxElem = trackElem->FirstChildElement("max_points"))
+      {
+        unsigned int maxFixes{0u};
+        if (maxElem->QueryUnsignedText(&maxFixes) == tinyxml2::XML_SUCCESS)
+          this->dataPtr->maxTrackFixes = maxFixes;
+      }
+
+    }
+
+    if (auto fleetElem = _pluginElem->FirstChildElement("vehicles"))
+    {
+      for (auto elem = fleetElem->FirstChildElement("topic");
+          elem != nullptr; elem = elem->NextSiblingElement("topic"))
+      {
+        if (nullptr != elem->GetText())
+          fleetTopics.push_back(elem->GetText());
+      }
+
+      auto patternElem = fleetElem->FirstChildElement("pattern");
+      if (nullptr != patternElem && nullptr != patternElem->GetText())
+      {
+        try
+        {
+          this->dataPtr->fleetPattern = std::regex(patternElem->GetText(),
+              std::regex::ECMAScript | std::regex::optimize);
+        }
+        catch (const std::regex_error &_e)
+        {
+          gzerr << "Invalid vehicle pattern [" << patternElem->GetText()
+                << "]: " << _e.what() << std::endl;
+        }
+      }
+
+      if (auto rateElem = fleetElem->FirstChildElement("rate"))
+        rateElem->QueryDoubleText(&fleetRate);
+    }
+  }
+
+  if (this->dataPtr->maxTrackFixes > 0u &&
+      !this->dataPtr->trackTimer.isActive())
+  {
+    this->dataPtr->trackTimer.start(500);
   }
 
+  for (const auto &fleetTopic : fleetTopics)
+    this->SubscribeVehicle(fleetTopic);
+
+  if (this->dataPtr->fleetPattern)
+  {
+    auto discovery = TopicDiscovery::Instance();
+    for (const auto &navSatTopic : discovery->Topics("gz.msgs.NavSat"))
+    {
+      if (std::regex_match(navSatTopic, *this->dataPtr->fleetPattern))
+        this->SubscribeVehicle(navSatTopic);
+    }
+    this->connect(discovery, &TopicDiscovery::TopicAdded, this,
+        [this](const QString &_topic, const QString &_msgType)
+    {
+      auto fleetTopic = _topic.toStdString();
+      if (_msgType == "gz.msgs.NavSat" &&
+          std::regex_match(fleetTopic, *this->dataPtr->fleetPattern))
+      {
+        this->SubscribeVehicle(fleetTopic);
+      }
+    });
+  }
+
+  bool fleet = !fleetTopics.empty() || this->dataPtr->fleetPattern;
+  if (fleet && fleetRate > 0.0 && !this->dataPtr->vehicleTimer.isActive())
+  {
+    this->dataPtr->vehicleTimer.start(
+        std::max(1, static_cast<int>(std::lround(1000.0 / fleetRate))));
+  }
+
+  if (this->dataPtr->cacheDirectory.empty())
+  {
+    std::string home;
+    common::env(GZ_HOMEDIR, home);
+    this->dataPtr->cacheDirectory = common::joinPaths(home, ".gz", "gui",
+        "navsat_map", "tiles");
+  }
+
+  // Sizes are ints in bytes
+  this->dataPtr->cacheSizeMb = std::clamp(this->dataPtr->cacheSizeMb, 0,
+      std::numeric_limits<int>::max() / (1024 * 1024));
+
   if (topic.empty() && !topicPicker)
   {
     gzwarn << "Can't hide topic picker without a default topic." << std::endl;
@@ -103,25 +691,164 @@ void NavSatMap::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
   }
   else
     this->OnRefresh();
+
+  this->CreateMap();
+}
+
+/////////////////////////////////////////////////
+void NavSatMap::SubscribeVehicle(const std::string &_topic)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->trackMutex);
+    if (!this->dataPtr->fleetTopics.insert(_topic).second)
+      return;
+  }
+
+  // Every fix is recorded, not only the latest
+  std::function<void(const msgs::NavSat &)> cb =
+      [this, _topic](const msgs::NavSat &_msg)
+      {
+        if (!std::isfinite(_msg.latitude_deg()) ||
+            !std::isfinite(_msg.longitude_deg()))
+        {
+          return;
+        }
+        {
+          std::lock_guard<std::mutex> lock(this->dataPtr->trackMutex);
+          this->dataPtr->positions[_topic] =
+              {_msg.latitude_deg(), _msg.longitude_deg()};
+          this->dataPtr->positionsDirty = true;
+        }
+        this->dataPtr->AddFix(_topic, _msg);
+      };
+  if (!this->dataPtr->fleetNode.Subscribe(_topic, cb,
+      this->SubscribeOptions(_topic)))
+  {
+    gzerr << "Unable to subscribe to topic [" << _topic << "]" << std::endl;
+    std::lock_guard<std::mutex> lock(this->dataPtr->trackMutex);
+    this->dataPtr->fleetTopics.erase(_topic);
+  }
+}
+
+/////////////////////////////////////////////////
+void NavSatMap::CreateMap()
+{
+  const auto &offline = this->dataPtr->offline;
+  if (!offline.empty() && !common::isDirectory(offline))
+  {
+    if (!common::isFile(offline))
+    {
+      gzerr << "Offline map [" << offline << "] not found, using the "
+            << "online tiles" << std::endl;
+      this->SetupMap(std::string());
+      return;
+    }
+
+#ifdef HAVE_QT_SQL
+    // Extracted once into the cache, as the map reads tiles from files
+    auto dir = common::joinPaths(this->dataPtr->cacheDirectory, "mbtiles",
+        common::basename(offline));
+    this->dataPtr->extractThread = std::thread([this, offline, dir]
+    {
+      bool ok = extractMbtiles(QString::fromStdString(offline),
+          QString::fromStdString(dir), this->dataPtr->stopExtract);
+      if (this->dataPtr->stopExtract)
+        return;
+      QMetaObject::invokeMethod(this, [this, ok, dir]
+      {
+        this->SetupMap(ok ? dir : std::string());
+      }, Qt::QueuedConnection);
+    });
+#else
+    gzerr << "Offline map [" << offline << "] needs MBTiles support, "
+          << "which requires Qt SQL at build time, using the online tiles"
+          << std::endl;
+    this->SetupMap(std::string());
+#endif
+    return;
+  }
+
+  this->SetupMap(offline);
+}
+
+/////////////////////////////////////////////////
+void NavSatMap::SetupMap(const std::string &_tilesDir)
+{
+  QVariantMap params;
+  params["osm.mapping.cache.directory"] =
+      QString::fromStdString(this->dataPtr->cacheDirectory);
+  params["osm.mapping.cache.disk.size"] =
+      this->dataPtr->cacheSizeMb * 1024 * 1024;
+
+  // Tiles of the offline directory are read as a custom tile server, and
+  // nothing is fetched from the network
+  bool offline = !_tilesDir.empty();
+  if (offline)
+  {
+    params["osm.mapping.custom.host"] = QUrl::fromLocalFile(
+        QString::fromStdString(_tilesDir) + "/").toString();
+    params["osm.mapping.providersrepository.disabled"] = true;
+  }
+
+  QMetaObject::invokeMethod(this->PluginItem(), "createMap",
+      Q_ARG(QVariant, params), Q_ARG(QVariant, offline));
 }
 
 /////////////////////////////////////////////////
 void NavSatMap::ProcessMessage()
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->navSatMutex);
+  const auto &msg = this->dataPtr->navSatMsg;
+  this->newMessage(msg.latitude_deg(), msg.longitude_deg());
+
+  if (this->dataPtr->prefetchSeconds <= 0.0)
+    return;
+
+  // Velocity from the message, or else from the previous fix
+  double latRad = GZ_DTOR(msg.latitude_deg());
+  double east = msg.velocity_east();
+  double north = msg.velocity_north();
+  auto now = std::chrono::steady_clock::now();
+  if (east == 0.0 && north == 0.0 && this->dataPtr->prevFix)
+  {
+    double dt = std::chrono::duration<double>(
+        now - this->dataPtr->prevFixTime).count();
+    if (dt > 0.0)
+    {
+      north = GZ_DTOR(msg.latitude_deg() - this->dataPtr->prevFix->first) *
+          kEarthRadius / dt;
+      east = GZ_DTOR(msg.longitude_deg() - this->dataPtr->prevFix->second) *
+          kEarthRadius * std::cos(latRad) / dt;
+    }
+  }
+  this->dataPtr->prevFix = {msg.latitude_deg(), msg.longitude_deg()};
+  this->dataPtr->prevFixTime = now;
 
-  this->newMessage(this->dataPtr->navSatMsg.latitude_deg(),
-      this->dataPtr->navSatMsg.longitude_deg());
+  // Not worth it while standing still
+  if (std::hypot(east, north) < 0.5 || std::abs(std::cos(latRad)) < 1e-6)
+    return;
+
+  double ahead = this->dataPtr->prefetchSeconds;
+  this->prefetch(
+      msg.latitude_deg() + GZ_RTOD(north * ahead / kEarthRadius),
+      msg.longitude_deg() +
+      GZ_RTOD(east * ahead / (kEarthRadius * std::cos(latRad))));
 }
 
 /////////////////////////////////////////////////
 void NavSatMap::OnMessage(const msgs::NavSat &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->navSatMutex);
-  this->dataPtr->navSatMsg = _msg;
+  // Only the latest position is shown
+  this->dataPtr->latestMsg->Set(_msg);
 
-  // Signal to main thread that the navSat changed
-  QMetaObject::invokeMethod(this, "ProcessMessage");
+  // Topics of the fleet are tracked by their own subscription
+  std::string topic;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->trackMutex);
+    if (this->dataPtr->fleetTopics.count(this->dataPtr->selectedTopic) > 0u)
+      return;
+    topic = this->dataPtr->selectedTopic;
+  }
+  this->dataPtr->AddFix(topic, _msg);
 }
 
 /////////////////////////////////////////////////
@@ -136,9 +863,14 @@ void NavSatMap::OnTopic(const QString _topic)
   for (auto sub : subs)
     this->dataPtr->node.Unsubscribe(sub);
 
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->trackMutex);
+    this->dataPtr->selectedTopic = topic;
+  }
+
   // Subscribe to new topic
   if (!this->dataPtr->node.Subscribe(topic, &NavSatMap::OnMessage,
-      this))
+      this, this->SubscribeOptions(topic)))
   {
     gzerr << "Unable to subscribe to topic [" << topic << "]" << std::endl;
   }
@@ -151,21 +883,10 @@ void NavSatMap::OnRefresh()
   this->dataPtr->topicList.clear();
 
   // Get updated list
-  std::vector<std::string> allTopics;
-  this->dataPtr->node.TopicList(allTopics);
-  for (auto topic : allTopics)
-  {
-    std::vector<transport::MessagePublisher> publishers;
-    this->dataPtr->node.TopicInfo(topic, publishers);
-    for (auto pub : publishers)
-    {
-      if (pub.MsgTypeName() == "gz.msgs.NavSat")
-      {
-        this->dataPtr->topicList.push_back(QString::fromStdString(topic));
-        break;
-      }
-    }
-  }
+  auto discovery = TopicDiscovery::Instance();
+  discovery->Refresh();
+  for (const auto &topic : discovery->Topics("gz.msgs.NavSat"))
+    this->dataPtr->topicList.push_back(QString::fromStdString(topic));
 
   // Select first one
   if (this->dataPtr->topicList.count() > 0)
@@ -186,6 +907,82 @@ void NavSatMap::SetTopicList(const QStringList &_topicList)
   this->TopicListChanged();
 }
 
+/////////////////////////////////////////////////
+QStringList NavSatMap::TrackTopics() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->trackMutex);
+  return this->dataPtr->trackTopics;
+}
+
+/////////////////////////////////////////////////
+QObject *NavSatMap::Vehicles() const
+{
+  return &this->dataPtr->vehicles;
+}
+
+/////////////////////////////////////////////////
+int NavSatMap::TrackRevision() const
+{
+  return this->dataPtr->trackRevision;
+}
+
+/////////////////////////////////////////////////
+QVariantList NavSatMap::TrackPath(const QString &_topic, int _zoom) const
+{
+  std::vector<std::pair<double, double>> fixes;
+  uint64_t revision{0u};
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->trackMutex);
+    auto it = this->dataPtr->tracks.find(_topic.toStdString());
+    if (it == this->dataPtr->tracks.end())
+      return QVariantList();
+
+    auto &track = it->second;
+    if (track.cachedRevision == track.revision && track.cachedZoom == _zoom)
+      return track.cachedPath;
+
+    fixes.assign(track.fixes.begin(), track.fixes.end());
+    revision = track.revision;
+  }
+  if (fixes.empty())
+    return QVariantList();
+
+  // Simplified in meters, on a plane tangent at the first fix, so it's
+  // accurate to a pixel at this zoom level
+  auto origin = fixes.front();
+  double cosLat = std::cos(GZ_DTOR(origin.first));
+  std::vector<std::pair<double, double>> points;
+  points.reserve(fixes.size());
+  for (const auto &fix : fixes)
+  {
+    points.emplace_back(
+        GZ_DTOR(fix.second - origin.second) * kEarthRadius * cosLat,
+        GZ_DTOR(fix.first - origin.first) * kEarthRadius);
+  }
+  double tolerance = kMetersPerPixelZoom0 * std::abs(cosLat) /
+      std::pow(2.0, _zoom) * kTrackTolerancePx;
+
+  QVariantList path;
+  auto kept = simplify(points, tolerance);
+  path.reserve(static_cast<int>(kept.size()));
+  for (auto i : kept)
+  {
+    QVariantMap coordinate;
+    coordinate["latitude"] = fixes[i].first;
+    coordinate["longitude"] = fixes[i].second;
+    path.append(coordinate);
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->trackMutex);
+  auto it = this->dataPtr->tracks.find(_topic.toStdString());
+  if (it != this->dataPtr->tracks.end())
+  {
+    it->second.cachedRevision = revision;
+    it->second.cachedZoom = _zoom;
+    it->second.cachedPath = path;
+  }
+  return path;
+}
+
 // Register this plugin
-GZ_ADD_PLUGIN(gz::gui::plugins::NavSatMap,
-              gz::gui::Plugin)
+GZ_GUI_ADD_PLUGIN(gz::gui::plugins::NavSatMap, "NavSatMap")
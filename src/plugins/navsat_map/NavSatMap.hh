@@ -19,6 +19,7 @@
 #define GZ_GUI_PLUGINS_IMAGEDISPLAY_HH_
 
 #include <memory>
+#include <string>
 
 #include <gz/msgs/navsat.pb.h>
 
@@ -40,6 +41,29 @@ namespace plugins
   /// \<topic\> : Set the topic to receive NavSat messages.
   /// \<topic_picker\> : Whether to show the topic picker, true by default. If
   ///                    this is false, a \<topic\> must be specified.
+  /// \<cache\> : Tiles are cached on disk, with:
+  ///   * \<directory\> : Cache directory, defaults to
+  ///                      ~/.gz/gui/navsat_map/tiles
+  ///   * \<size_mb\> : Maximum size of the cache, defaults to 500 MB
+  /// \<prefetch_seconds\> : Tiles where the vehicle will be in this many
+  ///                         seconds, at its current velocity, are fetched
+  ///                         in advance. Defaults to 30, 0 disables it.
+  /// \<offline\> : Directory of z/x/y.png tiles, or MBTiles file, shown
+  ///                instead of the online tiles, so the map loads without
+  ///                network. MBTiles files are extracted once into the
+  ///                cache directory, and need Qt SQL.
+  /// \<track\> : The positions received on each topic are drawn as a line.
+  ///   * \<max_points\> : Maximum number of positions per topic, the
+  ///                       oldest are dropped. Defaults to 100000, 0
+  ///                       disables the tracks.
+  /// \<vehicles\> : A fleet shown besides the selected topic, on the same
+  ///                 map:
+  ///   * \<topic\> : Topic of a vehicle, may be repeated.
+  ///   * \<pattern\> : ECMAScript regular expression, NavSat topics
+  ///                    matching it are added as they're discovered, such
+  ///                    as /fleet/.+/navsat
+  ///   * \<rate\> : Rate at which the vehicles move on the map in Hz,
+  ///                 whatever the rate of the messages. Defaults to 10.
   class NavSatMap : public Plugin
   {
     Q_OBJECT
@@ -52,6 +76,28 @@ namespace plugins
       NOTIFY TopicListChanged
     )
 
+    /// \brief Topics with a track
+    Q_PROPERTY(
+      QStringList trackTopics
+      READ TrackTopics
+      NOTIFY TrackTopicsChanged
+    )
+
+    /// \brief Latest position of each vehicle of the fleet, with the
+    /// topic, latitude and longitude roles
+    Q_PROPERTY(
+      QObject *vehicles
+      READ Vehicles
+      CONSTANT
+    )
+
+    /// \brief Changes when tracks change, so their paths are fetched again
+    Q_PROPERTY(
+      int trackRevision
+      READ TrackRevision
+      NOTIFY TrackRevisionChanged
+    )
+
     /// \brief Constructor
     public: NavSatMap();
 
@@ -78,14 +124,59 @@ namespace plugins
     /// \brief Notify that topic list has changed
     signals: void TopicListChanged();
 
+    /// \brief Get the topics with a track
+    /// \return Topics, in the order they were first received
+    public: Q_INVOKABLE QStringList TrackTopics() const;
+
+    /// \brief Get the positions of the fleet
+    /// \return List model, owned by the plugin
+    public: QObject *Vehicles() const;
+
+    /// \brief Notify that a track was added
+    signals: void TrackTopicsChanged();
+
+    /// \brief Get the revision of the tracks
+    /// \return Incremented at most twice per second when tracks change
+    public: Q_INVOKABLE int TrackRevision() const;
+
+    /// \brief Notify that tracks changed
+    signals: void TrackRevisionChanged();
+
+    /// \brief Get the track of a topic, simplified with the
+    /// Douglas-Peucker algorithm to what's visible at a zoom level.
+    /// \param[in] _topic Topic
+    /// \param[in] _zoom Zoom level of the map
+    /// \return Coordinates with latitude and longitude, the oldest first
+    public: Q_INVOKABLE QVariantList TrackPath(const QString &_topic,
+        int _zoom) const;
+
     /// \brief Notify that a new message has been received.
     /// \param[in] _latitudeDeg Latitude in degrees
     /// \param[in] _longitudeDeg Longitude in degrees
     signals: void newMessage(double _latitudeDeg, double _longitudeDeg);
 
+    /// \brief Notify where tiles should be fetched in advance, ahead of
+    /// the vehicle
+    /// \param[in] _latitudeDeg Latitude in degrees
+    /// \param[in] _longitudeDeg Longitude in degrees
+    signals: void prefetch(double _latitudeDeg, double _longitudeDeg);
+
     /// \brief Callback in main thread when message changes
     private slots: void ProcessMessage();
 
+    /// \brief Create the map from the configuration, once the offline
+    /// tiles, if any, are ready
+    private: void CreateMap();
+
+    /// \brief Create the map's tile source in QML
+    /// \param[in] _tilesDir Directory of offline z/x/y tiles, empty to use
+    /// the online tiles
+    private: void SetupMap(const std::string &_tilesDir);
+
+    /// \brief Subscribe to a vehicle of the fleet, if it isn't already.
+    /// \param[in] _topic NavSat topic
+    private: void SubscribeVehicle(const std::string &_topic);
+
     /// \brief Subscriber callback when new message is received
     /// \param[in] _msg New message
     private: void OnMessage(const gz::msgs::NavSat &_msg);
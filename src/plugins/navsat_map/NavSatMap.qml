@@ -89,9 +89,66 @@ Item {
     }
   }
 
-  Plugin {
-    id: mapPlugin
-    name: "osm"
+  /**
+   * Create the map plugin, called once from C++ with the configuration,
+   * since plugin parameters can't be changed once the map uses it.
+   * @param _params Map of plugin parameter names to values
+   * @param _offline True to show the custom, offline tiles
+   */
+  function createMap(_params, _offline) {
+    if (map.plugin) {
+      return;
+    }
+
+    var qml = 'import QtLocation 5.6; Plugin { name: "osm"; ';
+    for (var key in _params) {
+      qml += 'PluginParameter { name: "' + key + '"; value: ' +
+          JSON.stringify(_params[key]) + ' } ';
+    }
+    qml += '}';
+    var mapPlugin = Qt.createQmlObject(qml, navSatMap);
+
+    // Both maps share the plugin, so they share the tile cache
+    map.plugin = mapPlugin;
+    prefetchMap.plugin = mapPlugin;
+
+    if (!_offline) {
+      return;
+    }
+    for (var i = 0; i < map.supportedMapTypes.length; ++i) {
+      if (map.supportedMapTypes[i].style === MapType.CustomMap) {
+        map.activeMapType = map.supportedMapTypes[i];
+        prefetchMap.activeMapType = map.supportedMapTypes[i];
+        break;
+      }
+    }
+  }
+
+  // Invisible, centered ahead of the vehicle, so the tiles it will need
+  // are fetched into the cache before it gets there
+  Map {
+    id: prefetchMap
+    anchors.fill: map
+    opacity: 0
+    enabled: false
+    copyrightsVisible: false
+    zoomLevel: map.zoomLevel
+  }
+
+  // Colors of the tracks and vehicles
+  property var trackColors: ["#4285f4", "#db4437", "#0f9d58", "#f4b400",
+      "#ab47bc", "#00acc1"]
+
+  /**
+   * Color of a topic, the same for its track and its vehicle
+   * @param _topic Topic name
+   */
+  function topicColor(_topic) {
+    var hash = 0;
+    for (var i = 0; i < _topic.length; ++i) {
+      hash = (hash * 31 + _topic.charCodeAt(i)) % 65521;
+    }
+    return trackColors[hash % trackColors.length];
   }
 
   Map {
@@ -105,6 +162,48 @@ Item {
     anchors.leftMargin: -5
     anchors.rightMargin: -5
 
+    // A single simplified line per topic, whatever the number of fixes
+    MapItemView {
+      model: NavSatMap.trackTopics
+      delegate: MapPolyline {
+        line.width: 3
+        line.color: topicColor(modelData)
+        opacity: 0.8
+        path: {
+          NavSatMap.trackRevision;
+          return NavSatMap.TrackPath(modelData, Math.round(map.zoomLevel));
+        }
+      }
+    }
+
+    // Fleet, moved in place at a capped rate by the model. Roles are read
+    // through model, as the root item has a latitude and longitude too.
+    MapItemView {
+      model: NavSatMap.vehicles
+      delegate: MapQuickItem {
+        coordinate: QtPositioning.coordinate(model.latitude, model.longitude)
+        anchorPoint.x: dot.width / 2
+        anchorPoint.y: dot.height / 2
+        sourceItem: Rectangle {
+          id: dot
+          width: 14
+          height: 14
+          radius: 7
+          color: topicColor(model.topic)
+          border.width: 2
+          border.color: "white"
+
+          MouseArea {
+            id: dotArea
+            anchors.fill: parent
+            hoverEnabled: true
+          }
+          ToolTip.visible: dotArea.containsMouse
+          ToolTip.text: model.topic
+        }
+      }
+    }
+
     MapCircle {
       id: circle
       center {
@@ -117,7 +216,6 @@ Item {
       border.color: "white"
     }
 
-    plugin: mapPlugin
     center: centering ? QtPositioning.coordinate(latitude, longitude) : center
     copyrightsVisible: false
     zoomLevel: 16
@@ -163,5 +261,9 @@ Item {
       latitude = _latitudeDeg
       longitude = _longitudeDeg
     }
+    onPrefetch: {
+      prefetchMap.center = QtPositioning.coordinate(_latitudeDeg,
+          _longitudeDeg)
+    }
   }
 }
@@ -14,6 +14,10 @@
  * limitations under the License.
  *
 */
+#include <string>
+
+#include <gz/gui/Helpers.hh>
+#include <gz/gui/StaticPlugins.hh>
 #include <gz/plugin/Register.hh>
 #include "TransportPlotting.hh"
 
@@ -26,10 +30,26 @@ TransportPlotting::~TransportPlotting()
 }
 
 //////////////////////////////////////////
-void TransportPlotting::LoadConfig(const tinyxml2::XMLElement *)
+void TransportPlotting::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Transport plotting";
+
+  // Follow the sim time of the world, if any
+  std::string statsTopic;
+  auto worldNames = gui::worldNames();
+  if (!worldNames.empty())
+    statsTopic = "/world/" + worldNames[0].toStdString() + "/stats";
+
+  if (_pluginElem)
+  {
+    auto topicElem = _pluginElem->FirstChildElement("stats_topic");
+    if (nullptr != topicElem)
+      statsTopic = topicElem->GetText() ? topicElem->GetText() : "";
+  }
+
+  if (!statsTopic.empty())
+    this->dataPtr->SetStatsTopic(statsTopic);
 }
 
 //////////////////////////////////////////
@@ -39,6 +59,5 @@ TransportPlotting::TransportPlotting() : Plugin(),
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(gz::gui::plugins::TransportPlotting,
-              gz::gui::Plugin)
+GZ_GUI_ADD_PLUGIN(gz::gui::plugins::TransportPlotting, "TransportPlotting")
 
@@ -32,6 +32,13 @@ namespace plugins
 
 /// \brief Plots fields from Gazebo Transport topics.
 /// Fields can be dragged from the Topic Viewer or the Component Inspector.
+///
+/// ## Configuration
+///
+/// \<stats_topic\> : World statistics topic whose sim time is used for
+///                    fields without a header. Defaults to the stats of
+///                    the main window's first world, if any. Leave empty
+///                    to use the time since the plugin was loaded.
 class TransportPlotting : public gz::gui::Plugin
 {
   Q_OBJECT
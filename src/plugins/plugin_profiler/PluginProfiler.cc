@@ -0,0 +1,363 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gz/msgs/param.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/plugin/Register.hh>
+#include <gz/transport/Node.hh>
+#include <gz/transport/TopicUtils.hh>
+
+#include "gz/gui/GpuMemory.hh"
+#include "gz/gui/PluginStats.hh"
+#include "gz/gui/QueueStats.hh"
+#include "gz/gui/StaticPlugins.hh"
+
+#include "PluginProfiler.hh"
+
+/// \brief Private data class for PluginProfiler
+class gz::gui::plugins::PluginProfilerPrivate
+{
+  /// \brief Period of the statistics update, in ms
+  public: static constexpr int kReportPeriodMs{1000};
+
+  /// \brief Timer to update the statistics
+  public: QTimer reportTimer;
+
+  /// \brief Time of the previous report
+  public: PluginStats::Clock::time_point lastReport;
+
+  /// \brief Usage per plugin, see PluginProfiler::Usage
+  public: QVariantList usage;
+
+  /// \brief Memory used by the process
+  public: QString memoryValue;
+
+  /// \brief GPU memory per plugin, see PluginProfiler::GpuUsage
+  public: QVariantList gpuUsage;
+
+  /// \brief GPU memory used by the scene
+  public: QString gpuMemoryValue;
+
+  /// \brief Message queues, see PluginProfiler::QueueUsage
+  public: QVariantList queueUsage;
+
+  /// \brief Names of the queues limited by the config
+  public: std::vector<std::string> limitedQueues;
+
+  /// \brief Topic the statistics are published on
+  public: std::string topic{"/gui/stats"};
+
+  /// \brief Topic the queues are published on
+  public: std::string diagnosticsTopic{"/gui/diagnostics"};
+
+  /// \brief Message reused for every report
+  public: msgs::Param msg;
+
+  /// \brief Message of the queues reused for every report
+  public: msgs::Param diagnosticsMsg;
+
+  /// \brief Node to publish the statistics
+  public: transport::Node node;
+
+  /// \brief Publisher of the statistics
+  public: transport::Node::Publisher pub;
+
+  /// \brief Publisher of the queues
+  public: transport::Node::Publisher diagnosticsPub;
+};
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+/// \brief Format bytes as MB
+/// \param[in] _bytes Bytes
+/// \return Megabytes with one decimal
+static QString megabytes(uint64_t _bytes)
+{
+  return QString::number(static_cast<double>(_bytes) / (1024.0 * 1024.0),
+      'f', 1);
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a topic from the config
+/// \param[in] _pluginElem Plugin element
+/// \param[in] _name Name of the topic element
+/// \param[in, out] _topic Topic, unchanged if it's not set or invalid
+static void loadTopic(const tinyxml2::XMLElement *_pluginElem,
+    const char *_name, std::string &_topic)
+{
+  auto topicElem = _pluginElem->FirstChildElement(_name);
+  if (nullptr == topicElem || nullptr == topicElem->GetText())
+    return;
+
+  auto topic = transport::TopicUtils::AsValidTopic(topicElem->GetText());
+  if (topic.empty())
+  {
+    gzerr << "Invalid <" << _name << "> [" << topicElem->GetText()
+          << "], publishing on [" << _topic << "]" << std::endl;
+    return;
+  }
+  _topic = topic;
+}
+
+/////////////////////////////////////////////////
+PluginProfiler::PluginProfiler()
+  : Plugin(), dataPtr(std::make_unique<PluginProfilerPrivate>())
+{
+  PluginStats::Enable();
+  this->dataPtr->lastReport = PluginStats::Clock::now();
+  this->connect(&this->dataPtr->reportTimer, &QTimer::timeout, this,
+      &PluginProfiler::Report);
+}
+
+/////////////////////////////////////////////////
+PluginProfiler::~PluginProfiler()
+{
+  PluginStats::Disable();
+  for (const auto &name : this->dataPtr->limitedQueues)
+    QueueStats::SetLimit(name, QueueStats::Limit());
+}
+
+/////////////////////////////////////////////////
+void PluginProfiler::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Plugin profiler";
+
+  if (_pluginElem)
+  {
+    loadTopic(_pluginElem, "topic", this->dataPtr->topic);
+    loadTopic(_pluginElem, "diagnostics_topic",
+        this->dataPtr->diagnosticsTopic);
+
+    for (auto limitElem = _pluginElem->FirstChildElement("queue_limit");
+        nullptr != limitElem;
+        limitElem = limitElem->NextSiblingElement("queue_limit"))
+    {
+      auto name = limitElem->Attribute("name");
+      QueueStats::Limit limit;
+      limit.depth = limitElem->Unsigned64Attribute("depth", 0u);
+      limit.bytes = limitElem->Unsigned64Attribute("bytes", 0u);
+      auto policy = limitElem->Attribute("policy");
+      if (nullptr == name || !limit.Enabled() ||
+          (nullptr != policy &&
+          !QueueStats::PolicyFromName(policy, limit.policy)))
+      {
+        gzerr << "Invalid <queue_limit>, it needs a name, a depth or bytes, "
+              << "and an optional policy, drop_oldest or drop_newest"
+              << std::endl;
+        continue;
+      }
+
+      QueueStats::SetLimit(name, limit);
+      this->dataPtr->limitedQueues.push_back(name);
+    }
+  }
+
+  this->dataPtr->pub =
+      this->dataPtr->node.Advertise<msgs::Param>(this->dataPtr->topic);
+  if (!this->dataPtr->pub)
+  {
+    gzerr << "Failed to advertise [" << this->dataPtr->topic << "]"
+          << std::endl;
+  }
+
+  this->dataPtr->diagnosticsPub = this->dataPtr->node.Advertise<msgs::Param>(
+      this->dataPtr->diagnosticsTopic);
+  if (!this->dataPtr->diagnosticsPub)
+  {
+    gzerr << "Failed to advertise [" << this->dataPtr->diagnosticsTopic
+          << "]" << std::endl;
+  }
+
+  if (!this->dataPtr->reportTimer.isActive())
+    this->dataPtr->reportTimer.start(PluginProfilerPrivate::kReportPeriodMs);
+}
+
+/////////////////////////////////////////////////
+void PluginProfiler::Report()
+{
+  auto &data = *this->dataPtr;
+
+  // Normalized to the actual period, in case the timer was late
+  auto now = PluginStats::Clock::now();
+  double seconds =
+      std::chrono::duration<double>(now - data.lastReport).count();
+  data.lastReport = now;
+  if (seconds <= 0.0)
+    return;
+
+  constexpr auto kEvents =
+      static_cast<std::size_t>(PluginStats::Source::kEvents);
+  constexpr auto kRenderHooks =
+      static_cast<std::size_t>(PluginStats::Source::kRenderHooks);
+  constexpr auto kTransport =
+      static_cast<std::size_t>(PluginStats::Source::kTransport);
+
+  auto params = data.msg.mutable_params();
+  params->clear();
+  auto setDouble = [params](const std::string &_name, double _value)
+  {
+    auto &param = (*params)[_name];
+    param.set_type(msgs::Any::DOUBLE);
+    param.set_double_value(_value);
+  };
+
+  data.usage.clear();
+  for (const auto &usage : PluginStats::TakeUsage())
+  {
+    double events = usage.ms[kEvents] / seconds;
+    double renderHooks = usage.ms[kRenderHooks] / seconds;
+    double transport = usage.ms[kTransport] / seconds;
+    double total = usage.TotalMs() / seconds;
+
+    QVariantMap entry;
+    entry["name"] = QString::fromStdString(usage.name);
+    entry["events"] = events;
+    entry["renderHooks"] = renderHooks;
+    entry["transport"] = transport;
+    entry["total"] = total;
+    data.usage.append(entry);
+
+    setDouble(usage.name + "/events", events);
+    setDouble(usage.name + "/render_hooks", renderHooks);
+    setDouble(usage.name + "/transport", transport);
+    setDouble(usage.name + "/total", total);
+  }
+
+  auto rss = PluginStats::ResidentMemory();
+  data.memoryValue = rss == 0 ? QString("N/A") : megabytes(rss) + " MB";
+  setDouble("rss", static_cast<double>(rss));
+
+  data.gpuUsage.clear();
+  for (const auto &usage : GpuMemory::CurrentUsage())
+  {
+    QVariantMap entry;
+    entry["name"] = QString::fromStdString(usage.name);
+    for (std::size_t i = 0; i < GpuMemory::kResourceCount; ++i)
+    {
+      auto resource = GpuMemory::ResourceName(
+          static_cast<GpuMemory::Resource>(i));
+      entry[QString::fromStdString(resource)] =
+          static_cast<double>(usage.bytes[i]) / (1024.0 * 1024.0);
+      setDouble("gpu/" + usage.name + "/" + resource,
+          static_cast<double>(usage.bytes[i]));
+    }
+    entry["total"] =
+        static_cast<double>(usage.TotalBytes()) / (1024.0 * 1024.0);
+    data.gpuUsage.append(entry);
+  }
+
+  auto gpuTotal = GpuMemory::TotalBytes();
+  auto gpuBudget = GpuMemory::Budget();
+  data.gpuMemoryValue = megabytes(gpuTotal);
+  if (gpuBudget > 0u)
+    data.gpuMemoryValue += " / " + megabytes(gpuBudget);
+  data.gpuMemoryValue += " MB";
+  setDouble("gpu/total", static_cast<double>(gpuTotal));
+  setDouble("gpu/budget", static_cast<double>(gpuBudget));
+
+  auto queueParams = data.diagnosticsMsg.mutable_params();
+  queueParams->clear();
+  auto setQueue = [queueParams](const std::string &_name, uint64_t _value)
+  {
+    auto &param = (*queueParams)["queue/" + _name];
+    param.set_type(msgs::Any::DOUBLE);
+    param.set_double_value(static_cast<double>(_value));
+  };
+
+  data.queueUsage.clear();
+  for (const auto &usage : QueueStats::CurrentUsage())
+  {
+    QVariantMap entry;
+    entry["name"] = QString::fromStdString(usage.name);
+    entry["depth"] = static_cast<double>(usage.depth);
+    entry["maxDepth"] = static_cast<double>(usage.maxDepth);
+    entry["kb"] = static_cast<double>(usage.bytes) / 1024.0;
+    entry["maxKb"] = static_cast<double>(usage.maxBytes) / 1024.0;
+    entry["dropped"] = static_cast<double>(usage.dropped);
+
+    QString limit;
+    if (usage.limit.Enabled() && usage.droppable)
+    {
+      if (usage.limit.depth > 0u)
+        limit += QString::number(usage.limit.depth);
+      if (usage.limit.bytes > 0u)
+      {
+        limit += (limit.isEmpty() ? "" : ", ") +
+            megabytes(usage.limit.bytes) + " MB";
+      }
+    }
+    entry["limit"] = limit.isEmpty() ? QString("-") : limit;
+    data.queueUsage.append(entry);
+
+    setQueue(usage.name + "/depth", usage.depth);
+    setQueue(usage.name + "/bytes", usage.bytes);
+    setQueue(usage.name + "/max_depth", usage.maxDepth);
+    setQueue(usage.name + "/max_bytes", usage.maxBytes);
+    setQueue(usage.name + "/dropped", usage.dropped);
+  }
+
+  this->UsageChanged();
+
+  if (data.pub)
+    data.pub.Publish(data.msg);
+  if (data.diagnosticsPub)
+    data.diagnosticsPub.Publish(data.diagnosticsMsg);
+}
+
+/////////////////////////////////////////////////
+QVariantList PluginProfiler::Usage() const
+{
+  return this->dataPtr->usage;
+}
+
+/////////////////////////////////////////////////
+QString PluginProfiler::MemoryValue() const
+{
+  return this->dataPtr->memoryValue;
+}
+
+/////////////////////////////////////////////////
+QVariantList PluginProfiler::GpuUsage() const
+{
+  return this->dataPtr->gpuUsage;
+}
+
+/////////////////////////////////////////////////
+QString PluginProfiler::GpuMemoryValue() const
+{
+  return this->dataPtr->gpuMemoryValue;
+}
+
+/////////////////////////////////////////////////
+QVariantList PluginProfiler::QueueUsage() const
+{
+  return this->dataPtr->queueUsage;
+}
+
+// Register this plugin
+GZ_GUI_ADD_PLUGIN(gz::gui::plugins::PluginProfiler, "PluginProfiler")
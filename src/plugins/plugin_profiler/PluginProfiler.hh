@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_PLUGINPROFILER_HH_
+#define GZ_GUI_PLUGINS_PLUGINPROFILER_HH_
+
+#include <memory>
+
+#include "gz/gui/Plugin.hh"
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  class PluginProfilerPrivate;
+
+  /// \brief Displays the time each plugin spends filtering events, in
+  /// render hooks and in transport callbacks, in milliseconds per second,
+  /// the most expensive first, and the memory used by the process. See
+  /// PluginStats. Accounting is enabled while this plugin is loaded. The
+  /// estimated GPU memory used by each plugin's scene resources is also
+  /// displayed, the largest first, see GpuMemory, and the depth and size
+  /// of the plugins' message queues, see QueueStats. The statistics are
+  /// updated once per second.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<topic\> : Topic the statistics are also published on, as a
+  ///               gz.msgs.Param with `<plugin>/events`,
+  ///               `<plugin>/render_hooks`, `<plugin>/transport` and
+  ///               `<plugin>/total` in ms per second, and `rss` in bytes.
+  ///               GPU memory is published in bytes, as
+  ///               `gpu/<plugin>/<resource>` for each of meshes, textures,
+  ///               markers and points, and `gpu/total` and `gpu/budget`.
+  ///               Defaults to `/gui/stats`.
+  /// * \<diagnostics_topic\> : Topic the queues are published on, as a
+  ///               gz.msgs.Param with `queue/<queue>/depth`,
+  ///               `queue/<queue>/bytes`, their high-water marks
+  ///               `queue/<queue>/max_depth` and `queue/<queue>/max_bytes`,
+  ///               and `queue/<queue>/dropped`. Defaults to
+  ///               `/gui/diagnostics`.
+  /// * \<queue_limit\> : May be repeated. Limit of the queues named by its
+  ///               `name` attribute, with `depth` messages and `bytes`
+  ///               attributes, and a `policy` attribute, `drop_oldest` by
+  ///               default or `drop_newest`. Removed when the plugin is
+  ///               unloaded. For example:
+  ///               `<queue_limit name="MarkerManager/markers" depth="10000"/>`
+  class PluginProfiler : public Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Usage per plugin, each a map with name, events, renderHooks,
+    /// transport and total
+    Q_PROPERTY(
+      QVariantList usage
+      READ Usage
+      NOTIFY UsageChanged
+    )
+
+    /// \brief Memory used by the process
+    Q_PROPERTY(
+      QString memoryValue
+      READ MemoryValue
+      NOTIFY UsageChanged
+    )
+
+    /// \brief GPU memory per plugin, each a map with name, meshes,
+    /// textures, markers, points and total, in MB
+    Q_PROPERTY(
+      QVariantList gpuUsage
+      READ GpuUsage
+      NOTIFY UsageChanged
+    )
+
+    /// \brief GPU memory used by the scene, and the budget
+    Q_PROPERTY(
+      QString gpuMemoryValue
+      READ GpuMemoryValue
+      NOTIFY UsageChanged
+    )
+
+    /// \brief Message queues, each a map with name, depth, maxDepth,
+    /// kb, maxKb, dropped and limit
+    Q_PROPERTY(
+      QVariantList queueUsage
+      READ QueueUsage
+      NOTIFY UsageChanged
+    )
+
+    /// \brief Constructor
+    public: PluginProfiler();
+
+    /// \brief Destructor
+    public: ~PluginProfiler() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+        override;
+
+    /// \brief Get the usage per plugin
+    /// \return List of maps, the most expensive plugin first
+    public: Q_INVOKABLE QVariantList Usage() const;
+
+    /// \brief Get the memory used by the process
+    /// \return Resident memory, such as "312.5 MB"
+    public: Q_INVOKABLE QString MemoryValue() const;
+
+    /// \brief Get the GPU memory per plugin
+    /// \return List of maps, the largest first
+    public: Q_INVOKABLE QVariantList GpuUsage() const;
+
+    /// \brief Get the GPU memory used by the scene
+    /// \return Memory and budget, such as "312.5 / 2048.0 MB"
+    public: Q_INVOKABLE QString GpuMemoryValue() const;
+
+    /// \brief Get the message queues
+    /// \return List of maps, the largest first
+    public: Q_INVOKABLE QVariantList QueueUsage() const;
+
+    /// \brief Notify that the statistics have changed
+    signals: void UsageChanged();
+
+    /// \brief Take the usage recorded since the last report, and update
+    /// the properties and the topic
+    private: void Report();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<PluginProfilerPrivate> dataPtr;
+  };
+}
+}
+}
+#endif
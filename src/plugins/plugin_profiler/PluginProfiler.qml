@@ -0,0 +1,305 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+import QtQuick 2.9
+import QtQuick.Controls 2.1
+import QtQuick.Layouts 1.3
+
+Rectangle {
+  id: pluginProfiler
+  color: "transparent"
+  Layout.minimumWidth: 360
+  Layout.minimumHeight: 240
+
+  function format(_ms) {
+    return _ms.toFixed(1)
+  }
+
+  function formatMb(_mb) {
+    return _mb.toFixed(1)
+  }
+
+  function formatKb(_kb) {
+    return _kb.toFixed(1)
+  }
+
+  ColumnLayout {
+    anchors.fill: parent
+    anchors.margins: 10
+
+    RowLayout {
+      Label {
+        ToolTip.text: qsTr("Resident memory of the whole process")
+        font.weight: Font.DemiBold
+        text: "Memory"
+      }
+
+      Label {
+        objectName: "memory"
+        text: PluginProfiler.memoryValue
+        Layout.fillWidth: true
+        horizontalAlignment: Text.AlignRight
+      }
+    }
+
+    RowLayout {
+      Label {
+        ToolTip.text: qsTr("Estimated GPU memory of the scene, and budget")
+        font.weight: Font.DemiBold
+        text: "GPU memory"
+      }
+
+      Label {
+        objectName: "gpuMemory"
+        text: PluginProfiler.gpuMemoryValue
+        Layout.fillWidth: true
+        horizontalAlignment: Text.AlignRight
+      }
+    }
+
+    GridLayout {
+      columns: 5
+      Layout.fillWidth: true
+
+      Label {
+        font.weight: Font.DemiBold
+        text: "Plugin"
+        Layout.fillWidth: true
+      }
+
+      Label {
+        ToolTip.text: qsTr("Filtering events, in ms per second")
+        font.weight: Font.DemiBold
+        text: "Events"
+      }
+
+      Label {
+        ToolTip.text: qsTr("Render hooks, in ms per second")
+        font.weight: Font.DemiBold
+        text: "Render"
+      }
+
+      Label {
+        ToolTip.text: qsTr("Transport callbacks, in ms per second")
+        font.weight: Font.DemiBold
+        text: "Transport"
+      }
+
+      Label {
+        ToolTip.text: qsTr("All of them, in ms per second")
+        font.weight: Font.DemiBold
+        text: "Total"
+      }
+    }
+
+    ListView {
+      id: usageList
+      objectName: "usageList"
+      clip: true
+      model: PluginProfiler.usage
+      Layout.fillWidth: true
+      Layout.fillHeight: true
+
+      delegate: GridLayout {
+        columns: 5
+        width: usageList.width
+
+        Label {
+          text: modelData.name
+          elide: Text.ElideRight
+          Layout.fillWidth: true
+        }
+
+        Label {
+          text: pluginProfiler.format(modelData.events)
+        }
+
+        Label {
+          text: pluginProfiler.format(modelData.renderHooks)
+        }
+
+        Label {
+          text: pluginProfiler.format(modelData.transport)
+        }
+
+        Label {
+          text: pluginProfiler.format(modelData.total)
+          font.weight: Font.DemiBold
+        }
+      }
+    }
+
+    GridLayout {
+      columns: 6
+      Layout.fillWidth: true
+      visible: gpuUsageList.count > 0
+
+      Label {
+        font.weight: Font.DemiBold
+        text: "GPU"
+        Layout.fillWidth: true
+      }
+
+      Label {
+        ToolTip.text: qsTr("Mesh buffers, in MB")
+        font.weight: Font.DemiBold
+        text: "Meshes"
+      }
+
+      Label {
+        ToolTip.text: qsTr("Textures and render targets, in MB")
+        font.weight: Font.DemiBold
+        text: "Textures"
+      }
+
+      Label {
+        ToolTip.text: qsTr("Marker geometry, in MB")
+        font.weight: Font.DemiBold
+        text: "Markers"
+      }
+
+      Label {
+        ToolTip.text: qsTr("Point cloud buffers, in MB")
+        font.weight: Font.DemiBold
+        text: "Points"
+      }
+
+      Label {
+        ToolTip.text: qsTr("All of them, in MB")
+        font.weight: Font.DemiBold
+        text: "Total"
+      }
+    }
+
+    ListView {
+      id: gpuUsageList
+      objectName: "gpuUsageList"
+      clip: true
+      model: PluginProfiler.gpuUsage
+      Layout.fillWidth: true
+      Layout.preferredHeight: contentHeight
+      Layout.maximumHeight: 120
+
+      delegate: GridLayout {
+        columns: 6
+        width: gpuUsageList.width
+
+        Label {
+          text: modelData.name
+          elide: Text.ElideRight
+          Layout.fillWidth: true
+        }
+
+        Label {
+          text: pluginProfiler.formatMb(modelData.meshes)
+        }
+
+        Label {
+          text: pluginProfiler.formatMb(modelData.textures)
+        }
+
+        Label {
+          text: pluginProfiler.formatMb(modelData.markers)
+        }
+
+        Label {
+          text: pluginProfiler.formatMb(modelData.points)
+        }
+
+        Label {
+          text: pluginProfiler.formatMb(modelData.total)
+          font.weight: Font.DemiBold
+        }
+      }
+    }
+
+    GridLayout {
+      columns: 5
+      Layout.fillWidth: true
+      visible: queueUsageList.count > 0
+
+      Label {
+        font.weight: Font.DemiBold
+        text: "Queue"
+        Layout.fillWidth: true
+      }
+
+      Label {
+        ToolTip.text: qsTr("Messages waiting, and the most reached")
+        font.weight: Font.DemiBold
+        text: "Depth"
+      }
+
+      Label {
+        ToolTip.text: qsTr("Estimated size, and the largest reached, in KB")
+        font.weight: Font.DemiBold
+        text: "Size"
+      }
+
+      Label {
+        ToolTip.text: qsTr("Messages dropped beyond the limit")
+        font.weight: Font.DemiBold
+        text: "Dropped"
+      }
+
+      Label {
+        ToolTip.text: qsTr("Maximum messages or size")
+        font.weight: Font.DemiBold
+        text: "Limit"
+      }
+    }
+
+    ListView {
+      id: queueUsageList
+      objectName: "queueUsageList"
+      clip: true
+      model: PluginProfiler.queueUsage
+      Layout.fillWidth: true
+      Layout.preferredHeight: contentHeight
+      Layout.maximumHeight: 120
+
+      delegate: GridLayout {
+        columns: 5
+        width: queueUsageList.width
+
+        Label {
+          text: modelData.name
+          elide: Text.ElideRight
+          Layout.fillWidth: true
+        }
+
+        Label {
+          text: modelData.depth + " / " + modelData.maxDepth
+        }
+
+        Label {
+          text: pluginProfiler.formatKb(modelData.kb) + " / " +
+              pluginProfiler.formatKb(modelData.maxKb)
+        }
+
+        Label {
+          text: modelData.dropped
+          font.weight: modelData.dropped > 0 ? Font.DemiBold : Font.Normal
+        }
+
+        Label {
+          text: modelData.limit
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <gz/msgs/param.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/GpuMemory.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/Plugin.hh"
+#include "gz/gui/PluginStats.hh"
+#include "gz/gui/QueueStats.hh"
+#include "gz/gui/qt.h"
+#include "test_config.hh"  // NOLINT(build/include)
+
+#include "PluginProfiler.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./PluginProfiler_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(PluginProfilerTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Report))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(common::joinPaths(PROJECT_BINARY_PATH, "lib"));
+
+  std::mutex mutex;
+  msgs::Param received;
+  std::atomic<bool> hasReport{false};
+  transport::Node node;
+  std::function<void(const msgs::Param &)> cb =
+      [&](const msgs::Param &_msg)
+      {
+        if (_msg.params().find("Fake/events") == _msg.params().end())
+          return;
+        std::lock_guard<std::mutex> lock(mutex);
+        received = _msg;
+        hasReport = true;
+      };
+  EXPECT_TRUE(node.Subscribe("/gui/stats", cb));
+
+  EXPECT_FALSE(PluginStats::Enabled());
+  EXPECT_TRUE(app.LoadPlugin("PluginProfiler"));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  auto profilers = win->findChildren<plugins::PluginProfiler *>();
+  ASSERT_EQ(1, profilers.size());
+  auto plugin = profilers[0];
+  EXPECT_EQ("Plugin profiler", plugin->Title());
+
+  // Enabled while it's loaded
+  EXPECT_TRUE(PluginStats::Enabled());
+  PluginStats::Record("Fake", PluginStats::Source::kEvents, 100.0);
+  GpuMemory::Record("Fake", GpuMemory::Resource::kMeshes, "mesh",
+      2u * 1024u * 1024u);
+
+  int sleep = 0;
+  int maxSleep = 30;
+  while (!hasReport && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    ++sleep;
+  }
+  ASSERT_TRUE(hasReport);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_GT(received.params().at("Fake/events").double_value(), 0.0);
+    EXPECT_DOUBLE_EQ(received.params().at("Fake/events").double_value(),
+        received.params().at("Fake/total").double_value());
+    EXPECT_DOUBLE_EQ(0.0,
+        received.params().at("Fake/transport").double_value());
+    EXPECT_NE(received.params().end(), received.params().find("rss"));
+    EXPECT_DOUBLE_EQ(2.0 * 1024.0 * 1024.0,
+        received.params().at("gpu/Fake/meshes").double_value());
+    EXPECT_DOUBLE_EQ(0.0,
+        received.params().at("gpu/Fake/points").double_value());
+    EXPECT_DOUBLE_EQ(2.0 * 1024.0 * 1024.0,
+        received.params().at("gpu/total").double_value());
+  }
+
+  // The same report is displayed
+  auto usage = plugin->Usage();
+  ASSERT_FALSE(usage.empty());
+  bool found{false};
+  for (const auto &entry : usage)
+  {
+    auto map = entry.toMap();
+    if (map["name"].toString() == "Fake")
+    {
+      found = true;
+      EXPECT_GT(map["events"].toDouble(), 0.0);
+    }
+  }
+  EXPECT_TRUE(found);
+  EXPECT_FALSE(plugin->MemoryValue().isEmpty());
+
+  auto gpuUsage = plugin->GpuUsage();
+  ASSERT_EQ(1, gpuUsage.size());
+  auto gpuMap = gpuUsage[0].toMap();
+  EXPECT_EQ("Fake", gpuMap["name"].toString());
+  EXPECT_DOUBLE_EQ(2.0, gpuMap["meshes"].toDouble());
+  EXPECT_DOUBLE_EQ(2.0, gpuMap["total"].toDouble());
+  EXPECT_EQ("2.0 MB", plugin->GpuMemoryValue());
+  GpuMemory::ReleaseAll("Fake");
+}
+
+/////////////////////////////////////////////////
+TEST(PluginProfilerTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Queues))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(common::joinPaths(PROJECT_BINARY_PATH, "lib"));
+
+  std::mutex mutex;
+  msgs::Param received;
+  std::atomic<bool> hasReport{false};
+  transport::Node node;
+  std::function<void(const msgs::Param &)> cb =
+      [&](const msgs::Param &_msg)
+      {
+        if (_msg.params().find("queue/Fake/msgs/depth") ==
+            _msg.params().end())
+        {
+          return;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        received = _msg;
+        hasReport = true;
+      };
+  EXPECT_TRUE(node.Subscribe("/gui/diagnostics", cb));
+
+  const char *pluginStr =
+    "<plugin filename=\"PluginProfiler\">"
+      "<queue_limit name=\"Fake/msgs\" depth=\"8\" policy=\"drop_newest\"/>"
+      "<queue_limit name=\"Fake/invalid\" policy=\"drop_newest\"/>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+  EXPECT_TRUE(app.LoadPlugin("PluginProfiler",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  auto profilers = win->findChildren<plugins::PluginProfiler *>();
+  ASSERT_EQ(1, profilers.size());
+  auto plugin = profilers[0];
+
+  // The limit is set from the config
+  QueueStats::Queue queue("Fake/msgs", true);
+  EXPECT_EQ(8u, queue.CurrentLimit().depth);
+  EXPECT_EQ(QueueStats::DropPolicy::kDropNewest,
+      queue.CurrentLimit().policy);
+  EXPECT_FALSE(QueueStats::LimitOf("Fake/invalid").Enabled());
+
+  queue.Update(20u, 4096u);
+  queue.Update(5u, 2048u);
+  queue.Drop(2u);
+
+  int sleep = 0;
+  int maxSleep = 30;
+  while (!hasReport && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    ++sleep;
+  }
+  ASSERT_TRUE(hasReport);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_DOUBLE_EQ(5.0,
+        received.params().at("queue/Fake/msgs/depth").double_value());
+    EXPECT_DOUBLE_EQ(2048.0,
+        received.params().at("queue/Fake/msgs/bytes").double_value());
+    EXPECT_DOUBLE_EQ(20.0,
+        received.params().at("queue/Fake/msgs/max_depth").double_value());
+    EXPECT_DOUBLE_EQ(4096.0,
+        received.params().at("queue/Fake/msgs/max_bytes").double_value());
+    EXPECT_DOUBLE_EQ(2.0,
+        received.params().at("queue/Fake/msgs/dropped").double_value());
+  }
+
+  // The same report is displayed
+  auto queueUsage = plugin->QueueUsage();
+  ASSERT_EQ(1, queueUsage.size());
+  auto queueMap = queueUsage[0].toMap();
+  EXPECT_EQ("Fake/msgs", queueMap["name"].toString());
+  EXPECT_DOUBLE_EQ(5.0, queueMap["depth"].toDouble());
+  EXPECT_DOUBLE_EQ(20.0, queueMap["maxDepth"].toDouble());
+  EXPECT_DOUBLE_EQ(2.0, queueMap["kb"].toDouble());
+  EXPECT_DOUBLE_EQ(4.0, queueMap["maxKb"].toDouble());
+  EXPECT_EQ("8", queueMap["limit"].toString());
+}
@@ -18,12 +18,25 @@
 #include "gz/msgs/pointcloud_packed.pb.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <limits>
+#include <list>
+#include <memory>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
 #include <gz/common/Profiler.hh>
 #include <gz/math/Color.hh>
 #include <gz/math/Pose3.hh>
@@ -31,23 +44,282 @@
 #include <gz/msgs/PointCloudPackedUtils.hh>
 #include <gz/msgs/Utility.hh>
 #include <gz/plugin/Register.hh>
+#include <gz/rendering/Camera.hh>
+#include <gz/rendering/Marker.hh>
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/RenderingIface.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
 #include <gz/transport/Node.hh>
 
 #include <gz/gui/Application.hh>
 #include <gz/gui/Conversions.hh>
+#include <gz/gui/GpuMemory.hh>
 #include <gz/gui/GuiEvents.hh>
 #include <gz/gui/MainWindow.hh>
+#include <gz/gui/MessagePool.hh>
+#include <gz/gui/Profiler.hh>
+#include <gz/gui/RenderHooks.hh>
+#include <gz/gui/StaticPlugins.hh>
+#include <gz/gui/TopicDiscovery.hh>
 
 #include "PointCloud.hh"
+#include "PointCloudOctree.hh"
+
+namespace
+{
+/// \brief Name the GPU memory of the points is recorded under
+constexpr char kGpuMemoryName[] = "PointCloud";
+
+/// \brief Estimated GPU memory of a point, its position and color as floats
+constexpr uint64_t kPointBytes{28u};
+
+/// \brief Maximum number of points of an octree node
+constexpr std::size_t kOctreeNodePoints{20000u};
+
+/// \brief Octree points uploaded to the GPU per frame at most, so moving
+/// the camera doesn't stall rendering while new nodes stream in
+constexpr uint64_t kOctreeUploadPoints{1000000u};
+
+/// \brief Color maps used to color points by their value
+enum class ColorMap
+{
+  /// \brief Gradient between the minimum and maximum colors
+  kGradient,
+
+  /// \brief Perceptually uniform map, from purple to yellow
+  kViridis,
+
+  /// \brief Rainbow map, from blue to red
+  kJet,
+
+  /// \brief From black to white
+  kGrayscale
+};
+
+/// \brief Names of the color maps, in the order of ColorMap
+const std::array<const char *, 4> kColorMapNames{
+    {"gradient", "viridis", "jet", "grayscale"}};
+
+/// \brief Color of a value in a color map
+/// \param[in] _map Color map
+/// \param[in] _ratio Value, from 0 for the minimum to 1 for the maximum
+/// \param[in] _min Color of the minimum for the gradient map
+/// \param[in] _max Color of the maximum for the gradient map
+/// \return Color
+gz::math::Color MapColor(ColorMap _map, float _ratio,
+    const gz::math::Color &_min, const gz::math::Color &_max)
+{
+  _ratio = std::clamp(_ratio, 0.0f, 1.0f);
+  switch (_map)
+  {
+    case ColorMap::kViridis:
+    {
+      static const std::array<gz::math::Color, 9> viridis{{
+          {0.267f, 0.005f, 0.329f}, {0.283f, 0.141f, 0.458f},
+          {0.254f, 0.265f, 0.530f}, {0.207f, 0.372f, 0.553f},
+          {0.164f, 0.471f, 0.558f}, {0.128f, 0.567f, 0.551f},
+          {0.135f, 0.659f, 0.518f}, {0.360f, 0.786f, 0.388f},
+          {0.993f, 0.906f, 0.144f}}};
+      float pos = _ratio * (viridis.size() - 1);
+      auto index = std::min<std::size_t>(static_cast<std::size_t>(pos),
+          viridis.size() - 2);
+      float t = pos - index;
+      const auto &a = viridis[index];
+      const auto &b = viridis[index + 1];
+      return {a.R() + (b.R() - a.R()) * t,
+              a.G() + (b.G() - a.G()) * t,
+              a.B() + (b.B() - a.B()) * t};
+    }
+    case ColorMap::kJet:
+    {
+      auto channel = [_ratio](float _center)
+      {
+        return std::clamp(1.5f - std::abs(4.0f * _ratio - _center),
+            0.0f, 1.0f);
+      };
+      return {channel(3.0f), channel(2.0f), channel(1.0f)};
+    }
+    case ColorMap::kGrayscale:
+      return {_ratio, _ratio, _ratio};
+    case ColorMap::kGradient:
+    default:
+      return {_min.R() + (_max.R() - _min.R()) * _ratio,
+              _min.G() + (_max.G() - _min.G()) * _ratio,
+              _min.B() + (_max.B() - _min.B()) * _ratio};
+  }
+}
+
+/// \brief Scan kept in the history, rendered by its own geometry
+struct Scan
+{
+  /// \brief Positions of the points
+  std::vector<gz::math::Vector3d> points;
+
+  /// \brief Values of the points, which are mapped to colors
+  std::vector<float> values;
+
+  /// \brief Colors of the points, if they come from an rgb field
+  std::vector<gz::math::Color> colors;
+
+  /// \brief Geometry of the points
+  gz::rendering::MarkerPtr marker{nullptr};
+};
+
+/// \brief Octree node whose points are on the GPU, kept in a LRU cache
+/// while it isn't rendered
+struct CachedNode
+{
+  /// \brief Geometry of the node's points
+  gz::rendering::MarkerPtr marker{nullptr};
+
+  /// \brief Number of points
+  uint64_t count{0u};
+
+  /// \brief Position in the LRU list
+  std::list<uint32_t>::iterator lru;
+
+  /// \brief True if the geometry is attached to the visual
+  bool shown{false};
+};
+
+/// \brief Find a field of a packed point cloud
+/// \param[in] _msg Point cloud message
+/// \param[in] _name Field name
+/// \return Field, null if not found
+const gz::msgs::PointCloudPacked::Field *FindField(
+    const gz::msgs::PointCloudPacked &_msg, const std::string &_name)
+{
+  for (const auto &field : _msg.field())
+  {
+    if (field.name() == _name)
+      return &field;
+  }
+  return nullptr;
+}
+
+/// \brief Read a value of a given type from a point's data
+/// \param[in] _data Start of the value
+/// \return Value converted to float
+template<typename T>
+float ReadAs(const char *_data)
+{
+  T value;
+  std::memcpy(&value, _data, sizeof(T));
+  return static_cast<float>(value);
+}
+
+/// \brief Read a numeric field of a point
+/// \param[in] _data Start of the field's data
+/// \param[in] _type Data type of the field
+/// \return Value of the field
+float ReadField(const char *_data,
+    gz::msgs::PointCloudPacked::Field::DataType _type)
+{
+  switch (_type)
+  {
+    case gz::msgs::PointCloudPacked::Field::INT8:
+      return ReadAs<int8_t>(_data);
+    case gz::msgs::PointCloudPacked::Field::UINT8:
+      return ReadAs<uint8_t>(_data);
+    case gz::msgs::PointCloudPacked::Field::INT16:
+      return ReadAs<int16_t>(_data);
+    case gz::msgs::PointCloudPacked::Field::UINT16:
+      return ReadAs<uint16_t>(_data);
+    case gz::msgs::PointCloudPacked::Field::INT32:
+      return ReadAs<int32_t>(_data);
+    case gz::msgs::PointCloudPacked::Field::UINT32:
+      return ReadAs<uint32_t>(_data);
+    case gz::msgs::PointCloudPacked::Field::FLOAT64:
+      return ReadAs<double>(_data);
+    case gz::msgs::PointCloudPacked::Field::FLOAT32:
+    default:
+      return ReadAs<float>(_data);
+  }
+}
+
+/// \brief Size in bytes of a field's data type
+/// \param[in] _type Data type
+/// \return Size
+std::size_t FieldSize(gz::msgs::PointCloudPacked::Field::DataType _type)
+{
+  switch (_type)
+  {
+    case gz::msgs::PointCloudPacked::Field::INT8:
+    case gz::msgs::PointCloudPacked::Field::UINT8:
+      return 1u;
+    case gz::msgs::PointCloudPacked::Field::INT16:
+    case gz::msgs::PointCloudPacked::Field::UINT16:
+      return 2u;
+    case gz::msgs::PointCloudPacked::Field::FLOAT64:
+      return 8u;
+    default:
+      return 4u;
+  }
+}
+}
 
 /// \brief Private data class for PointCloud
 class gz::gui::plugins::PointCloudPrivate
 {
-  /// \brief Makes a request to populate the scene with markers
-  public: void PublishMarkers();
-
-  /// \brief Makes a request to delete all markers related to the point cloud.
-  public: void ClearMarkers();
+  /// \brief Extract the points of a cloud and their values into
+  /// cloudPoints, cloudValues and cloudColors. Called by the worker only.
+  /// \param[in] _cloud Point cloud
+  /// \param[in] _floatV Values of the points, used if there's no color
+  /// field
+  /// \param[in] _colorField Field of the cloud used to color the points,
+  /// empty to use _floatV
+  public: void UpdatePoints(const gz::msgs::PointCloudPacked &_cloud,
+              const gz::msgs::Float_V &_floatV,
+              const std::string &_colorField);
+
+  /// \brief Reduce the cloud to the points to render. Called by the worker
+  /// only.
+  /// \param[in] _voxelSize Edge of the voxels to downsample to, zero to
+  /// not downsample
+  /// \param[in] _pointBudget Maximum number of points, zero for no limit
+  /// \param[out] _out Points to render
+  public: void Decimate(float _voxelSize, unsigned int _pointBudget,
+              Scan &_out) const;
+
+  /// \brief Ask the worker to update the points from the latest messages.
+  public: void RequestUpdate();
+
+  /// \brief Loop of the worker thread, which updates and decimates the
+  /// points.
+  public: void ProcessWorker();
+
+  /// \brief Stop the worker thread and wait for it to finish.
+  public: void StopWorker();
+
+  /// \brief Recolor the points, after the color map, colors or range
+  /// changed.
+  public: void UpdateColors();
+
+  /// \brief Stop rendering the point cloud.
+  public: void ClearPoints();
+
+  /// \brief Render hook, which updates the point cloud's geometry.
+  public: void OnRender();
+
+  /// \brief Render the octree's nodes chosen for the user camera, called
+  /// by OnRender in octree mode.
+  public: void RenderOctree();
+
+  /// \brief Create the geometry of a scan or octree node.
+  /// \return Marker, whose colors come from its points
+  public: gz::rendering::MarkerPtr CreatePointsMarker();
+
+  /// \brief Evict octree nodes from the GPU, the least recently rendered
+  /// first, until the cache holds at most _limit points.
+  /// \param[in] _limit Number of points
+  /// \param[in] _keep Nodes which mustn't be evicted
+  public: void EvictOctreeNodes(uint64_t _limit,
+              const std::unordered_set<uint32_t> &_keep);
+
+  /// \brief Recycles the point cloud messages received, so their data
+  /// isn't allocated and copied for each message
+  public: MessagePool<gz::msgs::PointCloudPacked> pointCloudPool;
 
   /// \brief Transport node
   public: gz::transport::Node node;
@@ -67,11 +339,12 @@ class gz::gui::plugins::PointCloudPrivate
   /// \brief Protect variables changed from transport and the user
   public: std::recursive_mutex mutex;
 
-  /// \brief Point cloud message containing XYZ positions
-  public: gz::msgs::PointCloudPacked pointCloudMsg;
+  /// \brief Latest point cloud message containing XYZ positions. Replaced
+  /// as a whole, so the worker can process it without holding the lock.
+  public: std::shared_ptr<const gz::msgs::PointCloudPacked> pointCloudMsg;
 
-  /// \brief Message holding a float vector.
-  public: gz::msgs::Float_V floatVMsg;
+  /// \brief Latest message holding a float vector, replaced as a whole.
+  public: std::shared_ptr<const gz::msgs::Float_V> floatVMsg;
 
   /// \brief Minimum value in latest float vector
   public: float minFloatV{std::numeric_limits<float>::max()};
@@ -90,6 +363,197 @@ class gz::gui::plugins::PointCloudPrivate
 
   /// \brief True if showing, changeable at runtime
   public: bool showing{true};
+
+  /// \brief Color map, changeable at runtime
+  public: ColorMap colorMap{ColorMap::kGradient};
+
+  /// \brief Field of the point cloud used to color the points. If empty,
+  /// the float vector is used.
+  public: std::string colorField;
+
+  /// \brief Fields of the latest point cloud which can color the points
+  public: QStringList colorFieldList;
+
+  /// \brief Color field missing from the latest point cloud, to only warn
+  /// once. Owned by the worker.
+  public: std::string missingField;
+
+  /// \brief True if the last update took the value range from the color
+  /// field, in fieldMin and fieldMax. Owned by the worker.
+  public: bool hasFieldRange{false};
+
+  /// \brief Minimum value of the color field in the latest point cloud
+  public: float fieldMin{0};
+
+  /// \brief Maximum value of the color field in the latest point cloud
+  public: float fieldMax{0};
+
+  /// \brief Incremented when the points are cleared, so updates which
+  /// were in progress are dropped
+  public: uint64_t clearGeneration{0};
+
+  /// \brief Colors of the points to render, if they come from an rgb
+  /// field instead of values
+  public: std::vector<gz::math::Color> pointColors;
+
+  /// \brief Number of scans accumulated in the history, changeable at
+  /// runtime
+  public: unsigned int historySize{1};
+
+  /// \brief True if a new cloud arrived since the worker last updated
+  public: bool scanPending{false};
+
+  /// \brief True if the points to render come from a new cloud, which
+  /// takes the oldest slot of the history instead of replacing the latest
+  /// scan
+  public: bool newScan{false};
+
+  /// \brief True to clear the history, except for the latest scan
+  public: bool clearHistory{false};
+
+  /// \brief Positions of all the points of the latest cloud, before
+  /// decimation. Owned by the worker.
+  public: std::vector<gz::math::Vector3d> cloudPoints;
+
+  /// \brief Values of all the points of the latest cloud
+  public: std::vector<float> cloudValues;
+
+  /// \brief Colors of all the points of the latest cloud, if they come
+  /// from an rgb field
+  public: std::vector<gz::math::Color> cloudColors;
+
+  /// \brief Edge of the voxels the cloud is downsampled to, keeping one
+  /// point per voxel. Zero to not downsample.
+  public: float voxelSize{0};
+
+  /// \brief Maximum number of points rendered, applied by striding over
+  /// the cloud after downsampling. Zero for no limit.
+  public: unsigned int pointBudget{0};
+
+  /// \brief Thread updating and decimating the points
+  public: std::thread worker;
+
+  /// \brief Notified when an update is requested or the worker should stop
+  public: std::condition_variable_any workerCv;
+
+  /// \brief True if the worker should update the points
+  public: bool updatePending{false};
+
+  /// \brief True to stop the worker thread
+  public: bool stopWorker{false};
+
+  /// \brief Called by the worker with the value range of the color field,
+  /// after an update which took it from the field
+  public: std::function<void(float, float)> onFieldRange;
+
+  /// \brief Positions of the points to render
+  public: std::vector<gz::math::Vector3d> points;
+
+  /// \brief Values of the points to render, which are mapped to colors
+  public: std::vector<float> values;
+
+  /// \brief True if the points changed since they were last rendered
+  public: bool dirty{false};
+
+  /// \brief True if the colors or point size changed since the points
+  /// were last rendered
+  public: bool styleDirty{false};
+
+  /// \brief Rendered scans, used as a ring buffer of historySize slots.
+  /// Owned by the render thread.
+  public: std::vector<Scan> scans;
+
+  /// \brief Slot of the latest scan
+  public: std::size_t currentScan{0};
+
+  /// \brief Pointer to the rendering scene
+  public: gz::rendering::ScenePtr scene{nullptr};
+
+  /// \brief Visual holding the points
+  public: gz::rendering::VisualPtr visual{nullptr};
+
+  /// \brief Render hook identifier
+  public: uint64_t renderHookId{0};
+
+  /// \brief Identifier of the GPU memory reclaimer
+  public: uint64_t reclaimerId{0};
+
+  /// \brief True once it was warned that the GPU memory budget was
+  /// exceeded
+  public: bool budgetWarned{false};
+
+  /// \brief Get the key the GPU memory of a slot of the history is
+  /// recorded under
+  /// \param[in] _index Slot
+  /// \return Key, unique to this plugin
+  public: std::string GpuMemoryKey(std::size_t _index) const;
+
+  /// \brief Get the key the GPU memory of an octree node is recorded
+  /// under
+  /// \param[in] _node Index of the node
+  /// \return Key, unique to this plugin
+  public: std::string OctreeMemoryKey(uint32_t _node) const;
+
+  /// \brief Free GPU memory for other plugins by dropping the history,
+  /// except for the latest scan, or the octree nodes which aren't
+  /// rendered. Called on the render thread.
+  public: void ReclaimGpuMemory();
+
+  /// \brief True to render clouds through an octree, set on load
+  public: bool octreeMode{false};
+
+  /// \brief File the octree is loaded from on start and written to after
+  /// it's built, empty for none
+  public: std::string octreeFile;
+
+  /// \brief True if the worker should load the octree file
+  public: bool octreeLoadPending{false};
+
+  /// \brief Largest gap between points on screen, in pixels, before octree
+  /// nodes are refined
+  public: double lodError{2.0};
+
+  /// \brief Maximum number of octree points on the GPU, zero for the
+  /// default
+  public: uint64_t octreeCacheSize{0u};
+
+  /// \brief Latest octree, built or loaded by the worker
+  public: std::shared_ptr<const PointCloudOctree> octree;
+
+  /// \brief True if the octree changed since it was last rendered
+  public: bool octreeDirty{false};
+
+  /// \brief Octree being rendered. Owned by the render thread, as are all
+  /// the members below.
+  public: std::shared_ptr<const PointCloudOctree> renderOctree;
+
+  /// \brief Hidden visual holding the geometry of the cached nodes which
+  /// aren't rendered, and of the evicted nodes
+  public: gz::rendering::VisualPtr cacheVisual{nullptr};
+
+  /// \brief Octree nodes on the GPU, by index
+  public: std::unordered_map<uint32_t, CachedNode> cachedNodes;
+
+  /// \brief Cached octree nodes, the most recently rendered first
+  public: std::list<uint32_t> lruNodes;
+
+  /// \brief Total number of points of the cached nodes
+  public: uint64_t cachedPoints{0u};
+
+  /// \brief Geometries of evicted nodes, reused for new ones
+  public: std::vector<gz::rendering::MarkerPtr> freeMarkers;
+
+  /// \brief Camera the octree nodes are chosen for
+  public: gz::rendering::CameraPtr camera{nullptr};
+
+  /// \brief Camera pose the octree nodes were last chosen for
+  public: gz::math::Pose3d lastViewPose;
+
+  /// \brief True if chosen nodes are still to be uploaded
+  public: bool streaming{false};
+
+  /// \brief True if the octree was visible in the last frame
+  public: bool octreeShown{false};
 };
 
 using namespace gz;
@@ -101,12 +565,61 @@ PointCloud::PointCloud()
   : gz::gui::Plugin(),
     dataPtr(std::make_unique<PointCloudPrivate>())
 {
+  // Field ranges are found on the worker, but the properties are set on
+  // the main thread
+  this->dataPtr->onFieldRange = [this](float _min, float _max)
+  {
+    QMetaObject::invokeMethod(this, [this, _min, _max]
+    {
+      this->SetMinFloatV(_min);
+      this->SetMaxFloatV(_max);
+    }, Qt::QueuedConnection);
+  };
+  this->dataPtr->worker =
+      std::thread(&PointCloudPrivate::ProcessWorker, this->dataPtr.get());
 }
 
 /////////////////////////////////////////////////
 PointCloud::~PointCloud()
 {
-  this->dataPtr->ClearMarkers();
+  this->dataPtr->StopWorker();
+  RenderHooks::Unregister(this->dataPtr->renderHookId);
+  GpuMemory::RemoveReclaimer(this->dataPtr->reclaimerId);
+
+  // The visual can only be destroyed on the render thread, so leave that to
+  // a hook which runs once
+  auto visual = this->dataPtr->visual;
+  if (nullptr == visual)
+    return;
+
+  for (std::size_t i = 0; i < this->dataPtr->scans.size(); ++i)
+  {
+    GpuMemory::Release(kGpuMemoryName, GpuMemory::Resource::kPoints,
+        this->dataPtr->GpuMemoryKey(i));
+  }
+  for (const auto &cached : this->dataPtr->cachedNodes)
+  {
+    GpuMemory::Release(kGpuMemoryName, GpuMemory::Resource::kPoints,
+        this->dataPtr->OctreeMemoryKey(cached.first));
+  }
+
+  std::vector<rendering::VisualPtr> visuals{visual};
+  if (nullptr != this->dataPtr->cacheVisual)
+    visuals.push_back(this->dataPtr->cacheVisual);
+
+  auto hookId = std::make_shared<std::atomic<uint64_t>>(0u);
+  *hookId = RenderHooks::Register(RenderPhase::kPreRender,
+      [visuals, hookId]() mutable
+      {
+        for (auto &toDestroy : visuals)
+        {
+          auto scene = toDestroy->Scene();
+          if (nullptr != scene)
+            scene->DestroyVisual(toDestroy);
+        }
+        visuals.clear();
+        RenderHooks::Unregister(*hookId);
+      });
 }
 
 /////////////////////////////////////////////////
@@ -136,10 +649,83 @@ void PointCloud::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
       this->OnFloatVTopic(this->dataPtr->floatVTopicList.at(0));
     }
 
+    auto colorFieldElem = _pluginElem->FirstChildElement("color_field");
+    if (nullptr != colorFieldElem && nullptr != colorFieldElem->GetText())
+      this->SetColorField(QString::fromStdString(colorFieldElem->GetText()));
+
+    auto voxelSizeElem = _pluginElem->FirstChildElement("voxel_size");
+    float voxelSize;
+    if (nullptr != voxelSizeElem &&
+        voxelSizeElem->QueryFloatText(&voxelSize) == tinyxml2::XML_SUCCESS)
+    {
+      this->SetVoxelSize(voxelSize);
+    }
+
+    auto pointBudgetElem = _pluginElem->FirstChildElement("point_budget");
+    unsigned int pointBudget;
+    if (nullptr != pointBudgetElem &&
+        pointBudgetElem->QueryUnsignedText(&pointBudget) ==
+        tinyxml2::XML_SUCCESS)
+    {
+      this->SetPointBudget(static_cast<int>(pointBudget));
+    }
+
+    auto historyElem = _pluginElem->FirstChildElement("history");
+    unsigned int history;
+    if (nullptr != historyElem &&
+        historyElem->QueryUnsignedText(&history) == tinyxml2::XML_SUCCESS)
+    {
+      this->SetHistorySize(static_cast<int>(history));
+    }
+
+    auto colorMapElem = _pluginElem->FirstChildElement("color_map");
+    if (nullptr != colorMapElem && nullptr != colorMapElem->GetText())
+      this->SetColorMap(QString::fromStdString(colorMapElem->GetText()));
+
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    auto octreeElem = _pluginElem->FirstChildElement("octree");
+    if (nullptr != octreeElem)
+      octreeElem->QueryBoolText(&this->dataPtr->octreeMode);
+
+    auto octreeFileElem = _pluginElem->FirstChildElement("octree_file");
+    if (nullptr != octreeFileElem && nullptr != octreeFileElem->GetText())
+      this->dataPtr->octreeFile = octreeFileElem->GetText();
+
+    auto lodErrorElem = _pluginElem->FirstChildElement("lod_error");
+    double lodError;
+    if (nullptr != lodErrorElem &&
+        lodErrorElem->QueryDoubleText(&lodError) == tinyxml2::XML_SUCCESS)
+    {
+      this->dataPtr->lodError = std::max(lodError, 0.0);
+    }
+
+    auto octreeCacheElem = _pluginElem->FirstChildElement("octree_cache");
+    unsigned int octreeCache;
+    if (nullptr != octreeCacheElem &&
+        octreeCacheElem->QueryUnsignedText(&octreeCache) ==
+        tinyxml2::XML_SUCCESS)
+    {
+      this->dataPtr->octreeCacheSize = octreeCache;
+    }
+
+    // The map is shown from the last session's octree until a cloud
+    // arrives
+    if (this->dataPtr->octreeMode && !this->dataPtr->octreeFile.empty() &&
+        common::exists(this->dataPtr->octreeFile))
+    {
+      this->dataPtr->octreeLoadPending = true;
+      this->dataPtr->RequestUpdate();
+    }
   }
 
-  gz::gui::App()->findChild<
-    gz::gui::MainWindow *>()->installEventFilter(this);
+  if (this->dataPtr->renderHookId == 0)
+  {
+    auto dataPtr = this->dataPtr.get();
+    this->dataPtr->renderHookId = RenderHooks::Register(RenderPhase::kRender,
+        [dataPtr]{dataPtr->OnRender();}, 0, "PointCloud");
+    this->dataPtr->reclaimerId = GpuMemory::AddReclaimer(kGpuMemoryName,
+        [dataPtr](uint64_t){dataPtr->ReclaimGpuMemory();});
+  }
 }
 
 //////////////////////////////////////////////////
@@ -155,7 +741,7 @@ void PointCloud::OnPointCloudTopic(const QString &_pointCloudTopic)
   }
 
   // Clear visualization
-  this->dataPtr->ClearMarkers();
+  this->dataPtr->ClearPoints();
 
   this->dataPtr->pointCloudTopic = _pointCloudTopic.toStdString();
 
@@ -164,8 +750,14 @@ void PointCloud::OnPointCloudTopic(const QString &_pointCloudTopic)
       &PointCloud::OnPointCloudService, this);
 
   // Create new subscription
-  if (!this->dataPtr->node.Subscribe(this->dataPtr->pointCloudTopic,
-                            &PointCloud::OnPointCloud, this))
+  auto onPointCloud = [this](
+      std::shared_ptr<gz::msgs::PointCloudPacked> _msg)
+  {
+    this->OnPointCloud(std::move(_msg));
+  };
+  if (!this->dataPtr->pointCloudPool.Subscribe(this->dataPtr->node,
+      this->dataPtr->pointCloudTopic, onPointCloud,
+      this->SubscribeOptions(this->dataPtr->pointCloudTopic)))
   {
     gzerr << "Unable to subscribe to topic ["
            << this->dataPtr->pointCloudTopic << "]\n";
@@ -187,7 +779,7 @@ void PointCloud::OnFloatVTopic(const QString &_floatVTopic)
   }
 
   // Clear visualization
-  this->dataPtr->ClearMarkers();
+  this->dataPtr->ClearPoints();
 
   this->dataPtr->floatVTopic = _floatVTopic.toStdString();
 
@@ -197,7 +789,8 @@ void PointCloud::OnFloatVTopic(const QString &_floatVTopic)
 
   // Create new subscription
   if (!this->dataPtr->node.Subscribe(this->dataPtr->floatVTopic,
-                            &PointCloud::OnFloatV, this))
+      &PointCloud::OnFloatV, this,
+      this->SubscribeOptions(this->dataPtr->floatVTopic)))
   {
     gzerr << "Unable to subscribe to topic ["
            << this->dataPtr->floatVTopic << "]\n";
@@ -209,14 +802,26 @@ void PointCloud::OnFloatVTopic(const QString &_floatVTopic)
 //////////////////////////////////////////////////
 void PointCloud::Show(bool _show)
 {
+  // The octree is kept while hidden, since it's long to build
+  if (this->dataPtr->octreeMode)
+  {
+    {
+      std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+      this->dataPtr->showing = _show;
+    }
+    events::SceneChanged sceneChangedEvent;
+    App()->sendEvent(App()->MainWin(), &sceneChangedEvent);
+    return;
+  }
+
   this->dataPtr->showing = _show;
   if (_show)
   {
-    this->dataPtr->PublishMarkers();
+    this->dataPtr->RequestUpdate();
   }
   else
   {
-    this->dataPtr->ClearMarkers();
+    this->dataPtr->ClearPoints();
   }
 }
 
@@ -231,25 +836,15 @@ void PointCloud::OnRefresh()
   this->dataPtr->floatVTopicList.clear();
 
   // Get updated list
-  std::vector<std::string> allTopics;
-  this->dataPtr->node.TopicList(allTopics);
-  for (auto topic : allTopics)
+  auto discovery = TopicDiscovery::Instance();
+  discovery->Refresh();
+  for (const auto &topic : discovery->Topics("gz.msgs.PointCloudPacked"))
   {
-    std::vector<gz::transport::MessagePublisher> publishers;
-    this->dataPtr->node.TopicInfo(topic, publishers);
-    for (auto pub : publishers)
-    {
-      if (pub.MsgTypeName() == "gz.msgs.PointCloudPacked")
-      {
-        this->dataPtr->pointCloudTopicList.push_back(
-            QString::fromStdString(topic));
-      }
-      else if (pub.MsgTypeName() == "gz.msgs.Float_V")
-      {
-        this->dataPtr->floatVTopicList.push_back(QString::fromStdString(topic));
-      }
-    }
+    this->dataPtr->pointCloudTopicList.push_back(
+        QString::fromStdString(topic));
   }
+  for (const auto &topic : discovery->Topics("gz.msgs.Float_V"))
+    this->dataPtr->floatVTopicList.push_back(QString::fromStdString(topic));
   // Handle floats first, so by the time we get the point cloud it can be
   // colored
   if (this->dataPtr->floatVTopicList.size() > 0)
@@ -297,34 +892,67 @@ void PointCloud::SetFloatVTopicList(
 void PointCloud::OnPointCloud(
     const gz::msgs::PointCloudPacked &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
-  this->dataPtr->pointCloudMsg = _msg;
-  this->dataPtr->PublishMarkers();
+  // Copy the message before locking, so the lock is only held to swap it
+  this->OnPointCloud(std::make_shared<const gz::msgs::PointCloudPacked>(_msg));
 }
 
 //////////////////////////////////////////////////
-void PointCloud::OnFloatV(const gz::msgs::Float_V &_msg)
+void PointCloud::OnPointCloud(
+    std::shared_ptr<const gz::msgs::PointCloudPacked> _msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
-  this->dataPtr->floatVMsg = _msg;
+  if (!_msg)
+    return;
+
+  // Fields other than the position can color the points
+  QStringList fields;
+  for (const auto &field : _msg->field())
+  {
+    if (field.name() != "x" && field.name() != "y" && field.name() != "z")
+      fields.push_back(QString::fromStdString(field.name()));
+  }
+
+  bool fieldsChanged{false};
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->pointCloudMsg = std::move(_msg);
+    this->dataPtr->scanPending = true;
+    this->dataPtr->RequestUpdate();
+
+    if (fields != this->dataPtr->colorFieldList)
+    {
+      this->dataPtr->colorFieldList = fields;
+      fieldsChanged = true;
+    }
+  }
+  if (fieldsChanged)
+    this->ColorFieldListChanged();
+}
 
-  this->dataPtr->minFloatV = std::numeric_limits<float>::max();
-  this->dataPtr->maxFloatV = -std::numeric_limits<float>::max();
+//////////////////////////////////////////////////
+void PointCloud::OnFloatV(const gz::msgs::Float_V &_msg)
+{
+  auto msg = std::make_shared<const gz::msgs::Float_V>(_msg);
 
+  float minValue = std::numeric_limits<float>::max();
+  float maxValue = -std::numeric_limits<float>::max();
   for (auto i = 0; i < _msg.data_size(); ++i)
   {
-    auto data = _msg.data(i);
-    if (data < this->dataPtr->minFloatV)
-      this->SetMinFloatV(data);
-    if (data > this->dataPtr->maxFloatV)
-      this->SetMaxFloatV(data);
+    minValue = std::min(minValue, _msg.data(i));
+    maxValue = std::max(maxValue, _msg.data(i));
   }
 
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->floatVMsg = std::move(msg);
+  }
+  this->SetMinFloatV(minValue);
+  this->SetMaxFloatV(maxValue);
+
   // TODO(chapulina) Publishing whenever we get a new point cloud and a new
   // floatV is good in case these topics are out of sync. But here they're
   // synchronized, so in practice we're publishing markers twice for each
   // PC+float that we get.
-  this->dataPtr->PublishMarkers();
+  this->dataPtr->RequestUpdate();
 }
 
 //////////////////////////////////////////////////
@@ -352,101 +980,805 @@ void PointCloud::OnFloatVService(
 }
 
 //////////////////////////////////////////////////
-void PointCloudPrivate::PublishMarkers()
+void PointCloudPrivate::UpdatePoints(
+    const gz::msgs::PointCloudPacked &_cloud,
+    const gz::msgs::Float_V &_floatV, const std::string &_colorField)
 {
-  GZ_PROFILE("PointCloud::PublishMarkers");
+  GZ_GUI_PROFILE("PointCloud::UpdatePoints");
 
-  if (!this->showing)
-    return;
+  this->cloudPoints.clear();
+  this->cloudValues.clear();
+  this->cloudColors.clear();
+  this->hasFieldRange = false;
 
   // If point cloud empty, do nothing.
-  if (this->pointCloudMsg.height() == 0 &&
-      this->pointCloudMsg.width() == 0)
+  if ((_cloud.height() == 0 &&
+      _cloud.width() == 0) ||
+      _cloud.point_step() == 0)
   {
     return;
   }
 
-  std::lock_guard<std::recursive_mutex> lock(this->mutex);
-  gz::msgs::Marker marker;
-  marker.set_ns(this->pointCloudTopic + this->floatVTopic);
-  marker.set_id(1);
-  marker.set_action(gz::msgs::Marker::ADD_MODIFY);
-  marker.set_type(gz::msgs::Marker::POINTS);
-  marker.set_visibility(gz::msgs::Marker::GUI);
-
-  gz::msgs::Set(marker.mutable_scale(),
-    gz::math::Vector3d::One * this->pointSize);
-
   gz::msgs::PointCloudPackedIterator<float>
-      iterX(this->pointCloudMsg, "x");
+      iterX(_cloud, "x");
   gz::msgs::PointCloudPackedIterator<float>
-      iterY(this->pointCloudMsg, "y");
+      iterY(_cloud, "y");
   gz::msgs::PointCloudPackedIterator<float>
-      iterZ(this->pointCloudMsg, "z");
+      iterZ(_cloud, "z");
 
   // Index of point in point cloud, visualized or not
   int ptIdx{0};
-  auto minC = this->minColor;
-  auto maxC = this->maxColor;
-  auto floatRange = this->maxFloatV - this->minFloatV;
   auto num_points =
-    this->pointCloudMsg.data().size() / this->pointCloudMsg.point_step();
-  if (static_cast<int>(num_points) != this->floatVMsg.data().size())
+    _cloud.data().size() / _cloud.point_step();
+  if (_cloud.data().size() % _cloud.point_step() != 0)
   {
-    gzwarn << "Float message and pointcloud are not of the same size,"
-      <<" visualization may not be accurate" << std::endl;
+    gzwarn << "Mal-formatted pointcloud" << std::endl;
+  }
+
+  // Color from a field of the cloud itself, if chosen and available
+  const gz::msgs::PointCloudPacked::Field *field{nullptr};
+  if (!_colorField.empty())
+  {
+    field = FindField(_cloud, _colorField);
+    if (nullptr != field &&
+        field->offset() + FieldSize(field->datatype()) >
+        _cloud.point_step())
+    {
+      field = nullptr;
+    }
+    if (nullptr == field && this->missingField != _colorField)
+    {
+      gzwarn << "Point cloud has no valid field [" << _colorField
+             << "], coloring with the float vector instead." << std::endl;
+    }
+    this->missingField = nullptr == field ? _colorField : std::string();
   }
-  if (this->pointCloudMsg.data().size() % this->pointCloudMsg.point_step() != 0)
+
+  if (nullptr != field)
   {
-    gzwarn << "Mal-formatted pointcloud" << std::endl;
+    // Packed colors are stored as bytes in BGRA order
+    bool rgb = (_colorField == "rgb" || _colorField == "rgba") &&
+        FieldSize(field->datatype()) >= 4u;
+    bool alpha = _colorField == "rgba";
+    this->fieldMin = std::numeric_limits<float>::max();
+    this->fieldMax = -std::numeric_limits<float>::max();
+
+    this->cloudPoints.reserve(num_points);
+    const char *data = _cloud.data().data();
+    for (; ptIdx < static_cast<int>(num_points);
+        ++iterX, ++iterY, ++iterZ, ++ptIdx)
+    {
+      const char *value =
+          data + ptIdx * _cloud.point_step() + field->offset();
+      if (rgb)
+      {
+        const auto *bytes = reinterpret_cast<const uint8_t *>(value);
+        this->cloudColors.emplace_back(bytes[2] / 255.0f, bytes[1] / 255.0f,
+            bytes[0] / 255.0f, alpha ? bytes[3] / 255.0f : 1.0f);
+        this->cloudValues.push_back(0.0f);
+      }
+      else
+      {
+        float dataVal = ReadField(value, field->datatype());
+
+        // Don't visualize NaN
+        if (std::isnan(dataVal))
+          continue;
+
+        this->fieldMin = std::min(this->fieldMin, dataVal);
+        this->fieldMax = std::max(this->fieldMax, dataVal);
+        this->cloudValues.push_back(dataVal);
+      }
+      this->cloudPoints.emplace_back(*iterX, *iterY, *iterZ);
+    }
+    this->hasFieldRange = !rgb && !this->cloudValues.empty();
+    return;
+  }
+
+  if (static_cast<int>(num_points) != _floatV.data().size())
+  {
+    gzwarn << "Float message and pointcloud are not of the same size,"
+      <<" visualization may not be accurate" << std::endl;
   }
 
-  for (; ptIdx < std::min<int>(this->floatVMsg.data().size(), num_points);
-    ++iterX, ++iterY, ++iterZ, ++ptIdx)
+  int count = std::min<int>(_floatV.data().size(), num_points);
+  this->cloudPoints.reserve(count);
+  this->cloudValues.reserve(count);
+  for (; ptIdx < count; ++iterX, ++iterY, ++iterZ, ++ptIdx)
   {
     // Value from float vector, if available. Otherwise publish all data as
     // zeroes.
-    float dataVal = this->floatVMsg.data(ptIdx);
+    float dataVal = _floatV.data(ptIdx);
 
     // Don't visualize NaN
     if (std::isnan(dataVal))
       continue;
 
-    auto ratio = floatRange > 0 ?
-        (dataVal - this->minFloatV) / floatRange : 0.0f;
-    gz:: math::Color color{
-      minC.R() + (maxC.R() - minC.R()) * ratio,
-      minC.G() + (maxC.G() - minC.G()) * ratio,
-      minC.B() + (maxC.B() - minC.B()) * ratio
-    };
+    this->cloudValues.push_back(dataVal);
+    this->cloudPoints.emplace_back(*iterX, *iterY, *iterZ);
+  }
+}
 
-    gz::msgs::Set(marker.add_materials()->mutable_diffuse(), color);
-    gz::msgs::Set(marker.add_point(), gz::math::Vector3d(
-      *iterX,
-      *iterY,
-      *iterZ));
+//////////////////////////////////////////////////
+void PointCloudPrivate::Decimate(float _voxelSize,
+    unsigned int _pointBudget, Scan &_out) const
+{
+  GZ_GUI_PROFILE("PointCloud::Decimate");
+
+  // Indices of the points kept
+  std::vector<std::size_t> kept;
+  kept.reserve(this->cloudPoints.size());
+  if (_voxelSize > 0)
+  {
+    // Keep the first point of each voxel. Voxel coordinates are packed in
+    // 21 bits each, which is enough for clouds 2 million voxels across.
+    std::unordered_set<uint64_t> voxels;
+    voxels.reserve(this->cloudPoints.size());
+    for (std::size_t i = 0; i < this->cloudPoints.size(); ++i)
+    {
+      uint64_t key{0};
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        auto cell = static_cast<int64_t>(
+            std::floor(this->cloudPoints[i][axis] / _voxelSize));
+        key = (key << 21) | (static_cast<uint64_t>(cell) & 0x1FFFFFu);
+      }
+      if (voxels.insert(key).second)
+        kept.push_back(i);
+    }
+  }
+  else
+  {
+    for (std::size_t i = 0; i < this->cloudPoints.size(); ++i)
+      kept.push_back(i);
   }
 
-  this->node.Request("/marker", marker);
+  std::size_t stride{1};
+  if (_pointBudget > 0 && kept.size() > _pointBudget)
+    stride = (kept.size() + _pointBudget - 1) / _pointBudget;
+
+  std::size_t count = (kept.size() + stride - 1) / stride;
+  _out.points.reserve(count);
+  _out.values.reserve(count);
+  for (std::size_t k = 0; k < kept.size(); k += stride)
+  {
+    auto i = kept[k];
+    _out.points.push_back(this->cloudPoints[i]);
+    _out.values.push_back(this->cloudValues[i]);
+    if (!this->cloudColors.empty())
+      _out.colors.push_back(this->cloudColors[i]);
+  }
 }
 
 //////////////////////////////////////////////////
-void PointCloudPrivate::ClearMarkers()
+void PointCloudPrivate::RequestUpdate()
 {
-  if (this->pointCloudTopic.empty())
-    return;
+  std::lock_guard<std::recursive_mutex> lock(this->mutex);
+  this->updatePending = true;
+  this->workerCv.notify_one();
+}
+
+//////////////////////////////////////////////////
+void PointCloudPrivate::ProcessWorker()
+{
+  GZ_GUI_PROFILE_THREAD_NAME("Point cloud worker");
+  std::unique_lock<std::recursive_mutex> lock(this->mutex);
+  while (true)
+  {
+    this->workerCv.wait(lock, [this]
+    {
+      return this->stopWorker || this->updatePending;
+    });
+    if (this->stopWorker)
+      return;
+
+    // Work on a snapshot of the latest messages and settings, without
+    // holding the lock, so callbacks never wait for the processing
+    this->updatePending = false;
+    auto cloud = this->pointCloudMsg;
+    auto floatV = this->floatVMsg;
+    std::string field = this->colorField;
+    float voxel = this->voxelSize;
+    unsigned int budget = this->pointBudget;
+    bool scan = this->scanPending;
+    this->scanPending = false;
+    uint64_t generation = this->clearGeneration;
+    bool show = this->showing;
+    bool load = this->octreeLoadPending;
+    this->octreeLoadPending = false;
+    std::string file = this->octreeFile;
+    lock.unlock();
+
+    static const gz::msgs::Float_V kNoFloats;
+    if (this->octreeMode)
+    {
+      std::shared_ptr<const PointCloudOctree> tree;
+      if (load)
+      {
+        tree = PointCloudOctree::Load(file);
+
+        // Loaded values have no message to take their range from
+        if (nullptr != tree && tree->Colors().empty() &&
+            !tree->Values().empty() && this->onFieldRange)
+        {
+          auto range = std::minmax_element(tree->Values().begin(),
+              tree->Values().end());
+          this->onFieldRange(*range.first, *range.second);
+        }
+      }
+      else if (nullptr != cloud)
+      {
+        this->UpdatePoints(*cloud, nullptr != floatV ? *floatV : kNoFloats,
+            field);
+        tree = PointCloudOctree::Build(this->cloudPoints, this->cloudValues,
+            this->cloudColors, kOctreeNodePoints);
+
+        // The octree has its own copy of the points
+        this->cloudPoints = std::vector<gz::math::Vector3d>();
+        this->cloudValues = std::vector<float>();
+        this->cloudColors = std::vector<gz::math::Color>();
+        if (this->hasFieldRange && this->onFieldRange)
+          this->onFieldRange(this->fieldMin, this->fieldMax);
+      }
+
+      lock.lock();
+      if (nullptr == tree || generation != this->clearGeneration)
+        continue;
+      this->octree = tree;
+      this->octreeDirty = true;
 
+      // Written once it's shown, for the next session to load
+      if (!load && !file.empty())
+      {
+        lock.unlock();
+        if (tree->Save(file))
+        {
+          gzmsg << "Wrote point cloud octree [" << file << "]"
+                << std::endl;
+        }
+        lock.lock();
+      }
+      continue;
+    }
+    Scan out;
+    if (show && nullptr != cloud)
+    {
+      this->UpdatePoints(*cloud, nullptr != floatV ? *floatV : kNoFloats,
+          field);
+      this->Decimate(voxel, budget, out);
+    }
+
+    if (this->hasFieldRange && this->onFieldRange)
+      this->onFieldRange(this->fieldMin, this->fieldMax);
+
+    lock.lock();
+
+    // Points cleared while processing must stay cleared
+    if (generation != this->clearGeneration)
+      continue;
+
+    this->points.swap(out.points);
+    this->values.swap(out.values);
+    this->pointColors.swap(out.colors);
+    this->dirty = true;
+    this->newScan = this->newScan || scan;
+  }
+}
+
+//////////////////////////////////////////////////
+void PointCloudPrivate::StopWorker()
+{
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    this->stopWorker = true;
+  }
+  this->workerCv.notify_all();
+  if (this->worker.joinable())
+    this->worker.join();
+}
+
+//////////////////////////////////////////////////
+void PointCloudPrivate::UpdateColors()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->mutex);
+  this->styleDirty = true;
+}
+
+//////////////////////////////////////////////////
+void PointCloudPrivate::ClearPoints()
+{
   std::lock_guard<std::recursive_mutex> lock(this->mutex);
-  gz::msgs::Marker msg;
-  msg.set_ns(this->pointCloudTopic + this->floatVTopic);
-  msg.set_id(0);
-  msg.set_action(gz::msgs::Marker::DELETE_ALL);
+  this->updatePending = false;
+  this->scanPending = false;
+  this->clearHistory = true;
+  ++this->clearGeneration;
+  this->points.clear();
+  this->values.clear();
+  this->pointColors.clear();
+  this->dirty = true;
+  this->octreeLoadPending = false;
+  this->octree.reset();
+  this->octreeDirty = true;
+}
+
+//////////////////////////////////////////////////
+void PointCloudPrivate::OnRender()
+{
+  if (nullptr == this->scene)
+  {
+    this->scene = rendering::sceneFromFirstRenderEngine();
+    if (nullptr == this->scene)
+      return;
+  }
 
-  gzdbg << "Clearing markers on "
-    << this->pointCloudTopic + this->floatVTopic
-    << std::endl;
+  if (!RenderHooks::RunsFor(this->scene->Name()))
+    return;
+
+  if (this->octreeMode)
+  {
+    this->RenderOctree();
+    return;
+  }
+
+  // Take the latest points, so the lock isn't held while updating the
+  // geometry. When only the colors changed, the values kept from the last
+  // updates are mapped again, without going through the messages.
+  Scan latest;
+  bool updated;
+  bool addScan{false};
+  bool clear;
+  std::size_t history;
+  float size;
+  float minValue;
+  float maxValue;
+  ColorMap map;
+  gz::math::Color minC;
+  gz::math::Color maxC;
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    if (!this->dirty && !this->styleDirty && !this->clearHistory)
+      return;
+    updated = this->dirty;
+    if (this->dirty)
+    {
+      latest.points.swap(this->points);
+      latest.values.swap(this->values);
+      latest.colors.swap(this->pointColors);
+      addScan = this->newScan;
+      this->newScan = false;
+    }
+    clear = this->clearHistory;
+    this->dirty = false;
+    this->styleDirty = false;
+    this->clearHistory = false;
+    history = std::max(1u, this->historySize);
+    size = this->pointSize;
+    minValue = this->minFloatV;
+    maxValue = this->maxFloatV;
+    map = this->colorMap;
+    minC = this->minColor;
+    maxC = this->maxColor;
+  }
+
+  GZ_GUI_PROFILE("PointCloud::OnRender");
+
+  if (nullptr == this->visual)
+  {
+    this->visual = this->scene->CreateVisual();
+    this->scene->RootVisual()->AddChild(this->visual);
+  }
 
-  this->node.Request("/marker", msg);
+  // Slots are only created as the history fills up, and kept afterwards
+  // even if the history shrinks, so their geometry can be reused
+  if (this->scans.size() < history)
+    this->scans.resize(history);
+
+  // Slots which must be rebuilt
+  std::vector<std::size_t> rebuild;
+  if (clear)
+  {
+    // Keep the latest scan only, in the first slot
+    std::swap(this->scans[0].points, this->scans[this->currentScan].points);
+    std::swap(this->scans[0].values, this->scans[this->currentScan].values);
+    std::swap(this->scans[0].colors, this->scans[this->currentScan].colors);
+    for (std::size_t i = 1; i < this->scans.size(); ++i)
+    {
+      this->scans[i].points.clear();
+      this->scans[i].values.clear();
+      this->scans[i].colors.clear();
+      if (nullptr != this->scans[i].marker)
+        this->scans[i].marker->ClearPoints();
+      GpuMemory::Release(kGpuMemoryName, GpuMemory::Resource::kPoints,
+          this->GpuMemoryKey(i));
+    }
+    this->currentScan = 0;
+    rebuild.push_back(0);
+  }
+
+  if (updated)
+  {
+    // A new scan overwrites the oldest slot in place, other slots are left
+    // untouched
+    if (addScan && !this->scans[this->currentScan].points.empty())
+      this->currentScan = (this->currentScan + 1) % history;
+
+    auto &scan = this->scans[this->currentScan];
+    scan.points = std::move(latest.points);
+    scan.values = std::move(latest.values);
+    scan.colors = std::move(latest.colors);
+    rebuild.push_back(this->currentScan);
+  }
+
+  // Colors and sizes apply to the whole history
+  if (!updated && !clear)
+  {
+    for (std::size_t i = 0; i < history; ++i)
+      rebuild.push_back(i);
+  }
+
+  auto range = maxValue - minValue;
+  for (auto index : rebuild)
+  {
+    auto &scan = this->scans[index];
+    if (nullptr == scan.marker)
+    {
+      scan.marker = this->CreatePointsMarker();
+      this->visual->AddGeometry(scan.marker);
+    }
+
+    scan.marker->SetSize(size);
+    scan.marker->ClearPoints();
+
+    // Stay within the GPU memory budget, by striding over the scan if it
+    // doesn't fit whole
+    auto key = this->GpuMemoryKey(index);
+    GpuMemory::Release(kGpuMemoryName, GpuMemory::Resource::kPoints, key);
+    std::size_t stride{1u};
+    if (!GpuMemory::Reserve(kGpuMemoryName, GpuMemory::Resource::kPoints,
+        key, scan.points.size() * kPointBytes))
+    {
+      auto fit = std::max<uint64_t>(1u,
+          GpuMemory::AvailableBytes() / kPointBytes);
+      stride = static_cast<std::size_t>(
+          (scan.points.size() + fit - 1u) / fit);
+      GpuMemory::Record(kGpuMemoryName, GpuMemory::Resource::kPoints, key,
+          ((scan.points.size() + stride - 1u) / stride) * kPointBytes);
+      if (!this->budgetWarned)
+      {
+        gzwarn << "The GPU memory budget is exceeded, only 1 in " << stride
+               << " points of the cloud is rendered." << std::endl;
+        this->budgetWarned = true;
+      }
+    }
+
+    for (std::size_t i = 0; i < scan.points.size(); i += stride)
+    {
+      if (!scan.colors.empty())
+      {
+        scan.marker->AddPoint(scan.points[i], scan.colors[i]);
+        continue;
+      }
+
+      // Uniform clouds use the minimum color, whatever the map
+      if (range <= 0)
+      {
+        scan.marker->AddPoint(scan.points[i], minC);
+        continue;
+      }
+      auto ratio = (scan.values[i] - minValue) / range;
+      scan.marker->AddPoint(scan.points[i],
+          MapColor(map, ratio, minC, maxC));
+    }
+  }
+
+  bool empty = std::all_of(this->scans.begin(), this->scans.end(),
+      [](const Scan &_scan){return _scan.points.empty();});
+  this->visual->SetVisible(!empty);
+
+  // Let scenes which skip unchanged frames know they need to render
+  events::SceneChanged sceneChangedEvent;
+  App()->sendEvent(App()->MainWin(), &sceneChangedEvent);
+}
+
+/////////////////////////////////////////////////
+void PointCloudPrivate::RenderOctree()
+{
+  bool restyle;
+  bool show;
+  float size;
+  float minValue;
+  float maxValue;
+  ColorMap map;
+  gz::math::Color minC;
+  gz::math::Color maxC;
+  double maxError;
+  uint64_t budget;
+  uint64_t cacheSize;
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    restyle = this->styleDirty || this->octreeDirty;
+    if (this->octreeDirty)
+      this->renderOctree = this->octree;
+    this->octreeDirty = false;
+    this->styleDirty = false;
+    this->dirty = false;
+    this->clearHistory = false;
+    show = this->showing;
+    size = this->pointSize;
+    minValue = this->minFloatV;
+    maxValue = this->maxFloatV;
+    map = this->colorMap;
+    minC = this->minColor;
+    maxC = this->maxColor;
+    maxError = this->lodError;
+    budget = this->pointBudget;
+    cacheSize = this->octreeCacheSize;
+  }
+
+  // By default, nodes which were just left behind stay cached
+  if (cacheSize == 0u)
+  {
+    cacheSize = budget > 0u ? 2u * budget :
+        std::numeric_limits<uint64_t>::max();
+  }
+
+  if (nullptr == this->visual)
+  {
+    this->visual = this->scene->CreateVisual();
+    this->scene->RootVisual()->AddChild(this->visual);
+    this->cacheVisual = this->scene->CreateVisual();
+    this->cacheVisual->SetVisible(false);
+    this->scene->RootVisual()->AddChild(this->cacheVisual);
+  }
+
+  // Nodes are colored on upload, so they're all uploaded again
+  bool changed{false};
+  if (restyle)
+  {
+    this->EvictOctreeNodes(0u, {});
+    this->streaming = false;
+    changed = true;
+  }
+
+  // Attach to the first camera, which is the user camera
+  for (unsigned int i = 0;
+       nullptr == this->camera && i < this->scene->NodeCount(); ++i)
+  {
+    this->camera = std::dynamic_pointer_cast<rendering::Camera>(
+        this->scene->NodeByIndex(i));
+  }
+
+  bool visible = show && nullptr != this->renderOctree &&
+      nullptr != this->camera && !this->renderOctree->Nodes().empty();
+  if (visible != this->octreeShown)
+  {
+    this->visual->SetVisible(visible);
+    this->octreeShown = visible;
+    changed = true;
+  }
+
+  PointCloudOctree::View view;
+  if (visible)
+    view.pose = this->camera->WorldPose();
+
+  // Nodes are only chosen again when the camera moved, or while they're
+  // streaming in
+  if (visible && (changed || this->streaming || view.pose !=
+      this->lastViewPose))
+  {
+    GZ_GUI_PROFILE("PointCloud::RenderOctree");
+
+    this->lastViewPose = view.pose;
+    view.hfov = this->camera->HFOV().Radian();
+    view.aspectRatio = this->camera->AspectRatio();
+    view.width = this->camera->ImageWidth();
+    auto selected = this->renderOctree->Select(view, maxError, budget);
+    std::unordered_set<uint32_t> wanted(selected.begin(), selected.end());
+
+    // Nodes which aren't chosen anymore stay on the GPU while there's room
+    for (auto &cached : this->cachedNodes)
+    {
+      if (cached.second.shown && wanted.count(cached.first) == 0u)
+      {
+        this->visual->RemoveGeometry(cached.second.marker);
+        this->cacheVisual->AddGeometry(cached.second.marker);
+        cached.second.shown = false;
+        changed = true;
+      }
+    }
+
+    // Upload the chosen nodes which aren't cached, the coarsest first, a
+    // few per frame
+    const auto &nodes = this->renderOctree->Nodes();
+    const auto &points = this->renderOctree->Points();
+    const auto &values = this->renderOctree->Values();
+    const auto &colors = this->renderOctree->Colors();
+    auto range = maxValue - minValue;
+    uint64_t uploaded{0u};
+    bool full{false};
+    this->streaming = false;
+    for (auto index : selected)
+    {
+      auto it = this->cachedNodes.find(index);
+      if (it == this->cachedNodes.end())
+      {
+        const auto &node = nodes[index];
+        if (full || (uploaded > 0u &&
+            uploaded + node.count > kOctreeUploadPoints))
+        {
+          this->streaming = !full;
+          continue;
+        }
+
+        if (node.count <= cacheSize)
+          this->EvictOctreeNodes(cacheSize - node.count, wanted);
+        auto key = this->OctreeMemoryKey(index);
+        if (!GpuMemory::Reserve(kGpuMemoryName,
+            GpuMemory::Resource::kPoints, key, node.count * kPointBytes))
+        {
+          // Nodes further down are less important than those shown
+          full = true;
+          if (!this->budgetWarned)
+          {
+            gzwarn << "The GPU memory budget is exceeded, the point cloud "
+                   << "is rendered with less detail." << std::endl;
+            this->budgetWarned = true;
+          }
+          continue;
+        }
+
+        CachedNode cached;
+        cached.count = node.count;
+        if (this->freeMarkers.empty())
+        {
+          cached.marker = this->CreatePointsMarker();
+        }
+        else
+        {
+          cached.marker = this->freeMarkers.back();
+          this->freeMarkers.pop_back();
+          this->cacheVisual->RemoveGeometry(cached.marker);
+        }
+        cached.marker->SetSize(size);
+        cached.marker->ClearPoints();
+        for (auto i = node.offset; i < node.offset + node.count; ++i)
+        {
+          const auto &point = points[i];
+          math::Vector3d position(point.X(), point.Y(), point.Z());
+          if (!colors.empty())
+          {
+            cached.marker->AddPoint(position, colors[i]);
+            continue;
+          }
+
+          // Uniform clouds use the minimum color, whatever the map
+          if (range <= 0)
+          {
+            cached.marker->AddPoint(position, minC);
+            continue;
+          }
+          cached.marker->AddPoint(position,
+              MapColor(map, (values[i] - minValue) / range, minC, maxC));
+        }
+        this->lruNodes.push_front(index);
+        cached.lru = this->lruNodes.begin();
+        this->cachedPoints += node.count;
+        uploaded += node.count;
+        it = this->cachedNodes.emplace(index, cached).first;
+        this->visual->AddGeometry(it->second.marker);
+        it->second.shown = true;
+        changed = true;
+        continue;
+      }
+
+      this->lruNodes.splice(this->lruNodes.begin(), this->lruNodes,
+          it->second.lru);
+      if (!it->second.shown)
+      {
+        this->cacheVisual->RemoveGeometry(it->second.marker);
+        this->visual->AddGeometry(it->second.marker);
+        it->second.shown = true;
+        changed = true;
+      }
+    }
+  }
+
+  // Let scenes which skip unchanged frames know they need to render
+  if (changed || this->streaming)
+  {
+    events::SceneChanged sceneChangedEvent;
+    App()->sendEvent(App()->MainWin(), &sceneChangedEvent);
+  }
+}
+
+/////////////////////////////////////////////////
+rendering::MarkerPtr PointCloudPrivate::CreatePointsMarker()
+{
+  auto marker = this->scene->CreateMarker();
+  marker->SetType(rendering::MarkerType::MT_POINTS);
+
+  // Colors come from the points
+  auto material = this->scene->CreateMaterial();
+  material->SetDiffuse(math::Color::White);
+  material->SetLightingEnabled(false);
+  marker->SetMaterial(material, true /* clone */);
+  this->scene->DestroyMaterial(material);
+  return marker;
+}
+
+/////////////////////////////////////////////////
+void PointCloudPrivate::EvictOctreeNodes(uint64_t _limit,
+    const std::unordered_set<uint32_t> &_keep)
+{
+  auto it = this->lruNodes.end();
+  while (this->cachedPoints > _limit && it != this->lruNodes.begin())
+  {
+    --it;
+    if (_keep.count(*it) > 0u)
+      continue;
+
+    // The geometry is kept empty for another node
+    auto cached = this->cachedNodes.find(*it);
+    auto marker = cached->second.marker;
+    if (cached->second.shown)
+    {
+      this->visual->RemoveGeometry(marker);
+      this->cacheVisual->AddGeometry(marker);
+    }
+    marker->ClearPoints();
+    this->freeMarkers.push_back(marker);
+    this->cachedPoints -= cached->second.count;
+    GpuMemory::Release(kGpuMemoryName, GpuMemory::Resource::kPoints,
+        this->OctreeMemoryKey(*it));
+    this->cachedNodes.erase(cached);
+    it = this->lruNodes.erase(it);
+  }
+}
+
+/////////////////////////////////////////////////
+std::string PointCloudPrivate::OctreeMemoryKey(uint32_t _node) const
+{
+  return this->visual->Name() + "/octree/" + std::to_string(_node);
+}
+
+/////////////////////////////////////////////////
+std::string PointCloudPrivate::GpuMemoryKey(std::size_t _index) const
+{
+  return this->visual->Name() + "/" + std::to_string(_index);
+}
+
+/////////////////////////////////////////////////
+void PointCloudPrivate::ReclaimGpuMemory()
+{
+  if (nullptr == this->visual)
+    return;
+
+  if (this->octreeMode)
+  {
+    std::unordered_set<uint32_t> shown;
+    for (const auto &cached : this->cachedNodes)
+    {
+      if (cached.second.shown)
+        shown.insert(cached.first);
+    }
+    this->EvictOctreeNodes(0u, shown);
+    return;
+  }
+
+  for (std::size_t i = 0; i < this->scans.size(); ++i)
+  {
+    auto &scan = this->scans[i];
+    if (i == this->currentScan || scan.points.empty())
+      continue;
+
+    scan.points.clear();
+    scan.values.clear();
+    scan.colors.clear();
+    if (nullptr != scan.marker)
+      scan.marker->ClearPoints();
+    GpuMemory::Release(kGpuMemoryName, GpuMemory::Resource::kPoints,
+        this->GpuMemoryKey(i));
+  }
 }
 
 /////////////////////////////////////////////////
@@ -460,7 +1792,7 @@ void PointCloud::SetMinColor(const QColor &_minColor)
 {
   this->dataPtr->minColor = gz::gui::convert(_minColor);
   this->MinColorChanged();
-  this->dataPtr->PublishMarkers();
+  this->dataPtr->UpdateColors();
 }
 
 /////////////////////////////////////////////////
@@ -474,7 +1806,7 @@ void PointCloud::SetMaxColor(const QColor &_maxColor)
 {
   this->dataPtr->maxColor = gz::gui::convert(_maxColor);
   this->MaxColorChanged();
-  this->dataPtr->PublishMarkers();
+  this->dataPtr->UpdateColors();
 }
 
 /////////////////////////////////////////////////
@@ -488,6 +1820,7 @@ void PointCloud::SetMinFloatV(float _minFloatV)
 {
   this->dataPtr->minFloatV = _minFloatV;
   this->MinFloatVChanged();
+  this->dataPtr->UpdateColors();
 }
 
 /////////////////////////////////////////////////
@@ -501,6 +1834,7 @@ void PointCloud::SetMaxFloatV(float _maxFloatV)
 {
   this->dataPtr->maxFloatV = _maxFloatV;
   this->MaxFloatVChanged();
+  this->dataPtr->UpdateColors();
 }
 
 /////////////////////////////////////////////////
@@ -514,9 +1848,108 @@ void PointCloud::SetPointSize(float _pointSize)
 {
   this->dataPtr->pointSize = _pointSize;
   this->PointSizeChanged();
-  this->dataPtr->PublishMarkers();
+  this->dataPtr->UpdateColors();
+}
+
+/////////////////////////////////////////////////
+QString PointCloud::ColorMap() const
+{
+  return kColorMapNames[static_cast<std::size_t>(this->dataPtr->colorMap)];
+}
+
+/////////////////////////////////////////////////
+void PointCloud::SetColorMap(const QString &_colorMap)
+{
+  auto name = _colorMap.toLower().toStdString();
+  for (std::size_t i = 0; i < kColorMapNames.size(); ++i)
+  {
+    if (name == kColorMapNames[i])
+    {
+      this->dataPtr->colorMap = static_cast<::ColorMap>(i);
+      this->ColorMapChanged();
+      this->dataPtr->UpdateColors();
+      return;
+    }
+  }
+  gzerr << "Unknown color map [" << _colorMap.toStdString() << "]"
+         << std::endl;
+}
+
+/////////////////////////////////////////////////
+QString PointCloud::ColorField() const
+{
+  return QString::fromStdString(this->dataPtr->colorField);
+}
+
+/////////////////////////////////////////////////
+void PointCloud::SetColorField(const QString &_colorField)
+{
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->colorField = _colorField.toStdString();
+    this->dataPtr->RequestUpdate();
+  }
+  this->ColorFieldChanged();
+}
+
+/////////////////////////////////////////////////
+QStringList PointCloud::ColorFieldList() const
+{
+  return this->dataPtr->colorFieldList;
+}
+
+/////////////////////////////////////////////////
+float PointCloud::VoxelSize() const
+{
+  return this->dataPtr->voxelSize;
+}
+
+/////////////////////////////////////////////////
+void PointCloud::SetVoxelSize(float _voxelSize)
+{
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->voxelSize = std::max(0.0f, _voxelSize);
+  }
+  this->VoxelSizeChanged();
+  this->dataPtr->RequestUpdate();
+}
+
+/////////////////////////////////////////////////
+int PointCloud::PointBudget() const
+{
+  return static_cast<int>(this->dataPtr->pointBudget);
+}
+
+/////////////////////////////////////////////////
+void PointCloud::SetPointBudget(int _pointBudget)
+{
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->pointBudget =
+        static_cast<unsigned int>(std::max(0, _pointBudget));
+  }
+  this->PointBudgetChanged();
+  this->dataPtr->RequestUpdate();
+}
+
+/////////////////////////////////////////////////
+int PointCloud::HistorySize() const
+{
+  return static_cast<int>(this->dataPtr->historySize);
+}
+
+/////////////////////////////////////////////////
+void PointCloud::SetHistorySize(int _historySize)
+{
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->historySize =
+        static_cast<unsigned int>(std::max(1, _historySize));
+    this->dataPtr->clearHistory = true;
+  }
+  this->HistorySizeChanged();
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(gz::gui::plugins::PointCloud,
-                    gz::gui::Plugin)
+GZ_GUI_ADD_PLUGIN(gz::gui::plugins::PointCloud, "PointCloud")
@@ -41,17 +41,67 @@ namespace plugins
   /// which will be used to color all points with a color gradient according to
   /// their values. The float message must have the same number of elements as
   /// the point cloud and be indexed the same way. NaN values on the FloatV
-  /// message aren't displayed.
+  /// message aren't displayed. Changing the color map, the colors or the
+  /// value range recolors the points that are already displayed.
+  ///
+  /// Alternatively, the points can be colored by a field of the point cloud
+  /// itself, such as `intensity` or `ring`, without a float vector topic.
+  /// Fields called `rgb` or `rgba` hold the color of each point, packed as
+  /// bytes in BGRA order.
   ///
   /// Requirements:
   /// * A plugin that loads a 3D scene, such as `MinimalScene`
-  /// * The `MarkerManager` plugin
+  ///
+  /// The points are rendered directly in the scene, as a single points
+  /// geometry which is updated on the render thread.
   ///
   /// Parameters:
   ///
   /// * `<point_cloud_topic>`: Topic to receive
   ///      `gz::msgs::PointCloudPacked` messages.
   /// * `<float_v_topic>`: Topic to receive `gz::msgs::FloatV` messages.
+  /// * `<color_field>`: Field of the point cloud used to color the points
+  ///      instead of the float vector.
+  /// * `<voxel_size>`: Edge in meters of the voxels the cloud is
+  ///      downsampled to, keeping one point per voxel. Defaults to 0, which
+  ///      doesn't downsample.
+  /// * `<point_budget>`: Maximum number of points rendered. Clouds which are
+  ///      still larger after downsampling are strided. Defaults to 0, no
+  ///      limit.
+  /// * `<history>`: Number of scans accumulated, to show for example a map
+  ///      being built. Each new scan replaces the oldest one, so memory
+  ///      stays bounded and older scans aren't rebuilt. Defaults to 1, which
+  ///      only shows the latest scan. When another plugin needs GPU memory
+  ///      beyond the budget, see MinimalScene's `<gpu_memory_budget>`, the
+  ///      older scans are dropped. Scans which don't fit in the budget are
+  ///      strided.
+  /// * `<color_map>`: Color map for the float values, one of `gradient`,
+  ///      between the minimum and maximum colors, `viridis`, `jet` or
+  ///      `grayscale`. Defaults to `gradient`.
+  /// * `<octree>`: True to render clouds through an octree, see below.
+  ///      Defaults to false.
+  /// * `<octree_file>`: File the octree is loaded from on start, and
+  ///      written to after each cloud is built into an octree.
+  /// * `<lod_error>`: Largest gap between octree points on screen, in
+  ///      pixels, before more detail is rendered. Defaults to 2.
+  /// * `<octree_cache>`: Maximum number of octree points kept on the GPU.
+  ///      Defaults to twice the point budget, or no limit.
+  ///
+  /// ## Octree
+  ///
+  /// Static clouds too large to render whole, like maps of tens of
+  /// millions of points, can be rendered through an octree. Each cloud is
+  /// built into an octree on the worker thread, whose nodes hold points
+  /// spread evenly over their region. Only the nodes in view and close
+  /// enough to the camera for their gaps to show are rendered, within the
+  /// `<point_budget>`, so regions close to the camera get more detail than
+  /// distant ones.
+  ///
+  /// Nodes are uploaded to the GPU a few per frame as the camera moves,
+  /// and nodes left behind stay there until the `<octree_cache>` or the
+  /// GPU memory budget is full, the least recently rendered evicted first.
+  /// The voxel size and history don't apply to octrees, and changing the
+  /// colors uploads all the nodes again.
   class PointCloud : public gz::gui::Plugin
   {
     Q_OBJECT
@@ -104,6 +154,53 @@ namespace plugins
       NOTIFY MaxFloatVChanged
     )
 
+    /// \brief Field of the point cloud used to color the points
+    Q_PROPERTY(
+      QString colorField
+      READ ColorField
+      WRITE SetColorField
+      NOTIFY ColorFieldChanged
+    )
+
+    /// \brief Fields of the latest point cloud which can color the points
+    Q_PROPERTY(
+      QStringList colorFieldList
+      READ ColorFieldList
+      NOTIFY ColorFieldListChanged
+    )
+
+    /// \brief Color map
+    Q_PROPERTY(
+      QString colorMap
+      READ ColorMap
+      WRITE SetColorMap
+      NOTIFY ColorMapChanged
+    )
+
+    /// \brief Voxel size used to downsample the cloud
+    Q_PROPERTY(
+      float voxelSize
+      READ VoxelSize
+      WRITE SetVoxelSize
+      NOTIFY VoxelSizeChanged
+    )
+
+    /// \brief Maximum number of points rendered
+    Q_PROPERTY(
+      int pointBudget
+      READ PointBudget
+      WRITE SetPointBudget
+      NOTIFY PointBudgetChanged
+    )
+
+    /// \brief Number of scans accumulated
+    Q_PROPERTY(
+      int historySize
+      READ HistorySize
+      WRITE SetHistorySize
+      NOTIFY HistorySizeChanged
+    )
+
     /// \brief Point size
     Q_PROPERTY(
       float pointSize
@@ -125,6 +222,12 @@ namespace plugins
     /// \param[in] _msg Point cloud message
     public: void OnPointCloud(const msgs::PointCloudPacked &_msg);
 
+    /// \brief Callback function for point cloud topic, keeping the message
+    /// without copying it.
+    /// \param[in] _msg Point cloud message, mustn't be modified afterwards
+    public: void OnPointCloud(
+        std::shared_ptr<const msgs::PointCloudPacked> _msg);
+
     /// \brief Callback function for point cloud service
     /// \param[in] _msg Point cloud message
     /// \param[out] _result True on success.
@@ -216,6 +319,37 @@ namespace plugins
     /// \brief Notify that maximum value has changed
     signals: void MaxFloatVChanged();
 
+    /// \brief Get the field used to color the points
+    /// \return Field name, empty if the float vector is used
+    public: Q_INVOKABLE QString ColorField() const;
+
+    /// \brief Set the field used to color the points
+    /// \param[in] _colorField Field name, empty to use the float vector
+    public: Q_INVOKABLE void SetColorField(const QString &_colorField);
+
+    /// \brief Notify that the color field has changed
+    signals: void ColorFieldChanged();
+
+    /// \brief Get the fields of the latest point cloud, other than the
+    /// position, which can color the points
+    /// \return Field names
+    public: Q_INVOKABLE QStringList ColorFieldList() const;
+
+    /// \brief Notify that the color field list has changed
+    signals: void ColorFieldListChanged();
+
+    /// \brief Get the color map
+    /// \return Name of the color map
+    public: Q_INVOKABLE QString ColorMap() const;
+
+    /// \brief Set the color map
+    /// \param[in] _colorMap Name of the color map, one of "gradient",
+    /// "viridis", "jet" or "grayscale".
+    public: Q_INVOKABLE void SetColorMap(const QString &_colorMap);
+
+    /// \brief Notify that color map has changed
+    signals: void ColorMapChanged();
+
     /// \brief Get the point size
     /// \return Maximum value
     public: Q_INVOKABLE float PointSize() const;
@@ -227,6 +361,40 @@ namespace plugins
     /// \brief Notify that point size has changed
     signals: void PointSizeChanged();
 
+    /// \brief Get the voxel size used to downsample the cloud
+    /// \return Voxel edge in meters, zero if not downsampling
+    public: Q_INVOKABLE float VoxelSize() const;
+
+    /// \brief Set the voxel size used to downsample the cloud
+    /// \param[in] _voxelSize Voxel edge in meters, zero to not downsample
+    public: Q_INVOKABLE void SetVoxelSize(float _voxelSize);
+
+    /// \brief Notify that voxel size has changed
+    signals: void VoxelSizeChanged();
+
+    /// \brief Get the maximum number of points rendered
+    /// \return Point budget, zero for no limit
+    public: Q_INVOKABLE int PointBudget() const;
+
+    /// \brief Set the maximum number of points rendered
+    /// \param[in] _pointBudget Point budget, zero for no limit
+    public: Q_INVOKABLE void SetPointBudget(int _pointBudget);
+
+    /// \brief Notify that point budget has changed
+    signals: void PointBudgetChanged();
+
+    /// \brief Get the number of scans accumulated
+    /// \return Number of scans, 1 to only show the latest
+    public: Q_INVOKABLE int HistorySize() const;
+
+    /// \brief Set the number of scans accumulated. This clears the
+    /// history, except for the latest scan.
+    /// \param[in] _historySize Number of scans, 1 to only show the latest
+    public: Q_INVOKABLE void SetHistorySize(int _historySize);
+
+    /// \brief Notify that history size has changed
+    signals: void HistorySizeChanged();
+
     /// \brief Set whether to show the point cloud.
     /// \param[in] _show Boolean value for displaying the points.
     public: Q_INVOKABLE void Show(bool _show);
@@ -113,6 +113,107 @@ ColumnLayout {
       ToolTip.text: qsTr("Gazebo Transport topics publishing FloatV messages, used to color each point on the cloud")
     }
 
+    Label {
+      Layout.columnSpan: 1
+      text: "Color field"
+    }
+
+    ComboBox {
+      Layout.columnSpan: 2
+      id: colorFieldCombo
+      Layout.fillWidth: true
+      model: ["Float vector"].concat(PointCloud.colorFieldList)
+      currentIndex: PointCloud.colorField === "" ? 0 :
+          Math.max(0, model.indexOf(PointCloud.colorField))
+      onActivated: {
+        PointCloud.SetColorField(index === 0 ? "" : textAt(index));
+      }
+      ToolTip.visible: hovered
+      ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
+      ToolTip.text: qsTr("Field of the point cloud used to color each point, or the float vector topic")
+    }
+
+    Label {
+      Layout.columnSpan: 1
+      text: "Color map"
+    }
+
+    ComboBox {
+      Layout.columnSpan: 2
+      id: colorMapCombo
+      Layout.fillWidth: true
+      model: ["gradient", "viridis", "jet", "grayscale"]
+      currentIndex: model.indexOf(PointCloud.colorMap)
+      onActivated: {
+        PointCloud.SetColorMap(textAt(index));
+      }
+      ToolTip.visible: hovered
+      ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
+      ToolTip.text: qsTr("Map from float values to colors. The gradient goes from the minimum to the maximum color")
+    }
+
+    Label {
+      Layout.columnSpan: 1
+      text: "Voxel size"
+    }
+
+    GzSpinBox {
+      Layout.columnSpan: 2
+      id: voxelSizeSpin
+      value: PointCloud.voxelSize
+      minimumValue: 0
+      maximumValue: 100
+      decimals: 2
+      stepSize: 0.05
+      onEditingFinished: {
+        PointCloud.SetVoxelSize(voxelSizeSpin.value)
+      }
+      ToolTip.visible: hovered
+      ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
+      ToolTip.text: qsTr("Edge of the voxels the cloud is downsampled to, in meters. 0 shows all points")
+    }
+
+    Label {
+      Layout.columnSpan: 1
+      text: "Point budget"
+    }
+
+    GzSpinBox {
+      Layout.columnSpan: 2
+      id: pointBudgetSpin
+      value: PointCloud.pointBudget
+      minimumValue: 0
+      maximumValue: 100000000
+      decimals: 0
+      stepSize: 10000
+      onEditingFinished: {
+        PointCloud.SetPointBudget(pointBudgetSpin.value)
+      }
+      ToolTip.visible: hovered
+      ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
+      ToolTip.text: qsTr("Maximum number of points shown. 0 for no limit")
+    }
+
+    Label {
+      Layout.columnSpan: 1
+      text: "History"
+    }
+
+    GzSpinBox {
+      Layout.columnSpan: 2
+      id: historySpin
+      value: PointCloud.historySize
+      minimumValue: 1
+      maximumValue: 1000
+      decimals: 0
+      onEditingFinished: {
+        PointCloud.SetHistorySize(historySpin.value)
+      }
+      ToolTip.visible: hovered
+      ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
+      ToolTip.text: qsTr("Number of scans accumulated")
+    }
+
     Label {
       Layout.columnSpan: 1
       text: "Point size"
@@ -179,7 +280,7 @@ ColumnLayout {
     Button {
       Layout.columnSpan: 1
       id: maxColorButton
-      visible: !isUniform()
+      visible: !isUniform() && PointCloud.colorMap === "gradient"
       ToolTip.visible: hovered
       ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
       ToolTip.text: qsTr("Color for maximum value")
@@ -0,0 +1,473 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include <gz/common/Console.hh>
+
+#include "PointCloudOctree.hh"
+
+namespace
+{
+/// \brief Written at the start of octree files, with the format version
+constexpr char kMagic[8] = {'G', 'Z', 'P', 'C', 'O', 'C', 'T', '1'};
+
+/// \brief Depth at which nodes keep all their points, so clouds with many
+/// points at the same position don't split forever
+constexpr int kMaxDepth{21};
+
+/// \brief Write a value to a file as raw bytes
+/// \param[in] _out File
+/// \param[in] _value Value
+template<typename T>
+void WriteRaw(std::ofstream &_out, const T &_value)
+{
+  _out.write(reinterpret_cast<const char *>(&_value), sizeof(T));
+}
+
+/// \brief Read a value written by WriteRaw
+/// \param[in] _in File
+/// \param[out] _value Value
+/// \return False if the file ended
+template<typename T>
+bool ReadRaw(std::ifstream &_in, T &_value)
+{
+  _in.read(reinterpret_cast<char *>(&_value), sizeof(T));
+  return static_cast<bool>(_in);
+}
+
+/// \brief Node whose points are still to be split
+struct PendingNode
+{
+  /// \brief Index of the node
+  uint32_t node;
+
+  /// \brief Indices of the points in the node's cube
+  std::vector<uint32_t> indices;
+
+  /// \brief Depth of the node, 0 for the root
+  int depth;
+};
+}
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+/////////////////////////////////////////////////
+std::shared_ptr<const PointCloudOctree> PointCloudOctree::Build(
+    const std::vector<gz::math::Vector3d> &_points,
+    const std::vector<float> &_values,
+    const std::vector<gz::math::Color> &_colors,
+    std::size_t _nodeSize)
+{
+  auto tree = std::make_shared<PointCloudOctree>();
+  if (_points.empty() || _points.size() > std::numeric_limits<uint32_t>::max())
+  {
+    if (!_points.empty())
+      gzerr << "Point cloud is too large for an octree" << std::endl;
+    return tree;
+  }
+  bool hasColors = _colors.size() == _points.size();
+
+  gz::math::Vector3d min = _points[0];
+  gz::math::Vector3d max = _points[0];
+  for (const auto &point : _points)
+  {
+    min.Min(point);
+    max.Max(point);
+  }
+
+  // Points are spread over a grid of about _nodeSize cells in each node,
+  // keeping one point per cell. Those left go down to the children.
+  _nodeSize = std::max<std::size_t>(_nodeSize, 1u);
+  auto grid = std::max(1, static_cast<int>(
+      std::cbrt(static_cast<double>(_nodeSize))));
+  std::vector<uint8_t> occupied(static_cast<std::size_t>(grid) * grid * grid);
+
+  Node root;
+  root.center = (min + max) * 0.5;
+  // Slightly larger than the cloud, so points on its far faces are inside
+  root.halfSize = std::max((max - min).Max() * 0.5, 1e-3) * (1.0 + 1e-6);
+  tree->nodes.push_back(root);
+  tree->points.reserve(_points.size());
+  tree->values.reserve(_points.size());
+  if (hasColors)
+    tree->colors.reserve(_points.size());
+
+  std::vector<PendingNode> pending(1);
+  pending[0].node = 0u;
+  pending[0].depth = 0;
+  pending[0].indices.resize(_points.size());
+  for (std::size_t i = 0; i < _points.size(); ++i)
+    pending[0].indices[i] = static_cast<uint32_t>(i);
+
+  auto append = [&](uint32_t _index)
+  {
+    const auto &point = _points[_index];
+    tree->points.emplace_back(static_cast<float>(point.X()),
+        static_cast<float>(point.Y()), static_cast<float>(point.Z()));
+    tree->values.push_back(_index < _values.size() ? _values[_index] : 0.0f);
+    if (hasColors)
+      tree->colors.push_back(_colors[_index]);
+  };
+
+  while (!pending.empty())
+  {
+    auto current = std::move(pending.back());
+    pending.pop_back();
+
+    // Nodes may move as children are added, so they're copied
+    Node node = tree->nodes[current.node];
+    node.offset = tree->points.size();
+    node.spacing = 2.0 * node.halfSize / grid;
+
+    std::vector<uint32_t> rest;
+    if (current.indices.size() <= _nodeSize || current.depth >= kMaxDepth)
+    {
+      for (auto index : current.indices)
+        append(index);
+    }
+    else
+    {
+      std::fill(occupied.begin(), occupied.end(), 0u);
+      auto corner = node.center - gz::math::Vector3d(
+          node.halfSize, node.halfSize, node.halfSize);
+      for (auto index : current.indices)
+      {
+        std::size_t cell{0u};
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          auto coord = static_cast<int>(
+              (_points[index][axis] - corner[axis]) / node.spacing);
+          cell = cell * grid + std::clamp(coord, 0, grid - 1);
+        }
+        if (occupied[cell] == 0u)
+        {
+          occupied[cell] = 1u;
+          append(index);
+        }
+        else
+        {
+          rest.push_back(index);
+        }
+      }
+    }
+    node.count = tree->points.size() - node.offset;
+    current.indices = std::vector<uint32_t>();
+
+    if (!rest.empty())
+    {
+      std::array<std::vector<uint32_t>, 8> octants;
+      for (auto index : rest)
+      {
+        const auto &point = _points[index];
+        int octant = (point.X() >= node.center.X() ? 1 : 0) |
+            (point.Y() >= node.center.Y() ? 2 : 0) |
+            (point.Z() >= node.center.Z() ? 4 : 0);
+        octants[octant].push_back(index);
+      }
+      rest = std::vector<uint32_t>();
+
+      for (int octant = 0; octant < 8; ++octant)
+      {
+        if (octants[octant].empty())
+          continue;
+
+        Node child;
+        double quarter = node.halfSize * 0.5;
+        child.center = node.center + gz::math::Vector3d(
+            (octant & 1) ? quarter : -quarter,
+            (octant & 2) ? quarter : -quarter,
+            (octant & 4) ? quarter : -quarter);
+        child.halfSize = quarter;
+        node.children[octant] = static_cast<uint32_t>(tree->nodes.size());
+        tree->nodes.push_back(child);
+
+        PendingNode next;
+        next.node = node.children[octant];
+        next.indices = std::move(octants[octant]);
+        next.depth = current.depth + 1;
+        pending.push_back(std::move(next));
+      }
+    }
+    tree->nodes[current.node] = node;
+  }
+
+  return tree;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<const PointCloudOctree> PointCloudOctree::Load(
+    const std::string &_path)
+{
+  std::ifstream in(_path, std::ios::binary | std::ios::ate);
+  if (!in.is_open())
+  {
+    gzerr << "Failed to open point cloud octree [" << _path << "]"
+          << std::endl;
+    return nullptr;
+  }
+  auto fileSize = static_cast<uint64_t>(in.tellg());
+  in.seekg(0);
+
+  char magic[sizeof(kMagic)];
+  uint64_t nodeCount{0u};
+  uint64_t pointCount{0u};
+  uint8_t hasColors{0u};
+  in.read(magic, sizeof(magic));
+  if (!in || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      !ReadRaw(in, nodeCount) || !ReadRaw(in, pointCount) ||
+      !ReadRaw(in, hasColors))
+  {
+    gzerr << "File [" << _path << "] isn't a point cloud octree"
+          << std::endl;
+    return nullptr;
+  }
+
+  // Check the size before allocating anything
+  const uint64_t nodeBytes = 7 * 8 + 8 * 4;
+  const uint64_t pointBytes = 4 * 4 + (hasColors != 0u ? 4 * 4 : 0);
+  const uint64_t headerBytes = sizeof(kMagic) + 8 + 8 + 1;
+  if (nodeCount > std::numeric_limits<uint32_t>::max() ||
+      pointCount > std::numeric_limits<uint32_t>::max() ||
+      fileSize != headerBytes + nodeCount * nodeBytes +
+      pointCount * pointBytes)
+  {
+    gzerr << "Point cloud octree [" << _path << "] is truncated or corrupt"
+          << std::endl;
+    return nullptr;
+  }
+
+  auto tree = std::make_shared<PointCloudOctree>();
+  tree->nodes.resize(nodeCount);
+  for (auto &node : tree->nodes)
+  {
+    double center[3];
+    for (auto &coord : center)
+      ReadRaw(in, coord);
+    node.center.Set(center[0], center[1], center[2]);
+    ReadRaw(in, node.halfSize);
+    ReadRaw(in, node.spacing);
+    ReadRaw(in, node.offset);
+    ReadRaw(in, node.count);
+    for (auto &child : node.children)
+      ReadRaw(in, child);
+
+    bool valid = node.offset <= pointCount &&
+        node.count <= pointCount - node.offset;
+    for (auto child : node.children)
+      valid = valid && child < nodeCount;
+    if (!valid)
+    {
+      gzerr << "Point cloud octree [" << _path << "] is corrupt"
+            << std::endl;
+      return nullptr;
+    }
+  }
+
+  tree->points.resize(pointCount);
+  tree->values.resize(pointCount);
+  for (auto &point : tree->points)
+  {
+    float coords[3];
+    for (auto &coord : coords)
+      ReadRaw(in, coord);
+    point.Set(coords[0], coords[1], coords[2]);
+  }
+  for (auto &value : tree->values)
+    ReadRaw(in, value);
+  if (hasColors != 0u)
+  {
+    tree->colors.resize(pointCount);
+    for (auto &color : tree->colors)
+    {
+      float rgba[4];
+      for (auto &channel : rgba)
+        ReadRaw(in, channel);
+      color.Set(rgba[0], rgba[1], rgba[2], rgba[3]);
+    }
+  }
+
+  if (!in)
+  {
+    gzerr << "Failed to read point cloud octree [" << _path << "]"
+          << std::endl;
+    return nullptr;
+  }
+  return tree;
+}
+
+/////////////////////////////////////////////////
+bool PointCloudOctree::Save(const std::string &_path) const
+{
+  std::ofstream out(_path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open())
+  {
+    gzerr << "Failed to write point cloud octree [" << _path << "]"
+          << std::endl;
+    return false;
+  }
+
+  // Raw values in the byte order of the machine, since octrees are a cache
+  // of clouds rather than a format to exchange them
+  out.write(kMagic, sizeof(kMagic));
+  WriteRaw(out, static_cast<uint64_t>(this->nodes.size()));
+  WriteRaw(out, static_cast<uint64_t>(this->points.size()));
+  WriteRaw(out, static_cast<uint8_t>(this->colors.empty() ? 0u : 1u));
+  for (const auto &node : this->nodes)
+  {
+    WriteRaw(out, node.center.X());
+    WriteRaw(out, node.center.Y());
+    WriteRaw(out, node.center.Z());
+    WriteRaw(out, node.halfSize);
+    WriteRaw(out, node.spacing);
+    WriteRaw(out, node.offset);
+    WriteRaw(out, node.count);
+    for (auto child : node.children)
+      WriteRaw(out, child);
+  }
+  for (const auto &point : this->points)
+  {
+    WriteRaw(out, point.X());
+    WriteRaw(out, point.Y());
+    WriteRaw(out, point.Z());
+  }
+  for (auto value : this->values)
+    WriteRaw(out, value);
+  for (const auto &color : this->colors)
+  {
+    WriteRaw(out, color.R());
+    WriteRaw(out, color.G());
+    WriteRaw(out, color.B());
+    WriteRaw(out, color.A());
+  }
+
+  if (!out)
+  {
+    gzerr << "Failed to write point cloud octree [" << _path << "]"
+          << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::vector<uint32_t> PointCloudOctree::Select(const View &_view,
+    double _maxError, uint64_t _pointBudget) const
+{
+  std::vector<uint32_t> selected;
+  if (this->nodes.empty())
+    return selected;
+
+  const double tanH = std::tan(_view.hfov * 0.5);
+  const double tanV = tanH / std::max(_view.aspectRatio, 1e-6);
+  const double focal = _view.width * 0.5 / std::max(tanH, 1e-6);
+
+  // Size on screen of the gaps between a node's points, or -1 if the
+  // node's bounding sphere is outside of the view
+  auto screenError = [&](const Node &_node)
+  {
+    auto local = _view.pose.Rot().RotateVectorReverse(
+        _node.center - _view.pose.Pos());
+    double radius = _node.halfSize * std::sqrt(3.0);
+    if (local.X() < -radius ||
+        std::abs(local.Y()) - local.X() * tanH >
+        radius * std::sqrt(1.0 + tanH * tanH) ||
+        std::abs(local.Z()) - local.X() * tanV >
+        radius * std::sqrt(1.0 + tanV * tanV))
+    {
+      return -1.0;
+    }
+
+    double distance = local.Length() - radius;
+    if (distance <= 0.0)
+      return std::numeric_limits<double>::infinity();
+    return _node.spacing * focal / distance;
+  };
+
+  // Nodes with the largest gaps are refined first
+  using Candidate = std::pair<double, uint32_t>;
+  std::priority_queue<Candidate> candidates;
+  double rootError = screenError(this->nodes[0]);
+  if (rootError >= 0.0)
+    candidates.emplace(rootError, 0u);
+
+  uint64_t total{0u};
+  while (!candidates.empty())
+  {
+    auto candidate = candidates.top();
+    candidates.pop();
+    const auto &node = this->nodes[candidate.second];
+
+    // The root is always rendered, even beyond the budget
+    if (_pointBudget > 0u && !selected.empty() &&
+        total + node.count > _pointBudget)
+    {
+      break;
+    }
+    selected.push_back(candidate.second);
+    total += node.count;
+
+    if (candidate.first <= _maxError)
+      continue;
+    for (auto child : node.children)
+    {
+      if (child == 0u)
+        continue;
+      double error = screenError(this->nodes[child]);
+      if (error >= 0.0)
+        candidates.emplace(error, child);
+    }
+  }
+  return selected;
+}
+
+/////////////////////////////////////////////////
+const std::vector<PointCloudOctree::Node> &PointCloudOctree::Nodes() const
+{
+  return this->nodes;
+}
+
+/////////////////////////////////////////////////
+const std::vector<gz::math::Vector3f> &PointCloudOctree::Points() const
+{
+  return this->points;
+}
+
+/////////////////////////////////////////////////
+const std::vector<float> &PointCloudOctree::Values() const
+{
+  return this->values;
+}
+
+/////////////////////////////////////////////////
+const std::vector<gz::math::Color> &PointCloudOctree::Colors() const
+{
+  return this->colors;
+}
+}
+}
+}
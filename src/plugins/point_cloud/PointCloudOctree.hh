@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_POINTCLOUD_POINTCLOUDOCTREE_HH_
+#define GZ_GUI_PLUGINS_POINTCLOUD_POINTCLOUDOCTREE_HH_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/math/Color.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector3.hh>
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Octree of a large static point cloud, whose nodes each hold a
+  /// subset of the points, so the cloud can be rendered at the level of
+  /// detail of each region's distance to the camera.
+  ///
+  /// The root holds points spread evenly over the whole cloud, and each
+  /// node's children hold points spread over its octants, which fill in
+  /// between the node's points. Rendering a node and its ancestors gives
+  /// the detail of that node, so nodes are only ever added to the
+  /// rendered ones under nodes which already are.
+  ///
+  /// Octrees are immutable once built or loaded, so they're shared
+  /// between threads without locking.
+  class PointCloudOctree
+  {
+    /// \brief Node of the octree
+    public: struct Node
+    {
+      /// \brief Center of the node's cube
+      gz::math::Vector3d center;
+
+      /// \brief Half of the edge of the node's cube
+      double halfSize{0.0};
+
+      /// \brief Distance between the node's points, which is the size of
+      /// the gaps in the cloud if its children aren't rendered
+      double spacing{0.0};
+
+      /// \brief Index of the node's first point
+      uint64_t offset{0u};
+
+      /// \brief Number of points of the node
+      uint64_t count{0u};
+
+      /// \brief Indices of the children, by octant. Zero for no child,
+      /// since the root is no one's child.
+      std::array<uint32_t, 8> children{};
+    };
+
+    /// \brief Camera the nodes are chosen for
+    public: struct View
+    {
+      /// \brief Pose of the camera, looking along X with Z up
+      gz::math::Pose3d pose;
+
+      /// \brief Horizontal field of view in radians
+      double hfov{1.0};
+
+      /// \brief Width over height of the image
+      double aspectRatio{1.0};
+
+      /// \brief Width of the image in pixels
+      unsigned int width{1u};
+    };
+
+    /// \brief Build an octree. This takes a few seconds for tens of
+    /// millions of points, so it's done on a worker thread.
+    /// \param[in] _points Positions of the points
+    /// \param[in] _values Values of the points, one per point
+    /// \param[in] _colors Colors of the points, one per point, or empty
+    /// \param[in] _nodeSize Maximum number of points of a node
+    /// \return Octree, empty if there are no points
+    public: static std::shared_ptr<const PointCloudOctree> Build(
+        const std::vector<gz::math::Vector3d> &_points,
+        const std::vector<float> &_values,
+        const std::vector<gz::math::Color> &_colors,
+        std::size_t _nodeSize);
+
+    /// \brief Load an octree written by Save.
+    /// \param[in] _path File path
+    /// \return Octree, null if the file couldn't be read
+    public: static std::shared_ptr<const PointCloudOctree> Load(
+        const std::string &_path);
+
+    /// \brief Write the octree to a file, to be loaded instead of built
+    /// the next time.
+    /// \param[in] _path File path
+    /// \return True on success
+    public: bool Save(const std::string &_path) const;
+
+    /// \brief Choose the nodes to render from a camera. Nodes outside of
+    /// the camera's view aren't chosen. The others are refined while the
+    /// gaps between their points cover more than _maxError pixels, those
+    /// with the largest gaps first, until the point budget is reached.
+    /// \param[in] _view Camera
+    /// \param[in] _maxError Largest gap between points on screen, in
+    /// pixels
+    /// \param[in] _pointBudget Maximum number of points, zero for no limit
+    /// \return Indices of the nodes, each after its parent
+    public: std::vector<uint32_t> Select(const View &_view, double _maxError,
+        uint64_t _pointBudget) const;
+
+    /// \brief Get the nodes.
+    /// \return Nodes, the root first, empty if there are no points
+    public: const std::vector<Node> &Nodes() const;
+
+    /// \brief Get the positions of the points, grouped by node.
+    /// \return Positions
+    public: const std::vector<gz::math::Vector3f> &Points() const;
+
+    /// \brief Get the values of the points, grouped by node.
+    /// \return Values
+    public: const std::vector<float> &Values() const;
+
+    /// \brief Get the colors of the points, grouped by node.
+    /// \return Colors, empty if the points are colored by their values
+    public: const std::vector<gz::math::Color> &Colors() const;
+
+    /// \brief Nodes, the root first
+    private: std::vector<Node> nodes;
+
+    /// \brief Positions of the points, grouped by node. Floats are precise
+    /// enough for maps and halve the memory of very large clouds.
+    private: std::vector<gz::math::Vector3f> points;
+
+    /// \brief Values of the points, grouped by node
+    private: std::vector<float> values;
+
+    /// \brief Colors of the points, grouped by node, if they have any
+    private: std::vector<gz::math::Color> colors;
+  };
+}
+}
+}
+#endif
@@ -15,13 +15,26 @@
  *
 */
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <google/protobuf/message.h>
+
 #include <gz/common/Console.hh>
+#include <gz/gui/StaticPlugins.hh>
 #include <gz/msgs/Utility.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/transport/Node.hh>
 
 #include "Publisher.hh"
+#include "TrafficGenerator.hh"
 
 namespace gz
 {
@@ -31,6 +44,16 @@ namespace plugins
 {
   class PublisherPrivate
   {
+    /// \brief Publish the message at the frequency until stopped. Runs on
+    /// the publishing thread.
+    /// \param[in] _msg Message, parsed once
+    /// \param[in] _frequency Frequency in Hz
+    public: void PublishLoop(
+        std::unique_ptr<google::protobuf::Message> _msg, double _frequency);
+
+    /// \brief Stop the publishing thread, if it's running, and wait for it
+    public: void Stop();
+
     /// \brief Message type
     public: QString msgType = "gz.msgs.StringMsg";
 
@@ -43,8 +66,50 @@ namespace plugins
     /// \brief Frequency
     public: double frequency = 1.0;
 
-    /// \brief Timer to keep publishing
-    public: QTimer *timer;
+    /// \brief Thread publishing at the frequency
+    public: std::thread thread;
+
+    /// \brief Protects stop
+    public: std::mutex mutex;
+
+    /// \brief Wakes the publishing thread to stop
+    public: std::condition_variable cv;
+
+    /// \brief True to stop the publishing thread
+    public: bool stop{false};
+
+    /// \brief Number of messages published by the thread
+    public: std::atomic<uint64_t> published{0u};
+
+    /// \brief Value of published at the last rate update
+    public: uint64_t lastPublished{0u};
+
+    /// \brief Time of the last rate update
+    public: std::chrono::steady_clock::time_point lastRateUpdate;
+
+    /// \brief Timer to update the achieved rate
+    public: QTimer rateTimer;
+
+    /// \brief Rate achieved over the last second, in Hz
+    public: double achievedRate{0.0};
+
+    /// \brief Streams of the traffic generator, from the config
+    public: std::vector<TrafficGenerator::Stream> trafficStreams;
+
+    /// \brief Publishes the traffic streams
+    public: TrafficGenerator traffic;
+
+    /// \brief Totals at the last traffic statistics update
+    public: std::vector<TrafficGenerator::Counters> lastTotals;
+
+    /// \brief Time of the last traffic statistics update
+    public: std::chrono::steady_clock::time_point lastTrafficUpdate;
+
+    /// \brief Timer to update the traffic statistics
+    public: QTimer trafficTimer;
+
+    /// \brief Statistics per traffic stream, see Publisher::TrafficStats
+    public: QVariantList trafficStats;
 
     /// \brief Node for communication
     public: gz::transport::Node node;
@@ -60,15 +125,66 @@ using namespace gz;
 using namespace gui;
 using namespace plugins;
 
+/////////////////////////////////////////////////
+void PublisherPrivate::PublishLoop(
+    std::unique_ptr<google::protobuf::Message> _msg, double _frequency)
+{
+  using Clock = std::chrono::steady_clock;
+  auto period = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(1.0 / _frequency));
+
+  // Deadlines are absolute, so the rate doesn't drift with the time spent
+  // publishing
+  auto next = Clock::now();
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (!this->stop)
+  {
+    if (this->cv.wait_until(lock, next, [this]{return this->stop;}))
+      break;
+
+    lock.unlock();
+    this->pub.Publish(*_msg);
+    ++this->published;
+    lock.lock();
+
+    // When too far behind, the schedule restarts rather than catching up
+    // in a burst
+    next += period;
+    auto now = Clock::now();
+    if (next + period < now)
+      next = now;
+  }
+}
+
+/////////////////////////////////////////////////
+void PublisherPrivate::Stop()
+{
+  if (!this->thread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stop = true;
+  }
+  this->cv.notify_all();
+  this->thread.join();
+  this->stop = false;
+}
+
 /////////////////////////////////////////////////
 Publisher::Publisher()
   : Plugin(), dataPtr(new PublisherPrivate)
 {
+  this->connect(&this->dataPtr->rateTimer, &QTimer::timeout, this,
+      &Publisher::UpdateAchievedRate);
+  this->connect(&this->dataPtr->trafficTimer, &QTimer::timeout, this,
+      &Publisher::UpdateTrafficStats);
 }
 
 /////////////////////////////////////////////////
 Publisher::~Publisher()
 {
+  this->dataPtr->Stop();
 }
 
 /////////////////////////////////////////////////
@@ -94,21 +210,36 @@ void Publisher::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 
     if (auto frequencyElem = _pluginElem->FirstChildElement("frequency"))
       frequencyElem->QueryDoubleText(&this->dataPtr->frequency);
-  }
 
-  this->dataPtr->timer = new QTimer(this);
+    if (auto trafficElem = _pluginElem->FirstChildElement("traffic"))
+    {
+      this->dataPtr->trafficStreams.clear();
+      for (auto streamElem = trafficElem->FirstChildElement("stream");
+          streamElem != nullptr;
+          streamElem = streamElem->NextSiblingElement("stream"))
+      {
+        TrafficGenerator::Stream stream;
+        if (TrafficGenerator::LoadStream(streamElem, stream))
+          this->dataPtr->trafficStreams.push_back(stream);
+      }
+      this->TrafficChanged();
+    }
+  }
 }
 
 /////////////////////////////////////////////////
 void Publisher::OnPublish(const bool _checked)
 {
+  this->dataPtr->Stop();
+  this->dataPtr->rateTimer.stop();
+  if (this->dataPtr->achievedRate != 0.0)
+  {
+    this->dataPtr->achievedRate = 0.0;
+    this->AchievedRateChanged();
+  }
+
   if (!_checked)
   {
-    if (this->dataPtr->timer != nullptr)
-    {
-      this->dataPtr->timer->stop();
-      this->disconnect(this->dataPtr->timer, 0, 0, 0);
-    }
     this->dataPtr->pub = transport::Node::Publisher();
     return;
   }
@@ -117,7 +248,8 @@ void Publisher::OnPublish(const bool _checked)
   auto msgType = this->dataPtr->msgType.toStdString();
   auto msgData = this->dataPtr->msgData.toStdString();
 
-  // Check it's possible to create message
+  // Check it's possible to create message. It's parsed only once, and
+  // published as many times as needed.
   auto msg = msgs::Factory::New(msgType, msgData);
   if (!msg || (msg->DebugString() == "" && msgData != ""))
   {
@@ -146,13 +278,108 @@ void Publisher::OnPublish(const bool _checked)
     return;
   }
 
-  this->dataPtr->timer->setInterval(1000/this->dataPtr->frequency);
-  this->connect(this->dataPtr->timer, &QTimer::timeout, [=]()
+  this->dataPtr->published = 0u;
+  this->dataPtr->lastPublished = 0u;
+  this->dataPtr->lastRateUpdate = std::chrono::steady_clock::now();
+  this->dataPtr->rateTimer.start(1000);
+
+  this->dataPtr->thread = std::thread(&PublisherPrivate::PublishLoop,
+      this->dataPtr.get(), std::move(msg), this->dataPtr->frequency);
+}
+
+/////////////////////////////////////////////////
+void Publisher::UpdateAchievedRate()
+{
+  auto now = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(
+      now - this->dataPtr->lastRateUpdate).count();
+  if (seconds <= 0.0)
+    return;
+
+  uint64_t published = this->dataPtr->published;
+  this->dataPtr->achievedRate =
+      static_cast<double>(published - this->dataPtr->lastPublished) /
+      seconds;
+  this->dataPtr->lastPublished = published;
+  this->dataPtr->lastRateUpdate = now;
+  this->AchievedRateChanged();
+}
+
+/////////////////////////////////////////////////
+double Publisher::AchievedRate() const
+{
+  return this->dataPtr->achievedRate;
+}
+
+/////////////////////////////////////////////////
+void Publisher::OnTraffic(const bool _checked)
+{
+  this->dataPtr->trafficTimer.stop();
+  this->dataPtr->traffic.Stop();
+
+  if (_checked &&
+      this->dataPtr->traffic.Start(this->dataPtr->trafficStreams))
+  {
+    this->dataPtr->lastTotals = this->dataPtr->traffic.Totals();
+    this->dataPtr->lastTrafficUpdate = std::chrono::steady_clock::now();
+    this->dataPtr->trafficTimer.start(1000);
+  }
+
+  this->UpdateTrafficStats();
+}
+
+/////////////////////////////////////////////////
+void Publisher::UpdateTrafficStats()
+{
+  auto &data = *this->dataPtr;
+  auto now = std::chrono::steady_clock::now();
+  double seconds =
+      std::chrono::duration<double>(now - data.lastTrafficUpdate).count();
+  auto running = data.traffic.Running();
+  auto totals = data.traffic.Totals();
+
+  data.trafficStats.clear();
+  for (std::size_t i = 0; i < data.trafficStreams.size(); ++i)
   {
-    auto newMsg = msgs::Factory::New(msgType, msgData);
-    this->dataPtr->pub.Publish(*newMsg);
-  });
-  this->dataPtr->timer->start();
+    const auto &stream = data.trafficStreams[i];
+    double rate{0.0};
+    double throughput{0.0};
+    uint64_t failures{0u};
+    if (running && i < totals.size() && i < data.lastTotals.size() &&
+        seconds > 0.0)
+    {
+      rate = static_cast<double>(
+          totals[i].published - data.lastTotals[i].published) / seconds;
+      throughput = static_cast<double>(
+          totals[i].bytes - data.lastTotals[i].bytes) / seconds /
+          (1024.0 * 1024.0);
+      failures = totals[i].failures;
+    }
+
+    QVariantMap entry;
+    entry["topic"] = QString::fromStdString(stream.topic);
+    entry["rate"] = rate;
+    entry["targetRate"] = stream.rate;
+    entry["throughput"] = throughput;
+    entry["failures"] = static_cast<qulonglong>(failures);
+    data.trafficStats.append(entry);
+  }
+
+  data.lastTotals = std::move(totals);
+  data.lastTrafficUpdate = now;
+  this->TrafficChanged();
+}
+
+/////////////////////////////////////////////////
+int Publisher::TrafficStreamCount() const
+{
+  return static_cast<int>(this->dataPtr->trafficStreams.size());
+}
+
+/////////////////////////////////////////////////
+QVariantList Publisher::TrafficStats() const
+{
+  return this->dataPtr->trafficStats;
 }
 
 /////////////////////////////////////////////////
@@ -208,5 +435,4 @@ void Publisher::SetFrequency(const double _frequency)
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(Publisher,
-              gui::Plugin)
+GZ_GUI_ADD_PLUGIN(Publisher, "Publisher")
@@ -79,6 +79,8 @@ Rectangle {
     SpinBox {
       id: frequencyField
       value: 1.00
+      to: 100000
+      editable: true
 // why can't this be parsed?
 //      decimals: 2
 //      minimumValue: 0.0
@@ -102,5 +104,35 @@ Rectangle {
       ToolTip.timeout: tooltipTimeout
       ToolTip.text: checked ? qsTr("Stop publising") : qsTr("Start publishing")
     }
+
+    Label {
+      objectName: "achievedRate"
+      text: "Achieved: " + Publisher.achievedRate.toFixed(1) + " Hz"
+    }
+
+    Switch {
+      objectName: "trafficSwitch"
+      text: qsTr("Generate traffic")
+      visible: Publisher.trafficStreamCount > 0
+      onToggled: {
+        Publisher.OnTraffic(checked);
+      }
+      ToolTip.visible: hovered
+      ToolTip.delay: tooltipDelay
+      ToolTip.timeout: tooltipTimeout
+      ToolTip.text: qsTr("Publish all the streams of the configuration")
+    }
+
+    Repeater {
+      model: Publisher.trafficStats
+
+      Label {
+        text: modelData.topic + ": " + modelData.rate.toFixed(1) + " / " +
+            modelData.targetRate.toFixed(1) + " Hz, " +
+            modelData.throughput.toFixed(1) + " MiB/s" +
+            (modelData.failures > 0 ?
+            ", " + modelData.failures + " failed" : "")
+      }
+    }
   }
 }
@@ -16,6 +16,13 @@
 */
 
 #include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include <gz/msgs/image.pb.h>
 #include <gz/msgs/stringmsg.pb.h>
 
 #include <gz/transport/Node.hh>
@@ -251,3 +258,163 @@ TEST(PublisherTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(ParamsFromSDF))
   // Frequency
   EXPECT_DOUBLE_EQ(plugin->Frequency(), 0.1);
 }
+
+//////////////////////////////////////////////////
+TEST(PublisherTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(HighRate))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  const char *pluginStr =
+    "<plugin filename=\"Publisher\">"
+      "<topic>/high_rate</topic>"
+      "<frequency>1000</frequency>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+  EXPECT_TRUE(app.LoadPlugin("Publisher",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  auto plugins = win->findChildren<plugins::Publisher *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+
+  std::atomic<int> received{0};
+  std::function<void(const msgs::StringMsg &)> cb =
+      [&](const msgs::StringMsg &_msg)
+  {
+    EXPECT_EQ(_msg.data(), "Hello");
+    ++received;
+  };
+  transport::Node node;
+  node.Subscribe("/high_rate", cb);
+
+  EXPECT_DOUBLE_EQ(0.0, plugin->AchievedRate());
+  plugin->OnPublish(true);
+
+  // Published from its own thread, even while the GUI thread is blocked
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  EXPECT_GT(received, 100);
+
+  // The achieved rate is updated once per second
+  auto start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start <
+      std::chrono::milliseconds(1200))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    QCoreApplication::processEvents();
+  }
+  EXPECT_GT(plugin->AchievedRate(), 200.0);
+  EXPECT_LT(plugin->AchievedRate(), 1200.0);
+
+  plugin->OnPublish(false);
+  EXPECT_DOUBLE_EQ(0.0, plugin->AchievedRate());
+
+  int stopped = received;
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(stopped, received);
+}
+
+//////////////////////////////////////////////////
+TEST(PublisherTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Traffic))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  const char *pluginStr =
+    "<plugin filename=\"Publisher\">"
+      "<traffic>"
+        "<stream>"
+          "<topic>/traffic/image</topic>"
+          "<message_type>gz.msgs.Image</message_type>"
+          "<size>30000</size>"
+          "<rate>50</rate>"
+        "</stream>"
+        "<stream>"
+          "<topic>/traffic/string</topic>"
+          "<message_type>gz.msgs.StringMsg</message_type>"
+          "<message>data: \"load\"</message>"
+          "<rate>100</rate>"
+        "</stream>"
+        "<stream>"
+          "<topic>/traffic/invalid</topic>"
+          "<message_type>banana.message</message_type>"
+        "</stream>"
+      "</traffic>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+  EXPECT_TRUE(app.LoadPlugin("Publisher",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  auto plugins = win->findChildren<plugins::Publisher *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+
+  // The invalid stream is skipped
+  EXPECT_EQ(2, plugin->TrafficStreamCount());
+
+  std::atomic<int> images{0};
+  std::function<void(const msgs::Image &)> imageCb =
+      [&](const msgs::Image &_msg)
+  {
+    EXPECT_GE(_msg.data().size(), 30000u);
+    EXPECT_EQ(_msg.data().size(), _msg.step() * _msg.height());
+    ++images;
+  };
+  std::atomic<int> strings{0};
+  std::function<void(const msgs::StringMsg &)> stringCb =
+      [&](const msgs::StringMsg &_msg)
+  {
+    EXPECT_EQ(_msg.data(), "load");
+    ++strings;
+  };
+  transport::Node node;
+  node.Subscribe("/traffic/image", imageCb);
+  node.Subscribe("/traffic/string", stringCb);
+
+  plugin->OnTraffic(true);
+
+  auto start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start <
+      std::chrono::milliseconds(1200))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    QCoreApplication::processEvents();
+  }
+  EXPECT_GT(images, 20);
+  EXPECT_GT(strings, 40);
+
+  auto stats = plugin->TrafficStats();
+  ASSERT_EQ(2, stats.size());
+  auto image = stats[0].toMap();
+  EXPECT_EQ("/traffic/image", image["topic"].toString());
+  EXPECT_GT(image["rate"].toDouble(), 20.0);
+  EXPECT_DOUBLE_EQ(50.0, image["targetRate"].toDouble());
+  EXPECT_GT(image["throughput"].toDouble(), 0.5);
+  EXPECT_EQ(0u, image["failures"].toULongLong());
+  auto string = stats[1].toMap();
+  EXPECT_EQ("/traffic/string", string["topic"].toString());
+  EXPECT_GT(string["rate"].toDouble(), 40.0);
+
+  plugin->OnTraffic(false);
+  stats = plugin->TrafficStats();
+  ASSERT_EQ(2, stats.size());
+  EXPECT_DOUBLE_EQ(0.0, stats[0].toMap()["rate"].toDouble());
+
+  int stopped = images;
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(stopped, images);
+}
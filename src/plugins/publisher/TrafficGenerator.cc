@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/msgs/image.pb.h>
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/msgs/Utility.hh>
+#include <gz/transport/Node.hh>
+
+#include "TrafficGenerator.hh"
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief State of a stream being published
+  struct StreamState
+  {
+    /// \brief Stream
+    TrafficGenerator::Stream stream;
+
+    /// \brief Publisher
+    transport::Node::Publisher pub;
+
+    /// \brief Time between messages
+    std::chrono::steady_clock::duration period;
+
+    /// \brief Next deadline
+    std::chrono::steady_clock::time_point next;
+
+    /// \brief Number of messages published
+    std::atomic<uint64_t> published{0u};
+
+    /// \brief Number of messages which failed to be published
+    std::atomic<uint64_t> failures{0u};
+  };
+
+  class TrafficGeneratorPrivate
+  {
+    /// \brief Publish the streams until stopped. Runs on the thread.
+    public: void Run();
+
+    /// \brief Node to advertise the topics
+    public: transport::Node node;
+
+    /// \brief Streams being published. Only modified while the thread
+    /// isn't running.
+    public: std::vector<std::unique_ptr<StreamState>> streams;
+
+    /// \brief Thread publishing the streams
+    public: std::thread thread;
+
+    /// \brief Protects stop
+    public: std::mutex mutex;
+
+    /// \brief Wakes the thread to stop
+    public: std::condition_variable cv;
+
+    /// \brief True to stop the thread
+    public: bool stop{false};
+  };
+}
+}
+}
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+void TrafficGeneratorPrivate::Run()
+{
+  using Clock = std::chrono::steady_clock;
+
+  auto now = Clock::now();
+  for (auto &state : this->streams)
+    state->next = now;
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (!this->stop)
+  {
+    // The stream due first
+    auto due = std::min_element(this->streams.begin(), this->streams.end(),
+        [](const std::unique_ptr<StreamState> &_a,
+           const std::unique_ptr<StreamState> &_b)
+        {
+          return _a->next < _b->next;
+        });
+    auto &state = **due;
+
+    if (this->cv.wait_until(lock, state.next, [this]{return this->stop;}))
+      break;
+
+    lock.unlock();
+    if (state.pub.PublishRaw(state.stream.payload, state.stream.msgType))
+      ++state.published;
+    else
+      ++state.failures;
+    lock.lock();
+
+    // When too far behind, the schedule restarts rather than catching up
+    // in a burst
+    state.next += state.period;
+    now = Clock::now();
+    if (state.next + state.period < now)
+      state.next = now;
+  }
+}
+
+/////////////////////////////////////////////////
+bool TrafficGenerator::LoadStream(const tinyxml2::XMLElement *_elem,
+    Stream &_stream)
+{
+  if (nullptr == _elem)
+    return false;
+
+  auto topicElem = _elem->FirstChildElement("topic");
+  auto typeElem = _elem->FirstChildElement("message_type");
+  if (nullptr == topicElem || nullptr == topicElem->GetText() ||
+      nullptr == typeElem || nullptr == typeElem->GetText())
+  {
+    gzerr << "Traffic streams need a <topic> and a <message_type>"
+          << std::endl;
+    return false;
+  }
+  _stream.topic = topicElem->GetText();
+  _stream.msgType = typeElem->GetText();
+
+  _stream.rate = 1.0;
+  if (auto rateElem = _elem->FirstChildElement("rate"))
+    rateElem->QueryDoubleText(&_stream.rate);
+  if (_stream.rate <= 0.0)
+  {
+    gzerr << "Invalid <rate> for traffic stream [" << _stream.topic << "]"
+          << std::endl;
+    return false;
+  }
+
+  uint64_t size{0u};
+  if (auto sizeElem = _elem->FirstChildElement("size"))
+    sizeElem->QueryUnsigned64Text(&size);
+
+  // Large sensor messages are generated from their size
+  if (size > 0u && _stream.msgType == "gz.msgs.Image")
+  {
+    // A square RGB image of about the size
+    auto side = static_cast<uint32_t>(std::max(1.0,
+        std::ceil(std::sqrt(static_cast<double>(size) / 3.0))));
+    msgs::Image msg;
+    msg.set_width(side);
+    msg.set_height(side);
+    msg.set_step(side * 3u);
+    msg.set_pixel_format_type(msgs::PixelFormatType::RGB_INT8);
+    msg.set_data(std::string(static_cast<std::size_t>(side) * side * 3u,
+        '\x80'));
+    _stream.payload = msg.SerializeAsString();
+    return true;
+  }
+
+  if (size > 0u && _stream.msgType == "gz.msgs.PointCloudPacked")
+  {
+    // Points with 3 floats each, all at the origin
+    constexpr uint32_t kPointStep{12u};
+    auto points = static_cast<uint32_t>(std::max<uint64_t>(1u,
+        size / kPointStep));
+    msgs::PointCloudPacked msg;
+    const char *names[] = {"x", "y", "z"};
+    for (uint32_t i = 0; i < 3u; ++i)
+    {
+      auto field = msg.add_field();
+      field->set_name(names[i]);
+      field->set_offset(i * 4u);
+      field->set_datatype(msgs::PointCloudPacked::Field::FLOAT32);
+      field->set_count(1u);
+    }
+    msg.set_width(points);
+    msg.set_height(1u);
+    msg.set_point_step(kPointStep);
+    msg.set_row_step(points * kPointStep);
+    msg.set_is_dense(true);
+    msg.set_data(std::string(static_cast<std::size_t>(points) * kPointStep,
+        '\0'));
+    _stream.payload = msg.SerializeAsString();
+    return true;
+  }
+
+  if (size > 0u)
+  {
+    gzwarn << "<size> is only supported for gz.msgs.Image and "
+           << "gz.msgs.PointCloudPacked, ignoring it for ["
+           << _stream.topic << "]" << std::endl;
+  }
+
+  std::string data;
+  auto msgElem = _elem->FirstChildElement("message");
+  if (nullptr != msgElem && nullptr != msgElem->GetText())
+    data = msgElem->GetText();
+
+  auto msg = msgs::Factory::New(_stream.msgType, data);
+  if (!msg)
+  {
+    gzerr << "Unable to create message of type[" << _stream.msgType
+          << "] with data[" << data << "]." << std::endl;
+    return false;
+  }
+  _stream.payload = msg->SerializeAsString();
+  return true;
+}
+
+/////////////////////////////////////////////////
+TrafficGenerator::TrafficGenerator()
+  : dataPtr(std::make_unique<TrafficGeneratorPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+TrafficGenerator::~TrafficGenerator()
+{
+  this->Stop();
+}
+
+/////////////////////////////////////////////////
+bool TrafficGenerator::Start(const std::vector<Stream> &_streams)
+{
+  this->Stop();
+  this->dataPtr->streams.clear();
+
+  for (const auto &stream : _streams)
+  {
+    auto state = std::make_unique<StreamState>();
+    state->stream = stream;
+    state->period = std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / stream.rate));
+    state->pub = this->dataPtr->node.Advertise(stream.topic,
+        stream.msgType);
+    if (!state->pub)
+    {
+      gzerr << "Unable to publish on topic[" << stream.topic << "] "
+            << "with message type[" << stream.msgType << "]." << std::endl;
+      this->dataPtr->streams.clear();
+      return false;
+    }
+    this->dataPtr->streams.push_back(std::move(state));
+  }
+
+  if (this->dataPtr->streams.empty())
+    return false;
+
+  this->dataPtr->thread =
+      std::thread(&TrafficGeneratorPrivate::Run, this->dataPtr.get());
+  return true;
+}
+
+/////////////////////////////////////////////////
+void TrafficGenerator::Stop()
+{
+  if (!this->dataPtr->thread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->cv.notify_all();
+  this->dataPtr->thread.join();
+  this->dataPtr->stop = false;
+}
+
+/////////////////////////////////////////////////
+bool TrafficGenerator::Running() const
+{
+  return this->dataPtr->thread.joinable();
+}
+
+/////////////////////////////////////////////////
+std::vector<TrafficGenerator::Counters> TrafficGenerator::Totals() const
+{
+  std::vector<Counters> totals;
+  totals.reserve(this->dataPtr->streams.size());
+  for (const auto &state : this->dataPtr->streams)
+  {
+    Counters counters;
+    counters.topic = state->stream.topic;
+    counters.published = state->published;
+    counters.failures = state->failures;
+    counters.bytes = counters.published * state->stream.payload.size();
+    totals.push_back(counters);
+  }
+  return totals;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_PUBLISHER_TRAFFICGENERATOR_HH_
+#define GZ_GUI_PLUGINS_PUBLISHER_TRAFFICGENERATOR_HH_
+
+#include <tinyxml2.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  class TrafficGeneratorPrivate;
+
+  /// \brief Publishes several topics at fixed rates, to load the transport
+  /// and the plugins subscribed to it from inside the GUI process.
+  ///
+  /// Each message is serialized once when the stream is loaded, and the
+  /// same buffer is published every time, so the cost measured is the
+  /// transport's and the subscribers', not the generator's. All streams
+  /// are published from a single thread.
+  class TrafficGenerator
+  {
+    /// \brief A topic to publish
+    public: struct Stream
+    {
+      /// \brief Topic name
+      std::string topic;
+
+      /// \brief Message type, such as gz.msgs.Image
+      std::string msgType;
+
+      /// \brief Serialized message
+      std::string payload;
+
+      /// \brief Rate in Hz
+      double rate{1.0};
+    };
+
+    /// \brief What a stream published since it started
+    public: struct Counters
+    {
+      /// \brief Topic name
+      std::string topic;
+
+      /// \brief Number of messages published
+      uint64_t published{0u};
+
+      /// \brief Number of messages which failed to be published
+      uint64_t failures{0u};
+
+      /// \brief Number of bytes published
+      uint64_t bytes{0u};
+    };
+
+    /// \brief Load a stream from a `<stream>` element, with `<topic>`,
+    /// `<message_type>`, `<rate>` in Hz, and either `<size>` in bytes for
+    /// gz.msgs.Image and gz.msgs.PointCloudPacked, whose contents are
+    /// generated, or `<message>` in Protobuf text format for any type.
+    /// \param[in] _elem Stream element
+    /// \param[out] _stream Loaded stream
+    /// \return True if it's valid
+    public: static bool LoadStream(const tinyxml2::XMLElement *_elem,
+        Stream &_stream);
+
+    /// \brief Constructor
+    public: TrafficGenerator();
+
+    /// \brief Destructor, stops publishing
+    public: ~TrafficGenerator();
+
+    /// \brief Advertise the streams and start publishing them. Streams
+    /// being published are stopped first.
+    /// \param[in] _streams Streams to publish
+    /// \return False if a topic couldn't be advertised, then nothing is
+    /// published
+    public: bool Start(const std::vector<Stream> &_streams);
+
+    /// \brief Stop publishing, and wait for the thread
+    public: void Stop();
+
+    /// \brief Get whether streams are being published
+    /// \return True between Start and Stop
+    public: bool Running() const;
+
+    /// \brief Get what each stream published since Start. Safe to call
+    /// while publishing.
+    /// \return Counters per stream, in the order given to Start
+    public: std::vector<Counters> Totals() const;
+
+    /// \internal
+    /// \brief Private data pointer
+    private: std::unique_ptr<TrafficGeneratorPrivate> dataPtr;
+  };
+}
+}
+}
+
+#endif
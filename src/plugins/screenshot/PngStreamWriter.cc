@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "PngStreamWriter.hh"
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+namespace
+{
+  /// \brief Largest stored deflate block
+  constexpr std::size_t kMaxBlock{65535u};
+
+  /// \brief IDAT chunks are written once they reach this size
+  constexpr std::size_t kChunkSize{1u << 20};
+
+  /// \brief Adler-32 modulus
+  constexpr uint32_t kAdlerBase{65521u};
+
+  /////////////////////////////////////////////////
+  /// \brief CRC-32 table of the PNG specification
+  const std::array<uint32_t, 256> &crcTable()
+  {
+    static const auto table = []()
+    {
+      std::array<uint32_t, 256> t{};
+      for (uint32_t n = 0; n < 256; ++n)
+      {
+        uint32_t c = n;
+        for (int k = 0; k < 8; ++k)
+          c = (c & 1u) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+        t[n] = c;
+      }
+      return t;
+    }();
+    return table;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Continue a CRC-32 over more data
+  uint32_t crc(uint32_t _crc, const char *_data, std::size_t _size)
+  {
+    const auto &table = crcTable();
+    for (std::size_t i = 0; i < _size; ++i)
+    {
+      _crc = table[(_crc ^ static_cast<unsigned char>(_data[i])) & 0xffu] ^
+          (_crc >> 8);
+    }
+    return _crc;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Append a big endian 32 bit value
+  void appendBE(std::string &_out, uint32_t _value)
+  {
+    _out += static_cast<char>((_value >> 24) & 0xffu);
+    _out += static_cast<char>((_value >> 16) & 0xffu);
+    _out += static_cast<char>((_value >> 8) & 0xffu);
+    _out += static_cast<char>(_value & 0xffu);
+  }
+}
+
+/////////////////////////////////////////////////
+PngStreamWriter::~PngStreamWriter()
+{
+  if (this->file.is_open())
+    this->Close();
+}
+
+/////////////////////////////////////////////////
+bool PngStreamWriter::Open(const std::string &_path, unsigned int _width,
+    unsigned int _height)
+{
+  if (_width == 0u || _height == 0u)
+    return false;
+
+  this->file.open(_path, std::ios::binary | std::ios::trunc);
+  if (!this->file.is_open())
+    return false;
+
+  this->width = _width;
+  this->height = _height;
+  this->rows = 0u;
+  this->adlerA = 1u;
+  this->adlerB = 0u;
+  this->idat.clear();
+
+  static const char kSignature[] = "\x89PNG\r\n\x1a\n";
+  this->file.write(kSignature, 8);
+
+  // 8 bit RGB, no interlacing
+  std::string header;
+  appendBE(header, _width);
+  appendBE(header, _height);
+  header += std::string("\x08\x02\x00\x00\x00", 5);
+  this->WriteChunk("IHDR", header);
+
+  // zlib header, deflate with a 32K window and no preset dictionary
+  this->idat += "\x78\x01";
+  return this->file.good();
+}
+
+/////////////////////////////////////////////////
+bool PngStreamWriter::WriteRow(const unsigned char *_rgb)
+{
+  if (!this->file.is_open() || this->rows >= this->height)
+    return false;
+
+  // Filter type 0, the row is stored as is
+  const unsigned char filter{0u};
+  this->Store(&filter, 1u);
+  this->Store(_rgb, static_cast<std::size_t>(this->width) * 3u);
+  ++this->rows;
+
+  if (this->idat.size() >= kChunkSize)
+  {
+    this->WriteChunk("IDAT", this->idat);
+    this->idat.clear();
+  }
+  return this->file.good();
+}
+
+/////////////////////////////////////////////////
+bool PngStreamWriter::Close()
+{
+  if (!this->file.is_open())
+    return false;
+
+  bool complete = this->rows == this->height;
+  if (!complete)
+  {
+    std::vector<unsigned char> black(
+        static_cast<std::size_t>(this->width) * 3u, 0u);
+    while (this->rows < this->height)
+      this->WriteRow(black.data());
+  }
+
+  // Empty final block, since the last row isn't known to be last when
+  // it's stored
+  this->idat += std::string("\x01\x00\x00\xff\xff", 5);
+  appendBE(this->idat, (this->adlerB << 16) | this->adlerA);
+  this->WriteChunk("IDAT", this->idat);
+  this->idat.clear();
+  this->WriteChunk("IEND", std::string());
+
+  bool ok = this->file.good();
+  this->file.close();
+  return ok && complete;
+}
+
+/////////////////////////////////////////////////
+void PngStreamWriter::Store(const unsigned char *_data, std::size_t _size)
+{
+  for (std::size_t i = 0; i < _size; ++i)
+  {
+    this->adlerA = (this->adlerA + _data[i]) % kAdlerBase;
+    this->adlerB = (this->adlerB + this->adlerA) % kAdlerBase;
+  }
+
+  while (_size > 0u)
+  {
+    auto size = std::min(_size, kMaxBlock);
+    auto len = static_cast<uint16_t>(size);
+    auto nlen = static_cast<uint16_t>(~len);
+
+    // Not final, stored
+    this->idat += '\x00';
+    this->idat += static_cast<char>(len & 0xffu);
+    this->idat += static_cast<char>(len >> 8);
+    this->idat += static_cast<char>(nlen & 0xffu);
+    this->idat += static_cast<char>(nlen >> 8);
+    this->idat.append(reinterpret_cast<const char *>(_data), size);
+
+    _data += size;
+    _size -= size;
+  }
+}
+
+/////////////////////////////////////////////////
+void PngStreamWriter::WriteChunk(const char *_type, const std::string &_data)
+{
+  std::string length;
+  appendBE(length, static_cast<uint32_t>(_data.size()));
+  this->file.write(length.data(), 4);
+  this->file.write(_type, 4);
+  this->file.write(_data.data(), static_cast<std::streamsize>(_data.size()));
+
+  auto c = crc(0xffffffffu, _type, 4u);
+  c = crc(c, _data.data(), _data.size());
+  std::string footer;
+  appendBE(footer, c ^ 0xffffffffu);
+  this->file.write(footer.data(), 4);
+}
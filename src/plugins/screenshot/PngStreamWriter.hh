@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_SCREENSHOT_PNGSTREAMWRITER_HH_
+#define GZ_GUI_PLUGINS_SCREENSHOT_PNGSTREAMWRITER_HH_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Writes an 8-bit RGB PNG one row at a time, so images much
+  /// larger than what fits in memory can be saved while they're rendered.
+  ///
+  /// The pixels are stored without compression, which needs no zlib and
+  /// takes no time, at the cost of a file as large as the raw image. It can
+  /// be recompressed afterwards by any image tool.
+  class PngStreamWriter
+  {
+    /// \brief Destructor, closes the file if it's still open
+    public: ~PngStreamWriter();
+
+    /// \brief Create the file and write the header.
+    /// \param[in] _path File to write
+    /// \param[in] _width Image width in pixels
+    /// \param[in] _height Image height in pixels
+    /// \return False if the file couldn't be created
+    public: bool Open(const std::string &_path, unsigned int _width,
+                      unsigned int _height);
+
+    /// \brief Write the next row, from the top.
+    /// \param[in] _rgb Width * 3 bytes
+    /// \return False if the file isn't open, has all its rows or failed to
+    /// be written
+    public: bool WriteRow(const unsigned char *_rgb);
+
+    /// \brief Finish the file. Missing rows are written black.
+    /// \return True if the whole file was written
+    public: bool Close();
+
+    /// \brief Append stored deflate blocks with data to idat
+    /// \param[in] _data Bytes to store
+    /// \param[in] _size Number of bytes
+    private: void Store(const unsigned char *_data, std::size_t _size);
+
+    /// \brief Write a chunk to the file
+    /// \param[in] _type Four letter chunk type
+    /// \param[in] _data Chunk data
+    private: void WriteChunk(const char *_type, const std::string &_data);
+
+    /// \brief File being written
+    private: std::ofstream file;
+
+    /// \brief Image width in pixels
+    private: unsigned int width{0u};
+
+    /// \brief Image height in pixels
+    private: unsigned int height{0u};
+
+    /// \brief Rows written so far
+    private: unsigned int rows{0u};
+
+    /// \brief Running Adler-32 sums of the uncompressed data
+    private: uint32_t adlerA{1u};
+
+    /// \brief See adlerA
+    private: uint32_t adlerB{0u};
+
+    /// \brief Data of the next IDAT chunk, written once it's large enough
+    private: std::string idat;
+  };
+}
+}
+}
+
+#endif
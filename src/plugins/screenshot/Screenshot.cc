@@ -16,11 +16,30 @@
 */
 #include "Screenshot.hh"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gz/msgs/Utility.hh>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Filesystem.hh>
 #include <gz/common/Image.hh>
+#include <gz/math/Matrix4.hh>
+#include <gz/math/Pose3.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/rendering/Camera.hh>
 #include <gz/rendering/RenderEngine.hh>
@@ -31,6 +50,23 @@
 #include "gz/gui/Application.hh"
 #include "gz/gui/GuiEvents.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/StaticPlugins.hh"
+
+#include "PngStreamWriter.hh"
+
+/// \brief Time the batch service waits for its images to be written
+static constexpr std::chrono::seconds kBatchTimeout{60};
+
+/// \brief Time the tiled service waits for its image to be written
+static constexpr std::chrono::minutes kTiledTimeout{10};
+
+/// \brief Default size of the tiles of tiled screenshots, which every
+/// render engine supports as a texture size
+static constexpr unsigned int kDefaultTileSize{2048u};
+
+/// \brief Rows of tiles rendered ahead of the one being written, which
+/// bounds the memory of tiled screenshots
+static constexpr unsigned int kMaxQueuedTileRows{2u};
 
 namespace gz
 {
@@ -38,8 +74,178 @@ namespace gui
 {
 namespace plugins
 {
+  /// \brief Views requested through the batch service
+  struct ScreenshotBatch
+  {
+    /// \brief Camera poses, in the world frame
+    std::vector<math::Pose3d> poses;
+
+    /// \brief Image width, 0 for the user camera's
+    unsigned int width{0u};
+
+    /// \brief Image height, 0 for the user camera's
+    unsigned int height{0u};
+
+    /// \brief Directory to save the images to
+    std::string directory;
+
+    /// \brief Files written, filled on the render thread
+    std::vector<std::string> paths;
+
+    /// \brief Number of images not written yet
+    std::atomic<std::size_t> remaining{0u};
+
+    /// \brief False if an image failed to be written
+    std::atomic<bool> ok{true};
+
+    /// \brief Set once all the images are written, or on failure
+    std::promise<bool> done;
+  };
+
+  /// \brief A screenshot larger than the user camera can render, rendered
+  /// one row of tiles per frame and streamed to disk
+  struct TiledScreenshot
+  {
+    /// \brief Image width
+    unsigned int width{0u};
+
+    /// \brief Image height
+    unsigned int height{0u};
+
+    /// \brief Largest tile width and height
+    unsigned int tileSize{kDefaultTileSize};
+
+    /// \brief Tile width, the last column is cropped
+    unsigned int tileWidth{0u};
+
+    /// \brief Tile height, the last row is cropped
+    unsigned int tileHeight{0u};
+
+    /// \brief Number of tile columns
+    unsigned int columns{0u};
+
+    /// \brief Number of tile rows
+    unsigned int tileRows{0u};
+
+    /// \brief File to write to
+    std::string path;
+
+    /// \brief Pose of the user camera when the first row was rendered, so
+    /// the tiles match even if it moves
+    math::Pose3d pose;
+
+    /// \brief Half the width and height of the view frustum at the near
+    /// plane
+    double halfWidth{0.0};
+
+    /// \brief See halfWidth
+    double halfHeight{0.0};
+
+    /// \brief Near clip plane
+    double nearClip{0.0};
+
+    /// \brief Far clip plane
+    double farClip{0.0};
+
+    /// \brief Offscreen camera rendering the tiles, on the render thread
+    rendering::CameraPtr camera;
+
+    /// \brief Next row of tiles to render, on the render thread
+    unsigned int nextRow{0u};
+
+    /// \brief Rows of tiles rendered but not written yet
+    std::atomic<unsigned int> queuedRows{0u};
+
+    /// \brief Protects writer and writtenRows
+    std::mutex mutex;
+
+    /// \brief Notified when a row of tiles is written
+    std::condition_variable writtenCv;
+
+    /// \brief Rows of tiles written, in order
+    unsigned int writtenRows{0u};
+
+    /// \brief Streams the stitched rows to the file
+    PngStreamWriter writer;
+
+    /// \brief False if the image failed to be rendered or written
+    std::atomic<bool> ok{true};
+
+    /// \brief True once done is set
+    std::atomic<bool> finished{false};
+
+    /// \brief Set once the image is written, or on failure
+    std::promise<bool> done;
+
+    /// \brief Set done, unless it was already
+    /// \param[in] _ok Result
+    void Finish(bool _ok)
+    {
+      if (!this->finished.exchange(true))
+        this->done.set_value(_ok);
+    }
+  };
+
+  /// \brief An image copied from the camera, waiting to be written
+  struct ScreenshotJob
+  {
+    /// \brief Pixels copied from the camera
+    rendering::Image image;
+
+    /// \brief Image width
+    unsigned int width{0u};
+
+    /// \brief Image height
+    unsigned int height{0u};
+
+    /// \brief Pixel format
+    common::Image::PixelFormatType format{common::Image::UNKNOWN_PIXEL_FORMAT};
+
+    /// \brief File to write to
+    std::string path;
+
+    /// \brief Batch the image belongs to, null for single screenshots
+    std::shared_ptr<ScreenshotBatch> batch;
+
+    /// \brief Tiled screenshot a row of tiles belongs to, the tiles are
+    /// in tiles rather than image
+    std::shared_ptr<TiledScreenshot> tiled;
+
+    /// \brief Row of tiles of tiled
+    unsigned int tileRow{0u};
+
+    /// \brief Tiles of the row, from the left
+    std::vector<rendering::Image> tiles;
+  };
+
   class ScreenshotPrivate
   {
+    /// \brief Encode and write the queued images until stopped
+    public: void ProcessWorker();
+
+    /// \brief Render the views of a batch with an offscreen camera and
+    /// queue their images, on the render thread
+    /// \param[in] _batch Batch to render
+    public: void RenderBatch(const std::shared_ptr<ScreenshotBatch> &_batch);
+
+    /// \brief Render the next row of tiles of a tiled screenshot and queue
+    /// it, on the render thread
+    /// \param[in] _tiled Screenshot to render
+    /// \return True once all its rows are queued, or on failure
+    public: bool RenderTileRow(const std::shared_ptr<TiledScreenshot> &_tiled);
+
+    /// \brief Stitch a row of tiles and stream its pixel rows to the file,
+    /// after the previous row of tiles, on a worker
+    /// \param[in] _job Row of tiles
+    public: void WriteTileRow(ScreenshotJob &_job);
+
+    /// \brief Ask for a frame to be rendered, even if the scene is idle
+    public: void RequestFrame();
+
+    /// \brief Queue a job for the workers
+    /// \param[in] _job Job to queue
+    public: void QueueJob(ScreenshotJob &&_job);
+
     /// \brief Node for communication
     public: gz::transport::Node node;
 
@@ -50,13 +256,53 @@ namespace plugins
     public: std::string directory;
 
     /// \brief Whether a screenshot has been requested but not processed yet.
-    public: bool dirty{false};
+    /// Set from the GUI and service threads, read on the render thread.
+    public: std::atomic<bool> dirty{false};
+
+    /// \brief Protects batches
+    public: std::mutex batchMutex;
+
+    /// \brief Batches waiting to be rendered
+    public: std::deque<std::shared_ptr<ScreenshotBatch>> batches;
+
+    /// \brief True if batches isn't empty, checked on every frame
+    public: std::atomic<bool> hasBatches{false};
+
+    /// \brief Protects tiled
+    public: std::mutex tiledMutex;
+
+    /// \brief Tiled screenshots waiting to be rendered, the first one
+    /// is being rendered
+    public: std::deque<std::shared_ptr<TiledScreenshot>> tiled;
+
+    /// \brief True if tiled isn't empty, checked on every frame
+    public: std::atomic<bool> hasTiled{false};
 
     /// \brief Pointer to the user camera.
     public: gz::rendering::CameraPtr userCamera{nullptr};
 
     /// \brief Saved screenshot filepath
     public: QString savedScreenshotPath = "";
+
+    /// \brief Called by the worker once an image is written
+    public: std::function<void(const std::string &)> onSaved;
+
+    /// \brief Protects the jobs and stopWorker
+    public: std::mutex mutex;
+
+    /// \brief Images waiting to be written
+    public: std::deque<ScreenshotJob> jobs;
+
+    /// \brief Notified when a job is queued or the worker should stop
+    public: std::condition_variable workerCv;
+
+    /// \brief True to stop the worker once the queued images are written
+    public: bool stopWorker{false};
+
+    /// \brief Threads encoding and writing the images, so the render
+    /// thread only waits for the copy, and the images of a batch are
+    /// written in parallel
+    public: std::vector<std::thread> workers;
   };
 }
 }
@@ -92,10 +338,59 @@ Screenshot::Screenshot()
   }
 
   this->DirectoryChanged();
+
+  // Images are written on the worker, but the GUI is notified on the main
+  // thread
+  this->dataPtr->onSaved = [this](const std::string &_path)
+  {
+    QMetaObject::invokeMethod(this, [this, _path]
+    {
+      this->SetSavedScreenshotPath(QString::fromStdString(_path));
+      App()->findChild<MainWindow *>()->notifyWithDuration(
+          QString::fromStdString("Saved image to: <b>" + _path + "</b>"),
+          4000);
+    }, Qt::QueuedConnection);
+  };
+  auto workerCount = std::clamp(std::thread::hardware_concurrency(), 1u, 4u);
+  for (unsigned int i = 0; i < workerCount; ++i)
+  {
+    this->dataPtr->workers.emplace_back(&ScreenshotPrivate::ProcessWorker,
+        this->dataPtr.get());
+  }
 }
 
 /////////////////////////////////////////////////
-Screenshot::~Screenshot() = default;
+Screenshot::~Screenshot()
+{
+  // Batches which weren't rendered fail right away, rather than keeping
+  // their requests waiting
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->batchMutex);
+    for (auto &batch : this->dataPtr->batches)
+      batch->done.set_value(false);
+    this->dataPtr->batches.clear();
+    this->dataPtr->hasBatches = false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->tiledMutex);
+    for (auto &tiled : this->dataPtr->tiled)
+      tiled->Finish(false);
+    this->dataPtr->tiled.clear();
+    this->dataPtr->hasTiled = false;
+  }
+
+  // Screenshots already taken are still written
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stopWorker = true;
+  }
+  this->dataPtr->workerCv.notify_all();
+  for (auto &worker : this->dataPtr->workers)
+  {
+    if (worker.joinable())
+      worker.join();
+  }
+}
 
 /////////////////////////////////////////////////
 void Screenshot::LoadConfig(const tinyxml2::XMLElement *)
@@ -110,15 +405,68 @@ void Screenshot::LoadConfig(const tinyxml2::XMLElement *)
   gzmsg << "Screenshot service on ["
          << this->dataPtr->screenshotService << "]" << std::endl;
 
-  App()->findChild<MainWindow *>()->installEventFilter(this);
+  auto batchService = this->dataPtr->screenshotService + "/batch";
+  this->dataPtr->node.Advertise(batchService,
+      &Screenshot::BatchScreenshotService, this);
+  gzmsg << "Batch screenshot service on [" << batchService << "]"
+        << std::endl;
+
+  auto tiledService = this->dataPtr->screenshotService + "/tiled";
+  this->dataPtr->node.Advertise(tiledService,
+      &Screenshot::TiledScreenshotService, this);
+  gzmsg << "Tiled screenshot service on [" << tiledService << "]"
+        << std::endl;
+
+  App()->findChild<MainWindow *>()->SubscribeEvent(events::Render::kType,
+      this);
 }
 
 /////////////////////////////////////////////////
 bool Screenshot::eventFilter(QObject *_obj, QEvent *_event)
 {
-  if (_event->type() == events::Render::kType && this->dataPtr->dirty)
+  if (_event->type() == events::Render::kType)
   {
-    this->SaveScreenshot();
+    if (this->dataPtr->dirty)
+      this->SaveScreenshot();
+
+    while (this->dataPtr->hasBatches)
+    {
+      std::shared_ptr<ScreenshotBatch> batch;
+      {
+        std::lock_guard<std::mutex> lock(this->dataPtr->batchMutex);
+        if (this->dataPtr->batches.empty())
+          break;
+        batch = this->dataPtr->batches.front();
+        this->dataPtr->batches.pop_front();
+        this->dataPtr->hasBatches = !this->dataPtr->batches.empty();
+      }
+      this->FindUserCamera();
+      this->dataPtr->RenderBatch(batch);
+    }
+
+    // A row of tiles per frame, so the GUI stays responsive
+    if (this->dataPtr->hasTiled)
+    {
+      std::shared_ptr<TiledScreenshot> tiled;
+      {
+        std::lock_guard<std::mutex> lock(this->dataPtr->tiledMutex);
+        if (!this->dataPtr->tiled.empty())
+          tiled = this->dataPtr->tiled.front();
+      }
+      this->FindUserCamera();
+      if (tiled && this->dataPtr->RenderTileRow(tiled))
+      {
+        std::lock_guard<std::mutex> lock(this->dataPtr->tiledMutex);
+        if (!this->dataPtr->tiled.empty() &&
+            this->dataPtr->tiled.front() == tiled)
+        {
+          this->dataPtr->tiled.pop_front();
+        }
+        this->dataPtr->hasTiled = !this->dataPtr->tiled.empty();
+      }
+      if (this->dataPtr->hasTiled)
+        this->dataPtr->RequestFrame();
+    }
   }
 
   // Standard event processing
@@ -136,6 +484,370 @@ bool Screenshot::ScreenshotService(const msgs::StringMsg &_msg,
   return true;
 }
 
+/////////////////////////////////////////////////
+bool Screenshot::BatchScreenshotService(const msgs::Pose_V &_msg,
+    msgs::StringMsg_V &_res)
+{
+  auto batch = std::make_shared<ScreenshotBatch>();
+  batch->directory = this->dataPtr->directory;
+  for (const auto &data : _msg.header().data())
+  {
+    if (data.value_size() == 0)
+      continue;
+    if (data.key() == "width")
+      batch->width = std::strtoul(data.value(0).c_str(), nullptr, 10);
+    else if (data.key() == "height")
+      batch->height = std::strtoul(data.value(0).c_str(), nullptr, 10);
+    else if (data.key() == "directory")
+      batch->directory = data.value(0);
+  }
+  for (const auto &pose : _msg.pose())
+    batch->poses.push_back(msgs::Convert(pose));
+
+  if (batch->poses.empty())
+    return true;
+
+  if (!common::exists(batch->directory) &&
+      !common::createDirectories(batch->directory))
+  {
+    gzerr << "Unable to create directory [" << batch->directory << "]"
+          << std::endl;
+    return false;
+  }
+
+  auto done = batch->done.get_future();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->batchMutex);
+    this->dataPtr->batches.push_back(batch);
+    this->dataPtr->hasBatches = true;
+  }
+
+  this->dataPtr->RequestFrame();
+
+  if (done.wait_for(kBatchTimeout) != std::future_status::ready)
+  {
+    gzerr << "Timed out waiting for " << batch->poses.size()
+          << " screenshots" << std::endl;
+    return false;
+  }
+
+  for (const auto &path : batch->paths)
+    _res.add_data(path);
+  return done.get();
+}
+
+/////////////////////////////////////////////////
+bool Screenshot::TiledScreenshotService(const msgs::StringMsg &_msg,
+    msgs::StringMsg &_res)
+{
+  auto tiled = std::make_shared<TiledScreenshot>();
+  std::string directory = _msg.data().empty() ?
+      this->dataPtr->directory : _msg.data();
+  for (const auto &data : _msg.header().data())
+  {
+    if (data.value_size() == 0)
+      continue;
+    if (data.key() == "width")
+      tiled->width = std::strtoul(data.value(0).c_str(), nullptr, 10);
+    else if (data.key() == "height")
+      tiled->height = std::strtoul(data.value(0).c_str(), nullptr, 10);
+    else if (data.key() == "tile_size")
+      tiled->tileSize = std::strtoul(data.value(0).c_str(), nullptr, 10);
+  }
+
+  if (tiled->width == 0u || tiled->height == 0u || tiled->tileSize == 0u)
+  {
+    gzerr << "Tiled screenshots need a width, a height and a tile size "
+          << "larger than 0" << std::endl;
+    return false;
+  }
+
+  if (!common::exists(directory) && !common::createDirectories(directory))
+  {
+    gzerr << "Unable to create directory [" << directory << "]"
+          << std::endl;
+    return false;
+  }
+
+  // Equal tiles, the ones past the right and bottom edges are cropped
+  tiled->columns = (tiled->width + tiled->tileSize - 1u) / tiled->tileSize;
+  tiled->tileRows = (tiled->height + tiled->tileSize - 1u) /
+      tiled->tileSize;
+  tiled->tileWidth = (tiled->width + tiled->columns - 1u) / tiled->columns;
+  tiled->tileHeight = (tiled->height + tiled->tileRows - 1u) /
+      tiled->tileRows;
+  tiled->path = common::joinPaths(directory,
+      common::systemTimeISO() + "_tiled.png");
+
+  auto done = tiled->done.get_future();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->tiledMutex);
+    this->dataPtr->tiled.push_back(tiled);
+    this->dataPtr->hasTiled = true;
+  }
+  this->dataPtr->RequestFrame();
+
+  if (done.wait_for(kTiledTimeout) != std::future_status::ready)
+  {
+    gzerr << "Timed out waiting for the " << tiled->width << "x"
+          << tiled->height << " screenshot" << std::endl;
+    return false;
+  }
+
+  _res.set_data(tiled->path);
+  return done.get();
+}
+
+/////////////////////////////////////////////////
+void ScreenshotPrivate::RequestFrame()
+{
+  if (App() && App()->MainWin())
+    QCoreApplication::postEvent(App()->MainWin(), new events::SceneChanged());
+}
+
+/////////////////////////////////////////////////
+bool ScreenshotPrivate::RenderTileRow(
+    const std::shared_ptr<TiledScreenshot> &_tiled)
+{
+  if (_tiled->finished)
+    return true;
+
+  // The writer falls behind, it asks for a frame when it catches up
+  if (_tiled->queuedRows >= kMaxQueuedTileRows)
+    return false;
+
+  if (nullptr == _tiled->camera)
+  {
+    if (nullptr == this->userCamera)
+    {
+      gzerr << "No camera to take the tiled screenshot with" << std::endl;
+      _tiled->Finish(false);
+      return true;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(_tiled->mutex);
+      if (!_tiled->writer.Open(_tiled->path, _tiled->width, _tiled->height))
+      {
+        gzerr << "Failed to create [" << _tiled->path << "]" << std::endl;
+        _tiled->Finish(false);
+        return true;
+      }
+    }
+
+    auto scene = this->userCamera->Scene();
+    _tiled->camera = scene->CreateCamera();
+    if (nullptr == _tiled->camera)
+    {
+      gzerr << "Failed to create a camera for the tiled screenshot"
+            << std::endl;
+      _tiled->Finish(false);
+      return true;
+    }
+
+    // The whole image has the user camera's horizontal field of view
+    _tiled->pose = this->userCamera->WorldPose();
+    _tiled->nearClip = this->userCamera->NearClipPlane();
+    _tiled->farClip = this->userCamera->FarClipPlane();
+    _tiled->halfWidth = _tiled->nearClip * std::tan(
+        this->userCamera->HFOV().Radian() * 0.5);
+    _tiled->halfHeight = _tiled->halfWidth * _tiled->height /
+        _tiled->width;
+
+    auto &camera = _tiled->camera;
+    camera->SetImageWidth(_tiled->tileWidth);
+    camera->SetImageHeight(_tiled->tileHeight);
+    camera->SetAspectRatio(
+        static_cast<double>(_tiled->tileWidth) / _tiled->tileHeight);
+    camera->SetNearClipPlane(_tiled->nearClip);
+    camera->SetFarClipPlane(_tiled->farClip);
+    camera->SetAntiAliasing(this->userCamera->AntiAliasing());
+    camera->SetImageFormat(rendering::PF_R8G8B8);
+    scene->RootVisual()->AddChild(camera);
+    camera->SetWorldPose(_tiled->pose);
+  }
+
+  // Each tile has an off-axis frustum, a window of the whole image's
+  const double pixelX = 2.0 * _tiled->halfWidth / _tiled->width;
+  const double pixelY = 2.0 * _tiled->halfHeight / _tiled->height;
+  const double n = _tiled->nearClip;
+  const double f = _tiled->farClip;
+  const unsigned int row = _tiled->nextRow;
+
+  ScreenshotJob job;
+  job.tiled = _tiled;
+  job.tileRow = row;
+  for (unsigned int column = 0u; column < _tiled->columns; ++column)
+  {
+    double left = -_tiled->halfWidth + column * _tiled->tileWidth * pixelX;
+    double right = left + _tiled->tileWidth * pixelX;
+    double top = _tiled->halfHeight - row * _tiled->tileHeight * pixelY;
+    double bottom = top - _tiled->tileHeight * pixelY;
+
+    math::Matrix4d projection(
+        2.0 * n / (right - left), 0.0, (right + left) / (right - left), 0.0,
+        0.0, 2.0 * n / (top - bottom), (top + bottom) / (top - bottom), 0.0,
+        0.0, 0.0, -(f + n) / (f - n), -2.0 * f * n / (f - n),
+        0.0, 0.0, -1.0, 0.0);
+    _tiled->camera->SetProjectionMatrix(projection);
+    _tiled->camera->Update();
+
+    job.tiles.push_back(_tiled->camera->CreateImage());
+    _tiled->camera->Copy(job.tiles.back());
+  }
+
+  ++_tiled->queuedRows;
+  this->QueueJob(std::move(job));
+
+  if (++_tiled->nextRow < _tiled->tileRows)
+    return false;
+
+  // Written by the workers from here
+  _tiled->camera->Scene()->DestroySensor(_tiled->camera);
+  _tiled->camera.reset();
+  return true;
+}
+
+/////////////////////////////////////////////////
+void ScreenshotPrivate::WriteTileRow(ScreenshotJob &_job)
+{
+  auto &tiled = *_job.tiled;
+  std::unique_lock<std::mutex> lock(tiled.mutex);
+
+  // Rows are written in order, the previous one was taken by another
+  // worker before this one
+  tiled.writtenCv.wait(lock, [&]
+  {
+    return tiled.writtenRows == _job.tileRow;
+  });
+
+  if (!tiled.finished)
+  {
+    const unsigned int y0 = _job.tileRow * tiled.tileHeight;
+    const unsigned int rows = std::min(tiled.tileHeight, tiled.height - y0);
+    std::vector<unsigned char> pixels(
+        static_cast<std::size_t>(tiled.width) * 3u);
+    for (unsigned int y = 0u; y < rows && tiled.ok; ++y)
+    {
+      for (unsigned int column = 0u; column < _job.tiles.size(); ++column)
+      {
+        const unsigned int x0 = column * tiled.tileWidth;
+        const unsigned int columns =
+            std::min(tiled.tileWidth, tiled.width - x0);
+        const auto *tile = _job.tiles[column].Data<unsigned char>();
+        std::copy_n(tile + static_cast<std::size_t>(y) * tiled.tileWidth * 3u,
+            static_cast<std::size_t>(columns) * 3u,
+            pixels.begin() + static_cast<std::size_t>(x0) * 3u);
+      }
+      if (!tiled.writer.WriteRow(pixels.data()))
+        tiled.ok = false;
+    }
+  }
+
+  ++tiled.writtenRows;
+  --tiled.queuedRows;
+  tiled.writtenCv.notify_all();
+
+  if (tiled.writtenRows == tiled.tileRows)
+  {
+    if (!tiled.writer.Close())
+      tiled.ok = false;
+    if (tiled.ok)
+      gzdbg << "Saved image to [" << tiled.path << "]" << std::endl;
+    else
+      gzerr << "Failed to save image to [" << tiled.path << "]" << std::endl;
+    tiled.Finish(tiled.ok);
+    if (tiled.ok)
+      this->onSaved(tiled.path);
+  }
+  else
+  {
+    // Let the render thread queue the next row
+    this->RequestFrame();
+  }
+}
+
+/////////////////////////////////////////////////
+void ScreenshotPrivate::RenderBatch(
+    const std::shared_ptr<ScreenshotBatch> &_batch)
+{
+  if (nullptr == this->userCamera)
+  {
+    gzerr << "No camera to take the batch screenshots with" << std::endl;
+    _batch->done.set_value(false);
+    return;
+  }
+
+  // An offscreen camera matching the user camera renders the views, so the
+  // user camera doesn't move and the size may differ from the window's
+  auto scene = this->userCamera->Scene();
+  auto camera = scene->CreateCamera();
+  if (nullptr == camera)
+  {
+    gzerr << "Failed to create a camera for batch screenshots"
+          << std::endl;
+    _batch->done.set_value(false);
+    return;
+  }
+  unsigned int width = _batch->width > 0u ? _batch->width :
+      this->userCamera->ImageWidth();
+  unsigned int height = _batch->height > 0u ? _batch->height :
+      this->userCamera->ImageHeight();
+  camera->SetImageWidth(width);
+  camera->SetImageHeight(height);
+  camera->SetAspectRatio(static_cast<double>(width) / height);
+  camera->SetHFOV(this->userCamera->HFOV());
+  camera->SetNearClipPlane(this->userCamera->NearClipPlane());
+  camera->SetFarClipPlane(this->userCamera->FarClipPlane());
+  camera->SetAntiAliasing(this->userCamera->AntiAliasing());
+  camera->SetImageFormat(rendering::PF_R8G8B8);
+  scene->RootVisual()->AddChild(camera);
+
+  auto format = common::Image::ConvertPixelFormat(
+      rendering::PixelUtil::Name(camera->ImageFormat()));
+  std::string time = common::systemTimeISO();
+
+  // All the paths are set before any image is queued, so they're complete
+  // when the last one is written
+  const auto count = _batch->poses.size();
+  _batch->paths.resize(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    char index[32];
+    std::snprintf(index, sizeof(index), "_%04zu.png", i);
+    _batch->paths[i] = common::joinPaths(_batch->directory, time + index);
+  }
+  _batch->remaining = count;
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    camera->SetWorldPose(_batch->poses[i]);
+    camera->Update();
+
+    ScreenshotJob job;
+    job.width = width;
+    job.height = height;
+    job.format = format;
+    job.image = camera->CreateImage();
+    camera->Copy(job.image);
+    job.path = _batch->paths[i];
+    job.batch = _batch;
+    this->QueueJob(std::move(job));
+  }
+
+  scene->DestroySensor(camera);
+}
+
+/////////////////////////////////////////////////
+void ScreenshotPrivate::QueueJob(ScreenshotJob &&_job)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->jobs.push_back(std::move(_job));
+  }
+  this->workerCv.notify_one();
+}
+
 /////////////////////////////////////////////////
 void Screenshot::SaveScreenshot()
 {
@@ -144,30 +856,69 @@ void Screenshot::SaveScreenshot()
   if (nullptr == this->dataPtr->userCamera)
     return;
 
-  unsigned int width = this->dataPtr->userCamera->ImageWidth();
-  unsigned int height = this->dataPtr->userCamera->ImageHeight();
-
-  auto cameraImage = this->dataPtr->userCamera->CreateImage();
-  this->dataPtr->userCamera->Copy(cameraImage);
+  // Only the copy from the GPU happens on the render thread, encoding and
+  // writing the file are left to the worker
+  ScreenshotJob job;
+  job.width = this->dataPtr->userCamera->ImageWidth();
+  job.height = this->dataPtr->userCamera->ImageHeight();
+  job.image = this->dataPtr->userCamera->CreateImage();
+  this->dataPtr->userCamera->Copy(job.image);
   auto formatStr =
       rendering::PixelUtil::Name(this->dataPtr->userCamera->ImageFormat());
-  auto format = common::Image::ConvertPixelFormat(formatStr);
+  job.format = common::Image::ConvertPixelFormat(formatStr);
 
   std::string time = common::systemTimeISO() + ".png";
-  std::string savePath = common::joinPaths(this->dataPtr->directory, time);
+  job.path = common::joinPaths(this->dataPtr->directory, time);
 
-  common::Image image;
-  image.SetFromData(cameraImage.Data<unsigned char>(), width, height, format);
-  image.SavePNG(savePath);
+  this->dataPtr->dirty = false;
 
-  gzdbg << "Saved image to [" << savePath << "]" << std::endl;
+  this->dataPtr->QueueJob(std::move(job));
+}
 
-  this->dataPtr->dirty = false;
+/////////////////////////////////////////////////
+void ScreenshotPrivate::ProcessWorker()
+{
+  while (true)
+  {
+    ScreenshotJob job;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->workerCv.wait(lock, [this]
+      {
+        return this->stopWorker || !this->jobs.empty();
+      });
+      if (this->jobs.empty())
+        return;
+      job = std::move(this->jobs.front());
+      this->jobs.pop_front();
+    }
+
+    if (nullptr != job.tiled)
+    {
+      this->WriteTileRow(job);
+      continue;
+    }
 
-  this->SetSavedScreenshotPath(QString::fromStdString(savePath));
+    common::Image image;
+    image.SetFromData(job.image.Data<unsigned char>(), job.width,
+        job.height, job.format);
+    image.SavePNG(job.path);
 
-  App()->findChild<MainWindow *>()->notifyWithDuration(
-    QString::fromStdString("Saved image to: <b>" + savePath + "</b>"), 4000);
+    if (nullptr == job.batch)
+    {
+      gzdbg << "Saved image to [" << job.path << "]" << std::endl;
+      this->onSaved(job.path);
+      continue;
+    }
+
+    if (!common::exists(job.path))
+    {
+      gzerr << "Failed to save image to [" << job.path << "]" << std::endl;
+      job.batch->ok = false;
+    }
+    if (--job.batch->remaining == 0u)
+      job.batch->done.set_value(job.batch->ok);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -228,5 +979,4 @@ void Screenshot::SetSavedScreenshotPath(const QString &_filename)
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(Screenshot,
-              gui::Plugin)
+GZ_GUI_ADD_PLUGIN(Screenshot, "Screenshot")
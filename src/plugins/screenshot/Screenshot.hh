@@ -18,7 +18,9 @@
 #define GZ_GUI_PLUGINS_SCREENSHOT_HH_
 
 #include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/pose_v.pb.h>
 #include <gz/msgs/stringmsg.pb.h>
+#include <gz/msgs/stringmsg_v.pb.h>
 
 #include <memory>
 
@@ -39,6 +41,33 @@ namespace plugins
   /// /gui/screenshot service:
   ///     Data: Path to save to, leave empty to save to latest path.
   ///     Response: True if screenshot has been queued succesfully.
+  ///
+  /// /gui/screenshot/batch service:
+  ///     Data: Camera poses, in the world frame. The header may have
+  ///       `width` and `height` for the image size, which is the user
+  ///       camera's by default, and `directory` to save to, the latest path
+  ///       by default.
+  ///     Response: Paths of the images, once they're all written. False if
+  ///       any failed.
+  ///
+  /// /gui/screenshot/tiled service:
+  ///     Data: Directory to save to, leave empty to save to latest path.
+  ///       The header must have `width` and `height`, which may be larger
+  ///       than the render engine's largest texture, and may have
+  ///       `tile_size`, 2048 by default.
+  ///     Response: Path of the image, once it's written.
+  ///
+  /// The image is copied from the camera on the render thread, then encoded
+  /// and written on a worker thread. savedScreenshot is emitted once the
+  /// file is written. The views of a batch are rendered back to back in a
+  /// single frame by an offscreen camera, and written in parallel.
+  ///
+  /// Tiled screenshots are rendered from the user camera's view by an
+  /// offscreen camera, one row of tiles per frame, each tile with an
+  /// off-axis frustum. The tiles are stitched and streamed to an
+  /// uncompressed PNG by a worker, and at most two rows of tiles wait to
+  /// be written, so memory doesn't grow with the image size. Screen-space
+  /// effects, such as ambient occlusion, may show at the tile seams.
   class Screenshot : public Plugin
   {
     Q_OBJECT
@@ -84,6 +113,22 @@ namespace plugins
     private: bool ScreenshotService(const msgs::StringMsg &_msg,
         msgs::Boolean &_res);
 
+    /// \brief Callback for the batch screenshot service, which returns
+    /// once all the images are written
+    /// \param[in] _msg Camera poses and options
+    /// \param[in] _res Paths of the images
+    /// \return True if all the images were written
+    private: bool BatchScreenshotService(const msgs::Pose_V &_msg,
+        msgs::StringMsg_V &_res);
+
+    /// \brief Callback for the tiled screenshot service, which returns
+    /// once the image is written
+    /// \param[in] _msg Directory and size
+    /// \param[in] _res Path of the image
+    /// \return True if the image was written
+    private: bool TiledScreenshotService(const msgs::StringMsg &_msg,
+        msgs::StringMsg &_res);
+
     /// \brief Encapsulates the logic to find the user camera through the
     /// render engine singleton.
     private: void FindUserCamera();
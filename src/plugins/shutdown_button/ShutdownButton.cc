@@ -21,6 +21,7 @@
 
 #include "gz/gui/Application.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/StaticPlugins.hh"
 
 using namespace gz;
 using namespace gui;
@@ -49,5 +50,4 @@ void ShutdownButton::OnStop()
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(ShutdownButton,
-              gui::Plugin)
+GZ_GUI_ADD_PLUGIN(ShutdownButton, "ShutdownButton")
@@ -17,17 +17,31 @@
 
 #include <gz/msgs/marker.pb.h>
 
+#include <atomic>
+#include <cstdint>
 #include <iostream>
+#include <mutex>
 #include <unordered_set>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include <gz/common/Console.hh>
+#include <gz/common/MouseEvent.hh>
 #include <gz/gui/Application.hh>
 #include <gz/gui/GuiEvents.hh>
 #include <gz/gui/MainWindow.hh>
+#include <gz/gui/RenderHooks.hh>
+#include <gz/gui/ScenePicker.hh>
+#include <gz/gui/StaticPlugins.hh>
 #include <gz/msgs/Utility.hh>
 #include <gz/plugin/Register.hh>
+#include <gz/rendering/Geometry.hh>
+#include <gz/rendering/Marker.hh>
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/RenderingIface.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
 #include <gz/transport/Node.hh>
 #include <gz/transport/Publisher.hh>
 
@@ -37,9 +51,22 @@ namespace gz::gui
 {
   class TapeMeasurePrivate
   {
+    /// \brief Set the hovered point of the scene and update the
+    /// measurement. Called from the render thread.
+    /// \param[in] _point Hovered point
+    public: void Hover(const math::Vector3d &_point);
+
+    /// \brief Create the visuals if needed and update them with the
+    /// measurement. Called on the render thread before each frame.
+    public: void OnPreRender();
+
     /// \brief Gazebo communication node.
     public: transport::Node node;
 
+    /// \brief Protects the measurement, which is changed from both the Qt
+    /// and render threads
+    public: std::mutex mutex;
+
     /// \brief True if currently measuring, else false.
     public: bool measure = false;
 
@@ -66,6 +93,30 @@ namespace gz::gui
     /// tool, only set when the user clicks to set the point.
     public: gz::math::Vector3d endPoint = gz::math::Vector3d::Zero;
 
+    /// \brief The latest hovered point, valid if hovered is true
+    public: math::Vector3d hoverPoint = math::Vector3d::Zero;
+
+    /// \brief True if the point being placed was hovered since the last
+    /// click
+    public: bool hovered{false};
+
+    /// \brief True once both points are placed
+    public: bool finished{false};
+
+    /// \brief Latest hovered position in the render window, picked on the
+    /// next frame
+    public: math::Vector2i hoverPos;
+
+    /// \brief True if hoverPos must be picked
+    public: bool hoverPending{false};
+
+    /// \brief Incremented when the measurement changes, so the visuals are
+    /// only updated when needed
+    public: uint64_t revision{0u};
+
+    /// \brief Revision shown by the visuals. Render thread only.
+    public: uint64_t shownRevision{0u};
+
     /// \brief The color to set the marker when hovering the mouse over the
     /// scene.
     public: gz::math::Color
@@ -86,12 +137,156 @@ namespace gz::gui
 
     /// \brief The namespace that the markers for this plugin are placed in.
     public: std::string ns = "tape_measure";
+
+    /// \brief True to publish the final measurement as markers
+    public: bool publishMarkers{false};
+
+    /// \brief Id of the render hook
+    public: uint64_t renderHookId{0u};
+
+    /// \brief Scene, render thread only, like the visuals
+    public: rendering::ScenePtr scene;
+
+    /// \brief Parent of the visuals
+    public: rendering::VisualPtr visual;
+
+    /// \brief Start point
+    public: rendering::VisualPtr startVisual;
+
+    /// \brief End point
+    public: rendering::VisualPtr endVisual;
+
+    /// \brief Line between the points
+    public: rendering::VisualPtr lineVisual;
+
+    /// \brief Geometry of the line
+    public: rendering::MarkerPtr line;
+
+    /// \brief Material while hovering
+    public: rendering::MaterialPtr hoverMaterial;
+
+    /// \brief Material of placed points
+    public: rendering::MaterialPtr drawMaterial;
   };
 }
 
 using namespace gz;
 using namespace gui;
 
+/////////////////////////////////////////////////
+void TapeMeasurePrivate::Hover(const math::Vector3d &_point)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (!this->measure)
+    return;
+
+  this->hoverPoint = _point;
+  this->hovered = true;
+  if (this->currentId == this->kEndPointId)
+    this->distance = this->startPoint.Distance(_point);
+  ++this->revision;
+}
+
+/////////////////////////////////////////////////
+void TapeMeasurePrivate::OnPreRender()
+{
+  if (nullptr == this->scene)
+  {
+    this->scene = rendering::sceneFromFirstRenderEngine();
+    if (nullptr == this->scene)
+      return;
+  }
+
+  if (!RenderHooks::RunsFor(this->scene->Name()))
+    return;
+
+  // Picked here rather than at HoverToScene's rate, so the tape follows
+  // the mouse on every frame
+  math::Vector2i pos;
+  bool pick{false};
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    pick = this->hoverPending && this->measure;
+    pos = this->hoverPos;
+    this->hoverPending = false;
+  }
+  PickResult result;
+  if (pick && ScenePicker::Pick(pos, result))
+    this->Hover(result.Point(1000));
+
+  bool startShown{false};
+  bool startPlaced{false};
+  bool endShown{false};
+  math::Vector3d startPos;
+  math::Vector3d endPos;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->revision == this->shownRevision && nullptr != this->visual)
+      return;
+    this->shownRevision = this->revision;
+
+    startPlaced = this->currentId == this->kEndPointId;
+    startShown = startPlaced || (this->measure && this->hovered);
+    startPos = startPlaced ? this->startPoint : this->hoverPoint;
+    endShown = this->finished ||
+        (startPlaced && this->measure && this->hovered);
+    endPos = this->finished ? this->endPoint : this->hoverPoint;
+  }
+
+  if (nullptr == this->visual)
+  {
+    auto createMaterial = [this](const math::Color &_color)
+    {
+      auto material = this->scene->CreateMaterial();
+      material->SetAmbient(_color);
+      material->SetDiffuse(_color);
+      material->SetTransparency(1.0 - _color.A());
+      material->SetCastShadows(false);
+      return material;
+    };
+    this->hoverMaterial = createMaterial(this->hoverColor);
+    this->drawMaterial = createMaterial(this->drawColor);
+
+    // Not selectable, so the hovered point isn't picked on the ball
+    auto flags = GZ_VISIBILITY_GUI & ~GZ_VISIBILITY_SELECTABLE;
+    this->visual = this->scene->CreateVisual();
+    this->scene->RootVisual()->AddChild(this->visual);
+    for (auto point : {&this->startVisual, &this->endVisual})
+    {
+      *point = this->scene->CreateVisual();
+      (*point)->AddGeometry(this->scene->CreateSphere());
+      (*point)->SetLocalScale(math::Vector3d(0.1, 0.1, 0.1));
+      (*point)->SetVisibilityFlags(flags);
+      this->visual->AddChild(*point);
+    }
+
+    this->line = this->scene->CreateMarker();
+    this->line->SetType(rendering::MarkerType::MT_LINE_LIST);
+    this->lineVisual = this->scene->CreateVisual();
+    this->lineVisual->AddGeometry(this->line);
+    this->lineVisual->SetVisibilityFlags(flags);
+    this->visual->AddChild(this->lineVisual);
+  }
+
+  // Materials are shared, so switching them doesn't copy anything
+  this->startVisual->SetVisible(startShown);
+  this->startVisual->SetWorldPosition(startPos);
+  this->startVisual->SetMaterial(
+      startPlaced ? this->drawMaterial : this->hoverMaterial, false);
+
+  auto endMaterial = this->finished ? this->drawMaterial :
+      this->hoverMaterial;
+  this->endVisual->SetVisible(endShown);
+  this->endVisual->SetWorldPosition(endPos);
+  this->endVisual->SetMaterial(endMaterial, false);
+
+  this->lineVisual->SetVisible(endShown);
+  this->line->ClearPoints();
+  this->line->AddPoint(startPos, endMaterial->Diffuse());
+  this->line->AddPoint(endPos, endMaterial->Diffuse());
+  this->lineVisual->SetMaterial(endMaterial, false);
+}
+
 /////////////////////////////////////////////////
 TapeMeasure::TapeMeasure()
   : gz::gui::Plugin(),
@@ -100,18 +295,67 @@ TapeMeasure::TapeMeasure()
 }
 
 /////////////////////////////////////////////////
-TapeMeasure::~TapeMeasure() = default;
+TapeMeasure::~TapeMeasure()
+{
+  RenderHooks::Unregister(this->dataPtr->renderHookId);
+
+  // The visuals can only be destroyed on the render thread, so leave that
+  // to a hook which runs once
+  auto visual = this->dataPtr->visual;
+  if (nullptr == visual)
+    return;
+
+  std::vector<rendering::MaterialPtr> materials{
+      this->dataPtr->hoverMaterial, this->dataPtr->drawMaterial};
+  auto hookId = std::make_shared<std::atomic<uint64_t>>(0u);
+  *hookId = RenderHooks::Register(RenderPhase::kPreRender,
+      [visual, materials, hookId]() mutable
+      {
+        if (nullptr != visual)
+        {
+          auto scene = visual->Scene();
+          if (nullptr != scene)
+          {
+            scene->DestroyVisual(visual, true);
+            for (const auto &material : materials)
+              scene->DestroyMaterial(material);
+          }
+          visual.reset();
+        }
+        RenderHooks::Unregister(*hookId);
+      });
+}
 
 /////////////////////////////////////////////////
-void TapeMeasure::LoadConfig(const tinyxml2::XMLElement *)
+void TapeMeasure::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Tape measure";
 
-  gz::gui::App()->findChild<gz::gui::MainWindow *>
-      ()->installEventFilter(this);
-  gz::gui::App()->findChild<gz::gui::MainWindow *>
-      ()->QuickWindow()->installEventFilter(this);
+  if (_pluginElem)
+  {
+    if (auto elem = _pluginElem->FirstChildElement("publish_markers"))
+      elem->QueryBoolText(&this->dataPtr->publishMarkers);
+  }
+
+  // Key events are sent to the window, scene events to the main window
+  auto mainWindow = gz::gui::App()->findChild<gz::gui::MainWindow *>();
+  for (auto type : {gz::gui::events::HoverOnScene::kType,
+                    gz::gui::events::HoverToScene::kType,
+                    gz::gui::events::LeftClickToScene::kType,
+                    gz::gui::events::RightClickToScene::kType})
+  {
+    mainWindow->SubscribeEvent(type, this);
+  }
+  mainWindow->QuickWindow()->installEventFilter(this);
+
+  if (this->dataPtr->renderHookId == 0u)
+  {
+    auto dataPtr = this->dataPtr.get();
+    this->dataPtr->renderHookId = RenderHooks::Register(
+        RenderPhase::kPreRender, [dataPtr]{dataPtr->OnPreRender();}, 0,
+        "TapeMeasure");
+  }
 }
 
 /////////////////////////////////////////////////
@@ -124,7 +368,10 @@ void TapeMeasure::OnMeasure()
 void TapeMeasure::Measure()
 {
   this->Reset();
-  this->dataPtr->measure = true;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->measure = true;
+  }
   QGuiApplication::setOverrideCursor(Qt::CrossCursor);
 
   // Notify 3D scene to disable the right click menu while we use it to
@@ -148,11 +395,18 @@ void TapeMeasure::Reset()
   this->DeleteMarker(this->dataPtr->kEndPointId);
   this->DeleteMarker(this->dataPtr->kLineId);
 
-  this->dataPtr->currentId = this->dataPtr->kStartPointId;
-  this->dataPtr->startPoint = gz::math::Vector3d::Zero;
-  this->dataPtr->endPoint = gz::math::Vector3d::Zero;
-  this->dataPtr->distance = 0.0;
-  this->dataPtr->measure = false;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->currentId = this->dataPtr->kStartPointId;
+    this->dataPtr->startPoint = gz::math::Vector3d::Zero;
+    this->dataPtr->endPoint = gz::math::Vector3d::Zero;
+    this->dataPtr->distance = 0.0;
+    this->dataPtr->measure = false;
+    this->dataPtr->hovered = false;
+    this->dataPtr->finished = false;
+    this->dataPtr->hoverPending = false;
+    ++this->dataPtr->revision;
+  }
   this->newDistance();
   QGuiApplication::restoreOverrideCursor();
 
@@ -167,6 +421,7 @@ void TapeMeasure::Reset()
 /////////////////////////////////////////////////
 double TapeMeasure::Distance()
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   return this->dataPtr->distance;
 }
 
@@ -231,70 +486,103 @@ void TapeMeasure::DrawLine(int _id, gz::math::Vector3d &_startPoint,
 /////////////////////////////////////////////////
 bool TapeMeasure::eventFilter(QObject *_obj, QEvent *_event)
 {
-  if (_event->type() == gz::gui::events::HoverToScene::kType)
+  if (_event->type() == gz::gui::events::HoverOnScene::kType)
   {
-    auto hoverToSceneEvent =
-        reinterpret_cast<gz::gui::events::HoverToScene *>(_event);
+    auto hoverOnSceneEvent =
+        reinterpret_cast<gz::gui::events::HoverOnScene *>(_event);
 
-    // This event is called in the RenderThread, so it's safe to make
-    // rendering calls here
-    if (this->dataPtr->measure && hoverToSceneEvent)
+    // Picked on the next frame, only the latest position matters
+    if (hoverOnSceneEvent && ScenePicker::HasPicker())
     {
-      gz::math::Vector3d point = hoverToSceneEvent->Point();
-      this->DrawPoint(this->dataPtr->currentId, point,
-        this->dataPtr->hoverColor);
-
-      // If the user is currently choosing the end point, draw the connecting
-      // line and update the new distance.
-      if (this->dataPtr->currentId == this->dataPtr->kEndPointId)
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      if (this->dataPtr->measure)
       {
-        this->DrawLine(this->dataPtr->kLineId, this->dataPtr->startPoint,
-          point, this->dataPtr->hoverColor);
-        this->dataPtr->distance = this->dataPtr->startPoint.Distance(point);
-        this->newDistance();
+        this->dataPtr->hoverPos = hoverOnSceneEvent->Mouse().Pos();
+        this->dataPtr->hoverPending = true;
       }
     }
   }
+  else if (_event->type() == gz::gui::events::HoverToScene::kType)
+  {
+    auto hoverToSceneEvent =
+        reinterpret_cast<gz::gui::events::HoverToScene *>(_event);
+
+    // Without a picker, the scene's own, throttled, picking is used
+    if (hoverToSceneEvent && !ScenePicker::HasPicker())
+      this->dataPtr->Hover(hoverToSceneEvent->Point());
+
+    bool measuringEnd{false};
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      measuringEnd = this->dataPtr->measure &&
+          this->dataPtr->currentId == this->dataPtr->kEndPointId;
+    }
+    // The label doesn't need to follow at the frame rate
+    if (measuringEnd)
+      this->newDistance();
+  }
   else if (_event->type() == gz::gui::events::LeftClickToScene::kType)
   {
     auto leftClickToSceneEvent =
         reinterpret_cast<gz::gui::events::LeftClickToScene *>(_event);
 
-    // This event is called in the RenderThread, so it's safe to make
-    // rendering calls here
-    if (this->dataPtr->measure && leftClickToSceneEvent)
+    // This event is called in the RenderThread
+    bool finished{false};
+    math::Vector3d startPoint;
+    math::Vector3d endPoint;
+    if (leftClickToSceneEvent)
     {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      if (!this->dataPtr->measure)
+        return QObject::eventFilter(_obj, _event);
+
       gz::math::Vector3d point = leftClickToSceneEvent->Point();
-      this->DrawPoint(this->dataPtr->currentId, point,
-        this->dataPtr->drawColor);
       // If the user is placing the start point, update its position
       if (this->dataPtr->currentId == this->dataPtr->kStartPointId)
       {
         this->dataPtr->startPoint = point;
       }
       // If the user is placing the end point, update the end position,
-      // end the measurement state, and update the draw line and distance
+      // end the measurement state, and update the distance
       else
       {
         this->dataPtr->endPoint = point;
         this->dataPtr->measure = false;
-        this->DrawLine(this->dataPtr->kLineId, this->dataPtr->startPoint,
-          this->dataPtr->endPoint, this->dataPtr->drawColor);
+        this->dataPtr->finished = true;
         this->dataPtr->distance =
           this->dataPtr->startPoint.Distance(this->dataPtr->endPoint);
-        this->newDistance();
-        QGuiApplication::restoreOverrideCursor();
-
-        // Notify 3D scene that we are done using the right click, so it can
-        // re-enable the settings menu
-        gz::gui::events::DropdownMenuEnabled
-          dropdownMenuEnabledEvent(true);
-
-        gz::gui::App()->sendEvent(
-            gz::gui::App()->findChild<gz::gui::MainWindow *>(),
-            &dropdownMenuEnabledEvent);
+        finished = true;
+        startPoint = this->dataPtr->startPoint;
+        endPoint = this->dataPtr->endPoint;
       }
       this->dataPtr->currentId = this->dataPtr->kEndPointId;
+      this->dataPtr->hovered = false;
+      ++this->dataPtr->revision;
+    }
+
+    if (finished)
+    {
+      // Only the final measurement is sent to the other clients
+      if (this->dataPtr->publishMarkers)
+      {
+        this->DrawPoint(this->dataPtr->kStartPointId, startPoint,
+          this->dataPtr->drawColor);
+        this->DrawPoint(this->dataPtr->kEndPointId, endPoint,
+          this->dataPtr->drawColor);
+        this->DrawLine(this->dataPtr->kLineId, startPoint, endPoint,
+          this->dataPtr->drawColor);
+      }
+      this->newDistance();
+      QGuiApplication::restoreOverrideCursor();
+
+      // Notify 3D scene that we are done using the right click, so it can
+      // re-enable the settings menu
+      gz::gui::events::DropdownMenuEnabled
+        dropdownMenuEnabledEvent(true);
+
+      gz::gui::App()->sendEvent(
+          gz::gui::App()->findChild<gz::gui::MainWindow *>(),
+          &dropdownMenuEnabledEvent);
     }
   }
   else if (_event->type() == QEvent::KeyPress)
@@ -309,8 +597,12 @@ bool TapeMeasure::eventFilter(QObject *_obj, QEvent *_event)
   else if (_event->type() == QEvent::KeyRelease)
   {
     QKeyEvent *keyEvent = static_cast<QKeyEvent*>(_event);
-    if (keyEvent && keyEvent->key() == Qt::Key_Escape &&
-        this->dataPtr->measure)
+    bool measuring{false};
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      measuring = this->dataPtr->measure;
+    }
+    if (keyEvent && keyEvent->key() == Qt::Key_Escape && measuring)
     {
       this->Reset();
     }
@@ -318,7 +610,12 @@ bool TapeMeasure::eventFilter(QObject *_obj, QEvent *_event)
   // Cancel the current action if a right click is detected
   else if (_event->type() == gz::gui::events::RightClickToScene::kType)
   {
-    if (this->dataPtr->measure)
+    bool measuring{false};
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      measuring = this->dataPtr->measure;
+    }
+    if (measuring)
     {
       this->Reset();
     }
@@ -328,5 +625,4 @@ bool TapeMeasure::eventFilter(QObject *_obj, QEvent *_event)
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(gz::gui::TapeMeasure,
-              gz::gui::Plugin)
+GZ_GUI_ADD_PLUGIN(gz::gui::TapeMeasure, "TapeMeasure")
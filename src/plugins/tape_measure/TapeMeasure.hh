@@ -30,6 +30,15 @@ namespace gui
   class TapeMeasurePrivate;
 
   /// \brief Provides buttons for the tape measure tool.
+  ///
+  /// The points and line are visuals of the plugin, updated on the render
+  /// thread, so the measurement follows the mouse at the frame rate.
+  ///
+  /// ## Configuration
+  ///
+  /// \<publish_markers\> : True to also publish the final measurement
+  ///                       through the /marker service, so other clients
+  ///                       show it. Defaults to false.
   class TapeMeasure : public gz::gui::Plugin
   {
     Q_OBJECT
@@ -57,8 +66,8 @@ namespace gui
     /// progress or already made.
     public: void Measure();
 
-    /// \brief Draws a point marker.  Called to display the start and end
-    /// point of the tape measure.
+    /// \brief Publishes a point marker.  Called to share the start and end
+    /// point of the final measurement.
     /// \param[in] _id The id of the marker
     /// \param[in] _point The x, y, z coordinates of where to place the marker
     /// \param[in] _color The rgba color to set the marker
@@ -66,8 +75,8 @@ namespace gui
                 gz::math::Vector3d &_point,
                 gz::math::Color &_color);
 
-    /// \brief Draws a line marker.  Called to display the line between the
-    /// start and end point of the tape measure.
+    /// \brief Publishes a line marker.  Called to share the line between
+    /// the start and end point of the final measurement.
     /// \param[in] _id The id of the marker
     /// \param[in] _startPoint The x, y, z coordinates of the line start point
     /// \param[in] _endPoint The x, y, z coordinates of the line end point
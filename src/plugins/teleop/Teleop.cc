@@ -15,8 +15,25 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/joystick.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
 
 #include <gz/msgs/twist.pb.h>
 
@@ -26,6 +43,7 @@
 
 #include <gz/gui/Application.hh>
 #include <gz/gui/MainWindow.hh>
+#include <gz/gui/StaticPlugins.hh>
 
 namespace gz
 {
@@ -51,19 +69,125 @@ namespace plugins
     kStop,
   };
 
+  /// \brief Gamepad configuration, see Teleop
+  struct Gamepad
+  {
+    /// \brief Joystick device
+    std::string device{"/dev/input/js0"};
+
+    /// \brief Rate at which the device is polled, in Hz
+    double rate{250.0};
+
+    /// \brief Axis of the forward velocity, -1 for none
+    int forwardAxis{1};
+
+    /// \brief Axis of the vertical velocity, -1 for none
+    int verticalAxis{4};
+
+    /// \brief Axis of the yaw velocity, -1 for none
+    int yawAxis{0};
+
+    /// \brief Axis values below this fraction of the range are zero
+    double deadzone{0.1};
+
+    /// \brief Button which must be held for the axes to move the vehicle,
+    /// -1 for none
+    int enableButton{-1};
+  };
+
   class TeleopPrivate
   {
+    /// \brief Publish the latest command at the configured rate, until
+    /// stopped. Runs on its own thread.
+    public: void PublishLoop();
+
+    /// \brief Read the gamepad and set the command as soon as its axes
+    /// change, until stopped. Runs on its own thread.
+    public: void GamepadLoop();
+
+    /// \brief Set the command, which is published right away, or by the
+    /// publisher thread with a rate.
+    /// \param[in] _msg Command
+    /// \param[in] _fromGamepad True if it's set by the gamepad thread
+    public: void SetCommand(const msgs::Twist &_msg, bool _fromGamepad);
+
+    /// \brief Get the command of the gamepad's axes
+    /// \param[in] _axes Axis values
+    /// \param[in] _buttons Button values
+    /// \return Command
+    public: msgs::Twist GamepadCommand(const std::vector<int> &_axes,
+        const std::vector<int> &_buttons);
+
     /// \brief Node for communication.
     public: gz::transport::Node node;
 
     /// \brief Topic. Set '/cmd_vel' as default.
     public: std::string topic = "/cmd_vel";
 
-    /// \brief Publisher.
+    /// \brief Publisher. Protected by cmdMutex once the publisher thread
+    /// is started.
     public: gz::transport::Node::Publisher cmdVelPub;
 
+    /// \brief Rate at which the command is published, in Hz. Zero to
+    /// publish only when it changes.
+    public: double rate{0.0};
+
+    /// \brief If the GUI thread doesn't respond for this long, zero
+    /// velocities are published until it does. Zero disables it.
+    public: std::chrono::duration<double> deadmanTimeout{0.5};
+
+    /// \brief Protects the command, the publisher and the flags
+    public: std::mutex cmdMutex;
+
+    /// \brief Wakes the publisher thread when the command changes or it
+    /// should stop
+    public: std::condition_variable cmdCv;
+
+    /// \brief Latest command set from the GUI
+    public: msgs::Twist cmd;
+
+    /// \brief True if the command changed since it was last published
+    public: bool cmdChanged{false};
+
+    /// \brief True if the command was set by the gamepad, which isn't
+    /// affected by the GUI thread's deadman timeout
+    public: bool cmdFromGamepad{false};
+
+    /// \brief True if the publisher thread is publishing at a rate
+    public: bool fixedRate{false};
+
+    /// \brief Gamepad configuration
+    public: Gamepad gamepad;
+
+    /// \brief True if the gamepad is enabled
+    public: bool gamepadEnabled{false};
+
+    /// \brief True to stop the gamepad thread. Protected by cmdMutex.
+    public: bool stopGamepad{false};
+
+    /// \brief Wakes the gamepad thread when it should stop
+    public: std::condition_variable gamepadCv;
+
+    /// \brief Thread reading the gamepad
+    public: std::thread gamepadThread;
+
+    /// \brief True to stop the publisher thread
+    public: bool stopPublisher{false};
+
+    /// \brief Thread publishing at the fixed rate
+    public: std::thread publisherThread;
+
+    /// \brief Last time the GUI thread was responsive, in steady clock
+    /// ticks. Checked by the publisher thread for the deadman timeout.
+    public: std::atomic<std::chrono::steady_clock::rep> heartbeat{0};
+
+    /// \brief Timer updating the heartbeat on the GUI thread
+    public: QTimer heartbeatTimer;
+
     /// \brief Maximum forward velocity in m/s. GUI buttons and key presses
-    /// will use this velocity. Sliders will scale up to this value.
+    /// will use this velocity. Sliders will scale up to this value. The
+    /// maximum velocities are set with cmdMutex locked, since the gamepad
+    /// thread reads them.
     public: double maxForwardVel = 1.0;
 
     /// \brief Maximum vertical velocity in m/s. GUI buttons and key presses
@@ -109,6 +233,247 @@ using namespace gz;
 using namespace gui;
 using namespace plugins;
 
+/////////////////////////////////////////////////
+void TeleopPrivate::PublishLoop()
+{
+  using Clock = std::chrono::steady_clock;
+  auto period = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(1.0 / this->rate));
+
+  bool expired{false};
+  bool failed{false};
+
+  // Deadlines are absolute, so the rate doesn't drift with the time spent
+  // publishing
+  auto next = Clock::now();
+  std::unique_lock<std::mutex> lock(this->cmdMutex);
+  while (!this->stopPublisher)
+  {
+    this->cmdCv.wait_until(lock, next, [this]
+    {
+      return this->stopPublisher || this->cmdChanged;
+    });
+    if (this->stopPublisher)
+      break;
+
+    // A new command is published right away, and the period restarts
+    auto now = Clock::now();
+    if (this->cmdChanged)
+    {
+      this->cmdChanged = false;
+      next = now;
+    }
+    if (now < next)
+      continue;
+
+    msgs::Twist msg = this->cmd;
+    auto pub = this->cmdVelPub;
+    auto topic = this->topic;
+    bool fromGamepad = this->cmdFromGamepad;
+    lock.unlock();
+
+    // The gamepad doesn't depend on the GUI thread
+    auto heartbeat = Clock::time_point(Clock::duration(this->heartbeat));
+    bool stalled = !fromGamepad && this->deadmanTimeout.count() > 0.0 &&
+        now - heartbeat > this->deadmanTimeout;
+    if (stalled != expired)
+    {
+      expired = stalled;
+      if (expired)
+      {
+        gzwarn << "GUI unresponsive for more than "
+               << this->deadmanTimeout.count()
+               << " s, publishing zero velocities on [" << topic
+               << "]" << std::endl;
+      }
+    }
+    if (expired)
+      msg = msgs::Twist();
+
+    bool published = pub.Publish(msg);
+    if (!published && !failed)
+    {
+      gzerr << "gz::msgs::Twist message couldn't be published at topic: "
+        << topic << std::endl;
+    }
+    failed = !published;
+
+    lock.lock();
+
+    // Late ticks are skipped rather than published in a burst
+    next += period;
+    if (next <= now)
+      next = now + period;
+  }
+}
+
+/////////////////////////////////////////////////
+void TeleopPrivate::GamepadLoop()
+{
+#ifdef __linux__
+  // Events are read as soon as they arrive, the period only bounds how
+  // long the thread waits before checking whether it should stop
+  int timeout = std::max(1, static_cast<int>(1000.0 / this->gamepad.rate));
+
+  auto stopped = [this]
+  {
+    std::lock_guard<std::mutex> lock(this->cmdMutex);
+    return this->stopGamepad;
+  };
+
+  auto same = [](const msgs::Twist &_a, const msgs::Twist &_b)
+  {
+    return _a.linear().x() == _b.linear().x() &&
+        _a.linear().z() == _b.linear().z() &&
+        _a.angular().z() == _b.angular().z();
+  };
+
+  std::vector<int> axes;
+  std::vector<int> buttons;
+  msgs::Twist last;
+  bool warned{false};
+  int fd{-1};
+  while (!stopped())
+  {
+    if (fd < 0)
+    {
+      fd = open(this->gamepad.device.c_str(), O_RDONLY | O_NONBLOCK);
+      if (fd < 0)
+      {
+        if (!warned)
+        {
+          gzwarn << "Unable to open gamepad [" << this->gamepad.device
+                 << "], retrying every second" << std::endl;
+          warned = true;
+        }
+        std::unique_lock<std::mutex> lock(this->cmdMutex);
+        this->gamepadCv.wait_for(lock, std::chrono::seconds(1), [this]
+        {
+          return this->stopGamepad;
+        });
+        continue;
+      }
+      gzmsg << "Reading gamepad [" << this->gamepad.device << "]"
+            << std::endl;
+      warned = false;
+    }
+
+    pollfd pfd{fd, POLLIN, 0};
+    int ready = poll(&pfd, 1, timeout);
+    bool lost = ready < 0 && errno != EINTR;
+    if (ready > 0)
+    {
+      // The device sends the initial state of each axis and button once
+      // it's opened, then their changes
+      js_event event;
+      ssize_t size{0};
+      while ((size = read(fd, &event, sizeof(event))) ==
+          static_cast<ssize_t>(sizeof(event)))
+      {
+        auto type = event.type & ~JS_EVENT_INIT;
+        if (type != JS_EVENT_AXIS && type != JS_EVENT_BUTTON)
+          continue;
+        auto &values = type == JS_EVENT_AXIS ? axes : buttons;
+        if (values.size() <= event.number)
+          values.resize(event.number + 1u, 0);
+        values[event.number] = event.value;
+      }
+
+      // No more events once it's read, 0 or another error once the device
+      // is gone
+      lost = size == 0 || (size < 0 && errno != EAGAIN && errno != EINTR);
+    }
+
+    if (lost)
+    {
+      gzwarn << "Lost gamepad [" << this->gamepad.device << "]"
+             << std::endl;
+      close(fd);
+      fd = -1;
+      axes.clear();
+      buttons.clear();
+    }
+
+    // Only changes are set, so the other inputs still work while the
+    // gamepad is idle
+    auto msg = this->GamepadCommand(axes, buttons);
+    if (!same(msg, last))
+    {
+      last = msg;
+      this->SetCommand(msg, true);
+    }
+  }
+
+  if (fd >= 0)
+    close(fd);
+#endif
+}
+
+/////////////////////////////////////////////////
+msgs::Twist TeleopPrivate::GamepadCommand(const std::vector<int> &_axes,
+    const std::vector<int> &_buttons)
+{
+  msgs::Twist msg;
+  const auto &config = this->gamepad;
+  if (config.enableButton >= 0 &&
+      (static_cast<std::size_t>(config.enableButton) >= _buttons.size() ||
+      _buttons[config.enableButton] == 0))
+  {
+    return msg;
+  }
+
+  // Rescaled so the velocity starts from zero at the edge of the deadzone
+  auto axis = [&](int _index)
+  {
+    if (_index < 0 || static_cast<std::size_t>(_index) >= _axes.size())
+      return 0.0;
+    double value = std::clamp(_axes[_index] / 32767.0, -1.0, 1.0);
+    if (std::abs(value) <= config.deadzone)
+      return 0.0;
+    return std::copysign(
+        (std::abs(value) - config.deadzone) / (1.0 - config.deadzone),
+        value);
+  };
+
+  // Pushing a stick up or left gives negative values
+  std::lock_guard<std::mutex> lock(this->cmdMutex);
+  msg.mutable_linear()->set_x(-axis(config.forwardAxis) *
+      this->maxForwardVel);
+  msg.mutable_linear()->set_z(-axis(config.verticalAxis) *
+      this->maxVerticalVel);
+  msg.mutable_angular()->set_z(-axis(config.yawAxis) * this->maxYawVel);
+  return msg;
+}
+
+/////////////////////////////////////////////////
+void TeleopPrivate::SetCommand(const msgs::Twist &_msg, bool _fromGamepad)
+{
+  // At a fixed rate, only the setpoint is updated, and the publisher
+  // thread publishes it
+  if (this->fixedRate)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->cmdMutex);
+      this->cmd = _msg;
+      this->cmdChanged = true;
+      this->cmdFromGamepad = _fromGamepad;
+    }
+    this->cmdCv.notify_one();
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(this->cmdMutex);
+  auto pub = this->cmdVelPub;
+  auto topicName = this->topic;
+  lock.unlock();
+
+  if (!pub.Publish(_msg))
+  {
+    gzerr << "gz::msgs::Twist message couldn't be published at topic: "
+      << topicName << std::endl;
+  }
+}
+
 /////////////////////////////////////////////////
 Teleop::Teleop(): Plugin(), dataPtr(std::make_unique<TeleopPrivate>())
 {
@@ -120,7 +485,24 @@ Teleop::Teleop(): Plugin(), dataPtr(std::make_unique<TeleopPrivate>())
 }
 
 /////////////////////////////////////////////////
-Teleop::~Teleop() = default;
+Teleop::~Teleop()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->cmdMutex);
+    this->dataPtr->stopGamepad = true;
+  }
+  this->dataPtr->gamepadCv.notify_all();
+  if (this->dataPtr->gamepadThread.joinable())
+    this->dataPtr->gamepadThread.join();
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->cmdMutex);
+    this->dataPtr->stopPublisher = true;
+  }
+  this->dataPtr->cmdCv.notify_all();
+  if (this->dataPtr->publisherThread.joinable())
+    this->dataPtr->publisherThread.join();
+}
 
 /////////////////////////////////////////////////
 void Teleop::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
@@ -133,9 +515,135 @@ void Teleop::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
     auto topicElem = _pluginElem->FirstChildElement("topic");
     if (nullptr != topicElem && nullptr != topicElem->GetText())
       this->SetTopic(topicElem->GetText());
+
+    auto rateElem = _pluginElem->FirstChildElement("rate");
+    if (nullptr != rateElem)
+    {
+      double rate{0.0};
+      if (rateElem->QueryDoubleText(&rate) != tinyxml2::XML_SUCCESS ||
+          rate < 0.0)
+      {
+        gzerr << "Invalid <rate>, publishing only on changes" << std::endl;
+      }
+      else
+      {
+        this->dataPtr->rate = rate;
+      }
+    }
+
+    auto deadmanElem = _pluginElem->FirstChildElement("deadman_timeout");
+    if (nullptr != deadmanElem)
+    {
+      double timeout{0.0};
+      if (deadmanElem->QueryDoubleText(&timeout) != tinyxml2::XML_SUCCESS ||
+          timeout < 0.0)
+      {
+        gzerr << "Invalid <deadman_timeout>, using "
+              << this->dataPtr->deadmanTimeout.count() << " s" << std::endl;
+      }
+      else
+      {
+        this->dataPtr->deadmanTimeout =
+            std::chrono::duration<double>(timeout);
+      }
+    }
+
+    auto gamepadElem = _pluginElem->FirstChildElement("gamepad");
+    if (nullptr != gamepadElem)
+    {
+      this->dataPtr->gamepadEnabled = true;
+      auto &gamepad = this->dataPtr->gamepad;
+
+      auto elem = gamepadElem->FirstChildElement("device");
+      if (nullptr != elem && nullptr != elem->GetText())
+        gamepad.device = elem->GetText();
+
+      elem = gamepadElem->FirstChildElement("rate");
+      if (nullptr != elem)
+      {
+        double rate{0.0};
+        if (elem->QueryDoubleText(&rate) != tinyxml2::XML_SUCCESS ||
+            rate < 1.0)
+        {
+          gzerr << "Invalid gamepad <rate>, using " << gamepad.rate
+                << " Hz" << std::endl;
+        }
+        else
+        {
+          gamepad.rate = rate;
+        }
+      }
+
+      elem = gamepadElem->FirstChildElement("deadzone");
+      if (nullptr != elem)
+      {
+        double deadzone{0.0};
+        if (elem->QueryDoubleText(&deadzone) != tinyxml2::XML_SUCCESS ||
+            deadzone < 0.0 || deadzone >= 1.0)
+        {
+          gzerr << "Invalid <deadzone>, expected [0, 1), using "
+                << gamepad.deadzone << std::endl;
+        }
+        else
+        {
+          gamepad.deadzone = deadzone;
+        }
+      }
+
+      auto parseIndex = [&](const char *_name, int &_index)
+      {
+        auto indexElem = gamepadElem->FirstChildElement(_name);
+        if (nullptr != indexElem &&
+            indexElem->QueryIntText(&_index) != tinyxml2::XML_SUCCESS)
+        {
+          gzerr << "Invalid <" << _name << ">, expected an index or -1"
+                << std::endl;
+        }
+      };
+      parseIndex("forward_axis", gamepad.forwardAxis);
+      parseIndex("vertical_axis", gamepad.verticalAxis);
+      parseIndex("yaw_axis", gamepad.yawAxis);
+      parseIndex("enable_button", gamepad.enableButton);
+    }
   }
 
   App()->findChild<MainWindow *>()->QuickWindow()->installEventFilter(this);
+
+  if (this->dataPtr->rate > 0.0 &&
+      !this->dataPtr->publisherThread.joinable())
+  {
+    // The GUI thread only proves it's alive, the publisher thread checks
+    auto beat = [this]
+    {
+      this->dataPtr->heartbeat =
+          std::chrono::steady_clock::now().time_since_epoch().count();
+    };
+    beat();
+    if (this->dataPtr->deadmanTimeout.count() > 0.0)
+    {
+      this->connect(&this->dataPtr->heartbeatTimer, &QTimer::timeout, this,
+          beat);
+      auto interval = std::chrono::duration<double, std::milli>(
+          this->dataPtr->deadmanTimeout).count() / 4.0;
+      this->dataPtr->heartbeatTimer.start(
+          std::clamp(static_cast<int>(interval), 1, 100));
+    }
+
+    this->dataPtr->fixedRate = true;
+    this->dataPtr->publisherThread =
+        std::thread(&TeleopPrivate::PublishLoop, this->dataPtr.get());
+  }
+
+  if (this->dataPtr->gamepadEnabled &&
+      !this->dataPtr->gamepadThread.joinable())
+  {
+#ifdef __linux__
+    this->dataPtr->gamepadThread =
+        std::thread(&TeleopPrivate::GamepadLoop, this->dataPtr.get());
+#else
+    gzwarn << "Gamepads are only supported on Linux" << std::endl;
+#endif
+  }
 }
 
 /////////////////////////////////////////////////
@@ -148,11 +656,7 @@ void Teleop::OnTeleopTwist(double _forwardVel, double _verticalVel,
   cmdVelMsg.mutable_linear()->set_z(_verticalVel);
   cmdVelMsg.mutable_angular()->set_z(_angVel);
 
-  if (!this->dataPtr->cmdVelPub.Publish(cmdVelMsg))
-  {
-    gzerr << "gz::msgs::Twist message couldn't be published at topic: "
-      << this->dataPtr->topic << std::endl;
-  }
+  this->dataPtr->SetCommand(cmdVelMsg, false);
 }
 
 /////////////////////////////////////////////////
@@ -164,6 +668,7 @@ QString Teleop::Topic() const
 /////////////////////////////////////////////////
 void Teleop::SetTopic(const QString &_topic)
 {
+  std::unique_lock<std::mutex> lock(this->dataPtr->cmdMutex);
   this->dataPtr->topic = _topic.toStdString();
   gzmsg << "A new topic has been entered: '" <<
       this->dataPtr->topic << " ' " <<std::endl;
@@ -173,7 +678,10 @@ void Teleop::SetTopic(const QString &_topic)
   this->dataPtr->cmdVelPub =
       this->dataPtr->node.Advertise<msgs::Twist>
       (this->dataPtr->topic);
-  if (!this->dataPtr->cmdVelPub)
+  bool advertised = static_cast<bool>(this->dataPtr->cmdVelPub);
+  lock.unlock();
+
+  if (!advertised)
   {
     App()->findChild<MainWindow *>()->notifyWithDuration(
       QString::fromStdString("Error when advertising topic: " +
@@ -193,7 +701,10 @@ void Teleop::SetTopic(const QString &_topic)
 /////////////////////////////////////////////////
 void Teleop::SetMaxForwardVel(double _velocity)
 {
-  this->dataPtr->maxForwardVel = _velocity;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->cmdMutex);
+    this->dataPtr->maxForwardVel = _velocity;
+  }
   this->MaxForwardVelChanged();
 }
 
@@ -206,7 +717,10 @@ double Teleop::MaxForwardVel() const
 /////////////////////////////////////////////////
 void Teleop::SetMaxVerticalVel(double _velocity)
 {
-  this->dataPtr->maxVerticalVel = _velocity;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->cmdMutex);
+    this->dataPtr->maxVerticalVel = _velocity;
+  }
   this->MaxVerticalVelChanged();
 }
 
@@ -219,7 +733,10 @@ double Teleop::MaxVerticalVel() const
 /////////////////////////////////////////////////
 void Teleop::SetMaxYawVel(double _velocity)
 {
-  this->dataPtr->maxYawVel = _velocity;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->cmdMutex);
+    this->dataPtr->maxYawVel = _velocity;
+  }
   this->MaxYawVelChanged();
 }
 
@@ -326,5 +843,4 @@ void Teleop::SetKeyScale()
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(Teleop,
-              gui::Plugin)
+GZ_GUI_ADD_PLUGIN(Teleop, "Teleop")
@@ -49,6 +49,31 @@ namespace plugins
   /// vehicle in the world.
   /// ## Configuration
   /// * `<topic>`: Topic to publish twist messages to.
+  /// * `<rate>`: Rate in Hz at which the current command is published, from
+  ///   a dedicated thread, so it's regular however busy the GUI is. A new
+  ///   command is published right away. Defaults to 0, which publishes
+  ///   only when the command changes.
+  /// * `<deadman_timeout>`: With a rate, zero velocities are published
+  ///   while the GUI thread doesn't respond for this many seconds.
+  ///   Defaults to 0.5, 0 disables it. Commands of the gamepad aren't
+  ///   affected, since it doesn't depend on the GUI thread.
+  /// * `<gamepad>`: Drive with a joystick or gamepad, read on a dedicated
+  ///   thread as soon as its axes move, without going through the Qt event
+  ///   loop. Only changes are sent, so the other inputs still work while
+  ///   the sticks are centered. Linux only, through the joystick API.
+  ///   * `<device>`: Joystick device, defaults to `/dev/input/js0`. It's
+  ///     opened again if it's unplugged.
+  ///   * `<rate>`: Rate in Hz at which the thread wakes up when no event
+  ///     arrives, defaults to 250.
+  ///   * `<forward_axis>`, `<vertical_axis>`, `<yaw_axis>`: Axes of each
+  ///     velocity, scaled to the maximum velocities, -1 for none. Default
+  ///     to 1, 4 and 0, the vertical axis of the left stick, the vertical
+  ///     axis of the right stick and the horizontal axis of the left stick
+  ///     on most gamepads.
+  ///   * `<deadzone>`: Fraction of each axis' range around its center
+  ///     which is ignored, defaults to 0.1.
+  ///   * `<enable_button>`: Button which must be held for the axes to move
+  ///     the vehicle, releasing it stops it. Defaults to -1, for none.
   class Teleop_EXPORTS_API Teleop : public Plugin
   {
     Q_OBJECT
@@ -98,6 +123,8 @@ namespace plugins
     protected: bool eventFilter(QObject *_obj, QEvent *_event) override;
 
     /// \brief Publish the twist message to the selected command velocity topic.
+    /// With a `<rate>`, it's set as the command the publisher thread
+    /// publishes.
     /// \param[in] _forwardVel Forward velocity
     /// \param[in] _verticalVel Vertical velocity
     /// \param[in] _angVel Yaw velocity
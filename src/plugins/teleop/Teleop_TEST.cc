@@ -17,9 +17,24 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/joystick.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <gz/msgs/stringmsg.pb.h>
 #include <gz/msgs/twist.pb.h>
 
+#include <gz/common/Filesystem.hh>
 #include <gz/utils/ExtraTestMacros.hh>
 
 #include "test_config.hh"  // NOLINT(build/include)
@@ -239,3 +254,175 @@ TEST_F(TeleopTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(KeyboardCommand))
   this->verticalVel = 0.0;
   this->KeyEvent(false, Qt::Key_E);
 }
+
+/////////////////////////////////////////////////
+TEST(TeleopRateTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(FixedRate))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  const std::string kTopic{"/test/cmd_vel_rate"};
+  std::mutex mutex;
+  msgs::Twist last;
+  std::atomic<int> count{0};
+  transport::Node node;
+  std::function<void(const msgs::Twist &)> cb =
+      [&](const msgs::Twist &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        last = _msg;
+        ++count;
+      };
+  EXPECT_TRUE(node.Subscribe(kTopic, cb));
+
+  std::string pluginStr =
+    "<plugin filename=\"Teleop\">"
+      "<topic>" + kTopic + "</topic>"
+      "<rate>50</rate>"
+      "<deadman_timeout>0.2</deadman_timeout>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr.c_str()));
+  EXPECT_TRUE(app.LoadPlugin("Teleop",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  auto teleops = win->findChildren<plugins::Teleop *>();
+  ASSERT_EQ(1, teleops.size());
+
+  auto lastX = [&]
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return last.linear().x();
+  };
+
+  // Published repeatedly, without further changes
+  teleops[0]->OnTeleopTwist(0.5, 0.0, 0.0);
+  auto start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start < std::chrono::seconds(1))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    QCoreApplication::processEvents();
+  }
+  EXPECT_GT(count, 25);
+  EXPECT_LT(count, 75);
+  EXPECT_DOUBLE_EQ(0.5, lastX());
+
+  // Still published while the GUI thread is blocked, but stopped once the
+  // deadman timeout expires
+  int before = count;
+  std::this_thread::sleep_for(std::chrono::milliseconds(600));
+  EXPECT_GT(count, before + 10);
+  EXPECT_DOUBLE_EQ(0.0, lastX());
+
+  // Resumed once the GUI thread responds
+  start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start <
+      std::chrono::milliseconds(300))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    QCoreApplication::processEvents();
+  }
+  EXPECT_DOUBLE_EQ(0.5, lastX());
+}
+
+#ifdef __linux__
+/////////////////////////////////////////////////
+TEST(TeleopGamepadTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Gamepad))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  // A pipe stands for the joystick device, events are written to it
+  auto device = common::joinPaths(PROJECT_BINARY_PATH, "teleop_test_js");
+  unlink(device.c_str());
+  ASSERT_EQ(0, mkfifo(device.c_str(), 0600));
+
+  const std::string kTopic{"/test/cmd_vel_gamepad"};
+  std::mutex mutex;
+  msgs::Twist last;
+  std::atomic<int> count{0};
+  transport::Node node;
+  std::function<void(const msgs::Twist &)> cb =
+      [&](const msgs::Twist &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        last = _msg;
+        ++count;
+      };
+  EXPECT_TRUE(node.Subscribe(kTopic, cb));
+
+  std::string pluginStr =
+    "<plugin filename=\"Teleop\">"
+      "<topic>" + kTopic + "</topic>"
+      "<rate>50</rate>"
+      "<deadman_timeout>0.2</deadman_timeout>"
+      "<gamepad>"
+        "<device>" + device + "</device>"
+        "<enable_button>0</enable_button>"
+      "</gamepad>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr.c_str()));
+  EXPECT_TRUE(app.LoadPlugin("Teleop",
+      pluginDoc.FirstChildElement("plugin")));
+
+  // Waits for the gamepad thread to open it
+  int fd = open(device.c_str(), O_WRONLY);
+  ASSERT_GE(fd, 0);
+
+  auto send = [fd](uint8_t _type, uint8_t _number, int16_t _value)
+  {
+    js_event event{0u, _value, _type, _number};
+    EXPECT_EQ(static_cast<ssize_t>(sizeof(event)),
+        write(fd, &event, sizeof(event)));
+  };
+
+  auto waitX = [&](double _x)
+  {
+    // The GUI thread is blocked, which doesn't stop the gamepad
+    for (int i = 0; i < 100; ++i)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count > 0 && last.linear().x() == _x)
+          return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+  };
+
+  // Ignored until the enable button is held
+  send(JS_EVENT_AXIS | JS_EVENT_INIT, 1, -32767);
+  send(JS_EVENT_BUTTON | JS_EVENT_INIT, 0, 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(0, count);
+
+  // Full forward, past the deadman timeout of the GUI thread
+  send(JS_EVENT_BUTTON, 0, 1);
+  EXPECT_TRUE(waitX(1.0));
+  std::this_thread::sleep_for(std::chrono::milliseconds(400));
+  EXPECT_TRUE(waitX(1.0));
+
+  // Inside the deadzone
+  send(JS_EVENT_AXIS, 1, -1000);
+  EXPECT_TRUE(waitX(0.0));
+
+  // Releasing the button stops the vehicle
+  send(JS_EVENT_AXIS, 1, 32767);
+  EXPECT_TRUE(waitX(-1.0));
+  send(JS_EVENT_BUTTON, 0, 0);
+  EXPECT_TRUE(waitX(0.0));
+
+  close(fd);
+  unlink(device.c_str());
+}
+#endif
@@ -0,0 +1,506 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include <gz/common/Console.hh>
+
+#include "EchoFilter.hh"
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+using google::protobuf::FieldDescriptor;
+using google::protobuf::internal::WireFormatLite;
+
+namespace
+{
+  /////////////////////////////////////////////////
+  std::string trim(const std::string &_str)
+  {
+    auto first = _str.find_first_not_of(" \t\n");
+    if (first == std::string::npos)
+      return std::string();
+    auto last = _str.find_last_not_of(" \t\n");
+    return _str.substr(first, last - first + 1);
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Parse a whole string as a number
+  bool parseNumber(const std::string &_str, double &_number)
+  {
+    if (_str.empty())
+      return false;
+    char *end{nullptr};
+    _number = std::strtod(_str.c_str(), &end);
+    return end == _str.c_str() + _str.size();
+  }
+}
+
+/////////////////////////////////////////////////
+bool EchoFilter::Parse(const std::string &_expression)
+{
+  *this = EchoFilter();
+
+  auto expr = trim(_expression);
+  if (expr.empty())
+    return true;
+
+  auto invalid = [&expr](const std::string &_reason)
+  {
+    gzerr << "Invalid filter [" << expr << "]: " << _reason
+          << ". Expected a field path, an operator and a value, such as "
+          << "[pose.position.x > 3]" << std::endl;
+    return false;
+  };
+
+  // Path
+  std::size_t pos{0};
+  while (pos < expr.size() &&
+      (std::isalnum(static_cast<unsigned char>(expr[pos])) ||
+       expr[pos] == '_' || expr[pos] == '.'))
+  {
+    ++pos;
+  }
+  std::vector<std::string> names;
+  std::stringstream path(expr.substr(0, pos));
+  std::string name;
+  while (std::getline(path, name, '.'))
+  {
+    if (name.empty())
+      return invalid("empty field name");
+    names.push_back(name);
+  }
+  if (names.empty())
+    return invalid("missing field path");
+
+  // Operator, the longest first so "<=" isn't read as "<"
+  static const std::pair<const char *, Op> kOps[] =
+  {
+    {"==", Op::kEqual},
+    {"!=", Op::kNotEqual},
+    {"<=", Op::kLessEqual},
+    {">=", Op::kGreaterEqual},
+    {"<", Op::kLess},
+    {">", Op::kGreater},
+    {"contains", Op::kContains},
+  };
+  while (pos < expr.size() &&
+      std::isspace(static_cast<unsigned char>(expr[pos])))
+  {
+    ++pos;
+  }
+  bool found{false};
+  Op op{Op::kEqual};
+  for (const auto &candidate : kOps)
+  {
+    auto length = std::strlen(candidate.first);
+    if (expr.compare(pos, length, candidate.first) == 0)
+    {
+      op = candidate.second;
+      pos += length;
+      found = true;
+      break;
+    }
+  }
+  if (!found)
+    return invalid("missing operator");
+
+  // Value
+  auto value = trim(expr.substr(pos));
+  if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'')
+      && value.back() == value.front())
+  {
+    value = value.substr(1, value.size() - 2);
+  }
+  else if (value.empty())
+  {
+    return invalid("missing value");
+  }
+
+  this->expression = expr;
+  this->names = names;
+  this->op = op;
+  this->text = value;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool EchoFilter::Empty() const
+{
+  return this->expression.empty();
+}
+
+/////////////////////////////////////////////////
+const std::string &EchoFilter::Expression() const
+{
+  return this->expression;
+}
+
+/////////////////////////////////////////////////
+bool EchoFilter::Resolve(const google::protobuf::Descriptor *_type)
+{
+  // Not retried for the same type, so errors are only reported once
+  this->type = _type;
+  this->path.clear();
+  this->repeated = false;
+
+  std::vector<const FieldDescriptor *> fields;
+  auto desc = _type;
+  for (const auto &name : this->names)
+  {
+    if (nullptr == desc)
+    {
+      gzerr << "Filter field [" << fields.back()->full_name()
+            << "] isn't a message, it has no field [" << name << "]"
+            << std::endl;
+      return false;
+    }
+    auto field = desc->FindFieldByName(name);
+    if (nullptr == field)
+    {
+      gzerr << "Filter field [" << name << "] isn't in ["
+            << desc->full_name() << "]" << std::endl;
+      return false;
+    }
+    fields.push_back(field);
+    this->repeated = this->repeated || field->is_repeated();
+    desc = field->message_type();
+  }
+
+  auto leaf = fields.back();
+  if (leaf->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE)
+  {
+    gzerr << "Filter field [" << leaf->full_name() << "] is a message, "
+          << "one of its fields is needed" << std::endl;
+    return false;
+  }
+
+  if (leaf->cpp_type() != FieldDescriptor::CPPTYPE_STRING)
+  {
+    auto enumValue = leaf->enum_type() ?
+        leaf->enum_type()->FindValueByName(this->text) : nullptr;
+    if (this->op == Op::kContains)
+    {
+      gzerr << "Filter operator [contains] needs a string field, ["
+            << leaf->full_name() << "] isn't" << std::endl;
+      return false;
+    }
+    else if (nullptr != enumValue)
+    {
+      this->number = enumValue->number();
+    }
+    else if (leaf->cpp_type() == FieldDescriptor::CPPTYPE_BOOL &&
+        (this->text == "true" || this->text == "false"))
+    {
+      this->number = this->text == "true" ? 1.0 : 0.0;
+    }
+    else if (!parseNumber(this->text, this->number))
+    {
+      gzerr << "Filter value [" << this->text << "] isn't a valid value of ["
+            << leaf->full_name() << "]" << std::endl;
+      return false;
+    }
+  }
+
+  this->path = fields;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool EchoFilter::Matches(const google::protobuf::Descriptor *_type,
+    const char *_data, std::size_t _size)
+{
+  if (this->Empty())
+    return true;
+
+  if (_type != this->type)
+    this->Resolve(_type);
+  if (this->path.empty())
+    return false;
+
+  google::protobuf::io::CodedInputStream input(
+      reinterpret_cast<const uint8_t *>(_data), static_cast<int>(_size));
+  bool found{false};
+  bool matched{false};
+  if (!this->Scan(input, 0u, found, matched))
+    return false;
+  if (matched || found || this->repeated)
+    return matched;
+
+  // Fields which aren't set have their default value
+  auto leaf = this->path.back();
+  switch (leaf->cpp_type())
+  {
+    case FieldDescriptor::CPPTYPE_STRING:
+      return this->Test(leaf->default_value_string());
+    case FieldDescriptor::CPPTYPE_INT32:
+      return this->Test(static_cast<double>(leaf->default_value_int32()));
+    case FieldDescriptor::CPPTYPE_INT64:
+      return this->Test(static_cast<double>(leaf->default_value_int64()));
+    case FieldDescriptor::CPPTYPE_UINT32:
+      return this->Test(static_cast<double>(leaf->default_value_uint32()));
+    case FieldDescriptor::CPPTYPE_UINT64:
+      return this->Test(static_cast<double>(leaf->default_value_uint64()));
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      return this->Test(leaf->default_value_double());
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      return this->Test(static_cast<double>(leaf->default_value_float()));
+    case FieldDescriptor::CPPTYPE_BOOL:
+      return this->Test(leaf->default_value_bool() ? 1.0 : 0.0);
+    case FieldDescriptor::CPPTYPE_ENUM:
+      return this->Test(
+          static_cast<double>(leaf->default_value_enum()->number()));
+    default:
+      return false;
+  }
+}
+
+/////////////////////////////////////////////////
+bool EchoFilter::Scan(google::protobuf::io::CodedInputStream &_input,
+    std::size_t _depth, bool &_found, bool &_matched)
+{
+  auto field = this->path[_depth];
+  bool leaf = _depth + 1 == this->path.size();
+  while (true)
+  {
+    // 0 at the end of the message or of the submessage
+    auto tag = _input.ReadTag();
+    if (tag == 0)
+      return true;
+
+    auto wireType = WireFormatLite::GetTagWireType(tag);
+    bool delimited = wireType == WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+    if (WireFormatLite::GetTagFieldNumber(tag) != field->number() ||
+        (!leaf && !delimited))
+    {
+      if (!WireFormatLite::SkipField(&_input, tag))
+        return false;
+      continue;
+    }
+
+    // Only the submessages on the path are entered
+    if (!leaf)
+    {
+      uint32_t length{0};
+      if (!_input.ReadVarint32(&length))
+        return false;
+      auto limit = _input.PushLimit(static_cast<int>(length));
+      bool ok = this->Scan(_input, _depth + 1, _found, _matched);
+      _input.PopLimit(limit);
+      if (!ok || _matched)
+        return ok;
+      continue;
+    }
+
+    // Repeated numbers may be packed, one after the other
+    if (delimited && field->cpp_type() != FieldDescriptor::CPPTYPE_STRING)
+    {
+      uint32_t length{0};
+      if (!_input.ReadVarint32(&length))
+        return false;
+      auto limit = _input.PushLimit(static_cast<int>(length));
+      while (_input.BytesUntilLimit() > 0 && !_matched)
+      {
+        if (!this->ReadValue(_input, _matched))
+          return false;
+      }
+      _input.PopLimit(limit);
+    }
+    else if (wireType != WireFormatLite::WireTypeForFieldType(
+        static_cast<WireFormatLite::FieldType>(field->type())))
+    {
+      if (!WireFormatLite::SkipField(&_input, tag))
+        return false;
+      continue;
+    }
+    else if (!this->ReadValue(_input, _matched))
+    {
+      return false;
+    }
+
+    _found = true;
+    if (_matched)
+      return true;
+  }
+}
+
+/////////////////////////////////////////////////
+bool EchoFilter::ReadValue(google::protobuf::io::CodedInputStream &_input,
+    bool &_matched) const
+{
+  uint32_t raw32{0};
+  uint64_t raw64{0};
+  double value{0.0};
+  switch (this->path.back()->type())
+  {
+    case FieldDescriptor::TYPE_DOUBLE:
+    {
+      if (!_input.ReadLittleEndian64(&raw64))
+        return false;
+      std::memcpy(&value, &raw64, sizeof(value));
+      break;
+    }
+    case FieldDescriptor::TYPE_FLOAT:
+    {
+      if (!_input.ReadLittleEndian32(&raw32))
+        return false;
+      float single;
+      std::memcpy(&single, &raw32, sizeof(single));
+      value = single;
+      break;
+    }
+    case FieldDescriptor::TYPE_INT64:
+      if (!_input.ReadVarint64(&raw64))
+        return false;
+      value = static_cast<double>(static_cast<int64_t>(raw64));
+      break;
+    case FieldDescriptor::TYPE_UINT64:
+      if (!_input.ReadVarint64(&raw64))
+        return false;
+      value = static_cast<double>(raw64);
+      break;
+    // Negative ones take 10 bytes, like 64 bit ones
+    case FieldDescriptor::TYPE_INT32:
+    case FieldDescriptor::TYPE_ENUM:
+      if (!_input.ReadVarint64(&raw64))
+        return false;
+      value = static_cast<int32_t>(raw64);
+      break;
+    case FieldDescriptor::TYPE_UINT32:
+      if (!_input.ReadVarint32(&raw32))
+        return false;
+      value = raw32;
+      break;
+    case FieldDescriptor::TYPE_BOOL:
+      if (!_input.ReadVarint64(&raw64))
+        return false;
+      value = raw64 != 0u ? 1.0 : 0.0;
+      break;
+    case FieldDescriptor::TYPE_SINT32:
+      if (!_input.ReadVarint32(&raw32))
+        return false;
+      value = WireFormatLite::ZigZagDecode32(raw32);
+      break;
+    case FieldDescriptor::TYPE_SINT64:
+      if (!_input.ReadVarint64(&raw64))
+        return false;
+      value = static_cast<double>(WireFormatLite::ZigZagDecode64(raw64));
+      break;
+    case FieldDescriptor::TYPE_FIXED32:
+      if (!_input.ReadLittleEndian32(&raw32))
+        return false;
+      value = raw32;
+      break;
+    case FieldDescriptor::TYPE_SFIXED32:
+      if (!_input.ReadLittleEndian32(&raw32))
+        return false;
+      value = static_cast<int32_t>(raw32);
+      break;
+    case FieldDescriptor::TYPE_FIXED64:
+      if (!_input.ReadLittleEndian64(&raw64))
+        return false;
+      value = static_cast<double>(raw64);
+      break;
+    case FieldDescriptor::TYPE_SFIXED64:
+      if (!_input.ReadLittleEndian64(&raw64))
+        return false;
+      value = static_cast<double>(static_cast<int64_t>(raw64));
+      break;
+    case FieldDescriptor::TYPE_STRING:
+    case FieldDescriptor::TYPE_BYTES:
+    {
+      std::string str;
+      if (!_input.ReadVarint32(&raw32) ||
+          !_input.ReadString(&str, static_cast<int>(raw32)))
+      {
+        return false;
+      }
+      _matched = this->Test(str);
+      return true;
+    }
+    default:
+      return false;
+  }
+
+  _matched = this->Test(value);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool EchoFilter::Test(double _value) const
+{
+  switch (this->op)
+  {
+    case Op::kEqual:
+      return _value == this->number;
+    case Op::kNotEqual:
+      return _value != this->number;
+    case Op::kLess:
+      return _value < this->number;
+    case Op::kLessEqual:
+      return _value <= this->number;
+    case Op::kGreater:
+      return _value > this->number;
+    case Op::kGreaterEqual:
+      return _value >= this->number;
+    default:
+      return false;
+  }
+}
+
+/////////////////////////////////////////////////
+bool EchoFilter::Test(const std::string &_value) const
+{
+  switch (this->op)
+  {
+    case Op::kEqual:
+      return _value == this->text;
+    case Op::kNotEqual:
+      return _value != this->text;
+    case Op::kLess:
+      return _value < this->text;
+    case Op::kLessEqual:
+      return _value <= this->text;
+    case Op::kGreater:
+      return _value > this->text;
+    case Op::kGreaterEqual:
+      return _value >= this->text;
+    case Op::kContains:
+      return _value.find(this->text) != std::string::npos;
+    default:
+      return false;
+  }
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TOPICECHO_ECHOFILTER_HH_
+#define GZ_GUI_PLUGINS_TOPICECHO_ECHOFILTER_HH_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+#include <google/protobuf/descriptor.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+namespace google
+{
+namespace protobuf
+{
+namespace io
+{
+  class CodedInputStream;
+}
+}
+}
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Predicate on a field of serialized messages, such as
+  /// `pose.position.x > 3` or `header.data.key == "frame"`.
+  ///
+  /// An expression is a path of field names separated by dots, an
+  /// operator among `==`, `!=`, `<`, `<=`, `>`, `>=` and `contains`, and
+  /// a value. Numbers, booleans and enums are compared as numbers, enums
+  /// may be given by name, and strings are compared as strings, quoted or
+  /// not. A message matches if any element of the repeated fields on the
+  /// path does.
+  ///
+  /// Messages are matched on their wire format: only the fields on the
+  /// path are decoded, the others are skipped, so large messages, such as
+  /// images, are cheap to match.
+  ///
+  /// It isn't thread safe, since the path is resolved for the type of the
+  /// messages matched.
+  class EchoFilter
+  {
+    /// \brief Operator
+    public: enum class Op
+    {
+      kEqual,
+      kNotEqual,
+      kLess,
+      kLessEqual,
+      kGreater,
+      kGreaterEqual,
+      kContains
+    };
+
+    /// \brief Parse an expression.
+    /// \param[in] _expression Expression, empty to match everything
+    /// \return False if it's invalid, the filter is left empty then
+    public: bool Parse(const std::string &_expression);
+
+    /// \brief Get whether it matches every message
+    /// \return True if no expression was parsed
+    public: bool Empty() const;
+
+    /// \brief Get the expression
+    /// \return Expression, empty if none
+    public: const std::string &Expression() const;
+
+    /// \brief Check whether a serialized message matches.
+    /// \param[in] _type Type of the message
+    /// \param[in] _data Serialized message
+    /// \param[in] _size Size of the serialized message
+    /// \return False if it doesn't match, can't be parsed or the path
+    /// doesn't exist in its type
+    public: bool Matches(const google::protobuf::Descriptor *_type,
+                         const char *_data, std::size_t _size);
+
+    /// \brief Resolve the path for a type, once per type.
+    /// \param[in] _type Message type
+    /// \return False if the path or value don't fit the type
+    private: bool Resolve(const google::protobuf::Descriptor *_type);
+
+    /// \brief Go through the fields of a message, or of a submessage
+    /// within the stream's limit.
+    /// \param[in] _input Stream positioned at the first field
+    /// \param[in] _depth Index of the path's field to look for
+    /// \param[out] _found Set to true if the last field of the path was
+    /// found
+    /// \param[out] _matched Set to true if a value matched
+    /// \return False if the message can't be parsed
+    private: bool Scan(google::protobuf::io::CodedInputStream &_input,
+                       std::size_t _depth, bool &_found, bool &_matched);
+
+    /// \brief Read a value of the last field of the path and test it.
+    /// \param[in] _input Stream positioned at the value
+    /// \param[out] _matched Set to true if the value matched
+    /// \return False if the value can't be read
+    private: bool ReadValue(google::protobuf::io::CodedInputStream &_input,
+                            bool &_matched) const;
+
+    /// \brief Test a number
+    /// \param[in] _value Value of the field
+    /// \return True if it matches
+    private: bool Test(double _value) const;
+
+    /// \brief Test a string
+    /// \param[in] _value Value of the field
+    /// \return True if it matches
+    private: bool Test(const std::string &_value) const;
+
+    /// \brief Expression
+    private: std::string expression;
+
+    /// \brief Field names of the path
+    private: std::vector<std::string> names;
+
+    /// \brief Operator
+    private: Op op{Op::kEqual};
+
+    /// \brief Value as written, without quotes
+    private: std::string text;
+
+    /// \brief Value as a number, for numeric fields
+    private: double number{0.0};
+
+    /// \brief Type the path was resolved for
+    private: const google::protobuf::Descriptor *type{nullptr};
+
+    /// \brief Fields of the path for type, empty if it doesn't fit
+    private: std::vector<const google::protobuf::FieldDescriptor *> path;
+
+    /// \brief True if a field of the path is repeated, messages without
+    /// the field don't match then, instead of matching on its default
+    private: bool repeated{false};
+  };
+}
+}
+}
+
+#endif
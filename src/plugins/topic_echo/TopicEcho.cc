@@ -15,27 +15,198 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+
 #include <gz/common/Console.hh>
+#include <gz/msgs/Factory.hh>
 #include <gz/plugin/Register.hh>
+#include <gz/transport/MessageInfo.hh>
 #include <gz/transport/Node.hh>
 
 #include "gz/gui/Application.hh"
+#include "gz/gui/QueueStats.hh"
+#include "gz/gui/StaticPlugins.hh"
+#include "EchoFilter.hh"
 #include "TopicEcho.hh"
 
+// Period over which the message rate and bandwidth are measured, in ms
+#define STATS_PERIOD (1000)
+
+// Maximum number of messages waiting to be matched against the filter,
+// the oldest are dropped beyond it
+#define MAX_PENDING (1000u)
+
 namespace gz
 {
 namespace gui
 {
 namespace plugins
 {
+  /// \brief Message received, kept serialized until it's displayed
+  struct EchoMsg
+  {
+    /// \brief Empty message of the received type, to parse it
+    std::shared_ptr<const google::protobuf::Message> prototype;
+
+    /// \brief Serialized message
+    std::string data;
+
+    /// \brief Text of the message, set the first time it's displayed
+    QString text;
+
+    /// \brief True once text is set
+    bool formatted{false};
+
+    /// \brief Get the memory used by the message
+    /// \return Bytes of the serialized message or of its text
+    std::size_t Bytes() const
+    {
+      return this->data.size() +
+          static_cast<std::size_t>(this->text.size()) * sizeof(QChar);
+    }
+  };
+
+  /// \brief List of the last messages. Messages are only converted to
+  /// text when the view asks for their row.
+  class EchoModel : public QAbstractListModel
+  {
+    /// \brief Append messages, removing the oldest beyond a size.
+    /// \param[in] _msgs Messages, oldest first
+    /// \param[in] _size Maximum number of messages
+    public: void Append(std::deque<EchoMsg> &_msgs, int _size)
+    {
+      if (!_msgs.empty())
+      {
+        int first = static_cast<int>(this->msgs.size());
+        this->beginInsertRows(QModelIndex(), first,
+            first + static_cast<int>(_msgs.size()) - 1);
+        for (auto &msg : _msgs)
+        {
+          this->bytes += msg.Bytes();
+          this->msgs.push_back(std::move(msg));
+        }
+        this->endInsertRows();
+      }
+      this->Trim(_size);
+    }
+
+    /// \brief Remove the oldest messages beyond a size.
+    /// \param[in] _size Maximum number of messages
+    public: void Trim(int _size)
+    {
+      int diff = static_cast<int>(this->msgs.size()) - std::max(_size, 0);
+      if (diff <= 0)
+        return;
+
+      this->beginRemoveRows(QModelIndex(), 0, diff - 1);
+      for (int i = 0; i < diff; ++i)
+        this->bytes -= this->msgs[i].Bytes();
+      this->msgs.erase(this->msgs.begin(), this->msgs.begin() + diff);
+      this->endRemoveRows();
+    }
+
+    /// \brief Remove the oldest messages beyond a limit.
+    /// \param[in] _limit Limit
+    /// \return Number of messages removed
+    public: int TrimToLimit(const QueueStats::Limit &_limit)
+    {
+      int size = static_cast<int>(this->msgs.size());
+      std::size_t remaining = this->bytes;
+      while (size > 0 &&
+          _limit.Exceeded(static_cast<uint64_t>(size), remaining))
+      {
+        remaining -= this->msgs[this->msgs.size() - size].Bytes();
+        --size;
+      }
+
+      int removed = static_cast<int>(this->msgs.size()) - size;
+      this->Trim(size);
+      return removed;
+    }
+
+    /// \brief Get the memory used by the messages
+    /// \return Bytes
+    public: std::size_t Bytes() const
+    {
+      return this->bytes;
+    }
+
+    // Documentation inherited
+    public: int rowCount(
+        const QModelIndex &_parent = QModelIndex()) const override
+    {
+      if (_parent.isValid())
+        return 0;
+      return static_cast<int>(this->msgs.size());
+    }
+
+    // Documentation inherited
+    public: QVariant data(const QModelIndex &_index,
+        int _role = Qt::DisplayRole) const override
+    {
+      if (!_index.isValid() || _index.row() >= this->rowCount() ||
+          _role != Qt::DisplayRole)
+      {
+        return QVariant();
+      }
+
+      auto &msg = this->msgs[_index.row()];
+      if (!msg.formatted)
+      {
+        this->bytes -= msg.Bytes();
+        std::unique_ptr<google::protobuf::Message> parsed(
+            msg.prototype->New());
+        if (parsed->ParseFromString(msg.data))
+          msg.text = QString::fromStdString(parsed->DebugString());
+        else
+          msg.text = "Failed to parse message";
+        msg.formatted = true;
+        msg.data.clear();
+        msg.data.shrink_to_fit();
+        this->bytes += msg.Bytes();
+      }
+      return msg.text;
+    }
+
+    /// \brief Messages, oldest first
+    private: mutable std::deque<EchoMsg> msgs;
+
+    /// \brief Memory used by the messages
+    private: mutable std::size_t bytes{0u};
+  };
+
   class TopicEchoPrivate
   {
+    /// \brief Receives the serialized messages, on the transport thread.
+    /// \param[in] _data Serialized message
+    /// \param[in] _size Size of the serialized message
+    /// \param[in] _info Message information, with its type
+    public: void OnRawMessage(const char *_data, const size_t _size,
+                              const transport::MessageInfo &_info);
+
+    /// \brief Keep a message until the list is updated. Must be called
+    /// with the mutex locked.
+    /// \param[in] _msg Message
+    public: void Keep(EchoMsg &&_msg);
+
+    /// \brief Match the pending messages against the filter, on the
+    /// worker thread.
+    public: void MatchLoop();
+
     /// \brief Topic
     public: QString topic{"/echo"};
 
     /// \brief A list of text data.
-    public: QStringListModel msgList;
+    public: EchoModel msgList;
 
     /// \brief Size of the text buffer. The size is the number of
     /// messages.
@@ -47,6 +218,79 @@ namespace plugins
     /// \brief Mutex to protect message buffer.
     public: std::mutex mutex;
 
+    /// \brief Messages received since the list was last updated, at most
+    /// as many as the buffer size
+    public: std::deque<EchoMsg> received;
+
+    /// \brief Bytes of received
+    public: std::size_t receivedBytes{0u};
+
+    /// \brief Number of messages in the list, for the transport thread
+    public: std::atomic<uint64_t> listDepth{0u};
+
+    /// \brief Bytes of the messages in the list, for the transport thread
+    public: std::atomic<uint64_t> listBytes{0u};
+
+    /// \brief Reports the messages kept to QueueStats
+    public: QueueStats::Queue queue{"TopicEcho/messages", true};
+
+    /// \brief Prototype of the last type received, null if the type is
+    /// unknown
+    public: std::shared_ptr<const google::protobuf::Message> prototype;
+
+    /// \brief Name of the last type received
+    public: std::string prototypeType;
+
+    /// \brief Filter expression
+    public: QString filterText;
+
+    /// \brief Filter, null to show all messages. It's only used by the
+    /// worker, and replaced instead of modified.
+    public: std::shared_ptr<EchoFilter> filter;
+
+    /// \brief Messages waiting to be matched against the filter
+    public: std::deque<EchoMsg> pending;
+
+    /// \brief Notifies the worker of pending messages
+    public: std::condition_variable pendingCv;
+
+    /// \brief Incremented when the messages are cleared or the filter
+    /// changes, so the worker drops the ones it was matching
+    public: uint64_t generation{0u};
+
+    /// \brief Matches the messages against the filter, started with the
+    /// first filter
+    public: std::thread worker;
+
+    /// \brief Set to stop the worker
+    public: bool stopWorker{false};
+
+    /// \brief Messages received since the stats were last measured
+    public: uint64_t msgCount{0};
+
+    /// \brief Messages matching the filter since the stats were last
+    /// measured
+    public: uint64_t matchCount{0};
+
+    /// \brief Bytes received since the stats were last measured
+    public: uint64_t byteCount{0};
+
+    /// \brief When the stats were last measured
+    public: std::chrono::steady_clock::time_point statsTime{
+        std::chrono::steady_clock::now()};
+
+    /// \brief Measured messages per second
+    public: double rate{0.0};
+
+    /// \brief Measured bytes per second
+    public: double bandwidth{0.0};
+
+    /// \brief Measured messages matching the filter per second
+    public: double matchRate{0.0};
+
+    /// \brief Timer to update the list with the messages received
+    public: QTimer displayTimer;
+
     /// \brief Node for communication
     public: gz::transport::Node node;
   };
@@ -70,30 +314,78 @@ TopicEcho::TopicEcho()
 /////////////////////////////////////////////////
 TopicEcho::~TopicEcho()
 {
+  // Stop receiving before the buffers are destroyed
+  for (auto const &sub : this->dataPtr->node.SubscribedTopics())
+    this->dataPtr->node.Unsubscribe(sub);
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stopWorker = true;
+  }
+  this->dataPtr->pendingCv.notify_all();
+  if (this->dataPtr->worker.joinable())
+    this->dataPtr->worker.join();
 }
 
 /////////////////////////////////////////////////
-void TopicEcho::LoadConfig(const tinyxml2::XMLElement * /*_pluginElem*/)
+void TopicEcho::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
   if (this->title.empty())
     this->title = "Topic echo";
 
-  this->connect(this, SIGNAL(AddMsg(QString)), this, SLOT(OnAddMsg(QString)),
-          Qt::QueuedConnection);
+  // The list is updated at most this many times per second, however fast
+  // messages arrive
+  double maxRate{30.0};
+  if (_pluginElem)
+  {
+    auto rateElem = _pluginElem->FirstChildElement("max_rate");
+    if (nullptr != rateElem)
+    {
+      double rate{0.0};
+      if (rateElem->QueryDoubleText(&rate) == tinyxml2::XML_SUCCESS &&
+          rate > 0.0)
+      {
+        maxRate = rate;
+      }
+      else
+      {
+        gzerr << "Invalid <max_rate>, using [" << maxRate << "]"
+              << std::endl;
+      }
+    }
+
+    auto filterElem = _pluginElem->FirstChildElement("filter");
+    if (nullptr != filterElem && nullptr != filterElem->GetText())
+      this->SetFilter(QString::fromStdString(filterElem->GetText()));
+  }
+
+  this->connect(&this->dataPtr->displayTimer, &QTimer::timeout, this,
+      &TopicEcho::OnDisplay);
+  this->dataPtr->displayTimer.start(
+      std::max(1, static_cast<int>(1000.0 / maxRate)));
 }
 
 /////////////////////////////////////////////////
 void TopicEcho::Stop()
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  // Erase all previous messages
-  this->dataPtr->msgList.removeRows(0,
-      this->dataPtr->msgList.rowCount());
-
   // Unsubscribe
   for (auto const &sub : this->dataPtr->node.SubscribedTopics())
     this->dataPtr->node.Unsubscribe(sub);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // Erase all previous messages
+  ++this->dataPtr->generation;
+  this->dataPtr->pending.clear();
+  this->dataPtr->received.clear();
+  this->dataPtr->receivedBytes = 0u;
+  this->dataPtr->msgList.Trim(0);
+  this->dataPtr->listDepth = 0u;
+  this->dataPtr->listBytes = 0u;
+  this->dataPtr->queue.Update(0u, 0u);
+  this->dataPtr->msgCount = 0;
+  this->dataPtr->matchCount = 0;
+  this->dataPtr->byteCount = 0;
 }
 
 /////////////////////////////////////////////////
@@ -106,42 +398,173 @@ void TopicEcho::OnEcho(const bool _checked)
 
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  // Subscribe to new topic
+  // Subscribe to new topic. Messages are received serialized, they're
+  // only parsed to be matched against the filter or displayed.
   auto topic = this->dataPtr->topic.toStdString();
-  if (!this->dataPtr->node.Subscribe(topic, &TopicEcho::OnMessage, this))
+  auto data = this->dataPtr.get();
+  std::function<void(const char *, const size_t,
+      const transport::MessageInfo &)> cb =
+      [data](const char *_data, const size_t _size,
+          const transport::MessageInfo &_info)
+      {
+        data->OnRawMessage(_data, _size, _info);
+      };
+  if (!this->dataPtr->node.SubscribeRaw(topic, cb,
+      transport::kGenericMessageType, this->SubscribeOptions(topic)))
   {
     gzerr << "Invalid topic [" << topic << "]" << std::endl;
   }
 }
 
 /////////////////////////////////////////////////
-void TopicEcho::OnMessage(const google::protobuf::Message &_msg)
+void TopicEchoPrivate::OnRawMessage(const char *_data, const size_t _size,
+    const transport::MessageInfo &_info)
 {
-  if (this->dataPtr->paused)
+  if (this->paused)
     return;
 
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  // Kept serialized, it's only converted to text if displayed
+  EchoMsg msg;
+  msg.data.assign(_data, _size);
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  ++this->msgCount;
+  this->byteCount += _size;
 
-  this->AddMsg(QString::fromStdString(_msg.DebugString()));
+  if (this->prototypeType != _info.Type())
+  {
+    this->prototypeType = _info.Type();
+    this->prototype = msgs::Factory::New(_info.Type());
+    if (!this->prototype)
+    {
+      gzerr << "Unknown message type [" << _info.Type() << "] on ["
+            << _info.Topic() << "], its messages can't be shown"
+            << std::endl;
+    }
+  }
+  if (!this->prototype)
+    return;
+  msg.prototype = this->prototype;
+
+  if (!this->filter)
+  {
+    this->Keep(std::move(msg));
+    return;
+  }
+
+  // Slow matches drop the oldest messages rather than delay the newest
+  this->pending.push_back(std::move(msg));
+  if (this->pending.size() > MAX_PENDING)
+  {
+    this->pending.pop_front();
+    this->queue.Drop();
+  }
+  this->pendingCv.notify_one();
 }
 
 /////////////////////////////////////////////////
-void TopicEcho::OnAddMsg(QString _msg)
+void TopicEchoPrivate::Keep(EchoMsg &&_msg)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  // Messages which wouldn't fit the list are dropped right away
+  auto limit = this->queue.CurrentLimit();
+  if (limit.policy == QueueStats::DropPolicy::kDropNewest &&
+      limit.Exceeded(this->listDepth + this->received.size() + 1,
+      this->listBytes + this->receivedBytes + _msg.Bytes()))
+  {
+    this->queue.Drop();
+    return;
+  }
 
-  // Append msg to list
-  if (this->dataPtr->msgList.insertRow(this->dataPtr->msgList.rowCount()))
+  this->receivedBytes += _msg.Bytes();
+  this->received.push_back(std::move(_msg));
+  while (this->received.size() > this->buffer)
   {
-    auto index = this->dataPtr->msgList.index(
-        this->dataPtr->msgList.rowCount() - 1, 0);
-    this->dataPtr->msgList.setData(index, _msg);
+    this->receivedBytes -= this->received.front().Bytes();
+    this->received.pop_front();
   }
+  this->queue.Update(this->listDepth + this->received.size(),
+      this->listBytes + this->receivedBytes);
+}
+
+/////////////////////////////////////////////////
+void TopicEchoPrivate::MatchLoop()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    this->pendingCv.wait(lock, [this]
+        {
+          return this->stopWorker || !this->pending.empty();
+        });
+    if (this->stopWorker)
+      return;
+
+    std::deque<EchoMsg> batch;
+    batch.swap(this->pending);
+    auto currentFilter = this->filter;
+    auto currentGeneration = this->generation;
+    lock.unlock();
+
+    // Only the fields of the filter's path are decoded
+    std::deque<EchoMsg> matched;
+    for (auto &msg : batch)
+    {
+      if (!currentFilter || currentFilter->Matches(
+          msg.prototype->GetDescriptor(), msg.data.data(), msg.data.size()))
+      {
+        matched.push_back(std::move(msg));
+      }
+    }
+
+    lock.lock();
+    if (currentGeneration != this->generation)
+      continue;
+    for (auto &msg : matched)
+    {
+      ++this->matchCount;
+      this->Keep(std::move(msg));
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void TopicEcho::OnDisplay()
+{
+  std::deque<EchoMsg> received;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    received.swap(this->dataPtr->received);
+    this->dataPtr->receivedBytes = 0u;
+
+    // Stats
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration<double>(
+        now - this->dataPtr->statsTime).count();
+    if (elapsed * 1000.0 >= STATS_PERIOD)
+    {
+      this->dataPtr->rate = this->dataPtr->msgCount / elapsed;
+      this->dataPtr->bandwidth = this->dataPtr->byteCount / elapsed;
+      this->dataPtr->matchRate = this->dataPtr->matchCount / elapsed;
+      this->dataPtr->msgCount = 0;
+      this->dataPtr->matchCount = 0;
+      this->dataPtr->byteCount = 0;
+      this->dataPtr->statsTime = now;
+      this->StatsChanged();
+    }
+  }
+
+  auto &list = this->dataPtr->msgList;
+  list.Append(received, static_cast<int>(this->dataPtr->buffer));
+
+  auto limit = this->dataPtr->queue.CurrentLimit();
+  if (limit.policy == QueueStats::DropPolicy::kDropOldest)
+    this->dataPtr->queue.Drop(static_cast<uint64_t>(list.TrimToLimit(limit)));
 
-  // Remove items if the list is too long.
-  auto diff = this->dataPtr->msgList.rowCount() -
-      this->dataPtr->buffer;
-  this->dataPtr->msgList.removeRows(0, diff);
+  this->dataPtr->listDepth = static_cast<uint64_t>(list.rowCount());
+  this->dataPtr->listBytes = list.Bytes();
+  this->dataPtr->queue.Update(this->dataPtr->listDepth,
+      this->dataPtr->listBytes);
 }
 
 /////////////////////////////////////////////////
@@ -160,6 +583,7 @@ void TopicEcho::SetTopic(const QString &_topic)
 /////////////////////////////////////////////////
 void TopicEcho::OnBuffer(const unsigned int _buffer)
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   this->dataPtr->buffer = _buffer;
 }
 
@@ -177,7 +601,62 @@ void TopicEcho::SetPaused(const bool &_paused)
   this->PausedChanged();
 }
 
-// Register this plugin
-GZ_ADD_PLUGIN(TopicEcho,
-              gui::Plugin)
+/////////////////////////////////////////////////
+double TopicEcho::Rate() const
+{
+  return this->dataPtr->rate;
+}
+
+/////////////////////////////////////////////////
+double TopicEcho::Bandwidth() const
+{
+  return this->dataPtr->bandwidth;
+}
 
+/////////////////////////////////////////////////
+double TopicEcho::MatchRate() const
+{
+  return this->dataPtr->matchRate;
+}
+
+/////////////////////////////////////////////////
+QString TopicEcho::Filter() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->filterText;
+}
+
+/////////////////////////////////////////////////
+void TopicEcho::SetFilter(const QString &_filter)
+{
+  auto filter = std::make_shared<EchoFilter>();
+  if (!filter->Parse(_filter.toStdString()))
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (filter->Empty())
+      filter.reset();
+    this->dataPtr->filter = filter;
+    this->dataPtr->filterText = _filter.trimmed();
+    ++this->dataPtr->generation;
+
+    // Pending messages are matched against the new filter
+    if (!filter)
+    {
+      for (auto &msg : this->dataPtr->pending)
+        this->dataPtr->Keep(std::move(msg));
+      this->dataPtr->pending.clear();
+    }
+    else if (!this->dataPtr->worker.joinable())
+    {
+      this->dataPtr->worker = std::thread(&TopicEchoPrivate::MatchLoop,
+          this->dataPtr.get());
+    }
+  }
+  this->dataPtr->pendingCv.notify_one();
+  this->FilterChanged();
+}
+
+// Register this plugin
+GZ_GUI_ADD_PLUGIN(TopicEcho, "TopicEcho")
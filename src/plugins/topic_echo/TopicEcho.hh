@@ -51,8 +51,24 @@ namespace plugins
 
   /// \brief Echo messages coming through a Gazebo Transport topic.
   ///
+  /// Messages are kept serialized and only converted to text when their
+  /// row is shown, and the list is updated at a limited rate, so fast
+  /// topics can be echoed. The measured message rate and bandwidth are
+  /// shown.
+  ///
+  /// The messages kept are reported to QueueStats as `TopicEcho/messages`.
+  /// A limit set on it also applies, besides the buffer size.
+  ///
+  /// A filter, such as `pose.position.x > 3`, only shows the messages
+  /// matching it, see EchoFilter. Messages are matched on a worker thread,
+  /// only decoding the fields of the filter, so a rare message on a fast
+  /// topic can be found without the GUI thread parsing every message.
+  ///
   /// ## Configuration
-  /// This plugin doesn't accept any custom configuration.
+  ///
+  /// \<max_rate\> : Maximum number of list updates per second, 30 by
+  ///                 default.
+  /// \<filter\> : Filter expression, all messages are shown by default.
   class TopicEcho_EXPORTS_API TopicEcho : public Plugin
   {
     Q_OBJECT
@@ -73,6 +89,35 @@ namespace plugins
       NOTIFY PausedChanged
     )
 
+    /// \brief Messages received per second
+    Q_PROPERTY(
+      double rate
+      READ Rate
+      NOTIFY StatsChanged
+    )
+
+    /// \brief Bytes received per second
+    Q_PROPERTY(
+      double bandwidth
+      READ Bandwidth
+      NOTIFY StatsChanged
+    )
+
+    /// \brief Messages matching the filter per second
+    Q_PROPERTY(
+      double matchRate
+      READ MatchRate
+      NOTIFY StatsChanged
+    )
+
+    /// \brief Filter expression
+    Q_PROPERTY(
+      QString filter
+      READ Filter
+      WRITE SetFilter
+      NOTIFY FilterChanged
+    )
+
     /// \brief Constructor
     public: TopicEcho();
 
@@ -108,13 +153,36 @@ namespace plugins
     /// \brief Notify that paused has changed
     signals: void PausedChanged();
 
-    /// \brief Signal to add a message to the GUI list.
-    /// \param[in] _msg Text message to add.
-    signals: void AddMsg(QString _msg);
+    /// \brief Get the messages received per second, measured over the
+    /// last second
+    /// \return Message rate
+    public: double Rate() const;
+
+    /// \brief Get the bytes received per second, measured over the last
+    /// second
+    /// \return Bandwidth
+    public: double Bandwidth() const;
+
+    /// \brief Get the messages matching the filter per second, measured
+    /// over the last second
+    /// \return Match rate, 0 without a filter
+    public: double MatchRate() const;
+
+    /// \brief Notify that the rate and bandwidth have changed
+    signals: void StatsChanged();
+
+    /// \brief Get the filter expression
+    /// \return Expression, empty if all messages are shown
+    public: Q_INVOKABLE QString Filter() const;
+
+    /// \brief Set the filter expression, for example 'data == "stop"'.
+    /// It applies to the messages received from then on.
+    /// \param[in] _filter Expression, empty to show all messages. The
+    /// current filter is kept if it's invalid.
+    public: Q_INVOKABLE void SetFilter(const QString &_filter);
 
-    /// \brief Receives incoming text messages.
-    /// \param[in] _msg New text message.
-    private: void OnMessage(const google::protobuf::Message &_msg);
+    /// \brief Notify that the filter has changed
+    signals: void FilterChanged();
 
     /// \brief Clear list and unsubscribe.
     private: void Stop();
@@ -122,9 +190,9 @@ namespace plugins
     /// \brief Callback when echo button is pressed
     public slots: void OnEcho(const bool _checked);
 
-    /// \brief Callback from the ::AddMsg signal.
-    /// \param[in] _msg Message to add to the list.
-    private slots: void OnAddMsg(QString _msg);
+    /// \brief Add the messages received since the last call to the list,
+    /// called by a timer.
+    private slots: void OnDisplay();
 
     /// \internal
     /// \brief Pointer to private data.
@@ -60,6 +60,26 @@ Rectangle {
       }
     }
 
+    Label {
+      text: "Filter"
+    }
+
+    TextField {
+      id: filterField
+      objectName: "filterField"
+      width: topicEcho.parent !== null ? topicEcho.parent.width - 20 : 280
+      text: TopicEcho.filter
+      placeholderText: qsTr("pose.position.x > 3")
+      selectByMouse: true
+      onEditingFinished: {
+        TopicEcho.filter = text
+      }
+      ToolTip.visible: hovered
+      ToolTip.delay: tooltipDelay
+      ToolTip.timeout: tooltipTimeout
+      ToolTip.text: qsTr("Only show messages where a field matches")
+    }
+
     Label {
       text: "Buffer"
     }
@@ -87,9 +107,17 @@ Rectangle {
       text: "Messages"
     }
 
+    Label {
+      objectName: "statsLabel"
+      text: TopicEcho.rate.toFixed(1) + " Hz, " +
+            (TopicEcho.bandwidth / 1024).toFixed(1) + " KB/s" +
+            (TopicEcho.filter.length > 0 ?
+             ", " + TopicEcho.matchRate.toFixed(1) + " Hz matching" : "")
+    }
+
     Rectangle {
       width: topicEcho.parent !== null ? topicEcho.parent.width - 20 : 50
-      height: topicEcho.parent !== null ? topicEcho.parent.height - 200 : 50
+      height: topicEcho.parent !== null ? topicEcho.parent.height - 270 : 50
       color: "transparent"
 
       ListView {
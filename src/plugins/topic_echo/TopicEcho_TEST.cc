@@ -40,6 +40,16 @@ char* g_argv[] =
 using namespace gz;
 using namespace gui;
 
+/////////////////////////////////////////////////
+/// \brief Get the text of all rows of the message list
+QStringList Rows(const QAbstractItemModel *_model)
+{
+  QStringList rows;
+  for (int i = 0; i < _model->rowCount(); ++i)
+    rows.push_back(_model->data(_model->index(i, 0)).toString());
+  return rows;
+}
+
 /////////////////////////////////////////////////
 TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Load))
 {
@@ -101,7 +111,7 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
   ASSERT_NE(msgList, nullptr);
   objProp = msgList->property("model");
   EXPECT_TRUE(objProp.isValid());
-  auto msgStringList = objProp.value<QStringListModel *>();
+  auto msgStringList = objProp.value<QAbstractItemModel *>();
   ASSERT_NE(msgStringList, nullptr);
   EXPECT_EQ(msgStringList->rowCount(), 0);
 
@@ -111,6 +121,11 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
   EXPECT_TRUE(bufferProp.isValid());
   EXPECT_EQ(bufferProp.toInt(), 10);
 
+  auto statsLabel = plugin->PluginItem()->findChild<QObject *>("statsLabel");
+  ASSERT_NE(statsLabel, nullptr);
+  EXPECT_TRUE(plugin->property("rate").isValid());
+  EXPECT_TRUE(plugin->property("bandwidth").isValid());
+
   auto pauseCheck = plugin->PluginItem()->findChild<QObject *>("pauseCheck");
   ASSERT_NE(pauseCheck, nullptr);
   auto pauseProp = pauseCheck->property("checked");
@@ -139,7 +154,7 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
 
   // Check message was echoed
   ASSERT_EQ(msgStringList->rowCount(), 1);
-  EXPECT_EQ(msgStringList->stringList()[0].toStdString(),
+  EXPECT_EQ(Rows(msgStringList)[0].toStdString(),
             "data: \"example string\"\n");
 
   // Publish more than buffer size (messages numbered 0 to 14)
@@ -160,8 +175,8 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
   // 13 and 14. There's a chance a lower number comes afterwards, but that's
   // just bad luck.
   sleep = 0;
-  while (msgStringList->stringList().filter(regExp13).count() == 0
-      && msgStringList->stringList().filter(regExp14).count() == 0
+  while (Rows(msgStringList).filter(regExp13).count() == 0
+      && Rows(msgStringList).filter(regExp14).count() == 0
       && sleep < maxSleep)
   {
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -182,7 +197,7 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
   for (auto i = 5; i < 15; ++i)
   {
     regExp.setPattern("*" + QString::number(i));
-    if (msgStringList->stringList().filter(regExp).count() > 0)
+    if (Rows(msgStringList).filter(regExp).count() > 0)
       ++count;
   }
   EXPECT_GE(count, 6u);
@@ -210,9 +225,9 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
   ASSERT_EQ(msgStringList->rowCount(), 11);
 
   // The last one is guaranteed to be the new message
-  EXPECT_EQ(msgStringList->stringList().last().toStdString(),
+  EXPECT_EQ(Rows(msgStringList).last().toStdString(),
             "data: \"new message\"\n")
-            << msgStringList->stringList().last().toStdString();
+            << Rows(msgStringList).last().toStdString();
 
   // Pause
   plugin->SetPaused(true);
@@ -232,9 +247,9 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
     ++sleep;
   }
   ASSERT_EQ(msgStringList->rowCount(), 11);
-  EXPECT_EQ(msgStringList->stringList().last().toStdString(),
+  EXPECT_EQ(Rows(msgStringList).last().toStdString(),
             "data: \"new message\"\n")
-            << msgStringList->stringList().last().toStdString();
+            << Rows(msgStringList).last().toStdString();
 
   // Decrease buffer
   bufferField->setProperty("value", 5);
@@ -260,9 +275,9 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
   ASSERT_EQ(msgStringList->rowCount(), 5);
 
   // The last message is still the new one
-  EXPECT_EQ(msgStringList->stringList().last().toStdString(),
+  EXPECT_EQ(Rows(msgStringList).last().toStdString(),
             "data: \"new message 2\"\n")
-            << msgStringList->stringList().last().toStdString();
+            << Rows(msgStringList).last().toStdString();
 
   // Stop echoing
   plugin->OnEcho(false);
@@ -271,3 +286,113 @@ TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Echo))
   // Cleanup
   plugins.clear();
 }
+
+/////////////////////////////////////////////////
+TEST(TopicEchoTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Filter))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(
+    common::joinPaths(std::string(PROJECT_BINARY_PATH), "lib"));
+
+  const char *pluginStr =
+    "<plugin filename=\"TopicEcho\">"
+      "<filter>data contains 7</filter>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+  EXPECT_TRUE(app.LoadPlugin("TopicEcho",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(win, nullptr);
+
+  auto plugins = win->findChildren<plugins::TopicEcho *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+  EXPECT_EQ(plugin->Filter(), "data contains 7");
+
+  // Invalid filters are ignored
+  plugin->SetFilter("data ~ 7");
+  EXPECT_EQ(plugin->Filter(), "data contains 7");
+
+  auto msgList = plugin->PluginItem()->findChild<QQuickItem *>("listView");
+  ASSERT_NE(msgList, nullptr);
+  auto model = msgList->property("model").value<QAbstractItemModel *>();
+  ASSERT_NE(model, nullptr);
+
+  plugin->OnEcho(true);
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::StringMsg>("/echo");
+  msgs::StringMsg msg;
+  for (auto i = 0; i < 20; ++i)
+  {
+    msg.set_data("message " + std::to_string(i));
+    pub.Publish(msg);
+  }
+
+  int sleep = 0;
+  int maxSleep = 30;
+  while (model->rowCount() < 2 && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    ++sleep;
+  }
+
+  // Only 7 and 17 match
+  ASSERT_EQ(model->rowCount(), 2);
+  for (const auto &row : Rows(model))
+    EXPECT_TRUE(row.contains("7")) << row.toStdString();
+
+  // Filter on a repeated field of a submessage
+  plugin->SetFilter("header.data.key == \"frame\"");
+  EXPECT_EQ(plugin->Filter(), "header.data.key == \"frame\"");
+
+  msg.set_data("without frame");
+  pub.Publish(msg);
+
+  auto data = msg.mutable_header()->add_data();
+  data->set_key("other");
+  msg.set_data("other key");
+  pub.Publish(msg);
+
+  data = msg.mutable_header()->add_data();
+  data->set_key("frame");
+  msg.set_data("with frame");
+  pub.Publish(msg);
+
+  sleep = 0;
+  while (model->rowCount() < 3 && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    ++sleep;
+  }
+  ASSERT_EQ(model->rowCount(), 3);
+  EXPECT_TRUE(Rows(model).last().contains("with frame"))
+      << Rows(model).last().toStdString();
+
+  // Without a filter all messages are shown again
+  plugin->SetFilter("");
+  EXPECT_TRUE(plugin->Filter().isEmpty());
+  msg.Clear();
+  msg.set_data("unfiltered");
+  pub.Publish(msg);
+
+  sleep = 0;
+  while (model->rowCount() < 4 && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    ++sleep;
+  }
+  ASSERT_EQ(model->rowCount(), 4);
+  EXPECT_EQ(Rows(model).last().toStdString(), "data: \"unfiltered\"\n");
+
+  plugin->OnEcho(false);
+  plugins.clear();
+}
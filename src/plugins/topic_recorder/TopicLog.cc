@@ -0,0 +1,699 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <gz/common/Console.hh>
+
+#include "TopicLog.hh"
+
+namespace
+{
+  /// \brief Identifies a log, "gzGL"
+  constexpr uint32_t kMagic{0x677a474cu};
+
+  /// \brief Identifies the index at the end of a closed log, "gzGI"
+  constexpr uint32_t kIndexMagic{0x677a4749u};
+
+  /// \brief Format version
+  constexpr uint32_t kVersion{1u};
+
+  /// \brief Topic of the records defining a topic, whose data is the name
+  /// and the type, each null terminated
+  constexpr uint32_t kTopicDefinition{UINT32_MAX};
+
+  /// \brief Start of the file. Values are in the byte order of the host.
+  struct FileHeader
+  {
+    /// \brief kMagic
+    uint32_t magic{kMagic};
+
+    /// \brief kVersion
+    uint32_t version{kVersion};
+
+    /// \brief Time between keyframes in nanoseconds
+    int64_t keyframePeriod{0};
+  };
+
+  /// \brief Start of each record, followed by its data
+  struct RecordHeader
+  {
+    /// \brief Time in nanoseconds
+    int64_t time{0};
+
+    /// \brief Topic index, or kTopicDefinition
+    uint32_t topic{0u};
+
+    /// \brief Size of the data
+    uint32_t size{0u};
+  };
+
+  /// \brief End of a closed log
+  struct Trailer
+  {
+    /// \brief Offset of the index
+    uint64_t indexOffset{0u};
+
+    /// \brief kIndexMagic
+    uint32_t magic{kIndexMagic};
+
+    /// \brief Unused, for alignment
+    uint32_t reserved{0u};
+  };
+
+  /// \brief Latest message of each topic before a message
+  struct Keyframe
+  {
+    /// \brief Index of the first message after the keyframe
+    uint64_t message{0u};
+
+    /// \brief Index plus one of the latest message of each topic, 0 for
+    /// none. Topics added later are missing.
+    std::vector<uint64_t> latest;
+  };
+
+  /// \brief Index of the messages, built while writing or when reading a
+  /// log which wasn't closed
+  struct Index
+  {
+    /// \brief Add a message
+    /// \param[in] _time Time of the message
+    /// \param[in] _topic Topic of the message
+    /// \param[in] _offset Offset of its record
+    void Add(int64_t _time, uint32_t _topic, uint64_t _offset)
+    {
+      if (_time >= this->nextKeyframe && this->period > 0)
+      {
+        this->keyframes.push_back({this->times.size(), this->latest});
+        this->nextKeyframe = (_time / this->period + 1) * this->period;
+      }
+
+      if (_topic >= this->latest.size())
+        this->latest.resize(_topic + 1u, 0u);
+      this->times.push_back(_time);
+      this->offsets.push_back(_offset);
+      this->latest[_topic] = this->times.size();
+    }
+
+    /// \brief Time between keyframes
+    int64_t period{0};
+
+    /// \brief Time of the next keyframe
+    int64_t nextKeyframe{0};
+
+    /// \brief Topics, by index
+    std::vector<gz::gui::plugins::TopicLogTopic> topics;
+
+    /// \brief Time of each message
+    std::vector<int64_t> times;
+
+    /// \brief Offset of the record of each message
+    std::vector<uint64_t> offsets;
+
+    /// \brief Keyframes, sorted
+    std::vector<Keyframe> keyframes;
+
+    /// \brief Latest message of each topic so far
+    std::vector<uint64_t> latest;
+  };
+
+  /////////////////////////////////////////////////
+  template <typename T>
+  void writeValue(std::ostream &_out, const T &_value)
+  {
+    _out.write(reinterpret_cast<const char *>(&_value), sizeof(T));
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Reads values from a mapped file, checking its bounds
+  class Cursor
+  {
+    /// \brief Constructor
+    /// \param[in] _data File
+    /// \param[in] _size Size of the file
+    /// \param[in] _offset Where to start
+    public: Cursor(const char *_data, std::size_t _size, std::size_t _offset)
+      : data(_data), size(_size), offset(_offset)
+    {
+    }
+
+    /// \brief Read a value
+    /// \param[out] _value Value read
+    /// \return False past the end
+    public: template <typename T> bool Read(T &_value)
+    {
+      if (this->offset > this->size || this->size - this->offset < sizeof(T))
+        return false;
+      std::memcpy(&_value, this->data + this->offset, sizeof(T));
+      this->offset += sizeof(T);
+      return true;
+    }
+
+    /// \brief Read a string with its length
+    /// \param[out] _value String read
+    /// \return False past the end
+    public: bool Read(std::string &_value)
+    {
+      uint32_t length{0u};
+      if (!this->Read(length) || this->size - this->offset < length)
+        return false;
+      _value.assign(this->data + this->offset, length);
+      this->offset += length;
+      return true;
+    }
+
+    /// \brief File
+    private: const char *data;
+
+    /// \brief Size of the file
+    private: std::size_t size;
+
+    /// \brief Current offset
+    private: std::size_t offset;
+  };
+
+  /////////////////////////////////////////////////
+  /// \brief Parse the data of a topic definition
+  bool parseTopic(const char *_data, std::size_t _size,
+      gz::gui::plugins::TopicLogTopic &_topic)
+  {
+    auto end = _data + _size;
+    auto nameEnd = std::find(_data, end, '\0');
+    if (nameEnd == end)
+      return false;
+    auto typeEnd = std::find(nameEnd + 1, end, '\0');
+    if (typeEnd == end)
+      return false;
+    _topic.name.assign(_data, nameEnd);
+    _topic.msgType.assign(nameEnd + 1, typeEnd);
+    return true;
+  }
+}
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  class TopicLogWriterPrivate
+  {
+    /// \brief Protects everything
+    public: mutable std::mutex mutex;
+
+    /// \brief Log file
+    public: std::ofstream file;
+
+    /// \brief Offset of the next record
+    public: uint64_t offset{0u};
+
+    /// \brief Time of the last message
+    public: int64_t lastTime{0};
+
+    /// \brief Index of the messages written
+    public: Index index;
+  };
+
+  class TopicLogReaderPrivate
+  {
+    /// \brief Unmap the file
+    public: void Close();
+
+    /// \brief Read the index at the end of a closed log
+    /// \return False if there's none or it's invalid
+    public: bool ReadIndex();
+
+    /// \brief Rebuild the index from the records
+    public: void Scan();
+
+    /// \brief Mapped file, or the buffer where it's read on Windows
+    public: const char *data{nullptr};
+
+    /// \brief Size of the file
+    public: std::size_t size{0u};
+
+#ifdef _WIN32
+    /// \brief File contents, where mapping isn't implemented
+    public: std::string buffer;
+#endif
+
+    /// \brief Index of the messages
+    public: Index index;
+  };
+}
+}
+}
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TopicLogWriter::TopicLogWriter()
+  : dataPtr(std::make_unique<TopicLogWriterPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+TopicLogWriter::~TopicLogWriter()
+{
+  this->Close();
+}
+
+/////////////////////////////////////////////////
+bool TopicLogWriter::Open(const std::string &_path, int64_t _keyframePeriod)
+{
+  this->Close();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->file.open(_path,
+      std::ios::binary | std::ios::out | std::ios::trunc);
+  if (!this->dataPtr->file.is_open())
+  {
+    gzerr << "Failed to create log [" << _path << "]" << std::endl;
+    return false;
+  }
+
+  FileHeader header;
+  header.keyframePeriod = _keyframePeriod;
+  writeValue(this->dataPtr->file, header);
+  this->dataPtr->offset = sizeof(header);
+  this->dataPtr->lastTime = 0;
+  this->dataPtr->index = Index();
+  this->dataPtr->index.period = _keyframePeriod;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool TopicLogWriter::IsOpen() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->file.is_open();
+}
+
+/////////////////////////////////////////////////
+uint32_t TopicLogWriter::AddTopic(const std::string &_name,
+    const std::string &_msgType)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &topics = this->dataPtr->index.topics;
+  auto id = static_cast<uint32_t>(topics.size());
+  topics.push_back({_name, _msgType});
+  if (!this->dataPtr->file.is_open())
+    return id;
+
+  RecordHeader record;
+  record.topic = kTopicDefinition;
+  record.size = static_cast<uint32_t>(_name.size() + _msgType.size() + 2u);
+  writeValue(this->dataPtr->file, record);
+  this->dataPtr->file.write(_name.c_str(), _name.size() + 1u);
+  this->dataPtr->file.write(_msgType.c_str(), _msgType.size() + 1u);
+  this->dataPtr->offset += sizeof(record) + record.size;
+  return id;
+}
+
+/////////////////////////////////////////////////
+bool TopicLogWriter::Write(uint32_t _topic, int64_t _time, const char *_data,
+    std::size_t _size)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->file.is_open() ||
+      _topic >= this->dataPtr->index.topics.size() || _size > UINT32_MAX)
+  {
+    return false;
+  }
+
+  RecordHeader record;
+  record.time = std::max(_time, this->dataPtr->lastTime);
+  record.topic = _topic;
+  record.size = static_cast<uint32_t>(_size);
+  writeValue(this->dataPtr->file, record);
+  this->dataPtr->file.write(_data, static_cast<std::streamsize>(_size));
+  if (!this->dataPtr->file)
+    return false;
+
+  this->dataPtr->index.Add(record.time, _topic, this->dataPtr->offset);
+  this->dataPtr->offset += sizeof(record) + _size;
+  this->dataPtr->lastTime = record.time;
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::size_t TopicLogWriter::Count() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->index.times.size();
+}
+
+/////////////////////////////////////////////////
+bool TopicLogWriter::Close()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &file = this->dataPtr->file;
+  if (!file.is_open())
+    return false;
+
+  // The index, after the records
+  const auto &index = this->dataPtr->index;
+  Trailer trailer;
+  trailer.indexOffset = this->dataPtr->offset;
+
+  writeValue(file, static_cast<uint32_t>(index.topics.size()));
+  for (const auto &topic : index.topics)
+  {
+    writeValue(file, static_cast<uint32_t>(topic.name.size()));
+    file.write(topic.name.data(), topic.name.size());
+    writeValue(file, static_cast<uint32_t>(topic.msgType.size()));
+    file.write(topic.msgType.data(), topic.msgType.size());
+  }
+
+  writeValue(file, static_cast<uint64_t>(index.times.size()));
+  for (std::size_t i = 0; i < index.times.size(); ++i)
+  {
+    writeValue(file, index.times[i]);
+    writeValue(file, index.offsets[i]);
+  }
+
+  writeValue(file, static_cast<uint64_t>(index.keyframes.size()));
+  for (const auto &keyframe : index.keyframes)
+  {
+    writeValue(file, keyframe.message);
+    writeValue(file, static_cast<uint32_t>(keyframe.latest.size()));
+    for (auto latest : keyframe.latest)
+      writeValue(file, latest);
+  }
+
+  writeValue(file, trailer);
+  bool result = static_cast<bool>(file);
+  file.close();
+  return result;
+}
+
+/////////////////////////////////////////////////
+TopicLogReader::TopicLogReader()
+  : dataPtr(std::make_unique<TopicLogReaderPrivate>())
+{
+}
+
+/////////////////////////////////////////////////
+TopicLogReader::~TopicLogReader()
+{
+  this->dataPtr->Close();
+}
+
+/////////////////////////////////////////////////
+void TopicLogReaderPrivate::Close()
+{
+#ifndef _WIN32
+  if (nullptr != this->data && this->size > 0u)
+    munmap(const_cast<char *>(this->data), this->size);
+#else
+  this->buffer.clear();
+#endif
+  this->data = nullptr;
+  this->size = 0u;
+  this->index = Index();
+}
+
+/////////////////////////////////////////////////
+bool TopicLogReader::Open(const std::string &_path)
+{
+  auto &d = *this->dataPtr;
+  d.Close();
+
+#ifndef _WIN32
+  int fd = open(_path.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    gzerr << "Failed to open log [" << _path << "]" << std::endl;
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size < 0)
+  {
+    close(fd);
+    gzerr << "Failed to open log [" << _path << "]" << std::endl;
+    return false;
+  }
+  d.size = static_cast<std::size_t>(info.st_size);
+  if (d.size > 0u)
+  {
+    void *mapped = mmap(nullptr, d.size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED)
+    {
+      close(fd);
+      d.size = 0u;
+      gzerr << "Failed to map log [" << _path << "]" << std::endl;
+      return false;
+    }
+    d.data = static_cast<const char *>(mapped);
+  }
+  close(fd);
+#else
+  std::ifstream file(_path, std::ios::binary);
+  if (!file.is_open())
+  {
+    gzerr << "Failed to open log [" << _path << "]" << std::endl;
+    return false;
+  }
+  d.buffer.assign(std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>());
+  d.data = d.buffer.data();
+  d.size = d.buffer.size();
+#endif
+
+  FileHeader header;
+  if (d.size < sizeof(header))
+  {
+    gzerr << "Invalid log [" << _path << "]" << std::endl;
+    d.Close();
+    return false;
+  }
+  std::memcpy(&header, d.data, sizeof(header));
+  if (header.magic != kMagic || header.version != kVersion)
+  {
+    gzerr << "Invalid log [" << _path << "]" << std::endl;
+    d.Close();
+    return false;
+  }
+  d.index.period = header.keyframePeriod;
+
+  if (!d.ReadIndex())
+  {
+    gzwarn << "Log [" << _path << "] wasn't closed, rebuilding its index"
+           << std::endl;
+    d.index = Index();
+    d.index.period = header.keyframePeriod;
+    d.Scan();
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool TopicLogReaderPrivate::ReadIndex()
+{
+  Trailer trailer;
+  if (this->size < sizeof(FileHeader) + sizeof(trailer))
+    return false;
+  std::memcpy(&trailer, this->data + this->size - sizeof(trailer),
+      sizeof(trailer));
+  if (trailer.magic != kIndexMagic || trailer.indexOffset >= this->size)
+    return false;
+
+  Cursor cursor(this->data, this->size - sizeof(trailer),
+      static_cast<std::size_t>(trailer.indexOffset));
+  uint32_t topicCount{0u};
+  if (!cursor.Read(topicCount))
+    return false;
+  for (uint32_t i = 0; i < topicCount; ++i)
+  {
+    TopicLogTopic topic;
+    if (!cursor.Read(topic.name) || !cursor.Read(topic.msgType))
+      return false;
+    this->index.topics.push_back(topic);
+  }
+
+  uint64_t count{0u};
+  if (!cursor.Read(count) || count > this->size / sizeof(RecordHeader))
+    return false;
+  this->index.times.resize(count);
+  this->index.offsets.resize(count);
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    if (!cursor.Read(this->index.times[i]) ||
+        !cursor.Read(this->index.offsets[i]) ||
+        this->index.offsets[i] + sizeof(RecordHeader) > trailer.indexOffset)
+    {
+      return false;
+    }
+  }
+
+  uint64_t keyframeCount{0u};
+  if (!cursor.Read(keyframeCount) || keyframeCount > count)
+    return false;
+  this->index.keyframes.resize(keyframeCount);
+  for (auto &keyframe : this->index.keyframes)
+  {
+    uint32_t latestCount{0u};
+    if (!cursor.Read(keyframe.message) || !cursor.Read(latestCount) ||
+        latestCount > topicCount)
+    {
+      return false;
+    }
+    keyframe.latest.resize(latestCount);
+    for (auto &latest : keyframe.latest)
+    {
+      if (!cursor.Read(latest))
+        return false;
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void TopicLogReaderPrivate::Scan()
+{
+  std::size_t offset = sizeof(FileHeader);
+  while (this->size - offset >= sizeof(RecordHeader))
+  {
+    RecordHeader record;
+    std::memcpy(&record, this->data + offset, sizeof(record));
+    auto dataOffset = offset + sizeof(record);
+
+    // Stop at a record which wasn't completely written
+    if (this->size - dataOffset < record.size)
+      break;
+
+    if (record.topic == kTopicDefinition)
+    {
+      TopicLogTopic topic;
+      if (!parseTopic(this->data + dataOffset, record.size, topic))
+        break;
+      this->index.topics.push_back(topic);
+    }
+    else
+    {
+      if (record.topic >= this->index.topics.size())
+        break;
+      this->index.Add(record.time, record.topic, offset);
+    }
+    offset = dataOffset + record.size;
+  }
+}
+
+/////////////////////////////////////////////////
+const std::vector<TopicLogTopic> &TopicLogReader::Topics() const
+{
+  return this->dataPtr->index.topics;
+}
+
+/////////////////////////////////////////////////
+std::size_t TopicLogReader::Count() const
+{
+  return this->dataPtr->index.times.size();
+}
+
+/////////////////////////////////////////////////
+int64_t TopicLogReader::Duration() const
+{
+  const auto &times = this->dataPtr->index.times;
+  return times.empty() ? 0 : times.back();
+}
+
+/////////////////////////////////////////////////
+TopicLogMessage TopicLogReader::Message(std::size_t _index) const
+{
+  TopicLogMessage msg;
+  const auto &index = this->dataPtr->index;
+  if (_index >= index.offsets.size())
+    return msg;
+
+  RecordHeader record;
+  auto offset = static_cast<std::size_t>(index.offsets[_index]);
+  std::memcpy(&record, this->dataPtr->data + offset, sizeof(record));
+  msg.time = index.times[_index];
+  msg.topic = record.topic;
+  msg.data = this->dataPtr->data + offset + sizeof(record);
+
+  // Bounded by the file, in case the index doesn't match it
+  auto available = this->dataPtr->size - offset - sizeof(record);
+  msg.size = std::min<std::size_t>(record.size, available);
+  return msg;
+}
+
+/////////////////////////////////////////////////
+std::size_t TopicLogReader::End(int64_t _time) const
+{
+  const auto &times = this->dataPtr->index.times;
+  return static_cast<std::size_t>(
+      std::upper_bound(times.begin(), times.end(), _time) - times.begin());
+}
+
+/////////////////////////////////////////////////
+std::vector<std::size_t> TopicLogReader::State(int64_t _time) const
+{
+  const auto &index = this->dataPtr->index;
+  auto end = this->End(_time);
+
+  // Latest keyframe before the end
+  auto keyframe = std::upper_bound(index.keyframes.begin(),
+      index.keyframes.end(), end,
+      [](std::size_t _end, const Keyframe &_keyframe)
+      {
+        return _end < _keyframe.message;
+      });
+
+  std::vector<uint64_t> latest(index.topics.size(), 0u);
+  std::size_t start{0u};
+  if (keyframe != index.keyframes.begin())
+  {
+    --keyframe;
+    std::copy(keyframe->latest.begin(), keyframe->latest.end(),
+        latest.begin());
+    start = static_cast<std::size_t>(keyframe->message);
+  }
+
+  // Only the messages since the keyframe are read
+  for (std::size_t i = start; i < end; ++i)
+  {
+    auto msg = this->Message(i);
+    if (msg.topic < latest.size())
+      latest[msg.topic] = i + 1u;
+  }
+
+  std::vector<std::size_t> state;
+  for (auto i : latest)
+  {
+    if (i > 0u)
+      state.push_back(static_cast<std::size_t>(i - 1u));
+  }
+  std::sort(state.begin(), state.end());
+  return state;
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TOPICRECORDER_TOPICLOG_HH_
+#define GZ_GUI_PLUGINS_TOPICRECORDER_TOPICLOG_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  class TopicLogReaderPrivate;
+  class TopicLogWriterPrivate;
+
+  /// \brief A topic of a log
+  struct TopicLogTopic
+  {
+    /// \brief Topic name
+    std::string name;
+
+    /// \brief Message type, such as gz.msgs.Pose_V
+    std::string msgType;
+  };
+
+  /// \brief A message of a log, pointing into the mapped file
+  struct TopicLogMessage
+  {
+    /// \brief Time since the start of the recording, in nanoseconds
+    int64_t time{0};
+
+    /// \brief Index of its topic
+    uint32_t topic{0u};
+
+    /// \brief Serialized message
+    const char *data{nullptr};
+
+    /// \brief Size of data in bytes
+    std::size_t size{0u};
+  };
+
+  /// \brief Writes serialized messages of several topics to a log file.
+  ///
+  /// Messages are appended as they're written, and an index of their times
+  /// and of periodic keyframes is appended on Close. A log which wasn't
+  /// closed, such as after a crash, is still read, by rebuilding the
+  /// index. Write may be called from any thread.
+  class TopicLogWriter
+  {
+    /// \brief Constructor
+    public: TopicLogWriter();
+
+    /// \brief Destructor, closes the log
+    public: ~TopicLogWriter();
+
+    /// \brief Create a log, replacing an existing file.
+    /// \param[in] _path Log file
+    /// \param[in] _keyframePeriod Time between keyframes, in nanoseconds
+    /// \return True if the file was created
+    public: bool Open(const std::string &_path, int64_t _keyframePeriod);
+
+    /// \brief Get whether a log is open
+    /// \return True between Open and Close
+    public: bool IsOpen() const;
+
+    /// \brief Add a topic.
+    /// \param[in] _name Topic name
+    /// \param[in] _msgType Message type
+    /// \return Index of the topic, passed to Write
+    public: uint32_t AddTopic(const std::string &_name,
+                              const std::string &_msgType);
+
+    /// \brief Append a message. Times earlier than the previous message's
+    /// are raised to it, so messages stay sorted.
+    /// \param[in] _topic Index of the topic, from AddTopic
+    /// \param[in] _time Time since the start, in nanoseconds
+    /// \param[in] _data Serialized message
+    /// \param[in] _size Size of _data in bytes
+    /// \return False if the log isn't open, the topic is unknown or the
+    /// write failed
+    public: bool Write(uint32_t _topic, int64_t _time, const char *_data,
+                       std::size_t _size);
+
+    /// \brief Get the number of messages written
+    /// \return Number of messages
+    public: std::size_t Count() const;
+
+    /// \brief Write the index and close the file
+    /// \return True if the index was written
+    public: bool Close();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<TopicLogWriterPrivate> dataPtr;
+  };
+
+  /// \brief Reads a log written by TopicLogWriter.
+  ///
+  /// The file is memory-mapped, so messages are read in place, and only
+  /// the pages which are played are loaded. Finding the messages at a
+  /// time is a binary search, and the state of all topics at a time is
+  /// rebuilt from the keyframe before it.
+  class TopicLogReader
+  {
+    /// \brief Constructor
+    public: TopicLogReader();
+
+    /// \brief Destructor, unmaps the file
+    public: ~TopicLogReader();
+
+    /// \brief Open a log, closing the previous one.
+    /// \param[in] _path Log file
+    /// \return True if it's a valid log
+    public: bool Open(const std::string &_path);
+
+    /// \brief Get the topics of the log
+    /// \return Topics, by index
+    public: const std::vector<TopicLogTopic> &Topics() const;
+
+    /// \brief Get the number of messages in the log
+    /// \return Number of messages
+    public: std::size_t Count() const;
+
+    /// \brief Get the time of the last message
+    /// \return Time in nanoseconds, 0 if the log is empty
+    public: int64_t Duration() const;
+
+    /// \brief Get a message. Valid until the next Open.
+    /// \param[in] _index Index of the message, less than Count
+    /// \return Message
+    public: TopicLogMessage Message(std::size_t _index) const;
+
+    /// \brief Find the messages up to a time.
+    /// \param[in] _time Time in nanoseconds
+    /// \return Number of messages at or before _time, which is the index
+    /// of the first message after it
+    public: std::size_t End(int64_t _time) const;
+
+    /// \brief Get the state of the topics at a time, which is the latest
+    /// message of each topic at or before it.
+    /// \param[in] _time Time in nanoseconds
+    /// \return Indices of the messages, sorted
+    public: std::vector<std::size_t> State(int64_t _time) const;
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<TopicLogReaderPrivate> dataPtr;
+  };
+}
+}
+}
+
+#endif
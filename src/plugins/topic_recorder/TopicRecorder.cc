@@ -0,0 +1,668 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/plugin/Register.hh>
+#include <gz/transport/MessageInfo.hh>
+#include <gz/transport/Node.hh>
+#include <gz/transport/TopicUtils.hh>
+
+#include "gz/gui/LatestValue.hh"
+#include "gz/gui/StaticPlugins.hh"
+#include "gz/gui/TopicDiscovery.hh"
+
+#include "TopicLog.hh"
+#include "TopicRecorder.hh"
+
+/// \brief Clock of the recording and playback times
+using Clock = std::chrono::steady_clock;
+
+/// \brief Types of the topics recorded by default, those displayed by the
+/// GUI plugins
+static const std::vector<std::string> kDefaultTypes{
+  "gz.msgs.Pose_V",
+  "gz.msgs.Scene",
+  "gz.msgs.UInt32_V",
+  "gz.msgs.Marker",
+  "gz.msgs.Marker_V",
+  "gz.msgs.Image",
+  "gz.msgs.PointCloudPacked",
+};
+
+/// \brief Time between two progress reports while playing
+static constexpr std::chrono::milliseconds kProgressPeriod{50};
+
+/// \brief A topic being recorded, shared with its callback
+struct RecordedTopic
+{
+  /// \brief Protects everything
+  std::mutex mutex;
+
+  /// \brief Topic name
+  std::string name;
+
+  /// \brief Index in the log, once its first message gave its type
+  std::optional<uint32_t> id;
+};
+
+/// \brief Progress of the playback, passed to the GUI thread
+struct Progress
+{
+  /// \brief Position in nanoseconds
+  int64_t position{0};
+
+  /// \brief True while playing
+  bool playing{false};
+};
+
+/// \brief Private data class for TopicRecorder
+class gz::gui::plugins::TopicRecorderPrivate
+{
+  /// \brief Start the playback thread
+  public: void StartPlayer();
+
+  /// \brief Stop the playback thread and close the log
+  public: void StopPlayer();
+
+  /// \brief Loop of the playback thread
+  public: void PlayerLoop();
+
+  /// \brief Publish a message of the log. Called from the playback thread.
+  /// \param[in] _index Index of the message
+  public: void Publish(std::size_t _index);
+
+  /// \brief Report the progress to the GUI thread. Called from the playback
+  /// thread with the mutex locked.
+  public: void Report();
+
+  /// \brief Log file
+  public: std::string path{"gui_topics.log"};
+
+  /// \brief Topics to record, empty for the defaults
+  public: std::vector<std::string> topics;
+
+  /// \brief Time between keyframes, in nanoseconds
+  public: int64_t keyframePeriod{1000000000};
+
+  /// \brief Writes the recording
+  public: TopicLogWriter writer;
+
+  /// \brief Topics being recorded
+  public: std::vector<std::shared_ptr<RecordedTopic>> recorded;
+
+  /// \brief Start of the recording
+  public: Clock::time_point recordStart;
+
+  /// \brief Node recording, destroyed to stop the callbacks
+  public: std::unique_ptr<transport::Node> recordNode;
+
+  /// \brief Updates the status while recording
+  public: QTimer statusTimer;
+
+  /// \brief See TopicRecorder::Status
+  public: QString status;
+
+  /// \brief Reads the log played. Only used by the playback thread while
+  /// it runs.
+  public: TopicLogReader reader;
+
+  /// \brief True if a log is open for playback
+  public: bool loaded{false};
+
+  /// \brief Node publishing the log, replaced for each log
+  public: std::unique_ptr<transport::Node> playNode;
+
+  /// \brief Publisher of each topic of the log, by index
+  public: std::vector<transport::Node::Publisher> publishers;
+
+  /// \brief Protects the playback state below
+  public: mutable std::mutex mutex;
+
+  /// \brief Wakes the playback thread
+  public: std::condition_variable condition;
+
+  /// \brief True while playing
+  public: bool playing{false};
+
+  /// \brief Playback speed
+  public: double rate{1.0};
+
+  /// \brief Playback position, in nanoseconds
+  public: int64_t position{0};
+
+  /// \brief Position to move to
+  public: std::optional<int64_t> seek;
+
+  /// \brief True when the pace must be restarted from the position, after
+  /// playing, seeking or changing the speed
+  public: bool retime{true};
+
+  /// \brief True to stop the playback thread
+  public: bool stop{false};
+
+  /// \brief Time of the last progress report
+  public: Clock::time_point lastReport;
+
+  /// \brief Delivers the progress to the GUI thread. Declared before the
+  /// thread, which uses it.
+  public: std::unique_ptr<LatestValue<Progress>> progress;
+
+  /// \brief Playback thread
+  public: std::thread player;
+};
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+void TopicRecorderPrivate::StartPlayer()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stop = false;
+    this->playing = false;
+    this->position = 0;
+    this->seek = 0;
+    this->retime = true;
+  }
+  this->player = std::thread(&TopicRecorderPrivate::PlayerLoop, this);
+}
+
+/////////////////////////////////////////////////
+void TopicRecorderPrivate::StopPlayer()
+{
+  if (this->player.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->stop = true;
+    }
+    this->condition.notify_all();
+    this->player.join();
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->playing = false;
+  this->position = 0;
+  this->publishers.clear();
+  this->playNode.reset();
+  this->loaded = false;
+}
+
+/////////////////////////////////////////////////
+void TopicRecorderPrivate::PlayerLoop()
+{
+  // Next message to publish
+  std::size_t next{0u};
+
+  // The message at logStart was due at wallStart
+  Clock::time_point wallStart;
+  int64_t logStart{0};
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (!this->stop)
+  {
+    if (this->seek)
+    {
+      auto time = std::clamp<int64_t>(*this->seek, 0,
+          this->reader.Duration());
+      this->seek.reset();
+      this->position = time;
+      this->retime = true;
+      next = this->reader.End(time);
+
+      // Only the latest message of each topic, found from the keyframe
+      // before the position
+      auto state = this->reader.State(time);
+      lock.unlock();
+      for (auto index : state)
+        this->Publish(index);
+      lock.lock();
+      this->Report();
+      continue;
+    }
+
+    if (!this->playing)
+    {
+      this->condition.wait(lock);
+      continue;
+    }
+
+    if (next >= this->reader.Count())
+    {
+      this->playing = false;
+      this->position = this->reader.Duration();
+      this->Report();
+      continue;
+    }
+
+    if (this->retime)
+    {
+      wallStart = Clock::now();
+      logStart = this->position;
+      this->retime = false;
+    }
+
+    auto time = this->reader.Message(next).time;
+    auto due = wallStart + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::nano>(
+        static_cast<double>(time - logStart) / this->rate));
+    if (Clock::now() < due)
+    {
+      // Woken early by a seek, pause or change of speed
+      this->condition.wait_until(lock, due);
+      continue;
+    }
+
+    this->position = time;
+    auto index = next++;
+    lock.unlock();
+    this->Publish(index);
+    lock.lock();
+
+    if (Clock::now() - this->lastReport >= kProgressPeriod)
+      this->Report();
+  }
+}
+
+/////////////////////////////////////////////////
+void TopicRecorderPrivate::Publish(std::size_t _index)
+{
+  auto msg = this->reader.Message(_index);
+  if (msg.topic >= this->publishers.size() || !this->publishers[msg.topic])
+    return;
+
+  this->publishers[msg.topic].PublishRaw(std::string(msg.data, msg.size),
+      this->reader.Topics()[msg.topic].msgType);
+}
+
+/////////////////////////////////////////////////
+void TopicRecorderPrivate::Report()
+{
+  this->lastReport = Clock::now();
+  this->progress->Set({this->position, this->playing});
+}
+
+/////////////////////////////////////////////////
+TopicRecorder::TopicRecorder()
+  : Plugin(), dataPtr(std::make_unique<TopicRecorderPrivate>())
+{
+  this->dataPtr->progress = std::make_unique<LatestValue<Progress>>(this,
+      [this](const Progress &)
+      {
+        this->PositionChanged();
+        this->PlayingChanged();
+      });
+
+  this->connect(&this->dataPtr->statusTimer, &QTimer::timeout, this,
+      &TopicRecorder::UpdateStatus);
+}
+
+/////////////////////////////////////////////////
+TopicRecorder::~TopicRecorder()
+{
+  this->dataPtr->StopPlayer();
+  this->dataPtr->recordNode.reset();
+  this->dataPtr->writer.Close();
+}
+
+/////////////////////////////////////////////////
+void TopicRecorder::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Topic recorder";
+
+  if (!_pluginElem)
+    return;
+
+  auto elem = _pluginElem->FirstChildElement("path");
+  if (nullptr != elem && nullptr != elem->GetText())
+    this->SetPath(QString::fromStdString(elem->GetText()));
+
+  elem = _pluginElem->FirstChildElement("keyframe_period");
+  if (nullptr != elem)
+  {
+    double period{0.0};
+    if (elem->QueryDoubleText(&period) == tinyxml2::XML_SUCCESS &&
+        period >= 0.01)
+    {
+      this->dataPtr->keyframePeriod = static_cast<int64_t>(period * 1e9);
+    }
+    else
+    {
+      gzerr << "Invalid <keyframe_period>, expected at least 0.01 seconds"
+            << std::endl;
+    }
+  }
+
+  for (auto topicElem = _pluginElem->FirstChildElement("topic");
+      nullptr != topicElem;
+      topicElem = topicElem->NextSiblingElement("topic"))
+  {
+    if (nullptr == topicElem->GetText())
+      continue;
+    auto topic = transport::TopicUtils::AsValidTopic(topicElem->GetText());
+    if (topic.empty())
+    {
+      gzerr << "Invalid <topic> [" << topicElem->GetText() << "]"
+            << std::endl;
+      continue;
+    }
+    this->dataPtr->topics.push_back(topic);
+  }
+}
+
+/////////////////////////////////////////////////
+QString TopicRecorder::Path() const
+{
+  return QString::fromStdString(this->dataPtr->path);
+}
+
+/////////////////////////////////////////////////
+void TopicRecorder::SetPath(const QString &_path)
+{
+  auto path = _path.startsWith("file:") ? QUrl(_path).toLocalFile() :
+      _path;
+  if (path.toStdString() == this->dataPtr->path)
+    return;
+  this->dataPtr->path = path.toStdString();
+  this->PathChanged();
+}
+
+/////////////////////////////////////////////////
+bool TopicRecorder::Recording() const
+{
+  return nullptr != this->dataPtr->recordNode;
+}
+
+/////////////////////////////////////////////////
+bool TopicRecorder::Loaded() const
+{
+  return this->dataPtr->loaded;
+}
+
+/////////////////////////////////////////////////
+bool TopicRecorder::Playing() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->playing;
+}
+
+/////////////////////////////////////////////////
+double TopicRecorder::Duration() const
+{
+  if (!this->dataPtr->loaded)
+    return 0.0;
+  return static_cast<double>(this->dataPtr->reader.Duration()) * 1e-9;
+}
+
+/////////////////////////////////////////////////
+double TopicRecorder::Position() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return static_cast<double>(this->dataPtr->position) * 1e-9;
+}
+
+/////////////////////////////////////////////////
+double TopicRecorder::Rate() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->rate;
+}
+
+/////////////////////////////////////////////////
+void TopicRecorder::SetRate(double _rate)
+{
+  _rate = std::clamp(_rate, 0.01, 100.0);
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (_rate == this->dataPtr->rate)
+      return;
+    this->dataPtr->rate = _rate;
+    this->dataPtr->retime = true;
+  }
+  this->dataPtr->condition.notify_all();
+  this->RateChanged();
+}
+
+/////////////////////////////////////////////////
+QString TopicRecorder::Status() const
+{
+  return this->dataPtr->status;
+}
+
+/////////////////////////////////////////////////
+bool TopicRecorder::StartRecording()
+{
+  auto &d = *this->dataPtr;
+  if (d.recordNode)
+    return true;
+
+  // Playing while recording would record the playback
+  if (d.loaded)
+  {
+    d.StopPlayer();
+    this->LoadedChanged();
+    this->PlayingChanged();
+    this->PositionChanged();
+  }
+
+  std::vector<std::string> topics = d.topics;
+  if (topics.empty())
+  {
+    auto discovery = TopicDiscovery::Instance();
+    for (const auto &type : kDefaultTypes)
+    {
+      for (const auto &topic : discovery->Topics(type))
+        topics.push_back(topic);
+    }
+  }
+  std::sort(topics.begin(), topics.end());
+  topics.erase(std::unique(topics.begin(), topics.end()), topics.end());
+
+  if (topics.empty())
+  {
+    gzerr << "No topics to record" << std::endl;
+    d.status = "No topics to record";
+    this->StatusChanged();
+    return false;
+  }
+
+  if (!d.writer.Open(d.path, d.keyframePeriod))
+  {
+    d.status = "Failed to create " + QString::fromStdString(d.path);
+    this->StatusChanged();
+    return false;
+  }
+
+  d.recordStart = Clock::now();
+  d.recorded.clear();
+  d.recordNode = std::make_unique<transport::Node>();
+  for (const auto &topic : topics)
+  {
+    auto recorded = std::make_shared<RecordedTopic>();
+    recorded->name = topic;
+
+    // Topics are added to the log with the type of their first message
+    auto writer = &d.writer;
+    auto start = d.recordStart;
+    std::function<void(const char *, const size_t,
+        const transport::MessageInfo &)> cb =
+        [recorded, writer, start](const char *_data, const size_t _size,
+            const transport::MessageInfo &_info)
+        {
+          auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+              Clock::now() - start).count();
+          std::lock_guard<std::mutex> lock(recorded->mutex);
+          if (!recorded->id)
+            recorded->id = writer->AddTopic(recorded->name, _info.Type());
+          writer->Write(*recorded->id, time, _data, _size);
+        };
+
+    if (!d.recordNode->SubscribeRaw(topic, cb))
+    {
+      gzerr << "Failed to subscribe to [" << topic << "]" << std::endl;
+      continue;
+    }
+    d.recorded.push_back(recorded);
+  }
+
+  gzmsg << "Recording " << d.recorded.size() << " topics to [" << d.path
+        << "]" << std::endl;
+  d.statusTimer.start(500);
+  this->UpdateStatus();
+  this->RecordingChanged();
+  return true;
+}
+
+/////////////////////////////////////////////////
+void TopicRecorder::StopRecording()
+{
+  auto &d = *this->dataPtr;
+  if (!d.recordNode)
+    return;
+
+  // No callback runs once the node is destroyed
+  d.recordNode.reset();
+  d.statusTimer.stop();
+  auto count = d.writer.Count();
+  if (!d.writer.Close())
+    gzerr << "Failed to write the index of [" << d.path << "]" << std::endl;
+
+  gzmsg << "Recorded " << count << " messages to [" << d.path << "]"
+        << std::endl;
+  d.status = QString("Recorded %1 messages").arg(count);
+  this->StatusChanged();
+  this->RecordingChanged();
+}
+
+/////////////////////////////////////////////////
+bool TopicRecorder::Open()
+{
+  auto &d = *this->dataPtr;
+  if (d.recordNode)
+  {
+    gzerr << "Stop recording before playing a log" << std::endl;
+    return false;
+  }
+
+  d.StopPlayer();
+  if (!d.reader.Open(d.path))
+  {
+    d.status = "Failed to open " + QString::fromStdString(d.path);
+    this->StatusChanged();
+    this->LoadedChanged();
+    return false;
+  }
+
+  d.playNode = std::make_unique<transport::Node>();
+  for (const auto &topic : d.reader.Topics())
+  {
+    auto pub = d.playNode->Advertise(topic.name, topic.msgType);
+    if (!pub)
+    {
+      gzerr << "Failed to advertise [" << topic.name << "] of type ["
+            << topic.msgType << "]" << std::endl;
+    }
+    d.publishers.push_back(pub);
+  }
+  d.loaded = true;
+
+  d.status = QString("%1 messages of %2 topics")
+      .arg(d.reader.Count()).arg(d.reader.Topics().size());
+  d.StartPlayer();
+
+  this->StatusChanged();
+  this->LoadedChanged();
+  this->PositionChanged();
+  this->PlayingChanged();
+  return true;
+}
+
+/////////////////////////////////////////////////
+void TopicRecorder::Play()
+{
+  if (!this->dataPtr->loaded)
+    return;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->playing)
+      return;
+
+    // From the start again once the end was reached
+    if (this->dataPtr->position >= this->dataPtr->reader.Duration())
+      this->dataPtr->seek = 0;
+    this->dataPtr->playing = true;
+    this->dataPtr->retime = true;
+  }
+  this->dataPtr->condition.notify_all();
+  this->PlayingChanged();
+}
+
+/////////////////////////////////////////////////
+void TopicRecorder::Pause()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->playing)
+      return;
+    this->dataPtr->playing = false;
+  }
+  this->dataPtr->condition.notify_all();
+  this->PlayingChanged();
+}
+
+/////////////////////////////////////////////////
+void TopicRecorder::Seek(double _seconds)
+{
+  if (!this->dataPtr->loaded)
+    return;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->seek = static_cast<int64_t>(_seconds * 1e9);
+  }
+  this->dataPtr->condition.notify_all();
+}
+
+/////////////////////////////////////////////////
+void TopicRecorder::UpdateStatus()
+{
+  auto &d = *this->dataPtr;
+  auto seconds = std::chrono::duration<double>(Clock::now() - d.recordStart)
+      .count();
+  d.status = QString("Recording %1 topics, %2 messages in %3 s")
+      .arg(d.recorded.size()).arg(d.writer.Count())
+      .arg(seconds, 0, 'f', 1);
+  this->StatusChanged();
+}
+
+// Register this plugin
+GZ_GUI_ADD_PLUGIN(TopicRecorder, "TopicRecorder")
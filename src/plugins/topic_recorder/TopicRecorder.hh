@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TOPICRECORDER_HH_
+#define GZ_GUI_PLUGINS_TOPICRECORDER_HH_
+
+#include <memory>
+
+#include "gz/gui/Plugin.hh"
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  class TopicRecorderPrivate;
+
+  /// \brief Records the topics displayed by the GUI into a log file, and
+  /// plays them back into the same plugins, so a run can be reviewed
+  /// without the simulator.
+  ///
+  /// Messages are recorded raw, without being parsed, with the time they
+  /// were received. The log is memory-mapped for playback and indexed, so
+  /// seeking to a time only searches the index. The state at that time,
+  /// the latest message of each topic, is rebuilt from the keyframe
+  /// before it, and published at once, so scrubbing updates the displays
+  /// while paused. Playback publishes the messages on their original
+  /// topics, and can be sped up or slowed down.
+  ///
+  /// Topics whose messages only hold changes, such as markers, are
+  /// restored from their latest message only.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<topic\> : May be repeated. Topic to record. Defaults to the
+  ///               topics of poses, scenes, deletions, markers, images and
+  ///               point clouds known when the recording starts.
+  /// * \<path\> : Log file recorded to and played, defaults to
+  ///              `gui_topics.log` in the working directory.
+  /// * \<keyframe_period\> : Time between keyframes, in seconds, defaults
+  ///                         to 1.
+  class TopicRecorder : public Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Log file
+    Q_PROPERTY(
+      QString path
+      READ Path
+      WRITE SetPath
+      NOTIFY PathChanged
+    )
+
+    /// \brief True while recording
+    Q_PROPERTY(
+      bool recording
+      READ Recording
+      NOTIFY RecordingChanged
+    )
+
+    /// \brief True while a log is open for playback
+    Q_PROPERTY(
+      bool loaded
+      READ Loaded
+      NOTIFY LoadedChanged
+    )
+
+    /// \brief True while playing
+    Q_PROPERTY(
+      bool playing
+      READ Playing
+      NOTIFY PlayingChanged
+    )
+
+    /// \brief Time of the last message of the log, in seconds
+    Q_PROPERTY(
+      double duration
+      READ Duration
+      NOTIFY LoadedChanged
+    )
+
+    /// \brief Playback position, in seconds
+    Q_PROPERTY(
+      double position
+      READ Position
+      NOTIFY PositionChanged
+    )
+
+    /// \brief Playback speed, 1 for real time
+    Q_PROPERTY(
+      double rate
+      READ Rate
+      WRITE SetRate
+      NOTIFY RateChanged
+    )
+
+    /// \brief Description of the recording or of the log
+    Q_PROPERTY(
+      QString status
+      READ Status
+      NOTIFY StatusChanged
+    )
+
+    /// \brief Constructor
+    public: TopicRecorder();
+
+    /// \brief Destructor
+    public: ~TopicRecorder() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+        override;
+
+    /// \brief Get the log file
+    /// \return Path
+    public: Q_INVOKABLE QString Path() const;
+
+    /// \brief Set the log file, used by the next recording or Open. Local
+    /// file URLs are accepted.
+    /// \param[in] _path Path or URL
+    public: Q_INVOKABLE void SetPath(const QString &_path);
+
+    /// \brief Get whether topics are being recorded
+    /// \return True while recording
+    public: Q_INVOKABLE bool Recording() const;
+
+    /// \brief Get whether a log is open for playback
+    /// \return True once opened
+    public: Q_INVOKABLE bool Loaded() const;
+
+    /// \brief Get whether the log is playing
+    /// \return True while playing
+    public: Q_INVOKABLE bool Playing() const;
+
+    /// \brief Get the duration of the open log
+    /// \return Time of its last message, in seconds
+    public: Q_INVOKABLE double Duration() const;
+
+    /// \brief Get the playback position
+    /// \return Position in seconds
+    public: Q_INVOKABLE double Position() const;
+
+    /// \brief Get the playback speed
+    /// \return Speed, 1 for real time
+    public: Q_INVOKABLE double Rate() const;
+
+    /// \brief Set the playback speed
+    /// \param[in] _rate Speed, between 0.01 and 100
+    public: Q_INVOKABLE void SetRate(double _rate);
+
+    /// \brief Get the status
+    /// \return Description of the recording or of the log
+    public: Q_INVOKABLE QString Status() const;
+
+    /// \brief Start recording to the log file, closing the log being
+    /// played.
+    /// \return True if recording
+    public: Q_INVOKABLE bool StartRecording();
+
+    /// \brief Stop recording and write the index of the log
+    public: Q_INVOKABLE void StopRecording();
+
+    /// \brief Open the log file for playback, paused at its start.
+    /// \return True if it's a valid log
+    public: Q_INVOKABLE bool Open();
+
+    /// \brief Play the open log from the current position
+    public: Q_INVOKABLE void Play();
+
+    /// \brief Pause playback
+    public: Q_INVOKABLE void Pause();
+
+    /// \brief Move the playback position, publishing the state of the
+    /// topics at the new position.
+    /// \param[in] _seconds Position in seconds
+    public: Q_INVOKABLE void Seek(double _seconds);
+
+    /// \brief Notify that the log file changed
+    signals: void PathChanged();
+
+    /// \brief Notify that recording started or stopped
+    signals: void RecordingChanged();
+
+    /// \brief Notify that a log was opened
+    signals: void LoadedChanged();
+
+    /// \brief Notify that playback started or stopped
+    signals: void PlayingChanged();
+
+    /// \brief Notify that the playback position changed
+    signals: void PositionChanged();
+
+    /// \brief Notify that the playback speed changed
+    signals: void RateChanged();
+
+    /// \brief Notify that the status changed
+    signals: void StatusChanged();
+
+    /// \brief Update the status while recording
+    private: void UpdateStatus();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<TopicRecorderPrivate> dataPtr;
+  };
+}
+}
+}
+#endif
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+import QtQuick 2.9
+import QtQuick.Controls 2.1
+import QtQuick.Dialogs 1.0
+import QtQuick.Layouts 1.3
+
+Rectangle {
+  id: topicRecorder
+  color: "transparent"
+  Layout.minimumWidth: 400
+  Layout.minimumHeight: 180
+
+  function formatTime(_seconds) {
+    var minutes = Math.floor(_seconds / 60)
+    var seconds = _seconds - minutes * 60
+    return minutes + ":" + (seconds < 10 ? "0" : "") + seconds.toFixed(1)
+  }
+
+  FileDialog {
+    id: fileDialog
+    title: qsTr("Log file")
+    selectExisting: false
+    nameFilters: ["Logs (*.log)", "All files (*)"]
+    onAccepted: TopicRecorder.SetPath(fileDialog.fileUrl)
+  }
+
+  ColumnLayout {
+    anchors.fill: parent
+    anchors.margins: 10
+
+    RowLayout {
+      Layout.fillWidth: true
+
+      TextField {
+        objectName: "pathField"
+        text: TopicRecorder.path
+        selectByMouse: true
+        Layout.fillWidth: true
+        onEditingFinished: TopicRecorder.SetPath(text)
+      }
+
+      Button {
+        text: qsTr("...")
+        implicitWidth: 30
+        ToolTip.visible: hovered
+        ToolTip.text: qsTr("Choose the log file")
+        onClicked: fileDialog.open()
+      }
+    }
+
+    RowLayout {
+      Layout.fillWidth: true
+
+      Button {
+        objectName: "recordButton"
+        text: TopicRecorder.recording ? qsTr("Stop") : qsTr("Record")
+        ToolTip.visible: hovered
+        ToolTip.text: qsTr("Record the displayed topics to the log file")
+        onClicked: {
+          if (TopicRecorder.recording)
+            TopicRecorder.StopRecording()
+          else
+            TopicRecorder.StartRecording()
+        }
+      }
+
+      Button {
+        text: qsTr("Open")
+        enabled: !TopicRecorder.recording
+        ToolTip.visible: hovered
+        ToolTip.text: qsTr("Open the log file for playback")
+        onClicked: TopicRecorder.Open()
+      }
+
+      Button {
+        objectName: "playButton"
+        text: TopicRecorder.playing ? qsTr("Pause") : qsTr("Play")
+        enabled: TopicRecorder.loaded
+        onClicked: {
+          if (TopicRecorder.playing)
+            TopicRecorder.Pause()
+          else
+            TopicRecorder.Play()
+        }
+      }
+
+      Label {
+        text: qsTr("Speed")
+      }
+
+      SpinBox {
+        id: rateSpin
+        from: 1
+        to: 10000
+        stepSize: 25
+        value: TopicRecorder.rate * 100
+        editable: true
+        ToolTip.visible: hovered
+        ToolTip.text: qsTr("Playback speed, in percent of real time")
+        onValueModified: TopicRecorder.SetRate(value / 100)
+      }
+    }
+
+    RowLayout {
+      Layout.fillWidth: true
+
+      Slider {
+        id: slider
+        objectName: "positionSlider"
+        enabled: TopicRecorder.loaded
+        from: 0
+        to: Math.max(TopicRecorder.duration, 0.001)
+        Layout.fillWidth: true
+
+        // Follows the playback unless dragged, which scrubs through the log
+        Binding {
+          target: slider
+          property: "value"
+          value: TopicRecorder.position
+          when: !slider.pressed
+        }
+        onMoved: TopicRecorder.Seek(value)
+      }
+
+      Label {
+        text: topicRecorder.formatTime(TopicRecorder.position) + " / " +
+            topicRecorder.formatTime(TopicRecorder.duration)
+      }
+    }
+
+    Label {
+      objectName: "statusLabel"
+      text: TopicRecorder.status
+      elide: Text.ElideRight
+      Layout.fillWidth: true
+    }
+
+    Item {
+      Layout.fillHeight: true
+    }
+  }
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/msgs/stringmsg.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/Plugin.hh"
+#include "gz/gui/qt.h"
+#include "test_config.hh"  // NOLINT(build/include)
+
+#include "TopicRecorder.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./TopicRecorder_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(TopicRecorderTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(RecordAndPlay))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(common::joinPaths(PROJECT_BINARY_PATH, "lib"));
+
+  auto path = common::joinPaths(PROJECT_BINARY_PATH, "test_topics.log");
+  common::removeFile(path);
+
+  const std::string pluginStr =
+    "<plugin filename=\"TopicRecorder\">"
+      "<topic>/test/recorded</topic>"
+      "<keyframe_period>0.05</keyframe_period>"
+      "<path>" + path + "</path>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr.c_str()));
+  EXPECT_TRUE(app.LoadPlugin("TopicRecorder",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  auto plugins = win->findChildren<plugins::TopicRecorder *>();
+  ASSERT_EQ(1, plugins.size());
+  auto plugin = plugins[0];
+  EXPECT_EQ("Topic recorder", plugin->Title());
+  EXPECT_EQ(QString::fromStdString(path), plugin->Path());
+  EXPECT_FALSE(plugin->Recording());
+  EXPECT_FALSE(plugin->Loaded());
+
+  // Record
+  ASSERT_TRUE(plugin->StartRecording());
+  EXPECT_TRUE(plugin->Recording());
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::StringMsg>("/test/recorded");
+  int sleep = 0;
+  while (!pub.HasConnections() && sleep < 100)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ++sleep;
+  }
+
+  const int count = 10;
+  msgs::StringMsg msg;
+  for (int i = 0; i < count; ++i)
+  {
+    msg.set_data(std::to_string(i));
+    pub.Publish(msg);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    QCoreApplication::processEvents();
+  }
+  pub = transport::Node::Publisher();
+
+  plugin->StopRecording();
+  EXPECT_FALSE(plugin->Recording());
+  EXPECT_TRUE(common::exists(path));
+
+  // Playback is received on the original topic
+  std::mutex mutex;
+  std::vector<std::string> received;
+  std::function<void(const msgs::StringMsg &)> cb =
+      [&](const msgs::StringMsg &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.push_back(_msg.data());
+      };
+  EXPECT_TRUE(node.Subscribe("/test/recorded", cb));
+
+  ASSERT_TRUE(plugin->Open());
+  EXPECT_TRUE(plugin->Loaded());
+  EXPECT_FALSE(plugin->Playing());
+  EXPECT_GT(plugin->Duration(), 0.1);
+  EXPECT_DOUBLE_EQ(0.0, plugin->Position());
+  EXPECT_TRUE(plugin->Status().startsWith(QString::number(count)))
+      << plugin->Status().toStdString();
+
+  auto waitFor = [&](const std::function<bool()> &_done)
+  {
+    for (int i = 0; i < 300 && !_done(); ++i)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      QCoreApplication::processEvents();
+    }
+    return _done();
+  };
+
+  // Seeking publishes the latest message at the position
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    received.clear();
+  }
+  plugin->Seek(plugin->Duration());
+  ASSERT_TRUE(waitFor([&]
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !received.empty();
+  }));
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(std::to_string(count - 1), received.back());
+  }
+  EXPECT_TRUE(waitFor([&] {return plugin->Position() > 0.1;}));
+
+  // Playing from the start, faster than real time, publishes every
+  // message in order
+  plugin->SetRate(4.0);
+  EXPECT_DOUBLE_EQ(4.0, plugin->Rate());
+  plugin->Seek(0.0);
+  EXPECT_TRUE(waitFor([&] {return plugin->Position() < 0.01;}));
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    received.clear();
+  }
+  plugin->Play();
+  EXPECT_TRUE(plugin->Playing());
+  ASSERT_TRUE(waitFor([&] {return !plugin->Playing();}));
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(static_cast<std::size_t>(count), received.size());
+    for (int i = 0; i < count; ++i)
+      EXPECT_EQ(std::to_string(i), received[i]);
+  }
+  EXPECT_DOUBLE_EQ(plugin->Duration(), plugin->Position());
+
+  // Invalid logs aren't opened
+  plugin->SetPath(QString::fromStdString(
+      common::joinPaths(PROJECT_BINARY_PATH, "missing_topics.log")));
+  EXPECT_FALSE(plugin->Open());
+  EXPECT_FALSE(plugin->Loaded());
+
+  common::removeFile(path);
+}
@@ -0,0 +1,353 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <gz/msgs/param.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/plugin/Register.hh>
+#include <gz/transport/MessageInfo.hh>
+#include <gz/transport/Node.hh>
+#include <gz/transport/TopicUtils.hh>
+
+#include "gz/gui/StaticPlugins.hh"
+#include "gz/gui/TopicDiscovery.hh"
+
+#include "TopicStats.hh"
+
+/// \brief Clock of the arrival times
+using Clock = std::chrono::steady_clock;
+
+/// \brief Counters of a topic over a window
+struct Window
+{
+  /// \brief Messages received
+  uint64_t count{0u};
+
+  /// \brief Bytes received
+  uint64_t bytes{0u};
+
+  /// \brief Number of intervals between messages
+  uint64_t intervals{0u};
+
+  /// \brief Sum of the intervals, in ms
+  double sum{0.0};
+
+  /// \brief Sum of the squared intervals, in ms^2
+  double sumSquares{0.0};
+};
+
+/// \brief Counters of a topic, updated by its raw callback
+struct Counter
+{
+  /// \brief Protects everything
+  std::mutex mutex;
+
+  /// \brief Counters of the current window
+  Window window;
+
+  /// \brief Arrival of the previous message, kept across windows so the
+  /// interval spanning two windows is counted
+  Clock::time_point last;
+
+  /// \brief True once a message was received
+  bool received{false};
+};
+
+/// \brief Private data class for TopicStats
+class gz::gui::plugins::TopicStatsPrivate
+{
+  /// \brief Window of the counters, in ms
+  public: int windowMs{1000};
+
+  /// \brief Counters of the topics measured. Shared with the callbacks,
+  /// which may still run while a topic is being unsubscribed.
+  public: std::map<std::string, std::shared_ptr<Counter>> counters;
+
+  /// \brief Time of the previous report
+  public: Clock::time_point lastReport{Clock::now()};
+
+  /// \brief Statistics, see TopicStats::Stats
+  public: QVariantList stats;
+
+  /// \brief Topics which can be measured
+  public: QStringList topicList;
+
+  /// \brief Topic the statistics are published on
+  public: std::string statsTopic{"/gui/topic_stats"};
+
+  /// \brief Message reused for every report
+  public: msgs::Param msg;
+
+  /// \brief Timer to report the statistics
+  public: QTimer reportTimer;
+
+  /// \brief Node to subscribe to the topics and publish the statistics
+  public: transport::Node node;
+
+  /// \brief Publisher of the statistics
+  public: transport::Node::Publisher pub;
+};
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TopicStats::TopicStats()
+  : Plugin(), dataPtr(std::make_unique<TopicStatsPrivate>())
+{
+  this->connect(&this->dataPtr->reportTimer, &QTimer::timeout, this,
+      &TopicStats::Report);
+
+  // Topics are listed as the discovery notices them
+  auto discovery = TopicDiscovery::Instance();
+  auto updateList = [this]()
+  {
+    this->dataPtr->topicList.clear();
+    for (const auto &topic : TopicDiscovery::Instance()->Topics())
+      this->dataPtr->topicList.push_back(QString::fromStdString(topic));
+    this->TopicListChanged();
+  };
+  this->connect(discovery, &TopicDiscovery::TopicAdded, this, updateList);
+  this->connect(discovery, &TopicDiscovery::TopicRemoved, this, updateList);
+  updateList();
+}
+
+/////////////////////////////////////////////////
+TopicStats::~TopicStats()
+{
+  for (const auto &counter : this->dataPtr->counters)
+    this->dataPtr->node.Unsubscribe(counter.first);
+}
+
+/////////////////////////////////////////////////
+void TopicStats::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Topic stats";
+
+  if (_pluginElem)
+  {
+    auto elem = _pluginElem->FirstChildElement("window");
+    if (nullptr != elem)
+    {
+      double window{0.0};
+      if (elem->QueryDoubleText(&window) == tinyxml2::XML_SUCCESS &&
+          window >= 0.1)
+      {
+        this->dataPtr->windowMs = static_cast<int>(window * 1000.0);
+      }
+      else
+      {
+        gzerr << "Invalid <window>, expected at least 0.1 seconds"
+              << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("stats_topic");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      auto topic = transport::TopicUtils::AsValidTopic(elem->GetText());
+      if (topic.empty())
+      {
+        gzerr << "Invalid <stats_topic> [" << elem->GetText()
+              << "], publishing on [" << this->dataPtr->statsTopic << "]"
+              << std::endl;
+      }
+      else
+      {
+        this->dataPtr->statsTopic = topic;
+      }
+    }
+
+    for (auto topicElem = _pluginElem->FirstChildElement("topic");
+        nullptr != topicElem;
+        topicElem = topicElem->NextSiblingElement("topic"))
+    {
+      if (nullptr != topicElem->GetText())
+        this->AddTopic(QString::fromStdString(topicElem->GetText()));
+    }
+  }
+
+  this->dataPtr->pub = this->dataPtr->node.Advertise<msgs::Param>(
+      this->dataPtr->statsTopic);
+  if (!this->dataPtr->pub)
+  {
+    gzerr << "Failed to advertise [" << this->dataPtr->statsTopic << "]"
+          << std::endl;
+  }
+
+  this->dataPtr->lastReport = Clock::now();
+  if (!this->dataPtr->reportTimer.isActive())
+    this->dataPtr->reportTimer.start(this->dataPtr->windowMs);
+}
+
+/////////////////////////////////////////////////
+bool TopicStats::AddTopic(const QString &_topic)
+{
+  auto topic = transport::TopicUtils::AsValidTopic(_topic.toStdString());
+  if (topic.empty())
+  {
+    gzerr << "Invalid topic [" << _topic.toStdString() << "]" << std::endl;
+    return false;
+  }
+  if (this->dataPtr->counters.find(topic) != this->dataPtr->counters.end())
+    return true;
+
+  // Only the size and arrival time are recorded, the message isn't parsed
+  auto counter = std::make_shared<Counter>();
+  std::function<void(const char *, const size_t,
+      const transport::MessageInfo &)> cb =
+      [counter](const char *, const size_t _size,
+          const transport::MessageInfo &)
+      {
+        auto now = Clock::now();
+        std::lock_guard<std::mutex> lock(counter->mutex);
+        auto &window = counter->window;
+        ++window.count;
+        window.bytes += _size;
+        if (counter->received)
+        {
+          double ms = std::chrono::duration<double, std::milli>(
+              now - counter->last).count();
+          ++window.intervals;
+          window.sum += ms;
+          window.sumSquares += ms * ms;
+        }
+        counter->last = now;
+        counter->received = true;
+      };
+
+  if (!this->dataPtr->node.SubscribeRaw(topic, cb))
+  {
+    gzerr << "Failed to subscribe to [" << topic << "]" << std::endl;
+    return false;
+  }
+
+  // Shown once its first window is reported
+  this->dataPtr->counters[topic] = counter;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void TopicStats::RemoveTopic(const QString &_topic)
+{
+  auto it = this->dataPtr->counters.find(_topic.toStdString());
+  if (it == this->dataPtr->counters.end())
+    return;
+
+  this->dataPtr->node.Unsubscribe(it->first);
+  this->dataPtr->counters.erase(it);
+
+  auto &stats = this->dataPtr->stats;
+  for (int i = 0; i < stats.size(); ++i)
+  {
+    if (stats[i].toMap()["topic"].toString() == _topic)
+    {
+      stats.removeAt(i);
+      this->StatsChanged();
+      break;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void TopicStats::Report()
+{
+  auto &data = *this->dataPtr;
+
+  // Normalized to the actual window, in case the timer was late
+  auto now = Clock::now();
+  double seconds = std::chrono::duration<double>(now - data.lastReport)
+      .count();
+  data.lastReport = now;
+
+  auto params = data.msg.mutable_params();
+  params->clear();
+  auto setDouble = [params](const std::string &_name, double _value)
+  {
+    auto &param = (*params)[_name];
+    param.set_type(msgs::Any::DOUBLE);
+    param.set_double_value(_value);
+  };
+
+  data.stats.clear();
+  for (const auto &counter : data.counters)
+  {
+    Window window;
+    {
+      std::lock_guard<std::mutex> lock(counter.second->mutex);
+      std::swap(window, counter.second->window);
+    }
+
+    double rate = seconds > 0.0 ? window.count / seconds : 0.0;
+    double bandwidth = seconds > 0.0 ? window.bytes / seconds : 0.0;
+    double size = window.count > 0u ?
+        static_cast<double>(window.bytes) / window.count : 0.0;
+
+    // Standard deviation of the intervals
+    double jitter{0.0};
+    if (window.intervals > 1u)
+    {
+      double mean = window.sum / window.intervals;
+      double variance = window.sumSquares / window.intervals - mean * mean;
+      jitter = variance > 0.0 ? std::sqrt(variance) : 0.0;
+    }
+
+    QVariantMap entry;
+    entry["topic"] = QString::fromStdString(counter.first);
+    entry["rate"] = rate;
+    entry["bandwidth"] = bandwidth;
+    entry["size"] = size;
+    entry["jitter"] = jitter;
+    data.stats.append(entry);
+
+    setDouble(counter.first + "/rate", rate);
+    setDouble(counter.first + "/bandwidth", bandwidth);
+    setDouble(counter.first + "/size", size);
+    setDouble(counter.first + "/jitter", jitter);
+  }
+
+  this->StatsChanged();
+
+  if (data.pub && !data.counters.empty())
+    data.pub.Publish(data.msg);
+}
+
+/////////////////////////////////////////////////
+QVariantList TopicStats::Stats() const
+{
+  return this->dataPtr->stats;
+}
+
+/////////////////////////////////////////////////
+QStringList TopicStats::TopicList() const
+{
+  return this->dataPtr->topicList;
+}
+
+// Register this plugin
+GZ_GUI_ADD_PLUGIN(gz::gui::plugins::TopicStats, "TopicStats")
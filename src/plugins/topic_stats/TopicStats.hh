@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_GUI_PLUGINS_TOPICSTATS_HH_
+#define GZ_GUI_PLUGINS_TOPICSTATS_HH_
+
+#include <memory>
+
+#include "gz/gui/Plugin.hh"
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  class TopicStatsPrivate;
+
+  /// \brief Measures the rate, bandwidth, mean message size and
+  /// inter-arrival jitter of chosen topics.
+  ///
+  /// Topics are subscribed to with raw callbacks, so messages of any type
+  /// are counted without being deserialized, and only their size and
+  /// arrival time are recorded. The counters cover a fixed window, and
+  /// are reset once it's reported. Topics to choose from are listed by
+  /// TopicDiscovery.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<topic\> : May be repeated. Topic measured from the start.
+  /// * \<window\> : Window of the counters, in seconds, defaults to 1.
+  /// * \<stats_topic\> : Topic the statistics are also published on, as a
+  ///               gz.msgs.Param with `<topic>/rate` in Hz,
+  ///               `<topic>/bandwidth` in bytes per second,
+  ///               `<topic>/size` in bytes and `<topic>/jitter` in ms.
+  ///               Defaults to `/gui/topic_stats`.
+  class TopicStats : public Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Topics measured, each a map with topic, rate, bandwidth,
+    /// size and jitter
+    Q_PROPERTY(
+      QVariantList stats
+      READ Stats
+      NOTIFY StatsChanged
+    )
+
+    /// \brief Topics which can be measured
+    Q_PROPERTY(
+      QStringList topicList
+      READ TopicList
+      NOTIFY TopicListChanged
+    )
+
+    /// \brief Constructor
+    public: TopicStats();
+
+    /// \brief Destructor
+    public: ~TopicStats() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+        override;
+
+    /// \brief Get the statistics of the topics measured.
+    /// \return List of maps, sorted by topic
+    public: Q_INVOKABLE QVariantList Stats() const;
+
+    /// \brief Get the topics which can be measured.
+    /// \return Topics known to the discovery, sorted
+    public: Q_INVOKABLE QStringList TopicList() const;
+
+    /// \brief Start measuring a topic.
+    /// \param[in] _topic Topic name
+    /// \return True if it's measured, false if it's invalid or couldn't be
+    /// subscribed to
+    public: Q_INVOKABLE bool AddTopic(const QString &_topic);
+
+    /// \brief Stop measuring a topic.
+    /// \param[in] _topic Topic name
+    public: Q_INVOKABLE void RemoveTopic(const QString &_topic);
+
+    /// \brief Notify that the statistics have been updated
+    signals: void StatsChanged();
+
+    /// \brief Notify that the topics which can be measured changed
+    signals: void TopicListChanged();
+
+    /// \brief Take the counters of the window, and update the properties
+    /// and the topic
+    private: void Report();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<TopicStatsPrivate> dataPtr;
+  };
+}
+}
+}
+#endif
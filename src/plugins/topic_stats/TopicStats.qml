@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+import QtQuick 2.9
+import QtQuick.Controls 2.1
+import QtQuick.Layouts 1.3
+
+Rectangle {
+  id: topicStats
+  color: "transparent"
+  Layout.minimumWidth: 420
+  Layout.minimumHeight: 200
+
+  function formatBytes(_bytes) {
+    if (_bytes >= 1024 * 1024)
+      return (_bytes / (1024 * 1024)).toFixed(1) + " MB"
+    if (_bytes >= 1024)
+      return (_bytes / 1024).toFixed(1) + " KB"
+    return _bytes.toFixed(0) + " B"
+  }
+
+  ColumnLayout {
+    anchors.fill: parent
+    anchors.margins: 10
+
+    RowLayout {
+      Layout.fillWidth: true
+
+      ComboBox {
+        id: combo
+        objectName: "topicsCombo"
+        editable: true
+        model: TopicStats.topicList
+        Layout.fillWidth: true
+        ToolTip.visible: hovered
+        ToolTip.text: qsTr("Gazebo Transport topics")
+      }
+
+      Button {
+        text: qsTr("Add")
+        enabled: combo.editText !== ""
+        onClicked: TopicStats.AddTopic(combo.editText)
+      }
+    }
+
+    GridLayout {
+      columns: 6
+      Layout.fillWidth: true
+
+      Label {
+        font.weight: Font.DemiBold
+        text: "Topic"
+        Layout.fillWidth: true
+      }
+
+      Label {
+        ToolTip.text: qsTr("Messages per second")
+        font.weight: Font.DemiBold
+        text: "Rate"
+      }
+
+      Label {
+        ToolTip.text: qsTr("Serialized bytes per second")
+        font.weight: Font.DemiBold
+        text: "Bandwidth"
+      }
+
+      Label {
+        ToolTip.text: qsTr("Mean serialized message size")
+        font.weight: Font.DemiBold
+        text: "Size"
+      }
+
+      Label {
+        ToolTip.text: qsTr("Standard deviation of the time between " +
+            "messages, in ms")
+        font.weight: Font.DemiBold
+        text: "Jitter"
+      }
+
+      Item {
+        width: 20
+      }
+    }
+
+    ListView {
+      id: statsList
+      objectName: "statsList"
+      clip: true
+      model: TopicStats.stats
+      Layout.fillWidth: true
+      Layout.fillHeight: true
+
+      delegate: GridLayout {
+        columns: 6
+        width: statsList.width
+
+        Label {
+          text: modelData.topic
+          elide: Text.ElideRight
+          Layout.fillWidth: true
+        }
+
+        Label {
+          text: modelData.rate.toFixed(1) + " Hz"
+        }
+
+        Label {
+          text: topicStats.formatBytes(modelData.bandwidth) + "/s"
+        }
+
+        Label {
+          text: topicStats.formatBytes(modelData.size)
+        }
+
+        Label {
+          text: modelData.jitter.toFixed(2)
+        }
+
+        ToolButton {
+          text: "x"
+          ToolTip.visible: hovered
+          ToolTip.text: qsTr("Stop measuring")
+          implicitWidth: 20
+          onClicked: TopicStats.RemoveTopic(modelData.topic)
+        }
+      }
+    }
+  }
+}
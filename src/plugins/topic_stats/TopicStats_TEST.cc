@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <gz/msgs/param.pb.h>
+#include <gz/msgs/stringmsg.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/Plugin.hh"
+#include "gz/gui/qt.h"
+#include "test_config.hh"  // NOLINT(build/include)
+
+#include "TopicStats.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./TopicStats_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(TopicStatsTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Measure))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(common::joinPaths(PROJECT_BINARY_PATH, "lib"));
+
+  std::mutex mutex;
+  msgs::Param received;
+  std::atomic<bool> hasReport{false};
+  transport::Node node;
+  std::function<void(const msgs::Param &)> cb =
+      [&](const msgs::Param &_msg)
+      {
+        auto it = _msg.params().find("/test/measured/rate");
+        if (it == _msg.params().end() || it->second.double_value() <= 0.0)
+          return;
+        std::lock_guard<std::mutex> lock(mutex);
+        received = _msg;
+        hasReport = true;
+      };
+  EXPECT_TRUE(node.Subscribe("/test/topic_stats", cb));
+
+  const char *pluginStr =
+    "<plugin filename=\"TopicStats\">"
+      "<topic>/test/measured</topic>"
+      "<window>0.5</window>"
+      "<stats_topic>/test/topic_stats</stats_topic>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+  EXPECT_TRUE(app.LoadPlugin("TopicStats",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  auto plugins = win->findChildren<plugins::TopicStats *>();
+  ASSERT_EQ(1, plugins.size());
+  auto plugin = plugins[0];
+  EXPECT_EQ("Topic stats", plugin->Title());
+
+  // Any message type is counted by its serialized size
+  auto pub = node.Advertise<msgs::StringMsg>("/test/measured");
+  msgs::StringMsg msg;
+  msg.set_data(std::string(1000, 'x'));
+  auto size = static_cast<double>(msg.ByteSizeLong());
+
+  int sleep = 0;
+  int maxSleep = 100;
+  while (!hasReport && sleep < maxSleep)
+  {
+    pub.Publish(msg);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    QCoreApplication::processEvents();
+    ++sleep;
+  }
+  ASSERT_TRUE(hasReport);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_DOUBLE_EQ(size,
+        received.params().at("/test/measured/size").double_value());
+    EXPECT_GT(received.params().at("/test/measured/bandwidth")
+        .double_value(), 0.0);
+    EXPECT_GE(received.params().at("/test/measured/jitter")
+        .double_value(), 0.0);
+  }
+
+  auto stats = plugin->Stats();
+  ASSERT_EQ(1, stats.size());
+  auto map = stats[0].toMap();
+  EXPECT_EQ("/test/measured", map["topic"].toString());
+  EXPECT_GT(map["rate"].toDouble(), 0.0);
+  EXPECT_DOUBLE_EQ(size, map["size"].toDouble());
+
+  // Topics can be added and removed
+  EXPECT_FALSE(plugin->AddTopic(""));
+  EXPECT_TRUE(plugin->AddTopic("/test/other"));
+  EXPECT_TRUE(plugin->AddTopic("/test/other"));
+  plugin->RemoveTopic("/test/measured");
+  EXPECT_TRUE(plugin->Stats().isEmpty());
+
+  // The new topic is reported with the next window, even without messages
+  sleep = 0;
+  while (plugin->Stats().isEmpty() && sleep < 20)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+    ++sleep;
+  }
+  ASSERT_EQ(1, plugin->Stats().size());
+  map = plugin->Stats()[0].toMap();
+  EXPECT_EQ("/test/other", map["topic"].toString());
+  EXPECT_DOUBLE_EQ(0.0, map["rate"].toDouble());
+}
@@ -16,21 +16,20 @@
 */
 
 #include <QModelIndex>
-#include <QStandardItem>
 #include <QString>
 
-#include <deque>
+#include <algorithm>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include <gz/common/Console.hh>
 #include <gz/gui/Application.hh>
+#include <gz/gui/StaticPlugins.hh>
+#include <gz/gui/TopicDiscovery.hh>
 #include <gz/plugin/Register.hh>
 #include <gz/msgs/Factory.hh>
-#include <gz/transport/MessageInfo.hh>
-#include <gz/transport/Node.hh>
-#include <gz/transport/Publisher.hh>
 
 #include "TopicViewer.hh"
 
@@ -52,11 +51,105 @@ namespace gui
 {
 namespace plugins
 {
+  /// \brief Field of a message type, as shown in the tree
+  struct FieldInfo
+  {
+    /// \brief Field name
+    std::string name;
+
+    /// \brief Displayed type, the message name for message fields
+    std::string type;
+
+    /// \brief True if the field can be plotted
+    bool plottable{false};
+
+    /// \brief Type of a message field, null for other fields
+    const google::protobuf::Descriptor *descriptor{nullptr};
+  };
+
+  /// \brief Item of the tree, either a topic or a field of its message.
+  /// Children are only created the first time the item is expanded.
+  struct TopicsNode
+  {
+    /// \brief Parent item, null for the root
+    TopicsNode *parent{nullptr};
+
+    /// \brief Row within the parent
+    int row{0};
+
+    /// \brief Topic name or field name
+    std::string name;
+
+    /// \brief Message type of topics, displayed type of fields
+    std::string type;
+
+    /// \brief Topic of the item
+    std::string topic;
+
+    /// \brief Field names from the topic to the field, separated by '-',
+    /// empty for topics
+    std::string path;
+
+    /// \brief True if the field can be plotted
+    bool plottable{false};
+
+    /// \brief Fields of the item's message type, shared by all the items
+    /// of that type. Null if the item isn't a message.
+    const std::vector<FieldInfo> *fields{nullptr};
+
+    /// \brief True once the children were created from the fields
+    bool fetched{false};
+
+    /// \brief Children, in the order of the fields
+    std::vector<std::unique_ptr<TopicsNode>> children;
+  };
+
   /// \brief Model for the Topics and their Msgs and Fields
   /// a tree model that represents the topics tree with its Msgs
-  /// Childeren and each msg node has its own fileds/msgs childeren
-  class TopicsModel : public QStandardItemModel
+  /// Childeren and each msg node has its own fileds/msgs childeren.
+  /// The fields of each message type are read from its descriptor once,
+  /// and items are only created as they're expanded.
+  class TopicsModel : public QAbstractItemModel
   {
+    /// \brief Add a topic at the end
+    /// \param[in] _topic Topic name
+    /// \param[in] _msgType Message type name
+    public: void AddTopic(const std::string &_topic,
+                          const std::string &_msgType);
+
+    /// \brief Remove a topic
+    /// \param[in] _topic Topic name
+    public: void RemoveTopic(const std::string &_topic);
+
+    // Documentation inherited
+    public: QModelIndex index(int _row, int _column,
+        const QModelIndex &_parent = QModelIndex()) const override;
+
+    // Documentation inherited
+    public: QModelIndex parent(const QModelIndex &_index) const override;
+
+    // Documentation inherited
+    public: int rowCount(
+        const QModelIndex &_parent = QModelIndex()) const override;
+
+    // Documentation inherited
+    public: int columnCount(
+        const QModelIndex &_parent = QModelIndex()) const override;
+
+    // Documentation inherited
+    public: bool hasChildren(
+        const QModelIndex &_parent = QModelIndex()) const override;
+
+    // Documentation inherited
+    public: bool canFetchMore(const QModelIndex &_parent) const override;
+
+    // Documentation inherited
+    public: void fetchMore(const QModelIndex &_parent) override;
+
+    // Documentation inherited
+    public: QVariant data(const QModelIndex &_index,
+        int _role = Qt::DisplayRole) const override;
+
     /// \brief roles and names of the model
     public: QHash<int, QByteArray> roleNames() const override
     {
@@ -68,79 +161,44 @@ namespace plugins
       roles[PLOT_ROLE] = PLOT_KEY;
       return roles;
     }
+
+    /// \brief Get the item of an index
+    /// \param[in] _index Index, invalid for the root
+    /// \return Item
+    private: TopicsNode *Node(const QModelIndex &_index) const;
+
+    /// \brief Get the fields of a message type, reading them the first
+    /// time.
+    /// \param[in] _descriptor Message type
+    /// \return Fields
+    private: const std::vector<FieldInfo> *Fields(
+        const google::protobuf::Descriptor *_descriptor);
+
+    /// \brief Get the fields of a message type by name.
+    /// \param[in] _msgType Message type name
+    /// \return Fields, null if the type is unknown
+    private: const std::vector<FieldInfo> *Fields(
+        const std::string &_msgType);
+
+    /// \brief Invisible root, whose children are the topics
+    private: TopicsNode root;
+
+    /// \brief Fields by message type
+    private: std::map<const google::protobuf::Descriptor *,
+        std::vector<FieldInfo>> fieldsByType;
+
+    /// \brief Message type by name, null for unknown types
+    private: std::map<std::string, const google::protobuf::Descriptor *>
+        descriptors;
   };
 
   class TopicViewerPrivate
   {
-    /// \brief Node for Commincation
-    public: gz::transport::Node node;
-
     /// \brief Model to create it from the available topics and messages
     public: TopicsModel *model;
 
-    /// \brief Timer to update the model and keep track of its changes
-    public: QTimer *timer;
-
-    /// \brief topic: msgType map to keep track of the model current topics
-    public: std::map<std::string, std::string> currentTopics;
-
     /// \brief Create the fields model
     public: void CreateModel();
-
-    /// \brief add a topic to the model
-    /// \param[in] _topic topic name to be displayed
-    /// \param[in] _msg topic's msg type
-    public: void AddTopic(const std::string &_topic,
-                         const std::string &_msg);
-
-    /// \brief add a field/msg child to that parent item
-    /// \param[in] _parentItem a parent for the added field/msg
-    /// \param[in] _msgName the displayed name of the field/msg
-    /// \param[in] _msgType field/msg type
-    public: void AddField(QStandardItem *_parentItem,
-                       const std::string &_msgName,
-                       const std::string &_msgType);
-
-    /// \brief factory method for creating an item
-    /// \param[in] _name the display name
-    /// \param[in] _type type of the field of the item
-    /// \param[in] _path a set of concatenate strings of parent msgs
-    /// names that lead to that field, starting from the most parent
-    /// ex : if we have [Collision]msg contains [pose]msg contains [position]
-    /// msg contains [x,y,z] fields, so the path of x = "pose-position-x"
-    /// \param[in] _topic the name of the most parent item
-    /// \return the created Item
-    public: QStandardItem *FactoryItem(const std::string &_name,
-                                      const std::string &_type,
-                                      const std::string &_path = "",
-                                      const std::string &_topic = "");
-
-    /// \brief set the topic role name of the item with the most
-    /// topic parent of that field item
-    /// \param[in] _item item ref to set its topic
-    public: void SetItemTopic(QStandardItem *_item);
-
-    /// \brief set the path/ID of the givin item starting from
-    /// the most topic parent to the field itself
-    /// \param[in] _item item ref to set its path
-    public: void SetItemPath(QStandardItem *_item);
-
-    /// \brief get the topic name of selected item
-    /// \param[in] _item ref to the item to get its parent topic
-    public: std::string TopicName(const QStandardItem *_item) const;
-
-    /// \brief full path starting from topic name till the msg name
-    /// \param[in] _index index of the QStanadardItem
-    /// \return string with all elements separated by '/'
-    public: std::string ItemPath(const QStandardItem *_item) const;
-
-    /// \brief check if the type is supported in the plotting types
-    /// \param[in] _type the msg type to check if it is supported
-    public: bool IsPlotable(
-            const google::protobuf::FieldDescriptor::Type &_type);
-
-    /// \brief supported types for plotting
-    public: std::vector<google::protobuf::FieldDescriptor::Type> plotableTypes;
   };
 }
 }
@@ -150,280 +208,299 @@ using namespace gz;
 using namespace gui;
 using namespace plugins;
 
-TopicViewer::TopicViewer() : Plugin(), dataPtr(new TopicViewerPrivate)
+namespace
+{
+/// \brief Check if the type is supported in the plotting types
+/// \param[in] _type Field type
+/// \return True if it can be plotted
+bool IsPlotable(google::protobuf::FieldDescriptor::Type _type)
 {
-  using namespace google::protobuf;
-  this->dataPtr->plotableTypes.push_back(FieldDescriptor::Type::TYPE_DOUBLE);
-  this->dataPtr->plotableTypes.push_back(FieldDescriptor::Type::TYPE_FLOAT);
-  this->dataPtr->plotableTypes.push_back(FieldDescriptor::Type::TYPE_INT32);
-  this->dataPtr->plotableTypes.push_back(FieldDescriptor::Type::TYPE_INT64);
-  this->dataPtr->plotableTypes.push_back(FieldDescriptor::Type::TYPE_UINT32);
-  this->dataPtr->plotableTypes.push_back(FieldDescriptor::Type::TYPE_UINT64);
-  this->dataPtr->plotableTypes.push_back(FieldDescriptor::Type::TYPE_BOOL);
+  using FieldDescriptor = google::protobuf::FieldDescriptor;
+  switch (_type)
+  {
+    case FieldDescriptor::Type::TYPE_DOUBLE:
+    case FieldDescriptor::Type::TYPE_FLOAT:
+    case FieldDescriptor::Type::TYPE_INT32:
+    case FieldDescriptor::Type::TYPE_INT64:
+    case FieldDescriptor::Type::TYPE_UINT32:
+    case FieldDescriptor::Type::TYPE_UINT64:
+    case FieldDescriptor::Type::TYPE_BOOL:
+      return true;
+    default:
+      return false;
+  }
+}
+}
 
-  this->dataPtr->CreateModel();
+/////////////////////////////////////////////////
+void TopicsModel::AddTopic(const std::string &_topic,
+                           const std::string &_msgType)
+{
+  auto node = std::make_unique<TopicsNode>();
+  node->parent = &this->root;
+  node->row = static_cast<int>(this->root.children.size());
+  node->name = _topic;
+  node->type = _msgType;
+  node->topic = _topic;
+  node->fields = this->Fields(_msgType);
+
+  this->beginInsertRows(QModelIndex(), node->row, node->row);
+  this->root.children.push_back(std::move(node));
+  this->endInsertRows();
+}
 
-  gui::App()->Engine()->rootContext()->setContextProperty(
-                "TopicsModel", this->dataPtr->model);
+/////////////////////////////////////////////////
+void TopicsModel::RemoveTopic(const std::string &_topic)
+{
+  auto &topics = this->root.children;
+  auto it = std::find_if(topics.begin(), topics.end(),
+      [&_topic](const std::unique_ptr<TopicsNode> &_node)
+      {
+        return _node->name == _topic;
+      });
+  if (it == topics.end())
+    return;
 
-  this->dataPtr->timer = new QTimer();
-  connect(this->dataPtr->timer, SIGNAL(timeout()), this, SLOT(UpdateModel()));
-  this->dataPtr->timer->start(1000);
+  int row = static_cast<int>(it - topics.begin());
+  this->beginRemoveRows(QModelIndex(), row, row);
+  topics.erase(it);
+  for (auto i = static_cast<std::size_t>(row); i < topics.size(); ++i)
+    topics[i]->row = static_cast<int>(i);
+  this->endRemoveRows();
 }
 
-//////////////////////////////////////////////////
-TopicViewer::~TopicViewer()
+/////////////////////////////////////////////////
+QModelIndex TopicsModel::index(int _row, int _column,
+    const QModelIndex &_parent) const
 {
+  auto parentNode = this->Node(_parent);
+  if (_column != 0 || _row < 0 ||
+      static_cast<std::size_t>(_row) >= parentNode->children.size())
+  {
+    return QModelIndex();
+  }
+  return this->createIndex(_row, 0, parentNode->children[_row].get());
 }
 
-//////////////////////////////////////////////////
-void TopicViewer::LoadConfig(const tinyxml2::XMLElement *)
+/////////////////////////////////////////////////
+QModelIndex TopicsModel::parent(const QModelIndex &_index) const
 {
-  if (this->title.empty())
-    this->title = "Topic Viewer";
+  if (!_index.isValid())
+    return QModelIndex();
+
+  auto parentNode = this->Node(_index)->parent;
+  if (!parentNode || parentNode == &this->root)
+    return QModelIndex();
+  return this->createIndex(parentNode->row, 0, parentNode);
 }
 
-//////////////////////////////////////////////////
-QStandardItemModel *TopicViewer::Model()
+/////////////////////////////////////////////////
+int TopicsModel::rowCount(const QModelIndex &_parent) const
 {
-  return reinterpret_cast<QStandardItemModel *>(this->dataPtr->model);
+  if (_parent.column() > 0)
+    return 0;
+  return static_cast<int>(this->Node(_parent)->children.size());
 }
 
-//////////////////////////////////////////////////
-void TopicViewerPrivate::CreateModel()
+/////////////////////////////////////////////////
+int TopicsModel::columnCount(const QModelIndex &) const
 {
-  this->model = new TopicsModel();
+  return 1;
+}
 
-  std::vector<std::string> topics;
-  this->node.TopicList(topics);
+/////////////////////////////////////////////////
+bool TopicsModel::hasChildren(const QModelIndex &_parent) const
+{
+  auto node = this->Node(_parent);
+  if (!node->children.empty())
+    return true;
+  return !node->fetched && node->fields && !node->fields->empty();
+}
 
-  for (unsigned int i = 0; i < topics.size(); ++i)
-  {
-    std::vector<transport::MessagePublisher> infoMsgs;
-    this->node.TopicInfo(topics[i], infoMsgs);
-    std::string msgType = infoMsgs[0].MsgTypeName();
-    this->AddTopic(topics[i], msgType);
-  }
+/////////////////////////////////////////////////
+bool TopicsModel::canFetchMore(const QModelIndex &_parent) const
+{
+  if (!_parent.isValid())
+    return false;
+  auto node = this->Node(_parent);
+  return !node->fetched && node->fields && !node->fields->empty();
 }
 
-//////////////////////////////////////////////////
-void TopicViewerPrivate::AddTopic(const std::string &_topic,
-                           const std::string &_msg)
+/////////////////////////////////////////////////
+void TopicsModel::fetchMore(const QModelIndex &_parent)
 {
-  QStandardItem *topicItem = this->FactoryItem(_topic, _msg);
-  topicItem->setWhatsThis("Topic");
-  QStandardItem *parent = this->model->invisibleRootItem();
-  parent->appendRow(topicItem);
+  if (!this->canFetchMore(_parent))
+    return;
 
-  this->AddField(topicItem , _msg, _msg);
+  auto node = this->Node(_parent);
+  node->fetched = true;
 
-  // store the topics to keep track of them
-  this->currentTopics[_topic] = _msg;
+  this->beginInsertRows(_parent, 0,
+      static_cast<int>(node->fields->size()) - 1);
+  for (const auto &field : *node->fields)
+  {
+    auto child = std::make_unique<TopicsNode>();
+    child->parent = node;
+    child->row = static_cast<int>(node->children.size());
+    child->name = field.name;
+    child->type = field.type;
+    child->topic = node->topic;
+    child->path = node->path.empty() ? field.name :
+        node->path + "-" + field.name;
+    child->plottable = field.plottable;
+    if (field.descriptor)
+      child->fields = this->Fields(field.descriptor);
+    node->children.push_back(std::move(child));
+  }
+  this->endInsertRows();
 }
 
-//////////////////////////////////////////////////
-void TopicViewerPrivate::AddField(QStandardItem *_parentItem,
-                           const std::string &_msgName,
-                           const std::string &_msgType)
+/////////////////////////////////////////////////
+QVariant TopicsModel::data(const QModelIndex &_index, int _role) const
 {
-  QStandardItem *msgItem;
+  if (!_index.isValid())
+    return QVariant();
 
-  // check if it is a topic, to skip the extra level of the topic Msg
-  if (_parentItem->whatsThis() == "Topic")
-  {
-    msgItem = _parentItem;
-    // make it different, so next iteration will make a new msg item
-    msgItem->setWhatsThis("Msg");
-  }
-  else
+  auto node = this->Node(_index);
+  switch (_role)
   {
-    msgItem = this->FactoryItem(_msgName, _msgType);
-    _parentItem->appendRow(msgItem);
+    case Qt::DisplayRole:
+    case NAME_ROLE:
+      return QString::fromStdString(node->name);
+    case TYPE_ROLE:
+      return QString::fromStdString(node->type);
+    case TOPIC_ROLE:
+      return QString::fromStdString(node->topic);
+    case PATH_ROLE:
+      return QString::fromStdString(node->path);
+    case PLOT_ROLE:
+      return node->plottable;
+    default:
+      return QVariant();
   }
+}
 
-  auto msg = msgs::Factory::New(_msgType);
-  if (!msg)
-  {
-      gzwarn << "Null Msg: " << _msgType << std::endl;
-      return;
-  }
+/////////////////////////////////////////////////
+TopicsNode *TopicsModel::Node(const QModelIndex &_index) const
+{
+  if (!_index.isValid())
+    return const_cast<TopicsNode *>(&this->root);
+  return static_cast<TopicsNode *>(_index.internalPointer());
+}
 
-  auto msgDescriptor = msg->GetDescriptor();
-  if (!msgDescriptor)
-  {
-    gzwarn << "Null Descriptor of Msg: " << _msgType << std::endl;
-    return;
-  }
+/////////////////////////////////////////////////
+const std::vector<FieldInfo> *TopicsModel::Fields(
+    const google::protobuf::Descriptor *_descriptor)
+{
+  auto it = this->fieldsByType.find(_descriptor);
+  if (it != this->fieldsByType.end())
+    return &it->second;
 
-  for (int i = 0 ; i < msgDescriptor->field_count(); ++i)
+  auto &fields = this->fieldsByType[_descriptor];
+  for (int i = 0 ; i < _descriptor->field_count(); ++i)
   {
-    auto msgField = msgDescriptor->field(i);
+    auto msgField = _descriptor->field(i);
 
     if (msgField->is_repeated())
       continue;
 
-    auto messageType = msgField->message_type();
-
-    if (messageType)
-      this->AddField(msgItem, msgField->name(), messageType->name());
-
+    FieldInfo field;
+    field.name = msgField->name();
+    field.descriptor = msgField->message_type();
+    if (field.descriptor)
+    {
+      field.type = field.descriptor->name();
+    }
     else
     {
-      auto msgFieldItem = this->FactoryItem(msgField->name(),
-                                            msgField->type_name());
-      msgItem->appendRow(msgFieldItem);
-
-      this->SetItemPath(msgFieldItem);
-      this->SetItemTopic(msgFieldItem);
-
-      // to make the plottable items draggable
-      if (this->IsPlotable(msgField->type()))
-        msgFieldItem->setData(QVariant(true), PLOT_ROLE);
+      field.type = msgField->type_name();
+      field.plottable = IsPlotable(msgField->type());
     }
+    fields.push_back(field);
   }
+  return &fields;
 }
 
-//////////////////////////////////////////////////
-QStandardItem *TopicViewerPrivate::FactoryItem(const std::string &_name,
-                                               const std::string &_type,
-                                               const std::string &_path,
-                                               const std::string &_topic)
+/////////////////////////////////////////////////
+const std::vector<FieldInfo> *TopicsModel::Fields(
+    const std::string &_msgType)
 {
-  QString name = QString::fromStdString(_name);
-  QString type = QString::fromStdString(_type);
-  QString path = QString::fromStdString(_path);
-  QString topic = QString::fromStdString(_topic);
+  auto it = this->descriptors.find(_msgType);
+  if (it == this->descriptors.end())
+  {
+    // The descriptor outlives the message, it belongs to its pool
+    const google::protobuf::Descriptor *descriptor{nullptr};
+    auto msg = msgs::Factory::New(_msgType);
+    if (!msg)
+      gzwarn << "Null Msg: " << _msgType << std::endl;
+    else if (!msg->GetDescriptor())
+      gzwarn << "Null Descriptor of Msg: " << _msgType << std::endl;
+    else
+      descriptor = msg->GetDescriptor();
+    it = this->descriptors.emplace(_msgType, descriptor).first;
+  }
 
-  QStandardItem *item = new QStandardItem(name);
+  return it->second ? this->Fields(it->second) : nullptr;
+}
 
-  item->setData(QVariant(name), NAME_ROLE);
-  item->setData(QVariant(type), TYPE_ROLE);
-  item->setData(QVariant(path), PATH_ROLE);
-  item->setData(QVariant(topic), TOPIC_ROLE);
-  item->setData(QVariant(false), PLOT_ROLE);
+/////////////////////////////////////////////////
+TopicViewer::TopicViewer() : Plugin(), dataPtr(new TopicViewerPrivate)
+{
+  this->dataPtr->CreateModel();
+
+  gui::App()->Engine()->rootContext()->setContextProperty(
+                "TopicsModel", this->dataPtr->model);
 
-  return item;
+  // Topics are added and removed as the discovery notices them
+  auto discovery = TopicDiscovery::Instance();
+  connect(discovery, &TopicDiscovery::TopicAdded, this,
+      [this](const QString &_topic, const QString &_msgType)
+      {
+        this->dataPtr->model->AddTopic(_topic.toStdString(),
+            _msgType.toStdString());
+      });
+  connect(discovery, &TopicDiscovery::TopicRemoved, this,
+      [this](const QString &_topic)
+      {
+        this->dataPtr->model->RemoveTopic(_topic.toStdString());
+      });
 }
 
 //////////////////////////////////////////////////
-void TopicViewerPrivate::SetItemTopic(QStandardItem *_item)
+TopicViewer::~TopicViewer()
 {
-  std::string topic = this->TopicName(_item);
-  QVariant Topic(QString::fromStdString(topic));
-  _item->setData(Topic, TOPIC_ROLE);
 }
 
 //////////////////////////////////////////////////
-void TopicViewerPrivate::SetItemPath(QStandardItem *_item)
+void TopicViewer::LoadConfig(const tinyxml2::XMLElement *)
 {
-  std::string path = this->ItemPath(_item);
-  QVariant Path(QString::fromStdString(path));
-  _item->setData(Path, PATH_ROLE);
+  if (this->title.empty())
+    this->title = "Topic Viewer";
 }
 
 //////////////////////////////////////////////////
-std::string TopicViewerPrivate::TopicName(const QStandardItem *_item) const
+QAbstractItemModel *TopicViewer::Model()
 {
-  QStandardItem *parent = _item->parent();
-
-  // get the next parent until you reach the first level parent
-  while (parent)
-  {
-    _item = parent;
-    parent = parent->parent();
-  }
-
-  return _item->data(NAME_ROLE).toString().toStdString();
+  return this->dataPtr->model;
 }
 
 //////////////////////////////////////////////////
-std::string TopicViewerPrivate::ItemPath(const QStandardItem *_item) const
+void TopicViewerPrivate::CreateModel()
 {
-  std::deque<std::string> path;
-  while (_item)
-  {
-    path.push_front(_item->data(NAME_ROLE).toString().toStdString());
-    _item = _item->parent();
-  }
-
-  if (path.size())
-    path.erase(path.begin());
-
-  // convert to string
-  std::string pathString;
-
-  for (unsigned int i = 0; i < path.size()-1; ++i)
-    pathString += path[i] + "-";
-
-  if (path.size())
-    pathString += path[path.size()-1];
-
-  return pathString;
-}
+  this->model = new TopicsModel();
 
-/////////////////////////////////////////////////
-bool TopicViewerPrivate::IsPlotable(
-    const google::protobuf::FieldDescriptor::Type &_type)
-{
-  return std::find(this->plotableTypes.begin(), this->plotableTypes.end(),
-                   _type) != this->plotableTypes.end();
+  auto discovery = TopicDiscovery::Instance();
+  for (const auto &topic : discovery->Topics())
+    this->model->AddTopic(topic, discovery->MsgType(topic));
 }
 
 /////////////////////////////////////////////////
 void TopicViewer::UpdateModel()
 {
-  // get the current topics in the network
-  std::vector<std::string> topics;
-  this->dataPtr->node.TopicList(topics);
-
-  // initialize the topics with the old topics & remove every matched topic
-  // when you finish advertised topics the remaining topics will be removed
-  std::map<std::string, std::string> topicsToRemove =
-          this->dataPtr->currentTopics;
-
-  for (unsigned int i = 0; i < topics.size(); ++i)
-  {
-    // get the msg type
-    std::vector<transport::MessagePublisher> infoMsgs;
-    this->dataPtr->node.TopicInfo(topics[i], infoMsgs);
-    std::string msgType = infoMsgs[0].MsgTypeName();
-
-    // skip the matched topics
-    if (this->dataPtr->currentTopics.count(topics[i]) &&
-            this->dataPtr->currentTopics[topics[i]] == msgType)
-    {
-      topicsToRemove.erase(topics[i]);
-      continue;
-    }
-
-    // new topic
-    this->dataPtr->AddTopic(topics[i], msgType);
-  }
-
-  // remove the topics that don't exist in the network
-  for (auto topic : topicsToRemove)
-  {
-    auto root = this->dataPtr->model->invisibleRootItem();
-
-    // search for the topic in the model
-    for (int i = 0; i < root->rowCount(); ++i)
-    {
-      auto child = root->child(i);
-
-      if (child->data(NAME_ROLE).toString().toStdString() == topic.first &&
-              child->data(TYPE_ROLE).toString().toStdString() == topic.second)
-      {
-        // remove from model
-        root->removeRow(i);
-        // remove from topics as it is a dangling topic
-        this->dataPtr->currentTopics.erase(topic.first);
-        break;
-      }
-    }
-  }
+  // The model is updated through the discovery's signals
+  TopicDiscovery::Instance()->Refresh();
 }
 
 
 // Register this plugin
-GZ_ADD_PLUGIN(TopicViewer,
-              gui::Plugin)
+GZ_GUI_ADD_PLUGIN(TopicViewer, "TopicViewer")
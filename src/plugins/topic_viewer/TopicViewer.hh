@@ -52,11 +52,13 @@ namespace plugins
     /// \brief Documentaation inherited
     public: void LoadConfig(const tinyxml2::XMLElement *) override;
 
-    /// \brief Get the model of msgs & fields
+    /// \brief Get the model of msgs & fields. The fields of an item are
+    /// only added once it's expanded, see QAbstractItemModel::fetchMore.
     /// \return Pointer to the model of msgs & fields
-    public: QStandardItemModel *Model();
+    public: QAbstractItemModel *Model();
 
-    /// \brief update the model according to the changes of the topics
+    /// \brief update the model according to the changes of the topics.
+    /// Topics are also updated every second by gz::gui::TopicDiscovery.
     public slots: void UpdateModel();
 
     /// \brief Pointer to private data.
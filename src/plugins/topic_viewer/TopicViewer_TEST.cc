@@ -129,52 +129,66 @@ TEST(TopicViewerTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Model))
     auto model = plugin->Model();
     ASSERT_NE(model, nullptr);
 
-    auto root = model->invisibleRootItem();
-    ASSERT_NE(model, nullptr);
-
-    ASSERT_EQ(root->hasChildren(), true);
+    ASSERT_EQ(model->hasChildren(), true);
 
     bool foundCollision = false;
     bool foundInt = false;
 
-    EXPECT_GE(root->rowCount(), 2);
+    EXPECT_GE(model->rowCount(), 2);
 
     // check plotable items
-    for (int i = 0; i < root->rowCount(); ++i)
+    for (int i = 0; i < model->rowCount(); ++i)
     {
-        auto child = root->child(i);
+        auto child = model->index(i, 0);
 
-        if (child->data(NAME_ROLE) == "/collision_topic")
+        if (child.data(NAME_ROLE) == "/collision_topic")
         {
             foundCollision = true;
 
-            EXPECT_EQ(child->data(TYPE_ROLE), "gz.msgs.Collision");
-            EXPECT_EQ(child->rowCount(), 8);
-
-            auto pose = child->child(5);
-            auto position = pose->child(3);
-            auto x = position->child(1);
-
-            EXPECT_EQ(x->data(NAME_ROLE), "x");
-            EXPECT_EQ(x->data(TYPE_ROLE), "double");
-            EXPECT_EQ(x->data(PATH_ROLE), "pose-position-x");
-            EXPECT_EQ(x->data(TOPIC_ROLE), "/collision_topic");
-            EXPECT_TRUE(x->data(PLOT_ROLE).toBool());
+            EXPECT_EQ(child.data(TYPE_ROLE), "gz.msgs.Collision");
+
+            // fields are only added when expanded
+            EXPECT_TRUE(model->hasChildren(child));
+            EXPECT_EQ(model->rowCount(child), 0);
+            ASSERT_TRUE(model->canFetchMore(child));
+            model->fetchMore(child);
+            EXPECT_FALSE(model->canFetchMore(child));
+            EXPECT_EQ(model->rowCount(child), 8);
+
+            auto pose = model->index(5, 0, child);
+            EXPECT_EQ(pose.data(NAME_ROLE), "pose");
+            EXPECT_EQ(pose.data(TYPE_ROLE), "Pose");
+            EXPECT_EQ(model->parent(pose), child);
+            model->fetchMore(pose);
+
+            auto position = model->index(3, 0, pose);
+            model->fetchMore(position);
+
+            auto x = model->index(1, 0, position);
+            EXPECT_EQ(model->parent(x), position);
+            EXPECT_FALSE(model->hasChildren(x));
+
+            EXPECT_EQ(x.data(NAME_ROLE), "x");
+            EXPECT_EQ(x.data(TYPE_ROLE), "double");
+            EXPECT_EQ(x.data(PATH_ROLE), "pose-position-x");
+            EXPECT_EQ(x.data(TOPIC_ROLE), "/collision_topic");
+            EXPECT_TRUE(x.data(PLOT_ROLE).toBool());
         }
-        else if (child->data(NAME_ROLE) == "/int_topic")
+        else if (child.data(NAME_ROLE) == "/int_topic")
         {
             foundInt = true;
 
-            EXPECT_EQ(child->data(TYPE_ROLE), "gz.msgs.Int32");
-            EXPECT_EQ(child->rowCount(), 2);
+            EXPECT_EQ(child.data(TYPE_ROLE), "gz.msgs.Int32");
+            model->fetchMore(child);
+            EXPECT_EQ(model->rowCount(child), 2);
 
-            auto data = child->child(1);
+            auto data = model->index(1, 0, child);
 
-            EXPECT_EQ(data->data(NAME_ROLE), "data");
-            EXPECT_EQ(data->data(TYPE_ROLE), "int32");
-            EXPECT_EQ(data->data(PATH_ROLE), "data");
-            EXPECT_EQ(data->data(TOPIC_ROLE), "/int_topic");
-            EXPECT_TRUE(data->data(PLOT_ROLE).toBool());
+            EXPECT_EQ(data.data(NAME_ROLE), "data");
+            EXPECT_EQ(data.data(TYPE_ROLE), "int32");
+            EXPECT_EQ(data.data(PATH_ROLE), "data");
+            EXPECT_EQ(data.data(TOPIC_ROLE), "/int_topic");
+            EXPECT_TRUE(data.data(PLOT_ROLE).toBool());
         }
         else
         {
@@ -198,7 +212,5 @@ TEST(TopicViewerTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Model))
     // wait for update timeout
     std::this_thread::sleep_for(std::chrono::milliseconds(700));
 
-    root = plugin->Model()->invisibleRootItem();
-
-    EXPECT_EQ(root->rowCount(), 2);
+    EXPECT_EQ(plugin->Model()->rowCount(), 2);
 }
@@ -0,0 +1,632 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <gz/common/ColladaLoader.hh>
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Material.hh>
+#include <gz/common/Mesh.hh>
+#include <gz/common/MeshManager.hh>
+#include <gz/common/OBJLoader.hh>
+#include <gz/common/STLLoader.hh>
+#include <gz/common/SubMesh.hh>
+#include <gz/common/SystemPaths.hh>
+#include <gz/common/Util.hh>
+#include <gz/common/Uuid.hh>
+#include <gz/math/Color.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+
+#include "gz/gui/StartupProfiler.hh"
+
+#include "AssetLoader.hh"
+
+namespace
+{
+  /// \brief First bytes of cache files
+  constexpr char kMagic[4] = {'G', 'Z', 'M', 'C'};
+
+  /// \brief Format of cache files, bumped on changes so older files are
+  /// parsed again
+  constexpr uint32_t kVersion = 1u;
+
+  /// \brief The mesh file a cache entry was made from
+  struct Source
+  {
+    /// \brief File size in bytes
+    uint64_t size{0u};
+
+    /// \brief Modification time in seconds
+    int64_t mtime{0};
+  };
+
+  /////////////////////////////////////////////////
+  bool source(const std::string &_path, Source &_source)
+  {
+    struct stat info;
+    if (stat(_path.c_str(), &info) != 0)
+      return false;
+    _source.size = static_cast<uint64_t>(info.st_size);
+    _source.mtime = static_cast<int64_t>(info.st_mtime);
+    return true;
+  }
+
+  /// \brief Writes the binary cache format
+  class Writer
+  {
+    /// \brief Constructor
+    /// \param[in] _out Stream to write to
+    public: explicit Writer(std::ostream &_out) : out(_out) {}
+
+    /// \brief Write a plain value
+    /// \param[in] _value Value
+    public: template<typename T> void Value(const T &_value)
+    {
+      this->out.write(reinterpret_cast<const char *>(&_value), sizeof(T));
+    }
+
+    /// \brief Write a string, prefixed by its size
+    /// \param[in] _str String
+    public: void String(const std::string &_str)
+    {
+      this->Value(static_cast<uint32_t>(_str.size()));
+      this->out.write(_str.data(), _str.size());
+    }
+
+    /// \brief Write a vector
+    /// \param[in] _vec Vector
+    public: void Vector(const gz::math::Vector3d &_vec)
+    {
+      this->Value(_vec.X());
+      this->Value(_vec.Y());
+      this->Value(_vec.Z());
+    }
+
+    /// \brief Write a color
+    /// \param[in] _color Color
+    public: void Color(const gz::math::Color &_color)
+    {
+      this->Value(_color.R());
+      this->Value(_color.G());
+      this->Value(_color.B());
+      this->Value(_color.A());
+    }
+
+    /// \brief Stream written to
+    private: std::ostream &out;
+  };
+
+  /// \brief Reads the binary cache format. Reads past the end of the stream
+  /// give zeros and are caught by checking Good once done.
+  class Reader
+  {
+    /// \brief Constructor
+    /// \param[in] _in Stream to read from
+    public: explicit Reader(std::istream &_in) : in(_in) {}
+
+    /// \brief Read a plain value
+    /// \return Value
+    public: template<typename T> T Value()
+    {
+      T value{};
+      this->in.read(reinterpret_cast<char *>(&value), sizeof(T));
+      return value;
+    }
+
+    /// \brief Read a count, refusing counts which can't fit in the rest of
+    /// the file, so a corrupt file doesn't cause huge allocations
+    /// \param[in] _itemSize Smallest size of each item in bytes
+    /// \return Count, 0 if it's invalid
+    public: uint32_t Count(std::size_t _itemSize)
+    {
+      auto count = this->Value<uint32_t>();
+      auto pos = this->in.tellg();
+      this->in.seekg(0, std::ios::end);
+      auto end = this->in.tellg();
+      this->in.seekg(pos);
+      if (!this->in.good() || pos < 0 ||
+          static_cast<uint64_t>(count) * _itemSize >
+          static_cast<uint64_t>(end - pos))
+      {
+        this->in.setstate(std::ios::failbit);
+        return 0u;
+      }
+      return count;
+    }
+
+    /// \brief Read a string
+    /// \return String
+    public: std::string String()
+    {
+      std::string str(this->Count(1u), '\0');
+      this->in.read(&str[0], str.size());
+      return str;
+    }
+
+    /// \brief Read a vector
+    /// \return Vector
+    public: gz::math::Vector3d Vector()
+    {
+      double x = this->Value<double>();
+      double y = this->Value<double>();
+      double z = this->Value<double>();
+      return {x, y, z};
+    }
+
+    /// \brief Read a color
+    /// \return Color
+    public: gz::math::Color Color()
+    {
+      float r = this->Value<float>();
+      float g = this->Value<float>();
+      float b = this->Value<float>();
+      float a = this->Value<float>();
+      return {r, g, b, a};
+    }
+
+    /// \brief Get whether everything read so far was valid
+    /// \return True if there were no errors
+    public: bool Good() const
+    {
+      return !this->in.fail();
+    }
+
+    /// \brief Stream read from
+    private: std::istream &in;
+  };
+
+  /////////////////////////////////////////////////
+  /// \brief Get whether the cache can store a mesh without losing data
+  bool cacheable(const gz::common::Mesh &_mesh)
+  {
+    if (_mesh.HasSkeleton())
+      return false;
+
+    for (unsigned int i = 0; i < _mesh.MaterialCount(); ++i)
+    {
+      auto material = _mesh.MaterialByIndex(i);
+      if (material && (nullptr != material->PbrMaterial() ||
+          nullptr != material->TextureData()))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /////////////////////////////////////////////////
+  void writeMesh(Writer &_out, const gz::common::Mesh &_mesh)
+  {
+    _out.String(_mesh.Path());
+
+    _out.Value(static_cast<uint32_t>(_mesh.MaterialCount()));
+    for (unsigned int i = 0; i < _mesh.MaterialCount(); ++i)
+    {
+      auto material = _mesh.MaterialByIndex(i);
+      _out.Value(static_cast<uint8_t>(material != nullptr));
+      if (!material)
+        continue;
+      _out.Color(material->Ambient());
+      _out.Color(material->Diffuse());
+      _out.Color(material->Specular());
+      _out.Color(material->Emissive());
+      _out.Value(material->Transparency());
+      _out.Value(material->Shininess());
+      _out.Value(static_cast<uint8_t>(material->Lighting()));
+      _out.String(material->TextureImage());
+    }
+
+    _out.Value(static_cast<uint32_t>(_mesh.SubMeshCount()));
+    for (unsigned int i = 0; i < _mesh.SubMeshCount(); ++i)
+    {
+      auto subMesh = _mesh.SubMeshByIndex(i).lock();
+      _out.String(subMesh->Name());
+      _out.Value(static_cast<int32_t>(subMesh->SubMeshPrimitive()));
+      auto materialIndex = subMesh->GetMaterialIndex();
+      _out.Value(materialIndex.has_value() ?
+          static_cast<int64_t>(*materialIndex) : int64_t{-1});
+
+      _out.Value(static_cast<uint32_t>(subMesh->VertexCount()));
+      for (unsigned int v = 0; v < subMesh->VertexCount(); ++v)
+        _out.Vector(subMesh->Vertex(v));
+
+      _out.Value(static_cast<uint32_t>(subMesh->NormalCount()));
+      for (unsigned int n = 0; n < subMesh->NormalCount(); ++n)
+        _out.Vector(subMesh->Normal(n));
+
+      _out.Value(static_cast<uint32_t>(subMesh->TexCoordSetCount()));
+      for (unsigned int s = 0; s < subMesh->TexCoordSetCount(); ++s)
+      {
+        auto count = subMesh->TexCoordCountBySet(s);
+        _out.Value(static_cast<uint32_t>(count));
+        for (unsigned int t = 0; t < count; ++t)
+        {
+          auto texCoord = subMesh->TexCoordBySet(t, s);
+          _out.Value(texCoord.X());
+          _out.Value(texCoord.Y());
+        }
+      }
+
+      _out.Value(static_cast<uint32_t>(subMesh->IndexCount()));
+      for (unsigned int n = 0; n < subMesh->IndexCount(); ++n)
+        _out.Value(static_cast<uint32_t>(subMesh->Index(n)));
+    }
+  }
+
+  /////////////////////////////////////////////////
+  std::unique_ptr<gz::common::Mesh> readMesh(Reader &_in)
+  {
+    auto mesh = std::make_unique<gz::common::Mesh>();
+    mesh->SetPath(_in.String());
+
+    auto materialCount = _in.Count(1u);
+    std::vector<int> materialIndices;
+    for (uint32_t i = 0; i < materialCount && _in.Good(); ++i)
+    {
+      if (0u == _in.Value<uint8_t>())
+      {
+        materialIndices.push_back(-1);
+        continue;
+      }
+      auto material = std::make_shared<gz::common::Material>();
+      material->SetAmbient(_in.Color());
+      material->SetDiffuse(_in.Color());
+      material->SetSpecular(_in.Color());
+      material->SetEmissive(_in.Color());
+      material->SetTransparency(_in.Value<double>());
+      material->SetShininess(_in.Value<double>());
+      material->SetLighting(0u != _in.Value<uint8_t>());
+      auto texture = _in.String();
+      if (!texture.empty())
+        material->SetTextureImage(texture);
+      materialIndices.push_back(mesh->AddMaterial(material));
+    }
+
+    auto subMeshCount = _in.Count(1u);
+    for (uint32_t i = 0; i < subMeshCount && _in.Good(); ++i)
+    {
+      gz::common::SubMesh subMesh;
+      subMesh.SetName(_in.String());
+      subMesh.SetPrimitiveType(
+          static_cast<gz::common::SubMesh::PrimitiveType>(
+          _in.Value<int32_t>()));
+      auto materialIndex = _in.Value<int64_t>();
+      if (materialIndex >= 0 &&
+          materialIndex < static_cast<int64_t>(materialIndices.size()) &&
+          materialIndices[materialIndex] >= 0)
+      {
+        subMesh.SetMaterialIndex(materialIndices[materialIndex]);
+      }
+
+      auto vertexCount = _in.Count(3u * sizeof(double));
+      for (uint32_t v = 0; v < vertexCount; ++v)
+        subMesh.AddVertex(_in.Vector());
+
+      auto normalCount = _in.Count(3u * sizeof(double));
+      for (uint32_t n = 0; n < normalCount; ++n)
+        subMesh.AddNormal(_in.Vector());
+
+      auto setCount = _in.Count(sizeof(uint32_t));
+      for (uint32_t s = 0; s < setCount; ++s)
+      {
+        auto count = _in.Count(2u * sizeof(double));
+        for (uint32_t t = 0; t < count; ++t)
+        {
+          double u = _in.Value<double>();
+          double v = _in.Value<double>();
+          subMesh.AddTexCoordBySet(u, v, s);
+        }
+      }
+
+      auto indexCount = _in.Count(sizeof(uint32_t));
+      for (uint32_t n = 0; n < indexCount; ++n)
+        subMesh.AddIndex(_in.Value<uint32_t>());
+
+      mesh->AddSubMesh(subMesh);
+    }
+
+    if (!_in.Good())
+      return nullptr;
+    return mesh;
+  }
+
+  /////////////////////////////////////////////////
+  std::string lowercaseExtension(const std::string &_filename)
+  {
+    auto dot = _filename.rfind('.');
+    if (dot == std::string::npos)
+      return std::string();
+    std::string ext = _filename.substr(dot + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+        [](unsigned char _c) {return std::tolower(_c);});
+    return ext;
+  }
+}
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  class AssetLoaderPrivate
+  {
+    /// \brief Load a mesh file into the mesh manager, from the cache if
+    /// possible
+    /// \param[in] _filename Mesh file name
+    public: void LoadMesh(const std::string &_filename);
+
+    /// \brief Get the cache file of a mesh file
+    /// \param[in] _filename Mesh file name
+    /// \return Cache file path, empty if the cache is disabled
+    public: std::string CachePath(const std::string &_filename) const;
+
+    /// \brief Read a mesh from the cache
+    /// \param[in] _filename Mesh file name
+    /// \param[in] _path Resolved path of the mesh file
+    /// \return Mesh, null if it isn't cached or the cache is outdated
+    public: std::unique_ptr<common::Mesh> ReadCache(
+        const std::string &_filename, const std::string &_path) const;
+
+    /// \brief Save a mesh to the cache
+    /// \param[in] _filename Mesh file name
+    /// \param[in] _path Resolved path of the mesh file
+    /// \param[in] _mesh Mesh
+    public: void WriteCache(const std::string &_filename,
+        const std::string &_path, const common::Mesh &_mesh) const;
+
+    /// \brief Maximum number of threads loading at once
+    public: unsigned int threads{1u};
+
+    /// \brief Directory of the on-disk cache, empty if it's disabled
+    public: std::string cacheDir;
+
+    /// \brief True if the mesh manager must load everything with assimp,
+    /// which the format specific loaders of the pool would bypass
+    public: bool forceAssimp{false};
+  };
+}
+}
+}
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+AssetLoader::AssetLoader(unsigned int _threads, const std::string &_cacheDir)
+  : dataPtr(std::make_unique<AssetLoaderPrivate>())
+{
+  this->dataPtr->threads = std::max(1u, _threads);
+  this->dataPtr->cacheDir = _cacheDir;
+
+  std::string forceAssimp;
+  this->dataPtr->forceAssimp = common::env("GZ_MESH_FORCE_ASSIMP",
+      forceAssimp) && !forceAssimp.empty();
+
+  if (!this->dataPtr->cacheDir.empty() &&
+      !common::createDirectories(this->dataPtr->cacheDir))
+  {
+    gzwarn << "Failed to create mesh cache directory ["
+           << this->dataPtr->cacheDir << "], meshes won't be cached"
+           << std::endl;
+    this->dataPtr->cacheDir.clear();
+  }
+}
+
+/////////////////////////////////////////////////
+AssetLoader::~AssetLoader() = default;
+
+/////////////////////////////////////////////////
+void AssetLoader::Load(const std::vector<std::string> &_filenames)
+{
+  auto manager = common::MeshManager::Instance();
+
+  // Each file once, skipping those loaded by earlier scenes
+  std::vector<std::string> filenames;
+  std::unordered_set<std::string> seen;
+  for (const auto &filename : _filenames)
+  {
+    if (!filename.empty() && seen.insert(filename).second &&
+        !manager->HasMesh(filename))
+    {
+      filenames.push_back(filename);
+    }
+  }
+  if (filenames.empty())
+    return;
+
+  StartupProfiler::Scope scope(std::to_string(filenames.size()) + " meshes",
+      "Load meshes");
+
+  auto threadCount = std::min<std::size_t>(this->dataPtr->threads,
+      filenames.size());
+  if (threadCount <= 1u)
+  {
+    for (const auto &filename : filenames)
+      this->dataPtr->LoadMesh(filename);
+    return;
+  }
+
+  // Threads take the next file until there are none left, so a few large
+  // files don't hold up the rest
+  std::atomic<std::size_t> next{0u};
+  auto work = [&]
+  {
+    for (auto i = next++; i < filenames.size(); i = next++)
+      this->dataPtr->LoadMesh(filenames[i]);
+  };
+
+  std::vector<std::thread> pool;
+  for (std::size_t i = 1; i < threadCount; ++i)
+    pool.emplace_back(work);
+  work();
+  for (auto &thread : pool)
+    thread.join();
+}
+
+/////////////////////////////////////////////////
+void AssetLoaderPrivate::LoadMesh(const std::string &_filename)
+{
+  auto manager = common::MeshManager::Instance();
+  std::string path = common::findFile(_filename);
+  if (path.empty())
+    path = _filename;
+
+  auto mesh = this->ReadCache(_filename, path);
+  if (mesh)
+  {
+    mesh->SetName(_filename);
+    manager->AddMesh(mesh.release());
+    return;
+  }
+
+  // The mesh manager has a single loader per format and can't parse in
+  // parallel, so each call gets its own
+  std::unique_ptr<common::MeshLoader> loader;
+  auto ext = lowercaseExtension(path);
+  if (!this->forceAssimp)
+  {
+    if (ext == "dae")
+      loader = std::make_unique<common::ColladaLoader>();
+    else if (ext == "obj")
+      loader = std::make_unique<common::OBJLoader>();
+    else if (ext == "stl")
+      loader = std::make_unique<common::STLLoader>();
+  }
+
+  const common::Mesh *loaded{nullptr};
+  if (loader)
+  {
+    common::Mesh *parsed = loader->Load(path);
+    if (nullptr == parsed)
+    {
+      gzerr << "Failed to load mesh [" << _filename << "]" << std::endl;
+      return;
+    }
+    parsed->SetName(_filename);
+    manager->AddMesh(parsed);
+    loaded = parsed;
+  }
+  else
+  {
+    loaded = manager->Load(_filename);
+  }
+
+  if (nullptr != loaded)
+    this->WriteCache(_filename, path, *loaded);
+}
+
+/////////////////////////////////////////////////
+std::string AssetLoaderPrivate::CachePath(const std::string &_filename) const
+{
+  if (this->cacheDir.empty())
+    return std::string();
+
+  std::ostringstream name;
+  name << std::hex << std::hash<std::string>{}(_filename) << ".mesh";
+  return common::joinPaths(this->cacheDir, name.str());
+}
+
+/////////////////////////////////////////////////
+std::unique_ptr<common::Mesh> AssetLoaderPrivate::ReadCache(
+    const std::string &_filename, const std::string &_path) const
+{
+  auto cachePath = this->CachePath(_filename);
+  Source current;
+  if (cachePath.empty() || !common::exists(cachePath) ||
+      !source(_path, current))
+  {
+    return nullptr;
+  }
+
+  std::ifstream file(cachePath, std::ios::binary);
+  Reader in(file);
+  char magic[sizeof(kMagic)];
+  file.read(magic, sizeof(magic));
+  if (!in.Good() || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      in.Value<uint32_t>() != kVersion)
+  {
+    return nullptr;
+  }
+
+  // Hashes may collide, and the file may have changed since
+  if (in.String() != _filename || in.Value<uint64_t>() != current.size ||
+      in.Value<int64_t>() != current.mtime)
+  {
+    return nullptr;
+  }
+
+  auto mesh = readMesh(in);
+  if (!mesh)
+  {
+    gzwarn << "Ignoring corrupt mesh cache [" << cachePath << "]"
+           << std::endl;
+  }
+  return mesh;
+}
+
+/////////////////////////////////////////////////
+void AssetLoaderPrivate::WriteCache(const std::string &_filename,
+    const std::string &_path, const common::Mesh &_mesh) const
+{
+  auto cachePath = this->CachePath(_filename);
+  Source current;
+  if (cachePath.empty() || !cacheable(_mesh) || !source(_path, current))
+    return;
+
+  // Written next to it and renamed, so other instances reading the cache
+  // at the same time never see a partial file
+  auto tmpPath = cachePath + "." + common::Uuid().String() + ".tmp";
+  {
+    std::ofstream file(tmpPath, std::ios::binary);
+    if (!file.is_open())
+      return;
+    Writer out(file);
+    file.write(kMagic, sizeof(kMagic));
+    out.Value(kVersion);
+    out.String(_filename);
+    out.Value(current.size);
+    out.Value(current.mtime);
+    writeMesh(out, _mesh);
+    if (!file.good())
+    {
+      file.close();
+      common::removeFile(tmpPath);
+      return;
+    }
+  }
+
+  if (!common::moveFile(tmpPath, cachePath))
+    common::removeFile(tmpPath);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_ASSETLOADER_HH_
+#define GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_ASSETLOADER_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  class AssetLoaderPrivate;
+
+  /// \brief Loads mesh files into the mesh manager on a pool of threads,
+  /// so the render thread finds them parsed and only creates their GPU
+  /// resources.
+  ///
+  /// COLLADA, OBJ and STL files are parsed in parallel, each with its own
+  /// loader. Other formats go through the mesh manager, one at a time.
+  ///
+  /// Parsed meshes can also be kept in an on-disk cache, shared by all the
+  /// GUI instances of the host, so that reopening a world reads them back
+  /// without parsing the original files. Entries are replaced when the
+  /// original file changes. Meshes with skeletons or PBR materials aren't
+  /// cached, since the cache only keeps their geometry and basic
+  /// materials.
+  class AssetLoader
+  {
+    /// \brief Constructor
+    /// \param[in] _threads Maximum number of threads loading at once
+    /// \param[in] _cacheDir Directory of the on-disk cache, empty to
+    /// disable it
+    public: AssetLoader(unsigned int _threads, const std::string &_cacheDir);
+
+    /// \brief Destructor
+    public: ~AssetLoader();
+
+    /// \brief Load meshes which aren't in the mesh manager yet, and wait
+    /// for all of them.
+    /// \param[in] _filenames Absolute paths of the mesh files, which are
+    /// also their names in the mesh manager
+    public: void Load(const std::vector<std::string> &_filenames);
+
+    /// \internal
+    /// \brief Private data pointer
+    private: std::unique_ptr<AssetLoaderPrivate> dataPtr;
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <QByteArray>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+
+#include "SceneSnapshot.hh"
+
+namespace
+{
+/// \brief Add a key to the header data of a chunk
+/// \param[in] _msg Chunk
+/// \param[in] _key Key
+/// \param[in] _value Value
+void AddData(gz::msgs::Bytes &_msg, const std::string &_key,
+    const std::string &_value)
+{
+  auto data = _msg.mutable_header()->add_data();
+  data->set_key(_key);
+  data->add_value(_value);
+}
+
+/// \brief Find a value in the header data of a chunk
+/// \param[in] _msg Chunk
+/// \param[in] _key Key
+/// \return Value, null if not found
+const std::string *FindData(const gz::msgs::Bytes &_msg,
+    const std::string &_key)
+{
+  for (const auto &data : _msg.header().data())
+  {
+    if (data.key() == _key && data.value_size() > 0)
+      return &data.value(0);
+  }
+  return nullptr;
+}
+
+/// \brief Read a number from the header data of a chunk
+/// \param[in] _msg Chunk
+/// \param[in] _key Key
+/// \param[out] _value Number
+/// \return False if it's missing or invalid
+bool FindNumber(const gz::msgs::Bytes &_msg, const std::string &_key,
+    uint32_t &_value)
+{
+  auto str = FindData(_msg, _key);
+  if (nullptr == str)
+    return false;
+  try
+  {
+    std::size_t end{0u};
+    auto value = std::stoul(*str, &end);
+    if (end != str->size() || value > UINT32_MAX)
+      return false;
+    _value = static_cast<uint32_t>(value);
+    return true;
+  }
+  catch (...)
+  {
+    return false;
+  }
+}
+}
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+/////////////////////////////////////////////////
+std::vector<msgs::Bytes> SplitSceneSnapshot(
+    const msgs::Scene &_scene, uint32_t _snapshot, std::size_t _chunkSize,
+    bool _compress)
+{
+  // The first chunk has everything but the models and lights
+  std::vector<msgs::Scene> scenes(1);
+  scenes[0] = _scene;
+  scenes[0].clear_model();
+  scenes[0].clear_light();
+  std::size_t size = scenes[0].ByteSizeLong();
+
+  auto fit = [&](std::size_t _size)
+  {
+    if (size > 0u && size + _size > _chunkSize)
+    {
+      scenes.emplace_back();
+      size = 0u;
+    }
+    size += _size;
+    return &scenes.back();
+  };
+  for (const auto &model : _scene.model())
+    *fit(model.ByteSizeLong())->add_model() = model;
+  for (const auto &light : _scene.light())
+    *fit(light.ByteSizeLong())->add_light() = light;
+
+  std::vector<msgs::Bytes> chunks(scenes.size());
+  for (std::size_t i = 0; i < scenes.size(); ++i)
+  {
+    auto &chunk = chunks[i];
+    AddData(chunk, "snapshot", std::to_string(_snapshot));
+    AddData(chunk, "chunk", std::to_string(i));
+    AddData(chunk, "chunks", std::to_string(scenes.size()));
+    AddData(chunk, "encoding", _compress ? "zlib" : "none");
+
+    auto data = scenes[i].SerializeAsString();
+    if (_compress)
+    {
+      auto compressed = qCompress(
+          reinterpret_cast<const uchar *>(data.data()),
+          static_cast<int>(data.size()));
+      chunk.set_data(compressed.constData(),
+          static_cast<std::size_t>(compressed.size()));
+    }
+    else
+    {
+      chunk.set_data(std::move(data));
+    }
+  }
+  return chunks;
+}
+
+/////////////////////////////////////////////////
+bool ReadSceneSnapshotChunk(const msgs::Bytes &_msg,
+    SceneSnapshotChunk &_chunk)
+{
+  if (!FindNumber(_msg, "snapshot", _chunk.snapshot) ||
+      !FindNumber(_msg, "chunk", _chunk.index) ||
+      !FindNumber(_msg, "chunks", _chunk.count) ||
+      _chunk.index >= _chunk.count)
+  {
+    gzerr << "Invalid scene snapshot chunk header" << std::endl;
+    return false;
+  }
+
+  auto encoding = FindData(_msg, "encoding");
+  bool parsed{false};
+  if (nullptr == encoding || *encoding == "none")
+  {
+    parsed = _chunk.scene.ParseFromString(_msg.data());
+  }
+  else if (*encoding == "zlib")
+  {
+    // Empty if the data is corrupt, unless its size is 0
+    auto data = qUncompress(
+        reinterpret_cast<const uchar *>(_msg.data().data()),
+        static_cast<int>(_msg.data().size()));
+    bool empty = _msg.data().compare(0, 4, std::string(4, '\0')) == 0;
+    parsed = (empty || !data.isEmpty()) &&
+        _chunk.scene.ParseFromArray(data.constData(), data.size());
+  }
+  else
+  {
+    gzerr << "Unsupported scene snapshot encoding [" << *encoding << "]"
+          << std::endl;
+    return false;
+  }
+
+  if (!parsed)
+  {
+    gzerr << "Failed to decode chunk [" << _chunk.index
+          << "] of scene snapshot [" << _chunk.snapshot << "]" << std::endl;
+  }
+  return parsed;
+}
+}
+}
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_SCENESNAPSHOT_HH_
+#define GZ_GUI_PLUGINS_TRANSPORTSCENEMANAGER_SCENESNAPSHOT_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gz/msgs/bytes.pb.h>
+#include <gz/msgs/scene.pb.h>
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief A piece of a scene snapshot, which is a whole scene split in
+  /// compressed chunks, so it's received and shown progressively instead
+  /// of as a single large message.
+  ///
+  /// Chunks are sent as msgs::Bytes, whose header data has:
+  ///
+  /// * `snapshot` : Id of the snapshot, the same for all its chunks.
+  /// * `chunk` : Index of the chunk, from 0.
+  /// * `chunks` : Number of chunks of the snapshot.
+  /// * `encoding` : `zlib` if the data is compressed, `none` otherwise.
+  ///
+  /// The data is a serialized msgs::Scene with some of the models and
+  /// lights. The first chunk also has the rest of the scene, such as its
+  /// header and ambient color. Compressed data is a zlib stream preceded
+  /// by the size of the uncompressed data, as a 4 byte big endian
+  /// integer, as written by qCompress.
+  struct SceneSnapshotChunk
+  {
+    /// \brief Id of the snapshot
+    uint32_t snapshot{0u};
+
+    /// \brief Index of the chunk
+    uint32_t index{0u};
+
+    /// \brief Number of chunks of the snapshot
+    uint32_t count{0u};
+
+    /// \brief Part of the scene
+    msgs::Scene scene;
+  };
+
+  /// \brief Split a scene into snapshot chunks, such as for a scene server
+  /// or a test.
+  /// \param[in] _scene Whole scene
+  /// \param[in] _snapshot Id of the snapshot
+  /// \param[in] _chunkSize Approximate size of the uncompressed chunks in
+  /// bytes. Models and lights aren't split, so chunks may be larger.
+  /// \param[in] _compress True to compress the chunks
+  /// \return Chunks, at least one
+  std::vector<msgs::Bytes> SplitSceneSnapshot(const msgs::Scene &_scene,
+      uint32_t _snapshot, std::size_t _chunkSize, bool _compress = true);
+
+  /// \brief Read a snapshot chunk
+  /// \param[in] _msg Chunk message
+  /// \param[out] _chunk Chunk
+  /// \return False if the message isn't a valid chunk
+  bool ReadSceneSnapshotChunk(const msgs::Bytes &_msg,
+      SceneSnapshotChunk &_chunk);
+}
+}
+}
+
+#endif
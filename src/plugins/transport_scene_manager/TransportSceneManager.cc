@@ -16,15 +16,36 @@
 */
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <limits>
 #include <map>
+#include <memory>
+#include <set>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
 #include <vector>
 
 #include <QQmlProperty>
 
+#include <gz/msgs/bytes.pb.h>
+#include <gz/msgs/empty.pb.h>
 #include <gz/msgs/geometry.pb.h>
+#include <gz/msgs/header.pb.h>
 #include <gz/msgs/light.pb.h>
 #include <gz/msgs/link.pb.h>
 #include <gz/msgs/material.pb.h>
@@ -35,843 +56,4557 @@
 #include <gz/msgs/visual.pb.h>
 
 #include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Mesh.hh>
 #include <gz/common/MeshManager.hh>
+#include <gz/common/SubMesh.hh>
+#include <gz/common/Util.hh>
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Frustum.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/msgs/Utility.hh>
 #include <gz/plugin/Register.hh>
+#include <gz/rendering/Camera.hh>
 #include <gz/rendering/Capsule.hh>
 #include <gz/rendering/RenderEngine.hh>
 #include <gz/rendering/RenderingIface.hh>
 #include <gz/rendering/Scene.hh>
+#include <gz/transport/MessageInfo.hh>
 #include <gz/transport/Node.hh>
 #include <gz/transport/TopicUtils.hh>
 
 #include "gz/gui/Application.hh"
 #include "gz/gui/Conversions.hh"
+#include "gz/gui/GpuMemory.hh"
 #include "gz/gui/GuiEvents.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/MessagePool.hh"
+#include "gz/gui/Profiler.hh"
+#include "gz/gui/QueueStats.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/RenderStats.hh"
+#include "gz/gui/SceneEntities.hh"
+#include "gz/gui/ServiceRequest.hh"
+#include "gz/gui/SharedMemory.hh"
+#include "gz/gui/StaticPlugins.hh"
+#include "gz/gui/WorkerPool.hh"
 
+#include "AssetLoader.hh"
+#include "SceneSnapshot.hh"
 #include "TransportSceneManager.hh"
 
-/// \brief Private data class for TransportSceneManager
-class gz::gui::plugins::TransportSceneManagerPrivate
+namespace
 {
-  /// \brief Make the scene service request and populate the scene
-  public: void Request();
+/// \brief Time to wait for the scene service, including for a server which
+/// isn't started yet
+constexpr std::chrono::milliseconds kSceneRequestTimeout{30000};
 
-  /// \brief Update the scene based on pose msgs received
-  public: void OnRender();
+/// \brief Number of poses kept per entity for interpolation, enough for a
+/// delay of a few pose messages
+constexpr std::size_t kPoseHistorySize{4u};
 
-  /// \brief Initialize transport, subscribing to the necessary topics.
-  /// To be called after a valid scene has been found.
-  public: void InitializeTransport();
+/// \brief A pose received with its time
+struct TimedPose
+{
+  /// \brief Time of the pose message, in seconds
+  double time{0.0};
 
-  /// \brief Callback function for the pose topic
-  /// \param[in] _msg Pose vector msg
-  public: void OnPoseVMsg(const msgs::Pose_V &_msg);
+  /// \brief Pose, including the entity's local pose
+  gz::math::Pose3d pose;
+};
 
-  /// \brief Load the scene from a scene msg
-  /// \param[in] _msg Scene msg
-  public: void LoadScene(const msgs::Scene &_msg);
+/// \brief Type of node an entity is rendered with
+enum class EntityType
+{
+  /// \brief Model, link or visual
+  kVisual,
 
-  /// \brief Callback function for the request topic
-  /// \param[in] _msg Deletion message
-  public: void OnDeletionMsg(const msgs::UInt32_V &_msg);
+  /// \brief Light
+  kLight
+};
 
-  /// \brief Load the scene from a scene msg
-  /// \param[in] _msg Scene msg
-  public: void OnSceneSrvMsg(const msgs::Scene &_msg, const bool result);
+/// \brief Order poses are applied in under the pose budget
+enum class PosePriority : uint8_t
+{
+  /// \brief In the view frustum of the user camera
+  kInView,
 
-  /// \brief Called when there's an entity is added to the scene
-  /// \param[in] _msg Scene msg
-  public: void OnSceneMsg(const msgs::Scene &_msg);
+  /// \brief Close to the user camera
+  kNear,
 
-  /// \brief Load the model from a model msg
-  /// \param[in] _msg Model msg
-  /// \return Model visual created from the msg
-  public: rendering::VisualPtr LoadModel(const msgs::Model &_msg);
+  /// \brief Anywhere else
+  kFar
+};
 
-  /// \brief Load a link from a link msg
-  /// \param[in] _msg Link msg
-  /// \return Link visual created from the msg
-  public: rendering::VisualPtr LoadLink(const msgs::Link &_msg);
+/// \brief Level of detail of a model
+enum class Lod : uint8_t
+{
+  /// \brief Rendered as loaded
+  kFull,
 
-  /// \brief Load a visual from a visual msg
-  /// \param[in] _msg Visual msg
-  /// \return Visual visual created from the msg
-  public: rendering::VisualPtr LoadVisual(const msgs::Visual &_msg);
+  /// \brief Meshes are replaced by their bounding boxes
+  kBox,
 
-  /// \brief Load a geometry from a geometry msg
-  /// \param[in] _msg Geometry msg
-  /// \param[out] _scale Geometry scale that will be set based on msg param
-  /// \param[out] _localPose Additional local pose to be applied after the
-  /// visual's pose
-  /// \return Geometry object created from the msg
-  public: rendering::GeometryPtr LoadGeometry(const msgs::Geometry &_msg,
-      math::Vector3d &_scale, math::Pose3d &_localPose);
+  /// \brief Hidden
+  kCulled
+};
 
-  /// \brief Load a material from a material msg
-  /// \param[in] _msg Material msg
-  /// \return Material object created from the msg
-  public: rendering::MaterialPtr LoadMaterial(const msgs::Material &_msg);
+/// \brief An entity rendered by the scene manager
+struct Entity
+{
+  /// \brief Entity Id
+  unsigned int id{0u};
 
-  /// \brief Load a light from a light msg
-  /// \param[in] _msg Light msg
-  /// \return Light object created from the msg
-  public: rendering::LightPtr LoadLight(const msgs::Light &_msg);
+  /// \brief Type of node
+  EntityType type{EntityType::kVisual};
 
-  /// \brief Delete an entity
-  /// \param[in] _entity Entity to delete
-  public: void DeleteEntity(const unsigned int _entity);
+  /// \brief Node rendering the entity
+  gz::rendering::NodePtr::weak_type node;
 
-  //// \brief gz-transport scene service name
-  public: std::string service{"scene"};
+  /// \brief Additional local pose between the entity and its geometry,
+  /// applied after the entity's pose. This is currently used to handle the
+  /// normal vector in plane visuals.
+  gz::math::Pose3d localPose;
 
-  //// \brief gz-transport pose topic name
-  public: std::string poseTopic{"pose"};
+  /// \brief Latest pose received, including localPose
+  gz::math::Pose3d pose;
 
-  //// \brief gz-transport deletion topic name
-  public: std::string deletionTopic{"delete"};
+  /// \brief True if pose hasn't been applied to the node yet
+  bool poseDirty{false};
 
-  //// \brief gz-transport scene topic name
-  public: std::string sceneTopic{"scene"};
+  /// \brief True if it belongs to a static model and is marked as static,
+  /// see RenderStats
+  bool isStatic{false};
 
-  //// \brief Pointer to the rendering scene
-  public: rendering::ScenePtr scene{nullptr};
+  /// \brief Last pose applied to the node, valid if poseApplied is true
+  gz::math::Pose3d appliedPose;
 
-  //// \brief Mutex to protect the msgs
-  public: std::mutex msgMutex;
+  /// \brief True once a pose msg has been applied to the node
+  bool poseApplied{false};
 
-  /// \brief Map of entity id to pose
-  public: std::map<unsigned int, math::Pose3d> poses;
+  /// \brief Id of the top level model this entity belongs to, 0 for
+  /// lights at the top level
+  unsigned int root{0u};
 
-  /// \brief Map of entity id to initial local poses
-  /// This is currently used to handle the normal vector in plane visuals. In
-  /// general, this can be used to store any local transforms between the
-  /// parent Visual and geometry.
-  public: std::map<unsigned int, math::Pose3d> localPoses;
+  /// \brief Level of detail, only used by top level models
+  Lod lod{Lod::kFull};
 
-  /// \brief Map of visual id to visual pointers.
-  public: std::map<unsigned int, rendering::VisualPtr::weak_type> visuals;
+  /// \brief Order its poses are applied in under the pose budget, only
+  /// used by top level models
+  PosePriority posePriority{PosePriority::kInView};
 
-  /// \brief Map of light id to light pointers.
-  public: std::map<unsigned int, rendering::LightPtr::weak_type> lights;
+  /// \brief Visuals with a mesh in this model and its descendants, only
+  /// used by top level models
+  std::vector<unsigned int> meshVisuals;
 
-  /// Entities to be deleted
-  public: std::vector<unsigned int> toDeleteEntities;
+  /// \brief Box shown instead of the mesh, only used by visuals with a mesh
+  gz::rendering::VisualPtr::weak_type proxy;
 
-  /// \brief Keeps the a list of unprocessed scene messages
-  public: std::vector<msgs::Scene> sceneMsgs;
+  /// \brief Latest poses received, oldest first from historyStart, only
+  /// used when interpolating
+  std::array<TimedPose, kPoseHistorySize> history;
 
-  /// \brief Transport node for making service request and subscribing to
-  /// pose topic
-  public: gz::transport::Node node;
+  /// \brief Index in history of the oldest pose
+  uint8_t historyStart{0u};
+
+  /// \brief Number of poses in history
+  uint8_t historySize{0u};
+
+  /// \brief True until the render time reaches the newest pose of history
+  bool interpolating{false};
+
+  /// \brief Static batch the model is merged into, 0 if none, only used by
+  /// top level models
+  uint32_t batch{0u};
 
-  /// \brief Thread to wait for transport initialization
-  public: std::thread initializeTransport;
+  /// \brief Time a pose was last applied to the model or its descendants,
+  /// negative until it's first checked for batching, only used by top level
+  /// models
+  double movedTime{-1.0};
 };
 
-using namespace gz;
-using namespace gui;
-using namespace plugins;
+/// \brief Model geometries merged into a single mesh, see
+/// TransportSceneManagerPrivate::BuildStaticBatch
+struct StaticBatch
+{
+  /// \brief Visual of the merged mesh
+  gz::rendering::VisualPtr::weak_type visual;
 
-/////////////////////////////////////////////////
-TransportSceneManager::TransportSceneManager()
-  : Plugin(), dataPtr(new TransportSceneManagerPrivate)
+  /// \brief Name of the merged mesh in the mesh manager
+  std::string meshName;
+
+  /// \brief Top level models merged
+  std::vector<unsigned int> roots;
+
+  /// \brief Visuals hidden while they're merged
+  std::vector<gz::rendering::VisualPtr::weak_type> hidden;
+};
+
+/// \brief Material shared by the visuals with the same material properties
+struct CachedMaterial
 {
-}
+  /// \brief Rendering material
+  gz::rendering::MaterialPtr material;
 
-/////////////////////////////////////////////////
-TransportSceneManager::~TransportSceneManager()
+  /// \brief Number of geometries using the material
+  unsigned int refs{0};
+};
+
+/// \brief Shared material of a geometry
+struct GeometryMaterial
+{
+  /// \brief Key of the material in the cache
+  std::string key;
+
+  /// \brief The geometry, to find the ones destroyed by someone else
+  gz::rendering::GeometryPtr::weak_type geometry;
+};
+
+/// \brief Geometry of several visuals sharing a material
+struct BatchPart
 {
-  if (this->dataPtr->initializeTransport.joinable())
-    this->dataPtr->initializeTransport.join();
+  /// \brief Material of the geometry
+  gz::rendering::MaterialPtr material;
+
+  /// \brief Geometry, in world coordinates
+  gz::common::SubMesh subMesh;
+};
+
+/// \brief Collect the leaf visuals with a geometry under a visual
+/// \param[in] _visual Visual
+/// \param[out] _visuals Leaf visuals
+void CollectLeafVisuals(const gz::rendering::VisualPtr &_visual,
+    std::vector<gz::rendering::VisualPtr> &_visuals)
+{
+  if (_visual->ChildCount() == 0u)
+  {
+    if (_visual->GeometryCount() > 0u)
+      _visuals.push_back(_visual);
+    return;
+  }
+
+  for (unsigned int i = 0; i < _visual->ChildCount(); ++i)
+  {
+    auto child = std::dynamic_pointer_cast<gz::rendering::Visual>(
+        _visual->ChildByIndex(i));
+    if (child)
+      CollectLeafVisuals(child, _visuals);
+  }
 }
 
-/////////////////////////////////////////////////
-void TransportSceneManager::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+/// \brief Add the geometries of a visual to a batch, in world coordinates.
+/// Only meshes, including primitive shapes, made of triangles are
+/// supported.
+/// \param[in] _visual Leaf visual
+/// \param[in, out] _parts Geometry of the batch, one per material
+/// \return False if the visual has geometries which can't be merged, it's
+/// then left out
+bool AddToBatch(const gz::rendering::VisualPtr &_visual,
+    std::vector<BatchPart> &_parts)
 {
-  if (this->title.empty())
-    this->title = "Transport Scene Manager";
+  using gz::common::SubMesh;
 
-  // Custom parameters
-  if (_pluginElem)
+  // Check everything first, so visuals are merged whole or not at all
+  std::vector<std::pair<const SubMesh *, gz::rendering::MaterialPtr>>
+      sources;
+  for (unsigned int g = 0; g < _visual->GeometryCount(); ++g)
   {
-    auto elem = _pluginElem->FirstChildElement("service");
-    if (nullptr != elem && nullptr != elem->GetText())
+    auto mesh = std::dynamic_pointer_cast<gz::rendering::Mesh>(
+        _visual->GeometryByIndex(g));
+    if (!mesh)
+      return false;
+
+    const auto &descriptor = mesh->Descriptor();
+    const gz::common::Mesh *source = descriptor.mesh;
+    if (nullptr == source && !descriptor.meshName.empty())
     {
-      this->dataPtr->service =
-          transport::TopicUtils::AsValidTopic(elem->GetText());
+      source = gz::common::MeshManager::Instance()->MeshByName(
+          descriptor.meshName);
     }
-
-    elem = _pluginElem->FirstChildElement("pose_topic");
-    if (nullptr != elem && nullptr != elem->GetText())
+    if (nullptr == source || !descriptor.subMeshName.empty() ||
+        source->SubMeshCount() != mesh->SubMeshCount())
     {
-      this->dataPtr->poseTopic =
-          transport::TopicUtils::AsValidTopic(elem->GetText());
+      return false;
     }
 
-    elem = _pluginElem->FirstChildElement("deletion_topic");
-    if (nullptr != elem && nullptr != elem->GetText())
+    for (unsigned int i = 0; i < source->SubMeshCount(); ++i)
     {
-      this->dataPtr->deletionTopic =
-          transport::TopicUtils::AsValidTopic(elem->GetText());
+      auto subMesh = source->SubMeshByIndex(i).lock();
+      auto material = mesh->SubMeshByIndex(i)->Material();
+      if (nullptr == subMesh || nullptr == material ||
+          subMesh->SubMeshPrimitive() != SubMesh::TRIANGLES)
+      {
+        return false;
+      }
+      sources.emplace_back(subMesh.get(), material);
     }
+  }
 
-    elem = _pluginElem->FirstChildElement("scene_topic");
-    if (nullptr != elem && nullptr != elem->GetText())
+  const auto pose = _visual->WorldPose();
+  const auto scale = _visual->WorldScale();
+  for (const auto &[source, material] : sources)
+  {
+    auto part = std::find_if(_parts.begin(), _parts.end(),
+        [&material = material](const BatchPart &_part)
+        {
+          return _part.material == material;
+        });
+    if (part == _parts.end())
     {
-      this->dataPtr->sceneTopic =
-          transport::TopicUtils::AsValidTopic(elem->GetText());
+      _parts.push_back({material, SubMesh()});
+      part = std::prev(_parts.end());
+      part->subMesh.SetPrimitiveType(SubMesh::TRIANGLES);
     }
-  }
+    auto &out = part->subMesh;
 
-  QQmlProperty::write(this->PluginItem(), "service",
-      QString::fromStdString(this->dataPtr->service));
-  QQmlProperty::write(this->PluginItem(), "poseTopic",
-      QString::fromStdString(this->dataPtr->poseTopic));
-  QQmlProperty::write(this->PluginItem(), "deletionTopic",
-      QString::fromStdString(this->dataPtr->deletionTopic));
-  QQmlProperty::write(this->PluginItem(), "sceneTopic",
-      QString::fromStdString(this->dataPtr->sceneTopic));
+    // Every vertex gets a normal and texture coordinates, so they stay
+    // aligned across the merged geometries
+    auto base = static_cast<unsigned int>(out.VertexCount());
+    bool normals = source->NormalCount() == source->VertexCount();
+    bool texCoords = source->TexCoordCountBySet(0u) == source->VertexCount();
+    for (unsigned int v = 0; v < source->VertexCount(); ++v)
+    {
+      out.AddVertex(pose.Rot() * (source->Vertex(v) * scale) + pose.Pos());
 
-  if (this->dataPtr->service.empty() ||
-      this->dataPtr->poseTopic.empty() ||
-      this->dataPtr->deletionTopic.empty() ||
-      this->dataPtr->sceneTopic.empty())
-  {
-    gzerr << "One or more transport parameters invalid:" << std::endl
-        << "  * <service>: " << this->dataPtr->service << std::endl
-        << "  * <pose_topic>: " << this->dataPtr->poseTopic << std::endl
-        << "  * <deletion_topic>: " << this->dataPtr->deletionTopic << std::endl
-        << "  * <scene_topic>: " << this->dataPtr->sceneTopic << std::endl;
-  }
-  else
-  {
-    App()->findChild<MainWindow *>()->installEventFilter(this);
+      gz::math::Vector3d normal = gz::math::Vector3d::UnitZ;
+      if (normals)
+        normal = source->Normal(v) / scale;
+      out.AddNormal((pose.Rot() * normal).Normalize());
+
+      gz::math::Vector2d texCoord;
+      if (texCoords)
+        texCoord = source->TexCoordBySet(v, 0u);
+      out.AddTexCoordBySet(texCoord.X(), texCoord.Y(), 0u);
+    }
+
+    if (source->IndexCount() > 0u)
+    {
+      for (unsigned int i = 0; i < source->IndexCount(); ++i)
+        out.AddIndex(base + static_cast<unsigned int>(source->Index(i)));
+    }
+    else
+    {
+      for (unsigned int i = 0; i < source->VertexCount(); ++i)
+        out.AddIndex(base + i);
+    }
   }
+  return true;
 }
 
-/////////////////////////////////////////////////
-void TransportSceneManagerPrivate::InitializeTransport()
+/// \brief Add a pose to the history of an entity
+/// \param[in, out] _entity Entity, whose pose is the one received
+/// \param[in] _time Time of the pose message
+/// \return True if the entity has to be interpolated to it
+bool AddPoseSample(Entity &_entity, double _time)
 {
-  this->Request();
-
-  if (!this->node.Subscribe(this->poseTopic,
-      &TransportSceneManagerPrivate::OnPoseVMsg, this))
-  {
-    gzerr << "Error subscribing to pose topic: " << this->poseTopic
-      << std::endl;
-  }
-  else
+  auto at = [&_entity](std::size_t _i) -> TimedPose &
   {
-    gzmsg << "Listening to pose messages on [" << this->poseTopic << "]"
-           << std::endl;
-  }
+    return _entity.history[(_entity.historyStart + _i) % kPoseHistorySize];
+  };
 
-  if (!this->node.Subscribe(this->deletionTopic,
-      &TransportSceneManagerPrivate::OnDeletionMsg, this))
-  {
-    gzerr << "Error subscribing to deletion topic: " << this->deletionTopic
-      << std::endl;
-  }
-  else
+  if (_entity.historySize > 0u)
   {
-    gzmsg << "Listening to deletion messages on [" << this->deletionTopic
-           << "]" << std::endl;
-  }
+    auto &newest = at(_entity.historySize - 1u);
 
-  if (!this->node.Subscribe(this->sceneTopic,
-      &TransportSceneManagerPrivate::OnSceneMsg, this))
-  {
-    gzerr << "Error subscribing to scene topic: " << this->sceneTopic
-           << std::endl;
-  }
-  else
-  {
-    gzmsg << "Listening to scene messages on [" << this->sceneTopic << "]"
-           << std::endl;
+    // The simulation was reset, start over
+    if (_time < newest.time)
+    {
+      _entity.historySize = 0u;
+    }
+    else if (newest.pose == _entity.pose)
+    {
+      // Entities at rest move their newest pose forward, instead of
+      // filling their history with the same pose
+      if (_time == newest.time || (_entity.historySize > 1u &&
+          at(_entity.historySize - 2u).pose == _entity.pose))
+      {
+        newest.time = _time;
+        return false;
+      }
+    }
   }
 
-  gzmsg << "Transport initialized." << std::endl;
+  if (_entity.historySize < kPoseHistorySize)
+    ++_entity.historySize;
+  else
+    _entity.historyStart = (_entity.historyStart + 1u) % kPoseHistorySize;
+  at(_entity.historySize - 1u) = {_time, _entity.pose};
+  return true;
 }
 
-/////////////////////////////////////////////////
-bool TransportSceneManager::eventFilter(QObject *_obj, QEvent *_event)
+/// \brief Get the pose of an entity at a time, interpolated between the
+/// poses of its history, and held at the oldest and newest ones.
+/// \param[in] _entity Entity with at least one pose in its history
+/// \param[in] _time Render time
+/// \param[out] _done True if the time is past the newest pose
+/// \return Pose
+gz::math::Pose3d InterpolatedPose(const Entity &_entity, double _time,
+    bool &_done)
 {
-  if (_event->type() == events::Render::kType)
+  auto at = [&_entity](std::size_t _i) -> const TimedPose &
   {
-    this->dataPtr->OnRender();
-  }
+    return _entity.history[(_entity.historyStart + _i) % kPoseHistorySize];
+  };
 
-  // Standard event processing
-  return QObject::eventFilter(_obj, _event);
+  std::size_t i = _entity.historySize - 1u;
+  _done = _time >= at(i).time;
+  if (_done)
+    return at(i).pose;
+  if (_time <= at(0).time)
+    return at(0).pose;
+
+  while (i > 1u && at(i - 1u).time > _time)
+    --i;
+  const auto &a = at(i - 1u);
+  const auto &b = at(i);
+  double t = (_time - a.time) / (b.time - a.time);
+  return gz::math::Pose3d(a.pose.Pos() + (b.pose.Pos() - a.pose.Pos()) * t,
+      gz::math::Quaterniond::Slerp(t, a.pose.Rot(), b.pose.Rot(), true));
 }
 
-/////////////////////////////////////////////////
-void TransportSceneManagerPrivate::Request()
+/// \brief Time poses are rendered at when interpolating, following the
+/// times of the pose messages with a delay. It advances with the wall
+/// clock at the rate the messages' times advance, and is nudged towards
+/// the latest message, so network jitter doesn't make it jump.
+class PlaybackClock
 {
-  // wait for the service to be advertized
-  std::vector<transport::ServicePublisher> publishers;
-  const std::chrono::duration<double> sleepDuration{1.0};
-  const std::size_t tries = 30;
-  for (std::size_t i = 0; i < tries; ++i)
-  {
-    this->node.ServiceInfo(this->service, publishers);
-    if (publishers.size() > 0)
-      break;
-    std::this_thread::sleep_for(sleepDuration);
-    gzdbg << "Waiting for service [" << this->service << "]\n";
-  }
+  /// \brief Clock of the arrivals
+  public: using Clock = std::chrono::steady_clock;
 
-  if (publishers.empty() || !this->node.Request(this->service,
-      &TransportSceneManagerPrivate::OnSceneSrvMsg, this))
+  /// \brief Record a pose message
+  /// \param[in] _time Time of the message
+  /// \param[in] _arrival When it was received
+  public: void Receive(double _time, Clock::time_point _arrival)
   {
-    gzerr << "Error making service request to [" << this->service << "]"
-           << std::endl;
+    if (this->hasMessage && _time > this->latest)
+    {
+      double wall = std::chrono::duration<double>(
+          _arrival - this->latestArrival).count();
+      if (wall > 1e-3)
+      {
+        double rate = std::clamp((_time - this->latest) / wall, 0.0,
+            kMaxRate);
+        this->rate += 0.1 * (rate - this->rate);
+      }
+    }
+    this->latest = _time;
+    this->latestArrival = _arrival;
+    this->hasMessage = true;
   }
-}
 
-/////////////////////////////////////////////////
-void TransportSceneManagerPrivate::OnPoseVMsg(const msgs::Pose_V &_msg)
-{
-  std::lock_guard<std::mutex> lock(this->msgMutex);
-  for (int i = 0; i < _msg.pose_size(); ++i)
+  /// \brief Get the render time of a frame
+  /// \param[in] _now Time of the frame
+  /// \param[in] _delay Delay behind the latest message, in seconds
+  /// \return Render time, never decreasing unless the times jumped, such
+  /// as when the simulation is reset
+  public: double Now(Clock::time_point _now, double _delay)
   {
-    math::Pose3d pose = msgs::Convert(_msg.pose(i));
+    // Extrapolated for a short while only, in case the simulation paused
+    double age = std::min(kMaxExtrapolation,
+        std::chrono::duration<double>(_now - this->latestArrival).count());
+    double target = this->latest + age * this->rate - _delay;
 
-    // apply additional local poses if available
-    const auto it = this->localPoses.find(_msg.pose(i).id());
-    if (it != this->localPoses.end())
+    if (!this->started || std::abs(target - this->time) > kMaxDrift)
     {
-      pose = pose * it->second;
+      this->time = target;
+      this->started = true;
     }
-
-    this->poses[_msg.pose(i).id()] = pose;
+    else
+    {
+      double predicted = this->time + this->rate *
+          std::chrono::duration<double>(_now - this->lastFrame).count();
+      this->time = std::max(this->time,
+          predicted + kCorrection * (target - predicted));
+    }
+    this->lastFrame = _now;
+    return this->time;
   }
-}
 
-/////////////////////////////////////////////////
-void TransportSceneManagerPrivate::OnDeletionMsg(const msgs::UInt32_V &_msg)
-{
-  std::lock_guard<std::mutex> lock(this->msgMutex);
-  std::copy(_msg.data().begin(), _msg.data().end(),
-            std::back_inserter(this->toDeleteEntities));
-}
+  /// \brief Fastest rate of the message times
+  private: static constexpr double kMaxRate{100.0};
 
-/////////////////////////////////////////////////
-void TransportSceneManagerPrivate::OnRender()
-{
-  if (nullptr == this->scene)
-  {
-    this->scene = rendering::sceneFromFirstRenderEngine();
-    if (nullptr == this->scene)
-      return;
+  /// \brief Longest extrapolation past the latest message, in seconds
+  private: static constexpr double kMaxExtrapolation{0.5};
 
-    this->initializeTransport = std::thread(
-        &TransportSceneManagerPrivate::InitializeTransport, this);
-  }
+  /// \brief Distance to the latest message beyond which the clock jumps
+  /// to it, in seconds
+  private: static constexpr double kMaxDrift{0.5};
 
-  std::lock_guard<std::mutex> lock(this->msgMutex);
+  /// \brief Part of the distance to the latest message corrected per frame
+  private: static constexpr double kCorrection{0.1};
 
-  for (const auto &msg : this->sceneMsgs)
+  /// \brief True once a message was received
+  private: bool hasMessage{false};
+
+  /// \brief True once a frame was rendered
+  private: bool started{false};
+
+  /// \brief Time of the latest message
+  private: double latest{0.0};
+
+  /// \brief When the latest message was received
+  private: Clock::time_point latestArrival;
+
+  /// \brief Rate of the message times per wall clock second
+  private: double rate{1.0};
+
+  /// \brief Render time of the last frame
+  private: double time{0.0};
+
+  /// \brief When the last frame was rendered
+  private: Clock::time_point lastFrame;
+};
+
+/// \brief Entities stored contiguously, so that poses are applied in a
+/// linear sweep, and indexed by Id through an open addressing hash table.
+///
+/// Pointers and references to entities are invalidated by Insert and
+/// Erase.
+class EntityTable
+{
+  /// \brief Find an entity.
+  /// \param[in] _id Entity Id
+  /// \return Entity, null if not found
+  public: Entity *Find(unsigned int _id)
   {
-    this->LoadScene(msg);
+    if (this->buckets.empty())
+      return nullptr;
+
+    const std::size_t mask = this->buckets.size() - 1;
+    for (std::size_t i = this->Home(_id); ; i = (i + 1) & mask)
+    {
+      auto index = this->buckets[i];
+      if (index == 0u)
+        return nullptr;
+      if (this->entities[index - 1].id == _id)
+        return &this->entities[index - 1];
+    }
   }
-  this->sceneMsgs.clear();
 
-  for (const auto &entity : this->toDeleteEntities)
+  /// \brief Find an entity, adding it if it doesn't exist yet.
+  /// \param[in] _id Entity Id
+  /// \return Entity
+  public: Entity &Insert(unsigned int _id)
   {
-    this->DeleteEntity(entity);
+    if (auto entity = this->Find(_id))
+      return *entity;
+
+    // Keep the load factor under 3/4
+    if ((this->entities.size() + 1) * 4 > this->buckets.size() * 3)
+      this->Rehash(this->buckets.empty() ? 6u : this->bits + 1);
+
+    this->entities.emplace_back();
+    this->entities.back().id = _id;
+    this->Place(_id, static_cast<uint32_t>(this->entities.size()));
+    return this->entities.back();
   }
-  this->toDeleteEntities.clear();
 
-  for (auto pIt = this->poses.begin(); pIt != this->poses.end();)
+  /// \brief Remove an entity. The last entity takes its place.
+  /// \param[in] _id Entity Id
+  /// \return True if the entity existed
+  public: bool Erase(unsigned int _id)
   {
-    auto vIt = this->visuals.find(pIt->first);
-    if (vIt != this->visuals.end())
-    {
-      auto visual = vIt->second.lock();
-      if (visual)
+    auto i = this->BucketOf(_id);
+    if (i == kNotFound)
+      return false;
+
+    uint32_t index = this->buckets[i] - 1;
+
+    // Backward shift deletion, so that no tombstones are needed
+    const std::size_t mask = this->buckets.size() - 1;
+    this->buckets[i] = 0u;
+    for (std::size_t j = (i + 1) & mask; this->buckets[j] != 0u;
+        j = (j + 1) & mask)
+    {
+      auto home = this->Home(this->entities[this->buckets[j] - 1].id);
+
+      // Entries whose home is cyclically in (i, j] must stay
+      bool stays = (i <= j) ? (i < home && home <= j) :
+          (i < home || home <= j);
+      if (stays)
+        continue;
+
+      this->buckets[i] = this->buckets[j];
+      this->buckets[j] = 0u;
+      i = j;
+    }
+
+    // Keep entities contiguous
+    uint32_t last = static_cast<uint32_t>(this->entities.size() - 1);
+    if (index != last)
+    {
+      this->entities[index] = std::move(this->entities[last]);
+      this->buckets[this->BucketOf(this->entities[index].id)] = index + 1;
+    }
+    this->entities.pop_back();
+    return true;
+  }
+
+  /// \brief All entities, in no particular order
+  /// \return Entities
+  public: std::vector<Entity> &Entities()
+  {
+    return this->entities;
+  }
+
+  /// \brief Bucket returned by BucketOf when an Id isn't found
+  private: static constexpr std::size_t kNotFound =
+      std::numeric_limits<std::size_t>::max();
+
+  /// \brief Home bucket of an Id, using Fibonacci hashing
+  /// \param[in] _id Entity Id
+  /// \return Bucket index
+  private: std::size_t Home(unsigned int _id) const
+  {
+    return static_cast<std::size_t>(
+        (static_cast<uint64_t>(_id) * 0x9E3779B97F4A7C15ull) >>
+        (64u - this->bits));
+  }
+
+  /// \brief Find the bucket holding an Id.
+  /// \param[in] _id Entity Id
+  /// \return Bucket index, kNotFound if not found
+  private: std::size_t BucketOf(unsigned int _id) const
+  {
+    if (this->buckets.empty())
+      return kNotFound;
+
+    const std::size_t mask = this->buckets.size() - 1;
+    for (std::size_t i = this->Home(_id); ; i = (i + 1) & mask)
+    {
+      auto index = this->buckets[i];
+      if (index == 0u)
+        return kNotFound;
+      if (this->entities[index - 1].id == _id)
+        return i;
+    }
+  }
+
+  /// \brief Store an entity index in the first free bucket for its Id.
+  /// \param[in] _id Entity Id
+  /// \param[in] _index Index in entities, plus one
+  private: void Place(unsigned int _id, uint32_t _index)
+  {
+    const std::size_t mask = this->buckets.size() - 1;
+    std::size_t i = this->Home(_id);
+    while (this->buckets[i] != 0u)
+      i = (i + 1) & mask;
+    this->buckets[i] = _index;
+  }
+
+  /// \brief Rebuild the hash table with a new size.
+  /// \param[in] _bits Log2 of the number of buckets
+  private: void Rehash(unsigned int _bits)
+  {
+    this->bits = _bits;
+    this->buckets.assign(std::size_t{1} << _bits, 0u);
+    for (std::size_t k = 0; k < this->entities.size(); ++k)
+      this->Place(this->entities[k].id, static_cast<uint32_t>(k + 1));
+  }
+
+  /// \brief Entities, densely packed
+  private: std::vector<Entity> entities;
+
+  /// \brief Hash table of index in entities plus one, 0 if empty
+  private: std::vector<uint32_t> buckets;
+
+  /// \brief Log2 of the number of buckets
+  private: unsigned int bits{0u};
+};
+
+/// \brief Lock-free triple buffer handing the latest pose message from the
+/// transport thread to the render thread. Neither side ever waits on the
+/// other: the writer always has a buffer to fill, and the reader gets the
+/// most recent complete message, skipping any it didn't get to.
+///
+/// Only one thread may call Write and only one thread may call Read.
+class PoseBuffer
+{
+  /// \brief Publish a new message, parsed into the buffer being written,
+  /// which keeps the capacity of the previous message parsed into it.
+  /// Called from the transport thread.
+  /// \param[in] _data Serialized pose message
+  /// \param[in] _size Size of _data in bytes
+  /// \return False if _data isn't a valid message, which isn't published
+  public: bool Write(const char *_data, std::size_t _size)
+  {
+    if (!this->buffers[this->back].ParseFromArray(_data,
+        static_cast<int>(_size)))
+    {
+      return false;
+    }
+    this->back = this->middle.exchange(this->back | kFresh,
+        std::memory_order_acq_rel) & kIndexMask;
+    return true;
+  }
+
+  /// \brief Take the latest message. Called from the render thread.
+  /// \return The latest message, or null if there's nothing new since the
+  /// last call. Valid until the next call.
+  public: const gz::msgs::Pose_V *Read()
+  {
+    if ((this->middle.load(std::memory_order_relaxed) & kFresh) == 0u)
+      return nullptr;
+
+    this->front = this->middle.exchange(this->front,
+        std::memory_order_acq_rel) & kIndexMask;
+    return &this->buffers[this->front];
+  }
+
+  /// \brief Bits of middle holding a buffer index
+  private: static constexpr uint8_t kIndexMask = 0x3u;
+
+  /// \brief Bit of middle set when it holds a message not read yet
+  private: static constexpr uint8_t kFresh = 0x4u;
+
+  /// \brief The three buffers
+  private: std::array<gz::msgs::Pose_V, 3> buffers;
+
+  /// \brief Buffer shared between both threads, plus the kFresh bit
+  private: std::atomic<uint8_t> middle{1u};
+
+  /// \brief Buffer being written, owned by the writer
+  private: uint8_t back{0u};
+
+  /// \brief Buffer being read, owned by the reader
+  private: uint8_t front{2u};
+};
+
+/// \brief Poses of a pose message as structure of arrays, so they're
+/// composed with the entities' local poses in tight loops over contiguous
+/// doubles, which the compiler vectorizes, rather than one Pose3d at a
+/// time. The buffers keep their capacity from one message to the next.
+class PoseBatch
+{
+  /// \brief Copy the poses of a message, with identity local poses
+  /// \param[in] _msg Pose message
+  public: void Decode(const gz::msgs::Pose_V &_msg)
+  {
+    const auto count = static_cast<std::size_t>(_msg.pose_size());
+    this->ids.resize(count);
+    for (auto &values : this->pose)
+      values.resize(count);
+    for (auto &values : this->local)
+      values.assign(count, 0.0);
+    std::fill(this->local[kW].begin(), this->local[kW].end(), 1.0);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const auto &msg = _msg.pose(static_cast<int>(i));
+      this->ids[i] = msg.id();
+      this->pose[kX][i] = msg.position().x();
+      this->pose[kY][i] = msg.position().y();
+      this->pose[kZ][i] = msg.position().z();
+      this->pose[kW][i] = msg.orientation().w();
+      this->pose[kQx][i] = msg.orientation().x();
+      this->pose[kQy][i] = msg.orientation().y();
+      this->pose[kQz][i] = msg.orientation().z();
+    }
+  }
+
+  /// \brief Set the local pose applied after a pose
+  /// \param[in] _i Index of the pose
+  /// \param[in] _pose Local pose
+  public: void SetLocal(std::size_t _i, const gz::math::Pose3d &_pose)
+  {
+    this->local[kX][_i] = _pose.Pos().X();
+    this->local[kY][_i] = _pose.Pos().Y();
+    this->local[kZ][_i] = _pose.Pos().Z();
+    this->local[kW][_i] = _pose.Rot().W();
+    this->local[kQx][_i] = _pose.Rot().X();
+    this->local[kQy][_i] = _pose.Rot().Y();
+    this->local[kQz][_i] = _pose.Rot().Z();
+  }
+
+  /// \brief Apply the local poses, like pose * local. The rotation of the
+  /// local position divides by the quaternion's squared norm, like
+  /// Quaternion::Inverse does, so poses which aren't normalized give the
+  /// same result.
+  public: void Compose()
+  {
+    const std::size_t count = this->ids.size();
+    double *px = this->pose[kX].data();
+    double *py = this->pose[kY].data();
+    double *pz = this->pose[kZ].data();
+    double *qw = this->pose[kW].data();
+    double *qx = this->pose[kQx].data();
+    double *qy = this->pose[kQy].data();
+    double *qz = this->pose[kQz].data();
+    const double *lx = this->local[kX].data();
+    const double *ly = this->local[kY].data();
+    const double *lz = this->local[kZ].data();
+    const double *lw = this->local[kW].data();
+    const double *lqx = this->local[kQx].data();
+    const double *lqy = this->local[kQy].data();
+    const double *lqz = this->local[kQz].data();
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const double w = qw[i];
+      const double x = qx[i];
+      const double y = qy[i];
+      const double z = qz[i];
+
+      // q v q^-1 = ((w^2 - |u|^2) v + 2 (u.v) u + 2 w (u x v)) / |q|^2
+      const double norm = w * w + x * x + y * y + z * z;
+      const double inv = norm > 1e-6 ? 1.0 / norm : 0.0;
+      const double s = (w * w - x * x - y * y - z * z) * inv;
+      const double dot = 2.0 * (x * lx[i] + y * ly[i] + z * lz[i]) * inv;
+      const double w2 = 2.0 * w * inv;
+      px[i] += s * lx[i] + dot * x + w2 * (y * lz[i] - z * ly[i]);
+      py[i] += s * ly[i] + dot * y + w2 * (z * lx[i] - x * lz[i]);
+      pz[i] += s * lz[i] + dot * z + w2 * (x * ly[i] - y * lx[i]);
+
+      qw[i] = w * lw[i] - x * lqx[i] - y * lqy[i] - z * lqz[i];
+      qx[i] = w * lqx[i] + x * lw[i] + y * lqz[i] - z * lqy[i];
+      qy[i] = w * lqy[i] - x * lqz[i] + y * lw[i] + z * lqx[i];
+      qz[i] = w * lqz[i] + x * lqy[i] - y * lqx[i] + z * lw[i];
+    }
+  }
+
+  /// \brief Get a pose
+  /// \param[in] _i Index of the pose
+  /// \return The pose
+  public: gz::math::Pose3d Pose(std::size_t _i) const
+  {
+    return gz::math::Pose3d(
+        this->pose[kX][_i], this->pose[kY][_i], this->pose[kZ][_i],
+        this->pose[kW][_i], this->pose[kQx][_i], this->pose[kQy][_i],
+        this->pose[kQz][_i]);
+  }
+
+  /// \brief Number of poses
+  /// \return Number of poses of the last message decoded
+  public: std::size_t Size() const
+  {
+    return this->ids.size();
+  }
+
+  /// \brief Entity id of each pose
+  public: std::vector<unsigned int> ids;
+
+  /// \brief Indices of the components in pose and local
+  private: enum Component {kX, kY, kZ, kW, kQx, kQy, kQz, kComponents};
+
+  /// \brief Position and orientation of each pose, one array per
+  /// component
+  private: std::array<std::vector<double>, kComponents> pose;
+
+  /// \brief Local pose of each pose, identity by default
+  private: std::array<std::vector<double>, kComponents> local;
+};
+
+/// \brief Pose received for an entity which doesn't exist yet
+struct PendingPose
+{
+  /// \brief Latest pose received
+  gz::math::Pose3d pose;
+
+  /// \brief Frame when it was received
+  uint64_t frame{0u};
+};
+
+/// \brief A top level model or light waiting to be loaded
+struct LoadJob
+{
+  /// \brief Scene message containing the entity
+  std::shared_ptr<const gz::msgs::Scene> msg;
+
+  /// \brief Index of the model or light in the message
+  int index{0};
+
+  /// \brief True if it's a light, false if it's a model
+  bool light{false};
+
+  /// \brief Id of the model or light
+  unsigned int id{0u};
+
+  /// \brief True to reload the entity if it already exists
+  bool replace{false};
+
+  /// \brief Estimated center of the model in world coordinates, used to
+  /// order the jobs by the user camera
+  gz::math::Vector3d center;
+
+  /// \brief Estimated radius of the model around center
+  double radius{0.0};
+};
+
+/// \brief Visual showing a box while its mesh is decoded, see
+/// TransportSceneManagerPrivate::ReplacePlaceholders
+struct Placeholder
+{
+  /// \brief Id of the visual
+  unsigned int id{0u};
+
+  /// \brief Visual, to tell it apart from a visual loaded later with the
+  /// same id
+  gz::rendering::VisualPtr::weak_type visual;
+
+  /// \brief Scene message containing the visual, keeping visualMsg alive
+  std::shared_ptr<const gz::msgs::Scene> msg;
+
+  /// \brief Visual message, owned by msg
+  const gz::msgs::Visual *visualMsg{nullptr};
+};
+
+/// \brief Scene message waiting to be loaded
+struct SceneUpdate
+{
+  /// \brief Scene message
+  gz::msgs::Scene msg;
+
+  /// \brief True if it's the whole scene, false if it only contains
+  /// changes
+  bool full{false};
+
+  /// \brief True if it was read from the scene cache
+  bool cached{false};
+
+  /// \brief True if it's the whole scene written by a HostSceneCache
+  bool hosted{false};
+
+  /// \brief True if the entities which aren't part of it are removed,
+  /// for whole scenes which are known to be complete
+  bool prune{false};
+
+  /// \brief Mesh files still being decoded when it was handed to the
+  /// render thread, with progressive loading
+  std::vector<std::string> decoding;
+};
+
+/// \brief Find a key in the header data of a scene message
+/// \param[in] _msg Scene message
+/// \param[in] _key Key
+/// \return Header data, null if not found
+const gz::msgs::Header_Map *HeaderData(const gz::msgs::Scene &_msg,
+    const std::string &_key)
+{
+  if (!_msg.has_header())
+    return nullptr;
+
+  for (const auto &data : _msg.header().data())
+  {
+    if (data.key() == _key)
+      return &data;
+  }
+  return nullptr;
+}
+
+/// \brief Get the revision of a scene message
+/// \param[in] _msg Scene message
+/// \param[out] _revision Revision
+/// \return True if the message has a valid revision
+bool SceneRevision(const gz::msgs::Scene &_msg, uint64_t &_revision)
+{
+  auto data = HeaderData(_msg, "revision");
+  if (nullptr == data || data->value_size() == 0)
+    return false;
+
+  try
+  {
+    _revision = std::stoull(data->value(0));
+  }
+  catch (...)
+  {
+    gzerr << "Invalid scene revision [" << data->value(0) << "]"
+          << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/// \brief Get the radius of a sphere around the origin of a geometry
+/// containing it
+/// \param[in] _msg Geometry message
+/// \return Radius, the scale for meshes since their size isn't known
+/// before they're decoded
+double GeometryRadius(const gz::msgs::Geometry &_msg)
+{
+  if (_msg.has_box())
+    return gz::msgs::Convert(_msg.box().size()).Length() * 0.5;
+  if (_msg.has_cylinder())
+  {
+    return std::hypot(_msg.cylinder().radius(),
+        _msg.cylinder().length() * 0.5);
+  }
+  if (_msg.has_capsule())
+    return _msg.capsule().radius() + _msg.capsule().length() * 0.5;
+  if (_msg.has_ellipsoid())
+    return gz::msgs::Convert(_msg.ellipsoid().radii()).Max();
+  if (_msg.has_plane())
+    return gz::msgs::Convert(_msg.plane().size()).Length() * 0.5;
+  if (_msg.has_sphere())
+    return _msg.sphere().radius();
+  if (_msg.has_mesh())
+    return gz::msgs::Convert(_msg.mesh().scale()).Length() * 0.5;
+  return 0.0;
+}
+
+/// \brief Estimate the extent of a model from its visuals
+/// \param[in] _msg Model message
+/// \param[in] _parent World pose of the model's parent
+/// \param[in,out] _box Box containing the visuals, extended. It stays empty
+/// if there are no visuals.
+void ModelBounds(const gz::msgs::Model &_msg, const gz::math::Pose3d &_parent,
+    gz::math::AxisAlignedBox &_box)
+{
+  auto modelPose = _parent * gz::msgs::Convert(_msg.pose());
+  for (const auto &link : _msg.link())
+  {
+    auto linkPose = modelPose * gz::msgs::Convert(link.pose());
+    for (const auto &visual : link.visual())
+    {
+      auto pos = (linkPose * gz::msgs::Convert(visual.pose())).Pos();
+      double radius = GeometryRadius(visual.geometry());
+      const gz::math::Vector3d extent(radius, radius, radius);
+      _box.Merge(gz::math::AxisAlignedBox(pos - extent, pos + extent));
+    }
+  }
+  for (const auto &model : _msg.model())
+    ModelBounds(model, modelPose, _box);
+}
+
+/// \brief Add the Ids of a model and all its descendants to a set
+/// \param[in] _msg Model message
+/// \param[out] _ids Set of Ids
+void CollectIds(const gz::msgs::Model &_msg,
+    std::unordered_set<unsigned int> &_ids)
+{
+  _ids.insert(_msg.id());
+  for (const auto &link : _msg.link())
+  {
+    _ids.insert(link.id());
+    for (const auto &visual : link.visual())
+      _ids.insert(visual.id());
+    for (const auto &light : link.light())
+      _ids.insert(light.id());
+  }
+  for (const auto &model : _msg.model())
+    CollectIds(model, _ids);
+}
+}
+
+/// \brief Private data class for TransportSceneManager
+class gz::gui::plugins::TransportSceneManagerPrivate
+{
+  /// \brief Make the scene service request and populate the scene once
+  /// it replies. Scene updates are deferred until then.
+  public: void Request();
+
+  /// \brief Request the whole scene from the scene service
+  public: void RequestScene();
+
+  /// \brief Request a chunk of a scene snapshot from the snapshot service
+  /// \param[in] _snapshot Id of the snapshot, 0 for a new one
+  /// \param[in] _chunk Index of the chunk
+  public: void RequestSnapshotChunk(uint32_t _snapshot, uint32_t _chunk);
+
+  /// \brief Show a chunk of a scene snapshot and request the next one,
+  /// or populate the whole scene once it's the last one
+  /// \param[in] _msg Chunk
+  /// \param[in] _result True if the service replied
+  public: void OnSnapshotChunk(const msgs::Bytes &_msg, bool _result);
+
+  /// \brief Request the whole scene again, after missing scene updates
+  public: void Resync();
+
+  /// \brief Update the scene based on pose msgs received
+  public: void OnRender();
+
+  /// \brief Let the 3D scenes know that data is waiting to be applied, so
+  /// that they render a frame even when they've stopped rendering while
+  /// idle, which means OnRender isn't called. Called from the threads the
+  /// data arrives on, it only posts once until the next OnRender.
+  public: void NotifyDataArrived();
+
+  /// \brief Initialize transport, subscribing to the necessary topics.
+  /// To be called after a valid scene has been found.
+  public: void InitializeTransport();
+
+  /// \brief Callback function for the pose topic, which is subscribed to
+  /// raw so the message is parsed straight into its buffer
+  /// \param[in] _data Serialized pose vector msg
+  /// \param[in] _size Size of _data in bytes
+  public: void OnPoseVMsg(const char *_data, std::size_t _size);
+
+  /// \brief Store the poses in a message on the entities which exist in the
+  /// scene, converting them only for those. Called from the render thread.
+  /// \param[in] _msg Message containing pose updates
+  public: void UpdatePoses(const msgs::Pose_V &_msg);
+
+  /// \brief Queue the models and lights of a scene msg to be loaded
+  /// \param[in] _update Scene msg
+  public: void LoadScene(const SceneUpdate &_update);
+
+  /// \brief Load queued models and lights, until the frame's budget is
+  /// used up
+  /// \return True if anything was loaded
+  public: bool ProcessLoadJobs();
+
+  /// \brief Sort the queued jobs by the user camera, lights first, then
+  /// models in view and the others, each by their apparent size, so that
+  /// what's nearest and largest is loaded first. Only sorts again when
+  /// jobs were queued or the camera moved.
+  public: void OrderLoadJobs();
+
+  /// \brief Replace the placeholder boxes of decoded meshes by the meshes
+  /// \param[in] _meshes Mesh files which finished decoding
+  /// \return True if any placeholder was replaced
+  public: bool ReplacePlaceholders(const std::vector<std::string> &_meshes);
+
+  /// \brief Pass a scene msg to the loading worker
+  /// \param[in] _msg Scene msg
+  /// \param[in] _full True if it's the whole scene
+  /// \param[in] _cached True if it was read from the scene cache
+  /// \param[in] _hosted True if it was written by a HostSceneCache
+  /// \param[in] _prune True to remove the entities which aren't part of
+  /// the whole scene
+  public: void QueueScene(const msgs::Scene &_msg, bool _full,
+      bool _cached = false, bool _hosted = false, bool _prune = false);
+
+  /// \brief Read the scene and poses from a HostSceneCache instead of
+  /// transport, if there's one on this host
+  /// \return True if both are read from the cache
+  public: bool SubscribeHostCache();
+
+  /// \brief Load the scene saved by the previous session, if any, so it's
+  /// shown while waiting for the scene service
+  public: void LoadSceneCache();
+
+  /// \brief Save the whole scene, to be shown on the next launch
+  /// \param[in] _msg Scene msg
+  public: void SaveSceneCache(const msgs::Scene &_msg);
+
+  /// \brief Loading worker thread, which reads mesh files before the scene
+  /// msgs are handed to the render thread
+  public: void LoadWorker();
+
+  /// \brief Get the mesh files used by a model and its children
+  /// \param[in] _msg Model msg
+  /// \param[out] _filenames Mesh file names, appended to
+  public: void CollectMeshes(const msgs::Model &_msg,
+      std::vector<std::string> &_filenames);
+
+  /// \brief Callback function for the request topic
+  /// \param[in] _msg Deletion message
+  public: void OnDeletionMsg(const msgs::UInt32_V &_msg);
+
+  /// \brief Load the scene from a scene msg
+  /// \param[in] _msg Scene msg
+  public: void OnSceneSrvMsg(const msgs::Scene &_msg, const bool result);
+
+  /// \brief Called when there's an entity is added to the scene
+  /// \param[in] _msg Scene msg
+  public: void OnSceneMsg(const msgs::Scene &_msg);
+
+  /// \brief Load the model from a model msg
+  /// \param[in] _msg Model msg
+  /// \return Model visual created from the msg
+  public: rendering::VisualPtr LoadModel(const msgs::Model &_msg);
+
+  /// \brief Load a link from a link msg
+  /// \param[in] _msg Link msg
+  /// \return Link visual created from the msg
+  public: rendering::VisualPtr LoadLink(const msgs::Link &_msg);
+
+  /// \brief Load a visual from a visual msg
+  /// \param[in] _msg Visual msg
+  /// \return Visual visual created from the msg
+  public: rendering::VisualPtr LoadVisual(const msgs::Visual &_msg);
+
+  /// \brief Add the geometry of a visual msg to its visual and set its
+  /// material
+  /// \param[in] _msg Visual msg
+  /// \param[in] _visual Visual, without a geometry
+  /// \param[in] _root Id of the visual's top level model, 0 if none
+  /// \param[out] _localPose Additional local pose to be applied after the
+  /// visual's pose
+  /// \param[out] _placeholder True if a box was added because the mesh is
+  /// still being decoded
+  /// \return True if the geometry was loaded
+  public: bool LoadVisualGeometry(const msgs::Visual &_msg,
+      const rendering::VisualPtr &_visual, unsigned int _root,
+      math::Pose3d &_localPose, bool &_placeholder);
+
+  /// \brief Load a geometry from a geometry msg
+  /// \param[in] _msg Geometry msg
+  /// \param[out] _scale Geometry scale that will be set based on msg param
+  /// \param[out] _localPose Additional local pose to be applied after the
+  /// visual's pose
+  /// \param[out] _placeholder True if the geometry is a box because the
+  /// mesh is still being decoded
+  /// \return Geometry object created from the msg
+  public: rendering::GeometryPtr LoadGeometry(const msgs::Geometry &_msg,
+      math::Vector3d &_scale, math::Pose3d &_localPose, bool &_placeholder);
+
+  /// \brief Load a material from a material msg
+  /// \param[in] _msg Material msg
+  /// \return Material object created from the msg
+  public: rendering::MaterialPtr LoadMaterial(const msgs::Material &_msg);
+
+  /// \brief Set the material of a geometry, shared by all visuals with
+  /// the same material, transparency and shadows.
+  /// \param[in] _msg Visual msg
+  /// \param[in] _geom Geometry of the visual
+  public: void SetSharedMaterial(const msgs::Visual &_msg,
+      const rendering::GeometryPtr &_geom);
+
+  /// \brief Release the shared material of a geometry, destroying it when
+  /// no other geometry uses it.
+  /// \param[in] _geometryId Id of the geometry
+  public: void ReleaseMaterial(unsigned int _geometryId);
+
+  /// \brief Release the shared materials of geometries which were
+  /// destroyed without going through DestroyVisual, such as by other
+  /// plugins.
+  public: void ReleaseExpiredMaterials();
+
+  /// \brief Create the material shared by the visuals with the same
+  /// material, transparency and shadows as a visual msg.
+  /// \param[in] _msg Visual msg
+  /// \return New material
+  public: rendering::MaterialPtr LoadSharedMaterial(
+      const msgs::Visual &_msg);
+
+  /// \brief Release the shared materials of a visual and its descendants.
+  /// \param[in] _visual The visual
+  public: void ReleaseMaterials(const rendering::VisualPtr &_visual);
+
+  /// \brief Destroy a visual and its descendants, releasing their shared
+  /// materials.
+  /// \param[in] _visual The visual
+  public: void DestroyVisual(const rendering::VisualPtr &_visual);
+
+  /// \brief Load a light from a light msg
+  /// \param[in] _msg Light msg
+  /// \return Light object created from the msg
+  public: rendering::LightPtr LoadLight(const msgs::Light &_msg);
+
+  /// \brief Delete an entity. Visuals are hidden right away and destroyed
+  /// later by DestroyVisuals, unless _immediate is true.
+  /// \param[in] _entity Entity to delete
+  /// \param[in] _immediate True to destroy the visual right away
+  public: void DeleteEntity(const unsigned int _entity,
+      bool _immediate = false);
+
+  /// \brief Queue a loaded entity for the scene entities, as a child of
+  /// loadingParent
+  /// \param[in] _id Entity Id
+  /// \param[in] _name Entity name
+  /// \param[in] _type Kind of entity
+  /// \param[in] _node Node rendering it
+  public: void AddSceneEntity(unsigned int _id, const std::string &_name,
+      SceneEntities::Type _type, const rendering::NodePtr &_node);
+
+  /// \brief Queue a deleted entity for the scene entities
+  /// \param[in] _id Entity Id
+  public: void RemoveSceneEntity(unsigned int _id);
+
+  /// \brief Send the queued entities to the scene entities
+  public: void PublishSceneEntities();
+
+  /// \brief Destroy deleted visuals, until the frame's budget is used up
+  /// \return True if anything was destroyed
+  public: bool DestroyVisuals();
+
+  /// \brief Update the level of detail of some of the top level models,
+  /// based on their distance to the user camera
+  /// \return True if any level of detail changed
+  public: bool UpdateLod();
+
+  /// \brief Change the level of detail of a top level model
+  /// \param[in] _root Top level model entity
+  /// \param[in] _lod New level of detail
+  public: void SetLod(Entity &_root, Lod _lod);
+
+  /// \brief Show a visual's mesh or its bounding box
+  /// \param[in] _visual Visual entity with a mesh
+  /// \param[in] _box True to show the bounding box
+  public: void ShowBox(Entity &_visual, bool _box);
+
+  /// \brief Set the pose of a newly created entity to the latest pose
+  /// received for it before it existed, if any.
+  /// \param[in] _id Entity Id
+  public: void ApplyPendingPose(unsigned int _id);
+
+  /// \brief Remove pending poses of entities which haven't appeared for
+  /// kPendingPoseFrames frames.
+  public: void EvictPendingPoses();
+
+  /// \brief Find the user camera, if it's not known yet
+  /// \return True if there's a user camera
+  public: bool FindUserCamera();
+
+  /// \brief Apply the poses received, all of them or, with a pose budget,
+  /// those in view first and the others while the budget lasts.
+  public: void ApplyPoses();
+
+  /// \brief Update the pose priority of the top level models, based on
+  /// the user camera
+  public: void UpdatePosePriorities();
+
+  /// \brief Check if the pose of an entity isn't applied for now, because
+  /// its model is culled and skipCulledPoses is set
+  /// \param[in] _entity Entity
+  /// \return True to keep its pose until its model is visible again
+  public: bool SkipPose(const Entity &_entity);
+
+  /// \brief Apply the poses of the entities being interpolated at the
+  /// render time of this frame
+  public: void InterpolatePoses();
+
+  /// \brief Record that a pose was applied to an entity, so its model
+  /// isn't batched for a while, and is split from its batch if it is.
+  /// \param[in] _entity Entity
+  public: void MarkMoved(const Entity &_entity);
+
+  /// \brief Split the batches of models which moved, and periodically
+  /// merge models which stayed put into new batches
+  /// \return True if any batch changed
+  public: bool UpdateStaticBatches();
+
+  /// \brief Merge the geometries of top level models into a single mesh
+  /// with a submesh per material, and hide their own visuals.
+  /// \param[in] _roots Top level models
+  /// \return True if the batch was created
+  public: bool BuildStaticBatch(const std::vector<unsigned int> &_roots);
+
+  /// \brief Destroy a batch and show its models' own visuals again
+  /// \param[in] _batch Batch Id
+  public: void SplitStaticBatch(uint32_t _batch);
+
+  /// \brief Stop the loading worker thread
+  public: void StopWorker();
+
+  /// \brief Mark an entity of the model being loaded as static, if the
+  /// model is
+  /// \param[in] _entity Entity
+  /// \param[in] _visual Its visual
+  public: void MarkStatic(Entity &_entity,
+      const rendering::VisualPtr &_visual);
+
+  //// \brief gz-transport scene service name
+  public: std::string service{"scene"};
+
+  /// \brief Service sending the scene as a snapshot in chunks, empty to
+  /// only use the scene service
+  public: std::string snapshotService;
+
+  /// \brief Scene snapshot being received, with all the chunks so far.
+  /// Only used by the snapshot callbacks, which are called one at a time.
+  public: SceneSnapshotChunk snapshot;
+
+  /// \brief Time the snapshot was requested
+  public: std::chrono::steady_clock::time_point snapshotStart;
+
+  //// \brief gz-transport pose topic name
+  public: std::string poseTopic{"pose"};
+
+  //// \brief gz-transport deletion topic name
+  public: std::string deletionTopic{"delete"};
+
+  //// \brief gz-transport scene topic name
+  public: std::string sceneTopic{"scene"};
+
+  /// \brief File the whole scene is cached in, empty to disable caching
+  public: std::string sceneCachePath;
+
+  /// \brief Serialized models and lights of the cached scene, by Id, until
+  /// the live scene arrives, or of the previous scene from the host cache,
+  /// so only the entities which changed are reloaded. Only accessed from
+  /// the render thread.
+  public: std::unordered_map<unsigned int, std::string> cachedEntities;
+
+  /// \brief True to read the scene from a HostSceneCache
+  public: bool hostCache{false};
+
+  /// \brief Scene written by the host cache
+  public: SharedMemorySubscriber hostScene;
+
+  /// \brief Poses written by the host cache
+  public: SharedMemorySubscriber hostPoses;
+
+  //// \brief Pointer to the rendering scene
+  public: rendering::ScenePtr scene{nullptr};
+
+  //// \brief Mutex to protect the msgs
+  public: std::mutex msgMutex;
+
+  /// \brief All visuals and lights, with their latest poses. Only accessed
+  /// from the render thread.
+  public: EntityTable entities;
+
+  /// \brief Number of entities with a pose which hasn't been applied yet
+  public: std::size_t dirtyPoseCount{0u};
+
+  /// \brief Delay in seconds poses are rendered at behind the latest pose
+  /// message, interpolating between the messages. 0 to apply the latest
+  /// poses as they are.
+  public: double interpolationDelay{0.0};
+
+  /// \brief Render time of the interpolated poses
+  public: PlaybackClock playback;
+
+  /// \brief Number of entities being interpolated, at most
+  public: std::size_t interpolatingCount{0u};
+
+  /// \brief Origin of the times of pose messages without a header stamp
+  public: std::chrono::steady_clock::time_point poseEpoch{
+      std::chrono::steady_clock::now()};
+
+  /// \brief Latest poses of entities which don't exist yet, applied when
+  /// they're loaded. Only accessed from the render thread.
+  public: std::unordered_map<unsigned int, PendingPose> pendingPoses;
+
+  /// \brief Maximum number of pending poses
+  public: static constexpr std::size_t kMaxPendingPoses{10000u};
+
+  /// \brief Number of frames after which a pending pose is dropped
+  public: static constexpr uint64_t kPendingPoseFrames{600u};
+
+  /// \brief Number of frames rendered
+  public: uint64_t frameCount{0u};
+
+  /// \brief True to only keep the latest pose message received between two
+  /// frames, false to apply all of them.
+  public: bool conflatePoses{true};
+
+  /// \brief Latest pose message, passed from the transport thread to the
+  /// render thread without locking. Used when conflating poses.
+  public: PoseBuffer poseBuffer;
+
+  /// \brief All pose messages received since the last frame. Used when not
+  /// conflating poses.
+  public: std::vector<std::shared_ptr<msgs::Pose_V>> poseMsgs;
+
+  /// \brief Recycles the messages of poseMsgs once they're applied
+  public: MessagePool<msgs::Pose_V> posePool{16u};
+
+  /// \brief Poses of the message being applied, only used by UpdatePoses
+  public: PoseBatch poseBatch;
+
+  /// \brief Entity of each pose of poseBatch, null if it isn't loaded or
+  /// its pose is skipped, only used by UpdatePoses
+  public: std::vector<Entity *> poseEntities;
+
+  /// \brief Protects poseMsgs
+  public: std::mutex poseMutex;
+
+  /// Entities to be deleted
+  public: std::vector<unsigned int> toDeleteEntities;
+
+  /// \brief Keeps the a list of unprocessed scene messages, with their
+  /// meshes loaded
+  public: std::vector<SceneUpdate> sceneMsgs;
+
+  /// \brief Serialized size of sceneMsgs
+  public: std::size_t sceneBytes{0u};
+
+  /// \brief Reports sceneMsgs to QueueStats. Scene updates can't be
+  /// dropped without losing entities, so it has no limit.
+  public: QueueStats::Queue sceneQueue{"TransportSceneManager/scenes",
+      false};
+
+  /// \brief Reports toDeleteEntities to QueueStats
+  public: QueueStats::Queue deletionQueue{
+      "TransportSceneManager/deletions", false};
+
+  /// \brief Scene messages waiting for the loading worker
+  public: std::deque<SceneUpdate> workerMsgs;
+
+  /// \brief Protects revision, hasRevision and deferredUpdates
+  public: std::mutex revisionMutex;
+
+  /// \brief Revision of the last scene update received
+  public: uint64_t revision{0u};
+
+  /// \brief True once a scene msg with a revision was received
+  public: bool hasRevision{false};
+
+  /// \brief True while waiting for the whole scene, at startup or after
+  /// missing updates
+  public: bool resyncing{false};
+
+  /// \brief True while the whole scene is requested again after missing
+  /// updates, so the entities which aren't part of it are removed
+  public: bool resyncRequested{false};
+
+  /// \brief Scene service request in flight. Protected by revisionMutex.
+  public: ServiceRequest sceneRequest;
+
+  /// \brief Scene updates received while resyncing, applied on top of the
+  /// whole scene once it arrives
+  public: std::vector<msgs::Scene> deferredUpdates;
+
+  /// \brief Number of scene messages passed to the loading worker and not
+  /// taken by the render thread yet
+  public: std::atomic<std::size_t> scenesInFlight{0u};
+
+  /// \brief True once NotifyDataArrived posted, until the next OnRender
+  public: std::atomic<bool> dataArrived{false};
+
+  /// \brief Protects workerMsgs and stopWorker
+  public: std::mutex workerMutex;
+
+  /// \brief Notifies the loading worker of new messages
+  public: std::condition_variable workerCv;
+
+  /// \brief True to stop the loading worker
+  public: bool stopWorker{false};
+
+  /// \brief Loading worker thread
+  public: std::thread worker;
+
+  /// \brief Number of threads the loading worker parses mesh files with
+  public: unsigned int loadThreads{
+      std::max(1u, std::thread::hardware_concurrency() / 2u)};
+
+  /// \brief Directory parsed meshes are cached in, empty to disable it
+  public: std::string meshCacheDir;
+
+  /// \brief Parses the mesh files for the loading worker
+  public: std::unique_ptr<AssetLoader> assetLoader;
+
+  /// \brief Models and lights waiting to be loaded. Only accessed from the
+  /// render thread.
+  public: std::deque<LoadJob> loadJobs;
+
+  /// \brief Number of jobs loaded since loading started
+  public: std::size_t loadJobsDone{0u};
+
+  /// \brief Number of jobs queued since loading started
+  public: std::size_t loadJobsTotal{0u};
+
+  /// \brief Maximum number of visuals and lights to create per frame, 0 for
+  /// no limit
+  public: std::size_t loadBudget{200u};
+
+  /// \brief Number of visuals and lights created in the current frame
+  public: std::size_t createdNodes{0u};
+
+  /// \brief True to load the scene progressively: jobs are ordered by the
+  /// user camera, and scenes are handed to the render thread before their
+  /// meshes are decoded, which show boxes until they are
+  public: bool progressiveLoading{true};
+
+  /// \brief True if jobs were queued since they were last ordered
+  public: bool loadOrderDirty{false};
+
+  /// \brief Pose of the user camera when the jobs were last ordered
+  public: math::Pose3d loadOrderPose;
+
+  /// \brief Distance the camera moves before the jobs are ordered again
+  public: static constexpr double kLoadOrderDistance{1.0};
+
+  /// \brief Angle in radians the camera turns before the jobs are ordered
+  /// again
+  public: static constexpr double kLoadOrderAngle{0.2};
+
+  /// \brief Mesh files being decoded by the loading worker, which are
+  /// shown as boxes until they're decoded. Only accessed from the render
+  /// thread.
+  public: std::unordered_set<std::string> decodingMeshes;
+
+  /// \brief Mesh files decoded by the loading worker since the last frame.
+  /// Protected by msgMutex.
+  public: std::vector<std::string> decodedMeshes;
+
+  /// \brief Visuals showing boxes, by the mesh file they're waiting for
+  public: std::unordered_map<std::string, std::vector<Placeholder>>
+      placeholders;
+
+  /// \brief Number of visuals in placeholders
+  public: std::size_t placeholderCount{0u};
+
+  /// \brief Scene msg of the job being loaded
+  public: std::shared_ptr<const msgs::Scene> loadingMsg;
+
+  /// \brief Deleted visuals, hidden and waiting to be destroyed. Weak
+  /// pointers, since destroying a visual also destroys its children, which
+  /// may be queued as well.
+  public: std::deque<rendering::VisualPtr::weak_type> toDestroy;
+
+  /// \brief Time spent applying poses of models out of view per frame, 0
+  /// to apply all poses each frame. Poses of models in view are always
+  /// applied.
+  public: std::chrono::duration<double, std::milli> poseBudget{0.0};
+
+  /// \brief Index in the entity table where applying deferred poses
+  /// resumes, so all entities get their turn
+  public: std::size_t poseCursor{0u};
+
+  /// \brief Distance to the user camera under which models count as near
+  public: static constexpr double kNearPoseDistance{10.0};
+
+  /// \brief Margin around a model's origin for the view frustum check,
+  /// as the extent of models isn't known
+  public: static constexpr double kViewMargin{2.0};
+
+  /// \brief Number of poses applied between checks of the pose budget
+  public: static constexpr std::size_t kPoseBudgetStride{256u};
+
+  /// \brief Time to spend destroying deleted visuals per frame
+  public: std::chrono::duration<double, std::milli> destroyBudget{2.0};
+
+  /// \brief Materials shared between visuals, keyed by the serialized
+  /// material msg, transparency and shadows
+  public: std::unordered_map<std::string, CachedMaterial> materialCache;
+
+  /// \brief Shared material of each geometry, by geometry id, since ids
+  /// aren't reused like the addresses of destroyed geometries
+  public: std::unordered_map<unsigned int, GeometryMaterial>
+      geometryMaterials;
+
+  /// \brief Entities deleted before they were loaded
+  public: std::set<unsigned int> deletedBeforeLoad;
+
+  /// \brief Called from the render thread with the number of jobs loaded,
+  /// the total number of jobs and the number of placeholders
+  public: std::function<void(std::size_t, std::size_t, std::size_t)>
+      onLoadProgress;
+
+  /// \brief Plugins sharing this scene, one per window, whose items are
+  /// notified of the loading progress. Protected by pluginsMutex.
+  public: std::vector<TransportSceneManager *> plugins;
+
+  /// \brief Protects plugins, which is read from the render thread
+  public: std::mutex pluginsMutex;
+
+  /// \brief Key of this scene among the shared scenes, empty if it isn't
+  /// shared, see sharedScenes
+  public: std::string sharedKey;
+
+  /// \brief Transport node for making service request and subscribing to
+  /// pose topic
+  public: gz::transport::Node node;
+
+  /// \brief Render hook identifier
+  public: uint64_t renderHookId{0};
+
+  /// \brief Id of the top level model being loaded
+  public: unsigned int loadingRoot{0u};
+
+  /// \brief Id of the model or link whose children are being loaded, 0
+  /// at the top level
+  public: unsigned int loadingParent{0u};
+
+  /// \brief Hierarchy of the scene for browsing plugins, set on the GUI
+  /// thread
+  public: SceneEntities *sceneEntities{nullptr};
+
+  /// \brief Entities loaded since the scene entities were last updated.
+  /// Only one of addedEntities and removedEntities is non empty, so they're
+  /// sent in order.
+  public: std::vector<SceneEntities::Entity> addedEntities;
+
+  /// \brief Entities deleted since the scene entities were last updated
+  public: std::vector<unsigned int> removedEntities;
+
+  /// \brief Distance to the user camera beyond which meshes are replaced by
+  /// their bounding boxes, 0 to disable
+  public: double boxDistance{0.0};
+
+  /// \brief Distance to the user camera beyond which models are hidden, 0
+  /// to disable
+  public: double cullDistance{0.0};
+
+  /// \brief True to not apply poses to hidden models until they're visible
+  public: bool skipCulledPoses{false};
+
+  /// \brief True to mark static models as static, and skip their pose
+  /// updates once placed
+  public: bool staticModels{false};
+
+  /// \brief True while loading a top level model marked as static
+  public: bool loadingStatic{false};
+
+  /// \brief Index in the entity table where the next level of detail
+  /// update starts
+  public: std::size_t lodCursor{0u};
+
+  /// \brief Maximum number of entities checked per level of detail update
+  public: static constexpr std::size_t kLodBatch{1000u};
+
+  /// \brief Estimated GPU memory of a mesh vertex: position, normal and
+  /// texture coordinates as floats
+  public: static constexpr uint64_t kVertexBytes{32u};
+
+  /// \brief Estimated GPU memory of a mesh index
+  public: static constexpr uint64_t kIndexBytes{4u};
+
+  /// \brief True to merge models which don't move into static batches
+  public: bool staticBatching{false};
+
+  /// \brief Time in seconds a model must stay put before it's batched,
+  /// models marked as static are batched right away
+  public: double batchSettleTime{5.0};
+
+  /// \brief Size in meters of the grid cells models are batched by, so
+  /// that batches can still be culled
+  public: double batchCellSize{50.0};
+
+  /// \brief Static batches by Id
+  public: std::unordered_map<uint32_t, StaticBatch> batches;
+
+  /// \brief Id of the next batch
+  public: uint32_t nextBatch{1u};
+
+  /// \brief Batches with a model which moved, split on the next update
+  public: std::vector<uint32_t> batchesToSplit;
+
+  /// \brief Time of the current frame, in seconds since poseEpoch
+  public: double frameTime{0.0};
+
+  /// \brief Time of the last search of models to batch, in seconds since
+  /// poseEpoch
+  public: double lastBatchCheck{0.0};
+
+  /// \brief Time in seconds between searches of models to batch
+  public: static constexpr double kBatchCheckPeriod{1.0};
+
+  /// \brief Maximum number of models in a batch, so that a model which
+  /// moves doesn't split too much of the world
+  public: static constexpr std::size_t kMaxBatchRoots{256u};
+
+  /// \brief Time spent building batches per frame
+  public: static constexpr std::chrono::milliseconds kBatchBudget{5};
+
+  /// \brief User camera, used for the level of detail
+  public: rendering::CameraPtr camera{nullptr};
+};
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+namespace
+{
+  /// \brief Scenes loaded in the process
+  struct SharedScenes
+  {
+    /// \brief Protects scenes
+    std::mutex mutex;
+
+    /// \brief Data of each scene, by transport parameters
+    std::map<std::string, std::weak_ptr<TransportSceneManagerPrivate>>
+        scenes;
+  };
+
+  /////////////////////////////////////////////////
+  /// \brief Scenes shared by the plugins of all windows, so that each
+  /// transport scene is only requested, subscribed to and loaded once
+  SharedScenes &sharedScenes()
+  {
+    static SharedScenes instance;
+    return instance;
+  }
+}
+
+/////////////////////////////////////////////////
+TransportSceneManager::TransportSceneManager()
+  : Plugin(), dataPtr(new TransportSceneManagerPrivate)
+{
+  this->dataPtr->sceneEntities = SceneEntities::Instance();
+}
+
+/////////////////////////////////////////////////
+TransportSceneManager::~TransportSceneManager()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->pluginsMutex);
+    auto &plugins = this->dataPtr->plugins;
+    plugins.erase(std::remove(plugins.begin(), plugins.end(), this),
+        plugins.end());
+  }
+
+  {
+    auto &shared = sharedScenes();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    // Other windows still show the scene
+    if (this->dataPtr.use_count() > 1)
+      return;
+
+    if (!this->dataPtr->sharedKey.empty())
+      shared.scenes.erase(this->dataPtr->sharedKey);
+  }
+
+  RenderHooks::Unregister(this->dataPtr->renderHookId);
+  WorkerPool::Cancel(this->dataPtr.get());
+
+  // Waits for a reply being handled
+  ServiceRequest sceneRequest;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->revisionMutex);
+    sceneRequest = this->dataPtr->sceneRequest;
+  }
+  sceneRequest.Cancel();
+  this->dataPtr->hostScene.Unsubscribe();
+  this->dataPtr->hostPoses.Unsubscribe();
+  this->dataPtr->StopWorker();
+
+  // The scene goes away with its manager
+  this->dataPtr->sceneEntities->Clear();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManager::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Transport Scene Manager";
+
+  // Custom parameters
+  if (_pluginElem)
+  {
+    auto elem = _pluginElem->FirstChildElement("service");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      this->dataPtr->service =
+          transport::TopicUtils::AsValidTopic(elem->GetText());
+    }
+
+    elem = _pluginElem->FirstChildElement("snapshot_service");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      this->dataPtr->snapshotService =
+          transport::TopicUtils::AsValidTopic(elem->GetText());
+      if (this->dataPtr->snapshotService.empty())
+      {
+        gzerr << "Invalid <snapshot_service> [" << elem->GetText() << "]"
+              << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("pose_topic");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      this->dataPtr->poseTopic =
+          transport::TopicUtils::AsValidTopic(elem->GetText());
+    }
+
+    elem = _pluginElem->FirstChildElement("deletion_topic");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      this->dataPtr->deletionTopic =
+          transport::TopicUtils::AsValidTopic(elem->GetText());
+    }
+
+    elem = _pluginElem->FirstChildElement("scene_topic");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      this->dataPtr->sceneTopic =
+          transport::TopicUtils::AsValidTopic(elem->GetText());
+    }
+
+    elem = _pluginElem->FirstChildElement("conflate_poses");
+    if (nullptr != elem)
+    {
+      elem->QueryBoolText(&this->dataPtr->conflatePoses);
+    }
+
+    elem = _pluginElem->FirstChildElement("interpolation_delay");
+    if (nullptr != elem)
+    {
+      double delay{0.0};
+      if (elem->QueryDoubleText(&delay) == tinyxml2::XML_SUCCESS &&
+          delay >= 0.0)
+      {
+        this->dataPtr->interpolationDelay = delay;
+      }
+      else
+      {
+        gzerr << "Invalid <interpolation_delay>, expected a time in seconds"
+              << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("load_budget");
+    if (nullptr != elem)
+    {
+      unsigned int budget{0u};
+      if (elem->QueryUnsignedText(&budget) == tinyxml2::XML_SUCCESS)
+        this->dataPtr->loadBudget = budget;
+      else
+        gzerr << "Invalid <load_budget>, expected a number of visuals"
+              << std::endl;
+    }
+
+    elem = _pluginElem->FirstChildElement("progressive_loading");
+    if (nullptr != elem)
+    {
+      elem->QueryBoolText(&this->dataPtr->progressiveLoading);
+    }
+
+    elem = _pluginElem->FirstChildElement("delete_budget");
+    if (nullptr != elem)
+    {
+      double budget{0.0};
+      if (elem->QueryDoubleText(&budget) == tinyxml2::XML_SUCCESS &&
+          budget >= 0.0)
+      {
+        this->dataPtr->destroyBudget =
+            std::chrono::duration<double, std::milli>(budget);
+      }
+      else
+      {
+        gzerr << "Invalid <delete_budget>, expected a time in milliseconds"
+              << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("pose_budget");
+    if (nullptr != elem)
+    {
+      double budget{0.0};
+      if (elem->QueryDoubleText(&budget) == tinyxml2::XML_SUCCESS &&
+          budget >= 0.0)
+      {
+        this->dataPtr->poseBudget =
+            std::chrono::duration<double, std::milli>(budget);
+      }
+      else
+      {
+        gzerr << "Invalid <pose_budget>, expected a time in milliseconds"
+              << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("lod");
+    if (nullptr != elem)
+    {
+      auto lodElem = elem->FirstChildElement("box_distance");
+      if (nullptr != lodElem)
+        lodElem->QueryDoubleText(&this->dataPtr->boxDistance);
+
+      lodElem = elem->FirstChildElement("cull_distance");
+      if (nullptr != lodElem)
+        lodElem->QueryDoubleText(&this->dataPtr->cullDistance);
+
+      lodElem = elem->FirstChildElement("skip_culled_poses");
+      if (nullptr != lodElem)
+        lodElem->QueryBoolText(&this->dataPtr->skipCulledPoses);
+    }
+
+    elem = _pluginElem->FirstChildElement("static_models");
+    if (nullptr != elem)
+      elem->QueryBoolText(&this->dataPtr->staticModels);
+
+    elem = _pluginElem->FirstChildElement("static_batching");
+    if (nullptr != elem)
+    {
+      this->dataPtr->staticBatching = true;
+
+      auto batchElem = elem->FirstChildElement("settle_time");
+      if (nullptr != batchElem)
+        batchElem->QueryDoubleText(&this->dataPtr->batchSettleTime);
+
+      batchElem = elem->FirstChildElement("cell_size");
+      if (nullptr != batchElem &&
+          (batchElem->QueryDoubleText(&this->dataPtr->batchCellSize) !=
+          tinyxml2::XML_SUCCESS || this->dataPtr->batchCellSize <= 0.0))
+      {
+        gzerr << "Invalid <cell_size>, expected a positive size in meters"
+              << std::endl;
+        this->dataPtr->batchCellSize = 50.0;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("scene_cache");
+    if (nullptr != elem)
+    {
+      if (nullptr != elem->GetText())
+      {
+        this->dataPtr->sceneCachePath = elem->GetText();
+      }
+      else
+      {
+        // One file per service, so different worlds don't share it
+        std::string name = transport::TopicUtils::AsValidTopic(
+            this->dataPtr->service);
+        name.erase(0, 1);
+        std::replace(name.begin(), name.end(), '/', '_');
+        std::string home;
+        common::env(GZ_HOMEDIR, home);
+        this->dataPtr->sceneCachePath = common::joinPaths(home, ".gz",
+            "gui", "scene_cache", name + ".pb");
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("host_cache");
+    if (nullptr != elem &&
+        elem->QueryBoolText(&this->dataPtr->hostCache) !=
+        tinyxml2::XML_SUCCESS)
+    {
+      gzerr << "Invalid <host_cache>, expected true or false" << std::endl;
+    }
+
+    elem = _pluginElem->FirstChildElement("load_threads");
+    if (nullptr != elem)
+    {
+      unsigned int threads{0u};
+      if (elem->QueryUnsignedText(&threads) == tinyxml2::XML_SUCCESS &&
+          threads > 0u)
+      {
+        this->dataPtr->loadThreads = threads;
+      }
+      else
+      {
+        gzerr << "Invalid <load_threads>, expected a positive number"
+              << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("mesh_cache");
+    if (nullptr != elem)
+    {
+      if (nullptr != elem->GetText())
+      {
+        this->dataPtr->meshCacheDir = elem->GetText();
+      }
+      else
+      {
+        // Shared by all worlds and instances, entries are per mesh file
+        std::string home;
+        common::env(GZ_HOMEDIR, home);
+        this->dataPtr->meshCacheDir = common::joinPaths(home, ".gz",
+            "gui", "mesh_cache");
+      }
+    }
+  }
+
+  QQmlProperty::write(this->PluginItem(), "service",
+      QString::fromStdString(this->dataPtr->service));
+  QQmlProperty::write(this->PluginItem(), "poseTopic",
+      QString::fromStdString(this->dataPtr->poseTopic));
+  QQmlProperty::write(this->PluginItem(), "deletionTopic",
+      QString::fromStdString(this->dataPtr->deletionTopic));
+  QQmlProperty::write(this->PluginItem(), "sceneTopic",
+      QString::fromStdString(this->dataPtr->sceneTopic));
+
+  if (this->dataPtr->service.empty() ||
+      this->dataPtr->poseTopic.empty() ||
+      this->dataPtr->deletionTopic.empty() ||
+      this->dataPtr->sceneTopic.empty())
+  {
+    gzerr << "One or more transport parameters invalid:" << std::endl
+        << "  * <service>: " << this->dataPtr->service << std::endl
+        << "  * <pose_topic>: " << this->dataPtr->poseTopic << std::endl
+        << "  * <deletion_topic>: " << this->dataPtr->deletionTopic << std::endl
+        << "  * <scene_topic>: " << this->dataPtr->sceneTopic << std::endl;
+  }
+  else if (this->dataPtr->sharedKey.empty())
+  {
+    // Another window may already show this scene, in which case its data
+    // is shared instead of loading the scene again
+    auto key = this->dataPtr->service + "|" +
+        this->dataPtr->snapshotService + "|" + this->dataPtr->poseTopic +
+        "|" + this->dataPtr->deletionTopic + "|" + this->dataPtr->sceneTopic;
+
+    auto &shared = sharedScenes();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    auto existing = shared.scenes[key].lock();
+    if (existing)
+    {
+      gzmsg << "Sharing the scene of service [" << this->dataPtr->service
+            << "] with another TransportSceneManager, its other parameters "
+            << "are ignored" << std::endl;
+      this->dataPtr = existing;
+    }
+    else
+    {
+      this->dataPtr->sharedKey = key;
+      shared.scenes[key] = this->dataPtr;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->pluginsMutex);
+    auto &plugins = this->dataPtr->plugins;
+    if (std::find(plugins.begin(), plugins.end(), this) == plugins.end())
+      plugins.push_back(this);
+  }
+
+  if (this->dataPtr->assetLoader)
+    return;
+
+  this->dataPtr->assetLoader = std::make_unique<AssetLoader>(
+      this->dataPtr->loadThreads, this->dataPtr->meshCacheDir);
+
+  auto dataPtr = this->dataPtr.get();
+  this->dataPtr->onLoadProgress = [dataPtr](std::size_t _done,
+      std::size_t _total, std::size_t _placeholders)
+  {
+    double progress = _total == 0u ? 1.0 :
+        static_cast<double>(_done) / static_cast<double>(_total);
+    int placeholders = static_cast<int>(_placeholders);
+
+    // For the overlays of the 3D scenes, delivered on the GUI thread
+    if (App() && App()->MainWin())
+    {
+      QCoreApplication::postEvent(App()->MainWin(),
+          new events::SceneLoadProgress(progress,
+          static_cast<unsigned int>(_placeholders)));
+    }
+
+    // Plugins remove themselves before they're deleted, and calls queued
+    // to deleted plugins are dropped
+    std::lock_guard<std::mutex> lock(dataPtr->pluginsMutex);
+    for (auto plugin : dataPtr->plugins)
+    {
+      QMetaObject::invokeMethod(plugin, [plugin, progress, placeholders]
+      {
+        QQmlProperty::write(plugin->PluginItem(), "loadProgress", progress);
+        QQmlProperty::write(plugin->PluginItem(), "placeholders",
+            placeholders);
+      }, Qt::QueuedConnection);
+    }
+  };
+
+  if (!this->dataPtr->sharedKey.empty() && this->dataPtr->renderHookId == 0)
+  {
+    this->dataPtr->renderHookId = RenderHooks::Register(RenderPhase::kRender,
+        [dataPtr]{dataPtr->OnRender();}, 0, "TransportSceneManager");
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::InitializeTransport()
+{
+  // Queued before the request, so the live scene is loaded after it
+  this->LoadSceneCache();
+
+  if (this->hostCache && this->SubscribeHostCache())
+    return;
+
+  this->Request();
+
+  auto onPoses = [this](const char *_data, const size_t _size,
+      const transport::MessageInfo &)
+  {
+    this->OnPoseVMsg(_data, _size);
+  };
+  if (!this->node.SubscribeRaw(this->poseTopic, onPoses,
+      msgs::Pose_V().GetTypeName()))
+  {
+    gzerr << "Error subscribing to pose topic: " << this->poseTopic
+      << std::endl;
+  }
+  else
+  {
+    gzmsg << "Listening to pose messages on [" << this->poseTopic << "]"
+           << std::endl;
+  }
+
+  if (!this->node.Subscribe(this->deletionTopic,
+      &TransportSceneManagerPrivate::OnDeletionMsg, this))
+  {
+    gzerr << "Error subscribing to deletion topic: " << this->deletionTopic
+      << std::endl;
+  }
+  else
+  {
+    gzmsg << "Listening to deletion messages on [" << this->deletionTopic
+           << "]" << std::endl;
+  }
+
+  if (!this->node.Subscribe(this->sceneTopic,
+      &TransportSceneManagerPrivate::OnSceneMsg, this))
+  {
+    gzerr << "Error subscribing to scene topic: " << this->sceneTopic
+           << std::endl;
+  }
+  else
+  {
+    gzmsg << "Listening to scene messages on [" << this->sceneTopic << "]"
+           << std::endl;
+  }
+
+  gzmsg << "Transport initialized." << std::endl;
+}
+
+/////////////////////////////////////////////////
+bool TransportSceneManagerPrivate::SubscribeHostCache()
+{
+  // Each scene supersedes the previous one, so only the latest is read
+  auto onScene = [this](const SharedMemoryView &_view)
+  {
+    GZ_GUI_PROFILE_THREAD_NAME("Transport");
+    GZ_GUI_PROFILE("TransportSceneManager::OnHostScene");
+    msgs::Scene msg;
+    if (_view.Parse(msg))
+      this->QueueScene(msg, true, false, true, true);
+  };
+
+  // Copied before parsing, since the cache may overwrite the slot
+  auto onPoses = [this](const SharedMemoryView &_view)
+  {
+    std::string data(_view.Data(), _view.Size());
+    if (_view.Valid())
+      this->OnPoseVMsg(data.data(), data.size());
+  };
+
+  if (!this->hostScene.Subscribe(this->service + "/host_cache", onScene) ||
+      !this->hostPoses.Subscribe(this->poseTopic + "/host_cache", onPoses))
+  {
+    this->hostScene.Unsubscribe();
+    gzwarn << "No host scene cache for [" << this->service << "], "
+           << "subscribing to the scene topics instead" << std::endl;
+    return false;
+  }
+
+  gzmsg << "Reading the scene of [" << this->service << "] from the host "
+        << "scene cache" << std::endl;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::Request()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->revisionMutex);
+    this->resyncing = true;
+  }
+
+  if (this->snapshotService.empty())
+  {
+    this->RequestScene();
+  }
+  else
+  {
+    this->snapshotStart = std::chrono::steady_clock::now();
+    this->RequestSnapshotChunk(0u, 0u);
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::RequestScene()
+{
+  // Sent once the service is discovered, so there's no need to wait for
+  // the server
+  std::function<void(const msgs::Scene &, ServiceRequest::Result)> cb =
+      [this](const msgs::Scene &_msg, ServiceRequest::Result _result)
+  {
+    if (_result == ServiceRequest::Result::kTimedOut)
+    {
+      gzerr << "Timed out waiting for service [" << this->service << "]"
+            << std::endl;
+    }
+    this->OnSceneSrvMsg(_msg, _result == ServiceRequest::Result::kReplied);
+  };
+  auto request = ServiceRequest::Send(ServiceRequest::Thread::kAny,
+      this->node, this->service, msgs::Empty(), kSceneRequestTimeout, cb);
+
+  // Not locked while sending, as failures are handled right away
+  std::lock_guard<std::mutex> lock(this->revisionMutex);
+  this->sceneRequest = request;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::RequestSnapshotChunk(uint32_t _snapshot,
+    uint32_t _chunk)
+{
+  msgs::UInt32_V req;
+  req.add_data(_snapshot);
+  req.add_data(_chunk);
+
+  // One chunk at a time, so they're shown in order
+  std::function<void(const msgs::Bytes &, ServiceRequest::Result)> cb =
+      [this](const msgs::Bytes &_msg, ServiceRequest::Result _result)
+  {
+    this->OnSnapshotChunk(_msg, _result == ServiceRequest::Result::kReplied);
+  };
+  auto request = ServiceRequest::Send(ServiceRequest::Thread::kAny,
+      this->node, this->snapshotService, req, kSceneRequestTimeout, cb);
+
+  std::lock_guard<std::mutex> lock(this->revisionMutex);
+  this->sceneRequest = request;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::OnSnapshotChunk(const msgs::Bytes &_msg,
+    bool _result)
+{
+  GZ_GUI_PROFILE_THREAD_NAME("Transport");
+  GZ_GUI_PROFILE("TransportSceneManager::OnSnapshotChunk");
+
+  SceneSnapshotChunk chunk;
+  bool valid = _result && ReadSceneSnapshotChunk(_msg, chunk);
+  uint32_t expected = chunk.index == 0u ? 0u : this->snapshot.index + 1u;
+  if (valid && chunk.index != 0u && (chunk.snapshot !=
+      this->snapshot.snapshot || chunk.count != this->snapshot.count))
+  {
+    gzerr << "Scene snapshot [" << chunk.snapshot << "] doesn't match ["
+          << this->snapshot.snapshot << "]" << std::endl;
+    valid = false;
+  }
+  if (!valid || chunk.index != expected)
+  {
+    gzwarn << "Failed to get the scene snapshot from ["
+           << this->snapshotService << "], requesting the whole scene from ["
+           << this->service << "]" << std::endl;
+    this->snapshot = SceneSnapshotChunk();
+    this->RequestScene();
+    return;
+  }
+
+  if (chunk.index == 0u)
+  {
+    gzmsg << "Receiving scene snapshot [" << chunk.snapshot << "] in ["
+          << chunk.count << "] chunks" << std::endl;
+    this->snapshot.snapshot = chunk.snapshot;
+    this->snapshot.count = chunk.count;
+    this->snapshot.scene.Clear();
+  }
+  this->snapshot.index = chunk.index;
+
+  // Shown right away as it only adds entities, the whole scene then
+  // removes the entities which aren't part of it
+  this->snapshot.scene.MergeFrom(chunk.scene);
+  chunk.scene.clear_header();
+  this->QueueScene(chunk.scene, false);
+
+  if (chunk.index + 1u < chunk.count)
+  {
+    this->RequestSnapshotChunk(chunk.snapshot, chunk.index + 1u);
+    return;
+  }
+
+  gzmsg << "Received scene snapshot [" << chunk.snapshot << "] in "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(
+           std::chrono::steady_clock::now() - this->snapshotStart).count()
+        << " ms" << std::endl;
+  auto scene = std::move(this->snapshot.scene);
+  this->snapshot = SceneSnapshotChunk();
+  this->OnSceneSrvMsg(scene, true);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::Resync()
+{
+  // Called with revisionMutex locked
+  if (this->resyncing)
+    return;
+  this->resyncing = true;
+  this->resyncRequested = true;
+
+  // Sent from a worker, as the request may fail right away, which takes
+  // the lock
+  WorkerPool::Post([this]
+  {
+    this->Request();
+  }, this, WorkerPool::Priority::kHigh);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::OnPoseVMsg(const char *_data,
+    std::size_t _size)
+{
+  GZ_GUI_PROFILE_THREAD_NAME("Transport");
+  GZ_GUI_PROFILE("TransportSceneManager::OnPoseVMsg");
+  if (this->conflatePoses)
+  {
+    if (!this->poseBuffer.Write(_data, _size))
+    {
+      gzerr << "Failed to parse pose message on [" << this->poseTopic << "]"
+            << std::endl;
+      return;
+    }
+    this->NotifyDataArrived();
+    return;
+  }
+
+  // Parsed before locking, so the render thread isn't kept waiting
+  auto msg = this->posePool.Parse(_data, _size);
+  if (!msg)
+  {
+    gzerr << "Failed to parse pose message on [" << this->poseTopic << "]"
+          << std::endl;
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->poseMutex);
+    this->poseMsgs.push_back(std::move(msg));
+  }
+  this->NotifyDataArrived();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::UpdatePoses(const msgs::Pose_V &_msg)
+{
+  GZ_GUI_PROFILE("TransportSceneManager::UpdatePoses");
+
+  // Messages are timed with their stamp, or when they're applied
+  double time{0.0};
+  bool interpolate = this->interpolationDelay > 0.0;
+  if (interpolate)
+  {
+    auto now = std::chrono::steady_clock::now();
+    if (_msg.has_header() && _msg.header().has_stamp())
+    {
+      time = _msg.header().stamp().sec() +
+          _msg.header().stamp().nsec() * 1e-9;
+    }
+    else
+    {
+      time = std::chrono::duration<double>(now - this->poseEpoch).count();
+    }
+    this->playback.Receive(time, now);
+  }
+
+  // The poses are decoded and composed with the local poses in batch,
+  // then applied to the entities
+  auto &batch = this->poseBatch;
+  batch.Decode(_msg);
+  const std::size_t count = batch.Size();
+  this->poseEntities.assign(count, nullptr);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto entity = this->entities.Find(batch.ids[i]);
+    if (nullptr == entity)
+    {
+      // Keep it until the entity is loaded, without its local pose
+      auto it = this->pendingPoses.find(batch.ids[i]);
+      if (it != this->pendingPoses.end())
+      {
+        it->second = {batch.Pose(i), this->frameCount};
+      }
+      else if (this->pendingPoses.size() < kMaxPendingPoses)
+      {
+        this->pendingPoses.emplace(batch.ids[i],
+            PendingPose{batch.Pose(i), this->frameCount});
+      }
+      continue;
+    }
+
+    if (entity->isStatic && entity->poseApplied)
+      continue;
+
+    this->poseEntities[i] = entity;
+    batch.SetLocal(i, entity->localPose);
+  }
+
+  // apply additional local poses
+  batch.Compose();
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto entity = this->poseEntities[i];
+    if (nullptr == entity)
+      continue;
+
+    entity->pose = batch.Pose(i);
+
+    if (interpolate)
+    {
+      if (AddPoseSample(*entity, time) && !entity->interpolating)
+      {
+        entity->interpolating = true;
+        ++this->interpolatingCount;
+      }
+      continue;
+    }
+
+    // Most entities in large worlds don't move, don't touch their nodes
+    if (!entity->poseDirty && entity->poseApplied &&
+        entity->pose == entity->appliedPose)
+    {
+      continue;
+    }
+
+    if (!entity->poseDirty)
+    {
+      entity->poseDirty = true;
+      ++this->dirtyPoseCount;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::OnDeletionMsg(const msgs::UInt32_V &_msg)
+{
+  GZ_GUI_PROFILE_THREAD_NAME("Transport");
+  GZ_GUI_PROFILE("TransportSceneManager::OnDeletionMsg");
+  {
+    std::lock_guard<std::mutex> lock(this->msgMutex);
+    std::copy(_msg.data().begin(), _msg.data().end(),
+              std::back_inserter(this->toDeleteEntities));
+    this->deletionQueue.Update(this->toDeleteEntities.size(),
+        this->toDeleteEntities.size() * sizeof(unsigned int));
+  }
+  this->NotifyDataArrived();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::NotifyDataArrived()
+{
+  if (this->dataArrived.exchange(true))
+    return;
+
+  // Delivered on the GUI thread, which wakes up idle scenes
+  if (App() && App()->MainWin())
+    QCoreApplication::postEvent(App()->MainWin(), new events::SceneChanged());
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::OnRender()
+{
+  GZ_GUI_PROFILE("TransportSceneManager::OnRender");
+  if (nullptr == this->scene)
+  {
+    this->scene = rendering::sceneFromFirstRenderEngine();
+    if (nullptr == this->scene)
+      return;
+
+    this->worker = std::thread(&TransportSceneManagerPrivate::LoadWorker,
+        this);
+    WorkerPool::Post([this] {this->InitializeTransport();}, this);
+  }
+
+  if (!RenderHooks::RunsFor(this->scene->Name()))
+    return;
+
+  // Data arriving from now on posts again
+  this->dataArrived = false;
+
+  // Only hold the lock long enough to take the pending messages, so the
+  // transport callbacks don't wait on scene loading
+  std::vector<SceneUpdate> newSceneMsgs;
+  std::vector<unsigned int> newDeletions;
+  std::vector<std::string> newDecodedMeshes;
+  {
+    std::lock_guard<std::mutex> lock(this->msgMutex);
+    newSceneMsgs.swap(this->sceneMsgs);
+    newDeletions.swap(this->toDeleteEntities);
+    newDecodedMeshes.swap(this->decodedMeshes);
+    this->sceneBytes = 0u;
+    this->sceneQueue.Update(0u, 0u);
+    this->deletionQueue.Update(0u, 0u);
+  }
+  this->scenesInFlight -= newSceneMsgs.size();
+  this->frameTime = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - this->poseEpoch).count();
+
+  bool changed = !newDeletions.empty();
+
+  for (const auto &msg : newSceneMsgs)
+  {
+    this->LoadScene(msg);
+  }
+
+  // After the scenes, since meshes are decoded after their scene is handed
+  // over, and before the jobs, so visuals loaded next get their mesh
+  changed = this->ReplacePlaceholders(newDecodedMeshes) || changed;
+  changed = this->ProcessLoadJobs() || changed;
+
+  for (const auto &entity : newDeletions)
+  {
+    if (nullptr != this->entities.Find(entity))
+      this->DeleteEntity(entity);
+    else if (!this->loadJobs.empty() || this->scenesInFlight > 0u)
+      this->deletedBeforeLoad.insert(entity);
+    this->pendingPoses.erase(entity);
+  }
+  changed = this->DestroyVisuals() || changed;
+  changed = this->UpdateLod() || changed;
+
+  ++this->frameCount;
+
+  // Read the poses after loading the scene, so entities added in the same
+  // frame get their pose. Poses of entities which aren't loaded yet are kept
+  // until they are.
+  if (this->conflatePoses)
+  {
+    if (auto poseMsg = this->poseBuffer.Read())
+    {
+      changed = true;
+      this->UpdatePoses(*poseMsg);
+    }
+  }
+  else
+  {
+    std::vector<std::shared_ptr<msgs::Pose_V>> newPoseMsgs;
+    {
+      std::lock_guard<std::mutex> lock(this->poseMutex);
+      newPoseMsgs.swap(this->poseMsgs);
+    }
+    changed = changed || !newPoseMsgs.empty();
+
+    // Later messages overwrite earlier ones, only the last pose of each
+    // entity is applied to its node. The messages go back to the pool
+    // once applied.
+    for (const auto &msg : newPoseMsgs)
+      this->UpdatePoses(*msg);
+  }
+
+  this->EvictPendingPoses();
+
+  if (this->dirtyPoseCount > 0u)
+    this->ApplyPoses();
+
+  if (this->interpolatingCount > 0u)
+  {
+    changed = true;
+    this->InterpolatePoses();
+  }
+
+  if (this->staticBatching)
+    changed = this->UpdateStaticBatches() || changed;
+
+  // At most once per frame, so browsing plugins get the changes in batches
+  this->PublishSceneEntities();
+
+  // Let scenes which skip unchanged frames know they need to render
+  if (changed)
+  {
+    events::SceneChanged sceneChangedEvent;
+    App()->sendEvent(App()->MainWin(), &sceneChangedEvent);
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::OnSceneMsg(const msgs::Scene &_msg)
+{
+  GZ_GUI_PROFILE_THREAD_NAME("Transport");
+  GZ_GUI_PROFILE("TransportSceneManager::OnSceneMsg");
+  uint64_t rev{0u};
+  if (!SceneRevision(_msg, rev))
+  {
+    this->QueueScene(_msg, false);
+    return;
+  }
+
+  // Scene update containing only changes since the previous revision
+  std::lock_guard<std::mutex> lock(this->revisionMutex);
+  if (this->resyncing)
+  {
+    this->deferredUpdates.push_back(_msg);
+    return;
+  }
+
+  if (this->hasRevision && rev <= this->revision)
+  {
+    gzdbg << "Ignoring old scene revision [" << rev << "]" << std::endl;
+    return;
+  }
+
+  if (this->hasRevision && rev != this->revision + 1)
+  {
+    gzwarn << "Missed scene updates between revisions [" << this->revision
+           << "] and [" << rev << "], requesting the whole scene"
+           << std::endl;
+    this->deferredUpdates.push_back(_msg);
+    this->Resync();
+    return;
+  }
+
+  this->hasRevision = true;
+  this->revision = rev;
+  this->QueueScene(_msg, false);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::OnSceneSrvMsg(const msgs::Scene &_msg,
+    const bool result)
+{
+  GZ_GUI_PROFILE_THREAD_NAME("Transport");
+  GZ_GUI_PROFILE("TransportSceneManager::OnSceneSrvMsg");
+  if (!result)
+  {
+    gzerr << "Error making service request to " << this->service
+           << std::endl;
+
+    // Carry on with the updates received meanwhile
+    std::lock_guard<std::mutex> lock(this->revisionMutex);
+    this->resyncing = false;
+    this->resyncRequested = false;
+    for (const auto &msg : this->deferredUpdates)
+      this->QueueScene(msg, false);
+    this->deferredUpdates.clear();
+    return;
+  }
+
+  this->SaveSceneCache(_msg);
+
+  std::lock_guard<std::mutex> lock(this->revisionMutex);
+  this->resyncing = false;
+
+  uint64_t rev{0u};
+  bool hasRev = SceneRevision(_msg, rev);
+  if (hasRev)
+  {
+    this->hasRevision = true;
+    this->revision = rev;
+  }
+
+  // Publishers without revisions may answer with only part of the scene,
+  // so entities are only removed when resyncing, or when the revision says
+  // the scene is complete at that point
+  this->QueueScene(_msg, true, false, false,
+      this->resyncRequested || hasRev);
+  this->resyncRequested = false;
+
+  // Apply the updates received while waiting which are newer than the
+  // scene. Without a revision on the scene, apply all of them.
+  for (const auto &msg : this->deferredUpdates)
+  {
+    uint64_t msgRev{0u};
+    SceneRevision(msg, msgRev);
+    if (hasRev && msgRev <= rev)
+      continue;
+    if (this->hasRevision && msgRev != this->revision + 1)
+    {
+      gzwarn << "Missing scene updates between revisions [" << this->revision
+             << "] and [" << msgRev << "]" << std::endl;
+    }
+    this->hasRevision = true;
+    this->revision = msgRev;
+    this->QueueScene(msg, false);
+  }
+  this->deferredUpdates.clear();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::LoadSceneCache()
+{
+  if (this->sceneCachePath.empty() || !common::exists(this->sceneCachePath))
+    return;
+
+  std::ifstream file(this->sceneCachePath, std::ios::binary);
+  msgs::Scene msg;
+  if (!file.is_open() || !msg.ParseFromIstream(&file))
+  {
+    gzwarn << "Failed to read scene cache [" << this->sceneCachePath << "]"
+           << std::endl;
+    return;
+  }
+
+  gzmsg << "Showing cached scene [" << this->sceneCachePath
+        << "] until the scene service responds" << std::endl;
+  this->QueueScene(msg, true, true);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::SaveSceneCache(const msgs::Scene &_msg)
+{
+  if (this->sceneCachePath.empty())
+    return;
+
+  auto dir = common::parentPath(this->sceneCachePath);
+  if (!dir.empty() && !common::exists(dir))
+    common::createDirectories(dir);
+
+  // Written next to it and renamed, so a crash doesn't leave half a file
+  std::string tmpPath = this->sceneCachePath + ".tmp";
+  {
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open() || !_msg.SerializeToOstream(&file))
+    {
+      gzwarn << "Failed to write scene cache [" << this->sceneCachePath
+             << "]" << std::endl;
+      return;
+    }
+  }
+  if (std::rename(tmpPath.c_str(), this->sceneCachePath.c_str()) != 0)
+  {
+    gzwarn << "Failed to write scene cache [" << this->sceneCachePath
+           << "]" << std::endl;
+    std::remove(tmpPath.c_str());
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::QueueScene(const msgs::Scene &_msg,
+    bool _full, bool _cached, bool _hosted, bool _prune)
+{
+  // Entities removed by scene updates
+  if (auto removed = HeaderData(_msg, "removed"))
+  {
+    std::lock_guard<std::mutex> lock(this->msgMutex);
+    for (const auto &value : removed->value())
+    {
+      try
+      {
+        this->toDeleteEntities.push_back(
+            static_cast<unsigned int>(std::stoul(value)));
+      }
+      catch (...)
+      {
+        gzerr << "Invalid removed entity [" << value << "]" << std::endl;
+      }
+    }
+    this->deletionQueue.Update(this->toDeleteEntities.size(),
+        this->toDeleteEntities.size() * sizeof(unsigned int));
+  }
+
+  ++this->scenesInFlight;
+  {
+    std::lock_guard<std::mutex> lock(this->workerMutex);
+    this->workerMsgs.push_back({_msg, _full, _cached, _hosted, _prune});
+  }
+  this->workerCv.notify_one();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::LoadWorker()
+{
+  GZ_GUI_PROFILE_THREAD_NAME("Scene loader");
+  std::unique_lock<std::mutex> lock(this->workerMutex);
+  while (true)
+  {
+    this->workerCv.wait(lock, [this]
+    {
+      return this->stopWorker || !this->workerMsgs.empty();
+    });
+    if (this->stopWorker)
+      return;
+
+    SceneUpdate update = std::move(this->workerMsgs.front());
+    this->workerMsgs.pop_front();
+    lock.unlock();
+
+    // Read mesh files here, so that the render thread finds them in the
+    // mesh manager and only needs to create GPU resources
+    std::vector<std::string> filenames;
+    for (int i = 0; i < update.msg.model_size(); ++i)
+      this->CollectMeshes(update.msg.model(i), filenames);
+
+    auto handOver = [this](SceneUpdate &&_update)
+    {
+      auto bytes = _update.msg.ByteSizeLong();
+      {
+        std::lock_guard<std::mutex> msgLock(this->msgMutex);
+        this->sceneMsgs.push_back(std::move(_update));
+        this->sceneBytes += bytes;
+        this->sceneQueue.Update(this->sceneMsgs.size(), this->sceneBytes);
+      }
+      this->NotifyDataArrived();
+    };
+
+    // With progressive loading, the scene is shown with boxes for the
+    // meshes which aren't decoded yet, and they're replaced as the
+    // decoding finishes. Meshes are decoded one scene at a time, so the
+    // next scene only waits on meshes being decoded for it.
+    if (this->progressiveLoading && this->assetLoader)
+    {
+      auto meshManager = common::MeshManager::Instance();
+      std::unordered_set<std::string> unique;
+      for (const auto &filename : filenames)
+      {
+        if (!meshManager->HasMesh(filename) &&
+            unique.insert(filename).second)
+        {
+          update.decoding.push_back(filename);
+        }
+      }
+      auto decoding = update.decoding;
+      handOver(std::move(update));
+
+      if (!decoding.empty())
+      {
+        this->assetLoader->Load(decoding);
+        {
+          std::lock_guard<std::mutex> msgLock(this->msgMutex);
+          this->decodedMeshes.insert(this->decodedMeshes.end(),
+              decoding.begin(), decoding.end());
+        }
+        this->NotifyDataArrived();
+      }
+    }
+    else
+    {
+      if (this->assetLoader)
+        this->assetLoader->Load(filenames);
+      handOver(std::move(update));
+    }
+
+    lock.lock();
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::CollectMeshes(const msgs::Model &_msg,
+    std::vector<std::string> &_filenames)
+{
+  for (const auto &link : _msg.link())
+  {
+    for (const auto &visual : link.visual())
+    {
+      if (!visual.has_geometry() || !visual.geometry().has_mesh() ||
+          visual.geometry().mesh().filename().empty())
+      {
+        continue;
+      }
+      _filenames.push_back(visual.geometry().mesh().filename());
+    }
+  }
+
+  for (const auto &model : _msg.model())
+    this->CollectMeshes(model, _filenames);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::MarkStatic(Entity &_entity,
+    const rendering::VisualPtr &_visual)
+{
+  _entity.isStatic = this->loadingStatic;
+  if (this->loadingStatic)
+    RenderStats::SetStatic(_visual->Id(), true);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::StopWorker()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->workerMutex);
+    this->stopWorker = true;
+  }
+  this->workerCv.notify_all();
+  if (this->worker.joinable())
+    this->worker.join();
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::LoadScene(const SceneUpdate &_update)
+{
+  GZ_GUI_PROFILE("TransportSceneManager::LoadScene");
+  auto msg = std::make_shared<const msgs::Scene>(_update.msg);
+
+  // Entities whose replacement is still queued are replaced by the new
+  // scene too, even if they didn't change since the previous one
+  std::unordered_set<unsigned int> pendingReplace;
+  if (_update.full)
+  {
+    for (const auto &job : this->loadJobs)
+    {
+      if (job.replace)
+        pendingReplace.insert(job.id);
+    }
+
+    // The whole scene supersedes anything still queued
+    this->loadJobs.clear();
+
+    // Remove entities which aren't part of the scene anymore. Otherwise
+    // only the ones shown from the scene cache are removed.
+    std::unordered_set<unsigned int> ids;
+    for (const auto &model : msg->model())
+      CollectIds(model, ids);
+    for (const auto &light : msg->light())
+      ids.insert(light.id());
+
+    std::vector<unsigned int> stale;
+    for (const auto &entity : this->entities.Entities())
+    {
+      if (ids.find(entity.id) != ids.end())
+        continue;
+      if (_update.prune || (!_update.cached &&
+          this->cachedEntities.count(entity.id) > 0u))
+      {
+        stale.push_back(entity.id);
+      }
+    }
+    for (auto id : stale)
+      this->DeleteEntity(id);
+  }
+
+  this->decodingMeshes.insert(_update.decoding.begin(),
+      _update.decoding.end());
+
+  // Queued jobs for entities in this message are superseded by it. Jobs
+  // for the same entity are loaded in any order once they're sorted by the
+  // camera, so only the latest is kept.
+  if (!_update.full && !this->loadJobs.empty())
+  {
+    std::unordered_set<unsigned int> ids;
+    for (const auto &model : msg->model())
+      ids.insert(model.id());
+    for (const auto &light : msg->light())
+      ids.insert(light.id());
+
+    auto superseded = std::remove_if(this->loadJobs.begin(),
+        this->loadJobs.end(), [&](const LoadJob &_job)
+        {
+          if (ids.find(_job.id) == ids.end())
+            return false;
+          if (_job.replace)
+            pendingReplace.insert(_job.id);
+          return true;
+        });
+    this->loadJobsDone += static_cast<std::size_t>(
+        std::distance(superseded, this->loadJobs.end()));
+    this->loadJobs.erase(superseded, this->loadJobs.end());
+  }
+
+  if (this->loadJobs.empty())
+  {
+    this->loadJobsDone = 0u;
+    this->loadJobsTotal = 0u;
+  }
+
+  // Entities in scene updates with a revision replace existing ones, other
+  // messages only add entities which weren't loaded yet
+  uint64_t rev{0u};
+  bool replace = !_update.full && SceneRevision(*msg, rev);
+
+  if (_update.cached)
+  {
+    this->cachedEntities.clear();
+    for (const auto &model : msg->model())
+      this->cachedEntities[model.id()] = model.SerializeAsString();
+    for (const auto &light : msg->light())
+      this->cachedEntities[light.id()] = light.SerializeAsString();
+  }
+
+  // The live scene only reloads the cached entities which changed
+  auto changedSinceCache = [&](unsigned int _id, const std::string &_data)
+  {
+    auto it = this->cachedEntities.find(_id);
+    return it == this->cachedEntities.end() || it->second != _data;
+  };
+  bool reconcile = _update.full && !_update.cached &&
+      !this->cachedEntities.empty();
+
+  for (int i = 0; i < msg->model_size(); ++i)
+  {
+    const auto &model = msg->model(i);
+    bool replaceModel = replace || pendingReplace.count(model.id()) > 0u ||
+        (reconcile &&
+        changedSinceCache(model.id(), model.SerializeAsString()));
+    LoadJob job{msg, i, false, model.id(), replaceModel};
+    if (this->progressiveLoading)
+    {
+      math::AxisAlignedBox box;
+      ModelBounds(model, math::Pose3d::Zero, box);
+      if (box == math::AxisAlignedBox())
+      {
+        job.center = msgs::Convert(model.pose()).Pos();
+      }
+      else
+      {
+        job.center = box.Center();
+        job.radius = box.Size().Length() * 0.5;
+      }
+    }
+    this->loadJobs.push_back(std::move(job));
+  }
+  for (int i = 0; i < msg->light_size(); ++i)
+  {
+    const auto &light = msg->light(i);
+    bool replaceLight = replace || pendingReplace.count(light.id()) > 0u ||
+        (reconcile &&
+        changedSinceCache(light.id(), light.SerializeAsString()));
+    this->loadJobs.push_back({msg, i, true, light.id(), replaceLight});
+  }
+  this->loadOrderDirty = true;
+
+  // The next scene from the host cache is reconciled with this one
+  if (_update.hosted)
+  {
+    this->cachedEntities.clear();
+    for (const auto &model : msg->model())
+      this->cachedEntities[model.id()] = model.SerializeAsString();
+    for (const auto &light : msg->light())
+      this->cachedEntities[light.id()] = light.SerializeAsString();
+  }
+  else if (reconcile)
+  {
+    this->cachedEntities.clear();
+  }
+
+  this->loadJobsTotal +=
+      static_cast<std::size_t>(msg->model_size() + msg->light_size());
+}
+
+/////////////////////////////////////////////////
+bool TransportSceneManagerPrivate::ProcessLoadJobs()
+{
+  if (this->loadJobs.empty())
+    return false;
+
+  if (this->progressiveLoading)
+    this->OrderLoadJobs();
+
+  rendering::VisualPtr rootVis = this->scene->RootVisual();
+
+  // The budget is checked before each job, so at least one job is loaded
+  // per frame and models with more visuals than the budget still load
+  this->createdNodes = 0u;
+  while (!this->loadJobs.empty() &&
+      (this->loadBudget == 0u || this->createdNodes < this->loadBudget))
+  {
+    LoadJob job = std::move(this->loadJobs.front());
+    this->loadJobs.pop_front();
+    ++this->loadJobsDone;
+
+    if (this->deletedBeforeLoad.erase(job.id) > 0u)
+      continue;
+
+    // Only add if it's not already loaded, unless it was modified
+    if (nullptr != this->entities.Find(job.id))
+    {
+      if (!job.replace)
+        continue;
+      this->DeleteEntity(job.id, true);
+    }
+
+    if (job.light)
+    {
+      const auto &lightMsg = job.msg->light(job.index);
+      rendering::LightPtr light = this->LoadLight(lightMsg);
+      if (light)
+        rootVis->AddChild(light);
+      else
+        gzerr << "Failed to load light: " << lightMsg.name() << std::endl;
+    }
+    else
+    {
+      const auto &modelMsg = job.msg->model(job.index);
+      this->loadingRoot = job.id;
+      this->loadingStatic = this->staticModels && modelMsg.is_static();
+      this->loadingMsg = job.msg;
+      rendering::VisualPtr modelVis = this->LoadModel(modelMsg);
+      this->loadingRoot = 0u;
+      this->loadingStatic = false;
+      this->loadingMsg.reset();
+      if (modelVis)
+        rootVis->AddChild(modelVis);
+      else
+        gzerr << "Failed to load model: " << modelMsg.name() << std::endl;
+    }
+  }
+
+  // Children of loaded models which were deleted before being loaded
+  for (auto it = this->deletedBeforeLoad.begin();
+      it != this->deletedBeforeLoad.end();)
+  {
+    if (nullptr != this->entities.Find(*it))
+    {
+      this->DeleteEntity(*it);
+      it = this->deletedBeforeLoad.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  if (this->loadJobs.empty() && this->scenesInFlight == 0u)
+    this->deletedBeforeLoad.clear();
+
+  if (this->onLoadProgress)
+  {
+    this->onLoadProgress(this->loadJobsDone, this->loadJobsTotal,
+        this->placeholderCount);
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::OrderLoadJobs()
+{
+  if (!this->FindUserCamera())
+    return;
+
+  auto cameraPose = this->camera->WorldPose();
+  if (!this->loadOrderDirty &&
+      cameraPose.Pos().Distance(this->loadOrderPose.Pos()) <
+      kLoadOrderDistance &&
+      (cameraPose.Rot().Inverse() * this->loadOrderPose.Rot()).Euler()
+      .Length() < kLoadOrderAngle)
+  {
+    return;
+  }
+  this->loadOrderDirty = false;
+  this->loadOrderPose = cameraPose;
+
+  GZ_GUI_PROFILE("TransportSceneManager::OrderLoadJobs");
+  math::Frustum frustum(this->camera->NearClipPlane(),
+      this->camera->FarClipPlane(), this->camera->HFOV(),
+      this->camera->AspectRatio(), cameraPose);
+
+  // Lower keys load first
+  struct Key
+  {
+    int group;
+    double size;
+  };
+  std::vector<std::pair<Key, std::size_t>> keys;
+  keys.reserve(this->loadJobs.size());
+  for (std::size_t i = 0; i < this->loadJobs.size(); ++i)
+  {
+    const auto &job = this->loadJobs[i];
+    Key key{0, 0.0};
+    if (!job.light)
+    {
+      const math::Vector3d extent(job.radius + kViewMargin,
+          job.radius + kViewMargin, job.radius + kViewMargin);
+      key.group = frustum.Contains(math::AxisAlignedBox(
+          job.center - extent, job.center + extent)) ? 1 : 2;
+
+      // Apparent size, negated so the largest come first
+      double distance = std::max(
+          job.center.Distance(cameraPose.Pos()) - job.radius, 0.1);
+      key.size = -(job.radius + kViewMargin) / distance;
+    }
+    keys.push_back({key, i});
+  }
+
+  // Stable, so jobs of the same size keep the order they were received in
+  std::stable_sort(keys.begin(), keys.end(),
+      [](const auto &_a, const auto &_b)
+      {
+        if (_a.first.group != _b.first.group)
+          return _a.first.group < _b.first.group;
+        return _a.first.size < _b.first.size;
+      });
+
+  std::deque<LoadJob> ordered;
+  for (const auto &key : keys)
+    ordered.push_back(std::move(this->loadJobs[key.second]));
+  this->loadJobs.swap(ordered);
+}
+
+/////////////////////////////////////////////////
+bool TransportSceneManagerPrivate::ReplacePlaceholders(
+    const std::vector<std::string> &_meshes)
+{
+  if (_meshes.empty())
+    return false;
+
+  GZ_GUI_PROFILE("TransportSceneManager::ReplacePlaceholders");
+  bool replaced{false};
+  for (const auto &mesh : _meshes)
+  {
+    this->decodingMeshes.erase(mesh);
+
+    auto it = this->placeholders.find(mesh);
+    if (it == this->placeholders.end())
+      continue;
+    auto waiting = std::move(it->second);
+    this->placeholders.erase(it);
+    this->placeholderCount -= waiting.size();
+
+    for (const auto &placeholder : waiting)
+    {
+      auto entity = this->entities.Find(placeholder.id);
+      auto visual = placeholder.visual.lock();
+      if (nullptr == entity || nullptr == visual ||
+          entity->node.lock() != visual)
       {
-        visual->SetLocalPose(pIt->second);
+        continue;
       }
-      else
+
+      // The batch holds the box
+      auto root = this->entities.Find(entity->root);
+      if (root && root->batch != 0u)
+        this->SplitStaticBatch(root->batch);
+
+      // A visual only has one mesh, so there's nothing else to wait for
+      for (unsigned int i = 0; i < visual->GeometryCount(); ++i)
+        this->ReleaseMaterial(visual->GeometryByIndex(i)->Id());
+      visual->RemoveGeometries();
+      if (auto proxy = entity->proxy.lock())
+      {
+        this->DestroyVisual(proxy);
+        entity->proxy.reset();
+      }
+
+      // The visual keeps its latest pose, only the local pose of the
+      // geometry changes
+      auto oldLocalPose = entity->localPose;
+      math::Pose3d localPose;
+      bool decoding{false};
+      this->LoadVisualGeometry(*placeholder.visualMsg, visual, entity->root,
+          localPose, decoding);
+      entity->localPose = localPose;
+      auto pose = visual->LocalPose() * oldLocalPose.Inverse() * localPose;
+      visual->SetLocalPose(pose);
+      if (entity->poseApplied)
+      {
+        entity->pose = pose;
+        entity->appliedPose = pose;
+      }
+
+      if (root && root->lod == Lod::kBox)
+        this->ShowBox(*entity, true);
+      replaced = true;
+    }
+  }
+
+  if (this->onLoadProgress)
+  {
+    this->onLoadProgress(this->loadJobsDone, this->loadJobsTotal,
+        this->placeholderCount);
+  }
+
+  return replaced;
+}
+
+/////////////////////////////////////////////////
+rendering::VisualPtr TransportSceneManagerPrivate::LoadModel(
+    const msgs::Model &_msg)
+{
+  rendering::VisualPtr modelVis;
+  if (!_msg.name().empty() && !this->scene->HasVisualName(_msg.name()))
+  {
+    modelVis = this->scene->CreateVisual(_msg.name());
+  }
+  else
+  {
+    modelVis = this->scene->CreateVisual();
+  }
+
+  ++this->createdNodes;
+
+  if (_msg.has_pose())
+    modelVis->SetLocalPose(msgs::Convert(_msg.pose()));
+  auto &modelEntity = this->entities.Insert(_msg.id());
+  modelEntity.node = modelVis;
+  modelEntity.root = this->loadingRoot;
+  this->MarkStatic(modelEntity, modelVis);
+  this->ApplyPendingPose(_msg.id());
+  this->AddSceneEntity(_msg.id(), _msg.name(), SceneEntities::Type::kModel,
+      modelVis);
+  auto parent = this->loadingParent;
+  this->loadingParent = _msg.id();
+
+  // load links
+  for (int i = 0; i < _msg.link_size(); ++i)
+  {
+    rendering::VisualPtr linkVis = this->LoadLink(_msg.link(i));
+    if (linkVis)
+      modelVis->AddChild(linkVis);
+    else
+      gzerr << "Failed to load link: " << _msg.link(i).name() << std::endl;
+  }
+
+  // load nested models
+  for (int i = 0; i < _msg.model_size(); ++i)
+  {
+    rendering::VisualPtr nestedModelVis = this->LoadModel(_msg.model(i));
+    if (nestedModelVis)
+      modelVis->AddChild(nestedModelVis);
+    else
+      gzerr << "Failed to load nested model: " << _msg.model(i).name()
+             << std::endl;
+  }
+
+  this->loadingParent = parent;
+  return modelVis;
+}
+
+/////////////////////////////////////////////////
+rendering::VisualPtr TransportSceneManagerPrivate::LoadLink(
+    const msgs::Link &_msg)
+{
+  rendering::VisualPtr linkVis;
+  if (!_msg.name().empty() && !this->scene->HasVisualName(_msg.name()))
+  {
+    linkVis = this->scene->CreateVisual(_msg.name());
+  }
+  else
+  {
+    linkVis = this->scene->CreateVisual();
+  }
+
+  ++this->createdNodes;
+
+  if (_msg.has_pose())
+    linkVis->SetLocalPose(msgs::Convert(_msg.pose()));
+  auto &linkEntity = this->entities.Insert(_msg.id());
+  linkEntity.node = linkVis;
+  linkEntity.root = this->loadingRoot;
+  this->MarkStatic(linkEntity, linkVis);
+  this->ApplyPendingPose(_msg.id());
+  this->AddSceneEntity(_msg.id(), _msg.name(), SceneEntities::Type::kLink,
+      linkVis);
+  auto parent = this->loadingParent;
+  this->loadingParent = _msg.id();
+
+  // load visuals
+  for (int i = 0; i < _msg.visual_size(); ++i)
+  {
+    rendering::VisualPtr visualVis = this->LoadVisual(_msg.visual(i));
+    if (visualVis)
+      linkVis->AddChild(visualVis);
+    else
+      gzerr << "Failed to load visual: " << _msg.visual(i).name() << std::endl;
+  }
+
+  // load lights
+  for (int i = 0; i < _msg.light_size(); ++i)
+  {
+    rendering::LightPtr light = this->LoadLight(_msg.light(i));
+    if (light)
+      linkVis->AddChild(light);
+    else
+      gzerr << "Failed to load light: " << _msg.light(i).name() << std::endl;
+  }
+
+  this->loadingParent = parent;
+  return linkVis;
+}
+
+/////////////////////////////////////////////////
+rendering::VisualPtr TransportSceneManagerPrivate::LoadVisual(
+    const msgs::Visual &_msg)
+{
+  if (!_msg.has_geometry())
+    return rendering::VisualPtr();
+
+  rendering::VisualPtr visualVis;
+  if (!_msg.name().empty() && !this->scene->HasVisualName(_msg.name()))
+  {
+    visualVis = this->scene->CreateVisual(_msg.name());
+  }
+  else
+  {
+    visualVis = this->scene->CreateVisual();
+  }
+
+  ++this->createdNodes;
+  auto &visualEntity = this->entities.Insert(_msg.id());
+  visualEntity.node = visualVis;
+  visualEntity.root = this->loadingRoot;
+  this->MarkStatic(visualEntity, visualVis);
+  this->AddSceneEntity(_msg.id(), _msg.name(), SceneEntities::Type::kVisual,
+      visualVis);
+
+  math::Pose3d localPose;
+  bool placeholder{false};
+  bool loaded = this->LoadVisualGeometry(_msg, visualVis, this->loadingRoot,
+      localPose, placeholder);
+
+  if (_msg.has_pose())
+    visualVis->SetLocalPose(msgs::Convert(_msg.pose()) * localPose);
+  else
+    visualVis->SetLocalPose(localPose);
+
+  if (loaded)
+  {
+    // store the local pose
+    this->entities.Insert(_msg.id()).localPose = localPose;
+
+    if (placeholder && this->loadingMsg)
+    {
+      this->placeholders[_msg.geometry().mesh().filename()].push_back(
+          {_msg.id(), visualVis, this->loadingMsg, &_msg});
+      ++this->placeholderCount;
+    }
+  }
+  else
+  {
+    gzerr << "Failed to load geometry for visual: " << _msg.name()
+           << std::endl;
+  }
+
+  this->ApplyPendingPose(_msg.id());
+  return visualVis;
+}
+
+/////////////////////////////////////////////////
+bool TransportSceneManagerPrivate::LoadVisualGeometry(
+    const msgs::Visual &_msg, const rendering::VisualPtr &_visual,
+    unsigned int _root, math::Pose3d &_localPose, bool &_placeholder)
+{
+  math::Vector3d scale = math::Vector3d::One;
+  _localPose = math::Pose3d::Zero;
+  rendering::GeometryPtr geom =
+      this->LoadGeometry(_msg.geometry(), scale, _localPose, _placeholder);
+  if (!geom)
+    return false;
+
+  _visual->AddGeometry(geom);
+  _visual->SetLocalScale(scale);
+
+  // Null if the mesh was replaced by a box to stay within the GPU memory
+  // budget, or while it's decoded
+  auto mesh = _msg.geometry().has_mesh() ?
+      std::dynamic_pointer_cast<rendering::Mesh>(geom) : nullptr;
+
+  // Meshes can be replaced by boxes for the level of detail
+  if (nullptr != mesh && _root != 0u)
+  {
+    if (auto root = this->entities.Find(_root))
+      root->meshVisuals.push_back(_msg.id());
+  }
+
+  // set material
+  // Don't set a default material for meshes because they
+  // may have their own
+  // TODO(anyone) support overriding mesh material
+  if (_msg.has_material() || nullptr == mesh)
+  {
+    // Share the material instead of letting the geometry clone it
+    this->SetSharedMaterial(_msg, geom);
+  }
+  else
+  {
+    // meshes created by mesh loader may have their own materials
+    // update/override their properties based on input sdf element values
+    for (unsigned int i = 0; i < mesh->SubMeshCount(); ++i)
+    {
+      auto submesh = mesh->SubMeshByIndex(i);
+      auto submeshMat = submesh->Material();
+      if (submeshMat)
       {
-        this->visuals.erase(vIt);
+        double productAlpha = (1.0-_msg.transparency()) *
+            (1.0 - submeshMat->Transparency());
+        submeshMat->SetTransparency(1 - productAlpha);
+        submeshMat->SetCastShadows(_msg.cast_shadows());
       }
-      this->poses.erase(pIt++);
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+rendering::GeometryPtr TransportSceneManagerPrivate::LoadGeometry(
+    const msgs::Geometry &_msg, math::Vector3d &_scale,
+    math::Pose3d &_localPose, bool &_placeholder)
+{
+  _placeholder = false;
+  math::Vector3d scale = math::Vector3d::One;
+  math::Pose3d localPose = math::Pose3d::Zero;
+  rendering::GeometryPtr geom{nullptr};
+  if (_msg.has_box())
+  {
+    geom = this->scene->CreateBox();
+    if (_msg.box().has_size())
+      scale = msgs::Convert(_msg.box().size());
+  }
+  else if (_msg.has_cylinder())
+  {
+    geom = this->scene->CreateCylinder();
+    scale.X() = _msg.cylinder().radius() * 2;
+    scale.Y() = scale.X();
+    scale.Z() = _msg.cylinder().length();
+  }
+  else if (_msg.has_capsule())
+  {
+    auto capsule = this->scene->CreateCapsule();
+    capsule->SetRadius(_msg.capsule().radius());
+    capsule->SetLength(_msg.capsule().length());
+    geom = capsule;
+
+    scale.X() = _msg.capsule().radius() * 2;
+    scale.Y() = scale.X();
+    scale.Z() = _msg.capsule().length() + scale.X();
+  }
+  else if (_msg.has_ellipsoid())
+  {
+    geom = this->scene->CreateSphere();
+    scale.X() = _msg.ellipsoid().radii().x() * 2;
+    scale.Y() = _msg.ellipsoid().radii().y() * 2;
+    scale.Z() = _msg.ellipsoid().radii().z() * 2;
+  }
+  else if (_msg.has_plane())
+  {
+    geom = this->scene->CreatePlane();
+
+    if (_msg.plane().has_size())
+    {
+      scale.X() = _msg.plane().size().x();
+      scale.Y() = _msg.plane().size().y();
+    }
+
+    if (_msg.plane().has_normal())
+    {
+      // Create a rotation for the plane mesh to account for the normal vector.
+      // The rotation is the angle between the +z(0,0,1) vector and the
+      // normal, which are both expressed in the local (Visual) frame.
+      math::Vector3d normal = msgs::Convert(_msg.plane().normal());
+      localPose.Rot().SetFrom2Axes(math::Vector3d::UnitZ, normal.Normalized());
+    }
+  }
+  else if (_msg.has_sphere())
+  {
+    geom = this->scene->CreateSphere();
+    scale.X() = _msg.sphere().radius() * 2;
+    scale.Y() = scale.X();
+    scale.Z() = scale.X();
+  }
+  else if (_msg.has_mesh())
+  {
+    if (_msg.mesh().filename().empty())
+    {
+      gzerr << "Mesh geometry missing filename" << std::endl;
+      return geom;
+    }
+    rendering::MeshDescriptor descriptor;
+
+    // Assume absolute path to mesh file
+    descriptor.meshName = _msg.mesh().filename();
+    scale = msgs::Convert(_msg.mesh().scale());
+
+    // The mesh's size isn't known until it's decoded, so the box has the
+    // mesh's scale
+    if (this->decodingMeshes.count(descriptor.meshName) > 0u)
+    {
+      _placeholder = true;
+      _scale = scale;
+      _localPose = localPose;
+      return this->scene->CreateBox();
+    }
+
+    gz::common::MeshManager* meshManager =
+        gz::common::MeshManager::Instance();
+    descriptor.mesh = meshManager->Load(descriptor.meshName);
+
+    // The engine keeps meshes once loaded and shares them by name, so each
+    // is only recorded once and never released. Meshes which don't fit in
+    // the budget are shown as their bounding boxes.
+    if (nullptr != descriptor.mesh &&
+        !GpuMemory::Reserve("TransportSceneManager",
+        GpuMemory::Resource::kMeshes, descriptor.meshName,
+        descriptor.mesh->VertexCount() * kVertexBytes +
+        descriptor.mesh->IndexCount() * kIndexBytes))
+    {
+      gzwarn << "Mesh [" << descriptor.meshName << "] doesn't fit in the "
+             << "GPU memory budget, showing its bounding box instead."
+             << std::endl;
+      math::Vector3d min;
+      math::Vector3d max;
+      descriptor.mesh->AABB(min, max);
+      localPose.Pos() = (min + max) * 0.5 * scale;
+      scale *= max - min;
+      geom = this->scene->CreateBox();
     }
     else
     {
-      auto lIt = this->lights.find(pIt->first);
-      if (lIt != this->lights.end())
-      {
-        auto light = lIt->second.lock();
-        if (light)
-        {
-          light->SetLocalPose(pIt->second);
-        }
-        else
-        {
-          this->lights.erase(lIt);
-        }
-        this->poses.erase(pIt++);
-      }
-      else
-      {
-        ++pIt;
-      }
+      geom = this->scene->CreateMesh(descriptor);
     }
   }
+  else
+  {
+    gzerr << "Unsupported geometry type" << std::endl;
+  }
+  _scale = scale;
+  _localPose = localPose;
+  return geom;
+}
+
+/////////////////////////////////////////////////
+rendering::MaterialPtr TransportSceneManagerPrivate::LoadMaterial(
+    const msgs::Material &_msg)
+{
+  rendering::MaterialPtr material = this->scene->CreateMaterial();
+  if (_msg.has_ambient())
+  {
+    material->SetAmbient(msgs::Convert(_msg.ambient()));
+  }
+  if (_msg.has_diffuse())
+  {
+    material->SetDiffuse(msgs::Convert(_msg.diffuse()));
+  }
+  if (_msg.has_specular())
+  {
+    material->SetDiffuse(msgs::Convert(_msg.specular()));
+  }
+  if (_msg.has_emissive())
+  {
+    material->SetEmissive(msgs::Convert(_msg.emissive()));
+  }
 
-  // Note we are clearing the pose msgs here but later on we may need to
-  // consider the case where pose msgs arrive before scene/visual msgs
-  this->poses.clear();
+  return material;
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManagerPrivate::OnSceneMsg(const msgs::Scene &_msg)
+void TransportSceneManagerPrivate::SetSharedMaterial(
+    const msgs::Visual &_msg, const rendering::GeometryPtr &_geom)
 {
-  std::lock_guard<std::mutex> lock(this->msgMutex);
-  this->sceneMsgs.push_back(_msg);
+  std::string key;
+  if (_msg.has_material())
+    _msg.material().SerializeToString(&key);
+  key.push_back(_msg.has_material() ? 'm' : 'd');
+  double transparency = _msg.transparency();
+  key.append(reinterpret_cast<const char *>(&transparency),
+      sizeof(transparency));
+  key.push_back(_msg.cast_shadows() ? '1' : '0');
+
+  auto current = this->geometryMaterials.find(_geom->Id());
+  if (current != this->geometryMaterials.end() &&
+      current->second.key == key)
+    return;
+
+  auto &cached = this->materialCache[key];
+  if (nullptr == cached.material)
+    cached.material = this->LoadSharedMaterial(_msg);
+  ++cached.refs;
+
+  this->ReleaseMaterial(_geom->Id());
+  _geom->SetMaterial(cached.material, false);
+  this->geometryMaterials[_geom->Id()] = {key, _geom};
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManagerPrivate::OnSceneSrvMsg(const msgs::Scene &_msg,
-    const bool result)
+rendering::MaterialPtr TransportSceneManagerPrivate::LoadSharedMaterial(
+    const msgs::Visual &_msg)
 {
-  if (!result)
+  rendering::MaterialPtr material;
+  if (_msg.has_material())
   {
-    gzerr << "Error making service request to " << this->service
-           << std::endl;
+    material = this->LoadMaterial(_msg.material());
+  }
+  else
+  {
+    // create default material
+    auto grey = this->scene->Material("gz-grey");
+    if (!grey)
+    {
+      grey = this->scene->CreateMaterial("gz-grey");
+      grey->SetAmbient(0.3, 0.3, 0.3);
+      grey->SetDiffuse(0.7, 0.7, 0.7);
+      grey->SetSpecular(1.0, 1.0, 1.0);
+      grey->SetRoughness(0.2f);
+      grey->SetMetalness(1.0f);
+    }
+    material = grey->Clone();
+  }
+
+  // set transparency
+  material->SetTransparency(_msg.transparency());
+
+  // cast shadows
+  material->SetCastShadows(_msg.cast_shadows());
+
+  return material;
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::ReleaseMaterial(
+    unsigned int _geometryId)
+{
+  auto geomIt = this->geometryMaterials.find(_geometryId);
+  if (geomIt == this->geometryMaterials.end())
     return;
+
+  auto it = this->materialCache.find(geomIt->second.key);
+  this->geometryMaterials.erase(geomIt);
+  if (it == this->materialCache.end())
+    return;
+
+  if (--it->second.refs == 0)
+  {
+    this->scene->DestroyMaterial(it->second.material);
+    this->materialCache.erase(it);
   }
+}
 
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::ReleaseExpiredMaterials()
+{
+  std::vector<unsigned int> expired;
+  for (const auto &geometry : this->geometryMaterials)
   {
-    std::lock_guard<std::mutex> lock(this->msgMutex);
-    this->sceneMsgs.push_back(_msg);
+    if (geometry.second.geometry.expired())
+      expired.push_back(geometry.first);
   }
+  for (auto id : expired)
+    this->ReleaseMaterial(id);
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManagerPrivate::LoadScene(const msgs::Scene &_msg)
+void TransportSceneManagerPrivate::ReleaseMaterials(
+    const rendering::VisualPtr &_visual)
 {
-  rendering::VisualPtr rootVis = this->scene->RootVisual();
+  for (unsigned int i = 0; i < _visual->GeometryCount(); ++i)
+    this->ReleaseMaterial(_visual->GeometryByIndex(i)->Id());
 
-  // load models
-  for (int i = 0; i < _msg.model_size(); ++i)
+  for (unsigned int i = 0; i < _visual->ChildCount(); ++i)
   {
-    // Only add if it's not already loaded
-    if (this->visuals.find(_msg.model(i).id()) == this->visuals.end())
-    {
-      rendering::VisualPtr modelVis = this->LoadModel(_msg.model(i));
-      if (modelVis)
-        rootVis->AddChild(modelVis);
-      else
-        gzerr << "Failed to load model: " << _msg.model(i).name() << std::endl;
-    }
+    auto child = std::dynamic_pointer_cast<rendering::Visual>(
+        _visual->ChildByIndex(i));
+    if (child)
+      this->ReleaseMaterials(child);
   }
+}
 
-  // load lights
-  for (int i = 0; i < _msg.light_size(); ++i)
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::DestroyVisual(
+    const rendering::VisualPtr &_visual)
+{
+  this->ReleaseMaterials(_visual);
+  this->scene->DestroyVisual(_visual, true);
+}
+
+/////////////////////////////////////////////////
+rendering::LightPtr TransportSceneManagerPrivate::LoadLight(
+    const msgs::Light &_msg)
+{
+  rendering::LightPtr light;
+
+  switch (_msg.type())
   {
-    if (this->lights.find(_msg.light(i).id()) == this->lights.end())
+    case msgs::Light_LightType_POINT:
+      light = this->scene->CreatePointLight();
+      break;
+    case msgs::Light_LightType_SPOT:
     {
-      rendering::LightPtr light = this->LoadLight(_msg.light(i));
-      if (light)
-        rootVis->AddChild(light);
-      else
-        gzerr << "Failed to load light: " << _msg.light(i).name() << std::endl;
+      light = this->scene->CreateSpotLight();
+      rendering::SpotLightPtr spotLight =
+          std::dynamic_pointer_cast<rendering::SpotLight>(light);
+      spotLight->SetInnerAngle(_msg.spot_inner_angle());
+      spotLight->SetOuterAngle(_msg.spot_outer_angle());
+      spotLight->SetFalloff(_msg.spot_falloff());
+      break;
+    }
+    case msgs::Light_LightType_DIRECTIONAL:
+    {
+      light = this->scene->CreateDirectionalLight();
+      rendering::DirectionalLightPtr dirLight =
+          std::dynamic_pointer_cast<rendering::DirectionalLight>(light);
+
+      if (_msg.has_direction())
+        dirLight->SetDirection(msgs::Convert(_msg.direction()));
+      break;
     }
+    default:
+      gzerr << "Light type not supported" << std::endl;
+      return light;
   }
+
+  if (_msg.has_pose())
+    light->SetLocalPose(msgs::Convert(_msg.pose()));
+
+  if (_msg.has_diffuse())
+    light->SetDiffuseColor(msgs::Convert(_msg.diffuse()));
+
+  if (_msg.has_specular())
+    light->SetSpecularColor(msgs::Convert(_msg.specular()));
+
+  light->SetAttenuationConstant(_msg.attenuation_constant());
+  light->SetAttenuationLinear(_msg.attenuation_linear());
+  light->SetAttenuationQuadratic(_msg.attenuation_quadratic());
+  light->SetAttenuationRange(_msg.range());
+
+  light->SetCastShadows(_msg.cast_shadows());
+
+  ++this->createdNodes;
+  auto &entity = this->entities.Insert(_msg.id());
+  entity.type = EntityType::kLight;
+  entity.node = light;
+  this->ApplyPendingPose(_msg.id());
+  this->AddSceneEntity(_msg.id(), _msg.name(), SceneEntities::Type::kLight,
+      light);
+  return light;
 }
 
 /////////////////////////////////////////////////
-rendering::VisualPtr TransportSceneManagerPrivate::LoadModel(
-    const msgs::Model &_msg)
+bool TransportSceneManagerPrivate::DestroyVisuals()
 {
-  rendering::VisualPtr modelVis;
-  if (!_msg.name().empty() && !this->scene->HasVisualName(_msg.name()))
+  if (this->toDestroy.empty())
+    return false;
+
+  // Always destroy at least one visual, so the queue drains
+  auto start = std::chrono::steady_clock::now();
+  do
   {
-    modelVis = this->scene->CreateVisual(_msg.name());
+    auto visual = this->toDestroy.front().lock();
+    this->toDestroy.pop_front();
+    if (visual)
+      this->DestroyVisual(visual);
   }
-  else
+  while (!this->toDestroy.empty() &&
+      std::chrono::steady_clock::now() - start < this->destroyBudget);
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool TransportSceneManagerPrivate::UpdateLod()
+{
+  if (this->boxDistance <= 0.0 && this->cullDistance <= 0.0)
+    return false;
+
+  if (!this->FindUserCamera())
+    return false;
+
+  auto &all = this->entities.Entities();
+  if (all.empty())
+    return false;
+
+  // Only check a slice of the entities each frame, models far away don't
+  // need to switch right away
+  const auto cameraPos = this->camera->WorldPosition();
+  bool changed{false};
+  const std::size_t count = std::min(all.size(), kLodBatch);
+  for (std::size_t n = 0; n < count; ++n)
   {
-    modelVis = this->scene->CreateVisual();
+    if (this->lodCursor >= all.size())
+      this->lodCursor = 0u;
+    auto &entity = all[this->lodCursor++];
+
+    // Only top level models, batched models stay as they are
+    if (entity.root != entity.id || entity.type != EntityType::kVisual ||
+        entity.batch != 0u)
+    {
+      continue;
+    }
+
+    auto node = entity.node.lock();
+    if (!node)
+      continue;
+
+    double distance = node->WorldPosition().Distance(cameraPos);
+    Lod lod = Lod::kFull;
+    if (this->cullDistance > 0.0 && distance > this->cullDistance)
+      lod = Lod::kCulled;
+    else if (this->boxDistance > 0.0 && distance > this->boxDistance)
+      lod = Lod::kBox;
+
+    if (lod != entity.lod)
+    {
+      this->SetLod(entity, lod);
+      changed = true;
+    }
   }
+  return changed;
+}
 
-  if (_msg.has_pose())
-    modelVis->SetLocalPose(msgs::Convert(_msg.pose()));
-  this->visuals[_msg.id()] = modelVis;
+/////////////////////////////////////////////////
+bool TransportSceneManagerPrivate::FindUserCamera()
+{
+  if (this->camera)
+    return true;
 
-  // load links
-  for (int i = 0; i < _msg.link_size(); ++i)
+  for (unsigned int i = 0; i < this->scene->NodeCount(); ++i)
   {
-    rendering::VisualPtr linkVis = this->LoadLink(_msg.link(i));
-    if (linkVis)
-      modelVis->AddChild(linkVis);
-    else
-      gzerr << "Failed to load link: " << _msg.link(i).name() << std::endl;
+    auto cam = std::dynamic_pointer_cast<rendering::Camera>(
+      this->scene->NodeByIndex(i));
+    if (!cam)
+      continue;
+
+    bool isUserCamera = false;
+    try
+    {
+      isUserCamera = std::get<bool>(cam->UserData("user-camera"));
+    }
+    catch (std::bad_variant_access &)
+    {
+      continue;
+    }
+    if (isUserCamera)
+    {
+      this->camera = cam;
+      return true;
+    }
   }
+  return false;
+}
 
-  // load nested models
-  for (int i = 0; i < _msg.model_size(); ++i)
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::ApplyPoses()
+{
+  GZ_GUI_PROFILE("TransportSceneManager::ApplyPoses");
+  bool budgeted = this->poseBudget.count() > 0.0 && this->FindUserCamera();
+  if (budgeted)
+    this->UpdatePosePriorities();
+
+  auto &all = this->entities.Entities();
+  std::vector<unsigned int> expired;
+  std::size_t pending{0u};
+  auto apply = [&](Entity &_entity)
   {
-    rendering::VisualPtr nestedModelVis = this->LoadModel(_msg.model(i));
-    if (nestedModelVis)
-      modelVis->AddChild(nestedModelVis);
+    if (this->SkipPose(_entity))
+    {
+      ++pending;
+      return;
+    }
+    _entity.poseDirty = false;
+
+    auto node = _entity.node.lock();
+    if (node)
+    {
+      node->SetLocalPose(_entity.pose);
+      _entity.appliedPose = _entity.pose;
+      _entity.poseApplied = true;
+      this->MarkMoved(_entity);
+    }
     else
-      gzerr << "Failed to load nested model: " << _msg.model(i).name()
-             << std::endl;
+    {
+      expired.push_back(_entity.id);
+    }
+  };
+
+  auto priority = [this](const Entity &_entity)
+  {
+    if (_entity.root == 0u)
+      return PosePriority::kInView;
+    auto root = _entity.root == _entity.id ? &_entity :
+        this->entities.Find(_entity.root);
+    return root ? root->posePriority : PosePriority::kInView;
+  };
+
+  if (!budgeted)
+  {
+    for (auto &entity : all)
+    {
+      if (entity.poseDirty)
+        apply(entity);
+    }
   }
+  else
+  {
+    // Models in view are always up to date
+    std::size_t deferred{0u};
+    for (auto &entity : all)
+    {
+      if (!entity.poseDirty)
+        continue;
+      if (priority(entity) == PosePriority::kInView)
+        apply(entity);
+      else
+        ++deferred;
+    }
 
-  return modelVis;
+    // Then near models and the rest, each starting where the last frame
+    // left off, while the budget lasts
+    auto start = std::chrono::steady_clock::now();
+    bool exhausted{false};
+    for (auto level : {PosePriority::kNear, PosePriority::kFar})
+    {
+      if (this->poseCursor >= all.size())
+        this->poseCursor = 0u;
+      std::size_t applied{0u};
+      for (std::size_t n = 0; n < all.size() && deferred > 0u && !exhausted;
+          ++n)
+      {
+        auto index = (this->poseCursor + n) % all.size();
+        auto &entity = all[index];
+        if (!entity.poseDirty || priority(entity) != level)
+          continue;
+
+        apply(entity);
+        --deferred;
+        if (++applied % kPoseBudgetStride == 0u &&
+            std::chrono::steady_clock::now() - start > this->poseBudget)
+        {
+          exhausted = true;
+          this->poseCursor = index + 1u;
+        }
+      }
+      if (exhausted)
+        break;
+    }
+    pending += deferred;
+  }
+  this->dirtyPoseCount = pending;
+
+  // Nodes destroyed by someone else
+  for (auto id : expired)
+  {
+    this->entities.Erase(id);
+    this->RemoveSceneEntity(id);
+  }
+  if (!expired.empty())
+    this->ReleaseExpiredMaterials();
 }
 
 /////////////////////////////////////////////////
-rendering::VisualPtr TransportSceneManagerPrivate::LoadLink(
-    const msgs::Link &_msg)
+void TransportSceneManagerPrivate::UpdatePosePriorities()
 {
-  rendering::VisualPtr linkVis;
-  if (!_msg.name().empty() && !this->scene->HasVisualName(_msg.name()))
+  math::Frustum frustum(this->camera->NearClipPlane(),
+      this->camera->FarClipPlane(), this->camera->HFOV(),
+      this->camera->AspectRatio(), this->camera->WorldPose());
+  const auto cameraPos = this->camera->WorldPosition();
+  const math::Vector3d margin(kViewMargin, kViewMargin, kViewMargin);
+
+  for (auto &entity : this->entities.Entities())
   {
-    linkVis = this->scene->CreateVisual(_msg.name());
+    if (entity.root != entity.id)
+      continue;
+
+    auto node = entity.node.lock();
+    if (!node)
+      continue;
+
+    auto pos = node->WorldPosition();
+    if (frustum.Contains(math::AxisAlignedBox(pos - margin, pos + margin)))
+      entity.posePriority = PosePriority::kInView;
+    else if (pos.Distance(cameraPos) < kNearPoseDistance)
+      entity.posePriority = PosePriority::kNear;
+    else
+      entity.posePriority = PosePriority::kFar;
   }
-  else
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::SetLod(Entity &_root, Lod _lod)
+{
+  auto visual = std::dynamic_pointer_cast<rendering::Visual>(
+      _root.node.lock());
+  if (!visual)
+    return;
+
+  Lod previous = _root.lod;
+  _root.lod = _lod;
+
+  if (_lod == Lod::kCulled)
   {
-    linkVis = this->scene->CreateVisual();
+    visual->SetVisible(false);
+    return;
   }
 
-  if (_msg.has_pose())
-    linkVis->SetLocalPose(msgs::Convert(_msg.pose()));
-  this->visuals[_msg.id()] = linkVis;
+  // Showing a visual shows all its descendants, including hidden meshes and
+  // boxes
+  if (previous == Lod::kCulled)
+    visual->SetVisible(true);
 
-  // load visuals
-  for (int i = 0; i < _msg.visual_size(); ++i)
+  for (auto id : _root.meshVisuals)
   {
-    rendering::VisualPtr visualVis = this->LoadVisual(_msg.visual(i));
-    if (visualVis)
-      linkVis->AddChild(visualVis);
-    else
-      gzerr << "Failed to load visual: " << _msg.visual(i).name() << std::endl;
+    if (auto meshVisual = this->entities.Find(id))
+      this->ShowBox(*meshVisual, _lod == Lod::kBox);
   }
+}
 
-  // load lights
-  for (int i = 0; i < _msg.light_size(); ++i)
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::ShowBox(Entity &_visual, bool _box)
+{
+  auto visual = std::dynamic_pointer_cast<rendering::Visual>(
+      _visual.node.lock());
+  if (!visual)
+    return;
+
+  auto proxy = _visual.proxy.lock();
+  if (_box && !proxy)
   {
-    rendering::LightPtr light = this->LoadLight(_msg.light(i));
-    if (light)
-      linkVis->AddChild(light);
-    else
-      gzerr << "Failed to load light: " << _msg.light(i).name() << std::endl;
+    auto parent = std::dynamic_pointer_cast<rendering::Visual>(
+        visual->Parent());
+    if (!parent)
+      return;
+
+    // The box is a sibling of the mesh visual, so that hiding the mesh
+    // doesn't hide it
+    auto box = visual->LocalBoundingBox();
+    proxy = this->scene->CreateVisual();
+    auto geom = this->scene->CreateBox();
+    this->SetSharedMaterial(msgs::Visual(), geom);
+    proxy->AddGeometry(geom);
+    proxy->SetLocalScale(box.Size());
+    proxy->SetLocalPose(visual->LocalPose() *
+        math::Pose3d(box.Center(), math::Quaterniond::Identity));
+    parent->AddChild(proxy);
+    _visual.proxy = proxy;
   }
 
-  return linkVis;
+  visual->SetVisible(!_box);
+  if (proxy)
+    proxy->SetVisible(_box);
 }
 
 /////////////////////////////////////////////////
-rendering::VisualPtr TransportSceneManagerPrivate::LoadVisual(
-    const msgs::Visual &_msg)
+void TransportSceneManagerPrivate::ApplyPendingPose(unsigned int _id)
 {
-  if (!_msg.has_geometry())
-    return rendering::VisualPtr();
+  if (this->pendingPoses.empty())
+    return;
 
-  rendering::VisualPtr visualVis;
-  if (!_msg.name().empty() && !this->scene->HasVisualName(_msg.name()))
+  auto it = this->pendingPoses.find(_id);
+  if (it == this->pendingPoses.end())
+    return;
+
+  auto entity = this->entities.Find(_id);
+  auto node = entity ? entity->node.lock() : nullptr;
+  if (node)
   {
-    visualVis = this->scene->CreateVisual(_msg.name());
+    entity->pose = it->second.pose * entity->localPose;
+    entity->appliedPose = entity->pose;
+    entity->poseApplied = true;
+    node->SetLocalPose(entity->pose);
   }
-  else
+  this->pendingPoses.erase(it);
+}
+
+/////////////////////////////////////////////////
+bool TransportSceneManagerPrivate::SkipPose(const Entity &_entity)
+{
+  // The model's own pose is always applied, as it's used to tell when it's
+  // visible
+  if (!this->skipCulledPoses || _entity.root == 0u ||
+      _entity.root == _entity.id)
   {
-    visualVis = this->scene->CreateVisual();
+    return false;
   }
 
-  this->visuals[_msg.id()] = visualVis;
-
-  math::Vector3d scale = math::Vector3d::One;
-  math::Pose3d localPose;
-  rendering::GeometryPtr geom =
-      this->LoadGeometry(_msg.geometry(), scale, localPose);
+  auto root = this->entities.Find(_entity.root);
+  return root && root->lod == Lod::kCulled;
+}
 
-  if (_msg.has_pose())
-    visualVis->SetLocalPose(msgs::Convert(_msg.pose()) * localPose);
-  else
-    visualVis->SetLocalPose(localPose);
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::InterpolatePoses()
+{
+  GZ_GUI_PROFILE("TransportSceneManager::InterpolatePoses");
+  double time = this->playback.Now(std::chrono::steady_clock::now(),
+      this->interpolationDelay);
 
-  if (geom)
+  // A single sweep of the table, most entities aren't moving
+  std::vector<unsigned int> expired;
+  std::size_t interpolating{0u};
+  for (auto &entity : this->entities.Entities())
   {
-    // store the local pose
-    this->localPoses[_msg.id()] = localPose;
-
-    visualVis->AddGeometry(geom);
-    visualVis->SetLocalScale(scale);
+    if (!entity.interpolating)
+      continue;
 
-    // set material
-    rendering::MaterialPtr material{nullptr};
-    if (_msg.has_material())
+    if (entity.historySize == 0u || this->SkipPose(entity))
     {
-      material = this->LoadMaterial(_msg.material());
-    }
-    // Don't set a default material for meshes because they
-    // may have their own
-    // TODO(anyone) support overriding mesh material
-    else if (!_msg.geometry().has_mesh())
-    {
-      // create default material
-      material = this->scene->Material("gz-grey");
-      if (!material)
-      {
-        material = this->scene->CreateMaterial("gz-grey");
-        material->SetAmbient(0.3, 0.3, 0.3);
-        material->SetDiffuse(0.7, 0.7, 0.7);
-        material->SetSpecular(1.0, 1.0, 1.0);
-        material->SetRoughness(0.2f);
-        material->SetMetalness(1.0f);
-      }
+      ++interpolating;
+      continue;
     }
-    else
+
+    bool done{false};
+    auto pose = InterpolatedPose(entity, time, done);
+    auto node = entity.node.lock();
+    if (!node)
     {
-      // meshes created by mesh loader may have their own materials
-      // update/override their properties based on input sdf element values
-      auto mesh = std::dynamic_pointer_cast<rendering::Mesh>(geom);
-      for (unsigned int i = 0; i < mesh->SubMeshCount(); ++i)
-      {
-        auto submesh = mesh->SubMeshByIndex(i);
-        auto submeshMat = submesh->Material();
-        if (submeshMat)
-        {
-          double productAlpha = (1.0-_msg.transparency()) *
-              (1.0 - submeshMat->Transparency());
-          submeshMat->SetTransparency(1 - productAlpha);
-          submeshMat->SetCastShadows(_msg.cast_shadows());
-        }
-      }
+      expired.push_back(entity.id);
+      continue;
     }
 
-    if (material)
+    if (!entity.poseApplied || pose != entity.appliedPose)
     {
-      // set transparency
-      material->SetTransparency(_msg.transparency());
-
-      // cast shadows
-      material->SetCastShadows(_msg.cast_shadows());
-
-      geom->SetMaterial(material);
-      // todo(anyone) SetMaterial function clones the input material.
-      // but does not take ownership of it so we need to destroy it here.
-      // This is not ideal. We should let gz-rendering handle the lifetime
-      // of this material
-      this->scene->DestroyMaterial(material);
+      node->SetLocalPose(pose);
+      entity.appliedPose = pose;
+      entity.poseApplied = true;
+      this->MarkMoved(entity);
     }
+
+    if (done)
+      entity.interpolating = false;
+    else
+      ++interpolating;
   }
-  else
+  this->interpolatingCount = interpolating;
+
+  // Nodes destroyed by someone else
+  for (auto id : expired)
   {
-    gzerr << "Failed to load geometry for visual: " << _msg.name()
-           << std::endl;
+    this->entities.Erase(id);
+    this->RemoveSceneEntity(id);
   }
+  if (!expired.empty())
+    this->ReleaseExpiredMaterials();
+}
 
-  return visualVis;
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::MarkMoved(const Entity &_entity)
+{
+  if (!this->staticBatching || _entity.root == 0u)
+    return;
+
+  auto root = _entity.root == _entity.id ? this->entities.Find(_entity.id) :
+      this->entities.Find(_entity.root);
+  if (nullptr == root)
+    return;
+
+  root->movedTime = this->frameTime;
+  if (root->batch != 0u)
+    this->batchesToSplit.push_back(root->batch);
 }
 
 /////////////////////////////////////////////////
-rendering::GeometryPtr TransportSceneManagerPrivate::LoadGeometry(
-    const msgs::Geometry &_msg, math::Vector3d &_scale,
-    math::Pose3d &_localPose)
+bool TransportSceneManagerPrivate::UpdateStaticBatches()
 {
-  math::Vector3d scale = math::Vector3d::One;
-  math::Pose3d localPose = math::Pose3d::Zero;
-  rendering::GeometryPtr geom{nullptr};
-  if (_msg.has_box())
-  {
-    geom = this->scene->CreateBox();
-    if (_msg.box().has_size())
-      scale = msgs::Convert(_msg.box().size());
-  }
-  else if (_msg.has_cylinder())
-  {
-    geom = this->scene->CreateCylinder();
-    scale.X() = _msg.cylinder().radius() * 2;
-    scale.Y() = scale.X();
-    scale.Z() = _msg.cylinder().length();
-  }
-  else if (_msg.has_capsule())
-  {
-    auto capsule = this->scene->CreateCapsule();
-    capsule->SetRadius(_msg.capsule().radius());
-    capsule->SetLength(_msg.capsule().length());
-    geom = capsule;
+  bool changed = !this->batchesToSplit.empty();
+  for (auto batch : this->batchesToSplit)
+    this->SplitStaticBatch(batch);
+  this->batchesToSplit.clear();
 
-    scale.X() = _msg.capsule().radius() * 2;
-    scale.Y() = scale.X();
-    scale.Z() = _msg.capsule().length() + scale.X();
-  }
-  else if (_msg.has_ellipsoid())
+  // Wait for the scene to settle, so batches don't miss visuals which are
+  // still being loaded, or hold visuals about to be destroyed or replaced
+  if (this->frameTime - this->lastBatchCheck < kBatchCheckPeriod ||
+      !this->loadJobs.empty() || !this->toDestroy.empty() ||
+      this->placeholderCount > 0u)
   {
-    geom = this->scene->CreateSphere();
-    scale.X() = _msg.ellipsoid().radii().x() * 2;
-    scale.Y() = _msg.ellipsoid().radii().y() * 2;
-    scale.Z() = _msg.ellipsoid().radii().z() * 2;
+    return changed;
   }
-  else if (_msg.has_plane())
-  {
-    geom = this->scene->CreatePlane();
 
-    if (_msg.plane().has_size())
+  GZ_GUI_PROFILE("TransportSceneManager::BuildStaticBatches");
+
+  // Models which stayed put, by grid cell
+  std::map<std::pair<int64_t, int64_t>, std::vector<unsigned int>> cells;
+  for (auto &entity : this->entities.Entities())
+  {
+    if (entity.root != entity.id || entity.type != EntityType::kVisual ||
+        entity.batch != 0u || entity.lod != Lod::kFull)
     {
-      scale.X() = _msg.plane().size().x();
-      scale.Y() = _msg.plane().size().y();
+      continue;
     }
 
-    if (_msg.plane().has_normal())
+    if (entity.movedTime < 0.0)
+      entity.movedTime = this->frameTime;
+    if (!entity.isStatic &&
+        this->frameTime - entity.movedTime < this->batchSettleTime)
     {
-      // Create a rotation for the plane mesh to account for the normal vector.
-      // The rotation is the angle between the +z(0,0,1) vector and the
-      // normal, which are both expressed in the local (Visual) frame.
-      math::Vector3d normal = msgs::Convert(_msg.plane().normal());
-      localPose.Rot().SetFrom2Axes(math::Vector3d::UnitZ, normal.Normalized());
+      continue;
     }
+
+    auto node = entity.node.lock();
+    if (!node)
+      continue;
+    auto pos = node->WorldPosition();
+    cells[{static_cast<int64_t>(std::floor(pos.X() / this->batchCellSize)),
+        static_cast<int64_t>(std::floor(pos.Y() / this->batchCellSize))}]
+        .push_back(entity.id);
   }
-  else if (_msg.has_sphere())
-  {
-    geom = this->scene->CreateSphere();
-    scale.X() = _msg.sphere().radius() * 2;
-    scale.Y() = scale.X();
-    scale.Z() = scale.X();
-  }
-  else if (_msg.has_mesh())
+
+  // Models left out are tried again on the next check
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &cell : cells)
   {
-    if (_msg.mesh().filename().empty())
+    for (std::size_t i = 0; i < cell.second.size(); i += kMaxBatchRoots)
     {
-      gzerr << "Mesh geometry missing filename" << std::endl;
-      return geom;
+      auto end = std::min(cell.second.size(), i + kMaxBatchRoots);
+      std::vector<unsigned int> roots(cell.second.begin() + i,
+          cell.second.begin() + end);
+      changed = this->BuildStaticBatch(roots) || changed;
+
+      // Carry on next frame
+      if (std::chrono::steady_clock::now() - start > kBatchBudget)
+        return changed;
     }
-    rendering::MeshDescriptor descriptor;
+  }
+  this->lastBatchCheck = this->frameTime;
+  return changed;
+}
 
-    // Assume absolute path to mesh file
-    descriptor.meshName = _msg.mesh().filename();
+/////////////////////////////////////////////////
+bool TransportSceneManagerPrivate::BuildStaticBatch(
+    const std::vector<unsigned int> &_roots)
+{
+  std::vector<BatchPart> parts;
+  StaticBatch batch;
+  for (auto id : _roots)
+  {
+    auto root = this->entities.Find(id);
+    auto visual = root ? std::dynamic_pointer_cast<rendering::Visual>(
+        root->node.lock()) : nullptr;
+    if (!visual)
+      continue;
 
-    gz::common::MeshManager* meshManager =
-        gz::common::MeshManager::Instance();
-    descriptor.mesh = meshManager->Load(descriptor.meshName);
-    geom = this->scene->CreateMesh(descriptor);
+    // Boxes of the level of detail are hidden
+    std::vector<rendering::VisualPtr> proxies;
+    for (auto meshId : root->meshVisuals)
+    {
+      auto meshVisual = this->entities.Find(meshId);
+      if (auto proxy = meshVisual ? meshVisual->proxy.lock() : nullptr)
+        proxies.push_back(proxy);
+    }
 
-    scale = msgs::Convert(_msg.mesh().scale());
+    std::vector<rendering::VisualPtr> leaves;
+    CollectLeafVisuals(visual, leaves);
+    for (const auto &leaf : leaves)
+    {
+      if (std::find(proxies.begin(), proxies.end(), leaf) == proxies.end() &&
+          AddToBatch(leaf, parts))
+      {
+        batch.hidden.push_back(leaf);
+      }
+    }
+    batch.roots.push_back(id);
   }
-  else
+
+  // Not worth it, try again once they've settled again
+  if (batch.hidden.size() < 2u)
   {
-    gzerr << "Unsupported geometry type" << std::endl;
+    for (auto id : batch.roots)
+      this->entities.Find(id)->movedTime = this->frameTime;
+    return false;
   }
-  _scale = scale;
-  _localPose = localPose;
-  return geom;
-}
 
-/////////////////////////////////////////////////
-rendering::MaterialPtr TransportSceneManagerPrivate::LoadMaterial(
-    const msgs::Material &_msg)
-{
-  rendering::MaterialPtr material = this->scene->CreateMaterial();
-  if (_msg.has_ambient())
+  uint32_t id = this->nextBatch++;
+  batch.meshName = "__transport_scene_manager_batch_" + std::to_string(id);
+  auto mesh = std::make_unique<common::Mesh>();
+  mesh->SetName(batch.meshName);
+  uint64_t bytes{0u};
+  for (const auto &part : parts)
   {
-    material->SetAmbient(msgs::Convert(_msg.ambient()));
+    bytes += part.subMesh.VertexCount() * kVertexBytes +
+        part.subMesh.IndexCount() * kIndexBytes;
+    mesh->AddSubMesh(part.subMesh);
   }
-  if (_msg.has_diffuse())
+
+  // The models' own meshes are kept for when they're split
+  if (!GpuMemory::Reserve("TransportSceneManager",
+      GpuMemory::Resource::kMeshes, batch.meshName, bytes))
   {
-    material->SetDiffuse(msgs::Convert(_msg.diffuse()));
+    for (auto root : batch.roots)
+      this->entities.Find(root)->movedTime = this->frameTime;
+    return false;
   }
-  if (_msg.has_specular())
+
+  common::MeshManager::Instance()->AddMesh(mesh.release());
+  rendering::MeshDescriptor descriptor;
+  descriptor.meshName = batch.meshName;
+  descriptor.mesh = common::MeshManager::Instance()->MeshByName(
+      batch.meshName);
+  auto geom = this->scene->CreateMesh(descriptor);
+  if (!geom)
   {
-    material->SetDiffuse(msgs::Convert(_msg.specular()));
+    gzerr << "Failed to create static batch mesh [" << batch.meshName
+          << "]" << std::endl;
+    common::MeshManager::Instance()->RemoveMesh(batch.meshName);
+    GpuMemory::Release("TransportSceneManager",
+        GpuMemory::Resource::kMeshes, batch.meshName);
+    for (auto root : batch.roots)
+      this->entities.Find(root)->movedTime = this->frameTime;
+    return false;
   }
-  if (_msg.has_emissive())
+
+  // Share the models' materials
+  for (unsigned int i = 0; i < geom->SubMeshCount() && i < parts.size(); ++i)
+    geom->SubMeshByIndex(i)->SetMaterial(parts[i].material, false);
+
+  auto visual = this->scene->CreateVisual();
+  visual->AddGeometry(geom);
+  this->scene->RootVisual()->AddChild(visual);
+  RenderStats::SetStatic(visual->Id(), true);
+  batch.visual = visual;
+
+  for (const auto &hidden : batch.hidden)
   {
-    material->SetEmissive(msgs::Convert(_msg.emissive()));
+    if (auto leaf = hidden.lock())
+      leaf->SetVisible(false);
   }
+  for (auto root : batch.roots)
+    this->entities.Find(root)->batch = id;
 
-  return material;
+  this->batches.emplace(id, std::move(batch));
+  return true;
 }
 
 /////////////////////////////////////////////////
-rendering::LightPtr TransportSceneManagerPrivate::LoadLight(
-    const msgs::Light &_msg)
+void TransportSceneManagerPrivate::SplitStaticBatch(uint32_t _batch)
 {
-  rendering::LightPtr light;
+  auto it = this->batches.find(_batch);
+  if (it == this->batches.end())
+    return;
 
-  switch (_msg.type())
+  // The other models are batched again on the next check
+  for (auto id : it->second.roots)
   {
-    case msgs::Light_LightType_POINT:
-      light = this->scene->CreatePointLight();
-      break;
-    case msgs::Light_LightType_SPOT:
-    {
-      light = this->scene->CreateSpotLight();
-      rendering::SpotLightPtr spotLight =
-          std::dynamic_pointer_cast<rendering::SpotLight>(light);
-      spotLight->SetInnerAngle(_msg.spot_inner_angle());
-      spotLight->SetOuterAngle(_msg.spot_outer_angle());
-      spotLight->SetFalloff(_msg.spot_falloff());
-      break;
-    }
-    case msgs::Light_LightType_DIRECTIONAL:
-    {
-      light = this->scene->CreateDirectionalLight();
-      rendering::DirectionalLightPtr dirLight =
-          std::dynamic_pointer_cast<rendering::DirectionalLight>(light);
-
-      if (_msg.has_direction())
-        dirLight->SetDirection(msgs::Convert(_msg.direction()));
-      break;
-    }
-    default:
-      gzerr << "Light type not supported" << std::endl;
-      return light;
+    if (auto root = this->entities.Find(id))
+      root->batch = 0u;
+  }
+  for (const auto &hidden : it->second.hidden)
+  {
+    if (auto leaf = hidden.lock())
+      leaf->SetVisible(true);
   }
 
-  if (_msg.has_pose())
-    light->SetLocalPose(msgs::Convert(_msg.pose()));
-
-  if (_msg.has_diffuse())
-    light->SetDiffuseColor(msgs::Convert(_msg.diffuse()));
-
-  if (_msg.has_specular())
-    light->SetSpecularColor(msgs::Convert(_msg.specular()));
-
-  light->SetAttenuationConstant(_msg.attenuation_constant());
-  light->SetAttenuationLinear(_msg.attenuation_linear());
-  light->SetAttenuationQuadratic(_msg.attenuation_quadratic());
-  light->SetAttenuationRange(_msg.range());
+  if (auto visual = it->second.visual.lock())
+    this->scene->DestroyVisual(visual, true);
+  common::MeshManager::Instance()->RemoveMesh(it->second.meshName);
+  GpuMemory::Release("TransportSceneManager",
+      GpuMemory::Resource::kMeshes, it->second.meshName);
+  this->batches.erase(it);
+}
 
-  light->SetCastShadows(_msg.cast_shadows());
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::EvictPendingPoses()
+{
+  // No need to check every frame
+  if (this->pendingPoses.empty() || this->frameCount % 60u != 0u)
+    return;
 
-  this->lights[_msg.id()] = light;
-  return light;
+  for (auto it = this->pendingPoses.begin(); it != this->pendingPoses.end();)
+  {
+    if (this->frameCount - it->second.frame > kPendingPoseFrames)
+      it = this->pendingPoses.erase(it);
+    else
+      ++it;
+  }
 }
 
 /////////////////////////////////////////////////
-void TransportSceneManagerPrivate::DeleteEntity(const unsigned int _entity)
+void TransportSceneManagerPrivate::DeleteEntity(const unsigned int _entity,
+    bool _immediate)
 {
-  if (this->visuals.find(_entity) != this->visuals.end())
+  auto entity = this->entities.Find(_entity);
+  if (nullptr == entity)
+    return;
+
+  // The batch may hold the geometry of the deleted visuals
+  if (!this->batches.empty())
   {
-    auto visual = this->visuals[_entity].lock();
-    if (visual)
+    auto root = entity->root == entity->id ? entity :
+        this->entities.Find(entity->root);
+    if (root && root->batch != 0u)
+      this->SplitStaticBatch(root->batch);
+  }
+
+  auto node = entity->node.lock();
+  if (entity->type == EntityType::kVisual)
+  {
+    auto visual = std::dynamic_pointer_cast<rendering::Visual>(node);
+    if (visual && _immediate)
     {
-      this->scene->DestroyVisual(visual, true);
+      this->DestroyVisual(visual);
+    }
+    else if (visual)
+    {
+      // Destroying large numbers of visuals at once stalls the frame, so
+      // only hide them for now
+      visual->SetVisible(false);
+      this->toDestroy.push_back(visual);
     }
-    this->visuals.erase(_entity);
   }
-  else if (this->lights.find(_entity) != this->lights.end())
+  else
   {
-    auto light = this->lights[_entity].lock();
+    auto light = std::dynamic_pointer_cast<rendering::Light>(node);
     if (light)
     {
       this->scene->DestroyLight(light, true);
     }
-    this->lights.erase(_entity);
   }
+  this->entities.Erase(_entity);
+  this->RemoveSceneEntity(_entity);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::AddSceneEntity(unsigned int _id,
+    const std::string &_name, SceneEntities::Type _type,
+    const rendering::NodePtr &_node)
+{
+  if (!this->removedEntities.empty())
+  {
+    this->sceneEntities->Remove(std::move(this->removedEntities));
+    this->removedEntities.clear();
+  }
+
+  SceneEntities::Entity entity;
+  entity.id = _id;
+  entity.parent = this->loadingParent;
+  entity.name = _name;
+  entity.type = _type;
+  entity.renderId = _node->Id();
+  this->addedEntities.push_back(std::move(entity));
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::RemoveSceneEntity(unsigned int _id)
+{
+  if (!this->addedEntities.empty())
+  {
+    this->sceneEntities->Add(std::move(this->addedEntities));
+    this->addedEntities.clear();
+  }
+  this->removedEntities.push_back(_id);
+}
+
+/////////////////////////////////////////////////
+void TransportSceneManagerPrivate::PublishSceneEntities()
+{
+  if (!this->addedEntities.empty())
+    this->sceneEntities->Add(std::move(this->addedEntities));
+  if (!this->removedEntities.empty())
+    this->sceneEntities->Remove(std::move(this->removedEntities));
+  this->addedEntities.clear();
+  this->removedEntities.clear();
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(gz::gui::plugins::TransportSceneManager,
-              gz::gui::Plugin)
+GZ_GUI_ADD_PLUGIN(gz::gui::plugins::TransportSceneManager,
+                  "TransportSceneManager")
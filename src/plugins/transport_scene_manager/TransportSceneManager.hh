@@ -33,16 +33,171 @@ namespace plugins
   /// \brief Provides a Gazebo Transport interface to
   /// `gz::gui::plugins::MinimalScene`.
   ///
+  /// Windows of the same application which show the same scene, each with
+  /// their own MinimalScene viewport, share a single TransportSceneManager.
+  /// The first one loaded with given \<service\>, \<snapshot_service\>,
+  /// \<pose_topic\>, \<deletion_topic\> and \<scene_topic\> requests,
+  /// subscribes to and loads the scene, and the others use its entities,
+  /// so the scene is only received and held in memory once however many
+  /// windows show it. Their other parameters are ignored. The scene is
+  /// unloaded when the last of them is closed.
+  ///
   /// ## Configuration
   ///
   /// * \<service\> : Name of service where this system will request a scene
   ///                 message. Optional, defaults to "/scene".
+  /// * \<snapshot_service\> : Name of a service sending the scene as a
+  ///                          compressed snapshot in chunks, see Scene
+  ///                          snapshots. Optional, disabled by default.
   /// * \<pose_topic\> : Name of topic to subscribe to receive pose updates.
   ///                    Optional, defaults to "/pose".
   /// * \<deletion_topic\> : Name of topic to request entity deletions.
   ///                        Optional, defaults to "/delete".
   /// * \<scene_topic\> : Name of topic to receive scene updates. Optional,
   ///                     defaults to "/scene".
+  /// * \<conflate_poses\> : True to only render the latest pose message
+  ///                        received between two frames, skipping older
+  ///                        ones. Set to false if pose messages only
+  ///                        contain some of the entities. Optional,
+  ///                        defaults to true.
+  /// * \<interpolation_delay\> : Time in seconds the poses are rendered
+  ///                             behind the latest pose message, so they're
+  ///                             interpolated between the last messages
+  ///                             when rendering faster than poses are
+  ///                             published, see Pose interpolation.
+  ///                             Optional, defaults to 0, which renders
+  ///                             the latest poses as they are.
+  /// * \<load_budget\> : Maximum number of visuals and lights created per
+  ///                     frame while loading a scene, so that large scenes
+  ///                     load over several frames without freezing the
+  ///                     GUI. Set to 0 to load scenes in a single frame.
+  ///                     Optional, defaults to 200.
+  /// * \<progressive_loading\> : True to load the models nearest and
+  ///                             largest in the user camera's view first,
+  ///                             and show the scene before its meshes are
+  ///                             decoded, with boxes until they are.
+  ///                             Optional, defaults to true.
+  /// * \<delete_budget\> : Time in milliseconds spent destroying deleted
+  ///                       visuals per frame. Deleted visuals are hidden
+  ///                       right away and destroyed over several frames.
+  ///                       Optional, defaults to 2.
+  /// * \<pose_budget\> : Time in milliseconds spent applying the poses of
+  ///                     models out of the user camera's view per frame.
+  ///                     Poses of models in view are always applied, then
+  ///                     those of models close to the camera and the
+  ///                     others, and the rest are applied over the next
+  ///                     frames. Interpolated poses aren't budgeted. Set to
+  ///                     0 to apply all poses each frame. Optional,
+  ///                     defaults to 0.
+  /// * \<lod\> : Level of detail of top level models, based on their
+  ///             distance to the user camera. Optional, disabled by default.
+  ///   * \<box_distance\> : Distance beyond which meshes are replaced by
+  ///                        their bounding boxes. 0 to disable.
+  ///   * \<cull_distance\> : Distance beyond which models are hidden. 0 to
+  ///                         disable.
+  ///   * \<skip_culled_poses\> : True to not update the links and visuals
+  ///                             of hidden models until they're visible
+  ///                             again. Defaults to false.
+  /// * \<static_models\> : True to mark the visuals of static models as
+  ///                       static, see RenderStats, and only apply their
+  ///                       first pose update. Optional, defaults to false.
+  /// * \<static_batching\> : Merge models which don't move into static
+  ///                         batches, see Static batching. Optional,
+  ///                         disabled by default.
+  ///   * \<settle_time\> : Time in seconds a model must stay put before
+  ///                       it's merged. Models marked as static with
+  ///                       \<static_models\> are merged right away.
+  ///                       Defaults to 5.
+  ///   * \<cell_size\> : Size in meters of the grid cells models are
+  ///                     merged by. Defaults to 50.
+  /// * \<scene_cache\> : File the whole scene is saved to each time it's
+  ///                     received. It's shown right away on the next
+  ///                     launch, and reconciled with the scene service's
+  ///                     response once it arrives. Leave empty to use
+  ///                     `~/.gz/gui/scene_cache/<service>.pb`. Optional,
+  ///                     disabled by default.
+  /// * \<host_cache\> : True to read the scene and poses from a
+  ///                    HostSceneCache on this host, with the same
+  ///                    \<service\> and \<pose_topic\>, instead of
+  ///                    subscribing to them. The scene topics are used if
+  ///                    there's no cache when the scene is created.
+  ///                    Optional, defaults to false.
+  /// * \<load_threads\> : Number of threads parsing mesh files while
+  ///                      loading a scene. Optional, defaults to half the
+  ///                      hardware threads.
+  /// * \<mesh_cache\> : Directory parsed meshes are saved to, so they're
+  ///                    read back without parsing their files again. It
+  ///                    can be shared by several instances. Leave empty to
+  ///                    use `~/.gz/gui/mesh_cache`. Optional, disabled by
+  ///                    default.
+  ///
+  /// ## Pose interpolation
+  ///
+  /// With an interpolation delay, each entity keeps its last few poses
+  /// with the time of their message, its header stamp or else when it was
+  /// received. Each frame is rendered at a time following the messages
+  /// with that delay, smoothed so network jitter doesn't make it jump,
+  /// and entities are placed between the poses around it, with a linear
+  /// interpolation of the position and a spherical one of the orientation.
+  /// The delay should cover a couple of pose messages, such as 0.1 for
+  /// poses published at 30 Hz. Set \<conflate_poses\> to false so no
+  /// pose message is skipped.
+  ///
+  /// ## Static batching
+  ///
+  /// Each model is normally rendered with a draw call per visual. With
+  /// static batching, the models of each grid cell which haven't moved for
+  /// a while are merged into a single mesh in world coordinates, with a
+  /// submesh per material, and their own visuals are hidden. Only meshes
+  /// and primitive shapes made of triangles are merged; other visuals are
+  /// left as they are. When a merged model moves or is deleted, its batch
+  /// is split back into its visuals, and the other models of the batch are
+  /// merged again on the next check, once per second. Only models at full
+  /// detail are merged, and their level of detail doesn't change while
+  /// they're merged. Merged meshes count towards the GPU memory budget,
+  /// models are left as they are if they don't fit.
+  ///
+  /// ## GPU memory
+  ///
+  /// The estimated size of each mesh is recorded for the GPU memory
+  /// accounting, see GpuMemory. Meshes which don't fit in the budget are
+  /// shown as their bounding boxes instead.
+  ///
+  /// ## Scene snapshots
+  ///
+  /// Large scenes take a while to be sent as a single message. With a
+  /// snapshot service, the scene is instead requested in chunks of a few
+  /// models and lights, compressed with zlib, and each chunk is shown as
+  /// soon as it arrives. Chunks are requested one at a time with a
+  /// msgs::UInt32_V holding the snapshot Id, 0 for a new snapshot, and the
+  /// chunk index. The reply is a msgs::Bytes, see SceneSnapshotChunk in
+  /// SceneSnapshot.hh, whose SplitSceneSnapshot can be used by servers.
+  /// Once the last chunk arrives, the snapshot is handled like a reply of
+  /// the scene service. If any chunk fails, the whole scene is requested
+  /// from the scene service instead.
+  ///
+  /// ## Scene entities
+  ///
+  /// The models, links, visuals and lights which are loaded and deleted are
+  /// sent to SceneEntities once per frame, for plugins browsing the scene
+  /// such as EntityTree.
+  ///
+  /// ## Scene updates
+  ///
+  /// Messages on the scene topic normally only add entities which weren't
+  /// loaded yet. Publishers can instead send scene updates containing only
+  /// what changed, by adding these keys to the message header's data:
+  ///
+  /// * `revision` : Number of the update, incremented by one on each
+  ///                update. Entities in the message replace existing ones
+  ///                with the same Id.
+  /// * `removed` : Ids of the entities removed by the update.
+  ///
+  /// When an update is missed, the whole scene is requested again from the
+  /// scene service. Entities which aren't part of it are removed, and the
+  /// updates received in the meantime are applied on top of it, according
+  /// to its own `revision` if it has one. Other responses of the scene
+  /// service only remove entities if they have a `revision`.
   class TransportSceneManager : public Plugin
   {
     Q_OBJECT
@@ -57,12 +212,10 @@ namespace plugins
     public: virtual void LoadConfig(const tinyxml2::XMLElement *_pluginElem)
         override;
 
-    // Documentation inherited
-    private: bool eventFilter(QObject *_obj, QEvent *_event) override;
-
     /// \internal
-    /// \brief Pointer to private data.
-    private: std::unique_ptr<TransportSceneManagerPrivate> dataPtr;
+    /// \brief Pointer to private data, shared by the plugins showing the
+    /// same scene.
+    private: std::shared_ptr<TransportSceneManagerPrivate> dataPtr;
   };
 }
 }
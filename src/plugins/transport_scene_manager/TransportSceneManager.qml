@@ -31,6 +31,8 @@ GridLayout {
   property string poseTopic: 'N/A'
   property string deletionTopic: 'N/A'
   property string sceneTopic: 'N/A'
+  property real loadProgress: 1.0
+  property int placeholders: 0
 
   Label {
     Layout.columnSpan: 1
@@ -42,6 +44,22 @@ GridLayout {
           "<br><b>Scene topic</b>: /" + sceneTopic
   }
 
+  Label {
+    Layout.columnSpan: 1
+    Layout.fillWidth: true
+    visible: loadProgress < 1.0 || placeholders > 0
+    text: "Loading scene: " + Math.floor(loadProgress * 100) + "%" +
+          (placeholders > 0 ? "<br>Decoding meshes of " + placeholders +
+          " visuals" : "")
+  }
+
+  ProgressBar {
+    Layout.columnSpan: 1
+    Layout.fillWidth: true
+    visible: loadProgress < 1.0 || placeholders > 0
+    value: loadProgress
+  }
+
 
   Item {
     Layout.columnSpan: 1
@@ -0,0 +1,629 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "VideoRecorder.hh"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Util.hh>
+#include <gz/common/VideoEncoder.hh>
+#include <gz/plugin/Register.hh>
+#include <gz/rendering/Camera.hh>
+#include <gz/rendering/RenderingIface.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/transport/Node.hh>
+
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "gz/gui/StaticPlugins.hh"
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Work for the encoder thread, in the order it was queued
+  struct VideoJob
+  {
+    /// \brief Kind of job
+    enum class Kind
+    {
+      /// \brief Start a video
+      kStart,
+
+      /// \brief Encode a frame
+      kFrame,
+
+      /// \brief Finish the video and save it
+      kStop
+    };
+
+    /// \brief Kind of job
+    Kind kind{Kind::kFrame};
+
+    /// \brief Pixels copied from the camera, for frames
+    rendering::Image image;
+
+    /// \brief When the frame was captured, for frames
+    std::chrono::steady_clock::time_point stamp;
+
+    /// \brief Video file, for starts
+    std::string path;
+
+    /// \brief Video format, for starts
+    std::string format;
+  };
+
+  class VideoRecorderPrivate
+  {
+    /// \brief Start recording.
+    /// \param[in] _path Video file, empty for a timestamped file in the
+    /// directory
+    /// \param[in] _format Video format, empty for the configured one
+    /// \return False if already recording
+    public: bool Start(const std::string &_path, const std::string &_format);
+
+    /// \brief Stop recording, the video is saved once the queued frames
+    /// are encoded.
+    /// \return False if not recording
+    public: bool Stop();
+
+    /// \brief Find the user camera, on the render thread
+    public: void FindUserCamera();
+
+    /// \brief Encode the queued frames until stopped
+    public: void ProcessWorker();
+
+    /// \brief Maximum number of frames waiting for the encoder. Frames
+    /// captured while the encoder is behind are dropped, rather than
+    /// slowing down rendering or piling up.
+    public: static constexpr std::size_t kMaxQueuedFrames{4u};
+
+    /// \brief Node for the service
+    public: transport::Node node;
+
+    /// \brief Record service name
+    public: std::string service{"/gui/video_recorder"};
+
+    /// \brief Directory to save videos
+    public: std::string directory;
+
+    /// \brief Video format
+    public: std::string format{"mp4"};
+
+    /// \brief Video frame rate
+    public: unsigned int fps{25u};
+
+    /// \brief Video bit rate
+    public: unsigned int bitrate{2070000u};
+
+    /// \brief True to capture every rendered frame, false to capture at fps
+    /// in wall clock time
+    public: bool perFrame{false};
+
+    /// \brief False to never use a hardware encoder
+    public: bool hwAccel{true};
+
+    /// \brief Called by the worker once a video is saved, or failed to
+    /// start or save
+    public: std::function<void(const std::string &, bool)> onDone;
+
+    /// \brief Checked by the render thread before taking the mutex
+    public: std::atomic<bool> recording{false};
+
+    /// \brief Recording state shown in the GUI
+    public: bool recordingValue{false};
+
+    /// \brief Path of the last saved video
+    public: QString savedPath;
+
+    /// \brief Protects everything below
+    public: std::mutex mutex;
+
+    /// \brief Jobs for the encoder thread
+    public: std::deque<VideoJob> jobs;
+
+    /// \brief Number of frames in jobs
+    public: std::size_t queuedFrames{0u};
+
+    /// \brief Images already encoded, reused for the next frames
+    public: std::vector<rendering::Image> freeImages;
+
+    /// \brief Time of the first frame of the video, unset until captured
+    public: std::optional<std::chrono::steady_clock::time_point> firstFrame;
+
+    /// \brief Number of frames captured for the video
+    public: uint64_t frameCount{0u};
+
+    /// \brief Number of frames dropped because the encoder was behind
+    public: uint64_t dropped{0u};
+
+    /// \brief Notified when a job is queued or the worker should stop
+    public: std::condition_variable workerCv;
+
+    /// \brief True to stop the worker once the queued jobs are done
+    public: bool stopWorker{false};
+
+    /// \brief Thread encoding the frames and writing the videos
+    public: std::thread worker;
+
+    /// \brief User camera, only used on the render thread
+    public: rendering::CameraPtr userCamera{nullptr};
+
+    /// \brief Render hook identifier
+    public: uint64_t renderHookId{0};
+  };
+}
+}
+}
+
+using namespace gz;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+VideoRecorder::VideoRecorder()
+  : gui::Plugin(),
+  dataPtr(std::make_unique<VideoRecorderPrivate>())
+{
+  std::string home;
+  common::env(GZ_HOMEDIR, home);
+  this->dataPtr->directory = common::joinPaths(home, ".gz", "gui", "videos");
+
+  // Videos are written on the worker, but the GUI is notified on the main
+  // thread
+  this->dataPtr->onDone = [this](const std::string &_path, bool _saved)
+  {
+    QMetaObject::invokeMethod(this, [this, _path, _saved]
+    {
+      if (!_saved)
+      {
+        this->SetRecording(false);
+        return;
+      }
+      this->dataPtr->savedPath = QString::fromStdString(_path);
+      this->SavedPathChanged();
+      App()->findChild<MainWindow *>()->notifyWithDuration(
+          QString::fromStdString("Saved video to: <b>" + _path + "</b>"),
+          4000);
+    }, Qt::QueuedConnection);
+  };
+  this->dataPtr->worker =
+      std::thread(&VideoRecorderPrivate::ProcessWorker, this->dataPtr.get());
+}
+
+/////////////////////////////////////////////////
+VideoRecorder::~VideoRecorder()
+{
+  RenderHooks::Unregister(this->dataPtr->renderHookId);
+
+  // A video being recorded is still saved
+  this->dataPtr->Stop();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stopWorker = true;
+  }
+  this->dataPtr->workerCv.notify_all();
+  if (this->dataPtr->worker.joinable())
+    this->dataPtr->worker.join();
+}
+
+/////////////////////////////////////////////////
+void VideoRecorder::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Video recorder";
+
+  if (_pluginElem)
+  {
+    if (auto elem = _pluginElem->FirstChildElement("format"))
+    {
+      if (nullptr != elem->GetText())
+        this->dataPtr->format = elem->GetText();
+    }
+
+    if (auto elem = _pluginElem->FirstChildElement("fps"))
+    {
+      elem->QueryUnsignedText(&this->dataPtr->fps);
+      if (this->dataPtr->fps == 0u)
+      {
+        gzwarn << "Invalid <fps> [0], using 25." << std::endl;
+        this->dataPtr->fps = 25u;
+      }
+    }
+
+    if (auto elem = _pluginElem->FirstChildElement("bitrate"))
+      elem->QueryUnsignedText(&this->dataPtr->bitrate);
+
+    if (auto elem = _pluginElem->FirstChildElement("capture"))
+    {
+      std::string capture = nullptr != elem->GetText() ?
+          elem->GetText() : "";
+      if (capture == "frame")
+        this->dataPtr->perFrame = true;
+      else if (capture != "fixed")
+      {
+        gzwarn << "Unknown <capture> [" << capture
+               << "], expected [fixed] or [frame]. Using [fixed]."
+               << std::endl;
+      }
+    }
+
+    if (auto elem = _pluginElem->FirstChildElement("hw_accel"))
+      elem->QueryBoolText(&this->dataPtr->hwAccel);
+
+    if (auto elem = _pluginElem->FirstChildElement("service"))
+    {
+      if (nullptr != elem->GetText())
+        this->dataPtr->service = elem->GetText();
+    }
+  }
+
+  if (this->dataPtr->node.Advertise(this->dataPtr->service,
+      &VideoRecorder::RecordService, this))
+  {
+    gzmsg << "Video recorder service on [" << this->dataPtr->service << "]"
+          << std::endl;
+  }
+  else
+  {
+    gzerr << "Failed to advertise video recorder service ["
+          << this->dataPtr->service << "]" << std::endl;
+  }
+
+  if (this->dataPtr->renderHookId == 0)
+  {
+    this->dataPtr->renderHookId = RenderHooks::Register(RenderPhase::kRender,
+        [this]{this->OnRender();}, 0, "VideoRecorder");
+  }
+}
+
+/////////////////////////////////////////////////
+void VideoRecorder::OnRecord(bool _start)
+{
+  if (_start)
+    this->SetRecording(this->dataPtr->Start("", ""));
+  else if (this->dataPtr->Stop())
+    this->SetRecording(false);
+}
+
+/////////////////////////////////////////////////
+bool VideoRecorder::RecordService(const msgs::VideoRecord &_msg,
+    msgs::Boolean &_res)
+{
+  bool accepted = false;
+  if (_msg.start())
+    accepted = this->dataPtr->Start(_msg.save_filename(), _msg.format());
+  else if (_msg.stop())
+    accepted = this->dataPtr->Stop();
+
+  if (accepted)
+  {
+    bool recording = _msg.start();
+    QMetaObject::invokeMethod(this, [this, recording]
+    {
+      this->SetRecording(recording);
+    }, Qt::QueuedConnection);
+  }
+  _res.set_data(accepted);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool VideoRecorderPrivate::Start(const std::string &_path,
+    const std::string &_format)
+{
+  VideoJob job;
+  job.kind = VideoJob::Kind::kStart;
+  job.format = _format.empty() ? this->format : _format;
+  job.path = _path;
+  if (job.path.empty())
+  {
+    if (!common::exists(this->directory) &&
+        !common::createDirectories(this->directory))
+    {
+      gzerr << "Unable to create directory [" << this->directory << "]"
+            << std::endl;
+      return false;
+    }
+    job.path = common::joinPaths(this->directory,
+        common::systemTimeISO() + "." + job.format);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->recording)
+      return false;
+    this->firstFrame.reset();
+    this->frameCount = 0u;
+    this->dropped = 0u;
+    this->jobs.push_back(std::move(job));
+    this->recording = true;
+  }
+  this->workerCv.notify_one();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool VideoRecorderPrivate::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (!this->recording)
+      return false;
+    this->recording = false;
+
+    if (this->dropped > 0u)
+    {
+      gzwarn << "Dropped " << this->dropped << " of "
+             << this->frameCount + this->dropped
+             << " frames while the encoder was behind" << std::endl;
+    }
+
+    VideoJob job;
+    job.kind = VideoJob::Kind::kStop;
+    this->jobs.push_back(std::move(job));
+  }
+  this->workerCv.notify_one();
+  return true;
+}
+
+/////////////////////////////////////////////////
+void VideoRecorder::OnRender()
+{
+  auto &data = *this->dataPtr;
+  if (!data.recording)
+    return;
+
+  data.FindUserCamera();
+  if (nullptr == data.userCamera)
+    return;
+
+  // Frames of other scenes would be mixed into the video
+  if (!RenderHooks::RunsFor(data.userCamera->Scene()->Name()))
+    return;
+
+  if (data.userCamera->ImageFormat() != rendering::PF_R8G8B8)
+  {
+    gzerr << "Can't record camera [" << data.userCamera->Name()
+          << "], its pixels aren't RGB." << std::endl;
+    if (data.Stop())
+    {
+      QMetaObject::invokeMethod(this, [this]
+      {
+        this->SetRecording(false);
+      }, Qt::QueuedConnection);
+    }
+    return;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  const std::chrono::steady_clock::duration period =
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(1.0 / data.fps));
+  const auto width = data.userCamera->ImageWidth();
+  const auto height = data.userCamera->ImageHeight();
+
+  VideoJob job;
+  {
+    std::lock_guard<std::mutex> lock(data.mutex);
+    if (!data.recording)
+      return;
+
+    if (!data.firstFrame)
+      data.firstFrame = now;
+
+    std::chrono::steady_clock::time_point stamp;
+    if (data.perFrame)
+    {
+      // Every rendered frame is a video frame, spaced as if it was
+      // rendered at the video's frame rate
+      stamp = *data.firstFrame + period * data.frameCount;
+    }
+    else
+    {
+      // The encoder keeps one frame per period, so frames it would drop
+      // aren't copied
+      stamp = now;
+      auto due = *data.firstFrame + period * data.frameCount;
+      if (data.frameCount > 0u && stamp < due)
+        return;
+    }
+
+    if (data.queuedFrames >= VideoRecorderPrivate::kMaxQueuedFrames)
+    {
+      if (data.dropped++ == 0u)
+      {
+        gzwarn << "Video encoder can't keep up, dropping frames"
+               << std::endl;
+      }
+      return;
+    }
+    ++data.frameCount;
+    ++data.queuedFrames;
+    job.stamp = stamp;
+
+    while (!data.freeImages.empty())
+    {
+      auto image = std::move(data.freeImages.back());
+      data.freeImages.pop_back();
+      if (image.Width() == width && image.Height() == height)
+      {
+        job.image = std::move(image);
+        break;
+      }
+    }
+  }
+
+  // The copy from the GPU is the only part done on the render thread
+  if (job.image.Width() != width || job.image.Height() != height)
+    job.image = data.userCamera->CreateImage();
+  data.userCamera->Copy(job.image);
+
+  {
+    std::lock_guard<std::mutex> lock(data.mutex);
+    data.jobs.push_back(std::move(job));
+  }
+  data.workerCv.notify_one();
+}
+
+/////////////////////////////////////////////////
+void VideoRecorderPrivate::FindUserCamera()
+{
+  if (nullptr != this->userCamera)
+    return;
+
+  auto scene = rendering::sceneFromFirstRenderEngine();
+  if (nullptr == scene)
+    return;
+
+  for (unsigned int i = 0; i < scene->NodeCount(); ++i)
+  {
+    auto cam = std::dynamic_pointer_cast<rendering::Camera>(
+        scene->NodeByIndex(i));
+    if (nullptr != cam)
+    {
+      this->userCamera = cam;
+      gzdbg << "Video recorder recording camera [" << cam->Name() << "]"
+            << std::endl;
+      break;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void VideoRecorderPrivate::ProcessWorker()
+{
+  common::VideoEncoder encoder;
+  bool started = false;
+  bool failed = false;
+  std::string path;
+  std::string format;
+
+  while (true)
+  {
+    VideoJob job;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->workerCv.wait(lock, [this]
+      {
+        return this->stopWorker || !this->jobs.empty();
+      });
+      if (this->jobs.empty())
+        return;
+      job = std::move(this->jobs.front());
+      this->jobs.pop_front();
+    }
+
+    switch (job.kind)
+    {
+      case VideoJob::Kind::kStart:
+      {
+        // The encoder is started with the first frame, once its size
+        // is known
+        path = job.path;
+        format = job.format;
+        started = false;
+        failed = false;
+        break;
+      }
+      case VideoJob::Kind::kFrame:
+      {
+        if (!started && !failed)
+        {
+          started = encoder.Start(format, path, job.image.Width(),
+              job.image.Height(), this->fps, this->bitrate, this->hwAccel);
+          if (!started)
+          {
+            gzerr << "Failed to start recording [" << path << "]"
+                  << std::endl;
+            failed = true;
+            this->Stop();
+            this->onDone(path, false);
+          }
+        }
+        if (started)
+        {
+          encoder.AddFrame(job.image.Data<unsigned char>(),
+              job.image.Width(), job.image.Height(), job.stamp);
+        }
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        --this->queuedFrames;
+        this->freeImages.push_back(std::move(job.image));
+        break;
+      }
+      case VideoJob::Kind::kStop:
+      {
+        if (!started)
+          break;
+        started = false;
+        if (encoder.SaveToFile(path))
+        {
+          gzdbg << "Saved video to [" << path << "]" << std::endl;
+          this->onDone(path, true);
+        }
+        else
+        {
+          gzerr << "Failed to save video [" << path << "]" << std::endl;
+          this->onDone(path, false);
+        }
+        break;
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+bool VideoRecorder::Recording() const
+{
+  return this->dataPtr->recordingValue;
+}
+
+/////////////////////////////////////////////////
+QString VideoRecorder::SavedPath() const
+{
+  return this->dataPtr->savedPath;
+}
+
+/////////////////////////////////////////////////
+void VideoRecorder::SetRecording(bool _recording)
+{
+  if (this->dataPtr->recordingValue == _recording)
+    return;
+  this->dataPtr->recordingValue = _recording;
+  this->RecordingChanged();
+}
+
+// Register this plugin
+GZ_GUI_ADD_PLUGIN(VideoRecorder, "VideoRecorder")
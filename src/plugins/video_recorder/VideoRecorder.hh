@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_PLUGINS_VIDEORECORDER_HH_
+#define GZ_GUI_PLUGINS_VIDEORECORDER_HH_
+
+#include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/video_record.pb.h>
+
+#include <memory>
+
+#include "gz/gui/qt.h"
+#include "gz/gui/Plugin.hh"
+
+namespace gz
+{
+namespace gui
+{
+namespace plugins
+{
+  class VideoRecorderPrivate;
+
+  /// \brief Records the user camera of the 3D scene to a video file.
+  ///
+  /// Frames are copied from the camera on the render thread, then encoded
+  /// and written on a worker thread with gz::common::VideoEncoder, which
+  /// uses a hardware encoder such as NVENC or VAAPI when one is allowed
+  /// through the `GZ_VIDEO_ALLOWED_ENCODERS` environment variable.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<format\> : Video format, such as mp4, the default, or ogv.
+  /// * \<fps\> : Frame rate of the video, 25 by default.
+  /// * \<bitrate\> : Bit rate of the video, 2070000 by default.
+  /// * \<capture\> : `fixed` to capture at \<fps\> in wall clock time, which
+  ///               is the default, or `frame` to capture every rendered
+  ///               frame, so the video plays at \<fps\> regardless of the
+  ///               render rate.
+  /// * \<hw_accel\> : False to never use a hardware encoder, true by
+  ///               default.
+  /// * \<service\> : Service to start and stop recording, with a
+  ///               gz.msgs.VideoRecord, `/gui/video_recorder` by default.
+  ///
+  /// Videos are saved to `~/.gz/gui/videos` unless the request has a
+  /// filename.
+  class VideoRecorder : public Plugin
+  {
+    Q_OBJECT
+
+    /// \brief True while recording
+    Q_PROPERTY(
+      bool recording
+      READ Recording
+      NOTIFY RecordingChanged
+    )
+
+    /// \brief Path of the last saved video
+    Q_PROPERTY(
+      QString savedPath
+      READ SavedPath
+      NOTIFY SavedPathChanged
+    )
+
+    /// \brief Constructor
+    public: VideoRecorder();
+
+    /// \brief Destructor
+    public: ~VideoRecorder() override;
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem) override;
+
+    /// \brief Start or stop recording from the GUI.
+    /// \param[in] _start True to start, false to stop
+    public slots: void OnRecord(bool _start);
+
+    /// \brief Get whether a video is being recorded
+    /// \return True while recording
+    public: Q_INVOKABLE bool Recording() const;
+
+    /// \brief Get the path of the last saved video
+    /// \return Path, empty if none was saved yet
+    public: Q_INVOKABLE QString SavedPath() const;
+
+    /// \brief Notify that recording started or stopped
+    signals: void RecordingChanged();
+
+    /// \brief Notify that a video was saved
+    signals: void SavedPathChanged();
+
+    /// \brief Callback for the record service
+    /// \param[in] _msg Request to start or stop recording
+    /// \param[in] _res True if the request was accepted
+    /// \return True if the request is received
+    private: bool RecordService(const msgs::VideoRecord &_msg,
+        msgs::Boolean &_res);
+
+    /// \brief Capture a frame, on the render thread
+    private: void OnRender();
+
+    /// \brief Set the recording state on the GUI thread
+    /// \param[in] _recording True while recording
+    private: void SetRecording(bool _recording);
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<VideoRecorderPrivate> dataPtr;
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+import QtQuick 2.9
+import QtQuick.Controls 2.1
+import QtQuick.Layouts 1.3
+
+Rectangle {
+  id: videoRecorder
+  color: "transparent"
+  Layout.minimumWidth: 200
+  Layout.minimumHeight: 80
+
+  RowLayout {
+    anchors.fill: parent
+    anchors.margins: 10
+
+    Button {
+      id: record
+      objectName: "record"
+      text: VideoRecorder.recording ? qsTr("Stop") : qsTr("Record")
+      ToolTip.text: VideoRecorder.recording ?
+          qsTr("Stop recording and save the video") :
+          qsTr("Record the 3D scene to a video")
+      ToolTip.visible: hovered
+      ToolTip.delay: Qt.styleHints.mousePressAndHoldInterval
+      onClicked: {
+        VideoRecorder.OnRecord(!VideoRecorder.recording)
+      }
+    }
+
+    Label {
+      objectName: "savedPath"
+      text: VideoRecorder.savedPath
+      elide: Text.ElideLeft
+      Layout.fillWidth: true
+      ToolTip.text: VideoRecorder.savedPath
+    }
+  }
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/video_record.pb.h>
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include <gz/common/Console.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/Plugin.hh"
+#include "VideoRecorder.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./VideoRecorder_TEST")),
+};
+
+using namespace gz;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(VideoRecorderTest, GZ_UTILS_TEST_DISABLED_ON_WIN32(Service))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  const char *pluginStr =
+    "<plugin filename=\"VideoRecorder\">"
+      "<service>/test/video_recorder</service>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  EXPECT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+  EXPECT_TRUE(app.LoadPlugin("VideoRecorder",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto window = app.findChild<MainWindow *>();
+  ASSERT_NE(window, nullptr);
+
+  auto plugins = window->findChildren<plugins::VideoRecorder *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+  EXPECT_FALSE(plugin->Recording());
+
+  transport::Node node;
+  auto request = [&](bool _start)
+  {
+    msgs::VideoRecord req;
+    req.set_start(_start);
+    req.set_stop(!_start);
+    req.set_save_filename(std::string(PROJECT_BINARY_PATH) +
+        "/VideoRecorder_TEST.mp4");
+    msgs::Boolean rep;
+    bool result{false};
+    EXPECT_TRUE(node.Request("/test/video_recorder", req, 1000, rep,
+        result));
+    EXPECT_TRUE(result);
+    return rep.data();
+  };
+
+  // Stopping when not recording is rejected
+  EXPECT_FALSE(request(false));
+
+  // Starting twice is rejected
+  EXPECT_TRUE(request(true));
+  EXPECT_FALSE(request(true));
+
+  // The GUI state is updated on the main thread
+  QCoreApplication::processEvents();
+  EXPECT_TRUE(plugin->Recording());
+
+  // Without a scene no frame is captured, and no video is saved
+  EXPECT_TRUE(request(false));
+  QCoreApplication::processEvents();
+  EXPECT_FALSE(plugin->Recording());
+  EXPECT_TRUE(plugin->SavedPath().isEmpty());
+}
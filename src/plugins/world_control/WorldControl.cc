@@ -17,11 +17,14 @@
 
 #include "WorldControl.hh"
 
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <string>
 
 #include <gz/msgs/boolean.pb.h>
 #include <gz/msgs/world_control.pb.h>
-#include <gz/msgs/world_stats.pb.h>
 
 #include <gz/common/Console.hh>
 #include <gz/common/StringUtils.hh>
@@ -32,6 +35,13 @@
 #include "gz/gui/Helpers.hh"
 #include "gz/gui/GuiEvents.hh"
 #include "gz/gui/MainWindow.hh"
+#include "gz/gui/ServiceRequest.hh"
+#include "gz/gui/SimClock.hh"
+#include "gz/gui/StaticPlugins.hh"
+
+/// \brief Time after which a request without a reply stops holding back
+/// the next one, so a missing server doesn't block the controls
+static constexpr std::chrono::milliseconds kReplyTimeout{1000};
 
 namespace gz
 {
@@ -45,14 +55,28 @@ namespace plugins
     /// \param[in] _msg Message to send.
     public: void SendEventMsg(const gz::msgs::WorldControl &_msg);
 
-    /// \brief Message holding latest world statistics
-    public: gz::msgs::WorldStatistics msg;
+    /// \brief Send the pending play / pause and steps as a single request,
+    /// unless a request is still waiting for its reply.
+    public: void Flush();
 
     /// \brief Service to send world control requests
     public: std::string controlService;
 
-    /// \brief Mutex to protect msg
-    public: std::recursive_mutex mutex;
+    /// \brief Latest world statistics, shared with other plugins
+    public: std::shared_ptr<SimClock> clock;
+
+    /// \brief Pause state requested since the last request, only the last
+    /// one counts
+    public: std::optional<bool> pendingPause;
+
+    /// \brief Steps requested since the last request
+    public: unsigned int pendingSteps{0u};
+
+    /// \brief Plugin, on whose thread the replies are delivered
+    public: QObject *plugin{nullptr};
+
+    /// \brief Service request waiting for its reply
+    public: ServiceRequest request;
 
     /// \brief Communication node
     public: gz::transport::Node node;
@@ -84,6 +108,7 @@ using namespace plugins;
 WorldControl::WorldControl()
   : Plugin(), dataPtr(new WorldControlPrivate)
 {
+  this->dataPtr->plugin = this;
 }
 
 /////////////////////////////////////////////////
@@ -226,15 +251,11 @@ void WorldControl::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
   statsTopic = transport::TopicUtils::AsValidTopic(statsTopic);
   if (!statsTopic.empty())
   {
-    // Subscribe to world_stats
-    if (!this->dataPtr->node.Subscribe(statsTopic,
-        &WorldControl::OnWorldStatsMsg, this))
-    {
-      gzerr << "Failed to subscribe to [" << statsTopic << "]" << std::endl;
-    }
-    else
+    this->dataPtr->clock = SimClock::ForTopic(statsTopic);
+    if (this->dataPtr->clock)
     {
-      gzmsg << "Listening to stats on [" << statsTopic << "]" << std::endl;
+      this->connect(this->dataPtr->clock.get(), &SimClock::Updated, this,
+          &WorldControl::ProcessMsg);
     }
   }
   else
@@ -255,16 +276,13 @@ void WorldControl::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 /////////////////////////////////////////////////
 void WorldControl::ProcessMsg()
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->clock)
+    return;
 
   // ignore the message if it's associated with a step
-  const auto &header = this->dataPtr->msg.header();
-  if (this->dataPtr->msg.stepping() ||
-      // (deprecated) Remove this check in Gazebo H
-      ((header.data_size() > 0) && (header.data(0).key() == "step")))
-  {
+  auto stats = this->dataPtr->clock->Latest();
+  if (stats.stepping)
     return;
-  }
 
   // If the pause state of the message doesn't match the pause state of this
   // plugin, then play/pause must have occurred elsewhere (for example, the
@@ -272,43 +290,31 @@ void WorldControl::ProcessMsg()
   // of this plugin, but the pause state of the message differs from the
   // previous message's pause state, this means that a pause/play request from
   // this plugin has been registered by the server
-  if (this->dataPtr->msg.paused() &&
+  if (stats.paused &&
       (!this->dataPtr->pause || !this->dataPtr->lastStatsMsgPaused))
     this->paused();
-  else if (!this->dataPtr->msg.paused() &&
+  else if (!stats.paused &&
       (this->dataPtr->pause || this->dataPtr->lastStatsMsgPaused))
     this->playing();
 
-  this->dataPtr->pause = this->dataPtr->msg.paused();
-  this->dataPtr->lastStatsMsgPaused = this->dataPtr->msg.paused();
-}
-
-/////////////////////////////////////////////////
-void WorldControl::OnWorldStatsMsg(const msgs::WorldStatistics &_msg)
-{
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
-
-  this->dataPtr->msg.CopyFrom(_msg);
-  QMetaObject::invokeMethod(this, "ProcessMsg");
+  this->dataPtr->pause = stats.paused;
+  this->dataPtr->lastStatsMsgPaused = stats.paused;
 }
 
 /////////////////////////////////////////////////
 void WorldControl::OnPlay()
 {
-  msgs::WorldControl msg;
-  msg.set_pause(false);
   this->dataPtr->pause = false;
-  this->dataPtr->SendEventMsg(msg);
+  this->dataPtr->pendingPause = false;
+  this->dataPtr->Flush();
 }
 
 /////////////////////////////////////////////////
 void WorldControl::OnPause()
 {
-  msgs::WorldControl msg;
-  msg.set_pause(true);
   this->dataPtr->pause = true;
-
-  this->dataPtr->SendEventMsg(msg);
+  this->dataPtr->pendingPause = true;
+  this->dataPtr->Flush();
 }
 
 /////////////////////////////////////////////////
@@ -320,6 +326,10 @@ void WorldControl::OnReset()
   msg.set_pause(true);
   msg.set_allocated_reset(msgReset);
 
+  // Steps and play / pause requested before the reset don't apply to the
+  // reset world
+  this->dataPtr->pendingPause.reset();
+  this->dataPtr->pendingSteps = 0u;
   this->dataPtr->SendEventMsg(msg);
 }
 
@@ -332,11 +342,29 @@ void WorldControl::OnStepCount(const unsigned int _steps)
 /////////////////////////////////////////////////
 void WorldControl::OnStep()
 {
+  this->dataPtr->pendingSteps += this->dataPtr->multiStep;
+  this->dataPtr->Flush();
+}
+
+/////////////////////////////////////////////////
+void WorldControlPrivate::Flush()
+{
+  if (!this->pendingPause && this->pendingSteps == 0u)
+    return;
+
+  // Wait for the reply to the previous request, which sends the requests
+  // made meanwhile as one
+  if (this->request.Pending())
+    return;
+
   msgs::WorldControl msg;
-  msg.set_pause(this->dataPtr->pause);
-  msg.set_multi_step(this->dataPtr->multiStep);
+  msg.set_pause(this->pendingPause.value_or(this->pause));
+  if (this->pendingSteps > 0u)
+    msg.set_multi_step(this->pendingSteps);
 
-  this->dataPtr->SendEventMsg(msg);
+  this->pendingPause.reset();
+  this->pendingSteps = 0u;
+  this->SendEventMsg(msg);
 }
 
 /////////////////////////////////////////////////
@@ -349,16 +377,18 @@ void WorldControlPrivate::SendEventMsg(const msgs::WorldControl &_msg)
   }
   else
   {
-    std::function<void(const msgs::Boolean &, const bool)> cb =
-        [](const msgs::Boolean &/*_rep*/, const bool /*_result*/)
+    // The state is updated in WorldControl::ProcessMsg, the reply, or
+    // its timeout, only tells that the next request can be sent
+    std::function<void(const msgs::Boolean &, ServiceRequest::Result)> cb =
+        [this](const msgs::Boolean &/*_rep*/,
+               ServiceRequest::Result /*_result*/)
     {
-      // the service CB is empty because updates are handled in
-      // WorldControl::ProcessMsg
+      this->Flush();
     };
-    this->node.Request(this->controlService, _msg, cb);
+    this->request = ServiceRequest::Send(this->node, this->controlService,
+        _msg, kReplyTimeout, this->plugin, cb);
   }
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(WorldControl,
-              gui::Plugin)
+GZ_GUI_ADD_PLUGIN(WorldControl, "WorldControl")
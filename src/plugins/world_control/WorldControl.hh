@@ -60,6 +60,11 @@ namespace plugins
   ///
   /// If no elements are filled for the plugin, both the play/pause and the
   /// step buttons will be displayed.
+  ///
+  /// Only one service request is in flight at a time. Steps and play /
+  /// pause clicked while it waits for its reply are sent as a single
+  /// request once it comes: the steps are added up into one multi-step and
+  /// only the last play / pause is kept. A reset is always sent right away.
   class WorldControl_EXPORTS_API WorldControl: public gz::gui::Plugin
   {
     Q_OBJECT
@@ -73,7 +78,7 @@ namespace plugins
     // Documentation inherited
     public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem);
 
-    /// \brief Callback in main thread when diagnostics come in
+    /// \brief Callback in main thread when new world statistics come in
     public slots: void ProcessMsg();
 
     /// \brief Callback in Qt thread when play button is clicked.
@@ -101,9 +106,6 @@ namespace plugins
     /// \brief Notify that it's now resetted.
     signals: void reset();
 
-    /// \brief Subscriber callback when new world statistics are received
-    private: void OnWorldStatsMsg(const gz::msgs::WorldStatistics &_msg);
-
     // Private data
     private: std::unique_ptr<WorldControlPrivate> dataPtr;
   };
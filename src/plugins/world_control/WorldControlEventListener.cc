@@ -23,7 +23,8 @@ using namespace gui;
 WorldControlEventListener::WorldControlEventListener()
 {
   gz::gui::App()->findChild<
-    gz::gui::MainWindow *>()->installEventFilter(this);
+    gz::gui::MainWindow *>()->SubscribeEvent(
+        gz::gui::events::WorldControl::kType, this);
 }
 
 WorldControlEventListener::~WorldControlEventListener() = default;
@@ -17,7 +17,15 @@
 
 #include "WorldStats.hh"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 
 #include <gz/msgs/world_stats.pb.h>
 
@@ -28,6 +36,8 @@
 #include <gz/transport/Node.hh>
 
 #include "gz/gui/Helpers.hh"
+#include "gz/gui/SimClock.hh"
+#include "gz/gui/StaticPlugins.hh"
 
 namespace gz
 {
@@ -37,14 +47,26 @@ namespace plugins
 {
   class WorldStatsPrivate
   {
-    /// \brief Message holding latest world statistics
-    public: gz::msgs::WorldStatistics msg;
+    /// \brief Latest world statistics, shared with other plugins
+    public: std::shared_ptr<SimClock> clock;
 
-    /// \brief Mutex to protect msg
-    public: std::recursive_mutex mutex;
+    /// \brief Version of the statistics last shown
+    public: uint64_t shownVersion{0u};
 
-    /// \brief Communication node
-    public: gz::transport::Node node;
+    /// \brief Updates the display at a fixed rate, however fast the
+    /// statistics come
+    public: QTimer displayTimer;
+
+    /// \brief Real and sim times in nanoseconds sampled on the display
+    /// clock over the last kRtfWindowNs of real time, to estimate the real
+    /// time factor
+    public: std::deque<std::pair<int64_t, int64_t>> rtfWindow;
+
+    /// \brief Span of real time the real time factor is estimated over
+    public: static constexpr int64_t kRtfWindowNs{1000000000};
+
+    /// \brief Display rate in Hz
+    public: static constexpr int kDisplayRate{10};
 
     /// \brief Holds real time factor
     public: QString realTimeFactor;
@@ -57,14 +79,6 @@ namespace plugins
 
     /// \brief Holds iterations
     public: QString iterations;
-
-    /// \brief Time delayed version if simTime used for computing a low-pass
-    /// filtered RTF
-    public: std::optional<double> simTimeDelayed;
-
-    /// \brief Time delayed version if realTime used for computing a low-pass
-    /// filtered RTF
-    public: std::optional<double> realTimeDelayed;
   };
 }
 }
@@ -74,10 +88,30 @@ using namespace gz;
 using namespace gui;
 using namespace plugins;
 
+/////////////////////////////////////////////////
+/// \brief Format a time like math::timePointToString, without streams
+/// \param[in] _ns Time in nanoseconds
+/// \return Time as "DD hh:mm:ss.mmm"
+static QString formatTime(int64_t _ns)
+{
+  int64_t ms = std::max<int64_t>(0, _ns) / 1000000;
+  char text[32];
+  std::snprintf(text, sizeof(text), "%02lld %02d:%02d:%02d.%03d",
+      static_cast<long long>(ms / 86400000),
+      static_cast<int>(ms / 3600000 % 24),
+      static_cast<int>(ms / 60000 % 60),
+      static_cast<int>(ms / 1000 % 60),
+      static_cast<int>(ms % 1000));
+  return QString::fromLatin1(text);
+}
+
 /////////////////////////////////////////////////
 WorldStats::WorldStats()
   : Plugin(), dataPtr(new WorldStatsPrivate)
 {
+  this->connect(&this->dataPtr->displayTimer, &QTimer::timeout, this,
+      &WorldStats::ProcessMsg);
+  this->dataPtr->displayTimer.start(1000 / WorldStatsPrivate::kDisplayRate);
 }
 
 /////////////////////////////////////////////////
@@ -158,14 +192,9 @@ void WorldStats::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
     return;
   }
 
-  if (!this->dataPtr->node.Subscribe(topic, &WorldStats::OnWorldStatsMsg,
-      this))
-  {
-    gzerr << "Failed to subscribe to [" << topic << "]" << std::endl;
+  this->dataPtr->clock = SimClock::ForTopic(topic);
+  if (!this->dataPtr->clock)
     return;
-  }
-
-  gzmsg << "Listening to stats on [" << topic << "]" << std::endl;
 
   // Sim time
   if (auto simTimeElem = _pluginElem->FirstChildElement("sim_time"))
@@ -213,81 +242,95 @@ void WorldStats::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 /////////////////////////////////////////////////
 void WorldStats::ProcessMsg()
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->clock)
+    return;
 
-  std::chrono::steady_clock::time_point simTimePoint;
-  std::chrono::steady_clock::time_point realTimePoint;
+  auto snapshot = this->dataPtr->clock->Latest();
+  if (snapshot.version == this->dataPtr->shownVersion)
+    return;
+  this->dataPtr->shownVersion = snapshot.version;
+
+  auto toNs = [](std::chrono::steady_clock::duration _time)
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        _time).count();
+  };
+  const int64_t simTimeNs = toNs(snapshot.simTime);
+  const int64_t realTimeNs = toNs(snapshot.realTime);
 
-  if (this->dataPtr->msg.has_sim_time())
+  // Properties are only notified when their text changes, so QML doesn't
+  // lay out text which didn't change, and all changes are notified
+  // together on the next frame
+  if (snapshot.hasSimTime)
   {
-    simTimePoint = math::secNsecToTimePoint(
-        this->dataPtr->msg.sim_time().sec(),
-        this->dataPtr->msg.sim_time().nsec());
-    this->SetSimTime(QString::fromStdString(
-      math::timePointToString(simTimePoint)));
+    auto simTime = formatTime(simTimeNs);
+    if (simTime != this->dataPtr->simTime)
+    {
+      this->dataPtr->simTime = simTime;
+      this->NotifyChanged("simTime");
+    }
   }
 
-  if (this->dataPtr->msg.has_real_time())
+  if (snapshot.hasRealTime)
   {
-    realTimePoint = math::secNsecToTimePoint(
-        this->dataPtr->msg.real_time().sec(),
-        this->dataPtr->msg.real_time().nsec());
-    this->SetRealTime(QString::fromStdString(
-      math::timePointToString(realTimePoint)));
+    auto realTime = formatTime(realTimeNs);
+    if (realTime != this->dataPtr->realTime)
+    {
+      this->dataPtr->realTime = realTime;
+      this->NotifyChanged("realTime");
+    }
   }
 
+  std::optional<double> rtf;
+  auto &window = this->dataPtr->rtfWindow;
+  // Messages without a real time bring their own real time factor
+  if (!snapshot.latestHasRealTime || realTimeNs <= 0)
   {
-    const double simTimeCount =
-        static_cast<double>(simTimePoint.time_since_epoch().count());
-    const double realTimeCount =
-        static_cast<double>(realTimePoint.time_since_epoch().count());
+    window.clear();
+    rtf = snapshot.realTimeFactor;
+  }
+  else
+  {
+    // Restarted, such as on a world reset
+    if (!window.empty() && realTimeNs < window.back().first)
+      window.clear();
 
-    if (realTimeCount > 0)
+    if (window.empty() || realTimeNs != window.back().first)
+      window.emplace_back(realTimeNs, simTimeNs);
+
+    // Keep a single sample older than the window, so it's always spanned
+    while (window.size() > 2 && window.back().first - window[1].first >=
+        WorldStatsPrivate::kRtfWindowNs)
     {
-      constexpr double kAlpha = 0.9;
-      this->dataPtr->simTimeDelayed =
-        kAlpha * this->dataPtr->simTimeDelayed.value_or(simTimeCount) +
-        (1.0 - kAlpha) * simTimeCount;
-
-      this->dataPtr->realTimeDelayed =
-        kAlpha * this->dataPtr->realTimeDelayed.value_or(realTimeCount) +
-        (1.0 - kAlpha) * realTimeCount;
-
-      // Compute the average sim and real times.
-      const double realTimeFiltered =
-          realTimeCount - (*this->dataPtr->realTimeDelayed);
-      const double simTimeFiltered =
-          simTimeCount - (*this->dataPtr->simTimeDelayed);
-
-      // RTF, only compute this if the realTime count is greater than zero. The
-      // realtTime count could be zero if simulation was started paused.
-      if (realTimeFiltered > 0)
-      {
-        const double rtf =
-            math::precision(simTimeFiltered / realTimeFiltered, 4) * 100;
-        this->SetRealTimeFactor(QString::number(rtf, 'f', 2) + " %");
-      }
+      window.pop_front();
     }
-    else
+
+    // The real time could be zero if simulation was started paused
+    const int64_t realSpan = window.back().first - window.front().first;
+    if (realSpan > 0)
     {
-      // RTF as a percentage.
-      double rtf = this->dataPtr->msg.real_time_factor() * 100;
-      this->SetRealTimeFactor(QString::number(rtf, 'f', 2) + " %");
+      rtf = math::precision(static_cast<double>(
+          window.back().second - window.front().second) / realSpan, 4);
     }
   }
 
+  if (rtf)
   {
-    this->SetIterations(QString::number(this->dataPtr->msg.iterations()));
+    // RTF as a percentage.
+    auto realTimeFactor = QString::number(*rtf * 100, 'f', 2) + " %";
+    if (realTimeFactor != this->dataPtr->realTimeFactor)
+    {
+      this->dataPtr->realTimeFactor = realTimeFactor;
+      this->NotifyChanged("realTimeFactor");
+    }
   }
-}
-
-/////////////////////////////////////////////////
-void WorldStats::OnWorldStatsMsg(const msgs::WorldStatistics &_msg)
-{
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
 
-  this->dataPtr->msg.CopyFrom(_msg);
-  QMetaObject::invokeMethod(this, "ProcessMsg");
+  auto iterations = QString::number(snapshot.iterations);
+  if (iterations != this->dataPtr->iterations)
+  {
+    this->dataPtr->iterations = iterations;
+    this->NotifyChanged("iterations");
+  }
 }
 
 /////////////////////////////////////////////////
@@ -343,5 +386,4 @@ void WorldStats::SetIterations(const QString &_iterations)
 }
 
 // Register this plugin
-GZ_ADD_PLUGIN(WorldStats,
-              gui::Plugin)
+GZ_GUI_ADD_PLUGIN(WorldStats, "WorldStats")
@@ -63,6 +63,11 @@ namespace plugins
   ///
   /// If no elements are filled for the plugin, all properties will be
   /// displayed.
+  ///
+  /// The display is refreshed 10 times per second with the latest
+  /// statistics, however fast they're published. The real time factor is
+  /// estimated from the sim and real times over the last second, or taken
+  /// from the messages if they have no real time.
   class WorldStats_EXPORTS_API WorldStats: public gz::gui::Plugin
   {
     Q_OBJECT
@@ -108,7 +113,8 @@ namespace plugins
     // Documentation inherited
     public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem);
 
-    /// \brief Callback in main thread when diagnostics come in
+    /// \brief Callback in main thread on the display clock, which shows
+    /// the latest statistics if there are new ones
     public slots: void ProcessMsg();
 
     /// \brief Get the message type as a string, for example
@@ -155,9 +161,6 @@ namespace plugins
     /// \brief Notify that message type has changed
     signals: void IterationsChanged();
 
-    /// \brief Subscriber callback when new world statistics are received
-    private: void OnWorldStatsMsg(const gz::msgs::WorldStatistics &_msg);
-
     // Private data
     private: std::unique_ptr<WorldStatsPrivate> dataPtr;
   };
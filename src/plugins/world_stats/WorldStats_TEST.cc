@@ -365,3 +365,75 @@ TEST(WorldStatsTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(WorldNameNoProp))
 
   EXPECT_EQ(plugin->SimTime().toStdString(), "00 01:00:00.123");
 }
+
+/////////////////////////////////////////////////
+TEST(WorldStatsTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(BatchedNotify))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  const char *pluginStr =
+    "<plugin filename=\"WorldStats\">"
+      "<sim_time>true</sim_time>"
+      "<real_time>true</real_time>"
+      "<topic>/world_stats_batched</topic>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("WorldStats",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  auto plugin = win->findChild<plugins::WorldStats *>();
+  ASSERT_NE(nullptr, plugin);
+
+  int simTimeNotified{0};
+  int realTimeNotified{0};
+  plugin->connect(plugin, &plugins::WorldStats::SimTimeChanged,
+      [&simTimeNotified]{++simTimeNotified;});
+  plugin->connect(plugin, &plugins::WorldStats::RealTimeChanged,
+      [&realTimeNotified]{++realTimeNotified;});
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::WorldStatistics>("/world_stats_batched");
+  {
+    msgs::WorldStatistics msg;
+    msg.mutable_sim_time()->set_sec(3600);
+    msg.mutable_real_time()->set_sec(7200);
+    pub.Publish(msg);
+  }
+
+  // The values change right away, the notifications come together later
+  int sleep = 0;
+  int maxSleep = 30;
+  while (simTimeNotified == 0 && sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    QCoreApplication::processEvents();
+    sleep++;
+  }
+
+  EXPECT_EQ(plugin->SimTime().toStdString(), "00 01:00:00.000");
+  EXPECT_EQ(plugin->RealTime().toStdString(), "00 02:00:00.000");
+  EXPECT_EQ(1, simTimeNotified);
+  EXPECT_EQ(1, realTimeNotified);
+
+  auto simTimeText = plugin->PluginItem()->findChild<QObject *>(
+      "simTimeValue");
+  ASSERT_NE(nullptr, simTimeText);
+  EXPECT_EQ(simTimeText->property("text").toString(), "00 01:00:00.000");
+
+  // Nothing else is notified without new statistics
+  for (int i = 0; i < 5; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    QCoreApplication::processEvents();
+  }
+  EXPECT_EQ(1, simTimeNotified);
+  EXPECT_EQ(1, realTimeNotified);
+}
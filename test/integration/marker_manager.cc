@@ -20,6 +20,7 @@
 
 #include <gz/msgs/world_stats.pb.h>
 #include <gz/msgs/marker.pb.h>
+#include <gz/msgs/marker_v.pb.h>
 #include <gz/msgs/material.pb.h>
 
 #include <gz/common/Console.hh>
@@ -28,6 +29,7 @@
 #include <gz/rendering/RenderEngine.hh>
 #include <gz/rendering/RenderingIface.hh>
 #include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
 #include <gz/transport/Node.hh>
 #include <gz/utils/ExtraTestMacros.hh>
 
@@ -36,6 +38,7 @@
 #include "gz/gui/GuiEvents.hh"
 #include "gz/gui/MainWindow.hh"
 #include "gz/gui/Plugin.hh"
+#include "gz/gui/QueueStats.hh"
 
 int g_argc = 1;
 char* g_argv[] =
@@ -204,6 +207,41 @@ TEST_F(MarkerManagerTestFixture,
     FAIL();
   }
 
+  // A second sphere, far from the first
+  markerMsg.set_id(2);
+  gz::msgs::Set(markerMsg.mutable_pose(),
+                      gz::math::Pose3d(20, 20, 0, 0, 0, 0));
+  ASSERT_TRUE(node.Request("/marker", markerMsg));
+  waitAndSendStatsMsgs(timePoint, 2, 200);
+  EXPECT_EQ(2u, scene->VisualCount());
+
+  // Only the second one is in its region
+  auto addRegion = [](gz::msgs::Marker &_msg)
+  {
+    auto data = _msg.mutable_header()->add_data();
+    data->set_key("region_min");
+    data->add_value("15 15 -1");
+    data = _msg.mutable_header()->add_data();
+    data->set_key("region_max");
+    data->add_value("25 25 1");
+  };
+  gz::msgs::Marker listReq;
+  addRegion(listReq);
+  gz::msgs::Marker_V listRep;
+  bool result{false};
+  ASSERT_TRUE(node.Request("/marker/list", listReq, 1000, listRep, result));
+  EXPECT_TRUE(result);
+  ASSERT_EQ(1, listRep.marker_size());
+  EXPECT_EQ(2u, listRep.marker(0).id());
+
+  // Deleting the region leaves the first one
+  gz::msgs::Marker regionMsg;
+  regionMsg.set_action(gz::msgs::Marker::DELETE_ALL);
+  addRegion(regionMsg);
+  ASSERT_TRUE(node.Request("/marker", regionMsg));
+  waitAndSendStatsMsgs(timePoint, 1, 200);
+  EXPECT_EQ(1u, scene->VisualCount());
+
   markerMsg.set_action(gz::msgs::Marker::DELETE_ALL);
   executed = node.Request("/marker", markerMsg);
   if (executed)
@@ -216,6 +254,44 @@ TEST_F(MarkerManagerTestFixture,
     FAIL();
   }
 
+  // Frames are scheduled by the event loop, so none start while events
+  // aren't processed, and both modifications arrive within a frame
+  auto markerDepth = []
+  {
+    for (const auto &usage : QueueStats::CurrentUsage())
+    {
+      if (usage.name == "MarkerManager/markers")
+        return usage.depth;
+    }
+    return uint64_t{0u};
+  };
+  std::this_thread::sleep_for(200ms);
+  EXPECT_EQ(0u, markerDepth());
+
+  markerMsg.set_id(3);
+  markerMsg.set_action(gz::msgs::Marker::ADD_MODIFY);
+  gz::msgs::Set(markerMsg.mutable_pose(),
+                      gz::math::Pose3d(1, 1, 0, 0, 0, 0));
+  ASSERT_TRUE(node.Request("/marker", markerMsg));
+
+  gz::msgs::Marker moveMsg;
+  moveMsg.set_ns("default");
+  moveMsg.set_id(3);
+  moveMsg.set_action(gz::msgs::Marker::ADD_MODIFY);
+  gz::msgs::Set(moveMsg.mutable_pose(),
+                      gz::math::Pose3d(5, 5, 0, 0, 0, 0));
+  ASSERT_TRUE(node.Request("/marker", moveMsg));
+
+  // Both are merged into one update
+  std::this_thread::sleep_for(500ms);
+  EXPECT_EQ(1u, markerDepth());
+
+  waitAndSendStatsMsgs(timePoint, 1, 200);
+  ASSERT_EQ(1u, scene->VisualCount());
+  EXPECT_EQ(gz::math::Vector3d(5, 5, 0),
+      scene->VisualByIndex(0)->WorldPose().Pos());
+  EXPECT_EQ(0u, markerDepth());
+
   // Cleanup
   plugins.clear();
 }
@@ -17,6 +17,12 @@
 
 #include <gtest/gtest.h>
 #include <QtTest/QtTest>
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <thread>
+
 #include <gz/common/Console.hh>
 #include <gz/math/Color.hh>
 #include <gz/math/Pose3.hh>
@@ -174,3 +180,85 @@ TEST(MinimalSceneTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Config))
   engine->DestroyScene(scene);
   EXPECT_TRUE(rendering::unloadEngine(engine->Name()));
 }
+
+/////////////////////////////////////////////////
+TEST(MinimalSceneTest, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(IdleSceneChanged))
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  // Stops rendering once idle, and only renders changes
+  const char *pluginStr =
+    "<plugin filename=\"MinimalScene\">"
+      "<engine>ogre</engine>"
+      "<scene>idle</scene>"
+      "<frame_pacing>"
+      "  <idle_fps>0</idle_fps>"
+      "</frame_pacing>"
+      "<dirty_tracking>true</dirty_tracking>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("MinimalScene",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  win->QuickWindow()->show();
+
+  // Render events are sent from the render thread
+  std::atomic<int> frames{0};
+  auto testHelper = std::make_unique<TestHelper>();
+  testHelper->forwardEvent = [&](QEvent *_event)
+  {
+    if (_event->type() == events::Render::kType)
+      ++frames;
+  };
+
+  auto waitFor = [&](int _count, int _maxMs)
+  {
+    for (int ms = 0; frames < _count && ms < _maxMs; ms += 10)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      QCoreApplication::processEvents();
+    }
+  };
+
+  waitFor(1, 3000);
+  ASSERT_GT(frames, 0);
+
+  // Idle after a second without input
+  waitFor(std::numeric_limits<int>::max(), 1500);
+  int idleFrames = frames;
+  waitFor(std::numeric_limits<int>::max(), 500);
+  EXPECT_EQ(idleFrames, frames);
+
+  // Like data arriving on a transport thread
+  std::thread([]
+  {
+    QCoreApplication::postEvent(App()->MainWin(), new events::SceneChanged());
+  }).join();
+
+  waitFor(idleFrames + 1, 3000);
+  EXPECT_GT(frames, idleFrames);
+
+  // Cleanup
+  auto plugins = win->findChildren<Plugin *>();
+  ASSERT_EQ(1, plugins.size());
+  auto pluginName = plugins[0]->CardItem()->objectName().toStdString();
+  EXPECT_TRUE(app.RemovePlugin(pluginName));
+  plugins.clear();
+
+  win->QuickWindow()->close();
+  auto engine = rendering::engine("ogre");
+  if (engine)
+  {
+    auto scene = engine->SceneByName("idle");
+    if (scene)
+      engine->DestroyScene(scene);
+    rendering::unloadEngine(engine->Name());
+  }
+}
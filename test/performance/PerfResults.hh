@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_GUI_TEST_PERFORMANCE_PERFRESULTS_HH_
+#define GZ_GUI_TEST_PERFORMANCE_PERFRESULTS_HH_
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gz
+{
+  namespace gui
+  {
+    /// \brief Collects the measurements of a performance test and writes
+    /// them as JSON, so they can be tracked over time.
+    ///
+    /// The file is `<suite>_perf.json` in the working directory, or in
+    /// the directory given by the `GZ_GUI_PERF_RESULTS` environment
+    /// variable. It holds one object per case, with its parameters and
+    /// measurements:
+    ///
+    ///     {"suite": "...", "results": [
+    ///       {"name": "...", "entities": 1000, "load_ms": 12.5}]}
+    class PerfResults
+    {
+      /// \brief A named value, a parameter or a measurement
+      public: using Value = std::pair<std::string, double>;
+
+      /// \brief Constructor
+      /// \param[in] _suite Name of the suite, used for the file name
+      public: explicit PerfResults(const std::string &_suite)
+        : suite(_suite)
+      {
+      }
+
+      /// \brief Add a case.
+      /// \param[in] _name Name of the case
+      /// \param[in] _values Its parameters followed by its measurements
+      public: void Add(const std::string &_name,
+                       const std::vector<Value> &_values)
+      {
+        this->results.emplace_back(_name, _values);
+      }
+
+      /// \brief Get the file the results are written to.
+      /// \return Path
+      public: std::string Path() const
+      {
+        std::string path;
+        const char *dir = std::getenv("GZ_GUI_PERF_RESULTS");
+        if (nullptr != dir && dir[0] != '\0')
+          path = std::string(dir) + "/";
+        return path + this->suite + "_perf.json";
+      }
+
+      /// \brief Write all cases added so far.
+      /// \return True if the file was written
+      public: bool Write() const
+      {
+        std::ofstream file(this->Path());
+        if (!file.is_open())
+        {
+          std::cerr << "Failed to write [" << this->Path() << "]"
+                    << std::endl;
+          return false;
+        }
+
+        file << "{\"suite\": \"" << this->suite << "\", \"results\": [";
+        for (std::size_t i = 0; i < this->results.size(); ++i)
+        {
+          file << (i > 0 ? ",\n" : "\n") << "  {\"name\": \""
+               << this->results[i].first << "\"";
+          for (const auto &value : this->results[i].second)
+            file << ", \"" << value.first << "\": " << value.second;
+          file << "}";
+        }
+        file << "\n]}\n";
+
+        std::cout << "Wrote [" << this->results.size() << "] results to ["
+                  << this->Path() << "]" << std::endl;
+        return true;
+      }
+
+      /// \brief Name of the suite
+      private: std::string suite;
+
+      /// \brief Cases, in order
+      private: std::vector<std::pair<std::string, std::vector<Value>>>
+          results;
+    };
+
+    /// \brief Base of the fixtures of performance tests, which collects
+    /// the results of the suite and writes them once it's done.
+    /// \tparam Derived The fixture, with a static `kSuite` member naming
+    /// the suite
+    template <typename Derived>
+    class PerfFixture : public ::testing::Test
+    {
+      /// \brief Get the results of the suite.
+      /// \return Results shared by all tests of the suite
+      protected: static PerfResults &Results()
+      {
+        static PerfResults results(Derived::kSuite);
+        return results;
+      }
+
+      /// \brief Write the results of the suite.
+      protected: static void TearDownTestSuite()
+      {
+        Results().Write();
+      }
+    };
+
+    /// \brief Resident memory of the process, in bytes
+    /// \return Resident set size, 0 if unknown
+    inline std::size_t ResidentMemory()
+    {
+#ifndef _WIN32
+      std::ifstream statm("/proc/self/statm");
+      std::size_t size{0};
+      std::size_t resident{0};
+      if (statm >> size >> resident)
+        return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+      return 0u;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gz/msgs/image.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/Plugin.hh"
+#include "ImageDisplay.hh"
+#include "PerfResults.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./ImageDisplay_PERF")),
+};
+
+using namespace std::chrono_literals;
+
+using namespace gz;
+using namespace gui;
+
+/// \brief Pixel formats converted by the plugin, with their size
+static const std::vector<std::pair<msgs::PixelFormatType, unsigned int>>
+    kFormats{
+  {msgs::PixelFormatType::RGB_INT8, 3},
+  {msgs::PixelFormatType::BGR_INT8, 3},
+  {msgs::PixelFormatType::R_FLOAT32, 4},
+  {msgs::PixelFormatType::L_INT16, 2},
+  {msgs::PixelFormatType::L_INT8, 1},
+  {msgs::PixelFormatType::BAYER_RGGB8, 1},
+};
+
+/// \brief Resolutions: 720p, 1080p and 4K
+static const std::vector<std::pair<unsigned int, unsigned int>>
+    kResolutions{{1280, 720}, {1920, 1080}, {3840, 2160}};
+
+/// \brief Loads an ImageDisplay and feeds it with synthetic images.
+class ImageDisplayPerfFixture
+  : public PerfFixture<ImageDisplayPerfFixture>
+{
+  /// \brief Name of the suite
+  public: static constexpr const char *kSuite{"image_display"};
+
+  /// \brief Load the plugin and wait for its subscription.
+  protected: void SetUp() override
+  {
+    common::Console::SetVerbosity(1);
+
+    this->pub = this->node.Advertise<msgs::Image>("/perf/image");
+
+    this->app = std::make_unique<Application>(g_argc, g_argv);
+    this->app->AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+    const char *pluginStr =
+      "<plugin filename=\"ImageDisplay\">"
+        "<topic>/perf/image</topic>"
+        "<topic_picker>false</topic_picker>"
+      "</plugin>";
+
+    tinyxml2::XMLDocument pluginDoc;
+    ASSERT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+    ASSERT_TRUE(this->app->LoadPlugin("ImageDisplay",
+        pluginDoc.FirstChildElement("plugin")));
+
+    auto window = this->app->findChild<MainWindow *>();
+    ASSERT_NE(window, nullptr);
+    window->QuickWindow()->show();
+
+    this->plugin = window->findChild<plugins::ImageDisplay *>();
+    ASSERT_NE(nullptr, this->plugin);
+    this->plugin->connect(this->plugin, &plugins::ImageDisplay::newImage,
+        [this]
+    {
+      ++this->shown;
+      this->lastShown = std::chrono::steady_clock::now();
+    });
+
+    int sleep = 0;
+    while (!this->pub.HasConnections() && sleep++ < 50)
+    {
+      std::this_thread::sleep_for(100ms);
+      QCoreApplication::processEvents();
+    }
+    ASSERT_TRUE(this->pub.HasConnections());
+  }
+
+  /// \brief Close the application.
+  protected: void TearDown() override
+  {
+    this->plugin = nullptr;
+    this->app.reset();
+  }
+
+  /// \brief Create an image with a gradient.
+  /// \param[in] _format Pixel format
+  /// \param[in] _bytes Bytes per pixel
+  /// \param[in] _width Width in pixels
+  /// \param[in] _height Height in pixels
+  /// \return Image message
+  protected: static msgs::Image Image(msgs::PixelFormatType _format,
+      unsigned int _bytes, unsigned int _width, unsigned int _height)
+  {
+    msgs::Image msg;
+    msg.set_width(_width);
+    msg.set_height(_height);
+    msg.set_step(_width * _bytes);
+    msg.set_pixel_format_type(_format);
+
+    std::string data(static_cast<std::size_t>(msg.step()) * _height, '\0');
+    for (std::size_t i = 0; i < data.size(); ++i)
+      data[i] = static_cast<char>((i / _bytes) % 251);
+    msg.set_data(std::move(data));
+    return msg;
+  }
+
+  /// \brief Publish an image and wait until it's shown.
+  /// \param[in] _msg Image
+  /// \param[out] _publish Time the publication took, which runs the
+  /// plugin's callback for local subscribers
+  /// \return Time until it was shown, negative on timeout
+  protected: std::chrono::duration<double, std::milli> ShowSync(
+      const msgs::Image &_msg,
+      std::chrono::duration<double, std::milli> &_publish)
+  {
+    int before = this->shown;
+    auto start = std::chrono::steady_clock::now();
+    this->pub.Publish(_msg);
+    _publish = std::chrono::steady_clock::now() - start;
+
+    auto deadline = start + 10s;
+    while (this->shown == before)
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+        return std::chrono::duration<double, std::milli>(-1);
+      QCoreApplication::processEvents();
+    }
+    return this->lastShown - start;
+  }
+
+  /// \brief Transport node
+  protected: transport::Node node;
+
+  /// \brief Image publisher
+  protected: transport::Node::Publisher pub;
+
+  /// \brief Application
+  protected: std::unique_ptr<Application> app;
+
+  /// \brief Plugin under test
+  protected: plugins::ImageDisplay *plugin{nullptr};
+
+  /// \brief Number of images shown
+  protected: int shown{0};
+
+  /// \brief Time the last image was shown
+  protected: std::chrono::steady_clock::time_point lastShown;
+};
+
+/////////////////////////////////////////////////
+TEST_F(ImageDisplayPerfFixture,
+  GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Latency))
+{
+  // One image at a time, so each is converted and shown before the next
+  const int frames{30};
+  for (const auto &resolution : kResolutions)
+  {
+    for (const auto &format : kFormats)
+    {
+      auto msg = Image(format.first, format.second, resolution.first,
+          resolution.second);
+
+      double totalPublish{0};
+      double totalLatency{0};
+      double worstLatency{0};
+      for (int i = 0; i < frames; ++i)
+      {
+        std::chrono::duration<double, std::milli> publish;
+        auto latency = this->ShowSync(msg, publish);
+        ASSERT_GE(latency.count(), 0) << "Timed out showing ["
+            << msgs::PixelFormatType_Name(format.first) << "] image";
+        totalPublish += publish.count();
+        totalLatency += latency.count();
+        worstLatency = std::max(worstLatency, latency.count());
+      }
+
+      std::cout << "[" << msgs::PixelFormatType_Name(format.first) << "] ["
+                << resolution.first << " x " << resolution.second
+                << "]: callback [" << totalPublish / frames
+                << "] ms, conversion and display, mean ["
+                << totalLatency / frames << "] ms, worst ["
+                << worstLatency << "] ms" << std::endl;
+
+      Results().Add("latency_" + msgs::PixelFormatType_Name(format.first), {
+          {"width", resolution.first},
+          {"height", resolution.second},
+          {"callback_ms", totalPublish / frames},
+          {"latency_mean_ms", totalLatency / frames},
+          {"latency_max_ms", worstLatency}});
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageDisplayPerfFixture,
+  GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Throughput))
+{
+  // Images are published as fast as possible from another thread, like a
+  // camera faster than the display. Images which aren't shown in time are
+  // replaced by newer ones and counted as dropped.
+  const auto duration = 2s;
+  for (const auto &resolution : kResolutions)
+  {
+    for (const auto &format : kFormats)
+    {
+      auto msg = Image(format.first, format.second, resolution.first,
+          resolution.second);
+
+      // Start from a shown image, with the drops of previous cases
+      // notified
+      std::chrono::duration<double, std::milli> publish;
+      ASSERT_GE(this->ShowSync(msg, publish).count(), 0);
+      int shownBefore = this->shown;
+      int droppedBefore = this->plugin->DroppedFrames();
+
+      std::atomic<bool> stop{false};
+      std::atomic<int> published{0};
+      std::thread producer([&]
+      {
+        while (!stop)
+        {
+          this->pub.Publish(msg);
+          ++published;
+        }
+      });
+
+      // Images waiting for the GUI, neither shown nor dropped yet
+      int maxDepth{0};
+      auto start = std::chrono::steady_clock::now();
+      while (std::chrono::steady_clock::now() - start < duration)
+      {
+        QCoreApplication::processEvents();
+        int depth = published - (this->shown - shownBefore) -
+            (this->plugin->DroppedFrames() - droppedBefore);
+        maxDepth = std::max(maxDepth, depth);
+      }
+      stop = true;
+      producer.join();
+      double seconds = std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - start).count();
+
+      int shownCount = this->shown - shownBefore;
+      int dropped = this->plugin->DroppedFrames() - droppedBefore;
+      std::cout << "[" << msgs::PixelFormatType_Name(format.first) << "] ["
+                << resolution.first << " x " << resolution.second
+                << "]: published [" << published / seconds << "] Hz, shown ["
+                << shownCount / seconds << "] FPS, dropped [" << dropped
+                << "], max queue depth [" << maxDepth << "]" << std::endl;
+
+      Results().Add(
+          "throughput_" + msgs::PixelFormatType_Name(format.first), {
+          {"width", resolution.first},
+          {"height", resolution.second},
+          {"published_hz", published / seconds},
+          {"fps", shownCount / seconds},
+          {"dropped", dropped},
+          {"max_queue_depth", maxDepth}});
+    }
+  }
+}
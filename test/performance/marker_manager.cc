@@ -0,0 +1,373 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/msgs/boolean.pb.h>
+#include <gz/msgs/marker.pb.h>
+#include <gz/msgs/marker_v.pb.h>
+#include <gz/msgs/world_stats.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/math/Color.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/msgs/Utility.hh>
+#include <gz/rendering/RenderEngine.hh>
+#include <gz/rendering/RenderingIface.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/Plugin.hh"
+#include "PerfResults.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./MarkerManager_PERF")),
+};
+
+using namespace std::chrono_literals;
+
+using namespace gz;
+using namespace gui;
+
+/// \brief Loads a scene with a MarkerManager and drives it with synthetic
+/// marker loads.
+class MarkerManagerPerfFixture
+  : public PerfFixture<MarkerManagerPerfFixture>
+{
+  /// \brief Name of the suite
+  public: static constexpr const char *kSuite{"marker_manager"};
+
+  /// \brief Load the plugins and wait for the scene.
+  protected: void SetUp() override
+  {
+    common::Console::SetVerbosity(1);
+
+    this->app = std::make_unique<Application>(g_argc, g_argv);
+    this->app->AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+    const char *pluginStr =
+      "<plugin filename=\"MarkerManager\">"
+        "<stats_topic>/perf/stats</stats_topic>"
+        "<process_budget>0</process_budget>"
+        "<sync_timeout>60000</sync_timeout>"
+      "</plugin>";
+
+    const char *pluginMinimalSceneStr =
+      "<plugin filename=\"MinimalScene\">"
+        "<engine>ogre</engine>"
+        "<scene>scene</scene>"
+      "</plugin>";
+
+    tinyxml2::XMLDocument pluginDoc;
+    ASSERT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+    tinyxml2::XMLDocument sceneDoc;
+    ASSERT_EQ(tinyxml2::XML_SUCCESS, sceneDoc.Parse(pluginMinimalSceneStr));
+
+    ASSERT_TRUE(this->app->LoadPlugin("MinimalScene",
+        sceneDoc.FirstChildElement("plugin")));
+    ASSERT_TRUE(this->app->LoadPlugin("MarkerManager",
+        pluginDoc.FirstChildElement("plugin")));
+
+    auto window = this->app->findChild<MainWindow *>();
+    ASSERT_NE(window, nullptr);
+    window->QuickWindow()->show();
+
+    auto engine = rendering::engine("ogre");
+    ASSERT_NE(nullptr, engine);
+
+    int sleep = 0;
+    while (0 == engine->SceneCount() && sleep++ < 30)
+    {
+      std::this_thread::sleep_for(100ms);
+      QCoreApplication::processEvents();
+    }
+    ASSERT_EQ(1u, engine->SceneCount());
+    this->scene = engine->SceneByName("scene");
+    ASSERT_NE(nullptr, this->scene);
+
+    this->statsPub =
+        this->node.Advertise<gz::msgs::WorldStatistics>("/perf/stats");
+
+    // Wait for the marker services to be advertised
+    std::vector<transport::ServicePublisher> publishers;
+    sleep = 0;
+    while (!this->node.ServiceInfo("/marker_array", publishers) &&
+        sleep++ < 50)
+    {
+      std::this_thread::sleep_for(100ms);
+      QCoreApplication::processEvents();
+    }
+    ASSERT_FALSE(publishers.empty());
+  }
+
+  /// \brief Close the application.
+  protected: void TearDown() override
+  {
+    this->scene.reset();
+    this->app.reset();
+  }
+
+  /// \brief Send markers and wait until they have been applied, rendering
+  /// in the meantime.
+  /// \param[in] _markers Markers to send.
+  /// \return Time from the request until the markers were applied.
+  protected: std::chrono::duration<double, std::milli> SendSync(
+      gz::msgs::Marker_V _markers)
+  {
+    auto data = _markers.mutable_header()->add_data();
+    data->set_key("sync");
+
+    std::atomic<bool> done{false};
+    bool result{false};
+    gz::msgs::Boolean rep;
+    auto start = std::chrono::steady_clock::now();
+    std::thread requester([&]
+    {
+      this->node.Request("/marker_array", _markers, 60000, rep, result);
+      done = true;
+    });
+    while (!done)
+      QCoreApplication::processEvents();
+    requester.join();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_TRUE(result);
+    EXPECT_TRUE(rep.data());
+    return elapsed;
+  }
+
+  /// \brief Render a single frame.
+  /// \return Time the frame took.
+  protected: std::chrono::duration<double, std::milli> Frame()
+  {
+    auto start = std::chrono::steady_clock::now();
+    QCoreApplication::processEvents();
+    return std::chrono::steady_clock::now() - start;
+  }
+
+  /// \brief Publish the sim time.
+  /// \param[in] _time Sim time.
+  protected: void SendSimTime(std::chrono::steady_clock::duration _time)
+  {
+    gz::msgs::WorldStatistics msg;
+    auto s = std::chrono::duration_cast<std::chrono::seconds>(_time);
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(_time - s);
+    msg.mutable_sim_time()->set_sec(s.count());
+    msg.mutable_sim_time()->set_nsec(ns.count());
+    this->statsPub.Publish(msg);
+  }
+
+  /// \brief Create a box marker.
+  /// \param[in] _id Marker id.
+  /// \param[out] _msg Marker message.
+  protected: static void BoxMarker(uint64_t _id, gz::msgs::Marker &_msg)
+  {
+    _msg.set_ns("perf");
+    _msg.set_id(_id);
+    _msg.set_action(gz::msgs::Marker::ADD_MODIFY);
+    _msg.set_type(gz::msgs::Marker::BOX);
+    gz::msgs::Set(_msg.mutable_material()->mutable_diffuse(),
+        math::Color(0, 0, 1));
+    gz::msgs::Set(_msg.mutable_scale(), math::Vector3d(0.1, 0.1, 0.1));
+    gz::msgs::Set(_msg.mutable_pose(), math::Pose3d(
+        static_cast<double>(_id % 100), static_cast<double>(_id / 100), 0,
+        0, 0, 0));
+  }
+
+  /// \brief Application
+  protected: std::unique_ptr<Application> app;
+
+  /// \brief Scene
+  protected: rendering::ScenePtr scene;
+
+  /// \brief Transport node
+  protected: transport::Node node;
+
+  /// \brief Sim time publisher
+  protected: transport::Node::Publisher statsPub;
+};
+
+/////////////////////////////////////////////////
+TEST_F(MarkerManagerPerfFixture,
+  GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(AddMarkers))
+{
+  for (unsigned int count : {1000u, 10000u})
+  {
+    std::size_t memoryBefore = ResidentMemory();
+
+    gz::msgs::Marker_V markers;
+    for (unsigned int i = 1; i <= count; ++i)
+      BoxMarker(i, *markers.add_marker());
+    auto latency = this->SendSync(markers);
+
+    std::size_t memoryAfter = ResidentMemory();
+    double bytesPerMarker = memoryAfter > memoryBefore ?
+        static_cast<double>(memoryAfter - memoryBefore) / count : 0;
+    auto frame = this->Frame();
+
+    std::cout << "[" << count << "] markers added in [" << latency.count()
+              << "] ms, next frame [" << frame.count() << "] ms, ["
+              << bytesPerMarker << "] bytes per marker" << std::endl;
+
+    gz::msgs::Marker_V deleteAll;
+    deleteAll.add_marker()->set_action(gz::msgs::Marker::DELETE_ALL);
+    auto deletion = this->SendSync(deleteAll);
+    std::cout << "[" << count << "] markers deleted in ["
+              << deletion.count() << "] ms" << std::endl;
+
+    Results().Add("add_markers", {
+        {"markers", count},
+        {"add_ms", latency.count()},
+        {"first_frame_ms", frame.count()},
+        {"bytes_per_marker", bytesPerMarker},
+        {"delete_ms", deletion.count()}});
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MarkerManagerPerfFixture,
+  GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(MarkerRate))
+{
+  // 100 updates of 1000 markers, at 100 Hz
+  const unsigned int count{1000};
+  gz::msgs::Marker_V markers;
+  for (unsigned int i = 1; i <= count; ++i)
+    BoxMarker(i, *markers.add_marker());
+
+  double worstFrame{0};
+  auto start = std::chrono::steady_clock::now();
+  for (int update = 0; update < 100; ++update)
+  {
+    for (auto &marker : *markers.mutable_marker())
+      marker.mutable_pose()->mutable_position()->set_z(update * 0.01);
+
+    gz::msgs::Boolean rep;
+    bool result{false};
+    this->node.Request("/marker_array", markers, 1000, rep, result);
+
+    auto next = start + update * 10ms;
+    while (std::chrono::steady_clock::now() < next)
+      worstFrame = std::max(worstFrame, this->Frame().count());
+  }
+
+  // Wait for the last update to be applied
+  auto latency = this->SendSync(gz::msgs::Marker_V());
+  std::cout << "100 updates of [" << count << "] markers at 100 Hz, worst "
+            << "frame [" << worstFrame << "] ms, last update applied ["
+            << latency.count() << "] ms after the end" << std::endl;
+
+  Results().Add("marker_rate", {
+      {"markers", count},
+      {"rate_hz", 100},
+      {"frame_max_ms", worstFrame},
+      {"latency_ms", latency.count()}});
+}
+
+/////////////////////////////////////////////////
+TEST_F(MarkerManagerPerfFixture,
+  GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(GrowingLineStrip))
+{
+  // A trajectory which grows by 10 points per update
+  gz::msgs::Marker_V markers;
+  auto marker = markers.add_marker();
+  marker->set_ns("perf");
+  marker->set_id(1);
+  marker->set_action(gz::msgs::Marker::ADD_MODIFY);
+  marker->set_type(gz::msgs::Marker::LINE_STRIP);
+  auto data = marker->mutable_header()->add_data();
+  data->set_key("append");
+
+  std::chrono::duration<double, std::milli> total{0};
+  std::chrono::duration<double, std::milli> last{0};
+  const int updates{500};
+  for (int update = 0; update < updates; ++update)
+  {
+    marker->clear_point();
+    for (int i = 0; i < 10; ++i)
+    {
+      double t = (update * 10 + i) * 0.01;
+      gz::msgs::Set(marker->add_point(),
+          math::Vector3d(t, std::sin(t), 0));
+    }
+    last = this->SendSync(markers);
+    total += last;
+  }
+
+  std::cout << "[" << updates * 10 << "] point line strip, mean update ["
+            << total.count() / updates << "] ms, last update ["
+            << last.count() << "] ms" << std::endl;
+
+  Results().Add("growing_line_strip", {
+      {"points", updates * 10},
+      {"update_mean_ms", total.count() / updates},
+      {"update_last_ms", last.count()}});
+}
+
+/////////////////////////////////////////////////
+TEST_F(MarkerManagerPerfFixture,
+  GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LifetimeChurn))
+{
+  // Markers which live for 100 ms of sim time, replaced as they expire
+  const unsigned int count{1000};
+  std::chrono::steady_clock::duration simTime{0};
+
+  double worstFrame{0};
+  std::chrono::duration<double, std::milli> total{0};
+  const int rounds{50};
+  for (int round = 0; round < rounds; ++round)
+  {
+    gz::msgs::Marker_V markers;
+    for (unsigned int i = 1; i <= count; ++i)
+    {
+      auto marker = markers.add_marker();
+      BoxMarker(round * count + i, *marker);
+      marker->mutable_lifetime()->set_nsec(100000000);
+    }
+    total += this->SendSync(markers);
+
+    simTime += 100ms;
+    this->SendSimTime(simTime);
+    for (int i = 0; i < 5; ++i)
+      worstFrame = std::max(worstFrame, this->Frame().count());
+  }
+
+  std::cout << "[" << rounds << "] rounds of [" << count << "] markers "
+            << "expiring, mean add [" << total.count() / rounds
+            << "] ms, worst frame [" << worstFrame << "] ms" << std::endl;
+
+  Results().Add("lifetime_churn", {
+      {"markers", count},
+      {"rounds", rounds},
+      {"add_mean_ms", total.count() / rounds},
+      {"frame_max_ms", worstFrame}});
+}
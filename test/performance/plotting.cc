@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/msgs/pose.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/PlottingInterface.hh"
+#include "PerfResults.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./Plotting_PERF")),
+};
+
+using namespace std::chrono_literals;
+
+using namespace gz;
+using namespace gui;
+
+/// \brief Plottable fields of a pose message
+static const std::vector<std::string> kPoseFields{
+    "position-x", "position-y", "position-z",
+    "orientation-x", "orientation-y", "orientation-z", "orientation-w"};
+
+/// \brief Create a pose message, different for each step.
+/// \param[in] _step Step
+/// \return Pose
+static msgs::Pose PoseMsg(int _step)
+{
+  msgs::Pose msg;
+  msg.mutable_position()->set_x(_step);
+  msg.mutable_position()->set_y(_step * 0.5);
+  msg.mutable_position()->set_z(-_step);
+  msg.mutable_orientation()->set_w(1.0);
+  msg.mutable_orientation()->set_z(_step % 100 * 0.01);
+  return msg;
+}
+
+/// \brief Writes the results of the suite.
+class PlottingPerfFixture : public PerfFixture<PlottingPerfFixture>
+{
+  /// \brief Name of the suite
+  public: static constexpr const char *kSuite{"plotting"};
+};
+
+/////////////////////////////////////////////////
+TEST_F(PlottingPerfFixture,
+  GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(TopicCallback))
+{
+  // Cost of a single message, without transport or the GUI thread
+  const int messages{100000};
+  for (std::size_t fields : {1u, 3u, 7u})
+  {
+    auto timeRef = std::make_shared<double>(0);
+    Topic topic("/perf/pose");
+    topic.SetPlottingTimeRef(timeRef);
+    for (std::size_t i = 0; i < fields; ++i)
+      topic.Register(kPoseFields[i], 1);
+
+    // The first message resolves the paths
+    topic.Callback(PoseMsg(0));
+    topic.Flush();
+
+    std::vector<msgs::Pose> poses;
+    for (int i = 0; i < 100; ++i)
+      poses.push_back(PoseMsg(i));
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < messages; ++i)
+    {
+      *timeRef = i * 0.001;
+      topic.Callback(poses[i % poses.size()]);
+
+      // Like the flush timer, so the buffers don't grow for ever
+      if (i % 16 == 15)
+        topic.Flush();
+    }
+    std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    double perMessage = elapsed.count() / messages;
+    std::cout << "[" << fields << "] fields: [" << perMessage
+              << "] us per callback, including flushes" << std::endl;
+
+    Results().Add("topic_callback", {
+        {"fields", fields},
+        {"callback_us", perMessage},
+        {"callback_per_field_us", perMessage / fields}});
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PlottingPerfFixture,
+  GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(HighRateTopics))
+{
+  common::Console::SetVerbosity(1);
+  Application app(g_argc, g_argv);
+
+  const auto duration = 2s;
+  const auto period = 1ms;
+  for (unsigned int topicCount : {1u, 10u, 50u})
+  {
+    for (std::size_t fields : {1u, 7u})
+    {
+      PlottingInterface iface;
+
+      std::atomic<int> pointSignals{0};
+      std::atomic<int> points{0};
+      std::atomic<int> plotSignals{0};
+      iface.connect(&iface, &PlottingInterface::plotPoints,
+          [&](int, QString, QVariantList _points)
+      {
+        ++pointSignals;
+        points += _points.size();
+      });
+      iface.connect(&iface, &PlottingInterface::plot,
+          [&](int, QString, double, double)
+      {
+        ++plotSignals;
+      });
+
+      // One chart per topic, so each topic's history is exported alone
+      transport::Node node;
+      std::vector<transport::Node::Publisher> pubs;
+      std::vector<std::string> topics;
+      for (unsigned int t = 0; t < topicCount; ++t)
+      {
+        topics.push_back("/perf/plot_" + std::to_string(topicCount) + "_" +
+            std::to_string(fields) + "_" + std::to_string(t));
+        pubs.push_back(node.Advertise<msgs::Pose>(topics.back()));
+        for (std::size_t f = 0; f < fields; ++f)
+        {
+          iface.subscribe(static_cast<int>(t),
+              QString::fromStdString(topics.back()),
+              QString::fromStdString(kPoseFields[f]));
+        }
+      }
+      for (auto &pub : pubs)
+      {
+        for (int sleep = 0; !pub.HasConnections() && sleep < 50; ++sleep)
+          std::this_thread::sleep_for(100ms);
+        ASSERT_TRUE(pub.HasConnections());
+      }
+
+      // Publish every topic at 1 kHz
+      std::atomic<bool> stop{false};
+      std::atomic<int> published{0};
+      std::thread publisher([&]
+      {
+        auto start = std::chrono::steady_clock::now();
+        for (int step = 0; !stop; ++step)
+        {
+          auto msg = PoseMsg(step);
+          for (auto &pub : pubs)
+            pub.Publish(msg);
+          ++published;
+          std::this_thread::sleep_until(start + (step + 1) * period);
+        }
+      });
+
+      // GUI thread time spent flushing the samples to the charts
+      double flushTime{0};
+      double worstFlush{0};
+      auto start = std::chrono::steady_clock::now();
+      while (std::chrono::steady_clock::now() - start < duration)
+      {
+        int before = pointSignals;
+        auto iterationStart = std::chrono::steady_clock::now();
+        QCoreApplication::processEvents();
+        std::chrono::duration<double, std::milli> iteration =
+            std::chrono::steady_clock::now() - iterationStart;
+        if (pointSignals != before)
+        {
+          flushTime += iteration.count();
+          worstFlush = std::max(worstFlush, iteration.count());
+        }
+      }
+      stop = true;
+      publisher.join();
+      double seconds = std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - start).count();
+
+      // Let the last messages arrive and be flushed
+      auto drain = std::chrono::steady_clock::now() + 200ms;
+      while (std::chrono::steady_clock::now() < drain)
+        QCoreApplication::processEvents();
+
+      // Samples missing from the full rate history were dropped
+      std::string dir = common::joinPaths(std::string(PROJECT_BINARY_PATH),
+          "test", "plotting_perf");
+      ASSERT_TRUE(common::createDirectories(dir));
+      QString url = QString::fromStdString("file://" + dir);
+      long long recorded{0};
+      for (unsigned int t = 0; t < topicCount; ++t)
+      {
+        auto exported = iface.exportHistoryCSV(url, static_cast<int>(t));
+        EXPECT_EQ(fields, static_cast<std::size_t>(exported.size()));
+        for (const auto &id : exported)
+        {
+          auto key = id.toStdString();
+          std::replace(key.begin(), key.end(), '-', '/');
+          auto path = iface.FilePath(url, "Plot" + std::to_string(t) + "_" +
+              key, "csv");
+          std::ifstream file(path);
+          std::string line;
+          std::getline(file, line);
+          while (std::getline(file, line))
+            ++recorded;
+        }
+      }
+      common::removeAll(dir);
+
+      long long expected = static_cast<long long>(published) *
+          topicCount * fields;
+      long long dropped = std::max(0LL, expected - recorded);
+      double flushesPerSecond = pointSignals / seconds;
+      std::cout << "[" << topicCount << "] topics x [" << fields
+                << "] fields at 1 kHz: [" << flushesPerSecond
+                << "] plotPoints signals per second with [" << points
+                << "] points, [" << plotSignals << "] plot signals, GUI "
+                << "flush time [" << flushTime / seconds * 100
+                << "] %, worst [" << worstFlush << "] ms, dropped ["
+                << dropped << "] of [" << expected << "] samples"
+                << std::endl;
+
+      Results().Add("high_rate_topics", {
+          {"topics", topicCount},
+          {"fields", fields},
+          {"published_hz", published / seconds},
+          {"signals_per_s", flushesPerSecond},
+          {"points_per_s", points / seconds},
+          {"plot_signals", plotSignals},
+          {"gui_flush_ms_per_s", flushTime / seconds},
+          {"gui_flush_max_ms", worstFlush},
+          {"samples_expected", expected},
+          {"samples_dropped", dropped}});
+    }
+  }
+}
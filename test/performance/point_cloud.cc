@@ -0,0 +1,368 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/msgs/pointcloud_packed.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/rendering/RenderEngine.hh>
+#include <gz/rendering/RenderingIface.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/GuiEvents.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/Plugin.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "PointCloud.hh"
+#include "PerfResults.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./PointCloud_PERF")),
+};
+
+using namespace std::chrono_literals;
+
+using namespace gz;
+using namespace gui;
+
+/// \brief Number of points of the clouds
+static const std::vector<unsigned int> kPointCounts{
+    10000, 100000, 500000, 2000000};
+
+/// \brief Counts the scene changes notified by the plugin once it updated
+/// its points, from the render thread.
+class SceneChangedCounter : public QObject
+{
+  /// \brief Count scene changes, let everything through.
+  /// \param[in] _obj Object the event is sent to
+  /// \param[in] _event Event
+  /// \return False
+  protected: bool eventFilter(QObject *_obj, QEvent *_event) override
+  {
+    if (_event->type() == events::SceneChanged::kType)
+    {
+      this->last = std::chrono::steady_clock::now().time_since_epoch().count();
+      ++this->count;
+    }
+    return QObject::eventFilter(_obj, _event);
+  }
+
+  /// \brief Number of scene changes
+  public: std::atomic<int> count{0};
+
+  /// \brief Time of the last scene change, in steady clock ticks
+  public: std::atomic<std::chrono::steady_clock::rep> last{0};
+};
+
+/// \brief Loads a scene with a PointCloud and feeds it with synthetic
+/// clouds.
+class PointCloudPerfFixture
+  : public PerfFixture<PointCloudPerfFixture>
+{
+  /// \brief Name of the suite
+  public: static constexpr const char *kSuite{"point_cloud"};
+
+  /// \brief Load the plugins and wait for the scene.
+  protected: void SetUp() override
+  {
+    common::Console::SetVerbosity(1);
+
+    this->app = std::make_unique<Application>(g_argc, g_argv);
+    this->app->AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+    const char *pluginStr =
+      "<plugin filename=\"PointCloud\">"
+        "<color_field>intensity</color_field>"
+      "</plugin>";
+
+    const char *pluginMinimalSceneStr =
+      "<plugin filename=\"MinimalScene\">"
+        "<engine>ogre</engine>"
+        "<scene>scene</scene>"
+      "</plugin>";
+
+    tinyxml2::XMLDocument pluginDoc;
+    ASSERT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+    tinyxml2::XMLDocument sceneDoc;
+    ASSERT_EQ(tinyxml2::XML_SUCCESS, sceneDoc.Parse(pluginMinimalSceneStr));
+
+    ASSERT_TRUE(this->app->LoadPlugin("MinimalScene",
+        sceneDoc.FirstChildElement("plugin")));
+    ASSERT_TRUE(this->app->LoadPlugin("PointCloud",
+        pluginDoc.FirstChildElement("plugin")));
+
+    auto window = this->app->findChild<MainWindow *>();
+    ASSERT_NE(window, nullptr);
+    window->QuickWindow()->show();
+    window->installEventFilter(&this->sceneChanged);
+
+    this->plugin = window->findChild<plugins::PointCloud *>();
+    ASSERT_NE(nullptr, this->plugin);
+
+    // The color range is set on the GUI thread once a cloud is converted
+    this->plugin->connect(this->plugin,
+        &plugins::PointCloud::MinFloatVChanged, [this]
+    {
+      ++this->converted;
+      this->lastConverted = std::chrono::steady_clock::now();
+    });
+
+    auto engine = rendering::engine("ogre");
+    ASSERT_NE(nullptr, engine);
+
+    int sleep = 0;
+    while (0 == engine->SceneCount() && sleep++ < 30)
+    {
+      std::this_thread::sleep_for(100ms);
+      QCoreApplication::processEvents();
+    }
+    ASSERT_EQ(1u, engine->SceneCount());
+
+    RenderHooks::SetTimingEnabled(true);
+  }
+
+  /// \brief Close the application.
+  protected: void TearDown() override
+  {
+    RenderHooks::SetTimingEnabled(false);
+    if (nullptr != this->app && nullptr != this->app->MainWin())
+      this->app->MainWin()->removeEventFilter(&this->sceneChanged);
+    this->plugin = nullptr;
+    this->app.reset();
+  }
+
+  /// \brief Create a cloud of points on a grid, with an intensity field.
+  /// \param[in] _points Number of points
+  /// \param[in] _maxIntensity Intensity of the last point, so the color
+  /// range changes between clouds
+  /// \return Cloud message
+  protected: static msgs::PointCloudPacked Cloud(unsigned int _points,
+      float _maxIntensity)
+  {
+    msgs::PointCloudPacked msg;
+    const char *names[] = {"x", "y", "z", "intensity"};
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      auto field = msg.add_field();
+      field->set_name(names[i]);
+      field->set_offset(i * sizeof(float));
+      field->set_datatype(msgs::PointCloudPacked::Field::FLOAT32);
+      field->set_count(1);
+    }
+    msg.set_point_step(4 * sizeof(float));
+    msg.set_width(_points);
+    msg.set_height(1);
+    msg.set_row_step(msg.point_step() * _points);
+    msg.set_is_dense(true);
+
+    std::vector<float> data(4 * static_cast<std::size_t>(_points));
+    for (unsigned int i = 0; i < _points; ++i)
+    {
+      data[4 * i] = static_cast<float>(i % 1000) * 0.01f;
+      data[4 * i + 1] = static_cast<float>(i / 1000 % 1000) * 0.01f;
+      data[4 * i + 2] = static_cast<float>(i / 1000000) * 0.01f;
+      data[4 * i + 3] = _maxIntensity * i / std::max(1u, _points - 1);
+    }
+    msg.set_data(std::string(reinterpret_cast<const char *>(data.data()),
+        data.size() * sizeof(float)));
+    return msg;
+  }
+
+  /// \brief Time spent by the plugin's render hook on the last frame.
+  /// \return Milliseconds, 0 if unknown
+  protected: static double HookTime()
+  {
+    for (const auto &timing : RenderHooks::Timings(RenderPhase::kRender))
+    {
+      if (timing.first == "PointCloud")
+        return timing.second;
+    }
+    return 0.0;
+  }
+
+  /// \brief Render until a condition is met.
+  /// \param[in] _done Condition
+  /// \return False on timeout
+  protected: static bool RenderUntil(const std::function<bool()> &_done)
+  {
+    auto deadline = std::chrono::steady_clock::now() + 30s;
+    while (!_done())
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+        return false;
+      QCoreApplication::processEvents();
+    }
+    return true;
+  }
+
+  /// \brief Application
+  protected: std::unique_ptr<Application> app;
+
+  /// \brief Plugin under test
+  protected: plugins::PointCloud *plugin{nullptr};
+
+  /// \brief Counts the point updates
+  protected: SceneChangedCounter sceneChanged;
+
+  /// \brief Number of clouds converted
+  protected: int converted{0};
+
+  /// \brief Time the last cloud was converted
+  protected: std::chrono::steady_clock::time_point lastConverted;
+};
+
+/////////////////////////////////////////////////
+TEST_F(PointCloudPerfFixture,
+  GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Latency))
+{
+  // One cloud at a time, so each is converted and rendered before the next
+  const int frames{20};
+  for (unsigned int points : kPointCounts)
+  {
+    double totalCallback{0};
+    double totalConversion{0};
+    double totalLatency{0};
+    double worstLatency{0};
+    double totalHook{0};
+    for (int i = 0; i < frames; ++i)
+    {
+      auto msg = Cloud(points, static_cast<float>(i + 1));
+
+      int convertedBefore = this->converted;
+      auto start = std::chrono::steady_clock::now();
+      this->plugin->OnPointCloud(msg);
+      std::chrono::duration<double, std::milli> callback =
+          std::chrono::steady_clock::now() - start;
+
+      ASSERT_TRUE(RenderUntil([&]{return this->converted > convertedBefore;}))
+          << "Timed out converting [" << points << "] points";
+      int changedBefore = this->sceneChanged.count;
+      ASSERT_TRUE(RenderUntil(
+          [&]{return this->sceneChanged.count > changedBefore;}))
+          << "Timed out rendering [" << points << "] points";
+      std::chrono::steady_clock::time_point rendered(
+          std::chrono::steady_clock::duration(this->sceneChanged.last.load()));
+
+      std::chrono::duration<double, std::milli> conversion =
+          this->lastConverted - start;
+      std::chrono::duration<double, std::milli> latency = rendered - start;
+      totalCallback += callback.count();
+      totalConversion += conversion.count();
+      totalLatency += latency.count();
+      worstLatency = std::max(worstLatency, latency.count());
+      totalHook += HookTime();
+    }
+
+    std::cout << "[" << points << "] points: callback ["
+              << totalCallback / frames << "] ms, conversion ["
+              << totalConversion / frames << "] ms, render hook ["
+              << totalHook / frames << "] ms, latency mean ["
+              << totalLatency / frames << "] ms, worst [" << worstLatency
+              << "] ms" << std::endl;
+
+    Results().Add("latency", {
+        {"points", points},
+        {"callback_ms", totalCallback / frames},
+        {"conversion_ms", totalConversion / frames},
+        {"render_hook_ms", totalHook / frames},
+        {"latency_mean_ms", totalLatency / frames},
+        {"latency_max_ms", worstLatency}});
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PointCloudPerfFixture,
+  GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(Throughput))
+{
+  // Clouds are received as fast as possible on another thread, like a fast
+  // lidar. The plugin only keeps the latest, so clouds received while one
+  // is converted are skipped.
+  const auto duration = 2s;
+  for (unsigned int points : kPointCounts)
+  {
+    std::vector<msgs::PointCloudPacked> clouds{
+        Cloud(points, 1.0f), Cloud(points, 2.0f)};
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> received{0};
+    std::thread producer([&]
+    {
+      while (!stop)
+      {
+        this->plugin->OnPointCloud(clouds[received % 2]);
+        ++received;
+      }
+    });
+
+    int convertedBefore = this->converted;
+    int changedBefore = this->sceneChanged.count;
+    int maxDepth{0};
+    double worstFrame{0};
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < duration)
+    {
+      auto frameStart = std::chrono::steady_clock::now();
+      QCoreApplication::processEvents();
+      std::chrono::duration<double, std::milli> frame =
+          std::chrono::steady_clock::now() - frameStart;
+      worstFrame = std::max(worstFrame, frame.count());
+
+      // Clouds received but not converted yet, skipped or waiting
+      maxDepth = std::max(maxDepth,
+          received - (this->converted - convertedBefore));
+    }
+    stop = true;
+    producer.join();
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    int convertedCount = this->converted - convertedBefore;
+    int updates = this->sceneChanged.count - changedBefore;
+    std::cout << "[" << points << "] points: received ["
+              << received / seconds << "] Hz, converted ["
+              << convertedCount / seconds << "] Hz, rendered updates ["
+              << updates / seconds << "] per second, skipped ["
+              << received - convertedCount << "], worst frame ["
+              << worstFrame << "] ms" << std::endl;
+
+    Results().Add("throughput", {
+        {"points", points},
+        {"received_hz", received / seconds},
+        {"converted_hz", convertedCount / seconds},
+        {"updates_per_s", updates / seconds},
+        {"skipped", received - convertedCount},
+        {"max_queue_depth", maxDepth},
+        {"frame_max_ms", worstFrame}});
+
+    // Let the last cloud through before the next size
+    RenderUntil([&]{return this->sceneChanged.count > changedBefore;});
+  }
+}
@@ -0,0 +1,428 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/msgs/param.pb.h>
+#include <gz/msgs/scene.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/math/Color.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/msgs/Utility.hh>
+#include <gz/rendering/RenderEngine.hh>
+#include <gz/rendering/RenderingIface.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/Plugin.hh"
+#include "PerfResults.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./RenderLoop_PERF")),
+};
+
+using namespace std::chrono_literals;
+
+using namespace gz;
+using namespace gui;
+
+/// \brief Frames measured
+static const int kFrames{1000};
+
+/// \brief Frames rendered before measuring, while shaders are compiled
+/// and caches fill up
+static const int kWarmupFrames{60};
+
+/// \brief Models of the heavy scene, on a grid of kRowModels per row
+static const unsigned int kModels{10000};
+
+/// \brief Models per row of the grid
+static const unsigned int kRowModels{200};
+
+/// \brief Slowdown over the baseline which fails the test, unless
+/// GZ_GUI_RENDER_TOLERANCE is set
+static const double kDefaultTolerance{0.25};
+
+/// \brief Get an environment variable.
+/// \param[in] _name Variable name
+/// \param[in] _default Value if it's not set or empty
+/// \return Value
+static std::string Env(const char *_name, const std::string &_default)
+{
+  const char *value = std::getenv(_name);
+  return nullptr == value || value[0] == '\0' ? _default :
+      std::string(value);
+}
+
+/// \brief Read the cases of a results file written by PerfResults.
+/// \param[in] _path File
+/// \return Values of each case by name, empty if it can't be read
+static std::map<std::string, std::map<std::string, double>> ReadResults(
+    const std::string &_path)
+{
+  // One case per line, as written by PerfResults::Write
+  static const std::regex kCase("\\{\"name\": \"([^\"]*)\"(.*)\\}");
+  static const std::regex kValue(", \"([^\"]*)\": ([-0-9.eE+]+)");
+
+  std::map<std::string, std::map<std::string, double>> cases;
+  std::ifstream file(_path);
+  std::string line;
+  while (std::getline(file, line))
+  {
+    std::smatch match;
+    if (!std::regex_search(line, match, kCase))
+      continue;
+
+    auto &values = cases[match[1]];
+    std::string rest = match[2];
+    for (std::sregex_iterator it(rest.begin(), rest.end(), kValue);
+        it != std::sregex_iterator(); ++it)
+    {
+      values[(*it)[1]] = std::stod((*it)[2]);
+    }
+  }
+  return cases;
+}
+
+/// \brief Renders a heavy scene headless and measures the render loop.
+///
+/// The render engine and graphics API are chosen with the
+/// GZ_GUI_RENDER_ENGINE and GZ_GUI_RENDER_GRAPHICS_API environment
+/// variables, "ogre2" and "opengl" by default, or "metal" on macOS. Ogre 2
+/// falls back to EGL when there's no display.
+///
+/// The results of a backend are compared against the baseline of that
+/// backend in `test/performance/baselines/render_loop_<api>.json`, or in
+/// the file given by GZ_GUI_RENDER_BASELINE. Baselines are results files
+/// of a previous run on the same machine, so a CI runner keeps its own.
+/// Without a baseline, the results are only written.
+class RenderLoopPerfFixture : public PerfFixture<RenderLoopPerfFixture>
+{
+  /// \brief Name of the suite
+  public: static constexpr const char *kSuite{"render_loop"};
+
+  /// \brief Load the plugins and wait for the heavy scene.
+  protected: void SetUp() override
+  {
+    common::Console::SetVerbosity(1);
+
+#ifdef __APPLE__
+    this->api = Env("GZ_GUI_RENDER_GRAPHICS_API", "metal");
+#else
+    this->api = Env("GZ_GUI_RENDER_GRAPHICS_API", "opengl");
+#endif
+    this->engineName = Env("GZ_GUI_RENDER_ENGINE", "ogre2");
+
+    this->sceneService = [](msgs::Scene &_rep) -> bool
+    {
+      _rep = World();
+      return true;
+    };
+    this->node.Advertise<msgs::Scene>("/perf/scene", this->sceneService);
+
+    std::function<void(const msgs::Param &)> timingCb =
+        [this](const msgs::Param &_msg)
+        {
+          std::lock_guard<std::mutex> lock(this->timingMutex);
+          if (this->measuring)
+            this->timings.push_back(_msg);
+        };
+    this->node.Subscribe("/perf/frame_timing", timingCb);
+
+    this->app = std::make_unique<Application>(g_argc, g_argv,
+        WindowType::kHeadless);
+    this->app->AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+    std::string sceneStr =
+      "<plugin filename=\"MinimalScene\">"
+        "<engine>" + this->engineName + "</engine>"
+        "<scene>scene</scene>"
+        "<graphics_api>" + this->api + "</graphics_api>"
+        "<camera_pose>100 -40 60 0 0.6 1.57</camera_pose>"
+        "<sky></sky>"
+        "<frame_timing><topic>/perf/frame_timing</topic></frame_timing>"
+      "</plugin>";
+
+    const char *managerStr =
+      "<plugin filename=\"TransportSceneManager\">"
+        "<service>/perf/scene</service>"
+        "<pose_topic>/perf/pose</pose_topic>"
+        "<deletion_topic>/perf/delete</deletion_topic>"
+        "<scene_topic>/perf/scene_topic</scene_topic>"
+        "<load_budget>0</load_budget>"
+      "</plugin>";
+
+    tinyxml2::XMLDocument sceneDoc;
+    ASSERT_EQ(tinyxml2::XML_SUCCESS, sceneDoc.Parse(sceneStr.c_str()));
+    tinyxml2::XMLDocument managerDoc;
+    ASSERT_EQ(tinyxml2::XML_SUCCESS, managerDoc.Parse(managerStr));
+
+    ASSERT_TRUE(this->app->LoadPlugin("MinimalScene",
+        sceneDoc.FirstChildElement("plugin")));
+    ASSERT_TRUE(this->app->LoadPlugin("TransportSceneManager",
+        managerDoc.FirstChildElement("plugin")));
+
+    auto engine = rendering::engine(this->engineName);
+    ASSERT_NE(nullptr, engine) << "Render engine [" << this->engineName
+                               << "] isn't available";
+
+    int frames = 0;
+    while (0 == engine->SceneCount() && frames++ < 100)
+      this->app->StepFrame(100);
+    ASSERT_EQ(1u, engine->SceneCount());
+    this->scene = engine->SceneByName("scene");
+    ASSERT_NE(nullptr, this->scene);
+
+    // The user camera and the models
+    auto root = this->scene->RootVisual();
+    auto deadline = std::chrono::steady_clock::now() + 600s;
+    while (root->ChildCount() < kModels + 1 &&
+        std::chrono::steady_clock::now() < deadline)
+    {
+      this->app->StepFrame(100);
+    }
+    ASSERT_GE(root->ChildCount(), kModels + 1) << "Timed out loading the "
+                                               << "scene";
+  }
+
+  /// \brief Close the application.
+  protected: void TearDown() override
+  {
+    this->scene.reset();
+    this->app.reset();
+  }
+
+  /// \brief Create the heavy scene: a grid of boxes, spheres and
+  /// cylinders with a few materials, and a light.
+  /// \return Scene message
+  protected: static msgs::Scene World()
+  {
+    static const std::vector<math::Color> kColors{
+        math::Color::Red, math::Color::Green, math::Color::Blue,
+        math::Color::Yellow, math::Color::Magenta, math::Color::Cyan,
+        math::Color::White, math::Color(1.0f, 0.5f, 0.0f)};
+
+    msgs::Scene msg;
+    msg.set_name("perf");
+
+    auto light = msg.add_light();
+    light->set_name("sun");
+    light->set_type(msgs::Light::DIRECTIONAL);
+    light->set_cast_shadows(true);
+    msgs::Set(light->mutable_direction(), math::Vector3d(-0.5, 0.1, -0.9));
+    msgs::Set(light->mutable_diffuse(), math::Color(0.8f, 0.8f, 0.8f));
+
+    for (unsigned int i = 0; i < kModels; ++i)
+    {
+      unsigned int id = 1 + i * 3;
+      auto model = msg.add_model();
+      model->set_id(id);
+      model->set_name("model_" + std::to_string(i));
+      msgs::Set(model->mutable_pose(), math::Pose3d(
+          i % kRowModels, i / kRowModels, 0.25, 0, 0, 0));
+
+      auto link = model->add_link();
+      link->set_id(id + 1);
+      link->set_name("link");
+
+      auto visual = link->add_visual();
+      visual->set_id(id + 2);
+      visual->set_name("visual");
+      auto geometry = visual->mutable_geometry();
+      switch (i % 3)
+      {
+        case 0:
+          msgs::Set(geometry->mutable_box()->mutable_size(),
+              math::Vector3d(0.5, 0.5, 0.5));
+          break;
+        case 1:
+          geometry->mutable_sphere()->set_radius(0.25);
+          break;
+        default:
+          geometry->mutable_cylinder()->set_radius(0.25);
+          geometry->mutable_cylinder()->set_length(0.5);
+          break;
+      }
+      msgs::Set(visual->mutable_material()->mutable_diffuse(),
+          kColors[i % kColors.size()]);
+    }
+    return msg;
+  }
+
+  /// \brief Render frames and measure them.
+  /// \param[out] _frameMs Wall time of each frame
+  /// \param[out] _phaseMs Mean CPU time of each phase and render hook, and
+  /// of the GPU when it's measured, from the frame timing topic
+  protected: void Measure(std::vector<double> &_frameMs,
+      std::map<std::string, double> &_phaseMs)
+  {
+    for (int i = 0; i < kWarmupFrames; ++i)
+      this->app->StepFrame();
+
+    {
+      std::lock_guard<std::mutex> lock(this->timingMutex);
+      this->measuring = true;
+    }
+
+    _frameMs.reserve(kFrames);
+    for (int i = 0; i < kFrames; ++i)
+    {
+      auto start = std::chrono::steady_clock::now();
+      EXPECT_TRUE(this->app->StepFrame());
+      _frameMs.push_back(std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - start).count());
+    }
+
+    // Let the last timings arrive
+    std::this_thread::sleep_for(200ms);
+
+    std::lock_guard<std::mutex> lock(this->timingMutex);
+    this->measuring = false;
+    std::map<std::string, int> counts;
+    for (const auto &msg : this->timings)
+    {
+      for (const auto &param : msg.params())
+      {
+        _phaseMs[param.first] += param.second.double_value();
+        ++counts[param.first];
+      }
+    }
+    for (auto &phase : _phaseMs)
+      phase.second /= counts[phase.first];
+  }
+
+  /// \brief Graphics API
+  protected: std::string api;
+
+  /// \brief Render engine
+  protected: std::string engineName;
+
+  /// \brief Transport node
+  protected: transport::Node node;
+
+  /// \brief Responds to the scene request with the heavy scene
+  protected: std::function<bool(msgs::Scene &)> sceneService;
+
+  /// \brief Protects timings and measuring
+  protected: std::mutex timingMutex;
+
+  /// \brief Frame timings received while measuring, averaged over 30
+  /// frames each
+  protected: std::vector<msgs::Param> timings;
+
+  /// \brief True while frames are measured
+  protected: bool measuring{false};
+
+  /// \brief Application
+  protected: std::unique_ptr<Application> app;
+
+  /// \brief Scene
+  protected: rendering::ScenePtr scene;
+};
+
+/////////////////////////////////////////////////
+TEST_F(RenderLoopPerfFixture,
+  GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(HeavyScene))
+{
+  std::vector<double> frameMs;
+  std::map<std::string, double> phaseMs;
+  this->Measure(frameMs, phaseMs);
+  ASSERT_EQ(static_cast<std::size_t>(kFrames), frameMs.size());
+
+  double total{0};
+  for (auto ms : frameMs)
+    total += ms;
+  double mean = total / frameMs.size();
+
+  auto sorted = frameMs;
+  std::sort(sorted.begin(), sorted.end());
+  double p99 = sorted[sorted.size() * 99 / 100];
+
+  std::cout << "[" << this->engineName << "/" << this->api << "] ["
+            << kFrames << "] frames of [" << kModels << "] models: mean ["
+            << mean << "] ms, p99 [" << p99 << "] ms" << std::endl;
+
+  std::vector<PerfResults::Value> values{
+      {"models", kModels},
+      {"frames", kFrames},
+      {"mean_ms", mean},
+      {"p99_ms", p99},
+      {"max_ms", sorted.back()}};
+  for (const auto &phase : phaseMs)
+  {
+    std::cout << "  * [" << phase.first << "] [" << phase.second << "] ms"
+              << std::endl;
+    values.emplace_back(phase.first + "_ms", phase.second);
+  }
+  if (phaseMs.find("gpu") == phaseMs.end())
+    std::cout << "  GPU time isn't measured by this backend" << std::endl;
+
+  // Cases are named by backend, so one file can hold all of them
+  auto name = this->engineName + "_" + this->api;
+  Results().Add(name, values);
+
+  auto baselinePath = Env("GZ_GUI_RENDER_BASELINE", common::joinPaths(
+      std::string(PROJECT_SOURCE_PATH), "test", "performance",
+      "baselines", "render_loop_" + this->api + ".json"));
+  auto baselines = ReadResults(baselinePath);
+  auto baseline = baselines.find(name);
+  if (baseline == baselines.end())
+  {
+    std::cout << "No baseline for [" << name << "] in [" << baselinePath
+              << "], the results in [" << Results().Path()
+              << "] can be used as one" << std::endl;
+    return;
+  }
+
+  double tolerance = std::atof(Env("GZ_GUI_RENDER_TOLERANCE",
+      std::to_string(kDefaultTolerance)).c_str());
+  for (const auto &metric : {"mean_ms", "p99_ms"})
+  {
+    auto expected = baseline->second.find(metric);
+    if (expected == baseline->second.end())
+      continue;
+
+    double actual = metric == std::string("mean_ms") ? mean : p99;
+    EXPECT_LE(actual, expected->second * (1.0 + tolerance))
+        << "[" << metric << "] of [" << name << "] regressed from ["
+        << expected->second << "] ms, tolerance [" << tolerance * 100
+        << "]%";
+  }
+}
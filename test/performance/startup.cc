@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/StartupProfiler.hh"
+#include "PerfResults.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./Startup_PERF")),
+};
+
+using namespace std::chrono_literals;
+
+using namespace gz;
+using namespace gui;
+
+/// \brief Launches of each config, the first one is cold
+static const int kLaunches{5};
+
+/// \brief Warm startup time above which a warning is printed. Setting
+/// GZ_GUI_STARTUP_THRESHOLD_MS makes the test fail above that instead.
+static const double kDefaultThresholdMs{3000.0};
+
+/// \brief Plugins of the synthetic config, which don't need a 3D scene
+static const std::vector<std::string> kSyntheticPlugins{
+    "Publisher", "TopicEcho", "TopicViewer", "KeyPublisher",
+    "WorldControl", "WorldStats", "ImageDisplay", "Teleop"};
+
+/// \brief Number of plugins of the synthetic config
+static const int kSyntheticCount{40};
+
+/// \brief Steps of one launch, read back from the startup profile
+struct Launch
+{
+  /// \brief From constructing the application to the first frame
+  double totalMs{0};
+
+  /// \brief Time parsing the config file
+  double parseMs{0};
+
+  /// \brief Time loading each plugin, by filename, summed over instances
+  std::map<std::string, double> pluginMs;
+};
+
+/// \brief Read the durations recorded by the startup profiler.
+/// \param[in] _path Trace file
+/// \param[out] _launch Parse and plugin load times
+static void ReadTrace(const std::string &_path, Launch &_launch)
+{
+  // One event per line, as written by StartupProfiler::Write
+  static const std::regex kEvent(
+      "\"cat\":\"([^\"]*)\".*\"dur\":([0-9]+).*\"args\":\\{\"name\":"
+      "\"([^\"]*)\"\\}");
+
+  std::ifstream file(_path);
+  std::string line;
+  while (std::getline(file, line))
+  {
+    std::smatch match;
+    if (!std::regex_search(line, match, kEvent))
+      continue;
+
+    double ms = std::stod(match[2]) / 1000.0;
+    if (match[1] == "Parse config")
+      _launch.parseMs += ms;
+    else if (match[1] == "Load plugin")
+      _launch.pluginMs[match[3]] += ms;
+  }
+}
+
+/// \brief Launch a headless application with a config until its first
+/// frame.
+/// \param[in] _config Config file
+/// \param[out] _launch Measurements
+/// \return False if the config failed to load or nothing was rendered
+static bool LaunchConfig(const std::string &_config, Launch &_launch)
+{
+  auto trace = common::joinPaths(std::string(PROJECT_BINARY_PATH),
+      "test", "startup_perf_trace.json");
+  StartupProfiler::Enable(trace);
+
+  bool ok{false};
+  auto start = std::chrono::steady_clock::now();
+  {
+    Application app(g_argc, g_argv, WindowType::kHeadless);
+    app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+    ok = app.LoadConfig(_config) && app.StepFrame(10000);
+    std::chrono::duration<double, std::milli> total =
+        std::chrono::steady_clock::now() - start;
+    _launch.totalMs = total.count();
+    StartupProfiler::Mark("First frame");
+    StartupProfiler::Write();
+  }
+
+  ReadTrace(trace, _launch);
+  common::removeFile(trace);
+  return ok;
+}
+
+/// \brief Write a config with many plugins.
+/// \return Path to the config
+static std::string SyntheticConfig()
+{
+  auto path = common::joinPaths(std::string(PROJECT_BINARY_PATH), "test",
+      "startup_perf_" + std::to_string(kSyntheticCount) + ".config");
+  std::ofstream file(path);
+  file << "<?xml version=\"1.0\"?>\n";
+  for (int i = 0; i < kSyntheticCount; ++i)
+  {
+    file << "<plugin filename=\""
+         << kSyntheticPlugins[i % kSyntheticPlugins.size()] << "\">"
+         << "<gz-gui><title>Plugin " << i << "</title></gz-gui>"
+         << "</plugin>\n";
+  }
+  return path;
+}
+
+/// \brief Writes the results of the suite.
+class StartupPerf : public PerfFixture<StartupPerf>
+{
+  /// \brief Name of the suite
+  public: static constexpr const char *kSuite{"startup"};
+};
+
+/////////////////////////////////////////////////
+TEST_F(StartupPerf, GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LaunchConfigs))
+{
+  common::Console::SetVerbosity(1);
+
+  std::vector<std::string> configs;
+  auto examples = common::joinPaths(std::string(PROJECT_SOURCE_PATH),
+      "examples", "config");
+  for (common::DirIter file(examples); file != common::DirIter(); ++file)
+  {
+    if (common::basename(*file).find(".config") != std::string::npos)
+      configs.push_back(*file);
+  }
+  std::sort(configs.begin(), configs.end());
+  ASSERT_TRUE(common::createDirectories(common::joinPaths(
+      std::string(PROJECT_BINARY_PATH), "test")));
+  configs.push_back(SyntheticConfig());
+
+  double threshold{kDefaultThresholdMs};
+  bool enforce{false};
+  if (const char *env = std::getenv("GZ_GUI_STARTUP_THRESHOLD_MS"))
+  {
+    threshold = std::atof(env);
+    enforce = threshold > 0.0;
+  }
+
+  for (const auto &config : configs)
+  {
+    auto name = common::basename(config);
+
+    Launch cold;
+    double warmTotal{0};
+    double warmWorst{0};
+    double warmParse{0};
+    std::map<std::string, double> warmPlugins;
+    int warmCount{0};
+    bool ok{true};
+    for (int i = 0; i < kLaunches; ++i)
+    {
+      Launch launch;
+      ok = LaunchConfig(config, launch) && ok;
+      if (i == 0)
+      {
+        cold = launch;
+        continue;
+      }
+      ++warmCount;
+      warmTotal += launch.totalMs;
+      warmWorst = std::max(warmWorst, launch.totalMs);
+      warmParse += launch.parseMs;
+      for (const auto &plugin : launch.pluginMs)
+        warmPlugins[plugin.first] += plugin.second;
+    }
+    if (!ok)
+    {
+      std::cout << "[" << name << "] didn't load or render, it may need "
+                << "plugins which aren't built" << std::endl;
+    }
+
+    double warmMean = warmTotal / warmCount;
+    std::cout << "[" << name << "]: cold start [" << cold.totalMs
+              << "] ms, warm start mean [" << warmMean << "] ms, worst ["
+              << warmWorst << "] ms, config parse ["
+              << warmParse / warmCount << "] ms" << std::endl;
+
+    std::string slowest;
+    double slowestMs{0};
+    for (const auto &plugin : warmPlugins)
+    {
+      std::cout << "  * [" << plugin.first << "] loaded in ["
+                << plugin.second / warmCount << "] ms" << std::endl;
+      if (plugin.second > slowestMs)
+      {
+        slowest = plugin.first;
+        slowestMs = plugin.second;
+      }
+    }
+
+    std::vector<PerfResults::Value> values{
+        {"loaded", ok ? 1 : 0},
+        {"cold_ms", cold.totalMs},
+        {"warm_mean_ms", warmMean},
+        {"warm_max_ms", warmWorst},
+        {"parse_ms", warmParse / warmCount}};
+    for (const auto &plugin : warmPlugins)
+      values.emplace_back("load_" + plugin.first + "_ms",
+          plugin.second / warmCount);
+    Results().Add(name, values);
+
+    if (warmMean > threshold)
+    {
+      if (enforce)
+      {
+        ADD_FAILURE() << "[" << name << "] took [" << warmMean
+                      << "] ms to start, more than [" << threshold
+                      << "] ms";
+      }
+      else
+      {
+        std::cout << "Warning: [" << name << "] took [" << warmMean
+                  << "] ms to start, more than [" << threshold
+                  << "] ms. The slowest plugin is [" << slowest << "]."
+                  << std::endl;
+      }
+    }
+  }
+}
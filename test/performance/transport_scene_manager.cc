@@ -0,0 +1,425 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/msgs/pose_v.pb.h>
+#include <gz/msgs/scene.pb.h>
+#include <gz/msgs/uint32_v.pb.h>
+
+#include <gz/common/Console.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/msgs/Utility.hh>
+#include <gz/rendering/RenderEngine.hh>
+#include <gz/rendering/RenderingIface.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
+#include <gz/transport/Node.hh>
+#include <gz/utils/ExtraTestMacros.hh>
+
+#include "test_config.hh"  // NOLINT(build/include)
+#include "gz/gui/Application.hh"
+#include "gz/gui/MainWindow.hh"
+#include "gz/gui/Plugin.hh"
+#include "gz/gui/RenderHooks.hh"
+#include "PerfResults.hh"
+
+int g_argc = 1;
+char* g_argv[] =
+{
+  reinterpret_cast<char*>(const_cast<char*>("./TransportSceneManager_PERF")),
+};
+
+using namespace std::chrono_literals;
+
+using namespace gz;
+using namespace gui;
+
+/// \brief Number of entities of the synthetic worlds. Each model has a
+/// link and a visual, so it's 3 entities.
+static const std::vector<unsigned int> kEntityCounts{1000, 10000, 100000};
+
+/// \brief Loads a scene with a TransportSceneManager and feeds it with
+/// synthetic worlds.
+class TransportSceneManagerPerfFixture
+  : public PerfFixture<TransportSceneManagerPerfFixture>
+{
+  /// \brief Name of the suite
+  public: static constexpr const char *kSuite{"transport_scene_manager"};
+
+  /// \brief Load the plugins and wait for the scene.
+  protected: void SetUp() override
+  {
+    common::Console::SetVerbosity(1);
+
+    // The initial world is empty, worlds are added with the scene topic
+    this->sceneService = [](msgs::Scene &) -> bool
+    {
+      return true;
+    };
+    this->node.Advertise<msgs::Scene>("/perf/scene", this->sceneService);
+    this->scenePub = this->node.Advertise<msgs::Scene>("/perf/scene_topic");
+    this->posePub = this->node.Advertise<msgs::Pose_V>("/perf/pose");
+    this->deletePub = this->node.Advertise<msgs::UInt32_V>("/perf/delete");
+
+    this->app = std::make_unique<Application>(g_argc, g_argv);
+    this->app->AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+    const char *pluginStr =
+      "<plugin filename=\"TransportSceneManager\">"
+        "<service>/perf/scene</service>"
+        "<pose_topic>/perf/pose</pose_topic>"
+        "<deletion_topic>/perf/delete</deletion_topic>"
+        "<scene_topic>/perf/scene_topic</scene_topic>"
+        "<load_budget>0</load_budget>"
+      "</plugin>";
+
+    const char *pluginMinimalSceneStr =
+      "<plugin filename=\"MinimalScene\">"
+        "<engine>ogre</engine>"
+        "<scene>scene</scene>"
+      "</plugin>";
+
+    tinyxml2::XMLDocument pluginDoc;
+    ASSERT_EQ(tinyxml2::XML_SUCCESS, pluginDoc.Parse(pluginStr));
+    tinyxml2::XMLDocument sceneDoc;
+    ASSERT_EQ(tinyxml2::XML_SUCCESS, sceneDoc.Parse(pluginMinimalSceneStr));
+
+    ASSERT_TRUE(this->app->LoadPlugin("MinimalScene",
+        sceneDoc.FirstChildElement("plugin")));
+    ASSERT_TRUE(this->app->LoadPlugin("TransportSceneManager",
+        pluginDoc.FirstChildElement("plugin")));
+
+    auto window = this->app->findChild<MainWindow *>();
+    ASSERT_NE(window, nullptr);
+    window->QuickWindow()->show();
+
+    auto engine = rendering::engine("ogre");
+    ASSERT_NE(nullptr, engine);
+
+    int sleep = 0;
+    while (0 == engine->SceneCount() && sleep++ < 30)
+    {
+      std::this_thread::sleep_for(100ms);
+      QCoreApplication::processEvents();
+    }
+    ASSERT_EQ(1u, engine->SceneCount());
+    this->scene = engine->SceneByName("scene");
+    ASSERT_NE(nullptr, this->scene);
+    this->root = this->scene->RootVisual();
+    ASSERT_NE(nullptr, this->root);
+
+    // Wait for the scene topic to be subscribed to
+    sleep = 0;
+    while (!this->scenePub.HasConnections() && sleep++ < 50)
+    {
+      std::this_thread::sleep_for(100ms);
+      QCoreApplication::processEvents();
+    }
+    ASSERT_TRUE(this->scenePub.HasConnections());
+
+    // Only the user camera
+    this->baseChildren = this->root->ChildCount();
+
+    RenderHooks::SetTimingEnabled(true);
+  }
+
+  /// \brief Close the application.
+  protected: void TearDown() override
+  {
+    RenderHooks::SetTimingEnabled(false);
+    this->root.reset();
+    this->scene.reset();
+    this->app.reset();
+  }
+
+  /// \brief Create a world of boxes.
+  /// \param[in] _models Number of models
+  /// \return Scene message
+  protected: static msgs::Scene World(unsigned int _models)
+  {
+    msgs::Scene msg;
+    msg.set_name("perf");
+    for (unsigned int i = 0; i < _models; ++i)
+    {
+      auto model = msg.add_model();
+      model->set_id(ModelId(i));
+      model->set_name("model_" + std::to_string(i));
+      msgs::Set(model->mutable_pose(), ModelPose(i, 0));
+
+      auto link = model->add_link();
+      link->set_id(ModelId(i) + 1);
+      link->set_name("link");
+
+      auto visual = link->add_visual();
+      visual->set_id(ModelId(i) + 2);
+      visual->set_name("visual");
+      msgs::Set(visual->mutable_geometry()->mutable_box()->mutable_size(),
+          math::Vector3d(0.5, 0.5, 0.5));
+    }
+    return msg;
+  }
+
+  /// \brief Entity id of a model, its link and visual follow.
+  /// \param[in] _index Index of the model
+  /// \return Id
+  protected: static unsigned int ModelId(unsigned int _index)
+  {
+    return 1 + _index * 3;
+  }
+
+  /// \brief Pose of a model, on a grid, moving up over time.
+  /// \param[in] _index Index of the model
+  /// \param[in] _step Update number
+  /// \return Pose
+  protected: static math::Pose3d ModelPose(unsigned int _index, int _step)
+  {
+    return math::Pose3d(_index % 200, _index / 200, _step * 0.001,
+        0, 0, 0);
+  }
+
+  /// \brief Render until the number of children of the root reaches a
+  /// count.
+  /// \param[in] _count Number of models, the camera is added to it
+  /// \param[in] _timeout Time to wait for
+  /// \return Time it took, negative if it timed out
+  protected: std::chrono::duration<double, std::milli> WaitForModels(
+      unsigned int _count, std::chrono::seconds _timeout)
+  {
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + _timeout;
+    while (this->root->ChildCount() != this->baseChildren + _count)
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+        return std::chrono::duration<double, std::milli>(-1);
+      QCoreApplication::processEvents();
+    }
+    return std::chrono::steady_clock::now() - start;
+  }
+
+  /// \brief Render a single frame.
+  /// \return Time the frame took.
+  protected: std::chrono::duration<double, std::milli> Frame()
+  {
+    auto start = std::chrono::steady_clock::now();
+    QCoreApplication::processEvents();
+    return std::chrono::steady_clock::now() - start;
+  }
+
+  /// \brief Time spent by the plugin's render hook on the last frame.
+  /// \return Milliseconds, 0 if unknown
+  protected: static double HookTime()
+  {
+    for (const auto &timing : RenderHooks::Timings(RenderPhase::kRender))
+    {
+      if (timing.first == "TransportSceneManager")
+        return timing.second;
+    }
+    return 0.0;
+  }
+
+  /// \brief Add a world and wait until it's loaded.
+  /// \param[in] _models Number of models
+  /// \return Time until all models were in the scene, negative on timeout
+  protected: std::chrono::duration<double, std::milli> Load(
+      unsigned int _models)
+  {
+    auto world = World(_models);
+    auto start = std::chrono::steady_clock::now();
+    this->scenePub.Publish(world);
+    auto loaded = this->WaitForModels(_models, 600s);
+    if (loaded.count() < 0)
+      return loaded;
+    return std::chrono::steady_clock::now() - start;
+  }
+
+  /// \brief Delete the models of a world and wait until they're gone.
+  /// \param[in] _models Number of models
+  /// \return Time until all models left the scene, negative on timeout
+  protected: std::chrono::duration<double, std::milli> Delete(
+      unsigned int _models)
+  {
+    msgs::UInt32_V msg;
+    for (unsigned int i = 0; i < _models; ++i)
+      msg.add_data(ModelId(i));
+
+    auto start = std::chrono::steady_clock::now();
+    this->deletePub.Publish(msg);
+    auto deleted = this->WaitForModels(0, 600s);
+    if (deleted.count() < 0)
+      return deleted;
+    return std::chrono::steady_clock::now() - start;
+  }
+
+  /// \brief Transport node
+  protected: transport::Node node;
+
+  /// \brief Responds to the scene request
+  protected: std::function<bool(msgs::Scene &)> sceneService;
+
+  /// \brief Scene publisher
+  protected: transport::Node::Publisher scenePub;
+
+  /// \brief Pose publisher
+  protected: transport::Node::Publisher posePub;
+
+  /// \brief Deletion publisher
+  protected: transport::Node::Publisher deletePub;
+
+  /// \brief Application
+  protected: std::unique_ptr<Application> app;
+
+  /// \brief Scene
+  protected: rendering::ScenePtr scene;
+
+  /// \brief Root visual of the scene
+  protected: rendering::VisualPtr root;
+
+  /// \brief Children of the root before any world is loaded
+  protected: unsigned int baseChildren{0};
+};
+
+/////////////////////////////////////////////////
+TEST_F(TransportSceneManagerPerfFixture,
+  GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(LoadAndDelete))
+{
+  for (unsigned int entities : kEntityCounts)
+  {
+    unsigned int models = entities / 3;
+    std::size_t memoryBefore = ResidentMemory();
+
+    auto load = this->Load(models);
+    ASSERT_GE(load.count(), 0) << "Timed out loading [" << entities
+                               << "] entities";
+
+    std::size_t memoryAfter = ResidentMemory();
+    double bytesPerEntity = memoryAfter > memoryBefore ?
+        static_cast<double>(memoryAfter - memoryBefore) / (models * 3) : 0;
+    auto frame = this->Frame();
+
+    auto deletion = this->Delete(models);
+    ASSERT_GE(deletion.count(), 0) << "Timed out deleting [" << entities
+                                   << "] entities";
+
+    std::cout << "[" << models * 3 << "] entities loaded in ["
+              << load.count() << "] ms, next frame [" << frame.count()
+              << "] ms, [" << bytesPerEntity << "] bytes per entity, "
+              << "deleted in [" << deletion.count() << "] ms" << std::endl;
+
+    Results().Add("load_and_delete", {
+        {"entities", models * 3},
+        {"load_ms", load.count()},
+        {"first_frame_ms", frame.count()},
+        {"bytes_per_entity", bytesPerEntity},
+        {"delete_ms", deletion.count()}});
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportSceneManagerPerfFixture,
+  GZ_UTILS_TEST_ENABLED_ONLY_ON_LINUX(PoseStream))
+{
+  for (unsigned int entities : kEntityCounts)
+  {
+    unsigned int models = entities / 3;
+    ASSERT_GE(this->Load(models).count(), 0);
+
+    // Every model moves on every update, like a world's dynamic poses
+    for (unsigned int rate : {100u, 1000u})
+    {
+      const std::chrono::duration<double> period(1.0 / rate);
+      const int updates = static_cast<int>(rate);
+
+      msgs::Pose_V poses;
+      for (unsigned int i = 0; i < models; ++i)
+        poses.add_pose()->set_id(ModelId(i));
+
+      double worstFrame{0};
+      double totalFrame{0};
+      double worstHook{0};
+      double totalHook{0};
+      int frames{0};
+      auto start = std::chrono::steady_clock::now();
+      for (int update = 1; update <= updates; ++update)
+      {
+        for (unsigned int i = 0; i < models; ++i)
+          msgs::Set(poses.mutable_pose(i), ModelPose(i, update));
+        this->posePub.Publish(poses);
+
+        auto next = start + update * period;
+        do
+        {
+          double frame = this->Frame().count();
+          double hook = HookTime();
+          worstFrame = std::max(worstFrame, frame);
+          totalFrame += frame;
+          worstHook = std::max(worstHook, hook);
+          totalHook += hook;
+          ++frames;
+        }
+        while (std::chrono::steady_clock::now() < next);
+      }
+      auto streamEnd = std::chrono::steady_clock::now();
+
+      // Wait for the last update to be applied to the last model
+      auto last = std::dynamic_pointer_cast<rendering::Visual>(
+          this->root->ChildByIndex(this->root->ChildCount() - 1));
+      ASSERT_NE(nullptr, last);
+      auto expected = ModelPose(models - 1, updates);
+      auto deadline = streamEnd + 10s;
+      while (last->LocalPose() != expected &&
+          std::chrono::steady_clock::now() < deadline)
+      {
+        this->Frame();
+      }
+      std::chrono::duration<double, std::milli> latency =
+          std::chrono::steady_clock::now() - streamEnd;
+      EXPECT_EQ(expected, last->LocalPose());
+
+      double seconds = std::chrono::duration<double>(
+          streamEnd - start).count();
+      std::cout << "[" << models * 3 << "] entities at [" << rate
+                << "] Hz: [" << frames / seconds << "] FPS, mean frame ["
+                << totalFrame / frames << "] ms, worst frame ["
+                << worstFrame << "] ms, mean pose application ["
+                << totalHook / frames << "] ms, worst ["
+                << worstHook << "] ms, last update applied ["
+                << latency.count() << "] ms after the end" << std::endl;
+
+      Results().Add("pose_stream", {
+          {"entities", models * 3},
+          {"rate_hz", rate},
+          {"fps", frames / seconds},
+          {"frame_mean_ms", totalFrame / frames},
+          {"frame_max_ms", worstFrame},
+          {"pose_apply_mean_ms", totalHook / frames},
+          {"pose_apply_max_ms", worstHook},
+          {"latency_ms", latency.count()}});
+    }
+
+    ASSERT_GE(this->Delete(models).count(), 0);
+  }
+}